@@ -287,6 +287,10 @@
     #define configUSE_TIMERS    0
 #endif
 
+#ifndef configUSE_TIMER_TOUCH
+    #define configUSE_TIMER_TOUCH    0
+#endif
+
 #ifndef configUSE_COUNTING_SEMAPHORES
     #define configUSE_COUNTING_SEMAPHORES    0
 #endif
@@ -1398,6 +1402,9 @@ typedef struct xSTATIC_TIMER
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy7;
     #endif
+    #if ( configUSE_TIMER_TOUCH == 1 )
+        TickType_t xDummy9;
+    #endif
     uint8_t ucDummy8;
 } StaticTimer_t;
 
@@ -1323,6 +1323,35 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  */
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerTouch( TimerHandle_t xTimer );
+ * void vTimerTouchFromISR( TimerHandle_t xTimer );
+ *
+ * Moves the expiry time of a running timer to one period after the current
+ * tick count, like xTimerReset(), without sending a command to the timer
+ * service task.  Only the tick count is stored in the timer.  When the timer
+ * reaches its old expiry time, the timer service task sees the touch and moves
+ * the timer to the new expiry time instead of calling the callback.  Touching
+ * a timer many times per period therefore costs no more than a store.
+ *
+ * configUSE_TIMER_TOUCH must be set to 1 in FreeRTOSConfig.h for these
+ * functions to be available.
+ *
+ * A touch does not start a timer that is not running, use xTimerStart() or
+ * xTimerReset() for that.  xTimerGetExpiryTime() returns the old expiry time
+ * until it is reached.  A touch is only seen if it is more recent than the
+ * start of the timer, within the range of the tick count.
+ *
+ * vTimerTouchFromISR() is the version that can be called from an interrupt
+ * service routine.
+ *
+ * @param xTimer The handle of the timer being touched.
+ */
+#if ( configUSE_TIMER_TOUCH == 1 )
+    void vTimerTouch( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+    void vTimerTouchFromISR( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
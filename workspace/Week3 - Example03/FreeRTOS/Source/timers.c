@@ -82,6 +82,9 @@
         #if ( configUSE_TRACE_FACILITY == 1 )
             UBaseType_t uxTimerNumber;              /*<< An ID assigned by trace tools such as FreeRTOS+Trace */
         #endif
+        #if ( configUSE_TIMER_TOUCH == 1 )
+            volatile TickType_t xLastTouchTime;     /*<< The tick count of the last vTimerTouch(), written without a command to the timer service task. */
+        #endif
         uint8_t ucStatus;                           /*<< Holds bits to say if the timer was statically allocated or not, and if it is active or not. */
     } xTIMER;
 
@@ -374,6 +377,12 @@
         pxNewTimer->pxCallbackFunction = pxCallbackFunction;
         vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
 
+        #if ( configUSE_TIMER_TOUCH == 1 )
+        {
+            pxNewTimer->xLastTouchTime = ( TickType_t ) 0U;
+        }
+        #endif
+
         if( xAutoReload != pdFALSE )
         {
             pxNewTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
@@ -510,6 +519,32 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_TOUCH == 1 )
+
+        void vTimerTouch( TimerHandle_t xTimer )
+        {
+            Timer_t * const pxTimer = xTimer;
+
+            configASSERT( xTimer );
+
+            /* A single store of the tick count, which is atomic on ports with
+             * portTICK_TYPE_IS_ATOMIC.  The timer service task reads it when the
+             * timer expires. */
+            pxTimer->xLastTouchTime = xTaskGetTickCount();
+        }
+/*-----------------------------------------------------------*/
+
+        void vTimerTouchFromISR( TimerHandle_t xTimer )
+        {
+            Timer_t * const pxTimer = xTimer;
+
+            configASSERT( xTimer );
+            pxTimer->xLastTouchTime = xTaskGetTickCountFromISR();
+        }
+
+    #endif /* configUSE_TIMER_TOUCH */
+/*-----------------------------------------------------------*/
+
     const char * pcTimerGetName( TimerHandle_t xTimer ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
     {
         Timer_t * pxTimer = xTimer;
@@ -542,26 +577,63 @@
                                         const TickType_t xTimeNow )
     {
         Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        TickType_t xExpiredTime = xNextExpireTime;
+        BaseType_t xCallCallback = pdTRUE;
 
         /* Remove the timer from the list of active timers.  A check has already
          * been performed to ensure the list is not empty. */
 
         ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
 
-        /* If the timer is an auto-reload timer then calculate the next
-         * expiry time and re-insert the timer in the list of active timers. */
-        if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+        #if ( configUSE_TIMER_TOUCH == 1 )
         {
-            prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
+            /* The timer was started a period before its expiry time.  If it
+             * was touched since then, it expires a period after the touch
+             * instead.  The touch is only looked at now, so touching a timer
+             * costs no command and no wake up of this task.  The touch time
+             * must be after the start and not after xTimeNow, an older one
+             * took place before the timer was started and a newer one is seen
+             * the next time. */
+            const TickType_t xStartTime = xNextExpireTime - pxTimer->xTimerPeriodInTicks;
+            const TickType_t xTouchTime = pxTimer->xLastTouchTime;
+
+            if( ( ( TickType_t ) ( xTouchTime - xStartTime ) - ( TickType_t ) 1 ) < ( TickType_t ) ( xTimeNow - xStartTime ) )
+            {
+                xExpiredTime = xTouchTime + pxTimer->xTimerPeriodInTicks;
+                traceTIMER_COMMAND_RECEIVED( pxTimer, tmrCOMMAND_RESET, xTouchTime );
+
+                /* As a reset command given at the time of the touch. */
+                xCallCallback = prvInsertTimerInActiveList( pxTimer, xExpiredTime, xTimeNow, xTouchTime );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIMER_TOUCH */
+
+        if( xCallCallback != pdFALSE )
+        {
+            /* If the timer is an auto-reload timer then calculate the next
+             * expiry time and re-insert the timer in the list of active timers. */
+            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+            {
+                prvReloadTimer( pxTimer, xExpiredTime, xTimeNow );
+            }
+            else
+            {
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+            }
+
+            /* Call the timer callback. */
+            traceTIMER_EXPIRED( pxTimer );
+            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
         }
         else
         {
-            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+            /* The new expiry time has not been reached yet. */
+            mtCOVERAGE_TEST_MARKER();
         }
-
-        /* Call the timer callback. */
-        traceTIMER_EXPIRED( pxTimer );
-        pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
     }
 /*-----------------------------------------------------------*/
 
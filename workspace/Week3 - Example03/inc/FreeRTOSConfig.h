@@ -87,6 +87,9 @@ extern volatile uint32_t ulHighFrequencyTicks;
 #define configTIMER_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE )
 #define configTIMER_SERVICE_TASK_NAME   "Daemon"
 
+/* vTimerTouch() extends a running timer without a command to the daemon */
+#define configUSE_TIMER_TOUCH			1
+
 /* Enabling tickless. */
 #define configUSE_TICKLESS_IDLE			1
 
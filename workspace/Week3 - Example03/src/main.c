@@ -144,10 +144,12 @@ static void vKeyHitTask( void *pvParameters )
             }
             else
             {
-                /* Reset the software timer. A real application may read key presses in an
-                interrupt. If this function was an interrupt service routine then
-                xTimerResetFromISR() must be used instead of xTimerReset(). */
-                xTimerReset( xBacklightTimer, xBacklightOffDelay );
+                /* Extend the software timer. Unlike xTimerReset(), vTimerTouch() only
+                stores the time of the key hit in the timer. The daemon looks at it when
+                the timer expires, so frequent key hits do not send a command each.
+                If this function was an interrupt service routine then
+                vTimerTouchFromISR() must be used instead of vTimerTouch(). */
+                vTimerTouch( xBacklightTimer );
 
                 /* The backlight was already on, so print a message to say the timer is about to
                 be reset and the time at which it was reset. */
@@ -0,0 +1,555 @@
+/*! ***************************************************************************
+ *
+ * \brief     Shared ADC0 conversion service
+ * \file      adc.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "adc.h"
+
+// Request queue, the head is the request being converted
+static adc_request_t * volatile head = NULL;
+static adc_request_t * volatile tail = NULL;
+
+// Set by adc_acquire(), queued requests are kept until adc_release()
+static volatile bool exclusive = false;
+
+/*!
+ * \brief Initialises ADC0 for the conversion service
+ *
+ * All requests use 16-bit single-ended conversions with a long sample time.
+ * The ADC is calibrated and software triggered, the interrupt handler starts
+ * every queued request directly after the previous one.
+ *
+ * Every driver that uses ADC0 calls this function, only the first call has
+ * effect.
+ */
+void adc_init(void)
+{
+    static bool initialised = false;
+
+    if(initialised)
+    {
+        return;
+    }
+
+    initialised = true;
+
+    // Enable clock to ADC0
+    SIM->SCGC6 |= SIM_SCGC6_ADC0(1);
+
+    // Configure ADC
+    // - ADLPC = 1        : Low-power configuration. The power is reduced at
+    //                      the expense of maximum clock speed.
+    // - ADIV[1:0] = 00   : The divide ratio is 1 and the clock rate is input
+    //                      clock.
+    // - ADLSMP = 1       : Long sample time.
+    // - MODE[1:0] = 11   : Single-ended 16-bit conversion
+    // - ADICLK[1:0] = 01 : (Bus clock)/2
+    ADC0->CFG1 = 0x9D;
+
+    (void)adc_calibrate();
+
+    // - ADTRG = 0   : Software trigger selected
+    // - ACFE  = 0   : Compare function disabled
+    // - DMAEN = 0   : DMA is disabled
+    // - REFSEL = 00 : Default voltage reference pin pair
+    ADC0->SC2 = 0;
+
+    // No conversion
+    ADC0->SC1[0] = ADC_SC1_ADCH(0x1F);
+
+    // Enable the interrupt in the NVIC
+    NVIC_SetPriority(ADC0_IRQn, 128);
+    NVIC_ClearPendingIRQ(ADC0_IRQn);
+    NVIC_EnableIRQ(ADC0_IRQn);
+}
+
+/*!
+ * \brief Runs the ADC0 self-calibration
+ *
+ * Calibration is done with the ADC clock divided to 3 MHz and 32 samples
+ * hardware average, as recommended by the reference manual, and takes a few
+ * milliseconds. The resulting plus-side and minus-side gains are stored in
+ * PG and MG. The configuration of ADC0 is restored afterwards, so this can be
+ * repeated after a large change in supply voltage or temperature between
+ * adc_acquire() and adc_release().
+ *
+ * \return False if the calibration failed, the previous gains are kept then
+ */
+bool adc_calibrate(void)
+{
+    const uint32_t cfg1 = ADC0->CFG1;
+    const uint32_t sc1 = ADC0->SC1[0];
+    const uint32_t sc2 = ADC0->SC2;
+    const uint32_t sc3 = ADC0->SC3;
+    const uint32_t pg = ADC0->PG;
+    const uint32_t mg = ADC0->MG;
+
+    // ADIV[1:0] = 10 : ADCK = (Bus clock)/2/4 = 3 MHz
+    ADC0->CFG1 = (cfg1 & ~ADC_CFG1_ADIV_MASK) | ADC_CFG1_ADIV(2);
+
+    // Software trigger, no interrupt
+    ADC0->SC2 = 0;
+    ADC0->SC1[0] = ADC_SC1_ADCH(0x1F);
+
+    // Start the calibration with 32 samples average
+    ADC0->SC3 = ADC_SC3_CAL_MASK | ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(3);
+
+    while(ADC0->SC3 & ADC_SC3_CAL_MASK)
+    {}
+
+    const bool ok = (ADC0->SC3 & ADC_SC3_CALF_MASK) == 0;
+
+    if(ok)
+    {
+        // Plus-side gain: sum of the calibration values, divided by two, with
+        // the MSB set
+        uint16_t sum = ADC0->CLP0 + ADC0->CLP1 + ADC0->CLP2 + ADC0->CLP3 +
+                       ADC0->CLP4 + ADC0->CLPS;
+        ADC0->PG = (sum / 2) | 0x8000;
+
+        // Minus-side gain
+        sum = ADC0->CLM0 + ADC0->CLM1 + ADC0->CLM2 + ADC0->CLM3 +
+              ADC0->CLM4 + ADC0->CLMS;
+        ADC0->MG = (sum / 2) | 0x8000;
+    }
+    else
+    {
+        ADC0->PG = pg;
+        ADC0->MG = mg;
+    }
+
+    // Clear CALF and COCO and restore the configuration
+    ADC0->SC3 = ADC_SC3_CALF_MASK | (sc3 & (ADC_SC3_AVGE_MASK | ADC_SC3_AVGS_MASK));
+    (void)ADC0->R[0];
+    ADC0->CFG1 = cfg1;
+    ADC0->SC2 = sc2;
+    ADC0->SC1[0] = sc1;
+
+    return ok;
+}
+
+/*!
+ * \brief Returns the number of conversions averaged for \p avg
+ */
+uint32_t adc_avg_samples(const adc_avg_t avg)
+{
+    return (avg == ADC_AVG_1) ? 1 : (4UL << (avg - ADC_AVG_4));
+}
+
+/*!
+ * \brief Returns the ADC0->SC3 averaging bits for \p avg
+ */
+uint8_t adc_sc3_avg(const adc_avg_t avg)
+{
+    if(avg == ADC_AVG_1)
+    {
+        return 0;
+    }
+
+    return ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(avg - ADC_AVG_4);
+}
+
+/*!
+ * \brief Stops the converter, also if it converts continuously
+ *
+ * Called from a critical section or from the interrupt handler.
+ */
+static void adc_stop(void)
+{
+    ADC0->SC1[0] = ADC_SC1_ADCH(0x1F);
+    ADC0->SC2 = 0;
+    ADC0->SC3 = 0;
+}
+
+/*!
+ * \brief Starts the conversion of the request at the head of the queue
+ *
+ * Called from a critical section or from the interrupt handler.
+ */
+static void adc_begin(void)
+{
+    head->status = ADC_BUSY;
+
+    // - ACFE = 1  : Compare function enabled
+    // - ACFGT = 1 : Greater than or equal to the threshold
+    if(head->compare == ADC_CMP_NONE)
+    {
+        ADC0->SC2 = 0;
+        ADC0->SC3 = adc_sc3_avg(head->avg);
+    }
+    else
+    {
+        ADC0->CV1 = head->threshold;
+        ADC0->SC2 = ADC_SC2_ACFE_MASK |
+            ((head->compare == ADC_CMP_ABOVE) ? ADC_SC2_ACFGT_MASK : 0);
+
+        // Continuous conversions until the result matches
+        ADC0->SC3 = adc_sc3_avg(head->avg) | ADC_SC3_ADCO_MASK;
+    }
+
+    // Writing SC1A starts the conversion
+    ADC0->SC1[0] = ADC_SC1_AIEN(1) | ADC_SC1_ADCH(head->channel);
+}
+
+/*!
+ * \brief Appends a request, starts it if the converter is idle
+ *
+ * Called from a critical section or from an interrupt handler.
+ */
+static void adc_enqueue(adc_request_t *r)
+{
+    r->status = ADC_QUEUED;
+    r->next = NULL;
+
+    if(tail == NULL)
+    {
+        head = r;
+        tail = r;
+
+        if(!exclusive)
+        {
+            adc_begin();
+        }
+    }
+    else
+    {
+        tail->next = r;
+        tail = r;
+    }
+}
+
+/*!
+ * \brief Queues a conversion request from a task
+ *
+ * Requests of all clients are converted in the order they are submitted,
+ * each directly after the previous one. Without a callback, the calling task
+ * is notified on index ADC_NOTIFY_INDEX, wait for it with adc_wait().
+ *
+ * \param[in,out]  r  Request
+ */
+void adc_submit(adc_request_t *r)
+{
+    r->task = xTaskGetCurrentTaskHandle();
+
+    taskENTER_CRITICAL();
+    {
+        adc_enqueue(r);
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Queues a conversion request from an interrupt handler
+ *
+ * The request must have a callback. Use this to start conversions from a
+ * timer interrupt, or to chain a conversion from a callback.
+ *
+ * \param[in,out]  r  Request
+ */
+void adc_submit_from_isr(adc_request_t *r)
+{
+    r->task = NULL;
+
+    UBaseType_t uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        adc_enqueue(r);
+    }
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/*!
+ * \brief Removes a request that did not complete in time from the queue
+ */
+static void adc_cancel(adc_request_t *r)
+{
+    taskENTER_CRITICAL();
+    {
+        if((r->status == ADC_QUEUED) || (r->status == ADC_BUSY))
+        {
+            if(head == r)
+            {
+                head = r->next;
+
+                if(r->status == ADC_BUSY)
+                {
+                    // Abort the conversion
+                    adc_stop();
+
+                    if((head != NULL) && !exclusive)
+                    {
+                        adc_begin();
+                    }
+                }
+            }
+            else
+            {
+                adc_request_t *prev = head;
+                while(prev->next != r)
+                {
+                    prev = prev->next;
+                }
+
+                prev->next = r->next;
+            }
+
+            if(tail == r)
+            {
+                // Find the new tail, NULL if the queue is empty
+                adc_request_t *t = head;
+                while((t != NULL) && (t->next != NULL))
+                {
+                    t = t->next;
+                }
+
+                tail = t;
+            }
+
+            r->status = ADC_CANCELLED;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Waits for a request submitted by the calling task without callback
+ *
+ * If it is not completed within \p timeout ticks, it is cancelled.
+ *
+ * \param[in,out]  r        Request
+ * \param[in]      timeout  Maximum time to wait in ticks
+ *
+ * \return True if the result is valid
+ */
+bool adc_wait(adc_request_t *r, const TickType_t timeout)
+{
+    TimeOut_t start;
+    TickType_t remaining = timeout;
+
+    vTaskSetTimeOutState(&start);
+
+    // A notification may belong to another request of this task, so check
+    // the state of this one every time
+    while((r->status == ADC_QUEUED) || (r->status == ADC_BUSY))
+    {
+        if(xTaskCheckForTimeOut(&start, &remaining) == pdTRUE)
+        {
+            adc_cancel(r);
+            break;
+        }
+
+        ulTaskNotifyTakeIndexed(ADC_NOTIFY_INDEX, pdTRUE, remaining);
+    }
+
+    return (r->status == ADC_DONE);
+}
+
+/*!
+ * \brief Converts a channel and waits for the result
+ *
+ * The calling task blocks on notification index ADC_NOTIFY_INDEX until the
+ * conversion complete interrupt, so it does not poll COCO and lower priority
+ * tasks run during the conversion.
+ *
+ * \param[in]   channel  Single-ended input channel
+ * \param[in]   avg      Hardware averaging
+ * \param[out]  result   Conversion result
+ * \param[in]   timeout  Maximum time to wait in ticks
+ *
+ * \return True if \p result is valid
+ */
+bool adc_convert(const uint8_t channel, const adc_avg_t avg, uint16_t *result,
+    const TickType_t timeout)
+{
+    adc_request_t r =
+    {
+        .channel = channel,
+        .avg = avg,
+        .callback = NULL,
+    };
+
+    adc_submit(&r);
+
+    if(!adc_wait(&r, timeout))
+    {
+        return false;
+    }
+
+    *result = r.result;
+
+    return true;
+}
+
+/*!
+ * \brief Waits until a channel compares to a threshold
+ *
+ * ADC0 converts the channel continuously with the compare function, and the
+ * calling task blocks until the conversion complete interrupt of the first
+ * result that matches. The CPU is not woken up for the other results, so the
+ * task can wait for a level instead of polling it. Other requests wait until
+ * this one completes or times out.
+ *
+ * \param[in]   channel    Single-ended input channel
+ * \param[in]   avg        Hardware averaging
+ * \param[in]   compare    Compare function, ADC_CMP_BELOW or ADC_CMP_ABOVE
+ * \param[in]   threshold  Threshold of the compare function
+ * \param[out]  result     Conversion result that matched
+ * \param[in]   timeout    Maximum time to wait in ticks
+ *
+ * \return True if a result matched within \p timeout
+ */
+bool adc_compare(const uint8_t channel, const adc_avg_t avg,
+    const adc_cmp_t compare, const uint16_t threshold, uint16_t *result,
+    const TickType_t timeout)
+{
+    adc_request_t r =
+    {
+        .channel = channel,
+        .avg = avg,
+        .compare = compare,
+        .threshold = threshold,
+        .callback = NULL,
+    };
+
+    adc_submit(&r);
+
+    if(!adc_wait(&r, timeout))
+    {
+        return false;
+    }
+
+    *result = r.result;
+
+    return true;
+}
+
+/*!
+ * \brief Takes exclusive ownership of ADC0
+ *
+ * Waits for the conversion in progress. Queued and new requests are kept
+ * until adc_release(), so the owner can use a hardware trigger, both SC1A
+ * and SC1B, or DMA. Only one owner at a time.
+ */
+void adc_acquire(void)
+{
+    bool busy;
+
+    do
+    {
+        taskENTER_CRITICAL();
+        {
+            exclusive = true;
+            busy = (head != NULL) && (head->status == ADC_BUSY);
+        }
+        taskEXIT_CRITICAL();
+    }
+    while(busy);
+
+    NVIC_DisableIRQ(ADC0_IRQn);
+}
+
+/*!
+ * \brief Gives ADC0 back to the conversion service
+ *
+ * Restores the software trigger and starts the queued requests.
+ */
+void adc_release(void)
+{
+    ADC0->SC2 = 0;
+    ADC0->SC1[0] = ADC_SC1_ADCH(0x1F);
+    (void)ADC0->R[0];
+
+    NVIC_ClearPendingIRQ(ADC0_IRQn);
+    NVIC_EnableIRQ(ADC0_IRQn);
+
+    taskENTER_CRITICAL();
+    {
+        exclusive = false;
+
+        if(head != NULL)
+        {
+            adc_begin();
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief ADC0 interrupt handler
+ *
+ * Completes the request at the head of the queue and starts the next one
+ * before the client is informed, so the converter is idle only while the
+ * result is read.
+ */
+void ADC0_IRQHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    // Reading the result clears COCO
+    const uint16_t result = ADC0->R[0];
+
+    adc_request_t *r = head;
+
+    if((r == NULL) || (r->status != ADC_BUSY))
+    {
+        return;
+    }
+
+    head = r->next;
+    if(head == NULL)
+    {
+        tail = NULL;
+
+        if(r->compare != ADC_CMP_NONE)
+        {
+            adc_stop();
+        }
+    }
+    else if(!exclusive)
+    {
+        adc_begin();
+    }
+    else
+    {
+        adc_stop();
+    }
+
+    r->result = result;
+    r->status = ADC_DONE;
+
+    if(r->callback != NULL)
+    {
+        r->callback(r, &xHigherPriorityTaskWoken);
+    }
+    else if(r->task != NULL)
+    {
+        vTaskNotifyGiveIndexedFromISR(r->task, ADC_NOTIFY_INDEX,
+            &xHigherPriorityTaskWoken);
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
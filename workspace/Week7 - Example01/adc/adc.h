@@ -0,0 +1,142 @@
+/*! ***************************************************************************
+ *
+ * \brief     Shared ADC0 conversion service
+ * \file      adc.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef ADC_H
+#define ADC_H
+
+#include <MKL25Z4.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*!
+ * \brief Task notification index used to signal a completed conversion
+ */
+#ifndef ADC_NOTIFY_INDEX
+#define ADC_NOTIFY_INDEX (5)
+#endif
+
+/*!
+ * \brief Approximate time of a single 16-bit long sample conversion in us
+ */
+#define ADC_CONVERSION_US (4)
+
+/*!
+ * \brief Number of conversions averaged by the ADC hardware per result
+ */
+typedef enum
+{
+    ADC_AVG_1,  ///< Hardware averaging disabled
+    ADC_AVG_4,
+    ADC_AVG_8,
+    ADC_AVG_16,
+    ADC_AVG_32,
+}adc_avg_t;
+
+/*!
+ * \brief State of a conversion request
+ */
+typedef enum
+{
+    ADC_QUEUED,    ///< Waiting for the converter
+    ADC_BUSY,      ///< Converting
+    ADC_DONE,      ///< Result is valid
+    ADC_CANCELLED, ///< Removed by adc_wait() after a timeout
+}adc_status_t;
+
+/*!
+ * \brief Compare function of a conversion request
+ *
+ * With a compare function, ADC0 converts continuously and completes the
+ * request only with the first result that matches, without interrupting the
+ * CPU for the results that do not. The other requests wait until it matches
+ * or is cancelled.
+ */
+typedef enum
+{
+    ADC_CMP_NONE,  ///< Complete with the first result
+    ADC_CMP_BELOW, ///< Complete with a result below the threshold
+    ADC_CMP_ABOVE, ///< Complete with a result at or above the threshold
+}adc_cmp_t;
+
+struct adc_request;
+
+/*!
+ * \brief Completion callback, called from the ADC interrupt handler
+ *
+ * \param[in]  r      Completed request
+ * \param[out] woken  Set to pdTRUE if a higher priority task was woken
+ */
+typedef void (*adc_callback_t)(struct adc_request *r, BaseType_t *woken);
+
+/*!
+ * \brief Conversion request
+ *
+ * If \p callback is NULL, the submitting task is notified on index
+ * ADC_NOTIFY_INDEX instead, wait for it with adc_wait(). The request must
+ * remain valid until it is completed.
+ */
+typedef struct adc_request
+{
+    uint8_t channel;          ///< Single-ended input channel, ADCH
+    adc_avg_t avg;            ///< Hardware averaging
+    adc_cmp_t compare;        ///< Compare function
+    uint16_t threshold;       ///< Threshold of the compare function, CV1
+    adc_callback_t callback;  ///< Called when completed, or NULL
+    void *arg;                ///< Free for use by the client
+
+    // Managed by the service
+    volatile uint16_t result;
+    volatile adc_status_t status;
+    TaskHandle_t task;
+    struct adc_request *next;
+}adc_request_t;
+
+// Function prototypes
+void adc_init(void);
+bool adc_calibrate(void);
+
+void adc_submit(adc_request_t *r);
+void adc_submit_from_isr(adc_request_t *r);
+bool adc_wait(adc_request_t *r, const TickType_t timeout);
+bool adc_convert(const uint8_t channel, const adc_avg_t avg, uint16_t *result,
+    const TickType_t timeout);
+bool adc_compare(const uint8_t channel, const adc_avg_t avg,
+    const adc_cmp_t compare, const uint16_t threshold, uint16_t *result,
+    const TickType_t timeout);
+
+uint32_t adc_avg_samples(const adc_avg_t avg);
+uint8_t adc_sc3_avg(const adc_avg_t avg);
+
+void adc_acquire(void);
+void adc_release(void);
+
+#endif // ADC_H
@@ -57,14 +57,14 @@
 #define configUSE_APPLICATION_TASK_TAG	0
 #define configUSE_COUNTING_SEMAPHORES	1
 #define configUSE_TASK_NOTIFICATIONS    1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 6
 
 /* For generating runtime statistics */
 #define configGENERATE_RUN_TIME_STATS	     1
 #define configUSE_STATS_FORMATTING_FUNCTIONS 1
 
-extern volatile uint32_t ulHighFrequencyTicks;
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vConfigureTimerForRunTimeStats()
-#define portGET_RUN_TIME_COUNTER_VALUE() ulHighFrequencyTicks
+#define portGET_RUN_TIME_COUNTER_VALUE() ulRunTimeStatsCounter()
 
 #define configRECORD_STACK_HIGH_ADDRESS      1
 
@@ -93,6 +93,10 @@ extern volatile uint32_t ulHighFrequencyTicks;
 /* Enabling tickless. */
 #define configUSE_TICKLESS_IDLE			1
 
+/* Measure the time asleep and the wake-ups, see runtime_stats.c */
+#define configPRE_SLEEP_PROCESSING( x ) vRunTimeStatsPreSleep()
+#define configPOST_SLEEP_PROCESSING( x ) vRunTimeStatsPostSleep()
+
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
 #define INCLUDE_vTaskPrioritySet		1
@@ -103,6 +107,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
 #define INCLUDE_eTaskGetState			1
+#define INCLUDE_xTaskGetIdleTaskHandle	1
 
 /* Normal assert() semantics without relying on the provision of an assert.h
 header file. */
@@ -52,38 +52,8 @@ void led_init(void)
     PORTD->PCR[4] = PORT_PCR_MUX(1);
     
     // Set port pin to outputs
-    PTD->PDDR |= (1<<4);
+    gpio_output(LED_GPIO, LED_MASK);
 
     // Turn off the LED
-    PTD->PCOR = (1<<4);
-}
-
-/*!
- * \brief Turns on the LED
- *
- * This functions switches on the LED.
- */
-inline void led_on(void)
-{
-    PTD->PSOR = (1<<4);
-}
-
-/*!
- * \brief Turns off the LED
- *
- * This functions switches off the LED.
- */
-inline void led_off(void)
-{
-    PTD->PCOR = (1<<4);
-}
-
-/*!
- * \brief Toggles the LED
- *
- * This functions toggles the LED.
- */
-inline void led_toggle(void)
-{
-    PTD->PTOR = (1<<4);
+    led_off();
 }
@@ -0,0 +1,134 @@
+/*! ***************************************************************************
+ *
+ * \brief     CPU load, wake-ups and estimated supply current
+ * \file      meter.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "meter.h"
+#include "runtime_stats.h"
+#include "serial.h"
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+// Counters at the start of the current window
+static uint32_t start_total = 0;
+static uint32_t start_idle = 0;
+static uint32_t start_sleep = 0;
+static uint32_t start_wakeups = 0;
+
+/*----------------------------------------------------------------------------*/
+// Local functions
+/*----------------------------------------------------------------------------*/
+static uint32_t permille(const uint32_t part, const uint32_t total)
+{
+    return (total == 0) ? 0 : (uint32_t)(((uint64_t)part * 1000U) / total);
+}
+
+/*----------------------------------------------------------------------------*/
+// Shared functions
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Returns the figures since the previous call and starts a new window
+ *
+ * The first window starts when the scheduler starts. The times come from the
+ * run-time counter of runtime_stats.c, which keeps counting while the CPU
+ * sleeps. The CPU load is the time outside the idle task. The time awake is
+ * the time outside the sleep of the tickless idle, so it also includes the
+ * idle task before it sleeps and the ticks it does not suppress. The current
+ * is estimated from the time awake with METER_RUN_UA and METER_SLEEP_UA.
+ *
+ * \param[out]  m  Figures of the window
+ */
+void meter_sample(meter_t *m)
+{
+    uint32_t total, idle, sleep, wakeups;
+
+    // Read all counters at the same time
+    taskENTER_CRITICAL();
+    {
+        total = ulRunTimeStatsCounter();
+        sleep = ulRunTimeSleepTicks;
+        wakeups = ulRunTimeWakeups;
+    }
+    taskEXIT_CRITICAL();
+
+    idle = ulTaskGetIdleRunTimeCounter();
+
+    const uint32_t d_total = total - start_total;
+    const uint32_t d_idle = idle - start_idle;
+    const uint32_t d_sleep = sleep - start_sleep;
+
+    start_total = total;
+    start_idle = idle;
+    start_sleep = sleep;
+
+    m->window_ms = (uint32_t)(((uint64_t)d_total * 1000U) / RUNTIME_STATS_HZ);
+    m->cpu_permille = 1000U - permille((d_idle < d_total) ? d_idle : d_total, d_total);
+    m->awake_permille = 1000U - permille((d_sleep < d_total) ? d_sleep : d_total, d_total);
+    m->wakeups = wakeups - start_wakeups;
+    m->current_ua = (m->awake_permille * METER_RUN_UA +
+                     (1000U - m->awake_permille) * METER_SLEEP_UA) / 1000U;
+
+    start_wakeups = wakeups;
+}
+
+/*!
+ * \brief Prints the figures since the previous call and starts a new window
+ *
+ * One line, for example
+ * "meter tt 10000 ms cpu 12.3 % awake 14.0 % wakeups 61.2 /s 4041 uA",
+ * which tools/meter_compare.py reads from captures of the serial port.
+ *
+ * \param[in]  name  Name of the application in the line
+ */
+void meter_report(const char *name)
+{
+    // Only used by the calling task, so it is not on its stack
+    static char str[96];
+
+    meter_t m;
+    meter_sample(&m);
+
+    // Wake-ups per second with one decimal
+    const uint32_t rate = (m.window_ms == 0) ? 0 :
+        (uint32_t)(((uint64_t)m.wakeups * 10000U) / m.window_ms);
+
+    snprintf(str, sizeof(str),
+        "meter %s %lu ms cpu %lu.%lu %% awake %lu.%lu %% wakeups %lu.%lu /s %lu uA\r\n",
+        name, (unsigned long)m.window_ms,
+        (unsigned long)(m.cpu_permille / 10), (unsigned long)(m.cpu_permille % 10),
+        (unsigned long)(m.awake_permille / 10), (unsigned long)(m.awake_permille % 10),
+        (unsigned long)(rate / 10), (unsigned long)(rate % 10),
+        (unsigned long)m.current_ua);
+    vSerialPutString(str);
+}
@@ -0,0 +1,76 @@
+/*! ***************************************************************************
+ *
+ * \brief     CPU load, wake-ups and estimated supply current
+ * \file      meter.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef METER_H
+#define METER_H
+
+#include <stdint.h>
+
+/*!
+ * \brief Supply current of the MCU while awake in uA
+ *
+ * Approximately the typical run current of the data sheet at a 48 MHz core
+ * clock, running from flash. Replace it by the current measured at the IDD
+ * jumper J4 of the board.
+ */
+#ifndef METER_RUN_UA
+#define METER_RUN_UA (6100)
+#endif
+
+/*!
+ * \brief Supply current of the MCU in the sleep of the tickless idle in uA
+ *
+ * The tickless idle enters wait mode, approximately the typical wait current
+ * of the data sheet. Replace it by the measured current as well.
+ */
+#ifndef METER_SLEEP_UA
+#define METER_SLEEP_UA (3700)
+#endif
+
+/*!
+ * \brief Figures of one measurement window
+ *
+ * Only the current of the MCU is estimated, the current of the LEDs, the
+ * Oled display and the other parts of the board is not included.
+ */
+typedef struct
+{
+    uint32_t window_ms;      ///< Length of the window
+    uint32_t cpu_permille;   ///< Time not spent in the idle task
+    uint32_t awake_permille; ///< Time not spent in the sleep of the idle task
+    uint32_t wakeups;        ///< Number of sleeps that ended
+    uint32_t current_ua;     ///< Estimated average supply current of the MCU
+}meter_t;
+
+// Function prototypes
+void meter_sample(meter_t *m);
+void meter_report(const char *name);
+
+#endif // METER_H
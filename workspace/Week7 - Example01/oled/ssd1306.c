@@ -77,6 +77,23 @@ uint8_t x = 0;
  */
 uint8_t y = 0;
 
+/*!
+ * \brief Generation of the framebuffer
+ *
+ * Incremented by every function that writes to the framebuffer.
+ */
+static volatile uint32_t generation = 0;
+
+/*!
+ * \brief Generation of the framebuffer that was last sent to the Oled display
+ */
+static uint32_t sent_generation = 0;
+
+/*!
+ * \brief Time in ms of the last frame sent by ssd1306_update_if_dirty()
+ */
+static uint32_t last_frame_ms = 0;
+
 /*!
  * \brief List of commands that will be send to the Oled display upon
  *        initialisation
@@ -118,6 +135,8 @@ void ssd1306_init(void)
         ssd1306_framebuffer[i] = 0;
     }
 
+    generation++;
+
     // Initialize the KL25Z I2C peripheral
     i2c1_init();
 
@@ -187,6 +206,8 @@ void ssd1306_update(void)
         0x22, 0x00, 0x07, // Page address start and end (DEFAULT)
     };
 
+    // Drawing during the transfer marks the framebuffer as changed again
+    sent_generation = generation;
 
     if(!i2c1_write_cmd(SSD1306_SLAVE_ADDRESS, data, sizeof(data)))
     {
@@ -210,6 +231,65 @@ void ssd1306_update(void)
     }
 }
 
+/*!
+ * \brief Sends the framebuffer to the Oled display if needed
+ *
+ * The framebuffer is sent if it changed since the last transfer and at least
+ * SSD1306_MIN_FRAME_MS have elapsed since the last frame of this function.
+ * An unchanged framebuffer is sent again after SSD1306_MAX_FRAME_MS. Call
+ * this function periodically instead of ssd1306_update(), a static screen
+ * then costs no time on the I2C bus.
+ *
+ * \param[in]  now_ms  Current time in ms
+ *
+ * \return true if the framebuffer was sent, false otherwise
+ */
+bool ssd1306_update_if_dirty(const uint32_t now_ms)
+{
+    uint32_t elapsed = now_ms - last_frame_ms;
+
+    if(generation != sent_generation)
+    {
+        if(elapsed < SSD1306_MIN_FRAME_MS)
+        {
+            return false;
+        }
+    }
+    else if((SSD1306_MAX_FRAME_MS == 0) || (elapsed < SSD1306_MAX_FRAME_MS))
+    {
+        return false;
+    }
+
+    last_frame_ms = now_ms;
+    ssd1306_update();
+
+    return true;
+}
+
+/*!
+ * \brief Marks the framebuffer as changed
+ *
+ * The drawing functions do this themselves. Call this function after writing
+ * to ssd1306_framebuffer directly.
+ */
+void ssd1306_invalidate(void)
+{
+    generation++;
+}
+
+/*!
+ * \brief Checks if the framebuffer changed since it was last sent
+ *
+ * A task that only wakes up to send a changed framebuffer uses this to stop
+ * calling ssd1306_update_if_dirty() once the changes have been sent.
+ *
+ * \return true if the framebuffer has not been sent since it changed
+ */
+bool ssd1306_dirty(void)
+{
+    return generation != sent_generation;
+}
+
 /*!
  * \brief Sets the font
  *
@@ -289,6 +369,7 @@ void ssd1306_setinverse(const uint8_t inv)
 void ssd1306_clearscreen(void)
 {
     memset(ssd1306_framebuffer, 0x00, sizeof(ssd1306_framebuffer));
+    generation++;
 }
 
 /*!
@@ -354,6 +435,8 @@ void ssd1306_setpixel(const uint8_t x, const uint8_t y, const pixel_value_t val)
     {
 		ssd1306_framebuffer[x + (y / 8) * SSD1306_WIDTH] &= ~(1 << (y % 8));
 	}
+
+    generation++;
 }
 
 /*!
@@ -653,4 +736,5 @@ void ssd1306_drawline(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
 void ssd1306_drawbitmap(const unsigned char *bitmap)
 {
     memcpy(ssd1306_framebuffer, bitmap, sizeof(ssd1306_framebuffer));
+    generation++;
 }
@@ -86,6 +86,35 @@ void rtc_set(rtc_datetime_t *datetime)
     RTC->SR |= RTC_SR_TCE_MASK;
 }
 
+// Returns the time in seconds, the value of the Time Seconds Register
+uint32_t rtc_seconds(void)
+{
+    return RTC->TSR;
+}
+
+// Enables or disables the interrupt of every second. rtc_init() enables it,
+// an application that only needs the alarm disables it, so the CPU is not
+// woken up every second.
+void rtc_seconds_irq(const bool enable)
+{
+    if(enable)
+    {
+        RTC->IER |= RTC_IER_TSIE_MASK;
+    }
+    else
+    {
+        RTC->IER &= ~RTC_IER_TSIE_MASK;
+    }
+}
+
+// Sets the alarm, xRtcAlarmSemaphore is given when the time, as returned by
+// rtc_seconds(), increments from seconds to seconds + 1. Writing the alarm
+// register also clears a pending alarm.
+void rtc_alarm(const uint32_t seconds)
+{
+    RTC->TAR = seconds;
+}
+
 void RTC_IRQHandler(void)
 {
     // Clear pending interrupts
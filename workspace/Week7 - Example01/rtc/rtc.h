@@ -5,6 +5,8 @@
 #define RTC_H
 
 #include "MKL25Z4.h"
+#include <stdbool.h>
+
 #include "FreeRTOS.h"
 #include "semphr.h"
 
@@ -26,4 +28,8 @@ void rtc_init(void);
 void rtc_get(rtc_datetime_t *datetime);
 void rtc_set(rtc_datetime_t *datetime);
 
+uint32_t rtc_seconds(void);
+void rtc_seconds_irq(const bool enable);
+void rtc_alarm(const uint32_t seconds);
+
 #endif
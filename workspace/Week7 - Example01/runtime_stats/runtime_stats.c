@@ -31,7 +31,19 @@
  *****************************************************************************/
 #include "runtime_stats.h"
 
-volatile uint32_t ulHighFrequencyTicks = 0;
+/*
+ * PIT0 expires at RUNTIME_STATS_HZ and PIT1 is chained to it, so together
+ * they are a 32-bit counter that runs without interrupts. A counter that
+ * interrupts the CPU at 10 kHz would wake it from every sleep of the
+ * tickless idle, and the wake-ups per second could not be measured.
+ */
+
+// Time in counts spent in the sleep of the tickless idle and the number of
+// sleeps, updated by the idle task with interrupts disabled
+volatile uint32_t ulRunTimeSleepTicks = 0;
+volatile uint32_t ulRunTimeWakeups = 0;
+
+static uint32_t ulSleepStart = 0;
 
 void vConfigureTimerForRunTimeStats( void )
 {
@@ -42,36 +54,37 @@ void vConfigureTimerForRunTimeStats( void )
     PIT->MCR &= ~PIT_MCR_MDIS_MASK;
     PIT->MCR |= PIT_MCR_FRZ_MASK;
 
-    // Initialize PIT0 to count down from argument
-    PIT->CHANNEL[0].LDVAL = PIT_LDVAL_TSV(2400-1);
-
-    // No chaining
-    PIT->CHANNEL[0].TCTRL &= ~PIT_TCTRL_CHN_MASK;
+    // PIT0 expires every 100 us of the 24 MHz bus clock, without interrupt
+    PIT->CHANNEL[0].LDVAL = PIT_LDVAL_TSV((24000000UL / RUNTIME_STATS_HZ) - 1);
+    PIT->CHANNEL[0].TCTRL = 0;
 
-    // Generate interrupts
-    PIT->CHANNEL[0].TCTRL |= PIT_TCTRL_TIE_MASK;
+    // PIT1 counts the expirations of PIT0 over the full 32 bits
+    PIT->CHANNEL[1].LDVAL = PIT_LDVAL_TSV(0xFFFFFFFF);
+    PIT->CHANNEL[1].TCTRL = PIT_TCTRL_CHN_MASK;
 
-    /* Enable Interrupts */
-    NVIC_SetPriority(PIT_IRQn, 192); // 0, 64, 128 or 192
-    NVIC_ClearPendingIRQ(PIT_IRQn);
-    NVIC_EnableIRQ(PIT_IRQn);
-
-    // Enable counter
+    // Start the counter first, it waits for the first expiration of PIT0
+    PIT->CHANNEL[1].TCTRL |= PIT_TCTRL_TEN_MASK;
     PIT->CHANNEL[0].TCTRL |= PIT_TCTRL_TEN_MASK;
 }
 
-void PIT_IRQHandler()
+/*!
+ * \brief Marks the start of a sleep of the tickless idle
+ *
+ * Called by configPRE_SLEEP_PROCESSING() with interrupts disabled.
+ */
+void vRunTimeStatsPreSleep( void )
 {
-    //clear pending IRQ
-    NVIC_ClearPendingIRQ(PIT_IRQn);
-
-    // check to see which channel triggered interrupt
-    if (PIT->CHANNEL[0].TFLG & PIT_TFLG_TIF_MASK)
-    {
-        // clear status flag for timer channel 0
-        PIT->CHANNEL[0].TFLG &= PIT_TFLG_TIF_MASK;
+    ulSleepStart = ulRunTimeStatsCounter();
+}
 
-        // Do ISR work
-        ulHighFrequencyTicks++;
-    }
+/*!
+ * \brief Marks the end of a sleep of the tickless idle
+ *
+ * Called by configPOST_SLEEP_PROCESSING() with interrupts disabled, before
+ * the interrupt that ended the sleep runs.
+ */
+void vRunTimeStatsPostSleep( void )
+{
+    ulRunTimeSleepTicks += ulRunTimeStatsCounter() - ulSleepStart;
+    ulRunTimeWakeups++;
 }
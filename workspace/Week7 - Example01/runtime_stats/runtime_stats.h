@@ -34,8 +34,27 @@
 
 #include <MKL25Z4.h>
 
-extern volatile uint32_t ulHighFrequencyTicks;
+/*!
+ * \brief Frequency of the run-time counter in Hz
+ */
+#define RUNTIME_STATS_HZ (10000UL)
+
+extern volatile uint32_t ulRunTimeSleepTicks;
+extern volatile uint32_t ulRunTimeWakeups;
 
 void vConfigureTimerForRunTimeStats( void );
+void vRunTimeStatsPreSleep( void );
+void vRunTimeStatsPostSleep( void );
+
+/*!
+ * \brief Returns the run-time counter, in 1 / RUNTIME_STATS_HZ s
+ *
+ * PIT1 counts the expirations of PIT0 down from 0xFFFFFFFF, so the counter is
+ * its complement and no interrupt is needed to keep it.
+ */
+static inline uint32_t ulRunTimeStatsCounter( void )
+{
+    return ~PIT->CHANNEL[1].CVAL;
+}
 
 #endif // RUNTIME_STATS_H
@@ -42,12 +42,15 @@
 #include "timers.h"
 
 #include "leds.h"
+#include "meter.h"
 #include "rgb.h"
 #include "rtc.h"
 #include "ssd1306.h"
 #include "serial.h"
 #include "switches.h"
 #include "tcrt5000.h"
+#include "tsi.h"
+#include "tt.h"
 
 /*----------------------------------------------------------------------------*/
 // Local defines
@@ -56,6 +59,10 @@
 #define mainN_SLOTS        (20)
 #define mainSLOT_MS        (mainTOTAL_CYCLE_MS / mainN_SLOTS)
 
+// Print the schedule statistics and the CPU load, wake-ups and current every
+// mainREPORT_CYCLES total cycles
+#define mainREPORT_CYCLES  (10)
+
 /*----------------------------------------------------------------------------*/
 // Local type definitions
 /*----------------------------------------------------------------------------*/
@@ -65,6 +72,19 @@ typedef enum
     DOWN,
 }command_t;
 
+typedef enum
+{
+    SLOT_LED_ON,
+    SLOT_LED_OFF,
+    SLOT_OLED,
+    SLOT_IR,
+    SLOT_DT,
+    SLOT_SW,
+    SLOT_TSI,
+    SLOT_CMD,
+    SLOT_N,
+}slot_t;
+
 /*----------------------------------------------------------------------------*/
 // Local function prototypes
 /*----------------------------------------------------------------------------*/
@@ -95,6 +115,21 @@ static TaskHandle_t vCmdTaskHandle;
 
 static volatile uint32_t ulRunningTaskNum = 0;
 
+// The static schedule: name, offset, period and budget in us. Every slot is
+// released in its own minor frame of mainSLOT_MS, tt_init() verifies that the
+// budgets fit.
+static tt_slot_t xSlots[SLOT_N] =
+{
+    [SLOT_LED_ON]  = TT_SLOT("LedOn",   0 * mainSLOT_MS, mainTOTAL_CYCLE_MS,      2000),
+    [SLOT_LED_OFF] = TT_SLOT("LedOff",  1 * mainSLOT_MS, mainTOTAL_CYCLE_MS,      2000),
+    [SLOT_OLED]    = TT_SLOT("Oled",    4 * mainSLOT_MS, mainTOTAL_CYCLE_MS / 4, 30000),
+    [SLOT_IR]      = TT_SLOT("Ir",      2 * mainSLOT_MS, mainTOTAL_CYCLE_MS / 4,  5000),
+    [SLOT_DT]      = TT_SLOT("Dt",      5 * mainSLOT_MS, mainTOTAL_CYCLE_MS,     20000),
+    [SLOT_SW]      = TT_SLOT("Sw",      3 * mainSLOT_MS, mainTOTAL_CYCLE_MS / 2,  2000),
+    [SLOT_TSI]     = TT_SLOT("Tsi",     8 * mainSLOT_MS, mainTOTAL_CYCLE_MS / 2,  5000),
+    [SLOT_CMD]     = TT_SLOT("Cmd",    10 * mainSLOT_MS, mainTOTAL_CYCLE_MS,      2000),
+};
+
 extern uint8_t FreeRTOSDebugConfig[];
 
 /*----------------------------------------------------------------------------*/
@@ -153,6 +188,10 @@ int main(void)
     vQueueAddToRegistry(xRtcAlarmSemaphore, "xRtcAlarmSemaphore");
     vQueueAddToRegistry(xCmdQueue, "xCmdQueue");
 
+    // Releases start one minor cycle from now, all tasks are waiting in
+    // tt_wait() by then
+    tt_init(xSlots, SLOT_N, mainSLOT_MS);
+
     /* Start the scheduler so the tasks start executing. */
     vTaskStartScheduler();
 
@@ -195,14 +234,15 @@ static void vLedOnTask(void *parameters)
     // 24 x 10 bits x 1/921600 s = 0.26 ms
     char str[24];
 
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-//    vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(0 * mainSLOT_MS));
-
     /* As per most tasks, this task is implemented within an infinite loop. */
     for( ;; )
     {
+        // Go into Blocking state until the next release of this slot
+        tt_wait(&xSlots[SLOT_LED_ON]);
+        ulRunningTaskNum = 1;
+
         // For debugging: show info
-        sprintf(str, "% 7u | %s\r\n", xLastWakeTime, __func__);
+        sprintf(str, "% 7u | %s\r\n", xTaskGetTickCount(), __func__);
         vSerialPutString(str);
 
         if(xSemaphoreTake(xOledMutex, pdMS_TO_TICKS(20)) == pdPASS)
@@ -214,10 +254,6 @@ static void vLedOnTask(void *parameters)
 
         // Do work
         led_on();
-
-        // Go into Blocking state for one cycle total time
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(mainTOTAL_CYCLE_MS));
-        ulRunningTaskNum = 1;
     }
 }
 
@@ -227,14 +263,15 @@ static void vLedOffTask(void *parameters)
 {
     char str[24];
 
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(1 * mainSLOT_MS));
-
     /* As per most tasks, this task is implemented within an infinite loop. */
     for( ;; )
     {
+        // Go into Blocking state until the next release of this slot
+        tt_wait(&xSlots[SLOT_LED_OFF]);
+        ulRunningTaskNum = 2;
+
         // For debugging: show info
-        sprintf(str, "% 7u | %s\r\n", xLastWakeTime, __func__);
+        sprintf(str, "% 7u | %s\r\n", xTaskGetTickCount(), __func__);
         vSerialPutString(str);
 
         if(xSemaphoreTake(xOledMutex, pdMS_TO_TICKS(20)) == pdPASS)
@@ -246,10 +283,6 @@ static void vLedOffTask(void *parameters)
 
         // Do work
         led_off();
-
-        // Go into Blocking state for one cycle total time
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(mainTOTAL_CYCLE_MS));
-        ulRunningTaskNum = 2;
     }
 }
 
@@ -259,22 +292,19 @@ static void vOledTask(void *parameters)
 {
     char str[24];
 
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(4 * mainSLOT_MS));
-
     /* As per most tasks, this task is implemented within an infinite loop. */
     for( ;; )
     {
+        // Go into Blocking state until the next release of this slot
+        tt_wait(&xSlots[SLOT_OLED]);
+        ulRunningTaskNum = 5;
+
         // For debugging: show info
-        sprintf(str, "% 7u | %s\r\n", xLastWakeTime, __func__);
+        sprintf(str, "% 7u | %s\r\n", xTaskGetTickCount(), __func__);
         vSerialPutString(str);
 
-        // Do work
-        ssd1306_update();
-
-        // Go into Blocking state for one cycle total time
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(mainTOTAL_CYCLE_MS / 4));
-        ulRunningTaskNum = 5;
+        // Do work, the framebuffer is only sent if it changed
+        ssd1306_update_if_dirty(xTaskGetTickCount() * portTICK_PERIOD_MS);
     }
 }
 
@@ -284,63 +314,47 @@ static void vIrTask(void *parameters)
 {
     char str[24];
 
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(2 * mainSLOT_MS));
-
     /* As per most tasks, this task is implemented within an infinite loop. */
     for( ;; )
     {
+        // Go into Blocking state until the next release of this slot
+        tt_wait(&xSlots[SLOT_IR]);
+        ulRunningTaskNum = 3;
+
         // For debugging: show info
-        sprintf(str, "% 7u | %s\r\n", xLastWakeTime, __func__);
+        sprintf(str, "% 7u | %s\r\n", xTaskGetTickCount(), __func__);
         vSerialPutString(str);
 
         // Do work
 
-        // - AIEN = 0     : Conversion complete interrupt is disabled
-        // - DIFF = 0     : Single-ended conversions and input channels are
-        //                  selected
-        // - ADCH = 01000 : Channel 8
-        ADC0->SC1[0] = ADC_SC1_ADCH(8);
-
-        // Wait for conversion to complete
-        while(!(ADC0->SC1[0] & ADC_SC1_COCO_MASK))
-        {;}
+        // Convert channel 8. The task blocks until the conversion complete
+        // interrupt, instead of polling COCO.
+        uint16_t raw = 0xFFFF;
+        (void)adc_convert(8, ADC_AVG_1, &raw, pdMS_TO_TICKS(2));
 
-        // Read the result and complement
-        uint16_t off_brightness = 0xFFFF - ADC0->R[0];
+        // Complement the result
+        uint16_t off_brightness = 0xFFFF - raw;
 
         // IR LED on
-        PTA->PCOR = (1<<16);
+        gpio_clear(GPIO_A, TCRT5000_IR_MASK);
 
         // Delay to settle down the signal
         vTaskDelay(pdMS_TO_TICKS(1));
 
-        // - AIEN = 0     : Conversion complete interrupt is disabled
-        // - DIFF = 0     : Single-ended conversions and input channels are
-        //                  selected
-        // - ADCH = 01000 : Channel 8
-        ADC0->SC1[0] = ADC_SC1_ADCH(8);
+        // Convert channel 8
+        raw = 0xFFFF;
+        (void)adc_convert(8, ADC_AVG_1, &raw, pdMS_TO_TICKS(2));
 
-        // Wait for conversion to complete
-        while(!(ADC0->SC1[0] & ADC_SC1_COCO_MASK))
-        {;}
-
-        // Read the result and complement
-        uint16_t on_brightness = 0xFFFF - ADC0->R[0];
+        // Complement the result
+        uint16_t on_brightness = 0xFFFF - raw;
 
         // IR LED off
-        PTA->PSOR = (1<<16);
+        gpio_set(GPIO_A, TCRT5000_IR_MASK);
 
         // Process the ADC result
         int32_t result = (int32_t)on_brightness - (int32_t)off_brightness;
         rgb_green_on(result < 2000);
         rgb_red_on(result >= 2000);
-
-        // Go into Blocking state for one cycle total time
-//        sprintf(str, "% 7u | %s Blocking\r\n", xTaskGetTickCount(), __func__);
-//        vSerialPutString(str);
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(mainTOTAL_CYCLE_MS / 4));
-        ulRunningTaskNum = 3;
     }
 }
 
@@ -350,15 +364,17 @@ static void vDtTask(void *pvParameters)
 {
     rtc_datetime_t datetime;
     char str[128];
-
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(5 * mainSLOT_MS));
+    uint32_t cycles = 0;
 
     /* As per most tasks, this task is implemented within an infinite loop. */
     for( ;; )
     {
+        // Go into Blocking state until the next release of this slot
+        tt_wait(&xSlots[SLOT_DT]);
+        ulRunningTaskNum = 6;
+
         // For debugging: show info
-        sprintf(str, "% 7u | %s\r\n", xLastWakeTime, __func__);
+        sprintf(str, "% 7u | %s\r\n", xTaskGetTickCount(), __func__);
         vSerialPutString(str);
 
         if(xSemaphoreTake(xOledMutex, pdMS_TO_TICKS(20)) == pdPASS)
@@ -383,9 +399,13 @@ static void vDtTask(void *pvParameters)
             }
         }
 
-        // Go into Blocking state for one cycle total time
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(mainTOTAL_CYCLE_MS));
-        ulRunningTaskNum = 6;
+        // Print jitter, execution time and overrun statistics of all slots
+        if(++cycles == mainREPORT_CYCLES)
+        {
+            cycles = 0;
+            tt_report();
+            meter_report("tt");
+        }
     }
 }
 
@@ -398,13 +418,14 @@ static void vSwTask(void *parameters)
     const command_t command_up = UP;
     const command_t command_down = DOWN;
 
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(3 * mainSLOT_MS));
-
     for( ;; )
     {
+        // Go into Blocking state until the next release of this slot
+        tt_wait(&xSlots[SLOT_SW]);
+        ulRunningTaskNum = 4;
+
         // For debugging: show info
-        sprintf(str, "% 7u | %s\r\n", xLastWakeTime, __func__);
+        sprintf(str, "% 7u | %s\r\n", xTaskGetTickCount(), __func__);
         vSerialPutString(str);
 
         if(sw_pressed(SW1))
@@ -416,10 +437,6 @@ static void vSwTask(void *parameters)
         {
             xQueueSend(xCmdQueue, &command_up, pdMS_TO_TICKS(10));
         }
-
-        // Go into Blocking state for one cycle total time
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(mainTOTAL_CYCLE_MS / 2));
-        ulRunningTaskNum = 4;
     }
 }
 
@@ -432,126 +449,60 @@ static void vTsiTask(void *parameters)
     const command_t command_up = UP;
     const command_t command_down = DOWN;
 
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(8 * mainSLOT_MS));
-
-    // Enable PTB clock
-    SIM->SCGC5 |= SIM_SCGC5_PORTB_MASK;
-
-    // Set pin to FTM
-    // PTB16: TSI0_CH9, Mux Alt 0 (default)
-    // PTB17: TSI0_CH10, Mux Alt 0 (default)
-    PORTB->PCR[16] &= ~PORT_PCR_MUX_MASK;
-    PORTB->PCR[16] |= PORT_PCR_MUX(0);
-    PORTB->PCR[17] &= ~PORT_PCR_MUX_MASK;
-    PORTB->PCR[17] |= PORT_PCR_MUX(0);
-
-    // Enable TSI Clock
-    SIM->SCGC5 |= SIM_SCGC5_TSI_MASK;
-
-    // Setup general control and status register
-    // - OUTRGF : 1 - Clear Out-of-range flag
-    // - ESOR   : 0 - Out-of-range interrupt is allowed (default)
-    // - MODE   : 0000 - Set TSI in capacitive sensing(non-noise detection) mode
-    //                   (default)
-    // - REFCHRG: 000 - 500 nA reference oscillator charge and discharge current
-    //                  value (default)
-    // - DVOLT  : 00 - DV = 1.03 V; V P = 1.33 V; V m = 0.30 V oscillator's
-    //                 voltage rails (default)
-    // - EXTCHRG: 000 - 500 nA electrode oscillator charge and discharge current
-    //                  (default)
-    // - PS     : 0 - Electrode Oscillator Frequency divided by 1 prescaler
-    //                (default)
-    // - NSCN   : 11111 - 32 scans for each electrode
-    // - TSIEN  : 1 - TSI module enabled
-    // - TSIIEN : 0 - TSI interrupt is disabled (default)
-    // - STPE   : 1 - Allow TSI to continue running in all low power modes
-    // - STM    : 0 - Software trigger scan (default)
-    // - SCNIP  : n/a
-    // - EOSF   : 1 - Clear scan complete flag
-    // - CURSW  : 0 - The current source pair are not swapped (default)
-    TSI0->GENCS =
-        TSI_GENCS_OUTRGF(1) |
-        TSI_GENCS_NSCN(31) |
-        TSI_GENCS_TSIEN(1) |
-        TSI_GENCS_STPE(1) |
-        TSI_GENCS_EOSF(1);
-
-    uint32_t channel09_result;
-    uint32_t channel10_result;
+    // Touch events are produced by the TSI interrupt handler in between the
+    // releases of this slot
+    QueueHandle_t xTsiQueue = xQueueCreate(8, sizeof(tsi_event_t));
+    configASSERT(xTsiQueue != NULL);
+
+    tsi_init(xTsiQueue);
+
+    tsi_event_t event;
 
     /* As per most tasks, this task is implemented in an infinite loop. */
     for( ;; )
     {
+        // Go into Blocking state until the next release of this slot
+        tt_wait(&xSlots[SLOT_TSI]);
+        ulRunningTaskNum = 9;
+
         // For debugging: show info
-        sprintf(str, "% 7u | %s\r\n", xLastWakeTime, __func__);
+        sprintf(str, "% 7u | %s\r\n", xTaskGetTickCount(), __func__);
         vSerialPutString(str);
 
-        // ------------------------------------------------------------------------
-        // Scan channel 9
-        // ------------------------------------------------------------------------
-
-        // Select channel 9
-        TSI0->DATA = TSI_DATA_TSICH(9);
-
-        // Start a scan
-        TSI0->DATA |= TSI_DATA_SWTS_MASK;
-
-        // Wait for scan complete
-        while(!(TSI0->GENCS & TSI_GENCS_EOSF_MASK))
-        {;}
-
-        // Read TSI Conversion Counter Value, masking all other bits
-        channel09_result = TSI0->DATA & TSI_DATA_TSICNT_MASK;
-
-        // Clear scan complete flag
-        TSI0->GENCS |= TSI_GENCS_EOSF_MASK;
-
-        // Wait some time before sampling the next channel
-        vTaskDelay(pdMS_TO_TICKS(1));
-
-        // ------------------------------------------------------------------------
-        // Scan channel 10
-        // ------------------------------------------------------------------------
-
-        // Select channel 10
-        TSI0->DATA = TSI_DATA_TSICH(10);
-
-        // Start a scan
-        TSI0->DATA |= TSI_DATA_SWTS_MASK;
-
-        // Wait for scan complete
-        while(!(TSI0->GENCS & TSI_GENCS_EOSF_MASK))
-        {;}
-
-        // Read TSI Conversion Counter Value, masking all other bits
-        channel10_result = TSI0->DATA & TSI_DATA_TSICNT_MASK;
+        // Send a command for every touch since the previous release and show
+        // the last slider position
+        bool moved = false;
+        tsi_event_t slide;
 
-        // Clear scan complete flag
-        TSI0->GENCS |= TSI_GENCS_EOSF_MASK;
+        while(xQueueReceive(xTsiQueue, &event, 0))
+        {
+            if(event.type == TSI_POSITION)
+            {
+                slide = event;
+                moved = true;
+                continue;
+            }
 
-        // ------------------------------------------------------------------------
-        // Calculate the scan results
-        // ------------------------------------------------------------------------
-        // The variables channel09_result and channel10_result now hold the
-        // accumulated scan counter values (32 scans as set by TSI_GENCS_NSCN).
-        // The following threshold value is determined by using the debugger.
-        const uint32_t threshold = 0x00000380;
+            if(event.type != TSI_TOUCH)
+            {
+                continue;
+            }
 
-        // Send command according the scan results
-        if(channel09_result > threshold)
-        {
-            xQueueSend(xCmdQueue, &command_down, pdMS_TO_TICKS(10));
+            if(event.channel == 9)
+            {
+                xQueueSend(xCmdQueue, &command_down, 0);
+            }
+            else
+            {
+                xQueueSend(xCmdQueue, &command_up, 0);
+            }
         }
 
-        if(channel10_result > threshold)
+        if(moved)
         {
-            xQueueSend(xCmdQueue, &command_up, pdMS_TO_TICKS(10));
+            sprintf(str, "  slider %3u %+5d\r\n", slide.position, slide.velocity);
+            vSerialPutString(str);
         }
-
-        // Go into Blocking state for one cycle total time
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(mainTOTAL_CYCLE_MS / 2));
-        ulRunningTaskNum = 9;
     }
 }
 
@@ -563,15 +514,16 @@ static void vCmdTask(void *parameters)
     // 24 x 10 bits x 1/921600 s = 0.26 ms
     char str[24];
 
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(10 * mainSLOT_MS));
-
     command_t command;
 
     for( ;; )
     {
+        // Go into Blocking state until the next release of this slot
+        tt_wait(&xSlots[SLOT_CMD]);
+        ulRunningTaskNum = 11;
+
         // For debugging: show info
-        sprintf(str, "% 7u | %s\r\n", xLastWakeTime, __func__);
+        sprintf(str, "% 7u | %s\r\n", xTaskGetTickCount(), __func__);
         vSerialPutString(str);
 
         if(xSemaphoreTake(xOledMutex, pdMS_TO_TICKS(20)) == pdPASS)
@@ -591,9 +543,5 @@ static void vCmdTask(void *parameters)
                 xSemaphoreGive(xOledMutex);
             }
         }
-
-        // Go into Blocking state for one cycle total time
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(mainTOTAL_CYCLE_MS));
-        ulRunningTaskNum = 11;
     }
 }
@@ -0,0 +1,505 @@
+/*! ***************************************************************************
+ *
+ * \brief     Event-driven variant of the FreeRTOS demo for FRDM-KL25Z
+ * \file      main_event.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <MKL25Z4.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "semphr.h"
+#include "task.h"
+
+#include "adc.h"
+#include "leds.h"
+#include "meter.h"
+#include "rgb.h"
+#include "rtc.h"
+#include "ssd1306.h"
+#include "serial.h"
+#include "switches.h"
+#include "tcrt5000.h"
+#include "tsi.h"
+
+/*
+ * The same application as main.c, without the static schedule. No task runs
+ * periodically, every task blocks until the event it handles:
+ *
+ * - Sw       a press of a switch, from the pin interrupt of port D
+ * - Tsi      a touch or a slider movement, from the TSI interrupt
+ * - Cmd      a command of Sw or Tsi, the command is shown on the display
+ * - Ir       a change of the object in front of the TCRT5000, from the
+ *            compare function of ADC0
+ * - Clock    the start of a minute, from the RTC alarm
+ * - Display  a change of the framebuffer, notified by the drawing tasks
+ * - Log      a log line, queued by the other tasks
+ *
+ * The interrupt of every second of the RTC is disabled and there is no LED
+ * heartbeat, so the tickless idle sleeps until one of these events. The Clock
+ * task prints the line of meter_report() every minute, main.c prints it with
+ * the schedule report, compare both with tools/meter_compare.py.
+ */
+
+/*----------------------------------------------------------------------------*/
+// Local defines
+/*----------------------------------------------------------------------------*/
+// Presses of the same switch within this time are contact bounce
+#define mainSW_DEBOUNCE_MS  (50)
+
+// A shown command is cleared after this time
+#define mainCMD_SHOW_MS     (1000)
+
+// Difference of the ADC results with the IR LED off and on at which an object
+// is in front of the TCRT5000, as in main.c
+#define mainIR_DELTA        (2000)
+
+// Time after which the ambient light is measured again
+#define mainIR_AMBIENT_MS   (1000)
+
+#define mainIR_CHANNEL      (8)
+
+// Maximum time to wait for the Oled display
+#define mainOLED_TIMEOUT    (pdMS_TO_TICKS(50))
+
+#define mainLOG_QUEUE_LEN   (16)
+
+#define mainPRIO_INPUT      (3)
+#define mainPRIO_APP        (2)
+#define mainPRIO_LOG        (1)
+
+/*----------------------------------------------------------------------------*/
+// Local type definitions
+/*----------------------------------------------------------------------------*/
+typedef enum
+{
+    UP,
+    DOWN,
+}command_t;
+
+// A log line, formatted by the Log task. The format has up to two %ld.
+typedef struct
+{
+    TickType_t tick;
+    const char *fmt;
+    long a;
+    long b;
+}log_entry_t;
+
+/*----------------------------------------------------------------------------*/
+// Local function prototypes
+/*----------------------------------------------------------------------------*/
+static void vSwTask(void *parameters);
+static void vTsiTask(void *parameters);
+static void vCmdTask(void *parameters);
+static void vIrTask(void *parameters);
+static void vClockTask(void *parameters);
+static void vDisplayTask(void *parameters);
+static void vLogTask(void *parameters);
+
+static void vLog(const char *fmt, const long a, const long b);
+static void vDisplayChanged(void);
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+static SemaphoreHandle_t xOledMutex;
+
+static QueueHandle_t xCmdQueue;
+static QueueHandle_t xSwQueue;
+static QueueHandle_t xLogQueue;
+
+static TaskHandle_t vDisplayTaskHandle;
+
+// Log lines that did not fit in the queue
+static volatile uint32_t ulLogDropped = 0;
+
+extern uint8_t FreeRTOSDebugConfig[];
+
+/*----------------------------------------------------------------------------*/
+// Main application
+/*----------------------------------------------------------------------------*/
+int main(void)
+{
+    // Make sure this variable is not optimized out by the linker. If this is
+    // Optimized out, the debugger doens't show the tasks as separate threads
+    if(FreeRTOSDebugConfig[0] == 0)
+    {
+        for(;;);
+    }
+
+    xRtcOneSecondSemaphore = xSemaphoreCreateBinary();
+    xRtcAlarmSemaphore = xSemaphoreCreateBinary();
+
+    rgb_init();
+    led_init();
+    tcrt5000_init();
+    rtc_init();
+    sw_init();
+    xSerialPortInit(921600, 128);
+
+    // Only the alarm wakes up the CPU
+    rtc_seconds_irq(false);
+
+    rtc_datetime_t datetime;
+    datetime.year   = 2022U;
+    datetime.month  = 2U;
+    datetime.day    = 22U;
+    datetime.hour   = 12U;
+    datetime.minute = 0;
+    datetime.second = 0;
+    rtc_set(&datetime);
+
+    ssd1306_init();
+    ssd1306_setorientation(1);
+    ssd1306_setfont(Monospaced_plain_12);
+    ssd1306_clearscreen();
+    ssd1306_putstring(0, 0, "Event-driven");
+
+    vSerialPutString("\r\nFRDM-KL25Z FreeRTOS demo Week 7 - Example 01, event-driven\r\n");
+    vSerialPutString("By Hugo Arends\r\n\r\n");
+
+    xOledMutex = xSemaphoreCreateMutex();
+    xCmdQueue = xQueueCreate(10, sizeof(command_t));
+    xSwQueue = xQueueCreate(8, sizeof(sw_t));
+    xLogQueue = xQueueCreate(mainLOG_QUEUE_LEN, sizeof(log_entry_t));
+    configASSERT((xOledMutex != NULL) && (xCmdQueue != NULL) &&
+                 (xSwQueue != NULL) && (xLogQueue != NULL));
+
+    vQueueAddToRegistry(xOledMutex, "xOledMutex");
+    vQueueAddToRegistry(xRtcAlarmSemaphore, "xRtcAlarmSemaphore");
+    vQueueAddToRegistry(xCmdQueue, "xCmdQueue");
+    vQueueAddToRegistry(xSwQueue, "xSwQueue");
+    vQueueAddToRegistry(xLogQueue, "xLogQueue");
+
+    xTaskCreate(vSwTask,      "vSwTask",        configMINIMAL_STACK_SIZE, NULL, mainPRIO_INPUT, NULL);
+    xTaskCreate(vTsiTask,     "vTsiTask",       configMINIMAL_STACK_SIZE, NULL, mainPRIO_INPUT, NULL);
+    xTaskCreate(vCmdTask,     "vCmdTask",       configMINIMAL_STACK_SIZE, NULL, mainPRIO_INPUT, NULL);
+    xTaskCreate(vIrTask,      "vIrTask",        configMINIMAL_STACK_SIZE, NULL, mainPRIO_APP,   NULL);
+    xTaskCreate(vClockTask,   "vClockTask",   2*configMINIMAL_STACK_SIZE, NULL, mainPRIO_APP,   NULL);
+    xTaskCreate(vDisplayTask, "vDispTask",      configMINIMAL_STACK_SIZE, NULL, mainPRIO_APP,   &vDisplayTaskHandle);
+    xTaskCreate(vLogTask,     "vLogTask",     2*configMINIMAL_STACK_SIZE, NULL, mainPRIO_LOG,   NULL);
+
+    // Presses are queued from now on, the Sw task receives them once the
+    // scheduler runs
+    sw_irq_init(xSwQueue);
+
+    /* Start the scheduler so the tasks start executing. */
+    vTaskStartScheduler();
+
+    /* If all is well then main() will never reach here as the scheduler will
+    now be running the tasks. If main() does reach here then it is likely that
+    there was insufficient heap memory available for the idle task to be created.
+    Chapter 2 provides more information on heap memory management. */
+    for( ;; );
+}
+
+void vApplicationIdleHook( void )
+{
+    // Nothing to do, the tickless idle sleeps after the hook returns
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Queues a log line for the Log task
+ *
+ * The line is formatted and sent by the Log task at the lowest priority, so
+ * the calling task does not wait for the serial port. \p fmt must be a string
+ * literal. A line that does not fit in the queue is counted and dropped.
+ */
+static void vLog(const char *fmt, const long a, const long b)
+{
+    const log_entry_t entry =
+    {
+        .tick = xTaskGetTickCount(),
+        .fmt = fmt,
+        .a = a,
+        .b = b,
+    };
+
+    if(xQueueSend(xLogQueue, &entry, 0) != pdPASS)
+    {
+        ulLogDropped++;
+    }
+}
+
+/*!
+ * \brief Wakes up the Display task after drawing in the framebuffer
+ */
+static void vDisplayChanged(void)
+{
+    xTaskNotifyGive(vDisplayTaskHandle);
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void vSwTask(void *parameters)
+{
+    const command_t command_up = UP;
+    const command_t command_down = DOWN;
+
+    TickType_t last[N_SWITCHES];
+    for(int i=0; i<N_SWITCHES; i++)
+    {
+        last[i] = xTaskGetTickCount() - pdMS_TO_TICKS(mainSW_DEBOUNCE_MS);
+    }
+
+    sw_t sw;
+
+    for( ;; )
+    {
+        // Go into Blocking state until a switch is pressed
+        xQueueReceive(xSwQueue, &sw, portMAX_DELAY);
+
+        // The edges of the contact bounce are ignored
+        const TickType_t now = xTaskGetTickCount();
+        if((now - last[sw]) < pdMS_TO_TICKS(mainSW_DEBOUNCE_MS))
+        {
+            continue;
+        }
+
+        last[sw] = now;
+
+        vLog("SW%ld pressed\r\n", (long)sw + 1, 0);
+        xQueueSend(xCmdQueue, (sw == SW1) ? &command_down : &command_up,
+            pdMS_TO_TICKS(10));
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void vTsiTask(void *parameters)
+{
+    const command_t command_up = UP;
+    const command_t command_down = DOWN;
+
+    // Touch events are produced by the TSI interrupt handler
+    QueueHandle_t xTsiQueue = xQueueCreate(8, sizeof(tsi_event_t));
+    configASSERT(xTsiQueue != NULL);
+
+    tsi_init(xTsiQueue);
+
+    tsi_event_t event;
+
+    for( ;; )
+    {
+        // Go into Blocking state until a touch event
+        xQueueReceive(xTsiQueue, &event, portMAX_DELAY);
+
+        if(event.type == TSI_POSITION)
+        {
+            vLog("  slider %3ld %+5ld\r\n", event.position, event.velocity);
+        }
+        else if(event.type == TSI_TOUCH)
+        {
+            xQueueSend(xCmdQueue, (event.channel == 9) ? &command_down : &command_up, 0);
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void vCmdTask(void *parameters)
+{
+    command_t command;
+    bool shown = false;
+
+    for( ;; )
+    {
+        // Go into Blocking state until a command, or until the shown command
+        // is cleared
+        const bool received = xQueueReceive(xCmdQueue, &command,
+            shown ? pdMS_TO_TICKS(mainCMD_SHOW_MS) : portMAX_DELAY) == pdPASS;
+
+        if(xSemaphoreTake(xOledMutex, mainOLED_TIMEOUT) == pdPASS)
+        {
+            ssd1306_setfont(Monospaced_plain_12);
+            ssd1306_putstring(0, 15, received ? ((command == UP) ? "Up  " : "Down") : "    ");
+            xSemaphoreGive(xOledMutex);
+
+            vDisplayChanged();
+        }
+
+        shown = received;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Instead of measuring the reflection four times per second, the IR LED is
+ * kept on and ADC0 compares the reflection in hardware. The CPU is only woken
+ * up when an object appears or disappears, and once per mainIR_AMBIENT_MS to
+ * measure the ambient light again. The IR LED and ADC0 draw current all the
+ * time then, which is not included in the estimate of meter_report(). On a
+ * battery, the LED current can be more than the CPU saves, measure it before
+ * choosing this over the periodic measurement of main.c.
+ */
+static void vIrTask(void *parameters)
+{
+    bool object = false;
+
+    rgb_green_on(true);
+    rgb_red_on(false);
+
+    for( ;; )
+    {
+        // Measure the ambient light with the IR LED off
+        uint16_t off_raw = 0xFFFF;
+        (void)adc_convert(mainIR_CHANNEL, ADC_AVG_1, &off_raw, pdMS_TO_TICKS(2));
+
+        // A reflection lowers the result, the threshold is the result at which
+        // the brightness is mainIR_DELTA above the ambient light
+        const uint16_t threshold = (off_raw > mainIR_DELTA) ? (off_raw - mainIR_DELTA) : 0;
+
+        // IR LED on
+        gpio_clear(GPIO_A, TCRT5000_IR_MASK);
+
+        // Delay to settle down the signal
+        vTaskDelay(pdMS_TO_TICKS(1));
+
+        // Go into Blocking state until the reflection changes
+        uint16_t raw;
+        const bool changed = adc_compare(mainIR_CHANNEL, ADC_AVG_4,
+            object ? ADC_CMP_ABOVE : ADC_CMP_BELOW, threshold, &raw,
+            pdMS_TO_TICKS(mainIR_AMBIENT_MS));
+
+        // IR LED off
+        gpio_set(GPIO_A, TCRT5000_IR_MASK);
+
+        if(changed)
+        {
+            object = !object;
+
+            rgb_green_on(!object);
+            rgb_red_on(object);
+
+            vLog(object ? "object at %ld\r\n" : "no object at %ld\r\n",
+                (long)off_raw - (long)raw, 0);
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void vClockTask(void *pvParameters)
+{
+    rtc_datetime_t datetime;
+    char str[24];
+
+    for( ;; )
+    {
+        rtc_get(&datetime);
+        snprintf(str, sizeof(str), "%04hu-%02hu-%02hu %02hu:%02hu",
+            datetime.year, datetime.month, datetime.day,
+            datetime.hour, datetime.minute);
+
+        if(xSemaphoreTake(xOledMutex, mainOLED_TIMEOUT) == pdPASS)
+        {
+            ssd1306_setfont(Monospaced_plain_10);
+            ssd1306_putstring(0, 51, str);
+            xSemaphoreGive(xOledMutex);
+
+            vDisplayChanged();
+        }
+
+        // The alarm is raised when the seconds increment past the alarm
+        // time, set it to the last second of this minute
+        const uint32_t now = rtc_seconds();
+        rtc_alarm(now - (now % 60) + 59);
+
+        // Go into Blocking state until the next minute
+        xSemaphoreTake(xRtcAlarmSemaphore, portMAX_DELAY);
+
+        meter_report("event");
+
+        if(ulLogDropped != 0)
+        {
+            vLog("%ld log lines dropped\r\n", (long)ulLogDropped, 0);
+            ulLogDropped = 0;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Unlike the Oled task of main.c, an unchanged framebuffer is not sent again
+ * after SSD1306_MAX_FRAME_MS, the display is only restored with the next
+ * change after a reset of the display.
+ */
+static void vDisplayTask(void *parameters)
+{
+    for( ;; )
+    {
+        // Go into Blocking state until the framebuffer changed
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Changes within SSD1306_MIN_FRAME_MS of the previous frame are sent
+        // together with the next one
+        while(ssd1306_dirty())
+        {
+            bool sent = false;
+
+            if(xSemaphoreTake(xOledMutex, mainOLED_TIMEOUT) == pdPASS)
+            {
+                sent = ssd1306_update_if_dirty(xTaskGetTickCount() * portTICK_PERIOD_MS);
+                xSemaphoreGive(xOledMutex);
+            }
+
+            if(!sent)
+            {
+                vTaskDelay(pdMS_TO_TICKS(SSD1306_MIN_FRAME_MS));
+            }
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void vLogTask(void *parameters)
+{
+    // Sending a maximum of 64 characters takes
+    // 64 x 10 bits x 1/921600 s = 0.69 ms
+    char str[64];
+
+    log_entry_t entry;
+
+    for( ;; )
+    {
+        // Go into Blocking state until a line is queued
+        xQueueReceive(xLogQueue, &entry, portMAX_DELAY);
+
+        int n = snprintf(str, sizeof(str), "%7lu | ", (unsigned long)entry.tick);
+        snprintf(&str[n], sizeof(str) - n, entry.fmt, entry.a, entry.b);
+
+        vSerialPutString(str);
+    }
+}
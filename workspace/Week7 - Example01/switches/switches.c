@@ -30,11 +30,15 @@
  *
  *****************************************************************************/
 #include "switches.h"
+#include "gpio.h"
 
 static PORT_Type * port_mapping[N_SWITCHES] = {PORTD, PORTD};
-static GPIO_Type * gpio_mapping[N_SWITCHES] = {PTD,   PTD};
+static gpio_t *    gpio_mapping[N_SWITCHES] = {GPIO_D, GPIO_D};
 static uint8_t     pin_mapping[N_SWITCHES]  = {3,     5};
 
+// Queue of the pressed switches, set by sw_irq_init()
+static QueueHandle_t sw_queue = NULL;
+
 /*!
  * \brief Initialises the switches on the shield
  *
@@ -60,7 +64,7 @@ void sw_init(void)
     // Set port pins to inputs
     for(int i=0; i<N_SWITCHES; i++)
     {
-        gpio_mapping[i]->PDDR &= ~(1<<pin_mapping[i]);
+        gpio_input(gpio_mapping[i], 1UL << pin_mapping[i]);
     }
 }
 
@@ -78,5 +82,64 @@ void sw_init(void)
 bool sw_pressed(const sw_t sw)
 {
     // If the key is pressed, the bit at that position will read logic 0
-    return ((gpio_mapping[sw]->PDIR & (1<<pin_mapping[sw])) == 0);
+    return !gpio_read(gpio_mapping[sw], 1UL << pin_mapping[sw]);
+}
+
+/*!
+ * \brief Enables the pin interrupts of the switches
+ *
+ * Every falling edge of a switch, a press, sends its ::sw_t to \p queue. The
+ * contacts bounce, so a press can send the same switch several times. The
+ * receiving task debounces, for example by ignoring a switch for some time
+ * after it was received. Call sw_init() first.
+ *
+ * \param[in]  queue  Queue of ::sw_t items
+ */
+void sw_irq_init(QueueHandle_t queue)
+{
+    sw_queue = queue;
+
+    // - IRQC[3:0] = 1010 : Interrupt on falling edge
+    // - ISF = 1          : Clear a pending flag
+    for(int i=0; i<N_SWITCHES; i++)
+    {
+        port_mapping[i]->PCR[pin_mapping[i]] =
+            (port_mapping[i]->PCR[pin_mapping[i]] & ~PORT_PCR_IRQC_MASK) |
+            PORT_PCR_IRQC(0b1010) | PORT_PCR_ISF_MASK;
+    }
+
+    // Enable the interrupt in the NVIC
+    NVIC_SetPriority(PORTD_IRQn, 128);
+    NVIC_ClearPendingIRQ(PORTD_IRQn);
+    NVIC_EnableIRQ(PORTD_IRQn);
+}
+
+/*!
+ * \brief Port D interrupt handler
+ *
+ * Sends every switch of which the flag is set to the queue of sw_irq_init().
+ */
+void PORTD_IRQHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    NVIC_ClearPendingIRQ(PORTD_IRQn);
+
+    for(sw_t sw=SW1; sw<N_SWITCHES; sw++)
+    {
+        const uint32_t mask = 1UL << pin_mapping[sw];
+
+        if(port_mapping[sw]->ISFR & mask)
+        {
+            // Writing a one clears the flag
+            port_mapping[sw]->ISFR = mask;
+
+            if(sw_queue != NULL)
+            {
+                (void)xQueueSendFromISR(sw_queue, &sw, &xHigherPriorityTaskWoken);
+            }
+        }
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
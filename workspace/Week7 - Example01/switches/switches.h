@@ -35,6 +35,9 @@
 #include <MKL25Z4.h>
 #include <stdbool.h>
 
+#include "FreeRTOS.h"
+#include "queue.h"
+
 /// The number of keys available on the shield
 #define N_SWITCHES (2)
 
@@ -48,5 +51,6 @@ typedef enum
 // Function prototypes
 void sw_init(void);
 bool sw_pressed(const sw_t sw); 
+void sw_irq_init(QueueHandle_t queue);
 
 #endif // SWITCHES_H
@@ -40,7 +40,7 @@ TaskHandle_t xADCTaskHandle;
  * This functions initializes the TCRT5000 on the shield.
  * - PTA16 is configured as an output pin
  * - PTB0 is configured as an analog input (ADC channel 8)
- * - TPM1 is configured to trigger an ADC conversion every 50 ms
+ * - ADC0 is initialised for software triggered conversions by adc_init()
  */
 void tcrt5000_init(void)
 {
@@ -53,10 +53,10 @@ void tcrt5000_init(void)
     // pin.
     PORTA->PCR[16] &= ~0x7FF;
     PORTA->PCR[16] |= PORT_PCR_MUX(1) | PORT_PCR_PE(1);
-    PTA->PDDR |= (1<<16);
+    gpio_output(GPIO_A, TCRT5000_IR_MASK);
 
     // IR LED off
-    PTA->PSOR = (1<<16);
+    gpio_set(GPIO_A, TCRT5000_IR_MASK);
 
     // The output of the transistor is connected to PTB0. Configure the pin as
     // ADC input pin (channel 8).
@@ -64,22 +64,6 @@ void tcrt5000_init(void)
 
     // ------------------------------------------------------------------------
 
-    // Enable clock to ADC0
-    SIM->SCGC6 |= SIM_SCGC6_ADC0(1);
-
-    // Configure ADC
-    // - ADLPC = 1        : Low-power configuration. The power is reduced at
-    //                      the expense of maximum clock speed.
-    // - ADIV[1:0] = 00   : The divide ratio is 1 and the clock rate is input
-    //                      clock.
-    // - ADLSMP = 1       : Long sample time.
-    // - MODE[1:0] = 11   : Single-ended 16-bit conversion
-    // - ADICLK[1:0] = 01 : (Bus clock)/2
-    ADC0->CFG1 = 0x9D;
-
-    // - ADTRG = 0   : Software trigger selected
-    // - ACFE  = 0   : Compare function disabled
-    // - DMAEN = 0   : DMA is disabled
-    // - REFSEL = 00 : Default voltage reference pin pair
-    ADC0->SC2 = 0;
+    // ADC0 is owned by the conversion service, see adc_convert()
+    adc_init();
 }
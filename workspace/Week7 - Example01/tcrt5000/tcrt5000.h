@@ -36,6 +36,14 @@
 #include "FreeRTOS.h"
 #include "semphr.h"
 
+#include "adc.h"
+#include "gpio.h"
+
+/*!
+ * \brief Pin of the IR LED, PTA16, the LED is on when the pin is low
+ */
+#define TCRT5000_IR_MASK (1UL << 16)
+
 extern TaskHandle_t xADCTaskHandle;
 
 // Function prototypes
@@ -29,47 +29,86 @@
  *            OTHER DEALINGS IN THE SOFTWARE.
  *
  *****************************************************************************/
+#include <stddef.h>
+
 #include "timer.h"
 
 /*----------------------------------------------------------------------------*/
 // Local variables
 /*----------------------------------------------------------------------------*/
+static tim_callback_t tim_callback = NULL;
 
-void tim_init(void)
+/*!
+ * \brief Starts TPM1 as a periodic interrupt source
+ *
+ * The counter runs at TIM_CLOCK_HZ and overflows every period_us. On every
+ * overflow the callback is called from the interrupt handler. The period must
+ * not exceed TIM_MAX_PERIOD_US.
+ *
+ * \param[in]  period_us  Overflow period in us
+ * \param[in]  callback   Function called on every overflow, may be NULL
+ */
+void tim_init(const uint32_t period_us, tim_callback_t callback)
 {
+    tim_callback = callback;
+
     // Clock to TIM1 on
     SIM->SCGC6 |= SIM_SCGC6_TPM1(1);
 
-    // 48 MHz / 48000 = 1kHz
-//    TPM1->MOD = (48000-1);
-    TPM1->MOD = 0xFFFF;
+    // Stop the counter before changing the prescaler
+    TPM1->SC = 0;
+    TPM1->CNT = 0;
 
-    // Divide by 1 Prescale Factor
-//    TPM1->SC &= ~TPM_SC_PS_MASK;
-    TPM1->SC |= TPM_SC_PS(0b111);
+    // 48 MHz / 128 = 375 kHz
+    TPM1->MOD = ((period_us * (TIM_CLOCK_HZ / 1000UL)) / 1000UL) - 1;
 
+    // Divide by 128 Prescale Factor
+    TPM1->SC = TPM_SC_PS(0b111);
 
+    // Clear and enable the timer overflow interrupt
+    TPM1->STATUS = TPM_STATUS_TOF(1);
+    TPM1->SC |= TPM_SC_TOIE(1);
 
-//    // Timer overflow interrupt enable
-//    TPM1->SC |= TPM_SC_TOIE(1);
+    // Enable Interrupts
+    NVIC_SetPriority(TPM1_IRQn, 64); // 0, 64, 128 or 192
+    NVIC_ClearPendingIRQ(TPM1_IRQn);
+    NVIC_EnableIRQ(TPM1_IRQn);
 
     // Counter increments on every LPTPM counter clock
     TPM1->SC |= TPM_SC_CMOD(1);
+}
 
-//    // Enable Interrupts
-//    NVIC_SetPriority(TPM1_IRQn, 0);
-//    NVIC_ClearPendingIRQ(TPM1_IRQn);
-//    NVIC_EnableIRQ(TPM1_IRQn);
+/*!
+ * \brief Returns the number of TIM_CLOCK_HZ counts since the last overflow
+ */
+uint32_t tim_count(void)
+{
+    return TPM1->CNT;
 }
 
-void TPM1_IRQHandler(void)
+/*!
+ * \brief Returns true if an overflow occurred that is not handled yet
+ *
+ * Used together with tim_count() with interrupts disabled, to detect that
+ * the counter wrapped after the last call of the callback.
+ */
+bool tim_pending(void)
 {
+    return (TPM1->STATUS & TPM_STATUS_TOF(1)) != 0;
+}
 
+void TPM1_IRQHandler(void)
+{
     NVIC_ClearPendingIRQ(TPM1_IRQn);
 
     if(TPM1->STATUS & TPM_STATUS_TOF(1))
     {
         // Reset the interrupt flag
         TPM1->STATUS = TPM_STATUS_TOF(1);
+
+        if(tim_callback != NULL)
+        {
+            tim_callback();
+        }
     }
 }
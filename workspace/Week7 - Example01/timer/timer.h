@@ -33,11 +33,29 @@
 #define TIM_H
 
 #include <MKL25Z4.h>
+#include <stdbool.h>
+
+/*!
+ * \brief TPM1 counter frequency: 48 MHz / 128 prescaler
+ */
+#define TIM_CLOCK_HZ (375000UL)
+
+/*!
+ * \brief Longest period in us that fits in the 16-bit TPM1 modulo register
+ */
+#define TIM_MAX_PERIOD_US ((0x10000UL * 1000UL) / (TIM_CLOCK_HZ / 1000UL))
+
+/*!
+ * \brief Function called from TPM1_IRQHandler() on every overflow
+ */
+typedef void (*tim_callback_t)(void);
 
 /*----------------------------------------------------------------------------*/
 // Shared variables
 /*----------------------------------------------------------------------------*/
 
-void tim_init(void);
+void tim_init(const uint32_t period_us, tim_callback_t callback);
+uint32_t tim_count(void);
+bool tim_pending(void);
 
 #endif // TIM_H
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""Compares the CPU load, wake-ups and supply current of two variants of the
+application, from captures of the serial port.
+
+Every capture holds the lines of meter_report() (meter/meter.c), for example
+"meter tt 10000 ms cpu 12.3 % awake 14.0 % wakeups 61.2 /s 4041 uA". The
+first line of a capture is left out, its window includes the startup. The
+other windows are averaged, weighted by their length, so captures with
+windows of a different length can be compared.
+
+The current is the estimate of meter_report() from the time awake and is
+only the current of the MCU. Measure the current of the board at the IDD
+jumper J4 to include the LEDs, the IR LED of the TCRT5000 and the display,
+and give it with --measured=<uA>,<uA> to show it in the table.
+
+Usage:
+    meter_compare.py [--measured=<uA>,<uA>] <capture.txt> <capture.txt>
+
+Typically the capture of cmake_week_7_example01.elf first and that of
+cmake_week_7_example01_event.elf second.
+"""
+
+import re
+import sys
+
+LINE_RE = re.compile(r"meter (\S+) (\d+) ms cpu ([\d.]+) % awake ([\d.]+) % "
+                     r"wakeups ([\d.]+) /s (\d+) uA")
+
+
+def read_capture(path):
+    windows = []
+    with open(path, encoding="latin-1") as f:
+        for line in f:
+            m = LINE_RE.search(line)
+            if m:
+                windows.append({"name": m.group(1),
+                                "ms": int(m.group(2)),
+                                "cpu": float(m.group(3)),
+                                "awake": float(m.group(4)),
+                                "wakeups": float(m.group(5)),
+                                "ua": int(m.group(6))})
+
+    # The first window starts with the scheduler and includes the startup
+    if len(windows) > 1:
+        windows = windows[1:]
+    return windows
+
+
+def average(windows):
+    total = sum(w["ms"] for w in windows)
+    result = {"name": windows[0]["name"], "ms": total, "windows": len(windows)}
+    for key in ("cpu", "awake", "wakeups", "ua"):
+        result[key] = sum(w[key] * w["ms"] for w in windows) / max(total, 1)
+    return result
+
+
+def main(argv):
+    measured = None
+    while len(argv) > 1 and argv[1].startswith("--"):
+        if argv[1].startswith("--measured="):
+            measured = [float(v) for v in argv[1][len("--measured="):].split(",")]
+            if len(measured) != 2:
+                print(__doc__)
+                return 1
+        else:
+            print(__doc__)
+            return 1
+        del argv[1]
+
+    if len(argv) < 3:
+        print(__doc__)
+        return 1
+
+    variants = []
+    for path in argv[1:3]:
+        windows = read_capture(path)
+        if not windows:
+            print("no meter lines in %s" % path, file=sys.stderr)
+            return 1
+        variants.append(average(windows))
+
+    a, b = variants
+    rows = [("Time (s)", "%.0f", a["ms"] / 1000, b["ms"] / 1000),
+            ("Windows", "%d", a["windows"], b["windows"]),
+            ("CPU (%)", "%.1f", a["cpu"], b["cpu"]),
+            ("Awake (%)", "%.1f", a["awake"], b["awake"]),
+            ("Wakeups (/s)", "%.1f", a["wakeups"], b["wakeups"]),
+            ("MCU est. (uA)", "%.0f", a["ua"], b["ua"])]
+    if measured:
+        rows.append(("Board (uA)", "%.0f", measured[0], measured[1]))
+
+    print("%-14s %10s %10s %8s" % ("", a["name"], b["name"], "Ratio"))
+    for label, fmt, va, vb in rows:
+        ratio = "%.2f" % (vb / va) if va else "-"
+        print("%-14s %10s %10s %8s" % (label, fmt % va, fmt % vb, ratio))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,410 @@
+/*! ***************************************************************************
+ *
+ * \brief     Capacitive touch sensing input driver
+ * \file      tsi.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <MKL25Z4.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tsi.h"
+
+/*!
+ * \brief Scanning mode of the driver
+ */
+typedef enum
+{
+    TSI_MODE_ACTIVE, ///< End-of-scan interrupt, electrodes alternate
+    TSI_MODE_IDLE,   ///< Out-of-range interrupt on the first electrode only
+}tsi_mode_t;
+
+/*!
+ * \brief State of a single electrode
+ */
+typedef struct
+{
+    const uint8_t channel;
+    uint32_t baseline;  ///< Scaled by 2^TSI_BASELINE_SHIFT
+    uint32_t sum;       ///< Calibration sum
+    uint32_t scans;     ///< Number of calibration scans
+    uint16_t delta;     ///< Count above the baseline of the last scan
+    bool touched;
+}tsi_electrode_t;
+
+/*!
+ * \brief State of the slider formed by both electrodes
+ */
+typedef struct
+{
+    uint32_t position;  ///< Filtered position scaled by 2^TSI_SLIDER_SHIFT
+    uint8_t reported;   ///< Position of the last event
+    bool touched;
+}tsi_slider_t;
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+static volatile tsi_electrode_t electrodes[TSI_N_CHANNELS] =
+{
+    {.channel = 9},
+    {.channel = 10},
+};
+
+static volatile tsi_mode_t mode = TSI_MODE_ACTIVE;
+static volatile uint32_t current = 0;
+static volatile uint32_t idle = 0;
+static volatile tsi_slider_t slider;
+
+static QueueHandle_t tsi_queue = NULL;
+
+/*!
+ * \brief Writes the general control and status register
+ *
+ * Both flags are written one to clear them.
+ * - ESOR   : esor - 1 for the end-of-scan, 0 for the out-of-range interrupt
+ * - MODE   : 0000 - Capacitive sensing (non-noise detection) mode (default)
+ * - REFCHRG: 000 - 500 nA reference oscillator current (default)
+ * - DVOLT  : 00 - DV = 1.03 V oscillator's voltage rails (default)
+ * - EXTCHRG: 000 - 500 nA electrode oscillator current (default)
+ * - PS     : 0 - Electrode oscillator frequency divided by 1 (default)
+ * - NSCN   : 11111 - 32 scans for each electrode
+ * - TSIEN  : 1 - TSI module enabled
+ * - TSIIEN : 1 - TSI interrupt is enabled
+ * - STPE   : 1 - Allow TSI to continue running in all low power modes
+ * - STM    : 1 - Hardware trigger scan, by LPTMR0
+ */
+static inline void tsi_gencs(const uint32_t esor)
+{
+    TSI0->GENCS =
+        TSI_GENCS_OUTRGF(1) |
+        TSI_GENCS_ESOR(esor) |
+        TSI_GENCS_NSCN(31) |
+        TSI_GENCS_TSIEN(1) |
+        TSI_GENCS_TSIIEN(1) |
+        TSI_GENCS_STPE(1) |
+        TSI_GENCS_STM(1) |
+        TSI_GENCS_EOSF(1);
+}
+
+/*!
+ * \brief Initialises the TSI for continuous scanning of channel 9 and 10
+ *
+ * LPTMR0 triggers a scan every TSI_SCAN_MS ms. It runs from the 1 kHz LPO,
+ * so scanning continues in the low power modes. The first TSI_CAL_SCANS scans
+ * of every electrode determine its baseline, the electrodes must not be
+ * touched during the first TSI_N_CHANNELS * TSI_CAL_SCANS * TSI_SCAN_MS ms.
+ *
+ * \param[in]  queue  Queue of tsi_event_t that receives the touch events
+ */
+void tsi_init(QueueHandle_t queue)
+{
+    tsi_queue = queue;
+
+    // Enable PTB, TSI and LPTMR clocks
+    SIM->SCGC5 |= SIM_SCGC5_PORTB_MASK | SIM_SCGC5_TSI_MASK |
+        SIM_SCGC5_LPTMR_MASK;
+
+    // PTB16: TSI0_CH9, Mux Alt 0 (default)
+    // PTB17: TSI0_CH10, Mux Alt 0 (default)
+    PORTB->PCR[16] &= ~PORT_PCR_MUX_MASK;
+    PORTB->PCR[17] &= ~PORT_PCR_MUX_MASK;
+
+    // Start with the end-of-scan interrupt on the first electrode
+    TSI0->GENCS = 0;
+    TSI0->TSHD = 0;
+    TSI0->DATA = TSI_DATA_TSICH(electrodes[0].channel);
+    tsi_gencs(1);
+
+    // Enable Interrupts
+    NVIC_SetPriority(TSI0_IRQn, 128); // 0, 64, 128 or 192
+    NVIC_ClearPendingIRQ(TSI0_IRQn);
+    NVIC_EnableIRQ(TSI0_IRQn);
+
+    // LPTMR0 in time counter mode, 1 kHz LPO, prescaler bypassed. The counter
+    // is reset on every compare, which triggers the next scan.
+    LPTMR0->CSR = 0;
+    LPTMR0->PSR = LPTMR_PSR_PCS(1) | LPTMR_PSR_PBYP(1);
+    LPTMR0->CMR = TSI_SCAN_MS - 1;
+    LPTMR0->CSR = LPTMR_CSR_TEN(1);
+}
+
+/*!
+ * \brief Returns whether an electrode is touched
+ *
+ * \param[in]  channel  TSI channel, 9 or 10
+ *
+ * \return True if touched, false otherwise or for an unknown channel
+ */
+bool tsi_touched(const uint8_t channel)
+{
+    for(uint32_t i=0; i<TSI_N_CHANNELS; ++i)
+    {
+        if(electrodes[i].channel == channel)
+        {
+            return electrodes[i].touched;
+        }
+    }
+
+    return false;
+}
+
+/*!
+ * \brief Returns the untouched count of an electrode
+ *
+ * \param[in]  channel  TSI channel, 9 or 10
+ *
+ * \return Baseline count, 0 during calibration or for an unknown channel
+ */
+uint16_t tsi_baseline(const uint8_t channel)
+{
+    for(uint32_t i=0; i<TSI_N_CHANNELS; ++i)
+    {
+        if(electrodes[i].channel == channel)
+        {
+            return (uint16_t)(electrodes[i].baseline >> TSI_BASELINE_SHIFT);
+        }
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief Returns the slider position
+ *
+ * \param[out] position  Filtered position 0 .. 100, if touched
+ *
+ * \return True if the slider is touched, false otherwise
+ */
+bool tsi_slider(uint8_t *position)
+{
+    if(!slider.touched)
+    {
+        return false;
+    }
+
+    *position = (uint8_t)(slider.position >> TSI_SLIDER_SHIFT);
+    return true;
+}
+
+/*!
+ * \brief Sends an event to the queue, if any
+ */
+static void tsi_send(const tsi_event_t *event, BaseType_t *woken)
+{
+    if(tsi_queue != NULL)
+    {
+        xQueueSendFromISR(tsi_queue, event, woken);
+    }
+}
+
+/*!
+ * \brief Processes a scan result of an electrode
+ *
+ * \param[in]  e      Scanned electrode
+ * \param[in]  count  Accumulated count
+ * \param[out] woken  Set to pdTRUE if a higher priority task was woken
+ */
+static void tsi_update(volatile tsi_electrode_t *e, const uint16_t count,
+    BaseType_t *woken)
+{
+    if(e->scans < TSI_CAL_SCANS)
+    {
+        e->sum += count;
+
+        if(++e->scans == TSI_CAL_SCANS)
+        {
+            e->baseline = (e->sum << TSI_BASELINE_SHIFT) / TSI_CAL_SCANS;
+        }
+
+        return;
+    }
+
+    const uint16_t baseline = (uint16_t)(e->baseline >> TSI_BASELINE_SHIFT);
+    const uint16_t delta = (count > baseline) ? (count - baseline) : 0;
+
+    e->delta = delta;
+
+    // Touch and release with hysteresis
+    if((!e->touched && (delta > TSI_TOUCH_DELTA)) ||
+       (e->touched && (delta < TSI_RELEASE_DELTA)))
+    {
+        e->touched = !e->touched;
+
+        const tsi_event_t event =
+        {
+            .channel = e->channel,
+            .type = e->touched ? TSI_TOUCH : TSI_RELEASE,
+            .delta = delta,
+        };
+
+        tsi_send(&event, woken);
+    }
+
+    // Only follow the drift of an untouched electrode
+    if(!e->touched)
+    {
+        e->baseline = e->baseline - (e->baseline >> TSI_BASELINE_SHIFT) + count;
+    }
+}
+
+/*!
+ * \brief Updates the slider position after both electrodes are scanned
+ *
+ * The raw position is the ratio of the counts above the baseline: a finger
+ * on channel 9 only gives 0, on channel 10 only 100. The slider is touched
+ * when the sum exceeds TSI_TOUCH_DELTA and released below TSI_RELEASE_DELTA.
+ * The position is smoothed by a first order IIR filter and the velocity
+ * follows from the difference of two filtered positions.
+ *
+ * \param[out] woken  Set to pdTRUE if a higher priority task was woken
+ */
+static void tsi_slide(BaseType_t *woken)
+{
+    const uint32_t d9 = electrodes[0].delta;
+    const uint32_t d10 = electrodes[1].delta;
+    const uint32_t sum = d9 + d10;
+
+    tsi_event_t event =
+    {
+        .channel = 0,
+        .delta = (sum > UINT16_MAX) ? UINT16_MAX : (uint16_t)sum,
+    };
+
+    if(slider.touched && (sum < TSI_RELEASE_DELTA))
+    {
+        slider.touched = false;
+
+        event.type = TSI_LIFT;
+        event.position = slider.reported;
+        tsi_send(&event, woken);
+        return;
+    }
+
+    if(!slider.touched && (sum <= TSI_TOUCH_DELTA))
+    {
+        return;
+    }
+
+    const uint32_t raw = ((100 * d10) + (sum / 2)) / sum;
+    const uint32_t previous = slider.position;
+
+    if(!slider.touched)
+    {
+        // Start at the raw position, the filter would slide in from the
+        // previous touch
+        slider.touched = true;
+        slider.position = raw << TSI_SLIDER_SHIFT;
+        slider.reported = 0xFF;
+    }
+    else
+    {
+        slider.position = slider.position - (slider.position >> TSI_SLIDER_SHIFT)
+            + raw;
+    }
+
+    const uint8_t position = (uint8_t)(slider.position >> TSI_SLIDER_SHIFT);
+
+    if(position != slider.reported)
+    {
+        const int32_t diff = (int32_t)slider.position - (int32_t)previous;
+
+        event.type = TSI_POSITION;
+        event.position = position;
+        event.velocity = (slider.reported == 0xFF) ? 0 :
+            (int16_t)((diff * 1000) / (TSI_SLIDER_MS << TSI_SLIDER_SHIFT));
+
+        slider.reported = position;
+        tsi_send(&event, woken);
+    }
+}
+
+/*!
+ * \brief TSI interrupt handler
+ *
+ * In active mode called at the end of every scan. The result is processed and
+ * the next electrode is selected for the next hardware triggered scan. When no
+ * electrode has been touched for TSI_IDLE_SCANS scans, the handler switches to
+ * idle mode: only the first electrode is scanned and the handler is called
+ * once its count exceeds the touch threshold.
+ */
+void TSI0_IRQHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    const uint16_t count = (uint16_t)(TSI0->DATA & TSI_DATA_TSICNT_MASK);
+
+    if(mode == TSI_MODE_IDLE)
+    {
+        // Woken by the out-of-range interrupt, back to end-of-scan interrupts
+        mode = TSI_MODE_ACTIVE;
+        idle = 0;
+        TSI0->TSHD = 0;
+    }
+
+    // Clear the flags
+    tsi_gencs(1);
+
+    volatile tsi_electrode_t *e = &electrodes[current];
+    tsi_update(e, count, &xHigherPriorityTaskWoken);
+
+    if((current == (TSI_N_CHANNELS - 1)) && (e->scans >= TSI_CAL_SCANS))
+    {
+        tsi_slide(&xHigherPriorityTaskWoken);
+    }
+
+    bool busy = slider.touched;
+    for(uint32_t i=0; i<TSI_N_CHANNELS; ++i)
+    {
+        busy |= electrodes[i].touched || (electrodes[i].scans < TSI_CAL_SCANS);
+    }
+
+    idle = busy ? 0 : (idle + 1);
+
+    if(idle >= TSI_IDLE_SCANS)
+    {
+        // Monitor the first electrode, the interrupt is generated when the
+        // count is out of the range THRESL .. THRESH
+        mode = TSI_MODE_IDLE;
+        current = 0;
+
+        const uint32_t threshold = (electrodes[0].baseline >> TSI_BASELINE_SHIFT) +
+            TSI_TOUCH_DELTA;
+
+        TSI0->DATA = TSI_DATA_TSICH(electrodes[0].channel);
+        TSI0->TSHD = TSI_TSHD_THRESH(threshold) | TSI_TSHD_THRESL(0);
+        tsi_gencs(0);
+    }
+    else
+    {
+        // Select the electrode for the next triggered scan
+        current = (current + 1) % TSI_N_CHANNELS;
+        TSI0->DATA = TSI_DATA_TSICH(electrodes[current].channel);
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
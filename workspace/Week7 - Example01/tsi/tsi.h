@@ -0,0 +1,133 @@
+/*! ***************************************************************************
+ *
+ * \brief     Capacitive touch sensing input driver
+ * \file      tsi.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef TSI_H
+#define TSI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+/*!
+ * \brief Number of electrodes scanned by the driver
+ */
+#define TSI_N_CHANNELS (2)
+
+/*!
+ * \brief Time between two hardware triggered scans in ms
+ *
+ * The scans alternate between the electrodes, so every electrode is scanned
+ * once every TSI_N_CHANNELS * TSI_SCAN_MS ms.
+ */
+#define TSI_SCAN_MS (10)
+
+/*!
+ * \brief Count above the baseline at which an electrode is touched
+ *
+ * The counts are accumulated over 32 scans, as set by NSCN. The value is
+ * determined by using the debugger.
+ */
+#define TSI_TOUCH_DELTA (200)
+
+/*!
+ * \brief Count above the baseline below which a touch is released
+ */
+#define TSI_RELEASE_DELTA (100)
+
+/*!
+ * \brief Number of scans per electrode averaged into the initial baseline
+ */
+#define TSI_CAL_SCANS (8)
+
+/*!
+ * \brief Weight of a new scan in the baseline, as a power of two
+ *
+ * The baseline follows slow drift of an untouched electrode with a time
+ * constant of 2^TSI_BASELINE_SHIFT scans.
+ */
+#define TSI_BASELINE_SHIFT (4)
+
+/*!
+ * \brief Number of scans without a touch before the driver goes idle
+ *
+ * While idle, only the first electrode is monitored by the out-of-range
+ * threshold and the CPU is not interrupted until it is touched.
+ */
+#define TSI_IDLE_SCANS (100)
+
+/*!
+ * \brief Weight of a new slider position in the filtered position, as a
+ *        power of two
+ */
+#define TSI_SLIDER_SHIFT (2)
+
+/*!
+ * \brief Time between two slider position updates in ms
+ *
+ * The position is computed after both electrodes have been scanned.
+ */
+#define TSI_SLIDER_MS (TSI_N_CHANNELS * TSI_SCAN_MS)
+
+/*!
+ * \brief Touch event types
+ */
+typedef enum
+{
+    TSI_TOUCH,    ///< An electrode is touched
+    TSI_RELEASE,  ///< An electrode is released
+    TSI_POSITION, ///< The slider is touched and the position has changed
+    TSI_LIFT,     ///< The slider is no longer touched
+}tsi_event_type_t;
+
+/*!
+ * \brief Touch event, sent to the queue passed to tsi_init()
+ *
+ * The slider events have channel 0 and delta is the sum of the counts above
+ * the baseline of both electrodes.
+ */
+typedef struct
+{
+    uint8_t channel;        ///< TSI channel, 9 or 10
+    tsi_event_type_t type;
+    uint16_t delta;         ///< Count above the baseline
+    uint8_t position;       ///< Slider position, 0 (channel 9) .. 100 (channel 10)
+    int16_t velocity;       ///< Slider velocity in positions per second
+}tsi_event_t;
+
+// Function prototypes
+void tsi_init(QueueHandle_t queue);
+
+bool tsi_touched(const uint8_t channel);
+uint16_t tsi_baseline(const uint8_t channel);
+bool tsi_slider(uint8_t *position);
+
+#endif // TSI_H
@@ -0,0 +1,309 @@
+/*! ***************************************************************************
+ *
+ * \brief     Time-triggered cyclic executive
+ * \file      tt.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "serial.h"
+#include "timer.h"
+#include "tt.h"
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+static tt_slot_t *tt_slots = NULL;
+static uint32_t tt_n = 0;
+static uint32_t tt_minor_us = 0;
+
+// Number of minor frames since tt_init(), incremented by tt_release()
+static volatile uint32_t tt_frames = 0;
+
+/*----------------------------------------------------------------------------*/
+// Local functions
+/*----------------------------------------------------------------------------*/
+static uint32_t tt_gcd(uint32_t a, uint32_t b)
+{
+    while(b != 0)
+    {
+        const uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return a;
+}
+
+/*!
+ * \brief Releases the slots that are due in this minor frame
+ *
+ * Called by TPM1_IRQHandler() at the start of every minor frame. A slot whose
+ * previous job has not called tt_wait() yet is not released again, but the
+ * miss is counted.
+ */
+static void tt_release(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    tt_frames++;
+    const uint32_t now = tt_frames * tt_minor_us;
+
+    for(uint32_t i=0; i<tt_n; ++i)
+    {
+        tt_slot_t *s = &tt_slots[i];
+
+        if(--s->countdown != 0)
+        {
+            continue;
+        }
+
+        s->countdown = s->period_frames;
+
+        // Task did not call tt_wait() yet
+        if(s->task == NULL)
+        {
+            continue;
+        }
+
+        s->releases++;
+
+        if(s->running)
+        {
+            s->misses++;
+            continue;
+        }
+
+        s->running = true;
+        s->release_us = now;
+        vTaskNotifyGiveIndexedFromISR(s->task, TT_NOTIFY_INDEX, &woken);
+    }
+
+    portYIELD_FROM_ISR(woken);
+}
+
+/*----------------------------------------------------------------------------*/
+// Shared functions
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Checks a static schedule
+ *
+ * A schedule is valid if every offset and period is a multiple of the minor
+ * cycle, every offset is less than its period and, in every minor frame of
+ * the major cycle, the budgets of all slots released in that frame add up
+ * to no more than the minor cycle. The major cycle is the least common
+ * multiple of all periods.
+ *
+ * \param[in]  slots     Slot table
+ * \param[in]  n         Number of slots
+ * \param[in]  minor_ms  Minor cycle in ms
+ *
+ * \return True if the schedule is valid, false otherwise
+ */
+bool tt_verify(const tt_slot_t slots[], const uint32_t n,
+    const uint32_t minor_ms)
+{
+    if((n == 0) || (minor_ms == 0) || ((minor_ms * 1000UL) > TIM_MAX_PERIOD_US))
+    {
+        return false;
+    }
+
+    uint32_t major_ms = minor_ms;
+
+    for(uint32_t i=0; i<n; ++i)
+    {
+        const tt_slot_t *s = &slots[i];
+
+        if((s->period_ms == 0) ||
+           ((s->period_ms % minor_ms) != 0) ||
+           ((s->offset_ms % minor_ms) != 0) ||
+           (s->offset_ms >= s->period_ms))
+        {
+            return false;
+        }
+
+        major_ms = (major_ms / tt_gcd(major_ms, s->period_ms)) * s->period_ms;
+    }
+
+    // Every minor frame must fit the budgets of the slots released in it
+    for(uint32_t t=0; t<major_ms; t+=minor_ms)
+    {
+        uint32_t load_us = 0;
+
+        for(uint32_t i=0; i<n; ++i)
+        {
+            if((t % slots[i].period_ms) == slots[i].offset_ms)
+            {
+                load_us += slots[i].budget_us;
+            }
+        }
+
+        if(load_us > (minor_ms * 1000UL))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Starts the time-triggered schedule
+ *
+ * The schedule is checked by tt_verify() and TPM1 is started with the minor
+ * cycle as period. The first minor frame starts at the first overflow, one
+ * minor cycle after this call, so it can be called from main() just before
+ * the scheduler is started. Every slot is released by its own task, which
+ * must call tt_wait() at the top of its loop.
+ *
+ * \param[in]  slots     Slot table, must remain valid
+ * \param[in]  n         Number of slots
+ * \param[in]  minor_ms  Minor cycle in ms
+ */
+void tt_init(tt_slot_t slots[], const uint32_t n, const uint32_t minor_ms)
+{
+    configASSERT(tt_verify(slots, n, minor_ms));
+
+    for(uint32_t i=0; i<n; ++i)
+    {
+        slots[i].period_frames = slots[i].period_ms / minor_ms;
+        slots[i].countdown = (slots[i].offset_ms / minor_ms) + 1;
+    }
+
+    tt_slots = slots;
+    tt_n = n;
+    tt_minor_us = minor_ms * 1000UL;
+
+    tim_init(tt_minor_us, tt_release);
+}
+
+/*!
+ * \brief Completes the current job of a slot and waits for its next release
+ *
+ * The first call attaches the calling task to the slot. Every following call
+ * records the execution time of the job, measured from its start, and counts
+ * an overrun if it exceeds the budget. The time between the release and the
+ * moment the task runs again is recorded as jitter.
+ *
+ * \param[in]  slot  Slot of the calling task
+ */
+void tt_wait(tt_slot_t *slot)
+{
+    if(slot->task == NULL)
+    {
+        slot->task = xTaskGetCurrentTaskHandle();
+    }
+    else if(slot->running)
+    {
+        const uint32_t exec_us = tt_now_us() - slot->start_us;
+
+        slot->exec_last_us = exec_us;
+
+        if(exec_us > slot->exec_max_us)
+        {
+            slot->exec_max_us = exec_us;
+        }
+
+        if(exec_us > slot->budget_us)
+        {
+            slot->overruns++;
+        }
+
+        slot->runs++;
+        slot->running = false;
+    }
+
+    (void)ulTaskNotifyTakeIndexed(TT_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+
+    slot->start_us = tt_now_us();
+
+    const uint32_t jitter_us = slot->start_us - slot->release_us;
+
+    if(jitter_us > slot->jitter_max_us)
+    {
+        slot->jitter_max_us = jitter_us;
+    }
+}
+
+/*!
+ * \brief Returns the schedule time in us
+ *
+ * Time zero is one minor cycle before the first minor frame. The resolution
+ * is one TPM1 count, 1/TIM_CLOCK_HZ s.
+ */
+uint32_t tt_now_us(void)
+{
+    uint32_t frames;
+    uint32_t count;
+
+    taskENTER_CRITICAL();
+    {
+        frames = tt_frames;
+        count = tim_count();
+
+        // Overflow not handled yet by tt_release()
+        if(tim_pending())
+        {
+            frames++;
+            count = tim_count();
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return (frames * tt_minor_us) + ((count * 1000UL) / (TIM_CLOCK_HZ / 1000UL));
+}
+
+/*!
+ * \brief Prints the statistics of all slots
+ *
+ * Every row shows the period, the number of releases, missed releases,
+ * budget overruns, the last and longest execution time, the budget and the
+ * longest release jitter. All times are in us, except the period.
+ */
+void tt_report(void)
+{
+    // Only used by the calling task, so it is not on its stack
+    static char str[80];
+
+    vSerialPutString("slot      per_ms   rel miss over   last    max budget jitter\r\n");
+
+    for(uint32_t i=0; i<tt_n; ++i)
+    {
+        const tt_slot_t *s = &tt_slots[i];
+
+        snprintf(str, sizeof(str), "%-9s %6lu %5lu %4lu %4lu %6lu %6lu %6lu %6lu\r\n",
+            s->name, (unsigned long)s->period_ms, (unsigned long)s->releases,
+            (unsigned long)s->misses, (unsigned long)s->overruns,
+            (unsigned long)s->exec_last_us, (unsigned long)s->exec_max_us,
+            (unsigned long)s->budget_us, (unsigned long)s->jitter_max_us);
+        vSerialPutString(str);
+    }
+}
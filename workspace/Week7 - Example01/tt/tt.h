@@ -0,0 +1,96 @@
+/*! ***************************************************************************
+ *
+ * \brief     Time-triggered cyclic executive
+ * \file      tt.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef TT_H
+#define TT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*!
+ * \brief Task notification index used to release a slot
+ */
+#ifndef TT_NOTIFY_INDEX
+#define TT_NOTIFY_INDEX (1)
+#endif
+
+/*!
+ * \brief A slot in the static schedule
+ *
+ * The first four fields describe the schedule and are set with TT_SLOT().
+ * The statistics are updated by tt_wait() and the release interrupt and can
+ * be read at any time, for example with a debugger or by tt_report().
+ */
+typedef struct
+{
+    const char *name;       ///< Name shown by tt_report()
+    uint32_t offset_ms;     ///< First release in the major cycle
+    uint32_t period_ms;     ///< Time between two releases
+    uint32_t budget_us;     ///< Allowed time from start to the next tt_wait()
+
+    // Statistics
+    volatile uint32_t releases; ///< Number of releases
+    volatile uint32_t misses;   ///< Releases while the previous job still ran
+    uint32_t runs;          ///< Number of completed jobs
+    uint32_t overruns;      ///< Jobs that took longer than budget_us
+    uint32_t exec_last_us;  ///< Time from start to completion of the last job
+    uint32_t exec_max_us;   ///< Longest time from start to completion
+    uint32_t jitter_max_us; ///< Longest time from release to start
+
+    // Private, used by the scheduler
+    TaskHandle_t task;
+    volatile bool running;
+    uint32_t period_frames;
+    uint32_t countdown;
+    volatile uint32_t release_us;
+    uint32_t start_us;
+}tt_slot_t;
+
+/*!
+ * \brief Initialiser for an entry of the slot table
+ */
+#define TT_SLOT(n, offset, period, budget) \
+    {.name = (n), .offset_ms = (offset), .period_ms = (period), \
+     .budget_us = (budget)}
+
+/*----------------------------------------------------------------------------*/
+// Shared functions
+/*----------------------------------------------------------------------------*/
+bool tt_verify(const tt_slot_t slots[], const uint32_t n,
+    const uint32_t minor_ms);
+void tt_init(tt_slot_t slots[], const uint32_t n, const uint32_t minor_ms);
+void tt_wait(tt_slot_t *slot);
+uint32_t tt_now_us(void);
+void tt_report(void);
+
+#endif // TT_H
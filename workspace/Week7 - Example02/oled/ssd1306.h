@@ -56,6 +56,26 @@
  */
 #define SSD1306_SLAVE_ADDRESS (0x78 | SSD1306_SA0)
 
+/*!
+ * \brief Minimum time in ms between two frames of ssd1306_update_if_dirty()
+ *
+ * Caps the frame rate, sending the framebuffer takes approximately 28 ms.
+ */
+#ifndef SSD1306_MIN_FRAME_MS
+#define SSD1306_MIN_FRAME_MS  (40)
+#endif
+
+/*!
+ * \brief Maximum time in ms between two frames of ssd1306_update_if_dirty()
+ *
+ * An unchanged framebuffer is sent again after this time, which restores the
+ * display contents after a reset of the display. 0 never sends an unchanged
+ * framebuffer again.
+ */
+#ifndef SSD1306_MAX_FRAME_MS
+#define SSD1306_MAX_FRAME_MS  (10000)
+#endif
+
 /// \}
 
 /// Value for a pixel
@@ -73,6 +93,8 @@ void ssd1306_init(void);
 void ssd1306_command(const uint8_t cmd);
 void ssd1306_data(const uint8_t data);
 void ssd1306_update(void);
+bool ssd1306_update_if_dirty(const uint32_t now_ms);
+void ssd1306_invalidate(void);
 
 void ssd1306_setfont(const char *f);
 void ssd1306_setorientation(const uint8_t orientation);
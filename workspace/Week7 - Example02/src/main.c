@@ -222,10 +222,12 @@ static void vOledTask(void *parameters)
     // As per most tasks, this task is implemented in an infinite loop.
     for( ;; )
     {
-        ssd1306_update();
+        // Only sends the framebuffer if it changed, at most once every
+        // SSD1306_MIN_FRAME_MS
+        ssd1306_update_if_dirty(xTaskGetTickCount() * portTICK_PERIOD_MS);
 
-        // Wait before updating the next time
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(100));
+        // Wait before checking the next time
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(SSD1306_MIN_FRAME_MS));
     }
 }
 
@@ -947,6 +947,21 @@
     #define configUSE_SB_COMPLETED_CALLBACK    0
 #endif
 
+#ifndef configUSE_STREAM_BUFFER_SPANS
+    #define configUSE_STREAM_BUFFER_SPANS    0
+#endif
+
+/* The copy of queue items and stream buffer data, and the fill of new stacks.
+ * Define these in FreeRTOSConfig.h to use routines that are faster than the
+ * library functions on the target. */
+#ifndef configMEMCPY
+    #define configMEMCPY( pvDest, pvSource, xSize )    memcpy( ( pvDest ), ( pvSource ), ( xSize ) )
+#endif
+
+#ifndef configMEMSET
+    #define configMEMSET( pvDest, iValue, xSize )    memset( ( pvDest ), ( iValue ), ( xSize ) )
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
     #define portTICK_TYPE_IS_ATOMIC    0
 #endif
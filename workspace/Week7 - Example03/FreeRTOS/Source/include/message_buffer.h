@@ -847,6 +847,73 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferReceiveCompletedFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) \
     xStreamBufferReceiveCompletedFromISR( ( xMessageBuffer ), ( pxHigherPriorityTaskWoken ) )
 
+#if ( configUSE_STREAM_BUFFER_SPANS == 1 )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendReserve( MessageBufferHandle_t xMessageBuffer,
+ *                                   StreamBufferSpan_t * const pxSpan,
+ *                                   TickType_t xTicksToWait );
+ *
+ * size_t xMessageBufferSendCommit( MessageBufferHandle_t xMessageBuffer,
+ *                                  size_t xDataLengthBytes );
+ *
+ * size_t xMessageBufferSendCommitFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                         size_t xDataLengthBytes,
+ *                                         BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Writes a message in place.  xMessageBufferSendReserve() returns the room
+ * for the largest message that fits in pxSpan, the message is written into
+ * pxSpan->pucData and, if it wraps, pxSpan->pucWrapped.  The commit sends it
+ * with a length of xDataLengthBytes.  See xStreamBufferSendReserve().
+ *
+ * \defgroup xMessageBufferSendReserve xMessageBufferSendReserve
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendReserve( xMessageBuffer, pxSpan, xTicksToWait ) \
+    xStreamBufferSendReserve( ( xMessageBuffer ), ( pxSpan ), ( xTicksToWait ) )
+
+#define xMessageBufferSendCommit( xMessageBuffer, xDataLengthBytes ) \
+    xStreamBufferSendCommit( ( xMessageBuffer ), ( xDataLengthBytes ) )
+
+#define xMessageBufferSendCommitFromISR( xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken ) \
+    xStreamBufferSendCommitFromISR( ( xMessageBuffer ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceiveAcquire( MessageBufferHandle_t xMessageBuffer,
+ *                                      StreamBufferSpan_t * const pxSpan,
+ *                                      TickType_t xTicksToWait );
+ *
+ * size_t xMessageBufferReceiveRelease( MessageBufferHandle_t xMessageBuffer );
+ *
+ * size_t xMessageBufferReceiveReleaseFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                             BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Reads the next message in place.  xMessageBufferReceiveAcquire() returns
+ * the length of the message and the message in pxSpan, the release removes
+ * it.  See xStreamBufferReceiveAcquire().
+ *
+ * \defgroup xMessageBufferReceiveAcquire xMessageBufferReceiveAcquire
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceiveAcquire( xMessageBuffer, pxSpan, xTicksToWait ) \
+    xStreamBufferReceiveAcquire( ( xMessageBuffer ), ( pxSpan ), ( xTicksToWait ) )
+
+#define xMessageBufferReceiveRelease( xMessageBuffer ) \
+    xStreamBufferReceiveRelease( ( xMessageBuffer ), 0 )
+
+#define xMessageBufferReceiveReleaseFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) \
+    xStreamBufferReceiveReleaseFromISR( ( xMessageBuffer ), 0, ( pxHigherPriorityTaskWoken ) )
+
+#endif /* configUSE_STREAM_BUFFER_SPANS */
+
 /* *INDENT-OFF* */
 #if defined( __cplusplus )
     } /* extern "C" */
@@ -163,6 +163,22 @@ typedef struct xHeapStats
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
+/*
+ * heap_5.c only.  Allocates a block that lies within pxRegion, which need not
+ * be one of the regions passed to vPortDefineHeapRegions() - for example the
+ * address range of a RAM bank.  Returns NULL if no free block in the range is
+ * large enough.
+ */
+void * pvPortMallocFromRegion( const HeapRegion_t * pxRegion,
+                               size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * heap_5.c only.  With configAPPLICATION_ALLOCATED_HEAP set to 1, the
+ * application provides the regions of the heap with this function, which is
+ * called with the scheduler suspended on the first call to pvPortMalloc().
+ */
+const HeapRegion_t * pxApplicationGetHeapRegions( void );
+
 /*
  * Returns a HeapStats_t structure filled with information about the current
  * heap state.
@@ -36,11 +36,17 @@
  *
  * Setting configCHECK_FOR_STACK_OVERFLOW to 1 will cause the macro to check
  * the current stack state only - comparing the current top of stack value to
- * the stack limit.  Setting configCHECK_FOR_STACK_OVERFLOW to greater than 1
+ * the stack limit.  Setting configCHECK_FOR_STACK_OVERFLOW to 2
  * will also cause the last few stack bytes to be checked to ensure the value
  * to which the bytes were set when the task was created have not been
  * overwritten.  Note this second test does not guarantee that an overflowed
  * stack will always be recognised.
+ *
+ * Setting configCHECK_FOR_STACK_OVERFLOW to 3 checks only the lowest word of
+ * the stack, a single load and compare at every switch.  It does not depend
+ * on the saved top of stack, so it can be used with a port that saves it
+ * after the switch.  The whole stack can be checked outside the context
+ * switch, from its high water mark.
  */
 
 /*-----------------------------------------------------------*/
@@ -84,7 +90,7 @@
 #endif /* configCHECK_FOR_STACK_OVERFLOW == 1 */
 /*-----------------------------------------------------------*/
 
-#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portSTACK_GROWTH < 0 ) )
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 2 ) && ( portSTACK_GROWTH < 0 ) )
 
     #define taskCHECK_FOR_STACK_OVERFLOW()                                                            \
     {                                                                                                 \
@@ -103,7 +109,7 @@
 #endif /* #if( configCHECK_FOR_STACK_OVERFLOW > 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portSTACK_GROWTH > 0 ) )
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 2 ) && ( portSTACK_GROWTH > 0 ) )
 
     #define taskCHECK_FOR_STACK_OVERFLOW()                                                                                                \
     {                                                                                                                                     \
@@ -127,6 +133,34 @@
 #endif /* #if( configCHECK_FOR_STACK_OVERFLOW > 1 ) */
 /*-----------------------------------------------------------*/
 
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portSTACK_GROWTH < 0 ) )
+
+/* Only the canary word at the limit of the stack is checked. */
+    #define taskCHECK_FOR_STACK_OVERFLOW()                                                            \
+    {                                                                                                 \
+        if( *( ( const uint32_t * ) pxCurrentTCB->pxStack ) != ( uint32_t ) 0xa5a5a5a5 )              \
+        {                                                                                             \
+            vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName ); \
+        }                                                                                             \
+    }
+
+#endif /* configCHECK_FOR_STACK_OVERFLOW == 3 */
+/*-----------------------------------------------------------*/
+
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portSTACK_GROWTH > 0 ) )
+
+/* Only the canary word at the limit of the stack is checked. */
+    #define taskCHECK_FOR_STACK_OVERFLOW()                                                            \
+    {                                                                                                 \
+        if( *( ( const uint32_t * ) pxCurrentTCB->pxEndOfStack ) != ( uint32_t ) 0xa5a5a5a5 )         \
+        {                                                                                             \
+            vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName ); \
+        }                                                                                             \
+    }
+
+#endif /* configCHECK_FOR_STACK_OVERFLOW == 3 */
+/*-----------------------------------------------------------*/
+
 /* Remove stack overflow macro if not being used. */
 #ifndef taskCHECK_FOR_STACK_OVERFLOW
     #define taskCHECK_FOR_STACK_OVERFLOW()
@@ -78,6 +78,20 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
                                                  BaseType_t xIsInsideISR,
                                                  BaseType_t * const pxHigherPriorityTaskWoken );
 
+/**
+ * Part of the storage area of a stream buffer or message buffer, returned by
+ * xStreamBufferSendReserve() and xStreamBufferReceiveAcquire().  Data that
+ * reaches the end of the storage area continues at its start, in the wrapped
+ * part.
+ */
+typedef struct StreamBufferSpan
+{
+    uint8_t * pucData;     /* Start of the span, NULL if it is empty. */
+    size_t xLength;        /* Number of bytes at pucData. */
+    uint8_t * pucWrapped;  /* Start of the storage area if the span wraps, otherwise NULL. */
+    size_t xWrappedLength; /* Number of bytes at pucWrapped. */
+} StreamBufferSpan_t;
+
 /**
  * stream_buffer.h
  *
@@ -879,6 +893,193 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
                                                  BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_STREAM_BUFFER_SPANS == 1 )
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+ *                                  StreamBufferSpan_t * const pxSpan,
+ *                                  TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Returns the free space of a stream buffer or message buffer in pxSpan, so a
+ * DMA transfer or a parser can write into the storage area of the buffer in
+ * place, instead of into a scratch buffer that xStreamBufferSend() then copies
+ * from.  The space is the bytes up to the end of the storage area, plus the
+ * bytes that continue at its start.  Nothing is sent until
+ * xStreamBufferSendCommit() or xStreamBufferSendCommitFromISR() is called.
+ *
+ * configUSE_STREAM_BUFFER_SPANS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * For a message buffer the span leaves room for the length of the message in
+ * front of it, the whole message must be written before it is committed.
+ *
+ * Like xStreamBufferSend(), this function must only be called by the single
+ * writer of the buffer.  It can be called from an interrupt if xTicksToWait is
+ * 0.
+ *
+ * @param xStreamBuffer The handle of the stream buffer or message buffer.
+ *
+ * @param pxSpan Set to the free space.  pxSpan->pucWrapped is NULL if the space
+ * does not wrap.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for space if the buffer is full.
+ *
+ * @return The number of bytes that can be written in place, 0 if the buffer was
+ * full.
+ *
+ * \defgroup xStreamBufferSendReserve xStreamBufferSendReserve
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+                                 StreamBufferSpan_t * const pxSpan,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+ *                                 size_t xDataLengthBytes );
+ * @endcode
+ *
+ * Sends the first xDataLengthBytes of the span returned by
+ * xStreamBufferSendReserve(), which were written in place.  A task that waits
+ * for data is unblocked as by xStreamBufferSend().  Use
+ * xStreamBufferSendCommitFromISR() in an interrupt.
+ *
+ * @param xStreamBuffer The handle of the stream buffer or message buffer.
+ *
+ * @param xDataLengthBytes The number of bytes written, at most the number
+ * returned by xStreamBufferSendReserve().  For a message buffer this is the
+ * length of the message.
+ *
+ * @return xDataLengthBytes.
+ *
+ * \defgroup xStreamBufferSendCommit xStreamBufferSendCommit
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+                                size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                        size_t xDataLengthBytes,
+ *                                        BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferSendCommit() that can be called from an interrupt
+ * service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a task that waited for data
+ * was unblocked and has a priority above the interrupted task, as by
+ * xStreamBufferSendFromISR().
+ *
+ * \defgroup xStreamBufferSendCommitFromISR xStreamBufferSendCommitFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                       size_t xDataLengthBytes,
+                                       BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+ *                                     StreamBufferSpan_t * const pxSpan,
+ *                                     TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Returns the data in a stream buffer, or the next message in a message
+ * buffer, in pxSpan, so it can be read or parsed in place instead of being
+ * copied out by xStreamBufferReceive().  The data stays in the buffer until
+ * xStreamBufferReceiveRelease() or xStreamBufferReceiveReleaseFromISR() is
+ * called.
+ *
+ * configUSE_STREAM_BUFFER_SPANS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Like xStreamBufferReceive(), this function must only be called by the single
+ * reader of the buffer.  It can be called from an interrupt if xTicksToWait is
+ * 0.
+ *
+ * @param xStreamBuffer The handle of the stream buffer or message buffer.
+ *
+ * @param pxSpan Set to the data.  pxSpan->pucWrapped is NULL if the data does
+ * not wrap.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data if the buffer is empty.
+ *
+ * @return The number of bytes, or the length of the message, 0 if the buffer
+ * was empty.
+ *
+ * \defgroup xStreamBufferReceiveAcquire xStreamBufferReceiveAcquire
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+                                    StreamBufferSpan_t * const pxSpan,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+ *                                     size_t xDataLengthBytes );
+ * @endcode
+ *
+ * Removes the first xDataLengthBytes of a stream buffer, or the next message
+ * of a message buffer, after they were read in place.  A task that waits for
+ * space is unblocked as by xStreamBufferReceive().  Use
+ * xStreamBufferReceiveReleaseFromISR() in an interrupt.
+ *
+ * @param xStreamBuffer The handle of the stream buffer or message buffer.
+ *
+ * @param xDataLengthBytes The number of bytes to remove from a stream buffer.
+ * Ignored for a message buffer, a message is always removed as a whole.
+ *
+ * @return The number of bytes removed, or the length of the removed message.
+ *
+ * \defgroup xStreamBufferReceiveRelease xStreamBufferReceiveRelease
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                            size_t xDataLengthBytes,
+ *                                            BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferReceiveRelease() that can be called from an
+ * interrupt service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a task that waited for
+ * space was unblocked and has a priority above the interrupted task, as by
+ * xStreamBufferReceiveFromISR().
+ *
+ * \defgroup xStreamBufferReceiveReleaseFromISR xStreamBufferReceiveReleaseFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           size_t xDataLengthBytes,
+                                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_SPANS */
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                  size_t xTriggerLevelBytes,
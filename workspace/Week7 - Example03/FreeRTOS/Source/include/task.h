@@ -1957,6 +1957,30 @@ void vTaskGetRunTimeStats( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetCurrentRunTimeCounter( void );
+ * @endcode
+ *
+ * configGENERATE_RUN_TIME_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * The run time of a task is only added to its counter when the task is
+ * switched out.  ulTaskGetCurrentRunTimeCounter() returns the total run time
+ * of the calling task including the time since it was last switched in, so
+ * the difference of two calls is the time the task was running in between,
+ * without the time it was preempted or blocked.  Interrupts are counted in
+ * the run time of the task they interrupted.
+ *
+ * @return The total run time of the calling task, in the units of
+ * portGET_RUN_TIME_COUNTER_VALUE().
+ *
+ * \defgroup ulTaskGetCurrentRunTimeCounter ulTaskGetCurrentRunTimeCounter
+ * \ingroup TaskUtils
+ */
+configRUN_TIME_COUNTER_TYPE ulTaskGetCurrentRunTimeCounter( void ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
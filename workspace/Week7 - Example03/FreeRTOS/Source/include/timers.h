@@ -1323,6 +1323,18 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  */
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * UBaseType_t uxTimerGetQueueFullCount( void );
+ *
+ * Returns the number of timer commands and pended function calls that could
+ * not be sent to the timer service task because the timer command queue was
+ * full.  With configUSE_TIMER_WHEEL set to 1 only xTimerDelete() and the pended
+ * function calls use the queue.
+ *
+ * @return The number of failed sends since the start.
+ */
+UBaseType_t uxTimerGetQueueFullCount( void ) PRIVILEGED_FUNCTION;
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
@@ -111,6 +111,18 @@ static void prvTaskExitError( void );
 
 /*-----------------------------------------------------------*/
 
+#ifndef configUSE_PORT_FAST_PENDSV
+    #define configUSE_PORT_FAST_PENDSV    0
+#endif
+
+/* The fast PendSV handler saves the top of stack after vTaskSwitchContext()
+ * has run, so stack overflow check method 1 would compare a stale value. */
+#if ( configUSE_PORT_FAST_PENDSV == 1 ) && ( configCHECK_FOR_STACK_OVERFLOW == 1 )
+    #error "configUSE_PORT_FAST_PENDSV needs configCHECK_FOR_STACK_OVERFLOW 0, 2 or 3"
+#endif
+
+/*-----------------------------------------------------------*/
+
 /* Each task maintains its own interrupt status in the critical nesting
  * variable. */
 static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
@@ -281,7 +293,25 @@ void vPortYield( void )
 
 void vPortEnterCritical( void )
 {
+    #if ( portTIME_MASKED_SECTIONS == 1 )
+        uint32_t ulWasMasked;
+
+        __asm volatile ( " mrs %0, PRIMASK " : "=r" ( ulWasMasked ) );
+    #endif
+
     portDISABLE_INTERRUPTS();
+
+    #if ( portTIME_MASKED_SECTIONS == 1 )
+        /* Only the outermost mask starts a section, interrupts may also be
+         * masked by portSET_INTERRUPT_MASK_FROM_ISR() already.  Before the
+         * scheduler starts the nesting is not 0 and interrupts stay masked
+         * until the first task runs, which is not timed. */
+        if( ( ulWasMasked == 0 ) && ( uxCriticalNesting == 0 ) )
+        {
+            traceINTERRUPTS_MASKED( __builtin_return_address( 0 ) );
+        }
+    #endif
+
     uxCriticalNesting++;
     __asm volatile ( "dsb" ::: "memory" );
     __asm volatile ( "isb" );
@@ -295,33 +325,139 @@ void vPortExitCritical( void )
 
     if( uxCriticalNesting == 0 )
     {
+        #if ( portTIME_MASKED_SECTIONS == 1 )
+            traceINTERRUPTS_UNMASKED();
+        #endif
+
         portENABLE_INTERRUPTS();
     }
 }
 /*-----------------------------------------------------------*/
 
-uint32_t ulSetInterruptMaskFromISR( void )
-{
-    __asm volatile (
-        " mrs r0, PRIMASK	\n"
-        " cpsid i			\n"
-        " bx lr				  "
-        ::: "memory"
-        );
-}
-/*-----------------------------------------------------------*/
+/* The mask functions are naked, unless the masked sections are timed, see
+ * portmacro.h. */
+#if ( portTIME_MASKED_SECTIONS == 1 )
+
+    uint32_t ulSetInterruptMaskFromISR( void )
+    {
+        uint32_t ulMask;
+
+        __asm volatile (
+            " mrs %0, PRIMASK	\n"
+            " cpsid i			  "
+            : "=r" ( ulMask ) :: "memory"
+            );
+
+        if( ulMask == 0 )
+        {
+            traceINTERRUPTS_MASKED( __builtin_return_address( 0 ) );
+        }
+
+        return ulMask;
+    }
+    /*-----------------------------------------------------------*/
+
+    void vClearInterruptMaskFromISR( uint32_t ulMask )
+    {
+        if( ulMask == 0 )
+        {
+            traceINTERRUPTS_UNMASKED();
+        }
+
+        __asm volatile ( " msr PRIMASK, %0 " :: "r" ( ulMask ) : "memory" );
+    }
+    /*-----------------------------------------------------------*/
+
+#else /* portTIME_MASKED_SECTIONS */
 
-void vClearInterruptMaskFromISR( __attribute__( ( unused ) ) uint32_t ulMask )
+    uint32_t ulSetInterruptMaskFromISR( void )
+    {
+        __asm volatile (
+            " mrs r0, PRIMASK	\n"
+            " cpsid i			\n"
+            " bx lr				  "
+            ::: "memory"
+            );
+    }
+    /*-----------------------------------------------------------*/
+
+    void vClearInterruptMaskFromISR( __attribute__( ( unused ) ) uint32_t ulMask )
+    {
+        __asm volatile (
+            " msr PRIMASK, r0	\n"
+            " bx lr				  "
+            ::: "memory"
+            );
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* portTIME_MASKED_SECTIONS */
+
+#if ( configUSE_PORT_FAST_PENDSV == 1 )
+
+/*
+ * Selects the next task before the context is saved. r4-r11 are callee saved,
+ * so they still hold the values of the running task after vTaskSwitchContext()
+ * returns. When the running task is selected again, nothing is saved or
+ * restored. Otherwise r4-r11 are stored on the stack of the old task and the
+ * context of the new task is restored. The handler runs from SRAM_L, see
+ * sections.h, where every load and store takes its minimum number of cycles.
+ */
+__RAMFUNC void xPortPendSVHandler( void )
 {
-    __asm volatile (
-        " msr PRIMASK, r0	\n"
-        " bx lr				  "
-        ::: "memory"
-        );
+    /* This is a naked function. */
+
+    __asm volatile
+    (
+        "	.syntax unified						\n"
+        "	ldr	r3, pxCurrentTCBConst			\n"/* Get the location of the current TCB. */
+        "	ldr	r2, [r3]						\n"/* r2 holds the TCB of the running task. */
+        "										\n"
+        "	push {r2, r14}						\n"
+        "	cpsid i								\n"
+        "	bl vTaskSwitchContext				\n"
+        "	cpsie i								\n"
+        "	pop {r2, r3}						\n"/* lr goes in r3. r2 holds the old tcb pointer. */
+        "										\n"
+        "	ldr	r1, pxCurrentTCBConst			\n"
+        "	ldr	r1, [r1]						\n"/* r1 holds the TCB of the selected task. */
+        "	cmp r1, r2							\n"
+        "	beq 1f								\n"/* Same task, r4-r11 are untouched. */
+        "										\n"
+        "	mrs r0, psp							\n"
+        "	subs r0, r0, #32					\n"/* Make space for the remaining low registers. */
+        "	str r0, [r2]						\n"/* Save the new top of stack. */
+        "	stmia r0!, {r4-r7}					\n"/* Store the low registers that are not saved automatically. */
+        " 	mov r4, r8							\n"/* Store the high registers. */
+        " 	mov r5, r9							\n"
+        " 	mov r6, r10							\n"
+        " 	mov r7, r11							\n"
+        " 	stmia r0!, {r4-r7}					\n"
+        "										\n"
+        "	ldr r0, [r1]						\n"/* The first item in pxCurrentTCB is the task top of stack. */
+        "	adds r0, r0, #16					\n"/* Move to the high registers. */
+        "	ldmia r0!, {r4-r7}					\n"/* Pop the high registers. */
+        " 	mov r8, r4							\n"
+        " 	mov r9, r5							\n"
+        " 	mov r10, r6							\n"
+        " 	mov r11, r7							\n"
+        "										\n"
+        "	msr psp, r0							\n"/* Remember the new top of stack for the task. */
+        "										\n"
+        "	subs r0, r0, #32					\n"/* Go back for the low registers that are not automatically restored. */
+        " 	ldmia r0!, {r4-r7}					\n"/* Pop low registers.  */
+        "										\n"
+        "1:										\n"
+        "	bx r3								\n"
+        "										\n"
+        "	.align 4							\n"
+        "pxCurrentTCBConst: .word pxCurrentTCB	  "
+    );
 }
-/*-----------------------------------------------------------*/
 
-void xPortPendSVHandler( void )
+#else /* configUSE_PORT_FAST_PENDSV */
+
+__RAMFUNC void xPortPendSVHandler( void )
 {
     /* This is a naked function. */
 
@@ -368,9 +504,11 @@ void xPortPendSVHandler( void )
         "pxCurrentTCBConst: .word pxCurrentTCB	  "
     );
 }
+
+#endif /* configUSE_PORT_FAST_PENDSV */
 /*-----------------------------------------------------------*/
 
-void xPortSysTickHandler( void )
+__RAMFUNC void xPortSysTickHandler( void )
 {
     uint32_t ulPreviousMask;
 
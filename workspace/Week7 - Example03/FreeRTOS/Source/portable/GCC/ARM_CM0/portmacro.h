@@ -87,12 +87,69 @@
     #define portYIELD_FROM_ISR( x )                     portEND_SWITCHING_ISR( x )
 /*-----------------------------------------------------------*/
 
+/* Port specific optimisations. */
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+/* Check the configuration. */
+        #if ( configMAX_PRIORITIES > 32 )
+            #error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.
+        #endif
+
+/* Store/clear the ready priorities in a bit map. */
+        #define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )    ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+        #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )     ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+/* The Cortex-M0+ has no CLZ instruction. The bits below the highest set bit
+ * are set, which leaves one of 32 values, and a de Bruijn multiply maps each
+ * of them to a unique index in a table. The single cycle multiplier of the
+ * KL25Z makes this take the same few cycles for any bit map. */
+        static inline __attribute__( ( always_inline ) ) uint32_t ulPortHighestBit( uint32_t ulBitmap )
+        {
+            static const uint8_t ucTable[ 32 ] =
+            {
+                0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
+                8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31
+            };
+
+            ulBitmap |= ulBitmap >> 1;
+            ulBitmap |= ulBitmap >> 2;
+            ulBitmap |= ulBitmap >> 4;
+            ulBitmap |= ulBitmap >> 8;
+            ulBitmap |= ulBitmap >> 16;
+
+            return ucTable[ ( ulBitmap * 0x07C4ACDDUL ) >> 27 ];
+        }
+
+        #define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )    uxTopPriority = ulPortHighestBit( uxReadyPriorities )
+
+    #endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
 
 /* Critical section management. */
+
+/* The application may time the sections that run with interrupts masked by
+ * defining traceINTERRUPTS_MASKED( pvCaller ) and traceINTERRUPTS_UNMASKED().
+ * Both are called with interrupts masked, at the outermost mask and unmask of
+ * a critical section or of portSET_INTERRUPT_MASK_FROM_ISR().  pvCaller is the
+ * return address into the function that masked the interrupts.  The mask
+ * functions are then no longer naked. */
+    #if defined( traceINTERRUPTS_MASKED ) && defined( traceINTERRUPTS_UNMASKED )
+        #define portTIME_MASKED_SECTIONS    1
+    #else
+        #define portTIME_MASKED_SECTIONS    0
+    #endif
+
     extern void vPortEnterCritical( void );
     extern void vPortExitCritical( void );
-    extern uint32_t ulSetInterruptMaskFromISR( void ) __attribute__( ( naked ) );
-    extern void vClearInterruptMaskFromISR( uint32_t ulMask )  __attribute__( ( naked ) );
+
+    #if ( portTIME_MASKED_SECTIONS == 1 )
+        extern uint32_t ulSetInterruptMaskFromISR( void );
+        extern void vClearInterruptMaskFromISR( uint32_t ulMask );
+    #else
+        extern uint32_t ulSetInterruptMaskFromISR( void ) __attribute__( ( naked ) );
+        extern void vClearInterruptMaskFromISR( uint32_t ulMask )  __attribute__( ( naked ) );
+    #endif
 
     #define portSET_INTERRUPT_MASK_FROM_ISR()         ulSetInterruptMaskFromISR()
     #define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )    vClearInterruptMaskFromISR( x )
@@ -116,6 +173,8 @@
 
     #define portNOP()
 
+    #define portFORCE_INLINE    inline __attribute__( ( always_inline ) )
+
     #define portMEMORY_BARRIER()    __asm volatile ( "" ::: "memory" )
 
     #ifdef __cplusplus
@@ -0,0 +1,659 @@
+/*! ***************************************************************************
+ *
+ * \brief     Two-level segregated fit heap
+ * \file      heap_tlsf.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+/*
+ * A two-level segregated fit (TLSF) implementation of pvPortMalloc() and
+ * vPortFree(), with the API and the statistics of heap_4.c, select it with
+ * cmake -DHEAP=heap_tlsf.
+ *
+ * The free blocks are kept in a list per size class. The first level splits
+ * the sizes in powers of two, the second level splits every power of two in
+ * 2 ^ configHEAP_TLSF_SL_LOG2 classes. A bit map per level records which
+ * lists are not empty, so pvPortMalloc() finds a list with a block that is
+ * large enough with two bit scans instead of walking the free blocks. A
+ * request is rounded up to the next class, which wastes at most a part
+ * 1 / 2 ^ configHEAP_TLSF_SL_LOG2 of a block.
+ *
+ * Every block records the block in front of it, so vPortFree() merges a
+ * block with both free neighbours without walking the free blocks either.
+ * The time of both functions does not depend on the history of the heap.
+ *
+ * The lists take 4 * ( 1 + 2 ^ configHEAP_TLSF_SL_LOG2 ) bytes per power of
+ * two up to configTOTAL_HEAP_SIZE, outside the heap.
+ */
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* Second level classes per power of two, as a power of two. */
+#ifndef configHEAP_TLSF_SL_LOG2
+    #define configHEAP_TLSF_SL_LOG2    3
+#endif
+
+#if ( configHEAP_TLSF_SL_LOG2 < 1 ) || ( configHEAP_TLSF_SL_LOG2 > 5 )
+    #error configHEAP_TLSF_SL_LOG2 must be 1 to 5
+#endif
+
+/* Bit 0 of the block size is the free flag. */
+#if ( portBYTE_ALIGNMENT < 4 )
+    #error heap_tlsf.c needs a portBYTE_ALIGNMENT of at least 4
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE         ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )         ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* Index of the most significant bit of a constant of up to 32 bits, sizes
+ * the tables at compile time. */
+#define heapCONST_MSB_2( x )     ( ( ( x ) & 0x2UL ) ? 1 : 0 )
+#define heapCONST_MSB_4( x )     ( ( ( x ) & 0xCUL ) ? ( 2 + heapCONST_MSB_2( ( x ) >> 2 ) ) : heapCONST_MSB_2( x ) )
+#define heapCONST_MSB_8( x )     ( ( ( x ) & 0xF0UL ) ? ( 4 + heapCONST_MSB_4( ( x ) >> 4 ) ) : heapCONST_MSB_4( x ) )
+#define heapCONST_MSB_16( x )    ( ( ( x ) & 0xFF00UL ) ? ( 8 + heapCONST_MSB_8( ( x ) >> 8 ) ) : heapCONST_MSB_8( x ) )
+#define heapCONST_MSB_32( x )    ( ( ( x ) & 0xFFFF0000UL ) ? ( 16 + heapCONST_MSB_16( ( x ) >> 16 ) ) : heapCONST_MSB_16( x ) )
+
+/* The size classes. Sizes below heapSMALL_BLOCK_SIZE are all in the first
+ * level list 0, with a class per portBYTE_ALIGNMENT bytes. Each next first
+ * level list holds a power of two. */
+#define heapALIGNMENT_LOG2       heapCONST_MSB_8( portBYTE_ALIGNMENT )
+#define heapSL_LOG2              ( configHEAP_TLSF_SL_LOG2 )
+#define heapSL_COUNT             ( 1U << heapSL_LOG2 )
+#define heapFL_SHIFT             ( heapSL_LOG2 + heapALIGNMENT_LOG2 )
+#define heapSMALL_BLOCK_SIZE     ( ( size_t ) 1 << heapFL_SHIFT )
+#define heapFL_COUNT             ( heapCONST_MSB_32( configTOTAL_HEAP_SIZE ) - heapFL_SHIFT + 2 )
+
+/* Bit 0 of the xBlockSize member of a TlsfBlock_t structure is set while the
+ * block is in a free list. The sizes are multiples of portBYTE_ALIGNMENT. */
+#define heapBLOCK_FREE_BIT                 ( ( size_t ) 1 )
+#define heapBLOCK_SIZE( pxBlock )          ( ( pxBlock )->xBlockSize & ~heapBLOCK_FREE_BIT )
+#define heapBLOCK_IS_FREE( pxBlock )       ( ( ( pxBlock )->xBlockSize & heapBLOCK_FREE_BIT ) != 0 )
+
+/* The block behind a block in memory. */
+#define heapNEXT_PHYS_BLOCK( pxBlock )     ( ( TlsfBlock_t * ) ( void * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/*-----------------------------------------------------------*/
+
+/* Allocate the memory for the heap. */
+#if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
+
+/* The application writer has already defined the array used for the RTOS
+* heap - probably so it can be placed in a special segment or address. */
+    extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+    PRIVILEGED_DATA static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* The header of a block. The free list links are only used while the block
+ * is free, they are part of the memory returned by pvPortMalloc(). */
+typedef struct A_TLSF_BLOCK
+{
+    struct A_TLSF_BLOCK * pxPrevPhysBlock; /*<< The block in front of this one in memory, NULL for the first block. */
+    size_t xBlockSize;                     /*<< The size of the block including the header. */
+    struct A_TLSF_BLOCK * pxNextFreeBlock; /*<< The next block in the free list. */
+    struct A_TLSF_BLOCK * pxPrevFreeBlock; /*<< The previous block in the free list. */
+} TlsfBlock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the first and second level list of a block size.
+ */
+static void prvMapInsert( size_t xSize,
+                          UBaseType_t * puxFl,
+                          UBaseType_t * puxSl ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the first list of which every block is at least xSize bytes.
+ */
+static void prvMapSearch( size_t xSize,
+                          UBaseType_t * puxFl,
+                          UBaseType_t * puxSl ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the first block of the first list that is not empty at or above
+ * the given list, NULL if there is none.
+ */
+static TlsfBlock_t * prvFindFreeBlock( UBaseType_t uxFl,
+                                       UBaseType_t uxSl ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds a block to, or removes a block from, the list of its size.
+ */
+static void prvInsertFreeBlock( TlsfBlock_t * pxBlock ) PRIVILEGED_FUNCTION;
+static void prvRemoveFreeBlock( TlsfBlock_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* The size of the structure placed at the beginning of each allocated memory
+ * block must by correctly byte aligned. */
+static const size_t xHeapStructSize = ( offsetof( TlsfBlock_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* A free block must hold the free list links. */
+static const size_t xMinimumBlockSize = ( sizeof( TlsfBlock_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The free lists and the bit maps of the lists that are not empty. */
+PRIVILEGED_DATA static TlsfBlock_t * pxFreeLists[ heapFL_COUNT ][ heapSL_COUNT ];
+PRIVILEGED_DATA static uint32_t ulFlBitmap = 0U;
+PRIVILEGED_DATA static uint32_t ulSlBitmap[ heapFL_COUNT ];
+
+/* Marks the end of the heap, an allocated block of size 0. */
+PRIVILEGED_DATA static TlsfBlock_t * pxEnd = NULL;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation. */
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = 0;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = 0;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    TlsfBlock_t * pxBlock = NULL;
+    TlsfBlock_t * pxNewBlock;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+    UBaseType_t uxFl, uxSl;
+
+    vTaskSuspendAll();
+    {
+        /* If this is the first call to malloc then the heap will require
+         * initialisation to setup the list of free blocks. */
+        if( pxEnd == NULL )
+        {
+            prvHeapInit();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xWantedSize > 0 )
+        {
+            /* The wanted size must be increased so it can contain the header
+             * in addition to the requested amount of bytes, and rounded up to
+             * the alignment. */
+            xAdditionalRequiredSize = xHeapStructSize + ( ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) ) & portBYTE_ALIGNMENT_MASK );
+
+            if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+            {
+                xWantedSize += xAdditionalRequiredSize;
+
+                if( xWantedSize < xMinimumBlockSize )
+                {
+                    xWantedSize = xMinimumBlockSize;
+                }
+            }
+            else
+            {
+                xWantedSize = 0;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+        {
+            /* Any block in the list found by the search is large enough. A
+             * request rounded up beyond the largest list cannot be met. */
+            prvMapSearch( xWantedSize, &uxFl, &uxSl );
+
+            if( uxFl < heapFL_COUNT )
+            {
+                pxBlock = prvFindFreeBlock( uxFl, uxSl );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxBlock != NULL )
+        {
+            prvRemoveFreeBlock( pxBlock );
+
+            /* If the block is larger than required it can be split into two.
+             * The block behind it is not free, so the remainder does not
+             * need to be merged. */
+            if( ( pxBlock->xBlockSize - xWantedSize ) >= xMinimumBlockSize )
+            {
+                pxNewBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                configASSERT( ( ( ( size_t ) pxNewBlock ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                pxNewBlock->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                pxNewBlock->pxPrevPhysBlock = pxBlock;
+                heapNEXT_PHYS_BLOCK( pxNewBlock )->pxPrevPhysBlock = pxNewBlock;
+                pxBlock->xBlockSize = xWantedSize;
+
+                prvInsertFreeBlock( pxNewBlock );
+            }
+            else
+            {
+                /* The whole block is traced, so the allocated and freed
+                 * bytes match. */
+                xWantedSize = pxBlock->xBlockSize;
+            }
+
+            xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+            if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+            {
+                xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+            xNumberOfSuccessfulAllocations++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    TlsfBlock_t * pxBlock;
+    TlsfBlock_t * pxNeighbour;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have a header immediately before it. */
+        pxBlock = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+
+        configASSERT( heapBLOCK_IS_FREE( pxBlock ) == 0 );
+        configASSERT( heapNEXT_PHYS_BLOCK( pxBlock )->pxPrevPhysBlock == pxBlock );
+
+        if( ( heapBLOCK_IS_FREE( pxBlock ) == 0 ) && ( pxBlock->xBlockSize != 0 ) )
+        {
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( pv, 0, pxBlock->xBlockSize - xHeapStructSize );
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                xFreeBytesRemaining += pxBlock->xBlockSize;
+                traceFREE( pv, pxBlock->xBlockSize );
+
+                /* Two free blocks are never next to each other, so merging
+                 * with the neighbour on both sides is enough. */
+                pxNeighbour = pxBlock->pxPrevPhysBlock;
+
+                if( ( pxNeighbour != NULL ) && ( heapBLOCK_IS_FREE( pxNeighbour ) != 0 ) )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxNeighbour->xBlockSize += pxBlock->xBlockSize;
+                    pxBlock = pxNeighbour;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxNeighbour = heapNEXT_PHYS_BLOCK( pxBlock );
+
+                if( heapBLOCK_IS_FREE( pxNeighbour ) != 0 )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxBlock->xBlockSize += pxNeighbour->xBlockSize;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                heapNEXT_PHYS_BLOCK( pxBlock )->pxPrevPhysBlock = pxBlock;
+                prvInsertFreeBlock( pxBlock );
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
+{
+    TlsfBlock_t * pxFirstFreeBlock;
+    uint8_t * pucAlignedHeap;
+    portPOINTER_SIZE_TYPE uxAddress;
+    size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+    /* Ensure the heap starts on a correctly aligned boundary. */
+    uxAddress = ( portPOINTER_SIZE_TYPE ) ucHeap;
+
+    if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+    {
+        uxAddress += ( portBYTE_ALIGNMENT - 1 );
+        uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+        xTotalHeapSize -= uxAddress - ( portPOINTER_SIZE_TYPE ) ucHeap;
+    }
+
+    pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+    /* pxEnd is an allocated block of size 0 at the end of the heap space, so
+     * the last block never merges past the end. */
+    uxAddress = ( ( portPOINTER_SIZE_TYPE ) pucAlignedHeap ) + xTotalHeapSize;
+    uxAddress -= xHeapStructSize;
+    uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+    pxEnd = ( TlsfBlock_t * ) uxAddress;
+    pxEnd->xBlockSize = 0;
+
+    /* To start with there is a single free block that is sized to take up the
+     * entire heap space, minus the space taken by pxEnd. */
+    pxFirstFreeBlock = ( TlsfBlock_t * ) pucAlignedHeap;
+    pxFirstFreeBlock->xBlockSize = ( size_t ) ( uxAddress - ( portPOINTER_SIZE_TYPE ) pxFirstFreeBlock );
+    pxFirstFreeBlock->pxPrevPhysBlock = NULL;
+    pxEnd->pxPrevPhysBlock = pxFirstFreeBlock;
+
+    prvInsertFreeBlock( pxFirstFreeBlock );
+
+    /* Only one block exists - and it covers the entire usable heap space. */
+    xMinimumEverFreeBytesRemaining = heapBLOCK_SIZE( pxFirstFreeBlock );
+    xFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapInsert( size_t xSize,
+                          UBaseType_t * puxFl,
+                          UBaseType_t * puxSl ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxMsb;
+
+    if( xSize < heapSMALL_BLOCK_SIZE )
+    {
+        *puxFl = 0;
+        *puxSl = ( UBaseType_t ) ( xSize >> heapALIGNMENT_LOG2 );
+    }
+    else
+    {
+        /* The Cortex-M0+ has no CLZ instruction, the libgcc routine does
+         * not loop over the bits either. */
+        uxMsb = ( UBaseType_t ) ( ( sizeof( unsigned long ) * heapBITS_PER_BYTE ) - 1U - ( size_t ) __builtin_clzl( ( unsigned long ) xSize ) );
+        *puxSl = ( UBaseType_t ) ( ( xSize >> ( uxMsb - heapSL_LOG2 ) ) ^ heapSL_COUNT );
+        *puxFl = uxMsb - heapFL_SHIFT + 1U;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapSearch( size_t xSize,
+                          UBaseType_t * puxFl,
+                          UBaseType_t * puxSl ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxMsb;
+
+    /* Round up to the next class, each class of the small sizes is one
+     * size. */
+    if( xSize >= heapSMALL_BLOCK_SIZE )
+    {
+        uxMsb = ( UBaseType_t ) ( ( sizeof( unsigned long ) * heapBITS_PER_BYTE ) - 1U - ( size_t ) __builtin_clzl( ( unsigned long ) xSize ) );
+        xSize += ( ( ( size_t ) 1 ) << ( uxMsb - heapSL_LOG2 ) ) - 1U;
+    }
+
+    prvMapInsert( xSize, puxFl, puxSl );
+}
+/*-----------------------------------------------------------*/
+
+static TlsfBlock_t * prvFindFreeBlock( UBaseType_t uxFl,
+                                       UBaseType_t uxSl ) /* PRIVILEGED_FUNCTION */
+{
+    uint32_t ulMap = ulSlBitmap[ uxFl ] & ( ~0UL << uxSl );
+
+    if( ulMap == 0U )
+    {
+        /* No list of this power of two has a block, take the smallest list
+         * of a larger power of two. */
+        ulMap = ulFlBitmap & ( ~0UL << ( uxFl + 1U ) );
+
+        if( ulMap == 0U )
+        {
+            return NULL;
+        }
+
+        uxFl = ( UBaseType_t ) __builtin_ctzl( ulMap );
+        ulMap = ulSlBitmap[ uxFl ];
+    }
+
+    uxSl = ( UBaseType_t ) __builtin_ctzl( ulMap );
+
+    return pxFreeLists[ uxFl ][ uxSl ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( TlsfBlock_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFl, uxSl;
+    TlsfBlock_t * pxHead;
+
+    prvMapInsert( pxBlock->xBlockSize, &uxFl, &uxSl );
+
+    pxHead = pxFreeLists[ uxFl ][ uxSl ];
+    pxBlock->pxNextFreeBlock = pxHead;
+    pxBlock->pxPrevFreeBlock = NULL;
+
+    if( pxHead != NULL )
+    {
+        pxHead->pxPrevFreeBlock = pxBlock;
+    }
+
+    pxFreeLists[ uxFl ][ uxSl ] = pxBlock;
+    ulFlBitmap |= 1UL << uxFl;
+    ulSlBitmap[ uxFl ] |= 1UL << uxSl;
+
+    pxBlock->xBlockSize |= heapBLOCK_FREE_BIT;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( TlsfBlock_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFl, uxSl;
+
+    pxBlock->xBlockSize &= ~heapBLOCK_FREE_BIT;
+    prvMapInsert( pxBlock->xBlockSize, &uxFl, &uxSl );
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock->pxPrevFreeBlock;
+    }
+
+    if( pxBlock->pxPrevFreeBlock != NULL )
+    {
+        pxBlock->pxPrevFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+    }
+    else
+    {
+        pxFreeLists[ uxFl ][ uxSl ] = pxBlock->pxNextFreeBlock;
+
+        if( pxBlock->pxNextFreeBlock == NULL )
+        {
+            ulSlBitmap[ uxFl ] &= ~( 1UL << uxSl );
+
+            if( ulSlBitmap[ uxFl ] == 0U )
+            {
+                ulFlBitmap &= ~( 1UL << uxFl );
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    TlsfBlock_t * pxBlock;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+    UBaseType_t uxFl, uxSl;
+
+    vTaskSuspendAll();
+    {
+        /* The lists are empty if the heap has not been initialised.  The heap
+         * is initialised automatically when the first allocation is made. */
+        for( uxFl = 0; uxFl < heapFL_COUNT; uxFl++ )
+        {
+            for( uxSl = 0; uxSl < heapSL_COUNT; uxSl++ )
+            {
+                for( pxBlock = pxFreeLists[ uxFl ][ uxSl ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    xBlocks++;
+
+                    if( heapBLOCK_SIZE( pxBlock ) > xMaxSize )
+                    {
+                        xMaxSize = heapBLOCK_SIZE( pxBlock );
+                    }
+
+                    if( heapBLOCK_SIZE( pxBlock ) < xMinSize )
+                    {
+                        xMinSize = heapBLOCK_SIZE( pxBlock );
+                    }
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
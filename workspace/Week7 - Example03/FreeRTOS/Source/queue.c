@@ -54,6 +54,16 @@
 #define queueLOCKED_UNMODIFIED    ( ( int8_t ) 0 )
 #define queueINT8_MAX             ( ( int8_t ) 127 )
 
+/* Set configQUEUE_SMALL_ITEM_COPY to 1 in FreeRTOSConfig.h to copy items of
+ * 1, 2 and 4 bytes with a single load and store, see prvCopyItem(). */
+#ifndef configQUEUE_SMALL_ITEM_COPY
+    #define configQUEUE_SMALL_ITEM_COPY    0
+#endif
+
+#ifndef portFORCE_INLINE
+    #define portFORCE_INLINE
+#endif
+
 /* When the Queue_t structure is used to represent a base queue its pcHead and
  * pcTail members are used as pointers into the queue storage area.  When the
  * Queue_t structure is used to represent a mutex pcHead and pcTail pointers are
@@ -189,6 +199,22 @@ static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION
  */
 static BaseType_t prvIsQueueFull( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
 
+#if ( configQUEUE_SMALL_ITEM_COPY == 1 )
+
+/*
+ * Copies an item to or from the queue storage area.  Items of 1 byte, and of
+ * 2 and 4 bytes at aligned addresses, are copied with a single load and store
+ * instead of a call to memcpy(), which is called inside a critical section.
+ * The storage area is aligned if the queue was created with xQueueCreate(),
+ * or with xQueueCreateStatic() and storage aligned to the item size.
+ */
+    static portFORCE_INLINE void prvCopyItem( void * pvDest,
+                                              const void * pvSource,
+                                              const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#else
+    #define prvCopyItem( pvDest, pvSource, uxItemSize )    ( void ) configMEMCPY( ( pvDest ), ( pvSource ), ( size_t ) ( uxItemSize ) )
+#endif
+
 /*
  * Copies an item into the queue, either at the front of the queue or the
  * back of the queue.
@@ -2202,7 +2228,7 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
     else if( xPosition == queueSEND_TO_BACK )
     {
-        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        prvCopyItem( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
         pxQueue->pcWriteTo += pxQueue->uxItemSize;                                                       /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
 
         if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )                                             /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
@@ -2216,7 +2242,7 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
     else
     {
-        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
+        prvCopyItem( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
         pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
 
         if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
@@ -2271,11 +2297,40 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
             mtCOVERAGE_TEST_MARKER();
         }
 
-        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        prvCopyItem( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
     }
 }
 /*-----------------------------------------------------------*/
 
+#if ( configQUEUE_SMALL_ITEM_COPY == 1 )
+
+    static portFORCE_INLINE void prvCopyItem( void * pvDest,
+                                              const void * pvSource,
+                                              const UBaseType_t uxItemSize )
+    {
+        const uintptr_t uxAddresses = ( uintptr_t ) pvDest | ( uintptr_t ) pvSource;
+
+        if( uxItemSize == ( UBaseType_t ) 1 )
+        {
+            *( ( uint8_t * ) pvDest ) = *( ( const uint8_t * ) pvSource );
+        }
+        else if( ( uxItemSize == ( UBaseType_t ) 4 ) && ( ( uxAddresses & ( uintptr_t ) 3 ) == ( uintptr_t ) 0 ) )
+        {
+            *( ( uint32_t * ) pvDest ) = *( ( const uint32_t * ) pvSource );
+        }
+        else if( ( uxItemSize == ( UBaseType_t ) 2 ) && ( ( uxAddresses & ( uintptr_t ) 1 ) == ( uintptr_t ) 0 ) )
+        {
+            *( ( uint16_t * ) pvDest ) = *( ( const uint16_t * ) pvSource );
+        }
+        else
+        {
+            ( void ) configMEMCPY( pvDest, pvSource, ( size_t ) uxItemSize );
+        }
+    }
+
+#endif /* configQUEUE_SMALL_ITEM_COPY */
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2613,7 +2668,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 }
 
                 --( pxQueue->uxMessagesWaiting );
-                ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+                prvCopyItem( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, pxQueue->uxItemSize );
 
                 xReturn = pdPASS;
 
@@ -2727,7 +2782,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
             }
 
             --( pxQueue->uxMessagesWaiting );
-            ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+            prvCopyItem( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, pxQueue->uxItemSize );
 
             if( ( *pxCoRoutineWoken ) == pdFALSE )
             {
@@ -304,6 +304,33 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                       size_t xCount,
                                       size_t xTail ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_STREAM_BUFFER_SPANS == 1 )
+
+/*
+ * Describes xCount bytes of the pxStreamBuffer's data storage area, starting at
+ * xIndex, in pxSpan.  xIndex may be less than one buffer length past the end.
+ */
+    static size_t prvGetSpan( const StreamBuffer_t * const pxStreamBuffer,
+                              size_t xIndex,
+                              size_t xCount,
+                              StreamBufferSpan_t * const pxSpan ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves xHead past xDataLengthBytes that were written in place, after writing
+ * the length of the message if this is a message buffer.
+ */
+    static size_t prvCommitSpan( StreamBuffer_t * const pxStreamBuffer,
+                                 size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves xTail past xDataLengthBytes that were read in place, or past the next
+ * message if this is a message buffer.
+ */
+    static size_t prvReleaseSpan( StreamBuffer_t * const pxStreamBuffer,
+                                  size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_SPANS */
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -1245,6 +1272,408 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_STREAM_BUFFER_SPANS == 1 )
+
+    static size_t prvGetSpan( const StreamBuffer_t * const pxStreamBuffer,
+                              size_t xIndex,
+                              size_t xCount,
+                              StreamBufferSpan_t * const pxSpan )
+    {
+        size_t xFirstLength;
+
+        if( xIndex >= pxStreamBuffer->xLength )
+        {
+            xIndex -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The part up to the end of the storage area, the rest continues at
+         * its start. */
+        xFirstLength = configMIN( pxStreamBuffer->xLength - xIndex, xCount );
+
+        pxSpan->pucData = ( xCount > ( size_t ) 0 ) ? &( pxStreamBuffer->pucBuffer[ xIndex ] ) : NULL;
+        pxSpan->xLength = xFirstLength;
+
+        if( xCount > xFirstLength )
+        {
+            pxSpan->pucWrapped = pxStreamBuffer->pucBuffer;
+            pxSpan->xWrappedLength = xCount - xFirstLength;
+        }
+        else
+        {
+            pxSpan->pucWrapped = NULL;
+            pxSpan->xWrappedLength = 0;
+        }
+
+        return xCount;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+                                     StreamBufferSpan_t * const pxSpan,
+                                     TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xSpace, xBytesToStoreMessageLength;
+        TimeOut_t xTimeOut;
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( pxSpan );
+
+        /* The length of a message is written in front of it by the commit, so
+         * the span of a message buffer starts after it. */
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        }
+        else
+        {
+            xBytesToStoreMessageLength = 0;
+        }
+
+        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+        if( ( xSpace <= xBytesToStoreMessageLength ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+
+            do
+            {
+                /* Wait until there is room for at least one byte, as in
+                 * xStreamBufferSend(). */
+                taskENTER_CRITICAL();
+                {
+                    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+                    if( xSpace <= xBytesToStoreMessageLength )
+                    {
+                        ( void ) xTaskNotifyStateClear( NULL );
+
+                        /* Should only be one writer. */
+                        configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                        pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                    }
+                    else
+                    {
+                        taskEXIT_CRITICAL();
+                        break;
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                pxStreamBuffer->xTaskWaitingToSend = NULL;
+            } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+
+            xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xSpace = ( xSpace > xBytesToStoreMessageLength ) ? ( xSpace - xBytesToStoreMessageLength ) : ( size_t ) 0;
+
+        return prvGetSpan( pxStreamBuffer, pxStreamBuffer->xHead + xBytesToStoreMessageLength, xSpace, pxSpan );
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvCommitSpan( StreamBuffer_t * const pxStreamBuffer,
+                                 size_t xDataLengthBytes )
+    {
+        size_t xNextHead = pxStreamBuffer->xHead;
+        configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength;
+
+        if( xDataLengthBytes == ( size_t ) 0 )
+        {
+            return 0;
+        }
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            configASSERT( ( xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH ) <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+            xMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
+            configASSERT( ( size_t ) xMessageLength == xDataLengthBytes );
+
+            /* The data is in place already, only the length is copied. */
+            xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+        }
+        else
+        {
+            configASSERT( xDataLengthBytes <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+        }
+
+        xNextHead += xDataLengthBytes;
+
+        if( xNextHead >= pxStreamBuffer->xLength )
+        {
+            xNextHead -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The reader sees the data once the head moved. */
+        pxStreamBuffer->xHead = xNextHead;
+
+        return xDataLengthBytes;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xDataLengthBytes )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn;
+
+        configASSERT( pxStreamBuffer );
+
+        xReturn = prvCommitSpan( pxStreamBuffer, xDataLengthBytes );
+
+        if( xReturn > ( size_t ) 0 )
+        {
+            traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+            /* Was a task waiting for the data? */
+            if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+            {
+                prvSEND_COMPLETED( pxStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           size_t xDataLengthBytes,
+                                           BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn;
+
+        configASSERT( pxStreamBuffer );
+
+        xReturn = prvCommitSpan( pxStreamBuffer, xDataLengthBytes );
+
+        if( xReturn > ( size_t ) 0 )
+        {
+            /* Was a task waiting for the data? */
+            if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+            {
+                prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+                                        StreamBufferSpan_t * const pxSpan,
+                                        TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xBytesAvailable, xBytesToStoreMessageLength;
+        configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( pxSpan );
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        }
+        else
+        {
+            xBytesToStoreMessageLength = 0;
+        }
+
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            /* Checking if there is data and clearing the notification state must
+             * be performed atomically, as in xStreamBufferReceive(). */
+            taskENTER_CRITICAL();
+            {
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+                if( xBytesAvailable <= xBytesToStoreMessageLength )
+                {
+                    ( void ) xTaskNotifyStateClear( NULL );
+
+                    /* Should only be one reader. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                    pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xBytesAvailable <= xBytesToStoreMessageLength )
+            {
+                traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                pxStreamBuffer->xTaskWaitingToReceive = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+        if( xBytesAvailable <= xBytesToStoreMessageLength )
+        {
+            xBytesAvailable = 0;
+        }
+        else if( xBytesToStoreMessageLength != ( size_t ) 0 )
+        {
+            /* The span of a message buffer is the next message. */
+            ( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, pxStreamBuffer->xTail );
+            xBytesAvailable = ( size_t ) xTempNextMessageLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return prvGetSpan( pxStreamBuffer, pxStreamBuffer->xTail + xBytesToStoreMessageLength, xBytesAvailable, pxSpan );
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvReleaseSpan( StreamBuffer_t * const pxStreamBuffer,
+                                  size_t xDataLengthBytes )
+    {
+        const size_t xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+        size_t xCount = xDataLengthBytes;
+        size_t xNextTail = pxStreamBuffer->xTail;
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            if( xBytesAvailable <= sbBYTES_TO_STORE_MESSAGE_LENGTH )
+            {
+                return 0;
+            }
+
+            /* A message is released as a whole, including its length. */
+            xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+            xCount = ( size_t ) xTempNextMessageLength;
+        }
+        else
+        {
+            xCount = configMIN( xCount, xBytesAvailable );
+        }
+
+        if( xCount == ( size_t ) 0 )
+        {
+            return 0;
+        }
+
+        xNextTail += xCount;
+
+        if( xNextTail >= pxStreamBuffer->xLength )
+        {
+            xNextTail -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The writer may reuse the memory once the tail moved. */
+        pxStreamBuffer->xTail = xNextTail;
+
+        return xCount;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xDataLengthBytes )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReceivedLength;
+
+        configASSERT( pxStreamBuffer );
+
+        xReceivedLength = prvReleaseSpan( pxStreamBuffer, xDataLengthBytes );
+
+        /* Was a task waiting for space in the buffer? */
+        if( xReceivedLength != ( size_t ) 0 )
+        {
+            traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+            prvRECEIVE_COMPLETED( xStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReceivedLength;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+                                               size_t xDataLengthBytes,
+                                               BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReceivedLength;
+
+        configASSERT( pxStreamBuffer );
+
+        xReceivedLength = prvReleaseSpan( pxStreamBuffer, xDataLengthBytes );
+
+        /* Was a task waiting for space in the buffer? */
+        if( xReceivedLength != ( size_t ) 0 )
+        {
+            prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
+
+        return xReceivedLength;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_SPANS */
+/*-----------------------------------------------------------*/
+
 static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                      const uint8_t * pucData,
                                      size_t xCount,
@@ -1261,7 +1690,7 @@ static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
 
     /* Write as many bytes as can be written in the first write. */
     configASSERT( ( xHead + xFirstLength ) <= pxStreamBuffer->xLength );
-    ( void ) memcpy( ( void * ) ( &( pxStreamBuffer->pucBuffer[ xHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+    ( void ) configMEMCPY( ( void * ) ( &( pxStreamBuffer->pucBuffer[ xHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
 
     /* If the number of bytes written was less than the number that could be
      * written in the first write... */
@@ -1269,7 +1698,7 @@ static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
     {
         /* ...then write the remaining bytes to the start of the buffer. */
         configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
-        ( void ) memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+        ( void ) configMEMCPY( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
     }
     else
     {
@@ -1309,14 +1738,14 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
      * read.  Asserts check bounds of read and write. */
     configASSERT( xFirstLength <= xCount );
     configASSERT( ( xTail + xFirstLength ) <= pxStreamBuffer->xLength );
-    ( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+    ( void ) configMEMCPY( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
 
     /* If the total number of wanted bytes is greater than the number
      * that could be read in the first read... */
     if( xCount > xFirstLength )
     {
         /* ...then read the remaining bytes from the start of the buffer. */
-        ( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+        ( void ) configMEMCPY( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
     }
     else
     {
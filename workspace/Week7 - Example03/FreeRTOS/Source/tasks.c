@@ -196,6 +196,45 @@
 
 /*-----------------------------------------------------------*/
 
+/* Set configUSE_DELAYED_WHEEL to 1 in FreeRTOSConfig.h to keep the delayed
+ * tasks in a timing wheel of configDELAYED_WHEEL_SIZE unsorted lists, indexed by
+ * the wake time, instead of in a sorted list.  Blocking with a timeout then takes
+ * constant time, see prvAddTaskToDelayedWheel(). */
+#ifndef configUSE_DELAYED_WHEEL
+    #define configUSE_DELAYED_WHEEL    0
+#endif
+
+#ifndef configDELAYED_WHEEL_SIZE
+    #define configDELAYED_WHEEL_SIZE    32
+#endif
+
+#if ( configUSE_DELAYED_WHEEL == 1 )
+
+    #if ( ( configDELAYED_WHEEL_SIZE & ( configDELAYED_WHEEL_SIZE - 1 ) ) != 0 )
+        #error configDELAYED_WHEEL_SIZE must be a power of two
+    #endif
+
+/* The list of the wheel that holds the tasks with wake time xTime. */
+    #define taskWHEEL_INDEX( xTime )             ( ( UBaseType_t ) ( ( xTime ) & ( TickType_t ) ( configDELAYED_WHEEL_SIZE - 1 ) ) )
+
+/* pdTRUE if wake time xA comes before wake time xB, counted from xNow. This
+ * also holds when the tick count overflows in between. */
+    #define taskWHEEL_BEFORE( xA, xB, xNow )    ( ( TickType_t ) ( ( xA ) - ( xNow ) ) < ( TickType_t ) ( ( xB ) - ( xNow ) ) )
+
+/* pdTRUE if pxList is one of the lists of the wheel. */
+    #define taskIS_DELAYED_LIST( pxList )                       \
+    ( ( ( pxList ) >= &( xDelayedWheel[ 0 ] ) ) &&              \
+      ( ( pxList ) < &( xDelayedWheel[ configDELAYED_WHEEL_SIZE ] ) ) )
+
+/* The wheel does not depend on the epoch of the tick count, only the
+ * overflows are counted for the time outs. */
+    #define taskSWITCH_DELAYED_LISTS() \
+    {                              \
+        xNumOfOverflows++;         \
+    }
+
+#else /* configUSE_DELAYED_WHEEL */
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
  * count overflows. */
 #define taskSWITCH_DELAYED_LISTS()                                                \
@@ -212,6 +251,26 @@
         prvResetNextTaskUnblockTime();                                            \
     }
 
+#endif /* configUSE_DELAYED_WHEEL */
+
+/*-----------------------------------------------------------*/
+
+/* Set configUSE_TIME_SLICE_QUANTUM to 1 in FreeRTOSConfig.h to give the tasks
+ * of a priority a time slice of configTIME_SLICE_TICKS( uxPriority ) ticks
+ * instead of one tick.  A task that blocks or is preempted before its slice
+ * ends starts a new slice when it runs again. */
+#ifndef configUSE_TIME_SLICE_QUANTUM
+    #define configUSE_TIME_SLICE_QUANTUM    0
+#endif
+
+#ifndef configTIME_SLICE_TICKS
+    #define configTIME_SLICE_TICKS( uxPriority )    ( ( TickType_t ) 1 )
+#endif
+
+#if ( configUSE_TIME_SLICE_QUANTUM == 1 ) && ( ( configUSE_PREEMPTION == 0 ) || ( configUSE_TIME_SLICING == 0 ) )
+    #error configUSE_TIME_SLICE_QUANTUM needs configUSE_PREEMPTION and configUSE_TIME_SLICING
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -326,17 +385,22 @@ typedef tskTCB TCB_t;
 
 /*lint -save -e956 A manual analysis and inspection has been used to determine
  * which static variables must be declared volatile. */
-portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+portDONT_DISCARD PRIVILEGED_DATA __DATA_HOT TCB_t * volatile pxCurrentTCB = NULL;
 
 /* Lists for ready and blocked tasks. --------------------
  * xDelayedTaskList1 and xDelayedTaskList2 could be moved to function scope but
  * doing so breaks some kernel aware debuggers and debuggers that rely on removing
  * the static qualifier. */
-PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /*< Prioritised ready tasks. */
+PRIVILEGED_DATA __DATA_HOT static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /*< Prioritised ready tasks. */
+#if ( configUSE_DELAYED_WHEEL == 1 )
+    PRIVILEGED_DATA static List_t xDelayedWheel[ configDELAYED_WHEEL_SIZE ];          /*< Delayed tasks, in the list of their wake time modulo configDELAYED_WHEEL_SIZE, unsorted. */
+    PRIVILEGED_DATA static TickType_t xDelayedWheelNext[ configDELAYED_WHEEL_SIZE ];  /*< Earliest wake time in each list of the wheel.  May be earlier when a task left the list before it timed out. */
+#else
 PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /*< Delayed tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used. */
+PRIVILEGED_DATA __DATA_HOT static List_t * volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used. */
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#endif
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -360,16 +424,20 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 
 /* Other file private variables. --------------------------------*/
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks = ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile TickType_t xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
-PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+PRIVILEGED_DATA __DATA_HOT static volatile TickType_t xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
+PRIVILEGED_DATA __DATA_HOT static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning = pdFALSE;
-PRIVILEGED_DATA static volatile TickType_t xPendedTicks = ( TickType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+PRIVILEGED_DATA __DATA_HOT static volatile TickType_t xPendedTicks = ( TickType_t ) 0U;
+PRIVILEGED_DATA __DATA_HOT static volatile BaseType_t xYieldPending = pdFALSE;
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows = ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber = ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
+PRIVILEGED_DATA __DATA_HOT static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                          /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
 
+#if ( configUSE_TIME_SLICE_QUANTUM == 1 )
+    PRIVILEGED_DATA __DATA_HOT static TickType_t xTimeSliceTicks = ( TickType_t ) 0U; /*< Ticks the running task has used of its time slice. */
+#endif
+
 /* Improve support for OpenOCD. The kernel tracks Ready tasks via priority lists.
  * For tracking the state of remote threads, OpenOCD uses uxTopUsedPriority
  * to determine the number of priority lists to read back from the remote target. */
@@ -383,7 +451,7 @@ const volatile UBaseType_t uxTopUsedPriority = configMAX_PRIORITIES - 1U;
  * kernel to move the task from the pending ready list into the real ready list
  * when the scheduler is unsuspended.  The pending ready list itself can only be
  * accessed from a critical section. */
-PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t ) pdFALSE;
+PRIVILEGED_DATA __DATA_HOT static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t ) pdFALSE;
 
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
@@ -516,6 +584,24 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_DELAYED_WHEEL == 1 )
+
+/*
+ * Adds a task to the list of the wheel for its wake time.
+ */
+    static void prvAddTaskToDelayedWheel( ListItem_t * const pxStateListItem,
+                                          const TickType_t xTimeToWake,
+                                          const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by xTaskIncrementTick() when the tick count reaches
+ * xNextTaskUnblockTime.  Moves the tasks of the current tick to the ready
+ * lists and returns pdTRUE if a context switch is required.
+ */
+    static BaseType_t prvUnblockDelayedWheelTasks( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -844,7 +930,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     #if ( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
     {
         /* Fill the stack with a known value to assist debugging. */
-        ( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) ulStackDepth * sizeof( StackType_t ) );
+        ( void ) configMEMSET( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) ulStackDepth * sizeof( StackType_t ) );
     }
     #endif /* tskSET_NEW_STACKS_TO_KNOWN_VALUE */
 
@@ -1347,8 +1433,10 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         eTaskState eReturn;
         List_t const * pxStateList;
-        List_t const * pxDelayedList;
-        List_t const * pxOverflowedDelayedList;
+        #if ( configUSE_DELAYED_WHEEL == 0 )
+            List_t const * pxDelayedList;
+            List_t const * pxOverflowedDelayedList;
+        #endif
         const TCB_t * const pxTCB = xTask;
 
         configASSERT( pxTCB );
@@ -1363,12 +1451,18 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             taskENTER_CRITICAL();
             {
                 pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-                pxDelayedList = pxDelayedTaskList;
-                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+                #if ( configUSE_DELAYED_WHEEL == 0 )
+                    pxDelayedList = pxDelayedTaskList;
+                    pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+                #endif
             }
             taskEXIT_CRITICAL();
 
-            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            #if ( configUSE_DELAYED_WHEEL == 1 )
+                if( taskIS_DELAYED_LIST( pxStateList ) )
+            #else
+                if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            #endif
             {
                 /* The task being queried is referenced from one of the Blocked
                  * lists. */
@@ -2446,6 +2540,14 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
             } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
             /* Search the delayed lists. */
+            #if ( configUSE_DELAYED_WHEEL == 1 )
+            {
+                for( uxQueue = 0; ( uxQueue < ( UBaseType_t ) configDELAYED_WHEEL_SIZE ) && ( pxTCB == NULL ); uxQueue++ )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( &( xDelayedWheel[ uxQueue ] ), pcNameToQuery );
+                }
+            }
+            #else
             if( pxTCB == NULL )
             {
                 pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
@@ -2455,6 +2557,7 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
             {
                 pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
             }
+            #endif
 
             #if ( INCLUDE_vTaskSuspend == 1 )
             {
@@ -2507,8 +2610,17 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 
                 /* Fill in an TaskStatus_t structure with information on each
                  * task in the Blocked state. */
+                #if ( configUSE_DELAYED_WHEEL == 1 )
+                {
+                    for( uxQueue = 0; uxQueue < ( UBaseType_t ) configDELAYED_WHEEL_SIZE; uxQueue++ )
+                    {
+                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedWheel[ uxQueue ] ), eBlocked );
+                    }
+                }
+                #else
                 uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
                 uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+                #endif
 
                 #if ( INCLUDE_vTaskDelete == 1 )
                 {
@@ -2583,7 +2695,11 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
         /* Correct the tick count value after a period during which the tick
          * was suppressed.  Note this does *not* call the tick hook function for
          * each stepped tick. */
-        configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+        #if ( configUSE_DELAYED_WHEEL == 1 )
+            configASSERT( xTicksToJump <= ( TickType_t ) ( xNextTaskUnblockTime - xTickCount ) );
+        #else
+            configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+        #endif
 
         if( ( xTickCount + xTicksToJump ) == xNextTaskUnblockTime )
         {
@@ -2717,10 +2833,12 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 #endif /* INCLUDE_xTaskAbortDelay */
 /*----------------------------------------------------------*/
 
-BaseType_t xTaskIncrementTick( void )
+__RAMFUNC BaseType_t xTaskIncrementTick( void )
 {
-    TCB_t * pxTCB;
-    TickType_t xItemValue;
+    #if ( configUSE_DELAYED_WHEEL == 0 )
+        TCB_t * pxTCB;
+        TickType_t xItemValue;
+    #endif
     BaseType_t xSwitchRequired = pdFALSE;
 
     /* Called by the portable layer each time a tick interrupt occurs.
@@ -2747,6 +2865,21 @@ BaseType_t xTaskIncrementTick( void )
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( configUSE_DELAYED_WHEEL == 1 )
+
+            /* xNextTaskUnblockTime is the earliest wake time in the wheel, or
+             * the tick before the current one if no task is delayed.  The tick
+             * count increments by one, so it is reached exactly. */
+            if( xConstTickCount == xNextTaskUnblockTime )
+            {
+                xSwitchRequired = prvUnblockDelayedWheelTasks( xConstTickCount );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        #else /* configUSE_DELAYED_WHEEL */
+
         /* See if this tick has made a timeout expire.  Tasks are stored in
          * the  queue in the order of their wake time - meaning once one task
          * has been found whose block time has not expired there is no need to
@@ -2832,6 +2965,7 @@ BaseType_t xTaskIncrementTick( void )
                 }
             }
         }
+        #endif /* configUSE_DELAYED_WHEEL */
 
         /* Tasks of equal priority to the currently running task will share
          * processing time (time slice) if preemption is on, and the application
@@ -2840,7 +2974,24 @@ BaseType_t xTaskIncrementTick( void )
         {
             if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
             {
-                xSwitchRequired = pdTRUE;
+                #if ( configUSE_TIME_SLICE_QUANTUM == 1 )
+                {
+                    /* The slice ends after the ticks of the priority, the
+                     * running task keeps the CPU until then. */
+                    if( ++xTimeSliceTicks >= configTIME_SLICE_TICKS( pxCurrentTCB->uxPriority ) )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                #endif /* configUSE_TIME_SLICE_QUANTUM */
             }
             else
             {
@@ -3006,7 +3157,7 @@ BaseType_t xTaskIncrementTick( void )
 #endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
-void vTaskSwitchContext( void )
+__RAMFUNC void vTaskSwitchContext( void )
 {
     if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
     {
@@ -3057,11 +3208,29 @@ void vTaskSwitchContext( void )
         }
         #endif
 
+        #if ( configUSE_TIME_SLICE_QUANTUM == 1 )
+            TCB_t * const pxPreviousTCB = pxCurrentTCB;
+        #endif
+
         /* Select a new task to run using either the generic C or port
          * optimised asm code. */
         taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
         traceTASK_SWITCHED_IN();
 
+        #if ( configUSE_TIME_SLICE_QUANTUM == 1 )
+        {
+            /* A new task starts a new time slice. */
+            if( pxCurrentTCB != pxPreviousTCB )
+            {
+                xTimeSliceTicks = ( TickType_t ) 0U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIME_SLICE_QUANTUM */
+
         /* After the new task is switched in, update the global errno. */
         #if ( configUSE_POSIX_ERRNO == 1 )
         {
@@ -3510,7 +3679,9 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
                     /* Now the scheduler is suspended, the expected idle
                      * time can be sampled again, and this time its value can
                      * be used. */
-                    configASSERT( xNextTaskUnblockTime >= xTickCount );
+                    #if ( configUSE_DELAYED_WHEEL == 0 )
+                        configASSERT( xNextTaskUnblockTime >= xTickCount );
+                    #endif
                     xExpectedIdleTime = prvGetExpectedIdleTime();
 
                     /* Define the following macro to set xExpectedIdleTime to 0
@@ -3663,8 +3834,17 @@ static void prvInitialiseTaskLists( void )
         vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
     }
 
+    #if ( configUSE_DELAYED_WHEEL == 1 )
+    {
+        for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configDELAYED_WHEEL_SIZE; uxPriority++ )
+        {
+            vListInitialise( &( xDelayedWheel[ uxPriority ] ) );
+        }
+    }
+    #else
     vListInitialise( &xDelayedTaskList1 );
     vListInitialise( &xDelayedTaskList2 );
+    #endif
     vListInitialise( &xPendingReadyList );
 
     #if ( INCLUDE_vTaskDelete == 1 )
@@ -3679,10 +3859,14 @@ static void prvInitialiseTaskLists( void )
     }
     #endif /* INCLUDE_vTaskSuspend */
 
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-     * using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    #if ( configUSE_DELAYED_WHEEL == 0 )
+    {
+        /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+         * using list2. */
+        pxDelayedTaskList = &xDelayedTaskList1;
+        pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -3996,6 +4180,130 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DELAYED_WHEEL == 1 )
+
+static void prvResetNextTaskUnblockTime( void )
+{
+    const TickType_t xConstTickCount = xTickCount;
+    UBaseType_t uxIndex;
+
+    /* Without delayed tasks, the tick before the current one is the furthest
+     * away from it.  The cost depends on the size of the wheel only. */
+    TickType_t xNext = xConstTickCount - ( TickType_t ) 1;
+
+    for( uxIndex = 0; uxIndex < ( UBaseType_t ) configDELAYED_WHEEL_SIZE; uxIndex++ )
+    {
+        if( ( listLIST_IS_EMPTY( &( xDelayedWheel[ uxIndex ] ) ) == pdFALSE ) &&
+            ( taskWHEEL_BEFORE( xDelayedWheelNext[ uxIndex ], xNext, xConstTickCount ) ) )
+        {
+            xNext = xDelayedWheelNext[ uxIndex ];
+        }
+    }
+
+    xNextTaskUnblockTime = xNext;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddTaskToDelayedWheel( ListItem_t * const pxStateListItem,
+                                      const TickType_t xTimeToWake,
+                                      const TickType_t xConstTickCount )
+{
+    const UBaseType_t uxIndex = taskWHEEL_INDEX( xTimeToWake );
+    List_t * const pxList = &( xDelayedWheel[ uxIndex ] );
+
+    /* The list is not sorted, so adding a task takes constant time. */
+    if( ( listLIST_IS_EMPTY( pxList ) != pdFALSE ) ||
+        ( taskWHEEL_BEFORE( xTimeToWake, xDelayedWheelNext[ uxIndex ], xConstTickCount ) ) )
+    {
+        xDelayedWheelNext[ uxIndex ] = xTimeToWake;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    listINSERT_END( pxList, pxStateListItem );
+
+    if( taskWHEEL_BEFORE( xTimeToWake, xNextTaskUnblockTime, xConstTickCount ) )
+    {
+        xNextTaskUnblockTime = xTimeToWake;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+__RAMFUNC static BaseType_t prvUnblockDelayedWheelTasks( const TickType_t xConstTickCount )
+{
+    const UBaseType_t uxIndex = taskWHEEL_INDEX( xConstTickCount );
+    List_t * const pxList = &( xDelayedWheel[ uxIndex ] );
+    ListItem_t const * const pxEnd = listGET_END_MARKER( pxList );
+    ListItem_t * pxItem = listGET_HEAD_ENTRY( pxList );
+    TickType_t xListNext = xConstTickCount - ( TickType_t ) 1;
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    /* Only the list of the current tick is visited.  Its tasks either wake now
+     * or a multiple of configDELAYED_WHEEL_SIZE ticks later. */
+    while( pxItem != pxEnd )
+    {
+        ListItem_t * const pxNextItem = listGET_NEXT( pxItem );
+        const TickType_t xItemValue = listGET_LIST_ITEM_VALUE( pxItem );
+
+        if( xItemValue == xConstTickCount )
+        {
+            TCB_t * const pxTCB = listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            /* It is time to remove the item from the Blocked state. */
+            listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+            /* Is the task waiting on an event also?  If so remove it from the
+             * event list. */
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+            {
+                listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvAddTaskToReadyList( pxTCB );
+
+            #if ( configUSE_PREEMPTION == 1 )
+            {
+                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_PREEMPTION */
+        }
+        else if( taskWHEEL_BEFORE( xItemValue, xListNext, xConstTickCount ) )
+        {
+            xListNext = xItemValue;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxItem = pxNextItem;
+    }
+
+    xDelayedWheelNext[ uxIndex ] = xListNext;
+    prvResetNextTaskUnblockTime();
+
+    return xSwitchRequired;
+}
+
+#else /* configUSE_DELAYED_WHEEL */
+
 static void prvResetNextTaskUnblockTime( void )
 {
     if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
@@ -4015,6 +4323,8 @@ static void prvResetNextTaskUnblockTime( void )
         xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
     }
 }
+
+#endif /* configUSE_DELAYED_WHEEL */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
@@ -5294,6 +5604,41 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetCurrentRunTimeCounter( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulTotalRunTime, ulReturn;
+
+        taskENTER_CRITICAL();
+        {
+            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+            #else
+                ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+            #endif
+
+            /* The counter of the running task is only updated when it is
+             * switched out, add the time since it was switched in. */
+            ulReturn = pxCurrentTCB->ulRunTimeCounter;
+
+            if( ulTotalRunTime > ulTaskSwitchedInTime )
+            {
+                ulReturn += ( ulTotalRunTime - ulTaskSwitchedInTime );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return ulReturn;
+    }
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely )
 {
@@ -5341,6 +5686,9 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
             /* The list item will be inserted in wake time order. */
             listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+            #if ( configUSE_DELAYED_WHEEL == 1 )
+                prvAddTaskToDelayedWheel( &( pxCurrentTCB->xStateListItem ), xTimeToWake, xConstTickCount );
+            #else
             if( xTimeToWake < xConstTickCount )
             {
                 /* Wake time has overflowed.  Place this item in the overflow
@@ -5365,6 +5713,7 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
+            #endif /* configUSE_DELAYED_WHEEL */
         }
     }
     #else /* INCLUDE_vTaskSuspend */
@@ -5377,6 +5726,9 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         /* The list item will be inserted in wake time order. */
         listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+        #if ( configUSE_DELAYED_WHEEL == 1 )
+            prvAddTaskToDelayedWheel( &( pxCurrentTCB->xStateListItem ), xTimeToWake, xConstTickCount );
+        #else
         if( xTimeToWake < xConstTickCount )
         {
             /* Wake time has overflowed.  Place this item in the overflow list. */
@@ -5399,6 +5751,7 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                 mtCOVERAGE_TEST_MARKER();
             }
         }
+        #endif /* configUSE_DELAYED_WHEEL */
 
         /* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
         ( void ) xCanBlockIndefinitely;
@@ -71,6 +71,52 @@
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 0x02 )
     #define tmrSTATUS_IS_AUTORELOAD              ( ( uint8_t ) 0x04 )
 
+/* Set configUSE_TIMER_WHEEL to 1 in FreeRTOSConfig.h to keep the active timers
+ * in a timing wheel of configTIMER_WHEEL_SIZE unsorted lists, indexed by the
+ * expiry time, instead of in a sorted list.  Starting, resetting and stopping a
+ * timer then take constant time and are applied by the calling task or
+ * interrupt, without a message to the timer service task, see
+ * prvApplyTimerCommand(). */
+    #ifndef configUSE_TIMER_WHEEL
+        #define configUSE_TIMER_WHEEL    0
+    #endif
+
+    #ifndef configTIMER_WHEEL_SIZE
+        #define configTIMER_WHEEL_SIZE    16
+    #endif
+
+/* The index of the task notification the timer service task waits on when
+ * the timer wheel is used. */
+    #ifndef configTIMER_WHEEL_NOTIFY_INDEX
+        #define configTIMER_WHEEL_NOTIFY_INDEX    0
+    #endif
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        #if ( ( configTIMER_WHEEL_SIZE & ( configTIMER_WHEEL_SIZE - 1 ) ) != 0 )
+            #error configTIMER_WHEEL_SIZE must be a power of two
+        #endif
+
+        #if ( configUSE_TASK_NOTIFICATIONS == 0 )
+            #error configUSE_TIMER_WHEEL requires configUSE_TASK_NOTIFICATIONS
+        #endif
+
+/* Expiry times are compared by their distance, which must stay below half the
+ * range of the tick count. */
+        #define tmrWHEEL_HALF_RANGE                ( ( TickType_t ) ( ( tmrMAX_TIME_BEFORE_OVERFLOW >> 1 ) + 1U ) )
+
+/* The list of the wheel that holds the timers that expire at xTime. */
+        #define tmrWHEEL_INDEX( xTime )            ( ( UBaseType_t ) ( ( xTime ) & ( TickType_t ) ( configTIMER_WHEEL_SIZE - 1 ) ) )
+
+/* pdTRUE if expiry time xA comes before expiry time xB, counted from xNow.
+ * This also holds when the tick count overflows in between. */
+        #define tmrWHEEL_BEFORE( xA, xB, xNow )    ( ( TickType_t ) ( ( xA ) - ( xNow ) ) < ( TickType_t ) ( ( xB ) - ( xNow ) ) )
+
+/* pdTRUE if expiry time xTime is not after xNow. */
+        #define tmrWHEEL_IS_DUE( xTime, xNow )     ( ( TickType_t ) ( ( xNow ) - ( xTime ) ) < tmrWHEEL_HALF_RANGE )
+
+    #endif /* configUSE_TIMER_WHEEL */
+
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                  /* The old naming convention is used to prevent breaking kernel aware debuggers. */
     {
@@ -134,15 +180,27 @@
  * xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
  * breaks some kernel aware debuggers, and debuggers that reply on removing the
  * static qualifier. */
-    PRIVILEGED_DATA static List_t xActiveTimerList1;
-    PRIVILEGED_DATA static List_t xActiveTimerList2;
-    PRIVILEGED_DATA static List_t * pxCurrentTimerList;
-    PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+    #if ( configUSE_TIMER_WHEEL == 1 )
+        PRIVILEGED_DATA static List_t xTimerWheel[ configTIMER_WHEEL_SIZE ];         /*< Active timers, in the list of their expiry time modulo configTIMER_WHEEL_SIZE, unsorted.  Accessed in critical sections, also by other tasks and interrupts. */
+        PRIVILEGED_DATA static TickType_t xTimerWheelNext[ configTIMER_WHEEL_SIZE ]; /*< Earliest expiry time in each list of the wheel.  May be earlier when a timer left the list before it expired. */
+        PRIVILEGED_DATA static List_t xExpiredTimerList;                             /*< Expired timers of which the callback has not been called yet. */
+        PRIVILEGED_DATA static TickType_t xTimerWheelTime;                           /*< The lists of the wheel have been processed up to the tick before this one. */
+        PRIVILEGED_DATA static TickType_t xNextTimerExpiry;                          /*< Earliest expiry time in the wheel, or xTimerWheelTime - 1 if the wheel is empty. */
+    #else
+        PRIVILEGED_DATA static List_t xActiveTimerList1;
+        PRIVILEGED_DATA static List_t xActiveTimerList2;
+        PRIVILEGED_DATA static List_t * pxCurrentTimerList;
+        PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+    #endif
 
 /* A queue that is used to send commands to the timer service task. */
     PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
     PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
 
+/* The number of commands and pended function calls that could not be sent
+ * because the timer queue was full. */
+    PRIVILEGED_DATA static volatile UBaseType_t uxTimerQueueFullCount = 0U;
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -166,6 +224,50 @@
  */
     static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Counts a command or pended function call that did not fit in the timer queue.
+ */
+    static void prvCountQueueFull( void ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/*
+ * Applies a start, reset, stop or change period command to the timer in the
+ * wheel.  Called in a critical section.  Returns pdTRUE if the timer service
+ * task has to be woken because the timer expires before the wheel did.
+ */
+        static BaseType_t prvApplyTimerCommand( Timer_t * const pxTimer,
+                                                const BaseType_t xCommandID,
+                                                const TickType_t xOptionalValue,
+                                                const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds a timer to the list of the wheel for its expiry time.  Called in a
+ * critical section.  Returns pdTRUE if it expires before the other timers.
+ */
+        static BaseType_t prvInsertTimerInWheel( Timer_t * const pxTimer,
+                                                 const TickType_t xExpiryTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves the expired timers of the lists of the ticks that passed to
+ * xExpiredTimerList, then calls their callbacks and reloads the auto-reload
+ * timers.
+ */
+        static void prvProcessTimerWheel( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the time the timer service task can wait for the next expiry.
+ */
+        static TickType_t prvGetTimerWheelWaitTime( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Wakes the timer service task to look at the wheel and the timer queue again.
+ */
+        static void prvWakeTimerTask( const BaseType_t xFromISR,
+                                      BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+    #else /* configUSE_TIMER_WHEEL */
+
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
  * depending on if the expire time causes a timer counter overflow.
@@ -218,6 +320,8 @@
     static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
                                             BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
 
+    #endif /* configUSE_TIMER_WHEEL */
+
 /*
  * Called after a Timer_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -394,6 +498,48 @@
 
         configASSERT( xTimer );
 
+        #if ( configUSE_TIMER_WHEEL == 1 )
+            if( ( xTimerQueue != NULL ) && ( xCommandID != tmrCOMMAND_DELETE ) )
+            {
+                BaseType_t xWakeTimerTask;
+
+                /* The wheel is updated here in constant time, so the command
+                 * cannot fail and does not wait.  Only a delete is sent to the
+                 * timer service task, which may be executing the callback. */
+                if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        xWakeTimerTask = prvApplyTimerCommand( xTimer, xCommandID, xOptionalValue, xTaskGetTickCount() );
+                    }
+                    taskEXIT_CRITICAL();
+                }
+                else
+                {
+                    UBaseType_t uxSavedInterruptStatus;
+
+                    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+                    {
+                        xWakeTimerTask = prvApplyTimerCommand( xTimer, xCommandID, xOptionalValue, xTaskGetTickCountFromISR() );
+                    }
+                    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+                }
+
+                if( xWakeTimerTask != pdFALSE )
+                {
+                    prvWakeTimerTask( ( BaseType_t ) ( xCommandID >= tmrFIRST_FROM_ISR_COMMAND ), pxHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+                traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
+            }
+            else
+        #endif /* configUSE_TIMER_WHEEL */
+
         /* Send a message to the timer service task to perform a particular action
          * on a particular timer definition. */
         if( xTimerQueue != NULL )
@@ -419,6 +565,17 @@
                 xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
             }
 
+            if( xReturn != pdPASS )
+            {
+                prvCountQueueFull();
+            }
+            else
+            {
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                    prvWakeTimerTask( pdFALSE, NULL );
+                #endif
+            }
+
             traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
         }
         else
@@ -519,6 +676,8 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_WHEEL == 0 )
+
     static void prvReloadTimer( Timer_t * const pxTimer,
                                 TickType_t xExpiredTime,
                                 const TickType_t xTimeNow )
@@ -563,12 +722,16 @@
         traceTIMER_EXPIRED( pxTimer );
         pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
     }
+
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static portTASK_FUNCTION( prvTimerTask, pvParameters )
     {
-        TickType_t xNextExpireTime;
-        BaseType_t xListWasEmpty;
+        #if ( configUSE_TIMER_WHEEL == 0 )
+            TickType_t xNextExpireTime;
+            BaseType_t xListWasEmpty;
+        #endif
 
         /* Just to avoid compiler warnings. */
         ( void ) pvParameters;
@@ -587,20 +750,343 @@
 
         for( ; ; )
         {
-            /* Query the timers list to see if it contains any timers, and if so,
-             * obtain the time at which the next timer will expire. */
-            xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+            #if ( configUSE_TIMER_WHEEL == 1 )
+            {
+                /* Process all the timers that expired since the last time, then
+                 * empty the command queue.  Block until the next expiry, or until
+                 * a timer is started earlier or a message is sent. */
+                prvProcessTimerWheel();
+                prvProcessReceivedCommands();
+                ( void ) ulTaskNotifyTakeIndexed( configTIMER_WHEEL_NOTIFY_INDEX, pdTRUE, prvGetTimerWheelWaitTime() );
+            }
+            #else
+            {
+                /* Query the timers list to see if it contains any timers, and if so,
+                 * obtain the time at which the next timer will expire. */
+                xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
 
-            /* If a timer has expired, process it.  Otherwise, block this task
-             * until either a timer does expire, or a command is received. */
-            prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
+                /* If a timer has expired, process it.  Otherwise, block this task
+                 * until either a timer does expire, or a command is received. */
+                prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
 
-            /* Empty the command queue. */
-            prvProcessReceivedCommands();
+                /* Empty the command queue. */
+                prvProcessReceivedCommands();
+            }
+            #endif /* configUSE_TIMER_WHEEL */
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+    static BaseType_t prvInsertTimerInWheel( Timer_t * const pxTimer,
+                                             const TickType_t xExpiryTime )
+    {
+        TickType_t xListTime = xExpiryTime;
+        UBaseType_t uxIndex;
+        BaseType_t xEarliest = pdFALSE;
+
+        configASSERT( pxTimer->xTimerPeriodInTicks < tmrWHEEL_HALF_RANGE );
+
+        listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xExpiryTime );
+        listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+        /* A timer that expired already, for example when the command was
+         * issued with an old time, goes in the list that is processed next. */
+        if( ( TickType_t ) ( xExpiryTime - xTimerWheelTime ) >= tmrWHEEL_HALF_RANGE )
+        {
+            xListTime = xTimerWheelTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxIndex = tmrWHEEL_INDEX( xListTime );
+
+        /* The list is not sorted, so adding a timer takes constant time. */
+        if( ( listLIST_IS_EMPTY( &( xTimerWheel[ uxIndex ] ) ) != pdFALSE ) ||
+            ( tmrWHEEL_BEFORE( xListTime, xTimerWheelNext[ uxIndex ], xTimerWheelTime ) ) )
+        {
+            xTimerWheelNext[ uxIndex ] = xListTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        listINSERT_END( &( xTimerWheel[ uxIndex ] ), &( pxTimer->xTimerListItem ) );
+
+        if( tmrWHEEL_BEFORE( xListTime, xNextTimerExpiry, xTimerWheelTime ) )
+        {
+            xNextTimerExpiry = xListTime;
+            xEarliest = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xEarliest;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvApplyTimerCommand( Timer_t * const pxTimer,
+                                            const BaseType_t xCommandID,
+                                            const TickType_t xOptionalValue,
+                                            const TickType_t xTimeNow )
+    {
+        BaseType_t xWakeTimerTask = pdFALSE;
+
+        /* The timer is either in a list of the wheel, in the list of expired
+         * timers, or not active.  Removing it takes constant time. */
+        if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+        {
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
+
+        traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xOptionalValue );
+
+        switch( xCommandID )
+        {
+            case tmrCOMMAND_START:
+            case tmrCOMMAND_START_FROM_ISR:
+            case tmrCOMMAND_RESET:
+            case tmrCOMMAND_RESET_FROM_ISR:
+                /* Start or restart a timer, counted from the time the command
+                 * was issued. */
+                pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                xWakeTimerTask = prvInsertTimerInWheel( pxTimer, xOptionalValue + pxTimer->xTimerPeriodInTicks );
+                break;
+
+            case tmrCOMMAND_STOP:
+            case tmrCOMMAND_STOP_FROM_ISR:
+                /* The timer has already been removed from the wheel. */
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                break;
+
+            case tmrCOMMAND_CHANGE_PERIOD:
+            case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                pxTimer->xTimerPeriodInTicks = xOptionalValue;
+                configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+                xWakeTimerTask = prvInsertTimerInWheel( pxTimer, xTimeNow + pxTimer->xTimerPeriodInTicks );
+                break;
+
+            default:
+                /* Don't expect to get here. */
+                break;
+        }
+
+        return xWakeTimerTask;
     }
 /*-----------------------------------------------------------*/
 
+    static void prvProcessTimerWheel( void )
+    {
+        TickType_t xTimeNow;
+        TickType_t xListTime;
+        TickType_t xTicks;
+        UBaseType_t uxIndex;
+
+        /* Timers started from now on go in the lists after the current tick. */
+        taskENTER_CRITICAL();
+        {
+            xTimeNow = xTaskGetTickCount();
+            xListTime = xTimerWheelTime;
+            xTimerWheelTime = xTimeNow + ( TickType_t ) 1;
+        }
+        taskEXIT_CRITICAL();
+
+        /* Visit the list of every tick that passed, each list at most once.
+         * The timers in a list either expired or expire a multiple of
+         * configTIMER_WHEEL_SIZE ticks later.  Each list is a critical section
+         * of its own. */
+        xTicks = ( TickType_t ) ( xTimerWheelTime - xListTime );
+
+        if( xTicks > ( TickType_t ) configTIMER_WHEEL_SIZE )
+        {
+            xTicks = ( TickType_t ) configTIMER_WHEEL_SIZE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        for( ; xTicks > ( TickType_t ) 0; xTicks--, xListTime++ )
+        {
+            uxIndex = tmrWHEEL_INDEX( xListTime );
+
+            taskENTER_CRITICAL();
+            {
+                List_t * const pxList = &( xTimerWheel[ uxIndex ] );
+                ListItem_t const * const pxEnd = listGET_END_MARKER( pxList );
+                ListItem_t * pxItem = listGET_HEAD_ENTRY( pxList );
+                TickType_t xListNext = xTimeNow;
+
+                while( pxItem != pxEnd )
+                {
+                    ListItem_t * const pxNextItem = listGET_NEXT( pxItem );
+                    const TickType_t xItemValue = listGET_LIST_ITEM_VALUE( pxItem );
+
+                    if( tmrWHEEL_IS_DUE( xItemValue, xTimeNow ) )
+                    {
+                        ( void ) uxListRemove( pxItem );
+                        listINSERT_END( &xExpiredTimerList, pxItem );
+                    }
+                    else if( tmrWHEEL_BEFORE( xItemValue, xListNext, xTimerWheelTime ) )
+                    {
+                        xListNext = xItemValue;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxItem = pxNextItem;
+                }
+
+                /* The earliest expiry time of the timers that are left. */
+                xTimerWheelNext[ uxIndex ] = xListNext;
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        /* Call the callbacks one by one, outside of the critical section.  A
+         * command to the timer in the meantime only moves it to another list. */
+        for( ; ; )
+        {
+            Timer_t * pxTimer = NULL;
+            TimerCallbackFunction_t pxCallbackFunction = NULL;
+
+            taskENTER_CRITICAL();
+            {
+                if( listLIST_IS_EMPTY( &xExpiredTimerList ) == pdFALSE )
+                {
+                    TickType_t xExpiryTime;
+
+                    pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xExpiredTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+                    if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+                    {
+                        /* If the reloading is backlogged, the timer expires
+                         * again in this pass, once for every period. */
+                        xExpiryTime += pxTimer->xTimerPeriodInTicks;
+
+                        if( tmrWHEEL_IS_DUE( xExpiryTime, xTimeNow ) )
+                        {
+                            listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xExpiryTime );
+                            listINSERT_END( &xExpiredTimerList, &( pxTimer->xTimerListItem ) );
+                        }
+                        else
+                        {
+                            ( void ) prvInsertTimerInWheel( pxTimer, xExpiryTime );
+                        }
+                    }
+                    else
+                    {
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    }
+
+                    pxCallbackFunction = pxTimer->pxCallbackFunction;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( pxTimer == NULL )
+            {
+                break;
+            }
+
+            /* Call the timer callback. */
+            traceTIMER_EXPIRED( pxTimer );
+            pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+        }
+
+        /* The earliest expiry time in the wheel.  The cost depends on the size
+         * of the wheel only. */
+        taskENTER_CRITICAL();
+        {
+            TickType_t xNext = xTimerWheelTime - ( TickType_t ) 1;
+
+            for( uxIndex = 0; uxIndex < ( UBaseType_t ) configTIMER_WHEEL_SIZE; uxIndex++ )
+            {
+                if( ( listLIST_IS_EMPTY( &( xTimerWheel[ uxIndex ] ) ) == pdFALSE ) &&
+                    ( tmrWHEEL_BEFORE( xTimerWheelNext[ uxIndex ], xNext, xTimerWheelTime ) ) )
+                {
+                    xNext = xTimerWheelNext[ uxIndex ];
+                }
+            }
+
+            xNextTimerExpiry = xNext;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvGetTimerWheelWaitTime( void )
+    {
+        TickType_t xTicksToWait;
+
+        taskENTER_CRITICAL();
+        {
+            const TickType_t xTimeNow = xTaskGetTickCount();
+
+            if( ( TickType_t ) ( xNextTimerExpiry - xTimerWheelTime ) >= tmrWHEEL_HALF_RANGE )
+            {
+                /* No timer is active.  Starting one or sending a message
+                 * wakes this task. */
+                xTicksToWait = portMAX_DELAY;
+            }
+            else if( tmrWHEEL_IS_DUE( xNextTimerExpiry, xTimeNow ) )
+            {
+                xTicksToWait = tmrNO_DELAY;
+            }
+            else
+            {
+                xTicksToWait = ( TickType_t ) ( xNextTimerExpiry - xTimeNow );
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xTicksToWait;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWakeTimerTask( const BaseType_t xFromISR,
+                                  BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        /* Before the scheduler is started the timer service task looks at the
+         * wheel when it starts. */
+        if( xTimerTaskHandle != NULL )
+        {
+            if( xFromISR != pdFALSE )
+            {
+                vTaskNotifyGiveIndexedFromISR( xTimerTaskHandle, configTIMER_WHEEL_NOTIFY_INDEX, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                ( void ) xTaskNotifyGiveIndexed( xTimerTaskHandle, configTIMER_WHEEL_NOTIFY_INDEX );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    #else /* configUSE_TIMER_WHEEL */
+
     static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
                                             BaseType_t xListWasEmpty )
     {
@@ -755,14 +1241,19 @@
 
         return xProcessTimerNow;
     }
+
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static void prvProcessReceivedCommands( void )
     {
         DaemonTaskMessage_t xMessage;
         Timer_t * pxTimer;
-        BaseType_t xTimerListsWereSwitched;
-        TickType_t xTimeNow;
+
+        #if ( configUSE_TIMER_WHEEL == 0 )
+            BaseType_t xTimerListsWereSwitched;
+            TickType_t xTimeNow;
+        #endif
 
         while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
         {
@@ -788,6 +1279,38 @@
             }
             #endif /* INCLUDE_xTimerPendFunctionCall */
 
+            #if ( configUSE_TIMER_WHEEL == 1 )
+
+                /* With the wheel only a delete is sent as a message, the other
+                 * commands were applied by xTimerGenericCommand(). */
+                if( xMessage.xMessageID >= ( BaseType_t ) 0 )
+                {
+                    pxTimer = xMessage.u.xTimerParameters.pxTimer;
+                    configASSERT( xMessage.xMessageID == tmrCOMMAND_DELETE );
+
+                    taskENTER_CRITICAL();
+                    {
+                        ( void ) prvApplyTimerCommand( pxTimer, tmrCOMMAND_STOP, xMessage.u.xTimerParameters.xMessageValue, tmrNO_DELAY );
+                    }
+                    taskEXIT_CRITICAL();
+
+                    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                    {
+                        /* Free up the memory if the memory was dynamically
+                         * allocated. */
+                        if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                        {
+                            vPortFree( pxTimer );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+                }
+            #else /* configUSE_TIMER_WHEEL */
+
             /* Commands that are positive are timer commands rather than pended
              * function calls. */
             if( xMessage.xMessageID >= ( BaseType_t ) 0 )
@@ -901,10 +1424,33 @@
                         break;
                 }
             }
+            #endif /* configUSE_TIMER_WHEEL */
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCountQueueFull( void )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* Also called from interrupts, the count is only incremented when a
+         * send failed. */
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            uxTimerQueueFullCount++;
         }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
     }
 /*-----------------------------------------------------------*/
 
+    UBaseType_t uxTimerGetQueueFullCount( void )
+    {
+        return uxTimerQueueFullCount;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 0 )
+
     static void prvSwitchTimerLists( void )
     {
         TickType_t xNextExpireTime;
@@ -928,6 +1474,8 @@
         pxCurrentTimerList = pxOverflowTimerList;
         pxOverflowTimerList = pxTemp;
     }
+
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static void prvCheckForValidListAndQueue( void )
@@ -939,10 +1487,30 @@
         {
             if( xTimerQueue == NULL )
             {
-                vListInitialise( &xActiveTimerList1 );
-                vListInitialise( &xActiveTimerList2 );
-                pxCurrentTimerList = &xActiveTimerList1;
-                pxOverflowTimerList = &xActiveTimerList2;
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    UBaseType_t uxIndex;
+
+                    for( uxIndex = 0; uxIndex < ( UBaseType_t ) configTIMER_WHEEL_SIZE; uxIndex++ )
+                    {
+                        vListInitialise( &( xTimerWheel[ uxIndex ] ) );
+                    }
+
+                    vListInitialise( &xExpiredTimerList );
+
+                    /* The wheel starts at the current tick, timers can be
+                     * started before the scheduler. */
+                    xTimerWheelTime = xTaskGetTickCount();
+                    xNextTimerExpiry = xTimerWheelTime - ( TickType_t ) 1;
+                }
+                #else
+                {
+                    vListInitialise( &xActiveTimerList1 );
+                    vListInitialise( &xActiveTimerList2 );
+                    pxCurrentTimerList = &xActiveTimerList1;
+                    pxOverflowTimerList = &xActiveTimerList2;
+                }
+                #endif /* configUSE_TIMER_WHEEL */
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
@@ -1057,6 +1625,17 @@
 
             xReturn = xQueueSendFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
 
+            if( xReturn != pdPASS )
+            {
+                prvCountQueueFull();
+            }
+            else
+            {
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                    prvWakeTimerTask( pdTRUE, pxHigherPriorityTaskWoken );
+                #endif
+            }
+
             tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
 
             return xReturn;
@@ -1089,6 +1668,17 @@
 
             xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
 
+            if( xReturn != pdPASS )
+            {
+                prvCountQueueFull();
+            }
+            else
+            {
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                    prvWakeTimerTask( pdFALSE, NULL );
+                #endif
+            }
+
             tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
 
             return xReturn;
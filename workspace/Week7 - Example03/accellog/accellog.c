@@ -0,0 +1,368 @@
+/*! ***************************************************************************
+ *
+ * \brief     Accelerometer burst logging to the flash log
+ * \file      accellog.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#define LOG_MODULE  ALOG
+#define LOG_TAG     "Alog: "
+
+#include <string.h>
+
+#include "accellog.h"
+#include "log.h"
+#include "mono.h"
+#include "serial.h"
+#include "task.h"
+#include "xprintf.h"
+
+/*
+ * A burst reads the FIFO blocks of the MMA8451 for ALOG_BURST_MS and
+ * appends them to the flash log as records of ALOG_RECORD_SAMPLES samples.
+ * A record is ALOG_DELTA8 if all differences between its samples fit in a
+ * byte, which is typical for vibrations well below the data rate, else
+ * ALOG_PACK14. At 800 Hz that is about 2.5 to 4.3 KB/s.
+ *
+ * flog_append() only copies the record into a RAM page and never waits, the
+ * flash log task programs the pages at a lower priority. Acquisition is
+ * therefore never stalled by flash commands, but a record is dropped if a
+ * page is full before the flash log task swaps it. Every drop is counted
+ * and shows as a gap in the record numbers. A FLOG_PAGE_SIZE of 1024 holds
+ * about 250 ms at 800 Hz.
+ */
+
+#if (ALOG_ENABLED == 1) && (FLOG_ENABLED != 1)
+#error "ALOG_ENABLED needs FLOG_ENABLED"
+#endif
+
+#if (((ALOG_RECORD_SAMPLES * 42 + 7) / 8) + 8) > FLOG_RECORD_MAX
+#error "ALOG_RECORD_SAMPLES does not fit in a flash log record"
+#endif
+
+// Stack size in words of the accelerometer log task
+#define ALOG_STACK_DEPTH (configMINIMAL_STACK_SIZE + 32)
+
+// Time without a FIFO block after which a burst is ended
+#define ALOG_TIMEOUT_MS  (100)
+
+// Time a line of the report may wait for room in the serial transmit buffer
+#define ALOG_BLOCK_TIME  pdMS_TO_TICKS(100)
+
+// Longest line written to the serial port, including the terminator
+#define ALOG_LINE_LEN    (64)
+
+static mma8451_sample_t samples[MMA8451_FIFO_SIZE];
+
+// A record being encoded, 2 bytes of slack for the 14-bit fields
+static uint8_t record[FLOG_RECORD_MAX + 2];
+
+// Statistics of the last burst, written by the task with interrupts masked
+static alog_stats_t stats;
+
+static volatile bool requested = false;
+static volatile bool running = false;
+
+static TaskHandle_t alog_task = NULL;
+static StaticTask_t alog_tcb;
+__BSS_NOCLEAR static StackType_t alog_stack[ALOG_STACK_DEPTH];
+
+static void vAlogTask(void *pvParameters);
+
+/*!
+ * \brief Adds a 14-bit field at a bit position of a zeroed buffer
+ */
+static void alog_put14(uint8_t *buf, const uint32_t bit, const int16_t v)
+{
+    const uint32_t w = ((uint32_t)(uint16_t)v & 0x3FFFU) << (bit % 8);
+    uint8_t *p = &buf[bit / 8];
+
+    p[0] |= (uint8_t)w;
+    p[1] |= (uint8_t)(w >> 8);
+    p[2] |= (uint8_t)(w >> 16);
+}
+
+/*!
+ * \brief Returns true if the differences of all samples to the sample
+ *        before fit in an int8_t
+ */
+static bool alog_fits_delta8(const mma8451_sample_t *s, const uint32_t n)
+{
+    for(uint32_t i=1; i<n; i++)
+    {
+        const int32_t dx = s[i].x - s[i-1].x;
+        const int32_t dy = s[i].y - s[i-1].y;
+        const int32_t dz = s[i].z - s[i-1].z;
+
+        if((dx < INT8_MIN) || (dx > INT8_MAX) || (dy < INT8_MIN) ||
+           (dy > INT8_MAX) || (dz < INT8_MIN) || (dz > INT8_MAX))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Encodes up to ALOG_RECORD_SAMPLES samples and appends the record
+ *        to the flash log
+ */
+static void alog_record(const mma8451_sample_t *s, const uint32_t n)
+{
+    alog_header_t h =
+    {
+        .t_us = s[0].t_us,
+        .seq = (uint16_t)(stats.records + stats.dropped),
+        .format = ALOG_PACK14,
+        .count = (uint8_t)n,
+    };
+    uint8_t *data = &record[sizeof(h)];
+    uint32_t len;
+
+    (void)memset(record, 0, sizeof(record));
+
+    if(alog_fits_delta8(s, n))
+    {
+        h.format = ALOG_DELTA8;
+        (void)memcpy(data, &s[0].x, 2);
+        (void)memcpy(&data[2], &s[0].y, 2);
+        (void)memcpy(&data[4], &s[0].z, 2);
+        len = 6;
+
+        for(uint32_t i=1; i<n; i++)
+        {
+            data[len++] = (uint8_t)(int8_t)(s[i].x - s[i-1].x);
+            data[len++] = (uint8_t)(int8_t)(s[i].y - s[i-1].y);
+            data[len++] = (uint8_t)(int8_t)(s[i].z - s[i-1].z);
+        }
+    }
+    else
+    {
+        for(uint32_t i=0; i<n; i++)
+        {
+            alog_put14(data, i * 42, s[i].x);
+            alog_put14(data, i * 42 + 14, s[i].y);
+            alog_put14(data, i * 42 + 28, s[i].z);
+        }
+
+        len = (n * 42 + 7) / 8;
+    }
+
+    (void)memcpy(record, &h, sizeof(h));
+    len += sizeof(h);
+
+    const bool stored = flog_append(ALOG_FLOG_TYPE, record, len);
+
+    taskENTER_CRITICAL();
+    {
+        if(stored)
+        {
+            stats.records++;
+            stats.delta8 += (h.format == ALOG_DELTA8) ? 1 : 0;
+            stats.bytes += len;
+        }
+        else
+        {
+            stats.dropped++;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Records the FIFO blocks of ALOG_BURST_MS
+ */
+static void alog_run(void)
+{
+    const uint32_t overflows = mma8451_fifo_overflows;
+    bool ok = mma8451_init() &&
+              mma8451_fifo_start(ALOG_ODR, ALOG_WATERMARK,
+                                 xTaskGetCurrentTaskHandle());
+    const uint32_t start = mono_ms();
+
+    taskENTER_CRITICAL();
+    {
+        (void)memset(&stats, 0, sizeof(stats));
+    }
+    taskEXIT_CRITICAL();
+
+    // A notification of a previous burst is not a FIFO block
+    (void)ulTaskNotifyTake(pdTRUE, 0);
+
+    while(ok && ((mono_ms() - start) < ALOG_BURST_MS))
+    {
+        uint32_t n;
+
+        ok = (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ALOG_TIMEOUT_MS)) > 0) &&
+             mma8451_fifo_read(samples, MMA8451_FIFO_SIZE, &n);
+
+        for(uint32_t i=0; ok && (i<n); i+=ALOG_RECORD_SAMPLES)
+        {
+            alog_record(&samples[i],
+                ((n - i) < ALOG_RECORD_SAMPLES) ? (n - i) : ALOG_RECORD_SAMPLES);
+        }
+
+        if(ok)
+        {
+            taskENTER_CRITICAL();
+            {
+                stats.samples += n;
+            }
+            taskEXIT_CRITICAL();
+        }
+    }
+
+    (void)mma8451_standby();
+
+    // Program the rest of the burst now
+    flog_flush();
+
+    taskENTER_CRITICAL();
+    {
+        stats.ms = mono_ms() - start;
+        stats.overflows = mma8451_fifo_overflows - overflows;
+        stats.failed = !ok;
+    }
+    taskEXIT_CRITICAL();
+
+    if(!ok)
+    {
+        LOG_WARN("MMA8451 error, burst ended after %lu ms\r\n",
+                 (unsigned long)stats.ms);
+    }
+}
+
+/*!
+ * \brief Creates the accelerometer log task
+ *
+ * The task owns the MMA8451 during a burst and puts it in standby mode
+ * after it.
+ *
+ * \param[in]  priority  Priority of the accelerometer log task, above the
+ *                       flash log task. The task must read a block within
+ *                       (32 - ALOG_WATERMARK) samples at ALOG_ODR.
+ */
+void alog_init(UBaseType_t priority)
+{
+    alog_task = xTaskCreateStatic(vAlogTask, "Alog", ALOG_STACK_DEPTH, NULL,
+                                  priority, alog_stack, &alog_tcb);
+}
+
+/*!
+ * \brief Starts a burst of ALOG_BURST_MS
+ *
+ * Does not block, the report is written to the serial port when the burst
+ * is done.
+ *
+ * \return false if a burst is running
+ */
+bool alog_burst(void)
+{
+    if(running || requested || (alog_task == NULL))
+    {
+        return false;
+    }
+
+    requested = true;
+    xTaskNotifyGive(alog_task);
+
+    return true;
+}
+
+/*!
+ * \brief Returns the statistics of the last or the running burst
+ */
+void alog_get_stats(alog_stats_t *s)
+{
+    taskENTER_CRITICAL();
+    {
+        *s = stats;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Writes the statistics of the last burst to the serial port
+ *
+ * The samples and the records appended, the sustained throughput into the
+ * flash log, the records dropped because a RAM page was full and the FIFO
+ * overflows.
+ */
+void alog_report(void)
+{
+    char line[ALOG_LINE_LEN];
+    alog_stats_t s;
+
+    alog_get_stats(&s);
+
+    const uint32_t rate = (s.ms > 0) ? ((s.bytes * 1000U) / s.ms) : 0;
+
+    xsnprintf(line, ALOG_LINE_LEN, "\r\nAccel log %lu samples in %lu ms%s\r\n",
+              (unsigned long)s.samples, (unsigned long)s.ms,
+              s.failed ? ", failed" : "");
+    xSerialPutStringPolicy(line, eSerialBlock, ALOG_BLOCK_TIME);
+
+    xsnprintf(line, ALOG_LINE_LEN, "Records %lu, delta %lu, %lu bytes, %lu B/s\r\n",
+              (unsigned long)s.records, (unsigned long)s.delta8,
+              (unsigned long)s.bytes, (unsigned long)rate);
+    xSerialPutStringPolicy(line, eSerialBlock, ALOG_BLOCK_TIME);
+
+    xsnprintf(line, ALOG_LINE_LEN, "Dropped %lu, overflows %lu\r\n",
+              (unsigned long)s.dropped, (unsigned long)s.overflows);
+    xSerialPutStringPolicy(line, eSerialBlock, ALOG_BLOCK_TIME);
+}
+
+/*!
+ * \brief Accelerometer log task
+ *
+ * Waits for alog_burst(), records the burst and reports it.
+ */
+static void vAlogTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    LOG_DEBUG("[%*s] started\r\n", 12, __func__);
+
+    for( ;; )
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        if(!requested)
+        {
+            continue;
+        }
+
+        running = true;
+        requested = false;
+
+        alog_run();
+
+        running = false;
+
+        alog_report();
+    }
+}
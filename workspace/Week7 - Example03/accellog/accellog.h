@@ -0,0 +1,135 @@
+/*! ***************************************************************************
+ *
+ * \brief     Accelerometer burst logging to the flash log
+ * \file      accellog.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef ACCELLOG_H
+#define ACCELLOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "flashlog.h"
+#include "mma8451.h"
+
+/// \name Definitions for the accelerometer log
+/// \{
+
+/*!
+ * \brief Set to 1 to create the accelerometer log task in main(), needs
+ *        FLOG_ENABLED and excludes VIB_ENABLED, both use the MMA8451 FIFO
+ */
+#ifndef ALOG_ENABLED
+#define ALOG_ENABLED        (0)
+#endif
+
+/*!
+ * \brief Output data rate of the MMA8451 during a burst
+ */
+#ifndef ALOG_ODR
+#define ALOG_ODR            (MMA8451_ODR_800HZ)
+#endif
+
+/*!
+ * \brief Number of samples of a FIFO block, the watermark
+ *
+ * The flash log masks interrupts for up to 14 ms to erase a sector, the
+ * FIFO must hold the samples of that time above the watermark: at 800 Hz,
+ * (32 - ALOG_WATERMARK) samples last 20 ms.
+ */
+#ifndef ALOG_WATERMARK
+#define ALOG_WATERMARK      (16)
+#endif
+
+/*!
+ * \brief Length of a burst in ms
+ *
+ * The log keeps the records of all but one of its sectors, 7 KB with the
+ * default 8 KB region, about 1.5 s at 800 Hz.
+ */
+#ifndef ALOG_BURST_MS
+#define ALOG_BURST_MS       (1000)
+#endif
+
+/*!
+ * \brief Most samples of a record, a FIFO block is split in records of at
+ *        most this many samples
+ */
+#define ALOG_RECORD_SAMPLES (16)
+
+/*!
+ * \brief Type of the records in the flash log, see flashlog.h
+ */
+#define ALOG_FLOG_TYPE      (0xAC)
+
+/// \}
+
+/// Encoding of the samples of a record
+typedef enum
+{
+    /// x, y and z of every sample as 14-bit two's complement fields, 42 bits
+    /// per sample without padding, least significant bit first
+    ALOG_PACK14 = 0,
+    /// The first sample as three int16_t, the others as int8_t differences
+    /// of x, y and z to the sample before, used if all differences fit
+    ALOG_DELTA8 = 1,
+}alog_format_t;
+
+/// Header of a record, followed by the encoded samples, little-endian
+typedef struct __attribute__((packed))
+{
+    uint32_t t_us;      ///< Time of the first sample since the burst started
+    uint16_t seq;       ///< Number of the record in the burst, a gap is a
+                        ///< dropped record
+    uint8_t format;     ///< alog_format_t
+    uint8_t count;      ///< Number of samples
+}
+alog_header_t;
+
+/// Statistics of the last burst
+typedef struct
+{
+    uint32_t ms;        ///< Duration
+    uint32_t samples;   ///< Samples read from the FIFO
+    uint32_t records;   ///< Records appended to the flash log
+    uint32_t delta8;    ///< Records of those in ALOG_DELTA8
+    uint32_t bytes;     ///< Payload bytes of those records
+    uint32_t dropped;   ///< Records dropped because the RAM page was full
+    uint32_t overflows; ///< FIFO overflows, samples lost in the MMA8451
+    bool failed;        ///< The burst ended early on an MMA8451 error
+}
+alog_stats_t;
+
+// Function prototypes
+void alog_init(UBaseType_t priority);
+bool alog_burst(void);
+void alog_get_stats(alog_stats_t *s);
+void alog_report(void);
+
+#endif // ACCELLOG_H
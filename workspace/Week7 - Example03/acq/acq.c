@@ -0,0 +1,502 @@
+/*! ***************************************************************************
+ *
+ * \brief     Synchronised acquisition of the ADC and the MMA8451
+ * \file      acq.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#define LOG_MODULE  ACQ
+#define LOG_TAG     "Acq: "
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "acq.h"
+#include "queue.h"
+#include "bringup.h"
+#include "log.h"
+#include "mono.h"
+#include "serial.h"
+#include "timer.h"
+#include "xprintf.h"
+
+/*
+ * Every sensor of the board has its own clock: the TCRT5000 conversions
+ * follow TPM1, the MMA8451 its internal ODR oscillator. Instead of
+ * resampling the streams, the acquisition takes the ADC conversions at a
+ * master tick of the timer service and stamps everything with the
+ * monotonic clock, see mono.h, the time base the MMA8451 driver already
+ * stamps its DRDY samples with.
+ *
+ * On every tick the timer interrupt stamps a slot and submits a conversion
+ * of every channel to the ADC service, the completion of the last one marks
+ * the slot converted. The task reads the MMA8451 in DRDY mode at ACQ_ODR,
+ * at least twice the tick rate. A converted slot is completed by the task
+ * as soon as it has a sample at or after the tick: of that sample and the
+ * one before it, the nearest to the tick goes in the frame, together with
+ * its distance to the tick. No values are interpolated, the distance is at
+ * most half a sample period as long as no samples are missed.
+ *
+ * If the conversions of all slots are still pending at a tick, the tick is
+ * skipped and counted, its number is not used, so a consumer sees the gap.
+ * The TSI of the KL25Z has no driver in this project and no stream here.
+ */
+
+#if (ACQ_PERIOD_US < TIM_MIN_PERIOD_US)
+#error "ACQ_PERIOD_US is shorter than the timer service allows"
+#endif
+
+// Stack size in words of the acquisition task
+#define ACQ_STACK_DEPTH  (configMINIMAL_STACK_SIZE + 32)
+
+// Time without a sample after which the MMA8451 is restarted
+#define ACQ_TIMEOUT_MS   (1000)
+
+// Ticks whose conversions can be pending at once
+#define ACQ_SLOTS        (4)
+
+// Time a line of the report may wait for room in the serial transmit buffer
+#define ACQ_BLOCK_TIME   pdMS_TO_TICKS(100)
+
+// Longest line written to the serial port, including the terminator
+#define ACQ_LINE_LEN     (64)
+
+typedef enum
+{
+    ACQ_FREE,       // Available for the next tick
+    ACQ_CONVERTING, // Conversions submitted
+    ACQ_CONVERTED,  // Waiting for an MMA8451 sample after the tick
+}acq_state_t;
+
+// The conversions of one tick
+typedef struct
+{
+    volatile acq_state_t state;
+    uint32_t seq;
+    uint32_t t_us;
+    uint32_t done_us;
+    volatile uint32_t pending;
+    adc_request_t req[ACQ_ADC_CHANNELS];
+}acq_slot_t;
+
+static acq_slot_t slots[ACQ_SLOTS];
+
+// Next slot to fill by the tick and next slot to complete by the task
+static uint32_t fill = 0;
+static uint32_t take = 0;
+
+// Number of the next tick
+static uint32_t seq = 0;
+
+static uint8_t acq_channels[ACQ_ADC_CHANNELS];
+static uint32_t channel_count = 0;
+
+// The last two MMA8451 samples and how many of them are valid
+static mma8451_sample_t prev;
+static mma8451_sample_t curr;
+static uint32_t have = 0;
+
+static void acq_tick(void *arg, BaseType_t *woken);
+static tim_timer_t tick = TIM_TIMER(acq_tick, NULL);
+
+// Latest frame, written by the task with interrupts masked
+static acq_frame_t latest;
+static bool valid = false;
+
+static acq_stats_t stats = {0};
+
+static QueueHandle_t queue = NULL;
+static StaticQueue_t queue_storage;
+static uint8_t queue_buffer[ACQ_QUEUE_LEN * sizeof(acq_frame_t)];
+
+static StaticTask_t acq_tcb;
+static StackType_t acq_stack[ACQ_STACK_DEPTH];
+
+static void vAcqTask(void *pvParameters);
+
+static const bringup_step_t acq_step =
+    BRINGUP_STEP("MMA8451", BRINGUP_MMA8451, 0, 0);
+
+/*!
+ * \brief Completion callback of a conversion, called from the ADC handler
+ */
+static void acq_adc_done(adc_request_t *r, BaseType_t *woken)
+{
+    acq_slot_t *s = (acq_slot_t *)r->arg;
+
+    (void)woken;
+
+    if(--s->pending == 0)
+    {
+        s->done_us = mono_us32();
+        s->state = ACQ_CONVERTED;
+    }
+}
+
+/*!
+ * \brief Master tick, called from the timer interrupt
+ *
+ * Stamps the next slot and submits the conversions of all channels.
+ */
+static void acq_tick(void *arg, BaseType_t *woken)
+{
+    acq_slot_t *s = &slots[fill % ACQ_SLOTS];
+
+    (void)arg;
+    (void)woken;
+
+    if(s->state != ACQ_FREE)
+    {
+        seq++;
+        stats.overruns++;
+        return;
+    }
+
+    s->seq = seq++;
+    s->t_us = mono_us32();
+    s->pending = channel_count;
+    s->state = ACQ_CONVERTING;
+    fill++;
+
+    for(uint32_t i=0; i<channel_count; ++i)
+    {
+        s->req[i].channel = acq_channels[i];
+        s->req[i].avg = ACQ_ADC_AVG;
+        s->req[i].callback = acq_adc_done;
+        s->req[i].arg = s;
+
+        adc_submit_from_isr(&s->req[i]);
+    }
+}
+
+/*!
+ * \brief Puts a frame in the queue, overwriting the oldest if it is full
+ */
+static void acq_put(const acq_frame_t *f)
+{
+    acq_frame_t old;
+
+    if(xQueueSend(queue, f, 0) != pdPASS)
+    {
+        (void)xQueueReceive(queue, &old, 0);
+        (void)xQueueSend(queue, f, 0);
+
+        stats.dropped++;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        latest = *f;
+        valid = true;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Completes the converted slots
+ *
+ * \param[in]  flush  Complete them without waiting for a sample after the
+ *                    tick, when the MMA8451 delivers none
+ */
+static void acq_assemble(const bool flush)
+{
+    for( ;; )
+    {
+        acq_slot_t *s = &slots[take % ACQ_SLOTS];
+        const mma8451_sample_t *a = &curr;
+        acq_frame_t f;
+
+        if(s->state != ACQ_CONVERTED)
+        {
+            return;
+        }
+
+        if(!flush && ((have == 0) || ((int32_t)(curr.t_us - s->t_us) < 0)))
+        {
+            return;
+        }
+
+        if((have > 1) &&
+           (abs((int32_t)(prev.t_us - s->t_us)) <
+            abs((int32_t)(curr.t_us - s->t_us))))
+        {
+            a = &prev;
+        }
+
+        const int32_t distance = (int32_t)(a->t_us - s->t_us);
+        const uint32_t adc_us = s->done_us - s->t_us;
+
+        f.seq = s->seq;
+        f.t_us = s->t_us;
+        f.adc_us = (adc_us > UINT16_MAX) ? UINT16_MAX : (uint16_t)adc_us;
+        f.flags = ACQ_ADC_VALID;
+
+        for(uint32_t i=0; i<ACQ_ADC_CHANNELS; ++i)
+        {
+            f.adc[i] = (i < channel_count) ? s->req[i].result : 0;
+        }
+
+        // Release the slot to the tick
+        s->state = ACQ_FREE;
+        take++;
+
+        if((have > 0) && ((uint32_t)abs(distance) <= dt_us))
+        {
+            f.x = a->x;
+            f.y = a->y;
+            f.z = a->z;
+            f.accel_us = (int16_t)distance;
+            f.flags |= ACQ_ACCEL_VALID;
+
+            if((uint32_t)abs(distance) > stats.max_accel_us)
+            {
+                stats.max_accel_us = (uint32_t)abs(distance);
+            }
+        }
+        else
+        {
+            f.x = f.y = f.z = 0;
+            f.accel_us = 0;
+            stats.stale++;
+        }
+
+        if(adc_us > stats.max_adc_us)
+        {
+            stats.max_adc_us = adc_us;
+        }
+
+        stats.frames++;
+
+        acq_put(&f);
+    }
+}
+
+/*!
+ * \brief Starts the MMA8451 in DRDY mode at ACQ_ODR, waking the calling task
+ */
+static bool acq_start(void)
+{
+    mma8451_config_t cfg;
+
+    have = 0;
+
+    if(!mma8451_init())
+    {
+        return false;
+    }
+
+    mma8451_get_config(&cfg);
+    cfg.odr = ACQ_ODR;
+
+    return mma8451_configure(&cfg) && mma8451_drdy_start();
+}
+
+/*!
+ * \brief Restarts the MMA8451 until it works, completing the frames of the
+ *        ticks in the meantime without samples
+ */
+static void acq_restart(void)
+{
+    while(!acq_start())
+    {
+        acq_assemble(true);
+        vTaskDelay(pdMS_TO_TICKS(ACQ_TIMEOUT_MS));
+    }
+}
+
+/*!
+ * \brief Acquisition task
+ */
+static void vAcqTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    // The ticks run from the start, the frames do not need the MMA8451
+    tim_start(&tick, ACQ_PERIOD_US, ACQ_PERIOD_US);
+
+    // The first attempt ends the bring-up, the device is retried after it
+    (void)bringup_begin(&acq_step, portMAX_DELAY);
+
+    const bool started = acq_start();
+
+    bringup_done(&acq_step, started);
+
+    if(!started)
+    {
+        acq_restart();
+    }
+
+    for( ;; )
+    {
+        mma8451_sample_t s;
+
+        if(!mma8451_drdy_wait(&s, pdMS_TO_TICKS(ACQ_TIMEOUT_MS)))
+        {
+            LOG_WARN("no sample, restarting the MMA8451\r\n");
+
+            stats.restarts++;
+            acq_assemble(true);
+            acq_restart();
+
+            continue;
+        }
+
+        prev = curr;
+        curr = s;
+        have = (have < 2) ? (have + 1) : 2;
+
+        acq_assemble(false);
+    }
+}
+
+/*!
+ * \brief Initializes the synchronised acquisition
+ *
+ * Creates the task that reads the MMA8451 in DRDY mode and assembles the
+ * frames, and starts the master tick of ACQ_PERIOD_US from it. The task
+ * owns the MMA8451 and its data interrupt.
+ *
+ * \param[in]  priority  Priority of the acquisition task, it must read a
+ *                       sample within a sample period at ACQ_ODR
+ * \param[in]  channels  ADC channels converted at every tick, in order
+ * \param[in]  n         Number of channels, at most ACQ_ADC_CHANNELS
+ */
+void acq_init(UBaseType_t priority, const uint8_t channels[], const uint32_t n)
+{
+    channel_count = (n > ACQ_ADC_CHANNELS) ? ACQ_ADC_CHANNELS : n;
+    (void)memcpy(acq_channels, channels, channel_count);
+
+    queue = xQueueCreateStatic(ACQ_QUEUE_LEN, sizeof(acq_frame_t),
+                               queue_buffer, &queue_storage);
+
+    (void)xTaskCreateStatic(vAcqTask, "Acq", ACQ_STACK_DEPTH, NULL, priority,
+                            acq_stack, &acq_tcb);
+}
+
+/*!
+ * \brief Waits for the next frame
+ *
+ * Frames are taken in order, a queue of ACQ_QUEUE_LEN frames loses its
+ * oldest frame if it is not read in time.
+ *
+ * \param[out] frame    The frame
+ * \param[in]  timeout  Ticks to wait for a frame
+ *
+ * \return false on a timeout
+ */
+bool acq_wait(acq_frame_t *frame, const TickType_t timeout)
+{
+    return (queue != NULL) && (xQueueReceive(queue, frame, timeout) == pdPASS);
+}
+
+/*!
+ * \brief Returns the latest frame
+ *
+ * \return false if no frame was assembled yet
+ */
+bool acq_get_latest(acq_frame_t *frame)
+{
+    bool ok;
+
+    taskENTER_CRITICAL();
+    {
+        *frame = latest;
+        ok = valid;
+    }
+    taskEXIT_CRITICAL();
+
+    return ok;
+}
+
+/*!
+ * \brief Returns the statistics of the acquisition
+ */
+void acq_get_stats(acq_stats_t *s)
+{
+    taskENTER_CRITICAL();
+    {
+        *s = stats;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Writes the latest frame and the statistics to the serial port
+ */
+void acq_report(void)
+{
+    char line[ACQ_LINE_LEN];
+    acq_frame_t f;
+    acq_stats_t s;
+
+    acq_get_stats(&s);
+
+    xsnprintf(line, ACQ_LINE_LEN, "\r\nAcquisition, %lu us ticks\r\n",
+              (unsigned long)ACQ_PERIOD_US);
+    xSerialPutStringPolicy(line, eSerialBlock, ACQ_BLOCK_TIME);
+
+    if(acq_get_latest(&f))
+    {
+        xsnprintf(line, ACQ_LINE_LEN, "Frame %lu at %lu us, adc",
+                  (unsigned long)f.seq, (unsigned long)f.t_us);
+        xSerialPutStringPolicy(line, eSerialBlock, ACQ_BLOCK_TIME);
+
+        for(uint32_t i=0; i<channel_count; ++i)
+        {
+            xsnprintf(line, ACQ_LINE_LEN, " %u", (unsigned int)f.adc[i]);
+            xSerialPutStringPolicy(line, eSerialBlock, ACQ_BLOCK_TIME);
+        }
+
+        if(f.flags & ACQ_ACCEL_VALID)
+        {
+            xsnprintf(line, ACQ_LINE_LEN, "\r\n  accel %d %d %d at %d us\r\n",
+                      f.x, f.y, f.z, f.accel_us);
+        }
+        else
+        {
+            xsnprintf(line, ACQ_LINE_LEN, "\r\n  no accel sample\r\n");
+        }
+        xSerialPutStringPolicy(line, eSerialBlock, ACQ_BLOCK_TIME);
+    }
+    else
+    {
+        xSerialPutStringPolicy("No frame yet\r\n", eSerialBlock, ACQ_BLOCK_TIME);
+    }
+
+    xsnprintf(line, ACQ_LINE_LEN, "Frames %lu, overruns %lu, dropped %lu\r\n",
+              (unsigned long)s.frames, (unsigned long)s.overruns,
+              (unsigned long)s.dropped);
+    xSerialPutStringPolicy(line, eSerialBlock, ACQ_BLOCK_TIME);
+
+    xsnprintf(line, ACQ_LINE_LEN, "Stale %lu, restarts %lu, missed %lu\r\n",
+              (unsigned long)s.stale, (unsigned long)s.restarts,
+              (unsigned long)mma8451_drdy_missed);
+    xSerialPutStringPolicy(line, eSerialBlock, ACQ_BLOCK_TIME);
+
+    xsnprintf(line, ACQ_LINE_LEN, "Longest conversion %lu us, sample %lu us\r\n",
+              (unsigned long)s.max_adc_us, (unsigned long)s.max_accel_us);
+    xSerialPutStringPolicy(line, eSerialBlock, ACQ_BLOCK_TIME);
+}
@@ -0,0 +1,132 @@
+/*! ***************************************************************************
+ *
+ * \brief     Synchronised acquisition of the ADC and the MMA8451
+ * \file      acq.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef ACQ_H
+#define ACQ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "adc.h"
+#include "mma8451.h"
+
+/// \name Definitions for the synchronised acquisition
+/// \{
+
+/*!
+ * \brief Set to 1 to create the acquisition task in main()
+ */
+#ifndef ACQ_ENABLED
+#define ACQ_ENABLED       (0)
+#endif
+
+/*!
+ * \brief Period in us of the master tick, the rate of the frames
+ */
+#ifndef ACQ_PERIOD_US
+#define ACQ_PERIOD_US     (10000)
+#endif
+
+/*!
+ * \brief Highest number of ADC channels of a frame
+ */
+#ifndef ACQ_ADC_CHANNELS
+#define ACQ_ADC_CHANNELS  (4)
+#endif
+
+/*!
+ * \brief Hardware averaging of the ADC conversions
+ */
+#ifndef ACQ_ADC_AVG
+#define ACQ_ADC_AVG       (ADC_AVG_4)
+#endif
+
+/*!
+ * \brief Output data rate of the MMA8451 during the acquisition
+ *
+ * At least twice the frame rate, so the sample nearest a tick is at most a
+ * quarter of a frame period away from it.
+ */
+#ifndef ACQ_ODR
+#define ACQ_ODR           (MMA8451_ODR_400HZ)
+#endif
+
+/*!
+ * \brief Number of frames the task keeps for acq_wait()
+ */
+#ifndef ACQ_QUEUE_LEN
+#define ACQ_QUEUE_LEN     (4)
+#endif
+
+/// \}
+
+/// The ADC results of the frame are valid
+#define ACQ_ADC_VALID     (0x01)
+/// The MMA8451 sample of the frame is within a sample period of the tick
+#define ACQ_ACCEL_VALID   (0x02)
+
+/// The results of all sensors for one master tick
+typedef struct
+{
+    uint32_t seq;                       ///< Number of the tick, a gap is a
+                                        ///< lost frame
+    uint32_t t_us;                      ///< Time of the tick, see mono_us32()
+    uint16_t adc[ACQ_ADC_CHANNELS];     ///< Results in the order of the
+                                        ///< channels given to acq_init()
+    uint16_t adc_us;                    ///< Tick to the last conversion
+    int16_t  x, y, z;                   ///< MMA8451 sample nearest the tick
+    int16_t  accel_us;                  ///< Time of that sample minus t_us
+    uint8_t  flags;                     ///< ACQ_ADC_VALID, ACQ_ACCEL_VALID
+}
+acq_frame_t;
+
+/// Statistics of the acquisition
+typedef struct
+{
+    uint32_t frames;        ///< Frames assembled
+    uint32_t overruns;      ///< Ticks skipped, conversions still pending
+    uint32_t dropped;       ///< Oldest frames overwritten in the queue
+    uint32_t stale;         ///< Frames without a valid MMA8451 sample
+    uint32_t restarts;      ///< Restarts of the MMA8451 after a failed read
+    uint32_t max_adc_us;    ///< Longest tick to last conversion
+    uint32_t max_accel_us;  ///< Largest distance of a sample to its tick
+}
+acq_stats_t;
+
+// Function prototypes
+void acq_init(UBaseType_t priority, const uint8_t channels[], const uint32_t n);
+bool acq_wait(acq_frame_t *frame, const TickType_t timeout);
+bool acq_get_latest(acq_frame_t *frame);
+void acq_get_stats(acq_stats_t *stats);
+void acq_report(void);
+
+#endif // ACQ_H
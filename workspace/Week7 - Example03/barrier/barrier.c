@@ -0,0 +1,188 @@
+/*! ***************************************************************************
+ *
+ * \brief     Rendezvous barrier of a fixed number of tasks
+ * \file      barrier.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdbool.h>
+
+#include "barrier.h"
+
+/*
+ * xEventGroupSync() sets the bits of the task and tests the bits of all
+ * tasks with the scheduler suspended, and walks the list of the waiting
+ * tasks of the event group to release them. The released tasks clear the
+ * bits again through the event list.
+ *
+ * A barrier only counts the tasks that arrived and keeps the waiting tasks
+ * in an array. An arrival is a check in a critical section. The last task
+ * notifies every waiting task at BARRIER_NOTIFY_INDEX, one notification
+ * per task, and starts the next round. A waiting task tells a release
+ * apart from a stale notification by the round.
+ */
+
+/*!
+ * \brief Sets up a barrier with no waiting task
+ *
+ * \param[out]  barrier  The barrier
+ * \param[in]   parties  Tasks that meet, 1 to BARRIER_MAX_PARTIES
+ */
+void barrier_init(barrier_t *barrier, const uint32_t parties)
+{
+    configASSERT((parties > 0) && (parties <= BARRIER_MAX_PARTIES));
+
+    taskENTER_CRITICAL();
+    {
+        barrier->parties = parties;
+        barrier->arrived = 0;
+        barrier->round = 0;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Removes a waiting task that timed out, called in a critical
+ *        section
+ */
+static void barrier_leave(barrier_t *barrier, const TaskHandle_t self)
+{
+    for(uint32_t i=0; i<barrier->arrived; i++)
+    {
+        if(barrier->waiters[i] == self)
+        {
+            barrier->arrived--;
+            barrier->waiters[i] = barrier->waiters[barrier->arrived];
+            break;
+        }
+    }
+}
+
+/*!
+ * \brief Waits until all tasks of the barrier arrived
+ *
+ * The last task to arrive does not block, it releases the others and
+ * returns at once. A task that times out leaves the barrier again, so the
+ * round then needs another task. A notification at BARRIER_NOTIFY_INDEX
+ * that is left over from a wait that timed out while it was released is
+ * ignored.
+ *
+ * \param[in,out]  barrier  The barrier
+ * \param[in]      timeout  Ticks to wait
+ *
+ * \return BARRIER_LAST for the last task, BARRIER_RELEASED for the others,
+ *         or BARRIER_TIMEOUT
+ */
+barrier_result_t barrier_wait(barrier_t *barrier, TickType_t timeout)
+{
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    TaskHandle_t release[BARRIER_MAX_PARTIES - 1];
+    barrier_result_t result = BARRIER_RELEASED;
+    uint32_t count = 0;
+    uint32_t round;
+    TimeOut_t start;
+
+    configASSERT(barrier->parties > 0);
+
+    taskENTER_CRITICAL();
+    {
+        round = barrier->round;
+
+        if((barrier->arrived + 1) == barrier->parties)
+        {
+            // The waiting tasks are notified after the critical section
+            count = barrier->arrived;
+
+            for(uint32_t i=0; i<count; i++)
+            {
+                release[i] = barrier->waiters[i];
+            }
+
+            barrier->arrived = 0;
+            barrier->round = round + 1;
+            result = BARRIER_LAST;
+        }
+        else if(timeout > 0)
+        {
+            barrier->waiters[barrier->arrived] = self;
+            barrier->arrived++;
+        }
+        else
+        {
+            result = BARRIER_TIMEOUT;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if(result == BARRIER_LAST)
+    {
+        for(uint32_t i=0; i<count; i++)
+        {
+            (void)xTaskNotifyGiveIndexed(release[i], BARRIER_NOTIFY_INDEX);
+        }
+
+        return result;
+    }
+
+    vTaskSetTimeOutState(&start);
+
+    bool waiting = (result == BARRIER_RELEASED);
+
+    while(waiting)
+    {
+        (void)ulTaskNotifyTakeIndexed(BARRIER_NOTIFY_INDEX, pdTRUE, timeout);
+
+        taskENTER_CRITICAL();
+        {
+            if(barrier->round != round)
+            {
+                // Released
+                waiting = false;
+            }
+            else if(xTaskCheckForTimeOut(&start, &timeout) != pdFALSE)
+            {
+                barrier_leave(barrier, self);
+                result = BARRIER_TIMEOUT;
+                waiting = false;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return result;
+}
+
+/*!
+ * \brief Reads the number of completed rounds, from a task or an interrupt
+ *
+ * \param[in]  barrier  The barrier
+ *
+ * \return Rounds since barrier_init()
+ */
+uint32_t barrier_round(const barrier_t *barrier)
+{
+    return barrier->round;
+}
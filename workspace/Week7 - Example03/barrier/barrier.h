@@ -0,0 +1,97 @@
+/*! ***************************************************************************
+ *
+ * \brief     Rendezvous barrier of a fixed number of tasks
+ * \file      barrier.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef BARRIER_H
+#define BARRIER_H
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// \name Definitions for the barrier
+/// \{
+
+/*!
+ * \brief Index of the task notification that releases the waiting tasks
+ *
+ * Not shared with the event flags or the serial DMA transmit path, a
+ * notification of those would release a waiting task too early.
+ */
+#ifndef BARRIER_NOTIFY_INDEX
+#define BARRIER_NOTIFY_INDEX (10)
+#endif
+
+/*!
+ * \brief Most tasks that meet at a barrier
+ */
+#ifndef BARRIER_MAX_PARTIES
+#define BARRIER_MAX_PARTIES  (8)
+#endif
+
+/*!
+ * \brief Defines a barrier of n tasks
+ *
+ * Example: static barrier_t xSampleBarrier = BARRIER_INIT(3);
+ */
+#define BARRIER_INIT(n)      {.parties = (n)}
+
+/// \}
+
+/*!
+ * \brief Result of barrier_wait()
+ */
+typedef enum
+{
+    BARRIER_TIMEOUT = 0,    ///< Not all tasks arrived in time
+    BARRIER_RELEASED,       ///< Released by the last task
+    BARRIER_LAST,           ///< The last task, which released the others
+}
+barrier_result_t;
+
+/// A barrier, the tasks that wait at it are released when the last of
+/// parties tasks arrives. It is used again for the next round at once.
+///
+/// Define with BARRIER_INIT() or set up with barrier_init().
+typedef struct
+{
+    uint32_t parties;           ///< Tasks that meet
+    uint32_t arrived;           ///< Tasks waiting in this round
+    volatile uint32_t round;    ///< Completed rounds
+    TaskHandle_t waiters[BARRIER_MAX_PARTIES - 1];
+}
+barrier_t;
+
+// Function prototypes
+void barrier_init(barrier_t *barrier, const uint32_t parties);
+barrier_result_t barrier_wait(barrier_t *barrier, TickType_t timeout);
+uint32_t barrier_round(const barrier_t *barrier);
+
+#endif // BARRIER_H
@@ -0,0 +1,456 @@
+/*! ***************************************************************************
+ *
+ * \brief     Shared harness of the on-target benchmarks
+ * \file      bench.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdarg.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+#include "serial.h"
+#include "xprintf.h"
+
+/*----------------------------------------------------------------------------*/
+// Local defines
+/*----------------------------------------------------------------------------*/
+
+// Build profile and heap scheme, set by CMakeLists.txt
+#ifndef BENCH_PROFILE
+#define BENCH_PROFILE       "Unknown"
+#endif
+
+#ifndef BENCH_HEAP
+#define BENCH_HEAP          "heap_4"
+#endif
+
+/// A JSON line under construction, cut at BENCH_JSON_LEN
+typedef struct
+{
+    char buf[BENCH_JSON_LEN];
+    size_t pos;
+}json_t;
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+
+// Samples of bench_measure(), a single benchmark task measures at a time
+static uint32_t samples[BENCH_MAX_RUNS];
+
+/*----------------------------------------------------------------------------*/
+// Local function prototypes
+/*----------------------------------------------------------------------------*/
+static void json_add(json_t *j, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+static void json_str(json_t *j, const char *key, const char *value);
+static void json_send(json_t *j);
+
+/*----------------------------------------------------------------------------*/
+// Timing
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Measures the cycles of two reads of bench_cycles() back to back,
+ *        a single operation timed with them takes this much longer
+ *
+ * \return Least cycles of 16 tries with interrupts masked
+ */
+uint32_t bench_cycles_overhead(void)
+{
+    uint32_t overhead = UINT32_MAX;
+
+    for(uint32_t i=0; i<16; i++)
+    {
+        const uint32_t state = bench_quiet_enter(BENCH_QUIET_IRQ);
+        const uint32_t start = bench_cycles();
+        const uint32_t cycles = bench_cycles() - start;
+        bench_quiet_exit(BENCH_QUIET_IRQ, state);
+
+        if(cycles < overhead)
+        {
+            overhead = cycles;
+        }
+    }
+
+    return overhead;
+}
+
+/*!
+ * \brief Starts a quiet measurement window
+ *
+ * Masking interrupts also holds off the tick, so a quiet window must be
+ * short compared to a tick period. The scheduler can only be suspended
+ * after it started.
+ *
+ * \param[in]  quiet  What the window is shielded from
+ *
+ * \return State for bench_quiet_exit()
+ */
+uint32_t bench_quiet_enter(const bench_quiet_t quiet)
+{
+    uint32_t state = 0;
+
+    if(quiet == BENCH_QUIET_IRQ)
+    {
+        state = __get_PRIMASK();
+        __disable_irq();
+    }
+    else if((quiet == BENCH_QUIET_SCHED) &&
+            (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED))
+    {
+        vTaskSuspendAll();
+        state = 1;
+    }
+
+    return state;
+}
+
+/*!
+ * \brief Ends a quiet measurement window
+ *
+ * \param[in]  quiet  What the window was shielded from
+ * \param[in]  state  Returned by bench_quiet_enter()
+ */
+void bench_quiet_exit(const bench_quiet_t quiet, const uint32_t state)
+{
+    if(quiet == BENCH_QUIET_IRQ)
+    {
+        if(state == 0)
+        {
+            __enable_irq();
+        }
+    }
+    else if((quiet == BENCH_QUIET_SCHED) && (state != 0))
+    {
+        (void)xTaskResumeAll();
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+// Statistics
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Clears the statistics, all values are 0 without samples
+ */
+void bench_stats_reset(bench_stats_t *s)
+{
+    (void)memset(s, 0, sizeof(*s));
+}
+
+/*!
+ * \brief Adds a sample, without the percentiles
+ */
+void bench_stats_add(bench_stats_t *s, const uint32_t value)
+{
+    if((s->count == 0) || (value < s->min))
+    {
+        s->min = value;
+    }
+
+    if(value > s->max)
+    {
+        s->max = value;
+    }
+
+    s->sum += value;
+    s->count++;
+}
+
+/*!
+ * \brief Sets the statistics of all samples, with the percentiles
+ *
+ * The percentiles are the nearest rank. Insertion sort, as the samples
+ * are few and often nearly sorted already.
+ *
+ * \param[out]    s        The statistics, reset first
+ * \param[in,out] values   The samples, sorted on return
+ * \param[in]     n        Number of samples
+ */
+void bench_stats_sort(bench_stats_t *s, uint32_t *values, const uint32_t n)
+{
+    bench_stats_reset(s);
+
+    for(uint32_t i=1; i<n; i++)
+    {
+        const uint32_t v = values[i];
+        uint32_t j = i;
+
+        while((j > 0) && (values[j - 1] > v))
+        {
+            values[j] = values[j - 1];
+            j--;
+        }
+
+        values[j] = v;
+    }
+
+    for(uint32_t i=0; i<n; i++)
+    {
+        bench_stats_add(s, values[i]);
+    }
+
+    if(n > 0)
+    {
+        s->p50 = values[((n * 50) + 99) / 100 - 1];
+        s->p90 = values[((n * 90) + 99) / 100 - 1];
+        s->p99 = values[((n * 99) + 99) / 100 - 1];
+        s->sorted = true;
+    }
+}
+
+/*!
+ * \brief Subtracts an overhead from every sample, down to 0
+ */
+void bench_stats_sub(bench_stats_t *s, const uint32_t offset)
+{
+    uint32_t *values[] = {&s->min, &s->max, &s->p50, &s->p90, &s->p99};
+
+    for(uint32_t i=0; i<(sizeof(values) / sizeof(values[0])); i++)
+    {
+        *values[i] = (*values[i] > offset) ? *values[i] - offset : 0;
+    }
+
+    const uint64_t total = (uint64_t)offset * s->count;
+
+    s->sum = (s->sum > total) ? s->sum - total : 0;
+}
+
+/*!
+ * \brief Average of the samples, 0 if there are none
+ */
+uint32_t bench_stats_avg(const bench_stats_t *s)
+{
+    return (s->count > 0) ? (uint32_t)(s->sum / s->count) : 0;
+}
+
+/*----------------------------------------------------------------------------*/
+// Measurement
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Measures an operation
+ *
+ * Every run is a sample of the cycles per operation, rounded down. The
+ * cost of the call of op() is included, measure an empty operation to
+ * subtract it with bench_stats_sub().
+ *
+ * \param[in]   spec  The operation
+ * \param[out]  s     Statistics of the timed runs, with the percentiles
+ */
+void bench_measure(const bench_spec_t *spec, bench_stats_t *s)
+{
+    const uint32_t ops = (spec->ops > 0) ? spec->ops : 1;
+    const uint32_t runs = (spec->runs < BENCH_MAX_RUNS) ? spec->runs : BENCH_MAX_RUNS;
+
+    for(uint32_t run=0; run<(spec->warmup + runs); run++)
+    {
+        if(spec->prepare != NULL)
+        {
+            spec->prepare();
+        }
+
+        const uint32_t state = bench_quiet_enter(spec->quiet);
+        const uint32_t start = bench_cycles();
+
+        for(uint32_t i=0; i<ops; i++)
+        {
+            spec->op();
+        }
+
+        const uint32_t cycles = bench_cycles() - start;
+        bench_quiet_exit(spec->quiet, state);
+
+        if(run >= spec->warmup)
+        {
+            samples[run - spec->warmup] = cycles / ops;
+        }
+    }
+
+    bench_stats_sort(s, samples, runs);
+}
+
+/*----------------------------------------------------------------------------*/
+// JSON lines
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Appends formatted text to a JSON line
+ */
+static void json_add(json_t *j, const char *fmt, ...)
+{
+    va_list ap;
+
+    if(j->pos >= (sizeof(j->buf) - 1))
+    {
+        return;
+    }
+
+    va_start(ap, fmt);
+    const int n = xvsnprintf(&j->buf[j->pos], sizeof(j->buf) - j->pos, fmt, ap);
+    va_end(ap);
+
+    if(n > 0)
+    {
+        j->pos += (size_t)n;
+
+        if(j->pos > (sizeof(j->buf) - 1))
+        {
+            j->pos = sizeof(j->buf) - 1;
+        }
+    }
+}
+
+/*!
+ * \brief Appends a string member, quotes and backslashes are escaped and
+ *        control characters left out
+ */
+static void json_str(json_t *j, const char *key, const char *value)
+{
+    json_add(j, "%s\"%s\":\"", (j->pos > 1) ? "," : "", key);
+
+    for(const char *c=value; *c != '\0'; c++)
+    {
+        if((*c == '"') || (*c == '\\'))
+        {
+            json_add(j, "\\%c", *c);
+        }
+        else if((uint8_t)*c >= ' ')
+        {
+            json_add(j, "%c", *c);
+        }
+    }
+
+    json_add(j, "\"");
+}
+
+/*!
+ * \brief Closes a JSON line and writes it to the serial port
+ */
+static void json_send(json_t *j)
+{
+    // Room for the closing brace and the line ending is kept
+    if(j->pos > (sizeof(j->buf) - 4))
+    {
+        j->pos = sizeof(j->buf) - 4;
+    }
+
+    (void)strcpy(&j->buf[j->pos], "}\r\n");
+
+    xSerialPutStringPolicy(j->buf, eSerialBlock, portMAX_DELAY);
+}
+
+/*!
+ * \brief Writes the description of the build and the board as a JSON line
+ *
+ * Written once before the results of a suite, so results of different
+ * builds and boards can be told apart and compared.
+ *
+ * \param[in]  suite   Name of the benchmark
+ * \param[in]  config  Configuration the results depend on, such as the
+ *                     backend of a driver, NULL for none
+ */
+void bench_json_meta(const char *suite, const char *config)
+{
+    json_t j = {.buf = "{", .pos = 1};
+
+    json_str(&j, "type", "meta");
+    json_str(&j, "suite", suite);
+    json_str(&j, "board", "FRDM-KL25Z");
+    json_add(&j, ",\"core_hz\":%lu", (unsigned long)SystemCoreClock);
+    json_str(&j, "kernel", tskKERNEL_VERSION_NUMBER);
+    json_str(&j, "profile", BENCH_PROFILE);
+    json_str(&j, "heap", BENCH_HEAP);
+    json_str(&j, "compiler", __VERSION__);
+
+    if(config != NULL)
+    {
+        json_str(&j, "config", config);
+    }
+
+    json_send(&j);
+}
+
+/*!
+ * \brief Writes the statistics of a measurement as a JSON line
+ *
+ * The percentiles are only written if they are valid.
+ *
+ * \param[in]  suite  Name of the benchmark
+ * \param[in]  name   Name of the measurement
+ * \param[in]  unit   Unit of the samples, such as "cycles" or "us"
+ * \param[in]  s      The statistics
+ */
+void bench_json_stats(const char *suite, const char *name, const char *unit,
+    const bench_stats_t *s)
+{
+    json_t j = {.buf = "{", .pos = 1};
+
+    json_str(&j, "type", "result");
+    json_str(&j, "suite", suite);
+    json_str(&j, "case", name);
+    json_str(&j, "unit", unit);
+    json_add(&j, ",\"n\":%lu,\"min\":%lu,\"avg\":%lu,\"max\":%lu",
+        (unsigned long)s->count, (unsigned long)s->min,
+        (unsigned long)bench_stats_avg(s), (unsigned long)s->max);
+
+    if(s->sorted)
+    {
+        json_add(&j, ",\"p50\":%lu,\"p90\":%lu,\"p99\":%lu",
+            (unsigned long)s->p50, (unsigned long)s->p90, (unsigned long)s->p99);
+    }
+
+    json_send(&j);
+}
+
+/*!
+ * \brief Writes a single value of a measurement as a JSON line
+ *
+ * \param[in]  suite   Name of the benchmark
+ * \param[in]  name    Name of the measurement
+ * \param[in]  metric  What the value is, such as "throughput"
+ * \param[in]  unit    Unit of the value, such as "B/s"
+ * \param[in]  value   The value
+ */
+void bench_json_value(const char *suite, const char *name, const char *metric,
+    const char *unit, const uint32_t value)
+{
+    json_t j = {.buf = "{", .pos = 1};
+
+    json_str(&j, "type", "result");
+    json_str(&j, "suite", suite);
+    json_str(&j, "case", name);
+    json_str(&j, "metric", metric);
+    json_str(&j, "unit", unit);
+    json_add(&j, ",\"value\":%lu", (unsigned long)value);
+
+    json_send(&j);
+}
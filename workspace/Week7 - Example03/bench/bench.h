@@ -0,0 +1,147 @@
+/*! ***************************************************************************
+ *
+ * \brief     Shared harness of the on-target benchmarks
+ * \file      bench.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <MKL25Z4.h>
+
+#include "runtime_stats.h"
+
+#if !rtsFREE_RUNNING
+#error "The benchmarks read the free-running PIT0, set rtsFREE_RUNNING"
+#endif
+
+/// \name Definitions for the benchmarks
+/// \{
+
+/*!
+ * \brief Runs bench_measure() keeps the samples of, for the percentiles
+ */
+#ifndef BENCH_MAX_RUNS
+#define BENCH_MAX_RUNS      (128)
+#endif
+
+/*!
+ * \brief Core clock cycles per count of PIT0, which counts the bus clock
+ */
+#define BENCH_PIT_CYCLES    (2)
+
+/*!
+ * \brief Length of a JSON line, a longer line is cut and is not valid JSON
+ */
+#define BENCH_JSON_LEN      (192)
+
+/// \}
+
+/*!
+ * \brief What a measured run is shielded from
+ *
+ * A run that blocks or that needs an interrupt must not be quiet.
+ */
+typedef enum
+{
+    BENCH_QUIET_NONE = 0,  ///< Tick and all interrupts run
+    BENCH_QUIET_SCHED,     ///< Scheduler suspended, interrupts run
+    BENCH_QUIET_IRQ,       ///< Interrupts masked
+}
+bench_quiet_t;
+
+/*!
+ * \brief A measured operation
+ *
+ * prepare() is called before every run and is not timed, op() is timed ops
+ * times in a run. The first warmup runs are not timed either, they fill the
+ * caches of the flash controller and let the kernel settle.
+ */
+typedef struct
+{
+    void (*prepare)(void);
+    void (*op)(void);
+    uint16_t ops;           ///< Operations per run, at least 1
+    uint16_t runs;          ///< Timed runs, up to BENCH_MAX_RUNS
+    uint16_t warmup;        ///< Runs before the timed runs
+    bench_quiet_t quiet;
+}
+bench_spec_t;
+
+/*!
+ * \brief Statistics of a measurement
+ *
+ * Filled sample by sample with bench_stats_add(), or from all samples at
+ * once with bench_stats_sort(), which also gives the percentiles.
+ */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t p50;
+    uint32_t p90;
+    uint32_t p99;
+    bool sorted;            ///< The percentiles are valid
+}
+bench_stats_t;
+
+/*!
+ * \brief Reads the free-running PIT0 in core clock cycles, counting up
+ *
+ * The difference of two reads is exact to BENCH_PIT_CYCLES for up to
+ * 2^31 cycles.
+ */
+static inline uint32_t bench_cycles(void)
+{
+    return (0xFFFFFFFFUL - PIT->CHANNEL[0].CVAL) * BENCH_PIT_CYCLES;
+}
+
+// Function prototypes
+uint32_t bench_cycles_overhead(void);
+uint32_t bench_quiet_enter(const bench_quiet_t quiet);
+void bench_quiet_exit(const bench_quiet_t quiet, const uint32_t state);
+
+void bench_stats_reset(bench_stats_t *s);
+void bench_stats_add(bench_stats_t *s, const uint32_t value);
+void bench_stats_sort(bench_stats_t *s, uint32_t *values, const uint32_t n);
+void bench_stats_sub(bench_stats_t *s, const uint32_t offset);
+uint32_t bench_stats_avg(const bench_stats_t *s);
+
+void bench_measure(const bench_spec_t *spec, bench_stats_t *s);
+
+void bench_json_meta(const char *suite, const char *config);
+void bench_json_stats(const char *suite, const char *name, const char *unit,
+    const bench_stats_t *s);
+void bench_json_value(const char *suite, const char *name, const char *metric,
+    const char *unit, const uint32_t value);
+
+#endif // BENCH_H
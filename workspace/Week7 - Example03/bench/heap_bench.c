@@ -0,0 +1,456 @@
+/*! ***************************************************************************
+ *
+ * \brief     On-target replay of a heap trace on the FreeRTOS heap and block pools
+ * \file      heap_bench.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+
+#include <MKL25Z4.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+#include "heap_trace.h"
+#include "kernel_memory.h"
+#include "pool.h"
+#include "serial.h"
+#include "xprintf.h"
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 0)
+#error "The benchmark replays the trace on the FreeRTOS heap, build without STATIC_ONLY"
+#endif
+
+/*----------------------------------------------------------------------------*/
+// Local defines
+/*----------------------------------------------------------------------------*/
+
+// Replays of the trace per allocator. Every replay starts with all blocks
+// free, so the first one costs the same as the others.
+#define BENCH_PASSES        (4)
+
+// Priority of the benchmark task
+#define BENCH_PRIORITY      (2)
+
+#define BENCH_LINE_LEN      (64)
+
+// Heap scheme, set by CMakeLists.txt
+#ifndef BENCH_HEAP
+#define BENCH_HEAP          "heap_4"
+#endif
+
+// Stack size in words of the benchmark task
+#define BENCH_STACK_DEPTH   (configMINIMAL_STACK_SIZE + 128)
+
+/*!
+ * \brief An allocator the trace is replayed on
+ *
+ * Both functions get the requested size, as a caller of a size class
+ * allocator knows the class of the block it frees.
+ */
+typedef struct
+{
+    const char *name;
+    void *(*alloc)(const uint32_t size);
+    void (*free)(void *block, const uint32_t size);
+    uint32_t (*used)(void); ///< Bytes taken from the allocator
+    uint32_t (*frag)(void); ///< Share of the free space not in the largest block in %
+}bench_allocator_t;
+
+/// Result of the replays on an allocator
+typedef struct
+{
+    bench_stats_t alloc;     ///< Core clock cycles of an allocation
+    bench_stats_t free;      ///< Core clock cycles of a free
+    uint32_t peak_used;      ///< Most bytes taken from the allocator
+    uint32_t peak_requested; ///< Most bytes requested at once
+    uint32_t frag;           ///< Worst fragmentation in %
+    uint32_t failed;         ///< Failed allocations of a replay
+}bench_result_t;
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+
+// Blocks of the trace and their requested sizes, NULL if not allocated
+static void *slots[HEAP_TRACE_SLOTS];
+static uint16_t slot_size[HEAP_TRACE_SLOTS];
+
+// Block pools of the size classes, as many blocks as the trace needs at most
+static pool_t pools[HEAP_TRACE_CLASSES];
+static uint32_t pool_storage[HEAP_TRACE_POOL_BYTES / 4];
+
+// Free heap before the first replay, the kernel objects are all static
+static uint32_t heap_free_start;
+
+// Cycles of the two timer reads around an operation
+static uint32_t bench_overhead;
+
+static StaticTask_t bench_tcb;
+__BSS_NOCLEAR static StackType_t bench_stack[BENCH_STACK_DEPTH];
+
+/*----------------------------------------------------------------------------*/
+// Local function prototypes
+/*----------------------------------------------------------------------------*/
+static void vBenchTask(void *pvParameters);
+
+/*----------------------------------------------------------------------------*/
+// Main application
+/*----------------------------------------------------------------------------*/
+int main(void)
+{
+    char line[BENCH_LINE_LEN];
+    uint8_t *storage = (uint8_t *)pool_storage;
+
+    xSerialPortInit(921600, 128);
+
+    vSerialPutString("\r\nFRDM-KL25Z heap benchmark\r\n");
+
+    xsnprintf(line, sizeof(line), "%s heap of %u B\r\n", BENCH_HEAP,
+        (unsigned)heap_size());
+    vSerialPutString(line);
+
+    xsnprintf(line, sizeof(line), "Trace %.32s, %u ops\r\n",
+        heap_trace_source, (unsigned)HEAP_TRACE_OPS);
+    vSerialPutString(line);
+
+    for(uint32_t i=0; i<HEAP_TRACE_CLASSES; i++)
+    {
+        pool_init(&pools[i], "Bench", storage, heap_trace_class_size[i],
+            heap_trace_class_peak[i]);
+        storage += POOL_BLOCK_SIZE(heap_trace_class_size[i]) * heap_trace_class_peak[i];
+    }
+
+    xsnprintf(line, sizeof(line), "Pools of %u to %u B in %u B\r\n",
+        (unsigned)heap_trace_class_size[0],
+        (unsigned)heap_trace_class_size[HEAP_TRACE_CLASSES - 1],
+        (unsigned)sizeof(pool_storage));
+    vSerialPutString(line);
+
+    (void)xTaskCreateStatic(vBenchTask, "Bench", BENCH_STACK_DEPTH, NULL,
+        BENCH_PRIORITY, bench_stack, &bench_tcb);
+
+    /* Start the scheduler so the tasks start executing. */
+    vTaskStartScheduler();
+
+    for( ;; );
+}
+
+/*----------------------------------------------------------------------------*/
+// Allocators
+/*----------------------------------------------------------------------------*/
+
+static void *heap_alloc(const uint32_t size)
+{
+    return pvPortMalloc(size);
+}
+
+static void heap_free(void *block, const uint32_t size)
+{
+    (void)size;
+
+    vPortFree(block);
+}
+
+static uint32_t heap_used(void)
+{
+    return heap_free_start - xPortGetFreeHeapSize();
+}
+
+static uint32_t heap_frag(void)
+{
+    HeapStats_t stats;
+
+    vPortGetHeapStats(&stats);
+
+    if(stats.xAvailableHeapSpaceInBytes == 0)
+    {
+        return 0;
+    }
+
+    return 100 - (stats.xSizeOfLargestFreeBlockInBytes * 100) /
+        stats.xAvailableHeapSpaceInBytes;
+}
+
+/*!
+ * \brief Finds the pool of the smallest class that holds size bytes
+ */
+static pool_t *pool_class(const uint32_t size)
+{
+    for(uint32_t i=0; i<HEAP_TRACE_CLASSES; i++)
+    {
+        if(size <= heap_trace_class_size[i])
+        {
+            return &pools[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void *pools_alloc(const uint32_t size)
+{
+    pool_t *pool = pool_class(size);
+
+    return (pool != NULL) ? pool_alloc(pool) : NULL;
+}
+
+static void pools_free(void *block, const uint32_t size)
+{
+    pool_free(pool_class(size), block);
+}
+
+static uint32_t pools_used(void)
+{
+    uint32_t used = 0;
+
+    for(uint32_t i=0; i<HEAP_TRACE_CLASSES; i++)
+    {
+        used += pools[i].used * pools[i].block_size;
+    }
+
+    return used;
+}
+
+// A block of a pool fits any request of its class, the waste is internal
+static uint32_t pools_frag(void)
+{
+    return 0;
+}
+
+static const bench_allocator_t allocators[] =
+{
+    {BENCH_HEAP, heap_alloc, heap_free, heap_used, heap_frag},
+    {"pools", pools_alloc, pools_free, pools_used, pools_frag},
+};
+
+#define BENCH_COUNT (sizeof(allocators) / sizeof(allocators[0]))
+
+/*----------------------------------------------------------------------------*/
+// Replay
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Adds a time measured with bench_cycles(), less the timer reads
+ */
+static void bench_time_add(bench_stats_t *t, const uint32_t cycles)
+{
+    bench_stats_add(t, (cycles > bench_overhead) ? cycles - bench_overhead : 0);
+}
+
+/*!
+ * \brief Replays the trace once on an allocator
+ *
+ * Every operation is timed with interrupts masked, so the tick interrupt
+ * does not add to the worst case. The use and fragmentation are sampled
+ * after every operation, without timing. The blocks left allocated at the
+ * end of the trace are freed.
+ */
+static void bench_replay(const bench_allocator_t *a, bench_result_t *r)
+{
+    uint32_t requested = 0;
+    uint32_t failed = 0;
+    uint32_t state;
+    uint32_t start;
+    uint32_t cycles;
+
+    for(uint32_t i=0; i<HEAP_TRACE_OPS; i++)
+    {
+        const heap_trace_op_t *op = &heap_trace[i];
+
+        if(op->size > 0)
+        {
+            void *block;
+
+            state = bench_quiet_enter(BENCH_QUIET_IRQ);
+            start = bench_cycles();
+            block = a->alloc(op->size);
+            cycles = bench_cycles() - start;
+            bench_quiet_exit(BENCH_QUIET_IRQ, state);
+
+            slots[op->slot] = block;
+            slot_size[op->slot] = op->size;
+
+            if(block == NULL)
+            {
+                failed++;
+                continue;
+            }
+
+            bench_time_add(&r->alloc, cycles);
+            requested += op->size;
+        }
+        else
+        {
+            void *block = slots[op->slot];
+
+            if(block == NULL)
+            {
+                continue;
+            }
+
+            state = bench_quiet_enter(BENCH_QUIET_IRQ);
+            start = bench_cycles();
+            a->free(block, slot_size[op->slot]);
+            cycles = bench_cycles() - start;
+            bench_quiet_exit(BENCH_QUIET_IRQ, state);
+
+            slots[op->slot] = NULL;
+
+            bench_time_add(&r->free, cycles);
+            requested -= slot_size[op->slot];
+        }
+
+        const uint32_t used = a->used();
+        const uint32_t frag = a->frag();
+
+        if(used > r->peak_used)
+        {
+            r->peak_used = used;
+        }
+
+        if(requested > r->peak_requested)
+        {
+            r->peak_requested = requested;
+        }
+
+        if(frag > r->frag)
+        {
+            r->frag = frag;
+        }
+    }
+
+    for(uint32_t i=0; i<HEAP_TRACE_SLOTS; i++)
+    {
+        if(slots[i] != NULL)
+        {
+            a->free(slots[i], slot_size[i]);
+            slots[i] = NULL;
+        }
+    }
+
+    if(failed > r->failed)
+    {
+        r->failed = failed;
+    }
+}
+
+/*!
+ * \brief Replays the trace on all allocators and writes the tables to the
+ *        serial port
+ *
+ * Nothing is written while the trace is replayed, so the serial interrupts
+ * do not disturb it. Any received character starts the next round.
+ */
+static void vBenchTask(void *pvParameters)
+{
+    bench_result_t results[BENCH_COUNT];
+    char line[BENCH_LINE_LEN];
+    char c;
+
+    (void)pvParameters;
+
+    heap_free_start = xPortGetFreeHeapSize();
+
+    for( ;; )
+    {
+        // Let the banner drain
+        vTaskDelay(pdMS_TO_TICKS(100));
+
+        bench_overhead = bench_cycles_overhead();
+
+        memset(results, 0, sizeof(results));
+
+        for(uint32_t i=0; i<BENCH_COUNT; i++)
+        {
+            for(uint32_t pass=0; pass<BENCH_PASSES; pass++)
+            {
+                bench_replay(&allocators[i], &results[i]);
+            }
+        }
+
+        xsnprintf(line, BENCH_LINE_LEN, "\r\n%-9s %6s %6s %6s %6s %6s %6s\r\n",
+            "Allocator", "Alloc", "Avg", "Max", "Free", "Avg", "Max");
+        xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+
+        for(uint32_t i=0; i<BENCH_COUNT; i++)
+        {
+            const bench_result_t *r = &results[i];
+
+            xsnprintf(line, BENCH_LINE_LEN, "%-9s %6lu %6lu %6lu %6lu %6lu %6lu\r\n",
+                allocators[i].name,
+                (unsigned long)r->alloc.min, (unsigned long)bench_stats_avg(&r->alloc),
+                (unsigned long)r->alloc.max, (unsigned long)r->free.min,
+                (unsigned long)bench_stats_avg(&r->free), (unsigned long)r->free.max);
+            xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+        }
+
+        // Overhead is what the allocator takes on top of the requests
+        xsnprintf(line, BENCH_LINE_LEN, "\r\n%-9s %6s %6s %6s %6s %6s\r\n",
+            "Allocator", "Peak", "Asked", "Over%", "Frag%", "Failed");
+        xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+
+        for(uint32_t i=0; i<BENCH_COUNT; i++)
+        {
+            const bench_result_t *r = &results[i];
+            const uint32_t over = (r->peak_requested > 0) ?
+                ((r->peak_used - r->peak_requested) * 100) / r->peak_requested : 0;
+
+            xsnprintf(line, BENCH_LINE_LEN, "%-9s %6lu %6lu %6lu %6lu %6lu\r\n",
+                allocators[i].name, (unsigned long)r->peak_used,
+                (unsigned long)r->peak_requested, (unsigned long)over,
+                (unsigned long)r->frag, (unsigned long)r->failed);
+            xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+        }
+
+        // The same results as JSON lines, after the tables
+        xsnprintf(line, BENCH_LINE_LEN, "trace %.32s, %u ops", heap_trace_source,
+            (unsigned)HEAP_TRACE_OPS);
+        bench_json_meta("heap", line);
+
+        for(uint32_t i=0; i<BENCH_COUNT; i++)
+        {
+            const bench_result_t *r = &results[i];
+            const char *name = allocators[i].name;
+
+            xsnprintf(line, BENCH_LINE_LEN, "%s alloc", name);
+            bench_json_stats("heap", line, "cycles", &r->alloc);
+            xsnprintf(line, BENCH_LINE_LEN, "%s free", name);
+            bench_json_stats("heap", line, "cycles", &r->free);
+            bench_json_value("heap", name, "peak", "B", r->peak_used);
+            bench_json_value("heap", name, "fragmentation", "%", r->frag);
+            bench_json_value("heap", name, "failed", "allocations", r->failed);
+        }
+
+        xSerialPutStringPolicy("Cycles per operation, bytes, any key to repeat\r\n",
+            eSerialBlock, portMAX_DELAY);
+
+        (void)xSerialGetChar(&c, portMAX_DELAY);
+    }
+}
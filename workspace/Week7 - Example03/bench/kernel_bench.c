@@ -0,0 +1,838 @@
+/*! ***************************************************************************
+ *
+ * \brief     On-target micro-benchmark of the FreeRTOS primitives
+ * \file      kernel_bench.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+
+#include <MKL25Z4.h>
+
+#include "FreeRTOS.h"
+#include "event_groups.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "task.h"
+
+#include "barrier.h"
+#include "bench.h"
+#include "flags.h"
+#include "irq_prio.h"
+#include "kernel_memory.h"
+#include "mem.h"
+#include "mono.h"
+#include "platform.h"
+#include "runtime_stats.h"
+#include "serial.h"
+#include "xprintf.h"
+
+/*----------------------------------------------------------------------------*/
+// Local defines
+/*----------------------------------------------------------------------------*/
+
+// Operations timed back to back in a single run
+#define BENCH_OPS           (16)
+
+// Runs per primitive. The minimum is the cost without interference of the
+// tick interrupt, the average includes it.
+#define BENCH_RUNS          (64)
+
+// Runs per primitive before the timed runs
+#define BENCH_WARMUP        (2)
+
+// Priority of the benchmark task, a peer task runs at the same or the next
+// priority
+#define BENCH_PRIORITY      (2)
+
+// Item size of the large queue and the stream buffer
+#define BENCH_ITEM_SIZE     (16)
+
+// Unused interrupt pended by the interrupt round trip benchmark
+#define BENCH_IRQn          (CMP0_IRQn)
+
+// Unused interrupt pended by the benchmarks that set events from an
+// interrupt
+#define BENCH_EVENT_IRQn    (DAC0_IRQn)
+
+// Words of the constant table read by the flash loop benchmark
+#define BENCH_TABLE_WORDS   (64)
+
+// Bytes copied and filled by the memory benchmarks, an Oled framebuffer
+#define BENCH_MEM_SIZE      (1024)
+
+#define BENCH_LINE_LEN      (64)
+
+// Build profile, set by CMakeLists.txt
+#ifndef BENCH_PROFILE
+#define BENCH_PROFILE       "Unknown"
+#endif
+
+// Heap scheme, set by CMakeLists.txt
+#ifndef BENCH_HEAP
+#define BENCH_HEAP          "heap_4"
+#endif
+
+// Size of the allocations of the heap benchmarks, and the blocks allocated
+// to fragment the heap first. Every other block is freed again.
+#define BENCH_ALLOC_SIZE    (32)
+#define BENCH_FRAG_BLOCKS   (16)
+
+// Stack sizes in words of the benchmark and peer tasks
+#define BENCH_STACK_DEPTH   (configMINIMAL_STACK_SIZE + 128)
+#define PEER_STACK_DEPTH    (configMINIMAL_STACK_SIZE)
+
+/*!
+ * \brief A benchmarked primitive
+ *
+ * prepare() is called before every run and is not timed, op() is timed
+ * BENCH_OPS times. A peer task is created before the first run and deleted
+ * after the last one. A quiet primitive runs with interrupts masked, it
+ * must not block or need an interrupt.
+ */
+typedef struct
+{
+    const char *name;
+    void (*prepare)(void);
+    void (*op)(void);
+    TaskFunction_t peer;
+    UBaseType_t peer_priority;
+    bool quiet;
+}bench_t;
+
+/// A flash controller setting compared by the platform benchmarks
+typedef struct
+{
+    const char *name;
+    uint32_t placr;
+}bench_placr_t;
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+static QueueHandle_t queue_small;
+static QueueHandle_t queue_word;
+static QueueHandle_t queue_large;
+static QueueHandle_t queue_wake;
+static SemaphoreHandle_t semaphore;
+static SemaphoreHandle_t mutex;
+static EventGroupHandle_t events;
+static StreamBufferHandle_t stream;
+static TaskHandle_t bench_task;
+static TaskHandle_t peer_task;
+static flags_t flags = FLAGS_INIT;
+static barrier_t barrier = BARRIER_INIT(2);
+
+// Set by the prepare functions, selects what the event interrupt sets
+static volatile bool isr_sets_flags;
+
+static uint8_t item[BENCH_ITEM_SIZE];
+static uint32_t word;
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+static void *frag[BENCH_FRAG_BLOCKS];
+#endif
+
+// Read from flash by the flash loop benchmark. The last word is not zero, so
+// the table is not placed in .bss.
+static const uint32_t table[BENCH_TABLE_WORDS] = {[BENCH_TABLE_WORDS - 1] = 1};
+static volatile uint32_t table_sum;
+
+// Word aligned buffers of the memory benchmarks
+static uint32_t mem_dst[BENCH_MEM_SIZE / 4];
+static uint32_t mem_src[BENCH_MEM_SIZE / 4];
+
+// Memory of the kernel objects, all are created statically. Every peer task
+// reuses the same memory, the previous peer is deleted first.
+static StaticQueue_t queue_small_buffer;
+static uint8_t queue_small_storage[BENCH_OPS];
+static StaticQueue_t queue_word_buffer;
+static uint32_t queue_word_storage[BENCH_OPS];
+static StaticQueue_t queue_large_buffer;
+static uint8_t queue_large_storage[BENCH_OPS * BENCH_ITEM_SIZE];
+static StaticQueue_t queue_wake_buffer;
+static uint8_t queue_wake_storage[1];
+static StaticSemaphore_t semaphore_buffer;
+static StaticSemaphore_t mutex_buffer;
+static StaticEventGroup_t events_buffer;
+static StaticStreamBuffer_t stream_buffer;
+static uint8_t stream_storage[BENCH_ITEM_SIZE * 2 + 1];
+
+static StaticTask_t bench_tcb;
+__BSS_NOCLEAR static StackType_t bench_stack[BENCH_STACK_DEPTH];
+static StaticTask_t peer_tcb;
+__BSS_NOCLEAR static StackType_t peer_stack[PEER_STACK_DEPTH];
+
+/*----------------------------------------------------------------------------*/
+// Local function prototypes
+/*----------------------------------------------------------------------------*/
+static void vBenchTask(void *pvParameters);
+
+/*----------------------------------------------------------------------------*/
+// Main application
+/*----------------------------------------------------------------------------*/
+int main(void)
+{
+    char line[BENCH_LINE_LEN];
+
+    xSerialPortInit(921600, 128);
+
+    vSerialPutString("\r\nFRDM-KL25Z FreeRTOS kernel benchmark\r\n");
+
+    // The switch rows depend on these, compare builds with -D overrides
+    xsnprintf(line, sizeof(line), "%u priorities, %s task selection\r\n",
+        (unsigned)configMAX_PRIORITIES,
+        configUSE_PORT_OPTIMISED_TASK_SELECTION ? "bit map" : "generic");
+    vSerialPutString(line);
+
+    xsnprintf(line, sizeof(line), "Kernel code in %s, kernel data in %s\r\n",
+        RAMFUNC_ENABLED ? "SRAM_L" : "flash",
+        SRAM_PLACEMENT_ENABLED ? "SRAM_L" : "SRAM");
+    vSerialPutString(line);
+
+    xsnprintf(line, sizeof(line), "%s PendSV handler\r\n",
+        configUSE_PORT_FAST_PENDSV ? "Fast" : "Standard");
+    vSerialPutString(line);
+
+    xsnprintf(line, sizeof(line), "Queue items up to 4 B copied with %s\r\n",
+        configQUEUE_SMALL_ITEM_COPY ? "loads and stores" : "memcpy");
+    vSerialPutString(line);
+
+    xsnprintf(line, sizeof(line), "%s build profile\r\n", BENCH_PROFILE);
+    vSerialPutString(line);
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    xsnprintf(line, sizeof(line), "%s heap of %u B\r\n", BENCH_HEAP,
+        (unsigned)heap_size());
+    vSerialPutString(line);
+#endif
+
+    xsnprintf(line, sizeof(line), "Flash controller MCM_PLACR 0x%05lX\r\n",
+        (unsigned long)platform_get_placr());
+    vSerialPutString(line);
+
+    // The handler is empty, an interrupt round trip is entry plus exit
+    NVIC_SetPriority(BENCH_IRQn, IRQ_PRIO(BENCH));
+    NVIC_ClearPendingIRQ(BENCH_IRQn);
+    NVIC_EnableIRQ(BENCH_IRQn);
+
+    NVIC_SetPriority(BENCH_EVENT_IRQn, IRQ_PRIO(BENCH_EVENT));
+    NVIC_ClearPendingIRQ(BENCH_EVENT_IRQn);
+    NVIC_EnableIRQ(BENCH_EVENT_IRQn);
+
+    queue_small = xQueueCreateStatic(BENCH_OPS, 1, queue_small_storage,
+        &queue_small_buffer);
+    queue_word = xQueueCreateStatic(BENCH_OPS, sizeof(uint32_t),
+        (uint8_t *)queue_word_storage, &queue_word_buffer);
+    queue_large = xQueueCreateStatic(BENCH_OPS, BENCH_ITEM_SIZE,
+        queue_large_storage, &queue_large_buffer);
+    queue_wake = xQueueCreateStatic(1, 1, queue_wake_storage, &queue_wake_buffer);
+    semaphore = xSemaphoreCreateBinaryStatic(&semaphore_buffer);
+    mutex = xSemaphoreCreateMutexStatic(&mutex_buffer);
+    events = xEventGroupCreateStatic(&events_buffer);
+    stream = xStreamBufferCreateStatic(BENCH_ITEM_SIZE * 2, 1, stream_storage,
+        &stream_buffer);
+
+    bench_task = xTaskCreateStatic(vBenchTask, "Bench", BENCH_STACK_DEPTH, NULL,
+        BENCH_PRIORITY, bench_stack, &bench_tcb);
+
+    /* Start the scheduler so the tasks start executing. */
+    vTaskStartScheduler();
+
+    for( ;; );
+}
+
+/*----------------------------------------------------------------------------*/
+// Timed operations and their peer tasks
+/*----------------------------------------------------------------------------*/
+
+static void op_none(void)
+{
+}
+
+static void op_yield(void)
+{
+    taskYIELD();
+}
+
+static void peer_yield(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for( ;; )
+    {
+        taskYIELD();
+    }
+}
+
+static void prepare_empty(void)
+{
+    (void)xQueueReset(queue_small);
+    (void)xQueueReset(queue_word);
+    (void)xQueueReset(queue_large);
+}
+
+static void prepare_full(void)
+{
+    while(xQueueSend(queue_small, item, 0) == pdPASS);
+    while(xQueueSend(queue_word, &word, 0) == pdPASS);
+    while(xQueueSend(queue_large, item, 0) == pdPASS);
+}
+
+static void op_queue_send_small(void)
+{
+    (void)xQueueSend(queue_small, item, 0);
+}
+
+static void op_queue_receive_small(void)
+{
+    (void)xQueueReceive(queue_small, item, 0);
+}
+
+static void op_queue_send_word(void)
+{
+    (void)xQueueSend(queue_word, &word, 0);
+}
+
+static void op_queue_receive_word(void)
+{
+    (void)xQueueReceive(queue_word, &word, 0);
+}
+
+static void op_queue_send_large(void)
+{
+    (void)xQueueSend(queue_large, item, 0);
+}
+
+static void op_queue_receive_large(void)
+{
+    (void)xQueueReceive(queue_large, item, 0);
+}
+
+static void op_queue_wake(void)
+{
+    (void)xQueueSend(queue_wake, item, portMAX_DELAY);
+}
+
+static void peer_queue_wake(void *pvParameters)
+{
+    uint8_t c;
+
+    (void)pvParameters;
+
+    for( ;; )
+    {
+        (void)xQueueReceive(queue_wake, &c, portMAX_DELAY);
+    }
+}
+
+static void op_semaphore(void)
+{
+    (void)xSemaphoreGive(semaphore);
+    (void)xSemaphoreTake(semaphore, 0);
+}
+
+static void op_mutex(void)
+{
+    (void)xSemaphoreTake(mutex, 0);
+    (void)xSemaphoreGive(mutex);
+}
+
+static void op_notify(void)
+{
+    (void)xTaskNotifyGive(bench_task);
+    (void)ulTaskNotifyTake(pdTRUE, 0);
+}
+
+static void op_notify_wake(void)
+{
+    (void)xTaskNotifyGive(peer_task);
+}
+
+static void peer_notify_wake(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for( ;; )
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+static void op_event_bits(void)
+{
+    (void)xEventGroupSetBits(events, 0x01);
+    (void)xEventGroupClearBits(events, 0x01);
+}
+
+static void op_event_sync(void)
+{
+    (void)xEventGroupSync(events, 0x01, 0x03, portMAX_DELAY);
+}
+
+static void peer_event_sync(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for( ;; )
+    {
+        (void)xEventGroupSync(events, 0x02, 0x03, portMAX_DELAY);
+    }
+}
+
+static void op_barrier(void)
+{
+    (void)barrier_wait(&barrier, portMAX_DELAY);
+}
+
+static void peer_barrier(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for( ;; )
+    {
+        (void)barrier_wait(&barrier, portMAX_DELAY);
+    }
+}
+
+static void prepare_event_isr(void)
+{
+    isr_sets_flags = false;
+}
+
+static void prepare_flags_isr(void)
+{
+    isr_sets_flags = true;
+}
+
+static void op_event_isr(void)
+{
+    // The peer notifies back once it was released
+    NVIC_SetPendingIRQ(BENCH_EVENT_IRQn);
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+void DAC0_IRQHandler(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    if(isr_sets_flags)
+    {
+        (void)flags_set_from_isr(&flags, 0x01, &woken);
+    }
+    else
+    {
+        // Pended to the timer daemon
+        (void)xEventGroupSetBitsFromISR(events, 0x01, &woken);
+    }
+
+    portYIELD_FROM_ISR(woken);
+}
+
+static void peer_event_isr(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for( ;; )
+    {
+        (void)xEventGroupWaitBits(events, 0x01, pdTRUE, pdFALSE, portMAX_DELAY);
+        (void)xTaskNotifyGive(bench_task);
+    }
+}
+
+static void peer_flags_isr(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for( ;; )
+    {
+        (void)flags_wait(&flags, 0x01, FLAGS_ANY | FLAGS_CLEAR, portMAX_DELAY);
+        (void)xTaskNotifyGive(bench_task);
+    }
+}
+
+static void op_stream(void)
+{
+    (void)xStreamBufferSend(stream, item, BENCH_ITEM_SIZE, 0);
+    (void)xStreamBufferReceive(stream, item, BENCH_ITEM_SIZE, 0);
+}
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+static void prepare_heap(void)
+{
+    for(uint32_t i=0; i<BENCH_FRAG_BLOCKS; i++)
+    {
+        vPortFree(frag[i]);
+        frag[i] = NULL;
+    }
+}
+
+static void prepare_heap_fragmented(void)
+{
+    prepare_heap();
+
+    for(uint32_t i=0; i<BENCH_FRAG_BLOCKS; i++)
+    {
+        frag[i] = pvPortMalloc(BENCH_ITEM_SIZE);
+    }
+
+    // Leaves holes that are too small for BENCH_ALLOC_SIZE
+    for(uint32_t i=0; i<BENCH_FRAG_BLOCKS; i+=2)
+    {
+        vPortFree(frag[i]);
+        frag[i] = NULL;
+    }
+}
+
+static void op_malloc(void)
+{
+    vPortFree(pvPortMalloc(BENCH_ALLOC_SIZE));
+}
+#endif
+
+static void op_interrupt(void)
+{
+    // Taken right after the write, before the next instruction completes
+    NVIC_SetPendingIRQ(BENCH_IRQn);
+    __DSB();
+    __ISB();
+}
+
+void CMP0_IRQHandler(void)
+{
+}
+
+static void op_flash_loop(void)
+{
+    uint32_t sum = 0;
+
+    for(uint32_t i=0; i<BENCH_TABLE_WORDS; i++)
+    {
+        sum += table[i];
+    }
+
+    table_sum = sum;
+}
+
+static void op_memcpy(void)
+{
+    (void)memcpy(mem_dst, mem_src, BENCH_MEM_SIZE);
+}
+
+static void op_mem_copy(void)
+{
+    (void)mem_copy(mem_dst, mem_src, BENCH_MEM_SIZE);
+}
+
+static void op_memset(void)
+{
+    (void)memset(mem_dst, 0, BENCH_MEM_SIZE);
+}
+
+static void op_mem_set(void)
+{
+    (void)mem_set(mem_dst, 0, BENCH_MEM_SIZE);
+}
+
+static void op_mono_us(void)
+{
+    (void)mono_us();
+}
+
+/*!
+ * \brief The benchmarked primitives, the first one is the overhead of the
+ *        call of an operation, which is subtracted from all others
+ *
+ * A yield without a peer selects the benchmark task again, which is the
+ * PendSV path that does not change the task.
+ *
+ * A wake is an operation that unblocks the peer task at a higher priority,
+ * it includes the switch to the peer, the peer blocking again and the switch
+ * back. The event sync and the barrier are the same rendezvous of two
+ * tasks, the benchmark task arrives last.
+ *
+ * The ISR rows set an event in an interrupt and wait until the peer that
+ * was released notifies back. An event group is set by the timer daemon,
+ * event flags release the peer in the interrupt itself.
+ */
+static const bench_t benchmarks[] =
+{
+    {"overhead",              NULL,          op_none,                NULL,             0},
+    {"yield, no switch",      NULL,          op_yield,               NULL,             0},
+    {"yield, 2 switches",     NULL,          op_yield,               peer_yield,       BENCH_PRIORITY},
+    {"queue send 1 B",        prepare_empty, op_queue_send_small,    NULL,             0},
+    {"queue receive 1 B",     prepare_full,  op_queue_receive_small, NULL,             0},
+    {"queue send 4 B",        prepare_empty, op_queue_send_word,     NULL,             0},
+    {"queue receive 4 B",     prepare_full,  op_queue_receive_word,  NULL,             0},
+    {"queue send 16 B",       prepare_empty, op_queue_send_large,    NULL,             0},
+    {"queue receive 16 B",    prepare_full,  op_queue_receive_large, NULL,             0},
+    {"queue send, wake",      NULL,          op_queue_wake,          peer_queue_wake,  BENCH_PRIORITY + 1},
+    {"semaphore give+take",   NULL,          op_semaphore,           NULL,             0},
+    {"mutex take+give",       NULL,          op_mutex,               NULL,             0},
+    {"notify give+take",      NULL,          op_notify,              NULL,             0},
+    {"notify give, wake",     NULL,          op_notify_wake,         peer_notify_wake, BENCH_PRIORITY + 1},
+    {"event set+clear",       NULL,          op_event_bits,          NULL,             0},
+    {"event sync, wake",      NULL,          op_event_sync,          peer_event_sync,  BENCH_PRIORITY + 1},
+    {"barrier, wake",         NULL,          op_barrier,             peer_barrier,     BENCH_PRIORITY + 1},
+    {"event ISR, wake+back",  prepare_event_isr, op_event_isr,       peer_event_isr,   BENCH_PRIORITY + 1},
+    {"flags ISR, wake+back",  prepare_flags_isr, op_event_isr,       peer_flags_isr,   BENCH_PRIORITY + 1},
+    {"stream 16 B send+recv", NULL,          op_stream,              NULL,             0},
+    {"memcpy 1 KiB",          NULL,          op_memcpy,              NULL,             0},
+    {"mem_copy 1 KiB",        NULL,          op_mem_copy,            NULL,             0},
+    {"memset 1 KiB",          NULL,          op_memset,              NULL,             0},
+    {"mem_set 1 KiB",         NULL,          op_mem_set,             NULL,             0},
+    {"mono_us",               NULL,          op_mono_us,             NULL,             0},
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    {"malloc+free 32 B",      prepare_heap,  op_malloc,              NULL,             0},
+    {"malloc+free, 8 holes",  prepare_heap_fragmented, op_malloc,    NULL,             0},
+#endif
+};
+
+#define BENCH_COUNT (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+/*!
+ * \brief The benchmarks run for every flash controller setting, the first
+ *        one is the overhead again
+ *
+ * The interrupt round trip is the latency of an interrupt of which the
+ * handler runs from flash. The flash loop reads a constant table from flash
+ * and is the throughput of a loop of code and data in flash, it runs with
+ * interrupts masked.
+ */
+static const bench_t platform_benchmarks[] =
+{
+    {"overhead",              NULL,          op_none,                NULL,             0},
+    {"interrupt round trip",  NULL,          op_interrupt,           NULL,             0},
+    {"flash loop 64 words",   NULL,          op_flash_loop,          NULL,             0, true},
+};
+
+#define PLATFORM_COUNT (sizeof(platform_benchmarks) / sizeof(platform_benchmarks[0]))
+
+/*!
+ * \brief The compared flash controller settings, see platform.h
+ */
+static const bench_placr_t placr_settings[] =
+{
+    {"no cache",           MCM_PLACR_DFCC_MASK},
+    {"no speculation",     MCM_PLACR_DFCS_MASK},
+    {"instructions only",  MCM_PLACR_DFCDA_MASK},
+    {"data cached",        0},
+    {"data speculated",    MCM_PLACR_EFDS_MASK},
+};
+
+#define PLACR_COUNT (sizeof(placr_settings) / sizeof(placr_settings[0]))
+
+// Results of the platform benchmarks for every setting
+static bench_stats_t platform_results[PLACR_COUNT][PLATFORM_COUNT];
+
+/*----------------------------------------------------------------------------*/
+// Benchmark task
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Times a primitive
+ *
+ * \param[in]   b  The primitive
+ * \param[out]  r  Core clock cycles per operation of the runs
+ */
+static void bench_run(const bench_t *b, bench_stats_t *r)
+{
+    const bench_spec_t spec =
+    {
+        .prepare = b->prepare,
+        .op = b->op,
+        .ops = BENCH_OPS,
+        .runs = BENCH_RUNS,
+        .warmup = BENCH_WARMUP,
+        .quiet = b->quiet ? BENCH_QUIET_IRQ : BENCH_QUIET_NONE,
+    };
+
+    peer_task = NULL;
+
+    if(b->peer != NULL)
+    {
+        // A peer at a higher priority runs at once and blocks
+        peer_task = xTaskCreateStatic(b->peer, "Peer", PEER_STACK_DEPTH, NULL,
+            b->peer_priority, peer_stack, &peer_tcb);
+    }
+
+    bench_measure(&spec, r);
+
+    if(peer_task != NULL)
+    {
+        // A task deleted by another task is removed at once, so the next
+        // peer can reuse its memory
+        vTaskDelete(peer_task);
+    }
+}
+
+/*!
+ * \brief Writes the result of a primitive as a JSON line, less the overhead
+ *        of the call of an operation
+ */
+static void bench_json(const char *name, const bench_stats_t *r,
+    const uint32_t overhead)
+{
+    bench_stats_t s = *r;
+
+    bench_stats_sub(&s, overhead);
+    bench_json_stats("kernel", name, "cycles", &s);
+}
+
+/*!
+ * \brief Times the platform benchmarks for every flash controller setting
+ *        and writes the table to the serial port
+ *
+ * The setting of the build profile is restored afterwards.
+ */
+static void bench_platform(void)
+{
+    char line[BENCH_LINE_LEN];
+    const uint32_t profile = platform_get_placr();
+
+    // Let the kernel table drain
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    for(uint32_t p=0; p<PLACR_COUNT; p++)
+    {
+        platform_set_placr(placr_settings[p].placr);
+
+        for(uint32_t i=0; i<PLATFORM_COUNT; i++)
+        {
+            bench_run(&platform_benchmarks[i], &platform_results[p][i]);
+        }
+    }
+
+    platform_set_placr(profile);
+
+    xsnprintf(line, BENCH_LINE_LEN, "\r\n%-18s %7s %6s %6s\r\n",
+        "MCM_PLACR", "", "ISR", "Loop");
+    xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+
+    for(uint32_t p=0; p<PLACR_COUNT; p++)
+    {
+        // Minimum cycles without the overhead of the call
+        const uint32_t overhead = platform_results[p][0].min;
+        const uint32_t isr = platform_results[p][1].min;
+        const uint32_t loop = platform_results[p][2].min;
+
+        xsnprintf(line, BENCH_LINE_LEN, "%-18s 0x%05lX %6lu %6lu\r\n",
+            placr_settings[p].name, (unsigned long)placr_settings[p].placr,
+            (unsigned long)((isr > overhead) ? isr - overhead : 0),
+            (unsigned long)((loop > overhead) ? loop - overhead : 0));
+        xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+    }
+}
+
+/*!
+ * \brief Writes the results of the platform benchmarks as JSON lines
+ */
+static void bench_platform_json(void)
+{
+    char name[BENCH_LINE_LEN];
+
+    for(uint32_t p=0; p<PLACR_COUNT; p++)
+    {
+        for(uint32_t i=1; i<PLATFORM_COUNT; i++)
+        {
+            xsnprintf(name, BENCH_LINE_LEN, "%s, %s", platform_benchmarks[i].name,
+                placr_settings[p].name);
+            bench_json(name, &platform_results[p][i], platform_results[p][0].min);
+        }
+    }
+}
+
+/*!
+ * \brief Runs all benchmarks and writes the table to the serial port
+ *
+ * Nothing is written while the benchmarks run, so the serial interrupts do
+ * not disturb them. Any received character starts the next round.
+ */
+static void vBenchTask(void *pvParameters)
+{
+    static bench_stats_t results[BENCH_COUNT];
+    char line[BENCH_LINE_LEN];
+    char c;
+
+    (void)pvParameters;
+
+    for( ;; )
+    {
+        // Let the banner drain
+        vTaskDelay(pdMS_TO_TICKS(100));
+
+        // The flags and barrier peers of the last round were deleted while
+        // they waited
+        flags_init(&flags);
+        barrier_init(&barrier, 2);
+
+        for(uint32_t i=0; i<BENCH_COUNT; i++)
+        {
+            bench_run(&benchmarks[i], &results[i]);
+        }
+
+        xsnprintf(line, BENCH_LINE_LEN, "\r\n%-22s %6s %6s %6s\r\n",
+            "Primitive", "Min", "Avg", "ns");
+        xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+
+        for(uint32_t i=0; i<BENCH_COUNT; i++)
+        {
+            // Cycles without the overhead of the call
+            const uint32_t overhead = (i > 0) ? results[0].min : 0;
+            const uint32_t min = (results[i].min > overhead) ? results[i].min - overhead : 0;
+            const uint32_t mean = bench_stats_avg(&results[i]);
+            const uint32_t avg = (mean > overhead) ? mean - overhead : 0;
+
+            xsnprintf(line, BENCH_LINE_LEN, "%-22s %6lu %6lu %6lu\r\n",
+                benchmarks[i].name, (unsigned long)min, (unsigned long)avg,
+                (unsigned long)(((uint64_t)min * 1000000000ULL) / SystemCoreClock));
+            xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+        }
+
+        bench_platform();
+
+        // The same results as JSON lines, after the tables
+        xsnprintf(line, BENCH_LINE_LEN, "%u priorities, %s, %s PendSV",
+            (unsigned)configMAX_PRIORITIES,
+            configUSE_PORT_OPTIMISED_TASK_SELECTION ? "bit map" : "generic",
+            configUSE_PORT_FAST_PENDSV ? "fast" : "standard");
+        bench_json_meta("kernel", line);
+
+        for(uint32_t i=1; i<BENCH_COUNT; i++)
+        {
+            bench_json(benchmarks[i].name, &results[i], results[0].min);
+        }
+
+        bench_platform_json();
+
+        xSerialPutStringPolicy("Cycles per operation, any key to repeat\r\n",
+            eSerialBlock, portMAX_DELAY);
+
+        (void)xSerialGetChar(&c, portMAX_DELAY);
+    }
+}
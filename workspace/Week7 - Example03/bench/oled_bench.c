@@ -0,0 +1,626 @@
+/*! ***************************************************************************
+ *
+ * \brief     On-target throughput benchmark of the Oled display
+ * \file      oled_bench.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+
+#include <MKL25Z4.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+#include "bitmaps.h"
+#include "bitmaps_rle.h"
+#include "fonts.h"
+#include "i2c.h"
+#include "i2c1.h"
+#include "mono.h"
+#include "sections.h"
+#include "serial.h"
+#include "spi1.h"
+#include "sprite.h"
+#include "ssd1306.h"
+#include "ssd1306_transport.h"
+#include "xprintf.h"
+
+/*----------------------------------------------------------------------------*/
+// Local defines
+/*----------------------------------------------------------------------------*/
+
+// Frames timed per workload and mode
+#define BENCH_FRAMES        (32)
+
+// Priority of the benchmark task. The spin task below it counts the time
+// the benchmark task waits for the bus.
+#define BENCH_PRIORITY      (2)
+#define SPIN_PRIORITY       (1)
+
+// Time the spin task counts alone to calibrate the idle time
+#define BENCH_CALIBRATE_MS  (200)
+
+#define BENCH_LINE_LEN      (64)
+
+// Balls of the sprite animation, and their size in pixels
+#define BALL_COUNT          (3)
+#define BALL_SIZE           (16)
+
+// Centre of the clock face of clock_rle, see main.c
+#define CLOCK_X             (64)
+#define CLOCK_Y             (31)
+
+// The display backend, selected at build time
+#if SSD1306_SPI
+#define BENCH_BACKEND       "SPI1 IRQ+DMA"
+#elif I2C1_USE_DMA
+#define BENCH_BACKEND       "I2C1 IRQ+DMA"
+#else
+#define BENCH_BACKEND       "I2C1 IRQ"
+#endif
+
+// Stack sizes in words of the benchmark and spin tasks
+#define BENCH_STACK_DEPTH   (configMINIMAL_STACK_SIZE + 128)
+#define SPIN_STACK_DEPTH    (configMINIMAL_STACK_SIZE)
+
+/*!
+ * \brief A rendered workload
+ *
+ * setup() draws the first frame and is not timed. frame() draws frame \p n
+ * into the framebuffer, which is sent by ssd1306_update() afterwards. A
+ * workload that sends the frame itself sets \p sends, its render and bus
+ * time cannot be told apart.
+ */
+typedef struct
+{
+    const char *name;
+    void (*setup)(void);
+    void (*frame)(const uint32_t n, const bool full);
+    bool sends;
+}workload_t;
+
+/// Bit rate of the display bus for an interrupt driven pass, 0 for the
+/// rate of the driver
+typedef struct
+{
+    uint32_t bps;
+}bench_config_t;
+
+/// Result of a workload in microseconds of all BENCH_FRAMES frames
+typedef struct
+{
+    uint32_t render_us;
+    uint32_t bus_us;
+    uint32_t total_us;
+    uint32_t idle_us;
+    bench_stats_t frame;    ///< Microseconds of a frame
+}bench_result_t;
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+
+// Counted by the spin task whenever the benchmark task waits
+static volatile uint32_t spin_count;
+
+// Spin counts in BENCH_CALIBRATE_MS and the measured duration of it
+static uint32_t calibrate_spins;
+static uint32_t calibrate_us;
+
+// Microseconds of every frame of a workload
+static uint32_t frame_us[BENCH_FRAMES];
+
+// The display, the benchmark is a firmware of its own
+__BSS_NOCLEAR static uint8_t framebuffer[SSD1306_SIZE] __attribute__((aligned(4)));
+static ssd1306_t oled = SSD1306_DISPLAY_INIT(framebuffer, SSD1306_SLAVE_ADDRESS);
+
+static sprite_scene_t scene;
+static sprite_t balls[BALL_COUNT];
+static uint8_t ball_image[SPRITE_IMAGE_SIZE(BALL_SIZE, BALL_SIZE)];
+
+static StaticTask_t bench_tcb;
+__BSS_NOCLEAR static StackType_t bench_stack[BENCH_STACK_DEPTH];
+static StaticTask_t spin_tcb;
+__BSS_NOCLEAR static StackType_t spin_stack[SPIN_STACK_DEPTH];
+
+/*----------------------------------------------------------------------------*/
+// Local function prototypes
+/*----------------------------------------------------------------------------*/
+static void vBenchTask(void *pvParameters);
+static void vSpinTask(void *pvParameters);
+static void bench_pass(bench_result_t results[][2]);
+static void bench_print(const char *title, const uint32_t bps,
+    bench_result_t results[][2], const bool polled);
+
+/*----------------------------------------------------------------------------*/
+// Workloads
+/*----------------------------------------------------------------------------*/
+
+static void text_setup(void)
+{
+    ssd1306_setfont(&oled, Monospaced_plain_10);
+}
+
+/*!
+ * \brief Fills the screen with 5 lines of 21 characters, every character
+ *        changes every frame
+ */
+static void text_frame(const uint32_t n, const bool full)
+{
+    char str[5 * 22 + 1];
+    uint32_t i = 0;
+
+    (void)full;
+
+    for(uint32_t row=0; row<5; row++)
+    {
+        for(uint32_t col=0; col<21; col++)
+        {
+            str[i++] = (char)('!' + ((n + row * 21 + col) % 94));
+        }
+
+        str[i++] = '\n';
+    }
+
+    str[i] = '\0';
+
+    ssd1306_putstring(&oled, 0, 0, str);
+}
+
+static void clock_setup(void)
+{
+    ssd1306_drawrle(&oled, &clock_rle, 0, 0);
+}
+
+/*!
+ * \brief Draws a clock hand from the centre of the clock face
+ */
+static void clock_hand(const int32_t len, const uint32_t step)
+{
+    const int32_t x = CLOCK_X + ((len * ssd1306_sin(step) + 0x4000) >> 15);
+    const int32_t y = CLOCK_Y - ((len * ssd1306_cos(step) + 0x4000) >> 15);
+
+    ssd1306_drawline(&oled, CLOCK_X, CLOCK_Y, (uint8_t)x, (uint8_t)y);
+}
+
+/*!
+ * \brief Draws the clock face and the hands, the second hand moves one
+ *        step every frame
+ *
+ * The face is drawn again every frame, so only the bytes that really
+ * changed are dirty.
+ */
+static void clock_frame(const uint32_t n, const bool full)
+{
+    (void)full;
+
+    ssd1306_drawrle(&oled, &clock_rle, 0, 0);
+
+    clock_hand(16, 50);
+    clock_hand(24, 10);
+    clock_hand(28, n % 60);
+}
+
+/*!
+ * \brief Draws a ball in its sprite image
+ */
+static void sprite_setup(void)
+{
+    const int32_t r = BALL_SIZE / 2;
+
+    (void)memset(ball_image, 0, sizeof(ball_image));
+
+    for(int32_t y=0; y<BALL_SIZE; y++)
+    {
+        for(int32_t x=0; x<BALL_SIZE; x++)
+        {
+            const int32_t dx = 2 * x + 1 - BALL_SIZE;
+            const int32_t dy = 2 * y + 1 - BALL_SIZE;
+
+            if((dx * dx + dy * dy) <= (4 * r * r))
+            {
+                ball_image[(y / 8) * BALL_SIZE + x] |= (uint8_t)(1 << (y % 8));
+            }
+        }
+    }
+
+    sprite_scene_init(&scene, NULL);
+    sprite_set_background_rle(&scene, &clock_rle);
+
+    for(uint32_t i=0; i<BALL_COUNT; i++)
+    {
+        sprite_init(&balls[i], ball_image, BALL_SIZE, BALL_SIZE, SPRITE_XOR);
+        sprite_show(&balls[i], true);
+        sprite_add(&scene, &balls[i]);
+    }
+
+    (void)sprite_render(&scene, &oled);
+}
+
+/*!
+ * \brief Returns a position that bounces between 0 and \p span
+ */
+static int16_t sprite_bounce(const uint32_t pos, const uint32_t span)
+{
+    const uint32_t p = pos % (2 * span);
+
+    return (int16_t)((p < span) ? p : (2 * span - p));
+}
+
+/*!
+ * \brief Moves the balls over the clock face, each at its own speed
+ */
+static void sprite_frame(const uint32_t n, const bool full)
+{
+    for(uint32_t i=0; i<BALL_COUNT; i++)
+    {
+        sprite_move(&balls[i],
+            sprite_bounce(n * (2 + i) + i * 40, SSD1306_WIDTH - BALL_SIZE),
+            sprite_bounce(n * (3 - i) + i * 16, SSD1306_HEIGHT - BALL_SIZE));
+    }
+
+    if(full)
+    {
+        sprite_invalidate(&scene);
+    }
+
+    (void)sprite_render(&scene, &oled);
+}
+
+static void terminal_setup(void)
+{
+    ssd1306_setfont(&oled, Monospaced_plain_10);
+}
+
+/*!
+ * \brief Writes a line and scrolls the terminal every frame
+ */
+static void terminal_frame(const uint32_t n, const bool full)
+{
+    char line[24];
+
+    (void)full;
+
+    xsnprintf(line, sizeof(line), "\nframe %4lu scrolled", (unsigned long)n);
+    ssd1306_terminal(&oled, line);
+}
+
+/*!
+ * \brief The workloads, the terminal is last as it rotates the framebuffer
+ *        rows, see ssd1306_terminal()
+ */
+static const workload_t workloads[] =
+{
+    {"text",     text_setup,     text_frame,     false},
+    {"clock",    clock_setup,    clock_frame,    false},
+    {"sprites",  sprite_setup,   sprite_frame,   false},
+    {"terminal", terminal_setup, terminal_frame, true},
+};
+
+#define WORKLOAD_COUNT (sizeof(workloads) / sizeof(workloads[0]))
+
+/*!
+ * \brief The bit rates of the interrupt driven passes
+ *
+ * The SPI clock is fixed by the driver. The I2C passes are standard mode,
+ * the default of the driver and fast mode.
+ */
+static const bench_config_t configs[] =
+{
+#if SSD1306_SPI
+    {0},
+#else
+    {100000},
+    {I2C1_DEFAULT_BPS},
+    {400000},
+#endif
+};
+
+#define CONFIG_COUNT (sizeof(configs) / sizeof(configs[0]))
+
+// Results of the polled pass before the scheduler started
+static bench_result_t polled_results[WORKLOAD_COUNT][2];
+
+/*----------------------------------------------------------------------------*/
+// Main application
+/*----------------------------------------------------------------------------*/
+int main(void)
+{
+    char line[BENCH_LINE_LEN];
+
+    xSerialPortInit(921600, 128);
+
+    vSerialPutString("\r\nFRDM-KL25Z Oled display benchmark\r\n");
+
+    // The backend is selected at build time, compare builds with -D overrides
+    xsnprintf(line, sizeof(line), "Backend %s, %lu frames per workload\r\n",
+        BENCH_BACKEND, (unsigned long)BENCH_FRAMES);
+    vSerialPutString(line);
+
+    // Without the scheduler, the drivers poll the bus
+    ssd1306_init(&oled);
+    bench_pass(polled_results);
+
+    (void)xTaskCreateStatic(vBenchTask, "Bench", BENCH_STACK_DEPTH, NULL,
+        BENCH_PRIORITY, bench_stack, &bench_tcb);
+    (void)xTaskCreateStatic(vSpinTask, "Spin", SPIN_STACK_DEPTH, NULL,
+        SPIN_PRIORITY, spin_stack, &spin_tcb);
+
+    /* Start the scheduler so the tasks start executing. */
+    vTaskStartScheduler();
+
+    for( ;; );
+}
+
+/*----------------------------------------------------------------------------*/
+// Benchmark
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Counts the time no other task runs
+ */
+static void vSpinTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for( ;; )
+    {
+        spin_count++;
+    }
+}
+
+/*!
+ * \brief Returns the bit rate of the display bus
+ */
+static uint32_t bench_bps(void)
+{
+#if SSD1306_SPI
+    return spi1_get_speed();
+#else
+    return i2c1_get_speed();
+#endif
+}
+
+/*!
+ * \brief Times a workload
+ *
+ * \param[in]  w     The workload
+ * \param[in]  full  Send the complete framebuffer every frame, instead of
+ *                   the dirty parts only
+ *
+ * \return Render, bus, total and idle microseconds of all frames, and the
+ *         statistics of a frame
+ */
+static bench_result_t bench_run(const workload_t *w, const bool full)
+{
+    bench_result_t result = {0};
+
+    // The first frame is not timed
+    w->setup();
+    ssd1306_invalidate(&oled);
+    ssd1306_update(&oled);
+
+    const uint32_t spins = spin_count;
+    const uint32_t start = mono_us32();
+
+    for(uint32_t n=0; n<BENCH_FRAMES; n++)
+    {
+        if(full)
+        {
+            ssd1306_invalidate(&oled);
+        }
+
+        const uint32_t t0 = mono_us32();
+
+        w->frame(n, full);
+
+        const uint32_t t1 = mono_us32();
+
+        if(w->sends)
+        {
+            result.bus_us += t1 - t0;
+            frame_us[n] = t1 - t0;
+        }
+        else
+        {
+            ssd1306_update(&oled);
+
+            const uint32_t t2 = mono_us32();
+
+            result.render_us += t1 - t0;
+            result.bus_us += t2 - t1;
+            frame_us[n] = t2 - t0;
+        }
+    }
+
+    result.total_us = mono_us32() - start;
+    bench_stats_sort(&result.frame, frame_us, BENCH_FRAMES);
+
+    if(calibrate_spins > 0)
+    {
+        result.idle_us = (uint32_t)(((uint64_t)(spin_count - spins) * calibrate_us)
+            / calibrate_spins);
+    }
+
+    return result;
+}
+
+/*!
+ * \brief Times every workload with full and dirty updates
+ *
+ * \param[out]  results  Dirty and full results of every workload
+ */
+static void bench_pass(bench_result_t results[][2])
+{
+    for(uint32_t i=0; i<WORKLOAD_COUNT; i++)
+    {
+        // Resets the start line of the terminal and clears the framebuffer
+        ssd1306_init(&oled);
+
+        results[i][0] = bench_run(&workloads[i], false);
+        results[i][1] = bench_run(&workloads[i], true);
+    }
+}
+
+/*!
+ * \brief Writes the results of a pass to the serial port
+ *
+ * Render and bus are the average microseconds per frame, CPU is the share
+ * of the frame time the spin task did not run. The table is followed by
+ * the same results as JSON lines, with the spread of the frame times.
+ *
+ * \param[in]  title    Description of the pass
+ * \param[in]  bps      Bit rate of the display bus
+ * \param[in]  results  Dirty and full results of every workload
+ * \param[in]  polled   The pass ran without the scheduler, the CPU is busy
+ *                      all the time
+ */
+static void bench_print(const char *title, const uint32_t bps,
+    bench_result_t results[][2], const bool polled)
+{
+    char line[BENCH_LINE_LEN];
+
+    xsnprintf(line, BENCH_LINE_LEN, "\r\n%s, %lu bit/s\r\n", title,
+        (unsigned long)bps);
+    xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+
+    xsnprintf(line, BENCH_LINE_LEN, "%-9s %-5s %7s %7s %4s %6s\r\n",
+        "Workload", "Mode", "Render", "Bus", "CPU", "FPS");
+    xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+
+    for(uint32_t i=0; i<WORKLOAD_COUNT; i++)
+    {
+        for(uint32_t m=0; m<2; m++)
+        {
+            const bench_result_t *r = &results[i][m];
+            const uint32_t idle = (r->idle_us < r->total_us) ? r->idle_us : r->total_us;
+            const uint32_t busy = polled ? 100 :
+                (uint32_t)(100 - ((uint64_t)idle * 100) / r->total_us);
+            const uint32_t fps10 = (uint32_t)(((uint64_t)BENCH_FRAMES * 10000000ULL)
+                / r->total_us);
+            char render[8] = "-";
+
+            if(!workloads[i].sends)
+            {
+                xsnprintf(render, sizeof(render), "%lu",
+                    (unsigned long)(r->render_us / BENCH_FRAMES));
+            }
+
+            xsnprintf(line, BENCH_LINE_LEN, "%-9s %-5s %7s %7lu %3lu%% %4lu.%lu\r\n",
+                workloads[i].name, m ? "full" : "dirty", render,
+                (unsigned long)(r->bus_us / BENCH_FRAMES), (unsigned long)busy,
+                (unsigned long)(fps10 / 10), (unsigned long)(fps10 % 10));
+            xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+        }
+    }
+
+    xsnprintf(line, BENCH_LINE_LEN, "%s, %lu bit/s", BENCH_BACKEND, (unsigned long)bps);
+    bench_json_meta("oled", line);
+
+    for(uint32_t i=0; i<WORKLOAD_COUNT; i++)
+    {
+        for(uint32_t m=0; m<2; m++)
+        {
+            const bench_result_t *r = &results[i][m];
+            const uint32_t idle = (r->idle_us < r->total_us) ? r->idle_us : r->total_us;
+            const uint32_t busy = polled ? 100 :
+                (uint32_t)(100 - ((uint64_t)idle * 100) / r->total_us);
+            char name[32];
+
+            xsnprintf(name, sizeof(name), "%s %s, %s", workloads[i].name,
+                m ? "full" : "dirty", polled ? "polled" : "interrupts");
+
+            bench_json_stats("oled", name, "us", &r->frame);
+
+            if(!workloads[i].sends)
+            {
+                bench_json_value("oled", name, "render", "us",
+                    r->render_us / BENCH_FRAMES);
+            }
+
+            bench_json_value("oled", name, "bus", "us", r->bus_us / BENCH_FRAMES);
+            bench_json_value("oled", name, "cpu", "%", busy);
+            bench_json_value("oled", name, "frame rate", "mHz",
+                (uint32_t)(((uint64_t)BENCH_FRAMES * 1000000000ULL) / r->total_us));
+        }
+    }
+}
+
+/*!
+ * \brief Calibrates the spin task, runs the interrupt driven passes and
+ *        writes all tables to the serial port
+ *
+ * Nothing is written while a pass runs, so the serial interrupts do not
+ * disturb it. Any received character starts the next round, which keeps
+ * the results of the polled pass at reset.
+ */
+static void vBenchTask(void *pvParameters)
+{
+    static bench_result_t results[WORKLOAD_COUNT][2];
+    char c;
+
+    (void)pvParameters;
+
+    for( ;; )
+    {
+        // Let the banner drain, then count the spins of an idle system
+        vTaskDelay(pdMS_TO_TICKS(100));
+
+        const uint32_t spins = spin_count;
+        const uint32_t start = mono_us32();
+
+        vTaskDelay(pdMS_TO_TICKS(BENCH_CALIBRATE_MS));
+
+        calibrate_us = mono_us32() - start;
+        calibrate_spins = spin_count - spins;
+
+        bench_print("Polled", bench_bps(), polled_results, true);
+
+        for(uint32_t i=0; i<CONFIG_COUNT; i++)
+        {
+#if !SSD1306_SPI
+            (void)i2c1_set_speed(configs[i].bps);
+#endif
+            // Let the table drain
+            vTaskDelay(pdMS_TO_TICKS(100));
+
+            bench_pass(results);
+            bench_print("Interrupts", bench_bps(), results, false);
+        }
+
+#if !SSD1306_SPI
+        (void)i2c1_set_speed(I2C1_DEFAULT_BPS);
+#endif
+
+        xSerialPutStringPolicy("Microseconds per frame, any key to repeat\r\n",
+            eSerialBlock, portMAX_DELAY);
+
+        (void)xSerialGetChar(&c, portMAX_DELAY);
+    }
+}
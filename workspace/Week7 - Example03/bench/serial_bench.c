@@ -0,0 +1,819 @@
+/*! ***************************************************************************
+ *
+ * \brief     On-target throughput and latency benchmark of the serial driver
+ * \file      serial_bench.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <MKL25Z4.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+#include "mono.h"
+#include "retarget.h"
+#include "sections.h"
+#include "serial.h"
+#include "xprintf.h"
+
+/*
+ * Commands, one character each, see tools/serial_bench.py:
+ *   l  Loopback: UART0 in loop mode at every rate of loopback_bauds, no
+ *      cable or host needed. The host sees the test bytes or nothing on
+ *      its receive line while it runs, the table follows afterwards.
+ *   e  Echo every received byte until the line is quiet for
+ *      BENCH_QUIET_MS, for the round trip latency measured by the host
+ *   t  Send BENCH_BYTES bytes of the test pattern to the host
+ *   r  Receive BENCH_BYTES bytes of the test pattern from the host
+ *   p  Write BENCH_LINES formatted lines with xsnprintf() and
+ *      xSerialWrite(), with xSerialPrintf() and with printf() through
+ *      retarget/retarget.c, for the cost of standard I/O per line
+ *
+ * The test pattern is byte i = i % 251, so a lost byte shows up as errors
+ * in the bytes after it.
+ */
+
+/*----------------------------------------------------------------------------*/
+// Local defines
+/*----------------------------------------------------------------------------*/
+
+// Baud rate of the console, restored after the loopback test
+#define BENCH_BAUD          (921600)
+
+// Queue length of the serial port, compare builds with -D overrides
+#ifndef BENCH_QUEUE_LENGTH
+#define BENCH_QUEUE_LENGTH  (128)
+#endif
+
+// Bytes per throughput test, written in chunks of BENCH_CHUNK bytes
+#define BENCH_BYTES         (4096)
+#define BENCH_CHUNK         (64)
+
+// Single byte round trips per rate of the loopback test
+#define BENCH_SAMPLES       (128)
+
+// A round trip that takes longer counts as a lost byte
+#define BENCH_LOST_MS       (10)
+
+// The echo and receive tests end after this quiet time
+#define BENCH_QUIET_MS      (1000)
+
+// The benchmark task reads the port, the writer task feeds the loopback
+// test, the spin task below both counts the time neither runs
+#define BENCH_PRIORITY      (3)
+#define WRITER_PRIORITY     (2)
+#define SPIN_PRIORITY       (1)
+
+// Time the spin task counts alone to calibrate the idle time
+#define BENCH_CALIBRATE_MS  (200)
+
+#define BENCH_PATTERN_MOD   (251)
+
+#define BENCH_LINE_LEN      (64)
+
+// Lines per method of the standard I/O test
+#define BENCH_LINES         (64)
+
+// Stack sizes in words of the tasks
+#define BENCH_STACK_DEPTH   (configMINIMAL_STACK_SIZE + 128)
+#define WRITER_STACK_DEPTH  (configMINIMAL_STACK_SIZE + 32)
+#define SPIN_STACK_DEPTH    (configMINIMAL_STACK_SIZE)
+
+/// Result of a throughput test
+typedef struct
+{
+    uint32_t bytes;     ///< Bytes received, or sent
+    uint32_t errors;    ///< Received bytes that did not match the pattern
+    uint32_t dropped;   ///< Bytes dropped by the driver
+    uint32_t us;        ///< Duration
+    uint32_t idle_us;   ///< Time the spin task ran
+}bench_result_t;
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+
+// Counted by the spin task whenever the other tasks wait
+static volatile uint32_t spin_count;
+
+// Spin counts in BENCH_CALIBRATE_MS and the measured duration of it
+static uint32_t calibrate_spins;
+static uint32_t calibrate_us;
+
+// Bytes the writer task sends when notified
+static volatile uint32_t writer_bytes;
+
+static TaskHandle_t writer_task;
+
+static uint32_t samples[BENCH_SAMPLES];
+
+/*!
+ * \brief The rates of the loopback test, all exact or within 0.16% from
+ *        the 48 MHz UART0 clock
+ */
+static const uint32_t loopback_bauds[] =
+{
+    115200, 460800, 921600, 1500000, 3000000,
+};
+
+#define BAUD_COUNT (sizeof(loopback_bauds) / sizeof(loopback_bauds[0]))
+
+static StaticTask_t bench_tcb;
+__BSS_NOCLEAR static StackType_t bench_stack[BENCH_STACK_DEPTH];
+static StaticTask_t writer_tcb;
+__BSS_NOCLEAR static StackType_t writer_stack[WRITER_STACK_DEPTH];
+static StaticTask_t spin_tcb;
+__BSS_NOCLEAR static StackType_t spin_stack[SPIN_STACK_DEPTH];
+
+/*----------------------------------------------------------------------------*/
+// Local function prototypes
+/*----------------------------------------------------------------------------*/
+static void vBenchTask(void *pvParameters);
+static void vWriterTask(void *pvParameters);
+static void vSpinTask(void *pvParameters);
+
+/*----------------------------------------------------------------------------*/
+// Main application
+/*----------------------------------------------------------------------------*/
+int main(void)
+{
+    char line[BENCH_LINE_LEN];
+
+    xSerialPortInit(BENCH_BAUD, BENCH_QUEUE_LENGTH);
+
+    // The benchmark measures drops in the receiver, the writes never drop
+    vSerialSetTxPolicy(eSerialBlock, portMAX_DELAY);
+
+    // printf() of the standard I/O test, unbuffered in newlib
+    retarget_init(xSerialGetDefaultPort());
+
+    vSerialPutString("\r\nFRDM-KL25Z serial benchmark\r\n");
+
+    xsnprintf(line, sizeof(line), "Queue length %u, TX %s, RX %s\r\n",
+        (unsigned)BENCH_QUEUE_LENGTH,
+        serUSE_DMA_TX ? "DMA" : "stream buffer",
+        serUSE_DMA_RX ? "DMA frames" : "ring");
+    vSerialPutString(line);
+
+    (void)xTaskCreateStatic(vBenchTask, "Bench", BENCH_STACK_DEPTH, NULL,
+        BENCH_PRIORITY, bench_stack, &bench_tcb);
+    writer_task = xTaskCreateStatic(vWriterTask, "Writer", WRITER_STACK_DEPTH,
+        NULL, WRITER_PRIORITY, writer_stack, &writer_tcb);
+    (void)xTaskCreateStatic(vSpinTask, "Spin", SPIN_STACK_DEPTH, NULL,
+        SPIN_PRIORITY, spin_stack, &spin_tcb);
+
+    /* Start the scheduler so the tasks start executing. */
+    vTaskStartScheduler();
+
+    for( ;; );
+}
+
+/*----------------------------------------------------------------------------*/
+// Helpers
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Reads what was received, with the receiver of the build
+ */
+static size_t bench_read(uint8_t *buf, const size_t n, const TickType_t block)
+{
+#if (serUSE_DMA_RX == 1)
+    return xSerialGetFrame(buf, n, block);
+#else
+    return xSerialRead(buf, n, block);
+#endif
+}
+
+/*!
+ * \brief Discards what is left in the receiver
+ */
+static void bench_flush(void)
+{
+    uint8_t buf[BENCH_CHUNK];
+
+    while(bench_read(buf, sizeof(buf), pdMS_TO_TICKS(20)) > 0)
+    {
+    }
+}
+
+/*!
+ * \brief Fills a buffer with the test pattern, from byte \p offset on
+ */
+static void bench_pattern(uint8_t *buf, const uint32_t offset, const size_t n)
+{
+    for(size_t i=0; i<n; i++)
+    {
+        buf[i] = (uint8_t)((offset + i) % BENCH_PATTERN_MOD);
+    }
+}
+
+/*!
+ * \brief Returns the bytes of a buffer that do not match the test pattern
+ */
+static uint32_t bench_check(const uint8_t *buf, const uint32_t offset, const size_t n)
+{
+    uint32_t errors = 0;
+
+    for(size_t i=0; i<n; i++)
+    {
+        if(buf[i] != (uint8_t)((offset + i) % BENCH_PATTERN_MOD))
+        {
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+/*!
+ * \brief Returns the bytes dropped by the driver since the last call
+ *
+ * Includes the received bytes lost to an overrun, at least one per overrun,
+ * and those discarded for a framing or parity error.
+ */
+static uint32_t bench_dropped(void)
+{
+    SerialStats_t stats;
+
+    vSerialGetStats(&stats);
+    vSerialResetStats();
+
+    return stats.ulRxBytesDropped + stats.ulTxBytesDropped + stats.ulRxOverruns +
+        stats.ulRxFramingErrors + stats.ulRxParityErrors;
+}
+
+/*!
+ * \brief Returns the percentage of \p r the spin task did not run
+ */
+static uint32_t bench_busy(const bench_result_t *r)
+{
+    if(r->us == 0)
+    {
+        return 0;
+    }
+
+    const uint32_t idle = (r->idle_us < r->us) ? r->idle_us : r->us;
+
+    return (uint32_t)(100 - ((uint64_t)idle * 100) / r->us);
+}
+
+/*!
+ * \brief Returns the core clock cycles of the other tasks and the
+ *        interrupts per byte of \p r
+ */
+static uint32_t bench_cycles_per_byte(const bench_result_t *r)
+{
+    if(r->bytes == 0)
+    {
+        return 0;
+    }
+
+    const uint32_t idle = (r->idle_us < r->us) ? r->idle_us : r->us;
+
+    return (uint32_t)(((uint64_t)(r->us - idle) * (SystemCoreClock / 1000000UL))
+        / r->bytes);
+}
+
+/*!
+ * \brief Starts a measurement of the idle time
+ */
+static void bench_start(bench_result_t *r, uint32_t *spins)
+{
+    (void)memset(r, 0, sizeof(*r));
+    (void)bench_dropped();
+
+    *spins = spin_count;
+    r->us = mono_us32();
+}
+
+/*!
+ * \brief Ends a measurement of the idle time
+ */
+static void bench_end(bench_result_t *r, const uint32_t spins, const uint32_t end)
+{
+    r->us = end - r->us;
+    r->dropped = bench_dropped();
+
+    if(calibrate_spins > 0)
+    {
+        r->idle_us = (uint32_t)(((uint64_t)(spin_count - spins) * calibrate_us)
+            / calibrate_spins);
+    }
+}
+
+/*!
+ * \brief Receives up to \p n bytes of the test pattern
+ *
+ * \param[in,out] r     Bytes and errors are added
+ * \param[in]     n     Bytes expected
+ * \param[in]     quiet Ends early after this many ticks without a byte
+ *
+ * \return Time of the last byte
+ */
+static uint32_t bench_receive(bench_result_t *r, const uint32_t n, const TickType_t quiet)
+{
+    uint8_t buf[BENCH_CHUNK];
+    uint32_t last = mono_us32();
+
+    while(r->bytes < n)
+    {
+        const size_t got = bench_read(buf, sizeof(buf), quiet);
+
+        if(got == 0)
+        {
+            break;
+        }
+
+        last = mono_us32();
+        r->errors += bench_check(buf, r->bytes, got);
+        r->bytes += got;
+    }
+
+    return last;
+}
+
+/*----------------------------------------------------------------------------*/
+// Tasks
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Counts the time no other task runs
+ */
+static void vSpinTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for( ;; )
+    {
+        spin_count++;
+    }
+}
+
+/*!
+ * \brief Sends writer_bytes bytes of the test pattern when notified
+ *
+ * The receiver has a single reader, the benchmark task, so the loopback
+ * test writes from this task.
+ */
+static void vWriterTask(void *pvParameters)
+{
+    uint8_t buf[BENCH_CHUNK];
+
+    (void)pvParameters;
+
+    for( ;; )
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        for(uint32_t sent=0; sent<writer_bytes; sent+=BENCH_CHUNK)
+        {
+            const size_t n = ((writer_bytes - sent) < BENCH_CHUNK) ?
+                (writer_bytes - sent) : BENCH_CHUNK;
+
+            bench_pattern(buf, sent, n);
+            (void)xSerialWrite(buf, n);
+        }
+    }
+}
+
+/*!
+ * \brief Writes the description of the build as a JSON line, before the
+ *        JSON lines of a test
+ */
+static void bench_meta(void)
+{
+    char line[BENCH_LINE_LEN];
+
+    xsnprintf(line, BENCH_LINE_LEN, "queue %u, TX %s, RX %s",
+        (unsigned)BENCH_QUEUE_LENGTH,
+        serUSE_DMA_TX ? "DMA" : "stream buffer",
+        serUSE_DMA_RX ? "DMA frames" : "ring");
+    bench_json_meta("serial", line);
+}
+
+/*!
+ * \brief Writes the throughput and CPU load of a test as JSON lines
+ *
+ * \param[in]  name  Name of the test
+ * \param[in]  r     Result of the test
+ * \param[in]  unit  What the bytes of the result count, "B" or "lines"
+ */
+static void bench_json_result(const char *name, const bench_result_t *r,
+    const char *unit)
+{
+    char per[16];
+
+    xsnprintf(per, sizeof(per), "cycles/%s", unit);
+
+    bench_json_value("serial", name, "count", unit, r->bytes);
+    bench_json_value("serial", name, "time", "us", r->us);
+    bench_json_value("serial", name, "cpu", "%", bench_busy(r));
+    bench_json_value("serial", name, "cost", per, bench_cycles_per_byte(r));
+    bench_json_value("serial", name, "dropped", "B", r->dropped);
+}
+
+/*!
+ * \brief Loopback test at every rate of loopback_bauds
+ *
+ * The writer task streams BENCH_BYTES bytes, which the benchmark task reads
+ * back for the throughput and the CPU load. Then BENCH_SAMPLES single bytes
+ * are sent and read back by this task, which is the round trip from
+ * xSerialPutChar() to the return of the read.
+ */
+static void bench_loopback(void)
+{
+    static bench_result_t results[BAUD_COUNT];
+    static bench_stats_t latency[BAUD_COUNT];
+    static uint32_t lost[BAUD_COUNT];
+    char line[BENCH_LINE_LEN];
+    const xComPortHandle port = xSerialGetDefaultPort();
+
+    xSerialPutStringPolicy("Loopback test, check the results afterwards\r\n",
+        eSerialBlock, portMAX_DELAY);
+
+    // Let the message drain before the rate changes
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    for(uint32_t b=0; b<BAUD_COUNT; b++)
+    {
+        bench_result_t *r = &results[b];
+        uint32_t spins;
+        uint8_t c;
+
+        if(xSerialPortSetBaud(port, loopback_bauds[b]) == pdFALSE)
+        {
+            (void)memset(r, 0, sizeof(*r));
+            bench_stats_reset(&latency[b]);
+            lost[b] = 0;
+            continue;
+        }
+
+        vSerialPortSetLoopback(port, pdTRUE);
+        bench_flush();
+
+        // Throughput, ends at the last byte read back
+        const TickType_t timeout = pdMS_TO_TICKS(((uint64_t)BENCH_BYTES * 10 * 1000)
+            / loopback_bauds[b] + 100);
+
+        bench_start(r, &spins);
+
+        writer_bytes = BENCH_BYTES;
+        xTaskNotifyGive(writer_task);
+
+        const uint32_t last = bench_receive(r, BENCH_BYTES, timeout);
+
+        bench_end(r, spins, last);
+
+        // Wait for a writer that lost bytes
+        bench_flush();
+
+        // Round trips of single bytes
+        uint32_t n = 0;
+
+        lost[b] = 0;
+
+        for(uint32_t i=0; i<BENCH_SAMPLES; i++)
+        {
+            const uint32_t start = mono_us32();
+
+            (void)xSerialPutChar((char)i, portMAX_DELAY);
+
+            if(bench_read(&c, 1, pdMS_TO_TICKS(BENCH_LOST_MS)) == 1)
+            {
+                samples[n++] = mono_us32() - start;
+            }
+            else
+            {
+                lost[b]++;
+            }
+        }
+
+        bench_stats_sort(&latency[b], samples, n);
+
+        bench_flush();
+        vSerialPortSetLoopback(port, pdFALSE);
+    }
+
+    (void)xSerialPortSetBaud(port, BENCH_BAUD);
+    bench_flush();
+    (void)bench_dropped();
+
+    xsnprintf(line, BENCH_LINE_LEN, "\r\n%7s %6s %4s %5s %5s %5s %5s %5s %4s\r\n",
+        "Baud", "B/s", "CPU", "cyc/B", "min", "med", "p99", "max", "lost");
+    xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+
+    for(uint32_t b=0; b<BAUD_COUNT; b++)
+    {
+        const bench_result_t *r = &results[b];
+        const uint32_t bps = (r->us > 0) ?
+            (uint32_t)(((uint64_t)r->bytes * 1000000ULL) / r->us) : 0;
+
+        xsnprintf(line, BENCH_LINE_LEN,
+            "%7lu %6lu %3lu%% %5lu %5lu %5lu %5lu %5lu %4lu\r\n",
+            (unsigned long)loopback_bauds[b], (unsigned long)bps,
+            (unsigned long)bench_busy(r), (unsigned long)bench_cycles_per_byte(r),
+            (unsigned long)latency[b].min, (unsigned long)latency[b].p50,
+            (unsigned long)latency[b].p99, (unsigned long)latency[b].max,
+            (unsigned long)(lost[b] + (BENCH_BYTES - r->bytes)));
+        xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+    }
+
+    xSerialPutStringPolicy("Latency in us, lost bytes of both tests\r\n",
+        eSerialBlock, portMAX_DELAY);
+
+    bench_meta();
+
+    for(uint32_t b=0; b<BAUD_COUNT; b++)
+    {
+        char name[24];
+
+        xsnprintf(name, sizeof(name), "loopback %lu", (unsigned long)loopback_bauds[b]);
+        bench_json_result(name, &results[b], "B");
+
+        xsnprintf(name, sizeof(name), "round trip %lu", (unsigned long)loopback_bauds[b]);
+        bench_json_stats("serial", name, "us", &latency[b]);
+        bench_json_value("serial", name, "lost", "B", lost[b]);
+    }
+
+    xSerialPutStringPolicy("end\r\n", eSerialBlock, portMAX_DELAY);
+}
+
+/*!
+ * \brief Echoes every received byte until the line is quiet
+ */
+static void bench_echo(void)
+{
+    uint8_t buf[BENCH_CHUNK];
+    char line[BENCH_LINE_LEN];
+    bench_result_t r;
+    uint32_t spins;
+    uint32_t last;
+
+    xSerialPutStringPolicy("echo\r\n", eSerialBlock, portMAX_DELAY);
+
+    bench_start(&r, &spins);
+    last = mono_us32();
+
+    for( ;; )
+    {
+        const size_t n = bench_read(buf, sizeof(buf), pdMS_TO_TICKS(BENCH_QUIET_MS));
+
+        if(n == 0)
+        {
+            break;
+        }
+
+        last = mono_us32();
+        (void)xSerialWrite(buf, n);
+        r.bytes += n;
+    }
+
+    bench_end(&r, spins, last);
+
+    xsnprintf(line, BENCH_LINE_LEN, "echo %lu bytes, cpu %lu%%, %lu dropped\r\n",
+        (unsigned long)r.bytes, (unsigned long)bench_busy(&r),
+        (unsigned long)r.dropped);
+    xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+
+    bench_meta();
+    bench_json_result("echo", &r, "B");
+    xSerialPutStringPolicy("end\r\n", eSerialBlock, portMAX_DELAY);
+}
+
+/*!
+ * \brief Sends BENCH_BYTES bytes of the test pattern
+ *
+ * The time is until the last byte was handed to the driver, the host
+ * measures the throughput on the line.
+ */
+static void bench_transmit(void)
+{
+    uint8_t buf[BENCH_CHUNK];
+    char line[BENCH_LINE_LEN];
+    bench_result_t r;
+    uint32_t spins;
+
+    xsnprintf(line, BENCH_LINE_LEN, "tx %lu\r\n", (unsigned long)BENCH_BYTES);
+    xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+
+    bench_start(&r, &spins);
+
+    for(uint32_t sent=0; sent<BENCH_BYTES; sent+=BENCH_CHUNK)
+    {
+        bench_pattern(buf, sent, BENCH_CHUNK);
+        r.bytes += xSerialWrite(buf, BENCH_CHUNK);
+    }
+
+    bench_end(&r, spins, mono_us32());
+
+    xsnprintf(line, BENCH_LINE_LEN, "\r\ntx %lu bytes, %lu us, cpu %lu%%, %lu cyc/B\r\n",
+        (unsigned long)r.bytes, (unsigned long)r.us, (unsigned long)bench_busy(&r),
+        (unsigned long)bench_cycles_per_byte(&r));
+    xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+
+    bench_meta();
+    bench_json_result("transmit", &r, "B");
+}
+
+/*!
+ * \brief Receives BENCH_BYTES bytes of the test pattern
+ *
+ * The time is from the first to the last byte received.
+ */
+static void bench_rx(void)
+{
+    uint8_t buf[BENCH_CHUNK];
+    char line[BENCH_LINE_LEN];
+    bench_result_t r;
+    uint32_t spins;
+
+    xsnprintf(line, BENCH_LINE_LEN, "rx %lu\r\n", (unsigned long)BENCH_BYTES);
+    xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+
+    // The first bytes start the measurement
+    const size_t first = bench_read(buf, sizeof(buf), pdMS_TO_TICKS(BENCH_QUIET_MS));
+
+    if(first == 0)
+    {
+        xSerialPutStringPolicy("rx nothing received\r\n", eSerialBlock, portMAX_DELAY);
+        return;
+    }
+
+    bench_start(&r, &spins);
+
+    r.errors = bench_check(buf, 0, first);
+    r.bytes = first;
+
+    const uint32_t last = bench_receive(&r, BENCH_BYTES, pdMS_TO_TICKS(BENCH_QUIET_MS));
+
+    bench_end(&r, spins, last);
+
+    xsnprintf(line, BENCH_LINE_LEN, "rx %lu of %lu bytes, %lu us, cpu %lu%%, %lu cyc/B\r\n",
+        (unsigned long)r.bytes, (unsigned long)BENCH_BYTES, (unsigned long)r.us,
+        (unsigned long)bench_busy(&r), (unsigned long)bench_cycles_per_byte(&r));
+    xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+
+    xsnprintf(line, BENCH_LINE_LEN, "rx %lu errors, %lu dropped\r\n",
+        (unsigned long)r.errors, (unsigned long)r.dropped);
+    xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+
+    bench_meta();
+    bench_json_result("receive", &r, "B");
+    bench_json_value("serial", "receive", "errors", "B", r.errors);
+}
+
+/*!
+ * \brief Writes BENCH_LINES lines with every method of standard I/O
+ *
+ * The time of a method lasts until its lines were sent, so the CPU time
+ * includes the transmit interrupts, which are the same for all methods.
+ */
+static void bench_stdio(void)
+{
+    static const char *const methods[] = {"write", "xprintf", "printf"};
+    bench_result_t results[3];
+    char line[BENCH_LINE_LEN];
+
+    xSerialPutStringPolicy("stdio\r\n", eSerialBlock, portMAX_DELAY);
+
+    // Time to send the lines of a method, of up to 32 bytes
+    const TickType_t drain = pdMS_TO_TICKS(((uint64_t)BENCH_LINES * 32 * 10 * 1000)
+        / ulSerialGetBaud() + 20);
+
+    for(uint32_t m=0; m<3; m++)
+    {
+        bench_result_t *r = &results[m];
+        uint32_t spins;
+
+        bench_start(r, &spins);
+
+        for(uint32_t i=0; i<BENCH_LINES; i++)
+        {
+            const unsigned long id = (unsigned long)(i * 0x9E3779B1UL);
+
+            if(m == 0)
+            {
+                const int n = xsnprintf(line, BENCH_LINE_LEN, "%s %3lu 0x%08lx\r\n",
+                    methods[m], (unsigned long)i, id);
+
+                (void)xSerialWrite(line, (size_t)n);
+            }
+            else if(m == 1)
+            {
+                (void)xSerialPrintf("%s %3lu 0x%08lx\r\n", methods[m],
+                    (unsigned long)i, id);
+            }
+            else
+            {
+                (void)printf("%s %3lu 0x%08lx\n", methods[m], (unsigned long)i, id);
+            }
+        }
+
+        vTaskDelay(drain);
+
+        bench_end(r, spins, mono_us32());
+        r->bytes = BENCH_LINES;
+    }
+
+    xsnprintf(line, BENCH_LINE_LEN, "%-8s %8s %4s %8s\r\n",
+        "Method", "us", "CPU", "cyc/line");
+    xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+
+    for(uint32_t m=0; m<3; m++)
+    {
+        xsnprintf(line, BENCH_LINE_LEN, "%-8s %8lu %3lu%% %8lu\r\n", methods[m],
+            (unsigned long)results[m].us, (unsigned long)bench_busy(&results[m]),
+            (unsigned long)bench_cycles_per_byte(&results[m]));
+        xSerialPutStringPolicy(line, eSerialBlock, portMAX_DELAY);
+    }
+
+    bench_meta();
+
+    for(uint32_t m=0; m<3; m++)
+    {
+        bench_json_result(methods[m], &results[m], "lines");
+    }
+
+    xSerialPutStringPolicy("end\r\n", eSerialBlock, portMAX_DELAY);
+}
+
+/*!
+ * \brief Calibrates the spin task and runs the commands
+ */
+static void vBenchTask(void *pvParameters)
+{
+    uint8_t cmd[BENCH_CHUNK];
+
+    (void)pvParameters;
+
+    // Let the banner drain, then count the spins of an idle system
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    const uint32_t spins = spin_count;
+    const uint32_t start = mono_us32();
+
+    vTaskDelay(pdMS_TO_TICKS(BENCH_CALIBRATE_MS));
+
+    calibrate_us = mono_us32() - start;
+    calibrate_spins = spin_count - spins;
+
+    for( ;; )
+    {
+        xSerialPutStringPolicy("l=loopback e=echo t=transmit r=receive p=stdio\r\n",
+            eSerialBlock, portMAX_DELAY);
+
+        if(bench_read(cmd, sizeof(cmd), portMAX_DELAY) == 0)
+        {
+            continue;
+        }
+
+        switch(cmd[0])
+        {
+            case 'l':
+                bench_loopback();
+                break;
+            case 'e':
+                bench_echo();
+                break;
+            case 't':
+                bench_transmit();
+                break;
+            case 'r':
+                bench_rx();
+                break;
+            case 'p':
+                bench_stdio();
+                break;
+            default:
+                break;
+        }
+    }
+}
@@ -0,0 +1,254 @@
+/*! ***************************************************************************
+ *
+ * \brief     Device bring-up with dependencies and settle times
+ * \file      bringup.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#define LOG_MODULE  BRINGUP
+#define LOG_TAG     "Bring-up: "
+
+#include "bringup.h"
+#include "event_groups.h"
+#include "log.h"
+#include "serial.h"
+#include "xprintf.h"
+
+/*
+ * Every driver brings up its device in the task that owns it, so the steps
+ * overlap: a task that waits for the reset time of its device or for a
+ * device it depends on blocks, the others go on. The settle time counts from
+ * the start of the scheduler rather than from the start of the step, so it
+ * runs out while the other devices are initialised. The application is
+ * ready when the slowest device is, not after the sum of all of them.
+ *
+ * A device is done when its step ended, whether it succeeded or not, so a
+ * missing device does not keep the ones that depend on it waiting for ever.
+ * These check bringup_ok() to find out.
+ */
+
+// Time a line may wait for room in the serial transmit buffer
+#define BRINGUP_BLOCK_TIME pdMS_TO_TICKS(100)
+
+// Longest line written to the serial port, including the terminator
+#define BRINGUP_LINE_LEN   (48)
+
+// A bit per device that is done, for the tasks that wait
+static StaticEventGroup_t done_buffer;
+static EventGroupHandle_t done = NULL;
+
+// Devices that are done and that failed, written in a critical section, and
+// the devices the application waits for
+static uint32_t finished = 0;
+static uint32_t failed = 0;
+static uint32_t expected = 0;
+static bool ready = false;
+
+// Ticks at which the steps started and ended
+static const bringup_step_t *steps[BRINGUP_DEVICES];
+static TickType_t begin_ticks[BRINGUP_DEVICES];
+static TickType_t done_ticks[BRINGUP_DEVICES];
+
+/*!
+ * \brief Sets up the bring-up, called before the tasks are started
+ *
+ * \param[in]  devices  BRINGUP_MASK() of the devices that are brought up, the
+ *                      application is ready when all of these are done
+ */
+void bringup_init(const uint32_t devices)
+{
+    configASSERT(done == NULL);
+
+    expected = devices;
+    done = xEventGroupCreateStatic(&done_buffer);
+}
+
+/*!
+ * \brief Starts the bring-up of a device
+ *
+ * Waits until the devices the step depends on are done and the settle time
+ * of the device ran out. A step without dependencies whose settle time ran
+ * out does not block, so it may be started before the scheduler.
+ *
+ * \param[in]  step     The bring-up of the device
+ * \param[in]  timeout  Maximum time to wait for the dependencies
+ *
+ * \return True if the dependencies were brought up, false if one of them
+ *         failed or the wait timed out. The step must be ended with
+ *         bringup_done() in both cases.
+ */
+bool bringup_begin(const bringup_step_t *step, const TickType_t timeout)
+{
+    configASSERT((done != NULL) && (step->dev < BRINGUP_DEVICES));
+
+    bool deps_done = true;
+
+    if(step->deps != 0)
+    {
+        const EventBits_t bits = xEventGroupWaitBits(done, step->deps,
+            pdFALSE, pdTRUE, timeout);
+
+        deps_done = ((bits & step->deps) == step->deps);
+    }
+
+    if(deps_done)
+    {
+        const TickType_t now = xTaskGetTickCount();
+        const TickType_t settle = pdMS_TO_TICKS(step->settle_ms);
+
+        if(now < settle)
+        {
+            vTaskDelay(settle - now);
+        }
+    }
+
+    begin_ticks[step->dev] = xTaskGetTickCount();
+    steps[step->dev] = step;
+
+    return deps_done && bringup_ok(step->deps);
+}
+
+/*!
+ * \brief Ends the bring-up of a device
+ *
+ * Releases the steps that depend on it. The last expected device logs the
+ * time to the ready state.
+ *
+ * \param[in]  step  The bring-up of the device
+ * \param[in]  ok    True if the device works
+ */
+void bringup_done(const bringup_step_t *step, const bool ok)
+{
+    configASSERT((done != NULL) && (step->dev < BRINGUP_DEVICES));
+
+    const uint32_t mask = BRINGUP_MASK(step->dev);
+    const TickType_t now = xTaskGetTickCount();
+    bool now_ready = false;
+
+    steps[step->dev] = step;
+    done_ticks[step->dev] = now;
+
+    taskENTER_CRITICAL();
+    {
+        finished |= mask;
+
+        if(!ok)
+        {
+            failed |= mask;
+        }
+
+        if(!ready && ((finished & expected) == expected))
+        {
+            ready = true;
+            now_ready = true;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    (void)xEventGroupSetBits(done, mask);
+
+    if(!ok)
+    {
+        LOG_ERROR("%s failed\r\n", step->name);
+    }
+
+    if(now_ready)
+    {
+        LOG_INFO("ready after %u ms\r\n",
+            (unsigned int)(now * portTICK_PERIOD_MS));
+    }
+}
+
+/*!
+ * \brief Checks that devices were brought up
+ *
+ * \param[in]  devices  BRINGUP_MASK() of the devices
+ *
+ * \return True if all of them are done and none failed
+ */
+bool bringup_ok(const uint32_t devices)
+{
+    return ((finished & devices) == devices) && ((failed & devices) == 0);
+}
+
+/*!
+ * \brief Waits until devices are done
+ *
+ * \param[in]  devices  BRINGUP_MASK() of the devices
+ * \param[in]  timeout  Maximum time to wait
+ *
+ * \return True if all of them are done and none failed
+ */
+bool bringup_wait(const uint32_t devices, const TickType_t timeout)
+{
+    configASSERT(done != NULL);
+
+    (void)xEventGroupWaitBits(done, devices, pdFALSE, pdTRUE, timeout);
+
+    return bringup_ok(devices);
+}
+
+/*!
+ * \brief Writes when every device started and ended its bring-up
+ *
+ * Times are in ms from the start of the scheduler. A step that waited for
+ * a dependency or its settle time begins late, a step that has not ended is
+ * shown without its end.
+ */
+void bringup_report(void)
+{
+    char line[BRINGUP_LINE_LEN];
+
+    xSerialPutStringPolicy("\r\nDevice     Begin    Done\r\n", eSerialBlock,
+        BRINGUP_BLOCK_TIME);
+
+    for(uint32_t i=0; i<BRINGUP_DEVICES; i++)
+    {
+        const uint32_t mask = BRINGUP_MASK(i);
+
+        if(steps[i] == NULL)
+        {
+            continue;
+        }
+
+        const unsigned int begin_ms = begin_ticks[i] * portTICK_PERIOD_MS;
+        const unsigned int done_ms = done_ticks[i] * portTICK_PERIOD_MS;
+
+        if(!(finished & mask))
+        {
+            xsnprintf(line, BRINGUP_LINE_LEN, "%-8s %7u     ...\r\n",
+                steps[i]->name, begin_ms);
+        }
+        else
+        {
+            xsnprintf(line, BRINGUP_LINE_LEN, "%-8s %7u %7u%s\r\n",
+                steps[i]->name, begin_ms, done_ms,
+                (failed & mask) ? " failed" : "");
+        }
+
+        xSerialPutStringPolicy(line, eSerialBlock, BRINGUP_BLOCK_TIME);
+    }
+}
@@ -0,0 +1,96 @@
+/*! ***************************************************************************
+ *
+ * \brief     Device bring-up with dependencies and settle times
+ * \file      bringup.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef BRINGUP_H
+#define BRINGUP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// \name Definitions for the device bring-up
+/// \{
+
+/*!
+ * \brief Bit of a device in the masks of the bring-up functions
+ */
+#define BRINGUP_MASK(dev)   (1UL << (dev))
+
+/*!
+ * \brief Declares the bring-up of a device
+ *
+ * Example, a display that needs 200 ms to get out of reset after power up,
+ * and a receiver that sets the RTC:
+ *
+ *     static const bringup_step_t oled_step =
+ *         BRINGUP_STEP("Oled", BRINGUP_OLED, 0, 200);
+ *     static const bringup_step_t dcf77_step =
+ *         BRINGUP_STEP("DCF77", BRINGUP_DCF77, BRINGUP_MASK(BRINGUP_RTC), 0);
+ */
+#define BRINGUP_STEP(name, dev, deps, settle_ms) \
+    {(name), (dev), (deps), (settle_ms)}
+
+/// \}
+
+/// Devices that are brought up, in the order of the report
+typedef enum
+{
+    BRINGUP_SERIAL,     ///< The serial port
+    BRINGUP_RTC,        ///< The RTC and the time of day
+    BRINGUP_DCF77,      ///< The DCF77 receiver, sets the RTC
+    BRINGUP_OLED,       ///< The Oled display
+    BRINGUP_MMA8451,    ///< The accelerometer
+    BRINGUP_DEVICES
+}
+bringup_dev_t;
+
+/// Bring-up of a device, declared by its driver with BRINGUP_STEP()
+typedef struct
+{
+    const char *name;       ///< Name for reports
+    bringup_dev_t dev;      ///< The device
+    uint32_t deps;          ///< BRINGUP_MASK() of the devices it needs
+    uint32_t settle_ms;     ///< Time after the start of the scheduler before
+                            ///< the device may be initialised, the power-up
+                            ///< or reset time of the device
+}
+bringup_step_t;
+
+// Function prototypes
+void bringup_init(const uint32_t devices);
+bool bringup_begin(const bringup_step_t *step, const TickType_t timeout);
+void bringup_done(const bringup_step_t *step, const bool ok);
+bool bringup_ok(const uint32_t devices);
+bool bringup_wait(const uint32_t devices, const TickType_t timeout);
+void bringup_report(void);
+
+#endif // BRINGUP_H
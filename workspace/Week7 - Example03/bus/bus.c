@@ -0,0 +1,212 @@
+/*! ***************************************************************************
+ *
+ * \brief     Publish-subscribe bus for messages on static topics
+ * \file      bus.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "bus.h"
+
+/*
+ * The subscribers of a topic are fixed at compile time by BUS_TOPIC(). A
+ * message is allocated once with msg_alloc() and bus_publish() gives every
+ * subscriber a reference, stored in the small ring of pending messages of
+ * the subscriber. Publishing never blocks and never allocates: the time it
+ * takes is bounded by the number of subscribers of the topic. The subscriber
+ * is then woken by a bit in its task notification at BUS_NOTIFY_INDEX, or by
+ * its notify function, e.g. to signal a mux.
+ */
+
+/*!
+ * \brief Sets the task that is notified for a subscriber
+ *
+ * The task waits with bus_wait() and calls bus_receive() for every
+ * subscriber whose bits are returned. A task can own several subscribers
+ * with different bits.
+ *
+ * \param[in,out]  sub   Subscriber
+ * \param[in]      task  Task to notify
+ * \param[in]      bits  Bits to set in the notification of the task
+ */
+void bus_attach(bus_sub_t *sub, TaskHandle_t task, const uint32_t bits)
+{
+    taskENTER_CRITICAL();
+    {
+        sub->notify = NULL;
+        sub->arg = NULL;
+        sub->bits = bits;
+        sub->task = task;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Sets a function that is called for a subscriber
+ *
+ * Used for subscribers that are not woken by a task notification, e.g. a
+ * task that blocks on a mux or a protothread job.
+ *
+ * \param[in,out]  sub     Subscriber
+ * \param[in]      notify  Function called after a message was added
+ * \param[in]      arg     Argument for the function, see bus_sub_t
+ */
+void bus_attach_notify(bus_sub_t *sub, bus_notify_t notify, void *arg)
+{
+    taskENTER_CRITICAL();
+    {
+        sub->task = NULL;
+        sub->bits = 0;
+        sub->arg = arg;
+        sub->notify = notify;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Adds a reference to a message to the pending messages
+ *
+ * \return True if there was room
+ */
+static bool bus_put(bus_sub_t *sub, void *msg)
+{
+    bool put = false;
+
+    taskENTER_CRITICAL();
+    {
+        if(sub->count < BUS_DEPTH)
+        {
+            sub->pending[(sub->head + sub->count) % BUS_DEPTH] = msg;
+            sub->count++;
+            put = true;
+        }
+        else
+        {
+            sub->drops++;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return put;
+}
+
+/*!
+ * \brief Publishes a message to all subscribers of a topic
+ *
+ * Takes over the reference of the caller, like msg_publish(): every
+ * subscriber that had room holds a reference afterwards and the caller
+ * holds none. If no subscriber had room, the message is freed. Never blocks,
+ * must be called from a task.
+ *
+ * \param[in,out]  topic  Topic defined with BUS_TOPIC()
+ * \param[in]      msg    Payload allocated with msg_alloc()
+ *
+ * \return Number of subscribers that received the message
+ */
+uint32_t bus_publish(bus_topic_t *topic, void *msg)
+{
+    uint32_t sent = 0;
+
+    // One reference per subscriber, the reference of the caller is released
+    // below, so a fast subscriber cannot free the message too soon
+    msg_ref(msg, topic->n);
+
+    topic->published++;
+
+    for(uint32_t i=0; i<topic->n; i++)
+    {
+        bus_sub_t *sub = topic->subs[i];
+
+        if(!bus_put(sub, msg))
+        {
+            msg_release(msg);
+            continue;
+        }
+
+        sent++;
+
+        if(sub->notify != NULL)
+        {
+            sub->notify(sub);
+        }
+        else if(sub->task != NULL)
+        {
+            (void)xTaskNotifyIndexed(sub->task, BUS_NOTIFY_INDEX, sub->bits,
+                eSetBits);
+        }
+    }
+
+    msg_release(msg);
+
+    return sent;
+}
+
+/*!
+ * \brief Takes the oldest pending message of a subscriber
+ *
+ * The caller then holds its reference and must release it with
+ * msg_release().
+ *
+ * \param[in,out]  sub  Subscriber
+ *
+ * \return The payload, or NULL if no message is pending
+ */
+void *bus_receive(bus_sub_t *sub)
+{
+    void *msg = NULL;
+
+    taskENTER_CRITICAL();
+    {
+        if(sub->count > 0)
+        {
+            msg = sub->pending[sub->head];
+            sub->head = (sub->head + 1) % BUS_DEPTH;
+            sub->count--;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return msg;
+}
+
+/*!
+ * \brief Waits until a subscriber of the calling task is notified
+ *
+ * The bits are cleared, so every returned subscriber must be drained with
+ * bus_receive() until it returns NULL.
+ *
+ * \param[in]  timeout  Maximum time to wait in ticks
+ *
+ * \return Bits of the notified subscribers, 0 on timeout
+ */
+uint32_t bus_wait(const TickType_t timeout)
+{
+    uint32_t bits = 0;
+
+    (void)xTaskNotifyWaitIndexed(BUS_NOTIFY_INDEX, 0, UINT32_MAX, &bits,
+        timeout);
+
+    return bits;
+}
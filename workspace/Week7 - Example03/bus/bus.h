@@ -0,0 +1,127 @@
+/*! ***************************************************************************
+ *
+ * \brief     Publish-subscribe bus for messages on static topics
+ * \file      bus.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef BUS_H
+#define BUS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "msg.h"
+
+/// \name Definitions for the bus
+/// \{
+
+/*!
+ * \brief Index of the task notification that signals a subscriber
+ */
+#define BUS_NOTIFY_INDEX (2)
+
+/*!
+ * \brief Number of messages a subscriber can hold before it receives them
+ *
+ * A message published to a full subscriber is dropped for that subscriber
+ * only, so a slow subscriber never delays the publisher or the others.
+ */
+#ifndef BUS_DEPTH
+#define BUS_DEPTH (4)
+#endif
+
+/*!
+ * \brief Defines a subscriber
+ *
+ * Example: static bus_sub_t xLogSub = BUS_SUB("Log");
+ */
+#define BUS_SUB(name_)  {.name = (name_)}
+
+/*!
+ * \brief Defines a topic with a fixed list of subscribers
+ *
+ * Example: static BUS_TOPIC(xSwTopic, &xShowSub, &xLogSub);
+ */
+#define BUS_TOPIC(var, ...)                                                   \
+    bus_topic_t var =                                                         \
+    {                                                                         \
+        .name = #var,                                                         \
+        .subs = (bus_sub_t *const []){__VA_ARGS__},                           \
+        .n = sizeof((bus_sub_t *const []){__VA_ARGS__}) / sizeof(bus_sub_t *),\
+    }
+
+/// \}
+
+struct bus_sub;
+
+/*!
+ * \brief Called by the publisher instead of a task notification
+ *
+ * Runs in the task that publishes and must not block.
+ *
+ * \param[in]  sub  Subscriber that received a message
+ */
+typedef void (*bus_notify_t)(struct bus_sub *sub);
+
+/// Subscriber, receives the messages of all topics that list it
+///
+/// Define with BUS_SUB(), set up with bus_attach() or bus_attach_notify().
+typedef struct bus_sub
+{
+    const char *name;           ///< Name for reports
+    TaskHandle_t task;          ///< Task notified with bits
+    uint32_t bits;              ///< Bits set in the notification of task
+    bus_notify_t notify;        ///< Called instead of notifying a task
+    void *arg;                  ///< Argument for notify
+    void *pending[BUS_DEPTH];   ///< Messages not received yet
+    uint32_t head;              ///< Index of the oldest pending message
+    uint32_t count;             ///< Number of pending messages
+    uint32_t drops;             ///< Messages dropped because it was full
+}
+bus_sub_t;
+
+/// Topic, define with BUS_TOPIC()
+typedef struct
+{
+    const char *name;           ///< Name for reports
+    bus_sub_t *const *subs;     ///< Subscribers
+    uint32_t n;                 ///< Number of subscribers
+    uint32_t published;         ///< Number of published messages
+}
+bus_topic_t;
+
+// Function prototypes
+void bus_attach(bus_sub_t *sub, TaskHandle_t task, const uint32_t bits);
+void bus_attach_notify(bus_sub_t *sub, bus_notify_t notify, void *arg);
+uint32_t bus_publish(bus_topic_t *topic, void *msg);
+void *bus_receive(bus_sub_t *sub);
+uint32_t bus_wait(const TickType_t timeout);
+
+#endif // BUS_H
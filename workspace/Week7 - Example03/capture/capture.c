@@ -0,0 +1,404 @@
+/*! ***************************************************************************
+ *
+ * \brief     TPM input capture with DMA edge timestamps
+ * \file      capture.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "capture.h"
+
+#include "clock.h"
+#include "dma.h"
+#include "gpio.h"
+#include "irq_prio.h"
+#include "mono.h"
+#include "sections.h"
+
+/*
+ * Every captured edge raises a DMA request instead of an interrupt. DMA
+ * copies the 16-bit counter value of the edge into a ring and the hardware
+ * clears the channel flag, so an edge costs a few bus cycles and there is
+ * one interrupt per CAP_WINDOW edges. The ring is the modulo of the DMA
+ * destination address, so the interrupt only reloads the byte count and
+ * the timestamps of consecutive windows are contiguous.
+ *
+ * The TPM0 counter is shared with the PWM of rgb.c and the DCF77 capture
+ * and wraps at 0x10000 clocks of the peripheral clock, 1.365 ms in CLK_RUN.
+ * The differences of the timestamps are taken modulo 0x10000, so two
+ * consecutive edges must be less than a wrap apart. A longer interval is
+ * detected by comparing a window with the time between the interrupts of
+ * its window and the one before, with a tolerance of half a wrap. Slower
+ * signals such as the DCF77 receiver keep an interrupt per edge.
+ *
+ * A window in which the clock mode was changed is measured in the clocks of
+ * the new mode.
+ */
+
+// Windows in the ring
+#define CAP_WINDOWS (CAP_RING_SIZE / CAP_WINDOW)
+
+#if (CAP_RING_SIZE != 8) && (CAP_RING_SIZE != 16) && (CAP_RING_SIZE != 32) && \
+    (CAP_RING_SIZE != 64) && (CAP_RING_SIZE != 128)
+#error "CAP_RING_SIZE must be 8, 16, 32, 64 or 128"
+#endif
+
+#if ((CAP_WINDOW % 2) != 0) || ((CAP_RING_SIZE % CAP_WINDOW) != 0) || \
+    (CAP_WINDOWS < 4)
+#error "CAP_WINDOW must be even and at most a quarter of CAP_RING_SIZE"
+#endif
+
+#define CAP_PIN_MASK (1UL << CAP_PIN)
+
+// Timestamps written by DMA, aligned to the DMA modulo
+static uint16_t ring[CAP_RING_SIZE] __DMA_RING(CAP_RING_SIZE * sizeof(uint16_t));
+
+// Number of completed windows and mono_us32() at the interrupt of each
+// window in the ring
+static volatile uint32_t windows = 0;
+static volatile uint32_t window_us[CAP_WINDOWS];
+
+// Next window expected by cap_wait()
+static uint32_t taken = 0;
+
+static cap_edge_t mode = CAP_BOTH;
+
+// Polarity of the first edge in CAP_BOTH
+static bool first_rising;
+
+// Task notified by the DMA interrupt
+static TaskHandle_t cap_task = NULL;
+
+// Claimed DMA channel, -1 while stopped
+static int32_t dma_ch = -1;
+
+static void cap_dma_isr(void *arg, const uint32_t status, BaseType_t *woken);
+
+// Number of windows that were completed before the previous one was taken
+// by cap_wait()
+uint32_t cap_overruns = 0;
+
+/*!
+ * \brief Initializes the capture input
+ *
+ * The pin is muxed to TPM0 channel CAP_CHANNEL and the TPM0 counter is
+ * started if rgb.c or dcf77.c did not start it yet. Nothing is captured
+ * until cap_start().
+ */
+void cap_init(void)
+{
+    // Enable clock to PORTD and TPM0
+    SIM->SCGC5 |= SIM_SCGC5_PORTD(1);
+    clk_gate_acquire(CLK_GATE_TPM0);
+
+    // PTD0 : TPM0_CH0
+    CAP_PORT->PCR[CAP_PIN] = PORT_PCR_MUX(CAP_MUX);
+    gpio_input(CAP_GPIO, CAP_PIN_MASK);
+
+    // Shared free running counter, also started by rgb_init()
+    if((TPM0->SC & TPM_SC_CMOD_MASK) == 0)
+    {
+        TPM0->MOD = 0xFFFF;
+        TPM0->SC = TPM_SC_CMOD(1);
+    }
+
+    TPM0->CONTROLS[CAP_CHANNEL].CnSC = 0;
+}
+
+/*!
+ * \brief Starts timestamping edges
+ *
+ * DMA channel CAP_DMA_CHANNEL stores the timestamps of \p edge edges in the
+ * ring. When a window of CAP_WINDOW edges is complete, \p task is notified
+ * on index CAP_NOTIFY_INDEX and takes the measurement with cap_wait().
+ *
+ * \param[in]  edge  Edges to timestamp, CAP_BOTH for the duty cycle
+ * \param[in]  task  Task that calls cap_wait()
+ *
+ * \return False if no DMA channel is free
+ */
+bool cap_start(const cap_edge_t edge, TaskHandle_t task)
+{
+    if(dma_ch >= 0)
+    {
+        cap_stop();
+    }
+
+    const int32_t ch = dma_claim(CAP_DMA_CHANNEL, cap_dma_isr, NULL);
+
+    if(ch < 0)
+    {
+        return false;
+    }
+
+    dma_ch = ch;
+
+    cap_task = task;
+    mode = edge;
+    windows = 0;
+    taken = 0;
+    cap_overruns = 0;
+
+    // ------------------------------------------------------------------------
+
+    // Route the request of the channel to the DMA channel
+    dma_route(ch, (dma_source_t)(DMA_SOURCE_TPM0_CH0 + CAP_CHANNEL), false);
+
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    DMA0->DMA[ch].SAR = (uint32_t)&TPM0->CONTROLS[CAP_CHANNEL].CnV;
+    DMA0->DMA[ch].DAR = (uint32_t)ring;
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_BCR(CAP_WINDOW * sizeof(uint16_t));
+
+    // 16-bit transfers, one per request, incrementing destination that
+    // wraps at the size of the ring, interrupt when a window is complete.
+    // ERQ is cleared by hardware when BCR reaches zero.
+    DMA0->DMA[ch].DCR = DMA_DCR_EINT_MASK |
+                        DMA_DCR_ERQ_MASK |
+                        DMA_DCR_CS_MASK |
+                        DMA_DCR_DINC_MASK |
+                        DMA_DCR_SSIZE(2) |
+                        DMA_DCR_DSIZE(2) |
+                        DMA_DCR_DMOD(dma_mod(sizeof(ring))) |
+                        DMA_DCR_D_REQ_MASK;
+
+    dma_irq_enable(ch, IRQ_PRIO(CAPTURE_DMA));
+
+    // ------------------------------------------------------------------------
+
+    uint32_t elsx;
+
+    switch(edge)
+    {
+    case CAP_RISING:
+        elsx = TPM_CnSC_ELSA(1);
+        break;
+    case CAP_FALLING:
+        elsx = TPM_CnSC_ELSB(1);
+        break;
+    default:
+        elsx = TPM_CnSC_ELSA(1) | TPM_CnSC_ELSB(1);
+        break;
+    }
+
+    // - CHIE = 1 and DMA = 1 : DMA request on a capture, no interrupt
+    // The level of the pin just before the capture is enabled gives the
+    // polarity of the first edge
+    taskENTER_CRITICAL();
+    {
+        first_rising = !gpio_read(CAP_GPIO, CAP_PIN_MASK);
+
+        TPM0->CONTROLS[CAP_CHANNEL].CnSC = TPM_CnSC_CHF_MASK |
+                                           TPM_CnSC_CHIE_MASK |
+                                           TPM_CnSC_DMA_MASK |
+                                           elsx;
+    }
+    taskEXIT_CRITICAL();
+
+    return true;
+}
+
+/*!
+ * \brief Stops timestamping edges
+ */
+void cap_stop(void)
+{
+    if(dma_ch < 0)
+    {
+        return;
+    }
+
+    TPM0->CONTROLS[CAP_CHANNEL].CnSC = 0;
+
+    dma_release(dma_ch);
+    dma_ch = -1;
+
+    // A pending notification is left, the index may be shared with the
+    // serial driver or the console of the task
+    cap_task = NULL;
+}
+
+/*!
+ * \brief Measures a window
+ *
+ * The intervals of window w are those from the last edge of window w-1 to
+ * the last edge of window w. Window 0 has one interval less and in
+ * CAP_BOTH starts at its second edge, so it holds whole periods.
+ */
+static void cap_measure(const uint32_t w, cap_result_t *r)
+{
+    const uint32_t last = ((w + 1) * CAP_WINDOW) - 1;
+    uint32_t first = (w == 0) ? 0 : (last - CAP_WINDOW);
+
+    if((mode == CAP_BOTH) && (((last - first) & 1) != 0))
+    {
+        first++;
+    }
+
+    const uint32_t step = (mode == CAP_BOTH) ? 2 : 1;
+
+    uint32_t sum = 0;
+    uint32_t high = 0;
+    uint32_t min = UINT32_MAX;
+    uint32_t max = 0;
+
+    for(uint32_t i=first; i<last; i+=step)
+    {
+        const uint16_t t0 = ring[i % CAP_RING_SIZE];
+        const uint16_t t1 = ring[(i + 1) % CAP_RING_SIZE];
+        uint32_t period = (uint16_t)(t1 - t0);
+
+        if(mode == CAP_BOTH)
+        {
+            const uint16_t t2 = ring[(i + 2) % CAP_RING_SIZE];
+            const uint32_t second = (uint16_t)(t2 - t1);
+
+            // Edges alternate, i is even relative to the first edge
+            high += (first_rising == ((i & 1) == 0)) ? period : second;
+            period += second;
+        }
+
+        sum += period;
+        min = (period < min) ? period : min;
+        max = (period > max) ? period : max;
+    }
+
+    const uint32_t hz = clk_periph_hz();
+
+    r->window = w;
+    r->periods = (last - first) / step;
+    r->period_ticks = (sum + (r->periods / 2)) / r->periods;
+    r->min_ticks = min;
+    r->max_ticks = max;
+    r->freq_mhz = 0;
+    r->duty_permille = 0;
+    r->valid = false;
+
+    if(sum == 0)
+    {
+        return;
+    }
+
+    r->freq_mhz = (uint32_t)(((uint64_t)hz * 1000 * r->periods) / sum);
+
+    if(mode == CAP_BOTH)
+    {
+        r->duty_permille = (uint32_t)(((uint64_t)high * 1000) / sum);
+    }
+
+    // Window 0 has no interrupt before it to check against
+    if(w == 0)
+    {
+        return;
+    }
+
+    const uint32_t elapsed_us = window_us[w % CAP_WINDOWS] -
+        window_us[(w - 1) % CAP_WINDOWS];
+    const uint32_t sum_us = (uint32_t)(((uint64_t)sum * 1000000) / hz);
+    const uint32_t wrap_us = (uint32_t)((0x10000ULL * 1000000) / hz);
+
+    r->valid = (elapsed_us < (sum_us + (wrap_us / 2)));
+}
+
+/*!
+ * \brief Waits for the next window and measures it
+ *
+ * If the task falls behind, the newest window is measured and cap_overruns
+ * is incremented by the windows that were skipped. The result is not valid
+ * if an interval exceeded the counter wrap, if the window is window 0,
+ * which cannot be checked, or if DMA overwrote it while it was measured.
+ *
+ * \param[out] result   Measurement of the window
+ * \param[in]  timeout  Maximum time to wait in ticks
+ *
+ * \return False on timeout or if the notification was not for a window
+ */
+bool cap_wait(cap_result_t *result, const TickType_t timeout)
+{
+    if(ulTaskNotifyTakeIndexed(CAP_NOTIFY_INDEX, pdTRUE, timeout) == 0)
+    {
+        return false;
+    }
+
+    const uint32_t done = windows;
+
+    if(done == 0)
+    {
+        return false;
+    }
+
+    const uint32_t w = done - 1;
+
+    cap_overruns += w - taken;
+    taken = done;
+
+    cap_measure(w, result);
+
+    // The last edge of window w-1 is overwritten by window w-1+CAP_WINDOWS
+    if((windows - w) >= (CAP_WINDOWS - 1))
+    {
+        result->valid = false;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Converts TPM0 clocks of the current clock mode to nanoseconds
+ */
+uint32_t cap_ticks_to_ns(const uint32_t ticks)
+{
+    return (uint32_t)(((uint64_t)ticks * 1000000000) / clk_periph_hz());
+}
+
+/*!
+ * \brief DMA interrupt at the end of every window
+ *
+ * The destination address already wrapped in the ring, only the byte count
+ * is reloaded. An edge during this handler is transferred when ERQ is set
+ * again, the channel flag stays set until then.
+ */
+static void cap_dma_isr(void *arg, const uint32_t status, BaseType_t *woken)
+{
+    const int32_t ch = dma_ch;
+
+    (void)arg;
+    (void)status;
+
+    // Clear the done and error flags
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_BCR(CAP_WINDOW * sizeof(uint16_t));
+    DMA0->DMA[ch].DCR |= DMA_DCR_ERQ_MASK;
+
+    const uint32_t w = windows;
+
+    window_us[w % CAP_WINDOWS] = mono_us32();
+    windows = w + 1;
+
+    if(cap_task != NULL)
+    {
+        vTaskNotifyGiveIndexedFromISR(cap_task, CAP_NOTIFY_INDEX, woken);
+    }
+}
@@ -0,0 +1,141 @@
+/*! ***************************************************************************
+ *
+ * \brief     TPM input capture with DMA edge timestamps
+ * \file      capture.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <MKL25Z4.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*!
+ * \brief TPM0 channel of the capture input
+ *
+ * Channel 1 and 2 are the PWM of the blue LED and the LCD backlight, channel
+ * 3 the DCF77 receiver.
+ */
+#ifndef CAP_CHANNEL
+#define CAP_CHANNEL (0)
+#endif
+
+/*!
+ * \brief Pin of the capture input, PTD0 with TPM0_CH0 on ALT4
+ */
+#ifndef CAP_PIN
+#define CAP_PIN (0)
+#endif
+
+#ifndef CAP_PORT
+#define CAP_PORT (PORTD)
+#endif
+
+#ifndef CAP_GPIO
+#define CAP_GPIO (GPIO_D)
+#endif
+
+#ifndef CAP_MUX
+#define CAP_MUX (4)
+#endif
+
+/*!
+ * \brief DMA channel used for the timestamps
+ *
+ * Claimed from the DMA manager by cap_start(), DMA_ANY for the highest free
+ * channel.
+ */
+#ifndef CAP_DMA_CHANNEL
+#define CAP_DMA_CHANNEL (DMA_ANY)
+#endif
+
+/*!
+ * \brief Number of edges per window, there is one DMA interrupt per window.
+ *        Must be even and at most a quarter of CAP_RING_SIZE.
+ */
+#ifndef CAP_WINDOW
+#define CAP_WINDOW (16)
+#endif
+
+/*!
+ * \brief Number of timestamps in the ring, 8, 16, 32, 64 or 128
+ *
+ * The ring is the modulo of the DMA destination, so its size in bytes is a
+ * power of two from 16 to 256. The consumer has CAP_RING_SIZE / CAP_WINDOW
+ * - 2 windows of time to measure a window before it is overwritten.
+ */
+#ifndef CAP_RING_SIZE
+#define CAP_RING_SIZE (64)
+#endif
+
+/*!
+ * \brief Task notification index used to signal a completed window
+ */
+#ifndef CAP_NOTIFY_INDEX
+#define CAP_NOTIFY_INDEX (0)
+#endif
+
+/*!
+ * \brief Edges that are timestamped
+ */
+typedef enum
+{
+    CAP_RISING,  ///< Rising edges, period and frequency
+    CAP_FALLING, ///< Falling edges, period and frequency
+    CAP_BOTH,    ///< Both edges, also the duty cycle
+}cap_edge_t;
+
+/*!
+ * \brief Measurement over one window
+ *
+ * The times are in TPM0 clocks, the peripheral clock of the clock mode.
+ */
+typedef struct
+{
+    uint32_t window;        ///< Number of the window since cap_start()
+    uint32_t periods;       ///< Number of signal periods measured
+    uint32_t period_ticks;  ///< Mean period
+    uint32_t min_ticks;     ///< Shortest period
+    uint32_t max_ticks;     ///< Longest period
+    uint32_t freq_mhz;      ///< Frequency in mHz
+    uint32_t duty_permille; ///< High time per period in 0.1 %, CAP_BOTH only
+    bool valid;             ///< False if an edge interval exceeded the counter
+}cap_result_t;
+
+extern uint32_t cap_overruns;
+
+// Function prototypes
+void cap_init(void);
+bool cap_start(const cap_edge_t edge, TaskHandle_t task);
+void cap_stop(void);
+bool cap_wait(cap_result_t *result, const TickType_t timeout);
+uint32_t cap_ticks_to_ns(const uint32_t ticks);
+void cap_report(const cap_edge_t edge);
+
+#endif // CAPTURE_H
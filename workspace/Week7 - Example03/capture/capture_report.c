@@ -0,0 +1,111 @@
+/*! ***************************************************************************
+ *
+ * \brief     Report of the TPM input capture
+ * \file      capture_report.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "capture.h"
+
+#include "serial.h"
+#include "xprintf.h"
+
+/*
+ * Only uses the API of capture.h, so the report also runs on the simulated
+ * capture of the host build.
+ */
+
+#define CAP_LINE_LEN    (80)
+
+#define CAP_BLOCK_TIME  pdMS_TO_TICKS(100)
+
+// Timeout of cap_report() for the first checked window
+#define CAP_REPORT_TIMEOUT pdMS_TO_TICKS(500)
+
+/*!
+ * \brief Measures the signal on the capture input and sends the result to
+ *        the serial port
+ *
+ * Blocks the calling task until the first checked window, at most
+ * CAP_REPORT_TIMEOUT. Other notifications on index CAP_NOTIFY_INDEX are
+ * taken meanwhile, their waits must recheck their condition.
+ *
+ * \param[in]  edge  Edges to timestamp
+ */
+void cap_report(const cap_edge_t edge)
+{
+    char line[CAP_LINE_LEN];
+    cap_result_t r = {0};
+    bool measured = false;
+
+    if(!cap_start(edge, xTaskGetCurrentTaskHandle()))
+    {
+        xSerialPutStringPolicy("\r\nCapture: no DMA channel\r\n", eSerialBlock,
+            CAP_BLOCK_TIME);
+        return;
+    }
+
+    const TickType_t start = xTaskGetTickCount();
+
+    while((xTaskGetTickCount() - start) < CAP_REPORT_TIMEOUT)
+    {
+        if(cap_wait(&r, CAP_REPORT_TIMEOUT - (xTaskGetTickCount() - start)) &&
+           (r.window > 0))
+        {
+            measured = true;
+            break;
+        }
+    }
+
+    cap_stop();
+
+    if(!measured)
+    {
+        xSerialPutStringPolicy("\r\nCapture: no signal\r\n", eSerialBlock,
+            CAP_BLOCK_TIME);
+        return;
+    }
+
+    xsnprintf(line, CAP_LINE_LEN, "\r\nCapture %lu.%03lu Hz, period %lu ns "
+        "(%lu..%lu)", (unsigned long)(r.freq_mhz / 1000),
+        (unsigned long)(r.freq_mhz % 1000),
+        (unsigned long)cap_ticks_to_ns(r.period_ticks),
+        (unsigned long)cap_ticks_to_ns(r.min_ticks),
+        (unsigned long)cap_ticks_to_ns(r.max_ticks));
+    xSerialPutStringPolicy(line, eSerialBlock, CAP_BLOCK_TIME);
+
+    if(edge == CAP_BOTH)
+    {
+        xsnprintf(line, CAP_LINE_LEN, ", duty %lu.%lu %%",
+            (unsigned long)(r.duty_permille / 10),
+            (unsigned long)(r.duty_permille % 10));
+        xSerialPutStringPolicy(line, eSerialBlock, CAP_BLOCK_TIME);
+    }
+
+    xsnprintf(line, CAP_LINE_LEN, "%s\r\n",
+        r.valid ? "" : ", interval beyond the counter wrap");
+    xSerialPutStringPolicy(line, eSerialBlock, CAP_BLOCK_TIME);
+}
@@ -0,0 +1,448 @@
+/*! ***************************************************************************
+ *
+ * \brief     Clock mode manager
+ * \file      clock.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "clock.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if !defined(CLOCK_SETUP) || (CLOCK_SETUP != 1)
+#error "The clock manager starts in the PEE mode of CLOCK_SETUP 1"
+#endif
+
+// Restarts SysTick of the port at the new core clock
+extern void vPortSetupTimerInterrupt(void);
+
+// SOPT2 fields that select the peripheral clock
+#define CLK_SOPT2_MASK (SIM_SOPT2_TPMSRC_MASK | SIM_SOPT2_UART0SRC_MASK | \
+                        SIM_SOPT2_PLLFLLSEL_MASK)
+
+/*!
+ * \brief Clocks and dividers of a clock mode
+ */
+typedef struct
+{
+    const char *name;
+    uint32_t core_hz;
+    uint32_t bus_hz;
+    uint32_t periph_hz;
+    uint32_t clkdiv1;
+    uint32_t sopt2;
+}clk_config_t;
+
+static const clk_config_t config[CLK_N_MODES] =
+{
+    // MCGPLLCLK 96 MHz, core / 2, bus / 4, MCGPLLCLK/2 for TPM and UART0
+    [CLK_RUN] = {"RUN", 48000000UL, 24000000UL, 48000000UL,
+                 SIM_CLKDIV1_OUTDIV1(1) | SIM_CLKDIV1_OUTDIV4(1),
+                 SIM_SOPT2_TPMSRC(1) | SIM_SOPT2_UART0SRC(1) | SIM_SOPT2_PLLFLLSEL_MASK},
+
+    // MCGFLLCLK 640 x 31.25 kHz, undivided, MCGFLLCLK for TPM and UART0
+    [CLK_FLL] = {"FLL", 20000000UL, 20000000UL, 20000000UL,
+                 SIM_CLKDIV1_OUTDIV1(0) | SIM_CLKDIV1_OUTDIV4(0),
+                 SIM_SOPT2_TPMSRC(1) | SIM_SOPT2_UART0SRC(1)},
+
+    // 8 MHz crystal, core / 2, bus / 8, OSCERCLK for TPM and UART0
+    [CLK_VLPR] = {"VLPR", 4000000UL, 1000000UL, 8000000UL,
+                  SIM_CLKDIV1_OUTDIV1(1) | SIM_CLKDIV1_OUTDIV4(3),
+                  SIM_SOPT2_TPMSRC(2) | SIM_SOPT2_UART0SRC(2)},
+};
+
+/*!
+ * \brief Register and mask of a clock gate
+ */
+typedef struct
+{
+    const char *name;
+    uint8_t scgc;  ///< SIM_SCGC4 to SIM_SCGC7
+    uint32_t mask;
+}clk_gate_config_t;
+
+static const clk_gate_config_t gates[CLK_GATES] =
+{
+    [CLK_GATE_I2C0]   = {"I2C0",   4, SIM_SCGC4_I2C0_MASK},
+    [CLK_GATE_I2C1]   = {"I2C1",   4, SIM_SCGC4_I2C1_MASK},
+    [CLK_GATE_UART0]  = {"UART0",  4, SIM_SCGC4_UART0_MASK},
+    [CLK_GATE_UART1]  = {"UART1",  4, SIM_SCGC4_UART1_MASK},
+    [CLK_GATE_UART2]  = {"UART2",  4, SIM_SCGC4_UART2_MASK},
+    [CLK_GATE_USBOTG] = {"USBOTG", 4, SIM_SCGC4_USBOTG_MASK},
+    [CLK_GATE_SPI0]   = {"SPI0",   4, SIM_SCGC4_SPI0_MASK},
+    [CLK_GATE_SPI1]   = {"SPI1",   4, SIM_SCGC4_SPI1_MASK},
+    [CLK_GATE_LPTMR]  = {"LPTMR",  5, SIM_SCGC5_LPTMR_MASK},
+    [CLK_GATE_DMAMUX] = {"DMAMUX", 6, SIM_SCGC6_DMAMUX_MASK},
+    [CLK_GATE_PIT]    = {"PIT",    6, SIM_SCGC6_PIT_MASK},
+    [CLK_GATE_TPM0]   = {"TPM0",   6, SIM_SCGC6_TPM0_MASK},
+    [CLK_GATE_TPM1]   = {"TPM1",   6, SIM_SCGC6_TPM1_MASK},
+    [CLK_GATE_TPM2]   = {"TPM2",   6, SIM_SCGC6_TPM2_MASK},
+    [CLK_GATE_ADC0]   = {"ADC0",   6, SIM_SCGC6_ADC0_MASK},
+    [CLK_GATE_RTC]    = {"RTC",    6, SIM_SCGC6_RTC_MASK},
+    [CLK_GATE_DAC0]   = {"DAC0",   6, SIM_SCGC6_DAC0_MASK},
+    [CLK_GATE_DMA]    = {"DMA",    7, SIM_SCGC7_DMA_MASK},
+};
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+
+// SystemInit() starts in PEE mode
+static clk_mode_t mode = CLK_RUN;
+
+// Registered drivers
+static clk_notifier_t *notifiers = NULL;
+
+// Number of drivers that use a clock gate
+static uint8_t gate_users[CLK_GATES];
+
+/*!
+ * \brief Registers a driver for clock mode changes
+ *
+ * Registering a notifier again only updates the callback and argument.
+ * Call from a task or before the scheduler is started.
+ *
+ * \param[out] n         Notifier, must remain valid
+ * \param[in]  callback  Called before and after every clock mode change
+ * \param[in]  arg       Argument of the callback
+ */
+void clk_register(clk_notifier_t *n, clk_callback_t callback, void *arg)
+{
+    taskENTER_CRITICAL();
+    {
+        n->callback = callback;
+        n->arg = arg;
+
+        clk_notifier_t *p = notifiers;
+
+        while((p != NULL) && (p != n))
+        {
+            p = p->next;
+        }
+
+        if(p == NULL)
+        {
+            n->next = notifiers;
+            notifiers = n;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Calls all registered drivers
+ */
+static void clk_notify(const clk_event_t event)
+{
+    for(clk_notifier_t *n = notifiers; n != NULL; n = n->next)
+    {
+        n->callback(event, n->arg);
+    }
+}
+
+/*!
+ * \brief Switches the MCG from the current mode to FBE mode
+ *
+ * FBE runs the core from the 8 MHz crystal. All modes pass through it, the
+ * dividers and the peripheral clock are changed while in it.
+ */
+static void clk_leave(void)
+{
+    switch(mode)
+    {
+    case CLK_RUN:
+        // PEE to PBE
+        MCG->C1 = (MCG->C1 & ~MCG_C1_CLKS_MASK) | MCG_C1_CLKS(2);
+        while((MCG->S & MCG_S_CLKST_MASK) != MCG_S_CLKST(2))
+        {}
+
+        // PBE to FBE
+        MCG->C6 &= ~MCG_C6_PLLS_MASK;
+        while(MCG->S & MCG_S_PLLST_MASK)
+        {}
+        break;
+
+    case CLK_FLL:
+        // FEE to FBE
+        MCG->C1 = (MCG->C1 & ~MCG_C1_CLKS_MASK) | MCG_C1_CLKS(2);
+        while((MCG->S & MCG_S_CLKST_MASK) != MCG_S_CLKST(2))
+        {}
+        break;
+
+    case CLK_VLPR:
+    default:
+        // VLPR to RUN, the MCG mode can only be changed in RUN
+        SMC->PMCTRL &= ~SMC_PMCTRL_RUNM_MASK;
+        while(SMC->PMSTAT != SMC_PMSTAT_PMSTAT(1))
+        {}
+
+        // BLPE to FBE
+        MCG->C2 &= ~MCG_C2_LP_MASK;
+        break;
+    }
+}
+
+/*!
+ * \brief Switches the MCG from FBE mode to the mode of \p target
+ */
+static void clk_enter(const clk_mode_t target)
+{
+    switch(target)
+    {
+    case CLK_RUN:
+        // FBE to PBE, the PLL multiplies the 4 MHz reference of SystemInit()
+        // by 24
+        MCG->C6 |= MCG_C6_PLLS_MASK;
+        while(!(MCG->S & MCG_S_PLLST_MASK))
+        {}
+        while(!(MCG->S & MCG_S_LOCK0_MASK))
+        {}
+
+        // PBE to PEE
+        MCG->C1 &= ~MCG_C1_CLKS_MASK;
+        while((MCG->S & MCG_S_CLKST_MASK) != MCG_S_CLKST(3))
+        {}
+        break;
+
+    case CLK_FLL:
+        // FBE to FEE, the FLL is locked to the crystal / 256 already
+        MCG->C1 &= ~MCG_C1_CLKS_MASK;
+        while((MCG->S & MCG_S_CLKST_MASK) != MCG_S_CLKST(0))
+        {}
+        break;
+
+    case CLK_VLPR:
+    default:
+        // FBE to BLPE, the FLL and PLL are disabled
+        MCG->C2 |= MCG_C2_LP_MASK;
+
+        // RUN to VLPR, allowed by SMC->PMPROT of SystemInit()
+        SMC->PMCTRL = (SMC->PMCTRL & ~SMC_PMCTRL_RUNM_MASK) | SMC_PMCTRL_RUNM(2);
+        while(SMC->PMSTAT != SMC_PMSTAT_PMSTAT(4))
+        {}
+        break;
+    }
+}
+
+/*!
+ * \brief Switches to another clock mode
+ *
+ * The registered drivers are notified with CLK_PRE_CHANGE, the MCG is
+ * switched with interrupts disabled, SystemCoreClock is updated and SysTick
+ * is restarted at the new core clock, after which the drivers are notified
+ * with CLK_POST_CHANGE. Interrupts are disabled for up to 1 ms while the PLL
+ * locks, and a partial tick is lost.
+ *
+ * Call from a task or before the scheduler is started, not from an
+ * interrupt handler.
+ *
+ * \param[in]  target  New clock mode
+ *
+ * \return False if \p target is not a clock mode
+ */
+bool clk_set_mode(const clk_mode_t target)
+{
+    if(target >= CLK_N_MODES)
+    {
+        return false;
+    }
+
+    if(target == mode)
+    {
+        return true;
+    }
+
+    const bool running = (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED);
+
+    if(running)
+    {
+        vTaskSuspendAll();
+    }
+
+    clk_notify(CLK_PRE_CHANGE);
+
+    taskENTER_CRITICAL();
+    {
+        clk_leave();
+
+        SIM->CLKDIV1 = config[target].clkdiv1;
+        SIM->SOPT2 = (SIM->SOPT2 & ~CLK_SOPT2_MASK) | config[target].sopt2;
+
+        clk_enter(target);
+
+        mode = target;
+        SystemCoreClock = config[target].core_hz;
+
+        if(running)
+        {
+            vPortSetupTimerInterrupt();
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    clk_notify(CLK_POST_CHANGE);
+
+    if(running)
+    {
+        (void)xTaskResumeAll();
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Returns the current clock mode
+ */
+clk_mode_t clk_get_mode(void)
+{
+    return mode;
+}
+
+/*!
+ * \brief Returns the name of a clock mode
+ */
+const char *clk_mode_name(const clk_mode_t m)
+{
+    return (m < CLK_N_MODES) ? config[m].name : "?";
+}
+
+/*!
+ * \brief Returns the core clock in Hz
+ */
+uint32_t clk_core_hz(void)
+{
+    return config[mode].core_hz;
+}
+
+/*!
+ * \brief Returns the bus clock in Hz, the clock of the PIT, I2C, UART1 and
+ *        UART2
+ */
+uint32_t clk_bus_hz(void)
+{
+    return config[mode].bus_hz;
+}
+
+/*!
+ * \brief Returns the peripheral clock in Hz, the clock of the TPMs and UART0
+ */
+uint32_t clk_periph_hz(void)
+{
+    return config[mode].periph_hz;
+}
+
+/*!
+ * \brief Selects the peripheral clock of the current mode as TPM and UART0
+ *        clock
+ *
+ * clk_set_mode() does this for every mode change, a driver calls it once
+ * before it starts to use the peripheral clock.
+ */
+void clk_periph_select(void)
+{
+    SIM->SOPT2 = (SIM->SOPT2 & ~CLK_SOPT2_MASK) | config[mode].sopt2;
+}
+
+/*!
+ * \brief Returns the SIM_SCGCx register of a clock gate
+ */
+static inline volatile uint32_t *clk_gate_reg(const clk_gate_t gate)
+{
+    volatile uint32_t *scgc4 = &SIM->SCGC4;
+
+    return &scgc4[gates[gate].scgc - 4];
+}
+
+/*!
+ * \brief Switches the clock of a peripheral on for a driver
+ *
+ * The clock stays on until every driver that acquired it released it with
+ * clk_gate_release(). Also called from interrupt handlers.
+ *
+ * \param[in]  gate  Clock gate of the peripheral
+ */
+void clk_gate_acquire(const clk_gate_t gate)
+{
+    if(gate >= CLK_GATES)
+    {
+        return;
+    }
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if(gate_users[gate]++ == 0)
+    {
+        *clk_gate_reg(gate) |= gates[gate].mask;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/*!
+ * \brief Gives the clock of a peripheral back, the clock is switched off
+ *        when no driver uses it
+ *
+ * The driver leaves the peripheral idle: no interrupt or DMA request
+ * enabled and the counter or converter stopped. The registers keep their
+ * values while the clock is off, but must not be accessed. Also called from
+ * interrupt handlers.
+ *
+ * \param[in]  gate  Clock gate acquired with clk_gate_acquire()
+ */
+void clk_gate_release(const clk_gate_t gate)
+{
+    if(gate >= CLK_GATES)
+    {
+        return;
+    }
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if((gate_users[gate] > 0) && (--gate_users[gate] == 0))
+    {
+        *clk_gate_reg(gate) &= ~gates[gate].mask;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/*!
+ * \brief Returns the number of drivers that use a clock gate
+ */
+uint32_t clk_gate_users(const clk_gate_t gate)
+{
+    return (gate < CLK_GATES) ? gate_users[gate] : 0;
+}
+
+/*!
+ * \brief Returns the name of a clock gate
+ */
+const char *clk_gate_name(const clk_gate_t gate)
+{
+    return (gate < CLK_GATES) ? gates[gate].name : "?";
+}
@@ -0,0 +1,132 @@
+/*! ***************************************************************************
+ *
+ * \brief     Clock mode manager
+ * \file      clock.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <MKL25Z4.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// \name Definitions for the clock manager
+/// \{
+
+/*!
+ * \brief Clock modes
+ *
+ * All modes use the 8 MHz crystal of the FRDM-KL25Z, so the slow internal
+ * reference clock is left to the RTC on CLKOUT. The peripheral clock is the
+ * TPM and UART0 clock.
+ */
+typedef enum
+{
+    CLK_RUN = 0, ///< PEE: 48 MHz core, 24 MHz bus, 48 MHz peripheral clock
+    CLK_FLL,     ///< FEE: 20 MHz core, bus and peripheral clock
+    CLK_VLPR,    ///< BLPE in VLPR: 4 MHz core, 1 MHz bus, 8 MHz peripheral clock
+    CLK_N_MODES,
+}clk_mode_t;
+
+/// \}
+
+/// Moment of a clock mode change a driver is notified of
+typedef enum
+{
+    CLK_PRE_CHANGE,  ///< Before the clocks change, the driver goes idle
+    CLK_POST_CHANGE, ///< After the clocks changed, the driver reconfigures
+}clk_event_t;
+
+/*!
+ * \brief Called before and after a clock mode change
+ *
+ * Called by clk_set_mode() with the scheduler suspended and interrupts
+ * enabled, so it must not block. clk_bus_hz() and clk_periph_hz() return the
+ * old clocks for CLK_PRE_CHANGE and the new ones for CLK_POST_CHANGE.
+ *
+ * \param[in]  event  CLK_PRE_CHANGE or CLK_POST_CHANGE
+ * \param[in]  arg    Argument given to clk_register()
+ */
+typedef void (*clk_callback_t)(const clk_event_t event, void *arg);
+
+/*!
+ * \brief Registration of a driver, owned by the driver
+ */
+typedef struct clk_notifier
+{
+    clk_callback_t callback;
+    void *arg;
+    struct clk_notifier *next;
+}clk_notifier_t;
+
+/*!
+ * \brief Peripheral clock gates, switched by clk_gate_acquire() and
+ *        clk_gate_release()
+ *
+ * The port clocks stay on, so the pins keep their function and a released
+ * peripheral leaves its pins as they are.
+ */
+typedef enum
+{
+    CLK_GATE_I2C0,   ///< SCGC4
+    CLK_GATE_I2C1,
+    CLK_GATE_UART0,
+    CLK_GATE_UART1,
+    CLK_GATE_UART2,
+    CLK_GATE_USBOTG,
+    CLK_GATE_SPI0,
+    CLK_GATE_SPI1,
+    CLK_GATE_LPTMR,  ///< SCGC5
+    CLK_GATE_DMAMUX, ///< SCGC6
+    CLK_GATE_PIT,
+    CLK_GATE_TPM0,
+    CLK_GATE_TPM1,
+    CLK_GATE_TPM2,
+    CLK_GATE_ADC0,
+    CLK_GATE_RTC,
+    CLK_GATE_DAC0,
+    CLK_GATE_DMA,    ///< SCGC7
+    CLK_GATES,
+}clk_gate_t;
+
+void clk_register(clk_notifier_t *n, clk_callback_t callback, void *arg);
+bool clk_set_mode(const clk_mode_t mode);
+clk_mode_t clk_get_mode(void);
+const char *clk_mode_name(const clk_mode_t mode);
+uint32_t clk_core_hz(void);
+uint32_t clk_bus_hz(void);
+uint32_t clk_periph_hz(void);
+void clk_periph_select(void);
+
+void clk_gate_acquire(const clk_gate_t gate);
+void clk_gate_release(const clk_gate_t gate);
+uint32_t clk_gate_users(const clk_gate_t gate);
+const char *clk_gate_name(const clk_gate_t gate);
+
+#endif // CLOCK_H
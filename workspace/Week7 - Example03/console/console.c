@@ -0,0 +1,559 @@
+/*! ***************************************************************************
+ *
+ * \brief     Line editing command console
+ * \file      console.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <string.h>
+
+#include "console.h"
+#include "critmon.h"
+#include "taskstats.h"
+#include "task.h"
+#include "telemetry.h"
+#include "wcet.h"
+#include "work.h"
+#include "xprintf.h"
+
+/*
+ * The receive interrupt only submits console_deferred() to the WORK_LOW
+ * worker of work/work.c, see vSerialPortSetRxCallback(), which coalesces
+ * the submissions until it ran. The deferred handler
+ * reads the receive ring, as its single reader, and edits the line: it
+ * echoes printable characters, removes one with backspace or delete,
+ * recalls the history with the up and down arrow keys and clears the line
+ * with Ctrl+C. Enter hands the line to the console task, which is woken
+ * once per line instead of once per character.
+ *
+ * The console task splits the line into words and looks the first one up
+ * with a binary search, in the built-in commands first and then in the
+ * table of the application. Both tables are sorted by name with strcmp(),
+ * which console_init() checks.
+ *
+ * While the console task still runs a command, the deferred handler leaves
+ * the received characters in the receive ring, the console task pends it
+ * again when it took the line.
+ *
+ * The console reads the receive ring, so with serUSE_DMA_RX it receives
+ * nothing. The filter runs in the worker, its stack is WORK_STACK_DEPTH.
+ */
+
+#define CONSOLE_OUT_LEN     (64)
+
+#define CONSOLE_ESC         ('\x1B')
+#define CONSOLE_CTRL_C      ('\x03')
+
+// States of the escape sequence parser
+typedef enum
+{
+    ESC_NONE,
+    ESC_START,  ///< After ESC
+    ESC_CSI,    ///< After ESC [
+}
+console_esc_t;
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+static xComPortHandle console_port;
+static const console_cmd_t *app_commands;
+static uint32_t app_count;
+static console_filter_t console_filter;
+static TaskHandle_t console_task;
+
+// The line being edited, in the worker only
+static char line[CONSOLE_LINE_LEN + 1];
+static uint32_t len;
+static console_esc_t esc;
+static bool last_cr;
+
+// History, newest at history[(head - 1) % CONSOLE_HISTORY]. selected is the
+// entry shown, 1 is the newest, 0 is the line being edited.
+static char history[CONSOLE_HISTORY][CONSOLE_LINE_LEN + 1];
+static uint32_t head;
+static uint32_t count;
+static uint32_t selected;
+
+// A completed line, full until the console task copied it
+static char ready[CONSOLE_LINE_LEN + 1];
+static volatile bool ready_full;
+
+/*----------------------------------------------------------------------------*/
+// Local function prototypes
+/*----------------------------------------------------------------------------*/
+static void console_bench(const uint32_t argc, char *argv[]);
+static void console_help(const uint32_t argc, char *argv[]);
+static void console_stats(const uint32_t argc, char *argv[]);
+static void console_trace(const uint32_t argc, char *argv[]);
+static void console_deferred(void *arg);
+
+/*!
+ * \brief The built-in commands, sorted by name
+ */
+static const console_cmd_t builtin_commands[] =
+{
+    {"bench", console_bench, "[reset] job times and masked sections"},
+    {"help",  console_help,  "this list"},
+    {"stats", console_stats, "<l|r|i|s|h|q|p|w|k|x|g> task statistics"},
+    {"trace", console_trace, "send the trace ring as telemetry"},
+};
+
+#define BUILTIN_COUNT (sizeof(builtin_commands) / sizeof(builtin_commands[0]))
+
+// Submitted by the receive interrupt
+static work_t console_work = WORK_ITEM(console_deferred, NULL, WORK_LOW);
+
+/*----------------------------------------------------------------------------*/
+// Line editor, in the worker
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Writes to the port, dropped if a command keeps it busy for longer
+ *        than CONSOLE_ECHO_TIMEOUT_MS
+ */
+static void console_echo(const char *str)
+{
+    (void)xSerialPortPutStringPolicy(console_port, str, eSerialBlock,
+        pdMS_TO_TICKS(CONSOLE_ECHO_TIMEOUT_MS));
+}
+
+/*!
+ * \brief Replaces the line with a history entry, or an empty line
+ */
+static void console_recall(const uint32_t entry)
+{
+    selected = entry;
+
+    if(entry == 0)
+    {
+        len = 0;
+    }
+    else
+    {
+        const uint32_t i = (head + CONSOLE_HISTORY - entry) % CONSOLE_HISTORY;
+
+        len = strlen(history[i]);
+        (void)memcpy(line, history[i], len);
+    }
+
+    line[len] = '\0';
+
+    console_echo("\r\x1B[K" CONSOLE_PROMPT);
+    console_echo(line);
+}
+
+/*!
+ * \brief Adds the line to the history, unless it repeats the newest entry
+ */
+static void console_remember(void)
+{
+    const uint32_t newest = (head + CONSOLE_HISTORY - 1) % CONSOLE_HISTORY;
+
+    if((count > 0) && (strcmp(history[newest], line) == 0))
+    {
+        return;
+    }
+
+    (void)memcpy(history[head], line, len + 1);
+    head = (head + 1) % CONSOLE_HISTORY;
+
+    if(count < CONSOLE_HISTORY)
+    {
+        count++;
+    }
+}
+
+/*!
+ * \brief Hands the line to the console task
+ */
+static void console_submit(void)
+{
+    line[len] = '\0';
+    selected = 0;
+
+    console_echo("\r\n");
+
+    if(len == 0)
+    {
+        console_echo(CONSOLE_PROMPT);
+        return;
+    }
+
+    console_remember();
+
+    (void)memcpy(ready, line, len + 1);
+    ready_full = true;
+    len = 0;
+
+    (void)xTaskNotifyGiveIndexed(console_task, CONSOLE_NOTIFY_INDEX);
+}
+
+/*!
+ * \brief Edits the line with a received character
+ */
+static void console_char(const char c)
+{
+    const bool after_cr = last_cr;
+
+    last_cr = false;
+
+    if((console_filter != NULL) && console_filter(c))
+    {
+        return;
+    }
+
+    if(esc == ESC_START)
+    {
+        esc = (c == '[') ? ESC_CSI : ESC_NONE;
+        return;
+    }
+
+    if(esc == ESC_CSI)
+    {
+        if((c == 'A') && (selected < count))
+        {
+            console_recall(selected + 1);
+        }
+        else if((c == 'B') && (selected > 0))
+        {
+            console_recall(selected - 1);
+        }
+
+        // A final byte ends the sequence, parameters come before it
+        if((c >= 0x40) && (c <= 0x7E))
+        {
+            esc = ESC_NONE;
+        }
+
+        return;
+    }
+
+    switch(c)
+    {
+    case CONSOLE_ESC:
+        esc = ESC_START;
+        break;
+    case '\n':
+        // The second character of a CR LF line end
+        if(!after_cr)
+        {
+            console_submit();
+        }
+        break;
+    case '\r':
+        last_cr = true;
+        console_submit();
+        break;
+    case '\b':
+    case '\x7F':
+        if(len > 0)
+        {
+            len--;
+            console_echo("\b \b");
+        }
+        break;
+    case CONSOLE_CTRL_C:
+        len = 0;
+        selected = 0;
+        console_echo("^C\r\n" CONSOLE_PROMPT);
+        break;
+    default:
+        if((c >= ' ') && (c <= '~') && (len < CONSOLE_LINE_LEN))
+        {
+            const char str[2] = {c, '\0'};
+
+            line[len++] = c;
+            console_echo(str);
+        }
+        break;
+    }
+}
+
+/*!
+ * \brief Reads the receive ring and edits the line, in the worker
+ */
+static void console_deferred(void *arg)
+{
+    char c;
+
+    (void)arg;
+
+    // One character at a time, the rest waits in the ring while the console
+    // task has a line. A byte received after the read submits it again.
+    while(!ready_full && (xSerialPortRead(console_port, &c, 1, 0) == 1))
+    {
+        console_char(c);
+    }
+}
+
+/*!
+ * \brief Submits console_deferred(), from the receive interrupt
+ */
+static void console_rx_isr(void *arg, BaseType_t *woken)
+{
+    (void)arg;
+
+    (void)work_submit_from_isr(&console_work, woken);
+}
+
+/*----------------------------------------------------------------------------*/
+// Commands, in the console task
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Writes a line of the console task
+ */
+static void console_print(const char *str)
+{
+    (void)xSerialPortPutStringPolicy(console_port, str, eSerialBlock, portMAX_DELAY);
+}
+
+static void console_bench(const uint32_t argc, char *argv[])
+{
+    if((argc > 1) && (strcmp(argv[1], "reset") == 0))
+    {
+        wcet_reset();
+        critmon_reset();
+        console_print("job times and masked sections cleared\r\n");
+        return;
+    }
+
+    taskstats_wcet();
+    taskstats_critical();
+}
+
+static void console_help(const uint32_t argc, char *argv[])
+{
+    char out[CONSOLE_OUT_LEN];
+
+    (void)argc;
+    (void)argv;
+
+    for(uint32_t i=0; i<BUILTIN_COUNT; i++)
+    {
+        xsnprintf(out, sizeof(out), "%-8s %s\r\n", builtin_commands[i].name,
+            builtin_commands[i].help);
+        console_print(out);
+    }
+
+    for(uint32_t i=0; i<app_count; i++)
+    {
+        xsnprintf(out, sizeof(out), "%-8s %s\r\n", app_commands[i].name,
+            app_commands[i].help);
+        console_print(out);
+    }
+}
+
+static void console_stats(const uint32_t argc, char *argv[])
+{
+    if((argc < 2) || (argv[1][1] != '\0'))
+    {
+        console_print("usage: stats <l|r|i|s|h|q|p|w|k|x|g>\r\n");
+        return;
+    }
+
+    taskstats_command(argv[1][0]);
+}
+
+static void console_trace(const uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    if(!tlm_trace())
+    {
+        console_print("trace busy\r\n");
+    }
+}
+
+/*!
+ * \brief Looks a command up with a binary search
+ *
+ * \param[in]  table  Commands sorted by name
+ * \param[in]  n      Number of commands
+ * \param[in]  name   Command to find
+ *
+ * \return The command, NULL if not found
+ */
+static const console_cmd_t *console_find(const console_cmd_t *table,
+    const uint32_t n, const char *name)
+{
+    uint32_t lo = 0;
+    uint32_t hi = n;
+
+    while(lo < hi)
+    {
+        const uint32_t mid = (lo + hi) / 2;
+        const int cmp = strcmp(name, table[mid].name);
+
+        if(cmp == 0)
+        {
+            return &table[mid];
+        }
+
+        if(cmp < 0)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * \brief Splits a line into words at spaces, in place
+ *
+ * \return Number of words, at most CONSOLE_MAX_ARGS
+ */
+static uint32_t console_split(char *str, char *argv[])
+{
+    uint32_t argc = 0;
+
+    while(argc < CONSOLE_MAX_ARGS)
+    {
+        while(*str == ' ')
+        {
+            str++;
+        }
+
+        if(*str == '\0')
+        {
+            break;
+        }
+
+        argv[argc++] = str;
+
+        while((*str != ' ') && (*str != '\0'))
+        {
+            str++;
+        }
+
+        if(*str == ' ')
+        {
+            *str++ = '\0';
+        }
+    }
+
+    return argc;
+}
+
+/*----------------------------------------------------------------------------*/
+// Public functions
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Sets up the console
+ *
+ * \param[in]  port      Port of the console, read only by the console
+ * \param[in]  commands  Commands of the application, sorted by name, kept
+ *                       by reference
+ * \param[in]  n         Number of commands
+ * \param[in]  filter    Takes characters before the line editor, NULL for
+ *                       none
+ */
+void console_init(xComPortHandle port, const console_cmd_t *commands,
+    const uint32_t n, console_filter_t filter)
+{
+    for(uint32_t i=1; i<BUILTIN_COUNT; i++)
+    {
+        configASSERT(strcmp(builtin_commands[i - 1].name, builtin_commands[i].name) < 0);
+    }
+
+    for(uint32_t i=1; i<n; i++)
+    {
+        configASSERT(strcmp(commands[i - 1].name, commands[i].name) < 0);
+    }
+
+    console_port = port;
+    app_commands = commands;
+    app_count = n;
+    console_filter = filter;
+}
+
+/*!
+ * \brief Runs the commands of the lines entered, in the calling task
+ *
+ * Starts the line editor and does not return. The workers of work_init()
+ * must have been created.
+ */
+void console_run(void)
+{
+    char cmd[CONSOLE_LINE_LEN + 1];
+    char out[CONSOLE_OUT_LEN];
+    char *argv[CONSOLE_MAX_ARGS];
+
+    console_task = xTaskGetCurrentTaskHandle();
+
+    vSerialPortSetRxCallback(console_port, console_rx_isr, NULL);
+
+    // Bytes received before, the callback was not set yet
+    (void)work_submit(&console_work);
+
+    for( ;; )
+    {
+        console_print(CONSOLE_PROMPT);
+
+        while(!ready_full)
+        {
+            (void)ulTaskNotifyTakeIndexed(CONSOLE_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+        }
+
+        (void)memcpy(cmd, ready, sizeof(cmd));
+        ready_full = false;
+
+        // The characters received while the line waited
+        (void)work_submit(&console_work);
+
+        const uint32_t argc = console_split(cmd, argv);
+
+        if(argc == 0)
+        {
+            continue;
+        }
+
+        const console_cmd_t *c = console_find(builtin_commands, BUILTIN_COUNT, argv[0]);
+
+        if(c == NULL)
+        {
+            c = console_find(app_commands, app_count, argv[0]);
+        }
+
+        if(c != NULL)
+        {
+            c->handler(argc, argv);
+        }
+        else
+        {
+            xsnprintf(out, sizeof(out), "%s: unknown command, try help\r\n", argv[0]);
+            console_print(out);
+        }
+    }
+}
@@ -0,0 +1,124 @@
+/*! ***************************************************************************
+ *
+ * \brief     Line editing command console
+ * \file      console.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "serial.h"
+
+/// \name Definitions for the console
+/// \{
+
+/*!
+ * \brief Set to 1 to run the console in the command task of main() instead
+ *        of the single character commands, see the CONSOLE option in
+ *        CMakeLists.txt
+ */
+#ifndef CONSOLE_ENABLED
+#define CONSOLE_ENABLED         (0)
+#endif
+
+/*!
+ * \brief Characters of a command line, without the terminator
+ */
+#ifndef CONSOLE_LINE_LEN
+#define CONSOLE_LINE_LEN        (64)
+#endif
+
+/*!
+ * \brief Command lines kept for the up and down arrow keys
+ */
+#ifndef CONSOLE_HISTORY
+#define CONSOLE_HISTORY         (4)
+#endif
+
+/*!
+ * \brief Words of a command line, the command included
+ */
+#ifndef CONSOLE_MAX_ARGS
+#define CONSOLE_MAX_ARGS        (6)
+#endif
+
+/*!
+ * \brief Task notification index on which the console task waits for a
+ *        line, the index xSerialGetChar() waits on
+ */
+#ifndef CONSOLE_NOTIFY_INDEX
+#define CONSOLE_NOTIFY_INDEX    (0)
+#endif
+
+/*!
+ * \brief Time the echo waits for the port in ms, while a command writes
+ */
+#ifndef CONSOLE_ECHO_TIMEOUT_MS
+#define CONSOLE_ECHO_TIMEOUT_MS (20)
+#endif
+
+#ifndef CONSOLE_PROMPT
+#define CONSOLE_PROMPT          "> "
+#endif
+
+/// \}
+
+/*!
+ * \brief Runs a command
+ *
+ * \param[in]  argc  Number of words, the command included
+ * \param[in]  argv  The words, argv[0] is the command
+ */
+typedef void (*console_handler_t)(const uint32_t argc, char *argv[]);
+
+/// A command of a command table
+typedef struct
+{
+    const char *name;           ///< Command, the first word of a line
+    console_handler_t handler;  ///< Called with the words of the line
+    const char *help;           ///< One line for the help command
+}
+console_cmd_t;
+
+/*!
+ * \brief Takes a received character before the line editor, for a protocol
+ *        that shares the port, like fmstr_rx()
+ *
+ * \return True if the character was consumed
+ */
+typedef bool (*console_filter_t)(const char c);
+
+// Function prototypes
+void console_init(xComPortHandle port, const console_cmd_t *commands,
+    const uint32_t n, console_filter_t filter);
+void console_run(void);
+
+#endif // CONSOLE_H
@@ -0,0 +1,413 @@
+/*! ***************************************************************************
+ *
+ * \brief     Capture of hard faults and failed assertions over a reset
+ * \file      crash.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <MKL25Z4.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "crash.h"
+#include "flashlog.h"
+#include "mtb.h"
+#include "sections.h"
+#include "serial.h"
+#include "xprintf.h"
+
+#if (CRASH_ENABLED == 1)
+
+/*
+ * A hard fault, a failed configASSERT() and a stack overflow fill the record
+ * in the .noinit section and reset the MCU with SYSRESETREQ, which keeps the
+ * SRAM. crash_init() takes a valid record after the reset, crash_report()
+ * writes it to the serial port and, with FLOG_ENABLED, a summary to the
+ * flash log. The MTB capture is stopped as well, so with MTB_ENABLED the
+ * branches that led to the crash are still in mtb_buffer after the reset
+ * until mtb_init() restarts it.
+ *
+ * The registers are sealed with a checksum before the task name, the trace
+ * and the stack are read, so a second fault while reading those, which
+ * locks up the core and resets it, still leaves the registers.
+ */
+
+// 'CRSH', marks a valid record
+#define CRASH_MAGIC      (0x48535243UL)
+
+// Time a line of the report may wait for room in the serial transmit buffer
+#define CRASH_BLOCK_TIME pdMS_TO_TICKS(100)
+
+// Longest line written to the serial port, including the terminator
+#define CRASH_LINE_LEN   (64)
+
+// Linker script symbols of the SRAM, the stack is only read inside
+extern uint8_t __base_SRAM[];
+extern uint8_t __top_SRAM[];
+
+static __NOINIT crash_record_t crash_record;
+
+// Copy of the record of the previous run, taken by crash_init()
+static crash_record_t crash_last;
+static bool crash_valid = false;
+
+// Reset status of the reset after the crash
+static uint8_t crash_srs0;
+static uint8_t crash_srs1;
+
+static const char * const reason_names[] =
+{
+    "", "Hard fault", "Assertion", "Stack overflow"
+};
+
+void crash_fault(const uint32_t *frame, const uint32_t exc_return)
+    __attribute__((used, noreturn));
+
+/*!
+ * \brief Returns the checksum of the record, up to the check word
+ */
+static uint32_t crash_checksum(const crash_record_t *r)
+{
+    const uint32_t *p = (const uint32_t *)r;
+    uint32_t sum = 0;
+
+    for(uint32_t i=0; i<(offsetof(crash_record_t, check) / 4); i++)
+    {
+        sum = (sum << 1 | sum >> 31) + p[i];
+    }
+
+    return ~sum;
+}
+
+/*!
+ * \brief Checks if n words from p are in the SRAM
+ */
+static bool crash_in_sram(const uint32_t *p, const uint32_t n)
+{
+    return ((uintptr_t)p >= (uintptr_t)__base_SRAM) &&
+           (((uintptr_t)p & 3) == 0) &&
+           (((uintptr_t)p + (n * 4)) <= (uintptr_t)__top_SRAM);
+}
+
+/*!
+ * \brief Starts a record, interrupts must be masked
+ */
+static void crash_begin(const crash_reason_t reason)
+{
+    mtb_stop();
+
+    memset(&crash_record, 0, sizeof(crash_record));
+    crash_record.magic = CRASH_MAGIC;
+    crash_record.reason = reason;
+    crash_record.ticks = xTaskGetTickCountFromISR();
+}
+
+/*!
+ * \brief Completes the record with the task, the stack and the trace and
+ *        resets
+ */
+static void crash_finish(void) __attribute__((noreturn));
+static void crash_finish(void)
+{
+    crash_record_t *r = &crash_record;
+    const uint32_t *sp = (const uint32_t *)r->sp;
+
+    r->check = crash_checksum(r);
+
+    if((r->task[0] == '\0') &&
+       (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED))
+    {
+        strncpy(r->task, pcTaskGetName(NULL), sizeof(r->task) - 1);
+    }
+
+    // Stop at the end of the SRAM, the stack pointer may be near it
+    for(uint32_t i=0; (i < CRASH_STACK_WORDS) && crash_in_sram(&sp[i], 1); i++)
+    {
+        r->stack[i] = sp[i];
+    }
+
+#if (TRACE_ENABLED == 1)
+    {
+        const uint32_t head = trace_ring.head;
+        const uint32_t n = (head < TRACE_BUFFER_SIZE) ? head : TRACE_BUFFER_SIZE;
+        const uint32_t first = (n > CRASH_TRACE_EVENTS) ? (n - CRASH_TRACE_EVENTS) : 0;
+
+        r->events = trace_read(r->trace, first, CRASH_TRACE_EVENTS);
+    }
+#endif
+
+    r->check = crash_checksum(r);
+
+    NVIC_SystemReset();
+}
+
+/*!
+ * \brief Takes the record of the previous run, if there is one
+ *
+ * Call at the start of main(), before anything can fail.
+ */
+void crash_init(void)
+{
+    crash_srs0 = RCM->SRS0;
+    crash_srs1 = RCM->SRS1;
+
+    crash_valid = (crash_record.magic == CRASH_MAGIC) &&
+                  (crash_record.check == crash_checksum(&crash_record));
+
+    if(crash_valid)
+    {
+        crash_last = crash_record;
+    }
+
+    crash_record.magic = 0;
+}
+
+static void crash_puts(const char *line)
+{
+    xSerialPutStringPolicy(line, eSerialBlock, CRASH_BLOCK_TIME);
+}
+
+/*!
+ * \brief Writes the record of the previous run to the serial port and the
+ *        flash log, once
+ *
+ * The reason with the running task and the uptime, the assertion, the
+ * stacked registers, the stack from the stack pointer upwards and the most
+ * recent trace events, oldest first. Nothing is written if the previous run
+ * did not crash. Must be called from a task.
+ */
+void crash_report(void)
+{
+    char line[CRASH_LINE_LEN];
+    const crash_record_t *r = &crash_last;
+
+    if(!crash_valid)
+    {
+        return;
+    }
+
+    crash_valid = false;
+
+    xsnprintf(line, CRASH_LINE_LEN, "\r\nCrash: %s in %s at %lu ms, reset by %s\r\n",
+        (r->reason < (sizeof(reason_names) / sizeof(reason_names[0]))) ?
+            reason_names[r->reason] : "?",
+        (r->task[0] != '\0') ? r->task : "(none)",
+        (unsigned long)(r->ticks * portTICK_PERIOD_MS),
+        (crash_srs1 & RCM_SRS1_SW_MASK) ? "software" :
+        (crash_srs1 & RCM_SRS1_LOCKUP_MASK) ? "lockup" : "other");
+    crash_puts(line);
+
+    if(r->reason == CRASH_ASSERT)
+    {
+        xsnprintf(line, CRASH_LINE_LEN, "%s:%lu\r\n", r->file, (unsigned long)r->line);
+        crash_puts(line);
+    }
+
+    xsnprintf(line, CRASH_LINE_LEN, "pc %08lx lr %08lx psr %08lx sp %08lx\r\n",
+        (unsigned long)r->regs[CRASH_PC], (unsigned long)r->regs[CRASH_LR],
+        (unsigned long)r->regs[CRASH_XPSR], (unsigned long)r->sp);
+    crash_puts(line);
+
+    xsnprintf(line, CRASH_LINE_LEN, "r0 %08lx r1 %08lx r2 %08lx r3 %08lx\r\n",
+        (unsigned long)r->regs[CRASH_R0], (unsigned long)r->regs[CRASH_R1],
+        (unsigned long)r->regs[CRASH_R2], (unsigned long)r->regs[CRASH_R3]);
+    crash_puts(line);
+
+    xsnprintf(line, CRASH_LINE_LEN, "r12 %08lx exc %08lx\r\n",
+        (unsigned long)r->regs[CRASH_R12], (unsigned long)r->exc_return);
+    crash_puts(line);
+
+    for(uint32_t i=0; i<CRASH_STACK_WORDS; i+=4)
+    {
+        xsnprintf(line, CRASH_LINE_LEN, "%08lx: %08lx %08lx %08lx %08lx\r\n",
+            (unsigned long)(r->sp + i * 4),
+            (unsigned long)r->stack[i], (unsigned long)r->stack[i + 1],
+            (unsigned long)r->stack[i + 2], (unsigned long)r->stack[i + 3]);
+        crash_puts(line);
+    }
+
+    // Time in ticks of TRACE_HZ, event type, task number and argument
+    for(uint32_t i=0; i<r->events; i++)
+    {
+        xsnprintf(line, CRASH_LINE_LEN, "%10lu %2u %3u %5u\r\n",
+            (unsigned long)r->trace[i].time, r->trace[i].type,
+            r->trace[i].task, r->trace[i].arg);
+        crash_puts(line);
+    }
+
+#if (FLOG_ENABLED == 1)
+    {
+        // Reason, PC, LR, uptime, line, task and file, 60 bytes
+        struct __attribute__((packed))
+        {
+            uint32_t reason;
+            uint32_t pc;
+            uint32_t lr;
+            uint32_t ticks;
+            uint32_t line;
+            char task[configMAX_TASK_NAME_LEN];
+            char file[CRASH_FILE_LEN];
+        }
+        summary =
+        {
+            r->reason, r->regs[CRASH_PC], r->regs[CRASH_LR], r->ticks, r->line,
+            {0}, {0}
+        };
+
+        memcpy(summary.task, r->task, sizeof(summary.task));
+        memcpy(summary.file, r->file, sizeof(summary.file));
+
+        (void)flog_append(CRASH_FLOG_TYPE, &summary, sizeof(summary));
+    }
+#endif
+}
+
+/*!
+ * \brief Captures a failed configASSERT() and resets
+ *
+ * \param[in]  file  __FILE__ of the assertion, the end of the path is kept
+ * \param[in]  line  __LINE__ of the assertion
+ */
+void crash_assert(const char *file, const uint32_t line)
+{
+    const size_t len = strlen(file);
+    uint32_t sp;
+
+    taskDISABLE_INTERRUPTS();
+    __asm volatile("mov %0, sp" : "=r" (sp));
+
+    crash_begin(CRASH_ASSERT);
+    crash_record.regs[CRASH_PC] = (uint32_t)__builtin_return_address(0);
+    crash_record.sp = sp;
+    crash_record.line = line;
+    strncpy(crash_record.file, (len < CRASH_FILE_LEN) ? file :
+            (file + len - (CRASH_FILE_LEN - 1)), CRASH_FILE_LEN - 1);
+
+    crash_finish();
+}
+
+/*!
+ * \brief Captures a stack overflow and resets
+ *
+ * The memory next to the stack of the task may be corrupted, its name is
+ * copied before anything else is read. The registers are taken from the
+ * exception frame of the task. In the context switch, which runs in
+ * PendSV, that is the frame on the process stack, as the task was
+ * interrupted. Anywhere else the task is switched out, and its frame is
+ * above the r4 to r11 that the port saved at its top of stack. An invalid
+ * frame leaves the PC of the caller.
+ *
+ * \param[in]  task  Name of the task that overflowed its stack
+ * \param[in]  tcb   Handle of the task, its first word is the top of stack
+ */
+void crash_stack_overflow(const char *task, const void *tcb)
+{
+    const uint32_t *frame;
+
+    taskDISABLE_INTERRUPTS();
+
+    crash_begin(CRASH_STACK_OVERFLOW);
+    strncpy(crash_record.task, task, sizeof(crash_record.task) - 1);
+
+    if(__get_IPSR() != 0)
+    {
+        frame = (const uint32_t *)__get_PSP();
+    }
+    else
+    {
+        frame = *(const uint32_t * const *)tcb + 8;
+    }
+
+    if(crash_in_sram(frame, CRASH_REGS))
+    {
+        memcpy(crash_record.regs, frame, sizeof(crash_record.regs));
+        crash_record.sp = (uint32_t)&frame[CRASH_REGS] +
+                          ((frame[CRASH_XPSR] & (1UL << 9)) ? 4 : 0);
+    }
+    else
+    {
+        crash_record.regs[CRASH_PC] = (uint32_t)__builtin_return_address(0);
+        crash_record.sp = (uint32_t)frame;
+    }
+
+    crash_finish();
+}
+
+/*!
+ * \brief Captures a hard fault from the exception frame and resets
+ *
+ * \param[in]  frame       Exception frame on the stack that was in use
+ * \param[in]  exc_return  EXC_RETURN value of the fault
+ */
+void crash_fault(const uint32_t *frame, const uint32_t exc_return)
+{
+    crash_begin(CRASH_HARDFAULT);
+    crash_record.exc_return = exc_return;
+
+    if(crash_in_sram(frame, CRASH_REGS))
+    {
+        memcpy(crash_record.regs, frame, sizeof(crash_record.regs));
+
+        // The frame is 8 words, plus one word of alignment if xPSR bit 9 is set
+        crash_record.sp = (uint32_t)&frame[CRASH_REGS] +
+                          ((frame[CRASH_XPSR] & (1UL << 9)) ? 4 : 0);
+    }
+    else
+    {
+        // The stack pointer itself was invalid, there is no frame to read
+        crash_record.sp = (uint32_t)frame;
+    }
+
+    crash_finish();
+}
+
+/*!
+ * \brief Passes the exception frame to crash_fault(), replaces the default
+ *        handler and the one in mtb.c
+ *
+ * Bit 2 of EXC_RETURN selects the stack the frame was pushed on: the
+ * process stack of the tasks or the main stack of the interrupts and of
+ * main() before the scheduler started.
+ */
+__attribute__((naked)) void HardFault_Handler(void)
+{
+    __asm volatile(
+        "   movs r0, #4         \n"
+        "   mov  r1, lr         \n"
+        "   tst  r0, r1         \n"
+        "   beq  1f             \n"
+        "   mrs  r0, psp        \n"
+        "   b    2f             \n"
+        "1: mrs  r0, msp        \n"
+        "2: ldr  r2, =crash_fault \n"
+        "   bx   r2             \n"
+        "   .ltorg              \n");
+}
+
+#endif // CRASH_ENABLED
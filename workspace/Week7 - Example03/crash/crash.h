@@ -0,0 +1,146 @@
+/*! ***************************************************************************
+ *
+ * \brief     Capture of hard faults and failed assertions over a reset
+ * \file      crash.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef CRASH_H
+#define CRASH_H
+
+#include <stdint.h>
+
+#include "trace.h"
+
+/// \name Definitions for the crash capture
+/// \{
+
+/*!
+ * \brief Set to 1 to capture a hard fault, a failed configASSERT() or a
+ *        stack overflow and reset, instead of halting
+ *
+ * Leave it at 0 while debugging, the core then stops where it failed.
+ */
+#ifndef CRASH_ENABLED
+#define CRASH_ENABLED       (0)
+#endif
+
+/*!
+ * \brief Number of words above the stack pointer kept in the record
+ */
+#ifndef CRASH_STACK_WORDS
+#define CRASH_STACK_WORDS   (16)
+#endif
+
+/*!
+ * \brief Number of the most recent trace events kept in the record
+ */
+#ifndef CRASH_TRACE_EVENTS
+#define CRASH_TRACE_EVENTS  (16)
+#endif
+
+/*!
+ * \brief Number of characters kept of the file name of an assertion, the
+ *        end of the path
+ */
+#define CRASH_FILE_LEN      (24)
+
+/*!
+ * \brief Type of the summary written to the flash log with FLOG_ENABLED,
+ *        see flashlog.h
+ */
+#define CRASH_FLOG_TYPE     (0xCE)
+
+/// \}
+
+/// What ended the previous run
+typedef enum
+{
+    CRASH_HARDFAULT = 1,     ///< Hard fault, the registers are the stacked ones
+    CRASH_ASSERT,            ///< configASSERT(), with file and line
+    CRASH_STACK_OVERFLOW,    ///< Stack overflow of the task
+}
+crash_reason_t;
+
+/// Stacked registers of the exception frame, in stacking order
+typedef enum
+{
+    CRASH_R0, CRASH_R1, CRASH_R2, CRASH_R3, CRASH_R12, CRASH_LR, CRASH_PC,
+    CRASH_XPSR, CRASH_REGS
+}
+crash_reg_t;
+
+/*!
+ * \brief The record in the .noinit section, kept over the reset
+ *
+ * For an assertion the PC is the caller of the capture function and the
+ * other registers are 0. For a stack overflow the registers are the
+ * exception frame of the task that overflowed, where it was interrupted or
+ * last switched out, and sp and the stack are those of the task.
+ */
+typedef struct
+{
+    uint32_t magic;                             ///< CRASH_MAGIC when valid
+    uint32_t reason;                            ///< crash_reason_t
+    uint32_t regs[CRASH_REGS];                  ///< See crash_reg_t
+    uint32_t sp;                                ///< Stack pointer before the fault
+    uint32_t exc_return;                        ///< EXC_RETURN of a hard fault
+    uint32_t ticks;                             ///< Tick count at the crash
+    uint32_t line;                              ///< Line of the assertion
+    char file[CRASH_FILE_LEN];                  ///< File of the assertion
+    char task[configMAX_TASK_NAME_LEN];         ///< Running task, empty before the scheduler
+    uint32_t stack[CRASH_STACK_WORDS];          ///< Words from sp upwards
+    uint32_t events;                            ///< Number of events in trace
+    trace_record_t trace[CRASH_TRACE_EVENTS];   ///< Most recent events, oldest first
+    uint32_t check;                             ///< Checksum of the words above
+}
+crash_record_t;
+
+#if (CRASH_ENABLED == 1)
+
+// Function prototypes
+void crash_init(void);
+void crash_report(void);
+void crash_assert(const char *file, const uint32_t line) __attribute__((noreturn));
+void crash_stack_overflow(const char *task, const void *tcb) __attribute__((noreturn));
+
+#else
+
+static inline void crash_assert(const char *file, const uint32_t line)
+{
+    (void)file;
+    (void)line;
+}
+
+static inline void crash_stack_overflow(const char *task, const void *tcb)
+{
+    (void)task;
+    (void)tcb;
+}
+
+#endif // CRASH_ENABLED
+
+#endif // CRASH_H
@@ -0,0 +1,238 @@
+/*! ***************************************************************************
+ *
+ * \brief     Timing of the sections that run with interrupts masked
+ * \file      critmon.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "critmon.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "runtime_stats.h"
+
+/*
+ * On the CM0 port a critical section masks all interrupts with PRIMASK,
+ * so the longest section delays every interrupt handler by its length.
+ * The port calls critmon_masked() when it masks interrupts that were not
+ * masked yet, in vPortEnterCritical() and ulSetInterruptMaskFromISR(), and
+ * critmon_unmasked() right before it unmasks them again. Both run with
+ * interrupts masked.
+ *
+ * A section is timed with the free-running PIT0 in bus clock cycles and
+ * attributed to the return address of the masking function, the call site
+ * in the kernel or the driver that entered it. The table keeps the
+ * CRITMON_SITES sites with the longest sections: a new site replaces the
+ * one with the shortest longest section if its own is longer.
+ *
+ * Sections masked with __disable_irq() or portDISABLE_INTERRUPTS()
+ * directly, and the PendSV handler, are not seen.
+ */
+
+#if (CRITMON_ENABLED == 1)
+
+#if !rtsFREE_RUNNING
+#error "CRITMON_ENABLED needs the free-running PIT0 of rtsFREE_RUNNING"
+#endif
+
+// Start of the open section and its caller, NULL if none is open
+static uint32_t critmon_start;
+static const void *critmon_caller = NULL;
+
+static critmon_site_t critmon_sites[CRITMON_SITES];
+static critmon_total_t critmon_totals;
+
+/*!
+ * \brief Starts a section, called by the port with interrupts masked
+ *
+ * \param[in]  caller  Return address into the masking function
+ */
+void critmon_masked(const void *caller)
+{
+    critmon_start = PIT->CHANNEL[0].CVAL;
+    critmon_caller = caller;
+}
+
+/*!
+ * \brief Ends the open section, called by the port with interrupts masked
+ */
+void critmon_unmasked(void)
+{
+    // PIT0 counts down
+    const uint32_t cycles = critmon_start - PIT->CHANNEL[0].CVAL;
+    const void *caller = critmon_caller;
+    critmon_site_t *site = NULL;
+    critmon_site_t *shortest = &critmon_sites[0];
+
+    // Interrupts were masked before the monitor saw them, e.g. before the
+    // scheduler started
+    if(caller == NULL)
+    {
+        return;
+    }
+
+    critmon_caller = NULL;
+
+    critmon_totals.count++;
+    critmon_totals.total_cycles += cycles;
+
+    if(cycles > critmon_totals.max_cycles)
+    {
+        critmon_totals.max_cycles = cycles;
+    }
+
+    for(uint32_t i=0; i<CRITMON_SITES; i++)
+    {
+        if(critmon_sites[i].caller == caller)
+        {
+            site = &critmon_sites[i];
+            break;
+        }
+
+        if(critmon_sites[i].max_cycles < shortest->max_cycles)
+        {
+            shortest = &critmon_sites[i];
+        }
+    }
+
+    if(site == NULL)
+    {
+        // Free entries have no sections, so they are the shortest
+        if(cycles <= shortest->max_cycles)
+        {
+            return;
+        }
+
+        if(shortest->caller != NULL)
+        {
+            critmon_totals.evicted++;
+        }
+
+        site = shortest;
+        site->caller = caller;
+        site->count = 0;
+        site->max_cycles = 0;
+    }
+
+    site->count++;
+
+    if(cycles > site->max_cycles)
+    {
+        site->max_cycles = cycles;
+    }
+}
+
+/*!
+ * \brief Reads a call site of the table
+ *
+ * \param[in]   i     Entry of the table, from 0
+ * \param[out]  site  Copy of the entry
+ *
+ * \return False if there are no more entries
+ */
+bool critmon_get(const uint32_t i, critmon_site_t *site)
+{
+    if(i >= CRITMON_SITES)
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        *site = critmon_sites[i];
+    }
+    taskEXIT_CRITICAL();
+
+    return true;
+}
+
+/*!
+ * \brief Reads the totals of all sections
+ *
+ * \param[out]  total  Copy of the totals
+ */
+void critmon_get_total(critmon_total_t *total)
+{
+    taskENTER_CRITICAL();
+    {
+        *total = critmon_totals;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Clears the table and the totals
+ */
+void critmon_reset(void)
+{
+    taskENTER_CRITICAL();
+    {
+        for(uint32_t i=0; i<CRITMON_SITES; i++)
+        {
+            critmon_sites[i].caller = NULL;
+            critmon_sites[i].count = 0;
+            critmon_sites[i].max_cycles = 0;
+        }
+
+        critmon_totals.count = 0;
+        critmon_totals.max_cycles = 0;
+        critmon_totals.total_cycles = 0;
+        critmon_totals.evicted = 0;
+    }
+    taskEXIT_CRITICAL();
+}
+
+#else
+
+void critmon_masked(const void *caller)
+{
+    (void)caller;
+}
+
+void critmon_unmasked(void)
+{
+}
+
+bool critmon_get(const uint32_t i, critmon_site_t *site)
+{
+    (void)i;
+    (void)site;
+
+    return false;
+}
+
+void critmon_get_total(critmon_total_t *total)
+{
+    total->count = 0;
+    total->max_cycles = 0;
+    total->total_cycles = 0;
+    total->evicted = 0;
+}
+
+void critmon_reset(void)
+{
+}
+
+#endif
@@ -0,0 +1,94 @@
+/*! ***************************************************************************
+ *
+ * \brief     Timing of the sections that run with interrupts masked
+ * \file      critmon.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef CRITMON_H
+#define CRITMON_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// \name Definitions for the masked section monitor
+/// \{
+
+/*!
+ * \brief Set to 1 to time every section with interrupts masked by the
+ *        kernel, set by the CRITMON option of CMakeLists.txt
+ *
+ * Adds a timestamp and a lookup to every critical section, which then takes
+ * longer itself. Needs the free-running PIT0 of rtsFREE_RUNNING.
+ */
+#ifndef CRITMON_ENABLED
+#define CRITMON_ENABLED     (0)
+#endif
+
+/*!
+ * \brief Number of call sites of which the longest section is kept
+ */
+#ifndef CRITMON_SITES
+#define CRITMON_SITES       (8)
+#endif
+
+/// \}
+
+/// The sections that masked interrupts at one call site
+typedef struct
+{
+    const void *caller;     ///< Return address into the masking function
+    uint32_t count;         ///< Number of sections
+    uint32_t max_cycles;    ///< Longest section in bus clock cycles
+}
+critmon_site_t;
+
+/// All sections since the last reset
+typedef struct
+{
+    uint32_t count;         ///< Number of sections
+    uint32_t max_cycles;    ///< Longest section in bus clock cycles
+    uint64_t total_cycles;  ///< Sum of all sections in bus clock cycles
+    uint32_t evicted;       ///< Sites dropped from the table for longer ones
+}
+critmon_total_t;
+
+// Function prototypes
+void critmon_masked(const void *caller);
+void critmon_unmasked(void);
+bool critmon_get(const uint32_t i, critmon_site_t *site);
+void critmon_get_total(critmon_total_t *total);
+void critmon_reset(void);
+
+#if (CRITMON_ENABLED == 1)
+
+// Hooks of the ARM_CM0 port, see portmacro.h
+#define traceINTERRUPTS_MASKED(pvCaller)    critmon_masked(pvCaller)
+#define traceINTERRUPTS_UNMASKED()          critmon_unmasked()
+
+#endif
+
+#endif // CRITMON_H
@@ -0,0 +1,519 @@
+/*! ***************************************************************************
+ *
+ * \brief     DAC0 waveform generator with DMA
+ * \file      dac.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <MKL25Z4.h>
+
+#include "dac.h"
+#include "clock.h"
+#include "dma.h"
+#include "irq_prio.h"
+
+// DAC output pin, PTE30
+#define DAC_PIN (30)
+
+// Mode of the playing table
+typedef enum
+{
+    DAC_IDLE,
+    DAC_LOOP,
+    DAC_PINGPONG,
+}dac_mode_t;
+
+// Sample rate in Hz, 0 until dac_set_rate()
+static uint32_t rate_hz = 0;
+
+// Playing table, or both halves in ping-pong mode
+static dac_mode_t volatile mode = DAC_IDLE;
+static const uint16_t *tables[2];
+static uint32_t samples;
+static uint32_t remaining;
+static bool forever;
+
+// Ping-pong mode: the half that plays, the half that was played and is not
+// yet handed out by dac_next(), and the times both halves were played
+// without dac_next() in between
+static uint32_t playing;
+static int32_t volatile played = -1;
+static uint32_t volatile underruns = 0;
+static TaskHandle_t volatile waiting = NULL;
+
+static clk_notifier_t clock;
+
+static void dac_dma_isr(void *arg, const uint32_t status, BaseType_t *woken);
+
+/*!
+ * \brief Quarter sine in Q15, in 32 steps of 90/32 degrees
+ */
+static const uint16_t sin_quarter[33] =
+{
+        0,  1608,  3212,  4808,  6393,  7962,  9512, 11039,
+    12539, 14010, 15446, 16846, 18204, 19519, 20787, 22005,
+    23170, 24279, 25329, 26319, 27245, 28105, 28898, 29621,
+    30273, 30852, 31356, 31785, 32137, 32412, 32609, 32728,
+    32767,
+};
+
+/*!
+ * \brief Sets the PIT1 period for the sample rate at the current bus clock
+ */
+static void dac_pit_start(void)
+{
+    PIT->CHANNEL[1].TCTRL = 0;
+    PIT->CHANNEL[1].LDVAL = PIT_LDVAL_TSV((clk_bus_hz() / rate_hz) - 1);
+    PIT->CHANNEL[1].TFLG = PIT_TFLG_TIF_MASK;
+    PIT->CHANNEL[1].TCTRL = PIT_TCTRL_TEN_MASK;
+}
+
+/*!
+ * \brief Recomputes the PIT1 period after a clock mode change, so a playing
+ *        table keeps its sample rate
+ */
+static void dac_clock(const clk_event_t event, void *arg)
+{
+    (void)arg;
+
+    if((event == CLK_POST_CHANGE) && (mode != DAC_IDLE))
+    {
+        dac_pit_start();
+    }
+}
+
+/*!
+ * \brief Starts a pass of a table
+ */
+static inline void dac_start_pass(const uint16_t *table)
+{
+    DMA0->DMA[DAC_DMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    DMA0->DMA[DAC_DMA_CHANNEL].SAR = (uint32_t)table;
+    DMA0->DMA[DAC_DMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_BCR(samples * sizeof(table[0]));
+}
+
+/*!
+ * \brief Initialises DAC0
+ *
+ * The DAC is enabled in high-power mode with VDDA as reference and the
+ * buffer disabled, so a write of DAT0 sets the output. The output is set to
+ * 0. The following pin is configured:
+ * - PTE30: DAC0_OUT
+ */
+void dac_init(void)
+{
+    // Clock port and DAC, once if initialised again
+    SIM->SCGC5 |= SIM_SCGC5_PORTE_MASK;
+
+    if(clk_gate_users(CLK_GATE_DAC0) == 0)
+    {
+        clk_gate_acquire(CLK_GATE_DAC0);
+    }
+
+    // The analog function is ALT0
+    PORTE->PCR[DAC_PIN] = PORT_PCR_MUX(0);
+
+    DAC0->C1 = 0;
+    DAC0->C2 = 0;
+    DAC0->DAT[0].DATL = 0;
+    DAC0->DAT[0].DATH = 0;
+    DAC0->C0 = DAC_C0_DACEN_MASK | DAC_C0_DACRFS_MASK;
+
+    clk_register(&clock, dac_clock, NULL);
+}
+
+/*!
+ * \brief Sets the DAC output
+ *
+ * Must not be called while a table plays.
+ *
+ * \param[in]  value  Output value, 0 to DAC_MAX_VALUE for 0 to VDDA
+ */
+void dac_write(const uint16_t value)
+{
+    const uint16_t v = (value > DAC_MAX_VALUE) ? DAC_MAX_VALUE : value;
+
+    DAC0->DAT[0].DATL = (uint8_t)(v & 0xFF);
+    DAC0->DAT[0].DATH = (uint8_t)(v >> 8);
+}
+
+/*!
+ * \brief Sets the sample rate of the tables
+ *
+ * PIT1 triggers a DMA transfer of one sample at this rate. The period is a
+ * whole number of bus clock cycles, so the achieved rate is returned. A
+ * playing table changes rate immediately.
+ *
+ * \param[in]  hz  Sample rate, 1 to DAC_MAX_HZ
+ *
+ * \return The achieved rate in Hz, 0 if \p hz is out of range
+ */
+uint32_t dac_set_rate(const uint32_t hz)
+{
+    const uint32_t bus = clk_bus_hz();
+
+    if((hz == 0) || (hz > DAC_MAX_HZ) || (hz > bus))
+    {
+        return 0;
+    }
+
+    rate_hz = hz;
+
+    if(mode != DAC_IDLE)
+    {
+        dac_pit_start();
+    }
+
+    return bus / (bus / hz);
+}
+
+/*!
+ * \brief Returns the sample rate set by dac_set_rate(), 0 if none
+ */
+uint32_t dac_get_rate(void)
+{
+    return rate_hz;
+}
+
+/*!
+ * \brief Starts the DMA channel and PIT1, the first sample is written at
+ *        the first trigger
+ *
+ * \return False if no rate is set, or the DMA channel or PIT1 is used by
+ *         another driver
+ */
+static bool dac_start(void)
+{
+    const uint32_t ch = DAC_DMA_CHANNEL;
+
+    if(rate_hz == 0)
+    {
+        return false;
+    }
+
+    clk_gate_acquire(CLK_GATE_PIT);
+
+    if((PIT->CHANNEL[1].TCTRL & PIT_TCTRL_TEN_MASK) ||
+       (dma_claim(DAC_DMA_CHANNEL, dac_dma_isr, NULL) < 0))
+    {
+        clk_gate_release(CLK_GATE_PIT);
+        return false;
+    }
+
+    // Cycle steal: one 16-bit transfer per PIT1 trigger, from the next table
+    // entry to DAT0. The end of a pass interrupts.
+    DMA0->DMA[ch].DAR = (uint32_t)&DAC0->DAT[0].DATL;
+    DMA0->DMA[ch].DCR = DMA_DCR_EINT_MASK |
+                        DMA_DCR_ERQ_MASK |
+                        DMA_DCR_CS_MASK |
+                        DMA_DCR_SINC_MASK |
+                        DMA_DCR_SSIZE(2) |
+                        DMA_DCR_DSIZE(2);
+
+    dac_start_pass(tables[0]);
+
+    dma_route(ch, DMA_SOURCE_ALWAYS, true);
+    dma_irq_enable(ch, IRQ_PRIO(DAC_DMA));
+
+    PIT->MCR &= ~PIT_MCR_MDIS_MASK;
+    dac_pit_start();
+
+    return true;
+}
+
+/*!
+ * \brief Plays a table without CPU load
+ *
+ * On every trigger of PIT1, DMA channel DAC_DMA_CHANNEL writes the next
+ * sample of the table to the DAC. The CPU only runs at the end of every
+ * pass, to start the next one. A playing table is stopped first. The table
+ * must remain valid while it plays.
+ *
+ * \param[in]  table   Samples, 0 to DAC_MAX_VALUE
+ * \param[in]  n       Number of samples
+ * \param[in]  repeat  Number of passes, or DAC_FOREVER
+ *
+ * \return False if \p n is 0, no rate is set, or the DMA channel or PIT1 is
+ *         used by another driver
+ */
+bool dac_play(const uint16_t *table, const uint32_t n, const uint32_t repeat)
+{
+    if((table == NULL) || (n == 0) || (n > (DMA_DSR_BCR_BCR_MASK / 2)))
+    {
+        return false;
+    }
+
+    dac_stop();
+
+    tables[0] = table;
+    tables[1] = table;
+    samples = n;
+    remaining = repeat;
+    forever = (repeat == DAC_FOREVER);
+    mode = DAC_LOOP;
+
+    if(!dac_start())
+    {
+        mode = DAC_IDLE;
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Streams samples from two buffers in turn
+ *
+ * While one buffer plays, the other is filled by the task that calls
+ * dac_next(). Both buffers must be filled before the call, buf0 plays
+ * first. A buffer that is not refilled in time plays again, which is
+ * counted by dac_underruns().
+ *
+ * \param[in]  buf0  First buffer of n samples
+ * \param[in]  buf1  Second buffer of n samples
+ * \param[in]  n     Number of samples per buffer
+ *
+ * \return False if \p n is 0, no rate is set, or the DMA channel or PIT1 is
+ *         used by another driver
+ */
+bool dac_stream(uint16_t *buf0, uint16_t *buf1, const uint32_t n)
+{
+    if((buf0 == NULL) || (buf1 == NULL) || (n == 0) ||
+       (n > (DMA_DSR_BCR_BCR_MASK / 2)))
+    {
+        return false;
+    }
+
+    dac_stop();
+
+    tables[0] = buf0;
+    tables[1] = buf1;
+    samples = n;
+    playing = 0;
+    played = -1;
+    underruns = 0;
+    mode = DAC_PINGPONG;
+
+    if(!dac_start())
+    {
+        mode = DAC_IDLE;
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Waits for a buffer of dac_stream() to be played
+ *
+ * \param[in]  timeout  Time to wait in ticks
+ *
+ * \return The buffer to refill with the next samples, NULL on a timeout or
+ *         if no stream plays
+ */
+uint16_t *dac_next(const TickType_t timeout)
+{
+    uint16_t *buf = NULL;
+
+    if(mode != DAC_PINGPONG)
+    {
+        return NULL;
+    }
+
+    waiting = xTaskGetCurrentTaskHandle();
+
+    taskENTER_CRITICAL();
+    {
+        if(played >= 0)
+        {
+            buf = (uint16_t *)tables[played];
+            played = -1;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if(buf != NULL)
+    {
+        return buf;
+    }
+
+    if(ulTaskNotifyTakeIndexed(DAC_NOTIFY_INDEX, pdTRUE, timeout) == 0)
+    {
+        return NULL;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        if(played >= 0)
+        {
+            buf = (uint16_t *)tables[played];
+            played = -1;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return buf;
+}
+
+/*!
+ * \brief Stops a playing table, the output keeps the last sample
+ */
+void dac_stop(void)
+{
+    if(mode == DAC_IDLE)
+    {
+        return;
+    }
+
+    PIT->CHANNEL[1].TCTRL = 0;
+    dma_release(DAC_DMA_CHANNEL);
+    clk_gate_release(CLK_GATE_PIT);
+
+    mode = DAC_IDLE;
+}
+
+/*!
+ * \brief Returns true while a table or a stream plays
+ */
+bool dac_playing(void)
+{
+    return mode != DAC_IDLE;
+}
+
+/*!
+ * \brief Returns the number of times a buffer of dac_stream() played again
+ *        because it was not handed out by dac_next() in time
+ */
+uint32_t dac_underruns(void)
+{
+    return underruns;
+}
+
+/*!
+ * \brief Returns the sine of a phase in Q15
+ *
+ * \param[in]  phase  Phase in 1/32768 of a turn
+ */
+static int32_t dac_sin(const uint32_t phase)
+{
+    // 128 table steps per turn with 8 bits of interpolation
+    const uint32_t p = phase & 0x7FFF;
+    const uint32_t quarter = p >> 13;
+    const uint32_t pos = p & 0x1FFF;
+    const uint32_t i = (quarter & 1) ? (0x2000 - pos) : pos;
+    const uint32_t k = i >> 8;
+    const uint32_t f = i & 0xFF;
+    const int32_t v = (k >= 32) ? sin_quarter[32] :
+        sin_quarter[k] + (((sin_quarter[k + 1] - sin_quarter[k]) * (int32_t)f) >> 8);
+
+    return (quarter >= 2) ? -v : v;
+}
+
+/*!
+ * \brief Computes one period of a waveform into a table
+ *
+ * \param[out] table  Table of n samples
+ * \param[in]  n      Number of samples
+ * \param[in]  wave   Waveform
+ * \param[in]  low    Lowest sample value
+ * \param[in]  high   Highest sample value, at most DAC_MAX_VALUE
+ */
+void dac_waveform(uint16_t table[], const uint32_t n, const dac_wave_t wave,
+                  const uint16_t low, const uint16_t high)
+{
+    const uint32_t hi = (high > DAC_MAX_VALUE) ? DAC_MAX_VALUE : high;
+    const uint32_t lo = (low > hi) ? hi : low;
+    const uint32_t span = hi - lo;
+
+    for(uint32_t i=0; i<n; i++)
+    {
+        // Phase in 1/32768 of a turn
+        const uint32_t x = (uint32_t)(((uint64_t)i << 15) / n);
+        uint32_t level;
+
+        switch(wave)
+        {
+        case DAC_SINE:
+            level = (uint32_t)(dac_sin(x) + 32767) >> 2;
+            break;
+        case DAC_TRIANGLE:
+            level = (x < 0x4000) ? x : (0x7FFF - x);
+            break;
+        case DAC_SAWTOOTH:
+            level = x >> 1;
+            break;
+        case DAC_SQUARE:
+        default:
+            level = (x < 0x4000) ? 0x3FFF : 0;
+            break;
+        }
+
+        // level is 0 to 0x3FFF
+        table[i] = (uint16_t)(lo + ((level * span + 0x1FFF) / 0x3FFF));
+    }
+}
+
+/*!
+ * \brief End of a pass, called by the interrupt handler of DMA channel 1
+ */
+static void dac_dma_isr(void *arg, const uint32_t status, BaseType_t *woken)
+{
+    (void)arg;
+    (void)status;
+
+    if(mode == DAC_LOOP)
+    {
+        if(!forever && (--remaining == 0))
+        {
+            dac_stop();
+        }
+        else
+        {
+            dac_start_pass(tables[0]);
+        }
+    }
+    else if(mode == DAC_PINGPONG)
+    {
+        dac_start_pass(tables[playing ^ 1]);
+
+        if(played >= 0)
+        {
+            underruns++;
+        }
+
+        played = (int32_t)playing;
+        playing ^= 1;
+
+        if(waiting != NULL)
+        {
+            vTaskNotifyGiveIndexedFromISR(waiting, DAC_NOTIFY_INDEX, woken);
+        }
+    }
+    else
+    {
+        DMA0->DMA[DAC_DMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    }
+}
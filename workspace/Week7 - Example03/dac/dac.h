@@ -0,0 +1,114 @@
+/*! ***************************************************************************
+ *
+ * \brief     DAC0 waveform generator with DMA
+ * \file      dac.h
+ * \date      October 2026
+ *
+ * \remark    Hardware connection
+ * <pre>      FRDM-KL25Z                                                 </pre>
+ * <pre>      -------------+                                             </pre>
+ * <pre>                   |                                             </pre>
+ * <pre>     DAC0_OUT/PTE30+----------- 0 to VDDA, J10 pin 11            </pre>
+ * <pre>                   |                                             </pre>
+ * <pre>      -------------+                                             </pre>
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef DAC_H
+#define DAC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// \name Definitions for the waveform generator
+/// \{
+
+/*!
+ * \brief Highest sample value, the DAC has 12 bits
+ */
+#define DAC_MAX_VALUE (4095)
+
+/*!
+ * \brief Highest sample rate in Hz
+ *
+ * The DAC settles in 1 us in high-power mode, every sample costs one DMA
+ * transfer from the table.
+ */
+#define DAC_MAX_HZ (500000)
+
+/*!
+ * \brief DMA channel that writes the samples to the DAC
+ *
+ * DMAMUX channel 1 is the one triggered by PIT1, so the channel is fixed.
+ * It is claimed from the DMA manager while a table plays, dac_play() fails
+ * while the serial driver holds it with serUSE_DMA_RX. PIT1 triggers the
+ * ADC of the TCRT5000 driver, which is not used together with the
+ * generator.
+ */
+#define DAC_DMA_CHANNEL (1)
+
+/*!
+ * \brief Task notification index used by dac_next(), the index of the
+ *        TCRT5000 driver, which is not used together with the generator
+ */
+#ifndef DAC_NOTIFY_INDEX
+#define DAC_NOTIFY_INDEX (0)
+#endif
+
+/// Repeat count of dac_play() that plays a table until dac_stop()
+#define DAC_FOREVER (0)
+
+/// \}
+
+/// Waveform of dac_waveform()
+typedef enum
+{
+    DAC_SINE,     ///< Sine, starting at the midpoint and rising
+    DAC_TRIANGLE, ///< Linear rise from low to high and back
+    DAC_SAWTOOTH, ///< Linear rise from low to high
+    DAC_SQUARE,   ///< High for the first half, low for the second half
+}dac_wave_t;
+
+// Function prototypes
+void dac_init(void);
+void dac_write(const uint16_t value);
+
+uint32_t dac_set_rate(const uint32_t hz);
+uint32_t dac_get_rate(void);
+
+bool dac_play(const uint16_t *table, const uint32_t n, const uint32_t repeat);
+bool dac_stream(uint16_t *buf0, uint16_t *buf1, const uint32_t n);
+uint16_t *dac_next(const TickType_t timeout);
+void dac_stop(void);
+bool dac_playing(void);
+uint32_t dac_underruns(void);
+
+void dac_waveform(uint16_t table[], const uint32_t n, const dac_wave_t wave,
+                  const uint16_t low, const uint16_t high);
+
+#endif // DAC_H
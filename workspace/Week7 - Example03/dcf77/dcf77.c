@@ -0,0 +1,372 @@
+/*! ***************************************************************************
+ *
+ * \brief     DCF77 time signal receiver
+ * \file      dcf77.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "dcf77.h"
+#include "clock.h"
+#include "gpio.h"
+#include "irq_prio.h"
+#include "rtc.h"
+
+// The receiver output is connected to PTD3, TPM0 channel 3
+#define DCF77_PIN     (3)
+#define DCF77_CHANNEL (3)
+
+// Pulse and pause limits in RTC timestamp ticks
+#define DCF77_MS(ms)        (((ms) * RTC_TIMESTAMP_HZ) / 1000)
+#define DCF77_MIN_PULSE     DCF77_MS(40)
+#define DCF77_ONE_PULSE     DCF77_MS(150)
+#define DCF77_MAX_PULSE     DCF77_MS(250)
+#define DCF77_MINUTE_MARK   DCF77_MS(1500)
+#define DCF77_MAX_PERIOD    DCF77_MS(2500)
+
+// Bits of a minute frame, the 60th second has no pulse
+#define DCF77_BITS (59)
+
+// Frame that is being received and start of the current pulse
+static uint64_t bits;
+static uint32_t nbits;
+static bool bits_ok;
+static uint64_t pulse_start;
+static bool in_pulse;
+
+// Last complete frame, taken by dcf77_fix_wait()
+static volatile uint64_t frame;
+static volatile uint64_t frame_at;
+static volatile bool frame_ready = false;
+
+// Task that waits in dcf77_fix_wait()
+static TaskHandle_t task = NULL;
+
+// Number of complete frames and of rejected pulses or frames
+uint32_t dcf77_frames = 0;
+uint32_t dcf77_errors = 0;
+
+/*!
+ * \brief Initialises the DCF77 receiver input
+ *
+ * Both edges of the receiver output are captured by TPM0 channel 3. The
+ * TPM0 counter is shared with the RGB LED PWM and runs at the peripheral
+ * clock of the clock mode with the full 16-bit modulo. The input is not monitored until dcf77_fix_start().
+ */
+void dcf77_init(void)
+{
+    // Enable clock to PORTD and TPM0
+    SIM->SCGC5 |= SIM_SCGC5_PORTD(1);
+    clk_gate_acquire(CLK_GATE_TPM0);
+
+    // PTD3 : TPM0_CH3
+    PORTD->PCR[DCF77_PIN] = PORT_PCR_MUX(4);
+
+    // Start the counter in the same configuration as rgb_init()
+    if((TPM0->SC & TPM_SC_CMOD_MASK) == 0)
+    {
+        TPM0->MOD = 0xFFFF;
+        TPM0->SC = TPM_SC_CMOD(1);
+    }
+
+    // Input capture on both edges, interrupt disabled
+    TPM0->CONTROLS[DCF77_CHANNEL].CnSC = TPM_CnSC_ELSA(1) | TPM_CnSC_ELSB(1);
+
+    NVIC_SetPriority(TPM0_IRQn, IRQ_PRIO(DCF77));
+    NVIC_ClearPendingIRQ(TPM0_IRQn);
+    NVIC_EnableIRQ(TPM0_IRQn);
+}
+
+/*!
+ * \brief Starts receiving the time
+ *
+ * Enables the capture interrupt. From now on there is one interrupt per
+ * edge, two per second, and nothing in between. The calling task is the
+ * one that is notified, it completes the fix with dcf77_fix_wait().
+ */
+void dcf77_fix_start(void)
+{
+    taskENTER_CRITICAL();
+    {
+        nbits = 0;
+        bits_ok = false;
+        in_pulse = false;
+        frame_ready = false;
+        task = xTaskGetCurrentTaskHandle();
+
+        TPM0->CONTROLS[DCF77_CHANNEL].CnSC |= TPM_CnSC_CHF_MASK |
+            TPM_CnSC_CHIE_MASK;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Stops receiving the time
+ */
+void dcf77_fix_stop(void)
+{
+    taskENTER_CRITICAL();
+    {
+        TPM0->CONTROLS[DCF77_CHANNEL].CnSC = (TPM0->CONTROLS[DCF77_CHANNEL].CnSC &
+            ~TPM_CnSC_CHIE_MASK) | TPM_CnSC_CHF_MASK;
+        task = NULL;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Checks the even parity of bits first to last of a frame
+ */
+static bool dcf77_parity(const uint64_t f, const uint32_t first,
+    const uint32_t last)
+{
+    uint32_t ones = 0;
+
+    for(uint32_t i=first; i<=last; ++i)
+    {
+        ones += (f >> i) & 1;
+    }
+
+    return (ones & 1) == 0;
+}
+
+/*!
+ * \brief Converts a BCD field of a frame
+ */
+static uint16_t dcf77_bcd(const uint64_t f, const uint32_t first,
+    const uint32_t n)
+{
+    static const uint8_t weight[] = {1, 2, 4, 8, 10, 20, 40, 80};
+    uint16_t value = 0;
+
+    for(uint32_t i=0; i<n; ++i)
+    {
+        if((f >> (first + i)) & 1)
+        {
+            value += weight[i];
+        }
+    }
+
+    return value;
+}
+
+/*!
+ * \brief Decodes a minute frame
+ *
+ * The frame describes the minute that starts at its minute mark.
+ *
+ * \return False if a marker, parity or field is invalid
+ */
+static bool dcf77_decode(const uint64_t f, rtc_datetime_t *datetime)
+{
+    // Bit 0 is always 0, bit 20 is the start of the time
+    if(((f & 1) != 0) || (((f >> 20) & 1) == 0))
+    {
+        return false;
+    }
+
+    if(!dcf77_parity(f, 21, 28) || !dcf77_parity(f, 29, 35) ||
+       !dcf77_parity(f, 36, 58))
+    {
+        return false;
+    }
+
+    datetime->minute  = dcf77_bcd(f, 21, 7);
+    datetime->hour    = dcf77_bcd(f, 29, 6);
+    datetime->day     = dcf77_bcd(f, 36, 6);
+    datetime->weekday = dcf77_bcd(f, 42, 3) % 7;
+    datetime->month   = dcf77_bcd(f, 45, 5);
+    datetime->year    = dcf77_bcd(f, 50, 8) + 2000;
+    datetime->second  = 0;
+
+    return (datetime->minute < 60) && (datetime->hour < 24) &&
+           (datetime->day >= 1) && (datetime->day <= 31) &&
+           (datetime->month >= 1) && (datetime->month <= 12);
+}
+
+/*!
+ * \brief Waits for a valid minute frame and sets the RTC
+ *
+ * A frame takes a full minute after the first minute mark, so a fix takes
+ * one to two minutes with good reception. Frames that fail the parity
+ * checks are counted in dcf77_errors and the next one is awaited. The
+ * minute marks of successive fixes also compensate the drift of the RTC,
+ * see rtc_sync(). Reception stops when this function returns.
+ *
+ * \param[in]  timeout  Maximum time to wait in ticks
+ *
+ * \return True if the RTC was set, false on timeout
+ */
+bool dcf77_fix_wait(const TickType_t timeout)
+{
+    TimeOut_t start;
+    TickType_t remaining = timeout;
+    bool ok = false;
+
+    vTaskSetTimeOutState(&start);
+
+    while(!ok)
+    {
+        if(!frame_ready &&
+           (ulTaskNotifyTakeIndexed(DCF77_NOTIFY_INDEX, pdTRUE, remaining) == 0))
+        {
+            break;
+        }
+
+        if(frame_ready)
+        {
+            const uint64_t f = frame;
+            const uint64_t at = frame_at;
+            frame_ready = false;
+
+            rtc_datetime_t datetime;
+
+            if(dcf77_decode(f, &datetime))
+            {
+                // The minute mark is the start of second 0, which also
+                // calibrates the RTC
+                (void)rtc_sync(&datetime, at);
+                ok = true;
+            }
+            else
+            {
+                dcf77_errors++;
+            }
+        }
+
+        if(!ok && (xTaskCheckForTimeOut(&start, &remaining) != pdFALSE))
+        {
+            break;
+        }
+    }
+
+    dcf77_fix_stop();
+
+    return ok;
+}
+
+/*!
+ * \brief Handles the start of a pulse, which is the start of a second
+ */
+static void dcf77_second(const uint64_t t, BaseType_t *woken)
+{
+    const uint64_t period = t - pulse_start;
+
+    pulse_start = t;
+    in_pulse = true;
+
+    if((period < DCF77_MINUTE_MARK) || (period > DCF77_MAX_PERIOD))
+    {
+        return;
+    }
+
+    // Missing pulse of the 60th second, the frame is complete
+    if(bits_ok && (nbits == DCF77_BITS))
+    {
+        frame = bits;
+        frame_at = t;
+        frame_ready = true;
+        dcf77_frames++;
+
+        if(task != NULL)
+        {
+            vTaskNotifyGiveIndexedFromISR(task, DCF77_NOTIFY_INDEX, woken);
+        }
+    }
+
+    // The next frame starts with this pulse
+    bits = 0;
+    nbits = 0;
+    bits_ok = true;
+}
+
+/*!
+ * \brief Handles the end of a pulse, its width is the bit value
+ */
+static void dcf77_bit(const uint64_t t)
+{
+    const uint64_t width = t - pulse_start;
+
+    in_pulse = false;
+
+    if((width < DCF77_MIN_PULSE) || (width > DCF77_MAX_PULSE) ||
+       (nbits >= DCF77_BITS))
+    {
+        if(bits_ok)
+        {
+            dcf77_errors++;
+        }
+
+        bits_ok = false;
+        return;
+    }
+
+    if(width >= DCF77_ONE_PULSE)
+    {
+        bits |= (uint64_t)1 << nbits;
+    }
+
+    nbits++;
+}
+
+/*!
+ * \brief TPM0 interrupt handler
+ *
+ * Called on every edge of the receiver output. The edge is timestamped with
+ * the RTC and corrected for the interrupt latency, which is the time the
+ * TPM0 counter ran since the capture.
+ */
+void TPM0_IRQHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if((TPM0->CONTROLS[DCF77_CHANNEL].CnSC & TPM_CnSC_CHF_MASK) == 0)
+    {
+        return;
+    }
+
+    const uint16_t since = (uint16_t)(TPM0->CNT -
+        TPM0->CONTROLS[DCF77_CHANNEL].CnV);
+
+    // Clear the flag
+    TPM0->CONTROLS[DCF77_CHANNEL].CnSC |= TPM_CnSC_CHF_MASK;
+
+    // TPM0 counts at the peripheral clock
+    const uint64_t t = rtc_get_timestamp() -
+        (((uint32_t)since * RTC_TIMESTAMP_HZ) / clk_periph_hz());
+
+    const bool level = gpio_read(GPIO_D, 1UL << DCF77_PIN) != DCF77_ACTIVE_LOW;
+
+    if(level && !in_pulse)
+    {
+        dcf77_second(t, &xHigherPriorityTaskWoken);
+    }
+    else if(!level && in_pulse)
+    {
+        dcf77_bit(t);
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
@@ -0,0 +1,63 @@
+/*! ***************************************************************************
+ *
+ * \brief     DCF77 time signal receiver
+ * \file      dcf77.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef DCF77_H
+#define DCF77_H
+
+#include <MKL25Z4.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*!
+ * \brief Task notification index used to signal a received minute frame
+ */
+#ifndef DCF77_NOTIFY_INDEX
+#define DCF77_NOTIFY_INDEX (0)
+#endif
+
+/*!
+ * \brief Set to 1 if the receiver output is low during a pulse
+ */
+#ifndef DCF77_ACTIVE_LOW
+#define DCF77_ACTIVE_LOW (0)
+#endif
+
+extern uint32_t dcf77_frames;
+extern uint32_t dcf77_errors;
+
+// Function prototypes
+void dcf77_init(void);
+void dcf77_fix_start(void);
+void dcf77_fix_stop(void);
+bool dcf77_fix_wait(const TickType_t timeout);
+
+#endif // DCF77_H
@@ -0,0 +1,101 @@
+/*! ***************************************************************************
+ *
+ * \brief     Calibrated us delays
+ * \file      delay.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <MKL25Z4.h>
+
+#include "delay.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timer.h"
+
+/*!
+ * \brief Waits on the SysTick counter
+ *
+ * SysTick counts down at the core clock, so the delay follows SystemCoreClock
+ * at every CLOCK_SETUP and optimisation level. Before the scheduler starts,
+ * SysTick is started free-running, vPortSetupTimerInterrupt() resets it for
+ * the tick. A preemption longer than a SysTick period makes the delay longer,
+ * never shorter.
+ *
+ * \param[in]  us  Delay in us
+ */
+static void delay_spin(const uint32_t us)
+{
+    if(!(SysTick->CTRL & SysTick_CTRL_ENABLE_Msk))
+    {
+        SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+        SysTick->VAL = 0;
+        SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+    }
+
+    uint32_t left = us * (SystemCoreClock / 1000000UL);
+    uint32_t last = SysTick->VAL;
+
+    while(left > 0)
+    {
+        const uint32_t now = SysTick->VAL;
+
+        // The counter reloads after it reached 0
+        const uint32_t elapsed = (now <= last) ? (last - now) :
+            (last + SysTick->LOAD + 1 - now);
+
+        if(elapsed >= left)
+        {
+            break;
+        }
+
+        left -= elapsed;
+        last = now;
+    }
+}
+
+/*!
+ * \brief Waits at least a number of us
+ *
+ * From a task with the scheduler running and interrupts enabled, delays of
+ * DELAY_BLOCK_US and longer block the task on the timer service, see
+ * tim_delay_us(). Shorter delays, and all delays from an interrupt handler,
+ * a critical section or before the scheduler starts, wait on SysTick.
+ *
+ * \param[in]  us  Delay in us, 0 .. TIM_MAX_US
+ */
+void delay_us(const uint32_t us)
+{
+    if((us >= DELAY_BLOCK_US) &&
+       (__get_IPSR() == 0) && (__get_PRIMASK() == 0) &&
+       (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING))
+    {
+        tim_delay_us(us);
+        return;
+    }
+
+    delay_spin(us);
+}
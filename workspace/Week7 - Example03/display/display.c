@@ -0,0 +1,490 @@
+/*! ***************************************************************************
+ *
+ * \brief     Double buffered display server for the SSD1306
+ * \file      display.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <string.h>
+
+#include "display.h"
+#include "bringup.h"
+#include "mono.h"
+#include "task.h"
+#include "semphr.h"
+#include "sections.h"
+
+#if (DISPLAY_PANELS < 1) || (DISPLAY_PANELS > 2)
+#error "DISPLAY_PANELS must be 1 or 2"
+#endif
+
+/// An input whose result waits to be shown
+typedef struct
+{
+    wcet_t *latency;
+    uint32_t stamp;
+}display_trace_t;
+
+/// A display, its back and front buffer
+typedef struct
+{
+    /// The back buffer the drawing tasks render into, with its font and
+    /// cursor, protected by the mutex
+    ssd1306_t oled;
+
+    /// Dirty ranges of the front buffer that are not sent yet
+    ssd1306_dirty_t front_dirty;
+
+    SemaphoreHandle_t mutex;
+    StaticSemaphore_t mutex_buffer;
+
+    /// Traces added with display_trace() since the last flip, protected by
+    /// the mutex
+    display_trace_t traces[DISPLAY_TRACES];
+    uint32_t n_traces;
+}display_panel_t;
+
+/*!
+ * \brief Back buffers, cleared by ssd1306_init()
+ */
+__BSS_NOCLEAR static __attribute__((aligned(4))) uint8_t back[DISPLAY_PANELS][SSD1306_SIZE];
+
+/*!
+ * \brief Front buffers
+ *
+ * Only accessed by the display task. The I2C1 DMA reads from them, so they
+ * are placed in SRAM_U.
+ */
+static __BSS_SRAM_U __attribute__((aligned(4))) uint8_t front[DISPLAY_PANELS][SSD1306_SIZE];
+
+static display_panel_t panels[DISPLAY_PANELS] =
+{
+    {.oled = SSD1306_DISPLAY_INIT(back[0], SSD1306_SLAVE_ADDRESS)},
+#if (DISPLAY_PANELS > 1)
+    {.oled = SSD1306_DISPLAY_INIT(back[1], SSD1306_SLAVE_ADDRESS ^ 0x02)},
+#endif
+};
+
+/*!
+ * \brief Handle of the display task, notified with the bit of a display for
+ *        every flip request
+ */
+static TaskHandle_t display_task = NULL;
+
+/*!
+ * \brief Memory of the display task
+ */
+static StaticTask_t display_tcb;
+__BSS_NOCLEAR static StackType_t display_stack[configMINIMAL_STACK_SIZE];
+
+static uint8_t display_orientation = 0;
+
+/*!
+ * \brief Tick count of the last call of display_activity()
+ */
+static volatile TickType_t last_activity = 0;
+
+/*!
+ * \brief Shortest time in ticks from one frame to the next, 0 for none
+ */
+static volatile TickType_t frame_ticks = 0;
+
+/*!
+ * \brief Power state, only changed by the display task
+ */
+static volatile display_power_t power = DISPLAY_ON;
+
+// The reset time counts from power up, it overlaps the other devices
+static const bringup_step_t display_step =
+    BRINGUP_STEP("Oled", BRINGUP_OLED, 0, DISPLAY_RESET_DELAY_MS);
+
+/*!
+ * \brief Returns the power state for the time since the last activity
+ */
+static display_power_t display_idle_power(const TickType_t idle)
+{
+    if((DISPLAY_OFF_MS > 0) && (idle >= pdMS_TO_TICKS(DISPLAY_OFF_MS)))
+    {
+        return DISPLAY_OFF;
+    }
+
+    if((DISPLAY_DIM_MS > 0) && (idle >= pdMS_TO_TICKS(DISPLAY_DIM_MS)))
+    {
+        return DISPLAY_DIMMED;
+    }
+
+    return DISPLAY_ON;
+}
+
+/*!
+ * \brief Returns the time until the next power state change without
+ *        activity
+ */
+static TickType_t display_idle_timeout(const TickType_t idle)
+{
+    TickType_t timeout = portMAX_DELAY;
+
+    if((DISPLAY_DIM_MS > 0) && (idle < pdMS_TO_TICKS(DISPLAY_DIM_MS)))
+    {
+        timeout = pdMS_TO_TICKS(DISPLAY_DIM_MS) - idle;
+    }
+    else if((DISPLAY_OFF_MS > 0) && (idle < pdMS_TO_TICKS(DISPLAY_OFF_MS)))
+    {
+        timeout = pdMS_TO_TICKS(DISPLAY_OFF_MS) - idle;
+    }
+
+    return timeout;
+}
+
+/*!
+ * \brief Sends the commands of a power state change
+ */
+static void display_set_power(const display_power_t state)
+{
+    if(state == power)
+    {
+        return;
+    }
+
+    for(uint32_t p=0; p<DISPLAY_PANELS; p++)
+    {
+        ssd1306_t *oled = &panels[p].oled;
+
+        if(state == DISPLAY_OFF)
+        {
+            ssd1306_setpower(oled, false);
+        }
+        else
+        {
+            ssd1306_setcontrast(oled, (state == DISPLAY_DIMMED) ?
+                DISPLAY_DIM_CONTRAST : DISPLAY_CONTRAST);
+
+            if(power == DISPLAY_OFF)
+            {
+                ssd1306_setpower(oled, true);
+            }
+        }
+    }
+
+    power = state;
+}
+
+/*!
+ * \brief Copies the back buffer of a display to its front buffer
+ *
+ * \param[in]   p      Display
+ * \param[out]  shown  The traces shown by this flip
+ *
+ * \return Number of traces in \p shown
+ */
+static uint32_t display_take(const uint32_t p, display_trace_t shown[])
+{
+    display_panel_t *d = &panels[p];
+    uint32_t n_shown;
+
+    xSemaphoreTake(d->mutex, portMAX_DELAY);
+    {
+        ssd1306_flip(&d->oled, front[p], &d->front_dirty);
+
+        n_shown = d->n_traces;
+        (void)memcpy(shown, d->traces, n_shown * sizeof(d->traces[0]));
+        d->n_traces = 0;
+    }
+    xSemaphoreGive(d->mutex);
+
+    return n_shown;
+}
+
+/*!
+ * \brief Records the latency of the traces of a display that was sent
+ */
+static void display_record(const display_trace_t shown[], const uint32_t n)
+{
+    for(uint32_t i=0; i<n; i++)
+    {
+        wcet_record(shown[i].latency, mono_us32() - shown[i].stamp);
+    }
+}
+
+/*!
+ * \brief Display task
+ *
+ * Owns the I2C bus and the front buffers. For every flip request the dirty
+ * parts of the back buffer are copied to the front buffer, which only holds
+ * the lock of that display for the copy. The front buffer is then streamed
+ * to the Oled display without holding any lock, so drawing tasks can render
+ * the next frame in the meantime. Flip requests that arrive during a
+ * transfer are combined into one.
+ *
+ * With display_set_interval() the task waits after every frame, so the
+ * flip requests of that time are combined into the next frame.
+ *
+ * When both displays have changes, their dirty pages are sent one of each
+ * in turn, see ssd1306_update_page(), so a full screen of one display does
+ * not delay a small change of the other by a full frame.
+ *
+ * Without display_activity() the displays are dimmed after DISPLAY_DIM_MS
+ * and turned off after DISPLAY_OFF_MS. While they are off, flip requests
+ * are not sent. The changes stay marked dirty in the back buffers and are
+ * sent at once when the displays are turned on again.
+ */
+static void vDisplayTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    // Wait until the oled display is out of reset state
+    (void)bringup_begin(&display_step, portMAX_DELAY);
+
+    // ssd1306_init() clears the back buffer
+    for(uint32_t p=0; p<DISPLAY_PANELS; p++)
+    {
+        xSemaphoreTake(panels[p].mutex, portMAX_DELAY);
+        {
+            ssd1306_init(&panels[p].oled);
+            ssd1306_setorientation(&panels[p].oled, display_orientation);
+        }
+        xSemaphoreGive(panels[p].mutex);
+    }
+
+    bringup_done(&display_step, true);
+
+    last_activity = xTaskGetTickCount();
+
+    // Show the initial contents
+    xTaskNotify(xTaskGetCurrentTaskHandle(), (1U << DISPLAY_PANELS) - 1,
+                eSetBits);
+
+    for( ;; )
+    {
+        const TickType_t idle = xTaskGetTickCount() - last_activity;
+        uint32_t requested = 0;
+
+        (void)xTaskNotifyWait(0, UINT32_MAX, &requested,
+                              display_idle_timeout(idle));
+
+        const display_power_t was = power;
+
+        display_set_power(display_idle_power(xTaskGetTickCount() - last_activity));
+
+        // Nothing is sent while off, the changes are sent when turned on
+        if(power == DISPLAY_OFF)
+        {
+            continue;
+        }
+
+        if(was == DISPLAY_OFF)
+        {
+            requested = (1U << DISPLAY_PANELS) - 1;
+        }
+
+        // The traces are shown by this flip
+        display_trace_t shown[DISPLAY_PANELS][DISPLAY_TRACES];
+        uint32_t n_shown[DISPLAY_PANELS] = {0};
+        uint32_t sending = 0;
+
+        for(uint32_t p=0; p<DISPLAY_PANELS; p++)
+        {
+            if((requested & (1U << p)) != 0)
+            {
+                n_shown[p] = display_take(p, shown[p]);
+                sending |= (1U << p);
+            }
+        }
+
+        // A single display is sent at once, a full screen in one transfer
+        for(uint32_t p=0; p<DISPLAY_PANELS; p++)
+        {
+            if(sending == (1U << p))
+            {
+                ssd1306_update_buffer(&panels[p].oled, front[p],
+                                      &panels[p].front_dirty);
+                display_record(shown[p], n_shown[p]);
+                sending = 0;
+            }
+        }
+
+        // Otherwise a dirty page of every display in turn
+        while(sending != 0)
+        {
+            for(uint32_t p=0; p<DISPLAY_PANELS; p++)
+            {
+                if(((sending & (1U << p)) != 0) &&
+                   !ssd1306_update_page(&panels[p].oled, front[p],
+                                        &panels[p].front_dirty))
+                {
+                    display_record(shown[p], n_shown[p]);
+                    sending &= ~(1U << p);
+                }
+            }
+        }
+
+        const TickType_t ticks = frame_ticks;
+
+        if(ticks > 0)
+        {
+            vTaskDelay(ticks);
+        }
+    }
+}
+
+/*!
+ * \brief Creates the display task
+ *
+ * After this call, only the display task may access the I2C1 bus and the
+ * Oled displays. Drawing tasks use the ssd1306 drawing functions on the
+ * back buffer returned by display_lock() until display_unlock() and call
+ * display_flip() to show the result. They must not call ssd1306_update() or
+ * any function that sends commands to the display.
+ *
+ * \param[in]  priority     Priority of the display task
+ * \param[in]  orientation  Orientation of the displays, see
+ *                          ssd1306_setorientation()
+ */
+void display_init(const UBaseType_t priority, const uint8_t orientation)
+{
+    display_orientation = orientation;
+
+    for(uint32_t p=0; p<DISPLAY_PANELS; p++)
+    {
+        panels[p].mutex = xSemaphoreCreateMutexStatic(&panels[p].mutex_buffer);
+        vQueueAddToRegistry(panels[p].mutex, (p == 0) ? "back_mutex" : "back_mutex1");
+    }
+
+    display_task = xTaskCreateStatic(vDisplayTask, "Display",
+        configMINIMAL_STACK_SIZE, NULL, priority, display_stack, &display_tcb);
+}
+
+/*!
+ * \brief Takes the back buffer of a display for drawing
+ *
+ * Keep the lock only while drawing. The lock is never held during bus I/O.
+ * The back buffer has its own font and cursor, so tasks that draw on
+ * different displays do not wait for each other.
+ *
+ * \param[in]  panel    Display, 0 to DISPLAY_PANELS-1
+ * \param[in]  timeout  Maximum time to wait for the lock
+ *
+ * \return The back buffer to draw into, NULL on timeout
+ */
+ssd1306_t *display_lock(const uint32_t panel, const TickType_t timeout)
+{
+    if(xSemaphoreTake(panels[panel].mutex, timeout) != pdTRUE)
+    {
+        return NULL;
+    }
+
+    return &panels[panel].oled;
+}
+
+/*!
+ * \brief Releases the back buffer of a display
+ */
+void display_unlock(const uint32_t panel)
+{
+    xSemaphoreGive(panels[panel].mutex);
+}
+
+/*!
+ * \brief Requests the display task to show the back buffer of a display
+ *
+ * Does not block. Can be called with or without holding the lock.
+ */
+void display_flip(const uint32_t panel)
+{
+    xTaskNotify(display_task, 1U << panel, eSetBits);
+}
+
+/*!
+ * \brief Limits the frame rate of the displays
+ *
+ * Drawing tasks keep drawing and flipping at their own rate, the frames in
+ * between are not sent. This saves the copies and the bus transfers, the
+ * drawing itself is up to the tasks. Takes effect after the next frame.
+ *
+ * \param[in]  ms  Shortest time from one frame to the next, 0 for no limit
+ */
+void display_set_interval(const uint32_t ms)
+{
+    frame_ticks = pdMS_TO_TICKS(ms);
+}
+
+/*!
+ * \brief Measures the latency from an input to a display
+ *
+ * Call holding the lock, after drawing the result of the input. When the
+ * next flip was sent to the display, the time from \p stamp is recorded in
+ * \p latency, so it includes the wait for the display task and the bus
+ * transfer. A display that is off adds the time until it is turned on.
+ *
+ * \param[in]      panel    Display, 0 to DISPLAY_PANELS-1
+ * \param[in,out]  latency  Profile of the input, see wcet_init()
+ * \param[in]      stamp    mono_us32() of the input
+ *
+ * \return False if DISPLAY_TRACES traces are waiting already
+ */
+bool display_trace(const uint32_t panel, wcet_t *latency, const uint32_t stamp)
+{
+    display_panel_t *d = &panels[panel];
+
+    if(d->n_traces >= DISPLAY_TRACES)
+    {
+        return false;
+    }
+
+    d->traces[d->n_traces].latency = latency;
+    d->traces[d->n_traces].stamp = stamp;
+    d->n_traces++;
+
+    return true;
+}
+
+/*!
+ * \brief Restarts the inactivity time of the displays
+ *
+ * Call for every user input, such as a switch event or motion. A dimmed or
+ * switched off display is turned on at once. Does not block, call it from
+ * a task.
+ */
+void display_activity(void)
+{
+    last_activity = xTaskGetTickCount();
+
+    if(power != DISPLAY_ON)
+    {
+        xTaskNotify(display_task, 0, eSetBits);
+    }
+}
+
+/*!
+ * \brief Returns the power state of the displays
+ *
+ * A drawing task can skip drawing that is not worth it while the display
+ * is off. The changes are shown when the display is turned on again.
+ */
+display_power_t display_power(void)
+{
+    return power;
+}
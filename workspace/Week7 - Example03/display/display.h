@@ -0,0 +1,106 @@
+/*! ***************************************************************************
+ *
+ * \brief     Double buffered display server for the SSD1306
+ * \file      display.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "ssd1306.h"
+#include "wcet.h"
+
+/*!
+ * \brief Time in ms the Oled display needs to get out of reset after power up
+ */
+#define DISPLAY_RESET_DELAY_MS (200)
+
+/*!
+ * \brief Time in ms without activity until the display is dimmed, 0 to never
+ *        dim it
+ */
+#ifndef DISPLAY_DIM_MS
+#define DISPLAY_DIM_MS         (30000)
+#endif
+
+/*!
+ * \brief Time in ms without activity until the display is turned off, 0 to
+ *        keep it on
+ */
+#ifndef DISPLAY_OFF_MS
+#define DISPLAY_OFF_MS         (60000)
+#endif
+
+/*!
+ * \brief Contrast of the display when it is on and when it is dimmed
+ */
+#define DISPLAY_CONTRAST       (0xFF)
+#ifndef DISPLAY_DIM_CONTRAST
+#define DISPLAY_DIM_CONTRAST   (0x10)
+#endif
+
+/*!
+ * \brief Number of Oled displays on I2C1, 1 or 2
+ *
+ * Display 0 is at SSD1306_SLAVE_ADDRESS, display 1 has the other level of
+ * SA0. Every display has its own back buffer and lock, so tasks that draw
+ * on different displays do not wait for each other.
+ */
+#ifndef DISPLAY_PANELS
+#define DISPLAY_PANELS         (1)
+#endif
+
+/*!
+ * \brief Number of latency traces per display that wait for it at once
+ */
+#ifndef DISPLAY_TRACES
+#define DISPLAY_TRACES         (4)
+#endif
+
+/// Power state of the display
+typedef enum
+{
+    DISPLAY_ON,
+    DISPLAY_DIMMED,
+    DISPLAY_OFF,
+}display_power_t;
+
+void display_init(const UBaseType_t priority, const uint8_t orientation);
+
+ssd1306_t *display_lock(const uint32_t panel, const TickType_t timeout);
+void display_unlock(const uint32_t panel);
+void display_flip(const uint32_t panel);
+void display_set_interval(const uint32_t ms);
+bool display_trace(const uint32_t panel, wcet_t *latency, const uint32_t stamp);
+
+void display_activity(void);
+display_power_t display_power(void);
+
+#endif // DISPLAY_H
@@ -0,0 +1,473 @@
+/*! ***************************************************************************
+ *
+ * \brief     DMA channel manager
+ * \file      dma.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <string.h>
+
+#include "dma.h"
+#include "sections.h"
+
+// State of a channel
+typedef struct
+{
+    volatile bool claimed;
+    dma_isr_t isr;
+    void *arg;
+    TaskHandle_t volatile waiting; ///< Task in dma_acquire()
+}dma_channel_t;
+
+static dma_channel_t channels[DMA_CHANNELS];
+
+#if (DMA_RING_ARENA > 0)
+#if ((DMA_RING_ARENA & (DMA_RING_ARENA - 1)) != 0) || \
+    (DMA_RING_ARENA < DMA_RING_MIN) || (DMA_RING_ARENA > DMA_RING_MAX)
+#error "DMA_RING_ARENA must be a power of two of DMA_RING_MIN to DMA_RING_MAX"
+#endif
+
+// Blocks of DMA_RING_MIN bytes in the arena
+#define DMA_RING_BLOCKS (DMA_RING_ARENA / DMA_RING_MIN)
+
+// The arena of dma_ring_alloc() and a bit per block, set if it is allocated
+static uint8_t ring_arena[DMA_RING_ARENA] __DMA_RING(DMA_RING_ARENA);
+static uint32_t ring_used[(DMA_RING_BLOCKS + 31) / 32];
+#endif
+
+/*!
+ * \brief Masks interrupts, also from an interrupt handler
+ */
+static inline uint32_t dma_lock(void)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+static inline void dma_unlock(const uint32_t primask)
+{
+    __set_PRIMASK(primask);
+}
+
+/*!
+ * \brief Claims a DMA channel until dma_release()
+ *
+ * Drivers that keep a channel claim it once at initialisation, drivers that
+ * need one only while they run claim it at the start and release it at the
+ * end, so a channel is shared by time-multiplexing among drivers that do not
+ * run together.
+ *
+ * The clocks of DMAMUX and DMA are on while a channel is claimed. The
+ * interrupt is enabled with dma_irq_enable().
+ *
+ * \param[in]  ch   Channel 0 to 3, or DMA_ANY for the highest free channel
+ * \param[in]  isr  Called by the interrupt handler of the channel, NULL if
+ *                  the DONE flag is only cleared
+ * \param[in]  arg  Argument of \p isr
+ *
+ * \return The claimed channel, or -1 if it is claimed by another driver
+ */
+int32_t dma_claim(const int32_t ch, const dma_isr_t isr, void *arg)
+{
+    int32_t claimed = -1;
+
+    if(ch >= DMA_CHANNELS)
+    {
+        return -1;
+    }
+
+    const uint32_t primask = dma_lock();
+    {
+        for(int32_t i=DMA_CHANNELS-1; i>=0; i--)
+        {
+            if(((ch == DMA_ANY) || (ch == i)) && !channels[i].claimed)
+            {
+                channels[i].claimed = true;
+                channels[i].isr = isr;
+                channels[i].arg = arg;
+                claimed = i;
+                break;
+            }
+        }
+    }
+    dma_unlock(primask);
+
+    if(claimed >= 0)
+    {
+        clk_gate_acquire(CLK_GATE_DMAMUX);
+        clk_gate_acquire(CLK_GATE_DMA);
+    }
+
+    return claimed;
+}
+
+/*!
+ * \brief Claims a DMA channel, waiting until the owner releases it
+ *
+ * One task waits per channel, with DMA_ANY on every claimed channel that has
+ * no waiting task. Call from a task only.
+ *
+ * \param[in]  ch       Channel 0 to 3, or DMA_ANY
+ * \param[in]  isr      See dma_claim()
+ * \param[in]  arg      Argument of \p isr
+ * \param[in]  timeout  Ticks to wait, portMAX_DELAY to wait forever
+ *
+ * \return The claimed channel, or -1 after the timeout or if another task
+ *         waits for the channel
+ */
+int32_t dma_acquire(const int32_t ch, const dma_isr_t isr, void *arg,
+    const TickType_t timeout)
+{
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    TickType_t remaining = timeout;
+    TimeOut_t start;
+    int32_t claimed;
+    bool waiting;
+
+    vTaskSetTimeOutState(&start);
+
+    for(;;)
+    {
+        // Registered before the claim, so a release in between notifies
+        waiting = false;
+
+        const uint32_t primask = dma_lock();
+        {
+            for(int32_t i=0; i<DMA_CHANNELS; i++)
+            {
+                if(((ch == DMA_ANY) || (ch == i)) &&
+                   ((channels[i].waiting == NULL) ||
+                    (channels[i].waiting == self)))
+                {
+                    channels[i].waiting = self;
+                    waiting = true;
+                }
+            }
+        }
+        dma_unlock(primask);
+
+        claimed = waiting ? dma_claim(ch, isr, arg) : -1;
+
+        if(!waiting || (claimed >= 0) ||
+           (xTaskCheckForTimeOut(&start, &remaining) != pdFALSE))
+        {
+            break;
+        }
+
+        (void)ulTaskNotifyTakeIndexed(DMA_NOTIFY_INDEX, pdTRUE, remaining);
+    }
+
+    const uint32_t primask = dma_lock();
+    {
+        for(int32_t i=0; i<DMA_CHANNELS; i++)
+        {
+            if(channels[i].waiting == self)
+            {
+                channels[i].waiting = NULL;
+            }
+        }
+    }
+    dma_unlock(primask);
+
+    return claimed;
+}
+
+/*!
+ * \brief Stops a channel and gives it back
+ *
+ * Disables the interrupt, the requests and the DMAMUX routing, releases the
+ * clocks and wakes a task waiting in dma_acquire(). Also called from the interrupt handler of
+ * the owner.
+ *
+ * \param[in]  ch  Claimed channel
+ */
+void dma_release(const int32_t ch)
+{
+    if((ch < 0) || (ch >= DMA_CHANNELS) || !channels[ch].claimed)
+    {
+        return;
+    }
+
+    NVIC_DisableIRQ((IRQn_Type)(DMA0_IRQn + ch));
+
+    DMA0->DMA[ch].DCR &= ~DMA_DCR_ERQ_MASK;
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    DMAMUX0->CHCFG[ch] = 0;
+
+    TaskHandle_t waiting;
+
+    const uint32_t primask = dma_lock();
+    {
+        channels[ch].isr = NULL;
+        channels[ch].arg = NULL;
+        channels[ch].claimed = false;
+        waiting = channels[ch].waiting;
+    }
+    dma_unlock(primask);
+
+    clk_gate_release(CLK_GATE_DMA);
+    clk_gate_release(CLK_GATE_DMAMUX);
+
+    if(waiting == NULL)
+    {
+        return;
+    }
+
+    if(__get_IPSR() != 0)
+    {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveIndexedFromISR(waiting, DMA_NOTIFY_INDEX, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+    else
+    {
+        xTaskNotifyGiveIndexed(waiting, DMA_NOTIFY_INDEX);
+    }
+}
+
+/*!
+ * \brief Returns true if a channel is claimed
+ */
+bool dma_claimed(const int32_t ch)
+{
+    return (ch >= 0) && (ch < DMA_CHANNELS) && channels[ch].claimed;
+}
+
+/*!
+ * \brief Routes a DMAMUX request source to a claimed channel
+ *
+ * \param[in]  ch       Claimed channel
+ * \param[in]  source   Request source
+ * \param[in]  trigger  True to gate the requests with the PIT channel of
+ *                      the same number, channel 1 is triggered by PIT1
+ */
+void dma_route(const int32_t ch, const dma_source_t source,
+    const bool trigger)
+{
+    DMAMUX0->CHCFG[ch] = 0;
+    DMAMUX0->CHCFG[ch] = DMAMUX_CHCFG_ENBL_MASK |
+                         (trigger ? DMAMUX_CHCFG_TRIG_MASK : 0) |
+                         DMAMUX_CHCFG_SOURCE(source);
+}
+
+/*!
+ * \brief Enables the interrupt of a claimed channel
+ *
+ * \param[in]  ch        Claimed channel
+ * \param[in]  priority  IRQ_PRIO() of the client, see irq_prio.h
+ */
+void dma_irq_enable(const int32_t ch, const uint32_t priority)
+{
+    const IRQn_Type irq = (IRQn_Type)(DMA0_IRQn + ch);
+
+    NVIC_SetPriority(irq, priority);
+    NVIC_ClearPendingIRQ(irq);
+    NVIC_EnableIRQ(irq);
+}
+
+#if (DMA_RING_ARENA > 0)
+/*!
+ * \brief Returns true if all blocks from \p first on to \p first + \p n are
+ *        free, or sets or clears them
+ */
+static bool dma_ring_blocks(const uint32_t first, const uint32_t n,
+    const int32_t op)
+{
+    for(uint32_t b=first; b<(first + n); ++b)
+    {
+        const uint32_t mask = 1UL << (b % 32);
+
+        if(op > 0)
+        {
+            ring_used[b / 32] |= mask;
+        }
+        else if(op < 0)
+        {
+            ring_used[b / 32] &= ~mask;
+        }
+        else if(ring_used[b / 32] & mask)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+#endif
+
+/*!
+ * \brief Allocates a ring for circular DMA
+ *
+ * The ring is aligned to its size, so the DMA controller wraps the source or
+ * destination address at its end with dma_mod(size) in SMOD or DMOD and
+ * runs without re-arming. Every ring is placed at the first multiple of its
+ * size that is free, allocate the largest rings first to keep the arena in
+ * one piece. Rings that are fixed at build time are declared with
+ * __DMA_RING() instead, see sections.h.
+ *
+ * \param[in]  size  Bytes of the ring, a power of two of DMA_RING_MIN to
+ *                   DMA_RING_ARENA
+ *
+ * \return The ring, cleared, or NULL if the arena has no aligned block of
+ *         \p size free
+ */
+void *dma_ring_alloc(const uint32_t size)
+{
+#if (DMA_RING_ARENA > 0)
+    void *ring = NULL;
+
+    if((dma_mod(size) == 0) || (size > DMA_RING_ARENA))
+    {
+        return NULL;
+    }
+
+    const uint32_t n = size / DMA_RING_MIN;
+
+    taskENTER_CRITICAL();
+    {
+        for(uint32_t b=0; b<DMA_RING_BLOCKS; b+=n)
+        {
+            if(dma_ring_blocks(b, n, 0))
+            {
+                (void)dma_ring_blocks(b, n, 1);
+                ring = &ring_arena[b * DMA_RING_MIN];
+                break;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if(ring != NULL)
+    {
+        (void)memset(ring, 0, size);
+    }
+
+    return ring;
+#else
+    (void)size;
+
+    return NULL;
+#endif
+}
+
+/*!
+ * \brief Returns a ring of dma_ring_alloc() to the arena
+ *
+ * The DMA channel must be stopped.
+ *
+ * \param[in]  ring  The ring, NULL is ignored
+ * \param[in]  size  Bytes of the ring, as given to dma_ring_alloc()
+ */
+void dma_ring_free(void *ring, const uint32_t size)
+{
+#if (DMA_RING_ARENA > 0)
+    if(ring == NULL)
+    {
+        return;
+    }
+
+    const uint32_t offset = (uint32_t)((uint8_t *)ring - ring_arena);
+
+    configASSERT((offset < DMA_RING_ARENA) && ((offset % size) == 0));
+
+    taskENTER_CRITICAL();
+    {
+        (void)dma_ring_blocks(offset / DMA_RING_MIN, size / DMA_RING_MIN, -1);
+    }
+    taskEXIT_CRITICAL();
+#else
+    (void)ring;
+    (void)size;
+#endif
+}
+
+/*!
+ * \brief Returns the free bytes of the arena, not all in one aligned block
+ */
+uint32_t dma_ring_free_bytes(void)
+{
+    uint32_t bytes = 0;
+
+#if (DMA_RING_ARENA > 0)
+    taskENTER_CRITICAL();
+    {
+        for(uint32_t b=0; b<DMA_RING_BLOCKS; ++b)
+        {
+            bytes += dma_ring_blocks(b, 1, 0) ? DMA_RING_MIN : 0;
+        }
+    }
+    taskEXIT_CRITICAL();
+#endif
+
+    return bytes;
+}
+
+/*!
+ * \brief Hands the interrupt of a channel to its owner
+ */
+static void dma_irq(const int32_t ch)
+{
+    BaseType_t woken = pdFALSE;
+
+    TRACE_ISR_ENTER();
+
+    const uint32_t status = DMA0->DMA[ch].DSR_BCR;
+    const dma_isr_t isr = channels[ch].isr;
+
+    if(isr != NULL)
+    {
+        isr(channels[ch].arg, status, &woken);
+    }
+    else
+    {
+        DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    }
+
+    TRACE_ISR_EXIT();
+
+    portYIELD_FROM_ISR(woken);
+}
+
+void DMA0_IRQHandler(void)
+{
+    dma_irq(0);
+}
+
+void DMA1_IRQHandler(void)
+{
+    dma_irq(1);
+}
+
+void DMA2_IRQHandler(void)
+{
+    dma_irq(2);
+}
+
+void DMA3_IRQHandler(void)
+{
+    dma_irq(3);
+}
@@ -0,0 +1,156 @@
+/*! ***************************************************************************
+ *
+ * \brief     DMA channel manager
+ * \file      dma.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef DMA_H
+#define DMA_H
+
+#include <MKL25Z4.h>
+#include <stdbool.h>
+
+#include "clock.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*!
+ * \brief Number of DMA channels
+ */
+#define DMA_CHANNELS (4)
+
+/*!
+ * \brief Channel argument of dma_claim() and dma_acquire() for any free
+ *        channel
+ *
+ * The channels are tried from 3 down to 0, the fixed channels of the serial
+ * driver are the low ones.
+ */
+#define DMA_ANY (-1)
+
+/*!
+ * \brief Task notification index on which dma_acquire() waits for a channel
+ *
+ * Not shared with another mechanism, such as serDMA_TX_NOTIFY_INDEX of the
+ * serial DMA transmit path, which the same task may wait on.
+ */
+#ifndef DMA_NOTIFY_INDEX
+#define DMA_NOTIFY_INDEX (9)
+#endif
+
+/*!
+ * \brief Bytes of the arena of dma_ring_alloc(), a power of two, 0 for none
+ *
+ * The arena is a __DMA_RING() buffer, aligned to its size, so every block of
+ * it that starts at a multiple of its own size is aligned for SMOD and DMOD.
+ */
+#ifndef DMA_RING_ARENA
+#define DMA_RING_ARENA (0)
+#endif
+
+/*!
+ * \brief Smallest ring of the SMOD and DMOD fields in bytes
+ */
+#define DMA_RING_MIN (16)
+
+/*!
+ * \brief Largest ring of the SMOD and DMOD fields in bytes
+ */
+#define DMA_RING_MAX (256UL * 1024UL)
+
+/*!
+ * \brief DMAMUX request sources used by the drivers
+ */
+typedef enum
+{
+    DMA_SOURCE_UART0_RX = 2,
+    DMA_SOURCE_UART0_TX = 3,
+    DMA_SOURCE_SPI1_TX = 19,
+    DMA_SOURCE_I2C1 = 23,
+    DMA_SOURCE_TPM0_CH0 = 24, ///< Channel n is source 24 + n
+    DMA_SOURCE_TPM1_CH1 = 33,
+    DMA_SOURCE_ADC0 = 40,
+    DMA_SOURCE_TPM0_OVERFLOW = 54,
+    DMA_SOURCE_TPM2_OVERFLOW = 56,
+    DMA_SOURCE_ALWAYS = 60,
+}dma_source_t;
+
+/*!
+ * \brief Interrupt handler of a channel owner, called when the channel ended
+ *        a transfer or failed
+ *
+ * DONE and the error flags are still set, the handler clears them.
+ *
+ * \param[in]  arg     Argument given to dma_claim()
+ * \param[in]  status  DSR_BCR of the channel at the interrupt
+ * \param[out] woken   Set to pdTRUE if a higher priority task was woken
+ */
+typedef void (*dma_isr_t)(void *arg, const uint32_t status, BaseType_t *woken);
+
+int32_t dma_claim(const int32_t ch, const dma_isr_t isr, void *arg);
+int32_t dma_acquire(const int32_t ch, const dma_isr_t isr, void *arg,
+    const TickType_t timeout);
+void dma_release(const int32_t ch);
+bool dma_claimed(const int32_t ch);
+
+void dma_route(const int32_t ch, const dma_source_t source,
+    const bool trigger);
+void dma_irq_enable(const int32_t ch, const uint32_t priority);
+
+void *dma_ring_alloc(const uint32_t size);
+void dma_ring_free(void *ring, const uint32_t size);
+uint32_t dma_ring_free_bytes(void);
+
+/*!
+ * \brief Returns the SMOD or DMOD field of DCR for a ring
+ *
+ * \param[in]  size  Bytes of the ring, a power of two of DMA_RING_MIN to
+ *                   DMA_RING_MAX, aligned to its size
+ *
+ * \return 1 to 15, 0 (no ring) for any other size
+ */
+static inline uint32_t dma_mod(const uint32_t size)
+{
+    uint32_t mod = 1;
+
+    if((size & (size - 1)) != 0)
+    {
+        return 0;
+    }
+
+    for(uint32_t n=DMA_RING_MIN; n<=DMA_RING_MAX; n<<=1, ++mod)
+    {
+        if(n == size)
+        {
+            return mod;
+        }
+    }
+
+    return 0;
+}
+
+#endif // DMA_H
@@ -0,0 +1,388 @@
+/*! ***************************************************************************
+ *
+ * \brief     Q15 filters and block statistics, on CMSIS-DSP when available
+ * \file      dsp.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <math.h>
+#include <string.h>
+
+#include "dsp.h"
+
+#if (CMSIS_DSP_ENABLED == 1)
+#include "arm_math.h"
+#endif
+
+/*
+ * The loops follow the Cortex-M0 code of CMSIS-DSP: products are summed in
+ * 64 bits, shifted right by 15 - post_shift and saturated to 16 bits. The
+ * M0+ has no SIMD instructions, so CMSIS-DSP gains by processing a block
+ * per call, with the coefficients and the state in registers, instead of a
+ * function call and a state update per sample.
+ */
+
+#if (CMSIS_DSP_ENABLED == 0)
+// sin(2 pi i / DSP_RFFT_MAX) in Q15 for the first quarter wave
+static const int16_t dsp_sin_table[(DSP_RFFT_MAX / 4) + 1] =
+{
+        0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+     6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767,
+};
+
+static inline int16_t dsp_sat16(const int64_t v)
+{
+    return (v > INT16_MAX) ? INT16_MAX : (v < INT16_MIN) ? INT16_MIN : (int16_t)v;
+}
+
+/*!
+ * \brief Returns sin(2 pi i / DSP_RFFT_MAX) in Q15
+ */
+static int16_t dsp_sin(const uint32_t i)
+{
+    const uint32_t q = DSP_RFFT_MAX / 4;
+    const uint32_t k = i % q;
+
+    switch((i / q) % 4)
+    {
+        case 0:  return dsp_sin_table[k];
+        case 1:  return dsp_sin_table[q - k];
+        case 2:  return (int16_t)-dsp_sin_table[k];
+        default: return (int16_t)-dsp_sin_table[q - k];
+    }
+}
+#endif
+
+/*!
+ * \brief Initialises a biquad cascade and clears its state
+ *
+ * \param[out] f           Filter
+ * \param[in]  stages      Number of stages
+ * \param[in]  coeffs      DSP_BIQUAD_COEFFS per stage, kept by reference
+ * \param[in]  state       DSP_BIQUAD_STATE per stage, kept by reference
+ * \param[in]  post_shift  Scale of the coefficients, see DSP_BIQUAD_COEFFS
+ */
+void dsp_biquad_init(dsp_biquad_t *f, const uint8_t stages,
+    const int16_t *coeffs, int16_t *state, const int8_t post_shift)
+{
+    f->stages = stages;
+    f->post_shift = post_shift;
+    f->coeffs = coeffs;
+    f->state = state;
+
+    memset(state, 0, (size_t)stages * DSP_BIQUAD_STATE * sizeof(int16_t));
+}
+
+/*!
+ * \brief Sets the state as if the input was x forever
+ *
+ * Assumes a gain of 1 at DC, as of the low-pass of dsp_biquad_lowpass(), so
+ * a filter started on its first sample has no start-up ramp.
+ *
+ * \param[in,out] f  Filter
+ * \param[in]     x  Sample
+ */
+void dsp_biquad_preset(dsp_biquad_t *f, const int16_t x)
+{
+    for(uint32_t i=0; i<((uint32_t)f->stages * DSP_BIQUAD_STATE); ++i)
+    {
+        f->state[i] = x;
+    }
+}
+
+/*!
+ * \brief Filters a block of samples
+ *
+ * \p out may be the same array as \p in.
+ *
+ * \param[in,out] f    Filter, the state is updated
+ * \param[in]     in   Samples
+ * \param[out]    out  Filtered samples
+ * \param[in]     n    Number of samples
+ */
+void dsp_biquad(const dsp_biquad_t *f, const int16_t *in, int16_t *out,
+    const uint32_t n)
+{
+#if (CMSIS_DSP_ENABLED == 1)
+    const arm_biquad_casd_df1_inst_q15 s =
+    {
+        (int8_t)f->stages, f->state, (q15_t *)f->coeffs, f->post_shift
+    };
+
+    arm_biquad_cascade_df1_q15(&s, (q15_t *)in, out, n);
+#else
+    const uint32_t shift = 15 - f->post_shift;
+    const int16_t *src = in;
+
+    for(uint32_t st=0; st<f->stages; ++st)
+    {
+        const int16_t *c = &f->coeffs[st * DSP_BIQUAD_COEFFS];
+        int16_t *s = &f->state[st * DSP_BIQUAD_STATE];
+        int16_t x1 = s[0], x2 = s[1], y1 = s[2], y2 = s[3];
+
+        for(uint32_t i=0; i<n; ++i)
+        {
+            const int16_t x = src[i];
+            int64_t acc = (int32_t)c[0] * x;
+
+            acc += (int32_t)c[2] * x1;
+            acc += (int32_t)c[3] * x2;
+            acc += (int32_t)c[4] * y1;
+            acc += (int32_t)c[5] * y2;
+
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = dsp_sat16(acc >> shift);
+            out[i] = y1;
+        }
+
+        s[0] = x1;
+        s[1] = x2;
+        s[2] = y1;
+        s[3] = y2;
+
+        // The next stage filters the output of this one
+        src = out;
+    }
+#endif
+}
+
+/*!
+ * \brief Calculates the coefficients of a second order Butterworth low-pass
+ *
+ * Bilinear transform design with a gain of 1 at DC. Floating point, so
+ * call it once at initialisation and not per sample. Below about fs / 200
+ * the Q15 coefficients lose too much precision, cascade a decimation first.
+ *
+ * \param[out] coeffs  Coefficients of one stage
+ * \param[in]  fc      Cutoff frequency, in the unit of fs
+ * \param[in]  fs      Sample rate, above 2 * fc
+ *
+ * \return Post shift of the coefficients, for dsp_biquad_init()
+ */
+int8_t dsp_biquad_lowpass(int16_t coeffs[DSP_BIQUAD_COEFFS],
+    const uint32_t fc, const uint32_t fs)
+{
+    const float w0 = 2.0f * 3.14159265f * (float)fc / (float)fs;
+    const float cw = cosf(w0);
+    const float alpha = sinf(w0) / (2.0f * 0.70710678f);
+    const float a0 = 1.0f + alpha;
+
+    // With a post shift of 1 the coefficients are stored divided by 2, the
+    // feedback coefficients reach 2
+    coeffs[0] = (int16_t)lroundf(16384.0f * (1.0f - cw) / 2.0f / a0);
+    coeffs[1] = 0;
+    coeffs[2] = (int16_t)lroundf(16384.0f * (1.0f - cw) / a0);
+    coeffs[3] = coeffs[0];
+    coeffs[4] = (int16_t)lroundf(16384.0f * 2.0f * cw / a0);
+    coeffs[5] = (int16_t)lroundf(16384.0f * -(1.0f - alpha) / a0);
+
+    return 1;
+}
+
+/*!
+ * \brief Calculates the mean of a block, rounded towards zero
+ *
+ * \param[in]  x  Samples
+ * \param[in]  n  Number of samples, at least 1
+ *
+ * \return Mean
+ */
+int16_t dsp_mean(const int16_t *x, const uint32_t n)
+{
+#if (CMSIS_DSP_ENABLED == 1)
+    q15_t mean;
+
+    arm_mean_q15((q15_t *)x, n, &mean);
+
+    return mean;
+#else
+    int32_t sum = 0;
+
+    for(uint32_t i=0; i<n; ++i)
+    {
+        sum += x[i];
+    }
+
+    return (int16_t)(sum / (int32_t)n);
+#endif
+}
+
+/*!
+ * \brief Calculates the root mean square of a block
+ *
+ * The mean square is saturated to Q15, so the result is below 1.0 for
+ * samples of a full scale block.
+ *
+ * \param[in]  x  Samples
+ * \param[in]  n  Number of samples, at least 1
+ *
+ * \return Root mean square
+ */
+int16_t dsp_rms(const int16_t *x, const uint32_t n)
+{
+#if (CMSIS_DSP_ENABLED == 1)
+    q15_t rms;
+
+    arm_rms_q15((q15_t *)x, n, &rms);
+
+    return rms;
+#else
+    int64_t sum = 0;
+    uint32_t ms;
+
+    for(uint32_t i=0; i<n; ++i)
+    {
+        sum += (int32_t)x[i] * x[i];
+    }
+
+    ms = (uint32_t)dsp_sat16((sum / (int64_t)n) >> 15);
+
+    // The square root of ms in Q30 is in Q15
+    return (int16_t)dsp_isqrt(ms << 15);
+#endif
+}
+
+/*!
+ * \brief Calculates the spectrum of a block of real samples
+ *
+ * Writes bins 0 to n / 2 as pairs of real and imaginary parts to out[0] to
+ * out[n + 1], scaled by 2 / n, as arm_rfft_q15(). A sine of amplitude A in
+ * a bin gives a magnitude of A. Every stage halves its results, so nothing
+ * overflows, but small signals lose precision: scale the samples up to
+ * near full scale first.
+ *
+ * \param[in,out] in   n samples, overwritten
+ * \param[out]    out  2 * n values
+ * \param[in]     n    Number of samples, a power of 2 from 32 to
+ *                     DSP_RFFT_MAX
+ *
+ * \return false if n is not supported
+ */
+bool dsp_rfft(int16_t *in, int16_t *out, const uint32_t n)
+{
+    if((n < 32) || (n > DSP_RFFT_MAX) || ((n & (n - 1)) != 0))
+    {
+        return false;
+    }
+
+#if (CMSIS_DSP_ENABLED == 1)
+    arm_rfft_instance_q15 s;
+
+    if(arm_rfft_init_q15(&s, n, 0, 1) != ARM_MATH_SUCCESS)
+    {
+        return false;
+    }
+
+    arm_rfft_q15(&s, in, out);
+#else
+    uint32_t bits = 0;
+
+    while((1UL << bits) < n)
+    {
+        bits++;
+    }
+
+    // A complex FFT of n points on the samples in bit reversed order, the
+    // imaginary parts are 0
+    for(uint32_t i=0; i<n; ++i)
+    {
+        uint32_t r = 0;
+
+        for(uint32_t b=0; b<bits; ++b)
+        {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+
+        out[2 * r] = in[i];
+        out[(2 * r) + 1] = 0;
+    }
+
+    // Radix-2 decimation in time, W = exp(-j 2 pi k / len)
+    for(uint32_t len=2; len<=n; len<<=1)
+    {
+        const uint32_t half = len / 2;
+        const uint32_t step = DSP_RFFT_MAX / len;
+
+        for(uint32_t k=0; k<half; ++k)
+        {
+            const int32_t wr = dsp_sin((k * step) + (DSP_RFFT_MAX / 4));
+            const int32_t wi = -dsp_sin(k * step);
+
+            for(uint32_t i=k; i<n; i+=len)
+            {
+                int16_t *a = &out[2 * i];
+                int16_t *b = &out[2 * (i + half)];
+                const int32_t tr = ((wr * b[0]) - (wi * b[1])) >> 15;
+                const int32_t ti = ((wr * b[1]) + (wi * b[0])) >> 15;
+
+                b[0] = dsp_sat16((a[0] - tr) >> 1);
+                b[1] = dsp_sat16((a[1] - ti) >> 1);
+                a[0] = dsp_sat16((a[0] + tr) >> 1);
+                a[1] = dsp_sat16((a[1] + ti) >> 1);
+            }
+        }
+    }
+
+    // The stages scaled by 1 / n, arm_rfft_q15() by 2 / n
+    for(uint32_t i=0; i<(n + 2); ++i)
+    {
+        out[i] = dsp_sat16(2 * (int32_t)out[i]);
+    }
+#endif
+
+    return true;
+}
+
+/*!
+ * \brief Calculates the integer square root, rounded down
+ *
+ * \param[in]  x  Value
+ *
+ * \return Square root of x
+ */
+uint16_t dsp_isqrt(const uint32_t x)
+{
+    uint32_t root = 0;
+
+    for(uint32_t bit=(1UL << 15); bit!=0; bit>>=1)
+    {
+        if(((root | bit) * (root | bit)) <= x)
+        {
+            root |= bit;
+        }
+    }
+
+    return (uint16_t)root;
+}
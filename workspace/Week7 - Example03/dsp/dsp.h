@@ -0,0 +1,101 @@
+/*! ***************************************************************************
+ *
+ * \brief     Q15 filters and block statistics, on CMSIS-DSP when available
+ * \file      dsp.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef DSP_H
+#define DSP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// \name Definitions for the filters and statistics
+/// \{
+
+/*!
+ * \brief Set to 1 to run the functions on the CMSIS-DSP library, set by the
+ *        CMSIS_DSP option of CMakeLists.txt
+ *
+ * With 0 the same fixed-point arithmetic is done by the loops in dsp.c, so
+ * the results are the same and the code builds on the host as well.
+ */
+#ifndef CMSIS_DSP_ENABLED
+#define CMSIS_DSP_ENABLED (0)
+#endif
+
+/*!
+ * \brief Number of coefficients of a biquad stage
+ *
+ * The layout of arm_biquad_cascade_df1_q15(): b0, 0, b1, b2, a1, a2. The
+ * feedback coefficients are negated, y[n] = b0 x[n] + b1 x[n-1] +
+ * b2 x[n-2] + a1 y[n-1] + a2 y[n-2], and all are scaled by 2^-post_shift.
+ */
+#define DSP_BIQUAD_COEFFS (6)
+
+/*!
+ * \brief Number of state words of a biquad stage: x[n-1], x[n-2], y[n-1]
+ *        and y[n-2]
+ */
+#define DSP_BIQUAD_STATE  (4)
+
+/*!
+ * \brief Longest real FFT of dsp_rfft(), a power of 2
+ *
+ * The loops in dsp.c take their twiddle factors from a quarter wave sine
+ * table of DSP_RFFT_MAX / 4 + 1 entries.
+ */
+#define DSP_RFFT_MAX      (256)
+
+/// \}
+
+/// Cascade of Direct Form I biquad stages on Q15 samples
+typedef struct
+{
+    uint8_t stages;        ///< Number of second order stages
+    int8_t post_shift;     ///< Coefficients are scaled by 2^-post_shift
+    const int16_t *coeffs; ///< DSP_BIQUAD_COEFFS per stage
+    int16_t *state;        ///< DSP_BIQUAD_STATE per stage
+}
+dsp_biquad_t;
+
+// Function prototypes
+void dsp_biquad_init(dsp_biquad_t *f, const uint8_t stages,
+    const int16_t *coeffs, int16_t *state, const int8_t post_shift);
+void dsp_biquad_preset(dsp_biquad_t *f, const int16_t x);
+void dsp_biquad(const dsp_biquad_t *f, const int16_t *in, int16_t *out,
+    const uint32_t n);
+int8_t dsp_biquad_lowpass(int16_t coeffs[DSP_BIQUAD_COEFFS],
+    const uint32_t fc, const uint32_t fs);
+
+int16_t dsp_mean(const int16_t *x, const uint32_t n);
+int16_t dsp_rms(const int16_t *x, const uint32_t n);
+
+bool dsp_rfft(int16_t *in, int16_t *out, const uint32_t n);
+uint16_t dsp_isqrt(const uint32_t x);
+
+#endif // DSP_H
@@ -0,0 +1,284 @@
+/*! ***************************************************************************
+ *
+ * \brief     Event flags set from interrupts in bounded time
+ * \file      flags.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdbool.h>
+
+#include "flags.h"
+
+/*
+ * xEventGroupSetBitsFromISR() does not set the bits itself: the number of
+ * tasks it may have to release is unbounded, so it pends the set to the
+ * timer daemon, which then releases the waiting tasks. The waiting task
+ * runs after two switches, and only when the daemon has a higher priority
+ * than the interrupted task.
+ *
+ * Event flags have at most one waiting task. Its condition is stored with
+ * the flags, so setting flags is a single check in a critical section at a
+ * bounded time, from a task and from an interrupt alike. A released task is
+ * notified at FLAGS_NOTIFY_INDEX directly, and runs after one switch.
+ */
+
+/*!
+ * \brief Sets up event flags with no flag set and no waiting task
+ *
+ * \param[out]  flags  Event flags
+ */
+void flags_init(flags_t *flags)
+{
+    taskENTER_CRITICAL();
+    {
+        flags->bits = 0;
+        flags->waiter = NULL;
+        flags->mask = 0;
+        flags->options = 0;
+        flags->result = 0;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Checks the condition of a wait
+ *
+ * \return True if the flags release the wait
+ */
+static inline bool flags_met(const uint32_t bits, const uint32_t mask,
+                             const uint32_t options)
+{
+    if(options & FLAGS_ALL)
+    {
+        return (bits & mask) == mask;
+    }
+
+    return (bits & mask) != 0;
+}
+
+/*!
+ * \brief Sets flags and releases the waiting task if its condition is met,
+ *        called in a critical section
+ *
+ * \return Task to notify, NULL if none was released
+ */
+static TaskHandle_t flags_update(flags_t *flags, const uint32_t bits)
+{
+    TaskHandle_t task = flags->waiter;
+
+    flags->bits |= bits;
+
+    if((task == NULL) || !flags_met(flags->bits, flags->mask, flags->options))
+    {
+        return NULL;
+    }
+
+    flags->result = flags->bits;
+
+    if(flags->options & FLAGS_CLEAR)
+    {
+        flags->bits &= ~flags->mask;
+    }
+
+    flags->waiter = NULL;
+
+    return task;
+}
+
+/*!
+ * \brief Sets flags from a task
+ *
+ * Never blocks. The time it takes does not depend on the flags.
+ *
+ * \param[in,out]  flags  Event flags
+ * \param[in]      bits   Flags to set
+ *
+ * \return Flags afterwards, without the flags cleared by a released task
+ */
+uint32_t flags_set(flags_t *flags, const uint32_t bits)
+{
+    TaskHandle_t task;
+    uint32_t result;
+
+    taskENTER_CRITICAL();
+    {
+        task = flags_update(flags, bits);
+        result = flags->bits;
+    }
+    taskEXIT_CRITICAL();
+
+    if(task != NULL)
+    {
+        (void)xTaskNotifyGiveIndexed(task, FLAGS_NOTIFY_INDEX);
+    }
+
+    return result;
+}
+
+/*!
+ * \brief Sets flags from an interrupt
+ *
+ * Releases the waiting task in the interrupt, unlike
+ * xEventGroupSetBitsFromISR() it does not need the timer daemon.
+ *
+ * \param[in,out]  flags  Event flags
+ * \param[in]      bits   Flags to set
+ * \param[out]     woken  Set to pdTRUE if a task of a higher priority than
+ *                        the interrupted task was released, the interrupt
+ *                        should then end with portYIELD_FROM_ISR()
+ *
+ * \return Flags afterwards, without the flags cleared by a released task
+ */
+uint32_t flags_set_from_isr(flags_t *flags, const uint32_t bits,
+                            BaseType_t *woken)
+{
+    TaskHandle_t task;
+    uint32_t result;
+
+    const UBaseType_t status = taskENTER_CRITICAL_FROM_ISR();
+    {
+        task = flags_update(flags, bits);
+        result = flags->bits;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(status);
+
+    if(task != NULL)
+    {
+        vTaskNotifyGiveIndexedFromISR(task, FLAGS_NOTIFY_INDEX, woken);
+    }
+
+    return result;
+}
+
+/*!
+ * \brief Clears flags, must be called from a task
+ *
+ * \param[in,out]  flags  Event flags
+ * \param[in]      bits   Flags to clear
+ *
+ * \return Flags before they were cleared
+ */
+uint32_t flags_clear(flags_t *flags, const uint32_t bits)
+{
+    uint32_t result;
+
+    taskENTER_CRITICAL();
+    {
+        result = flags->bits;
+        flags->bits &= ~bits;
+    }
+    taskEXIT_CRITICAL();
+
+    return result;
+}
+
+/*!
+ * \brief Reads the flags, from a task or an interrupt
+ *
+ * \param[in]  flags  Event flags
+ *
+ * \return Flags that are set
+ */
+uint32_t flags_get(const flags_t *flags)
+{
+    return flags->bits;
+}
+
+/*!
+ * \brief Waits for flags to be set
+ *
+ * Only one task at a time waits for the same flags. The task is released
+ * by the flags_set() or flags_set_from_isr() that meets its condition. A
+ * notification at FLAGS_NOTIFY_INDEX that is left over from a wait that
+ * timed out while it was released is ignored.
+ *
+ * \param[in,out]  flags    Event flags
+ * \param[in]      mask     Flags to wait for, not 0
+ * \param[in]      options  FLAGS_ANY or FLAGS_ALL, or'ed with FLAGS_CLEAR
+ * \param[in]      timeout  Ticks to wait, 0 to poll
+ *
+ * \return Flags when the condition was met, before they were cleared, or
+ *         flags at the timeout. Test these with the mask to tell them apart.
+ */
+uint32_t flags_wait(flags_t *flags, const uint32_t mask,
+                    const uint32_t options, TickType_t timeout)
+{
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    TimeOut_t start;
+    uint32_t result;
+    bool waiting = false;
+
+    configASSERT(mask != 0);
+
+    taskENTER_CRITICAL();
+    {
+        result = flags->bits;
+
+        if(flags_met(result, mask, options))
+        {
+            if(options & FLAGS_CLEAR)
+            {
+                flags->bits &= ~mask;
+            }
+        }
+        else if(timeout > 0)
+        {
+            configASSERT(flags->waiter == NULL);
+
+            flags->mask = mask;
+            flags->options = options;
+            flags->waiter = self;
+            waiting = true;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    vTaskSetTimeOutState(&start);
+
+    while(waiting)
+    {
+        (void)ulTaskNotifyTakeIndexed(FLAGS_NOTIFY_INDEX, pdTRUE, timeout);
+
+        taskENTER_CRITICAL();
+        {
+            if(flags->waiter != self)
+            {
+                // Released
+                result = flags->result;
+                waiting = false;
+            }
+            else if(xTaskCheckForTimeOut(&start, &timeout) != pdFALSE)
+            {
+                flags->waiter = NULL;
+                result = flags->bits;
+                waiting = false;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return result;
+}
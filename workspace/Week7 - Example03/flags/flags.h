@@ -0,0 +1,94 @@
+/*! ***************************************************************************
+ *
+ * \brief     Event flags set from interrupts in bounded time
+ * \file      flags.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef FLAGS_H
+#define FLAGS_H
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// \name Definitions for the event flags
+/// \{
+
+/*!
+ * \brief Index of the task notification that releases the waiting task
+ *
+ * Not shared with another mechanism, a task that waits for flags can also
+ * write through the serial DMA, which waits on serDMA_TX_NOTIFY_INDEX.
+ */
+#ifndef FLAGS_NOTIFY_INDEX
+#define FLAGS_NOTIFY_INDEX (8)
+#endif
+
+/*!
+ * \brief Options of flags_wait()
+ *
+ * FLAGS_ANY waits for any flag of the mask, FLAGS_ALL for all of them.
+ * FLAGS_CLEAR clears the flags of the mask when the wait is released.
+ */
+#define FLAGS_ANY   (0)
+#define FLAGS_ALL   (1U << 0)
+#define FLAGS_CLEAR (1U << 1)
+
+/*!
+ * \brief Defines event flags with no flag set and no waiting task
+ *
+ * Example: static flags_t xSwFlags = FLAGS_INIT;
+ */
+#define FLAGS_INIT  {0}
+
+/// \}
+
+/// Event flags, 32 flags that one task at a time waits for
+///
+/// Define with FLAGS_INIT or set up with flags_init().
+typedef struct
+{
+    volatile uint32_t bits;     ///< Flags that are set
+    TaskHandle_t waiter;        ///< Task in flags_wait(), NULL if none
+    uint32_t mask;              ///< Flags the waiting task waits for
+    uint32_t options;           ///< Options of the waiting task
+    uint32_t result;            ///< Flags that released the waiting task
+}
+flags_t;
+
+// Function prototypes
+void flags_init(flags_t *flags);
+uint32_t flags_set(flags_t *flags, const uint32_t bits);
+uint32_t flags_set_from_isr(flags_t *flags, const uint32_t bits,
+                            BaseType_t *woken);
+uint32_t flags_clear(flags_t *flags, const uint32_t bits);
+uint32_t flags_get(const flags_t *flags);
+uint32_t flags_wait(flags_t *flags, const uint32_t mask,
+                    const uint32_t options, TickType_t timeout);
+
+#endif // FLAGS_H
@@ -0,0 +1,943 @@
+/*! ***************************************************************************
+ *
+ * \brief     Wear-levelled log store in the program flash
+ * \file      flashlog.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <MKL25Z4.h>
+#include <string.h>
+
+#include "flashlog.h"
+#include "sections.h"
+#include "serial.h"
+#include "xprintf.h"
+
+/*
+ * The log region is a ring of sectors at the top of the program flash,
+ * reserved by the FLASH_LOG region of the linker script. Every sector starts
+ * with a header of two words, FLOG_MAGIC and a sequence number, followed by
+ * records. A record is a header word holding the type in bits 0-7, the
+ * length in bits 8-15 and the CRC-16/CCITT-FALSE of type, length and payload
+ * in bits 16-31, followed by the payload padded to whole words.
+ *
+ * The payload is programmed before the header and the sequence number
+ * before the magic, so a write interrupted by a reset leaves a blank header
+ * and the record or sector is ignored. The sector after the one being
+ * written is kept erased, so opening a new sector never waits for an erase.
+ * Writing moves through all sectors in turn, which spreads the erases evenly
+ * over the region, and the records of all but the spare sector are kept.
+ *
+ * The KL25 can not read the flash while it is programmed or erased, so a
+ * command is started and waited for by a function in SRAM with interrupts
+ * masked. Programming a word takes 65 us, erasing a sector 2 ms typical and
+ * 14 ms at most, during which no interrupt is handled. All commands are
+ * issued by the flash log task at a low priority, a task that appends a
+ * record only copies it into a RAM page. FTFA_IRQHandler is not used.
+ *
+ * Settings that must survive the log, such as calibrations, are kept in the
+ * sector of the FLASH_CONFIG region instead, as records in the same format
+ * from offset 0. The newest record of a type is the setting. A setting is
+ * appended by the task that saves it, and when the sector is full the
+ * newest setting of every type is copied to RAM, the sector is erased and
+ * the settings are programmed again. A reset during that loses the
+ * settings, which are then all missing, never partly written.
+ */
+
+// Linker script symbols of the reserved region
+extern uint8_t __base_FLASH_LOG[];
+extern uint8_t __top_FLASH_LOG[];
+
+#define FLOG_BASE       ((uint32_t)__base_FLASH_LOG)
+#define FLOG_SECTORS    (((uint32_t)__top_FLASH_LOG - FLOG_BASE) / FLOG_SECTOR_SIZE)
+#define FLOG_SECTOR(i)  ((const uint32_t *)(FLOG_BASE + ((i) * FLOG_SECTOR_SIZE)))
+
+// Linker script symbol of the settings sector
+extern uint8_t __base_FLASH_CONFIG[];
+
+#define FLOG_CONFIG     ((const uint32_t *)__base_FLASH_CONFIG)
+
+// 'FLOG', the first word of a sector in use
+#define FLOG_MAGIC      (0x474F4C46UL)
+
+// Value of an erased word
+#define FLOG_BLANK      (0xFFFFFFFFUL)
+
+// Offset of the first record in a sector
+#define FLOG_FIRST      (8)
+
+// Current sector before the first one is opened
+#define FLOG_NONE       (0xFFFFFFFFUL)
+
+// FTFA commands
+#define FLOG_CMD_PROGRAM_LONGWORD (0x06)
+#define FLOG_CMD_ERASE_SECTOR     (0x09)
+
+#define FLOG_FSTAT_ERRORS (FTFA_FSTAT_ACCERR_MASK | FTFA_FSTAT_FPVIOL_MASK | \
+                           FTFA_FSTAT_MGSTAT0_MASK)
+
+// Size of a record with a payload of len bytes
+#define FLOG_RECORD_SIZE(len) (4 + (((len) + 3) & ~3UL))
+
+// Time a line of the report may wait for room in the serial transmit buffer
+#define FLOG_BLOCK_TIME pdMS_TO_TICKS(100)
+
+// Longest line written to the serial port, including the terminator
+#define FLOG_LINE_LEN   (56)
+
+// Stack size in words of the flash log task
+#define FLOG_STACK_DEPTH (configMINIMAL_STACK_SIZE + 16)
+
+// Result of a flash command
+typedef enum
+{
+    FLOG_OK,     ///< Done and verified
+    FLOG_BUSY,   ///< Not in RUN mode, try again later
+    FLOG_FAILED, ///< The FTFA reported an error or the read back differs
+}
+flog_result_t;
+
+// The RAM pages. Tasks append to pages[fill], the flash log task programs
+// the other page, from flush_pos up to flush_len.
+static uint32_t pages[2][FLOG_PAGE_SIZE / 4];
+static uint32_t fill = 0;
+static uint32_t fill_len = 0;
+static uint32_t flush_len = 0;
+static uint32_t flush_pos = 0;
+
+// The sector records are programmed to and the erased sector after it, only
+// written by the flash log task
+static volatile uint32_t cur = FLOG_NONE;
+static uint32_t cur_off = 0;
+static uint32_t cur_seq = 0;
+static uint32_t spare = 0;
+static bool spare_dirty = false;
+
+// Statistics
+static volatile uint32_t dropped = 0;
+static volatile uint32_t erases = 0;
+static volatile uint32_t failures = 0;
+
+// Settings programmed by flog_config_save(), used with the scheduler
+// suspended
+static uint32_t config_buf[FLOG_CONFIG_SIZE / 4];
+
+static TaskHandle_t flog_task = NULL;
+static StaticTask_t flog_tcb;
+__BSS_NOCLEAR static StackType_t flog_stack[FLOG_STACK_DEPTH];
+
+static void vFlogTask(void *pvParameters);
+
+/*!
+ * \brief Calculates the CRC-16/CCITT-FALSE of a record
+ *
+ * Polynomial 0x1021, initial value 0xFFFF, no reflection, no final XOR,
+ * over the type, the length and the payload.
+ */
+static uint16_t flog_crc16(const uint8_t type, const uint8_t *data,
+                           const uint32_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    for(uint32_t n=0; n<(len + 2); n++)
+    {
+        uint8_t b = (n == 0) ? type : (n == 1) ? (uint8_t)len : data[n - 2];
+
+        crc ^= (uint16_t)b << 8;
+
+        for(uint32_t i=0; i<8; i++)
+        {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/*!
+ * \brief Starts the command in the FCCOB registers and waits for it
+ *
+ * Always placed in SRAM, regardless of RAMFUNC_ENABLED, because the flash
+ * can not be read until the command is complete. Must be called with
+ * interrupts masked, and may not call any function.
+ *
+ * \return FSTAT after the command
+ */
+__attribute__((section(".ramfunc"), noinline))
+static uint8_t flog_launch(void)
+{
+    FTFA->FSTAT = FTFA_FSTAT_CCIF_MASK;
+
+    while(!(FTFA->FSTAT & FTFA_FSTAT_CCIF_MASK))
+    {}
+
+    return FTFA->FSTAT;
+}
+
+/*!
+ * \brief Executes a flash command
+ *
+ * Interrupts are masked for the duration of the command. The flash
+ * controller is set to stall accesses to the flash instead of failing them,
+ * for DMA transfers that read the flash, and its cache is cleared after the
+ * command. Commands are only given in RUN mode, the FTFA can not erase in
+ * VLPR.
+ *
+ * \param[in]  cmd    FTFA command
+ * \param[in]  addr   Flash address
+ * \param[in]  value  Word to program
+ */
+static flog_result_t flog_command(const uint8_t cmd, const uint32_t addr,
+                                  const uint32_t value)
+{
+    uint8_t fstat;
+
+    taskENTER_CRITICAL();
+    {
+        if(SMC->PMSTAT != SMC_PMSTAT_PMSTAT(1))
+        {
+            taskEXIT_CRITICAL();
+            return FLOG_BUSY;
+        }
+
+        MCM->PLACR |= MCM_PLACR_ESFC_MASK;
+
+        FTFA->FSTAT = FTFA_FSTAT_ACCERR_MASK | FTFA_FSTAT_FPVIOL_MASK;
+
+        FTFA->FCCOB0 = cmd;
+        FTFA->FCCOB1 = (uint8_t)(addr >> 16);
+        FTFA->FCCOB2 = (uint8_t)(addr >> 8);
+        FTFA->FCCOB3 = (uint8_t)addr;
+        FTFA->FCCOB4 = (uint8_t)(value >> 24);
+        FTFA->FCCOB5 = (uint8_t)(value >> 16);
+        FTFA->FCCOB6 = (uint8_t)(value >> 8);
+        FTFA->FCCOB7 = (uint8_t)value;
+
+        fstat = flog_launch();
+
+        MCM->PLACR = (MCM->PLACR & ~MCM_PLACR_ESFC_MASK) | MCM_PLACR_CFCC_MASK;
+    }
+    taskEXIT_CRITICAL();
+
+    return (fstat & FLOG_FSTAT_ERRORS) ? FLOG_FAILED : FLOG_OK;
+}
+
+/*!
+ * \brief Checks if n words from p are erased
+ */
+static bool flog_blank(const uint32_t *p, uint32_t n)
+{
+    while(n--)
+    {
+        if(*p++ != FLOG_BLANK)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Programs a word and verifies it
+ *
+ * Words that are still erased are not programmed.
+ */
+static flog_result_t flog_program(const uint32_t addr, const uint32_t value)
+{
+    flog_result_t r = FLOG_OK;
+
+    if(value != FLOG_BLANK)
+    {
+        r = flog_command(FLOG_CMD_PROGRAM_LONGWORD, addr, value);
+    }
+
+    if((r == FLOG_OK) && (*(const volatile uint32_t *)addr != value))
+    {
+        r = FLOG_FAILED;
+    }
+
+    return r;
+}
+
+/*!
+ * \brief Erases the spare sector if it is not blank
+ */
+static flog_result_t flog_erase_spare(void)
+{
+    const uint32_t *s = FLOG_SECTOR(spare);
+    flog_result_t r;
+
+    if(!spare_dirty)
+    {
+        return FLOG_OK;
+    }
+
+    r = flog_command(FLOG_CMD_ERASE_SECTOR, (uint32_t)s, 0);
+
+    if(r == FLOG_BUSY)
+    {
+        return r;
+    }
+
+    erases++;
+
+    if((r == FLOG_OK) && !flog_blank(s, FLOG_SECTOR_SIZE / 4))
+    {
+        r = FLOG_FAILED;
+    }
+
+    if(r == FLOG_OK)
+    {
+        spare_dirty = false;
+    }
+    else
+    {
+        failures++;
+    }
+
+    return r;
+}
+
+/*!
+ * \brief Opens the spare sector for writing
+ *
+ * Erases it first if the background erase did not happen yet. The sector
+ * after it becomes the spare, it is erased by the flash log task later.
+ * A sector that can not be opened is skipped.
+ */
+static flog_result_t flog_open_sector(void)
+{
+    const uint32_t addr = (uint32_t)FLOG_SECTOR(spare);
+    flog_result_t r;
+
+    r = flog_erase_spare();
+
+    if(r != FLOG_OK)
+    {
+        return r;
+    }
+
+    r = flog_program(addr + 4, cur_seq + 1);
+
+    if(r == FLOG_OK)
+    {
+        r = flog_program(addr, FLOG_MAGIC);
+    }
+
+    if(r == FLOG_FAILED)
+    {
+        // Skip a sector that fails to open, it is tried again on the next
+        // round through the region
+        failures++;
+
+        if(((spare + 1) % FLOG_SECTORS) != cur)
+        {
+            spare = (spare + 1) % FLOG_SECTORS;
+        }
+
+        spare_dirty = true;
+    }
+
+    if(r != FLOG_OK)
+    {
+        return r;
+    }
+
+    cur_seq++;
+    cur = spare;
+    cur_off = FLOG_FIRST;
+    spare = (spare + 1) % FLOG_SECTORS;
+    spare_dirty = !flog_blank(FLOG_SECTOR(spare), FLOG_SECTOR_SIZE / 4);
+
+    return r;
+}
+
+/*!
+ * \brief Returns the offset after the last record in a sector
+ *
+ * The first blank header ends the records. If the words after it are not
+ * blank, a record was interrupted and the sector is treated as full.
+ */
+static uint32_t flog_end(const uint32_t sector)
+{
+    const uint32_t *s = FLOG_SECTOR(sector);
+    uint32_t off = FLOG_FIRST;
+
+    while(off < FLOG_SECTOR_SIZE)
+    {
+        uint32_t h = s[off / 4];
+
+        if(h == FLOG_BLANK)
+        {
+            return flog_blank(&s[off / 4], (FLOG_SECTOR_SIZE - off) / 4) ?
+                   off : FLOG_SECTOR_SIZE;
+        }
+
+        if(((h >> 8) & 0xFF) > FLOG_RECORD_MAX)
+        {
+            return FLOG_SECTOR_SIZE;
+        }
+
+        off += FLOG_RECORD_SIZE((h >> 8) & 0xFF);
+    }
+
+    return FLOG_SECTOR_SIZE;
+}
+
+/*!
+ * \brief Finds the newest sector and the end of its records
+ */
+static void flog_scan(void)
+{
+    uint32_t newest = FLOG_NONE;
+
+    for(uint32_t i=0; i<FLOG_SECTORS; i++)
+    {
+        const uint32_t *s = FLOG_SECTOR(i);
+
+        if((s[0] == FLOG_MAGIC) &&
+           ((newest == FLOG_NONE) || ((int32_t)(s[1] - cur_seq) > 0)))
+        {
+            newest = i;
+            cur_seq = s[1];
+        }
+    }
+
+    if(newest != FLOG_NONE)
+    {
+        cur_off = flog_end(newest);
+        spare = (newest + 1) % FLOG_SECTORS;
+        cur = newest;
+    }
+
+    spare_dirty = !flog_blank(FLOG_SECTOR(spare), FLOG_SECTOR_SIZE / 4);
+}
+
+/*!
+ * \brief Programs the records of the flush page
+ *
+ * Returns early if the MCU leaves RUN mode or a new sector can not be
+ * opened, the rest of the page is programmed on the next call.
+ */
+static void flog_program_page(void)
+{
+    const uint32_t *page = pages[fill ^ 1];
+
+    while(flush_pos < flush_len)
+    {
+        uint32_t h = page[flush_pos / 4];
+        uint32_t size = FLOG_RECORD_SIZE((h >> 8) & 0xFF);
+        uint32_t addr;
+        flog_result_t r = FLOG_OK;
+
+        if((cur == FLOG_NONE) || ((cur_off + size) > FLOG_SECTOR_SIZE))
+        {
+            if(flog_open_sector() != FLOG_OK)
+            {
+                return;
+            }
+
+            continue;
+        }
+
+        addr = (uint32_t)FLOG_SECTOR(cur) + cur_off;
+
+        // The payload first, the header commits the record
+        for(uint32_t i=4; (i < size) && (r == FLOG_OK); i+=4)
+        {
+            r = flog_program(addr + i, page[(flush_pos + i) / 4]);
+        }
+
+        if(r == FLOG_OK)
+        {
+            r = flog_program(addr, h);
+        }
+
+        if(r == FLOG_BUSY)
+        {
+            return;
+        }
+
+        if(r == FLOG_FAILED)
+        {
+            // The record is lost, the rest goes to the next sector
+            failures++;
+            cur_off = FLOG_SECTOR_SIZE;
+        }
+        else
+        {
+            cur_off += size;
+        }
+
+        flush_pos += size;
+    }
+}
+
+/*!
+ * \brief Initializes the flash log
+ *
+ * Creates the task that finds the end of the log in flash, programs the RAM
+ * pages and erases the sectors. Records appended before the task has run
+ * are kept in RAM.
+ *
+ * \param[in]  priority  Priority of the flash log task. Choose a priority
+ *                       below all real-time tasks, every flash command
+ *                       masks interrupts.
+ */
+void flog_init(UBaseType_t priority)
+{
+    flog_task = xTaskCreateStatic(vFlogTask, "Flog", FLOG_STACK_DEPTH, NULL,
+                                  priority, flog_stack, &flog_tcb);
+}
+
+/*!
+ * \brief Appends a record to the log
+ *
+ * Copies the record into the RAM page with interrupts masked and returns,
+ * it is programmed by the flash log task within FLOG_FLUSH_MS. The task is
+ * woken early when the page is half full. If the page is full, the record
+ * is dropped and counted. Must be called from a task.
+ *
+ * \param[in]  type  Type of the record, defined by the application
+ * \param[in]  data  Payload
+ * \param[in]  len   Number of bytes in data, at most FLOG_RECORD_MAX
+ *
+ * \return true if the record is stored, false if it was dropped
+ */
+bool flog_append(const uint8_t type, const void *data, const uint32_t len)
+{
+    const uint32_t size = FLOG_RECORD_SIZE(len);
+    uint32_t h;
+    bool stored = false;
+    bool wake = false;
+
+    if(len > FLOG_RECORD_MAX)
+    {
+        return false;
+    }
+
+    h = type | (len << 8) | ((uint32_t)flog_crc16(type, data, len) << 16);
+
+    taskENTER_CRITICAL();
+    {
+        if((fill_len + size) <= FLOG_PAGE_SIZE)
+        {
+            uint32_t *p = &pages[fill][fill_len / 4];
+
+            // Pad with erased bytes, the header last as it may share the
+            // word with the padding of an empty record
+            p[(size / 4) - 1] = FLOG_BLANK;
+            memcpy(&p[1], data, len);
+            p[0] = h;
+
+            wake = (fill_len < (FLOG_PAGE_SIZE / 2)) &&
+                   ((fill_len + size) >= (FLOG_PAGE_SIZE / 2));
+            fill_len += size;
+            stored = true;
+        }
+        else
+        {
+            dropped++;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if(wake && (flog_task != NULL))
+    {
+        xTaskNotifyGive(flog_task);
+    }
+
+    return stored;
+}
+
+/*!
+ * \brief Wakes the flash log task to program the records in RAM now
+ */
+void flog_flush(void)
+{
+    if(flog_task != NULL)
+    {
+        xTaskNotifyGive(flog_task);
+    }
+}
+
+/*!
+ * \brief Sets up an iterator at the oldest record in flash
+ *
+ * Records still in RAM are not visited, call flog_flush() first for those.
+ */
+void flog_iter_init(flog_iter_t *it)
+{
+    const uint32_t newest = cur;
+
+    it->sector = (newest == FLOG_NONE) ? 0 : (newest + 1) % FLOG_SECTORS;
+    it->offset = FLOG_FIRST;
+    it->count = (newest == FLOG_NONE) ? 0 : FLOG_SECTORS;
+}
+
+/*!
+ * \brief Returns the next record, oldest first
+ *
+ * Records with a wrong CRC are skipped. The sector after the newest one is
+ * erased while the log grows, so the data of a record of the oldest sector
+ * is only valid until the flash log task runs.
+ *
+ * \param[in,out] it   Iterator set up by flog_iter_init()
+ * \param[out]    rec  The record
+ *
+ * \return true if rec holds a record, false after the newest record
+ */
+bool flog_next(flog_iter_t *it, flog_record_t *rec)
+{
+    while(it->count > 0)
+    {
+        const uint32_t *s = FLOG_SECTOR(it->sector);
+        uint32_t h = (it->offset < FLOG_SECTOR_SIZE) ? s[it->offset / 4] :
+                                                       FLOG_BLANK;
+        uint32_t len = (h >> 8) & 0xFF;
+
+        if((s[0] == FLOG_MAGIC) && (h != FLOG_BLANK) &&
+           (len <= FLOG_RECORD_MAX) &&
+           ((it->offset + FLOG_RECORD_SIZE(len)) <= FLOG_SECTOR_SIZE))
+        {
+            const uint8_t *data = (const uint8_t *)&s[(it->offset / 4) + 1];
+
+            it->offset += FLOG_RECORD_SIZE(len);
+
+            if(flog_crc16((uint8_t)h, data, len) == (h >> 16))
+            {
+                rec->type = (uint8_t)h;
+                rec->len = (uint8_t)len;
+                rec->data = data;
+                return true;
+            }
+
+            continue;
+        }
+
+        it->sector = (it->sector + 1) % FLOG_SECTORS;
+        it->offset = FLOG_FIRST;
+        it->count--;
+    }
+
+    return false;
+}
+
+/*!
+ * \brief Finds the newest setting of a type in the settings sector
+ *
+ * \param[in]   type  Type of the setting
+ * \param[out]  end   Offset after the last record, FLOG_SECTOR_SIZE if a
+ *                    write was interrupted. May be NULL.
+ *
+ * \return Offset of the record, FLOG_NONE if there is no valid one
+ */
+static uint32_t flog_config_find(const uint8_t type, uint32_t *end)
+{
+    const uint32_t *s = FLOG_CONFIG;
+    uint32_t found = FLOG_NONE;
+    uint32_t off = 0;
+
+    while(off < FLOG_SECTOR_SIZE)
+    {
+        const uint32_t h = s[off / 4];
+        const uint32_t len = (h >> 8) & 0xFF;
+
+        if(h == FLOG_BLANK)
+        {
+            if(!flog_blank(&s[off / 4], (FLOG_SECTOR_SIZE - off) / 4))
+            {
+                off = FLOG_SECTOR_SIZE;
+            }
+
+            break;
+        }
+
+        if((len > FLOG_RECORD_MAX) ||
+           ((off + FLOG_RECORD_SIZE(len)) > FLOG_SECTOR_SIZE))
+        {
+            off = FLOG_SECTOR_SIZE;
+            break;
+        }
+
+        if(((uint8_t)h == type) &&
+           (flog_crc16(type, (const uint8_t *)&s[(off / 4) + 1], len) == (h >> 16)))
+        {
+            found = off;
+        }
+
+        off += FLOG_RECORD_SIZE(len);
+    }
+
+    if(end != NULL)
+    {
+        *end = off;
+    }
+
+    return found;
+}
+
+/*!
+ * \brief Programs the records of config_buf into the settings sector
+ *
+ * The payload of every record first, the header commits it.
+ *
+ * \param[in]  off   Offset in the settings sector
+ * \param[in]  used  Bytes of config_buf
+ */
+static flog_result_t flog_config_program(const uint32_t off, const uint32_t used)
+{
+    const uint32_t addr = (uint32_t)FLOG_CONFIG + off;
+    flog_result_t r = FLOG_OK;
+    uint32_t pos = 0;
+
+    while((pos < used) && (r == FLOG_OK))
+    {
+        const uint32_t size = FLOG_RECORD_SIZE((config_buf[pos / 4] >> 8) & 0xFF);
+
+        for(uint32_t i=4; (i < size) && (r == FLOG_OK); i+=4)
+        {
+            r = flog_program(addr + pos + i, config_buf[(pos + i) / 4]);
+        }
+
+        if(r == FLOG_OK)
+        {
+            r = flog_program(addr + pos, config_buf[pos / 4]);
+        }
+
+        pos += size;
+    }
+
+    return r;
+}
+
+/*!
+ * \brief Reads a setting from the settings sector
+ *
+ * \param[in]   type  Type of the setting, defined by the application
+ * \param[out]  data  The setting, not changed if there is none
+ * \param[in]   len   Number of bytes of the setting
+ *
+ * \return true if a valid setting of len bytes was found
+ */
+bool flog_config_load(const uint8_t type, void *data, const uint32_t len)
+{
+    const uint32_t off = flog_config_find(type, NULL);
+
+    if((off == FLOG_NONE) || (((FLOG_CONFIG[off / 4] >> 8) & 0xFF) != len))
+    {
+        return false;
+    }
+
+    memcpy(data, &FLOG_CONFIG[(off / 4) + 1], len);
+
+    return true;
+}
+
+/*!
+ * \brief Saves a setting in the settings sector
+ *
+ * Programs the record at once with the scheduler suspended, which takes
+ * about 65 us per word with interrupts masked, plus 2 to 14 ms to erase the
+ * sector when it is full. An unchanged setting is not programmed again.
+ * Must be called from a task or before the scheduler is started, and only
+ * in RUN mode.
+ *
+ * \param[in]  type  Type of the setting, defined by the application
+ * \param[in]  data  The setting
+ * \param[in]  len   Number of bytes of data, a record of the data fits in
+ *                   FLOG_CONFIG_SIZE
+ *
+ * \return true if the setting is stored
+ */
+bool flog_config_save(const uint8_t type, const void *data, const uint32_t len)
+{
+    const uint32_t size = FLOG_RECORD_SIZE(len);
+    flog_result_t r = FLOG_OK;
+    uint32_t used = 0;
+    uint32_t found;
+    uint32_t end;
+
+    if((len > FLOG_RECORD_MAX) || (size > FLOG_CONFIG_SIZE))
+    {
+        return false;
+    }
+
+    vTaskSuspendAll();
+    {
+        found = flog_config_find(type, &end);
+
+        if((found != FLOG_NONE) &&
+           (((FLOG_CONFIG[found / 4] >> 8) & 0xFF) == len) &&
+           (memcmp(&FLOG_CONFIG[(found / 4) + 1], data, len) == 0))
+        {
+            (void)xTaskResumeAll();
+            return true;
+        }
+
+        if((end + size) > FLOG_SECTOR_SIZE)
+        {
+            // Keep the newest setting of every other type that fits
+            for(uint32_t off=0; off<end; )
+            {
+                const uint32_t h = FLOG_CONFIG[off / 4];
+                const uint32_t rec = FLOG_RECORD_SIZE((h >> 8) & 0xFF);
+
+                if((h == FLOG_BLANK) || (((h >> 8) & 0xFF) > FLOG_RECORD_MAX))
+                {
+                    break;
+                }
+
+                if(((uint8_t)h != type) && (flog_config_find((uint8_t)h, NULL) == off))
+                {
+                    if((used + rec + size) <= FLOG_CONFIG_SIZE)
+                    {
+                        memcpy(&config_buf[used / 4], &FLOG_CONFIG[off / 4], rec);
+                        used += rec;
+                    }
+                    else
+                    {
+                        failures++;
+                    }
+                }
+
+                off += rec;
+            }
+
+            r = flog_command(FLOG_CMD_ERASE_SECTOR, (uint32_t)FLOG_CONFIG, 0);
+
+            if(r != FLOG_BUSY)
+            {
+                erases++;
+            }
+
+            if((r == FLOG_OK) && !flog_blank(FLOG_CONFIG, FLOG_SECTOR_SIZE / 4))
+            {
+                r = FLOG_FAILED;
+            }
+
+            end = 0;
+        }
+
+        if(r == FLOG_OK)
+        {
+            uint32_t *p = &config_buf[used / 4];
+
+            p[(size / 4) - 1] = FLOG_BLANK;
+            memcpy(&p[1], data, len);
+            p[0] = type | (len << 8) | ((uint32_t)flog_crc16(type, data, len) << 16);
+            used += size;
+
+            r = flog_config_program(end, used);
+        }
+
+        if(r == FLOG_FAILED)
+        {
+            failures++;
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return r == FLOG_OK;
+}
+
+static void flog_puts(const char *line)
+{
+    xSerialPutStringPolicy(line, eSerialBlock, FLOG_BLOCK_TIME);
+}
+
+/*!
+ * \brief Writes the contents and the statistics of the log to the serial
+ *        port
+ *
+ * The number of records and bytes in flash, the capacity of the sectors
+ * that are kept, the records waiting in RAM, the number of erases, the
+ * records dropped because a RAM page was full and the failed commands.
+ */
+void flog_report(void)
+{
+    char line[FLOG_LINE_LEN];
+    flog_iter_t it;
+    flog_record_t rec;
+    uint32_t records = 0;
+    uint32_t bytes = 0;
+
+    flog_iter_init(&it);
+
+    while(flog_next(&it, &rec))
+    {
+        records++;
+        bytes += FLOG_RECORD_SIZE(rec.len);
+    }
+
+    xsnprintf(line, FLOG_LINE_LEN, "\r\nFlash log %lu records, %lu of %lu bytes\r\n",
+        (unsigned long)records, (unsigned long)bytes,
+        (unsigned long)((FLOG_SECTORS - 1) * (FLOG_SECTOR_SIZE - FLOG_FIRST)));
+    flog_puts(line);
+
+    xsnprintf(line, FLOG_LINE_LEN, "RAM %lu bytes, erases %lu\r\n",
+        (unsigned long)(fill_len + flush_len - flush_pos), (unsigned long)erases);
+    flog_puts(line);
+
+    xsnprintf(line, FLOG_LINE_LEN, "Dropped %lu, failed %lu\r\n",
+        (unsigned long)dropped, (unsigned long)failures);
+    flog_puts(line);
+}
+
+/*!
+ * \brief Flash log task
+ *
+ * Wakes every FLOG_FLUSH_MS, swaps the RAM pages, programs the records and
+ * erases the spare sector. The log region is scanned once at the start.
+ */
+static void vFlogTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    flog_scan();
+
+    for( ;; )
+    {
+        (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(FLOG_FLUSH_MS));
+
+        if(flush_pos == flush_len)
+        {
+            taskENTER_CRITICAL();
+            {
+                flush_len = fill_len;
+                flush_pos = 0;
+                fill ^= 1;
+                fill_len = 0;
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        flog_program_page();
+
+        (void)flog_erase_spare();
+    }
+}
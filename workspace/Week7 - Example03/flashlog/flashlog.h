@@ -0,0 +1,121 @@
+/*! ***************************************************************************
+ *
+ * \brief     Wear-levelled log store in the program flash
+ * \file      flashlog.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef FLASHLOG_H
+#define FLASHLOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// \name Definitions for the flash log
+/// \{
+
+/*!
+ * \brief Set to 1 to create the flash log task in main()
+ */
+#ifndef FLOG_ENABLED
+#define FLOG_ENABLED      (0)
+#endif
+
+/*!
+ * \brief Size of an erasable flash sector of the KL25 in bytes
+ */
+#define FLOG_SECTOR_SIZE  (1024)
+
+/*!
+ * \brief Size of each of the two RAM pages in bytes
+ *
+ * Records are collected in one page while the flash log task programs the
+ * other one, so a page holds the records of at least one FLOG_FLUSH_MS.
+ */
+#ifndef FLOG_PAGE_SIZE
+#define FLOG_PAGE_SIZE    (256)
+#endif
+
+/*!
+ * \brief Longest payload of a record in bytes, a record never spans two
+ *        sectors or two pages
+ */
+#define FLOG_RECORD_MAX   (120)
+
+/*!
+ * \brief Longest time a record waits in RAM before it is programmed, in ms
+ */
+#ifndef FLOG_FLUSH_MS
+#define FLOG_FLUSH_MS     (1000)
+#endif
+
+/*!
+ * \brief Bytes of all settings of flog_config_save() together, including a
+ *        header word per setting
+ *
+ * When the settings sector is full, the newest setting of every type is
+ * kept in a RAM buffer of this size while the sector is erased.
+ */
+#ifndef FLOG_CONFIG_SIZE
+#define FLOG_CONFIG_SIZE  (128)
+#endif
+
+/// \}
+
+/// A record returned by flog_next()
+typedef struct
+{
+    uint8_t type;        ///< Type given to flog_append()
+    uint8_t len;         ///< Number of bytes in data
+    const uint8_t *data; ///< Payload, in flash
+}
+flog_record_t;
+
+/// Position of flog_next() in the log, set up with flog_iter_init()
+typedef struct
+{
+    uint32_t sector;     ///< Index of the sector in the log region
+    uint32_t offset;     ///< Offset of the next record in the sector
+    uint32_t count;      ///< Number of sectors left to visit
+}
+flog_iter_t;
+
+// Function prototypes
+void flog_init(UBaseType_t priority);
+bool flog_append(const uint8_t type, const void *data, const uint32_t len);
+void flog_flush(void);
+
+void flog_iter_init(flog_iter_t *it);
+bool flog_next(flog_iter_t *it, flog_record_t *rec);
+
+void flog_report(void);
+bool flog_config_load(const uint8_t type, void *data, const uint32_t len);
+bool flog_config_save(const uint8_t type, const void *data, const uint32_t len);
+
+#endif // FLASHLOG_H
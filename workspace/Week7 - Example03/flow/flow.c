@@ -0,0 +1,436 @@
+/*! ***************************************************************************
+ *
+ * \brief     Block based dataflow from sources through stages to sinks
+ * \file      flow.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "flow.h"
+
+#include "mono.h"
+#include "serial.h"
+#include "xprintf.h"
+
+/*
+ * Sensor data moves through a graph of nodes in blocks of frames, a frame
+ * being one sample of every channel. A source, such as the task that reads
+ * the FIFO of the MMA8451, fills a block and emits it. Stages, such as
+ * filters and decimators, take a block and emit blocks of their results,
+ * and sinks, such as the telemetry stream, take blocks at the end. The
+ * graph is fixed: every node is declared statically with the nodes it
+ * emits to.
+ *
+ * A block is a message of msg.h from a single pool. Emitting it to several
+ * nodes adds a reference per node instead of a copy, and the block returns
+ * to the pool when the last node released it. Every stage and sink is a
+ * work item of work.h and runs in one of the shared worker tasks, one
+ * block at a time, so a node costs a queue of FLOW_INPUT_DEPTH pointers
+ * and no task, and the cost of a queue operation and a switch is paid per
+ * block instead of per sample.
+ *
+ * A block for a node whose queue is full is dropped and counted, so a slow
+ * sink never blocks its source. A node with several inputs gets their
+ * blocks in the order they were emitted.
+ */
+
+#define FLOW_LINE_LEN       (64)
+
+#define FLOW_BLOCK_TIME     pdMS_TO_TICKS(100)
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+static pool_t flow_pool;
+
+// All nodes that emitted or received a block, for the report
+static flow_node_t *nodes = NULL;
+
+/*----------------------------------------------------------------------------*/
+// Local function prototypes
+/*----------------------------------------------------------------------------*/
+static void flow_list(flow_node_t *node);
+static void flow_push(flow_node_t *node, flow_block_t *block, const bool isr,
+    BaseType_t *woken);
+static flow_block_t *flow_pop(flow_node_t *node);
+
+/*----------------------------------------------------------------------------*/
+// Local functions
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Adds a node to the report, with interrupts masked
+ */
+static void flow_list(flow_node_t *node)
+{
+    if(!node->listed)
+    {
+        node->listed = true;
+        node->next = nodes;
+        nodes = node;
+    }
+}
+
+/*!
+ * \brief Queues a block to all outputs of a node and releases the
+ *        reference of the caller
+ */
+static void flow_push(flow_node_t *node, flow_block_t *block, const bool isr,
+    BaseType_t *woken)
+{
+    uint32_t n = 0;
+
+    while((node->outputs != NULL) && (node->outputs[n] != NULL))
+    {
+        n++;
+    }
+
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    {
+        flow_list(node);
+
+        block->seq = node->seq++;
+
+        if(node->fn == NULL)
+        {
+            node->blocks++;
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+
+    // The references are taken first, a worker may finish with the block
+    // before the next output has it
+    if(n > 0)
+    {
+        msg_ref(block, n);
+    }
+
+    for(uint32_t i=0; i<n; i++)
+    {
+        flow_node_t *out = node->outputs[i];
+        bool queued = false;
+
+        mask = taskENTER_CRITICAL_FROM_ISR();
+        {
+            flow_list(out);
+
+            if(out->count < FLOW_INPUT_DEPTH)
+            {
+                out->queue[(out->head + out->count) % FLOW_INPUT_DEPTH] = block;
+                out->count++;
+                queued = true;
+            }
+            else
+            {
+                out->dropped++;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR(mask);
+
+        if(queued && isr)
+        {
+            (void)work_submit_from_isr(&out->work, woken);
+        }
+        else if(queued)
+        {
+            (void)work_submit(&out->work);
+        }
+        else if(isr)
+        {
+            msg_release_from_isr(block);
+        }
+        else
+        {
+            msg_release(block);
+        }
+    }
+
+    if(isr)
+    {
+        msg_release_from_isr(block);
+    }
+    else
+    {
+        msg_release(block);
+    }
+}
+
+/*!
+ * \brief Takes the oldest block off the queue of a node
+ *
+ * \return The block, NULL if the queue is empty
+ */
+static flow_block_t *flow_pop(flow_node_t *node)
+{
+    flow_block_t *block = NULL;
+
+    taskENTER_CRITICAL();
+    {
+        if(node->count > 0)
+        {
+            block = node->queue[node->head];
+            node->head = (node->head + 1) % FLOW_INPUT_DEPTH;
+            node->count--;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return block;
+}
+
+/*----------------------------------------------------------------------------*/
+// Public functions
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Initialises the pool of the blocks
+ *
+ * \param[in]  storage  Storage of FLOW_POOL_STORAGE()
+ * \param[in]  count    Number of blocks in the storage
+ */
+void flow_init(void *storage, const uint32_t count)
+{
+    pool_init(&flow_pool, "Flow", storage, MSG_BLOCK_SIZE(sizeof(flow_block_t)),
+        count);
+}
+
+/*!
+ * \brief Allocates an empty block
+ *
+ * \return The block, NULL if none is free
+ */
+flow_block_t *flow_alloc(void)
+{
+    flow_block_t *block = msg_alloc(&flow_pool);
+
+    if(block != NULL)
+    {
+        block->frames = 0;
+    }
+
+    return block;
+}
+
+/*!
+ * \brief Allocates an empty block from an interrupt handler
+ *
+ * \return The block, NULL if none is free
+ */
+flow_block_t *flow_alloc_from_isr(void)
+{
+    flow_block_t *block = msg_alloc_from_isr(&flow_pool);
+
+    if(block != NULL)
+    {
+        block->frames = 0;
+    }
+
+    return block;
+}
+
+/*!
+ * \brief Emits a block to the outputs of a node
+ *
+ * The block is passed on, the caller must not use it afterwards.
+ *
+ * \param[in,out]  node   Source or stage that made the block
+ * \param[in]      block  The block, with the frames, channels, start time
+ *                        and period filled in
+ */
+void flow_emit(flow_node_t *node, flow_block_t *block)
+{
+    flow_push(node, block, false, NULL);
+}
+
+/*!
+ * \brief Emits a block to the outputs of a node, from an interrupt handler
+ *
+ * \param[in,out]  node   Source that made the block
+ * \param[in]      block  The block, the caller must not use it afterwards
+ * \param[in,out]  woken  Set to pdTRUE if a worker must be switched in
+ */
+void flow_emit_from_isr(flow_node_t *node, flow_block_t *block,
+                        BaseType_t *woken)
+{
+    flow_push(node, block, true, woken);
+}
+
+/*!
+ * \brief Runs a stage or sink on its waiting blocks, the work function of
+ *        the FLOW_STAGE() and FLOW_SINK() nodes
+ *
+ * \param[in,out]  arg  The node
+ */
+void flow_run(void *arg)
+{
+    flow_node_t *node = (flow_node_t *)arg;
+    flow_block_t *block;
+
+    while((block = flow_pop(node)) != NULL)
+    {
+        const uint32_t start = mono_us32();
+
+        node->fn(node, block);
+
+        const uint32_t us = mono_us32() - start;
+
+        node->blocks++;
+
+        if(us > node->max_us)
+        {
+            node->max_us = us;
+        }
+
+        msg_release(block);
+    }
+}
+
+/*!
+ * \brief Writes the statistics of the nodes and the pool
+ */
+void flow_report(void)
+{
+    char line[FLOW_LINE_LEN];
+    pool_stats_t stats;
+
+    pool_stats(&flow_pool, &stats);
+
+    xsnprintf(line, FLOW_LINE_LEN, "\r\nFlow blocks %lu of %lu, peak %lu, failed %lu\r\n",
+        (unsigned long)stats.used, (unsigned long)stats.count,
+        (unsigned long)stats.peak, (unsigned long)stats.failures);
+    xSerialPutStringPolicy(line, eSerialBlock, FLOW_BLOCK_TIME);
+
+    xsnprintf(line, FLOW_LINE_LEN, "%-*s %8s %8s %8s\r\n",
+        configMAX_TASK_NAME_LEN, "Node", "Blocks", "Dropped", "Max us");
+    xSerialPutStringPolicy(line, eSerialBlock, FLOW_BLOCK_TIME);
+
+    // Nodes are only added at the front, so the list from here is stable
+    for(const flow_node_t *node = nodes; node != NULL; node = node->next)
+    {
+        xsnprintf(line, FLOW_LINE_LEN, "%-*.*s %8lu %8lu %8lu\r\n",
+            configMAX_TASK_NAME_LEN, configMAX_TASK_NAME_LEN, node->name,
+            (unsigned long)node->blocks, (unsigned long)node->dropped,
+            (unsigned long)node->max_us);
+        xSerialPutStringPolicy(line, eSerialBlock, FLOW_BLOCK_TIME);
+    }
+}
+
+/*!
+ * \brief Averages every factor frames into one, a stage
+ *
+ * The frames of an input block are emitted in one block at its end, so
+ * the stage adds no latency beyond the frames it averages. A frame may
+ * span two input blocks.
+ *
+ * \param[in,out]  node  Node with a flow_decimate_t state
+ * \param[in]      in    The block
+ */
+void flow_decimate(flow_node_t *node, const flow_block_t *in)
+{
+    flow_decimate_t *d = (flow_decimate_t *)node->state;
+    const uint32_t ch = in->channels;
+    flow_block_t *out = NULL;
+
+    for(uint32_t f=0; f<in->frames; f++)
+    {
+        const int16_t *v = &in->data[f * ch];
+
+        if(d->count == 0)
+        {
+            d->stamp_us = in->stamp_us + (f * in->period_us);
+        }
+
+        for(uint32_t c=0; c<ch; c++)
+        {
+            d->acc[c] += v[c];
+        }
+
+        if(++d->count < d->factor)
+        {
+            continue;
+        }
+
+        if(out == NULL)
+        {
+            out = flow_alloc();
+
+            if(out != NULL)
+            {
+                out->channels = (uint8_t)ch;
+                out->stamp_us = d->stamp_us;
+                out->period_us = in->period_us * d->factor;
+            }
+            else
+            {
+                node->dropped++;
+            }
+        }
+
+        if(out != NULL)
+        {
+            for(uint32_t c=0; c<ch; c++)
+            {
+                out->data[(out->frames * ch) + c] = (int16_t)(d->acc[c] / d->factor);
+            }
+
+            out->frames++;
+        }
+
+        for(uint32_t c=0; c<ch; c++)
+        {
+            d->acc[c] = 0;
+        }
+
+        d->count = 0;
+
+        if((out != NULL) && (((out->frames + 1U) * ch) > FLOW_BLOCK_VALUES))
+        {
+            flow_emit(node, out);
+            out = NULL;
+        }
+    }
+
+    if(out != NULL)
+    {
+        flow_emit(node, out);
+    }
+}
+
+/*!
+ * \brief Sends every frame as a telemetry record, a sink
+ *
+ * \param[in]  node  Node with a flow_tlm_t state
+ * \param[in]  in    The block
+ */
+void flow_tlm(flow_node_t *node, const flow_block_t *in)
+{
+    const flow_tlm_t *t = (const flow_tlm_t *)node->state;
+    const uint8_t len = (uint8_t)(in->channels * sizeof(int16_t));
+
+    for(uint32_t f=0; f<in->frames; f++)
+    {
+        (void)tlm_send(t->type, &in->data[f * in->channels], len);
+    }
+}
@@ -0,0 +1,204 @@
+/*! ***************************************************************************
+ *
+ * \brief     Block based dataflow from sources through stages to sinks
+ * \file      flow.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef FLOW_H
+#define FLOW_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+#include "msg.h"
+#include "pool.h"
+#include "telemetry.h"
+#include "work.h"
+
+/// \name Definitions for the dataflow
+/// \{
+
+/*!
+ * \brief Values in a block, frames of interleaved channels
+ *
+ * A full FIFO of the MMA8451, 32 frames of x, y and z, fits in a block.
+ */
+#ifndef FLOW_BLOCK_VALUES
+#define FLOW_BLOCK_VALUES   (96)
+#endif
+
+/*!
+ * \brief Most channels of a frame
+ */
+#define FLOW_MAX_CHANNELS   (3)
+
+/*!
+ * \brief Blocks a node can have waiting, a block for a full node is dropped
+ */
+#ifndef FLOW_INPUT_DEPTH
+#define FLOW_INPUT_DEPTH    (4)
+#endif
+
+/*!
+ * \brief Defines the storage of count blocks for flow_init()
+ */
+#define FLOW_POOL_STORAGE(name, count) \
+    POOL_STORAGE(name, MSG_BLOCK_SIZE(sizeof(flow_block_t)), count)
+
+/// \}
+
+/*!
+ * \brief A block of samples
+ *
+ * Allocated with flow_alloc() and passed on with flow_emit(). Blocks are
+ * shared by all nodes they are emitted to and must not be written after
+ * that.
+ */
+typedef struct
+{
+    uint32_t seq;                       ///< Number of the block of its node
+    uint32_t stamp_us;                  ///< Time of the first frame, on the
+                                        ///< clock of the source
+    uint32_t period_us;                 ///< Time between two frames
+    uint16_t frames;                    ///< Frames in the block
+    uint8_t channels;                   ///< Values per frame, 1 to FLOW_MAX_CHANNELS
+    uint8_t reserved;
+    int16_t data[FLOW_BLOCK_VALUES];    ///< Frames, channels interleaved
+}
+flow_block_t;
+
+struct flow_node;
+
+/*!
+ * \brief Processes a block
+ *
+ * Runs in the worker of the node. A stage allocates its own blocks for the
+ * results and emits them to its outputs, the input is released after the
+ * function returns.
+ *
+ * \param[in,out]  node  The node, its state is node->state
+ * \param[in]      in    The block
+ */
+typedef void (*flow_fn_t)(struct flow_node *node, const flow_block_t *in);
+
+/*!
+ * \brief A node of the graph
+ *
+ * Declared statically with FLOW_SOURCE(), FLOW_STAGE() or FLOW_SINK(), the
+ * outputs before the nodes that emit to them.
+ */
+typedef struct flow_node
+{
+    const char *name;
+    flow_fn_t fn;                       ///< NULL for a source
+    void *state;
+    struct flow_node *const *outputs;   ///< NULL terminated, NULL for a sink
+
+    // Managed by the framework
+    work_t work;
+    flow_block_t *queue[FLOW_INPUT_DEPTH];
+    uint32_t head;
+    uint32_t count;
+    uint32_t seq;
+    uint32_t blocks;                    ///< Blocks processed or emitted
+    uint32_t dropped;                   ///< Blocks lost, the node was full or no
+                                        ///< block was free for its results
+    uint32_t max_us;                    ///< Longest time of a block
+    bool listed;
+    struct flow_node *next;
+}
+flow_node_t;
+
+/*!
+ * \brief Initialiser of a source, emitting to the given nodes
+ *
+ * Example: static flow_node_t src = FLOW_SOURCE("Accel", &lowpass, &log);
+ */
+#define FLOW_SOURCE(n, ...) \
+    {.name = (n), .outputs = (flow_node_t *const []){__VA_ARGS__, NULL}}
+
+/*!
+ * \brief Initialiser of a stage of the variable var, emitting to the given
+ *        nodes from the worker prio
+ */
+#define FLOW_STAGE(var, n, f, s, prio, ...) \
+    {.name = (n), .fn = (f), .state = (s), \
+     .outputs = (flow_node_t *const []){__VA_ARGS__, NULL}, \
+     .work = WORK_ITEM(flow_run, &(var), (prio))}
+
+/*!
+ * \brief Initialiser of a sink of the variable var, run by the worker prio
+ */
+#define FLOW_SINK(var, n, f, s, prio) \
+    {.name = (n), .fn = (f), .state = (s), \
+     .work = WORK_ITEM(flow_run, &(var), (prio))}
+
+/*!
+ * \brief State of flow_decimate()
+ */
+typedef struct
+{
+    uint16_t factor;                    ///< Frames averaged into one
+
+    // Managed by the stage
+    uint16_t count;
+    uint32_t stamp_us;
+    int32_t acc[FLOW_MAX_CHANNELS];
+}
+flow_decimate_t;
+
+/*!
+ * \brief Initialiser of the state of flow_decimate()
+ */
+#define FLOW_DECIMATE(f) {.factor = (f)}
+
+/*!
+ * \brief State of flow_tlm(), the type of the records
+ */
+typedef struct
+{
+    tlm_type_t type;
+}
+flow_tlm_t;
+
+// Function prototypes
+void flow_init(void *storage, const uint32_t count);
+flow_block_t *flow_alloc(void);
+flow_block_t *flow_alloc_from_isr(void);
+void flow_emit(flow_node_t *node, flow_block_t *block);
+void flow_emit_from_isr(flow_node_t *node, flow_block_t *block,
+                        BaseType_t *woken);
+void flow_run(void *arg);
+void flow_report(void);
+
+// Stages and sinks
+void flow_decimate(flow_node_t *node, const flow_block_t *in);
+void flow_tlm(flow_node_t *node, const flow_block_t *in);
+
+#endif // FLOW_H
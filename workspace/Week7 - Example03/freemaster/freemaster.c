@@ -0,0 +1,448 @@
+/*! ***************************************************************************
+ *
+ * \brief     FreeMASTER serial protocol and recorder
+ * \file      freemaster.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <string.h>
+
+#include "freemaster.h"
+#include "task.h"
+
+// Version of the serial protocol and of the driver, reported by GETINFO
+#define FMSTR_PROT_VER      (3)
+#define FMSTR_VER_MAJOR     (2)
+#define FMSTR_VER_MINOR     (0)
+
+// Length of the identification string in the GETINFO response
+#define FMSTR_IDT_LEN       (25)
+
+// Memory that may be accessed by the host. Peripherals are excluded, a read
+// of a peripheral register may have side effects.
+#define FMSTR_FLASH_START   (0x00000000UL)
+#define FMSTR_FLASH_END     (0x00020000UL)
+#define FMSTR_RAM_START     (0x1FFFF000UL)
+#define FMSTR_RAM_END       (0x20003000UL)
+
+// Command, length byte, data and checksum
+#define FMSTR_FRAME_MAX     (FMSTR_COMM_BUFFER_SIZE + 3)
+
+static xComPortHandle fmstr_port = NULL;
+
+/*!
+ * \brief Receiver state
+ *
+ * The frame holds the bytes after the start of frame, with doubled start of
+ * frame bytes already reduced to one.
+ */
+static struct
+{
+    uint8_t frame[FMSTR_FRAME_MAX];
+    uint32_t n;         ///< Bytes received
+    uint32_t expected;  ///< Length of the frame, 0 until known
+    bool active;        ///< A frame is being received
+    bool sob;           ///< The last byte was a single start of frame
+    TickType_t last;    ///< Tick count of the last byte
+}rx;
+
+/*!
+ * \brief Initializes the FreeMASTER driver
+ *
+ * \param[in]  port  Serial port the responses are written to. The host
+ *                   ignores text between frames, but a text line sent while
+ *                   the host waits for a response may time the command out.
+ */
+void fmstr_init(xComPortHandle port)
+{
+    fmstr_port = port;
+}
+
+/*!
+ * \brief Checks if the host may read memory
+ */
+bool fmstr_readable(const uint32_t addr, const uint32_t size)
+{
+    const uint32_t end = addr + size;
+
+    if(end < addr)
+    {
+        return false;
+    }
+
+    return ((addr >= FMSTR_FLASH_START) && (end <= FMSTR_FLASH_END)) ||
+           ((addr >= FMSTR_RAM_START) && (end <= FMSTR_RAM_END));
+}
+
+/*!
+ * \brief Checks if the host may write memory, only RAM is written
+ */
+bool fmstr_writable(const uint32_t addr, const uint32_t size)
+{
+    const uint32_t end = addr + size;
+
+    return (end >= addr) && (addr >= FMSTR_RAM_START) && (end <= FMSTR_RAM_END);
+}
+
+/*!
+ * \brief Reads a little endian 16-bit value
+ */
+static uint16_t fmstr_get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+/*!
+ * \brief Reads a little endian 32-bit value
+ */
+static uint32_t fmstr_get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+/*!
+ * \brief Writes a little endian 16-bit value
+ */
+static void fmstr_put16(uint8_t *p, const uint16_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+}
+
+/*!
+ * \brief Writes a little endian 32-bit value
+ */
+static void fmstr_put32(uint8_t *p, const uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+/*!
+ * \brief Sends a response
+ *
+ * The checksum is the two's complement of the sum of status and data. Every
+ * start of frame byte after the first one is doubled.
+ *
+ * \param[in]  status  Status code
+ * \param[in]  data    Response data, may be NULL if len is 0
+ * \param[in]  len     Number of data bytes
+ */
+static void fmstr_send(const uint8_t status, const uint8_t *data, const uint32_t len)
+{
+    uint8_t frame[2 * (FMSTR_COMM_BUFFER_SIZE + 2) + 1];
+    uint32_t n = 0;
+    uint8_t sum = status;
+
+    frame[n++] = FMSTR_SOB;
+
+    frame[n++] = status;
+
+    for(uint32_t i=0; i<=len; i++)
+    {
+        uint8_t b;
+
+        if(i < len)
+        {
+            b = data[i];
+            sum += b;
+        }
+        else
+        {
+            b = (uint8_t)(0x100 - sum);
+        }
+
+        frame[n++] = b;
+
+        if(b == FMSTR_SOB)
+        {
+            frame[n++] = b;
+        }
+    }
+
+    (void)xSerialPortWrite(fmstr_port, frame, n);
+}
+
+/*!
+ * \brief Fills the GETINFO response
+ *
+ * \return Number of bytes
+ */
+static uint32_t fmstr_getinfo(uint8_t *rsp, const bool brief)
+{
+    static const char idt[FMSTR_IDT_LEN] = "FRDM-KL25Z FreeRTOS";
+    uint32_t n = 0;
+
+    rsp[n++] = FMSTR_PROT_VER;
+    rsp[n++] = 0;                        // Configuration flags, little endian
+    rsp[n++] = 1;                        // Data bus width, byte addressed
+    rsp[n++] = FMSTR_VER_MAJOR;
+    rsp[n++] = FMSTR_VER_MINOR;
+    rsp[n++] = FMSTR_COMM_BUFFER_SIZE;
+    fmstr_put16(&rsp[n], FMSTR_REC_BUFF_SIZE);
+    n += 2;
+    fmstr_put16(&rsp[n], fmstr_rec_timebase());
+    n += 2;
+
+    if(!brief)
+    {
+        memcpy(&rsp[n], idt, FMSTR_IDT_LEN);
+        n += FMSTR_IDT_LEN;
+    }
+
+    return n;
+}
+
+/*!
+ * \brief Executes a received command and sends the response
+ *
+ * \param[in]  cmd   Command code
+ * \param[in]  data  Command data
+ * \param[in]  len   Number of data bytes
+ */
+static void fmstr_command(const uint8_t cmd, const uint8_t *data, const uint32_t len)
+{
+    uint8_t rsp[FMSTR_COMM_BUFFER_SIZE];
+    uint32_t addr;
+    uint32_t size;
+    uint16_t start;
+
+    switch(cmd)
+    {
+    case FMSTR_CMD_GETINFO:
+    case FMSTR_CMD_GETINFOBRIEF:
+        fmstr_send(FMSTR_STS_OK, rsp, fmstr_getinfo(rsp, cmd == FMSTR_CMD_GETINFOBRIEF));
+        break;
+
+    case FMSTR_CMD_READMEM_EX:
+        // Size, 32-bit address
+        if(len != 5)
+        {
+            fmstr_send(FMSTR_STC_INVBUFF, NULL, 0);
+            break;
+        }
+
+        size = data[0];
+        addr = fmstr_get32(&data[1]);
+
+        if(size > FMSTR_COMM_BUFFER_SIZE)
+        {
+            fmstr_send(FMSTR_STC_RSPBUFFOVF, NULL, 0);
+        }
+        else if(!fmstr_readable(addr, size))
+        {
+            fmstr_send(FMSTR_STC_EACCESS, NULL, 0);
+        }
+        else
+        {
+            memcpy(rsp, (const void *)addr, size);
+            fmstr_send(FMSTR_STS_OK, rsp, size);
+        }
+        break;
+
+    case FMSTR_CMD_WRITEMEM_EX:
+    case FMSTR_CMD_WRITEMEMMASK_EX:
+        // Size, 32-bit address, data and for the masked write the mask
+        size = (len >= 5) ? data[0] : 0;
+        addr = (len >= 5) ? fmstr_get32(&data[1]) : 0;
+
+        if((len < 5) || (len != (5 + size * ((cmd == FMSTR_CMD_WRITEMEM_EX) ? 1 : 2))))
+        {
+            fmstr_send(FMSTR_STC_INVBUFF, NULL, 0);
+        }
+        else if(!fmstr_writable(addr, size))
+        {
+            fmstr_send(FMSTR_STC_EACCESS, NULL, 0);
+        }
+        else
+        {
+            uint8_t *dst = (uint8_t *)addr;
+
+            taskENTER_CRITICAL();
+            {
+                for(uint32_t i=0; i<size; i++)
+                {
+                    const uint8_t mask = (cmd == FMSTR_CMD_WRITEMEM_EX) ? 0xFF : data[5 + size + i];
+
+                    dst[i] = (dst[i] & ~mask) | (data[5 + i] & mask);
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            fmstr_send(FMSTR_STS_OK, NULL, 0);
+        }
+        break;
+
+    case FMSTR_CMD_SETUPREC_EX:
+        fmstr_send(fmstr_rec_setup(data, len), NULL, 0);
+        break;
+
+    case FMSTR_CMD_STARTREC:
+        fmstr_send(fmstr_rec_start(), NULL, 0);
+        break;
+
+    case FMSTR_CMD_STOPREC:
+        fmstr_send(fmstr_rec_stop(), NULL, 0);
+        break;
+
+    case FMSTR_CMD_GETRECSTS:
+        fmstr_send(fmstr_rec_status(), NULL, 0);
+        break;
+
+    case FMSTR_CMD_GETRECBUFF_EX:
+        // Buffer address and the index of the oldest sample
+        addr = fmstr_rec_buffer(&start);
+
+        if(addr == 0)
+        {
+            fmstr_send(FMSTR_STC_NOTINIT, NULL, 0);
+            break;
+        }
+
+        fmstr_put32(&rsp[0], addr);
+        fmstr_put16(&rsp[4], start);
+        fmstr_send(FMSTR_STS_OK, rsp, 6);
+        break;
+
+    default:
+        fmstr_send(FMSTR_STC_INVCMD, NULL, 0);
+        break;
+    }
+}
+
+/*!
+ * \brief Feeds a received character to the protocol
+ *
+ * Call for every character read from the serial port. Characters that are
+ * not part of a frame are left to the caller, so FreeMASTER can share the
+ * port with the single character commands. A frame starts with '+', which
+ * is not one of those commands.
+ *
+ * A frame is the start of frame byte, the command, a length byte unless the
+ * command is a fast command, the data and the checksum: the two's
+ * complement of the sum of the bytes after the start of frame.
+ *
+ * \param[in]  c  Received character
+ *
+ * \return True if the character was consumed by the protocol
+ */
+bool fmstr_rx(const char c)
+{
+    const uint8_t b = (uint8_t)c;
+    const TickType_t now = xTaskGetTickCount();
+
+    if((rx.active || rx.sob) && ((now - rx.last) > pdMS_TO_TICKS(FMSTR_RX_TIMEOUT_MS)))
+    {
+        rx.active = false;
+        rx.sob = false;
+    }
+
+    rx.last = now;
+
+    if(b == FMSTR_SOB)
+    {
+        // The first one starts a frame, unless the next byte is another one
+        if(!rx.sob)
+        {
+            rx.sob = true;
+            return true;
+        }
+
+        rx.sob = false;
+
+        if(!rx.active)
+        {
+            return true;
+        }
+    }
+    else if(rx.sob)
+    {
+        rx.sob = false;
+        rx.active = true;
+        rx.n = 0;
+        rx.expected = 0;
+    }
+    else if(!rx.active)
+    {
+        return false;
+    }
+
+    rx.frame[rx.n++] = b;
+
+    if(rx.n == 1)
+    {
+        // Fast commands carry 0, 2, 4 or 6 data bytes and no length byte
+        if((b & 0xC0) == 0xC0)
+        {
+            rx.expected = 1 + ((b & 0x30) >> 3) + 1;
+        }
+    }
+    else if((rx.n == 2) && (rx.expected == 0))
+    {
+        if(b > FMSTR_COMM_BUFFER_SIZE)
+        {
+            rx.active = false;
+            fmstr_send(FMSTR_STC_CMDTOOLONG, NULL, 0);
+            return true;
+        }
+
+        rx.expected = 2 + b + 1;
+    }
+
+    if((rx.expected == 0) || (rx.n < rx.expected))
+    {
+        return true;
+    }
+
+    rx.active = false;
+
+    uint8_t sum = 0;
+
+    for(uint32_t i=0; i<rx.n; i++)
+    {
+        sum += rx.frame[i];
+    }
+
+    if(sum != 0)
+    {
+        fmstr_send(FMSTR_STC_CMDCSERR, NULL, 0);
+        return true;
+    }
+
+    if((rx.frame[0] & 0xC0) == 0xC0)
+    {
+        fmstr_command(rx.frame[0], &rx.frame[1], rx.n - 2);
+    }
+    else
+    {
+        fmstr_command(rx.frame[0], &rx.frame[2], rx.frame[1]);
+    }
+
+    return true;
+}
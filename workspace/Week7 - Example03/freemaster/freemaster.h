@@ -0,0 +1,131 @@
+/*! ***************************************************************************
+ *
+ * \brief     FreeMASTER serial protocol and recorder
+ * \file      freemaster.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef FREEMASTER_H
+#define FREEMASTER_H
+
+#include <MKL25Z4.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "serial.h"
+
+/// \name Definitions for the FreeMASTER driver
+/// \{
+
+/*!
+ * \brief Largest data part of a command or response in bytes, reported to the
+ *        host, which splits memory reads accordingly
+ */
+#ifndef FMSTR_COMM_BUFFER_SIZE
+#define FMSTR_COMM_BUFFER_SIZE  (64)
+#endif
+
+/*!
+ * \brief A partial frame is dropped after this gap between two bytes
+ */
+#ifndef FMSTR_RX_TIMEOUT_MS
+#define FMSTR_RX_TIMEOUT_MS     (100)
+#endif
+
+/*!
+ * \brief Size of the recorder buffer in bytes
+ */
+#ifndef FMSTR_REC_BUFF_SIZE
+#define FMSTR_REC_BUFF_SIZE     (1024)
+#endif
+
+/*!
+ * \brief Maximum number of recorded variables
+ */
+#ifndef FMSTR_REC_MAX_VARS
+#define FMSTR_REC_MAX_VARS      (8)
+#endif
+
+/*!
+ * \brief Default sample rate of the recorder timer in Hz
+ */
+#ifndef FMSTR_REC_HZ
+#define FMSTR_REC_HZ            (1000)
+#endif
+
+/// \}
+
+/// \name Protocol constants
+/// \{
+
+#define FMSTR_SOB                   (0x2B)  ///< Start of a frame, '+'
+
+// Commands with a length byte
+#define FMSTR_CMD_READMEM_EX        (0x04)
+#define FMSTR_CMD_WRITEMEM_EX       (0x05)
+#define FMSTR_CMD_WRITEMEMMASK_EX   (0x06)
+#define FMSTR_CMD_SETUPREC_EX       (0x0B)
+
+// Fast commands, bits 5 and 4 encode the data length
+#define FMSTR_CMD_GETINFO           (0xC0)
+#define FMSTR_CMD_STARTREC          (0xC1)
+#define FMSTR_CMD_STOPREC           (0xC2)
+#define FMSTR_CMD_GETRECSTS         (0xC3)
+#define FMSTR_CMD_GETINFOBRIEF      (0xC8)
+#define FMSTR_CMD_GETRECBUFF_EX     (0xC9)
+
+// Response status codes
+#define FMSTR_STS_OK                (0x00)
+#define FMSTR_STS_RECRUN            (0x01)
+#define FMSTR_STS_RECDONE           (0x02)
+#define FMSTR_STC_INVCMD            (0x81)
+#define FMSTR_STC_CMDCSERR          (0x82)
+#define FMSTR_STC_CMDTOOLONG        (0x83)
+#define FMSTR_STC_RSPBUFFOVF        (0x84)
+#define FMSTR_STC_INVBUFF           (0x85)
+#define FMSTR_STC_INVSIZE           (0x86)
+#define FMSTR_STC_NOTINIT           (0x88)
+#define FMSTR_STC_EACCESS           (0x89)
+
+/// \}
+
+// Function prototypes
+void fmstr_init(xComPortHandle port);
+bool fmstr_rx(const char c);
+
+uint8_t fmstr_rec_setup(const uint8_t *data, const uint32_t len);
+uint8_t fmstr_rec_start(void);
+uint8_t fmstr_rec_stop(void);
+uint8_t fmstr_rec_status(void);
+uint32_t fmstr_rec_buffer(uint16_t *start);
+uint16_t fmstr_rec_timebase(void);
+void fmstr_recorder(void);
+void fmstr_rec_timer_start(const uint32_t rate_hz);
+void fmstr_rec_timer_stop(void);
+
+bool fmstr_readable(const uint32_t addr, const uint32_t size);
+bool fmstr_writable(const uint32_t addr, const uint32_t size);
+
+#endif // FREEMASTER_H
@@ -0,0 +1,525 @@
+/*! ***************************************************************************
+ *
+ * \brief     FreeMASTER recorder
+ * \file      freemaster_rec.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <string.h>
+
+#include "freemaster.h"
+#include "clock.h"
+#include "irq_prio.h"
+#include "task.h"
+
+// LPTMR0 counts OSCERCLK, the 8 MHz crystal of the FRDM-KL25Z
+#define FMSTR_LPTMR_HZ      (8000000UL)
+
+// Length of the SETUPREC_EX data without the variables and per variable
+#define FMSTR_SETUP_LEN     (18)
+#define FMSTR_SETUP_VAR_LEN (5)
+
+// Trigger modes
+#define FMSTR_TRG_NONE      (0)
+#define FMSTR_TRG_RISING    (1)
+#define FMSTR_TRG_FALLING   (2)
+
+/*!
+ * \brief A recorded variable
+ */
+typedef struct
+{
+    uint32_t addr;
+    uint8_t size;   ///< 1, 2 or 4 bytes
+}fmstr_rec_var_t;
+
+/*!
+ * \brief Recorder configuration and state
+ *
+ * Configured by a task in a critical section, sampled by fmstr_recorder().
+ */
+static struct
+{
+    fmstr_rec_var_t vars[FMSTR_REC_MAX_VARS];
+    uint32_t count;         ///< Number of variables
+    uint32_t sample_size;   ///< Bytes per sample, all variables
+    uint32_t total;         ///< Samples in the buffer
+    uint32_t post;          ///< Samples after the trigger
+    uint32_t time_div;      ///< Samples skipped between recorded samples
+    uint8_t trg_mode;
+    bool trg_signed;
+    fmstr_rec_var_t trg;
+    int64_t threshold;
+
+    bool ready;             ///< Set up
+    volatile bool running;
+    volatile bool done;
+    bool triggered;
+    bool prev_valid;
+    int64_t prev;           ///< Last trigger value
+    uint32_t div;
+    uint32_t write;         ///< Index of the next sample
+    uint32_t filled;        ///< Samples recorded, saturates at total
+    uint32_t post_left;
+}rec;
+
+// Word aligned, so the host can read it with any access size
+static uint32_t rec_buffer[(FMSTR_REC_BUFF_SIZE + 3) / 4];
+
+// Recorder period in us, 0 while the timer is not running
+static uint32_t rec_period_us = 0;
+
+/*!
+ * \brief Checks a variable for the recorder, it is read with a single
+ *        access of its size
+ */
+static bool fmstr_rec_var_ok(const uint32_t addr, const uint8_t size)
+{
+    if((size != 1) && (size != 2) && (size != 4))
+    {
+        return false;
+    }
+
+    return ((addr % size) == 0) && fmstr_readable(addr, size);
+}
+
+/*!
+ * \brief Reads a variable with a single access of its size
+ */
+static inline uint32_t fmstr_rec_read(const fmstr_rec_var_t *v)
+{
+    switch(v->size)
+    {
+    case 1:
+        return *(const volatile uint8_t *)v->addr;
+    case 2:
+        return *(const volatile uint16_t *)v->addr;
+    default:
+        return *(const volatile uint32_t *)v->addr;
+    }
+}
+
+/*!
+ * \brief Sets up the recorder, SETUPREC_EX command
+ *
+ * Data is trigger mode (1), total samples (2), post-trigger samples (2),
+ * time divider (2), trigger variable address (4), size (1) and signedness
+ * (1), threshold (4), variable count (1) and per variable its size (1) and
+ * address (4). A running recording is stopped.
+ *
+ * \return FreeMASTER status code
+ */
+uint8_t fmstr_rec_setup(const uint8_t *data, const uint32_t len)
+{
+    const uint32_t count = (len >= FMSTR_SETUP_LEN) ? data[17] : 0;
+    uint32_t sample_size = 0;
+
+    if((len < FMSTR_SETUP_LEN) || (len != (FMSTR_SETUP_LEN + count * FMSTR_SETUP_VAR_LEN)))
+    {
+        return FMSTR_STC_INVBUFF;
+    }
+
+    if((count == 0) || (count > FMSTR_REC_MAX_VARS))
+    {
+        return FMSTR_STC_INVSIZE;
+    }
+
+    const uint8_t mode = data[0];
+    const uint32_t total = data[1] | (data[2] << 8);
+    const uint32_t post = data[3] | (data[4] << 8);
+    const uint32_t trg_addr = data[7] | (data[8] << 8) | (data[9] << 16) | ((uint32_t)data[10] << 24);
+    const uint8_t trg_size = data[11];
+    const uint32_t threshold = data[13] | (data[14] << 8) | (data[15] << 16) | ((uint32_t)data[16] << 24);
+
+    if(mode > FMSTR_TRG_FALLING)
+    {
+        return FMSTR_STC_INVBUFF;
+    }
+
+    if((mode != FMSTR_TRG_NONE) && !fmstr_rec_var_ok(trg_addr, trg_size))
+    {
+        return FMSTR_STC_EACCESS;
+    }
+
+    for(uint32_t i=0; i<count; i++)
+    {
+        const uint8_t *v = &data[FMSTR_SETUP_LEN + i * FMSTR_SETUP_VAR_LEN];
+        const uint32_t addr = v[1] | (v[2] << 8) | (v[3] << 16) | ((uint32_t)v[4] << 24);
+
+        if(!fmstr_rec_var_ok(addr, v[0]))
+        {
+            return FMSTR_STC_EACCESS;
+        }
+
+        sample_size += v[0];
+    }
+
+    if((total == 0) || (post > total) || ((total * sample_size) > FMSTR_REC_BUFF_SIZE))
+    {
+        return FMSTR_STC_INVSIZE;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        rec.running = false;
+        rec.done = false;
+
+        for(uint32_t i=0; i<count; i++)
+        {
+            const uint8_t *v = &data[FMSTR_SETUP_LEN + i * FMSTR_SETUP_VAR_LEN];
+
+            rec.vars[i].size = v[0];
+            rec.vars[i].addr = v[1] | (v[2] << 8) | (v[3] << 16) | ((uint32_t)v[4] << 24);
+        }
+
+        rec.count = count;
+        rec.sample_size = sample_size;
+        rec.total = total;
+        rec.post = post;
+        rec.time_div = data[5] | (data[6] << 8);
+        rec.trg_mode = mode;
+        rec.trg.addr = trg_addr;
+        rec.trg.size = trg_size;
+        rec.trg_signed = (data[12] != 0);
+
+        // Sign extend a signed threshold of the size of the trigger variable
+        if(rec.trg_signed && (trg_size < 4) &&
+           (threshold & (1UL << (trg_size * 8 - 1))))
+        {
+            rec.threshold = (int64_t)threshold - (1LL << (trg_size * 8));
+        }
+        else if(rec.trg_signed)
+        {
+            rec.threshold = (int32_t)threshold;
+        }
+        else
+        {
+            rec.threshold = threshold;
+        }
+
+        rec.ready = true;
+    }
+    taskEXIT_CRITICAL();
+
+    return FMSTR_STS_OK;
+}
+
+/*!
+ * \brief Starts a recording, STARTREC command
+ */
+uint8_t fmstr_rec_start(void)
+{
+    if(!rec.ready)
+    {
+        return FMSTR_STC_NOTINIT;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        rec.div = 0;
+        rec.write = 0;
+        rec.filled = 0;
+        rec.triggered = false;
+        rec.prev_valid = false;
+        rec.done = false;
+        rec.running = true;
+    }
+    taskEXIT_CRITICAL();
+
+    return FMSTR_STS_OK;
+}
+
+/*!
+ * \brief Triggers a running recording, STOPREC command
+ *
+ * The recording ends after the post-trigger samples.
+ */
+uint8_t fmstr_rec_stop(void)
+{
+    if(!rec.ready)
+    {
+        return FMSTR_STC_NOTINIT;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        if(rec.running && !rec.triggered)
+        {
+            rec.triggered = true;
+            rec.post_left = rec.post;
+
+            if(rec.post_left == 0)
+            {
+                rec.running = false;
+                rec.done = true;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return FMSTR_STS_OK;
+}
+
+/*!
+ * \brief Gets the recorder status, GETRECSTS command
+ */
+uint8_t fmstr_rec_status(void)
+{
+    if(!rec.ready)
+    {
+        return FMSTR_STC_NOTINIT;
+    }
+
+    return rec.running ? FMSTR_STS_RECRUN : FMSTR_STS_RECDONE;
+}
+
+/*!
+ * \brief Gets the recorded samples, GETRECBUFF_EX command
+ *
+ * The buffer is a ring of samples, every sample holds the variables in the
+ * order of the setup. The host reads it with READMEM_EX.
+ *
+ * \param[out] start  Index of the oldest sample
+ *
+ * \return Address of the buffer, 0 if there is no finished recording
+ */
+uint32_t fmstr_rec_buffer(uint16_t *start)
+{
+    if(!rec.done)
+    {
+        return 0;
+    }
+
+    *start = (uint16_t)((rec.filled < rec.total) ? 0 : rec.write);
+
+    return (uint32_t)rec_buffer;
+}
+
+/*!
+ * \brief Gets the recorder time base for GETINFO
+ *
+ * Bits 15 and 14 are the unit: 1 for microseconds, 2 for milliseconds,
+ * bits 13 to 0 the period. 0 while no timer calls the recorder.
+ */
+uint16_t fmstr_rec_timebase(void)
+{
+    if(rec_period_us == 0)
+    {
+        return 0;
+    }
+
+    if(rec_period_us < 0x4000)
+    {
+        return (uint16_t)(0x4000 | rec_period_us);
+    }
+
+    return (uint16_t)(0x8000 | ((rec_period_us / 1000) & 0x3FFF));
+}
+
+/*!
+ * \brief Takes a sample of the recorded variables
+ *
+ * Called by the recorder timer, or by the application from the interrupt
+ * handler of the signal that is watched. Does not call the kernel.
+ */
+void fmstr_recorder(void)
+{
+    if(!rec.running)
+    {
+        return;
+    }
+
+    if(rec.div < rec.time_div)
+    {
+        rec.div++;
+        return;
+    }
+
+    rec.div = 0;
+
+    uint8_t *dst = (uint8_t *)rec_buffer + rec.write * rec.sample_size;
+
+    for(uint32_t i=0; i<rec.count; i++)
+    {
+        const uint32_t value = fmstr_rec_read(&rec.vars[i]);
+
+        memcpy(dst, &value, rec.vars[i].size);
+        dst += rec.vars[i].size;
+    }
+
+    rec.write = (rec.write + 1 < rec.total) ? rec.write + 1 : 0;
+
+    if(rec.filled < rec.total)
+    {
+        rec.filled++;
+    }
+
+    if(rec.triggered)
+    {
+        if(--rec.post_left == 0)
+        {
+            rec.running = false;
+            rec.done = true;
+        }
+
+        return;
+    }
+
+    if(rec.trg_mode == FMSTR_TRG_NONE)
+    {
+        return;
+    }
+
+    // Trigger value, sign extended for a signed variable
+    const uint32_t raw = fmstr_rec_read(&rec.trg);
+    int64_t value = raw;
+
+    if(rec.trg_signed && (raw & (1UL << (rec.trg.size * 8 - 1))))
+    {
+        value -= (rec.trg.size < 4) ? (1LL << (rec.trg.size * 8)) : (1LL << 32);
+    }
+
+    // Only trigger when the pre-trigger part of the buffer is filled
+    if(rec.prev_valid && (rec.filled >= (rec.total - rec.post)))
+    {
+        const bool rising = (rec.prev < rec.threshold) && (value >= rec.threshold);
+        const bool falling = (rec.prev > rec.threshold) && (value <= rec.threshold);
+
+        if(((rec.trg_mode == FMSTR_TRG_RISING) && rising) ||
+           ((rec.trg_mode == FMSTR_TRG_FALLING) && falling))
+        {
+            rec.triggered = true;
+            rec.post_left = rec.post;
+
+            if(rec.post_left == 0)
+            {
+                rec.running = false;
+                rec.done = true;
+            }
+        }
+    }
+
+    rec.prev = value;
+    rec.prev_valid = true;
+}
+
+#if (LP_TICKLESS_LPTMR == 0)
+/*!
+ * \brief Calls fmstr_recorder() from the LPTMR0 interrupt
+ *
+ * LPTMR0 counts OSCERCLK, prescaled when needed to fit the 16-bit compare
+ * register. The interrupt has the highest priority, the recorder does not
+ * call the kernel.
+ *
+ * \param[in]  rate_hz  Sample rate, from 1 Hz to 1 MHz
+ */
+void fmstr_rec_timer_start(const uint32_t rate_hz)
+{
+    uint32_t ticks = FMSTR_LPTMR_HZ / rate_hz;
+    int32_t prescale = -1;
+
+    while((ticks > 0x10000) && (prescale < 15))
+    {
+        ticks >>= 1;
+        prescale++;
+    }
+
+    if(rec_period_us == 0)
+    {
+        clk_gate_acquire(CLK_GATE_LPTMR);
+    }
+
+    LPTMR0->CSR = 0;
+
+    if(prescale < 0)
+    {
+        LPTMR0->PSR = LPTMR_PSR_PCS(3) | LPTMR_PSR_PBYP_MASK;
+    }
+    else
+    {
+        LPTMR0->PSR = LPTMR_PSR_PCS(3) | LPTMR_PSR_PRESCALE(prescale);
+    }
+
+    LPTMR0->CMR = ticks - 1;
+
+    rec_period_us = (ticks << (prescale + 1)) / (FMSTR_LPTMR_HZ / 1000000UL);
+
+    NVIC_SetPriority(LPTMR0_IRQn, IRQ_PRIO(FMSTR_REC));
+    NVIC_ClearPendingIRQ(LPTMR0_IRQn);
+    NVIC_EnableIRQ(LPTMR0_IRQn);
+
+    // Clear the flag and enable the interrupt and the timer
+    LPTMR0->CSR = LPTMR_CSR_TCF_MASK | LPTMR_CSR_TIE_MASK | LPTMR_CSR_TEN_MASK;
+}
+
+/*!
+ * \brief Stops the recorder timer
+ */
+void fmstr_rec_timer_stop(void)
+{
+    if(rec_period_us == 0)
+    {
+        return;
+    }
+
+    LPTMR0->CSR = 0;
+    NVIC_DisableIRQ(LPTMR0_IRQn);
+
+    rec_period_us = 0;
+    clk_gate_release(CLK_GATE_LPTMR);
+}
+
+void LPTMR0_IRQHandler(void)
+{
+    // Clear the flag
+    LPTMR0->CSR |= LPTMR_CSR_TCF_MASK;
+
+    fmstr_recorder();
+}
+#else
+/*!
+ * \brief Does not start a timer, LPTMR0 is the tickless idle wakeup timer
+ *
+ * With LP_TICKLESS_LPTMR the recorder has no timebase, fmstr_recorder() can
+ * still be called periodically from an other interrupt or a task.
+ *
+ * \param[in]  rate_hz  Sample rate, not used
+ */
+void fmstr_rec_timer_start(const uint32_t rate_hz)
+{
+    (void)rate_hz;
+
+    rec_period_us = 0;
+}
+
+/*!
+ * \brief Stops the recorder timer
+ */
+void fmstr_rec_timer_stop(void)
+{
+    rec_period_us = 0;
+}
+#endif
@@ -0,0 +1,153 @@
+/*
+ * FreeRTOSv202210.01-LTS
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Kernel configuration of the host simulation on the POSIX port, see
+ * host/CMakeLists.txt. Follows inc/FreeRTOSConfig.h, except for what the
+ * POSIX port needs: generic task selection, no tickless idle, stacks that a
+ * pthread accepts and assertions that stop the process. */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include "MKL25Z4.h"
+#include "runtime_stats.h"
+#include "sections.h"
+
+#include <stdint.h>
+extern uint32_t SystemCoreClock;
+
+#define configUSE_PREEMPTION			         1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  0
+#define configQUEUE_SMALL_ITEM_COPY              1
+#ifndef configUSE_DELAYED_WHEEL
+#define configUSE_DELAYED_WHEEL                  1
+#endif
+#ifndef configUSE_TIMER_WHEEL
+#define configUSE_TIMER_WHEEL                    1
+#endif
+#define configUSE_STREAM_BUFFER_SPANS            1
+#define configUSE_TIME_SLICING			         1
+/* Time slices of 10 ticks at the background priorities 0 and 1, where tasks
+ * such as the work queue and the log do CPU-bound work, and of 1 tick above */
+#ifndef configUSE_TIME_SLICE_QUANTUM
+#define configUSE_TIME_SLICE_QUANTUM             1
+#endif
+#define configTIME_SLICE_TICKS( uxPriority )     ( ( ( uxPriority ) <= 1U ) ? ( TickType_t ) 10 : ( TickType_t ) 1 )
+/* Runs the background jobs of idle/idle.c */
+#define configUSE_IDLE_HOOK				         1
+#define configUSE_TICK_HOOK				         0
+#define configCPU_CLOCK_HZ				         ( SystemCoreClock )
+#define configTICK_RATE_HZ				         ( ( TickType_t ) 1000 )
+#ifndef configMAX_PRIORITIES
+#define configMAX_PRIORITIES			         5
+#endif
+#define configMAX_TASK_NAME_LEN			         12
+#define configUSE_TRACE_FACILITY		         1
+#define configUSE_16_BIT_TICKS			         0
+#define configIDLE_SHOULD_YIELD			         1
+#define configUSE_MUTEXES				         1
+#define configQUEUE_REGISTRY_SIZE		         8
+#ifndef configCHECK_FOR_STACK_OVERFLOW
+#define configCHECK_FOR_STACK_OVERFLOW	         0
+#endif
+#define configUSE_RECURSIVE_MUTEXES		         1
+#define configUSE_MALLOC_FAILED_HOOK	         0
+#define configUSE_APPLICATION_TASK_TAG	         0
+#define configUSE_COUNTING_SEMAPHORES	         1
+#define configUSE_QUEUE_SETS                     1
+#define configUSE_TASK_NOTIFICATIONS             1
+/* One index per mechanism that blocks a task on a notification, see the
+ * *_NOTIFY_INDEX defines. Index 8 is the event flags, 9 the DMA channel
+ * manager and 10 the barriers. */
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES    11
+
+/* For generating runtime statistics, see host/sim/runtime_stats.c */
+#define configGENERATE_RUN_TIME_STATS	         1
+#define configUSE_STATS_FORMATTING_FUNCTIONS     configSUPPORT_DYNAMIC_ALLOCATION
+
+/* The POSIX port defines portGET_RUN_TIME_COUNTER_VALUE() as
+ * ulPortGetRunTime(), which is linked to ullRunTimeCounterValue() with
+ * --wrap, so the counter is the same as on the target. */
+#define configRUN_TIME_COUNTER_TYPE              uint64_t
+
+#define configRECORD_STACK_HIGH_ADDRESS          1
+
+#define configSUPPORT_STATIC_ALLOCATION          1
+#ifndef configSUPPORT_DYNAMIC_ALLOCATION
+#define configSUPPORT_DYNAMIC_ALLOCATION         1
+#endif
+
+/* Heap and stack.
+ * The thread of a task runs on the task stack, which must be at least
+ * PTHREAD_STACK_MIN bytes and also holds the stack frames of the C library.
+ * The stacks of the drivers and the example are sized relative to
+ * configMINIMAL_STACK_SIZE, 4096 words of 8 bytes here.
+ */
+#define configMINIMAL_STACK_SIZE		         ( ( unsigned short ) 4096 )
+#ifndef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE			         (  ( size_t ) ( 64 * 1024 ) )
+#endif
+/* ucHeap is defined in startup/kernel_memory.c, heap_5 is target only */
+#define configAPPLICATION_ALLOCATED_HEAP         1
+#define configHEAP_REGIONS                       0
+
+/* Software timer definitions. */
+#define configUSE_TIMERS				         1
+#define configTIMER_TASK_PRIORITY		         2
+#define configTIMER_QUEUE_LENGTH		         5
+#define configTIMER_TASK_STACK_DEPTH	         ( configMINIMAL_STACK_SIZE )
+
+/* The tick is a timer signal of the host, there is no tickless idle. */
+#define configUSE_TICKLESS_IDLE			         0
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet		         1
+#define INCLUDE_uxTaskPriorityGet		         1
+#define INCLUDE_vTaskDelete				         1
+#define INCLUDE_vTaskCleanUpResources	         1
+#define INCLUDE_vTaskSuspend			         1
+#define INCLUDE_vTaskDelayUntil			         1
+#define INCLUDE_vTaskDelay				         1
+#define INCLUDE_eTaskGetState			         1
+#define INCLUDE_xTaskGetSchedulerState	         1
+#define INCLUDE_xTaskGetIdleTaskHandle	         1
+#define INCLUDE_uxTaskGetStackHighWaterMark      1
+#define INCLUDE_xTimerPendFunctionCall           1
+
+/* A failed assertion prints its location and aborts, see host/sim/sim.c */
+void vAssertCalled( const char * const pcFileName, unsigned long ulLine );
+#define configASSERT( x )                        if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+
+/* Trace hooks of the kernel trace recorder and the stack and heap monitor,
+the low power library and the idle jobs. */
+#include "trace.h"
+#include "taskstats.h"
+#include "lowpower.h"
+#include "idle.h"
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,502 @@
+/*! ***************************************************************************
+ *
+ * \brief     Register definitions of the host simulation
+ * \file      MKL25Z4.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef MKL25Z4_H_
+#define MKL25Z4_H_
+
+/*
+ * Replaces CMSIS/MKL25Z4.h in the host build. Only the registers of the
+ * peripherals that behave like memory, or that a small model in sim.c can
+ * bring up to date on every access, are defined: the port control and GPIO
+ * registers, the clock gates and dividers, the NVIC, the MCG and SMC mode
+ * status, the RTC and the counters of PIT0 and SysTick. Drivers that only
+ * use those, such as the switches, the LEDs, the clock manager, the RTC and
+ * the MMA8451 driver on top of i2c.h, are compiled unchanged. Peripherals
+ * with side effects on a register access are modelled at the level of their
+ * driver API in host/sim instead.
+ *
+ * No header of the host C library is included here, the drivers and the
+ * example would see names the target does not have, such as clock().
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// The clock configuration of SystemInit(), 48 MHz core and 24 MHz bus
+#define CLOCK_SETUP (1)
+
+extern uint32_t SystemCoreClock;
+
+/*----------------------------------------------------------------------------*/
+// Interrupts
+/*----------------------------------------------------------------------------*/
+typedef enum IRQn {
+  NonMaskableInt_IRQn          = -14,
+  HardFault_IRQn               = -13,
+  SVCall_IRQn                  = -5,
+  PendSV_IRQn                  = -2,
+  SysTick_IRQn                 = -1,
+  DMA0_IRQn                    = 0,
+  DMA1_IRQn                    = 1,
+  DMA2_IRQn                    = 2,
+  DMA3_IRQn                    = 3,
+  FTFA_IRQn                    = 5,
+  LVD_LVW_IRQn                 = 6,
+  LLWU_IRQn                    = 7,
+  I2C0_IRQn                    = 8,
+  I2C1_IRQn                    = 9,
+  SPI0_IRQn                    = 10,
+  SPI1_IRQn                    = 11,
+  UART0_IRQn                   = 12,
+  UART1_IRQn                   = 13,
+  UART2_IRQn                   = 14,
+  ADC0_IRQn                    = 15,
+  CMP0_IRQn                    = 16,
+  TPM0_IRQn                    = 17,
+  TPM1_IRQn                    = 18,
+  TPM2_IRQn                    = 19,
+  RTC_IRQn                     = 20,
+  RTC_Seconds_IRQn             = 21,
+  PIT_IRQn                     = 22,
+  USB0_IRQn                    = 24,
+  DAC0_IRQn                    = 25,
+  TSI0_IRQn                    = 26,
+  MCG_IRQn                     = 27,
+  LPTMR0_IRQn                  = 28,
+  PORTA_IRQn                   = 30,
+  PORTD_IRQn                   = 31
+} IRQn_Type;
+
+/// Priority bits of the NVIC of the Cortex-M0+
+#define __NVIC_PRIO_BITS 2
+
+/// Enabled interrupts, a simulated pin edge only calls an enabled handler
+extern volatile uint32_t sim_nvic_iser;
+
+/// Pending interrupts, their handlers are called by the simulation task
+extern volatile uint32_t sim_nvic_ispr;
+
+/// Exception number of the running simulated handler, 0 in a task
+extern volatile uint32_t sim_ipsr;
+
+/// Priorities of the interrupts, kept for NVIC_GetPriority(), the simulation
+/// does not preempt a handler
+extern volatile uint8_t sim_nvic_prio[32];
+
+void sim_irq_pend(IRQn_Type IRQn);
+
+static inline void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    __atomic_or_fetch(&sim_nvic_iser, 1UL << IRQn, __ATOMIC_SEQ_CST);
+
+    // An interrupt that became pending while it was disabled is taken now
+    if(sim_nvic_ispr & (1UL << IRQn))
+    {
+        sim_irq_pend(IRQn);
+    }
+}
+
+static inline void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    __atomic_and_fetch(&sim_nvic_iser, ~(1UL << IRQn), __ATOMIC_SEQ_CST);
+}
+
+static inline void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+    if(IRQn >= 0)
+    {
+        sim_nvic_prio[IRQn] = (uint8_t)(priority & 0xC0U);
+    }
+}
+
+static inline uint32_t NVIC_GetPriority(IRQn_Type IRQn)
+{
+    return (IRQn >= 0) ? sim_nvic_prio[IRQn] : 0;
+}
+
+static inline void NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+    sim_irq_pend(IRQn);
+}
+
+static inline void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+    __atomic_and_fetch(&sim_nvic_ispr, ~(1UL << IRQn), __ATOMIC_SEQ_CST);
+}
+
+/*----------------------------------------------------------------------------*/
+// Core functions
+/*----------------------------------------------------------------------------*/
+
+// The tick of the POSIX port is a signal, masking all signals of the thread
+// running the task is what PRIMASK is on the target, see the port's
+// vPortDisableInterrupts() and sim.c
+
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t priMask);
+
+static inline void __disable_irq(void)
+{
+    __set_PRIMASK(1U);
+}
+
+static inline void __enable_irq(void)
+{
+    __set_PRIMASK(0U);
+}
+
+static inline uint32_t __get_IPSR(void)
+{
+    return sim_ipsr;
+}
+
+#define __NOP()   do { } while(0)
+#define __WFI()   do { } while(0)
+#define __DMB()   __sync_synchronize()
+#define __DSB()   __sync_synchronize()
+#define __ISB()   __sync_synchronize()
+
+/*----------------------------------------------------------------------------*/
+// Peripherals without a model, their drivers are replaced in host/sim
+/*----------------------------------------------------------------------------*/
+typedef struct sim_no_model ADC_Type;
+typedef struct sim_no_model DMA_Type;
+typedef struct sim_no_model I2C_Type;
+typedef struct sim_no_model LPTMR_Type;
+typedef struct sim_no_model TPM_Type;
+typedef struct sim_no_model UART_Type;
+typedef struct sim_no_model UART0_Type;
+
+/*----------------------------------------------------------------------------*/
+// SIM, only the clock gates and clock selections
+/*----------------------------------------------------------------------------*/
+typedef struct {
+  volatile uint32_t SOPT1;
+  volatile uint32_t SOPT2;
+  volatile uint32_t SCGC4;
+  volatile uint32_t SCGC5;
+  volatile uint32_t SCGC6;
+  volatile uint32_t SCGC7;
+  volatile uint32_t CLKDIV1;
+} SIM_Type;
+
+extern SIM_Type sim_sim;
+#define SIM                                      (&sim_sim)
+
+#define SIM_SCGC4_I2C0_MASK                      0x40u
+#define SIM_SCGC4_I2C1_MASK                      0x80u
+#define SIM_SCGC4_UART0_MASK                     0x400u
+#define SIM_SCGC4_UART1_MASK                     0x800u
+#define SIM_SCGC4_UART2_MASK                     0x1000u
+#define SIM_SCGC4_USBOTG_MASK                    0x40000u
+#define SIM_SCGC4_SPI0_MASK                      0x400000u
+#define SIM_SCGC4_SPI1_MASK                      0x800000u
+#define SIM_SCGC5_LPTMR_MASK                     0x1u
+#define SIM_SCGC5_PORTA_MASK                     0x200u
+#define SIM_SCGC5_PORTB_MASK                     0x400u
+#define SIM_SCGC5_PORTC_MASK                     0x800u
+#define SIM_SCGC5_PORTD_MASK                     0x1000u
+#define SIM_SCGC5_PORTE_MASK                     0x2000u
+#define SIM_SCGC6_DMAMUX_MASK                    0x2u
+#define SIM_SCGC6_PIT_MASK                       0x800000u
+#define SIM_SCGC6_TPM0_MASK                      0x1000000u
+#define SIM_SCGC6_TPM1_MASK                      0x2000000u
+#define SIM_SCGC6_TPM2_MASK                      0x4000000u
+#define SIM_SCGC6_ADC0_MASK                      0x8000000u
+#define SIM_SCGC6_RTC_MASK                       0x20000000u
+#define SIM_SCGC6_DAC0_MASK                      0x80000000u
+#define SIM_SCGC7_DMA_MASK                       0x100u
+#define SIM_SOPT1_OSC32KSEL_MASK                 0xC0000u
+#define SIM_SOPT1_OSC32KSEL_SHIFT                18
+#define SIM_SOPT1_OSC32KSEL(x)                   (((uint32_t)(((uint32_t)(x))<<SIM_SOPT1_OSC32KSEL_SHIFT))&SIM_SOPT1_OSC32KSEL_MASK)
+#define SIM_SOPT2_CLKOUTSEL_MASK                 0xE0u
+#define SIM_SOPT2_CLKOUTSEL_SHIFT                5
+#define SIM_SOPT2_CLKOUTSEL(x)                   (((uint32_t)(((uint32_t)(x))<<SIM_SOPT2_CLKOUTSEL_SHIFT))&SIM_SOPT2_CLKOUTSEL_MASK)
+#define SIM_SOPT2_PLLFLLSEL_MASK                 0x10000u
+#define SIM_SOPT2_PLLFLLSEL_SHIFT                16
+#define SIM_SOPT2_PLLFLLSEL(x)                   (((uint32_t)(((uint32_t)(x))<<SIM_SOPT2_PLLFLLSEL_SHIFT))&SIM_SOPT2_PLLFLLSEL_MASK)
+#define SIM_SOPT2_TPMSRC_MASK                    0x3000000u
+#define SIM_SOPT2_TPMSRC_SHIFT                   24
+#define SIM_SOPT2_TPMSRC(x)                      (((uint32_t)(((uint32_t)(x))<<SIM_SOPT2_TPMSRC_SHIFT))&SIM_SOPT2_TPMSRC_MASK)
+#define SIM_SOPT2_UART0SRC_MASK                  0xC000000u
+#define SIM_SOPT2_UART0SRC_SHIFT                 26
+#define SIM_SOPT2_UART0SRC(x)                    (((uint32_t)(((uint32_t)(x))<<SIM_SOPT2_UART0SRC_SHIFT))&SIM_SOPT2_UART0SRC_MASK)
+#define SIM_CLKDIV1_OUTDIV1_MASK                 0xF0000000u
+#define SIM_CLKDIV1_OUTDIV1_SHIFT                28
+#define SIM_CLKDIV1_OUTDIV1(x)                   (((uint32_t)(((uint32_t)(x))<<SIM_CLKDIV1_OUTDIV1_SHIFT))&SIM_CLKDIV1_OUTDIV1_MASK)
+#define SIM_CLKDIV1_OUTDIV4_MASK                 0x70000u
+#define SIM_CLKDIV1_OUTDIV4_SHIFT                16
+#define SIM_CLKDIV1_OUTDIV4(x)                   (((uint32_t)(((uint32_t)(x))<<SIM_CLKDIV1_OUTDIV4_SHIFT))&SIM_CLKDIV1_OUTDIV4_MASK)
+
+/*----------------------------------------------------------------------------*/
+// PORT
+/*----------------------------------------------------------------------------*/
+typedef struct {
+  volatile uint32_t PCR[32];
+  volatile uint32_t GPCLR;
+  volatile uint32_t GPCHR;
+  uint8_t RESERVED_0[24];
+  volatile uint32_t ISFR;
+} PORT_Type;
+
+/// PORTA to PORTE. ISF reads back as written, sim_pin_set() clears the flags
+/// around every simulated edge instead of a write of 1.
+extern PORT_Type sim_port[5];
+#define PORTA                                    (&sim_port[0])
+#define PORTB                                    (&sim_port[1])
+#define PORTC                                    (&sim_port[2])
+#define PORTD                                    (&sim_port[3])
+#define PORTE                                    (&sim_port[4])
+
+#define PORT_PCR_PS_MASK                         0x1u
+#define PORT_PCR_PS_SHIFT                        0
+#define PORT_PCR_PS(x)                           (((uint32_t)(((uint32_t)(x))<<PORT_PCR_PS_SHIFT))&PORT_PCR_PS_MASK)
+#define PORT_PCR_PE_MASK                         0x2u
+#define PORT_PCR_PE_SHIFT                        1
+#define PORT_PCR_PE(x)                           (((uint32_t)(((uint32_t)(x))<<PORT_PCR_PE_SHIFT))&PORT_PCR_PE_MASK)
+#define PORT_PCR_PFE_MASK                        0x10u
+#define PORT_PCR_PFE_SHIFT                       4
+#define PORT_PCR_PFE(x)                          (((uint32_t)(((uint32_t)(x))<<PORT_PCR_PFE_SHIFT))&PORT_PCR_PFE_MASK)
+#define PORT_PCR_MUX_MASK                        0x700u
+#define PORT_PCR_MUX_SHIFT                       8
+#define PORT_PCR_MUX(x)                          (((uint32_t)(((uint32_t)(x))<<PORT_PCR_MUX_SHIFT))&PORT_PCR_MUX_MASK)
+#define PORT_PCR_IRQC_MASK                       0xF0000u
+#define PORT_PCR_IRQC_SHIFT                      16
+#define PORT_PCR_IRQC(x)                         (((uint32_t)(((uint32_t)(x))<<PORT_PCR_IRQC_SHIFT))&PORT_PCR_IRQC_MASK)
+#define PORT_PCR_ISF_MASK                        0x1000000u
+#define PORT_PCR_ISF_SHIFT                       24
+#define PORT_PCR_ISF(x)                          (((uint32_t)(((uint32_t)(x))<<PORT_PCR_ISF_SHIFT))&PORT_PCR_ISF_MASK)
+
+/*----------------------------------------------------------------------------*/
+// GPIO and FGPIO, both aliases of a port share the registers
+/*----------------------------------------------------------------------------*/
+typedef struct {
+  volatile uint32_t PDOR;
+  volatile uint32_t PSOR;
+  volatile uint32_t PCOR;
+  volatile uint32_t PTOR;
+  volatile uint32_t PDIR;
+  volatile uint32_t PDDR;
+} GPIO_Type;
+
+typedef GPIO_Type FGPIO_Type;
+
+/// The set, clear and toggle registers are not applied to PDOR. PDIR is
+/// the input level, written by the input models.
+extern GPIO_Type sim_gpio[5];
+#define GPIOA                                    (&sim_gpio[0])
+#define GPIOB                                    (&sim_gpio[1])
+#define GPIOC                                    (&sim_gpio[2])
+#define GPIOD                                    (&sim_gpio[3])
+#define GPIOE                                    (&sim_gpio[4])
+#define FGPIOA                                   (&sim_gpio[0])
+#define FGPIOB                                   (&sim_gpio[1])
+#define FGPIOC                                   (&sim_gpio[2])
+#define FGPIOD                                   (&sim_gpio[3])
+#define FGPIOE                                   (&sim_gpio[4])
+
+/*----------------------------------------------------------------------------*/
+// I2C, only the bit rate fields for i2c_speed.c
+/*----------------------------------------------------------------------------*/
+#define I2C_F_ICR_MASK                           0x3Fu
+#define I2C_F_ICR_SHIFT                          0
+#define I2C_F_ICR(x)                             (((uint8_t)(((uint8_t)(x))<<I2C_F_ICR_SHIFT))&I2C_F_ICR_MASK)
+#define I2C_F_MULT_MASK                          0xC0u
+#define I2C_F_MULT_SHIFT                         6
+#define I2C_F_MULT(x)                            (((uint8_t)(((uint8_t)(x))<<I2C_F_MULT_SHIFT))&I2C_F_MULT_MASK)
+
+/*----------------------------------------------------------------------------*/
+// MCG, S follows the clock source selected in C1 and C6
+/*----------------------------------------------------------------------------*/
+typedef struct {
+  volatile uint8_t C1;
+  volatile uint8_t C2;
+  volatile uint8_t C3;
+  volatile uint8_t C4;
+  volatile uint8_t C5;
+  volatile uint8_t C6;
+  volatile uint8_t S;
+} MCG_Type;
+
+MCG_Type *sim_mcg(void);
+#define MCG                                      (sim_mcg())
+
+#define MCG_C1_IRCLKEN_MASK                      0x2u
+#define MCG_C1_IRCLKEN_SHIFT                     1
+#define MCG_C1_IRCLKEN(x)                        (((uint8_t)(((uint8_t)(x))<<MCG_C1_IRCLKEN_SHIFT))&MCG_C1_IRCLKEN_MASK)
+#define MCG_C1_CLKS_MASK                         0xC0u
+#define MCG_C1_CLKS_SHIFT                        6
+#define MCG_C1_CLKS(x)                           (((uint8_t)(((uint8_t)(x))<<MCG_C1_CLKS_SHIFT))&MCG_C1_CLKS_MASK)
+#define MCG_C2_IRCS_MASK                         0x1u
+#define MCG_C2_IRCS_SHIFT                        0
+#define MCG_C2_IRCS(x)                           (((uint8_t)(((uint8_t)(x))<<MCG_C2_IRCS_SHIFT))&MCG_C2_IRCS_MASK)
+#define MCG_C2_LP_MASK                           0x2u
+#define MCG_C2_LP_SHIFT                          1
+#define MCG_C2_LP(x)                             (((uint8_t)(((uint8_t)(x))<<MCG_C2_LP_SHIFT))&MCG_C2_LP_MASK)
+#define MCG_C6_PLLS_MASK                         0x40u
+#define MCG_C6_PLLS_SHIFT                        6
+#define MCG_C6_PLLS(x)                           (((uint8_t)(((uint8_t)(x))<<MCG_C6_PLLS_SHIFT))&MCG_C6_PLLS_MASK)
+#define MCG_S_CLKST_MASK                         0xCu
+#define MCG_S_CLKST_SHIFT                        2
+#define MCG_S_CLKST(x)                           (((uint8_t)(((uint8_t)(x))<<MCG_S_CLKST_SHIFT))&MCG_S_CLKST_MASK)
+#define MCG_S_PLLST_MASK                         0x20u
+#define MCG_S_PLLST_SHIFT                        5
+#define MCG_S_PLLST(x)                           (((uint8_t)(((uint8_t)(x))<<MCG_S_PLLST_SHIFT))&MCG_S_PLLST_MASK)
+#define MCG_S_LOCK0_MASK                         0x40u
+#define MCG_S_LOCK0_SHIFT                        6
+#define MCG_S_LOCK0(x)                           (((uint8_t)(((uint8_t)(x))<<MCG_S_LOCK0_SHIFT))&MCG_S_LOCK0_MASK)
+
+/*----------------------------------------------------------------------------*/
+// SMC, PMSTAT follows the run mode selected in PMCTRL
+/*----------------------------------------------------------------------------*/
+typedef struct {
+  volatile uint8_t PMPROT;
+  volatile uint8_t PMCTRL;
+  volatile uint8_t STOPCTRL;
+  volatile uint8_t PMSTAT;
+} SMC_Type;
+
+SMC_Type *sim_smc(void);
+#define SMC                                      (sim_smc())
+
+#define SMC_PMCTRL_RUNM_MASK                     0x60u
+#define SMC_PMCTRL_RUNM_SHIFT                    5
+#define SMC_PMCTRL_RUNM(x)                       (((uint8_t)(((uint8_t)(x))<<SMC_PMCTRL_RUNM_SHIFT))&SMC_PMCTRL_RUNM_MASK)
+#define SMC_PMSTAT_PMSTAT_MASK                   0x7Fu
+#define SMC_PMSTAT_PMSTAT_SHIFT                  0
+#define SMC_PMSTAT_PMSTAT(x)                     (((uint8_t)(((uint8_t)(x))<<SMC_PMSTAT_PMSTAT_SHIFT))&SMC_PMSTAT_PMSTAT_MASK)
+
+/*----------------------------------------------------------------------------*/
+// RTC, TSR and TPR count the simulated time while TCE is set, see sim_rtc()
+/*----------------------------------------------------------------------------*/
+typedef struct {
+  volatile uint32_t TSR;
+  volatile uint32_t TPR;
+  volatile uint32_t TAR;
+  volatile uint32_t TCR;
+  volatile uint32_t CR;
+  volatile uint32_t SR;
+  volatile uint32_t LR;
+  volatile uint32_t IER;
+} RTC_Type;
+
+RTC_Type *sim_rtc(void);
+#define RTC                                      (sim_rtc())
+#define RTC_TSR                                  (RTC->TSR)
+#define RTC_SR                                   (RTC->SR)
+
+#define RTC_TPR_TPR_MASK                         0xFFFFu
+#define RTC_TPR_TPR_SHIFT                        0
+#define RTC_TPR_TPR(x)                           (((uint32_t)(((uint32_t)(x))<<RTC_TPR_TPR_SHIFT))&RTC_TPR_TPR_MASK)
+#define RTC_TCR_TCR_MASK                         0xFFu
+#define RTC_TCR_TCR_SHIFT                        0
+#define RTC_TCR_TCR(x)                           (((uint32_t)(((uint32_t)(x))<<RTC_TCR_TCR_SHIFT))&RTC_TCR_TCR_MASK)
+#define RTC_TCR_CIR_MASK                         0xFF00u
+#define RTC_TCR_CIR_SHIFT                        8
+#define RTC_TCR_CIR(x)                           (((uint32_t)(((uint32_t)(x))<<RTC_TCR_CIR_SHIFT))&RTC_TCR_CIR_MASK)
+#define RTC_CR_SWR_MASK                          0x1u
+#define RTC_CR_SWR_SHIFT                         0
+#define RTC_CR_SWR(x)                            (((uint32_t)(((uint32_t)(x))<<RTC_CR_SWR_SHIFT))&RTC_CR_SWR_MASK)
+#define RTC_SR_TIF_MASK                          0x1u
+#define RTC_SR_TIF_SHIFT                         0
+#define RTC_SR_TIF(x)                            (((uint32_t)(((uint32_t)(x))<<RTC_SR_TIF_SHIFT))&RTC_SR_TIF_MASK)
+#define RTC_SR_TOF_MASK                          0x2u
+#define RTC_SR_TOF_SHIFT                         1
+#define RTC_SR_TOF(x)                            (((uint32_t)(((uint32_t)(x))<<RTC_SR_TOF_SHIFT))&RTC_SR_TOF_MASK)
+#define RTC_SR_TAF_MASK                          0x4u
+#define RTC_SR_TAF_SHIFT                         2
+#define RTC_SR_TAF(x)                            (((uint32_t)(((uint32_t)(x))<<RTC_SR_TAF_SHIFT))&RTC_SR_TAF_MASK)
+#define RTC_SR_TCE_MASK                          0x10u
+#define RTC_SR_TCE_SHIFT                         4
+#define RTC_SR_TCE(x)                            (((uint32_t)(((uint32_t)(x))<<RTC_SR_TCE_SHIFT))&RTC_SR_TCE_MASK)
+#define RTC_IER_TAIE_MASK                        0x4u
+#define RTC_IER_TAIE_SHIFT                       2
+#define RTC_IER_TAIE(x)                          (((uint32_t)(((uint32_t)(x))<<RTC_IER_TAIE_SHIFT))&RTC_IER_TAIE_MASK)
+#define RTC_IER_TSIE_MASK                        0x10u
+#define RTC_IER_TSIE_SHIFT                       4
+#define RTC_IER_TSIE(x)                          (((uint32_t)(((uint32_t)(x))<<RTC_IER_TSIE_SHIFT))&RTC_IER_TSIE_MASK)
+
+/*----------------------------------------------------------------------------*/
+// PIT, channel 0 counts down from 0xFFFFFFFF at 24 MHz since the start
+/*----------------------------------------------------------------------------*/
+typedef struct {
+  volatile uint32_t MCR;
+  uint8_t RESERVED_0[252];
+  struct {
+    volatile uint32_t LDVAL;
+    volatile uint32_t CVAL;
+    volatile uint32_t TCTRL;
+    volatile uint32_t TFLG;
+  } CHANNEL[2];
+} PIT_Type;
+
+PIT_Type *sim_pit(void);
+#define PIT                                      (sim_pit())
+
+/*----------------------------------------------------------------------------*/
+// SysTick, counts down from LOAD at the core clock while enabled
+/*----------------------------------------------------------------------------*/
+typedef struct {
+  volatile uint32_t CTRL;
+  volatile uint32_t LOAD;
+  volatile uint32_t VAL;
+  volatile uint32_t CALIB;
+} SysTick_Type;
+
+SysTick_Type *sim_systick(void);
+#define SysTick                                  (sim_systick())
+
+#define SysTick_CTRL_CLKSOURCE_Pos               2U
+#define SysTick_CTRL_CLKSOURCE_Msk               (1UL << SysTick_CTRL_CLKSOURCE_Pos)
+#define SysTick_CTRL_ENABLE_Pos                  0U
+#define SysTick_CTRL_ENABLE_Msk                  (1UL)
+#define SysTick_LOAD_RELOAD_Pos                  0U
+#define SysTick_LOAD_RELOAD_Msk                  (0xFFFFFFUL)
+
+/*----------------------------------------------------------------------------*/
+// MTB, registers only, no branches are recorded
+/*----------------------------------------------------------------------------*/
+typedef struct {
+  volatile uint32_t POSITION;
+  volatile uint32_t MASTER;
+  volatile uint32_t FLOW;
+  volatile uint32_t BASE;
+} MTB_Type;
+
+extern MTB_Type sim_mtb;
+#define MTB                                      (&sim_mtb)
+
+#define MTB_POSITION_WRAP_MASK                   0x4u
+#define MTB_POSITION_POINTER_MASK                0xFFFFFFF8u
+#define MTB_MASTER_MASK_MASK                     0x1Fu
+#define MTB_MASTER_MASK(x)                       (((uint32_t)(x))&MTB_MASTER_MASK_MASK)
+#define MTB_MASTER_EN_MASK                       0x80000000u
+
+#endif // MKL25Z4_H_
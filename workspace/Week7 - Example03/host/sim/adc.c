@@ -0,0 +1,365 @@
+/*! ***************************************************************************
+ *
+ * \brief     ADC0 conversion service of the host simulation
+ * \file      adc.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "adc.h"
+#include "sim.h"
+
+/*
+ * The API of adc/adc.c. A conversion takes ADC_CONVERSION_US for every
+ * averaged sample and completes in a simulated ADC0 interrupt. The results
+ * are read from the script in SIM_ADC, lines of "ms,channel,value" with the
+ * time since the start. A value is valid from its time until the next line
+ * for that channel. Channels without a value convert to 0.
+ *
+ * An exclusive owner of ADC0 only stops the service, its hardware triggers,
+ * the compare function and DMA are not simulated.
+ */
+
+// Request queue, the head is the request being converted
+static adc_request_t * volatile head = NULL;
+static adc_request_t * volatile tail = NULL;
+
+// Set by adc_acquire(), queued requests are kept until adc_release()
+static volatile bool exclusive = false;
+
+static int32_t script[SIM_SCRIPT_ROWS * 3];
+static uint32_t script_rows = 0;
+
+static void adc_complete(sim_event_t *e);
+static sim_event_t conversion = {.callback = adc_complete};
+
+void adc_init(void)
+{
+    static bool initialised = false;
+
+    if(initialised)
+    {
+        return;
+    }
+
+    initialised = true;
+
+    script_rows = sim_script_load("SIM_ADC", script, 3, SIM_SCRIPT_ROWS);
+
+    sim_start();
+}
+
+/*!
+ * \brief The simulated converter needs no calibration
+ */
+bool adc_calibrate(void)
+{
+    return true;
+}
+
+uint32_t adc_avg_samples(const adc_avg_t avg)
+{
+    return (avg == ADC_AVG_1) ? 1 : (4UL << (avg - ADC_AVG_4));
+}
+
+/*!
+ * \brief Returns the SC3 averaging bits for \p avg, as on the target
+ */
+uint8_t adc_sc3_avg(const adc_avg_t avg)
+{
+    if(avg == ADC_AVG_1)
+    {
+        return 0;
+    }
+
+    // AVGE and AVGS of ADC0_SC3
+    return (uint8_t)(0x04 | (avg - ADC_AVG_4));
+}
+
+/*!
+ * \brief Returns the value of a channel at the current time
+ */
+static uint16_t adc_value(const uint8_t channel)
+{
+    const int64_t ms = (int64_t)(sim_time_ns() / 1000000U);
+    int32_t value = 0;
+
+    for(uint32_t i=0; (i<script_rows) && (script[i * 3] <= ms); ++i)
+    {
+        if(script[(i * 3) + 1] == channel)
+        {
+            value = script[(i * 3) + 2];
+        }
+    }
+
+    return (uint16_t)((value < 0) ? 0 : ((value > 0xFFFF) ? 0xFFFF : value));
+}
+
+/*!
+ * \brief Starts the conversion of the request at the head of the queue
+ *
+ * Called from a critical section or from the interrupt handler.
+ */
+static void adc_begin(void)
+{
+    head->status = ADC_BUSY;
+
+    sim_event_start(&conversion, (uint64_t)ADC_CONVERSION_US * 1000U *
+        adc_avg_samples(head->avg), 0);
+}
+
+static void adc_enqueue(adc_request_t *r)
+{
+    r->status = ADC_QUEUED;
+    r->next = NULL;
+
+    if(tail == NULL)
+    {
+        head = r;
+        tail = r;
+
+        if(!exclusive)
+        {
+            adc_begin();
+        }
+    }
+    else
+    {
+        tail->next = r;
+        tail = r;
+    }
+}
+
+void adc_submit(adc_request_t *r)
+{
+    r->task = xTaskGetCurrentTaskHandle();
+
+    taskENTER_CRITICAL();
+    {
+        adc_enqueue(r);
+    }
+    taskEXIT_CRITICAL();
+}
+
+void adc_submit_from_isr(adc_request_t *r)
+{
+    r->task = NULL;
+
+    UBaseType_t uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        adc_enqueue(r);
+    }
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+/*!
+ * \brief Removes a request that did not complete in time from the queue
+ */
+static void adc_cancel(adc_request_t *r)
+{
+    taskENTER_CRITICAL();
+    {
+        if((r->status == ADC_QUEUED) || (r->status == ADC_BUSY))
+        {
+            if(head == r)
+            {
+                head = r->next;
+
+                if(r->status == ADC_BUSY)
+                {
+                    sim_event_stop(&conversion);
+
+                    if((head != NULL) && !exclusive)
+                    {
+                        adc_begin();
+                    }
+                }
+            }
+            else
+            {
+                adc_request_t *prev = head;
+                while(prev->next != r)
+                {
+                    prev = prev->next;
+                }
+
+                prev->next = r->next;
+            }
+
+            if(tail == r)
+            {
+                adc_request_t *t = head;
+                while((t != NULL) && (t->next != NULL))
+                {
+                    t = t->next;
+                }
+
+                tail = t;
+            }
+
+            r->status = ADC_CANCELLED;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+bool adc_wait(adc_request_t *r, const TickType_t timeout)
+{
+    TimeOut_t start;
+    TickType_t remaining = timeout;
+
+    vTaskSetTimeOutState(&start);
+
+    while((r->status == ADC_QUEUED) || (r->status == ADC_BUSY))
+    {
+        if(xTaskCheckForTimeOut(&start, &remaining) == pdTRUE)
+        {
+            adc_cancel(r);
+            break;
+        }
+
+        ulTaskNotifyTakeIndexed(ADC_NOTIFY_INDEX, pdTRUE, remaining);
+    }
+
+    return (r->status == ADC_DONE);
+}
+
+bool adc_convert(const uint8_t channel, const adc_avg_t avg, uint16_t *result,
+    const TickType_t timeout)
+{
+    adc_request_t r =
+    {
+        .channel = channel,
+        .avg = avg,
+        .callback = NULL,
+    };
+
+    adc_submit(&r);
+
+    if(!adc_wait(&r, timeout))
+    {
+        return false;
+    }
+
+    *result = r.result;
+
+    return true;
+}
+
+/*!
+ * \brief Takes exclusive ownership of ADC0
+ *
+ * Waits for the conversion in progress. The interrupt handler of the owner
+ * is never called.
+ */
+void adc_acquire(const adc_isr_t isr)
+{
+    bool busy;
+
+    (void)isr;
+
+    do
+    {
+        taskENTER_CRITICAL();
+        {
+            exclusive = true;
+            busy = (head != NULL) && (head->status == ADC_BUSY);
+        }
+        taskEXIT_CRITICAL();
+
+        if(busy)
+        {
+            vTaskDelay(1);
+        }
+    }
+    while(busy);
+}
+
+void adc_release(void)
+{
+    taskENTER_CRITICAL();
+    {
+        exclusive = false;
+
+        if(head != NULL)
+        {
+            adc_begin();
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief The compare function is not simulated
+ */
+void adc_set_compare(const adc_compare_t mode, const uint16_t cv1,
+    const uint16_t cv2)
+{
+    (void)mode;
+    (void)cv1;
+    (void)cv2;
+}
+
+/*!
+ * \brief Completes the request at the head of the queue in the simulated
+ *        ADC0 interrupt
+ */
+static void adc_complete(sim_event_t *e)
+{
+    BaseType_t woken = pdFALSE;
+
+    (void)e;
+
+    const uint32_t isr = sim_isr_enter(ADC0_IRQn);
+
+    adc_request_t *r = head;
+
+    if((r != NULL) && (r->status == ADC_BUSY))
+    {
+        head = r->next;
+        if(head == NULL)
+        {
+            tail = NULL;
+        }
+        else if(!exclusive)
+        {
+            adc_begin();
+        }
+
+        r->result = adc_value(r->channel);
+        r->status = ADC_DONE;
+
+        if(r->callback != NULL)
+        {
+            r->callback(r, &woken);
+        }
+        else if(r->task != NULL)
+        {
+            vTaskNotifyGiveIndexedFromISR(r->task, ADC_NOTIFY_INDEX, &woken);
+        }
+    }
+
+    sim_isr_exit(isr, woken);
+}
@@ -0,0 +1,115 @@
+/*! ***************************************************************************
+ *
+ * \brief     Simulated TPM input capture
+ * \file      capture.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdio.h>
+
+#include "capture.h"
+#include "clock.h"
+#include "sim.h"
+
+/*
+ * There is no signal by default, so cap_wait() times out. With
+ * SIM_CAPTURE="hz,duty_permille" the input is a square wave of that
+ * frequency and duty cycle, a window is completed every CAP_WINDOW edges.
+ */
+
+uint32_t cap_overruns = 0;
+
+static bool running = false;
+static cap_edge_t mode = CAP_BOTH;
+static uint32_t windows = 0;
+
+void cap_init(void)
+{
+}
+
+bool cap_start(const cap_edge_t edge, TaskHandle_t task)
+{
+    (void)task;
+
+    mode = edge;
+    windows = 0;
+    cap_overruns = 0;
+    running = true;
+
+    return true;
+}
+
+void cap_stop(void)
+{
+    running = false;
+}
+
+bool cap_wait(cap_result_t *result, const TickType_t timeout)
+{
+    unsigned int hz = 0;
+    unsigned int duty = 500;
+
+    (void)sscanf(sim_env("SIM_CAPTURE", ""), "%u,%u", &hz, &duty);
+
+    if(!running || (hz == 0) || (duty > 1000))
+    {
+        vTaskDelay(timeout);
+        return false;
+    }
+
+    // Window 0 has one interval less, see cap_measure() of the firmware
+    const uint32_t periods = (mode == CAP_BOTH) ?
+        ((CAP_WINDOW / 2) - ((windows == 0) ? 1 : 0)) :
+        (CAP_WINDOW - ((windows == 0) ? 1 : 0));
+    const TickType_t wait = pdMS_TO_TICKS((CAP_WINDOW * 1000U) /
+        ((mode == CAP_BOTH) ? (2U * hz) : hz)) + 1;
+
+    if(wait > timeout)
+    {
+        vTaskDelay(timeout);
+        return false;
+    }
+
+    vTaskDelay(wait);
+
+    const uint32_t ticks = clk_periph_hz() / hz;
+
+    result->window = windows++;
+    result->periods = periods;
+    result->period_ticks = ticks;
+    result->min_ticks = ticks;
+    result->max_ticks = ticks;
+    result->freq_mhz = hz * 1000U;
+    result->duty_permille = (mode == CAP_BOTH) ? duty : 0;
+    result->valid = (result->window > 0) && (ticks < 0x10000);
+
+    return true;
+}
+
+uint32_t cap_ticks_to_ns(const uint32_t ticks)
+{
+    return (uint32_t)(((uint64_t)ticks * 1000000000) / clk_periph_hz());
+}
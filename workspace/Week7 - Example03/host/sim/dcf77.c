@@ -0,0 +1,118 @@
+/*! ***************************************************************************
+ *
+ * \brief     DCF77 receiver of the host simulation
+ * \file      dcf77.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdlib.h>
+#include <time.h>
+
+#include "dcf77.h"
+#include "rtc.h"
+#include "sim.h"
+
+/*
+ * There is no receiver by default, so dcf77_fix_wait() times out. With
+ * SIM_DCF77=1 a fix is received at the next minute mark of the local time of
+ * the host and sets the RTC to it.
+ */
+
+uint32_t dcf77_frames = 0;
+uint32_t dcf77_errors = 0;
+
+static bool receiving = false;
+
+void dcf77_init(void)
+{
+    sim_start();
+}
+
+void dcf77_fix_start(void)
+{
+    receiving = true;
+}
+
+void dcf77_fix_stop(void)
+{
+    receiving = false;
+}
+
+bool dcf77_fix_wait(const TickType_t timeout)
+{
+    const bool enabled = (atoi(sim_env("SIM_DCF77", "0")) == 1);
+    bool ok = false;
+
+    if(!enabled || !receiving)
+    {
+        vTaskDelay(timeout);
+    }
+    else
+    {
+        // Time of the host with the tick masked, see sim_write()
+        const uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        const time_t now = time(NULL);
+        __set_PRIMASK(primask);
+
+        const TickType_t wait = pdMS_TO_TICKS((60 - (now % 60)) * 1000U);
+
+        if(wait > timeout)
+        {
+            vTaskDelay(timeout);
+        }
+        else
+        {
+            vTaskDelay(wait);
+
+            struct tm tm;
+            const time_t mark = now + (60 - (now % 60));
+
+            __disable_irq();
+            (void)localtime_r(&mark, &tm);
+            __set_PRIMASK(primask);
+
+            rtc_datetime_t datetime =
+            {
+                .year = (uint16_t)(tm.tm_year + 1900),
+                .month = (uint16_t)(tm.tm_mon + 1),
+                .day = (uint16_t)tm.tm_mday,
+                .hour = (uint16_t)tm.tm_hour,
+                .minute = (uint16_t)tm.tm_min,
+                .second = 0,
+                .weekday = (uint8_t)tm.tm_wday,
+            };
+
+            dcf77_frames++;
+            (void)rtc_sync(&datetime, rtc_get_timestamp());
+            ok = true;
+        }
+    }
+
+    dcf77_fix_stop();
+
+    return ok;
+}
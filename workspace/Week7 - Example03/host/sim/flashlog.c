@@ -0,0 +1,108 @@
+/*! ***************************************************************************
+ *
+ * \brief     Settings of the flash log in RAM for the host simulation
+ * \file      flashlog.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <string.h>
+
+#include "flashlog.h"
+
+/*
+ * The host has no flash. The settings of flog_config_save() are kept in RAM
+ * for the run of the simulation, so every run starts without settings, as
+ * a board with an erased settings sector.
+ */
+
+#define SETTINGS_MAX  (8)
+
+typedef struct
+{
+    bool used;
+    uint8_t type;
+    uint8_t len;
+    uint8_t data[FLOG_RECORD_MAX];
+}setting_t;
+
+static setting_t settings[SETTINGS_MAX];
+
+static setting_t *find(const uint8_t type)
+{
+    for(uint32_t i=0; i<SETTINGS_MAX; i++)
+    {
+        if(settings[i].used && (settings[i].type == type))
+        {
+            return &settings[i];
+        }
+    }
+
+    return NULL;
+}
+
+bool flog_config_load(const uint8_t type, void *data, const uint32_t len)
+{
+    const setting_t *s = find(type);
+
+    if((s == NULL) || (s->len != len))
+    {
+        return false;
+    }
+
+    memcpy(data, s->data, len);
+
+    return true;
+}
+
+bool flog_config_save(const uint8_t type, const void *data, const uint32_t len)
+{
+    setting_t *s = find(type);
+
+    if(len > FLOG_RECORD_MAX)
+    {
+        return false;
+    }
+
+    for(uint32_t i=0; (s == NULL) && (i<SETTINGS_MAX); i++)
+    {
+        if(!settings[i].used)
+        {
+            s = &settings[i];
+        }
+    }
+
+    if(s == NULL)
+    {
+        return false;
+    }
+
+    s->used = true;
+    s->type = type;
+    s->len = (uint8_t)len;
+    memcpy(s->data, data, len);
+
+    return true;
+}
@@ -0,0 +1,114 @@
+/*! ***************************************************************************
+ *
+ * \brief     FreeMASTER driver of the host simulation
+ * \file      freemaster.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "freemaster.h"
+
+/*
+ * FreeMASTER addresses the memory of the target with 32-bit addresses, which
+ * does not fit a 64-bit host. The driver is not available in the simulation,
+ * every request answers FMSTR_STC_NOTINIT and no character is taken from the
+ * command line.
+ */
+
+void fmstr_init(xComPortHandle port)
+{
+    (void)port;
+}
+
+bool fmstr_rx(const char c)
+{
+    (void)c;
+
+    return false;
+}
+
+uint8_t fmstr_rec_setup(const uint8_t *data, const uint32_t len)
+{
+    (void)data;
+    (void)len;
+
+    return FMSTR_STC_NOTINIT;
+}
+
+uint8_t fmstr_rec_start(void)
+{
+    return FMSTR_STC_NOTINIT;
+}
+
+uint8_t fmstr_rec_stop(void)
+{
+    return FMSTR_STC_NOTINIT;
+}
+
+uint8_t fmstr_rec_status(void)
+{
+    return FMSTR_STC_NOTINIT;
+}
+
+uint32_t fmstr_rec_buffer(uint16_t *start)
+{
+    *start = 0;
+
+    return 0;
+}
+
+uint16_t fmstr_rec_timebase(void)
+{
+    return 0;
+}
+
+void fmstr_recorder(void)
+{
+}
+
+void fmstr_rec_timer_start(const uint32_t rate_hz)
+{
+    (void)rate_hz;
+}
+
+void fmstr_rec_timer_stop(void)
+{
+}
+
+bool fmstr_readable(const uint32_t addr, const uint32_t size)
+{
+    (void)addr;
+    (void)size;
+
+    return false;
+}
+
+bool fmstr_writable(const uint32_t addr, const uint32_t size)
+{
+    (void)addr;
+    (void)size;
+
+    return false;
+}
@@ -0,0 +1,441 @@
+/*! ***************************************************************************
+ *
+ * \brief     I2C master driver of the host simulation
+ * \file      i2c.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "i2c.h"
+#include "sim.h"
+
+/*
+ * The API of i2c/i2c.c on simulated buses. Transfers are queued the same
+ * way and each takes the time of its bytes at the achieved bit rate. At the
+ * end of a transfer the bytes are passed to the slave model at its address,
+ * in a simulated I2C interrupt. Other addresses do not acknowledge.
+ */
+
+/// Bus event of a transfer on the bus
+static void i2c_event(sim_event_t *e);
+
+static sim_event_t i2c_event0 = {.callback = i2c_event, .arg = &i2c_bus0};
+static sim_event_t i2c_event1 = {.callback = i2c_event, .arg = &i2c_bus1};
+
+// Value of the frequency divider register of each bus
+static uint8_t i2c_f0;
+static uint8_t i2c_f1;
+
+i2c_bus_t i2c_bus0 =
+{
+    .irq = I2C0_IRQn,
+    .notify_index = I2C0_NOTIFY_INDEX,
+    .dma_channel = -1,
+    .bps = I2C0_DEFAULT_BPS,
+    .rate = I2C0_DEFAULT_BPS,
+};
+
+i2c_bus_t i2c_bus1 =
+{
+    .irq = I2C1_IRQn,
+    .notify_index = I2C1_NOTIFY_INDEX,
+    .dma_channel = -1,
+    .bps = I2C1_DEFAULT_BPS,
+    .rate = I2C1_DEFAULT_BPS,
+};
+
+static uint8_t *i2c_f(const i2c_bus_t *bus)
+{
+    return (bus == &i2c_bus0) ? &i2c_f0 : &i2c_f1;
+}
+
+static sim_event_t *i2c_bus_event(const i2c_bus_t *bus)
+{
+    return (bus == &i2c_bus0) ? &i2c_event0 : &i2c_event1;
+}
+
+/*!
+ * \brief Sets the requested bit rate again after a clock mode change
+ */
+static void i2c_clock(const clk_event_t event, void *arg)
+{
+    i2c_bus_t *bus = (i2c_bus_t *)arg;
+
+    if(event != CLK_POST_CHANGE)
+    {
+        return;
+    }
+
+    if(i2c_set_speed(bus, bus->bps) == 0)
+    {
+        bus->rate = i2c_speed_rate(*i2c_f(bus));
+    }
+}
+
+/*!
+ * \brief Initialises a simulated I2C bus
+ *
+ * \param[in,out]  bus  I2C peripheral instance
+ */
+void i2c_init(i2c_bus_t *bus)
+{
+    if(i2c_set_speed(bus, bus->bps) == 0)
+    {
+        *i2c_f(bus) = (I2C_F_MULT(0) | I2C_F_ICR(0x12));
+        bus->rate = i2c_speed_rate(*i2c_f(bus));
+    }
+
+    clk_register(&bus->clock, i2c_clock, bus);
+}
+
+/*!
+ * \brief Sets the bit rate of a simulated I2C bus
+ *
+ * \param[in,out]  bus  I2C peripheral instance
+ * \param[in]      bps  Requested bit rate
+ *
+ * \return The achieved bit rate, or 0 if \p bps cannot be achieved
+ */
+uint32_t i2c_set_speed(i2c_bus_t *bus, const uint32_t bps)
+{
+    uint8_t f;
+    uint32_t rate = i2c_speed_calc(bps, &f);
+
+    if(rate == 0)
+    {
+        return 0;
+    }
+
+    *i2c_f(bus) = f;
+
+    bus->bps = bps;
+    bus->rate = rate;
+
+    return rate;
+}
+
+uint32_t i2c_get_speed(const i2c_bus_t *bus)
+{
+    return bus->rate;
+}
+
+/*!
+ * \brief A simulated bus is never held by a slave
+ */
+void i2c_recover(i2c_bus_t *bus)
+{
+    (void)bus;
+}
+
+void i2c_get_stats(const i2c_bus_t *bus, i2c_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    {
+        *stats = bus->stats;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Passes a transfer to the slave at its address
+ *
+ * \return I2C_DONE, or I2C_NACK if there is no slave or it did not
+ *         acknowledge a byte
+ */
+static i2c_status_t i2c_slave(const i2c_bus_t *bus, i2c_xfer_t *t)
+{
+    bool ack = false;
+
+    if((bus == &i2c_bus1) &&
+       ((t->address & ~0x02) == SIM_SSD1306_ADDRESS) && (t->nrx == 0))
+    {
+        ack = sim_ssd1306_write(t->reg, t->tx, t->ntx);
+    }
+    else if((bus == &i2c_bus0) && (t->address == SIM_MMA8451_ADDRESS))
+    {
+        ack = true;
+
+        if(t->ntx > 0)
+        {
+            ack = sim_mma8451_write(t->reg, t->tx, t->ntx);
+        }
+
+        if(ack && (t->nrx > 0))
+        {
+            ack = sim_mma8451_read(t->reg, t->rx, t->nrx);
+        }
+    }
+
+    return ack ? I2C_DONE : I2C_NACK;
+}
+
+/*!
+ * \brief Starts the transfer at the head of the queue
+ *
+ * The transfer ends after the time of its bytes, each 9 bit times: the
+ * address, the register, the written bytes and, for a read, the repeated
+ * address and the read bytes.
+ */
+static void i2c_begin(i2c_bus_t *bus)
+{
+    const i2c_xfer_t *t = bus->head;
+    const uint64_t bytes = (uint64_t)t->ntx + t->nrx + 2 + ((t->nrx > 0) ? 1 : 0);
+
+    bus->head->status = I2C_BUSY;
+    bus->phase = I2C_PHASE_ADDRESS;
+    bus->idx = 0;
+    bus->stats.transfers++;
+
+    i2c_metrics_start(bus);
+
+    PROBE_HIGH(PROBE_I2C);
+
+    sim_event_start(i2c_bus_event(bus), (bytes * 9U * 1000000000U) / bus->rate,
+        0);
+}
+
+/*!
+ * \brief Ends the transfer at the head of the queue
+ *
+ * \return The ended transfer
+ */
+static i2c_xfer_t *i2c_pop(i2c_bus_t *bus, const i2c_status_t status,
+    const bool next)
+{
+    i2c_xfer_t *t = bus->head;
+
+    sim_event_stop(i2c_bus_event(bus));
+
+    PROBE_LOW(PROBE_I2C);
+
+    bus->head = t->next;
+    if(bus->head == NULL)
+    {
+        bus->tail = NULL;
+    }
+
+    i2c_metrics_end(bus, t, status, true);
+    t->status = status;
+
+    if(next && (bus->head != NULL))
+    {
+        i2c_begin(bus);
+    }
+
+    return t;
+}
+
+/*!
+ * \brief Ends the transfer on the bus in the simulated I2C interrupt
+ */
+static void i2c_event(sim_event_t *e)
+{
+    i2c_bus_t *bus = (i2c_bus_t *)e->arg;
+    BaseType_t woken = pdFALSE;
+
+    const uint32_t isr = sim_isr_enter(bus->irq);
+
+    if(bus->head != NULL)
+    {
+        const i2c_status_t status = i2c_slave(bus, bus->head);
+
+        if(status == I2C_NACK)
+        {
+            bus->stats.nacks++;
+        }
+
+        i2c_xfer_t *t = i2c_pop(bus, status, true);
+
+        vTaskNotifyGiveIndexedFromISR(t->task, bus->notify_index, &woken);
+    }
+
+    sim_isr_exit(isr, woken);
+}
+
+/*!
+ * \brief Executes a transfer immediately, before the scheduler is started
+ */
+static void i2c_transfer_polled(i2c_bus_t *bus, i2c_xfer_t *t)
+{
+    bus->stats.transfers++;
+
+    t->queued = i2c_metrics_now();
+    i2c_metrics_start(bus);
+
+    t->status = i2c_slave(bus, t);
+
+    if(t->status == I2C_NACK)
+    {
+        bus->stats.nacks++;
+    }
+
+    i2c_metrics_end(bus, t, t->status, true);
+}
+
+void i2c_submit(i2c_bus_t *bus, i2c_xfer_t *t)
+{
+    t->task = xTaskGetCurrentTaskHandle();
+    t->status = I2C_QUEUED;
+    t->next = NULL;
+    t->queued = i2c_metrics_now();
+
+    taskENTER_CRITICAL();
+    {
+        if(bus->tail == NULL)
+        {
+            bus->head = t;
+            bus->tail = t;
+            i2c_begin(bus);
+        }
+        else
+        {
+            bus->tail->next = t;
+            bus->tail = t;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Removes a transfer that did not complete in time from the queue
+ */
+static void i2c_cancel(i2c_bus_t *bus, i2c_xfer_t *t)
+{
+    taskENTER_CRITICAL();
+    {
+        if(t->status == I2C_BUSY)
+        {
+            bus->stats.timeouts++;
+
+            (void)i2c_pop(bus, I2C_TIMED_OUT, true);
+        }
+        else if(t->status == I2C_QUEUED)
+        {
+            bus->stats.timeouts++;
+
+            // Not on the bus, so it is not the head
+            i2c_xfer_t *prev = bus->head;
+            while(prev->next != t)
+            {
+                prev = prev->next;
+            }
+
+            prev->next = t->next;
+            if(bus->tail == t)
+            {
+                bus->tail = prev;
+            }
+
+            i2c_metrics_end(bus, t, I2C_TIMED_OUT, false);
+            t->status = I2C_TIMED_OUT;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+bool i2c_wait(i2c_bus_t *bus, i2c_xfer_t *t, const TickType_t timeout)
+{
+    TimeOut_t start;
+    TickType_t remaining = timeout;
+
+    vTaskSetTimeOutState(&start);
+
+    while((t->status == I2C_QUEUED) || (t->status == I2C_BUSY))
+    {
+        if(xTaskCheckForTimeOut(&start, &remaining) == pdTRUE)
+        {
+            i2c_cancel(bus, t);
+            break;
+        }
+
+        ulTaskNotifyTakeIndexed(bus->notify_index, pdTRUE, remaining);
+    }
+
+    return (t->status == I2C_DONE);
+}
+
+bool i2c_transfer(i2c_bus_t *bus, i2c_xfer_t *t)
+{
+    const uint32_t bytes = t->ntx + t->nrx + 3;
+    const TickType_t timeout = pdMS_TO_TICKS((bytes * 9 * 1000) / bus->rate +
+        I2C_TIMEOUT_MARGIN_MS);
+
+    for(uint32_t attempt=0; attempt<=I2C_RETRIES; ++attempt)
+    {
+        if(attempt > 0)
+        {
+            bus->stats.retries++;
+        }
+
+        if(xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+        {
+            i2c_transfer_polled(bus, t);
+        }
+        else
+        {
+            i2c_submit(bus, t);
+            (void)i2c_wait(bus, t, timeout);
+        }
+
+        if(t->status == I2C_DONE)
+        {
+            return true;
+        }
+    }
+
+    bus->stats.failures++;
+
+    return false;
+}
+
+bool i2c_write(i2c_bus_t *bus, const uint8_t address, const uint8_t reg,
+    const uint8_t data[], const uint32_t n)
+{
+    i2c_xfer_t t =
+    {
+        .address = address,
+        .reg = reg,
+        .tx = data,
+        .ntx = n,
+        .nrx = 0,
+    };
+
+    return i2c_transfer(bus, &t);
+}
+
+bool i2c_read(i2c_bus_t *bus, const uint8_t address, const uint8_t reg,
+    uint8_t data[], const uint32_t n)
+{
+    i2c_xfer_t t =
+    {
+        .address = address,
+        .reg = reg,
+        .ntx = 0,
+        .rx = data,
+        .nrx = n,
+    };
+
+    return i2c_transfer(bus, &t);
+}
@@ -0,0 +1,112 @@
+/*! ***************************************************************************
+ *
+ * \brief     Low power idle of the host simulation
+ * \file      lowpower.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "lowpower.h"
+
+/*
+ * The host has no stop modes. Only the blockers of lp_deep_allowed() are
+ * kept, the peripherals of the MCU are not checked.
+ */
+
+static volatile uint32_t blockers[LP_CLIENTS];
+
+void lp_init(void)
+{
+}
+
+bool lp_deep_allowed(void)
+{
+    for(uint32_t i=0; i<LP_CLIENTS; i++)
+    {
+        if(blockers[i] != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void lp_deep_block(const lp_client_t client)
+{
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    {
+        blockers[client]++;
+    }
+    __set_PRIMASK(primask);
+}
+
+void lp_deep_unblock(const lp_client_t client)
+{
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    {
+        if(blockers[client] > 0)
+        {
+            blockers[client]--;
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+/*!
+ * \brief Keeps the registration, there is no stop mode to notify of
+ */
+void lp_register(lp_notifier_t *n, lp_callback_t callback, void *arg)
+{
+    n->callback = callback;
+    n->arg = arg;
+    n->next = NULL;
+}
+
+/*!
+ * \brief Not used, the POSIX port has no tickless idle
+ */
+void lp_suppress_ticks_and_sleep(const uint32_t expected)
+{
+    (void)expected;
+}
+
+/*!
+ * \brief Not used, the host never sleeps, the power profile is all LP_RUN
+ */
+void lp_pre_sleep(void)
+{
+}
+
+void lp_post_sleep(void)
+{
+}
@@ -0,0 +1,429 @@
+/*! ***************************************************************************
+ *
+ * \brief     Model of the MMA8451 accelerometer of the host simulation
+ * \file      mma8451_model.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <string.h>
+
+#include "mma8451.h"
+#include "sim.h"
+
+/*
+ * The registers, the output data rate, the data ready and FIFO interrupts,
+ * the offset registers, the range and the fast read mode are modelled. The
+ * embedded functions (motion, transient, tap and orientation detection and
+ * auto-sleep) are accepted and never raise an event.
+ *
+ * The acceleration is read from the script in SIM_ACCEL, lines of
+ * "ms,x_mg,y_mg,z_mg" with the time since the start. A value is valid from
+ * its time until the next line. Without a script the board lies flat, at
+ * 0, 0 and 1000 mg.
+ */
+
+/// \name Definitions for the MMA8451 model
+/// \{
+
+#define MMA_REGS       (0x32)
+
+#define MMA_F_MODE(r)  (((r)[F_SETUP_REG] >> 6) & 0x03)
+#define MMA_F_WMRK(r)  ((r)[F_SETUP_REG] & 0x3F)
+
+#define MMA_INT_DRDY   (0x01)
+#define MMA_INT_FIFO   (0x40)
+
+/// \}
+
+// Sample period in ns for every ODR of CTRL_REG1
+static const uint64_t odr_period_ns[] =
+{
+    1250000, 2500000, 5000000, 10000000, 20000000, 80000000, 160000000,
+    640000000,
+};
+
+static uint8_t reg[MMA_REGS];
+
+// Sample in 14-bit counts of the output registers and the FIFO
+static int16_t out[3];
+static int16_t fifo[MMA8451_FIFO_SIZE][3];
+static uint32_t fifo_n = 0;
+static bool fifo_overflow = false;
+
+// Data ready and overwritten since the sample was read
+static bool drdy = false;
+static bool overwritten = false;
+
+static int32_t script[SIM_SCRIPT_ROWS * 4];
+static uint32_t script_rows = 0;
+static bool script_loaded = false;
+
+static void mma_sample(sim_event_t *e);
+static sim_event_t odr_event = {.callback = mma_sample};
+
+/*!
+ * \brief Sets the registers to their reset values
+ */
+static void mma_reset(void)
+{
+    memset(reg, 0, sizeof(reg));
+    reg[WHO_AM_I_REG] = WHO_AM_I_VAL;
+    reg[PL_CFG_REG] = 0x80;
+    reg[CTRL_REG1] = 0x00;
+
+    fifo_n = 0;
+    fifo_overflow = false;
+    drdy = false;
+    overwritten = false;
+
+    sim_event_stop(&odr_event);
+}
+
+/*!
+ * \brief Resets the registers on the first access after power up
+ *
+ * WHO_AM_I is read only, so it is 0 only before the reset.
+ */
+static void mma_power_up(void)
+{
+    if(reg[WHO_AM_I_REG] == 0)
+    {
+        mma_reset();
+    }
+}
+
+/*!
+ * \brief Returns the interrupt sources that are active
+ */
+static uint8_t mma_sources(void)
+{
+    uint8_t src = 0;
+
+    if(MMA_F_MODE(reg) == 0)
+    {
+        src |= drdy ? MMA_INT_DRDY : 0;
+    }
+    else if(fifo_overflow ||
+            ((MMA_F_WMRK(reg) > 0) && (fifo_n >= MMA_F_WMRK(reg))))
+    {
+        src |= MMA_INT_FIFO;
+    }
+
+    return src;
+}
+
+/*!
+ * \brief Drives INT1 and INT2 from the enabled and routed sources
+ *
+ * The pins are active low unless IPOL is set in CTRL_REG3.
+ */
+static void mma_interrupts(void)
+{
+    const uint8_t src = mma_sources() & reg[CTRL_REG4];
+    const bool ipol = (reg[CTRL_REG3] & 0x02) != 0;
+
+    reg[INT_SOURCE_REG] = src;
+
+    sim_pin_set(0, SIM_MMA_INT1_PIN, ((src & reg[CTRL_REG5]) != 0) == ipol);
+    sim_pin_set(0, SIM_MMA_INT2_PIN, ((src & ~reg[CTRL_REG5]) != 0) == ipol);
+}
+
+/*!
+ * \brief Returns the acceleration in mg of an axis at the current time
+ */
+static int32_t mma_script(const uint32_t axis)
+{
+    static const int32_t flat[3] = {0, 0, 1000};
+
+    if(!script_loaded)
+    {
+        script_rows = sim_script_load("SIM_ACCEL", script, 4, SIM_SCRIPT_ROWS);
+        script_loaded = true;
+    }
+
+    const int64_t ms = (int64_t)(sim_time_ns() / 1000000U);
+    int32_t value = flat[axis];
+
+    for(uint32_t i=0; (i<script_rows) && (script[i * 4] <= ms); ++i)
+    {
+        value = script[(i * 4) + 1 + axis];
+    }
+
+    return value;
+}
+
+/*!
+ * \brief Takes a sample at the output data rate
+ */
+static void mma_sample(sim_event_t *e)
+{
+    (void)e;
+
+    // Range of XYZ_DATA_CFG, 4096 counts per g at 2g
+    const int32_t counts_per_g = COUNTS_PER_G >> (reg[XYZ_DATA_CFG_REG] & 0x03);
+    int16_t sample[3];
+
+    for(uint32_t i=0; i<3; ++i)
+    {
+        // An offset LSB is 2 mg
+        const int32_t mg = mma_script(i) + (2 * (int8_t)reg[OFF_X_REG + i]);
+        int32_t v = (mg * counts_per_g) / 1000;
+
+        v = (v > 8191) ? 8191 : ((v < -8192) ? -8192 : v);
+        sample[i] = (int16_t)v;
+    }
+
+    memcpy(out, sample, sizeof(out));
+
+    if(MMA_F_MODE(reg) == 0)
+    {
+        overwritten = drdy;
+        drdy = true;
+    }
+    else
+    {
+        if(fifo_n == MMA8451_FIFO_SIZE)
+        {
+            fifo_overflow = true;
+
+            if(MMA_F_MODE(reg) == 1)
+            {
+                // Circular mode: the oldest sample is dropped
+                memmove(fifo[0], fifo[1], sizeof(fifo[0]) * (fifo_n - 1));
+                fifo_n--;
+            }
+        }
+
+        if(fifo_n < MMA8451_FIFO_SIZE)
+        {
+            memcpy(fifo[fifo_n++], sample, sizeof(sample));
+        }
+    }
+
+    mma_interrupts();
+}
+
+/*!
+ * \brief Starts or stops the samples when CTRL_REG1 is written
+ */
+static void mma_ctrl_reg1(void)
+{
+    if(reg[CTRL_REG1] & 0x01)
+    {
+        const uint64_t period = odr_period_ns[(reg[CTRL_REG1] >> 3) & 0x07];
+
+        reg[SYSMOD_REG] = 0x01;
+        sim_event_start(&odr_event, period, period);
+    }
+    else
+    {
+        reg[SYSMOD_REG] = 0x00;
+        sim_event_stop(&odr_event);
+    }
+}
+
+/*!
+ * \brief Returns the value of a register for a read
+ */
+static uint8_t mma_register(const uint8_t r, const int16_t sample[])
+{
+    const bool fifo_mode = (MMA_F_MODE(reg) != 0);
+
+    switch(r)
+    {
+    case STATUS_REG:
+        if(fifo_mode)
+        {
+            return (uint8_t)((fifo_overflow ? 0x80 : 0) |
+                ((mma_sources() & MMA_INT_FIFO) ? 0x40 : 0) | fifo_n);
+        }
+
+        return (uint8_t)((overwritten ? 0xF0 : 0) | (drdy ? 0x0F : 0));
+
+    case OUT_X_MSB_REG: case OUT_Y_MSB_REG: case OUT_Z_MSB_REG:
+        return (uint8_t)((uint16_t)sample[(r - OUT_X_MSB_REG) / 2] >> 6);
+
+    case OUT_X_LSB_REG: case OUT_Y_LSB_REG: case OUT_Z_LSB_REG:
+        return (uint8_t)(((uint16_t)sample[(r - OUT_X_LSB_REG) / 2] << 2) & 0xFC);
+
+    default:
+        return (r < MMA_REGS) ? reg[r] : 0;
+    }
+}
+
+/*!
+ * \brief Writes registers, starting at reg
+ *
+ * \return False if the first register does not exist
+ */
+bool sim_mma8451_write(const uint8_t r, const uint8_t data[],
+    const uint32_t n)
+{
+    mma_power_up();
+
+    if(r >= MMA_REGS)
+    {
+        return false;
+    }
+
+    for(uint32_t i=0; (i<n) && ((r + i) < MMA_REGS); ++i)
+    {
+        const uint8_t a = (uint8_t)(r + i);
+
+        switch(a)
+        {
+        case STATUS_REG: case OUT_X_MSB_REG: case OUT_X_LSB_REG:
+        case OUT_Y_MSB_REG: case OUT_Y_LSB_REG: case OUT_Z_MSB_REG:
+        case OUT_Z_LSB_REG: case SYSMOD_REG: case INT_SOURCE_REG:
+        case WHO_AM_I_REG:
+            // Read only
+            break;
+
+        case CTRL_REG2:
+            if(data[i] & 0x40)
+            {
+                // The reset bit clears itself
+                mma_reset();
+            }
+            else
+            {
+                reg[a] = data[i];
+            }
+            break;
+
+        case CTRL_REG1:
+            reg[a] = data[i];
+            mma_ctrl_reg1();
+            break;
+
+        case F_SETUP_REG:
+            reg[a] = data[i];
+            fifo_n = 0;
+            fifo_overflow = false;
+            break;
+
+        default:
+            reg[a] = data[i];
+            break;
+        }
+    }
+
+    mma_interrupts();
+
+    return true;
+}
+
+/*!
+ * \brief Reads registers, starting at reg
+ *
+ * The address increments through the output registers, skipping the LSBs
+ * in fast read mode. In FIFO mode a read past OUT_Z takes the next sample
+ * from the FIFO and continues at OUT_X_MSB. Reading the output registers
+ * clears data ready, or takes the samples read from the FIFO.
+ *
+ * \return False if the first register does not exist
+ */
+bool sim_mma8451_read(const uint8_t r, uint8_t data[], const uint32_t n)
+{
+    mma_power_up();
+
+    if(r >= MMA_REGS)
+    {
+        return false;
+    }
+
+    const bool fast = (reg[CTRL_REG1] & 0x02) != 0;
+    const bool fifo_mode = (MMA_F_MODE(reg) != 0);
+    const uint8_t last = fast ? OUT_Z_MSB_REG : OUT_Z_LSB_REG;
+
+    int16_t sample[3];
+    bool read_out = false;
+    uint32_t popped = 0;
+    uint8_t a = r;
+
+    if(fifo_mode)
+    {
+        memcpy(sample, (fifo_n > 0) ? fifo[0] : out, sizeof(sample));
+    }
+    else
+    {
+        memcpy(sample, out, sizeof(sample));
+    }
+
+    for(uint32_t i=0; i<n; ++i)
+    {
+        data[i] = mma_register(a, sample);
+
+        if((a >= OUT_X_MSB_REG) && (a <= OUT_Z_LSB_REG))
+        {
+            read_out = true;
+        }
+
+        if(a == last)
+        {
+            if(fifo_mode)
+            {
+                popped++;
+
+                if(popped < fifo_n)
+                {
+                    memcpy(sample, fifo[popped], sizeof(sample));
+                }
+
+                a = OUT_X_MSB_REG;
+            }
+            else
+            {
+                a = STATUS_REG;
+            }
+        }
+        else if(fast && (a >= OUT_X_MSB_REG) && (a < OUT_Z_MSB_REG))
+        {
+            a = (uint8_t)(a + 2);
+        }
+        else
+        {
+            a = (uint8_t)((a + 1) % MMA_REGS);
+        }
+    }
+
+    if(fifo_mode && (popped > 0))
+    {
+        popped = (popped > fifo_n) ? fifo_n : popped;
+        memmove(fifo[0], fifo[popped], sizeof(fifo[0]) * (fifo_n - popped));
+        fifo_n -= popped;
+        fifo_overflow = false;
+    }
+    else if(!fifo_mode && read_out)
+    {
+        drdy = false;
+        overwritten = false;
+    }
+
+    mma_interrupts();
+
+    return true;
+}
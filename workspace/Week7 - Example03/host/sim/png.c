@@ -0,0 +1,233 @@
+/*! ***************************************************************************
+ *
+ * \brief     Grayscale PNG writer of the host simulation
+ * \file      png.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdio.h>
+
+#include "png.h"
+
+/*
+ * The image data is deflated with stored blocks only, so the writer needs no
+ * compression library. A 128 x 64 display scaled by 4 is 128 kB per frame.
+ */
+
+/// Largest stored deflate block
+#define PNG_BLOCK_MAX (65535U)
+
+/*!
+ * \brief Output file with the running checksums
+ */
+typedef struct
+{
+    FILE *f;
+    uint32_t crc;    ///< CRC-32 of the chunk
+    uint32_t s1, s2; ///< Adler-32 of the zlib stream
+}png_out_t;
+
+static uint32_t crc_table[256];
+
+/*!
+ * \brief Fills the table of the CRC-32 of the PNG specification
+ */
+static void png_crc_init(void)
+{
+    for(uint32_t n=0; n<256; ++n)
+    {
+        uint32_t c = n;
+
+        for(uint32_t k=0; k<8; ++k)
+        {
+            c = (c & 1U) ? (0xEDB88320UL ^ (c >> 1)) : (c >> 1);
+        }
+
+        crc_table[n] = c;
+    }
+}
+
+/*!
+ * \brief Writes bytes of a chunk and updates its CRC
+ */
+static void png_put(png_out_t *out, const uint8_t data[], const uint32_t n)
+{
+    for(uint32_t i=0; i<n; ++i)
+    {
+        out->crc = crc_table[(out->crc ^ data[i]) & 0xFF] ^ (out->crc >> 8);
+    }
+
+    fwrite(data, 1, n, out->f);
+}
+
+/*!
+ * \brief Writes a big endian word of a chunk
+ */
+static void png_put32(png_out_t *out, const uint32_t v)
+{
+    const uint8_t b[4] = {v >> 24, v >> 16, v >> 8, v};
+
+    png_put(out, b, sizeof(b));
+}
+
+/*!
+ * \brief Writes image data and updates the Adler-32 of the zlib stream
+ */
+static void png_put_data(png_out_t *out, const uint8_t data[], const uint32_t n)
+{
+    for(uint32_t i=0; i<n; ++i)
+    {
+        out->s1 = (out->s1 + data[i]) % 65521U;
+        out->s2 = (out->s2 + out->s1) % 65521U;
+    }
+
+    png_put(out, data, n);
+}
+
+/*!
+ * \brief Starts a chunk of n data bytes
+ */
+static void png_chunk_start(png_out_t *out, const char type[4], const uint32_t n)
+{
+    const uint8_t len[4] = {n >> 24, n >> 16, n >> 8, n};
+
+    fwrite(len, 1, sizeof(len), out->f);
+
+    out->crc = 0xFFFFFFFFUL;
+    png_put(out, (const uint8_t *)type, 4);
+}
+
+/*!
+ * \brief Ends a chunk with its CRC
+ */
+static void png_chunk_end(png_out_t *out)
+{
+    const uint32_t crc = out->crc ^ 0xFFFFFFFFUL;
+    const uint8_t b[4] = {crc >> 24, crc >> 16, crc >> 8, crc};
+
+    fwrite(b, 1, sizeof(b), out->f);
+}
+
+/*!
+ * \brief Writes an 8-bit grayscale image
+ *
+ * Every row of the image data starts with filter type 0, the rows are
+ * split over stored deflate blocks.
+ *
+ * \param[in]  path    File name
+ * \param[in]  pixels  width * height gray values, row by row
+ * \param[in]  width   Width in pixels
+ * \param[in]  height  Height in pixels
+ *
+ * \return False if the file could not be written
+ */
+bool png_write_gray(const char *path, const uint8_t pixels[],
+    const uint32_t width, const uint32_t height)
+{
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    static const uint8_t zlib_header[2] = {0x78, 0x01};
+
+    png_out_t out = {.f = fopen(path, "wb"), .s1 = 1, .s2 = 0};
+
+    if(out.f == NULL)
+    {
+        return false;
+    }
+
+    if(crc_table[1] == 0)
+    {
+        png_crc_init();
+    }
+
+    fwrite(signature, 1, sizeof(signature), out.f);
+
+    // Width, height, bit depth 8, grayscale, deflate, no filters, no interlace
+    png_chunk_start(&out, "IHDR", 13);
+    png_put32(&out, width);
+    png_put32(&out, height);
+    png_put(&out, (const uint8_t[]){8, 0, 0, 0, 0}, 5);
+    png_chunk_end(&out);
+
+    const uint32_t raw = (width + 1) * height;
+    const uint32_t blocks = (raw + PNG_BLOCK_MAX - 1) / PNG_BLOCK_MAX;
+
+    png_chunk_start(&out, "IDAT", sizeof(zlib_header) + (blocks * 5) + raw + 4);
+    png_put(&out, zlib_header, sizeof(zlib_header));
+
+    // Position in the filtered image data: a filter byte and a row of pixels
+    uint32_t row = 0;
+    uint32_t col = 0;
+
+    for(uint32_t left=raw; left>0; )
+    {
+        const uint32_t n = (left > PNG_BLOCK_MAX) ? PNG_BLOCK_MAX : left;
+        left -= n;
+
+        const uint8_t header[5] = {(left == 0) ? 1 : 0, n, n >> 8,
+                                   ~n, (~n) >> 8};
+        png_put(&out, header, sizeof(header));
+
+        for(uint32_t i=0; i<n; )
+        {
+            if(col == 0)
+            {
+                png_put_data(&out, (const uint8_t[]){0}, 1);
+                col = 1;
+                i++;
+                continue;
+            }
+
+            // The rest of the row, or what fits in this block
+            uint32_t k = (width + 1) - col;
+
+            if(k > (n - i))
+            {
+                k = n - i;
+            }
+
+            png_put_data(&out, &pixels[(row * width) + (col - 1)], k);
+
+            col += k;
+            i += k;
+
+            if(col > width)
+            {
+                col = 0;
+                row++;
+            }
+        }
+    }
+
+    png_put32(&out, (out.s2 << 16) | out.s1);
+    png_chunk_end(&out);
+
+    png_chunk_start(&out, "IEND", 0);
+    png_chunk_end(&out);
+
+    const bool ok = (ferror(out.f) == 0);
+
+    return (fclose(out.f) == 0) && ok;
+}
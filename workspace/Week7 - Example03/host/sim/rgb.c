@@ -0,0 +1,170 @@
+/*! ***************************************************************************
+ *
+ * \brief     RGB LED of the host simulation
+ * \file      rgb.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "rgb.h"
+#include "clock.h"
+#include "sim.h"
+
+/*
+ * The API of rgb/rgb.c without an output. The compare values are kept and
+ * an effect only plays for the time it would play on the target.
+ */
+
+// Compare values of the red, green and blue LED
+static uint16_t cnv[3];
+
+// Start time and duration of the playing effect, 0 plays until rgb_stop()
+static bool fx_playing = false;
+static uint64_t fx_start_ns;
+static uint64_t fx_duration_ns;
+
+// End time of the fade, the colour is set at its start
+static bool fd_fading = false;
+static uint64_t fd_end_ns;
+
+void rgb_init(void)
+{
+    cnv[RGB_RED] = 0;
+    cnv[RGB_GREEN] = 0;
+    cnv[RGB_BLUE] = 0;
+}
+
+void rgb_pwmcontrol(const uint16_t r, const uint16_t g, const uint16_t b)
+{
+    cnv[RGB_RED] = r;
+    cnv[RGB_GREEN] = g;
+    cnv[RGB_BLUE] = b;
+}
+
+void rgb_on(const bool r, const bool g, const bool b)
+{
+    fd_fading = false;
+    rgb_red_on(r);
+    rgb_green_on(g);
+    rgb_blue_on(b);
+}
+
+void rgb_red_on(const bool r)
+{
+    fd_fading = false;
+    cnv[RGB_RED] = r ? rgb_compare(RGB_RED, RGB_ON_LEVEL << 8) : 0;
+}
+
+void rgb_green_on(const bool g)
+{
+    fd_fading = false;
+    cnv[RGB_GREEN] = g ? rgb_compare(RGB_GREEN, RGB_ON_LEVEL << 8) : 0;
+}
+
+void rgb_blue_on(const bool b)
+{
+    fd_fading = false;
+    cnv[RGB_BLUE] = b ? rgb_compare(RGB_BLUE, RGB_ON_LEVEL << 8) : 0;
+}
+
+void rgb_set(const rgb_color_t *color)
+{
+    rgb_stop();
+    fd_fading = false;
+
+    rgb_pwmcontrol(rgb_compare(RGB_RED, color->r << 8),
+                   rgb_compare(RGB_GREEN, color->g << 8),
+                   rgb_compare(RGB_BLUE, color->b << 8));
+}
+
+/*!
+ * \brief Fades to a colour, checks the duration as on the target
+ */
+bool rgb_fade(const rgb_color_t *color, const uint32_t ms)
+{
+    if(ms > RGB_FADE_MAX_MS)
+    {
+        return false;
+    }
+
+    rgb_set(color);
+
+    fd_end_ns = sim_time_ns() + (uint64_t)ms * 1000000U;
+    fd_fading = true;
+
+    return true;
+}
+
+bool rgb_fading(void)
+{
+    if(fd_fading && (sim_time_ns() >= fd_end_ns))
+    {
+        fd_fading = false;
+    }
+
+    return fd_fading;
+}
+
+/*!
+ * \brief Plays an effect, checks the period as on the target
+ */
+bool rgb_play(const rgb_effect_t *effect, const uint32_t period_ms,
+    const uint32_t repeat)
+{
+    const uint32_t steps = (period_ms * (clk_periph_hz() / 1000UL)) / 65536UL;
+
+    rgb_stop();
+    fd_fading = false;
+
+    if((steps < 2) || (steps > RGB_FX_MAX_STEPS))
+    {
+        return false;
+    }
+
+    // Every waveform ends with the LED off
+    cnv[effect->led] = 0;
+
+    fx_start_ns = sim_time_ns();
+    fx_duration_ns = (uint64_t)period_ms * 1000000U * repeat;
+    fx_playing = true;
+
+    return true;
+}
+
+void rgb_stop(void)
+{
+    fx_playing = false;
+}
+
+bool rgb_playing(void)
+{
+    if(fx_playing && (fx_duration_ns != 0) &&
+       ((sim_time_ns() - fx_start_ns) >= fx_duration_ns))
+    {
+        fx_playing = false;
+    }
+
+    return fx_playing;
+}
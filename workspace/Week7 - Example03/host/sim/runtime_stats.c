@@ -0,0 +1,67 @@
+/*! ***************************************************************************
+ *
+ * \brief     Functions for generating task run-time statistics in the host simulation
+ * \file      runtime_stats.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "runtime_stats.h"
+#include "sim.h"
+
+/* The run time is the simulated time in rtsCLOCK_HZ cycles, as on the target
+ * in every clock mode. */
+
+void vConfigureTimerForRunTimeStats( void )
+{
+	/* Nothing to configure, the simulated time starts with the process. */
+}
+
+/* Returns the number of rtsCLOCK_HZ cycles since the start. */
+uint64_t ullRunTimeCounterValue( void )
+{
+	return ( sim_time_ns() * ( rtsCLOCK_HZ / 1000000UL ) ) / 1000U;
+}
+
+/* Used by portGET_RUN_TIME_COUNTER_VALUE() of the POSIX port, linked with
+ * -Wl,--wrap=ulPortGetRunTime. */
+unsigned long __wrap_ulPortGetRunTime( void );
+
+unsigned long __wrap_ulPortGetRunTime( void )
+{
+	return ( unsigned long ) ullRunTimeCounterValue();
+}
+
+/* Returns the run time in ticks of rtsTICK_US microseconds. */
+uint32_t ulRunTimeTicks( void )
+{
+	return ( uint32_t ) ( ullRunTimeCounterValue() / rtsTICK_CYCLES );
+}
+
+/* Returns the run time in microseconds. */
+uint32_t ulRunTimeMicroseconds( void )
+{
+	return sim_time_us();
+}
@@ -0,0 +1,571 @@
+/*! ***************************************************************************
+ *
+ * \brief     Serial ports of the host simulation on stdin and stdout
+ * \file      serial.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "task.h"
+
+#include "serial.h"
+#include "sim.h"
+#include "xprintf.h"
+
+/*
+ * serCOM1 (UART0, the OpenSDA port) writes to stdout and receives from stdin.
+ * serCOM2 and serCOM3 discard what is written and receive nothing. A write
+ * goes to stdout at once, so the transmit policies never drop and the
+ * transmit high water mark stays 0. Received bytes pass through a stream
+ * buffer like on the target, filled by a simulated receive interrupt that
+ * polls stdin every serRX_POLL_MS. In loop mode a write goes to the receive
+ * buffer of the port instead, and stdin is not polled.
+ */
+
+/// Poll interval of stdin in ms
+#ifndef serRX_POLL_MS
+#define serRX_POLL_MS           1
+#endif
+
+/// Receive stream buffer size, a larger uxQueueLength is clipped
+#define serRX_BUFFER_MAX        256
+
+struct xCOM_PORT
+{
+    eCOMPort ePort;
+    unsigned long ulBaudRate;
+    eSerialTxPolicy eTxPolicy;
+    TickType_t xTxPolicyBlockTime;
+    SemaphoreHandle_t xStringMutex;
+    StaticSemaphore_t xStringMutexBuffer;
+    StreamBufferHandle_t xRxedChars;
+    StaticStreamBuffer_t xRxedCharsBuffer;
+    uint8_t ucRxStorage[ serRX_BUFFER_MAX + 1 ];
+    SerialStats_t xStats;
+    portBASE_TYPE xOpen;
+    portBASE_TYPE xLoopback;
+    SerialRxCallback_t pxRxCallback;
+    void * pvRxCallbackArg;
+};
+
+static struct xCOM_PORT xPorts[ serNUM_PORTS ];
+static xComPortHandle xDefaultPort = NULL;
+
+static sim_event_t xRxEvent;
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Simulated UART0 receive interrupt: moves the bytes waiting on stdin into the
+ * receive stream buffer. Polling stops at the end of stdin.
+ */
+static void prvSerialRxPoll( sim_event_t *e )
+{
+    xComPortHandle pxPort = &xPorts[ serCOM1 ];
+    BaseType_t xWoken = pdFALSE;
+    uint8_t ucBuffer[ 32 ];
+
+    // The receiver is connected to the transmitter in loop mode
+    if( pxPort->xLoopback != pdFALSE )
+    {
+        return;
+    }
+
+    const uint32_t ulIsr = sim_isr_enter( UART0_IRQn );
+
+    for( ;; )
+    {
+        size_t xSpace = xStreamBufferSpacesAvailable( pxPort->xRxedChars );
+
+        if( xSpace > sizeof( ucBuffer ) )
+        {
+            xSpace = sizeof( ucBuffer );
+        }
+
+        // Leave the bytes in the pipe while the buffer is full
+        if( xSpace == 0 )
+        {
+            break;
+        }
+
+        const ssize_t xRead = read( STDIN_FILENO, ucBuffer, xSpace );
+
+        if( xRead == 0 )
+        {
+            sim_event_stop( e );
+            break;
+        }
+
+        if( xRead < 0 )
+        {
+            if( errno != EINTR )
+            {
+                break;
+            }
+
+            continue;
+        }
+
+        const size_t xSent = xStreamBufferSendFromISR( pxPort->xRxedChars, ucBuffer,
+                                                       ( size_t )xRead, &xWoken );
+
+        pxPort->xStats.ulRxBytesDropped += ( size_t )xRead - xSent;
+
+        if( ( xSent > 0 ) && ( pxPort->pxRxCallback != NULL ) )
+        {
+            pxPort->pxRxCallback( pxPort->pvRxCallbackArg, &xWoken );
+        }
+
+        const size_t xUsed = xStreamBufferBytesAvailable( pxPort->xRxedChars );
+
+        if( xUsed > pxPort->xStats.xRxHighWaterMark )
+        {
+            pxPort->xStats.xRxHighWaterMark = xUsed;
+        }
+    }
+
+    sim_isr_exit( ulIsr, xWoken );
+}
+
+/*---------------------------------------------------------------------------*/
+
+xComPortHandle xSerialPortOpen( eCOMPort ePort, unsigned long ulWantedBaud, unsigned portBASE_TYPE uxQueueLength )
+{
+    if( ( ePort >= serNUM_PORTS ) || ( ulWantedBaud == 0 ) || ( uxQueueLength == 0 ) ||
+        ( xPorts[ ePort ].xOpen != pdFALSE ) )
+    {
+        return NULL;
+    }
+
+    xComPortHandle pxPort = &xPorts[ ePort ];
+
+    if( uxQueueLength > serRX_BUFFER_MAX )
+    {
+        uxQueueLength = serRX_BUFFER_MAX;
+    }
+
+    sim_start();
+
+    pxPort->ePort = ePort;
+    pxPort->ulBaudRate = ulWantedBaud;
+    pxPort->eTxPolicy = serTX_DEFAULT_POLICY;
+    pxPort->xTxPolicyBlockTime = 0;
+    pxPort->xStringMutex = xSemaphoreCreateMutexStatic( &pxPort->xStringMutexBuffer );
+    pxPort->xRxedChars = xStreamBufferCreateStatic( uxQueueLength, serRX_TRIGGER_LEVEL,
+                                                    pxPort->ucRxStorage,
+                                                    &pxPort->xRxedCharsBuffer );
+    memset( &pxPort->xStats, 0, sizeof( pxPort->xStats ) );
+    pxPort->xOpen = pdTRUE;
+
+    if( ePort == serCOM1 )
+    {
+        // Poll stdin without blocking the process
+        const int flags = fcntl( STDIN_FILENO, F_GETFL );
+
+        if( ( flags != -1 ) &&
+            ( fcntl( STDIN_FILENO, F_SETFL, flags | O_NONBLOCK ) != -1 ) )
+        {
+            xRxEvent.callback = prvSerialRxPoll;
+            sim_event_start( &xRxEvent, 0, ( uint64_t )serRX_POLL_MS * 1000000U );
+        }
+    }
+
+    return pxPort;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Writes xLength bytes to the port. The caller must hold the port mutex.
+ */
+static size_t prvSerialTransmit( xComPortHandle pxPort, const char * const pcBuffer, size_t xLength )
+{
+    if( pxPort->xLoopback != pdFALSE )
+    {
+        // The only writer of the receive buffer, stdin is not polled
+        const size_t xSent = xStreamBufferSend( pxPort->xRxedChars, pcBuffer, xLength, 0 );
+
+        pxPort->xStats.ulRxBytesDropped += xLength - xSent;
+    }
+    else if( pxPort->ePort == serCOM1 )
+    {
+        sim_write( STDOUT_FILENO, pcBuffer, xLength );
+    }
+
+    return xLength;
+}
+
+/*---------------------------------------------------------------------------*/
+
+portBASE_TYPE xSerialPortPutChar( xComPortHandle pxPort, char cOutChar, TickType_t xBlockTime )
+{
+    portBASE_TYPE xReturn = pdFAIL;
+
+    if( ( pxPort != NULL ) && ( xSemaphoreTake( pxPort->xStringMutex, xBlockTime ) == pdTRUE ) )
+    {
+        if( prvSerialTransmit( pxPort, &cOutChar, 1 ) == 1 )
+        {
+            xReturn = pdPASS;
+        }
+
+        xSemaphoreGive( pxPort->xStringMutex );
+    }
+
+    return xReturn;
+}
+
+/*---------------------------------------------------------------------------*/
+
+portBASE_TYPE xSerialPortGetChar( xComPortHandle pxPort, char *pcRxedChar, TickType_t xBlockTime )
+{
+    if( ( pxPort != NULL ) &&
+        ( xStreamBufferReceive( pxPort->xRxedChars, pcRxedChar, 1, xBlockTime ) == 1 ) )
+    {
+        return pdTRUE;
+    }
+
+    return pdFALSE;
+}
+
+/*---------------------------------------------------------------------------*/
+
+size_t xSerialPortWrite( xComPortHandle pxPort, const void * pvBuffer, size_t xLength )
+{
+    size_t xWritten = 0;
+
+    if( ( pxPort != NULL ) && ( xSemaphoreTake( pxPort->xStringMutex, portMAX_DELAY ) == pdTRUE ) )
+    {
+        xWritten = prvSerialTransmit( pxPort, ( const char * )pvBuffer, xLength );
+
+        xSemaphoreGive( pxPort->xStringMutex );
+    }
+
+    return xWritten;
+}
+
+/*---------------------------------------------------------------------------*/
+
+size_t xSerialPortRead( xComPortHandle pxPort, void * pvBuffer, size_t xLength, TickType_t xBlockTime )
+{
+    if( pxPort == NULL )
+    {
+        return 0;
+    }
+
+    return xStreamBufferReceive( pxPort->xRxedChars, pvBuffer, xLength, xBlockTime );
+}
+
+/*---------------------------------------------------------------------------*/
+
+void vSerialPortPutString( xComPortHandle pxPort, const char * const pcString )
+{
+    (void)xSerialPortWrite( pxPort, pcString, strlen( pcString ) );
+}
+
+/*---------------------------------------------------------------------------*/
+
+size_t xSerialPortPutStringPolicy( xComPortHandle pxPort, const char * const pcString,
+                                   eSerialTxPolicy ePolicy, TickType_t xBlockTime )
+{
+    // Nothing is ever dropped, so the policy makes no difference
+    ( void )ePolicy;
+    ( void )xBlockTime;
+
+    return xSerialPortWrite( pxPort, pcString, strlen( pcString ) );
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Passes a piece of xvformat() output to the port, which the caller holds.
+ */
+static void prvSerialFormatOut( void * pvArg, const char * pcString, size_t xLength )
+{
+    xComPortHandle pxPort = ( xComPortHandle )pvArg;
+
+    ( void )prvSerialTransmit( pxPort, pcString, xLength );
+}
+
+size_t xSerialPortVPrintf( xComPortHandle pxPort, const char * pcFormat, va_list xArgs )
+{
+    size_t xLength = 0;
+
+    // The output is formatted straight into the transmit buffer. The port is
+    // held for the whole string, so it is not mixed with other output.
+    if( ( pxPort != NULL ) && ( xSemaphoreTake( pxPort->xStringMutex, portMAX_DELAY ) == pdTRUE ) )
+    {
+        xLength = xvformat( prvSerialFormatOut, pxPort, pcFormat, xArgs );
+
+        xSemaphoreGive( pxPort->xStringMutex );
+    }
+
+    return xLength;
+}
+
+size_t xSerialPortPrintf( xComPortHandle pxPort, const char * pcFormat, ... )
+{
+    va_list xArgs;
+
+    va_start( xArgs, pcFormat );
+    const size_t xLength = xSerialPortVPrintf( pxPort, pcFormat, xArgs );
+    va_end( xArgs );
+
+    return xLength;
+}
+
+/*---------------------------------------------------------------------------*/
+
+void vSerialPortSetTxPolicy( xComPortHandle pxPort, eSerialTxPolicy ePolicy, TickType_t xBlockTime )
+{
+    if( pxPort == NULL )
+    {
+        return;
+    }
+
+    xSemaphoreTake(pxPort->xStringMutex, portMAX_DELAY);
+    {
+        pxPort->eTxPolicy = ePolicy;
+        pxPort->xTxPolicyBlockTime = xBlockTime;
+    }
+    xSemaphoreGive(pxPort->xStringMutex);
+}
+
+/*---------------------------------------------------------------------------*/
+
+void vSerialPortGetStats( xComPortHandle pxPort, SerialStats_t * pxStats )
+{
+    if( pxPort == NULL )
+    {
+        memset( pxStats, 0, sizeof( *pxStats ) );
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        *pxStats = pxPort->xStats;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*---------------------------------------------------------------------------*/
+
+void vSerialPortResetStats( xComPortHandle pxPort )
+{
+    if( pxPort == NULL )
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        memset( &pxPort->xStats, 0, sizeof( pxPort->xStats ) );
+        pxPort->xStats.xRxHighWaterMark = xStreamBufferBytesAvailable( pxPort->xRxedChars );
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*---------------------------------------------------------------------------*/
+
+unsigned long ulSerialPortGetBaud( xComPortHandle pxPort )
+{
+    return ( pxPort != NULL ) ? pxPort->ulBaudRate : 0;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Any baud rate is reached exactly, the timing of a write does not depend on
+ * it.
+ */
+portBASE_TYPE xSerialPortSetBaud( xComPortHandle pxPort, unsigned long ulWantedBaud )
+{
+    if( ( pxPort == NULL ) || ( ulWantedBaud == 0 ) )
+    {
+        return pdFALSE;
+    }
+
+    pxPort->ulBaudRate = ulWantedBaud;
+
+    return pdTRUE;
+}
+
+/*---------------------------------------------------------------------------*/
+
+void vSerialPortSetLoopback( xComPortHandle pxPort, portBASE_TYPE xEnable )
+{
+    if( pxPort != NULL )
+    {
+        pxPort->xLoopback = xEnable;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Called in the simulated receive interrupt once per chunk read from stdin,
+ * on the target once per byte.
+ */
+void vSerialPortSetRxCallback( xComPortHandle pxPort, SerialRxCallback_t pxCallback, void * pvArg )
+{
+    if( pxPort == NULL )
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        pxPort->pxRxCallback = pxCallback;
+        pxPort->pvRxCallbackArg = pvArg;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*---------------------------------------------------------------------------*/
+
+portBASE_TYPE xSerialPortInit( unsigned long ulWantedBaud, unsigned portBASE_TYPE uxQueueLength )
+{
+    if( xDefaultPort == NULL )
+    {
+        xDefaultPort = xSerialPortOpen( serCOM1, ulWantedBaud, uxQueueLength );
+    }
+
+    return ( xDefaultPort != NULL ) ? pdPASS : pdFAIL;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Single port API, operating on the port opened by xSerialPortInit().
+ */
+portBASE_TYPE xSerialPutChar( char cOutChar, TickType_t xBlockTime )
+{
+    return xSerialPortPutChar( xDefaultPort, cOutChar, xBlockTime );
+}
+
+portBASE_TYPE xSerialGetChar( char *pcRxedChar, TickType_t xBlockTime )
+{
+    return xSerialPortGetChar( xDefaultPort, pcRxedChar, xBlockTime );
+}
+
+size_t xSerialWrite( const void * pvBuffer, size_t xLength )
+{
+    return xSerialPortWrite( xDefaultPort, pvBuffer, xLength );
+}
+
+size_t xSerialRead( void * pvBuffer, size_t xLength, TickType_t xBlockTime )
+{
+    return xSerialPortRead( xDefaultPort, pvBuffer, xLength, xBlockTime );
+}
+
+void vSerialPutString( const char * const pcString )
+{
+    vSerialPortPutString( xDefaultPort, pcString );
+}
+
+size_t xSerialPutStringPolicy( const char * const pcString,
+                               eSerialTxPolicy ePolicy, TickType_t xBlockTime )
+{
+    return xSerialPortPutStringPolicy( xDefaultPort, pcString, ePolicy, xBlockTime );
+}
+
+size_t xSerialPrintf( const char * pcFormat, ... )
+{
+    va_list xArgs;
+
+    va_start( xArgs, pcFormat );
+    const size_t xLength = xSerialPortVPrintf( xDefaultPort, pcFormat, xArgs );
+    va_end( xArgs );
+
+    return xLength;
+}
+
+void vSerialSetTxPolicy( eSerialTxPolicy ePolicy, TickType_t xBlockTime )
+{
+    vSerialPortSetTxPolicy( xDefaultPort, ePolicy, xBlockTime );
+}
+
+void vSerialGetStats( SerialStats_t * pxStats )
+{
+    vSerialPortGetStats( xDefaultPort, pxStats );
+}
+
+void vSerialResetStats( void )
+{
+    vSerialPortResetStats( xDefaultPort );
+}
+
+unsigned long ulSerialGetBaud( void )
+{
+    return ulSerialPortGetBaud( xDefaultPort );
+}
+
+/*---------------------------------------------------------------------------*/
+
+xComPortHandle xSerialGetDefaultPort( void )
+{
+    return xDefaultPort;
+}
+
+/*---------------------------------------------------------------------------*/
+
+portBASE_TYPE xSerialPutBuffer( const char * const pcBuffer, size_t xLength,
+                                TickType_t xBlockTime )
+{
+    xComPortHandle pxPort = xDefaultPort;
+    portBASE_TYPE xReturn = pdFAIL;
+
+    if( ( pxPort == NULL ) || ( xSemaphoreTake(pxPort->xStringMutex, xBlockTime) != pdTRUE ) )
+    {
+        return pdFAIL;
+    }
+
+    if( prvSerialTransmit(pxPort, pcBuffer, xLength) == xLength )
+    {
+        xReturn = pdPASS;
+    }
+
+    xSemaphoreGive(pxPort->xStringMutex);
+
+    return xReturn;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * There is no idle line on stdin, a frame is what arrived within the block
+ * time, up to xMaxLength bytes.
+ */
+size_t xSerialGetFrame( void * pvBuffer, size_t xMaxLength, TickType_t xBlockTime )
+{
+    return xSerialRead( pvBuffer, xMaxLength, xBlockTime );
+}
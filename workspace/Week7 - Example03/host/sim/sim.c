@@ -0,0 +1,938 @@
+/*! ***************************************************************************
+ *
+ * \brief     Time, interrupts and input scripts of the host simulation
+ * \file      sim.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sim.h"
+
+/*----------------------------------------------------------------------------*/
+// Peripheral registers that behave like memory, see MKL25Z4.h
+/*----------------------------------------------------------------------------*/
+// CLOCK_SETUP 1 of SystemInit(): PEE, core / 2, bus / 4, MCGPLLCLK/2 for TPM
+// and UART0
+SIM_Type sim_sim =
+{
+    .SOPT2 = SIM_SOPT2_TPMSRC(1) | SIM_SOPT2_UART0SRC(1) | SIM_SOPT2_PLLFLLSEL_MASK,
+    .CLKDIV1 = SIM_CLKDIV1_OUTDIV1(1) | SIM_CLKDIV1_OUTDIV4(1),
+};
+
+PORT_Type sim_port[5];
+
+// Inputs are pulled up, the switches and the interrupt outputs of the
+// MMA8451 are active low
+GPIO_Type sim_gpio[5] = {[0 ... 4] = {.PDIR = 0xFFFFFFFFUL}};
+
+MTB_Type sim_mtb;
+
+volatile uint32_t sim_nvic_iser = 0;
+volatile uint32_t sim_nvic_ispr = 0;
+volatile uint32_t sim_ipsr = 0;
+volatile uint8_t sim_nvic_prio[32];
+
+// CLOCK_SETUP 1, changed by the clock manager
+uint32_t SystemCoreClock = 48000000UL;
+
+// Measured by ResetISR() on the target, there is no startup code here
+unsigned int boot_init_cycles = 0;
+
+// Handlers of the modelled interrupts, if their driver is linked
+void PORTA_IRQHandler(void) __attribute__((weak));
+void PORTD_IRQHandler(void) __attribute__((weak));
+void RTC_IRQHandler(void) __attribute__((weak));
+void RTC_Seconds_IRQHandler(void) __attribute__((weak));
+
+static void (* const handlers[32])(void) =
+{
+    [PORTA_IRQn] = PORTA_IRQHandler,
+    [PORTD_IRQn] = PORTD_IRQHandler,
+    [RTC_IRQn] = RTC_IRQHandler,
+    [RTC_Seconds_IRQn] = RTC_Seconds_IRQHandler,
+};
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+static struct timespec start;
+static PIT_Type pit;
+static SysTick_Type systick;
+
+// PEE mode of CLOCK_SETUP 1, RUN mode
+static MCG_Type mcg = {.C1 = MCG_C1_IRCLKEN_MASK, .C6 = MCG_C6_PLLS_MASK};
+static SMC_Type smc;
+
+// RTC after a power on reset, the time is invalid
+static RTC_Type rtc = {.SR = RTC_SR_TIF_MASK, .IER = 0x7};
+static bool rtc_counting = false;
+static uint64_t rtc_start_ns;
+static uint64_t rtc_start;     ///< TSR and TPR at rtc_start_ns, in 1/32768 s
+static uint32_t rtc_last;      ///< TSR at the last seconds event
+static uint32_t rtc_tar;       ///< TAR at the previous access
+
+static void sim_rtc_second(sim_event_t *e);
+static sim_event_t rtc_event = {.callback = sim_rtc_second};
+
+// Interrupt flags of the pins, shown in the PCR registers to the handler
+static uint32_t port_isf[5];
+
+// Pending hardware events, sorted by due time
+static sim_event_t *events = NULL;
+
+static TaskHandle_t sim_task = NULL;
+static StaticTask_t sim_tcb;
+__BSS_NOCLEAR static StackType_t sim_stack[configMINIMAL_STACK_SIZE];
+
+// Yield requested by a handler while in a simulated interrupt
+static volatile bool yield_pending = false;
+
+// Switch script, rows of ms, switch and pressed
+static int32_t sw_script[SIM_SCRIPT_ROWS * 3];
+static uint32_t sw_rows = 0;
+static uint32_t sw_next = 0;
+static sim_event_t sw_event;
+
+static sim_event_t end_event;
+
+static void sim_run(void *arg);
+
+/*!
+ * \brief Takes the start of the simulated time, before main()
+ */
+__attribute__((constructor)) static void sim_clock_start(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &start);
+}
+
+/*!
+ * \brief Returns the time since the start of the program in ns
+ */
+uint64_t sim_time_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)(now.tv_sec - start.tv_sec) * 1000000000ULL) +
+        (uint64_t)now.tv_nsec - (uint64_t)start.tv_nsec;
+}
+
+/*!
+ * \brief Returns the time since the start of the program in us
+ */
+uint32_t sim_time_us(void)
+{
+    return (uint32_t)(sim_time_ns() / 1000U);
+}
+
+/*!
+ * \brief Returns 1 if the tick signal is masked for the calling thread
+ */
+uint32_t __get_PRIMASK(void)
+{
+    sigset_t set;
+
+    pthread_sigmask(SIG_BLOCK, NULL, &set);
+
+    return sigismember(&set, SIGALRM) ? 1U : 0U;
+}
+
+/*!
+ * \brief Masks or unmasks all signals, like vPortDisableInterrupts() and
+ *        vPortEnableInterrupts() of the POSIX port
+ */
+void __set_PRIMASK(uint32_t priMask)
+{
+    sigset_t set;
+
+    sigfillset(&set);
+    pthread_sigmask((priMask & 1U) ? SIG_BLOCK : SIG_UNBLOCK, &set, NULL);
+}
+
+/*!
+ * \brief Called by clk_set_mode() to restart SysTick at the new core clock
+ *
+ * The tick of the POSIX port is a host timer that does not depend on the
+ * core clock.
+ */
+void vPortSetupTimerInterrupt(void)
+{
+}
+
+/*!
+ * \brief PIT0 counts the 24 MHz bus clock down from 0xFFFFFFFF at the start
+ */
+PIT_Type *sim_pit(void)
+{
+    pit.CHANNEL[0].CVAL = 0xFFFFFFFFUL - (uint32_t)((sim_time_ns() * 3U) / 125U);
+
+    return &pit;
+}
+
+/*!
+ * \brief SysTick counts the core clock down from LOAD while it is enabled
+ */
+SysTick_Type *sim_systick(void)
+{
+    if(systick.CTRL & SysTick_CTRL_ENABLE_Msk)
+    {
+        const uint64_t cycles = (sim_time_ns() * (SystemCoreClock / 1000000U)) /
+            1000U;
+
+        systick.VAL = systick.LOAD - (uint32_t)(cycles % (systick.LOAD + 1ULL));
+    }
+
+    return &systick;
+}
+
+/*!
+ * \brief Brings the MCG status up to date with the clock source selected in
+ *        C1 and C6, the PLL locks at once
+ */
+MCG_Type *sim_mcg(void)
+{
+    const uint8_t clks = (mcg.C1 & MCG_C1_CLKS_MASK) >> MCG_C1_CLKS_SHIFT;
+    const bool plls = (mcg.C6 & MCG_C6_PLLS_MASK) != 0;
+
+    // CLKS 0 selects the output of the FLL or the PLL
+    const uint8_t clkst = (clks != 0) ? clks : (plls ? 3U : 0U);
+
+    mcg.S = MCG_S_CLKST(clkst) |
+            (plls ? (MCG_S_PLLST_MASK | MCG_S_LOCK0_MASK) : 0U);
+
+    return &mcg;
+}
+
+/*!
+ * \brief Brings the power mode status up to date with the run mode selected
+ *        in PMCTRL, VLPR is entered and left at once
+ */
+SMC_Type *sim_smc(void)
+{
+    const uint8_t runm = (smc.PMCTRL & SMC_PMCTRL_RUNM_MASK) >>
+        SMC_PMCTRL_RUNM_SHIFT;
+
+    smc.PMSTAT = SMC_PMSTAT_PMSTAT((runm == 2) ? 4U : 1U);
+
+    return &smc;
+}
+
+/*!
+ * \brief Converts ns to counts of the 32.768 kHz RTC clock
+ */
+static uint64_t sim_rtc_counts(const uint64_t ns)
+{
+    return ((ns / 1000000000ULL) << 15) +
+        (((ns % 1000000000ULL) << 15) / 1000000000ULL);
+}
+
+/*!
+ * \brief Brings the RTC registers up to date
+ *
+ * Called on every access through RTC, before the register is read or
+ * written. The model sees the effect of a write at the next access: a
+ * software reset, the time counter that is stopped and started again with
+ * the TSR and TPR values written meanwhile, and TAR that was written, which
+ * clears TAF. The time compensation in TCR is not applied, the host clock
+ * does not drift.
+ */
+RTC_Type *sim_rtc(void)
+{
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    if(rtc.CR & RTC_CR_SWR_MASK)
+    {
+        rtc.TSR = 0;
+        rtc.TPR = 0;
+        rtc.TAR = 0;
+        rtc.TCR = 0;
+        rtc.SR = RTC_SR_TIF_MASK;
+        rtc.IER = 0x7;
+        rtc_counting = false;
+    }
+
+    const uint64_t now = sim_time_ns();
+
+    if(rtc_counting && !(rtc.SR & RTC_SR_TCE_MASK))
+    {
+        // Stopped, TSR and TPR keep the last values until they are written
+        rtc_counting = false;
+    }
+    else if(!rtc_counting && (rtc.SR & RTC_SR_TCE_MASK))
+    {
+        // Started, a write to TSR cleared the invalid and overflow flags
+        rtc_counting = true;
+        rtc_start_ns = now;
+        rtc_start = ((uint64_t)rtc.TSR << 15) | (rtc.TPR & 0x7FFFU);
+        rtc_last = rtc.TSR;
+        rtc.SR &= ~(RTC_SR_TIF_MASK | RTC_SR_TOF_MASK);
+
+        sim_event_start(&rtc_event,
+            1000000000ULL - (((rtc.TPR & 0x7FFFU) * 1000000000ULL) >> 15), 0);
+    }
+
+    if(rtc_counting)
+    {
+        const uint64_t counts = rtc_start + sim_rtc_counts(now - rtc_start_ns);
+
+        rtc.TSR = (uint32_t)(counts >> 15);
+        rtc.TPR = (uint32_t)(counts & 0x7FFFU);
+    }
+
+    if(rtc.TAR != rtc_tar)
+    {
+        rtc_tar = rtc.TAR;
+        rtc.SR &= ~RTC_SR_TAF_MASK;
+    }
+
+    __set_PRIMASK(primask);
+
+    return &rtc;
+}
+
+/*!
+ * \brief Raises the seconds and alarm interrupts when TSR increments
+ */
+static void sim_rtc_second(sim_event_t *e)
+{
+    RTC_Type *r = sim_rtc();
+
+    if(!rtc_counting)
+    {
+        return;
+    }
+
+    const uint32_t tsr = r->TSR;
+
+    if(tsr != rtc_last)
+    {
+        // TAF is set when TSR increments from the value in TAR
+        if((r->TAR >= rtc_last) && (r->TAR < tsr))
+        {
+            r->SR |= RTC_SR_TAF_MASK;
+        }
+
+        rtc_last = tsr;
+
+        if(r->IER & RTC_IER_TSIE_MASK)
+        {
+            sim_irq_pend(RTC_Seconds_IRQn);
+        }
+
+        if((r->SR & RTC_SR_TAF_MASK) && (r->IER & RTC_IER_TAIE_MASK))
+        {
+            sim_irq_pend(RTC_IRQn);
+        }
+    }
+
+    // At the next increment of TSR
+    sim_event_start(e, 1000000000ULL - (((r->TPR & 0x7FFFU) * 1000000000ULL) >> 15), 0);
+}
+
+/*!
+ * \brief Enters a simulated interrupt
+ *
+ * Masks the tick signal, so no task switch happens until sim_isr_exit(), and
+ * sets IPSR to the exception number of the interrupt for the trace recorder.
+ *
+ * \param[in]  irq  Interrupt
+ *
+ * \return Mask to pass to sim_isr_exit()
+ */
+uint32_t sim_isr_enter(const IRQn_Type irq)
+{
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    const uint32_t ipsr = sim_ipsr;
+    sim_ipsr = (uint32_t)irq + 16U;
+
+    // The interrupted IPSR is kept in the upper half
+    return primask | (ipsr << 16);
+}
+
+/*!
+ * \brief Leaves a simulated interrupt and switches tasks if requested
+ *
+ * \param[in]  primask  Return value of sim_isr_enter()
+ * \param[in]  woken    pdTRUE if a task of a higher priority was woken
+ */
+void sim_isr_exit(const uint32_t primask, const BaseType_t woken)
+{
+    sim_ipsr = primask >> 16;
+    __set_PRIMASK(primask & 1U);
+
+    if(sim_ipsr != 0)
+    {
+        // Nested, the outer interrupt switches
+        yield_pending |= (woken != pdFALSE);
+    }
+    else if((woken != pdFALSE) || yield_pending)
+    {
+        yield_pending = false;
+        vPortYield();
+    }
+}
+
+/*!
+ * \brief Wrapper of the yield of the POSIX port, see -Wl,--wrap in
+ *        CMakeLists.txt
+ *
+ * The handlers call portYIELD_FROM_ISR() before they return, which would
+ * switch tasks in the middle of the simulated interrupt. The switch is
+ * postponed to sim_isr_exit() instead.
+ */
+void __real_vPortYield(void);
+
+void __wrap_vPortYield(void)
+{
+    if(sim_ipsr != 0)
+    {
+        yield_pending = true;
+        return;
+    }
+
+    __real_vPortYield();
+}
+
+/*!
+ * \brief Inserts an event in the list, called with the tick masked
+ */
+static void sim_event_insert(sim_event_t *e)
+{
+    sim_event_t **p = &events;
+
+    while((*p != NULL) && ((*p)->due_ns <= e->due_ns))
+    {
+        p = &(*p)->next;
+    }
+
+    e->next = *p;
+    *p = e;
+}
+
+/*!
+ * \brief Removes an event from the list, called with the tick masked
+ */
+static void sim_event_remove(sim_event_t *e)
+{
+    for(sim_event_t **p = &events; *p != NULL; p = &(*p)->next)
+    {
+        if(*p == e)
+        {
+            *p = e->next;
+            break;
+        }
+    }
+
+    e->next = NULL;
+}
+
+/*!
+ * \brief Wakes the simulation task to look at the first event again
+ */
+static void sim_wake(void)
+{
+    if((sim_task == NULL) ||
+       (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING))
+    {
+        return;
+    }
+
+    if(sim_ipsr != 0)
+    {
+        BaseType_t woken = pdFALSE;
+
+        vTaskNotifyGiveFromISR(sim_task, &woken);
+        yield_pending |= (woken != pdFALSE);
+    }
+    else
+    {
+        xTaskNotifyGive(sim_task);
+    }
+}
+
+/*!
+ * \brief Starts an event, or starts it again if it is active
+ *
+ * Can be called from a task and from a simulated interrupt.
+ *
+ * \param[in]  e          Event, must remain valid while it is active
+ * \param[in]  delay_ns   Time to the first callback
+ * \param[in]  period_ns  Time between callbacks, 0 for a single callback
+ */
+void sim_event_start(sim_event_t *e, const uint64_t delay_ns,
+    const uint64_t period_ns)
+{
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    if(e->active)
+    {
+        sim_event_remove(e);
+    }
+
+    e->due_ns = sim_time_ns() + delay_ns;
+    e->period_ns = period_ns;
+    e->active = true;
+
+    sim_event_insert(e);
+
+    const bool first = (events == e);
+
+    __set_PRIMASK(primask);
+
+    if(first)
+    {
+        sim_wake();
+    }
+}
+
+/*!
+ * \brief Stops an event
+ */
+void sim_event_stop(sim_event_t *e)
+{
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    if(e->active)
+    {
+        sim_event_remove(e);
+        e->active = false;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/*!
+ * \brief Makes an interrupt pending, its handler is called by the simulation
+ *        task when it is enabled
+ */
+void sim_irq_pend(IRQn_Type irq)
+{
+    __atomic_or_fetch(&sim_nvic_ispr, 1UL << irq, __ATOMIC_SEQ_CST);
+
+    sim_wake();
+}
+
+/*!
+ * \brief Calls the handler of the first pending interrupt that is enabled
+ *
+ * The interrupt with the lowest number goes first, the priorities are not
+ * modelled. The handler of a port interrupt sees the interrupt flags of the
+ * pins that changed since its previous call, the flags it writes with 1 are
+ * cleared when it returns.
+ *
+ * \return False if no interrupt was pending
+ */
+static bool sim_irq_dispatch(void)
+{
+    const uint32_t active = sim_nvic_ispr & sim_nvic_iser;
+
+    if(active == 0)
+    {
+        return false;
+    }
+
+    const IRQn_Type irq = (IRQn_Type)__builtin_ctz(active);
+
+    __atomic_and_fetch(&sim_nvic_ispr, ~(1UL << irq), __ATOMIC_SEQ_CST);
+
+    if(handlers[irq] == NULL)
+    {
+        return true;
+    }
+
+    const uint32_t isr = sim_isr_enter(irq);
+
+    PORT_Type *port = NULL;
+    uint32_t isf = 0;
+
+    if((irq == PORTA_IRQn) || (irq == PORTD_IRQn))
+    {
+        const uint32_t n = (irq == PORTA_IRQn) ? 0 : 3;
+
+        port = &sim_port[n];
+        isf = port_isf[n];
+        port_isf[n] = 0;
+
+        for(uint32_t i=0; i<32; ++i)
+        {
+            port->PCR[i] = (isf & (1UL << i)) ? (port->PCR[i] | PORT_PCR_ISF_MASK) :
+                                                (port->PCR[i] & ~PORT_PCR_ISF_MASK);
+        }
+    }
+
+    handlers[irq]();
+
+    if(port != NULL)
+    {
+        for(uint32_t i=0; i<32; ++i)
+        {
+            port->PCR[i] &= ~PORT_PCR_ISF_MASK;
+        }
+    }
+
+    sim_isr_exit(isr, pdFALSE);
+
+    return true;
+}
+
+/*!
+ * \brief Drives an input pin and raises the interrupt of its port
+ *
+ * If the change matches the IRQC field of the pin, its interrupt flag is
+ * set and the interrupt of the port is made pending. Only PORTA and PORTD
+ * have an interrupt. A level interrupt is raised once, when the level is
+ * reached.
+ *
+ * \param[in]  port  0 for PORTA to 4 for PORTE
+ * \param[in]  pin   Pin number
+ * \param[in]  high  New level
+ */
+void sim_pin_set(const uint32_t port, const uint32_t pin, const bool high)
+{
+    GPIO_Type *gpio = &sim_gpio[port];
+    PORT_Type *pcr = &sim_port[port];
+    const uint32_t mask = 1UL << pin;
+
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    const bool was = (gpio->PDIR & mask) != 0;
+    gpio->PDIR = high ? (gpio->PDIR | mask) : (gpio->PDIR & ~mask);
+
+    const uint32_t irqc = (pcr->PCR[pin] & PORT_PCR_IRQC_MASK) >>
+        PORT_PCR_IRQC_SHIFT;
+
+    // Level low, rising, falling, either edge and level high
+    const bool match = ((irqc == 0x8) && !high) ||
+                       ((irqc == 0x9) && !was && high) ||
+                       ((irqc == 0xA) && was && !high) ||
+                       ((irqc == 0xB) && (was != high)) ||
+                       ((irqc == 0xC) && high);
+
+    const bool raise = match && ((port == 0) || (port == 3));
+
+    if(raise)
+    {
+        port_isf[port] |= mask;
+    }
+
+    __set_PRIMASK(primask);
+
+    if(raise)
+    {
+        sim_irq_pend((port == 0) ? PORTA_IRQn : PORTD_IRQn);
+    }
+}
+
+/*!
+ * \brief Returns an environment variable, or fallback if it is not set
+ */
+const char *sim_env(const char *name, const char *fallback)
+{
+    const char *value = getenv(name);
+
+    return (value != NULL) ? value : fallback;
+}
+
+/*!
+ * \brief Writes to a file descriptor with the tick masked
+ *
+ * A task that is switched out by the tick signal stays in the middle of
+ * what it was doing, so it must not hold a lock of the C library. write()
+ * takes none, and is retried after EINTR and partial writes.
+ */
+void sim_write(const int fd, const void *data, const size_t n)
+{
+    const uint8_t *p = data;
+    size_t left = n;
+
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    while(left > 0)
+    {
+        const ssize_t written = write(fd, p, left);
+
+        if(written < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+
+            break;
+        }
+
+        p += written;
+        left -= (size_t)written;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/*!
+ * \brief Loads an input script
+ *
+ * The file named by the environment variable has a row of cols integers,
+ * separated by commas, per line. Empty lines and lines starting with '#'
+ * are skipped, missing values are 0.
+ *
+ * \param[in]   env       Name of the environment variable
+ * \param[out]  values    cols * max_rows values
+ * \param[in]   cols      Values per row
+ * \param[in]   max_rows  Maximum number of rows
+ *
+ * \return Number of rows, 0 if the variable is not set
+ */
+uint32_t sim_script_load(const char *env, int32_t values[],
+    const uint32_t cols, const uint32_t max_rows)
+{
+    const char *path = getenv(env);
+    uint32_t rows = 0;
+    char line[128];
+
+    if((path == NULL) || (path[0] == '\0'))
+    {
+        return 0;
+    }
+
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    FILE *f = fopen(path, "r");
+
+    if(f == NULL)
+    {
+        fprintf(stderr, "sim: %s: cannot open %s\n", env, path);
+    }
+    else
+    {
+        while((rows < max_rows) && (fgets(line, sizeof(line), f) != NULL))
+        {
+            char *p = line;
+
+            while((*p == ' ') || (*p == '\t'))
+            {
+                p++;
+            }
+
+            if((*p == '#') || (*p == '\r') || (*p == '\n') || (*p == '\0'))
+            {
+                continue;
+            }
+
+            for(uint32_t c=0; c<cols; ++c)
+            {
+                values[rows * cols + c] = (int32_t)strtol(p, &p, 0);
+
+                while((*p == ' ') || (*p == ','))
+                {
+                    p++;
+                }
+            }
+
+            rows++;
+        }
+
+        fclose(f);
+    }
+
+    __set_PRIMASK(primask);
+
+    return rows;
+}
+
+/*!
+ * \brief Applies the switch script rows that are due
+ */
+static void sim_switches(sim_event_t *e)
+{
+    static const uint8_t pins[] = {SIM_SW1_PIN, SIM_SW2_PIN};
+
+    const uint32_t now_ms = (uint32_t)(sim_time_ns() / 1000000U);
+
+    while((sw_next < sw_rows) && ((uint32_t)sw_script[sw_next * 3] <= now_ms))
+    {
+        const int32_t *row = &sw_script[sw_next * 3];
+
+        if((row[1] >= 0) && (row[1] < (int32_t)sizeof(pins)))
+        {
+            // Active low
+            sim_pin_set(3, pins[row[1]], row[2] == 0);
+        }
+
+        sw_next++;
+    }
+
+    if(sw_next < sw_rows)
+    {
+        sim_event_start(e, ((uint64_t)sw_script[sw_next * 3] * 1000000U) -
+            sim_time_ns(), 0);
+    }
+}
+
+/*!
+ * \brief Ends the simulation after SIM_SECONDS
+ */
+static void sim_end(sim_event_t *e)
+{
+    (void)e;
+
+    static const char msg[] = "\r\nsim: end of the simulated time\r\n";
+    sim_write(STDERR_FILENO, msg, sizeof(msg) - 1);
+
+    exit(EXIT_SUCCESS);
+}
+
+/*!
+ * \brief Starts the simulation task, called by the init function of every
+ *        simulated driver
+ *
+ * The first call loads the switch script of SIM_SWITCHES, lines of
+ * "ms,switch,pressed" with the time since the start, SW1 as 0 and SW2 as 1,
+ * and sets the end of the simulation to SIM_SECONDS if it is set.
+ */
+void sim_start(void)
+{
+    if(sim_task != NULL)
+    {
+        return;
+    }
+
+    sim_task = xTaskCreateStatic(sim_run, "Sim", configMINIMAL_STACK_SIZE,
+        NULL, SIM_TASK_PRIORITY, sim_stack, &sim_tcb);
+
+    sw_rows = sim_script_load("SIM_SWITCHES", sw_script, 3, SIM_SCRIPT_ROWS);
+
+    if(sw_rows > 0)
+    {
+        sw_event.callback = sim_switches;
+        sim_event_start(&sw_event, 0, 0);
+    }
+
+    const uint32_t seconds = (uint32_t)strtoul(sim_env("SIM_SECONDS", "0"),
+        NULL, 0);
+
+    if(seconds > 0)
+    {
+        end_event.callback = sim_end;
+        sim_event_start(&end_event, (uint64_t)seconds * 1000000000ULL, 0);
+    }
+}
+
+/*!
+ * \brief Calls the handlers of pending interrupts and runs the events when
+ *        they are due
+ *
+ * Sleeps in ticks of the kernel, so an event is late by up to a tick. A
+ * periodic event that fell behind runs again at once until it caught up.
+ */
+static void sim_run(void *arg)
+{
+    (void)arg;
+
+    for(;;)
+    {
+        if(sim_irq_dispatch())
+        {
+            continue;
+        }
+
+        const uint64_t now = sim_time_ns();
+        TickType_t wait = portMAX_DELAY;
+        sim_event_t *due = NULL;
+
+        const uint32_t primask = __get_PRIMASK();
+
+        __disable_irq();
+
+        if((events != NULL) && (events->due_ns <= now))
+        {
+            due = events;
+            events = due->next;
+            due->next = NULL;
+
+            if(due->period_ns != 0)
+            {
+                due->due_ns += due->period_ns;
+                sim_event_insert(due);
+            }
+            else
+            {
+                due->active = false;
+            }
+        }
+        else if(events != NULL)
+        {
+            wait = pdMS_TO_TICKS((events->due_ns - now + 999999U) / 1000000U);
+        }
+
+        __set_PRIMASK(primask);
+
+        if(due != NULL)
+        {
+            due->callback(due);
+            continue;
+        }
+
+        (void)ulTaskNotifyTake(pdTRUE, wait);
+    }
+}
+
+/*!
+ * \brief Called by configASSERT(), stops the program with a core dump
+ */
+void vAssertCalled(const char * const file, unsigned long line)
+{
+    char msg[160];
+    const int n = snprintf(msg, sizeof(msg), "\r\nsim: assert failed at %s:%lu\r\n",
+        file, line);
+
+    sim_write(STDERR_FILENO, msg, (size_t)n);
+
+    abort();
+}
@@ -0,0 +1,115 @@
+/*! ***************************************************************************
+ *
+ * \brief     Time, interrupts and input scripts of the host simulation
+ * \file      sim.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef SIM_H
+#define SIM_H
+
+#include <MKL25Z4.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// \name Definitions for the host simulation
+/// \{
+
+/// Priority of the task that runs the hardware events, above all drivers
+#define SIM_TASK_PRIORITY    (configMAX_PRIORITIES - 1)
+
+/// Maximum number of rows of an input script
+#ifndef SIM_SCRIPT_ROWS
+#define SIM_SCRIPT_ROWS      (256)
+#endif
+
+/// Switch pins on PTD3 and PTD5, see switches.c
+#define SIM_SW1_PIN          (3)
+#define SIM_SW2_PIN          (5)
+
+/// 8-bit write addresses of the simulated slaves, the SSD1306 on I2C1
+/// answers for either level of SA0
+#define SIM_SSD1306_ADDRESS  (0x78)
+#define SIM_MMA8451_ADDRESS  (0x3A)
+
+/// Interrupt outputs INT1 and INT2 of the MMA8451 on PTA14 and PTA15
+#define SIM_MMA_INT1_PIN     (14)
+#define SIM_MMA_INT2_PIN     (15)
+
+/// \}
+
+/*!
+ * \brief A hardware event, run by the simulation task
+ *
+ * The callback runs in the simulation task at or after the due time. It
+ * enters a simulated interrupt with sim_isr_enter() before it calls an
+ * interrupt handler or a FromISR function.
+ */
+typedef struct sim_event
+{
+    void (*callback)(struct sim_event *e);
+    void *arg;
+
+    // Managed by the simulation
+    uint64_t due_ns;
+    uint64_t period_ns;    ///< 0 for a single event
+    bool active;
+    struct sim_event *next;
+}sim_event_t;
+
+// Function prototypes
+void sim_start(void);
+
+uint64_t sim_time_ns(void);
+uint32_t sim_time_us(void);
+
+uint32_t sim_isr_enter(const IRQn_Type irq);
+void sim_isr_exit(const uint32_t primask, const BaseType_t woken);
+
+void sim_event_start(sim_event_t *e, const uint64_t delay_ns,
+    const uint64_t period_ns);
+void sim_event_stop(sim_event_t *e);
+
+void sim_pin_set(const uint32_t port, const uint32_t pin, const bool high);
+
+uint32_t sim_script_load(const char *env, int32_t values[],
+    const uint32_t cols, const uint32_t max_rows);
+const char *sim_env(const char *name, const char *fallback);
+
+void sim_write(const int fd, const void *data, const size_t n);
+
+// Slaves on the simulated I2C buses, called by i2c.c when a transfer ends.
+// They return false for a byte that is not acknowledged.
+bool sim_ssd1306_write(const uint8_t control, const uint8_t data[],
+    const uint32_t n);
+bool sim_mma8451_write(const uint8_t reg, const uint8_t data[],
+    const uint32_t n);
+bool sim_mma8451_read(const uint8_t reg, uint8_t data[], const uint32_t n);
+
+#endif // SIM_H
@@ -0,0 +1,395 @@
+/*! ***************************************************************************
+ *
+ * \brief     Model of the SSD1306 Oled display of the host simulation
+ * \file      ssd1306_model.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "png.h"
+#include "sim.h"
+
+/*
+ * The GDDRAM, the addressing modes and the commands that change what is
+ * shown are modelled: display on and off, entire display on, inverse, the
+ * contrast, the display start line and offset, the segment re-map and the
+ * COM scan direction. The other commands are accepted with their arguments
+ * and have no effect. Scrolling is not modelled.
+ *
+ * Some time after the last change the display is written to the PNG file
+ * named by SIM_OLED, "oled.png" by default. The name may contain a printf
+ * conversion of an unsigned int, "oled%04u.png" for example, to write a
+ * numbered file for every frame. An empty SIM_OLED writes nothing. Every
+ * display pixel is SIM_OLED_SCALE (default 4) pixels wide and high.
+ */
+
+/// \name Definitions for the SSD1306 model
+/// \{
+
+#define OLED_WIDTH     (128)
+#define OLED_PAGES     (8)
+#define OLED_HEIGHT    (OLED_PAGES * 8)
+
+/// Time after the last change before the frame is written
+#ifndef OLED_SETTLE_MS
+#define OLED_SETTLE_MS (5)
+#endif
+
+#define OLED_SCALE_MAX (8)
+
+/// \}
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+static uint8_t gddram[OLED_PAGES][OLED_WIDTH];
+
+// State after a reset of the SSD1306
+static struct
+{
+    uint8_t mode;          ///< 0 horizontal, 1 vertical, 2 page addressing
+    uint8_t col, col_start, col_end;
+    uint8_t page, page_start, page_end;
+    uint8_t contrast;
+    uint8_t start_line;
+    uint8_t offset;
+    bool on;
+    bool entire_on;
+    bool inverse;
+    bool remap;            ///< Column 127 is mapped to SEG0
+    bool scan_reverse;     ///< COM scan from COM63 to COM0
+}oled = {.mode = 2, .col_end = 127, .page_end = 7, .contrast = 0x7F};
+
+// Command that waits for its arguments, they may follow in the next
+// transfer
+static uint8_t cmd[8];
+static uint8_t cmd_n = 0;
+static uint8_t cmd_len = 0;
+
+static bool dirty = false;
+static uint32_t frame = 0;
+static sim_event_t settle_event;
+
+static uint8_t image[OLED_HEIGHT * OLED_SCALE_MAX * OLED_WIDTH * OLED_SCALE_MAX];
+
+/*!
+ * \brief Writes the display as it is shown to the PNG file
+ *
+ * The file is written with the tick masked, see sim_write().
+ */
+static void oled_dump(void)
+{
+    const char *path = sim_env("SIM_OLED", "oled.png");
+    char name[256];
+
+    dirty = false;
+
+    if(path[0] == '\0')
+    {
+        return;
+    }
+
+    uint32_t scale = (uint32_t)strtoul(sim_env("SIM_OLED_SCALE", "4"), NULL, 0);
+
+    if((scale == 0) || (scale > OLED_SCALE_MAX))
+    {
+        scale = 4;
+    }
+
+    // Off pixels are black, on pixels are brighter with the contrast
+    const uint8_t on = (uint8_t)(95U + ((oled.contrast * 160U) / 255U));
+    const uint32_t width = OLED_WIDTH * scale;
+
+    for(uint32_t y=0; y<OLED_HEIGHT; ++y)
+    {
+        // The COM line of this row and the GDDRAM row it shows
+        const uint32_t com = oled.scan_reverse ? (OLED_HEIGHT - 1 - y) : y;
+        const uint32_t row = (com + oled.start_line + oled.offset) % OLED_HEIGHT;
+
+        for(uint32_t x=0; x<OLED_WIDTH; ++x)
+        {
+            const uint32_t col = oled.remap ? (OLED_WIDTH - 1 - x) : x;
+
+            bool lit = (gddram[row / 8][col] >> (row % 8)) & 1U;
+
+            lit = (oled.entire_on || lit) != oled.inverse;
+
+            const uint8_t v = (oled.on && lit) ? on : 0;
+
+            for(uint32_t sy=0; sy<scale; ++sy)
+            {
+                memset(&image[(((y * scale) + sy) * width) + (x * scale)], v,
+                    scale);
+            }
+        }
+    }
+
+    if(strchr(path, '%') != NULL)
+    {
+        snprintf(name, sizeof(name), path, frame);
+        path = name;
+    }
+
+    frame++;
+
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    if(!png_write_gray(path, image, width, OLED_HEIGHT * scale))
+    {
+        fprintf(stderr, "sim: SIM_OLED: cannot write %s\n", path);
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/*!
+ * \brief Writes the frame when the display did not change for a while
+ */
+static void oled_settled(sim_event_t *e)
+{
+    (void)e;
+
+    oled_dump();
+}
+
+/*!
+ * \brief Writes the last frame when the simulation ends
+ */
+static void oled_exit(void)
+{
+    if(dirty)
+    {
+        oled_dump();
+    }
+}
+
+/*!
+ * \brief Notes a change of what is shown, the frame is written when the
+ *        display settled
+ */
+static void oled_changed(void)
+{
+    if(settle_event.callback == NULL)
+    {
+        settle_event.callback = oled_settled;
+        atexit(oled_exit);
+    }
+
+    dirty = true;
+
+    sim_event_start(&settle_event, (uint64_t)OLED_SETTLE_MS * 1000000U, 0);
+}
+
+/*!
+ * \brief Returns the length of a command, including its first byte
+ */
+static uint8_t oled_cmd_length(const uint8_t c)
+{
+    switch(c)
+    {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5:
+    case 0xD9: case 0xDA: case 0xDB:
+        return 2;
+
+    case 0x21: case 0x22: case 0xA3:
+        return 3;
+
+    case 0x29: case 0x2A:
+        return 6;
+
+    case 0x26: case 0x27:
+        return 7;
+
+    default:
+        return 1;
+    }
+}
+
+/*!
+ * \brief Executes a complete command
+ */
+static void oled_cmd(const uint8_t c[])
+{
+    switch(c[0])
+    {
+    case 0x20:
+        oled.mode = c[1] & 0x03;
+        break;
+
+    case 0x21:
+        oled.col_start = c[1] & 0x7F;
+        oled.col_end = c[2] & 0x7F;
+        oled.col = oled.col_start;
+        break;
+
+    case 0x22:
+        oled.page_start = c[1] & 0x07;
+        oled.page_end = c[2] & 0x07;
+        oled.page = oled.page_start;
+        break;
+
+    case 0x81:
+        oled.contrast = c[1];
+        oled_changed();
+        break;
+
+    case 0xA0: case 0xA1:
+        oled.remap = (c[0] & 1U) != 0;
+        oled_changed();
+        break;
+
+    case 0xA4: case 0xA5:
+        oled.entire_on = (c[0] & 1U) != 0;
+        oled_changed();
+        break;
+
+    case 0xA6: case 0xA7:
+        oled.inverse = (c[0] & 1U) != 0;
+        oled_changed();
+        break;
+
+    case 0xAE: case 0xAF:
+        oled.on = (c[0] & 1U) != 0;
+        oled_changed();
+        break;
+
+    case 0xC0: case 0xC8:
+        oled.scan_reverse = (c[0] == 0xC8);
+        oled_changed();
+        break;
+
+    case 0xD3:
+        oled.offset = c[1] & 0x3F;
+        oled_changed();
+        break;
+
+    default:
+        if(c[0] <= 0x0F)
+        {
+            // Lower nibble of the column of the page addressing mode
+            oled.col = (oled.col & 0xF0) | c[0];
+        }
+        else if(c[0] <= 0x1F)
+        {
+            oled.col = (uint8_t)(((c[0] & 0x07) << 4) | (oled.col & 0x0F));
+        }
+        else if((c[0] >= 0x40) && (c[0] <= 0x7F))
+        {
+            oled.start_line = c[0] & 0x3F;
+            oled_changed();
+        }
+        else if((c[0] >= 0xB0) && (c[0] <= 0xB7))
+        {
+            oled.page = c[0] & 0x07;
+        }
+        break;
+    }
+}
+
+/*!
+ * \brief Writes a byte to the GDDRAM and advances the address
+ */
+static void oled_data(const uint8_t d)
+{
+    gddram[oled.page][oled.col] = d;
+
+    switch(oled.mode)
+    {
+    case 0:
+        if(oled.col++ >= oled.col_end)
+        {
+            oled.col = oled.col_start;
+            oled.page = (oled.page >= oled.page_end) ? oled.page_start :
+                (uint8_t)(oled.page + 1);
+        }
+        break;
+
+    case 1:
+        if(oled.page++ >= oled.page_end)
+        {
+            oled.page = oled.page_start;
+            oled.col = (oled.col >= oled.col_end) ? oled.col_start :
+                (uint8_t)(oled.col + 1);
+        }
+        break;
+
+    default:
+        // The page addressing mode wraps within the page
+        oled.col = (oled.col + 1) & 0x7F;
+        break;
+    }
+}
+
+/*!
+ * \brief Receives a transfer to the SSD1306
+ *
+ * \param[in]  control  Control byte, D/C# selects commands or data
+ * \param[in]  data     Bytes after the control byte
+ * \param[in]  n        Number of bytes
+ *
+ * \return True, every byte is acknowledged
+ */
+bool sim_ssd1306_write(const uint8_t control, const uint8_t data[],
+    const uint32_t n)
+{
+    if(control & 0x40)
+    {
+        for(uint32_t i=0; i<n; ++i)
+        {
+            oled_data(data[i]);
+        }
+
+        if(n > 0)
+        {
+            oled_changed();
+        }
+
+        return true;
+    }
+
+    for(uint32_t i=0; i<n; ++i)
+    {
+        if(cmd_n == 0)
+        {
+            cmd_len = oled_cmd_length(data[i]);
+        }
+
+        cmd[cmd_n++] = data[i];
+
+        if(cmd_n == cmd_len)
+        {
+            oled_cmd(cmd);
+            cmd_n = 0;
+        }
+    }
+
+    return true;
+}
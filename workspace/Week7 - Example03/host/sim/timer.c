@@ -0,0 +1,219 @@
+/*! ***************************************************************************
+ *
+ * \brief     Timer service of the host simulation
+ * \file      timer.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "timer.h"
+#include "sim.h"
+
+/*
+ * The API of timer/timer.c with deadlines in us of the simulated time. The
+ * earliest deadline is a simulation event that runs the expired timers in
+ * a simulated TPM1 interrupt. An event is late by up to a kernel tick, see
+ * sim_run(), so the callbacks are not as accurate as on the target.
+ */
+
+// Active timers sorted by deadline
+static tim_timer_t *volatile head = NULL;
+
+static void tim_expired(sim_event_t *e);
+static sim_event_t tim_event = {.callback = tim_expired};
+
+void tim_init(void)
+{
+    sim_start();
+}
+
+/*!
+ * \brief Removes a timer from the list, call with interrupts masked
+ */
+static void tim_unlink(tim_timer_t *t)
+{
+    for(tim_timer_t *volatile *p = &head; *p != NULL; p = &(*p)->next)
+    {
+        if(*p == t)
+        {
+            *p = t->next;
+            t->next = NULL;
+            return;
+        }
+    }
+}
+
+/*!
+ * \brief Inserts a timer in the list by deadline, call with interrupts masked
+ */
+static void tim_insert(tim_timer_t *t)
+{
+    tim_timer_t *volatile *p = &head;
+
+    while((*p != NULL) && ((int32_t)(t->deadline - (*p)->deadline) >= 0))
+    {
+        p = &(*p)->next;
+    }
+
+    t->next = *p;
+    *p = t;
+}
+
+/*!
+ * \brief Sets the simulation event to the earliest deadline, call with
+ *        interrupts masked
+ */
+static void tim_program(void)
+{
+    if(head == NULL)
+    {
+        sim_event_stop(&tim_event);
+        return;
+    }
+
+    const int32_t left = (int32_t)(head->deadline - sim_time_us());
+
+    sim_event_start(&tim_event, (left > 0) ? ((uint64_t)left * 1000U) : 0, 0);
+}
+
+void tim_start(tim_timer_t *t, const uint32_t delay_us, const uint32_t period_us)
+{
+    configASSERT((t != NULL) && (t->callback != NULL));
+    configASSERT(delay_us <= TIM_MAX_US);
+    configASSERT((period_us == 0) ||
+        ((period_us >= TIM_MIN_PERIOD_US) && (period_us <= TIM_MAX_US)));
+
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    {
+        tim_unlink(t);
+
+        t->deadline = sim_time_us() + delay_us;
+        t->period = period_us;
+        t->active = true;
+
+        tim_insert(t);
+        tim_program();
+    }
+    __set_PRIMASK(primask);
+}
+
+void tim_stop(tim_timer_t *t)
+{
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    {
+        tim_unlink(t);
+        t->active = false;
+        tim_program();
+    }
+    __set_PRIMASK(primask);
+}
+
+bool tim_active(const tim_timer_t *t)
+{
+    return t->active;
+}
+
+/*!
+ * \brief Calls the callback of a deferred timer in the timer task
+ */
+static void tim_deferred(void *p1, uint32_t p2)
+{
+    (void)p2;
+
+    tim_timer_t *t = p1;
+    t->callback(t->arg, NULL);
+}
+
+/*!
+ * \brief Callback of tim_delay_us(), wakes the waiting task
+ */
+static void tim_wake(void *arg, BaseType_t *woken)
+{
+    vTaskNotifyGiveIndexedFromISR((TaskHandle_t)arg, TIM_NOTIFY_INDEX, woken);
+}
+
+void tim_delay_us(const uint32_t us)
+{
+    configASSERT(xTaskGetSchedulerState() == taskSCHEDULER_RUNNING);
+
+    tim_timer_t t = TIM_TIMER(tim_wake, xTaskGetCurrentTaskHandle());
+
+    ulTaskNotifyTakeIndexed(TIM_NOTIFY_INDEX, pdTRUE, 0);
+    tim_start(&t, us, 0);
+
+    ulTaskNotifyTakeIndexed(TIM_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+}
+
+/*!
+ * \brief Calls or defers the callbacks of all expired timers in the
+ *        simulated TPM1 interrupt
+ */
+static void tim_expired(sim_event_t *e)
+{
+    BaseType_t woken = pdFALSE;
+    tim_timer_t *t;
+
+    (void)e;
+
+    const uint32_t isr = sim_isr_enter(TPM1_IRQn);
+
+    while(((t = head) != NULL) &&
+          ((int32_t)(t->deadline - sim_time_us()) <= 0))
+    {
+        head = t->next;
+        t->next = NULL;
+
+        if(t->period != 0)
+        {
+            t->deadline += t->period;
+            tim_insert(t);
+        }
+        else
+        {
+            t->active = false;
+        }
+
+        if(t->deferred)
+        {
+            xTimerPendFunctionCallFromISR(tim_deferred, t, 0, &woken);
+        }
+        else
+        {
+            t->callback(t->arg, &woken);
+        }
+    }
+
+    tim_program();
+
+    sim_isr_exit(isr, woken);
+}
@@ -0,0 +1,1000 @@
+/*! ***************************************************************************
+ *
+ * \brief     Interrupt driven I2C master driver for I2C0 and I2C1
+ * \file      i2c.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "i2c.h"
+#include "bme.h"
+#include "delay.h"
+#include "dma.h"
+#include "irq_prio.h"
+
+/*!
+ * \brief I2C0: SCL on PTE24, SDA on PTE25, no DMA
+ */
+i2c_bus_t i2c_bus0 =
+{
+    .base = I2C0,
+    .irq = I2C0_IRQn,
+    .gate = CLK_GATE_I2C0,
+    .port = PORTE,
+    .gpio = PTE,
+    .scgc5 = SIM_SCGC5_PORTE_MASK,
+    .scl = 24,
+    .sda = 25,
+    .mux = 5,
+    .notify_index = I2C0_NOTIFY_INDEX,
+    .dma_channel = -1,
+    .bps = I2C0_DEFAULT_BPS,
+    .rate = I2C0_DEFAULT_BPS,
+};
+
+/*!
+ * \brief I2C1: SCL on PTE1, SDA on PTE0, writes by DMA if I2C1_USE_DMA
+ */
+i2c_bus_t i2c_bus1 =
+{
+    .base = I2C1,
+    .irq = I2C1_IRQn,
+    .gate = CLK_GATE_I2C1,
+    .port = PORTE,
+    .gpio = PTE,
+    .scgc5 = SIM_SCGC5_PORTE_MASK,
+    .scl = 1,
+    .sda = 0,
+    .mux = 6,
+    .notify_index = I2C1_NOTIFY_INDEX,
+#if (I2C1_USE_DMA == 1)
+    .dma_channel = I2C1_DMA_CHANNEL,
+#else
+    .dma_channel = -1,
+#endif
+    .dma_source = DMA_SOURCE_I2C1,
+    .dma_threshold = I2C1_DMA_THRESHOLD,
+    .bps = I2C1_DEFAULT_BPS,
+    .rate = I2C1_DEFAULT_BPS,
+};
+
+static void i2c_dma_isr(void *arg, const uint32_t dsr, BaseType_t *woken);
+
+/*!
+ * \brief Sets the requested bit rate again after a clock mode change
+ *
+ * If the bit rate cannot be reached at the new bus clock, the divider is
+ * kept and the achieved bit rate follows the bus clock. A byte on the bus
+ * during the change is clocked partly at the old and partly at the new rate.
+ */
+static void i2c_clock(const clk_event_t event, void *arg)
+{
+    i2c_bus_t *bus = (i2c_bus_t *)arg;
+
+    if(event != CLK_POST_CHANGE)
+    {
+        return;
+    }
+
+    if(i2c_set_speed(bus, bus->bps) == 0)
+    {
+        bus->rate = i2c_speed_rate(bus->base->F);
+    }
+}
+
+/*!
+ * \brief Initialises an I2C peripheral
+ *
+ * The bit rate is set to the default of the instance, or the bit rate
+ * selected by i2c_set_speed(). The bus is recovered first, in case a slave
+ * was left in the middle of a transfer by a reset.
+ *
+ * \param[in,out]  bus  I2C peripheral instance
+ */
+void i2c_init(i2c_bus_t *bus)
+{
+    // Clock i2c peripheral and port, once for a bus initialised again
+    if(clk_gate_users(bus->gate) == 0)
+    {
+        clk_gate_acquire(bus->gate);
+    }
+
+    SIM->SCGC5 |= bus->scgc5;
+
+    // Make sure i2c is disabled
+    bus->base->C1 &= ~(I2C_C1_IICEN_MASK);
+
+    i2c_recover(bus);
+
+    // Set the bit rate, the default is 375000 bps: 24MHz / (1 * 64)
+    if(i2c_set_speed(bus, bus->bps) == 0)
+    {
+        bus->base->F = (I2C_F_MULT(0) | I2C_F_ICR(0x12));
+    }
+
+    // And again after every clock mode change
+    clk_register(&bus->clock, i2c_clock, bus);
+
+    // Clear any flags
+    bus->base->S |= (I2C_S_ARBL_MASK | I2C_S_IICIF_MASK);
+
+    // Enable i2c and set to master mode
+    bus->base->C1 |= (I2C_C1_IICEN_MASK);
+
+    // Enable interrupts, the interrupt itself is enabled per transfer
+    NVIC_SetPriority(bus->irq, IRQ_PRIO(I2C));
+    NVIC_ClearPendingIRQ(bus->irq);
+    NVIC_EnableIRQ(bus->irq);
+
+    // Claim the DMA channel for good, all writes use the interrupt if
+    // another driver has it
+    if((bus->dma_channel >= 0) &&
+       (dma_claim(bus->dma_channel, i2c_dma_isr, bus) < 0))
+    {
+        bus->dma_channel = -1;
+    }
+
+    if(bus->dma_channel >= 0)
+    {
+        // Route the I2C request to the DMA channel
+        dma_route(bus->dma_channel, (dma_source_t)bus->dma_source, false);
+
+        DMA0->DMA[bus->dma_channel].DAR = (uint32_t)&bus->base->D;
+
+        dma_irq_enable(bus->dma_channel, IRQ_PRIO(I2C_DMA));
+    }
+}
+
+/*!
+ * \brief Sets the bit rate of an I2C peripheral
+ *
+ * The MULT and ICR values are calculated from the current bus clock. Call
+ * this function only while no transfer is in progress. The requested bit rate
+ * is applied again when i2c_init() is called.
+ *
+ * \param[in,out]  bus  I2C peripheral instance
+ * \param[in]      bps  Requested bit rate, for example one of i2c_speed_t
+ *
+ * \return The achieved bit rate, or 0 if \p bps cannot be achieved within
+ *         I2C_SPEED_TOLERANCE_PCT. The bit rate is not changed then.
+ */
+uint32_t i2c_set_speed(i2c_bus_t *bus, const uint32_t bps)
+{
+    uint8_t f;
+    uint32_t rate = i2c_speed_calc(bps, &f);
+
+    if(rate == 0)
+    {
+        return 0;
+    }
+
+    bus->base->F = f;
+
+    bus->bps = bps;
+    bus->rate = rate;
+
+    return rate;
+}
+
+/*!
+ * \brief Returns the achieved bit rate in bps
+ *
+ * \param[in]  bus  I2C peripheral instance
+ */
+uint32_t i2c_get_speed(const i2c_bus_t *bus)
+{
+    return bus->rate;
+}
+
+/*!
+ * \brief Frees a bus that is held by a slave
+ *
+ * A slave that was interrupted in the middle of a read by a reset or an
+ * aborted transfer may keep SDA low. SCL is clocked as an open drain GPIO
+ * until the slave releases SDA, at most nine times, followed by a stop
+ * condition. The pins are given back to the I2C peripheral afterwards.
+ *
+ * This takes about 100 us. It is called by i2c_init() and after a transfer
+ * timed out or lost arbitration.
+ *
+ * \param[in,out]  bus  I2C peripheral instance
+ */
+void i2c_recover(i2c_bus_t *bus)
+{
+    const uint32_t scl = (1UL << bus->scl);
+    const uint32_t sda = (1UL << bus->sda);
+
+    SIM->SCGC5 |= bus->scgc5;
+
+    // Both pins released: inputs that drive low when switched to output
+    bus->gpio->PDDR &= ~(scl | sda);
+    bus->gpio->PCOR = (scl | sda);
+    bus->port->PCR[bus->scl] = PORT_PCR_MUX(1);
+    bus->port->PCR[bus->sda] = PORT_PCR_MUX(1);
+
+    if((bus->gpio->PDIR & sda) == 0)
+    {
+        bus->stats.recoveries++;
+
+        for(uint32_t i=0; (i<9) && ((bus->gpio->PDIR & sda) == 0); ++i)
+        {
+            bus->gpio->PDDR |= scl;
+            delay_us(5);
+            bus->gpio->PDDR &= ~scl;
+            delay_us(5);
+        }
+    }
+
+    // Stop condition: SDA rises while SCL is high
+    bus->gpio->PDDR |= scl;
+    delay_us(5);
+    bus->gpio->PDDR |= sda;
+    delay_us(5);
+    bus->gpio->PDDR &= ~scl;
+    delay_us(5);
+    bus->gpio->PDDR &= ~sda;
+    delay_us(5);
+
+    // Set pins to I2C function
+    bus->port->PCR[bus->scl] = PORT_PCR_MUX(bus->mux);
+    bus->port->PCR[bus->sda] = PORT_PCR_MUX(bus->mux);
+}
+
+/*!
+ * \brief Copies the bus error statistics
+ *
+ * \param[in]   bus    I2C peripheral instance
+ * \param[out]  stats  Statistics
+ */
+void i2c_get_stats(const i2c_bus_t *bus, i2c_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    {
+        *stats = bus->stats;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Waits for the interrupt flag by polling
+ *
+ * \param[in]  base  I2C peripheral
+ *
+ * \return I2C_TIMED_OUT if the flag is not set within I2C_TIMEOUT loops,
+ *         I2C_ARBITRATION_LOST or I2C_DONE
+ */
+static i2c_status_t i2c_poll(I2C_Type *base)
+{
+    uint32_t timeout = I2C_TIMEOUT;
+
+    while((base->S & I2C_S_IICIF_MASK)==0)
+    {
+        if(--timeout == 0)
+        {
+            return I2C_TIMED_OUT;
+        }
+    }
+
+    const uint8_t s = base->S;
+
+    // Clear the flags
+    base->S |= (I2C_S_ARBL_MASK | I2C_S_IICIF_MASK);
+
+    return (s & I2C_S_ARBL_MASK) ? I2C_ARBITRATION_LOST : I2C_DONE;
+}
+
+/*!
+ * \brief Sends a byte by polling and checks its acknowledge
+ */
+static i2c_status_t i2c_poll_write(i2c_bus_t *bus, const uint8_t data)
+{
+    bus->base->D = data;
+
+    const i2c_status_t status = i2c_poll(bus->base);
+
+    if(status != I2C_DONE)
+    {
+        return status;
+    }
+
+    if(bus->base->S & I2C_S_RXAK_MASK)
+    {
+        return I2C_NACK;
+    }
+
+    return I2C_DONE;
+}
+
+/*!
+ * \brief Executes a transfer by polling the I2C flags
+ *
+ * Used when the scheduler is not running, so there is no task to block.
+ *
+ * \param[in,out]  bus  I2C peripheral instance
+ * \param[in,out]  t    Transfer
+ */
+static void i2c_transfer_polled(i2c_bus_t *bus, i2c_xfer_t *t)
+{
+    I2C_Type *base = bus->base;
+    i2c_status_t status;
+
+    bus->stats.transfers++;
+
+    t->queued = i2c_metrics_now();
+    i2c_metrics_start(bus);
+
+    PROBE_HIGH(PROBE_I2C);
+
+    // Make sure bus free time is 1.3 us (t_BUF).
+    delay_us(2);
+
+    // Set to transmit mode, ACK received bytes
+    base->C1 &= ~I2C_C1_TXAK_MASK;
+    base->C1 |= I2C_C1_TX_MASK;
+
+    // Generate start condition
+    base->C1 |= I2C_C1_MST_MASK;
+
+    // Send the address and register
+    status = i2c_poll_write(bus, t->address);
+
+    if(status == I2C_DONE)
+    {
+        status = i2c_poll_write(bus, t->reg);
+    }
+
+    for(uint32_t i=0; (i<t->ntx) && (status == I2C_DONE); ++i)
+    {
+        status = i2c_poll_write(bus, t->tx[i]);
+    }
+
+    if((t->nrx > 0) && (status == I2C_DONE))
+    {
+        // Repeated start and send device address (read)
+        base->C1 |= I2C_C1_RSTA_MASK;
+
+        status = i2c_poll_write(bus, t->address | 0x01);
+    }
+
+    if((t->nrx > 0) && (status == I2C_DONE))
+    {
+        // Receive mode, NACK after read if only one byte is read
+        base->C1 &= ~I2C_C1_TX_MASK;
+        if(t->nrx == 1)
+        {
+            base->C1 |= I2C_C1_TXAK_MASK;
+        }
+
+        // Dummy read starts the reception of the first byte
+        (void)base->D;
+
+        for(uint32_t i=0; (i<t->nrx) && (status == I2C_DONE); ++i)
+        {
+            status = i2c_poll(base);
+
+            if(i == (t->nrx - 1))
+            {
+                // Send stop before reading the last byte
+                base->C1 &= ~I2C_C1_MST_MASK;
+            }
+            else if(i == (t->nrx - 2))
+            {
+                // NACK after the next read, that is the last byte
+                base->C1 |= I2C_C1_TXAK_MASK;
+            }
+
+            t->rx[i] = base->D;
+        }
+    }
+
+    // Generate stop
+    base->C1 &= ~I2C_C1_MST_MASK;
+
+    PROBE_LOW(PROBE_I2C);
+
+    switch(status)
+    {
+    case I2C_NACK:
+        bus->stats.nacks++;
+        break;
+
+    case I2C_ARBITRATION_LOST:
+        bus->stats.arbitration++;
+        base->C1 &= ~I2C_C1_IICEN_MASK;
+        i2c_recover(bus);
+        base->C1 |= I2C_C1_IICEN_MASK;
+        break;
+
+    case I2C_TIMED_OUT:
+        bus->stats.timeouts++;
+        base->C1 &= ~I2C_C1_IICEN_MASK;
+        i2c_recover(bus);
+        base->C1 |= I2C_C1_IICEN_MASK;
+        break;
+
+    default:
+        break;
+    }
+
+    i2c_metrics_end(bus, t, status, true);
+    t->status = status;
+}
+
+/*!
+ * \brief Starts the transfer at the head of the queue
+ *
+ * Called from a critical section or from the interrupt handler.
+ */
+static void i2c_begin(i2c_bus_t *bus)
+{
+    I2C_Type *base = bus->base;
+
+    bus->head->status = I2C_BUSY;
+    bus->phase = I2C_PHASE_ADDRESS;
+    bus->idx = 0;
+    bus->stats.transfers++;
+
+    i2c_metrics_start(bus);
+
+    PROBE_HIGH(PROBE_I2C);
+
+    // Make sure bus free time is 1.3 us (t_BUF).
+    delay_us(2);
+
+    // Clear any flags
+    base->S |= (I2C_S_ARBL_MASK | I2C_S_IICIF_MASK);
+
+    // Set to transmit mode, ACK received bytes and enable the interrupt
+    base->C1 &= ~I2C_C1_TXAK_MASK;
+    base->C1 |= (I2C_C1_TX_MASK | I2C_C1_IICIE_MASK);
+
+    // Generate start condition
+    base->C1 |= I2C_C1_MST_MASK;
+
+    // Send the address, the rest of the transfer is done by the ISR
+    base->D = bus->head->address;
+}
+
+/*!
+ * \brief Ends the transfer at the head of the queue
+ *
+ * Called from a critical section or from the interrupt handler.
+ *
+ * \param[in,out]  bus     I2C peripheral instance
+ * \param[in]      status  Final state of the transfer
+ * \param[in]      next    Start the next queued transfer
+ *
+ * \return The ended transfer
+ */
+static i2c_xfer_t *i2c_pop(i2c_bus_t *bus, const i2c_status_t status,
+    const bool next)
+{
+    i2c_xfer_t *t = bus->head;
+
+    if(bus->phase == I2C_PHASE_DMA)
+    {
+        BME_CLR(DMA0->DMA[bus->dma_channel].DCR, DMA_DCR_ERQ_MASK);
+        DMA0->DMA[bus->dma_channel].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    }
+
+    // Disable the interrupt and DMA requests and generate stop
+    BME_CLR(bus->base->C1, I2C_C1_IICIE_MASK | I2C_C1_DMAEN_MASK | I2C_C1_MST_MASK);
+
+    PROBE_LOW(PROBE_I2C);
+
+    bus->head = t->next;
+    if(bus->head == NULL)
+    {
+        bus->tail = NULL;
+    }
+
+    i2c_metrics_end(bus, t, status, true);
+    t->status = status;
+
+    if(next && (bus->head != NULL))
+    {
+        i2c_begin(bus);
+    }
+
+    return t;
+}
+
+/*!
+ * \brief Ends the transfer at the head of the queue from the interrupt
+ *        handler and notifies its submitter
+ */
+static void i2c_finish(i2c_bus_t *bus, const i2c_status_t status,
+    BaseType_t *woken)
+{
+    i2c_xfer_t *t = i2c_pop(bus, status, true);
+
+    vTaskNotifyGiveIndexedFromISR(t->task, bus->notify_index, woken);
+}
+
+/*!
+ * \brief Queues a transfer
+ *
+ * The transfer is started immediately if the bus is idle. Transfers are
+ * executed back-to-back by the interrupt handler, so several tasks can share
+ * a bus, each blocking only on its own transfers. Must be called from a task,
+ * which is notified on the notify_index of \p bus when the transfer
+ * completes. Wait for it with i2c_wait().
+ *
+ * \param[in,out]  bus  I2C peripheral instance
+ * \param[in,out]  t    Transfer
+ */
+void i2c_submit(i2c_bus_t *bus, i2c_xfer_t *t)
+{
+    t->task = xTaskGetCurrentTaskHandle();
+    t->status = I2C_QUEUED;
+    t->next = NULL;
+    t->queued = i2c_metrics_now();
+
+    taskENTER_CRITICAL();
+    {
+        if(bus->tail == NULL)
+        {
+            bus->head = t;
+            bus->tail = t;
+            i2c_begin(bus);
+        }
+        else
+        {
+            bus->tail->next = t;
+            bus->tail = t;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Aborts the transfer at the head of the queue and recovers the bus
+ *        before the next transfer is started
+ *
+ * Called from a critical section or from the interrupt handler, takes about
+ * 100 us.
+ *
+ * \return The aborted transfer
+ */
+static i2c_xfer_t *i2c_abort(i2c_bus_t *bus, const i2c_status_t status)
+{
+    i2c_xfer_t *t = i2c_pop(bus, status, false);
+
+    bus->base->C1 &= ~I2C_C1_IICEN_MASK;
+    i2c_recover(bus);
+    bus->base->C1 |= I2C_C1_IICEN_MASK;
+
+    if(bus->head != NULL)
+    {
+        i2c_begin(bus);
+    }
+
+    return t;
+}
+
+/*!
+ * \brief Removes a transfer that did not complete in time from the queue
+ *
+ * A transfer that is on the bus is aborted and the bus is recovered before
+ * the next transfer is started.
+ */
+static void i2c_cancel(i2c_bus_t *bus, i2c_xfer_t *t)
+{
+    taskENTER_CRITICAL();
+    {
+        if(t->status == I2C_BUSY)
+        {
+            bus->stats.timeouts++;
+
+            (void)i2c_abort(bus, I2C_TIMED_OUT);
+        }
+        else if(t->status == I2C_QUEUED)
+        {
+            bus->stats.timeouts++;
+
+            // Not on the bus, so it is not the head
+            i2c_xfer_t *prev = bus->head;
+            while(prev->next != t)
+            {
+                prev = prev->next;
+            }
+
+            prev->next = t->next;
+            if(bus->tail == t)
+            {
+                bus->tail = prev;
+            }
+
+            i2c_metrics_end(bus, t, I2C_TIMED_OUT, false);
+            t->status = I2C_TIMED_OUT;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Waits for a transfer submitted by the calling task
+ *
+ * If it is not completed within \p timeout ticks, it is cancelled.
+ *
+ * \param[in,out]  bus      I2C peripheral instance
+ * \param[in,out]  t        Transfer
+ * \param[in]      timeout  Maximum time to wait in ticks
+ *
+ * \return True if the transfer completed successfully
+ */
+bool i2c_wait(i2c_bus_t *bus, i2c_xfer_t *t, const TickType_t timeout)
+{
+    TimeOut_t start;
+    TickType_t remaining = timeout;
+
+    vTaskSetTimeOutState(&start);
+
+    // A notification may belong to another transfer of this task, so check
+    // the state of this one every time
+    while((t->status == I2C_QUEUED) || (t->status == I2C_BUSY))
+    {
+        if(xTaskCheckForTimeOut(&start, &remaining) == pdTRUE)
+        {
+            i2c_cancel(bus, t);
+            break;
+        }
+
+        ulTaskNotifyTakeIndexed(bus->notify_index, pdTRUE, remaining);
+    }
+
+    return (t->status == I2C_DONE);
+}
+
+/*!
+ * \brief Executes a transfer and waits for it
+ *
+ * While the scheduler is running the transfer is queued and the calling task
+ * blocks. The timeout is the theoretical transfer time plus
+ * I2C_TIMEOUT_MARGIN_MS. Before the scheduler is started the transfer is
+ * done by polling.
+ *
+ * A failed transfer is repeated up to I2C_RETRIES times. The bus is already
+ * recovered when a transfer timed out or lost arbitration, so a glitch costs
+ * a repeated transfer instead of reinitialising the device.
+ *
+ * \param[in,out]  bus  I2C peripheral instance
+ * \param[in,out]  t    Transfer
+ *
+ * \return True on successfull communication, false otherwise. The reason of
+ *         the last failure is in t->status.
+ */
+bool i2c_transfer(i2c_bus_t *bus, i2c_xfer_t *t)
+{
+    // Every byte, including the addresses and register byte, takes 9 bit
+    // times
+    const uint32_t bytes = t->ntx + t->nrx + 3;
+    const TickType_t timeout = pdMS_TO_TICKS((bytes * 9 * 1000) / bus->rate +
+        I2C_TIMEOUT_MARGIN_MS);
+
+    for(uint32_t attempt=0; attempt<=I2C_RETRIES; ++attempt)
+    {
+        if(attempt > 0)
+        {
+            bus->stats.retries++;
+        }
+
+        if(xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+        {
+            i2c_transfer_polled(bus, t);
+        }
+        else
+        {
+            i2c_submit(bus, t);
+            (void)i2c_wait(bus, t, timeout);
+        }
+
+        if(t->status == I2C_DONE)
+        {
+            return true;
+        }
+    }
+
+    bus->stats.failures++;
+
+    return false;
+}
+
+/*!
+ * \brief Writes a register byte followed by n bytes
+ *
+ * \param[in,out]  bus      I2C peripheral instance
+ * \param[in]      address  Slave address (write)
+ * \param[in]      reg      Register address or control byte
+ * \param[in]      data     Bytes to write
+ * \param[in]      n        Number of bytes
+ *
+ * \return True on successfull communication, false otherwise
+ */
+bool i2c_write(i2c_bus_t *bus, const uint8_t address, const uint8_t reg,
+    const uint8_t data[], const uint32_t n)
+{
+    i2c_xfer_t t =
+    {
+        .address = address,
+        .reg = reg,
+        .tx = data,
+        .ntx = n,
+        .nrx = 0,
+    };
+
+    return i2c_transfer(bus, &t);
+}
+
+/*!
+ * \brief Reads n consecutive registers, starting at reg
+ *
+ * \param[in,out]  bus      I2C peripheral instance
+ * \param[in]      address  Slave address (write)
+ * \param[in]      reg      First register address
+ * \param[out]     data     Bytes read
+ * \param[in]      n        Number of bytes
+ *
+ * \return True on successfull communication, false otherwise
+ */
+bool i2c_read(i2c_bus_t *bus, const uint8_t address, const uint8_t reg,
+    uint8_t data[], const uint32_t n)
+{
+    i2c_xfer_t t =
+    {
+        .address = address,
+        .reg = reg,
+        .ntx = 0,
+        .rx = data,
+        .nrx = n,
+    };
+
+    return i2c_transfer(bus, &t);
+}
+
+/*!
+ * \brief Hands the remaining bytes of a write over to DMA
+ *
+ * The byte just written to the data register is on its way. Its completion
+ * raises the first DMA request, DMA writes the remaining bytes.
+ */
+static void i2c_start_dma(i2c_bus_t *bus, i2c_xfer_t *t)
+{
+    const int8_t ch = bus->dma_channel;
+
+    bus->phase = I2C_PHASE_DMA;
+
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    DMA0->DMA[ch].SAR = (uint32_t)&t->tx[bus->idx];
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_BCR(t->ntx - bus->idx);
+    bus->idx = t->ntx;
+
+    // Byte transfers, one per request, incrementing source, interrupt
+    // when complete. ERQ is cleared by hardware when BCR reaches zero.
+    DMA0->DMA[ch].DCR = DMA_DCR_EINT_MASK |
+                        DMA_DCR_ERQ_MASK |
+                        DMA_DCR_CS_MASK |
+                        DMA_DCR_SINC_MASK |
+                        DMA_DCR_SSIZE(1) |
+                        DMA_DCR_DSIZE(1) |
+                        DMA_DCR_D_REQ_MASK;
+
+    // Hand the byte transfers over to DMA
+    bus->base->C1 = (bus->base->C1 & ~I2C_C1_IICIE_MASK) | I2C_C1_DMAEN_MASK;
+}
+
+/*!
+ * \brief Common I2C interrupt handler
+ *
+ * Called after every transferred byte. Sends or receives the next byte of
+ * the transfer on the bus. When the transfer is completed, or the slave did
+ * not acknowledge or arbitration was lost, its submitter is notified and the
+ * next transfer is started.
+ */
+static void i2c_irq(i2c_bus_t *bus)
+{
+    BaseType_t woken = pdFALSE;
+    I2C_Type *base = bus->base;
+    const uint8_t s = base->S;
+
+    // Clear the flags
+    base->S |= (I2C_S_ARBL_MASK | I2C_S_IICIF_MASK);
+
+    i2c_xfer_t *t = bus->head;
+
+    // Ignore an interrupt left behind by an aborted transfer
+    if((t == NULL) || ((s & I2C_S_IICIF_MASK) == 0) ||
+       (bus->phase == I2C_PHASE_DMA))
+    {
+        return;
+    }
+
+    if(s & I2C_S_ARBL_MASK)
+    {
+        // A single master only loses arbitration to a glitch or a slave that
+        // holds SDA, so recover the bus before the next transfer
+        bus->stats.arbitration++;
+        t = i2c_abort(bus, I2C_ARBITRATION_LOST);
+        vTaskNotifyGiveIndexedFromISR(t->task, bus->notify_index, &woken);
+        portYIELD_FROM_ISR(woken);
+        return;
+    }
+
+    // The slave does not acknowledge bytes it transmits
+    if((bus->phase != I2C_PHASE_READ) && (s & I2C_S_RXAK_MASK))
+    {
+        bus->stats.nacks++;
+        i2c_finish(bus, I2C_NACK, &woken);
+        portYIELD_FROM_ISR(woken);
+        return;
+    }
+
+    switch(bus->phase)
+    {
+    case I2C_PHASE_ADDRESS:
+        // Send register
+        bus->phase = I2C_PHASE_REGISTER;
+        base->D = t->reg;
+        break;
+
+    case I2C_PHASE_REGISTER:
+    case I2C_PHASE_WRITE:
+        if(bus->idx < t->ntx)
+        {
+            bus->phase = I2C_PHASE_WRITE;
+            base->D = t->tx[bus->idx++];
+
+            if((bus->dma_channel >= 0) && (t->nrx == 0) &&
+               ((t->ntx - bus->idx) >= bus->dma_threshold))
+            {
+                i2c_start_dma(bus, t);
+            }
+        }
+        else if(t->nrx > 0)
+        {
+            // Repeated start and send device address (read)
+            bus->phase = I2C_PHASE_READ_ADDRESS;
+            BME_OR(base->C1, I2C_C1_RSTA_MASK);
+            base->D = (t->address | 0x01);
+        }
+        else
+        {
+            i2c_finish(bus, I2C_DONE, &woken);
+        }
+        break;
+
+    case I2C_PHASE_READ_ADDRESS:
+        // Receive mode, NACK after read if only one byte is read
+        bus->phase = I2C_PHASE_READ;
+        bus->idx = 0;
+        BME_CLR(base->C1, I2C_C1_TX_MASK);
+
+        if(t->nrx == 1)
+        {
+            BME_OR(base->C1, I2C_C1_TXAK_MASK);
+        }
+
+        // Dummy read starts the reception of the first byte
+        (void)base->D;
+        break;
+
+    case I2C_PHASE_READ:
+        if(bus->idx == (t->nrx - 1))
+        {
+            // Send stop before reading the last byte
+            BME_CLR(base->C1, I2C_C1_MST_MASK);
+            t->rx[bus->idx] = base->D;
+
+            i2c_finish(bus, I2C_DONE, &woken);
+        }
+        else
+        {
+            // NACK after the next read if that is the last byte
+            if(bus->idx == (t->nrx - 2))
+            {
+                BME_OR(base->C1, I2C_C1_TXAK_MASK);
+            }
+
+            t->rx[bus->idx++] = base->D;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    portYIELD_FROM_ISR(woken);
+}
+
+/*!
+ * \brief Common DMA interrupt, called by the interrupt handler of the
+ *        channel
+ *
+ * Called when DMA has written the last byte of the transfer to the data
+ * register. That byte is still being shifted out, so the I2C interrupt is
+ * enabled again to generate stop once it is completed.
+ */
+static void i2c_dma_isr(void *arg, const uint32_t dsr, BaseType_t *woken)
+{
+    i2c_bus_t *bus = arg;
+    const int8_t ch = bus->dma_channel;
+
+    // Clear the done and error flags
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+
+    if((bus->head == NULL) || (bus->phase != I2C_PHASE_DMA))
+    {
+        return;
+    }
+
+    if(dsr & (DMA_DSR_BCR_CE_MASK | DMA_DSR_BCR_BES_MASK | DMA_DSR_BCR_BED_MASK))
+    {
+        i2c_finish(bus, I2C_FAILED, woken);
+    }
+    else
+    {
+        bus->phase = I2C_PHASE_WRITE;
+
+        // Wait for the last byte with the I2C interrupt
+        BME_CLR(bus->base->C1, I2C_C1_DMAEN_MASK);
+        BME_OR(bus->base->S, I2C_S_IICIF_MASK);
+        BME_OR(bus->base->C1, I2C_C1_IICIE_MASK);
+
+        // The last byte may already be completed before the flag was
+        // cleared. The I2C interrupt is then ignored, as the flag is clear.
+        if(bus->base->S & I2C_S_TCF_MASK)
+        {
+            if(bus->base->S & I2C_S_RXAK_MASK)
+            {
+                bus->stats.nacks++;
+                i2c_finish(bus, I2C_NACK, woken);
+            }
+            else
+            {
+                i2c_finish(bus, I2C_DONE, woken);
+            }
+        }
+    }
+}
+
+/*!
+ * \brief I2C0 interrupt handler
+ */
+void I2C0_IRQHandler(void)
+{
+    TRACE_ISR_ENTER();
+    i2c_irq(&i2c_bus0);
+    TRACE_ISR_EXIT();
+}
+
+/*!
+ * \brief I2C1 interrupt handler
+ */
+void I2C1_IRQHandler(void)
+{
+    TRACE_ISR_ENTER();
+    i2c_irq(&i2c_bus1);
+    TRACE_ISR_EXIT();
+}
@@ -0,0 +1,256 @@
+/*! ***************************************************************************
+ *
+ * \brief     Interrupt driven I2C master driver for I2C0 and I2C1
+ * \file      i2c.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef I2C_H
+#define I2C_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <MKL25Z4.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "clock.h"
+#include "i2c_metrics.h"
+#include "i2c_speed.h"
+
+/// \name Definitions for the I2C driver
+/// \{
+
+/*!
+ * \brief Definition for the I2C timeout
+ *
+ * This timeout value is used in loops to wait for a bit to set/reset before
+ * the scheduler is started. If the bit doesn't get set, the transfer fails.
+ */
+#define I2C_TIMEOUT (10000)
+
+/*!
+ * \brief Margin in milliseconds added to the theoretical transfer time
+ *        before a queued transfer is cancelled
+ *
+ * This includes the time the transfer waits for transfers that were queued
+ * before it.
+ */
+#ifndef I2C_TIMEOUT_MARGIN_MS
+#define I2C_TIMEOUT_MARGIN_MS (10)
+#endif
+
+/*!
+ * \brief Number of times i2c_transfer() repeats a failed transfer
+ *
+ * A bus that was held by a slave or lost arbitration is recovered before the
+ * transfer is repeated. A driver should reinitialise its device only after
+ * all retries failed.
+ */
+#ifndef I2C_RETRIES
+#define I2C_RETRIES (2)
+#endif
+
+/*!
+ * \brief Default bit rates in bps
+ */
+#ifndef I2C0_DEFAULT_BPS
+#define I2C0_DEFAULT_BPS (375000)
+#endif
+
+#ifndef I2C1_DEFAULT_BPS
+#define I2C1_DEFAULT_BPS (375000)
+#endif
+
+/*!
+ * \brief Task notification indices used to signal a completed transfer
+ */
+#ifndef I2C0_NOTIFY_INDEX
+#define I2C0_NOTIFY_INDEX (4)
+#endif
+
+#ifndef I2C1_NOTIFY_INDEX
+#define I2C1_NOTIFY_INDEX (3)
+#endif
+
+/*!
+ * \brief Set to 1 to transfer the data phase of long I2C1 writes by DMA
+ *
+ * The address, register and first data byte are sent by the interrupt
+ * handler. DMA channel I2C1_DMA_CHANNEL sends the remaining bytes, so a full
+ * framebuffer update costs a few interrupts instead of one per byte.
+ */
+#ifndef I2C1_USE_DMA
+#define I2C1_USE_DMA (1)
+#endif
+
+/*!
+ * \brief Minimum number of bytes written for a transfer to use DMA
+ */
+#ifndef I2C1_DMA_THRESHOLD
+#define I2C1_DMA_THRESHOLD (16)
+#endif
+
+/*!
+ * \brief DMA channel used for I2C1 transfers, channels 0 and 1 are used by
+ *        the serial driver
+ */
+#define I2C1_DMA_CHANNEL (2)
+
+/// \}
+
+/// State of a transfer
+typedef enum
+{
+    I2C_QUEUED,           ///< Waiting for the bus
+    I2C_BUSY,             ///< On the bus
+    I2C_DONE,             ///< Completed successfully
+    I2C_NACK,             ///< Not acknowledged by the slave
+    I2C_ARBITRATION_LOST, ///< Arbitration lost, the bus was recovered
+    I2C_TIMED_OUT,        ///< Timed out, the bus was recovered
+    I2C_FAILED,           ///< DMA error
+}
+i2c_status_t;
+
+/// Transfer descriptor
+///
+/// A transfer writes the register byte followed by \p ntx bytes from \p tx.
+/// If \p nrx is larger than 0, a repeated start follows and \p nrx bytes are
+/// read into \p rx. For the SSD1306 the register byte is the control byte.
+/// The descriptor and the buffers must remain valid until i2c_wait()
+/// returns.
+typedef struct i2c_xfer
+{
+    uint8_t address;        ///< Slave address (write)
+    uint8_t reg;            ///< Register address or control byte
+    const uint8_t *tx;      ///< Bytes to write after the register byte
+    uint32_t ntx;           ///< Number of bytes to write
+    uint8_t *rx;            ///< Buffer for the bytes read
+    uint32_t nrx;           ///< Number of bytes to read
+
+    // Managed by the driver
+    volatile i2c_status_t status;
+    TaskHandle_t task;
+    struct i2c_xfer *next;
+    uint32_t queued;        ///< Run time of i2c_submit(), see i2c_metrics.h
+}
+i2c_xfer_t;
+
+/// Bus error statistics
+typedef struct
+{
+    uint32_t transfers;     ///< Started transfers
+    uint32_t nacks;         ///< Transfers not acknowledged by the slave
+    uint32_t arbitration;   ///< Transfers that lost arbitration
+    uint32_t timeouts;      ///< Transfers cancelled after a timeout
+    uint32_t recoveries;    ///< Bus recoveries
+    uint32_t retries;       ///< Transfers repeated by i2c_transfer()
+    uint32_t failures;      ///< Transfers that failed after all retries
+}
+i2c_stats_t;
+
+/// Phases of a transfer on the bus
+typedef enum
+{
+    I2C_PHASE_ADDRESS,
+    I2C_PHASE_REGISTER,
+    I2C_PHASE_WRITE,
+    I2C_PHASE_DMA,
+    I2C_PHASE_READ_ADDRESS,
+    I2C_PHASE_READ,
+}
+i2c_phase_t;
+
+/// I2C peripheral instance
+///
+/// Use i2c_bus0 or i2c_bus1, the configuration fields describe the pins and
+/// resources of that peripheral.
+typedef struct
+{
+    // Configuration
+    I2C_Type *base;             ///< Peripheral
+    IRQn_Type irq;              ///< Interrupt
+    clk_gate_t gate;            ///< Clock gate of the peripheral
+    PORT_Type *port;            ///< Port of the pins
+    GPIO_Type *gpio;            ///< GPIO of the pins, for bus recovery
+    uint32_t scgc5;             ///< Clock gate of the port in SIM_SCGC5
+    uint8_t scl;                ///< SCL pin number
+    uint8_t sda;                ///< SDA pin number
+    uint8_t mux;                ///< Pin mux value of the I2C function
+    UBaseType_t notify_index;   ///< Task notification index
+    int8_t dma_channel;         ///< DMA channel for writes, -1 for none
+    uint8_t dma_source;         ///< DMAMUX request source
+    uint32_t dma_threshold;     ///< Minimum number of bytes written by DMA
+
+    // State
+    uint32_t bps;               ///< Requested bit rate
+    uint32_t rate;              ///< Achieved bit rate
+    i2c_xfer_t * volatile head; ///< Transfer on the bus
+    i2c_xfer_t * volatile tail; ///< Last queued transfer
+    volatile i2c_phase_t phase; ///< Progress of the transfer on the bus
+    volatile uint32_t idx;      ///< Index of the next byte
+    i2c_stats_t stats;          ///< Bus error statistics
+#if (I2C_METRICS == 1)
+    i2c_metrics_t metrics;      ///< Transfers of every slave address
+#endif
+    clk_notifier_t clock;       ///< Registration for clock mode changes
+}
+i2c_bus_t;
+
+extern i2c_bus_t i2c_bus0;
+extern i2c_bus_t i2c_bus1;
+
+// Function prototypes
+void i2c_init(i2c_bus_t *bus);
+uint32_t i2c_set_speed(i2c_bus_t *bus, const uint32_t bps);
+uint32_t i2c_get_speed(const i2c_bus_t *bus);
+
+void i2c_submit(i2c_bus_t *bus, i2c_xfer_t *t);
+bool i2c_wait(i2c_bus_t *bus, i2c_xfer_t *t, const TickType_t timeout);
+bool i2c_transfer(i2c_bus_t *bus, i2c_xfer_t *t);
+
+bool i2c_write(i2c_bus_t *bus, const uint8_t address, const uint8_t reg,
+    const uint8_t data[], const uint32_t n);
+bool i2c_read(i2c_bus_t *bus, const uint8_t address, const uint8_t reg,
+    uint8_t data[], const uint32_t n);
+
+void i2c_recover(i2c_bus_t *bus);
+void i2c_get_stats(const i2c_bus_t *bus, i2c_stats_t *stats);
+
+bool i2c_get_device_stats(const i2c_bus_t *bus, const uint32_t index,
+    i2c_device_stats_t *d);
+uint32_t i2c_get_utilisation(const i2c_bus_t *bus);
+void i2c_reset_device_stats(i2c_bus_t *bus);
+
+// Accounting of the transfers, for the drivers, see i2c_metrics.c
+uint32_t i2c_metrics_now(void);
+void i2c_metrics_start(i2c_bus_t *bus);
+void i2c_metrics_end(i2c_bus_t *bus, const i2c_xfer_t *t,
+    const i2c_status_t status, const bool on_bus);
+
+#endif // I2C_H
@@ -0,0 +1,289 @@
+/*! ***************************************************************************
+ *
+ * \brief     Transfer metrics of every slave address on an I2C bus
+ * \file      i2c_metrics.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <string.h>
+
+#include "i2c.h"
+
+/*
+ * The accounting of i2c/i2c.c and of the simulated driver of the host
+ * build. A transfer is timed from i2c_submit() to the start on the bus,
+ * the queueing delay, and from the start to its end, the time on the bus.
+ * Both are measured at the end of the transfer, in the interrupt handler or
+ * a critical section.
+ */
+
+/*!
+ * \brief Returns the low 32 bits of the run-time counter
+ *
+ * Time differences below about 178 s are exact across a wrap. Returns 0
+ * without I2C_METRICS.
+ */
+uint32_t i2c_metrics_now(void)
+{
+#if (I2C_METRICS == 1)
+    return (uint32_t)ullRunTimeCounterValue();
+#else
+    return 0;
+#endif
+}
+
+/*!
+ * \brief Records the start of the transfer at the head of the queue on the
+ *        bus
+ *
+ * Called by the driver with interrupts masked.
+ *
+ * \param[in,out]  bus  I2C peripheral instance
+ */
+void i2c_metrics_start(i2c_bus_t *bus)
+{
+#if (I2C_METRICS == 1)
+    bus->metrics.started = i2c_metrics_now();
+#else
+    (void)bus;
+#endif
+}
+
+#if (I2C_METRICS == 1)
+/*!
+ * \brief Returns the slot of a slave address, a free slot the first time
+ *        it is seen
+ *
+ * \return The slot, NULL if all slots are taken by other addresses
+ */
+static i2c_device_stats_t *i2c_metrics_device(i2c_metrics_t *m,
+    const uint8_t address)
+{
+    for(uint32_t i=0; i<I2C_METRICS_DEVICES; ++i)
+    {
+        i2c_device_stats_t *d = &m->devices[i];
+
+        if(d->address == address)
+        {
+            return d;
+        }
+
+        if(d->address == 0)
+        {
+            d->address = address;
+            return d;
+        }
+    }
+
+    return NULL;
+}
+#endif
+
+/*!
+ * \brief Accounts an ended transfer to its slave address
+ *
+ * Called by the driver with interrupts masked. The start on the bus is the
+ * one recorded by i2c_metrics_start(), a transfer that never
+ * reached the bus has no time on the bus and waited until now.
+ *
+ * \param[in,out]  bus     I2C peripheral instance
+ * \param[in]      t       The ended transfer
+ * \param[in]      status  Final state of the transfer
+ * \param[in]      on_bus  The transfer was started on the bus
+ */
+void i2c_metrics_end(i2c_bus_t *bus, const i2c_xfer_t *t,
+    const i2c_status_t status, const bool on_bus)
+{
+#if (I2C_METRICS == 1)
+    i2c_metrics_t *m = &bus->metrics;
+    const uint32_t now = i2c_metrics_now();
+    const uint32_t busy = on_bus ? (now - m->started) : 0;
+    const uint32_t wait = (on_bus ? m->started : now) - t->queued;
+
+    m->busy += busy;
+
+    i2c_device_stats_t *d = i2c_metrics_device(m, t->address);
+    if(d == NULL)
+    {
+        return;
+    }
+
+    d->transfers++;
+    d->busy += busy;
+    d->wait += wait;
+
+    if(busy > d->busy_max)
+    {
+        d->busy_max = busy;
+    }
+
+    if(wait > d->wait_max)
+    {
+        d->wait_max = wait;
+    }
+
+    switch(status)
+    {
+    case I2C_DONE:
+        // Address, register, written bytes and for a read the repeated
+        // address and the read bytes
+        d->bytes += 2 + t->ntx + ((t->nrx > 0) ? (1 + t->nrx) : 0);
+        break;
+
+    case I2C_NACK:
+        d->nacks++;
+        break;
+
+    case I2C_ARBITRATION_LOST:
+        d->arbitration++;
+        break;
+
+    case I2C_TIMED_OUT:
+        d->timeouts++;
+        break;
+
+    default:
+        break;
+    }
+
+    if(on_bus)
+    {
+        uint32_t bound = I2C_METRICS_BUCKET_US * I2C_METRICS_CYCLES_PER_US;
+        uint32_t b = 0;
+
+        while((b < (I2C_METRICS_BUCKETS - 1)) && (busy >= bound))
+        {
+            bound <<= 1;
+            b++;
+        }
+
+        if(d->histogram[b] < UINT16_MAX)
+        {
+            d->histogram[b]++;
+        }
+    }
+#else
+    (void)bus;
+    (void)t;
+    (void)status;
+    (void)on_bus;
+#endif
+}
+
+/*!
+ * \brief Copies the metrics of a slave address
+ *
+ * Call with consecutive indices from 0 until it returns false.
+ *
+ * \param[in]   bus    I2C peripheral instance
+ * \param[in]   index  Slot of the address
+ * \param[out]  d      Metrics, times in rtsCLOCK_HZ cycles
+ *
+ * \return False if the slot is not used, or without I2C_METRICS
+ */
+bool i2c_get_device_stats(const i2c_bus_t *bus, const uint32_t index,
+    i2c_device_stats_t *d)
+{
+#if (I2C_METRICS == 1)
+    bool used = false;
+
+    if(index >= I2C_METRICS_DEVICES)
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        *d = bus->metrics.devices[index];
+        used = (d->address != 0);
+    }
+    taskEXIT_CRITICAL();
+
+    return used;
+#else
+    (void)bus;
+    (void)index;
+    (void)d;
+
+    return false;
+#endif
+}
+
+/*!
+ * \brief Returns the share of the time since the last reset that the bus
+ *        was busy with transfers
+ *
+ * \param[in]  bus  I2C peripheral instance
+ *
+ * \return Utilisation in tenths of a percent, 0 without I2C_METRICS
+ */
+uint32_t i2c_get_utilisation(const i2c_bus_t *bus)
+{
+#if (I2C_METRICS == 1)
+    uint64_t busy;
+    uint64_t since;
+
+    taskENTER_CRITICAL();
+    {
+        busy = bus->metrics.busy;
+        since = bus->metrics.since;
+    }
+    taskEXIT_CRITICAL();
+
+    const uint64_t elapsed = ullRunTimeCounterValue() - since;
+
+    return (elapsed > 0) ? (uint32_t)((busy * 1000) / elapsed) : 0;
+#else
+    (void)bus;
+
+    return 0;
+#endif
+}
+
+/*!
+ * \brief Clears the metrics of all slave addresses of a bus
+ *
+ * The slots are given free, so the measurement starts again with the
+ * addresses in the order they are used.
+ *
+ * \param[in,out]  bus  I2C peripheral instance
+ */
+void i2c_reset_device_stats(i2c_bus_t *bus)
+{
+#if (I2C_METRICS == 1)
+    taskENTER_CRITICAL();
+    {
+        const uint32_t started = bus->metrics.started;
+
+        memset(&bus->metrics, 0, sizeof(bus->metrics));
+        bus->metrics.started = started;
+        bus->metrics.since = ullRunTimeCounterValue();
+    }
+    taskEXIT_CRITICAL();
+#else
+    (void)bus;
+#endif
+}
@@ -0,0 +1,103 @@
+/*! ***************************************************************************
+ *
+ * \brief     Transfer metrics of every slave address on an I2C bus
+ * \file      i2c_metrics.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef I2C_METRICS_H
+#define I2C_METRICS_H
+
+#include <stdint.h>
+
+#include "runtime_stats.h"
+
+/*!
+ * \brief Set to 0 to stop measuring the transfers of every slave address,
+ *        see i2c_get_device_stats()
+ *
+ * Times are read from the run-time counter of runtime_stats.c, in
+ * rtsCLOCK_HZ cycles.
+ */
+#ifndef I2C_METRICS
+#define I2C_METRICS (1)
+#endif
+
+/*!
+ * \brief Number of slave addresses measured per bus
+ *
+ * Transfers to further addresses are only counted in the bus statistics
+ * and in the bus utilisation.
+ */
+#ifndef I2C_METRICS_DEVICES
+#define I2C_METRICS_DEVICES (2)
+#endif
+
+/// Number of buckets of the histogram of the times on the bus
+#define I2C_METRICS_BUCKETS (8)
+
+/*!
+ * \brief Upper bound in microseconds of the first histogram bucket, every
+ *        next bucket doubles it and the last holds the longer transfers
+ *
+ * A register read of the MMA8451 falls in the first buckets, a full Oled
+ * frame at 375 kbps takes about 25 ms.
+ */
+#ifndef I2C_METRICS_BUCKET_US
+#define I2C_METRICS_BUCKET_US (125)
+#endif
+
+/// Run-time counter cycles in a microsecond
+#define I2C_METRICS_CYCLES_PER_US (rtsCLOCK_HZ / 1000000UL)
+
+/// Transfers of one slave address, times in rtsCLOCK_HZ cycles
+typedef struct
+{
+    uint8_t address;        ///< Slave address (write), 0 for a free slot
+    uint32_t transfers;     ///< Ended transfers, including the failed ones
+    uint32_t bytes;         ///< Bytes on the bus of the completed transfers
+    uint32_t nacks;         ///< Transfers not acknowledged by the slave
+    uint32_t arbitration;   ///< Transfers that lost arbitration
+    uint32_t timeouts;      ///< Transfers that timed out, also in the queue
+    uint32_t busy_max;      ///< Longest time on the bus
+    uint32_t wait_max;      ///< Longest time in the queue
+    uint64_t busy;          ///< Total time on the bus
+    uint64_t wait;          ///< Total time in the queue
+    uint16_t histogram[I2C_METRICS_BUCKETS]; ///< Times on the bus
+}
+i2c_device_stats_t;
+
+/// Metrics of a bus
+typedef struct
+{
+    uint64_t since;         ///< Run time of the last reset
+    uint64_t busy;          ///< Time on the bus of all addresses
+    uint32_t started;       ///< Run time the transfer on the bus started
+    i2c_device_stats_t devices[I2C_METRICS_DEVICES];
+}
+i2c_metrics_t;
+
+#endif // I2C_METRICS_H
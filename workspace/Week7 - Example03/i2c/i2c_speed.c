@@ -0,0 +1,133 @@
+/*! ***************************************************************************
+ *
+ * \brief     I2C bit rate calculation
+ * \file      i2c_speed.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "i2c_speed.h"
+
+/*!
+ * \brief SCL divider for every value of I2Cx_F[ICR]
+ *
+ * See the KL25 Sub-Family Reference Manual, table I2C divider and hold
+ * values.
+ */
+static const uint16_t scl_divider[64] =
+{
+      20,   22,   24,   26,   28,   30,   34,   40,
+      28,   32,   36,   40,   44,   48,   56,   68,
+      48,   56,   64,   72,   80,   88,  104,  128,
+      80,   96,  112,  128,  144,  160,  192,  240,
+     160,  192,  224,  256,  288,  320,  384,  480,
+     320,  384,  448,  512,  576,  640,  768,  960,
+     640,  768,  896, 1024, 1152, 1280, 1536, 1920,
+    1280, 1536, 1792, 2048, 2304, 2560, 3072, 3840,
+};
+
+/*!
+ * \brief Returns the current bus clock frequency in Hz
+ *
+ * Derived from SystemCoreClock and SIM_CLKDIV1[OUTDIV4].
+ */
+uint32_t i2c_speed_busclock(void)
+{
+    uint32_t outdiv4 = (SIM->CLKDIV1 & SIM_CLKDIV1_OUTDIV4_MASK) >>
+        SIM_CLKDIV1_OUTDIV4_SHIFT;
+
+    return SystemCoreClock / (outdiv4 + 1);
+}
+
+/*!
+ * \brief Calculates the I2Cx_F register value for a bit rate
+ *
+ * Searches all MULT and ICR combinations for the highest bit rate that does
+ * not exceed \p bps at the current bus clock:
+ *
+ * I2C baud rate = bus speed (Hz)/(mul * SCL divider)
+ *
+ * \param[in]  bps  Requested bit rate, for example one of i2c_speed_t
+ * \param[out] f    Value for the I2Cx_F register
+ *
+ * \return The achieved bit rate, or 0 if it is more than
+ *         I2C_SPEED_TOLERANCE_PCT below \p bps. \p f is not written then.
+ */
+uint32_t i2c_speed_calc(const uint32_t bps, uint8_t *f)
+{
+    const uint32_t bus = i2c_speed_busclock();
+    uint32_t best = 0;
+    uint8_t best_f = 0;
+
+    if(bps == 0)
+    {
+        return 0;
+    }
+
+    for(uint32_t mult=0; mult<3; ++mult)
+    {
+        for(uint32_t icr=0; icr<64; ++icr)
+        {
+            uint32_t rate = bus / ((1UL << mult) * scl_divider[icr]);
+
+            if((rate <= bps) && (rate > best))
+            {
+                best = rate;
+                best_f = I2C_F_MULT(mult) | I2C_F_ICR(icr);
+            }
+        }
+    }
+
+    if(best < (bps / 100) * (100 - I2C_SPEED_TOLERANCE_PCT))
+    {
+        return 0;
+    }
+
+    *f = best_f;
+
+    return best;
+}
+
+/*!
+ * \brief Returns the bit rate of an I2Cx_F register value at the current bus
+ *        clock
+ *
+ * \param[in]  f  Value of the I2Cx_F register
+ *
+ * \return The bit rate in bps
+ */
+uint32_t i2c_speed_rate(const uint8_t f)
+{
+    const uint32_t mult = (f & I2C_F_MULT_MASK) >> I2C_F_MULT_SHIFT;
+    const uint32_t icr = (f & I2C_F_ICR_MASK) >> I2C_F_ICR_SHIFT;
+
+    // MULT 3 is reserved
+    if(mult > 2)
+    {
+        return 0;
+    }
+
+    return i2c_speed_busclock() / ((1UL << mult) * scl_divider[icr]);
+}
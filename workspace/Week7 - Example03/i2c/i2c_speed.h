@@ -0,0 +1,57 @@
+/*! ***************************************************************************
+ *
+ * \brief     I2C bit rate calculation
+ * \file      i2c_speed.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef I2C_SPEED_H
+#define I2C_SPEED_H
+
+#include <MKL25Z4.h>
+
+/// Bus speed profiles in bps
+typedef enum
+{
+    I2C_STANDARD  = 100000,  ///< Standard-mode
+    I2C_FAST      = 400000,  ///< Fast-mode
+    I2C_FAST_PLUS = 1000000, ///< Fast-mode Plus
+}
+i2c_speed_t;
+
+/*!
+ * \brief Maximum deviation in percent of the achieved bit rate below the
+ *        requested bit rate
+ *
+ * The achieved bit rate is never higher than requested.
+ */
+#define I2C_SPEED_TOLERANCE_PCT (10)
+
+uint32_t i2c_speed_busclock(void);
+uint32_t i2c_speed_calc(const uint32_t bps, uint8_t *f);
+uint32_t i2c_speed_rate(const uint8_t f);
+
+#endif // I2C_SPEED_H
@@ -0,0 +1,336 @@
+/*! ***************************************************************************
+ *
+ * \brief     Background jobs in the idle task
+ * \file      idle.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "idle.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "mono.h"
+#include "serial.h"
+#include "xprintf.h"
+
+/*
+ * Work that is not urgent, such as sampling statistics or preparing data
+ * that is needed later, runs in the idle task instead of a task of its own.
+ * It then needs no stack and no priority, and it only takes the time that
+ * no task wants: the idle task runs when all tasks are blocked and is
+ * preempted as soon as one of them is ready.
+ *
+ * A job runs in steps. vApplicationIdleHook() runs one step of the oldest
+ * queued job each time it is called, and a job with more steps goes to
+ * the back of the queue, so long jobs take turns. A step must not block,
+ * the idle task must always be able to run, and should be shorter than
+ * IDLE_BUDGET_US: a task at the idle priority waits for it, and so does
+ * the next sleep. The steps share the stack of the idle task,
+ * configMINIMAL_STACK_SIZE words.
+ *
+ * The tickless idle does not sleep while a job is queued, see
+ * configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING() in idle.h, and sleeps as
+ * before once the queue is empty. A job submitted by an interrupt between
+ * that check and the sleep runs when the sleep ends.
+ *
+ * The time in the steps counts as idle time in the run-time statistics and
+ * the load meter, the report shows how much of it was used by the jobs.
+ */
+
+#define IDLE_LINE_LEN       (64)
+
+#define IDLE_BLOCK_TIME     pdMS_TO_TICKS(100)
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+static idle_job_t *head = NULL;
+static idle_job_t *tail = NULL;
+
+// All jobs that were ever submitted, newest first
+static idle_job_t *jobs = NULL;
+
+// Time in all steps
+static uint32_t busy_us = 0;
+
+// Calls of the hook, see idle_loops()
+static volatile uint32_t loops = 0;
+
+/*----------------------------------------------------------------------------*/
+// Local function prototypes
+/*----------------------------------------------------------------------------*/
+static void idle_append(idle_job_t *job);
+static bool idle_enqueue(idle_job_t *job);
+
+/*----------------------------------------------------------------------------*/
+// Local functions
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Puts a job at the back of the queue, in a critical section
+ */
+static void idle_append(idle_job_t *job)
+{
+    job->next = NULL;
+
+    if(tail == NULL)
+    {
+        head = job;
+    }
+    else
+    {
+        tail->next = job;
+    }
+
+    tail = job;
+}
+
+/*!
+ * \brief Queues a job, in a critical section
+ *
+ * \return False if the job was already queued
+ */
+static bool idle_enqueue(idle_job_t *job)
+{
+    if(job->pending)
+    {
+        job->coalesced++;
+
+        // A run that started may have passed what the submission is about
+        if(job->started)
+        {
+            job->again = true;
+        }
+
+        return false;
+    }
+
+    if(!job->listed)
+    {
+        job->listed = true;
+        job->link = jobs;
+        jobs = job;
+    }
+
+    job->pending = true;
+    job->again = false;
+    job->started = false;
+    idle_append(job);
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+// Public functions
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Runs a step of the oldest queued job, FreeRTOS idle hook
+ *
+ * Called by the idle task every time it loops, see configUSE_IDLE_HOOK.
+ */
+void vApplicationIdleHook(void)
+{
+    idle_job_t *job;
+
+    loops++;
+
+    taskENTER_CRITICAL();
+    {
+        job = head;
+
+        if(job != NULL)
+        {
+            head = job->next;
+
+            if(head == NULL)
+            {
+                tail = NULL;
+            }
+
+            job->started = true;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if(job == NULL)
+    {
+        return;
+    }
+
+    const uint32_t start = mono_us32();
+    const bool more = job->fn(job->arg);
+    const uint32_t step = mono_us32() - start;
+
+    taskENTER_CRITICAL();
+    {
+        busy_us += step;
+        job->steps++;
+
+        if(step > job->max_step_us)
+        {
+            job->max_step_us = step;
+        }
+
+        if(step > IDLE_BUDGET_US)
+        {
+            job->overruns++;
+        }
+
+        if(more)
+        {
+            idle_append(job);
+        }
+        else
+        {
+            job->runs++;
+            job->started = false;
+
+            if(job->again)
+            {
+                job->again = false;
+                idle_append(job);
+            }
+            else
+            {
+                job->pending = false;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Returns the number of times the idle task looped
+ *
+ * Wraps around. A count that does not change for a long time means that
+ * the tasks never block, so the idle task does not run. Can be called from
+ * an interrupt.
+ */
+uint32_t idle_loops(void)
+{
+    return loops;
+}
+
+/*!
+ * \brief Queues a job to the idle task
+ *
+ * May be called before the scheduler is started, the job runs when the
+ * idle task first runs.
+ *
+ * \param[in,out]  job  The job, which must remain valid until it is done
+ *
+ * \return False if the job was already queued, the submission is
+ *         coalesced with it
+ */
+bool idle_submit(idle_job_t *job)
+{
+    bool queued;
+
+    taskENTER_CRITICAL();
+    {
+        queued = idle_enqueue(job);
+    }
+    taskEXIT_CRITICAL();
+
+    return queued;
+}
+
+/*!
+ * \brief Queues a job to the idle task, from an interrupt handler
+ *
+ * No task needs to be switched in, the job runs when the idle task does.
+ *
+ * \param[in,out]  job  The job, which must remain valid until it is done
+ *
+ * \return False if the job was already queued, the submission is
+ *         coalesced with it
+ */
+bool idle_submit_from_isr(idle_job_t *job)
+{
+    bool queued;
+
+    const UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    {
+        queued = idle_enqueue(job);
+    }
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+
+    return queued;
+}
+
+/*!
+ * \brief Checks if a job is queued
+ *
+ * Called by the idle task before the tickless idle, with the scheduler
+ * suspended.
+ */
+bool idle_pending(void)
+{
+    return head != NULL;
+}
+
+/*!
+ * \brief Writes the statistics of the idle jobs
+ */
+void idle_report(void)
+{
+    char line[IDLE_LINE_LEN];
+    idle_job_t job;
+    uint32_t busy;
+
+    taskENTER_CRITICAL();
+    {
+        busy = busy_us;
+    }
+    taskEXIT_CRITICAL();
+
+    xsnprintf(line, IDLE_LINE_LEN, "\r\nIdle jobs, %lu ms, budget %u us\r\n",
+        (unsigned long)(busy / 1000U), (unsigned int)IDLE_BUDGET_US);
+    xSerialPutStringPolicy(line, eSerialBlock, IDLE_BLOCK_TIME);
+
+    xsnprintf(line, IDLE_LINE_LEN, "%-*s %7s %7s %7s %7s %5s\r\n",
+        configMAX_TASK_NAME_LEN, "Job", "Runs", "Steps", "Merged", "Max us", "Over");
+    xSerialPutStringPolicy(line, eSerialBlock, IDLE_BLOCK_TIME);
+
+    // Jobs are only added at the front, so the list from here is stable
+    for(const idle_job_t *j = jobs; j != NULL; j = j->link)
+    {
+        taskENTER_CRITICAL();
+        {
+            job = *j;
+        }
+        taskEXIT_CRITICAL();
+
+        xsnprintf(line, IDLE_LINE_LEN, "%-*.*s %7lu %7lu %7lu %7lu %5lu\r\n",
+            configMAX_TASK_NAME_LEN, configMAX_TASK_NAME_LEN, job.name,
+            (unsigned long)job.runs, (unsigned long)job.steps,
+            (unsigned long)job.coalesced, (unsigned long)job.max_step_us,
+            (unsigned long)job.overruns);
+        xSerialPutStringPolicy(line, eSerialBlock, IDLE_BLOCK_TIME);
+    }
+}
@@ -0,0 +1,110 @@
+/*! ***************************************************************************
+ *
+ * \brief     Background jobs in the idle task
+ * \file      idle.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef IDLE_H
+#define IDLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// \name Definitions for the idle jobs
+/// \{
+
+/*!
+ * \brief Longest step of a job in us, a longer step is counted as an
+ *        overrun
+ *
+ * A step delays the tasks at the idle priority and the next sleep, but not
+ * the other tasks, which preempt it.
+ */
+#ifndef IDLE_BUDGET_US
+#define IDLE_BUDGET_US      (500)
+#endif
+
+/// \}
+
+/*!
+ * \brief A step of an idle job
+ *
+ * Runs in the idle task, so it must never block: no delays, no waits with a
+ * block time and no blocking writes to the serial port. It keeps its
+ * progress in the argument and does a part of the work that takes less
+ * than IDLE_BUDGET_US.
+ *
+ * \return True if the job has more steps, false when it is done
+ */
+typedef bool (*idle_fn_t)(void *arg);
+
+/*!
+ * \brief An idle job
+ *
+ * Statically allocated and initialised with IDLE_JOB(). A job is queued
+ * from its submission until its last step. A submission in that time is
+ * coalesced, the job is run once more from the start after its last step.
+ */
+typedef struct idle_job
+{
+    idle_fn_t fn;
+    void *arg;
+    const char *name;
+
+    // Managed by the runner
+    volatile bool pending;
+    volatile bool again;
+    uint32_t runs;              ///< Completed runs
+    uint32_t steps;             ///< Steps of all runs
+    uint32_t coalesced;         ///< Submissions while queued
+    uint32_t max_step_us;       ///< Longest step
+    uint32_t overruns;          ///< Steps over IDLE_BUDGET_US
+    bool started;
+    bool listed;
+    struct idle_job *next;
+    struct idle_job *link;      ///< All submitted jobs, for the report
+}
+idle_job_t;
+
+/*!
+ * \brief Initialiser of an idle job
+ */
+#define IDLE_JOB(f, a, n) {.fn = (f), .arg = (a), .name = (n)}
+
+// Function prototypes
+bool idle_submit(idle_job_t *job);
+bool idle_submit_from_isr(idle_job_t *job);
+bool idle_pending(void);
+uint32_t idle_loops(void);
+void idle_report(void);
+
+// FreeRTOS hook, expanded in the idle task before the tickless idle. The
+// MCU does not sleep while jobs are queued.
+#define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING(x) \
+    do { if(idle_pending()) { (x) = 0; } } while(0)
+
+#endif // IDLE_H
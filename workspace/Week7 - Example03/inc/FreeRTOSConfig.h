@@ -30,7 +30,9 @@
 #define FREERTOS_CONFIG_H
 
 #include "MKL25Z4.h"
+#include "mem.h"
 #include "runtime_stats.h"
+#include "sections.h"
 
 /* Prevent C code being included by the IAR assembler. */
 #ifndef __IASMARM__
@@ -39,53 +41,136 @@
 #endif
 
 #define configUSE_PREEMPTION			         1
+/* Ready priority bit map of the ARM_CM0 port, the cost of selecting the next
+ * task does not depend on configMAX_PRIORITIES */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+#endif
+/* PendSV handler of the ARM_CM0 port that selects the next task first and skips
+ * saving and restoring r4-r11 when the running task is selected again. Compare
+ * both handlers with bench/kernel_bench.c */
+#ifndef configUSE_PORT_FAST_PENDSV
+#define configUSE_PORT_FAST_PENDSV               1
+#endif
+/* Queue items of 1, 2 and 4 bytes are copied with a single load and store
+ * instead of memcpy(), compare with bench/kernel_bench.c */
+#ifndef configQUEUE_SMALL_ITEM_COPY
+#define configQUEUE_SMALL_ITEM_COPY              1
+#endif
+/* Delayed tasks in a timing wheel of unsorted lists, blocking with a timeout
+ * takes constant time instead of a sorted insertion */
+#ifndef configUSE_DELAYED_WHEEL
+#define configUSE_DELAYED_WHEEL                  1
+#endif
+/* Active software timers in a timing wheel as well, starting and stopping a
+ * timer takes constant time and does not go through the timer queue */
+#ifndef configUSE_TIMER_WHEEL
+#define configUSE_TIMER_WHEEL                    1
+#endif
+/* Stream and message buffers that are written and read in place, with
+ * reserve/commit and acquire/release instead of a copy */
+#define configUSE_STREAM_BUFFER_SPANS            1
+/* Larger queue items, stream buffer data and new stacks are copied and
+ * filled four words at a time, see mem.c */
+#define configMEMCPY( pvDest, pvSource, xSize )  mem_copy( ( pvDest ), ( pvSource ), ( xSize ) )
+#define configMEMSET( pvDest, iValue, xSize )    mem_set( ( pvDest ), ( iValue ), ( xSize ) )
 #define configUSE_TIME_SLICING			         1
-#define configUSE_IDLE_HOOK				         0
+/* Time slices of 10 ticks at the background priorities 0 and 1, where tasks
+ * such as the work queue and the log do CPU-bound work, and of 1 tick above */
+#ifndef configUSE_TIME_SLICE_QUANTUM
+#define configUSE_TIME_SLICE_QUANTUM             1
+#endif
+#define configTIME_SLICE_TICKS( uxPriority )     ( ( ( uxPriority ) <= 1U ) ? ( TickType_t ) 10 : ( TickType_t ) 1 )
+/* Runs the background jobs of idle/idle.c */
+#define configUSE_IDLE_HOOK				         1
 #define configUSE_TICK_HOOK				         0
 #define configCPU_CLOCK_HZ				         ( SystemCoreClock )
 #define configTICK_RATE_HZ				         ( ( TickType_t ) 1000 )
+#ifndef configMAX_PRIORITIES
 #define configMAX_PRIORITIES			         5
+#endif
 #define configMAX_TASK_NAME_LEN			         12
 #define configUSE_TRACE_FACILITY		         1
 #define configUSE_16_BIT_TICKS			         0
 #define configIDLE_SHOULD_YIELD			         1
 #define configUSE_MUTEXES				         1
 #define configQUEUE_REGISTRY_SIZE		         8
-#define configCHECK_FOR_STACK_OVERFLOW	         0
+/* Stack overflow check at every context switch, 1 compares the stack pointer
+to the stack limit, 2 also checks the last 16 bytes of the stack, 3 checks only
+the lowest word, a canary that costs a load and a compare. With 3 the stack
+monitor of taskstats.c finds the rest from the high water marks in the idle
+time. Calls vApplicationStackOverflowHook() in taskstats.c. */
+#ifndef configCHECK_FOR_STACK_OVERFLOW
+#define configCHECK_FOR_STACK_OVERFLOW	         3
+#endif
 #define configUSE_RECURSIVE_MUTEXES		         1
 #define configUSE_MALLOC_FAILED_HOOK	         0
 #define configUSE_APPLICATION_TASK_TAG	         0
 #define configUSE_COUNTING_SEMAPHORES	         1
+/* Queue sets for the mux component, one consumer blocks on several sources */
+#define configUSE_QUEUE_SETS                     1
 #define configUSE_TASK_NOTIFICATIONS             1
+/* One index per mechanism that blocks a task on a notification, see the
+ * *_NOTIFY_INDEX defines. Index 8 is the event flags, 9 the DMA channel
+ * manager and 10 the barriers. */
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES    11
 
 /* For generating runtime statistics */
 #define configGENERATE_RUN_TIME_STATS	         1
-#define configUSE_STATS_FORMATTING_FUNCTIONS     1
+/* vTaskList() and vTaskGetRunTimeStats() allocate, see taskstats.h for the
+ * reports that do not */
+#define configUSE_STATS_FORMATTING_FUNCTIONS     configSUPPORT_DYNAMIC_ALLOCATION
 
-extern volatile uint32_t ulHighFrequencyTicks;
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vConfigureTimerForRunTimeStats()
+#if rtsFREE_RUNNING
+#define configRUN_TIME_COUNTER_TYPE              uint64_t
+#define portGET_RUN_TIME_COUNTER_VALUE()         ullRunTimeCounterValue()
+#else
 #define portGET_RUN_TIME_COUNTER_VALUE()         ulHighFrequencyTicks
+#endif
 
 #define configRECORD_STACK_HIGH_ADDRESS          1
 
-/* Support various memory allocation. */
-#define configSUPPORT_STATIC_ALLOCATION          0
+/* Support various memory allocation.
+ * All tasks, queues, semaphores and stream buffers of the drivers and the
+ * example are created from static buffers, so their RAM is in .bss and
+ * known at link time. Define configSUPPORT_DYNAMIC_ALLOCATION as 0 (cmake
+ * -DSTATIC_ONLY=ON) to also leave the heap out of the build.
+ */
+#define configSUPPORT_STATIC_ALLOCATION          1
+#ifndef configSUPPORT_DYNAMIC_ALLOCATION
 #define configSUPPORT_DYNAMIC_ALLOCATION         1
+#endif
 
 /* Heap and stack.
  * The bytes specified in configTOTAL_HEAP_SIZE need to fit in to
  * the first memory bank, which is of size 16kB in total. This 16kB
  * consists of FreeRTOS heap, linker heap and also .bss etc. Thus
- * FreeRTOS heap cannot take the entire 16kB.
+ * FreeRTOS heap cannot take the entire 16kB. Nothing is allocated from the
+ * heap by the example, it is left for experiments with dynamic objects.
+ *
+ * With heap_5 (cmake -DHEAP=heap_5) configHEAP_REGIONS is set and the heap
+ * is all the RAM left in SRAM_L and SRAM_U after .data, .bss and the
+ * stacks, as found by the linker script. configTOTAL_HEAP_SIZE is then not
+ * used, see startup/kernel_memory.c.
  */
 #define configMINIMAL_STACK_SIZE		         ( ( unsigned short ) 192 )
-#define configTOTAL_HEAP_SIZE			         (  ( size_t ) ( 10 * 1024 ) )
+#ifndef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE			         (  ( size_t ) ( 1 * 1024 ) )
+#endif
+/* ucHeap is defined in startup/kernel_memory.c, outside the zeroed .bss */
+#define configAPPLICATION_ALLOCATED_HEAP         1
+#ifndef configHEAP_REGIONS
+#define configHEAP_REGIONS                       0
+#endif
 
 /* Software timer definitions. */
 #define configUSE_TIMERS				         1
 #define configTIMER_TASK_PRIORITY		         2
 #define configTIMER_QUEUE_LENGTH		         5
+#ifndef configTIMER_TASK_STACK_DEPTH
 #define configTIMER_TASK_STACK_DEPTH	         ( configMINIMAL_STACK_SIZE )
+#endif
 
 /* Enabling tickless. */
 #define configUSE_TICKLESS_IDLE			         1
@@ -100,10 +185,15 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil			         1
 #define INCLUDE_vTaskDelay				         1
 #define INCLUDE_eTaskGetState			         1
+#define INCLUDE_xTaskGetSchedulerState	         1
+#define INCLUDE_xTaskGetIdleTaskHandle	         1
+#define INCLUDE_uxTaskGetStackHighWaterMark      1
+#define INCLUDE_xTimerPendFunctionCall           1
 
 /* Normal assert() semantics without relying on the provision of an assert.h
-header file. */
-#define configASSERT( x )                        if( ( x ) == 0 ) { taskDISABLE_INTERRUPTS(); for( ;; ); }
+header file. A failed assertion stops the MTB capture, so the branches that
+led to it are kept. With CRASH_ENABLED it is recorded and the MCU resets. */
+#define configASSERT( x )                        if( ( x ) == 0 ) { mtb_stop(); crash_assert( __FILE__, __LINE__ ); taskDISABLE_INTERRUPTS(); for( ;; ); }
 
 /* Definitions that map the FreeRTOS port interrupt handlers to their CMSIS
 standard names - or at least those used in the unmodified vector table. */
@@ -111,4 +201,16 @@ standard names - or at least those used in the unmodified vector table. */
 #define xPortPendSVHandler                       PendSV_Handler
 #define xPortSysTickHandler                      SysTick_Handler
 
+/* Trace hooks of the kernel trace recorder and the stack and heap monitor,
+and the tickless idle of the low power library, the MTB capture stopped by
+configASSERT(), the crash capture, the masked section hooks of the port, and
+the check of the idle jobs before a sleep. */
+#include "crash.h"
+#include "critmon.h"
+#include "mtb.h"
+#include "trace.h"
+#include "taskstats.h"
+#include "lowpower.h"
+#include "idle.h"
+
 #endif /* FREERTOS_CONFIG_H */
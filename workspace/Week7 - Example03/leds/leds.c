@@ -30,6 +30,32 @@
  *
  *****************************************************************************/
 #include "leds.h"
+#include "idle.h"
+#include "timer.h"
+
+/*
+ * The heartbeat runs on a one-shot timer of timer.c, restarted by its
+ * callback in TPM1_IRQHandler() at every step of the pattern. PTD4 has no
+ * channel of TPM1, and TPM0_CH4 counts the PWM period of the RGB LED, far
+ * shorter than a heartbeat, so the pin stays a GPIO. A step costs one
+ * short interrupt and no task.
+ */
+
+/// The blink of the demos
+const uint16_t led_heartbeat_default[LED_HEARTBEAT_DEFAULT_STEPS] = {10, 4990};
+
+static void led_heartbeat_step(void *arg, BaseType_t *woken);
+
+static tim_timer_t heartbeat = TIM_TIMER(led_heartbeat_step, NULL);
+
+// Pattern of led_heartbeat_start()
+static const uint16_t *pattern = NULL;
+static uint32_t pattern_steps = 0;
+static uint32_t step = 0;
+static bool gate = false;
+
+// Idle loops at the start of the previous cycle of a gated heartbeat
+static uint32_t loops = 0;
 
 /*!
  * \brief Initialises the LEDs on the shield
@@ -52,38 +78,101 @@ void led_init(void)
     PORTD->PCR[4] = PORT_PCR_MUX(1);
     
     // Set port pin to outputs
-    PTD->PDDR |= (1<<4);
+    gpio_output(LED_GPIO, LED_MASK);
 
     // Turn off the LED
-    PTD->PCOR = (1<<4);
+    led_off();
 }
 
 /*!
- * \brief Turns on the LED
+ * \brief Takes the next step of the heartbeat pattern
  *
- * This functions switches on the LED.
+ * Called from TPM1_IRQHandler(). A gated heartbeat stays off for a cycle
+ * in which the idle task did not run.
  */
-inline void led_on(void)
+static void led_heartbeat_step(void *arg, BaseType_t *woken)
 {
-    PTD->PSOR = (1<<4);
+    (void)arg;
+    (void)woken;
+
+    if(step == 0)
+    {
+        const uint32_t now = idle_loops();
+        const bool alive = !gate || (now != loops);
+
+        loops = now;
+
+        if(!alive)
+        {
+            uint32_t cycle_ms = 0;
+
+            for(uint32_t i=0; i<pattern_steps; ++i)
+            {
+                cycle_ms += pattern[i];
+            }
+
+            led_off();
+            tim_start(&heartbeat, cycle_ms * 1000, 0);
+            return;
+        }
+    }
+
+    // Even steps are on, odd steps are off
+    if((step & 1) == 0)
+    {
+        led_on();
+    }
+    else
+    {
+        led_off();
+    }
+
+    tim_start(&heartbeat, pattern[step] * 1000UL, 0);
+
+    step = (step + 1) % pattern_steps;
 }
 
 /*!
- * \brief Turns off the LED
+ * \brief Blinks the LED in a pattern, without a task
+ *
+ * The pattern holds the durations in ms of the steps, alternately on and
+ * off, starting with on. It repeats until led_heartbeat_stop(), and must
+ * remain valid until then. With \p gated the LED stays off for any cycle
+ * in which the idle task did not loop since the previous cycle, so a
+ * heartbeat that stops shows a kernel that is stuck or starved. Requires
+ * tim_init() and led_init().
  *
- * This functions switches off the LED.
+ * \param[in]  pattern_ms  Durations of the steps in ms, each at least 1
+ * \param[in]  steps       Number of steps, an odd number ends a cycle on
+ * \param[in]  gated       Stop blinking while the idle task does not run
  */
-inline void led_off(void)
+void led_heartbeat_start(const uint16_t pattern_ms[], const uint32_t steps,
+    const bool gated)
 {
-    PTD->PCOR = (1<<4);
+    led_heartbeat_stop();
+
+    if((pattern_ms == NULL) || (steps == 0))
+    {
+        return;
+    }
+
+    pattern = pattern_ms;
+    pattern_steps = steps;
+    step = 0;
+    gate = gated;
+
+    // The first cycle is not gated
+    loops = idle_loops() - 1;
+
+    tim_start(&heartbeat, TIM_MIN_PERIOD_US, 0);
 }
 
 /*!
- * \brief Toggles the LED
- *
- * This functions toggles the LED.
+ * \brief Stops the heartbeat and turns off the LED
  */
-inline void led_toggle(void)
+void led_heartbeat_stop(void)
 {
-    PTD->PTOR = (1<<4);
+    tim_stop(&heartbeat);
+
+    led_off();
 }
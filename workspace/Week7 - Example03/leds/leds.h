@@ -34,10 +34,56 @@
 
 #include <MKL25Z4.h>
 
+#include <stdbool.h>
+
+#include "gpio.h"
+
+/// Port and pin of the LED on the shield, PTD4
+#define LED_GPIO  GPIO_D
+#define LED_MASK  (1UL << 4)
+
+/*!
+ * \brief The blink of the demos: on for 10 ms every 5 s, see
+ *        led_heartbeat_start()
+ */
+#define LED_HEARTBEAT_DEFAULT_STEPS (2)
+extern const uint16_t led_heartbeat_default[LED_HEARTBEAT_DEFAULT_STEPS];
+
 // Function prototypes
 void led_init(void);
-void led_on(void);
-void led_off(void);
-void led_toggle(void);
+
+void led_heartbeat_start(const uint16_t pattern_ms[], const uint32_t steps,
+    const bool gated);
+void led_heartbeat_stop(void);
+
+/*!
+ * \brief Turns on the LED
+ *
+ * This functions switches on the LED.
+ */
+static inline void led_on(void)
+{
+    gpio_set(LED_GPIO, LED_MASK);
+}
+
+/*!
+ * \brief Turns off the LED
+ *
+ * This functions switches off the LED.
+ */
+static inline void led_off(void)
+{
+    gpio_clear(LED_GPIO, LED_MASK);
+}
+
+/*!
+ * \brief Toggles the LED
+ *
+ * This functions toggles the LED.
+ */
+static inline void led_toggle(void)
+{
+    gpio_toggle(LED_GPIO, LED_MASK);
+}
 
 #endif // LEDS_H
@@ -0,0 +1,758 @@
+/*! ***************************************************************************
+ *
+ * \brief     Time synchronised link between boards
+ * \file      link.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#define LOG_MODULE  LINK
+#define LOG_TAG     "Link: "
+
+#include <string.h>
+
+#include "link.h"
+#include "log.h"
+#include "mono.h"
+#include "pool.h"
+#include "scratch.h"
+#include "sections.h"
+#include "task.h"
+#include "xprintf.h"
+
+/*
+ * The boards form a chain. The gateway is node 0 and keeps the time of the
+ * link, its own mono_us(). Every other node has a port towards the gateway
+ * and optionally one towards the next node.
+ *
+ * A node estimates the offset of the link time to its own mono_us() with
+ * an exchange as in NTP. Every LINK_SYNC_PERIOD_MS it sends t1, its own
+ * time. The other end stamps the link time t2 when the request arrived and
+ * t3 just before it sends the response, which arrives at t4. Then
+ *
+ *   offset = ((t2 - t1) + (t3 - t4)) / 2
+ *   delay  = (t4 - t1) - (t3 - t2)
+ *
+ * The time on the wire is the same in both directions and cancels out.
+ * The packets are stamped in the task, when the bytes are read from the
+ * receive ring. The latency of that is not symmetric, so of the last
+ * LINK_SYNC_FILTER exchanges the one with the shortest delay is used, it
+ * was delayed least. Crystals differ by tens of ppm, which is tens of us
+ * per second, so the rate difference is measured over LINK_SKEW_SPAN_MS
+ * and the offset is extrapolated with it between exchanges.
+ *
+ * A node in the middle of the chain answers the node after it with its own
+ * link time, so the time of the gateway is passed down the chain.
+ *
+ * Telemetry of a node is redirected to the link, see tlm_redirect(). A
+ * record is stamped with the link time and forwarded up the chain. The
+ * gateway writes it to its own telemetry port as TLM_NODE, so the records
+ * of all boards are on one time base.
+ */
+
+// Packet during encoding and decoding: header, body, payload and CRC
+#define LINK_RAW_MAX     (sizeof(link_header_t) + sizeof(link_tlm_t) + \
+                          LINK_TLM_MAX_PAYLOAD + 2)
+
+// COBS encoded packet with the delimiter, shorter than 254 bytes
+#define LINK_FRAME_MAX   (LINK_RAW_MAX + 2)
+
+// Number of packet buffers, the number of tasks that can send at once
+#define LINK_BUFFERS     (3)
+
+// Stack size in words of the link tasks
+#define LINK_STACK_DEPTH (configMINIMAL_STACK_SIZE + 64)
+
+// Time a packet may wait for room in the transmit buffer
+#define LINK_BLOCK_TIME  pdMS_TO_TICKS(20)
+
+// Longest line written to the serial port, including the terminator
+#define LINK_LINE_LEN    (64)
+
+// Bytes read from the receive ring at once
+#define LINK_CHUNK       (16)
+
+// A port of the link and its receive state
+typedef struct
+{
+    xComPortHandle port;
+    uint8_t chunk[LINK_CHUNK];
+    uint32_t chunk_n;
+    uint32_t chunk_pos;
+    uint64_t chunk_us;      // mono_us() when the chunk was read
+    uint8_t frame[LINK_FRAME_MAX];
+    uint32_t frame_n;
+    bool overrun;
+    uint8_t raw[LINK_FRAME_MAX];
+}
+link_port_t;
+
+// An exchange of the time synchronisation
+typedef struct
+{
+    int64_t offset;
+    uint32_t delay;
+    uint64_t at;            // mono_us() of the response
+}
+link_sample_t;
+
+// Buffers for encoding a packet, not on the stacks of the tasks that send
+// telemetry
+typedef struct
+{
+    uint8_t raw[LINK_RAW_MAX];
+    uint8_t frame[LINK_FRAME_MAX];
+}
+link_buffer_t;
+
+static POOL_STORAGE(link_buffer_storage, sizeof(link_buffer_t), LINK_BUFFERS);
+static pool_t link_buffers;
+
+static link_port_t up;
+static link_port_t down;
+
+static uint16_t link_seq = 0;
+
+// The last exchanges, written by the up task
+static link_sample_t samples[LINK_SYNC_FILTER];
+static uint32_t samples_n = 0;
+static uint32_t samples_next = 0;
+
+// Reference of the skew measurement
+static link_sample_t skew_ref;
+static bool skew_valid = false;
+static bool skew_measured = false;
+
+// Estimate of the link time, read with interrupts masked
+static link_sample_t estimate;
+static int32_t skew_ppb = 0;
+static bool estimated = false;
+static uint32_t synced_ms = 0;
+
+static link_stats_t stats;
+
+static StaticTask_t up_tcb;
+__BSS_NOCLEAR static StackType_t up_stack[LINK_STACK_DEPTH];
+static StaticTask_t down_tcb;
+__BSS_NOCLEAR static StackType_t down_stack[LINK_STACK_DEPTH];
+
+static void vLinkUpTask(void *pvParameters);
+static void vLinkDownTask(void *pvParameters);
+static bool link_tlm_sink(const tlm_type_t type, const void *payload,
+    const uint8_t len);
+
+/*!
+ * \brief Adds one to a counter of the statistics
+ */
+static void link_count(uint32_t *counter)
+{
+    taskENTER_CRITICAL();
+    {
+        (*counter)++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Converts a time of mono_us() to the link time
+ */
+static uint64_t link_time_at(const uint64_t mono)
+{
+    link_sample_t e;
+    int32_t skew;
+    bool valid;
+
+    if(up.port == NULL)
+    {
+        return mono;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        e = estimate;
+        skew = skew_ppb;
+        valid = estimated;
+    }
+    taskEXIT_CRITICAL();
+
+    if(!valid)
+    {
+        return mono;
+    }
+
+    const int64_t since = (int64_t)(mono - e.at);
+
+    return (uint64_t)((int64_t)mono + e.offset + ((since * skew) / 1000000000));
+}
+
+/*!
+ * \brief Writes a packet to a port
+ *
+ * \param[in]  p     The port
+ * \param[in]  raw   Header and body of the packet
+ * \param[in]  n     Number of bytes in raw, at most LINK_RAW_MAX - 2
+ *
+ * \return false if no buffer was free or the packet was not completely
+ *         written
+ */
+static bool link_write(link_port_t *p, const void *raw, const uint32_t n)
+{
+    link_buffer_t *buf = pool_alloc(&link_buffers);
+
+    if(buf == NULL)
+    {
+        link_count(&stats.dropped);
+        return false;
+    }
+
+    memcpy(buf->raw, raw, n);
+
+    const uint16_t crc = tlm_crc16(buf->raw, n);
+    buf->raw[n] = (uint8_t)(crc & 0xFF);
+    buf->raw[n + 1] = (uint8_t)(crc >> 8);
+
+    const uint32_t len = tlm_cobs_encode(buf->raw, n + 2, buf->frame);
+    const bool ret = (xSerialPortWrite(p->port, buf->frame, len) == len);
+
+    pool_free(&link_buffers, buf);
+
+    link_count(ret ? &stats.tx : &stats.dropped);
+
+    return ret;
+}
+
+/*!
+ * \brief Fills in the header of a packet of this node
+ */
+static void link_header(link_header_t *h, const link_type_t type)
+{
+    h->type = (uint8_t)type;
+    h->node = LINK_NODE;
+
+    taskENTER_CRITICAL();
+    {
+        h->seq = link_seq++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Returns the next valid packet of a port
+ *
+ * \param[in]  p        The port, the packet is in p->raw without its CRC
+ * \param[in]  timeout  Time to wait for every chunk of bytes
+ * \param[out] at       mono_us() when the end of the packet was read
+ *
+ * \return Length of the packet, 0 on a timeout
+ */
+static uint32_t link_receive(link_port_t *p, const TickType_t timeout,
+    uint64_t *at)
+{
+    for( ;; )
+    {
+        if(p->chunk_pos == p->chunk_n)
+        {
+            p->chunk_n = xSerialPortRead(p->port, p->chunk, LINK_CHUNK, timeout);
+            p->chunk_us = mono_us();
+            p->chunk_pos = 0;
+
+            if(p->chunk_n == 0)
+            {
+                return 0;
+            }
+        }
+
+        const uint8_t c = p->chunk[p->chunk_pos++];
+
+        if(c != 0)
+        {
+            if(p->frame_n < LINK_FRAME_MAX)
+            {
+                p->frame[p->frame_n++] = c;
+            }
+            else
+            {
+                p->overrun = true;
+            }
+
+            continue;
+        }
+
+        // The delimiter, an empty frame resynchronises the receiver
+        const uint32_t n = p->frame_n;
+        const bool overrun = p->overrun;
+
+        p->frame_n = 0;
+        p->overrun = false;
+
+        if(n == 0)
+        {
+            continue;
+        }
+
+        const uint32_t len = overrun ? 0 : tlm_cobs_decode(p->frame, n, p->raw);
+
+        if((len < (sizeof(link_header_t) + 2)) ||
+           (tlm_crc16(p->raw, len - 2) !=
+            (uint16_t)(p->raw[len - 2] | (p->raw[len - 1] << 8))))
+        {
+            link_count(&stats.errors);
+            continue;
+        }
+
+        link_count(&stats.rx);
+        *at = p->chunk_us;
+
+        return len - 2;
+    }
+}
+
+/*!
+ * \brief Adds an exchange to the estimate of the link time
+ */
+static void link_sync(const link_sync_t *s, const uint64_t t4)
+{
+    const int64_t up_us = (int64_t)(s->t2 - s->t1);
+    const int64_t down_us = (int64_t)(s->t3 - t4);
+    const int64_t delay = (int64_t)(t4 - s->t1) - (int64_t)(s->t3 - s->t2);
+
+    samples[samples_next].offset = (up_us + down_us) / 2;
+    samples[samples_next].delay = (delay > 0) ? (uint32_t)delay : 0;
+    samples[samples_next].at = t4;
+
+    samples_next = (samples_next + 1) % LINK_SYNC_FILTER;
+
+    if(samples_n < LINK_SYNC_FILTER)
+    {
+        samples_n++;
+    }
+
+    // The exchange that was delayed least
+    const link_sample_t *best = &samples[0];
+
+    for(uint32_t i=1; i<samples_n; i++)
+    {
+        if(samples[i].delay < best->delay)
+        {
+            best = &samples[i];
+        }
+    }
+
+    int32_t skew = skew_ppb;
+
+    if(!skew_valid)
+    {
+        skew_ref = *best;
+        skew_valid = true;
+    }
+    else if((int64_t)(best->at - skew_ref.at) >= (LINK_SKEW_SPAN_MS * 1000LL))
+    {
+        const int64_t measured = ((best->offset - skew_ref.offset) * 1000000000LL) /
+                                 (int64_t)(best->at - skew_ref.at);
+
+        // The first measurement is taken as it is, later ones are smoothed
+        skew = skew_measured ? (int32_t)((3 * (int64_t)skew + measured) / 4) :
+                               (int32_t)measured;
+        skew_measured = true;
+        skew_ref = *best;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        estimate = *best;
+        skew_ppb = skew;
+        estimated = true;
+        synced_ms = mono_ms();
+
+        stats.offset_us = best->offset;
+        stats.skew_ppb = skew;
+        stats.delay_us = best->delay;
+        stats.syncs++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Opens the ports of the link and starts its tasks
+ *
+ * The ports are LINK_UP_PORT and LINK_DOWN_PORT at LINK_BAUD. A node
+ * redirects its telemetry to the link, the gateway keeps writing it to the
+ * port given to tlm_init().
+ *
+ * \param[in]  priority  Priority of the tasks, above the tasks that send
+ *                       telemetry, so the time stamps are taken without
+ *                       delay
+ *
+ * \return false if a port could not be opened
+ */
+bool link_init(UBaseType_t priority)
+{
+    pool_init(&link_buffers, "link_buffers", link_buffer_storage,
+        sizeof(link_buffer_t), LINK_BUFFERS);
+
+    if(LINK_UP_PORT != LINK_NONE)
+    {
+        up.port = xSerialPortOpen((eCOMPort)LINK_UP_PORT, LINK_BAUD, LINK_QUEUE_LENGTH);
+
+        if(up.port == NULL)
+        {
+            LOG_ERROR("cannot open the port towards the gateway\r\n");
+            return false;
+        }
+
+        vSerialPortSetTxPolicy(up.port, eSerialBlock, LINK_BLOCK_TIME);
+    }
+
+    if(LINK_DOWN_PORT != LINK_NONE)
+    {
+        down.port = xSerialPortOpen((eCOMPort)LINK_DOWN_PORT, LINK_BAUD, LINK_QUEUE_LENGTH);
+
+        if(down.port == NULL)
+        {
+            LOG_ERROR("cannot open the port towards the next node\r\n");
+            return false;
+        }
+
+        vSerialPortSetTxPolicy(down.port, eSerialBlock, LINK_BLOCK_TIME);
+    }
+
+    if(up.port != NULL)
+    {
+        tlm_redirect(link_tlm_sink);
+
+        (void)xTaskCreateStatic(vLinkUpTask, "LinkUp", LINK_STACK_DEPTH, NULL,
+                                priority, up_stack, &up_tcb);
+    }
+
+    if(down.port != NULL)
+    {
+        (void)xTaskCreateStatic(vLinkDownTask, "LinkDown", LINK_STACK_DEPTH, NULL,
+                                priority, down_stack, &down_tcb);
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Returns the link time, mono_us() of the gateway, in us
+ *
+ * On a node that was never synchronised, its own mono_us(). Must be called
+ * from a task.
+ */
+uint64_t link_time_us(void)
+{
+    return link_time_at(mono_us());
+}
+
+/*!
+ * \brief Returns true on the gateway, and on a node that was synchronised
+ *        in the last LINK_SYNC_TIMEOUT_MS
+ */
+bool link_synced(void)
+{
+    bool valid;
+    uint32_t ms;
+
+    if(up.port == NULL)
+    {
+        return true;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        valid = estimated && (samples_n == LINK_SYNC_FILTER);
+        ms = synced_ms;
+    }
+    taskEXIT_CRITICAL();
+
+    return valid && ((mono_ms() - ms) < LINK_SYNC_TIMEOUT_MS);
+}
+
+/*!
+ * \brief Returns the statistics of the link
+ */
+void link_get_stats(link_stats_t *s)
+{
+    const bool synced = link_synced();
+
+    taskENTER_CRITICAL();
+    {
+        *s = stats;
+    }
+    taskEXIT_CRITICAL();
+
+    s->synced = synced;
+}
+
+/*!
+ * \brief Writes the state of the link to the serial port
+ *
+ * The offset of the link time to mono_us() and its rate difference, the
+ * round trip of the exchange they were taken from, and the packet counters.
+ */
+void link_report(void)
+{
+    char line[LINK_LINE_LEN];
+    link_stats_t s;
+
+    link_get_stats(&s);
+
+    const uint64_t offset = (s.offset_us < 0) ? (uint64_t)(-s.offset_us) :
+                            (uint64_t)s.offset_us;
+
+    xsnprintf(line, LINK_LINE_LEN, "\r\nLink node %u, %s\r\n",
+              (unsigned int)LINK_NODE,
+              (up.port == NULL) ? "gateway" : (s.synced ? "synced" : "not synced"));
+    xSerialPutStringPolicy(line, eSerialBlock, LINK_BLOCK_TIME);
+
+    if(up.port != NULL)
+    {
+        xsnprintf(line, LINK_LINE_LEN, "Offset %c%lu.%06lu s, skew %ld ppb, delay %lu us\r\n",
+                  (s.offset_us < 0) ? '-' : '+',
+                  (unsigned long)(offset / 1000000U),
+                  (unsigned long)(offset % 1000000U),
+                  (long)s.skew_ppb, (unsigned long)s.delay_us);
+        xSerialPutStringPolicy(line, eSerialBlock, LINK_BLOCK_TIME);
+    }
+
+    xsnprintf(line, LINK_LINE_LEN, "Syncs %lu, tx %lu, rx %lu, forwarded %lu\r\n",
+              (unsigned long)s.syncs, (unsigned long)s.tx,
+              (unsigned long)s.rx, (unsigned long)s.forwarded);
+    xSerialPutStringPolicy(line, eSerialBlock, LINK_BLOCK_TIME);
+
+    xsnprintf(line, LINK_LINE_LEN, "Errors %lu, dropped %lu\r\n",
+              (unsigned long)s.errors, (unsigned long)s.dropped);
+    xSerialPutStringPolicy(line, eSerialBlock, LINK_BLOCK_TIME);
+}
+
+/*!
+ * \brief Sends a telemetry record of this node towards the gateway
+ *
+ * Called by tlm_send() instead of writing to the serial port, on the stack
+ * of every task that sends telemetry, so the packet is assembled in the
+ * scratch arena.
+ */
+static bool link_tlm_sink(const tlm_type_t type, const void *payload,
+    const uint8_t len)
+{
+    const scratch_mark_t mark = scratch_mark();
+    uint8_t *raw;
+    link_header_t h;
+    link_tlm_t t;
+    bool ok;
+
+    if(len > LINK_TLM_MAX_PAYLOAD)
+    {
+        return false;
+    }
+
+    raw = scratch_alloc(sizeof(h) + sizeof(t) + len, LINK_BLOCK_TIME);
+
+    if(raw == NULL)
+    {
+        link_count(&stats.dropped);
+        return false;
+    }
+
+    link_header(&h, LINK_TLM);
+    t.time_us = (uint32_t)link_time_us();
+    t.type = (uint8_t)type;
+
+    memcpy(raw, &h, sizeof(h));
+    memcpy(&raw[sizeof(h)], &t, sizeof(t));
+    memcpy(&raw[sizeof(h) + sizeof(t)], payload, len);
+
+    ok = link_write(&up, raw, sizeof(h) + sizeof(t) + len);
+
+    scratch_release(mark);
+
+    return ok;
+}
+
+/*!
+ * \brief Writes a record of another node to the telemetry port of the
+ *        gateway, as TLM_NODE
+ */
+static void link_tlm_gateway(const link_header_t *h, const uint8_t *body,
+    const uint32_t n)
+{
+    uint8_t payload[TLM_MAX_PAYLOAD];
+    link_tlm_t t;
+    tlm_node_t node;
+
+    if((n < sizeof(t)) || ((n - sizeof(t)) > LINK_TLM_MAX_PAYLOAD))
+    {
+        link_count(&stats.errors);
+        return;
+    }
+
+    memcpy(&t, body, sizeof(t));
+
+    node.node = h->node;
+    node.type = t.type;
+    node.time_us = t.time_us;
+
+    memcpy(payload, &node, sizeof(node));
+    memcpy(&payload[sizeof(node)], &body[sizeof(t)], n - sizeof(t));
+
+    if(tlm_send(TLM_NODE, payload, (uint8_t)(sizeof(node) + n - sizeof(t))))
+    {
+        link_count(&stats.forwarded);
+    }
+}
+
+/*!
+ * \brief Task of the port towards the gateway
+ *
+ * Sends a synchronisation request every LINK_SYNC_PERIOD_MS and adds the
+ * responses to the estimate of the link time.
+ */
+static void vLinkUpTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    uint8_t raw[sizeof(link_header_t) + sizeof(link_sync_t)];
+    link_header_t h;
+    link_sync_t s;
+    uint64_t pending = 0;
+    TickType_t wake = xTaskGetTickCount();
+
+    LOG_DEBUG("[%*s] started\r\n", 12, __func__);
+
+    for( ;; )
+    {
+        // Request, t2 and t3 are sent as well so it takes as long on the
+        // wire as the response
+        link_header(&h, LINK_SYNC_REQ);
+        memset(&s, 0, sizeof(s));
+        s.t1 = mono_us();
+        pending = s.t1;
+
+        memcpy(raw, &h, sizeof(h));
+        memcpy(&raw[sizeof(h)], &s, sizeof(s));
+        (void)link_write(&up, raw, sizeof(raw));
+
+        wake += pdMS_TO_TICKS(LINK_SYNC_PERIOD_MS);
+
+        // After a blocked write the next request is sent now
+        if((TickType_t)(wake - xTaskGetTickCount()) > pdMS_TO_TICKS(LINK_SYNC_PERIOD_MS))
+        {
+            wake = xTaskGetTickCount();
+        }
+
+        // Responses until the next request
+        for( ;; )
+        {
+            const TickType_t left = wake - xTaskGetTickCount();
+            uint64_t at;
+
+            if((left == 0) || (left > pdMS_TO_TICKS(LINK_SYNC_PERIOD_MS)))
+            {
+                break;
+            }
+
+            const uint32_t n = link_receive(&up, left, &at);
+
+            if(n == 0)
+            {
+                continue;
+            }
+
+            memcpy(&h, up.raw, sizeof(h));
+
+            if((h.type != LINK_SYNC_RESP) ||
+               (n != (sizeof(h) + sizeof(s))))
+            {
+                continue;
+            }
+
+            memcpy(&s, &up.raw[sizeof(h)], sizeof(s));
+
+            // A late response to an earlier request is not used
+            if((pending != 0) && (s.t1 == pending))
+            {
+                link_sync(&s, at);
+                pending = 0;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Task of the port towards the next node
+ *
+ * Answers the synchronisation requests with the link time and forwards the
+ * telemetry records towards the gateway.
+ */
+static void vLinkDownTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    link_header_t h;
+    link_sync_t s;
+
+    LOG_DEBUG("[%*s] started\r\n", 12, __func__);
+
+    for( ;; )
+    {
+        uint64_t at;
+        const uint32_t n = link_receive(&down, portMAX_DELAY, &at);
+
+        if(n == 0)
+        {
+            continue;
+        }
+
+        memcpy(&h, down.raw, sizeof(h));
+
+        if((h.type == LINK_SYNC_REQ) && (n == (sizeof(h) + sizeof(s))))
+        {
+            memcpy(&s, &down.raw[sizeof(h)], sizeof(s));
+            s.t2 = link_time_at(at);
+
+            link_header(&h, LINK_SYNC_RESP);
+            memcpy(down.raw, &h, sizeof(h));
+
+            s.t3 = link_time_us();
+            memcpy(&down.raw[sizeof(h)], &s, sizeof(s));
+            (void)link_write(&down, down.raw, n);
+        }
+        else if(h.type == LINK_TLM)
+        {
+            if(up.port != NULL)
+            {
+                // Stamped with the link time by the node that sent it
+                if(link_write(&up, down.raw, n))
+                {
+                    link_count(&stats.forwarded);
+                }
+            }
+            else
+            {
+                link_tlm_gateway(&h, &down.raw[sizeof(h)], n - sizeof(h));
+            }
+        }
+    }
+}
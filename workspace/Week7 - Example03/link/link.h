@@ -0,0 +1,208 @@
+/*! ***************************************************************************
+ *
+ * \brief     Time synchronised link between boards
+ * \file      link.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef LINK_H
+#define LINK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "serial.h"
+#include "telemetry.h"
+
+/// \name Definitions for the board-to-board link
+/// \{
+
+/*!
+ * \brief Set to 1 to start the link in main(), see the LINK_NODE option in
+ *        CMakeLists.txt
+ */
+#ifndef LINK_ENABLED
+#define LINK_ENABLED        (0)
+#endif
+
+/*!
+ * \brief Number of this board, 0 is the gateway
+ *
+ * The gateway keeps the time of the link and writes the telemetry of all
+ * nodes to its own telemetry port.
+ */
+#ifndef LINK_NODE
+#define LINK_NODE           (0)
+#endif
+
+/// Port number of a link that is not used
+#define LINK_NONE           (serNUM_PORTS)
+
+/*!
+ * \brief Port towards the gateway, LINK_NONE on the gateway
+ */
+#ifndef LINK_UP_PORT
+#define LINK_UP_PORT        ((LINK_NODE == 0) ? LINK_NONE : serCOM3)
+#endif
+
+/*!
+ * \brief Port towards the next node, LINK_NONE on the last node
+ *
+ * The gateway has one node on UART2. A chain of more nodes needs UART1 on
+ * its alternative pins PTC4 and PTC3, as PTE0 and PTE1 are used by the
+ * Oled display. See serCOM2_PORT.
+ */
+#ifndef LINK_DOWN_PORT
+#define LINK_DOWN_PORT      ((LINK_NODE == 0) ? serCOM3 : LINK_NONE)
+#endif
+
+/*!
+ * \brief Baud rate of the link, the highest rate of UART1 and UART2 from
+ *        the 24 MHz bus clock
+ */
+#ifndef LINK_BAUD
+#define LINK_BAUD           (115200)
+#endif
+
+/*!
+ * \brief Queue length of a link port, see serBUFFER_POOL_SIZE
+ *
+ * The LINK_NODE option of CMakeLists.txt makes room for two link ports
+ * next to UART0.
+ */
+#ifndef LINK_QUEUE_LENGTH
+#define LINK_QUEUE_LENGTH   (128)
+#endif
+
+/*!
+ * \brief Period of the time synchronisation in ms
+ */
+#ifndef LINK_SYNC_PERIOD_MS
+#define LINK_SYNC_PERIOD_MS (250)
+#endif
+
+/*!
+ * \brief Number of synchronisations the offset is filtered over
+ *
+ * The exchange with the shortest round trip of the last LINK_SYNC_FILTER
+ * gives the offset, it was delayed least by the tasks on both ends.
+ */
+#ifndef LINK_SYNC_FILTER
+#define LINK_SYNC_FILTER    (8)
+#endif
+
+/*!
+ * \brief Time over which the rate difference of the clocks is measured,
+ *        in ms
+ */
+#ifndef LINK_SKEW_SPAN_MS
+#define LINK_SKEW_SPAN_MS   (8000)
+#endif
+
+/*!
+ * \brief Time without a synchronisation after which a node is not synced,
+ *        in ms
+ */
+#define LINK_SYNC_TIMEOUT_MS (4 * LINK_SYNC_PERIOD_MS * LINK_SYNC_FILTER)
+
+/*!
+ * \brief Largest payload of a record that a node forwards
+ *
+ * The gateway adds 6 bytes when it writes the record as TLM_NODE.
+ */
+#define LINK_TLM_MAX_PAYLOAD (TLM_MAX_PAYLOAD - 6)
+
+/// \}
+
+/// Packet types
+typedef enum
+{
+    LINK_SYNC_REQ  = 1, ///< link_sync_t with t1, from a node to the gateway
+    LINK_SYNC_RESP = 2, ///< link_sync_t with t1, t2 and t3
+    LINK_TLM       = 3, ///< link_tlm_t and the payload of a record
+}link_type_t;
+
+/*!
+ * \brief Packet header
+ *
+ * Every packet is the header, the body and a CRC-16/CCITT-FALSE, COBS
+ * encoded and terminated by 0x00, as the telemetry frames.
+ */
+typedef struct __attribute__((packed))
+{
+    uint8_t type;       ///< link_type_t
+    uint8_t node;       ///< Node that sent the packet first
+    uint16_t seq;       ///< Incremented for every packet of that node
+}
+link_header_t;
+
+/*!
+ * \brief Body of the synchronisation packets, all times in us
+ *
+ * A request has the same length as a response, so both take the same time
+ * on the wire and it cancels out of the offset.
+ */
+typedef struct __attribute__((packed))
+{
+    uint64_t t1;        ///< Request sent, time of the node
+    uint64_t t2;        ///< Request received, link time of the other end
+    uint64_t t3;        ///< Response sent, link time of the other end
+}
+link_sync_t;
+
+/// Body of a forwarded record, followed by its payload
+typedef struct __attribute__((packed))
+{
+    uint32_t time_us;   ///< Link time of the record, lower 32 bits
+    uint8_t type;       ///< tlm_type_t
+}
+link_tlm_t;
+
+/// Statistics of the link
+typedef struct
+{
+    bool synced;        ///< The offset is valid
+    int64_t offset_us;  ///< Link time minus mono_us() at the last sync
+    int32_t skew_ppb;   ///< Rate of the link time to mono_us(), minus 1
+    uint32_t delay_us;  ///< Round trip of the exchange of the offset
+    uint32_t syncs;     ///< Completed synchronisations
+    uint32_t tx;        ///< Packets sent, on both ports
+    uint32_t rx;        ///< Packets received, on both ports
+    uint32_t forwarded; ///< Records forwarded towards the gateway
+    uint32_t errors;    ///< Packets with a bad COBS code, length or CRC
+    uint32_t dropped;   ///< Packets that did not fit in a transmit buffer
+}
+link_stats_t;
+
+// Function prototypes
+bool link_init(UBaseType_t priority);
+uint64_t link_time_us(void);
+bool link_synced(void);
+void link_get_stats(link_stats_t *s);
+void link_report(void);
+
+#endif // LINK_H
@@ -0,0 +1,362 @@
+/*! ***************************************************************************
+ *
+ * \brief     Sliding window CPU load meter
+ * \file      loadmeter.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <string.h>
+
+#include "loadmeter.h"
+#include "periodic.h"
+#include "serial.h"
+#include "xprintf.h"
+
+// Time a row may wait for room in the serial transmit buffer
+#define LOADMETER_BLOCK_TIME pdMS_TO_TICKS(100)
+
+// Longest row written to the serial port, including the terminator
+#define LOADMETER_LINE_LEN   (48)
+
+/*!
+ * \brief Load history of a task
+ *
+ * recent holds the load of the last LOADMETER_RATIO periods, longer holds
+ * the mean load of the last LOADMETER_RATIO runs of LOADMETER_RATIO
+ * periods. Both in per mille.
+ */
+typedef struct
+{
+    TaskHandle_t task;
+    char name[configMAX_TASK_NAME_LEN];
+    configRUN_TIME_COUNTER_TYPE last;
+    uint16_t recent[LOADMETER_RATIO];
+    uint16_t longer[LOADMETER_RATIO];
+}loadmeter_task_t;
+
+// The snapshot is static, so sampling never allocates from the heap
+static TaskStatus_t snapshot[LOADMETER_TASKS];
+static loadmeter_task_t tasks[LOADMETER_TASKS];
+static configRUN_TIME_COUNTER_TYPE last_total = 0;
+static uint32_t periods = 0;
+
+static StaticTask_t load_tcb;
+__BSS_NOCLEAR static StackType_t load_stack[configMINIMAL_STACK_SIZE];
+
+static void vLoadTask(void *pvParameters);
+
+/*!
+ * \brief Initializes the load meter
+ *
+ * Creates the task that samples the run-time counters of all tasks every
+ * LOADMETER_PERIOD_MS.
+ *
+ * \param[in]  priority  Priority of the load meter task. A high priority
+ *                       keeps the periods regular, this task does little.
+ */
+void loadmeter_init(UBaseType_t priority)
+{
+    xTaskCreateStatic(vLoadTask, "Load", configMINIMAL_STACK_SIZE, NULL,
+                      priority, load_stack, &load_tcb);
+}
+
+/*!
+ * \brief Mean of the first n loads of a history
+ */
+static uint16_t loadmeter_mean(const uint16_t history[], const uint32_t n)
+{
+    uint32_t sum = 0;
+
+    if(n == 0)
+    {
+        return 0;
+    }
+
+    for(uint32_t i=0; i<n; i++)
+    {
+        sum += history[i];
+    }
+
+    return (uint16_t)(sum / n);
+}
+
+/*!
+ * \brief Copies the load of a task in every window, called in a critical
+ *        section
+ */
+static void loadmeter_copy(const loadmeter_task_t *t, loadmeter_load_t *load)
+{
+    const uint32_t filled = (periods < LOADMETER_RATIO) ? periods : LOADMETER_RATIO;
+    const uint32_t runs = periods / LOADMETER_RATIO;
+
+    memcpy(load->name, t->name, configMAX_TASK_NAME_LEN);
+
+    load->load[0] = (periods > 0) ? t->recent[(periods - 1) % LOADMETER_RATIO] : 0;
+    load->load[1] = loadmeter_mean(t->recent, filled);
+    load->load[2] = loadmeter_mean(t->longer,
+        (runs < LOADMETER_RATIO) ? runs : LOADMETER_RATIO);
+}
+
+/*!
+ * \brief Gets the load of a task
+ *
+ * A task is listed from the first period after it was created. Until a
+ * window has been filled after start-up, its load is the mean of the periods
+ * so far. For a task created later, the periods before it existed count as
+ * no load.
+ *
+ * \param[in]  i     Index of the task, counting from 0
+ * \param[out] load  Name and load of the task
+ *
+ * \return False if there is no task i
+ */
+bool loadmeter_get(const uint32_t i, loadmeter_load_t *load)
+{
+    uint32_t n = 0;
+    bool found = false;
+
+    taskENTER_CRITICAL();
+    {
+        for(uint32_t j=0; j<LOADMETER_TASKS; j++)
+        {
+            if(tasks[j].task == NULL)
+            {
+                continue;
+            }
+
+            if(n++ == i)
+            {
+                loadmeter_copy(&tasks[j], load);
+                found = true;
+                break;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return found;
+}
+
+/*!
+ * \brief Gets the total CPU load, all time not spent in the idle task
+ *
+ * \param[in]  window  Index of the window, 0 is the shortest
+ *
+ * \return Load in per mille
+ */
+uint16_t loadmeter_total(const uint32_t window)
+{
+    const TaskHandle_t idle = xTaskGetIdleTaskHandle();
+    loadmeter_load_t load;
+    uint16_t total = 0;
+
+    if(window >= LOADMETER_WINDOWS)
+    {
+        return 0;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        for(uint32_t j=0; j<LOADMETER_TASKS; j++)
+        {
+            if(tasks[j].task == idle)
+            {
+                loadmeter_copy(&tasks[j], &load);
+                total = (uint16_t)(1000 - load.load[window]);
+                break;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return total;
+}
+
+/*!
+ * \brief Formats a row of per mille loads
+ */
+static void loadmeter_row(const char *name, const uint16_t load[])
+{
+    char line[LOADMETER_LINE_LEN];
+    int n;
+
+    n = xsnprintf(line, LOADMETER_LINE_LEN, "%-*s", configMAX_TASK_NAME_LEN, name);
+
+    for(uint32_t w=0; w<LOADMETER_WINDOWS; w++)
+    {
+        n += xsnprintf(&line[n], LOADMETER_LINE_LEN - n, " %3u.%u%%",
+            load[w] / 10, load[w] % 10);
+    }
+
+    xsnprintf(&line[n], LOADMETER_LINE_LEN - n, "\r\n");
+
+    xSerialPutStringPolicy(line, eSerialBlock, LOADMETER_BLOCK_TIME);
+}
+
+/*!
+ * \brief Writes the load of all tasks and the total load to the serial port
+ *
+ * Columns are the name and the load in every window, the header gives the
+ * length of the windows in ms.
+ */
+void loadmeter_report(void)
+{
+    char line[LOADMETER_LINE_LEN];
+    loadmeter_load_t load;
+    uint16_t total[LOADMETER_WINDOWS];
+    uint32_t i = 0;
+
+    xsnprintf(line, LOADMETER_LINE_LEN, "\r\n%-*s %5lu %6lu %6lu ms\r\n",
+        configMAX_TASK_NAME_LEN, "Name",
+        (unsigned long)LOADMETER_PERIOD_MS,
+        (unsigned long)(LOADMETER_PERIOD_MS * LOADMETER_RATIO),
+        (unsigned long)(LOADMETER_PERIOD_MS * LOADMETER_RATIO * LOADMETER_RATIO));
+    xSerialPutStringPolicy(line, eSerialBlock, LOADMETER_BLOCK_TIME);
+
+    while(loadmeter_get(i++, &load))
+    {
+        loadmeter_row(load.name, load.load);
+    }
+
+    for(uint32_t w=0; w<LOADMETER_WINDOWS; w++)
+    {
+        total[w] = loadmeter_total(w);
+    }
+
+    loadmeter_row("Total", total);
+}
+
+/*!
+ * \brief Finds the entry of a task, NULL if the task has none
+ */
+static loadmeter_task_t *loadmeter_find(const TaskHandle_t task)
+{
+    for(uint32_t j=0; j<LOADMETER_TASKS; j++)
+    {
+        if(tasks[j].task == task)
+        {
+            return &tasks[j];
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * \brief Updates the history of every task with the last period
+ *
+ * Tasks that are gone release their entry, new tasks take a free entry and
+ * are measured from the next period.
+ */
+static void loadmeter_sample(const UBaseType_t n, const configRUN_TIME_COUNTER_TYPE total)
+{
+    const configRUN_TIME_COUNTER_TYPE elapsed = total - last_total;
+    const uint32_t slot = periods % LOADMETER_RATIO;
+    bool seen[LOADMETER_TASKS] = {false};
+
+    last_total = total;
+
+    taskENTER_CRITICAL();
+    {
+        for(UBaseType_t i=0; i<n; i++)
+        {
+            loadmeter_task_t *t = loadmeter_find(snapshot[i].xHandle);
+
+            if(t == NULL)
+            {
+                continue;
+            }
+
+            seen[t - tasks] = true;
+
+            const configRUN_TIME_COUNTER_TYPE run = snapshot[i].ulRunTimeCounter - t->last;
+            t->last = snapshot[i].ulRunTimeCounter;
+
+            t->recent[slot] = (elapsed > 0) ? (uint16_t)((run * 1000) / elapsed) : 0;
+
+            if(slot == (LOADMETER_RATIO - 1))
+            {
+                t->longer[(periods / LOADMETER_RATIO) % LOADMETER_RATIO] =
+                    loadmeter_mean(t->recent, LOADMETER_RATIO);
+            }
+        }
+
+        // Release the entries of deleted tasks
+        for(uint32_t j=0; j<LOADMETER_TASKS; j++)
+        {
+            if(!seen[j])
+            {
+                tasks[j].task = NULL;
+            }
+        }
+
+        for(UBaseType_t i=0; i<n; i++)
+        {
+            if(loadmeter_find(snapshot[i].xHandle) != NULL)
+            {
+                continue;
+            }
+
+            // There are at most as many tasks as entries
+            loadmeter_task_t *t = loadmeter_find(NULL);
+
+            memset(t, 0, sizeof(loadmeter_task_t));
+            t->task = snapshot[i].xHandle;
+            strncpy(t->name, snapshot[i].pcTaskName, configMAX_TASK_NAME_LEN - 1);
+            t->last = snapshot[i].ulRunTimeCounter;
+        }
+
+        periods++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Samples the run-time counters every LOADMETER_PERIOD_MS
+ */
+static void vLoadTask(void *pvParameters)
+{
+    configRUN_TIME_COUNTER_TYPE total;
+    UBaseType_t n;
+
+    (void)pvParameters;
+    static periodic_t xPeriodic;
+
+    periodic_init(&xPeriodic, "Load", pdMS_TO_TICKS(LOADMETER_PERIOD_MS));
+
+    for( ;; )
+    {
+        (void)periodic_wait(&xPeriodic);
+
+        n = uxTaskGetSystemState(snapshot, LOADMETER_TASKS, &total);
+
+        // Zero if there were more tasks than LOADMETER_TASKS
+        if(n > 0)
+        {
+            loadmeter_sample(n, total);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+/*! ***************************************************************************
+ *
+ * \brief     Sliding window CPU load meter
+ * \file      loadmeter.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef LOADMETER_H
+#define LOADMETER_H
+
+#include <MKL25Z4.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// \name Definitions for the load meter
+/// \{
+
+/*!
+ * \brief Sample period in ms, the length of the shortest window
+ */
+#ifndef LOADMETER_PERIOD_MS
+#define LOADMETER_PERIOD_MS   (100)
+#endif
+
+/*!
+ * \brief Every window is this many times longer than the previous one
+ */
+#ifndef LOADMETER_RATIO
+#define LOADMETER_RATIO       (10)
+#endif
+
+/*!
+ * \brief Number of windows, of 100 ms, 1 s and 10 s with the defaults
+ */
+#define LOADMETER_WINDOWS     (3)
+
+/*!
+ * \brief Maximum number of tasks, a snapshot with more tasks is skipped
+ */
+#ifndef LOADMETER_TASKS
+#define LOADMETER_TASKS       (10)
+#endif
+
+/// \}
+
+/// Load of a task in every window
+typedef struct
+{
+    char name[configMAX_TASK_NAME_LEN];
+    uint16_t load[LOADMETER_WINDOWS];    ///< Per mille of the CPU time
+}
+loadmeter_load_t;
+
+// Function prototypes
+void loadmeter_init(UBaseType_t priority);
+bool loadmeter_get(const uint32_t i, loadmeter_load_t *load);
+uint16_t loadmeter_total(const uint32_t window);
+void loadmeter_report(void);
+
+#endif // LOADMETER_H
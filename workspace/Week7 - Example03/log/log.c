@@ -0,0 +1,222 @@
+/*! ***************************************************************************
+ *
+ * \brief     Deferred binary logger
+ * \file      log.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <string.h>
+
+#include "log.h"
+#include "mono.h"
+#include "periodic.h"
+#include "rtt.h"
+#include "scratch.h"
+#include "serial.h"
+#include "usbcdc.h"
+#include "xprintf.h"
+
+// Ring buffer of pending records. Producers reserve a slot by incrementing
+// head with interrupts masked, fill the slot with interrupts enabled and then
+// mark it ready. tail is only written by the log task.
+static log_record_t ring[LOG_RING_SIZE];
+static volatile uint32_t head = 0;
+static volatile uint32_t tail = 0;
+static volatile uint32_t dropped = 0;
+
+volatile uint8_t log_threshold = LOG_LEVEL_DEBUG;
+
+// Stack size in words of the log task, xsnprintf() needs the extra words,
+// the line is in the scratch arena
+#define LOG_STACK_DEPTH (configMINIMAL_STACK_SIZE + 8)
+
+// Longest rendered record, including the terminator
+#define LOG_LINE_LEN    (96)
+
+static StaticTask_t log_tcb;
+__BSS_NOCLEAR static StackType_t log_stack[LOG_STACK_DEPTH];
+
+static void vLogTask(void *pvParameters);
+
+/*!
+ * \brief Initializes the logger
+ *
+ * Creates the task that renders the log records and sends them to the
+ * serial port. The serial port must be initialized before this task runs.
+ *
+ * \param[in]  priority  Priority of the log task. Choose a priority below all
+ *                       real-time tasks, so formatting never delays them.
+ */
+void log_init(UBaseType_t priority)
+{
+    xTaskCreateStatic(vLogTask, "Log", LOG_STACK_DEPTH, NULL, priority,
+                      log_stack, &log_tcb);
+}
+
+/*!
+ * \brief Stores a log record
+ *
+ * This function is normally called via the LOG() macro. It copies the
+ * arguments into the ring buffer without formatting them. If the ring buffer
+ * is full, the record is dropped and counted. Interrupts are only masked
+ * while a slot is reserved, so this function can be called from interrupt
+ * handlers as well as from tasks.
+ *
+ * \param[in]  fmt      printf style format string
+ * \param[in]  a0 - a3  Raw arguments
+ */
+void log_write(const char *fmt, uintptr_t a0, uintptr_t a1, uintptr_t a2,
+               uintptr_t a3)
+{
+    log_record_t *r = NULL;
+    UBaseType_t mask;
+
+    // Reserve a slot
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        if((head - tail) < LOG_RING_SIZE)
+        {
+            r = &ring[head & (LOG_RING_SIZE - 1)];
+            head++;
+        }
+        else
+        {
+            dropped++;
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    if(r == NULL)
+    {
+        return;
+    }
+
+    // Fill the slot, with the same time base as the sensor timestamps
+    r->timestamp = mono_ms();
+    r->fmt = fmt;
+    r->args[0] = a0;
+    r->args[1] = a1;
+    r->args[2] = a2;
+    r->args[3] = a3;
+
+    // Make sure the record is written before it is marked ready
+    __DMB();
+    r->ready = 1;
+}
+
+/*!
+ * \brief Returns the number of records dropped because the ring was full
+ */
+uint32_t log_dropped(void)
+{
+    return dropped;
+}
+
+/*!
+ * \brief Sets the highest level that is recorded at run time
+ *
+ * Statements above the level of their module are not in the image and
+ * stay off whatever the threshold is. Errors are always recorded, a lower
+ * level is taken as LOG_LEVEL_ERROR. Can be called from interrupt handlers.
+ *
+ * \param[in]  level  LOG_LEVEL_ERROR to LOG_LEVEL_DEBUG
+ */
+void log_set_threshold(const uint8_t level)
+{
+    if(level < LOG_LEVEL_ERROR)
+    {
+        log_threshold = LOG_LEVEL_ERROR;
+    }
+    else if(level > LOG_LEVEL_DEBUG)
+    {
+        log_threshold = LOG_LEVEL_DEBUG;
+    }
+    else
+    {
+        log_threshold = level;
+    }
+}
+
+/*!
+ * \brief Returns the highest level that is recorded at run time
+ */
+uint8_t log_get_threshold(void)
+{
+    return log_threshold;
+}
+
+/*!
+ * \brief Renders pending log records and sends them to the serial port, or
+ *        to the RTT terminal channel with LOG_RTT
+ */
+static void vLogTask(void *pvParameters)
+{
+    char *str;
+    int n;
+    static periodic_t xPeriodic;
+
+    periodic_init(&xPeriodic, "Log", pdMS_TO_TICKS(LOG_FLUSH_PERIOD_MS));
+
+    for( ;; )
+    {
+        const scratch_mark_t mark = scratch_mark();
+
+        // Without room in the arena the records wait for the next period
+        str = (tail != head) ? scratch_alloc(LOG_LINE_LEN, 0) : NULL;
+
+        while((str != NULL) && (tail != head))
+        {
+            log_record_t *r = &ring[tail & (LOG_RING_SIZE - 1)];
+
+            // The producer of this slot may have been interrupted before it
+            // finished, try again later
+            if(!r->ready)
+            {
+                break;
+            }
+
+            n = xsnprintf(str, LOG_LINE_LEN, "%7lu | ", (unsigned long)r->timestamp);
+            xsnprintf(&str[n], LOG_LINE_LEN - n, r->fmt,
+                      r->args[0], r->args[1], r->args[2], r->args[3]);
+
+            // The record is rendered, release the slot
+            r->ready = 0;
+            tail++;
+
+#if (LOG_RTT == 1)
+            (void)rtt_write(RTT_TERMINAL, str, strlen(str));
+#elif (LOG_USBCDC == 1)
+            vUsbCdcPutString(str);
+#else
+            vSerialPutString(str);
+#endif
+        }
+
+        scratch_release(mark);
+
+        (void)periodic_wait(&xPeriodic);
+    }
+}
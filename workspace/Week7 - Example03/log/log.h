@@ -0,0 +1,216 @@
+/*! ***************************************************************************
+ *
+ * \brief     Deferred binary logger
+ * \file      log.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef LOG_H
+#define LOG_H
+
+#include <MKL25Z4.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// \name Definitions for the logger
+/// \{
+
+/*!
+ * \brief Number of records in the ring buffer. Must be a power of two.
+ */
+#ifndef LOG_RING_SIZE
+#define LOG_RING_SIZE         (16)
+#endif
+
+/*!
+ * \brief Maximum number of arguments per record
+ */
+#define LOG_MAX_ARGS          (4)
+
+/*!
+ * \brief Interval at which the log task renders pending records
+ */
+#ifndef LOG_FLUSH_PERIOD_MS
+#define LOG_FLUSH_PERIOD_MS   (50)
+#endif
+
+/*!
+ * \brief Set to 1 to write the rendered records to the RTT terminal channel
+ *        instead of the serial port
+ *
+ * A record then costs a copy into RAM that the debug probe reads, without
+ * the serial interrupts. Records that do not fit in the RTT ring are
+ * dropped, so use it while a probe is attached.
+ */
+#ifndef LOG_RTT
+#define LOG_RTT               (0)
+#endif
+
+/*!
+ * \brief Set to 1 to write the rendered records to the USB virtual COM port
+ *        instead of the serial port
+ *
+ * Needs USBCDC_ENABLED. LOG_RTT takes precedence.
+ */
+#ifndef LOG_USBCDC
+#define LOG_USBCDC            (0)
+#endif
+
+/// \}
+
+/*!
+ * \brief Log a message without formatting it
+ *
+ * Only the address of the format string, up to four integer or pointer
+ * arguments and a timestamp are stored. The text is rendered later by the
+ * low-priority log task. LOG() may be used from tasks and from interrupt
+ * handlers, it never blocks. Because formatting is deferred, %s arguments must
+ * point to strings that are still valid at that time, such as string
+ * literals or __func__. Floating point arguments are not supported.
+ * LOG() is never filtered, LOG_ERROR() to LOG_DEBUG() are filtered by level.
+ *
+ * Example: LOG("[%*s] started\r\n", 12, __func__);
+ */
+#define LOG(...)  log_write(LOG_ARGS(__VA_ARGS__, 0, 0, 0, 0, 0))
+
+#define LOG_ARGS(fmt, a0, a1, a2, a3, ...) \
+    (fmt), (uintptr_t)(a0), (uintptr_t)(a1), (uintptr_t)(a2), (uintptr_t)(a3)
+
+/// \name Log levels
+/// \{
+
+/*!
+ * \brief Levels of LOG_ERROR() to LOG_DEBUG()
+ *
+ * A statement is kept if its level is at or below the level of its module.
+ * 0 is not a level, it stands for a module without a level of its own.
+ */
+#define LOG_LEVEL_NONE        (1)
+#define LOG_LEVEL_ERROR       (2)
+#define LOG_LEVEL_WARN        (3)
+#define LOG_LEVEL_INFO        (4)
+#define LOG_LEVEL_DEBUG       (5)
+
+/*!
+ * \brief Level of the modules without a level of their own
+ *
+ * Set by the LOG_LEVEL option of CMakeLists.txt, everything is kept by
+ * default.
+ */
+#ifndef LOG_LEVEL
+#define LOG_LEVEL             LOG_LEVEL_DEBUG
+#endif
+
+/*!
+ * \brief Level kept at run time, LOG_LEVEL_ERROR to LOG_LEVEL_DEBUG
+ *
+ * A statement that is in the image is only recorded if its level is at or
+ * below this threshold as well, see log_set_threshold(). Written with a
+ * single store, read without a lock.
+ */
+extern volatile uint8_t log_threshold;
+
+/*
+ * A source file selects its module by defining LOG_MODULE before its first
+ * include, and optionally the prefix of its messages with LOG_TAG:
+ *
+ *     #define LOG_MODULE  BRINGUP
+ *     #define LOG_TAG     "Bring-up: "
+ *
+ * The module then gets the level of LOG_LEVEL_BRINGUP if that is defined,
+ * set by the LOG_MODULE_LEVELS option of CMakeLists.txt, and LOG_LEVEL
+ * otherwise. The name of a module must not be one of the levels.
+ */
+#define LOG_CAT(a, b)         a ## b
+#define LOG_XCAT(a, b)        LOG_CAT(a, b)
+
+#if defined(LOG_MODULE) && (LOG_XCAT(LOG_LEVEL_, LOG_MODULE) > 0)
+#define LOG_MODULE_LEVEL      LOG_XCAT(LOG_LEVEL_, LOG_MODULE)
+#else
+#define LOG_MODULE_LEVEL      LOG_LEVEL
+#endif
+
+#ifndef LOG_TAG
+#define LOG_TAG               ""
+#endif
+
+/// \}
+
+/*!
+ * \brief Log a message of a level, like LOG() with the prefix of the module
+ *
+ * A statement above the level of the module expands to nothing, its
+ * arguments are not evaluated and the format string is not in the image.
+ * A statement above log_threshold only costs the compare.
+ *
+ * Example: LOG_INFO("ready after %u ms\r\n", ms);
+ */
+#define LOG_AT(level, ...) \
+    (((level) <= log_threshold) ? LOG(LOG_TAG __VA_ARGS__) : (void)0)
+
+#if (LOG_MODULE_LEVEL >= LOG_LEVEL_ERROR)
+#define LOG_ERROR(...)  LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...)  ((void)0)
+#endif
+
+#if (LOG_MODULE_LEVEL >= LOG_LEVEL_WARN)
+#define LOG_WARN(...)   LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...)   ((void)0)
+#endif
+
+#if (LOG_MODULE_LEVEL >= LOG_LEVEL_INFO)
+#define LOG_INFO(...)   LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...)   ((void)0)
+#endif
+
+#if (LOG_MODULE_LEVEL >= LOG_LEVEL_DEBUG)
+#define LOG_DEBUG(...)  LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...)  ((void)0)
+#endif
+
+/// A single deferred log record
+typedef struct
+{
+    uint32_t timestamp;             ///< mono_ms() when the record was made
+    const char *fmt;                ///< printf style format string
+    uintptr_t args[LOG_MAX_ARGS];   ///< Raw arguments, pointer sized
+    volatile uint8_t ready;         ///< Set when the record is complete
+}
+log_record_t;
+
+// Function prototypes
+void log_init(UBaseType_t priority);
+void log_write(const char *fmt, uintptr_t a0, uintptr_t a1, uintptr_t a2,
+               uintptr_t a3);
+uint32_t log_dropped(void);
+void log_set_threshold(const uint8_t level);
+uint8_t log_get_threshold(void);
+
+#endif // LOG_H
@@ -0,0 +1,502 @@
+/*! ***************************************************************************
+ *
+ * \brief     Tickless idle with LPTMR0 wakeup from VLPS or LLS
+ * \file      lowpower.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "lowpower.h"
+#include "clock.h"
+#include "irq_prio.h"
+#include "powerprof.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (LP_TICKLESS_LPTMR == 1)
+
+#if (configUSE_TICKLESS_IDLE != 1)
+#error "LP_TICKLESS_LPTMR requires configUSE_TICKLESS_IDLE"
+#endif
+
+// SysTick tickless idle of the port, used when a stop mode is not allowed
+extern void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime);
+
+#endif
+
+// Number of lp_deep_block() calls without lp_deep_unblock() of every client
+static volatile uint32_t blockers[LP_CLIENTS];
+
+// Registered drivers
+static lp_notifier_t *notifiers = NULL;
+
+// Mode of the sleep in progress, its start in run-time counts and the
+// source that ended it, see lp_pre_sleep()
+static uint32_t sleep_mode = LP_RUN;
+static configRUN_TIME_COUNTER_TYPE sleep_start = 0;
+static uint32_t sleep_wake = POWERPROF_WAKE_OTHER;
+
+/*!
+ * \brief Prepares the stop modes and LPTMR0
+ *
+ * Call before the scheduler is started. Does nothing when LP_TICKLESS_LPTMR
+ * is 0. VLPS and LLS are allowed by SystemInit(), SMC->PMPROT can only be
+ * written once.
+ */
+void lp_init(void)
+{
+#if (LP_TICKLESS_LPTMR == 1)
+    // One LPTMR0 count of the 1 kHz LPO is one tick
+    configASSERT(configTICK_RATE_HZ == 1000);
+
+    clk_gate_acquire(CLK_GATE_LPTMR);
+
+    LPTMR0->CSR = 0;
+
+    // Keep MCGIRCLK, and with it the RTC clock on CLKOUT, running in stop
+    MCG->C1 |= MCG_C1_IREFSTEN_MASK;
+
+    // The interrupt only ends the sleep, it is handled before it is taken
+    NVIC_SetPriority(LPTMR0_IRQn, IRQ_PRIO(LPTMR));
+    NVIC_ClearPendingIRQ(LPTMR0_IRQn);
+    NVIC_EnableIRQ(LPTMR0_IRQn);
+
+#if (LP_STOP_MODE == LP_LLS)
+    // LPTMR0 is wakeup module 0
+    LLWU->ME |= LLWU_ME_WUME0_MASK;
+
+    NVIC_SetPriority(LLWU_IRQn, IRQ_PRIO(LLWU));
+    NVIC_ClearPendingIRQ(LLWU_IRQn);
+    NVIC_EnableIRQ(LLWU_IRQn);
+#endif
+#endif
+}
+
+/*!
+ * \brief Returns the bit mask of the clients with an lp_deep_block() in
+ *        effect, call with interrupts masked
+ */
+static uint32_t lp_deep_blockers(void)
+{
+    uint32_t clients = 0;
+
+    for(uint32_t i=0; i<LP_CLIENTS; i++)
+    {
+        if(blockers[i] != 0)
+        {
+            clients |= 1UL << i;
+        }
+    }
+
+    return clients;
+}
+
+/*!
+ * \brief Returns true if a driver uses the clock gate of a peripheral
+ */
+static inline bool lp_used(const clk_gate_t gate)
+{
+    return clk_gate_users(gate) > 0;
+}
+
+/*!
+ * \brief Finds the first peripheral that needs the clocks that stop
+ *
+ * Only peripherals with a driver that acquired their clock gate are read,
+ * a released peripheral is gated and cannot need the clocks.
+ *
+ * \return The reason, LP_VETOES if a stop mode may be entered
+ */
+static lp_veto_t lp_deep_veto(void)
+{
+    if(lp_deep_blockers() != 0)
+    {
+        return LP_VETO_BLOCKED;
+    }
+
+    if(lp_used(CLK_GATE_UART0) &&
+       ((UART0->C2 & (UART0_C2_TIE_MASK | UART0_C2_TCIE_MASK)) ||
+        ((UART0->C2 & UART0_C2_TE_MASK) && !(UART0->S1 & UART0_S1_TC_MASK))))
+    {
+        return LP_VETO_UART0;
+    }
+
+    if(lp_used(CLK_GATE_DMA))
+    {
+        for(uint32_t i=0; i<4; i++)
+        {
+            if(DMA0->DMA[i].DSR_BCR & DMA_DSR_BCR_BSY_MASK)
+            {
+                return LP_VETO_DMA;
+            }
+        }
+    }
+
+    if((lp_used(CLK_GATE_I2C0) && (I2C0->S & I2C_S_BUSY_MASK)) ||
+       (lp_used(CLK_GATE_I2C1) && (I2C1->S & I2C_S_BUSY_MASK)))
+    {
+        return LP_VETO_I2C;
+    }
+
+    if(lp_used(CLK_GATE_ADC0) && (ADC0->SC2 & ADC_SC2_ADACT_MASK))
+    {
+        return LP_VETO_ADC;
+    }
+
+    if((lp_used(CLK_GATE_TPM0) && (TPM0->SC & TPM_SC_CMOD_MASK)) ||
+       (lp_used(CLK_GATE_TPM1) && (TPM1->SC & TPM_SC_CMOD_MASK)) ||
+       (lp_used(CLK_GATE_TPM2) && (TPM2->SC & TPM_SC_CMOD_MASK)))
+    {
+        return LP_VETO_TPM;
+    }
+
+    if(lp_used(CLK_GATE_PIT) &&
+       (PIT->CHANNEL[1].TCTRL & PIT_TCTRL_TEN_MASK))
+    {
+        return LP_VETO_PIT1;
+    }
+
+    if(lp_used(CLK_GATE_USBOTG) &&
+       (USB0->CONTROL & USB_CONTROL_DPPULLUPNONOTG_MASK))
+    {
+        return LP_VETO_USB;
+    }
+
+    return LP_VETOES;
+}
+
+/*!
+ * \brief Checks that no peripheral needs the clocks that stop
+ *
+ * A stop mode freezes the bus clock and the PLL, so it is not entered while
+ * UART0 transmits, a DMA channel or an I2C bus is busy, the ADC converts,
+ * a TPM counts, PIT channel 1 runs or lp_deep_block() is in effect. PIT0,
+ * the run-time counter, stops while the MCU sleeps, the sleep is then not
+ * counted as run time of the idle task. A peripheral whose clock gate was
+ * released with clk_gate_release() is off and does not keep it out.
+ *
+ * \return True if a stop mode may be entered
+ */
+bool lp_deep_allowed(void)
+{
+    return lp_deep_veto() == LP_VETOES;
+}
+
+/*!
+ * \brief Keeps the MCU out of the stop modes until lp_deep_unblock()
+ *
+ * For a peripheral that the checks of lp_deep_allowed() do not see, for
+ * example while a character may be received on UART0. Calls nest and may be
+ * made from an interrupt handler. The sleeps that are blocked are counted
+ * for the client by the power profiler.
+ *
+ * \param[in]  client  Driver that needs the clocks
+ */
+void lp_deep_block(const lp_client_t client)
+{
+    configASSERT(client < LP_CLIENTS);
+
+    const uint32_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        blockers[client]++;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+/*!
+ * \brief Ends an lp_deep_block() of the same client
+ *
+ * \param[in]  client  Driver that no longer needs the clocks
+ */
+void lp_deep_unblock(const lp_client_t client)
+{
+    configASSERT(client < LP_CLIENTS);
+
+    const uint32_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        if(blockers[client] > 0)
+        {
+            blockers[client]--;
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+/*!
+ * \brief Registers a driver for the stop modes
+ *
+ * For a peripheral that keeps working in a stop mode on another clock, for
+ * example UART0 on OSCERCLK. Registering a notifier again only updates the
+ * callback and argument. Call from a task or before the scheduler is
+ * started.
+ *
+ * \param[out] n         Notifier, must remain valid
+ * \param[in]  callback  Called before and after every stop mode
+ * \param[in]  arg       Argument of the callback
+ */
+void lp_register(lp_notifier_t *n, lp_callback_t callback, void *arg)
+{
+    taskENTER_CRITICAL();
+    {
+        n->callback = callback;
+        n->arg = arg;
+
+        lp_notifier_t *p = notifiers;
+
+        while((p != NULL) && (p != n))
+        {
+            p = p->next;
+        }
+
+        if(p == NULL)
+        {
+            n->next = notifiers;
+            notifiers = n;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Starts a sleep, configPRE_SLEEP_PROCESSING() of the tickless idle
+ *
+ * Called with interrupts masked right before the WFI, by the SysTick
+ * tickless idle of the port for LP_WAIT and by
+ * lp_suppress_ticks_and_sleep() for a stop mode.
+ */
+void lp_pre_sleep(void)
+{
+    if(sleep_mode == LP_RUN)
+    {
+        sleep_mode = LP_WAIT;
+    }
+
+    sleep_start = portGET_RUN_TIME_COUNTER_VALUE();
+}
+
+/*!
+ * \brief Ends a sleep, configPOST_SLEEP_PROCESSING() of the tickless idle
+ *
+ * Called with interrupts still masked after the WFI, so the interrupt that
+ * ended the sleep is pending. The lowest pending and enabled interrupt is
+ * counted as the wake-up source. A stop mode is counted by
+ * lp_suppress_ticks_and_sleep(), the run-time counter stops with the bus
+ * clock.
+ */
+void lp_post_sleep(void)
+{
+    const uint32_t pending = NVIC->ISPR[0] & NVIC->ISER[0];
+
+    if(SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        sleep_wake = POWERPROF_WAKE_SYSTICK;
+    }
+    else if(pending != 0)
+    {
+        sleep_wake = (uint32_t)__builtin_ctz(pending);
+    }
+    else
+    {
+        sleep_wake = POWERPROF_WAKE_OTHER;
+    }
+
+    if(sleep_mode == LP_WAIT)
+    {
+#if (LP_PROFILE == 1)
+        const configRUN_TIME_COUNTER_TYPE counts =
+            portGET_RUN_TIME_COUNTER_VALUE() - sleep_start;
+
+        powerprof_sleep(LP_WAIT, powerprof_counts_to_us(counts), sleep_wake);
+#endif
+        sleep_mode = LP_RUN;
+    }
+}
+
+#if (LP_TICKLESS_LPTMR == 1)
+/*!
+ * \brief Calls all registered drivers, with interrupts masked
+ */
+static void lp_notify(const lp_event_t event)
+{
+    for(lp_notifier_t *n = notifiers; n != NULL; n = n->next)
+    {
+        n->callback(event, n->arg);
+    }
+}
+
+/*!
+ * \brief Switches back to the PLL after a stop mode
+ *
+ * The MCG leaves a stop mode that was entered in PEE mode in PBE mode, the
+ * core then runs from the 8 MHz crystal until the PLL has locked. The FLL
+ * and VLPR modes of the clock manager do not use the PLL, they return to
+ * their own clock.
+ */
+static void lp_clock_restore(void)
+{
+    if(((MCG->S & MCG_S_CLKST_MASK) == MCG_S_CLKST(3)) ||
+        !(MCG->C6 & MCG_C6_PLLS_MASK))
+    {
+        return;
+    }
+
+    while(!(MCG->S & MCG_S_LOCK0_MASK))
+    {}
+
+    MCG->C1 &= ~MCG_C1_CLKS_MASK;
+
+    while((MCG->S & MCG_S_CLKST_MASK) != MCG_S_CLKST(3))
+    {}
+}
+
+/*!
+ * \brief Sleeps in LP_STOP_MODE for at most the expected idle time
+ *
+ * Implements portSUPPRESS_TICKS_AND_SLEEP(). SysTick is stopped and LPTMR0
+ * is started to expire at the expected idle time. On wake-up the elapsed
+ * whole ticks are added to the tick count and SysTick restarts with a full
+ * period, so up to one tick is lost per early wake-up. The LPO is only
+ * accurate to a few percent, the RTC keeps the wall-clock time. The drivers
+ * of lp_register() are notified around the WFI.
+ *
+ * \param[in]  expected  Expected idle time in ticks
+ */
+void lp_suppress_ticks_and_sleep(const uint32_t expected)
+{
+    uint32_t ticks = (expected > LP_MAX_TICKS) ? LP_MAX_TICKS : expected;
+
+    if(ticks < LP_MIN_TICKS)
+    {
+#if (LP_PROFILE == 1)
+        powerprof_veto(LP_VETO_SHORT, 0);
+#endif
+        vPortSuppressTicksAndSleep(expected);
+        return;
+    }
+
+    __disable_irq();
+
+    const lp_veto_t veto = lp_deep_veto();
+
+    if(veto != LP_VETOES)
+    {
+#if (LP_PROFILE == 1)
+        powerprof_veto(veto, lp_deep_blockers());
+#endif
+        __enable_irq();
+        vPortSuppressTicksAndSleep(expected);
+        return;
+    }
+
+    // Stop the tick, it continues where it was if the sleep is aborted
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+    if(eTaskConfirmSleepModeStatus() == eAbortSleep)
+    {
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        __enable_irq();
+        return;
+    }
+
+    // Count the LPO, the flag is set after ticks counts
+    LPTMR0->CSR = 0;
+    LPTMR0->PSR = LPTMR_PSR_PCS(1) | LPTMR_PSR_PBYP_MASK;
+    LPTMR0->CMR = ticks - 1;
+    LPTMR0->CSR = LPTMR_CSR_TIE_MASK | LPTMR_CSR_TEN_MASK;
+
+    sleep_mode = LP_STOP_MODE;
+    configPRE_SLEEP_PROCESSING(ticks);
+
+    if(ticks > 0)
+    {
+        SMC->PMCTRL = (SMC->PMCTRL & ~SMC_PMCTRL_STOPM_MASK) |
+                      SMC_PMCTRL_STOPM(LP_STOP_MODE);
+
+        // The read makes sure the write is done before the WFI
+        (void)SMC->PMCTRL;
+
+        lp_notify(LP_PRE_STOP);
+
+        SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+        __asm volatile("dsb" ::: "memory");
+        __asm volatile("wfi");
+        __asm volatile("isb");
+        SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+        lp_clock_restore();
+        lp_notify(LP_POST_STOP);
+    }
+
+    configPOST_SLEEP_PROCESSING(ticks);
+
+    // A write latches the counter for the read
+    const bool expired = (LPTMR0->CSR & LPTMR_CSR_TCF_MASK) != 0;
+    LPTMR0->CNR = 0;
+    const uint32_t elapsed = LPTMR0->CNR & LPTMR_CNR_COUNTER_MASK;
+
+    // Stopping the timer clears the counter, write 1 clears the flag
+    LPTMR0->CSR = LPTMR_CSR_TCF_MASK;
+    NVIC_ClearPendingIRQ(LPTMR0_IRQn);
+
+#if (LP_PROFILE == 1)
+    // One count is 1 ms of the LPO
+    powerprof_sleep(LP_STOP_MODE, (expired ? ticks : elapsed) * 1000UL,
+                    sleep_wake);
+#endif
+    sleep_mode = LP_RUN;
+
+    if(expired && (ticks > 0))
+    {
+        // The tick that unblocks a task is counted by the tick interrupt,
+        // which is made pending
+        vTaskStepTick(ticks - 1);
+        SCB->ICSR = SCB_ICSR_PENDSTSET_Msk;
+    }
+    else
+    {
+        vTaskStepTick(elapsed);
+    }
+
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    __enable_irq();
+}
+
+void LPTMR0_IRQHandler(void)
+{
+    // Only pending if the flag was set after the sleep was handled
+    LPTMR0->CSR = LPTMR_CSR_TCF_MASK;
+}
+
+#if (LP_STOP_MODE == LP_LLS)
+void LLWU_IRQHandler(void)
+{
+    // The module flag is cleared with the LPTMR0 flag
+    LPTMR0->CSR = LPTMR_CSR_TCF_MASK;
+}
+#endif
+
+#endif // LP_TICKLESS_LPTMR
@@ -0,0 +1,179 @@
+/*! ***************************************************************************
+ *
+ * \brief     Tickless idle with LPTMR0 wakeup from VLPS or LLS
+ * \file      lowpower.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef LOWPOWER_H
+#define LOWPOWER_H
+
+#include <MKL25Z4.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/// \name Definitions for the low power idle
+/// \{
+
+/*!
+ * \brief Set to 1 to let the tickless idle stop the clocks
+ *
+ * The idle time is then timed by LPTMR0 on the 1 kHz LPO, which keeps
+ * running in VLPS and LLS, so the MCU can sleep for up to 65 s at uA
+ * currents. LPTMR0 is no longer available to the FreeMASTER recorder. The
+ * SysTick tickless idle of the port is used when a peripheral needs the
+ * fast clocks, see lp_deep_allowed().
+ */
+#ifndef LP_TICKLESS_LPTMR
+#define LP_TICKLESS_LPTMR  (0)
+#endif
+
+/*!
+ * \brief Set to 1 to profile the time in the power modes and the reasons a
+ *        stop mode was not entered, see powerprof.h
+ */
+#ifndef LP_PROFILE
+#define LP_PROFILE         (1)
+#endif
+
+/*!
+ * \brief Power modes, the stop modes are the STOPM values of the SMC
+ *
+ * LP_WAIT is the sleep of the SysTick tickless idle, with the core clock
+ * stopped. Any interrupt ends VLPS. Only LPTMR0, through LLWU module 0,
+ * ends LLS, so with LP_LLS pin and UART interrupts are lost while the MCU
+ * sleeps.
+ */
+#define LP_RUN             (0)
+#define LP_WAIT            (1)
+#define LP_VLPS            (2)
+#define LP_LLS             (3)
+#define LP_MODES           (4)
+
+/*!
+ * \brief Stop mode of the SMC, LP_VLPS or LP_LLS
+ */
+
+#ifndef LP_STOP_MODE
+#define LP_STOP_MODE       LP_VLPS
+#endif
+
+/*!
+ * \brief Shortest expected idle time in ticks that is spent in a stop mode
+ *
+ * Waking up takes the PLL about 1 ms to lock, shorter idle times use the
+ * SysTick tickless idle of the port.
+ */
+#ifndef LP_MIN_TICKS
+#define LP_MIN_TICKS       (10)
+#endif
+
+/*!
+ * \brief Longest time in ticks in a stop mode, the range of LPTMR0
+ */
+#define LP_MAX_TICKS       (0x10000UL)
+
+/// \}
+
+/// Drivers that keep the MCU out of the stop modes with lp_deep_block()
+typedef enum
+{
+    LP_CLIENT_SERIAL,   ///< While a character may be received on UART0
+    LP_CLIENT_APP,      ///< The application
+    LP_CLIENTS
+}
+lp_client_t;
+
+/// Reasons a stop mode was not entered
+typedef enum
+{
+    LP_VETO_SHORT,      ///< Expected idle time below LP_MIN_TICKS
+    LP_VETO_BLOCKED,    ///< lp_deep_block() of one or more clients
+    LP_VETO_UART0,      ///< UART0 transmits
+    LP_VETO_DMA,        ///< A DMA channel is busy
+    LP_VETO_I2C,        ///< An I2C bus is busy
+    LP_VETO_ADC,        ///< The ADC converts
+    LP_VETO_TPM,        ///< A TPM counts
+    LP_VETO_PIT1,       ///< PIT channel 1 runs
+    LP_VETO_USB,        ///< USB0 is attached to the bus
+    LP_VETOES
+}
+lp_veto_t;
+
+/// Moment of a stop mode a driver is notified of
+typedef enum
+{
+    LP_PRE_STOP,        ///< Right before the WFI, the clocks still run
+    LP_POST_STOP,       ///< After the wake-up, the PLL has locked again
+}
+lp_event_t;
+
+/*!
+ * \brief Called before and after every stop mode
+ *
+ * Called by lp_suppress_ticks_and_sleep() with interrupts masked, so it must
+ * be short and must not call the kernel. Not called for the SysTick tickless
+ * idle, which keeps the clocks running.
+ *
+ * \param[in]  event  LP_PRE_STOP or LP_POST_STOP
+ * \param[in]  arg    Argument given to lp_register()
+ */
+typedef void (*lp_callback_t)(const lp_event_t event, void *arg);
+
+/*!
+ * \brief Registration of a driver, owned by the driver
+ */
+typedef struct lp_notifier
+{
+    lp_callback_t callback;
+    void *arg;
+    struct lp_notifier *next;
+}
+lp_notifier_t;
+
+// Function prototypes
+void lp_init(void);
+bool lp_deep_allowed(void);
+void lp_deep_block(const lp_client_t client);
+void lp_deep_unblock(const lp_client_t client);
+void lp_register(lp_notifier_t *n, lp_callback_t callback, void *arg);
+void lp_suppress_ticks_and_sleep(const uint32_t expected);
+void lp_pre_sleep(void);
+void lp_post_sleep(void);
+
+#if (LP_TICKLESS_LPTMR == 1)
+// FreeRTOS hook, expanded in the idle task
+#define portSUPPRESS_TICKS_AND_SLEEP(xExpectedIdleTime) \
+    lp_suppress_ticks_and_sleep(xExpectedIdleTime)
+#endif
+
+#if (LP_PROFILE == 1)
+// FreeRTOS hooks around the WFI of the tickless idle, with interrupts masked
+#define configPRE_SLEEP_PROCESSING(x)   lp_pre_sleep()
+#define configPOST_SLEEP_PROCESSING(x)  lp_post_sleep()
+#endif
+
+#endif // LOWPOWER_H
@@ -0,0 +1,197 @@
+/*! ***************************************************************************
+ *
+ * \brief     Word and multi-word memory copy and fill
+ * \file      mem.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "mem.h"
+
+/*
+ * newlib-nano's memcpy() and memset() are small and byte oriented, and the
+ * firmware is built with -fno-builtin so the compiler does not inline them
+ * either. Their byte loop costs about 7 cycles per byte on the Cortex-M0+.
+ * These move four words with a single ldm and stm, 13 cycles for 16 bytes
+ * from and to SRAM. The buffers that are copied often, such as the Oled
+ * framebuffers, are word aligned for them.
+ *
+ * A copy between two buffers with a different alignment cannot use words
+ * and is done in bytes. Builds for other cores, such as the host simulation,
+ * use plain word loops.
+ */
+
+#if defined(__ARM_ARCH_6M__)
+#define MEM_USE_LDM     (1)
+#else
+#define MEM_USE_LDM     (0)
+#endif
+
+/*!
+ * \brief Copies words between word aligned buffers
+ *
+ * \param[out] dst    Destination, word aligned
+ * \param[in]  src    Source, word aligned, must not overlap \p dst
+ * \param[in]  words  Number of words
+ */
+void mem_copy32(uint32_t *dst, const uint32_t *src, size_t words)
+{
+#if (MEM_USE_LDM == 1)
+    size_t blocks = words / 4;
+
+    if(blocks > 0)
+    {
+        __asm volatile(
+            "   .syntax unified                 \n"
+            "1: ldmia %[s]!, {r3, r4, r5, r6}   \n"
+            "   stmia %[d]!, {r3, r4, r5, r6}   \n"
+            "   subs  %[n], %[n], #1            \n"
+            "   bne   1b                        \n"
+            : [d] "+l" (dst), [s] "+l" (src), [n] "+l" (blocks)
+            :
+            : "r3", "r4", "r5", "r6", "cc", "memory");
+    }
+
+    words %= 4;
+#endif
+
+    while(words-- > 0)
+    {
+        *dst++ = *src++;
+    }
+}
+
+/*!
+ * \brief Fills a word aligned buffer with a word
+ *
+ * \param[out] dst    Destination, word aligned
+ * \param[in]  value  Word written
+ * \param[in]  words  Number of words
+ */
+void mem_fill32(uint32_t *dst, const uint32_t value, size_t words)
+{
+#if (MEM_USE_LDM == 1)
+    size_t blocks = words / 4;
+
+    if(blocks > 0)
+    {
+        __asm volatile(
+            "   .syntax unified                 \n"
+            "   mov   r3, %[v]                  \n"
+            "   mov   r4, %[v]                  \n"
+            "   mov   r5, %[v]                  \n"
+            "   mov   r6, %[v]                  \n"
+            "1: stmia %[d]!, {r3, r4, r5, r6}   \n"
+            "   subs  %[n], %[n], #1            \n"
+            "   bne   1b                        \n"
+            : [d] "+l" (dst), [n] "+l" (blocks)
+            : [v] "l" (value)
+            : "r3", "r4", "r5", "r6", "cc", "memory");
+    }
+
+    words %= 4;
+#endif
+
+    while(words-- > 0)
+    {
+        *dst++ = value;
+    }
+}
+
+/*!
+ * \brief Copies bytes, like memcpy()
+ *
+ * Buffers with the same alignment are copied in words after a head of up to
+ * three bytes.
+ *
+ * \param[out] dst  Destination
+ * \param[in]  src  Source, must not overlap \p dst
+ * \param[in]  n    Number of bytes
+ *
+ * \return \p dst
+ */
+void *mem_copy(void *dst, const void *src, size_t n)
+{
+    uint8_t *d = dst;
+    const uint8_t *s = src;
+
+    if((n >= MEM_WORD_MIN) && ((((uintptr_t)d ^ (uintptr_t)s) & 3) == 0))
+    {
+        while(((uintptr_t)d & 3) != 0)
+        {
+            *d++ = *s++;
+            n--;
+        }
+
+        mem_copy32((uint32_t *)(void *)d, (const uint32_t *)(const void *)s, n / 4);
+
+        d += n & ~(size_t)3;
+        s += n & ~(size_t)3;
+        n &= 3;
+    }
+
+    while(n-- > 0)
+    {
+        *d++ = *s++;
+    }
+
+    return dst;
+}
+
+/*!
+ * \brief Fills bytes with a value, like memset()
+ *
+ * \param[out] dst  Destination
+ * \param[in]  c    Value, only the lowest byte is used
+ * \param[in]  n    Number of bytes
+ *
+ * \return \p dst
+ */
+void *mem_set(void *dst, const int c, size_t n)
+{
+    uint8_t *d = dst;
+    const uint8_t b = (uint8_t)c;
+
+    if(n >= MEM_WORD_MIN)
+    {
+        while(((uintptr_t)d & 3) != 0)
+        {
+            *d++ = b;
+            n--;
+        }
+
+        mem_fill32((uint32_t *)(void *)d, b * 0x01010101UL, n / 4);
+
+        d += n & ~(size_t)3;
+        n &= 3;
+    }
+
+    while(n-- > 0)
+    {
+        *d++ = b;
+    }
+
+    return dst;
+}
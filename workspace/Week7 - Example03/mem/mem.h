@@ -0,0 +1,57 @@
+/*! ***************************************************************************
+ *
+ * \brief     Word and multi-word memory copy and fill
+ * \file      mem.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef MEM_H
+#define MEM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// \name Definitions for the memory copy and fill
+/// \{
+
+/*!
+ * \brief Shortest copy or fill in bytes that is done in words
+ *
+ * Below this the alignment of the head and tail costs more than words save.
+ */
+#ifndef MEM_WORD_MIN
+#define MEM_WORD_MIN    (16)
+#endif
+
+/// \}
+
+// Function prototypes
+void mem_copy32(uint32_t *dst, const uint32_t *src, size_t words);
+void mem_fill32(uint32_t *dst, const uint32_t value, size_t words);
+void *mem_copy(void *dst, const void *src, size_t n);
+void *mem_set(void *dst, const int c, size_t n);
+
+#endif // MEM_H
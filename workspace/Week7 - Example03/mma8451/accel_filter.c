@@ -0,0 +1,376 @@
+/*! ***************************************************************************
+ *
+ * \brief     Integer filters for accelerometer samples
+ * \file      accel_filter.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "accel_filter.h"
+
+/*!
+ * \brief Initialises the filter for a single axis
+ *
+ * For ACCEL_FILTER_IIR \p param is the shift of the low-pass filter: the
+ * filter constant is 1 / 2^param. For ACCEL_FILTER_AVERAGE \p param is the
+ * number of samples, limited to ACCEL_FILTER_MAX_LENGTH. For
+ * ACCEL_FILTER_BIQUAD \p param is the cutoff frequency in percent of the
+ * sample rate, 1 to 45. Its coefficients are calculated here in floating
+ * point, so initialise the filter once and not per block.
+ *
+ * \param[out] s      Filter
+ * \param[in]  type   Filter type
+ * \param[in]  param  IIR shift, moving average length or cutoff
+ */
+void accel_filter_stage_init(accel_filter_stage_t *s,
+    const accel_filter_type_t type, const uint8_t param)
+{
+    s->type = type;
+    s->param = param;
+    s->index = 0;
+    s->count = 0;
+    s->acc = 0;
+
+    if(type == ACCEL_FILTER_IIR)
+    {
+        // Keep (x << 8) >> param meaningful
+        if(s->param > 15)
+        {
+            s->param = 15;
+        }
+    }
+    else if(type == ACCEL_FILTER_AVERAGE)
+    {
+        if(s->param == 0)
+        {
+            s->param = 1;
+        }
+        else if(s->param > ACCEL_FILTER_MAX_LENGTH)
+        {
+            s->param = ACCEL_FILTER_MAX_LENGTH;
+        }
+    }
+    else if(type == ACCEL_FILTER_BIQUAD)
+    {
+        if(s->param == 0)
+        {
+            s->param = 1;
+        }
+        else if(s->param > 45)
+        {
+            s->param = 45;
+        }
+
+        dsp_biquad_init(&s->biquad, 1, s->coeffs, s->state,
+                        dsp_biquad_lowpass(s->coeffs, s->param, 100));
+    }
+}
+
+/*!
+ * \brief Filters a single sample
+ *
+ * The first sample initialises the filter, so there is no start-up ramp.
+ *
+ * \param[in,out] s  Filter
+ * \param[in]     x  Sample
+ *
+ * \return Filtered sample
+ */
+int16_t accel_filter_stage_update(accel_filter_stage_t *s, const int16_t x)
+{
+    switch(s->type)
+    {
+    case ACCEL_FILTER_IIR:
+        if(s->count == 0)
+        {
+            s->acc = (int32_t)x << 8;
+            s->count = 1;
+        }
+        else
+        {
+            s->acc += (((int32_t)x << 8) - s->acc) >> s->param;
+        }
+
+        return (int16_t)((s->acc + 128) >> 8);
+
+    case ACCEL_FILTER_AVERAGE:
+        if(s->count == s->param)
+        {
+            s->acc -= s->window[s->index];
+        }
+        else
+        {
+            s->count++;
+        }
+
+        s->window[s->index] = x;
+        s->acc += x;
+
+        if(++s->index == s->param)
+        {
+            s->index = 0;
+        }
+
+        return (int16_t)(s->acc / s->count);
+
+    case ACCEL_FILTER_BIQUAD:
+    {
+        int16_t y;
+
+        accel_filter_stage_block(s, &x, &y, 1);
+        return y;
+    }
+
+    default:
+        return x;
+    }
+}
+
+/*!
+ * \brief Filters a block of samples of a single axis
+ *
+ * ACCEL_FILTER_BIQUAD filters the block at once with dsp_biquad(), the
+ * other types sample by sample. The first sample initialises the filter.
+ * \p out may be the same array as \p in.
+ *
+ * \param[in,out] s    Filter
+ * \param[in]     in   Samples
+ * \param[out]    out  Filtered samples
+ * \param[in]     n    Number of samples
+ */
+void accel_filter_stage_block(accel_filter_stage_t *s, const int16_t in[],
+    int16_t out[], const uint32_t n)
+{
+    if(s->type != ACCEL_FILTER_BIQUAD)
+    {
+        for(uint32_t i=0; i<n; ++i)
+        {
+            out[i] = accel_filter_stage_update(s, in[i]);
+        }
+
+        return;
+    }
+
+    if((s->count == 0) && (n > 0))
+    {
+        dsp_biquad_preset(&s->biquad, in[0]);
+        s->count = 1;
+    }
+
+    dsp_biquad(&s->biquad, in, out, n);
+}
+
+/*!
+ * \brief Initialises the filter for all axes
+ *
+ * All axes get the same filter. For a different filter per axis, call
+ * accel_filter_stage_init() for f->axis[0], f->axis[1] or f->axis[2]
+ * afterwards.
+ *
+ * \param[out] f           Filter
+ * \param[in]  type        Filter type
+ * \param[in]  param       IIR shift or moving average length
+ * \param[in]  decimation  Output one of every \p decimation samples, 0 or 1
+ *                         outputs every sample
+ */
+void accel_filter_init(accel_filter_t *f, const accel_filter_type_t type,
+    const uint8_t param, const uint8_t decimation)
+{
+    for(uint32_t i=0; i<3; ++i)
+    {
+        accel_filter_stage_init(&f->axis[i], type, param);
+    }
+
+    f->decimation = (decimation == 0) ? 1 : decimation;
+    f->phase = 0;
+}
+
+/*!
+ * \brief Filters and decimates a block of samples
+ *
+ * Intended for the samples read by mma8451_fifo_read(). Every sample is
+ * filtered, but only one of every f->decimation samples is written to
+ * \p out, with the timestamp of that sample. The decimation phase is kept
+ * between calls, so blocks do not have to be a multiple of the decimation.
+ *
+ * \p out may be the same array as \p in.
+ *
+ * \param[in,out] f    Filter
+ * \param[in]     in   Samples
+ * \param[in]     n    Number of samples in \p in
+ * \param[out]    out  Filtered samples, at least n / f->decimation + 1
+ *
+ * \return Number of samples written to \p out
+ */
+uint32_t accel_filter_block(accel_filter_t *f, const mma8451_sample_t in[],
+    const uint32_t n, mma8451_sample_t out[])
+{
+    int16_t axis[3][ACCEL_FILTER_CHUNK];
+    uint32_t m = 0;
+
+    // The axes are separated into blocks, filtered per axis and decimated.
+    // Never more than the samples read so far are written, so out[] may
+    // alias in[].
+    for(uint32_t first=0; first<n; first+=ACCEL_FILTER_CHUNK)
+    {
+        const uint32_t len = ((n - first) < ACCEL_FILTER_CHUNK) ?
+                             (n - first) : ACCEL_FILTER_CHUNK;
+        uint32_t t_us[ACCEL_FILTER_CHUNK];
+
+        for(uint32_t i=0; i<len; ++i)
+        {
+            axis[0][i] = in[first + i].x;
+            axis[1][i] = in[first + i].y;
+            axis[2][i] = in[first + i].z;
+            t_us[i] = in[first + i].t_us;
+        }
+
+        for(uint32_t a=0; a<3; ++a)
+        {
+            accel_filter_stage_block(&f->axis[a], axis[a], axis[a], len);
+        }
+
+        for(uint32_t i=0; i<len; ++i)
+        {
+            if(++f->phase < f->decimation)
+            {
+                continue;
+            }
+
+            f->phase = 0;
+
+            out[m].x = axis[0][i];
+            out[m].y = axis[1][i];
+            out[m].z = axis[2][i];
+            out[m].t_us = t_us[i];
+            m++;
+        }
+    }
+
+    return m;
+}
+
+/*!
+ * \brief Calculates the mean and the root mean square of a block per axis
+ *
+ * With the samples of mma8451_fifo_read() the mean is the static
+ * acceleration, and the RMS of a block of the output of a high-pass or of
+ * the samples minus the mean is the vibration level. The RMS is limited to
+ * 8191 counts, the 14-bit full scale.
+ *
+ * \param[in]  in     Samples
+ * \param[in]  n      Number of samples, 1 to ACCEL_FILTER_STATS_MAX
+ * \param[out] stats  Mean and RMS of x, y and z
+ */
+void accel_filter_stats(const mma8451_sample_t in[], const uint32_t n,
+    accel_filter_stats_t *stats)
+{
+    int16_t block[ACCEL_FILTER_STATS_MAX];
+    const uint32_t len = (n < ACCEL_FILTER_STATS_MAX) ? n : ACCEL_FILTER_STATS_MAX;
+
+    for(uint32_t a=0; a<3; ++a)
+    {
+        // 14-bit counts in the upper bits, so the Q15 RMS keeps its
+        // resolution
+        for(uint32_t i=0; i<len; ++i)
+        {
+            block[i] = (int16_t)(((a == 0) ? in[i].x : (a == 1) ? in[i].y : in[i].z) * 4);
+        }
+
+        stats->mean[a] = dsp_mean(block, len) / 4;
+        stats->rms[a] = dsp_rms(block, len) / 4;
+    }
+}
+
+/*!
+ * \brief Initialises a complementary filter
+ *
+ * \param[out] c      Filter
+ * \param[in]  shift  Correction weight 1 / 2^shift towards the measured angle
+ */
+void accel_filter_comp_init(accel_filter_comp_t *c, const uint8_t shift)
+{
+    c->angle = 0;
+    c->shift = (shift > 15) ? 15 : shift;
+    c->valid = false;
+}
+
+/*!
+ * \brief Updates a complementary filter
+ *
+ * The previous angle is advanced by \p rate over \p dt_us and then corrected
+ * towards the measured \p angle, for example a result of
+ * mma8451_rollpitch_fixed(). The MMA8451 does not measure a rate, so without
+ * another sensor \p rate is 0 and the filter is a low-pass on the angle that
+ * handles the wrap around at +/-180 degrees.
+ *
+ * \param[in,out] c      Filter
+ * \param[in]     rate   Angular rate in centi-degrees per second
+ * \param[in]     angle  Measured angle in centi-degrees
+ * \param[in]     dt_us  Time since the previous update in us, see dt_us
+ *
+ * \return Filtered angle in centi-degrees
+ */
+int16_t accel_filter_comp_update(accel_filter_comp_t *c, const int32_t rate,
+    const int16_t angle, const uint32_t dt_us)
+{
+    const int32_t full = 36000L << 8;
+    const int32_t half = 18000L << 8;
+
+    if(!c->valid)
+    {
+        c->angle = (int32_t)angle << 8;
+        c->valid = true;
+    }
+    else
+    {
+        // Integrate the rate
+        c->angle += (int32_t)(((int64_t)rate * dt_us * 256) / 1000000);
+
+        // Correct towards the measured angle along the shortest way
+        int32_t diff = ((int32_t)angle << 8) - c->angle;
+        while(diff > half)
+        {
+            diff -= full;
+        }
+        while(diff < -half)
+        {
+            diff += full;
+        }
+
+        c->angle += diff >> c->shift;
+    }
+
+    while(c->angle > half)
+    {
+        c->angle -= full;
+    }
+    while(c->angle < -half)
+    {
+        c->angle += full;
+    }
+
+    return (int16_t)((c->angle + 128) >> 8);
+}
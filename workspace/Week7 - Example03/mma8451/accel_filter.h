@@ -0,0 +1,137 @@
+/*! ***************************************************************************
+ *
+ * \brief     Integer filters for accelerometer samples
+ * \file      accel_filter.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef ACCEL_FILTER_H
+#define ACCEL_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dsp.h"
+#include "mma8451.h"
+
+/// \name Definitions for the accelerometer filters
+/// \{
+
+/*!
+ * \brief Maximum length of a moving average
+ */
+#define ACCEL_FILTER_MAX_LENGTH (16)
+
+/*!
+ * \brief Number of samples per axis filtered at once by
+ *        accel_filter_block(), the stack holds three blocks
+ */
+#define ACCEL_FILTER_CHUNK      (8)
+
+/*!
+ * \brief Most samples of a block for accel_filter_stats(), the FIFO size
+ */
+#define ACCEL_FILTER_STATS_MAX  (32)
+
+/// \}
+
+/// Filter types
+typedef enum
+{
+    ACCEL_FILTER_NONE,    ///< Pass samples unchanged
+    ACCEL_FILTER_IIR,     ///< First order low-pass, y += (x - y) / 2^param
+    ACCEL_FILTER_AVERAGE, ///< Moving average of param samples
+    ACCEL_FILTER_BIQUAD,  ///< Butterworth low-pass, cutoff param % of the rate
+}
+accel_filter_type_t;
+
+/// Filter for a single axis
+///
+/// All state is kept in the structure, so no memory is allocated. The low-pass
+/// of ACCEL_FILTER_BIQUAD points into the structure, so do not copy it after
+/// the initialisation.
+typedef struct
+{
+    accel_filter_type_t type; ///< Filter type
+    uint8_t param;            ///< IIR shift or moving average length
+    uint8_t index;            ///< Next position in window
+    uint8_t count;            ///< Number of samples in window
+    int32_t acc;              ///< IIR output in Q8, or sum of window
+    int16_t window[ACCEL_FILTER_MAX_LENGTH]; ///< Moving average samples
+    dsp_biquad_t biquad;      ///< Low-pass of ACCEL_FILTER_BIQUAD
+    int16_t coeffs[DSP_BIQUAD_COEFFS]; ///< Coefficients of the low-pass
+    int16_t state[DSP_BIQUAD_STATE];   ///< State of the low-pass
+}
+accel_filter_stage_t;
+
+/// Filter for the x, y and z axis, followed by decimation
+typedef struct
+{
+    accel_filter_stage_t axis[3]; ///< Filters for x, y and z
+    uint8_t decimation;           ///< Output one of every decimation samples
+    uint8_t phase;                ///< Samples since the last output
+}
+accel_filter_t;
+
+/// Block statistics of the x, y and z axis, in 14-bit counts
+typedef struct
+{
+    int16_t mean[3]; ///< Mean of x, y and z
+    int16_t rms[3];  ///< Root mean square of x, y and z
+}
+accel_filter_stats_t;
+
+/// Complementary filter for an angle
+///
+/// Integrates a rate and corrects the result towards a measured angle. The
+/// angle is kept in centi-degrees in Q8.
+typedef struct
+{
+    int32_t angle;  ///< Filtered angle in centi-degrees, Q8
+    uint8_t shift;  ///< Correction weight 1 / 2^shift
+    bool valid;     ///< False until the first update
+}
+accel_filter_comp_t;
+
+// Function prototypes
+void accel_filter_stage_init(accel_filter_stage_t *s,
+    const accel_filter_type_t type, const uint8_t param);
+int16_t accel_filter_stage_update(accel_filter_stage_t *s, const int16_t x);
+void accel_filter_stage_block(accel_filter_stage_t *s, const int16_t in[],
+    int16_t out[], const uint32_t n);
+
+void accel_filter_init(accel_filter_t *f, const accel_filter_type_t type,
+    const uint8_t param, const uint8_t decimation);
+uint32_t accel_filter_block(accel_filter_t *f, const mma8451_sample_t in[],
+    const uint32_t n, mma8451_sample_t out[]);
+void accel_filter_stats(const mma8451_sample_t in[], const uint32_t n,
+    accel_filter_stats_t *stats);
+
+void accel_filter_comp_init(accel_filter_comp_t *c, const uint8_t shift);
+int16_t accel_filter_comp_update(accel_filter_comp_t *c, const int32_t rate,
+    const int16_t angle, const uint32_t dt_us);
+
+#endif // ACCEL_FILTER_H
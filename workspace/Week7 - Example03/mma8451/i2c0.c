@@ -43,329 +43,53 @@
  *            OTHER DEALINGS IN THE SOFTWARE.
  *
  *****************************************************************************/
-#include <MKL25Z4.h>
 #include "i2c0.h"
 
-static void delay_us(uint32_t d)
-{
-
-#if (CLOCK_SETUP != 1)
-#warning This delay function does not work as designed
-#endif
-
-    volatile uint32_t t;
-
-    for(t=4*d; t>0; t--)
-    {
-        __asm("nop");
-        __asm("nop");
-    }
-}
-
 // Init i2c0
 void i2c0_init(void)
 {
-    // Clock I2C peripheral and port
-    SIM->SCGC4 |= SIM_SCGC4_I2C0_MASK;
-	SIM->SCGC5 |= (SIM_SCGC5_PORTE_MASK);
-
-	// Set pins to I2C function
-	PORTE->PCR[24] |= PORT_PCR_MUX(5);
-	PORTE->PCR[25] |= PORT_PCR_MUX(5);
-
-    // MUL[1:0] : The MULT bits define the multiplier factor mul.
-    // ICR[5:0] : Prescales the bus clock for bit rate selection.
-    //
-    // I2C baud rate = bus speed (Hz)/(mul � SCL divider)
-    //        375000 =     24MHz     /( 1  *    64)
- 	I2C0->F = (I2C_F_ICR(0x12) | I2C_F_MULT(0));
-
-    // Enable i2c and set to master mode
-    I2C0->C1 |= (I2C_C1_IICEN_MASK);
+    i2c_init(&i2c_bus0);
 }
 
-// Start sequence
-void i2c0_start()
+// Set the i2c0 bit rate, see i2c_set_speed()
+uint32_t i2c0_set_speed(const uint32_t bps)
 {
-    // Make sure bus free time is 1.3 us (t_BUF).
-    delay_us(2);
-
-    // Set to transmit mode
-    I2C0->C1 |= I2C_C1_TX_MASK;
-
-    // Generate start condition
-    I2C0->C1 |= I2C_C1_MST_MASK;
-}
-
-// Send device and register addresses
-bool i2c0_read_setup(uint8_t address, uint8_t reg)
-{
-    // Send the address
-    I2C0->D = address;
-
-    // Wait for acknowledge
-    // Return anyway if it takes too long
-    uint32_t timeout = I2C_TIMEOUT;
-    while((I2C0->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }
-
-    // Clear the flag
-    I2C0->S |= I2C_S_IICIF_MASK;
-
-    // Send register
-    I2C0->D = reg;
-
-    // Wait for acknowledge
-    // If timeout occurs, try to reinitialise i2c and return from this function
-    timeout = I2C_TIMEOUT;
-    while((I2C0->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }
-
-    // Clear the flag
-    I2C0->S |= I2C_S_IICIF_MASK;
-
-    // Repeated start
-    I2C0->C1 |= I2C_C1_RSTA_MASK;
-
-    // Send device address (read)
-    I2C0->D = (address | 0x01);
-
-    // Wait for acknowledge
-    // If timeout occurs, try to reinitialise i2c and return from this function
-    timeout = I2C_TIMEOUT;
-    while((I2C0->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }
-
-    // Clear the flag
-    I2C0->S |= I2C_S_IICIF_MASK;
-
-    // Receive mode
-    I2C0->C1 &= ~I2C_C1_TX_MASK;
-
-    return true;
+    return i2c_set_speed(&i2c_bus0, bps);
 }
 
-// Read a repeated byte and ack/nack as appropriate
-bool i2c0_repeated_read(bool last, uint8_t *data)
+// Achieved i2c0 bit rate in bps
+uint32_t i2c0_get_speed(void)
 {
-	if(last)
-    {
-        // NACK after read
-        I2C0->C1 |= I2C_C1_TXAK_MASK;
-	}
-    else
-    {
-        // ACK after read
-        I2C0->C1 &= ~I2C_C1_TXAK_MASK;
-	}
-
-    // Dummy read
-    *data = I2C0->D;
-
-    // Wait for acknowledge
-    // If timeout occurs, try to reinitialise i2c and return from this function
-    uint32_t timeout = I2C_TIMEOUT;
-    while((I2C0->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }
-
-    // Clear the flag
-    I2C0->S |= I2C_S_IICIF_MASK;
-
-	if(last)
-    {
-        // Send stop
-        I2C0->C1 &= ~I2C_C1_MST_MASK;
-	}
-
-    // Read data
-    *data = I2C0->D;
-
-	return true;
+    return i2c_get_speed(&i2c_bus0);
 }
 
 // Functions for reading and writing a single byte
 
 bool i2c0_read_byte(uint8_t address, uint8_t reg, uint8_t *data)
 {
-    // Make sure bus free time is 1.3 us (t_BUF).
-    delay_us(2);
-
-    // Set to transmit mode
-    I2C0->C1 |= I2C_C1_TX_MASK;
-
-    // Generate start condition
-    I2C0->C1 |= I2C_C1_MST_MASK;
-
-    // Send the address
-    I2C0->D = address;
-
-    // Wait for acknowledge
-    // Return anyway if it takes too long
-    uint32_t timeout = I2C_TIMEOUT;
-    while((I2C0->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }
-
-    // Clear the flag
-    I2C0->S |= I2C_S_IICIF_MASK;
-
-    // Send register
-    I2C0->D = reg;
-
-    // Wait for acknowledge
-    // If timeout occurs, try to reinitialise i2c and return from this function
-    timeout = I2C_TIMEOUT;
-    while((I2C0->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }
-
-    // Clear the flag
-    I2C0->S |= I2C_S_IICIF_MASK;
-
-    // Repeated start
-    I2C0->C1 |= I2C_C1_RSTA_MASK;
-
-    // Send device address (read)
-    I2C0->D = (address | 0x01);
-
-    // Wait for acknowledge
-    // If timeout occurs, try to reinitialise i2c and return from this function
-    timeout = I2C_TIMEOUT;
-    while((I2C0->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }
-
-    // Clear the flag
-    I2C0->S |= I2C_S_IICIF_MASK;
-
-    // Receive mode
-    I2C0->C1 &= ~I2C_C1_TX_MASK;
-
-    // NACK after read
-    I2C0->C1 |= I2C_C1_TXAK_MASK;
-
-    // Dummy read
-    *data = I2C0->D;
-
-    // Wait for acknowledge
-    // If timeout occurs, try to reinitialise i2c and return from this function
-    timeout = I2C_TIMEOUT;
-    while((I2C0->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }
-
-    // Clear the flag
-    I2C0->S |= I2C_S_IICIF_MASK;
-
-    // Send stop
-    I2C0->C1 &= ~I2C_C1_MST_MASK;
-
-    // Read LSB
-    *data = I2C0->D;
-
-	return true;
+    return i2c_read(&i2c_bus0, address, reg, data, 1);
 }
 
 bool i2c0_write_byte(uint8_t address, uint8_t reg, uint8_t data)
 {
-    // Make sure bus free time is 1.3 us (t_BUF).
-    delay_us(2);
-
-    // Set to transmit mode
-    I2C0->C1 |= I2C_C1_TX_MASK;
-
-    // Generate start condition
-    I2C0->C1 |= I2C_C1_MST_MASK;
-
-    // Send the address
-    I2C0->D = address;
-
-    // Wait for acknowledge
-    // Return anyway if it takes too long
-    uint32_t timeout = I2C_TIMEOUT;
-    while((I2C0->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }
-
-    // Clear the flag
-    I2C0->S |= I2C_S_IICIF_MASK;
-
-    // Send register
-    I2C0->D = reg;
-
-    // Wait for acknowledge
-    // If timeout occurs, try to reinitialise i2c and return from this function
-    timeout = I2C_TIMEOUT;
-    while((I2C0->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }
-
-    // Clear the flag
-    I2C0->S |= I2C_S_IICIF_MASK;
-
-    // Send lsb
-    I2C0->D = data;
-
-    // Wait for acknowledge
-    // If timeout occurs, try to reinitialise i2c and return from this function
-    timeout = I2C_TIMEOUT;
-    while((I2C0->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }
+    return i2c_write(&i2c_bus0, address, reg, &data, 1);
+}
 
-    // Clear the flag
-    I2C0->S |= I2C_S_IICIF_MASK;
+// Read n consecutive registers, starting at reg. Uses the transaction queue
+// while the scheduler is running, polling otherwise.
+bool i2c0_read(uint8_t address, uint8_t reg, uint8_t *data, uint32_t n)
+{
+    return i2c_read(&i2c_bus0, address, reg, data, n);
+}
 
-    // Send stop
-    I2C0->C1 &= ~I2C_C1_MST_MASK;
+// Queue a transaction, see i2c_submit()
+void i2c0_submit(i2c0_xfer_t *t)
+{
+    i2c_submit(&i2c_bus0, t);
+}
 
-    return true;
+// Wait for a transaction submitted by the calling task, see i2c_wait()
+bool i2c0_wait(i2c0_xfer_t *t, const TickType_t timeout)
+{
+    return i2c_wait(&i2c_bus0, t, timeout);
 }
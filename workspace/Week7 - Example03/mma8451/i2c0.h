@@ -46,24 +46,22 @@
 #ifndef I2C0_H
 #define I2C0_H
 
-#include <stdint.h>
-#include <stdbool.h>
+#include "i2c.h"
 
 /*!
- * \brief Definition for the I2C timeout
- *
- * This timeout value is used in loops to wait for a bit to set/reset. If the
- * bit doesn't get set, the function returns.
+ * \brief Transaction descriptor, see i2c_xfer_t
  */
-#define I2C_TIMEOUT (10000)
+typedef i2c_xfer_t i2c0_xfer_t;
 
 void i2c0_init(void);
+uint32_t i2c0_set_speed(const uint32_t bps);
+uint32_t i2c0_get_speed(void);
 
-void i2c0_start(void);
-bool i2c0_read_setup(uint8_t address, uint8_t reg);
-bool i2c0_repeated_read(bool last, uint8_t *data);
-	
 bool i2c0_read_byte(uint8_t address, uint8_t reg, uint8_t *data);
 bool i2c0_write_byte(uint8_t address, uint8_t reg, uint8_t data);
+bool i2c0_read(uint8_t address, uint8_t reg, uint8_t *data, uint32_t n);
+
+void i2c0_submit(i2c0_xfer_t *t);
+bool i2c0_wait(i2c0_xfer_t *t, const TickType_t timeout);
 
 #endif // I2C0_H
@@ -1,22 +1,40 @@
 #include <MKL25Z4.h>
-#include <math.h>
+#include <stdlib.h>
 
 #include "FreeRTOS.h"
 #include "task.h"
 
+#include "delay.h"
+#include "flashlog.h"
 #include "mma8451.h"
+#include "mono.h"
+#include "irq_prio.h"
+#include "seqlock.h"
+
+#if (MMA8451_USE_FLOAT == 1)
+#include <math.h>
+#endif
 
 #if (CLOCK_SETUP != 1)
   #warning This driver does not work as designed
 #endif
 
+#if (MMA8451_USE_FLOAT == 1)
 #define M_PI (3.14159265f)
-
-//extern TaskHandle_t xMma8451TaskHandler;
+#endif
 
 int16_t x_out_14_bit = 0,
         y_out_14_bit = 0,
         z_out_14_bit = 0;
+int16_t x_out_mg = 0,
+        y_out_mg = 0,
+        z_out_mg = 0;
+int16_t roll_cdeg = 0,
+        pitch_cdeg = 0;
+
+uint32_t dt_us = 0;
+
+#if (MMA8451_USE_FLOAT == 1)
 float x_out_g = 0,
       y_out_g = 0,
       z_out_g = 0;
@@ -24,22 +42,82 @@ float roll = 0.0,
       pitch = 0.0;
 
 float dt = 0;
+#endif
 
-// Local function prototypes
+uint32_t mma8451_fifo_overflows = 0;
 
-static void delay_us(uint32_t d)
+// The results published after every update, read by mma8451_get_state()
+static mma8451_state_t state_copies[2];
+static seqlock_t state_lock = SEQLOCK_INIT(state_copies);
+
+// Acquisition settings, applied by mma8451_init()
+static mma8451_config_t config =
 {
+    .odr = MMA8451_ODR_100HZ,
+    .range = MMA8451_RANGE_2G,
+    .fast_read = false,
+    .low_noise = true,
+};
 
-#if (CLOCK_SETUP != 1)
-#warning This delay function does not work as designed
-#endif
+uint32_t mma8451_drdy_missed = 0;
+
+// Number of times the chip was reinitialised because a read failed despite
+// the retries and bus recovery of the I2C driver
+uint32_t mma8451_reinits = 0;
+
+// The offsets in the OFF registers, 0 until a calibration is loaded from
+// the flash log on the first mma8451_init() or made by mma8451_calibrate()
+static mma8451_cal_t cal = {0};
+static bool cal_valid = false;
+static bool cal_loaded = false;
+
+// Number of calibrations written to the flash log
+uint32_t mma8451_cal_saves = 0;
+
+// Task notified by the FIFO watermark or DRDY interrupt
+static TaskHandle_t irq_task = NULL;
+
+// Run time in us of the last INT1 edge
+static volatile uint32_t irq_us = 0;
+
+// Task notified by the embedded function interrupt on INT2
+static TaskHandle_t events_task = NULL;
+
+// Interrupt enable (CTRL_REG4) and wake (CTRL_REG3) bits of the embedded
+// functions, kept when the data interrupt on INT1 is reconfigured
+static uint8_t events_int = 0;
+static uint8_t events_wake = 0;
+
+// Sample period in us for every ODR
+static const uint32_t odr_period_us[] =
+{
+    1250, 2500, 5000, 10000, 20000, 80000, 160000, 640000,
+};
+
+static uint32_t fifo_period = 0;
+
+// Number of samples read since mma8451_fifo_start()
+static uint32_t fifo_count = 0;
+
+// Raw FIFO contents, 6 bytes per sample or 3 in fast read mode
+static uint8_t fifo_data[MMA8451_FIFO_SIZE * 6];
 
-    volatile uint32_t t;
+// Local function prototypes
+static void mma8451_convert(void);
+static void mma8451_unpack(const uint8_t data[], int16_t *x, int16_t *y,
+    int16_t *z);
+static uint8_t mma8451_ctrl_reg1(void);
+static void mma8451_set_dt(void);
+static void mma8451_publish(void);
+static bool mma8451_write_offsets(void);
 
-    for(t=4*d; t>0; t--)
+// Gives the bus and the processor to the other tasks between two polls of a
+// status bit. Before the scheduler runs the poll goes on at once.
+static void mma8451_poll_wait(void)
+{
+    if(xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
     {
-        __asm("nop");
-        __asm("nop");
+        vTaskDelay(1);
     }
 }
 
@@ -67,20 +145,22 @@ bool mma8451_init(void)
         return false;
     }
 
-    // Wait for RST bit to clear
+    // Wait for RST bit to clear, the reset takes about 1 ms
     value = 0;
     do
     {
+        mma8451_poll_wait();
+
         // Read the register
         if(!(i2c0_read_byte(MMA8451_ADDRESS, CTRL_REG2, &value)))
         {
             return false;
         }
     }
-    while((value & 0x40) == 0);
+    while((value & 0x40) != 0);
 
-    // +/-2g range -> 1g = 16384/4 = 4096 counts
-    if(!(i2c0_write_byte(MMA8451_ADDRESS, XYZ_DATA_CFG_REG, 0x00)))
+    // Range, +/-2g by default -> 1g = 16384/4 = 4096 counts
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, XYZ_DATA_CFG_REG, config.range)))
     {
         return false;
     }
@@ -91,8 +171,34 @@ bool mma8451_init(void)
         return false;
     }
 
-    // ODR = 100 Hz, Reduced noise, Active mode
-    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, 0x1D)))
+    // The stored calibration, so it does not have to be repeated at boot. A
+    // record with offsets a flat board cannot have is ignored.
+    if(!cal_loaded)
+    {
+        mma8451_cal_t stored;
+
+        cal_loaded = true;
+
+        if(flog_config_load(MMA8451_CAL_FLOG_TYPE, &stored, sizeof(stored)) &&
+           (abs(stored.x) <= (MMA8451_CAL_FLAT_MG / 2)) &&
+           (abs(stored.y) <= (MMA8451_CAL_FLAT_MG / 2)) &&
+           (abs(stored.z) <= (MMA8451_CAL_FLAT_MG / 2)) &&
+           (stored.range <= MMA8451_RANGE_8G))
+        {
+            cal = stored;
+            cal_valid = true;
+        }
+    }
+
+    // The reset cleared the offsets, the device is still in standby mode
+    if(cal_valid && !mma8451_write_offsets())
+    {
+        return false;
+    }
+
+    // ODR, reduced noise and fast read as configured, Active mode. By
+    // default ODR = 100 Hz, Reduced noise.
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, mma8451_ctrl_reg1())))
     {
         return false;
     }
@@ -102,8 +208,12 @@ bool mma8451_init(void)
 	SIM->SCGC5 |= SIM_SCGC5_PORTA_MASK;
 	PORTA->PCR[14] = PORT_PCR_ISF_MASK | PORT_PCR_MUX(0x1) | PORT_PCR_IRQC(0xA);
 
+	// Configure the PTA15, connected to the INT2 of the MMA8451Q, for
+    // interrupts on falling edges. INT2 is used for the embedded functions.
+	PORTA->PCR[15] = PORT_PCR_ISF_MASK | PORT_PCR_MUX(0x1) | PORT_PCR_IRQC(0xA);
+
 	// Enable interrupts
-    NVIC_SetPriority(PORTA_IRQn, 64);
+    NVIC_SetPriority(PORTA_IRQn, IRQ_PRIO(MMA8451));
     NVIC_ClearPendingIRQ(PORTA_IRQn);
     NVIC_EnableIRQ(PORTA_IRQn);
 
@@ -113,13 +223,20 @@ bool mma8451_init(void)
     return true;
 }
 
+// Corrects the offsets with a sample of the board lying flat and at rest,
+// stores them in the flash log and starts DRDY interrupts. mma8451_init()
+// applies the stored offsets, so this is only needed once per board or
+// when mma8451_cal_drifted(). Returns false if a transfer failed or the
+// board was not flat, then the offsets in use are kept.
 bool mma8451_calibrate(void)
 {
     uint8_t value = 0;
 
-    // Wait for data
+    // Wait for data, up to a sample period
     do
     {
+        mma8451_poll_wait();
+
         // Read the status register
         if(!(i2c0_read_byte(MMA8451_ADDRESS, STATUS_REG, &value)))
         {
@@ -131,41 +248,48 @@ bool mma8451_calibrate(void)
     // Read values
     mma8451_read();
 
-    // Calculate offsets as described in AN4069
-    signed char x_offset = -1 * (x_out_14_bit >> 3);
-    signed char y_offset = -1 * (y_out_14_bit >> 3);
-    signed char z_offset = COUNTS_PER_G - (z_out_14_bit >> 3);
+    // Calculate offsets as described in AN4069, 2 mg per LSB. The sample
+    // already includes the offsets in use, so the error is added to them.
+    const int32_t x_new = cal.x - (x_out_mg / 2);
+    const int32_t y_new = cal.y - (y_out_mg / 2);
+    const int32_t z_new = cal.z + ((1000 - z_out_mg) / 2);
 
-    // Standby mode
-    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, 0x00)))
-    {
-        return false;
-    }
+    // A board that is not flat and at rest keeps the offsets in use
+    const bool flat = (abs(x_new) <= (MMA8451_CAL_FLAT_MG / 2)) &&
+                      (abs(y_new) <= (MMA8451_CAL_FLAT_MG / 2)) &&
+                      (abs(z_new) <= (MMA8451_CAL_FLAT_MG / 2));
 
-    // Offsets
-    if(!(i2c0_write_byte(MMA8451_ADDRESS, OFF_X_REG, x_offset)))
+    if(flat)
     {
-        return false;
+        cal.x = (int8_t)x_new;
+        cal.y = (int8_t)y_new;
+        cal.z = (int8_t)z_new;
+        cal.odr = (uint8_t)config.odr;
+        cal.range = (uint8_t)config.range;
+        cal.low_noise = config.low_noise;
+        cal_valid = true;
     }
 
-    if(!(i2c0_write_byte(MMA8451_ADDRESS, OFF_Y_REG, y_offset)))
+    // Standby mode
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, 0x00)))
     {
         return false;
     }
 
-    if(!(i2c0_write_byte(MMA8451_ADDRESS, OFF_Z_REG, z_offset)))
+    // Offsets
+    if(!mma8451_write_offsets())
     {
         return false;
     }
 
     // Push-pull, active low interrupt
-    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG3, 0x00)))
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG3, events_wake)))
     {
         return false;
     }
 
     // Enable DRDY interrupt
-    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG4, 0x01)))
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG4, 0x01 | events_int)))
     {
         return false;
     }
@@ -176,11 +300,11 @@ bool mma8451_calibrate(void)
         return false;
     }
 
-    // ODR = 100 Hz, Reduced noise, Active mode
+    // ODR as configured, Active mode
     // Notice that delta dt is fixed, because it is set by ODR and DRDY
     // interrupts are enabled. This doesn't require a timer to measure delta t.
-    dt = 0.010f;
-    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, 0x1D)))
+    mma8451_set_dt();
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, mma8451_ctrl_reg1())))
     {
         return false;
     }
@@ -188,70 +312,757 @@ bool mma8451_calibrate(void)
     // Make sure the time between I2C transfers is > t_BUF (1.3 us)
     delay_us(10);
 
+    // Stored for the next boot, an unchanged calibration is not written
+    if(flat && flog_config_save(MMA8451_CAL_FLOG_TYPE, &cal, sizeof(cal)))
+    {
+        mma8451_cal_saves++;
+    }
+
+    return flat;
+}
+
+// Copy of the calibration in use, returns false if the offsets are 0
+// because there is no calibration
+bool mma8451_get_cal(mma8451_cal_t *c)
+{
+    *c = cal;
+
+    return cal_valid;
+}
+
+// Returns true if a flat board at rest reads more than MMA8451_CAL_DRIFT_MG
+// away from 0, 0 and 1 g on any axis, the mean of some samples in mg. A
+// board tilted more than MMA8451_CAL_FLAT_MG is not judged.
+bool mma8451_cal_drifted(const int32_t x_mg, const int32_t y_mg,
+                         const int32_t z_mg)
+{
+    const int32_t e_x = abs(x_mg);
+    const int32_t e_y = abs(y_mg);
+    const int32_t e_z = abs(z_mg - 1000);
+
+    if((e_x > MMA8451_CAL_FLAT_MG) || (e_y > MMA8451_CAL_FLAT_MG) ||
+       (e_z > MMA8451_CAL_FLAT_MG))
+    {
+        return false;
+    }
+
+    return (e_x > MMA8451_CAL_DRIFT_MG) || (e_y > MMA8451_CAL_DRIFT_MG) ||
+           (e_z > MMA8451_CAL_DRIFT_MG);
+}
+
+// Writes the offsets of cal, the device must be in standby mode
+static bool mma8451_write_offsets(void)
+{
+    return i2c0_write_byte(MMA8451_ADDRESS, OFF_X_REG, (uint8_t)cal.x) &&
+           i2c0_write_byte(MMA8451_ADDRESS, OFF_Y_REG, (uint8_t)cal.y) &&
+           i2c0_write_byte(MMA8451_ADDRESS, OFF_Z_REG, (uint8_t)cal.z);
+}
+
+// Change the acquisition settings. The device is put in standby mode while
+// the settings are written. A FIFO or DRDY interrupt configuration is kept.
+// In the 8g range reduced noise is not available and is switched off.
+bool mma8451_configure(const mma8451_config_t *cfg)
+{
+    config = *cfg;
+
+    if(config.range == MMA8451_RANGE_8G)
+    {
+        config.low_noise = false;
+    }
+
+    // Standby mode, the range can only be changed in standby mode
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, 0x00)))
+    {
+        return false;
+    }
+
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, XYZ_DATA_CFG_REG, config.range)))
+    {
+        return false;
+    }
+
+    mma8451_set_dt();
+    fifo_period = odr_period_us[config.odr];
+
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, mma8451_ctrl_reg1())))
+    {
+        return false;
+    }
+
     return true;
 }
 
+void mma8451_get_config(mma8451_config_t *cfg)
+{
+    *cfg = config;
+}
+
+// CTRL_REG1 value for the settings in config, Active mode
+static uint8_t mma8451_ctrl_reg1(void)
+{
+    uint8_t value = (config.odr << 3) | 0x01;
+
+    if(config.low_noise)
+    {
+        value |= 0x04;
+    }
+
+    if(config.fast_read)
+    {
+        value |= 0x02;
+    }
+
+    return value;
+}
+
+// Set dt to the sample period of the ODR
+static void mma8451_set_dt(void)
+{
+    dt_us = odr_period_us[config.odr];
+#if (MMA8451_USE_FLOAT == 1)
+    dt = (float)dt_us / 1000000.0f;
+#endif
+}
+
 void mma8451_read(void)
 {
-	int i;
 	uint8_t data[6];
 
-    i2c0_start();
-
-	if(!(i2c0_read_setup(MMA8451_ADDRESS, OUT_X_MSB_REG)))
+	// Read six bytes in repeated mode, or three in fast read mode
+	if(!(i2c0_read(MMA8451_ADDRESS, OUT_X_MSB_REG, data,
+	    config.fast_read ? 3 : 6)))
     {
+        // The I2C driver already retried and recovered the bus, so the chip
+        // itself is assumed to have lost its configuration
+        mma8451_reinits++;
         mma8451_init();
         return;
     }
 
-	// Read five bytes in repeated mode
-	for(i=0; i<5; i++)
+    mma8451_unpack(data, &x_out_14_bit, &y_out_14_bit, &z_out_14_bit);
+
+    mma8451_convert();
+    mma8451_publish();
+}
+
+// Publish the results as one consistent copy
+static void mma8451_publish(void)
+{
+    const mma8451_state_t s =
     {
-        if(!(i2c0_repeated_read(false, &data[i])))
-        {
-            mma8451_init();
-            return;
-        }
-	}
+        .x_14_bit = x_out_14_bit,
+        .y_14_bit = y_out_14_bit,
+        .z_14_bit = z_out_14_bit,
+        .x_mg = x_out_mg,
+        .y_mg = y_out_mg,
+        .z_mg = z_out_mg,
+        .roll_cdeg = roll_cdeg,
+        .pitch_cdeg = pitch_cdeg,
+#if (MMA8451_USE_FLOAT == 1)
+        .x_g = x_out_g,
+        .y_g = y_out_g,
+        .z_g = z_out_g,
+        .roll = roll,
+        .pitch = pitch,
+#endif
+    };
+
+    seqlock_write(&state_lock, &s);
+}
+
+// Copy the latest results of mma8451_read() and the roll and pitch
+// functions. Never blocks and can be called from an interrupt handler.
+// Returns the number of updates, which changes when there are new results.
+uint32_t mma8451_get_state(mma8451_state_t *state)
+{
+    return seqlock_read(&state_lock, state);
+}
 
-	// Read last byte ending repeated mode
-	if(!(i2c0_repeated_read(true, &data[i])))
+// Combine the read bytes to 14-bit signed values. In fast read mode only
+// the MSBs are read, these are scaled to 14-bit as well.
+static void mma8451_unpack(const uint8_t data[], int16_t *x, int16_t *y,
+    int16_t *z)
+{
+    if(config.fast_read)
     {
-        mma8451_init();
-        return;
+        *x = (int16_t)((int8_t)data[0] * 64);
+        *y = (int16_t)((int8_t)data[1] * 64);
+        *z = (int16_t)((int8_t)data[2] * 64);
+    }
+    else
+    {
+        *x = (int16_t)((data[0]<<8) | data[1]) >> 2;
+        *y = (int16_t)((data[2]<<8) | data[3]) >> 2;
+        *z = (int16_t)((data[4]<<8) | data[5]) >> 2;
+    }
+}
+
+// Compute the results in mg's, and in g's if enabled. The number of counts
+// per g halves for every step in range.
+static void mma8451_convert(void)
+{
+    const int32_t counts = COUNTS_PER_G >> config.range;
+
+    x_out_mg = (int16_t)(((int32_t)x_out_14_bit * 1000) / counts);
+    y_out_mg = (int16_t)(((int32_t)y_out_14_bit * 1000) / counts);
+    z_out_mg = (int16_t)(((int32_t)z_out_14_bit * 1000) / counts);
+
+#if (MMA8451_USE_FLOAT == 1)
+    x_out_g = (float)x_out_14_bit / counts;
+    y_out_g = (float)y_out_14_bit / counts;
+    z_out_g = (float)z_out_14_bit / counts;
+#endif
+}
+
+// Switch to FIFO mode. The FIFO runs in circular mode and the watermark
+// interrupt on INT1 notifies task (notification index 0) when at least
+// watermark (1..32) samples are available. Call after mma8451_calibrate().
+bool mma8451_fifo_start(const mma8451_odr_t odr, const uint8_t watermark,
+    TaskHandle_t task)
+{
+    if((watermark == 0) || (watermark > MMA8451_FIFO_SIZE))
+    {
+        return false;
+    }
+
+    // Standby mode, the FIFO can only be configured in standby mode
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, 0x00)))
+    {
+        return false;
+    }
+
+    // Circular FIFO with watermark
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, F_SETUP_REG, 0x40 | watermark)))
+    {
+        return false;
+    }
+
+    // Push-pull, active low interrupt
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG3, events_wake)))
+    {
+        return false;
+    }
+
+    // Enable FIFO interrupt only
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG4, 0x40 | events_int)))
+    {
+        return false;
+    }
+
+    // FIFO interrupt routed to INT1 - PTA14
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG5, 0x40)))
+    {
+        return false;
+    }
+
+    config.odr = odr;
+
+    irq_task = task;
+    fifo_period = odr_period_us[odr];
+    fifo_count = 0;
+    mma8451_set_dt();
+
+    // ODR, reduced noise and fast read as configured, Active mode
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, mma8451_ctrl_reg1())))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+// Drain up to max samples from the FIFO in a single burst read. The number
+// of samples read is stored in n. Reading F_STATUS clears the watermark
+// interrupt. The timestamps are reconstructed from the ODR, so samples
+// overwritten after an overflow are not accounted for. Overflows are counted
+// in mma8451_fifo_overflows. The x, y and z globals are set to the newest
+// sample.
+bool mma8451_fifo_read(mma8451_sample_t samples[], const uint32_t max,
+    uint32_t *n)
+{
+    uint8_t status;
+
+    *n = 0;
+
+    if(!(i2c0_read_byte(MMA8451_ADDRESS, F_STATUS_REG, &status)))
+    {
+        return false;
+    }
+
+    if(status & 0x80)
+    {
+        mma8451_fifo_overflows++;
+    }
+
+    uint32_t cnt = status & 0x3F;
+    if(cnt > max)
+    {
+        cnt = max;
+    }
+
+    if(cnt == 0)
+    {
+        return true;
+    }
+
+    // The FIFO data is read by reading OUT_X_MSB to OUT_Z_LSB repeatedly,
+    // or only the MSBs in fast read mode
+    const uint32_t size = config.fast_read ? 3 : 6;
+
+    if(!(i2c0_read(MMA8451_ADDRESS, OUT_X_MSB_REG, fifo_data, cnt * size)))
+    {
+        return false;
+    }
+
+    for(uint32_t i=0; i<cnt; ++i)
+    {
+        mma8451_unpack(&fifo_data[i * size], &samples[i].x, &samples[i].y,
+            &samples[i].z);
+        samples[i].t_us = fifo_count++ * fifo_period;
+    }
+
+    x_out_14_bit = samples[cnt-1].x;
+    y_out_14_bit = samples[cnt-1].y;
+    z_out_14_bit = samples[cnt-1].z;
+
+    mma8451_convert();
+
+    *n = cnt;
+
+    return true;
+}
+
+// Put the device in standby mode. It stops sampling and raises no FIFO or
+// DRDY interrupts until a start function is called again.
+bool mma8451_standby(void)
+{
+    irq_task = NULL;
+
+    return i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, 0x00);
+}
+
+// Switch to DRDY mode with the calling task as the consumer. The DRDY
+// interrupt on INT1 timestamps every sample and notifies the task
+// (notification index 0). Read the samples with mma8451_drdy_wait().
+bool mma8451_drdy_start(void)
+{
+    // Standby mode
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, 0x00)))
+    {
+        return false;
+    }
+
+    // FIFO disabled
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, F_SETUP_REG, 0x00)))
+    {
+        return false;
+    }
+
+    // Push-pull, active low interrupt
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG3, events_wake)))
+    {
+        return false;
+    }
+
+    // Enable DRDY interrupt
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG4, 0x01 | events_int)))
+    {
+        return false;
+    }
+
+    // DRDY interrupt routed to INT1 - PTA14
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG5, 0x01)))
+    {
+        return false;
+    }
+
+    irq_task = xTaskGetCurrentTaskHandle();
+    mma8451_drdy_missed = 0;
+    mma8451_set_dt();
+
+    // Discard a notification of an earlier mode
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    // ODR, reduced noise and fast read as configured, Active mode
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, mma8451_ctrl_reg1())))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+// Wait for the next sample in DRDY mode. Returns false on a timeout or
+// I2C error.
+//
+// INT1 stays asserted until the sample is read, so a task that falls behind
+// gets no edges for the samples it missed. The time since the last edge
+// tells how many samples were overwritten: these are counted in
+// mma8451_drdy_missed and the timestamp is moved to the sample that is
+// actually read.
+bool mma8451_drdy_wait(mma8451_sample_t *sample, const TickType_t timeout)
+{
+    uint8_t data[7];
+
+    if(ulTaskNotifyTake(pdTRUE, timeout) == 0)
+    {
+        return false;
+    }
+
+    const uint32_t edge = irq_us;
+
+    // Read the status register followed by the samples in repeated mode
+    if(!(i2c0_read(MMA8451_ADDRESS, STATUS_REG, data,
+        config.fast_read ? 4 : 7)))
+    {
+        return false;
+    }
+
+    const uint32_t late = (mono_us32() - edge) / dt_us;
+
+    if(late > 0)
+    {
+        mma8451_drdy_missed += late;
+    }
+    else if(data[0] & 0x80)
+    {
+        // ZYXOW: overwritten, but within the resolution of the estimate
+        mma8451_drdy_missed++;
+    }
+
+    mma8451_unpack(&data[1], &sample->x, &sample->y, &sample->z);
+    sample->t_us = edge + late * dt_us;
+
+    x_out_14_bit = sample->x;
+    y_out_14_bit = sample->y;
+    z_out_14_bit = sample->z;
+
+    mma8451_convert();
+
+    return true;
+}
+
+// Enable the embedded functions in cfg->events with the calling task as
+// the consumer. The events are routed to INT2 and the task is notified
+// (notification index 0), so it can block in mma8451_events_wait() instead
+// of polling samples. Enabled events also wake the device from auto-sleep.
+// A data interrupt on INT1 set up by mma8451_drdy_start() or
+// mma8451_fifo_start() is kept. Use a different task for those, as they
+// use the same notification index.
+bool mma8451_events_start(const mma8451_events_config_t *cfg)
+{
+    const uint8_t ev = cfg->events;
+
+    // Standby mode, the embedded functions can only be configured in
+    // standby mode
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, 0x00)))
+    {
+        return false;
+    }
+
+    // Motion detection: OR of the x, y and z events, latched
+    const uint8_t ff_mt = (ev & MMA8451_EVENT_MOTION) ? 0xF8 : 0x00;
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, FF_MT_CFG_REG, ff_mt)) ||
+       !(i2c0_write_byte(MMA8451_ADDRESS, FF_MT_THS_REG, cfg->motion_ths & 0x7F)) ||
+       !(i2c0_write_byte(MMA8451_ADDRESS, FF_MT_COUNT_REG, cfg->motion_count)))
+    {
+        return false;
+    }
+
+    // Transient detection: high-pass filtered x, y and z events, latched
+    const uint8_t trans = (ev & MMA8451_EVENT_TRANSIENT) ? 0x1E : 0x00;
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, TRANSIENT_CFG_REG, trans)) ||
+       !(i2c0_write_byte(MMA8451_ADDRESS, TRANSIENT_THS_REG, cfg->transient_ths & 0x7F)) ||
+       !(i2c0_write_byte(MMA8451_ADDRESS, TRANSIENT_COUNT_REG, cfg->transient_count)))
+    {
+        return false;
+    }
+
+    // Tap detection: single or double pulses on x, y and z, latched
+    uint8_t pulse = 0x00;
+    if(ev & MMA8451_EVENT_TAP)
+    {
+        pulse = cfg->double_tap ? 0x6A : 0x55;
+    }
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, PULSE_CFG_REG, pulse)) ||
+       !(i2c0_write_byte(MMA8451_ADDRESS, PULSE_THSX_REG, cfg->tap_ths & 0x7F)) ||
+       !(i2c0_write_byte(MMA8451_ADDRESS, PULSE_THSY_REG, cfg->tap_ths & 0x7F)) ||
+       !(i2c0_write_byte(MMA8451_ADDRESS, PULSE_THSZ_REG, cfg->tap_ths & 0x7F)) ||
+       !(i2c0_write_byte(MMA8451_ADDRESS, PULSE_TMLT_REG, cfg->tap_limit)) ||
+       !(i2c0_write_byte(MMA8451_ADDRESS, PULSE_LTCY_REG, cfg->tap_latency)) ||
+       !(i2c0_write_byte(MMA8451_ADDRESS, PULSE_WIND_REG, cfg->tap_window)))
+    {
+        return false;
+    }
+
+    // Portrait/landscape detection, debounce counter cleared on a change
+    const uint8_t pl = (ev & MMA8451_EVENT_ORIENTATION) ? 0xC0 : 0x80;
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, PL_CFG_REG, pl)) ||
+       !(i2c0_write_byte(MMA8451_ADDRESS, PL_COUNT_REG, cfg->orientation_count)))
+    {
+        return false;
+    }
+
+    // Auto-sleep after sleep_count of inactivity, high resolution mode
+    const bool sleep = ((ev & MMA8451_EVENT_SLEEP) && (cfg->sleep_count > 0));
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, ASLP_COUNT_REG, cfg->sleep_count)) ||
+       !(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG2, sleep ? 0x06 : 0x02)))
+    {
+        return false;
+    }
+
+    // The interrupt enable bits of the events equal their INT_SOURCE bits.
+    // The wake bits are WAKE_TRANS, WAKE_LNDPRT, WAKE_PULSE and WAKE_FF_MT.
+    events_int = ev & (MMA8451_EVENT_MOTION | MMA8451_EVENT_TAP |
+        MMA8451_EVENT_ORIENTATION | MMA8451_EVENT_TRANSIENT);
+    if(sleep)
+    {
+        events_int |= MMA8451_EVENT_SLEEP;
+    }
+
+    events_wake = 0;
+    if(ev & MMA8451_EVENT_TRANSIENT)   { events_wake |= 0x40; }
+    if(ev & MMA8451_EVENT_ORIENTATION) { events_wake |= 0x20; }
+    if(ev & MMA8451_EVENT_TAP)         { events_wake |= 0x10; }
+    if(ev & MMA8451_EVENT_MOTION)      { events_wake |= 0x08; }
+
+    // Keep the data interrupt on INT1, if any
+    uint8_t int_en;
+    if(!(i2c0_read_byte(MMA8451_ADDRESS, CTRL_REG4, &int_en)))
+    {
+        return false;
+    }
+    int_en = (int_en & 0x41) | events_int;
+
+    // Push-pull, active low interrupt, wake sources
+    // Interrupts enabled, only data and FIFO routed to INT1 - PTA14, the
+    // embedded functions to INT2 - PTA15
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG3, events_wake)) ||
+       !(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG4, int_en)) ||
+       !(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG5, int_en & 0x41)))
+    {
+        return false;
+    }
+
+    events_task = xTaskGetCurrentTaskHandle();
+
+    // Discard a notification of an earlier configuration
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    // ODR, reduced noise and fast read as configured, Active mode
+    if(!(i2c0_write_byte(MMA8451_ADDRESS, CTRL_REG1, mma8451_ctrl_reg1())))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+// Wait for an embedded function event. Reads INT_SOURCE and the source
+// registers of the events that fired, which clears them and releases INT2.
+// Returns false on a timeout or I2C error.
+bool mma8451_events_wait(mma8451_events_t *ev, const TickType_t timeout)
+{
+    ev->source = 0;
+    ev->motion = 0;
+    ev->tap = 0;
+    ev->orientation = 0;
+    ev->transient = 0;
+    ev->sysmod = 0;
+
+    if(ulTaskNotifyTake(pdTRUE, timeout) == 0)
+    {
+        return false;
+    }
+
+    if(!(i2c0_read_byte(MMA8451_ADDRESS, INT_SOURCE_REG, &ev->source)))
+    {
+        return false;
+    }
+
+    // Leave the data and FIFO sources to their own readers
+    ev->source &= events_int;
+
+    if((ev->source & MMA8451_EVENT_MOTION) &&
+       !(i2c0_read_byte(MMA8451_ADDRESS, FF_MT_SRC_REG, &ev->motion)))
+    {
+        return false;
     }
 
-    // Combine the read bytes to 16-bit values
-    x_out_14_bit = (int16_t)((data[0]<<8) | data[1]);
-    y_out_14_bit = (int16_t)((data[2]<<8) | data[3]);
-    z_out_14_bit = (int16_t)((data[4]<<8) | data[5]);
+    if((ev->source & MMA8451_EVENT_TAP) &&
+       !(i2c0_read_byte(MMA8451_ADDRESS, PULSE_SRC_REG, &ev->tap)))
+    {
+        return false;
+    }
 
-    // Compute 14-bit signed result
-    x_out_14_bit >>= 2;
-    y_out_14_bit >>= 2;
-    z_out_14_bit >>= 2;
+    if((ev->source & MMA8451_EVENT_ORIENTATION) &&
+       !(i2c0_read_byte(MMA8451_ADDRESS, PL_STATUS_REG, &ev->orientation)))
+    {
+        return false;
+    }
 
-    // Compute result in g's
-    x_out_g = (float)x_out_14_bit / COUNTS_PER_G;
-    y_out_g = (float)y_out_14_bit / COUNTS_PER_G;
-    z_out_g = (float)z_out_14_bit / COUNTS_PER_G;
+    if((ev->source & MMA8451_EVENT_TRANSIENT) &&
+       !(i2c0_read_byte(MMA8451_ADDRESS, TRANSIENT_SRC_REG, &ev->transient)))
+    {
+        return false;
+    }
+
+    if((ev->source & MMA8451_EVENT_SLEEP) &&
+       !(i2c0_read_byte(MMA8451_ADDRESS, SYSMOD_REG, &ev->sysmod)))
+    {
+        return false;
+    }
+
+    return true;
 }
 
+#if (MMA8451_USE_FLOAT == 1)
 void mma8451_rollpitch(void)
 {
 	roll = atan2(y_out_g, z_out_g)*180/M_PI;
 	pitch = atan2(x_out_g, sqrt(y_out_g*y_out_g + z_out_g*z_out_g))*180/M_PI;
+
+    mma8451_publish();
+}
+#endif
+
+// Integer square root
+static uint32_t mma8451_isqrt(uint32_t v)
+{
+    uint32_t r = 0;
+    uint32_t b = 1UL << 30;
+
+    while(b > v)
+    {
+        b >>= 2;
+    }
+
+    while(b != 0)
+    {
+        if(v >= r + b)
+        {
+            v -= r + b;
+            r = (r >> 1) + b;
+        }
+        else
+        {
+            r >>= 1;
+        }
+
+        b >>= 2;
+    }
+
+    return r;
+}
+
+// atan2(y, x) in centi-degrees (-18000 to 18000), without floating point.
+// The angle is reduced to the first octant, where atan(t) is approximated by
+// an odd polynomial in Q15. The error is less than 0.02 degree.
+int16_t mma8451_atan2_cdeg(int32_t y, int32_t x)
+{
+    uint32_t ax = (uint32_t)abs(x);
+    uint32_t ay = (uint32_t)abs(y);
+
+    if((ax == 0) && (ay == 0))
+    {
+        return 0;
+    }
+
+    const bool swap = (ay > ax);
+    uint32_t num = swap ? ax : ay;
+    uint32_t den = swap ? ay : ax;
+
+    // Keep num << 15 within 32 bits
+    while(den >= (1UL << 16))
+    {
+        num >>= 1;
+        den >>= 1;
+    }
+
+    // t = num / den in Q15, 0 <= t <= 1
+    const int32_t t = (int32_t)((num << 15) / den);
+    const int32_t t2 = (t * t) >> 15;
+
+    // atan(t) = t * (0.9998660 - 0.3302995 t^2 + 0.1801410 t^4
+    //           - 0.0851330 t^6 + 0.0208351 t^8)
+    int32_t p = 683;
+    p = ((p * t2) >> 15) - 2790;
+    p = ((p * t2) >> 15) + 5903;
+    p = ((p * t2) >> 15) - 10823;
+    p = ((p * t2) >> 15) + 32764;
+    p = (p * t) >> 15;
+
+    // Radians in Q15 to centi-degrees: 18000 / pi / 32768 = 11459 / 65536
+    int32_t a = (p * 11459 + 32768) >> 16;
+
+    if(swap)
+    {
+        a = 9000 - a;
+    }
+
+    if(x < 0)
+    {
+        a = 18000 - a;
+    }
+
+    if(y < 0)
+    {
+        a = -a;
+    }
+
+    return (int16_t)a;
+}
+
+// Fixed-point version of mma8451_rollpitch(), the results are in
+// centi-degrees
+void mma8451_rollpitch_fixed(void)
+{
+    const int32_t x = x_out_14_bit;
+    const int32_t y = y_out_14_bit;
+    const int32_t z = z_out_14_bit;
+
+    roll_cdeg = mma8451_atan2_cdeg(y, z);
+    pitch_cdeg = mma8451_atan2_cdeg(x, (int32_t)mma8451_isqrt((uint32_t)(y*y + z*z)));
+
+    mma8451_publish();
 }
 
 void PORTA_IRQHandler(void)
 {
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    TRACE_ISR_ENTER();
+
     NVIC_ClearPendingIRQ(PORTA_IRQn);
 
-    // Clear the interrupt
-    PORTA->PCR[14] |= PORT_PCR_ISF_MASK;
+    // INT1: data ready or FIFO watermark
+    if(PORTA->PCR[14] & PORT_PCR_ISF_MASK)
+    {
+        // Clear the interrupt
+        PORTA->PCR[14] |= PORT_PCR_ISF_MASK;
+
+        // Timestamp the edge before any scheduling jitter is added
+        irq_us = mono_us32();
+
+        // Notify the task that reads the samples
+        if(irq_task != NULL)
+        {
+            vTaskNotifyGiveFromISR(irq_task, &xHigherPriorityTaskWoken);
+        }
+    }
+
+    // INT2: embedded functions
+    if(PORTA->PCR[15] & PORT_PCR_ISF_MASK)
+    {
+        // Clear the interrupt
+        PORTA->PCR[15] |= PORT_PCR_ISF_MASK;
+
+        if(events_task != NULL)
+        {
+            vTaskNotifyGiveFromISR(events_task, &xHigherPriorityTaskWoken);
+        }
+    }
 
-    // Notify the task
-//    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-//    vTaskNotifyGiveFromISR(xMma8451TaskHandler, &xHigherPriorityTaskWoken);
-//    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    TRACE_ISR_EXIT();
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
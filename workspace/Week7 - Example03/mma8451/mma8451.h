@@ -6,6 +6,7 @@
 #define MMA8451_ADDRESS  (0x3A)
 
 #define STATUS_REG       (0x00)
+#define F_STATUS_REG     (0x00)
 
 #define OUT_X_MSB_REG    (0x01)
 #define OUT_X_LSB_REG    (0x02)
@@ -14,9 +15,37 @@
 #define OUT_Z_MSB_REG    (0x05)
 #define OUT_Z_LSB_REG    (0x06)
 
+#define F_SETUP_REG      (0x09)
+#define SYSMOD_REG       (0x0B)
+#define INT_SOURCE_REG   (0x0C)
 #define XYZ_DATA_CFG_REG (0x0E)
 #define WHO_AM_I_REG     (0x0D)
 
+#define PL_STATUS_REG    (0x10)
+#define PL_CFG_REG       (0x11)
+#define PL_COUNT_REG     (0x12)
+
+#define FF_MT_CFG_REG    (0x15)
+#define FF_MT_SRC_REG    (0x16)
+#define FF_MT_THS_REG    (0x17)
+#define FF_MT_COUNT_REG  (0x18)
+
+#define TRANSIENT_CFG_REG   (0x1D)
+#define TRANSIENT_SRC_REG   (0x1E)
+#define TRANSIENT_THS_REG   (0x1F)
+#define TRANSIENT_COUNT_REG (0x20)
+
+#define PULSE_CFG_REG    (0x21)
+#define PULSE_SRC_REG    (0x22)
+#define PULSE_THSX_REG   (0x23)
+#define PULSE_THSY_REG   (0x24)
+#define PULSE_THSZ_REG   (0x25)
+#define PULSE_TMLT_REG   (0x26)
+#define PULSE_LTCY_REG   (0x27)
+#define PULSE_WIND_REG   (0x28)
+
+#define ASLP_COUNT_REG   (0x29)
+
 #define CTRL_REG1        (0x2A)
 #define CTRL_REG2        (0x2B)
 #define CTRL_REG3        (0x2C)
@@ -31,15 +60,175 @@
 
 #define COUNTS_PER_G     (4096)
 
+// Set to 0 to leave out the floating point results x_out_g, y_out_g,
+// z_out_g, roll, pitch and dt. The Cortex-M0+ has no FPU, so these are
+// computed by the soft-float library. The fixed-point results are always
+// available.
+#ifndef MMA8451_USE_FLOAT
+#define MMA8451_USE_FLOAT (1)
+#endif
+
+#define MMA8451_FIFO_SIZE (32)
+
+// Type of the offset calibration in the settings sector of the flash log
+#define MMA8451_CAL_FLOG_TYPE (0xCA)
+
+// Largest error in mg of a board that is flat and at rest. A calibration
+// with a larger offset is not used and a board tilted further is not
+// checked for drift.
+#define MMA8451_CAL_FLAT_MG (150)
+
+// Error in mg of a flat board at rest above which mma8451_cal_drifted()
+// reports that the calibration should be repeated
+#ifndef MMA8451_CAL_DRIFT_MG
+#define MMA8451_CAL_DRIFT_MG (40)
+#endif
+
+// Output data rates, the value of the DR bits in CTRL_REG1
+typedef enum
+{
+    MMA8451_ODR_800HZ = 0,
+    MMA8451_ODR_400HZ,
+    MMA8451_ODR_200HZ,
+    MMA8451_ODR_100HZ,
+    MMA8451_ODR_50HZ,
+    MMA8451_ODR_12HZ5,
+    MMA8451_ODR_6HZ25,
+    MMA8451_ODR_1HZ56,
+}mma8451_odr_t;
+
+// Full scale ranges, the value of the FS bits in XYZ_DATA_CFG
+typedef enum
+{
+    MMA8451_RANGE_2G = 0,
+    MMA8451_RANGE_4G,
+    MMA8451_RANGE_8G,
+}mma8451_range_t;
+
+// Acquisition settings
+typedef struct
+{
+    mma8451_odr_t odr;      // Output data rate
+    mma8451_range_t range;  // Full scale range
+    bool fast_read;         // 8-bit results: 3 bytes per sample instead of 6
+    bool low_noise;         // Reduced noise, not available in the 8g range
+}mma8451_config_t;
+
+// Offset calibration, stored in the settings sector of the flash log and
+// written to the device by every mma8451_init()
+typedef struct
+{
+    int8_t x, y, z;     // OFF_X, OFF_Y and OFF_Z, 2 mg per LSB
+    uint8_t odr;        // Settings the offsets were measured with
+    uint8_t range;
+    uint8_t low_noise;
+    uint8_t reserved[2];
+}mma8451_cal_t;
+
+// A sample read from the FIFO
+typedef struct
+{
+    int16_t x, y, z;    // 14-bit results
+    uint32_t t_us;      // FIFO mode: time since mma8451_fifo_start(),
+                        // derived from the ODR. DRDY mode: run time of the
+                        // sample, see mono_us32().
+}mma8451_sample_t;
+
+// Embedded function events, the bits in INT_SOURCE
+typedef enum
+{
+    MMA8451_EVENT_MOTION      = 0x04, // Motion above a threshold (FF_MT)
+    MMA8451_EVENT_TAP         = 0x08, // Single or double tap (pulse)
+    MMA8451_EVENT_ORIENTATION = 0x10, // Portrait/landscape change
+    MMA8451_EVENT_TRANSIENT   = 0x20, // High-pass filtered acceleration
+    MMA8451_EVENT_SLEEP       = 0x80, // Auto-sleep or auto-wake
+}mma8451_event_t;
+
+// Embedded function settings. Thresholds are in steps of 63 mg, counts and
+// times are in samples at the ODR. See the MMA8451Q datasheet and AN4070,
+// AN4071, AN4072 and AN4074 for the details.
+typedef struct
+{
+    uint8_t events;             // Enabled events, mma8451_event_t bits
+    uint8_t motion_ths;         // MOTION: threshold
+    uint8_t motion_count;       // MOTION: debounce count
+    uint8_t transient_ths;      // TRANSIENT: threshold
+    uint8_t transient_count;    // TRANSIENT: debounce count
+    uint8_t tap_ths;            // TAP: threshold for all axes
+    uint8_t tap_limit;          // TAP: maximum pulse duration
+    uint8_t tap_latency;        // TAP: time a second tap is ignored
+    uint8_t tap_window;         // TAP: time allowed for a second tap
+    bool double_tap;            // TAP: detect double instead of single taps
+    uint8_t orientation_count;  // ORIENTATION: debounce count
+    uint8_t sleep_count;        // SLEEP: inactivity before auto-sleep
+}mma8451_events_config_t;
+
+// Source registers read by mma8451_events_wait()
+typedef struct
+{
+    uint8_t source;     // INT_SOURCE, the mma8451_event_t bits that fired
+    uint8_t motion;     // FF_MT_SRC
+    uint8_t tap;        // PULSE_SRC
+    uint8_t orientation;// PL_STATUS
+    uint8_t transient;  // TRANSIENT_SRC
+    uint8_t sysmod;     // SYSMOD, 0x02 is sleep and 0x01 is wake
+}mma8451_events_t;
+
+// Consistent copy of the results, see mma8451_get_state()
+typedef struct
+{
+    int16_t x_14_bit, y_14_bit, z_14_bit;
+    int16_t x_mg, y_mg, z_mg;
+    int16_t roll_cdeg, pitch_cdeg;
+#if (MMA8451_USE_FLOAT == 1)
+    float x_g, y_g, z_g;
+    float roll, pitch;
+#endif
+}mma8451_state_t;
+
+// The results as variables, only for the task that calls mma8451_read() and
+// the roll and pitch functions. Other tasks and interrupt handlers use
+// mma8451_get_state(), which never mixes the axes of two samples.
 extern int16_t x_out_14_bit, y_out_14_bit, z_out_14_bit;
+extern int16_t x_out_mg, y_out_mg, z_out_mg;
+extern int16_t roll_cdeg, pitch_cdeg;
+extern uint32_t dt_us;
+#if (MMA8451_USE_FLOAT == 1)
 extern float x_out_g, y_out_g, z_out_g;
 extern float roll, pitch;
 extern float dt;
+#endif
 extern bool mma8451_ready_flag;
+extern uint32_t mma8451_fifo_overflows;
+extern uint32_t mma8451_drdy_missed;
+extern uint32_t mma8451_reinits;
+extern uint32_t mma8451_cal_saves;
 
 bool mma8451_init(void);
 bool mma8451_calibrate(void);
+bool mma8451_get_cal(mma8451_cal_t *cal);
+bool mma8451_cal_drifted(const int32_t x_mg, const int32_t y_mg,
+                         const int32_t z_mg);
+bool mma8451_configure(const mma8451_config_t *cfg);
+void mma8451_get_config(mma8451_config_t *cfg);
 void mma8451_read(void);
+#if (MMA8451_USE_FLOAT == 1)
 void mma8451_rollpitch(void);
+#endif
+void mma8451_rollpitch_fixed(void);
+int16_t mma8451_atan2_cdeg(int32_t y, int32_t x);
+uint32_t mma8451_get_state(mma8451_state_t *state);
+
+bool mma8451_fifo_start(const mma8451_odr_t odr, const uint8_t watermark,
+    TaskHandle_t task);
+bool mma8451_fifo_read(mma8451_sample_t samples[], const uint32_t max,
+    uint32_t *n);
+bool mma8451_standby(void);
+
+bool mma8451_drdy_start(void);
+bool mma8451_drdy_wait(mma8451_sample_t *sample, const TickType_t timeout);
+
+bool mma8451_events_start(const mma8451_events_config_t *cfg);
+bool mma8451_events_wait(mma8451_events_t *ev, const TickType_t timeout);
 
 #endif
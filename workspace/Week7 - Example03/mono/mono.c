@@ -0,0 +1,76 @@
+/*! ***************************************************************************
+ *
+ * \brief     Monotonic microsecond clock
+ * \file      mono.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "mono.h"
+#include "runtime_stats.h"
+
+/// Run-time counter cycles per microsecond
+#define MONO_CYCLES_PER_US  (rtsCLOCK_HZ / 1000000UL)
+
+/*!
+ * \brief Divides a 64-bit value by a constant with 32-bit divisions
+ *
+ * The Cortex-M0+ has no divider, a 64-bit division is a long library call.
+ * With n = hi * 2^32 + lo and 2^32 = q * d + r, the quotient is
+ * hi * q + lo / d + (hi * r + lo % d) / d. The last sum fits in 32 bits as
+ * long as hi * r does, far beyond the lifetime of the counters here.
+ *
+ * \param[in]  n  Dividend
+ * \param[in]  d  Divisor, a constant so q and r are folded by the compiler
+ *
+ * \return n / d
+ */
+static inline uint64_t mono_div(const uint64_t n, const uint32_t d)
+{
+    const uint32_t hi = (uint32_t)(n >> 32);
+    const uint32_t lo = (uint32_t)n;
+    const uint32_t q = (uint32_t)(0x100000000ULL / d);
+    const uint32_t r = (uint32_t)(0x100000000ULL % d);
+
+    return ((uint64_t)hi * q) + (lo / d) + (((hi * r) + (lo % d)) / d);
+}
+
+/*!
+ * \brief Returns the microseconds since the start
+ */
+uint64_t mono_us(void)
+{
+    return mono_div(ullRunTimeCounterValue(), MONO_CYCLES_PER_US);
+}
+
+/*!
+ * \brief Returns the milliseconds since the start
+ *
+ * Wraps around after about 49 days, like a tick count of 1 ms.
+ */
+uint32_t mono_ms(void)
+{
+    return (uint32_t)mono_div(mono_us(), 1000UL);
+}
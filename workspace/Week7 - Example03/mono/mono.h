@@ -0,0 +1,61 @@
+/*! ***************************************************************************
+ *
+ * \brief     Monotonic microsecond clock
+ * \file      mono.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef MONO_H
+#define MONO_H
+
+#include <stdint.h>
+
+/*
+ * The common timestamp of the sensor drivers, the logger and the latency
+ * measurements. It counts microseconds since PIT0 was started in
+ * ResetISR(), in every clock mode, and does not wrap. It is derived from
+ * the 64-bit run-time counter, see runtime_stats.h, so a timestamp can be
+ * compared with the run-time statistics and the trace. All functions can
+ * be called from any interrupt, also one with a higher priority than the
+ * PIT.
+ *
+ * mono_us32() wraps around after about 71 minutes, which is fine for
+ * differences of timestamps that are taken less than that apart.
+ */
+
+// Function prototypes
+uint64_t mono_us(void);
+uint32_t mono_ms(void);
+
+/*!
+ * \brief Returns the lower 32 bits of mono_us()
+ */
+static inline uint32_t mono_us32(void)
+{
+    return (uint32_t)mono_us();
+}
+
+#endif // MONO_H
@@ -0,0 +1,280 @@
+/*! ***************************************************************************
+ *
+ * \brief     Zero-copy messages passed by pointer through queues
+ * \file      msg.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "msg.h"
+#include "task.h"
+
+/*
+ * A message is a pool block with a msg_header_t in front of the payload.
+ * Queues carry the address of the payload, so a message of any size is
+ * passed with a copy of a single pointer. Every reference is owned by
+ * exactly one task or queue: msg_alloc() returns one reference, a
+ * successful send moves it into the queue and msg_receive() moves it to the
+ * receiving task. The last msg_release() returns the block to its pool.
+ */
+
+/*!
+ * \brief Header of a message
+ */
+static inline msg_header_t *msg_header(void *msg)
+{
+    return (msg_header_t *)msg - 1;
+}
+
+/*!
+ * \brief Creates a queue that passes messages
+ *
+ * \param[in]   length   Maximum number of messages in the queue
+ * \param[in]   storage  Storage defined with MSG_QUEUE_STORAGE()
+ * \param[out]  buffer   Queue structure
+ *
+ * \return The queue
+ */
+QueueHandle_t msg_queue_create(const UBaseType_t length, uint8_t *storage,
+                               StaticQueue_t *buffer)
+{
+    return xQueueCreateStatic(length, sizeof(void *), storage, buffer);
+}
+
+/*!
+ * \brief Initialises the header of a new message
+ */
+static void *msg_init(pool_t *pool, msg_header_t *h)
+{
+    if(h == NULL)
+    {
+        return NULL;
+    }
+
+    h->pool = pool;
+    h->refs = 1;
+
+    return h + 1;
+}
+
+/*!
+ * \brief Allocates a message, the caller holds the only reference
+ *
+ * The block size of \p pool must be at least MSG_BLOCK_SIZE() of the
+ * payload.
+ *
+ * \param[in,out]  pool  Pool
+ *
+ * \return The payload, or NULL if the pool is empty
+ */
+void *msg_alloc(pool_t *pool)
+{
+    return msg_init(pool, pool_alloc(pool));
+}
+
+/*!
+ * \brief Allocates a message from an interrupt handler
+ *
+ * \param[in,out]  pool  Pool
+ *
+ * \return The payload, or NULL if the pool is empty
+ */
+void *msg_alloc_from_isr(pool_t *pool)
+{
+    return msg_init(pool, pool_alloc_from_isr(pool));
+}
+
+/*!
+ * \brief Adds n references to a message
+ *
+ * Used before a message is passed to more than one queue, every queue
+ * takes over one reference. The caller must hold a reference. May be called
+ * from an interrupt handler.
+ *
+ * \param[in,out]  msg  Payload
+ * \param[in]      n    Number of references to add
+ */
+void msg_ref(void *msg, const uint32_t n)
+{
+    msg_header_t *h = msg_header(msg);
+
+    const UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    {
+        configASSERT(h->refs > 0);
+        h->refs += n;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/*!
+ * \brief Drops a reference, returns true if it was the last one
+ */
+static bool msg_unref(msg_header_t *h)
+{
+    bool last;
+
+    const UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    {
+        configASSERT(h->refs > 0);
+        last = (--h->refs == 0);
+    }
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+
+    return last;
+}
+
+/*!
+ * \brief Releases a reference, the last one frees the message
+ *
+ * The payload must not be accessed after it is released.
+ *
+ * \param[in]  msg  Payload, NULL is ignored
+ */
+void msg_release(void *msg)
+{
+    if(msg == NULL)
+    {
+        return;
+    }
+
+    msg_header_t *h = msg_header(msg);
+
+    if(msg_unref(h))
+    {
+        pool_free(h->pool, h);
+    }
+}
+
+/*!
+ * \brief Releases a reference from an interrupt handler
+ *
+ * \param[in]  msg  Payload, NULL is ignored
+ */
+void msg_release_from_isr(void *msg)
+{
+    if(msg == NULL)
+    {
+        return;
+    }
+
+    msg_header_t *h = msg_header(msg);
+
+    if(msg_unref(h))
+    {
+        pool_free_from_isr(h->pool, h);
+    }
+}
+
+/*!
+ * \brief Passes a reference to a message to a queue
+ *
+ * On success the reference belongs to the queue. On failure the caller
+ * still holds it, and must send it again or release it.
+ *
+ * \param[in]  queue    Queue created with msg_queue_create()
+ * \param[in]  msg      Payload
+ * \param[in]  timeout  Maximum time to wait for room in ticks
+ *
+ * \return True if the message was queued
+ */
+bool msg_send(QueueHandle_t queue, void *msg, const TickType_t timeout)
+{
+    return xQueueSend(queue, &msg, timeout) == pdPASS;
+}
+
+/*!
+ * \brief Passes a reference to a message to a queue from an interrupt
+ *        handler
+ *
+ * \param[in]      queue  Queue created with msg_queue_create()
+ * \param[in]      msg    Payload
+ * \param[in,out]  woken  Set to pdTRUE if a task must be switched in
+ *
+ * \return True if the message was queued
+ */
+bool msg_send_from_isr(QueueHandle_t queue, void *msg, BaseType_t *woken)
+{
+    return xQueueSendFromISR(queue, &msg, woken) == pdPASS;
+}
+
+/*!
+ * \brief Passes a message to several queues
+ *
+ * Takes over the reference of the caller: every queue that accepted the
+ * message holds a reference afterwards and the caller holds none. If no
+ * queue accepted it, the message is freed.
+ *
+ * \param[in]  queues   Queues created with msg_queue_create()
+ * \param[in]  n        Number of queues
+ * \param[in]  msg      Payload
+ * \param[in]  timeout  Maximum time to wait for room, per queue, in ticks
+ *
+ * \return Number of queues that accepted the message
+ */
+uint32_t msg_publish(QueueHandle_t queues[], const uint32_t n, void *msg,
+                     const TickType_t timeout)
+{
+    uint32_t sent = 0;
+
+    // One reference per queue, the reference of the caller is released
+    // below, so a fast receiver cannot free the message too soon
+    msg_ref(msg, n);
+
+    for(uint32_t i=0; i<n; i++)
+    {
+        if(msg_send(queues[i], msg, timeout))
+        {
+            sent++;
+        }
+        else
+        {
+            msg_release(msg);
+        }
+    }
+
+    msg_release(msg);
+
+    return sent;
+}
+
+/*!
+ * \brief Takes a message from a queue, the caller then holds its reference
+ *
+ * \param[in]  queue    Queue created with msg_queue_create()
+ * \param[in]  timeout  Maximum time to wait in ticks
+ *
+ * \return The payload, or NULL on timeout
+ */
+void *msg_receive(QueueHandle_t queue, const TickType_t timeout)
+{
+    void *msg;
+
+    if(xQueueReceive(queue, &msg, timeout) != pdPASS)
+    {
+        return NULL;
+    }
+
+    return msg;
+}
@@ -0,0 +1,86 @@
+/*! ***************************************************************************
+ *
+ * \brief     Zero-copy messages passed by pointer through queues
+ * \file      msg.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef MSG_H
+#define MSG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#include "pool.h"
+
+/// \name Definitions for the messages
+/// \{
+
+/*!
+ * \brief Size of the pool block of a message with a payload of size bytes
+ *
+ * Example: a pool for eight sample blocks
+ *
+ *     static POOL_STORAGE(blocks_storage, MSG_BLOCK_SIZE(sizeof(block_t)), 8);
+ *     pool_init(&blocks, "blocks", blocks_storage,
+ *         MSG_BLOCK_SIZE(sizeof(block_t)), 8);
+ */
+#define MSG_BLOCK_SIZE(size)  (sizeof(msg_header_t) + (size))
+
+/*!
+ * \brief Defines the storage of a message queue of length pointers
+ */
+#define MSG_QUEUE_STORAGE(name, length) \
+    uint8_t name[(length) * sizeof(void *)]
+
+/// \}
+
+/// Header in front of the payload of every message
+typedef struct
+{
+    pool_t *pool;               ///< Pool the message is returned to
+    volatile uint32_t refs;     ///< References held by tasks and queues
+}
+msg_header_t;
+
+// Function prototypes
+QueueHandle_t msg_queue_create(const UBaseType_t length, uint8_t *storage,
+                               StaticQueue_t *buffer);
+void *msg_alloc(pool_t *pool);
+void *msg_alloc_from_isr(pool_t *pool);
+void msg_ref(void *msg, const uint32_t n);
+void msg_release(void *msg);
+void msg_release_from_isr(void *msg);
+bool msg_send(QueueHandle_t queue, void *msg, const TickType_t timeout);
+bool msg_send_from_isr(QueueHandle_t queue, void *msg, BaseType_t *woken);
+uint32_t msg_publish(QueueHandle_t queues[], const uint32_t n, void *msg,
+                     const TickType_t timeout);
+void *msg_receive(QueueHandle_t queue, const TickType_t timeout);
+
+#endif // MSG_H
@@ -0,0 +1,185 @@
+/*! ***************************************************************************
+ *
+ * \brief     Branch trace capture with the Micro Trace Buffer
+ * \file      mtb.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdbool.h>
+
+#include "mtb.h"
+#include "FreeRTOS.h"
+#include "crash.h"
+#include "serial.h"
+#include "xprintf.h"
+
+/*
+ * The MTB writes a packet to SRAM for every branch the core takes that is
+ * not sequential: the source address, with bit 0 set if the branch is an
+ * exception entry, and the destination address, with bit 0 set in the
+ * first packet after the capture started. The buffer is a ring, so it
+ * always holds the last MTB_BUFFER_SIZE / 8 branches.
+ *
+ * The capture runs from mtb_init() until a trigger calls mtb_stop():
+ * configASSERT(), the hard fault handler below and periodic_wait() when a
+ * cycle overran (PERIODIC_STOP_MTB). The branches that led to the trigger
+ * are then read
+ *
+ * - over the serial port with mtb_dump(), the 'm' command, or
+ * - by the debugger while the core is halted, e.g. in Ozone or with
+ *     (gdb) dump binary memory mtb.bin mtb_buffer (mtb_buffer + MTB_BUFFER_SIZE / 4)
+ *     (gdb) p/x ((MTB_Type *)0xF0000000)->POSITION
+ *
+ * and decoded to functions and lines with tools/mtb_decode.py.
+ *
+ * The POSITION register holds the offset of the next packet from the start
+ * of SRAM in the BASE register. The pointer wraps at the buffer size, so
+ * the buffer must be aligned to its size. The .mtb_buffer_default section
+ * is NOLOAD and not cleared by the startup code.
+ */
+
+#if (MTB_ENABLED == 1)
+
+#if (MTB_BUFFER_SIZE < 16) || (MTB_BUFFER_SIZE > 4096) || \
+    ((MTB_BUFFER_SIZE & (MTB_BUFFER_SIZE - 1)) != 0)
+#error "MTB_BUFFER_SIZE must be a power of two from 16 to 4096"
+#endif
+
+// Time a line of the dump may wait for room in the serial transmit buffer
+#define MTB_BLOCK_TIME pdMS_TO_TICKS(100)
+
+__attribute__((section(".mtb_buffer"), aligned(MTB_BUFFER_SIZE)))
+uint32_t mtb_buffer[MTB_BUFFER_SIZE / 4];
+
+/*!
+ * \brief Returns the offset of the trace buffer from the SRAM base
+ */
+static uint32_t mtb_offset(void)
+{
+    return (uint32_t)((uintptr_t)mtb_buffer - MTB->BASE);
+}
+
+/*!
+ * \brief Sets up the MTB and starts the capture
+ */
+void mtb_init(void)
+{
+    mtb_start();
+}
+
+/*!
+ * \brief Starts a new capture, the previous one is overwritten
+ */
+void mtb_start(void)
+{
+    mtb_stop();
+
+    MTB->POSITION = mtb_offset() & MTB_POSITION_POINTER_MASK;
+
+    // Wrap around, no watermark
+    MTB->FLOW = 0;
+
+    // The buffer is 2^(MASK + 4) bytes
+    MTB->MASTER = MTB_MASTER_EN_MASK |
+        MTB_MASTER_MASK(__builtin_ctz(MTB_BUFFER_SIZE) - 4);
+}
+
+/*!
+ * \brief Writes the captured branches to the serial port and starts a new
+ *        capture
+ *
+ * The capture is stopped first, so the dump does not overwrite it. One line
+ * per branch, oldest first: source and destination address in hex, the
+ * flag bits are kept in bit 0. The last line is "end". Must be called from
+ * a task.
+ */
+void mtb_dump(void)
+{
+    char line[32];
+
+    mtb_stop();
+
+    const uint32_t position = MTB->POSITION;
+    const bool wrapped = (position & MTB_POSITION_WRAP_MASK) != 0;
+    const uint32_t packets = MTB_BUFFER_SIZE / 8;
+    const uint32_t next = ((position & MTB_POSITION_POINTER_MASK) -
+        mtb_offset()) % MTB_BUFFER_SIZE / 8;
+
+    // Oldest first, the ring starts at the next packet once it wrapped
+    const uint32_t first = wrapped ? next : 0;
+    const uint32_t n = wrapped ? packets : next;
+
+    xsnprintf(line, sizeof(line), "\r\nMTB %lu branches\r\n", (unsigned long)n);
+    xSerialPutStringPolicy(line, eSerialBlock, MTB_BLOCK_TIME);
+
+    for(uint32_t i=0; i<n; i++)
+    {
+        const uint32_t p = (first + i) % packets;
+
+        xsnprintf(line, sizeof(line), "%08lx %08lx\r\n",
+            (unsigned long)mtb_buffer[2 * p], (unsigned long)mtb_buffer[2 * p + 1]);
+        xSerialPutStringPolicy(line, eSerialBlock, MTB_BLOCK_TIME);
+    }
+
+    xSerialPutStringPolicy("end\r\n", eSerialBlock, MTB_BLOCK_TIME);
+
+    mtb_start();
+}
+
+#if (CRASH_ENABLED == 0)
+/*!
+ * \brief Stops the capture on a hard fault, replaces the default handler
+ *
+ * The last packet is the exception entry, its source is the address of the
+ * faulting instruction or of the one after it. With CRASH_ENABLED the
+ * handler in crash.c stops the capture and resets instead.
+ */
+void HardFault_Handler(void)
+{
+    mtb_stop();
+
+    for(;;)
+    {
+    }
+}
+#endif
+
+#else
+
+void mtb_init(void)
+{
+}
+
+void mtb_start(void)
+{
+}
+
+void mtb_dump(void)
+{
+    xSerialPutStringPolicy("\r\nMTB disabled\r\n", eSerialBlock, pdMS_TO_TICKS(100));
+}
+
+#endif
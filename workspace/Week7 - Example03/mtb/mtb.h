@@ -0,0 +1,89 @@
+/*! ***************************************************************************
+ *
+ * \brief     Branch trace capture with the Micro Trace Buffer
+ * \file      mtb.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef MTB_H
+#define MTB_H
+
+#include <MKL25Z4.h>
+#include <stdint.h>
+
+/// \name Definitions for the Micro Trace Buffer
+/// \{
+
+/*!
+ * \brief Set to 1 to record the branches of the core into mtb_buffer
+ */
+#ifndef MTB_ENABLED
+#define MTB_ENABLED         (1)
+#endif
+
+/*!
+ * \brief Size of the trace buffer in bytes, a power of two from 16 to 4096
+ *
+ * Every branch takes a packet of 8 bytes, the buffer holds the last
+ * MTB_BUFFER_SIZE / 8 branches.
+ */
+#ifndef MTB_BUFFER_SIZE
+#define MTB_BUFFER_SIZE     (512)
+#endif
+
+/// \}
+
+#if (MTB_ENABLED == 1)
+
+/// Trace buffer at the start of SRAM_L, in the .mtb_buffer_default section
+/// of the linker script
+extern uint32_t mtb_buffer[MTB_BUFFER_SIZE / 4];
+
+/*!
+ * \brief Stops the capture, the buffer keeps the branches up to here
+ *
+ * Inline, so the trigger itself adds no branches. May be called from any
+ * context, also from configASSERT() and fault handlers.
+ */
+static inline void mtb_stop(void)
+{
+    MTB->MASTER &= ~MTB_MASTER_EN_MASK;
+}
+
+#else
+
+static inline void mtb_stop(void)
+{
+}
+
+#endif
+
+// Function prototypes
+void mtb_init(void);
+void mtb_start(void);
+void mtb_dump(void);
+
+#endif // MTB_H
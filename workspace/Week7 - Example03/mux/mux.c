@@ -0,0 +1,241 @@
+/*! ***************************************************************************
+ *
+ * \brief     Block on several queues, semaphores and signals with one queue set
+ * \file      mux.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "mux.h"
+
+/*!
+ * \brief Creates the queue set of a mux
+ *
+ * The queue set is created statically in the mux. FreeRTOS 202107 has no
+ * static variant of xQueueCreateSet(), a queue set is a queue of member
+ * handles created with queueQUEUE_TYPE_SET.
+ *
+ * \param[in]  mux  The mux, must remain valid
+ */
+void mux_init(mux_t *mux)
+{
+    mux->set = xQueueGenericCreateStatic(MUX_MAX_EVENTS,
+        sizeof(QueueSetMemberHandle_t), mux->set_storage, &mux->set_buffer,
+        queueQUEUE_TYPE_SET);
+    mux->events = 0;
+    mux->n = 0;
+    mux->signal = NULL;
+    mux->pending = 0;
+    mux->bits = 0;
+}
+
+/*!
+ * \brief Adds a member to the queue set and records its handler
+ *
+ * \return False if the mux is full or the member cannot be added
+ */
+static bool mux_add(mux_t *mux, QueueSetMemberHandle_t member, void *item,
+    mux_handler_t handler, void *arg)
+{
+    // The length of a queue or semaphore is its free and used space
+    const UBaseType_t length = uxQueueMessagesWaiting(member) +
+        uxQueueSpacesAvailable(member);
+
+    if((mux->n >= MUX_MAX_SOURCES) || ((mux->events + length) > MUX_MAX_EVENTS))
+    {
+        return false;
+    }
+
+    // Fails if the member is not empty or already in a set
+    if(xQueueAddToSet(member, mux->set) != pdPASS)
+    {
+        return false;
+    }
+
+    mux->sources[mux->n] = (mux_source_t){member, item, handler, arg};
+    mux->n++;
+    mux->events += length;
+
+    return true;
+}
+
+/*!
+ * \brief Adds a queue to a mux
+ *
+ * For every item sent to the queue, mux_wait() receives it into item and
+ * calls the handler. The queue must be empty and must only be received from
+ * by the mux.
+ *
+ * \param[in]  mux      The mux
+ * \param[in]  queue    The queue
+ * \param[in]  item     Buffer of the item size of the queue, must remain valid
+ * \param[in]  handler  Called with item and arg
+ * \param[in]  arg      Argument of the handler
+ *
+ * \return True if the queue was added
+ */
+bool mux_add_queue(mux_t *mux, QueueHandle_t queue, void *item,
+    mux_handler_t handler, void *arg)
+{
+    configASSERT(item != NULL);
+
+    return mux_add(mux, queue, item, handler, arg);
+}
+
+/*!
+ * \brief Adds a binary or counting semaphore to a mux
+ *
+ * For every give, mux_wait() takes the semaphore and calls the handler. A
+ * mutex cannot be a member of a queue set. The semaphore must not be
+ * available and must only be taken by the mux.
+ *
+ * \param[in]  mux        The mux
+ * \param[in]  semaphore  The semaphore
+ * \param[in]  handler    Called with NULL and arg
+ * \param[in]  arg        Argument of the handler
+ *
+ * \return True if the semaphore was added
+ */
+bool mux_add_semaphore(mux_t *mux, SemaphoreHandle_t semaphore,
+    mux_handler_t handler, void *arg)
+{
+    return mux_add(mux, semaphore, NULL, handler, arg);
+}
+
+/*!
+ * \brief Adds the signal source to a mux
+ *
+ * A task notification cannot be a member of a queue set. Instead, a task or
+ * interrupt calls mux_signal() or mux_signal_from_isr() with a set of bits.
+ * Bits signalled before mux_wait() dispatches them are combined, like the
+ * bits of a task notification, and the handler gets a pointer to them.
+ *
+ * \param[in]  mux      The mux
+ * \param[in]  handler  Called with a pointer to the uint32_t bits and arg
+ * \param[in]  arg      Argument of the handler
+ *
+ * \return True if the signal source was added
+ */
+bool mux_add_signal(mux_t *mux, mux_handler_t handler, void *arg)
+{
+    configASSERT(mux->signal == NULL);
+
+    mux->signal = xSemaphoreCreateBinaryStatic(&mux->signal_buffer);
+
+    return mux_add(mux, mux->signal, &mux->bits, handler, arg);
+}
+
+/*!
+ * \brief Signals bits to the signal source of a mux
+ */
+void mux_signal(mux_t *mux, const uint32_t bits)
+{
+    taskENTER_CRITICAL();
+    {
+        mux->pending |= bits;
+    }
+    taskEXIT_CRITICAL();
+
+    // Fails if an event is already in the set, which then dispatches the
+    // combined bits
+    (void)xSemaphoreGive(mux->signal);
+}
+
+/*!
+ * \brief Signals bits to the signal source of a mux from an interrupt
+ */
+void mux_signal_from_isr(mux_t *mux, const uint32_t bits, BaseType_t *woken)
+{
+    const UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        mux->pending |= bits;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    (void)xSemaphoreGiveFromISR(mux->signal, woken);
+}
+
+/*!
+ * \brief Waits for an event of any source and dispatches it
+ *
+ * The item of the source that fired is read before its handler is called,
+ * so the number of events in the queue set always matches the number of
+ * items in its members.
+ *
+ * \param[in]  mux      The mux
+ * \param[in]  timeout  Ticks to wait for an event
+ *
+ * \return True if an event was dispatched, false on timeout
+ */
+bool mux_wait(mux_t *mux, const TickType_t timeout)
+{
+    QueueSetMemberHandle_t member = xQueueSelectFromSet(mux->set, timeout);
+
+    if(member == NULL)
+    {
+        return false;
+    }
+
+    for(uint32_t i=0; i<mux->n; ++i)
+    {
+        const mux_source_t *s = &mux->sources[i];
+
+        if(s->member != member)
+        {
+            continue;
+        }
+
+        if(member == mux->signal)
+        {
+            (void)xSemaphoreTake(member, 0);
+
+            taskENTER_CRITICAL();
+            {
+                mux->bits = mux->pending;
+                mux->pending = 0;
+            }
+            taskEXIT_CRITICAL();
+
+            // Bits already dispatched with an earlier event
+            if(mux->bits == 0)
+            {
+                return true;
+            }
+        }
+        else if(s->item == NULL)
+        {
+            (void)xSemaphoreTake(member, 0);
+        }
+        else
+        {
+            (void)xQueueReceive(member, s->item, 0);
+        }
+
+        s->handler(s->item, s->arg);
+        break;
+    }
+
+    return true;
+}
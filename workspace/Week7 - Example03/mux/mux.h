@@ -0,0 +1,116 @@
+/*! ***************************************************************************
+ *
+ * \brief     Block on several queues, semaphores and signals with one queue set
+ * \file      mux.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef MUX_H
+#define MUX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "semphr.h"
+
+#if (configUSE_QUEUE_SETS != 1)
+#error "The mux is built on queue sets, set configUSE_QUEUE_SETS to 1"
+#endif
+
+/// \name Definitions for the multiplexer
+/// \{
+
+/*!
+ * \brief Maximum number of sources of a mux, including the signal source
+ */
+#ifndef MUX_MAX_SOURCES
+#define MUX_MAX_SOURCES (4)
+#endif
+
+/*!
+ * \brief Maximum sum of the lengths of all sources of a mux
+ *
+ * Every item in a queue and every count of a semaphore is one event in the
+ * queue set, so the set must be able to hold all of them.
+ */
+#ifndef MUX_MAX_EVENTS
+#define MUX_MAX_EVENTS (8)
+#endif
+
+/// \}
+
+/*!
+ * \brief Called by mux_wait() for an event of a source
+ *
+ * \param[in]  item  Item received from a queue, the signalled bits of a
+ *                   signal source, or NULL for a semaphore
+ * \param[in]  arg   Argument given when the source was added
+ */
+typedef void (*mux_handler_t)(void *item, void *arg);
+
+/// A queue, semaphore or signal source of a mux
+typedef struct
+{
+    QueueSetMemberHandle_t member;
+    void *item;
+    mux_handler_t handler;
+    void *arg;
+}
+mux_source_t;
+
+/// A queue set with the sources that are dispatched from it
+typedef struct
+{
+    QueueSetHandle_t set;
+    StaticQueue_t set_buffer;
+    uint8_t set_storage[MUX_MAX_EVENTS * sizeof(QueueSetMemberHandle_t)];
+    UBaseType_t events;         ///< Sum of the lengths of the sources
+
+    mux_source_t sources[MUX_MAX_SOURCES];
+    uint32_t n;
+
+    // Signal source, see mux_add_signal()
+    SemaphoreHandle_t signal;
+    StaticSemaphore_t signal_buffer;
+    volatile uint32_t pending;  ///< Bits signalled and not dispatched yet
+    uint32_t bits;              ///< Bits passed to the handler
+}
+mux_t;
+
+// Function prototypes
+void mux_init(mux_t *mux);
+bool mux_add_queue(mux_t *mux, QueueHandle_t queue, void *item,
+                   mux_handler_t handler, void *arg);
+bool mux_add_semaphore(mux_t *mux, SemaphoreHandle_t semaphore,
+                       mux_handler_t handler, void *arg);
+bool mux_add_signal(mux_t *mux, mux_handler_t handler, void *arg);
+void mux_signal(mux_t *mux, const uint32_t bits);
+void mux_signal_from_isr(mux_t *mux, const uint32_t bits, BaseType_t *woken);
+bool mux_wait(mux_t *mux, const TickType_t timeout);
+
+#endif // MUX_H
@@ -14,6 +14,11 @@
  * 4. Draw the bitmap by passing the pointer to the function
  *    ssd1306_drawbitmap()
  *
+ * Full screen images take less flash compressed. Such an image is a BMP in
+ * doc/, listed in BITMAPS_RLE in CMakeLists.txt. tools/bmp_convert.py
+ * converts it at build time to an ssd1306_rle_t in bitmaps_rle.h, which is
+ * drawn with ssd1306_drawrle().
+ *
  * \copyright 2021 HAN University of Applied Sciences. All Rights Reserved.
  *            \n\n
  *            Permission is hereby granted, free of charge, to any person
@@ -41,6 +46,18 @@
 #ifndef BITMAPS_H_
 #define BITMAPS_H_
 
-extern const unsigned char clock[];
+#include <stdint.h>
+
+/// Bitmap compressed per page with PackBits, see tools/bmp_convert.py
+typedef struct
+{
+    uint8_t width;          ///< Columns
+    uint8_t pages;          ///< Pages of 8 rows
+    const uint16_t *offset; ///< Offset in data of every page
+    const uint8_t *data;    ///< Runs of every page, restarted at each page
+}
+ssd1306_rle_t;
+
+extern const unsigned char icon_cpu[];
 
 #endif // BITMAPS_H_
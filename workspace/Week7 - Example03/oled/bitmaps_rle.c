@@ -0,0 +1,34 @@
+/* Generated by tools/bmp_convert.py, do not edit. */
+#include "bitmaps_rle.h"
+
+static const uint16_t clock_offset[8] =
+{
+    0, 41, 69, 89, 117, 145, 167, 195,
+};
+
+static const uint8_t clock_data[238] =
+{
+    0xD5, 0x00, 0x08, 0x80, 0xC0, 0xE0, 0xF0, 0x70, 0x78, 0x38, 0x1C, 0x1C, 0xFE, 0x0E, 0xFD, 0x07,
+    0xFE, 0x03, 0x02, 0x3F, 0x07, 0x3F, 0xFE, 0x03, 0xFD, 0x07, 0xFE, 0x0E, 0xFF, 0x1C, 0xFF, 0x38,
+    0x05, 0x70, 0xF0, 0xE0, 0xC0, 0x80, 0x80, 0xD7, 0x00, 0xDC, 0x00, 0x09, 0x80, 0xE0, 0xF0, 0xF8,
+    0x3C, 0x1F, 0x0F, 0x07, 0x03, 0x01, 0xDE, 0x00, 0x09, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3E, 0xF8,
+    0xF0, 0xE0, 0x80, 0xDD, 0x00, 0xDF, 0x00, 0x05, 0xC0, 0xF8, 0xFE, 0x7F, 0x0F, 0x03, 0xD0, 0x00,
+    0x05, 0x03, 0x0F, 0x7F, 0xFE, 0xF8, 0xC0, 0xE0, 0x00, 0xE0, 0x00, 0x03, 0xFC, 0xFF, 0xFF, 0xC7,
+    0xFE, 0x40, 0xEB, 0x00, 0x00, 0xC0, 0xFE, 0xE0, 0x00, 0xC0, 0xEB, 0x00, 0xFE, 0x40, 0x03, 0xC3,
+    0xFF, 0xFF, 0xFC, 0xE1, 0x00, 0xE0, 0x00, 0x03, 0x1F, 0xFF, 0xFF, 0xF1, 0xFE, 0x01, 0xEB, 0x00,
+    0x00, 0x01, 0xFE, 0x03, 0x00, 0x01, 0xEB, 0x00, 0xFE, 0x01, 0x03, 0xE1, 0xFF, 0xFF, 0x1F, 0xE1,
+    0x00, 0xDF, 0x00, 0x06, 0x01, 0x0F, 0x3F, 0xFF, 0xF8, 0xE0, 0x80, 0xD2, 0x00, 0x06, 0x80, 0xE0,
+    0xF8, 0xFF, 0x3F, 0x0F, 0x01, 0xE0, 0x00, 0xDB, 0x00, 0x09, 0x03, 0x07, 0x0F, 0x3E, 0x7C, 0xF8,
+    0xF0, 0xE0, 0xC0, 0x80, 0xE0, 0x00, 0x09, 0x80, 0xC0, 0xE0, 0xE0, 0xF8, 0x7C, 0x3E, 0x0F, 0x07,
+    0x03, 0xDC, 0x00, 0xD4, 0x00, 0x0A, 0x01, 0x03, 0x07, 0x07, 0x0E, 0x0E, 0x1C, 0x3C, 0x38, 0x38,
+    0x78, 0xFE, 0x70, 0x00, 0x60, 0xFE, 0xE0, 0x02, 0xFE, 0xF0, 0xFE, 0xFD, 0xE0, 0xFE, 0x70, 0x0B,
+    0x78, 0x38, 0x38, 0x3C, 0x1C, 0x0E, 0x0E, 0x07, 0x07, 0x03, 0x01, 0x01, 0xD6, 0x00,
+};
+
+const ssd1306_rle_t clock_rle =
+{
+    .width = 128,
+    .pages = 8,
+    .offset = clock_offset,
+    .data = clock_data,
+};
@@ -0,0 +1,9 @@
+/* Generated by tools/bmp_convert.py, do not edit. */
+#ifndef BITMAPS_RLE_H_
+#define BITMAPS_RLE_H_
+
+#include "bitmaps.h"
+
+extern const ssd1306_rle_t clock_rle; // 254 of 1024 bytes
+
+#endif // BITMAPS_RLE_H_
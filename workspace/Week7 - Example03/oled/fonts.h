@@ -41,6 +41,44 @@
 #ifndef FONTS_H_
 #define FONTS_H_
 
+#include <stdint.h>
+
+/*!
+ * \brief Number of glyphs of packed native fonts kept decoded in RAM
+ *
+ * Every entry takes FONTS_NATIVE_PACKED_MAX bytes. Text that is redrawn
+ * often, such as the digits of a clock, is then only decoded once.
+ */
+#ifndef FONT_CACHE_ENTRIES
+#define FONT_CACHE_ENTRIES    (8)
+#endif
+
+/// Glyph of a native font
+typedef struct
+{
+    uint16_t offset; ///< Index of the first byte in font_native_t::bitmap
+    uint8_t width;   ///< Width in columns
+}
+font_glyph_t;
+
+/// Font laid out in SSD1306 page order, generated by tools/font_convert.py
+///
+/// Page p of a glyph g holds the columns 0 .. width-1 of rows 8p .. 8p+7 at
+/// bitmap[g.offset + p * g.width]. Rows below the font height are cleared.
+/// In a packed font, g.offset is the start of the PackBits runs of the glyph
+/// that decode to this layout.
+typedef struct
+{
+    uint8_t height;             ///< Height in pixels
+    uint8_t pages;              ///< Bytes per glyph column
+    uint8_t first;              ///< First character
+    uint8_t count;              ///< Number of characters
+    uint8_t packed;             ///< 1 if the glyphs are PackBits runs
+    const font_glyph_t *glyphs; ///< Glyph table, indexed by character - first
+    const uint8_t *bitmap;      ///< Glyph data
+}
+font_native_t;
+
 extern const char Monospaced_plain_10[];
 extern const char Dialog_plain_12[];
 extern const char Monospaced_bold_24[];
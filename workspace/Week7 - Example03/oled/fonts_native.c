@@ -0,0 +1,2394 @@
+/* Generated by tools/font_convert.py, do not edit. */
+#include "fonts_native.h"
+
+static const font_glyph_t Monospaced_plain_10_glyphs[224] =
+{
+    {    0,  6}, // 32
+    {   12,  6}, // 33
+    {   24,  6}, // 34
+    {   36,  6}, // 35
+    {   48,  6}, // 36
+    {   60,  6}, // 37
+    {   72,  6}, // 38
+    {   84,  6}, // 39
+    {   96,  6}, // 40
+    {  108,  6}, // 41
+    {  120,  6}, // 42
+    {  132,  6}, // 43
+    {  144,  6}, // 44
+    {  156,  6}, // 45
+    {  168,  6}, // 46
+    {  180,  6}, // 47
+    {  192,  6}, // 48
+    {  204,  6}, // 49
+    {  216,  6}, // 50
+    {  228,  6}, // 51
+    {  240,  6}, // 52
+    {  252,  6}, // 53
+    {  264,  6}, // 54
+    {  276,  6}, // 55
+    {  288,  6}, // 56
+    {  300,  6}, // 57
+    {  312,  6}, // 58
+    {  324,  6}, // 59
+    {  336,  6}, // 60
+    {  348,  6}, // 61
+    {  360,  6}, // 62
+    {  372,  6}, // 63
+    {  384,  6}, // 64
+    {  396,  6}, // 65
+    {  408,  6}, // 66
+    {  420,  6}, // 67
+    {  432,  6}, // 68
+    {  444,  6}, // 69
+    {  456,  6}, // 70
+    {  468,  6}, // 71
+    {  480,  6}, // 72
+    {  492,  6}, // 73
+    {  504,  6}, // 74
+    {  516,  6}, // 75
+    {  528,  6}, // 76
+    {  540,  6}, // 77
+    {  552,  6}, // 78
+    {  564,  6}, // 79
+    {  576,  6}, // 80
+    {  588,  6}, // 81
+    {  600,  6}, // 82
+    {  612,  6}, // 83
+    {  624,  6}, // 84
+    {  636,  6}, // 85
+    {  648,  6}, // 86
+    {  660,  6}, // 87
+    {  672,  6}, // 88
+    {  684,  6}, // 89
+    {  696,  6}, // 90
+    {  708,  6}, // 91
+    {  720,  6}, // 92
+    {  732,  6}, // 93
+    {  744,  6}, // 94
+    {  756,  6}, // 95
+    {  768,  6}, // 96
+    {  780,  6}, // 97
+    {  792,  6}, // 98
+    {  804,  6}, // 99
+    {  816,  6}, // 100
+    {  828,  6}, // 101
+    {  840,  6}, // 102
+    {  852,  6}, // 103
+    {  864,  6}, // 104
+    {  876,  6}, // 105
+    {  888,  6}, // 106
+    {  900,  6}, // 107
+    {  912,  6}, // 108
+    {  924,  6}, // 109
+    {  936,  6}, // 110
+    {  948,  6}, // 111
+    {  960,  6}, // 112
+    {  972,  6}, // 113
+    {  984,  6}, // 114
+    {  996,  6}, // 115
+    { 1008,  6}, // 116
+    { 1020,  6}, // 117
+    { 1032,  6}, // 118
+    { 1044,  6}, // 119
+    { 1056,  6}, // 120
+    { 1068,  6}, // 121
+    { 1080,  6}, // 122
+    { 1092,  6}, // 123
+    { 1104,  6}, // 124
+    { 1116,  6}, // 125
+    { 1128,  6}, // 126
+    { 1140,  6}, // 127
+    { 1152,  6}, // 128
+    { 1164,  6}, // 129
+    { 1176,  6}, // 130
+    { 1188,  6}, // 131
+    { 1200,  6}, // 132
+    { 1212,  6}, // 133
+    { 1224,  6}, // 134
+    { 1236,  6}, // 135
+    { 1248,  6}, // 136
+    { 1260,  6}, // 137
+    { 1272,  6}, // 138
+    { 1284,  6}, // 139
+    { 1296,  6}, // 140
+    { 1308,  6}, // 141
+    { 1320,  6}, // 142
+    { 1332,  6}, // 143
+    { 1344,  6}, // 144
+    { 1356,  6}, // 145
+    { 1368,  6}, // 146
+    { 1380,  6}, // 147
+    { 1392,  6}, // 148
+    { 1404,  6}, // 149
+    { 1416,  6}, // 150
+    { 1428,  6}, // 151
+    { 1440,  6}, // 152
+    { 1452,  6}, // 153
+    { 1464,  6}, // 154
+    { 1476,  6}, // 155
+    { 1488,  6}, // 156
+    { 1500,  6}, // 157
+    { 1512,  6}, // 158
+    { 1524,  6}, // 159
+    { 1536,  6}, // 160
+    { 1548,  6}, // 161
+    { 1560,  6}, // 162
+    { 1572,  6}, // 163
+    { 1584,  6}, // 164
+    { 1596,  6}, // 165
+    { 1608,  6}, // 166
+    { 1620,  6}, // 167
+    { 1632,  6}, // 168
+    { 1644,  6}, // 169
+    { 1656,  6}, // 170
+    { 1668,  6}, // 171
+    { 1680,  6}, // 172
+    { 1692,  6}, // 173
+    { 1704,  6}, // 174
+    { 1716,  6}, // 175
+    { 1728,  6}, // 176
+    { 1740,  6}, // 177
+    { 1752,  6}, // 178
+    { 1764,  6}, // 179
+    { 1776,  6}, // 180
+    { 1788,  6}, // 181
+    { 1800,  6}, // 182
+    { 1812,  6}, // 183
+    { 1824,  6}, // 184
+    { 1836,  6}, // 185
+    { 1848,  6}, // 186
+    { 1860,  6}, // 187
+    { 1872,  6}, // 188
+    { 1884,  6}, // 189
+    { 1896,  6}, // 190
+    { 1908,  6}, // 191
+    { 1920,  6}, // 192
+    { 1932,  6}, // 193
+    { 1944,  6}, // 194
+    { 1956,  6}, // 195
+    { 1968,  6}, // 196
+    { 1980,  6}, // 197
+    { 1992,  6}, // 198
+    { 2004,  6}, // 199
+    { 2016,  6}, // 200
+    { 2028,  6}, // 201
+    { 2040,  6}, // 202
+    { 2052,  6}, // 203
+    { 2064,  6}, // 204
+    { 2076,  6}, // 205
+    { 2088,  6}, // 206
+    { 2100,  6}, // 207
+    { 2112,  6}, // 208
+    { 2124,  6}, // 209
+    { 2136,  6}, // 210
+    { 2148,  6}, // 211
+    { 2160,  6}, // 212
+    { 2172,  6}, // 213
+    { 2184,  6}, // 214
+    { 2196,  6}, // 215
+    { 2208,  6}, // 216
+    { 2220,  6}, // 217
+    { 2232,  6}, // 218
+    { 2244,  6}, // 219
+    { 2256,  6}, // 220
+    { 2268,  6}, // 221
+    { 2280,  6}, // 222
+    { 2292,  6}, // 223
+    { 2304,  6}, // 224
+    { 2316,  6}, // 225
+    { 2328,  6}, // 226
+    { 2340,  6}, // 227
+    { 2352,  6}, // 228
+    { 2364,  6}, // 229
+    { 2376,  6}, // 230
+    { 2388,  6}, // 231
+    { 2400,  6}, // 232
+    { 2412,  6}, // 233
+    { 2424,  6}, // 234
+    { 2436,  6}, // 235
+    { 2448,  6}, // 236
+    { 2460,  6}, // 237
+    { 2472,  6}, // 238
+    { 2484,  6}, // 239
+    { 2496,  6}, // 240
+    { 2508,  6}, // 241
+    { 2520,  6}, // 242
+    { 2532,  6}, // 243
+    { 2544,  6}, // 244
+    { 2556,  6}, // 245
+    { 2568,  6}, // 246
+    { 2580,  6}, // 247
+    { 2592,  6}, // 248
+    { 2604,  6}, // 249
+    { 2616,  6}, // 250
+    { 2628,  6}, // 251
+    { 2640,  6}, // 252
+    { 2652,  6}, // 253
+    { 2664,  6}, // 254
+    { 2676,  6}, // 255
+};
+
+static const uint8_t Monospaced_plain_10_bitmap[2688] =
+{
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x38, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x80, 0xE0, 0xB8, 0xE0, 0xB8, 0x20, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00,
+    0x00, 0x60, 0x50, 0xF8, 0x90, 0x90, 0x00, 0x02, 0x02, 0x07, 0x02, 0x01, 0x38, 0xA8, 0x78, 0xC0,
+    0xA0, 0x80, 0x00, 0x00, 0x00, 0x03, 0x02, 0x03, 0x00, 0xC0, 0x38, 0x68, 0x88, 0xC0, 0x00, 0x01,
+    0x02, 0x02, 0x01, 0x02, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xF8, 0x04, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xF0,
+    0x00, 0x00, 0x00, 0x00, 0x06, 0x01, 0x00, 0x00, 0x00, 0x48, 0x30, 0x78, 0x30, 0x48, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0xF0, 0x40, 0x40, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80,
+    0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x30, 0x08, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00,
+    0x00, 0xF0, 0x08, 0x48, 0x08, 0xF0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01, 0x00, 0x08, 0x08, 0xF8,
+    0x00, 0x00, 0x00, 0x02, 0x02, 0x03, 0x02, 0x02, 0x00, 0x10, 0x08, 0x88, 0xC8, 0x70, 0x00, 0x02,
+    0x03, 0x02, 0x02, 0x02, 0x00, 0x10, 0x48, 0x48, 0x48, 0xB0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01,
+    0x00, 0xC0, 0xE0, 0x90, 0xF8, 0x80, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x38, 0x28, 0x28,
+    0x28, 0xC0, 0x00, 0x02, 0x02, 0x02, 0x02, 0x01, 0x00, 0xF0, 0x58, 0x48, 0x48, 0x88, 0x00, 0x01,
+    0x02, 0x02, 0x02, 0x01, 0x00, 0x08, 0x08, 0x88, 0x78, 0x18, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00,
+    0x00, 0xB0, 0x48, 0x48, 0x48, 0xB0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01, 0x00, 0x30, 0x48, 0x48,
+    0x48, 0xF0, 0x00, 0x02, 0x02, 0x02, 0x03, 0x01, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+    0x00, 0x40, 0xA0, 0xA0, 0xA0, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xA0, 0xA0, 0xA0, 0xA0,
+    0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0xA0, 0xA0, 0xA0, 0x40, 0x00, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0xC8, 0x28, 0x18, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0xE0, 0x18, 0xE8, 0x28, 0xF0, 0x00, 0x03, 0x04, 0x0B, 0x0A, 0x03, 0x00, 0x00, 0xE0, 0x98,
+    0xE0, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0xF8, 0x48, 0x48, 0x48, 0xB0, 0x00, 0x03,
+    0x02, 0x02, 0x02, 0x01, 0x00, 0xF0, 0x18, 0x08, 0x08, 0x18, 0x00, 0x01, 0x03, 0x02, 0x02, 0x03,
+    0x00, 0xF8, 0x08, 0x08, 0x18, 0xF0, 0x00, 0x03, 0x02, 0x02, 0x03, 0x01, 0x00, 0xF8, 0x48, 0x48,
+    0x48, 0x48, 0x00, 0x03, 0x02, 0x02, 0x02, 0x02, 0x00, 0xF8, 0x48, 0x48, 0x48, 0x48, 0x00, 0x03,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x18, 0x08, 0x48, 0xD0, 0x00, 0x01, 0x03, 0x02, 0x02, 0x03,
+    0x00, 0xF8, 0x40, 0x40, 0x40, 0xF8, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x08, 0x08, 0xF8,
+    0x08, 0x08, 0x00, 0x02, 0x02, 0x03, 0x02, 0x02, 0x00, 0x00, 0x08, 0x08, 0xF8, 0x00, 0x00, 0x01,
+    0x02, 0x02, 0x01, 0x00, 0x00, 0xF8, 0x40, 0xA0, 0x10, 0x08, 0x00, 0x03, 0x00, 0x00, 0x01, 0x02,
+    0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x02, 0x02, 0x02, 0x02, 0x00, 0xF8, 0x30, 0x40,
+    0x30, 0xF8, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0xF8, 0x30, 0x40, 0x80, 0xF8, 0x00, 0x03,
+    0x00, 0x00, 0x01, 0x03, 0x00, 0xF0, 0x08, 0x08, 0x08, 0xF0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01,
+    0x00, 0xF8, 0x48, 0x48, 0x48, 0x30, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x08, 0x08,
+    0x08, 0xF0, 0x00, 0x01, 0x02, 0x02, 0x06, 0x05, 0x00, 0xF8, 0x48, 0x48, 0xC8, 0xB0, 0x00, 0x03,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x30, 0x48, 0x48, 0x48, 0x90, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01,
+    0x00, 0x08, 0x08, 0xF8, 0x08, 0x08, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00,
+    0x00, 0xF8, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01, 0x00, 0x18, 0xE0, 0x00, 0xE0, 0x18, 0x00, 0x00,
+    0x00, 0x03, 0x00, 0x00, 0x38, 0xC0, 0x70, 0x70, 0xC0, 0x38, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00,
+    0x00, 0x08, 0xB0, 0x40, 0xB0, 0x08, 0x00, 0x02, 0x01, 0x00, 0x01, 0x02, 0x00, 0x08, 0x30, 0xC0,
+    0x30, 0x08, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x08, 0x88, 0x48, 0x38, 0x08, 0x00, 0x02,
+    0x03, 0x02, 0x02, 0x02, 0x00, 0x00, 0xFC, 0x04, 0x00, 0x00, 0x00, 0x00, 0x07, 0x04, 0x00, 0x00,
+    0x00, 0x08, 0x30, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x00, 0x00, 0x04, 0xFC,
+    0x00, 0x00, 0x00, 0x00, 0x04, 0x07, 0x00, 0x00, 0x20, 0x10, 0x08, 0x10, 0x20, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x00, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xA0, 0xA0,
+    0xA0, 0xC0, 0x00, 0x03, 0x02, 0x02, 0x02, 0x03, 0x00, 0xFC, 0x20, 0x20, 0x20, 0xC0, 0x00, 0x03,
+    0x02, 0x02, 0x02, 0x01, 0x00, 0xC0, 0x20, 0x20, 0x20, 0x00, 0x00, 0x01, 0x02, 0x02, 0x02, 0x00,
+    0x00, 0xC0, 0x20, 0x20, 0x20, 0xFC, 0x00, 0x01, 0x02, 0x02, 0x02, 0x03, 0x00, 0xC0, 0xA0, 0xA0,
+    0xA0, 0xC0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x02, 0x00, 0x20, 0xF8, 0x24, 0x24, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x20, 0x20, 0x20, 0xE0, 0x00, 0x01, 0x0A, 0x0A, 0x0A, 0x07,
+    0x00, 0xFC, 0x40, 0x20, 0x20, 0xC0, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x20, 0xE4,
+    0x00, 0x00, 0x00, 0x02, 0x02, 0x03, 0x02, 0x02, 0x00, 0x20, 0x20, 0xE4, 0x00, 0x00, 0x00, 0x08,
+    0x08, 0x07, 0x00, 0x00, 0x00, 0xFC, 0x80, 0xC0, 0x20, 0x00, 0x00, 0x03, 0x00, 0x00, 0x01, 0x02,
+    0x04, 0x04, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x02, 0x00, 0x00, 0xE0, 0x20, 0xE0,
+    0x20, 0xE0, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0xE0, 0x40, 0x20, 0x20, 0xC0, 0x00, 0x03,
+    0x00, 0x00, 0x00, 0x03, 0x00, 0xC0, 0x20, 0x20, 0x20, 0xC0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01,
+    0x00, 0xE0, 0x20, 0x20, 0x20, 0xC0, 0x00, 0x0F, 0x02, 0x02, 0x02, 0x01, 0x00, 0xC0, 0x20, 0x20,
+    0x20, 0xE0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x0F, 0x00, 0x00, 0xE0, 0x20, 0x20, 0x60, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x40, 0xA0, 0xA0, 0xA0, 0xA0, 0x00, 0x02, 0x02, 0x02, 0x02, 0x01,
+    0x00, 0x20, 0xF8, 0x20, 0x20, 0x00, 0x00, 0x00, 0x03, 0x02, 0x02, 0x00, 0x00, 0xE0, 0x00, 0x00,
+    0x00, 0xE0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x03, 0x00, 0x20, 0xC0, 0x00, 0xC0, 0x20, 0x00, 0x00,
+    0x01, 0x02, 0x01, 0x00, 0x00, 0x60, 0x80, 0x40, 0x80, 0x60, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00,
+    0x00, 0x20, 0x60, 0x80, 0x60, 0x20, 0x00, 0x02, 0x03, 0x00, 0x03, 0x02, 0x00, 0x20, 0xC0, 0x00,
+    0xC0, 0x20, 0x00, 0x08, 0x08, 0x07, 0x00, 0x00, 0x00, 0x20, 0x20, 0xA0, 0x60, 0x20, 0x00, 0x02,
+    0x03, 0x02, 0x02, 0x02, 0x00, 0x40, 0x40, 0xBC, 0x04, 0x00, 0x00, 0x00, 0x00, 0x07, 0x04, 0x00,
+    0x00, 0x00, 0x00, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x04, 0xBC,
+    0x40, 0x40, 0x00, 0x00, 0x04, 0x07, 0x00, 0x00, 0x00, 0x40, 0x40, 0x40, 0x80, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F,
+    0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08,
+    0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F,
+    0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F,
+    0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08,
+    0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F,
+    0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F,
+    0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08,
+    0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F,
+    0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F,
+    0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08,
+    0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F,
+    0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F,
+    0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08,
+    0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F,
+    0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F,
+    0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08,
+    0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F,
+    0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F,
+    0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08,
+    0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F,
+    0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F,
+    0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08,
+    0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F,
+    0x08, 0x08, 0x08, 0x0F, 0x00, 0xF8, 0x08, 0x08, 0x08, 0xF8, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA0,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0xC0, 0x20, 0xF0, 0x20, 0x00, 0x00, 0x01,
+    0x02, 0x0F, 0x02, 0x00, 0x00, 0x40, 0xF0, 0x48, 0x48, 0x08, 0x00, 0x02, 0x03, 0x02, 0x02, 0x02,
+    0x00, 0x10, 0xE0, 0xA0, 0xE0, 0x10, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0xA8, 0xB0, 0xC0,
+    0xB0, 0xA8, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x0F, 0x00, 0x00, 0x00, 0xD8, 0xA8, 0x68, 0xC8, 0x00, 0x00, 0x04, 0x04, 0x05, 0x06, 0x00,
+    0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x18, 0x68, 0x98,
+    0x98, 0xE0, 0x00, 0x03, 0x02, 0x02, 0x03, 0x00, 0x00, 0x78, 0x58, 0x58, 0x78, 0x00, 0x00, 0x01,
+    0x01, 0x01, 0x01, 0x00, 0x00, 0xC0, 0x20, 0xC0, 0x20, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00,
+    0x00, 0x40, 0x40, 0x40, 0x40, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80,
+    0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x18, 0xF8, 0x78, 0xB8, 0xE0, 0x00, 0x03,
+    0x02, 0x02, 0x03, 0x00, 0x00, 0x00, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x38, 0x28, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0xF0,
+    0x40, 0x40, 0x00, 0x02, 0x02, 0x03, 0x02, 0x02, 0x00, 0x00, 0x48, 0x68, 0x58, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x58, 0x68, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00,
+    0x00, 0xE0, 0x00, 0x0F, 0x02, 0x02, 0x02, 0x03, 0x00, 0x30, 0x78, 0xF8, 0x08, 0xF8, 0x00, 0x00,
+    0x00, 0x07, 0x00, 0x07, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x48, 0x78,
+    0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x48, 0x48, 0x30, 0x00, 0x00, 0x01,
+    0x01, 0x01, 0x01, 0x00, 0x00, 0x20, 0xC0, 0x20, 0xC0, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00,
+    0x80, 0xA4, 0xFC, 0x60, 0x40, 0x00, 0x00, 0x00, 0x06, 0x06, 0x0F, 0x04, 0x80, 0xA4, 0xFC, 0x60,
+    0x40, 0x00, 0x00, 0x00, 0x00, 0x09, 0x0D, 0x0B, 0x80, 0xA4, 0xEC, 0x74, 0x40, 0x00, 0x00, 0x00,
+    0x06, 0x06, 0x0F, 0x04, 0x00, 0x00, 0x00, 0xA0, 0x00, 0x00, 0x00, 0x0C, 0x0A, 0x09, 0x08, 0x00,
+    0x00, 0x00, 0xE1, 0x9A, 0xE0, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0xE0, 0x9A,
+    0xE1, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0xE2, 0x99, 0xE2, 0x00, 0x00, 0x03,
+    0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0xE3, 0x9A, 0xE1, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03,
+    0x00, 0x00, 0xE2, 0x98, 0xE2, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0xE6, 0x9A,
+    0xE6, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0xE0, 0x98, 0xF8, 0x48, 0x48, 0x03, 0x00,
+    0x00, 0x03, 0x02, 0x02, 0x00, 0xF0, 0x18, 0x08, 0x08, 0x18, 0x00, 0x01, 0x0B, 0x0E, 0x02, 0x03,
+    0x00, 0xF8, 0x49, 0x4A, 0x48, 0x48, 0x00, 0x03, 0x02, 0x02, 0x02, 0x02, 0x00, 0xF8, 0x48, 0x4A,
+    0x49, 0x48, 0x00, 0x03, 0x02, 0x02, 0x02, 0x02, 0x00, 0xF8, 0x4A, 0x49, 0x4A, 0x48, 0x00, 0x03,
+    0x02, 0x02, 0x02, 0x02, 0x00, 0xF8, 0x4A, 0x48, 0x4A, 0x48, 0x00, 0x03, 0x02, 0x02, 0x02, 0x02,
+    0x00, 0x08, 0x09, 0xFA, 0x08, 0x08, 0x00, 0x02, 0x02, 0x03, 0x02, 0x02, 0x00, 0x08, 0x08, 0xFA,
+    0x09, 0x08, 0x00, 0x02, 0x02, 0x03, 0x02, 0x02, 0x00, 0x08, 0x0A, 0xF9, 0x0A, 0x08, 0x00, 0x02,
+    0x02, 0x03, 0x02, 0x02, 0x00, 0x08, 0x0A, 0xF8, 0x0A, 0x08, 0x00, 0x02, 0x02, 0x03, 0x02, 0x02,
+    0x40, 0xF8, 0x48, 0x08, 0x18, 0xF0, 0x00, 0x03, 0x02, 0x02, 0x03, 0x01, 0x00, 0xF8, 0x33, 0x42,
+    0x81, 0xF8, 0x00, 0x03, 0x00, 0x00, 0x01, 0x03, 0x00, 0xF0, 0x09, 0x0A, 0x08, 0xF0, 0x00, 0x01,
+    0x02, 0x02, 0x02, 0x01, 0x00, 0xF0, 0x08, 0x0A, 0x09, 0xF0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01,
+    0x00, 0xF0, 0x0A, 0x09, 0x0A, 0xF0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01, 0x00, 0xF0, 0x0B, 0x0A,
+    0x09, 0xF0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01, 0x00, 0xF0, 0x0A, 0x08, 0x0A, 0xF0, 0x00, 0x01,
+    0x02, 0x02, 0x02, 0x01, 0x00, 0x20, 0x40, 0x80, 0x40, 0x20, 0x00, 0x02, 0x01, 0x00, 0x01, 0x02,
+    0x00, 0xF0, 0x88, 0x48, 0x28, 0xF8, 0x02, 0x01, 0x02, 0x02, 0x02, 0x01, 0x00, 0xF8, 0x01, 0x02,
+    0x00, 0xF8, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01, 0x00, 0xF8, 0x00, 0x02, 0x01, 0xF8, 0x00, 0x01,
+    0x02, 0x02, 0x02, 0x01, 0x00, 0xF8, 0x02, 0x01, 0x02, 0xF8, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01,
+    0x00, 0xF8, 0x02, 0x00, 0x02, 0xF8, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01, 0x00, 0x08, 0x30, 0xC2,
+    0x31, 0x08, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0xF8, 0x90, 0x90, 0x90, 0x60, 0x00, 0x03,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x04, 0x74, 0x98, 0x80, 0x00, 0x03, 0x00, 0x02, 0x02, 0x03,
+    0x00, 0x24, 0xA8, 0xA0, 0xA0, 0xC0, 0x00, 0x03, 0x02, 0x02, 0x02, 0x03, 0x00, 0x20, 0xA8, 0xA4,
+    0xA0, 0xC0, 0x00, 0x03, 0x02, 0x02, 0x02, 0x03, 0x00, 0x28, 0xA4, 0xA8, 0xA0, 0xC0, 0x00, 0x03,
+    0x02, 0x02, 0x02, 0x03, 0x00, 0x28, 0xA4, 0xA8, 0xA4, 0xC0, 0x00, 0x03, 0x02, 0x02, 0x02, 0x03,
+    0x00, 0x20, 0xA4, 0xA0, 0xA4, 0xC0, 0x00, 0x03, 0x02, 0x02, 0x02, 0x03, 0x00, 0x20, 0xAE, 0xAA,
+    0xAE, 0xC0, 0x00, 0x03, 0x02, 0x02, 0x02, 0x03, 0x00, 0xA0, 0xA0, 0xC0, 0xA0, 0xE0, 0x00, 0x03,
+    0x02, 0x01, 0x02, 0x02, 0x00, 0xC0, 0x20, 0x20, 0x20, 0x00, 0x00, 0x01, 0x02, 0x0A, 0x0E, 0x00,
+    0x00, 0xC4, 0xA8, 0xA0, 0xA0, 0xC0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x02, 0x00, 0xC0, 0xA8, 0xA4,
+    0xA0, 0xC0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x02, 0x00, 0xC8, 0xA4, 0xA8, 0xA0, 0xC0, 0x00, 0x01,
+    0x02, 0x02, 0x02, 0x02, 0x00, 0xC0, 0xA4, 0xA0, 0xA4, 0xC0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x02,
+    0x00, 0x04, 0x28, 0xE0, 0x00, 0x00, 0x00, 0x02, 0x02, 0x03, 0x02, 0x02, 0x00, 0x00, 0x28, 0xE4,
+    0x00, 0x00, 0x00, 0x02, 0x02, 0x03, 0x02, 0x02, 0x00, 0x08, 0x24, 0xE8, 0x00, 0x00, 0x00, 0x02,
+    0x02, 0x03, 0x02, 0x02, 0x00, 0x00, 0x24, 0xE0, 0x04, 0x00, 0x00, 0x02, 0x02, 0x03, 0x02, 0x02,
+    0x00, 0xC0, 0x2C, 0x28, 0x38, 0xE0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01, 0x00, 0xE8, 0x44, 0x28,
+    0x24, 0xC0, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0xC4, 0x28, 0x20, 0x20, 0xC0, 0x00, 0x01,
+    0x02, 0x02, 0x02, 0x01, 0x00, 0xC0, 0x28, 0x24, 0x20, 0xC0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01,
+    0x00, 0xC0, 0x28, 0x24, 0x28, 0xC0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01, 0x00, 0xC8, 0x24, 0x2C,
+    0x28, 0xC4, 0x00, 0x01, 0x02, 0x02, 0x02, 0x01, 0x00, 0xC0, 0x24, 0x20, 0x24, 0xC0, 0x00, 0x01,
+    0x02, 0x02, 0x02, 0x01, 0x40, 0x40, 0x50, 0x40, 0x40, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0xC0, 0x20, 0xA0, 0x60, 0xE0, 0x00, 0x03, 0x03, 0x02, 0x02, 0x01, 0x00, 0xE4, 0x08, 0x00,
+    0x00, 0xE0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x03, 0x00, 0xE0, 0x08, 0x04, 0x00, 0xE0, 0x00, 0x01,
+    0x02, 0x02, 0x02, 0x03, 0x00, 0xE0, 0x08, 0x04, 0x08, 0xE0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x03,
+    0x00, 0xE0, 0x04, 0x00, 0x04, 0xE0, 0x00, 0x01, 0x02, 0x02, 0x02, 0x03, 0x00, 0x20, 0xC8, 0x04,
+    0xC0, 0x20, 0x00, 0x08, 0x08, 0x07, 0x00, 0x00, 0x00, 0xFC, 0x20, 0x20, 0x20, 0xC0, 0x00, 0x0F,
+    0x02, 0x02, 0x02, 0x01, 0x00, 0x20, 0xC4, 0x00, 0xC4, 0x20, 0x00, 0x08, 0x08, 0x07, 0x00, 0x00,
+};
+
+const font_native_t Monospaced_plain_10_native =
+{
+    .height = 13,
+    .pages = 2,
+    .first = 32,
+    .count = 224,
+    .packed = 0,
+    .glyphs = Monospaced_plain_10_glyphs,
+    .bitmap = Monospaced_plain_10_bitmap,
+};
+
+static const font_glyph_t Dialog_plain_12_glyphs[224] =
+{
+    {    0,  4}, // 32
+    {    8,  5}, // 33
+    {   18,  5}, // 34
+    {   28, 10}, // 35
+    {   48,  8}, // 36
+    {   64, 11}, // 37
+    {   86, 10}, // 38
+    {  106,  3}, // 39
+    {  112,  5}, // 40
+    {  122,  5}, // 41
+    {  132,  6}, // 42
+    {  144, 10}, // 43
+    {  164,  4}, // 44
+    {  172,  4}, // 45
+    {  180,  4}, // 46
+    {  188,  4}, // 47
+    {  196,  8}, // 48
+    {  212,  8}, // 49
+    {  228,  8}, // 50
+    {  244,  8}, // 51
+    {  260,  8}, // 52
+    {  276,  8}, // 53
+    {  292,  8}, // 54
+    {  308,  8}, // 55
+    {  324,  8}, // 56
+    {  340,  8}, // 57
+    {  356,  4}, // 58
+    {  364,  4}, // 59
+    {  372, 10}, // 60
+    {  392, 10}, // 61
+    {  412, 10}, // 62
+    {  432,  6}, // 63
+    {  444, 13}, // 64
+    {  470,  8}, // 65
+    {  486,  8}, // 66
+    {  502,  8}, // 67
+    {  518,  9}, // 68
+    {  536,  8}, // 69
+    {  552,  7}, // 70
+    {  566,  9}, // 71
+    {  584,  9}, // 72
+    {  602,  3}, // 73
+    {  608,  3}, // 74
+    {  614,  7}, // 75
+    {  628,  6}, // 76
+    {  640, 10}, // 77
+    {  660,  9}, // 78
+    {  678,  9}, // 79
+    {  696,  8}, // 80
+    {  712,  9}, // 81
+    {  730,  8}, // 82
+    {  746,  8}, // 83
+    {  762,  7}, // 84
+    {  776,  9}, // 85
+    {  794,  8}, // 86
+    {  810, 11}, // 87
+    {  832,  7}, // 88
+    {  846,  7}, // 89
+    {  860,  9}, // 90
+    {  878,  5}, // 91
+    {  888,  4}, // 92
+    {  896,  5}, // 93
+    {  906, 10}, // 94
+    {  926,  6}, // 95
+    {  938,  6}, // 96
+    {  950,  8}, // 97
+    {  966,  8}, // 98
+    {  982,  7}, // 99
+    {  996,  8}, // 100
+    { 1012,  8}, // 101
+    { 1028,  4}, // 102
+    { 1036,  8}, // 103
+    { 1052,  8}, // 104
+    { 1068,  3}, // 105
+    { 1074,  3}, // 106
+    { 1080,  7}, // 107
+    { 1094,  3}, // 108
+    { 1100, 11}, // 109
+    { 1122,  8}, // 110
+    { 1138,  8}, // 111
+    { 1154,  8}, // 112
+    { 1170,  8}, // 113
+    { 1186,  5}, // 114
+    { 1196,  7}, // 115
+    { 1210,  5}, // 116
+    { 1220,  8}, // 117
+    { 1236,  6}, // 118
+    { 1248,  9}, // 119
+    { 1266,  6}, // 120
+    { 1278,  6}, // 121
+    { 1290,  5}, // 122
+    { 1300,  8}, // 123
+    { 1316,  4}, // 124
+    { 1324,  8}, // 125
+    { 1340, 10}, // 126
+    { 1360,  7}, // 127
+    { 1374,  7}, // 128
+    { 1388,  7}, // 129
+    { 1402,  7}, // 130
+    { 1416,  7}, // 131
+    { 1430,  7}, // 132
+    { 1444,  7}, // 133
+    { 1458,  7}, // 134
+    { 1472,  7}, // 135
+    { 1486,  7}, // 136
+    { 1500,  7}, // 137
+    { 1514,  7}, // 138
+    { 1528,  7}, // 139
+    { 1542,  7}, // 140
+    { 1556,  7}, // 141
+    { 1570,  7}, // 142
+    { 1584,  7}, // 143
+    { 1598,  7}, // 144
+    { 1612,  7}, // 145
+    { 1626,  7}, // 146
+    { 1640,  7}, // 147
+    { 1654,  7}, // 148
+    { 1668,  7}, // 149
+    { 1682,  7}, // 150
+    { 1696,  7}, // 151
+    { 1710,  7}, // 152
+    { 1724,  7}, // 153
+    { 1738,  7}, // 154
+    { 1752,  7}, // 155
+    { 1766,  7}, // 156
+    { 1780,  7}, // 157
+    { 1794,  7}, // 158
+    { 1808,  7}, // 159
+    { 1822,  4}, // 160
+    { 1830,  5}, // 161
+    { 1840,  8}, // 162
+    { 1856,  8}, // 163
+    { 1872,  8}, // 164
+    { 1888,  8}, // 165
+    { 1904,  4}, // 166
+    { 1912,  6}, // 167
+    { 1924,  6}, // 168
+    { 1936, 12}, // 169
+    { 1960,  6}, // 170
+    { 1972,  7}, // 171
+    { 1986, 10}, // 172
+    { 2006,  4}, // 173
+    { 2014, 12}, // 174
+    { 2038,  6}, // 175
+    { 2050,  6}, // 176
+    { 2062, 10}, // 177
+    { 2082,  5}, // 178
+    { 2092,  5}, // 179
+    { 2102,  6}, // 180
+    { 2114,  8}, // 181
+    { 2130,  8}, // 182
+    { 2146,  4}, // 183
+    { 2154,  6}, // 184
+    { 2166,  5}, // 185
+    { 2176,  6}, // 186
+    { 2188,  7}, // 187
+    { 2202, 12}, // 188
+    { 2226, 12}, // 189
+    { 2250, 12}, // 190
+    { 2274,  6}, // 191
+    { 2286,  8}, // 192
+    { 2302,  8}, // 193
+    { 2318,  8}, // 194
+    { 2334,  8}, // 195
+    { 2350,  8}, // 196
+    { 2366,  8}, // 197
+    { 2382, 12}, // 198
+    { 2406,  8}, // 199
+    { 2422,  8}, // 200
+    { 2438,  8}, // 201
+    { 2454,  8}, // 202
+    { 2470,  8}, // 203
+    { 2486,  3}, // 204
+    { 2492,  3}, // 205
+    { 2498,  3}, // 206
+    { 2504,  3}, // 207
+    { 2510,  9}, // 208
+    { 2528,  9}, // 209
+    { 2546,  9}, // 210
+    { 2564,  9}, // 211
+    { 2582,  9}, // 212
+    { 2600,  9}, // 213
+    { 2618,  9}, // 214
+    { 2636, 10}, // 215
+    { 2656,  9}, // 216
+    { 2674,  9}, // 217
+    { 2692,  9}, // 218
+    { 2710,  9}, // 219
+    { 2728,  9}, // 220
+    { 2746,  7}, // 221
+    { 2760,  8}, // 222
+    { 2776,  8}, // 223
+    { 2792,  8}, // 224
+    { 2808,  8}, // 225
+    { 2824,  8}, // 226
+    { 2840,  8}, // 227
+    { 2856,  8}, // 228
+    { 2872,  8}, // 229
+    { 2888, 12}, // 230
+    { 2912,  7}, // 231
+    { 2926,  8}, // 232
+    { 2942,  8}, // 233
+    { 2958,  8}, // 234
+    { 2974,  8}, // 235
+    { 2990,  3}, // 236
+    { 2996,  3}, // 237
+    { 3002,  3}, // 238
+    { 3008,  3}, // 239
+    { 3014,  8}, // 240
+    { 3030,  8}, // 241
+    { 3046,  8}, // 242
+    { 3062,  8}, // 243
+    { 3078,  8}, // 244
+    { 3094,  8}, // 245
+    { 3110,  8}, // 246
+    { 3126, 10}, // 247
+    { 3146,  8}, // 248
+    { 3162,  8}, // 249
+    { 3178,  8}, // 250
+    { 3194,  8}, // 251
+    { 3210,  8}, // 252
+    { 3226,  6}, // 253
+    { 3238,  8}, // 254
+    { 3254,  6}, // 255
+};
+
+static const uint8_t Dialog_plain_12_bitmap[3266] =
+{
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x0D,
+    0x00, 0x00, 0x00, 0x38, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0xC0,
+    0x70, 0x40, 0xE0, 0x50, 0x40, 0x00, 0x00, 0x02, 0x0A, 0x07, 0x02, 0x0E, 0x03, 0x02, 0x00, 0x00,
+    0x00, 0x00, 0xE0, 0x90, 0xF8, 0x10, 0x20, 0x00, 0x00, 0x00, 0x04, 0x08, 0x3F, 0x09, 0x07, 0x00,
+    0x70, 0x88, 0x88, 0x70, 0x80, 0xC0, 0x30, 0x88, 0x80, 0x00, 0x00, 0x00, 0x00, 0x08, 0x06, 0x01,
+    0x00, 0x07, 0x08, 0x08, 0x07, 0x00, 0x00, 0x00, 0xF0, 0x48, 0x88, 0x10, 0x00, 0x00, 0x80, 0x00,
+    0x00, 0x07, 0x0C, 0x08, 0x08, 0x09, 0x06, 0x0A, 0x09, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xE0, 0x1C, 0x04, 0x00, 0x00, 0x03, 0x1C, 0x10, 0x00, 0x00, 0x04, 0x1C, 0xE0, 0x00, 0x00,
+    0x10, 0x1C, 0x03, 0x00, 0x00, 0x90, 0x60, 0xF8, 0x60, 0x90, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x0F, 0x01,
+    0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x18,
+    0x18, 0x07, 0x00, 0x00, 0x00, 0xE0, 0x18, 0x08, 0x08, 0x18, 0xE0, 0x00, 0x00, 0x03, 0x0C, 0x08,
+    0x08, 0x0C, 0x03, 0x00, 0x00, 0x08, 0x08, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x0F,
+    0x08, 0x08, 0x00, 0x00, 0x00, 0x10, 0x08, 0x08, 0x08, 0x98, 0x70, 0x00, 0x00, 0x08, 0x0C, 0x0A,
+    0x09, 0x08, 0x08, 0x00, 0x00, 0x10, 0x08, 0x88, 0x88, 0x88, 0x70, 0x00, 0x00, 0x04, 0x08, 0x08,
+    0x08, 0x08, 0x07, 0x00, 0x00, 0x00, 0xC0, 0x20, 0x18, 0xF8, 0x00, 0x00, 0x00, 0x03, 0x02, 0x02,
+    0x02, 0x0F, 0x02, 0x00, 0x00, 0x78, 0x48, 0x48, 0x48, 0xC8, 0x80, 0x00, 0x00, 0x04, 0x08, 0x08,
+    0x08, 0x0C, 0x07, 0x00, 0x00, 0xE0, 0x90, 0x48, 0x48, 0xC8, 0x90, 0x00, 0x00, 0x03, 0x0C, 0x08,
+    0x08, 0x0C, 0x07, 0x00, 0x00, 0x08, 0x08, 0x08, 0x88, 0x68, 0x18, 0x00, 0x00, 0x00, 0x08, 0x06,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x70, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00, 0x00, 0x07, 0x08, 0x08,
+    0x08, 0x08, 0x07, 0x00, 0x00, 0xF0, 0x98, 0x08, 0x08, 0x98, 0xE0, 0x00, 0x00, 0x04, 0x09, 0x09,
+    0x09, 0x04, 0x03, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00, 0xC0, 0x00, 0x00,
+    0x00, 0x1C, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x40, 0x40, 0x40, 0x60, 0x20, 0x00, 0x00, 0x01,
+    0x01, 0x01, 0x02, 0x02, 0x02, 0x06, 0x04, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x00, 0x00, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x00, 0x00, 0x20, 0x60, 0x40,
+    0x40, 0x40, 0x80, 0x80, 0x80, 0x00, 0x00, 0x04, 0x06, 0x02, 0x02, 0x02, 0x01, 0x01, 0x01, 0x00,
+    0x10, 0x08, 0x88, 0x48, 0x30, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x20, 0x10,
+    0x88, 0x48, 0x48, 0x48, 0xC8, 0x10, 0x30, 0xC0, 0x00, 0x00, 0x07, 0x08, 0x10, 0x23, 0x24, 0x24,
+    0x24, 0x27, 0x14, 0x02, 0x01, 0x00, 0x00, 0x00, 0xE0, 0x18, 0x18, 0xE0, 0x00, 0x00, 0x08, 0x07,
+    0x02, 0x02, 0x02, 0x02, 0x07, 0x08, 0x00, 0xF8, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00, 0x00, 0x0F,
+    0x08, 0x08, 0x08, 0x08, 0x07, 0x00, 0x00, 0xE0, 0x10, 0x08, 0x08, 0x08, 0x10, 0x00, 0x00, 0x03,
+    0x04, 0x08, 0x08, 0x08, 0x04, 0x00, 0x00, 0xF8, 0x08, 0x08, 0x08, 0x08, 0x10, 0xE0, 0x00, 0x00,
+    0x0F, 0x08, 0x08, 0x08, 0x08, 0x04, 0x03, 0x00, 0x00, 0xF8, 0x88, 0x88, 0x88, 0x88, 0x88, 0x00,
+    0x00, 0x0F, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0xF8, 0x88, 0x88, 0x88, 0x88, 0x00, 0x00,
+    0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x10, 0x08, 0x08, 0x88, 0x88, 0x90, 0x00, 0x00,
+    0x03, 0x04, 0x08, 0x08, 0x08, 0x08, 0x07, 0x00, 0x00, 0xF8, 0x80, 0x80, 0x80, 0x80, 0x80, 0xF8,
+    0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x0F, 0x00,
+    0x00, 0xF8, 0x00, 0x20, 0x1F, 0x00, 0x00, 0xF8, 0x80, 0x40, 0x20, 0x10, 0x08, 0x00, 0x0F, 0x00,
+    0x01, 0x02, 0x04, 0x08, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x08,
+    0x00, 0xF8, 0x30, 0xC0, 0x00, 0x00, 0xC0, 0x30, 0xF8, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x03, 0x03,
+    0x00, 0x00, 0x0F, 0x00, 0x00, 0xF8, 0x18, 0x60, 0x80, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x0F, 0x00,
+    0x00, 0x00, 0x03, 0x0C, 0x0F, 0x00, 0x00, 0xE0, 0x10, 0x08, 0x08, 0x08, 0x10, 0xE0, 0x00, 0x00,
+    0x03, 0x04, 0x08, 0x08, 0x08, 0x04, 0x03, 0x00, 0x00, 0xF8, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00,
+    0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x10, 0x08, 0x08, 0x08, 0x10, 0xE0,
+    0x00, 0x00, 0x03, 0x04, 0x08, 0x08, 0x18, 0x24, 0x03, 0x00, 0x00, 0xF8, 0x88, 0x88, 0x88, 0x88,
+    0x70, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x01, 0x06, 0x08, 0x00, 0x70, 0x88, 0x88, 0x88, 0x88,
+    0x10, 0x00, 0x00, 0x04, 0x08, 0x08, 0x08, 0x08, 0x07, 0x00, 0x08, 0x08, 0x08, 0xF8, 0x08, 0x08,
+    0x08, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8,
+    0x00, 0x00, 0x07, 0x0C, 0x08, 0x08, 0x08, 0x0C, 0x07, 0x00, 0x18, 0xE0, 0x00, 0x00, 0x00, 0x00,
+    0xE0, 0x18, 0x00, 0x00, 0x03, 0x0C, 0x0C, 0x03, 0x00, 0x00, 0x08, 0x70, 0x80, 0x00, 0xC0, 0x38,
+    0xC0, 0x00, 0x80, 0x70, 0x08, 0x00, 0x00, 0x03, 0x0C, 0x03, 0x00, 0x03, 0x0C, 0x03, 0x00, 0x00,
+    0x08, 0x18, 0x60, 0x80, 0x60, 0x18, 0x08, 0x08, 0x04, 0x03, 0x00, 0x03, 0x04, 0x08, 0x08, 0x30,
+    0xC0, 0x00, 0xC0, 0x30, 0x08, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x08,
+    0x88, 0x48, 0x28, 0x18, 0x00, 0x00, 0x0C, 0x0A, 0x09, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00,
+    0xF8, 0x08, 0x00, 0x00, 0x00, 0x3F, 0x20, 0x00, 0x18, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x07, 0x18,
+    0x00, 0x08, 0xF8, 0x00, 0x00, 0x00, 0x20, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x20, 0x10, 0x08, 0x08,
+    0x10, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00, 0x04, 0x08, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x20, 0x20, 0x20, 0x20, 0xC0, 0x00, 0x00, 0x06,
+    0x09, 0x09, 0x09, 0x05, 0x0F, 0x00, 0x00, 0xFC, 0x60, 0x20, 0x20, 0x60, 0xC0, 0x00, 0x00, 0x0F,
+    0x0C, 0x08, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xC0, 0x60, 0x20, 0x20, 0x40, 0x00, 0x00, 0x07, 0x0C,
+    0x08, 0x08, 0x04, 0x00, 0x00, 0xC0, 0x60, 0x20, 0x20, 0x60, 0xFC, 0x00, 0x00, 0x07, 0x0C, 0x08,
+    0x08, 0x0C, 0x0F, 0x00, 0x00, 0xC0, 0x60, 0x20, 0x20, 0x60, 0xC0, 0x00, 0x00, 0x07, 0x0D, 0x09,
+    0x09, 0x09, 0x05, 0x00, 0x20, 0xF8, 0x24, 0x24, 0x00, 0x0F, 0x00, 0x00, 0x00, 0xC0, 0x60, 0x20,
+    0x20, 0x60, 0xE0, 0x00, 0x00, 0x07, 0x2C, 0x48, 0x48, 0x6C, 0x3F, 0x00, 0x00, 0xFC, 0x40, 0x20,
+    0x20, 0x20, 0xC0, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0xE8, 0x00, 0x00,
+    0x0F, 0x00, 0x00, 0xE8, 0x00, 0x40, 0x7F, 0x00, 0x00, 0xFC, 0x00, 0x80, 0x40, 0x20, 0x00, 0x00,
+    0x0F, 0x01, 0x02, 0x04, 0x08, 0x00, 0x00, 0xFC, 0x00, 0x00, 0x0F, 0x00, 0x00, 0xE0, 0x20, 0x20,
+    0x20, 0xC0, 0x20, 0x20, 0x20, 0xC0, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x0F, 0x00, 0x00, 0xE0, 0x40, 0x20, 0x20, 0x20, 0xC0, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00,
+    0x0F, 0x00, 0x00, 0xC0, 0x60, 0x20, 0x20, 0x60, 0xC0, 0x00, 0x00, 0x07, 0x0C, 0x08, 0x08, 0x0C,
+    0x07, 0x00, 0x00, 0xE0, 0x60, 0x20, 0x20, 0x60, 0xC0, 0x00, 0x00, 0x7F, 0x0C, 0x08, 0x08, 0x0C,
+    0x07, 0x00, 0x00, 0xC0, 0x60, 0x20, 0x20, 0x60, 0xE0, 0x00, 0x00, 0x07, 0x0C, 0x08, 0x08, 0x0C,
+    0x7F, 0x00, 0x00, 0xE0, 0x40, 0x20, 0x20, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x20, 0x20,
+    0x20, 0x40, 0x00, 0x00, 0x04, 0x09, 0x09, 0x09, 0x06, 0x00, 0x20, 0xF8, 0x20, 0x20, 0x00, 0x00,
+    0x0F, 0x08, 0x08, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x07, 0x08, 0x08,
+    0x08, 0x04, 0x0F, 0x00, 0x60, 0x80, 0x00, 0x00, 0x80, 0x60, 0x00, 0x03, 0x0C, 0x0C, 0x03, 0x00,
+    0x60, 0x80, 0x00, 0x80, 0x60, 0x80, 0x00, 0x80, 0x60, 0x00, 0x03, 0x0C, 0x03, 0x00, 0x03, 0x0C,
+    0x03, 0x00, 0x20, 0xC0, 0x00, 0x00, 0xC0, 0x20, 0x08, 0x06, 0x01, 0x01, 0x06, 0x08, 0x60, 0x80,
+    0x00, 0x00, 0x80, 0x60, 0x40, 0x41, 0x26, 0x1C, 0x03, 0x00, 0x20, 0x20, 0x20, 0xA0, 0x60, 0x0C,
+    0x0A, 0x09, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x08, 0x08, 0x00, 0x00, 0x00, 0x01, 0x01,
+    0x3E, 0x20, 0x20, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x7F, 0x00, 0x00, 0x08, 0x08, 0xF8,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x20, 0x3E, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80,
+    0x80, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00,
+    0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0,
+    0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10,
+    0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10,
+    0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00,
+    0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40,
+    0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40,
+    0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F,
+    0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0,
+    0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10,
+    0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10,
+    0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00,
+    0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40,
+    0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40,
+    0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F,
+    0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0,
+    0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10,
+    0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10,
+    0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00,
+    0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40,
+    0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40,
+    0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F,
+    0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0,
+    0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10,
+    0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10,
+    0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00,
+    0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40,
+    0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40,
+    0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F,
+    0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00,
+    0x00, 0xC0, 0x20, 0xF8, 0x20, 0x40, 0x00, 0x00, 0x00, 0x07, 0x08, 0x3F, 0x08, 0x04, 0x00, 0x00,
+    0x00, 0x00, 0x80, 0xF0, 0x88, 0x88, 0x10, 0x00, 0x00, 0x00, 0x08, 0x0F, 0x08, 0x08, 0x08, 0x00,
+    0x20, 0xC0, 0x40, 0x40, 0x40, 0xC0, 0x20, 0x00, 0x08, 0x07, 0x04, 0x04, 0x04, 0x07, 0x08, 0x00,
+    0x00, 0x08, 0x50, 0x60, 0x80, 0x60, 0x50, 0x08, 0x00, 0x00, 0x01, 0x01, 0x0F, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0xF0, 0x00, 0x00, 0x00, 0x3C, 0x00, 0xF0, 0x28, 0x48, 0xC8, 0x88, 0x00, 0x11, 0x13,
+    0x12, 0x14, 0x0F, 0x00, 0x00, 0x00, 0x08, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xE0, 0x30, 0xD8, 0x28, 0x28, 0x28, 0x38, 0x30, 0xE0, 0x00, 0x00, 0x00, 0x03, 0x06,
+    0x0D, 0x0A, 0x0A, 0x0A, 0x0E, 0x06, 0x03, 0x00, 0x00, 0xC0, 0xA8, 0xA8, 0xA8, 0xF0, 0x00, 0x02,
+    0x02, 0x02, 0x02, 0x02, 0x00, 0x00, 0x80, 0xC0, 0x00, 0x80, 0xC0, 0x00, 0x01, 0x02, 0x06, 0x01,
+    0x02, 0x06, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00,
+    0xE0, 0x30, 0xF8, 0xA8, 0xA8, 0xA8, 0x78, 0x30, 0xE0, 0x00, 0x00, 0x00, 0x03, 0x06, 0x0F, 0x08,
+    0x08, 0x09, 0x0E, 0x06, 0x03, 0x00, 0x00, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x30, 0x48, 0x48, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x80, 0x80, 0xE0, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x08, 0x08, 0x08, 0x0B, 0x08, 0x08,
+    0x08, 0x00, 0x00, 0x88, 0xC8, 0xB8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0xA8, 0xA8,
+    0xD8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x7F, 0x08, 0x08, 0x08, 0x08,
+    0x0F, 0x08, 0x00, 0x70, 0xF8, 0xF8, 0x08, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x00, 0x1F,
+    0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x20, 0x30, 0x00, 0x00, 0x00, 0x88, 0xF8, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x70, 0x88, 0x88, 0x88, 0x70, 0x00, 0x02, 0x02, 0x02, 0x02, 0x02, 0x00, 0xC0, 0x80, 0x00,
+    0xC0, 0x80, 0x00, 0x00, 0x06, 0x02, 0x01, 0x06, 0x02, 0x01, 0x00, 0x88, 0xF8, 0x80, 0x00, 0x80,
+    0xC0, 0x30, 0x08, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x08, 0x06, 0x01, 0x00, 0x00, 0x06, 0x05,
+    0x0F, 0x04, 0x00, 0x88, 0xF8, 0x80, 0x00, 0x80, 0xC0, 0x30, 0x88, 0x80, 0x80, 0x00, 0x00, 0x00,
+    0x00, 0x08, 0x06, 0x01, 0x00, 0x00, 0x08, 0x0C, 0x0B, 0x00, 0x00, 0x88, 0xA8, 0xA8, 0xD8, 0x80,
+    0xC0, 0x30, 0x08, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x08, 0x06, 0x01, 0x00, 0x00, 0x06, 0x05,
+    0x0F, 0x04, 0x00, 0x00, 0x00, 0x60, 0x00, 0x00, 0x00, 0x38, 0x4C, 0x47, 0x40, 0x20, 0x00, 0x00,
+    0xE0, 0x19, 0x1A, 0xE0, 0x00, 0x00, 0x08, 0x07, 0x02, 0x02, 0x02, 0x02, 0x07, 0x08, 0x00, 0x00,
+    0xE0, 0x1A, 0x19, 0xE0, 0x00, 0x00, 0x08, 0x07, 0x02, 0x02, 0x02, 0x02, 0x07, 0x08, 0x00, 0x00,
+    0xE2, 0x19, 0x19, 0xE2, 0x00, 0x00, 0x08, 0x07, 0x02, 0x02, 0x02, 0x02, 0x07, 0x08, 0x00, 0x00,
+    0xE3, 0x19, 0x1A, 0xE3, 0x00, 0x00, 0x08, 0x07, 0x02, 0x02, 0x02, 0x02, 0x07, 0x08, 0x00, 0x00,
+    0xE2, 0x18, 0x18, 0xE2, 0x00, 0x00, 0x08, 0x07, 0x02, 0x02, 0x02, 0x02, 0x07, 0x08, 0x00, 0x00,
+    0xE6, 0x19, 0x19, 0xE6, 0x00, 0x00, 0x08, 0x07, 0x02, 0x02, 0x02, 0x02, 0x07, 0x08, 0x00, 0x00,
+    0xC0, 0x38, 0x08, 0xF8, 0x88, 0x88, 0x88, 0x88, 0x88, 0x00, 0x08, 0x07, 0x02, 0x02, 0x02, 0x0F,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0xE0, 0x10, 0x08, 0x08, 0x08, 0x10, 0x00, 0x00, 0x03,
+    0x04, 0x08, 0x28, 0x38, 0x04, 0x00, 0x00, 0xF8, 0x88, 0x89, 0x8A, 0x88, 0x88, 0x00, 0x00, 0x0F,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0xF8, 0x88, 0x8A, 0x89, 0x88, 0x88, 0x00, 0x00, 0x0F,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0xF8, 0x8A, 0x89, 0x89, 0x8A, 0x88, 0x00, 0x00, 0x0F,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0xF8, 0x8A, 0x88, 0x8A, 0x88, 0x88, 0x00, 0x00, 0x0F,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0xF9, 0x02, 0x00, 0x0F, 0x00, 0x00, 0xFA, 0x01, 0x00,
+    0x0F, 0x00, 0x03, 0xF9, 0x03, 0x00, 0x0F, 0x00, 0x02, 0xF8, 0x02, 0x00, 0x0F, 0x00, 0x80, 0xF8,
+    0x88, 0x88, 0x08, 0x08, 0x10, 0xE0, 0x00, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x08, 0x04, 0x03, 0x00,
+    0x00, 0xF8, 0x1B, 0x61, 0x83, 0x02, 0x03, 0xF8, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x03, 0x0C,
+    0x0F, 0x00, 0x00, 0xE0, 0x10, 0x08, 0x09, 0x0A, 0x10, 0xE0, 0x00, 0x00, 0x03, 0x04, 0x08, 0x08,
+    0x08, 0x04, 0x03, 0x00, 0x00, 0xE0, 0x10, 0x08, 0x0A, 0x09, 0x10, 0xE0, 0x00, 0x00, 0x03, 0x04,
+    0x08, 0x08, 0x08, 0x04, 0x03, 0x00, 0x00, 0xE0, 0x10, 0x0A, 0x09, 0x0A, 0x10, 0xE0, 0x00, 0x00,
+    0x03, 0x04, 0x08, 0x08, 0x08, 0x04, 0x03, 0x00, 0x00, 0xE0, 0x13, 0x09, 0x0B, 0x0A, 0x13, 0xE0,
+    0x00, 0x00, 0x03, 0x04, 0x08, 0x08, 0x08, 0x04, 0x03, 0x00, 0x00, 0xE0, 0x10, 0x0A, 0x08, 0x0A,
+    0x10, 0xE0, 0x00, 0x00, 0x03, 0x04, 0x08, 0x08, 0x08, 0x04, 0x03, 0x00, 0x00, 0x00, 0x20, 0x40,
+    0x80, 0x00, 0x80, 0x40, 0x20, 0x00, 0x00, 0x00, 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08, 0x00,
+    0x00, 0xE0, 0x10, 0x08, 0x88, 0x48, 0x30, 0xE8, 0x00, 0x00, 0x0B, 0x06, 0x09, 0x08, 0x08, 0x04,
+    0x03, 0x00, 0x00, 0xF8, 0x00, 0x01, 0x02, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x07, 0x0C, 0x08, 0x08,
+    0x08, 0x0C, 0x07, 0x00, 0x00, 0xF8, 0x00, 0x02, 0x01, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x07, 0x0C,
+    0x08, 0x08, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xF8, 0x00, 0x02, 0x01, 0x02, 0x00, 0xF8, 0x00, 0x00,
+    0x07, 0x0C, 0x08, 0x08, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xF8, 0x00, 0x02, 0x00, 0x02, 0x00, 0xF8,
+    0x00, 0x00, 0x07, 0x0C, 0x08, 0x08, 0x08, 0x0C, 0x07, 0x00, 0x08, 0x30, 0xC0, 0x02, 0xC1, 0x30,
+    0x08, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x10, 0x10, 0x10, 0x10, 0xE0, 0x00,
+    0x00, 0x0F, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0xF8, 0x04, 0xE4, 0xA4, 0x18, 0x00, 0x00,
+    0x00, 0x0F, 0x00, 0x08, 0x08, 0x09, 0x06, 0x00, 0x00, 0x40, 0x20, 0x24, 0x28, 0x20, 0xC0, 0x00,
+    0x00, 0x06, 0x09, 0x09, 0x09, 0x05, 0x0F, 0x00, 0x00, 0x40, 0x20, 0x28, 0x24, 0x20, 0xC0, 0x00,
+    0x00, 0x06, 0x09, 0x09, 0x09, 0x05, 0x0F, 0x00, 0x00, 0x40, 0x28, 0x24, 0x24, 0x28, 0xC0, 0x00,
+    0x00, 0x06, 0x09, 0x09, 0x09, 0x05, 0x0F, 0x00, 0x00, 0x40, 0x2C, 0x24, 0x28, 0x2C, 0xC0, 0x00,
+    0x00, 0x06, 0x09, 0x09, 0x09, 0x05, 0x0F, 0x00, 0x00, 0x40, 0x28, 0x20, 0x20, 0x28, 0xC0, 0x00,
+    0x00, 0x06, 0x09, 0x09, 0x09, 0x05, 0x0F, 0x00, 0x00, 0x40, 0x26, 0x29, 0x29, 0x26, 0xC0, 0x00,
+    0x00, 0x06, 0x09, 0x09, 0x09, 0x05, 0x0F, 0x00, 0x00, 0x40, 0x20, 0x20, 0x20, 0xC0, 0x60, 0x20,
+    0x20, 0x60, 0xC0, 0x00, 0x00, 0x06, 0x09, 0x09, 0x0D, 0x07, 0x0D, 0x09, 0x09, 0x09, 0x05, 0x00,
+    0x00, 0xC0, 0x60, 0x20, 0x20, 0x40, 0x00, 0x00, 0x07, 0x0C, 0x28, 0x38, 0x04, 0x00, 0x00, 0xC0,
+    0x60, 0x24, 0x28, 0x60, 0xC0, 0x00, 0x00, 0x07, 0x0D, 0x09, 0x09, 0x09, 0x05, 0x00, 0x00, 0xC0,
+    0x60, 0x28, 0x24, 0x60, 0xC0, 0x00, 0x00, 0x07, 0x0D, 0x09, 0x09, 0x09, 0x05, 0x00, 0x00, 0xC0,
+    0x68, 0x24, 0x24, 0x68, 0xC0, 0x00, 0x00, 0x07, 0x0D, 0x09, 0x09, 0x09, 0x05, 0x00, 0x00, 0xC0,
+    0x60, 0x28, 0x20, 0x68, 0xC0, 0x00, 0x00, 0x07, 0x0D, 0x09, 0x09, 0x09, 0x05, 0x00, 0x00, 0xE4,
+    0x08, 0x00, 0x0F, 0x00, 0x00, 0xE8, 0x04, 0x00, 0x0F, 0x00, 0x0C, 0xE4, 0x0C, 0x00, 0x0F, 0x00,
+    0x08, 0xE0, 0x08, 0x00, 0x0F, 0x00, 0x00, 0x80, 0xD8, 0x50, 0x70, 0x48, 0x80, 0x00, 0x00, 0x07,
+    0x0C, 0x08, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xE0, 0x4C, 0x24, 0x2C, 0x28, 0xCC, 0x00, 0x00, 0x0F,
+    0x00, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0xC0, 0x60, 0x24, 0x28, 0x60, 0xC0, 0x00, 0x00, 0x07,
+    0x0C, 0x08, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xC0, 0x60, 0x28, 0x24, 0x60, 0xC0, 0x00, 0x00, 0x07,
+    0x0C, 0x08, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xC0, 0x68, 0x24, 0x24, 0x68, 0xC0, 0x00, 0x00, 0x07,
+    0x0C, 0x08, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xC0, 0x6C, 0x24, 0x28, 0x6C, 0xC0, 0x00, 0x00, 0x07,
+    0x0C, 0x08, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xC0, 0x68, 0x20, 0x20, 0x68, 0xC0, 0x00, 0x00, 0x07,
+    0x0C, 0x08, 0x08, 0x0C, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x01, 0x01, 0x05, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0xC0, 0x60, 0x20, 0xA0, 0x60,
+    0xE0, 0x00, 0x00, 0x0F, 0x0C, 0x0B, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xE0, 0x00, 0x04, 0x08, 0x00,
+    0xE0, 0x00, 0x00, 0x07, 0x08, 0x08, 0x08, 0x04, 0x0F, 0x00, 0x00, 0xE0, 0x00, 0x08, 0x04, 0x00,
+    0xE0, 0x00, 0x00, 0x07, 0x08, 0x08, 0x08, 0x04, 0x0F, 0x00, 0x00, 0xE0, 0x08, 0x04, 0x04, 0x08,
+    0xE0, 0x00, 0x00, 0x07, 0x08, 0x08, 0x08, 0x04, 0x0F, 0x00, 0x00, 0xE0, 0x08, 0x00, 0x00, 0x08,
+    0xE0, 0x00, 0x00, 0x07, 0x08, 0x08, 0x08, 0x04, 0x0F, 0x00, 0x60, 0x80, 0x00, 0x08, 0x84, 0x60,
+    0x40, 0x41, 0x26, 0x1C, 0x03, 0x00, 0x00, 0xFC, 0x60, 0x20, 0x20, 0x60, 0xC0, 0x00, 0x00, 0x7F,
+    0x0C, 0x08, 0x08, 0x0C, 0x07, 0x00, 0x60, 0x88, 0x00, 0x00, 0x88, 0x60, 0x40, 0x41, 0x26, 0x1C,
+    0x03, 0x00,
+};
+
+const font_native_t Dialog_plain_12_native =
+{
+    .height = 15,
+    .pages = 2,
+    .first = 32,
+    .count = 224,
+    .packed = 0,
+    .glyphs = Dialog_plain_12_glyphs,
+    .bitmap = Dialog_plain_12_bitmap,
+};
+
+static const font_glyph_t Monospaced_bold_24_glyphs[224] =
+{
+    {    0, 14}, // 32
+    {    2, 14}, // 33
+    {   16, 14}, // 34
+    {   34, 14}, // 35
+    {   72, 14}, // 36
+    {  111, 14}, // 37
+    {  152, 14}, // 38
+    {  193, 14}, // 39
+    {  203, 14}, // 40
+    {  234, 14}, // 41
+    {  265, 14}, // 42
+    {  298, 14}, // 43
+    {  316, 14}, // 44
+    {  329, 14}, // 45
+    {  339, 14}, // 46
+    {  345, 14}, // 47
+    {  376, 14}, // 48
+    {  418, 14}, // 49
+    {  442, 14}, // 50
+    {  479, 14}, // 51
+    {  512, 14}, // 52
+    {  540, 14}, // 53
+    {  572, 14}, // 54
+    {  611, 14}, // 55
+    {  636, 14}, // 56
+    {  673, 14}, // 57
+    {  713, 14}, // 58
+    {  723, 14}, // 59
+    {  740, 14}, // 60
+    {  770, 14}, // 61
+    {  780, 14}, // 62
+    {  810, 14}, // 63
+    {  838, 14}, // 64
+    {  883, 14}, // 65
+    {  919, 14}, // 66
+    {  951, 14}, // 67
+    {  988, 14}, // 68
+    { 1022, 14}, // 69
+    { 1040, 14}, // 70
+    { 1056, 14}, // 71
+    { 1095, 14}, // 72
+    { 1121, 14}, // 73
+    { 1139, 14}, // 74
+    { 1161, 14}, // 75
+    { 1201, 14}, // 76
+    { 1217, 14}, // 77
+    { 1255, 14}, // 78
+    { 1289, 14}, // 79
+    { 1330, 14}, // 80
+    { 1353, 14}, // 81
+    { 1401, 14}, // 82
+    { 1433, 14}, // 83
+    { 1470, 14}, // 84
+    { 1484, 14}, // 85
+    { 1516, 14}, // 86
+    { 1552, 14}, // 87
+    { 1587, 14}, // 88
+    { 1631, 14}, // 89
+    { 1664, 14}, // 90
+    { 1692, 14}, // 91
+    { 1712, 14}, // 92
+    { 1742, 14}, // 93
+    { 1762, 14}, // 94
+    { 1790, 14}, // 95
+    { 1794, 14}, // 96
+    { 1805, 14}, // 97
+    { 1831, 14}, // 98
+    { 1865, 14}, // 99
+    { 1891, 14}, // 100
+    { 1925, 14}, // 101
+    { 1952, 14}, // 102
+    { 1972, 14}, // 103
+    { 2011, 14}, // 104
+    { 2038, 14}, // 105
+    { 2058, 14}, // 106
+    { 2083, 14}, // 107
+    { 2116, 14}, // 108
+    { 2135, 14}, // 109
+    { 2163, 14}, // 110
+    { 2186, 14}, // 111
+    { 2215, 14}, // 112
+    { 2249, 14}, // 113
+    { 2283, 14}, // 114
+    { 2300, 14}, // 115
+    { 2327, 14}, // 116
+    { 2349, 14}, // 117
+    { 2372, 14}, // 118
+    { 2400, 14}, // 119
+    { 2432, 14}, // 120
+    { 2463, 14}, // 121
+    { 2499, 14}, // 122
+    { 2526, 14}, // 123
+    { 2562, 14}, // 124
+    { 2580, 14}, // 125
+    { 2616, 14}, // 126
+    { 2635, 14}, // 127
+    { 2664, 14}, // 128
+    { 2693, 14}, // 129
+    { 2722, 14}, // 130
+    { 2751, 14}, // 131
+    { 2780, 14}, // 132
+    { 2809, 14}, // 133
+    { 2838, 14}, // 134
+    { 2867, 14}, // 135
+    { 2896, 14}, // 136
+    { 2925, 14}, // 137
+    { 2954, 14}, // 138
+    { 2983, 14}, // 139
+    { 3012, 14}, // 140
+    { 3041, 14}, // 141
+    { 3070, 14}, // 142
+    { 3099, 14}, // 143
+    { 3128, 14}, // 144
+    { 3157, 14}, // 145
+    { 3186, 14}, // 146
+    { 3215, 14}, // 147
+    { 3244, 14}, // 148
+    { 3273, 14}, // 149
+    { 3302, 14}, // 150
+    { 3331, 14}, // 151
+    { 3360, 14}, // 152
+    { 3389, 14}, // 153
+    { 3418, 14}, // 154
+    { 3447, 14}, // 155
+    { 3476, 14}, // 156
+    { 3505, 14}, // 157
+    { 3534, 14}, // 158
+    { 3563, 14}, // 159
+    { 3592, 14}, // 160
+    { 3594, 14}, // 161
+    { 3608, 14}, // 162
+    { 3644, 14}, // 163
+    { 3674, 14}, // 164
+    { 3702, 14}, // 165
+    { 3740, 14}, // 166
+    { 3758, 14}, // 167
+    { 3798, 14}, // 168
+    { 3808, 14}, // 169
+    { 3841, 14}, // 170
+    { 3867, 14}, // 171
+    { 3898, 14}, // 172
+    { 3910, 14}, // 173
+    { 3920, 14}, // 174
+    { 3953, 14}, // 175
+    { 3959, 14}, // 176
+    { 3983, 14}, // 177
+    { 4001, 14}, // 178
+    { 4022, 14}, // 179
+    { 4042, 14}, // 180
+    { 4053, 14}, // 181
+    { 4081, 14}, // 182
+    { 4124, 14}, // 183
+    { 4134, 14}, // 184
+    { 4147, 14}, // 185
+    { 4163, 14}, // 186
+    { 4192, 14}, // 187
+    { 4223, 14}, // 188
+    { 4261, 14}, // 189
+    { 4300, 14}, // 190
+    { 4343, 14}, // 191
+    { 4370, 14}, // 192
+    { 4407, 14}, // 193
+    { 4445, 14}, // 194
+    { 4483, 14}, // 195
+    { 4522, 14}, // 196
+    { 4561, 14}, // 197
+    { 4597, 14}, // 198
+    { 4629, 14}, // 199
+    { 4674, 14}, // 200
+    { 4700, 14}, // 201
+    { 4726, 14}, // 202
+    { 4754, 14}, // 203
+    { 4780, 14}, // 204
+    { 4805, 14}, // 205
+    { 4830, 14}, // 206
+    { 4856, 14}, // 207
+    { 4882, 14}, // 208
+    { 4919, 14}, // 209
+    { 4958, 14}, // 210
+    { 5000, 14}, // 211
+    { 5042, 14}, // 212
+    { 5083, 14}, // 213
+    { 5125, 14}, // 214
+    { 5167, 14}, // 215
+    { 5198, 14}, // 216
+    { 5240, 14}, // 217
+    { 5276, 14}, // 218
+    { 5313, 14}, // 219
+    { 5350, 14}, // 220
+    { 5387, 14}, // 221
+    { 5420, 14}, // 222
+    { 5445, 14}, // 223
+    { 5482, 14}, // 224
+    { 5517, 14}, // 225
+    { 5552, 14}, // 226
+    { 5590, 14}, // 227
+    { 5627, 14}, // 228
+    { 5661, 14}, // 229
+    { 5697, 14}, // 230
+    { 5728, 14}, // 231
+    { 5763, 14}, // 232
+    { 5799, 14}, // 233
+    { 5835, 14}, // 234
+    { 5874, 14}, // 235
+    { 5909, 14}, // 236
+    { 5934, 14}, // 237
+    { 5959, 14}, // 238
+    { 5987, 14}, // 239
+    { 6011, 14}, // 240
+    { 6051, 14}, // 241
+    { 6085, 14}, // 242
+    { 6123, 14}, // 243
+    { 6161, 14}, // 244
+    { 6201, 14}, // 245
+    { 6241, 14}, // 246
+    { 6278, 14}, // 247
+    { 6294, 14}, // 248
+    { 6325, 14}, // 249
+    { 6357, 14}, // 250
+    { 6389, 14}, // 251
+    { 6424, 14}, // 252
+    { 6455, 14}, // 253
+    { 6500, 14}, // 254
+    { 6538, 14}, // 255
+};
+
+static const uint8_t Monospaced_bold_24_bitmap[6582] =
+{
+    0xC9, 0x00, 0xFB, 0x00, 0xFE, 0xE0, 0xF6, 0x00, 0xFE, 0xFF, 0xF6, 0x00, 0xFE, 0x73, 0xEE, 0x00,
+    0xFE, 0x00, 0xFE, 0xE0, 0xFE, 0x00, 0xFE, 0xE0, 0xFC, 0x00, 0xFE, 0x0F, 0xFE, 0x00, 0xFE, 0x0F,
+    0xE3, 0x00, 0xFC, 0x00, 0xFE, 0xC0, 0xFF, 0x00, 0xFE, 0xC0, 0xFF, 0x00, 0xFF, 0x1C, 0x14, 0xDC,
+    0xFC, 0xFF, 0x1F, 0x1C, 0xDC, 0xFE, 0x7F, 0x1F, 0x1C, 0x1C, 0x07, 0x47, 0x7F, 0x7F, 0x0F, 0x07,
+    0x47, 0x7F, 0x7F, 0x0F, 0xFE, 0x07, 0xF2, 0x00, 0xFB, 0x00, 0xFF, 0xE0, 0xFA, 0x00, 0x0A, 0x3C,
+    0xFE, 0xFE, 0xE7, 0xC7, 0xFF, 0xFF, 0xC7, 0x87, 0x87, 0x0E, 0xFE, 0x00, 0xFF, 0x38, 0xFF, 0x70,
+    0x07, 0x71, 0xFF, 0xFF, 0x71, 0x7B, 0x3F, 0x3F, 0x1E, 0xFA, 0x00, 0xFF, 0x07, 0xFB, 0x00, 0x01,
+    0x80, 0xC0, 0xFE, 0x60, 0x01, 0xC0, 0x80, 0xFA, 0x00, 0x11, 0x03, 0x07, 0x0C, 0x8C, 0x8C, 0x47,
+    0x43, 0x20, 0x30, 0x10, 0x18, 0x08, 0x0C, 0x00, 0x00, 0x03, 0x01, 0x01, 0xFE, 0x00, 0x01, 0x1C,
+    0x3E, 0xFE, 0x63, 0x01, 0x3E, 0x1C, 0xF3, 0x00, 0xFE, 0x00, 0x01, 0x80, 0xC0, 0xFB, 0xE0, 0x00,
+    0xC0, 0xFE, 0x00, 0x1A, 0x80, 0xC0, 0xE7, 0x7F, 0x3F, 0xFC, 0xF0, 0xE0, 0xC0, 0x00, 0x01, 0xC0,
+    0xC0, 0x00, 0x0F, 0x1F, 0x3F, 0x78, 0x70, 0x70, 0x71, 0x73, 0x7F, 0x3F, 0x7E, 0x7F, 0x77, 0xF3,
+    0x00, 0xFB, 0x00, 0xFE, 0xE0, 0xF6, 0x00, 0xFE, 0x0F, 0xE0, 0x00, 0xFB, 0x00, 0x03, 0xC0, 0xE0,
+    0xE0, 0x20, 0xF9, 0x00, 0x03, 0xF8, 0xFF, 0xFF, 0x07, 0xF7, 0x00, 0x04, 0x0F, 0x7F, 0xFF, 0xF0,
+    0x80, 0xF6, 0x00, 0x03, 0x01, 0x03, 0x03, 0x02, 0xFD, 0x00, 0xFD, 0x00, 0x03, 0x20, 0xE0, 0xE0,
+    0xC0, 0xF5, 0x00, 0x03, 0x07, 0xFF, 0xFE, 0xF8, 0xF8, 0x00, 0x04, 0x80, 0xF0, 0xFF, 0x7F, 0x0F,
+    0xF9, 0x00, 0x03, 0x02, 0x03, 0x03, 0x01, 0xFB, 0x00, 0xFF, 0x00, 0x00, 0x80, 0xFE, 0x00, 0xFF,
+    0xE0, 0xFE, 0x00, 0x00, 0x80, 0xFE, 0x00, 0x0B, 0x21, 0x73, 0x33, 0x3F, 0x1E, 0xFF, 0xFF, 0x1E,
+    0x3F, 0x33, 0x73, 0x21, 0xFA, 0x00, 0xFF, 0x01, 0xED, 0x00, 0xF2, 0x00, 0xFC, 0xC0, 0xFE, 0xFE,
+    0xFC, 0xC0, 0x00, 0x00, 0xFC, 0x01, 0xFE, 0x3F, 0xFC, 0x01, 0xF3, 0x00, 0xE0, 0x00, 0xFD, 0xF8,
+    0xF8, 0x00, 0x03, 0x06, 0x07, 0x07, 0x03, 0xFB, 0x00, 0xEF, 0x00, 0xFA, 0x80, 0xFA, 0x00, 0xFA,
+    0x03, 0xF0, 0x00, 0xE0, 0x00, 0xFD, 0x78, 0xEE, 0x00, 0xF8, 0x00, 0x03, 0xC0, 0xE0, 0xE0, 0x20,
+    0xFB, 0x00, 0x05, 0x80, 0xE0, 0xF8, 0x7F, 0x1F, 0x07, 0xFC, 0x00, 0x05, 0xC0, 0xF8, 0xFE, 0x3F,
+    0x07, 0x01, 0xFA, 0x00, 0xFE, 0x01, 0xF7, 0x00, 0xFF, 0x00, 0x02, 0x80, 0xC0, 0xC0, 0xFD, 0xE0,
+    0xFF, 0xC0, 0x00, 0x80, 0xFE, 0x00, 0x04, 0xFE, 0xFF, 0xFF, 0x03, 0x00, 0xFE, 0x70, 0x09, 0x03,
+    0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x03, 0x1F, 0x3F, 0x3C, 0xFD, 0x70, 0x03, 0x3C, 0x3F, 0x1F, 0x03,
+    0xF2, 0x00, 0xFF, 0x00, 0xFF, 0xC0, 0xFC, 0xE0, 0xFA, 0x00, 0xFF, 0x01, 0xFF, 0x00, 0xFE, 0xFF,
+    0xFA, 0x00, 0xFD, 0x70, 0xFE, 0x7F, 0xFD, 0x70, 0xF2, 0x00, 0x02, 0x00, 0xC0, 0xC0, 0xFA, 0xE0,
+    0x01, 0xC0, 0x80, 0xFE, 0x00, 0xFF, 0x01, 0xFE, 0x00, 0x10, 0x80, 0xC0, 0xE0, 0xF1, 0x7F, 0x1F,
+    0x0F, 0x00, 0x00, 0x70, 0x78, 0x7C, 0x7E, 0x7F, 0x77, 0x73, 0x71, 0xFD, 0x70, 0xF2, 0x00, 0xFF,
+    0x00, 0xFF, 0xC0, 0xFB, 0xE0, 0xFF, 0xC0, 0xFD, 0x00, 0x01, 0x01, 0x00, 0xFC, 0x70, 0x07, 0xF9,
+    0xDF, 0xDF, 0x8F, 0x00, 0x00, 0x38, 0x38, 0xFB, 0x70, 0x03, 0x78, 0x3F, 0x3F, 0x0F, 0xF2, 0x00,
+    0xFB, 0x00, 0x00, 0x80, 0xFD, 0xE0, 0xFD, 0x00, 0x06, 0x80, 0xE0, 0xF8, 0x3C, 0x1F, 0x07, 0x01,
+    0xFE, 0xFF, 0xFD, 0x00, 0xFA, 0x07, 0xFE, 0x7F, 0xFF, 0x07, 0xF2, 0x00, 0xFF, 0x00, 0xF7, 0xE0,
+    0xFD, 0x00, 0x02, 0x7F, 0x3F, 0x3F, 0xFE, 0x38, 0xFF, 0x78, 0x06, 0xF0, 0xE0, 0xC0, 0x00, 0x00,
+    0x38, 0x30, 0xFC, 0x70, 0x04, 0x78, 0x38, 0x3F, 0x1F, 0x0F, 0xF2, 0x00, 0xFE, 0x00, 0x01, 0x80,
+    0xC0, 0xFB, 0xE0, 0x00, 0xC0, 0xFE, 0x00, 0x04, 0xFC, 0xFF, 0xFF, 0x73, 0x39, 0xFE, 0x38, 0x09,
+    0x78, 0xF0, 0xF1, 0xC0, 0x00, 0x00, 0x07, 0x1F, 0x3F, 0x38, 0xFD, 0x70, 0x03, 0x78, 0x3F, 0x1F,
+    0x0F, 0xF2, 0x00, 0x00, 0x00, 0xF5, 0xE0, 0xFA, 0x00, 0x06, 0x80, 0xE0, 0xFC, 0xFF, 0x1F, 0x07,
+    0x01, 0xFD, 0x00, 0x05, 0x40, 0x70, 0x7E, 0x3F, 0x0F, 0x03, 0xEE, 0x00, 0xFF, 0x00, 0xFF, 0xC0,
+    0xFB, 0xE0, 0xFF, 0xC0, 0xFE, 0x00, 0x03, 0x8F, 0xDF, 0xDF, 0xF9, 0xFD, 0x70, 0x09, 0xF9, 0xDF,
+    0xDF, 0x0F, 0x00, 0x00, 0x0F, 0x3F, 0x3F, 0x78, 0xFD, 0x70, 0x03, 0x78, 0x3F, 0x3F, 0x0F, 0xF2,
+    0x00, 0xFF, 0x00, 0x01, 0x80, 0xC0, 0xFC, 0xE0, 0xFF, 0xC0, 0x00, 0x80, 0xFE, 0x00, 0x03, 0x3F,
+    0xFF, 0xFF, 0xE1, 0xFD, 0xC0, 0x03, 0xE1, 0xFF, 0xFF, 0xFE, 0xFE, 0x00, 0x01, 0x38, 0x70, 0xFD,
+    0x71, 0x04, 0x79, 0x3C, 0x1F, 0x0F, 0x03, 0xF2, 0x00, 0xEE, 0x00, 0xFD, 0x78, 0xF7, 0x00, 0xFD,
+    0x78, 0xEE, 0x00, 0xEE, 0x00, 0xFD, 0x78, 0xF7, 0x00, 0xFD, 0xF8, 0xF8, 0x00, 0x03, 0x06, 0x07,
+    0x07, 0x03, 0xFB, 0x00, 0xF2, 0x00, 0x07, 0xC0, 0xE0, 0xE0, 0x60, 0x70, 0x70, 0x38, 0x38, 0xFE,
+    0x1C, 0x03, 0x0E, 0x00, 0x00, 0x01, 0xFE, 0x03, 0xFF, 0x07, 0xFF, 0x0E, 0xFE, 0x1C, 0x00, 0x38,
+    0xF2, 0x00, 0xF2, 0x00, 0xF5, 0x38, 0xFF, 0x00, 0xF5, 0x0E, 0xF2, 0x00, 0xF2, 0x00, 0x00, 0x0E,
+    0xFE, 0x1C, 0xFF, 0x38, 0xFF, 0x70, 0x06, 0x60, 0xE0, 0xE0, 0xC0, 0x00, 0x00, 0x38, 0xFE, 0x1C,
+    0xFF, 0x0E, 0xFF, 0x07, 0xFE, 0x03, 0x00, 0x01, 0xF2, 0x00, 0xFE, 0x00, 0x00, 0xC0, 0xFA, 0xE0,
+    0x01, 0xC0, 0x80, 0xFD, 0x00, 0x09, 0x01, 0x00, 0x80, 0xC0, 0xE0, 0x70, 0x38, 0x3F, 0x0F, 0x07,
+    0xFB, 0x00, 0xFE, 0x77, 0xED, 0x00, 0xFC, 0x00, 0xFB, 0x80, 0xFE, 0x00, 0x06, 0xE0, 0xF8, 0x3E,
+    0x0E, 0x83, 0xE3, 0x61, 0xFE, 0x31, 0x0A, 0x33, 0x67, 0xFE, 0xFC, 0x1F, 0x7F, 0xF0, 0xC0, 0x87,
+    0x1F, 0x18, 0xFD, 0x30, 0x02, 0x18, 0x3F, 0x3F, 0xFE, 0x00, 0x02, 0x01, 0x03, 0x03, 0xFB, 0x06,
+    0x01, 0x07, 0x02, 0xFD, 0x00, 0x00, 0xC0, 0xFD, 0xE0, 0x00, 0xC0, 0xFB, 0x00, 0x0F, 0xC0, 0xFC,
+    0xFF, 0x7F, 0x03, 0x03, 0x7F, 0xFF, 0xFC, 0xC0, 0x00, 0x00, 0x60, 0x7E, 0x7F, 0x7F, 0xFB, 0x07,
+    0xFF, 0x7F, 0x01, 0x7E, 0x60, 0xF3, 0x00, 0x00, 0x00, 0xF9, 0xE0, 0xFF, 0xC0, 0x00, 0x80, 0xFE,
+    0x00, 0xFE, 0xFF, 0xFD, 0x70, 0x03, 0x79, 0xDF, 0xDF, 0xCF, 0xFE, 0x00, 0xFE, 0x7F, 0xFC, 0x70,
+    0x03, 0x78, 0x3F, 0x3F, 0x1F, 0xF2, 0x00, 0xFD, 0x00, 0x01, 0x80, 0xC0, 0xFB, 0xE0, 0x00, 0xC0,
+    0xFE, 0x00, 0x04, 0xFC, 0xFF, 0xFF, 0x07, 0x01, 0xFD, 0x00, 0x01, 0x01, 0x03, 0xFE, 0x00, 0x04,
+    0x03, 0x0F, 0x1F, 0x3E, 0x78, 0xFD, 0x70, 0x01, 0x78, 0x3C, 0xF2, 0x00, 0xFF, 0x00, 0xFA, 0xE0,
+    0xFF, 0xC0, 0x00, 0x80, 0xFD, 0x00, 0xFE, 0xFF, 0xFD, 0x00, 0x06, 0x01, 0x07, 0xFF, 0xFF, 0xFC,
+    0x00, 0x00, 0xFE, 0x7F, 0xFD, 0x70, 0x04, 0x38, 0x3E, 0x1F, 0x0F, 0x03, 0xF3, 0x00, 0xFF, 0x00,
+    0xF6, 0xE0, 0xFE, 0x00, 0xFE, 0xFF, 0xFA, 0x70, 0xFD, 0x00, 0xFE, 0x7F, 0xF9, 0x70, 0xF2, 0x00,
+    0xFF, 0x00, 0xF6, 0xE0, 0xFE, 0x00, 0xFE, 0xFF, 0xFA, 0x70, 0xFD, 0x00, 0xFE, 0x7F, 0xEA, 0x00,
+    0xFE, 0x00, 0x01, 0x80, 0xC0, 0xFB, 0xE0, 0x00, 0xC0, 0xFE, 0x00, 0x12, 0xFC, 0xFF, 0xFF, 0x07,
+    0x01, 0x00, 0x00, 0xE0, 0xE0, 0xE1, 0xE1, 0xE0, 0x00, 0x00, 0x03, 0x0F, 0x1F, 0x3E, 0x78, 0xFD,
+    0x70, 0x02, 0x7F, 0x3F, 0x3F, 0xF2, 0x00, 0xFF, 0x00, 0xFE, 0xE0, 0xFC, 0x00, 0xFE, 0xE0, 0xFE,
+    0x00, 0xFE, 0xFF, 0xFC, 0x70, 0xFE, 0xFF, 0xFE, 0x00, 0xFE, 0x7F, 0xFC, 0x00, 0xFE, 0x7F, 0xF2,
+    0x00, 0xFE, 0x00, 0xF8, 0xE0, 0xF9, 0x00, 0xFE, 0xFF, 0xF9, 0x00, 0xFE, 0x70, 0xFE, 0x7F, 0xFE,
+    0x70, 0xF1, 0x00, 0xFC, 0x00, 0xFA, 0xE0, 0xF6, 0x00, 0xFE, 0xFF, 0xFE, 0x00, 0x01, 0x3C, 0x38,
+    0xFC, 0x70, 0x03, 0x78, 0x3F, 0x3F, 0x0F, 0xF1, 0x00, 0x00, 0x00, 0xFE, 0xE0, 0xFD, 0x00, 0x06,
+    0xC0, 0xE0, 0xE0, 0x60, 0x20, 0x00, 0x00, 0xFE, 0xFF, 0x06, 0xF8, 0x7C, 0xFE, 0xFF, 0xE7, 0x83,
+    0x01, 0xFD, 0x00, 0xFE, 0x7F, 0xFF, 0x00, 0x06, 0x01, 0x07, 0x1F, 0x7F, 0x7E, 0x78, 0x60, 0xF2,
+    0x00, 0xFE, 0x00, 0xFE, 0xE0, 0xF6, 0x00, 0xFE, 0xFF, 0xF6, 0x00, 0xFE, 0x7F, 0xF9, 0x70, 0xF3,
+    0x00, 0x00, 0x00, 0xFD, 0xE0, 0x03, 0x80, 0x00, 0x00, 0x80, 0xFD, 0xE0, 0xFF, 0x00, 0xFE, 0xFF,
+    0x05, 0x07, 0xFF, 0xF8, 0xF8, 0xFF, 0x07, 0xFE, 0xFF, 0xFF, 0x00, 0xFE, 0x7F, 0xFF, 0x00, 0xFF,
+    0x01, 0xFF, 0x00, 0xFE, 0x7F, 0xF2, 0x00, 0x00, 0x00, 0xFD, 0xE0, 0xFD, 0x00, 0xFE, 0xE0, 0xFE,
+    0x00, 0xFE, 0xFF, 0x04, 0x07, 0x3F, 0xF8, 0xC0, 0x00, 0xFE, 0xFF, 0xFE, 0x00, 0xFE, 0x7F, 0xFF,
+    0x00, 0x02, 0x01, 0x0F, 0x7E, 0xFE, 0x7F, 0xF1, 0x00, 0xFF, 0x00, 0x02, 0x80, 0xC0, 0xC0, 0xFD,
+    0xE0, 0xFF, 0xC0, 0x00, 0x80, 0xFE, 0x00, 0x03, 0xFC, 0xFF, 0xFF, 0x03, 0xFD, 0x00, 0x09, 0x03,
+    0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x03, 0x1F, 0x3F, 0x3C, 0xFD, 0x70, 0x03, 0x3C, 0x3F, 0x1F, 0x03,
+    0xF2, 0x00, 0xFF, 0x00, 0xF9, 0xE0, 0xFF, 0xC0, 0xFD, 0x00, 0xFE, 0xFF, 0xFD, 0xE0, 0x03, 0xF1,
+    0x7F, 0x7F, 0x1F, 0xFE, 0x00, 0xFE, 0x7F, 0xEA, 0x00, 0xFF, 0x00, 0x02, 0x80, 0xC0, 0xC0, 0xFD,
+    0xE0, 0xFF, 0xC0, 0x00, 0x80, 0xFE, 0x00, 0x03, 0xFC, 0xFF, 0xFF, 0x03, 0xFD, 0x00, 0x09, 0x03,
+    0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x03, 0x1F, 0x3F, 0x3C, 0xFE, 0x70, 0x04, 0xF0, 0xFC, 0xFF, 0x9F,
+    0x07, 0xF7, 0x00, 0x04, 0x01, 0x03, 0x01, 0x00, 0x00, 0xFF, 0x00, 0xF9, 0xE0, 0xFF, 0xC0, 0xFD,
+    0x00, 0xFE, 0xFF, 0xFD, 0xE0, 0x03, 0xF1, 0xBF, 0x3F, 0x1F, 0xFE, 0x00, 0xFE, 0x7F, 0xFE, 0x00,
+    0x05, 0x03, 0x0F, 0x3F, 0x7F, 0x7C, 0x70, 0xF3, 0x00, 0xFE, 0x00, 0xFF, 0xC0, 0xFB, 0xE0, 0x00,
+    0xC0, 0xFD, 0x00, 0x0A, 0x0F, 0x3F, 0x3F, 0x79, 0x70, 0xF0, 0xF0, 0xE0, 0xE1, 0xC3, 0x80, 0xFE,
+    0x00, 0x02, 0x3C, 0x78, 0x78, 0xFD, 0x70, 0x03, 0x79, 0x3F, 0x3F, 0x0F, 0xF2, 0x00, 0xFF, 0x00,
+    0xF6, 0xE0, 0xFA, 0x00, 0xFE, 0xFF, 0xF6, 0x00, 0xFE, 0x7F, 0xEE, 0x00, 0x00, 0x00, 0xFE, 0xE0,
+    0xFC, 0x00, 0xFE, 0xE0, 0xFE, 0x00, 0xFE, 0xFF, 0xFC, 0x00, 0xFE, 0xFF, 0xFE, 0x00, 0x03, 0x0F,
+    0x3F, 0x3F, 0x78, 0xFE, 0x70, 0x03, 0x78, 0x3F, 0x3F, 0x0F, 0xF1, 0x00, 0x01, 0x00, 0x60, 0xFE,
+    0xE0, 0xFC, 0x00, 0xFE, 0xE0, 0x0D, 0x60, 0x00, 0x00, 0x0F, 0xFF, 0xFF, 0xFC, 0x80, 0x00, 0x80,
+    0xFC, 0xFF, 0xFF, 0x0F, 0xFC, 0x00, 0x06, 0x0F, 0x7F, 0x7F, 0x70, 0x7F, 0x7F, 0x0F, 0xF0, 0x00,
+    0xFE, 0xE0, 0xF9, 0x00, 0xFE, 0xE0, 0x04, 0x01, 0xFF, 0xFF, 0xFC, 0x00, 0xFD, 0xFC, 0x06, 0x80,
+    0xF8, 0xFF, 0xFF, 0x03, 0x00, 0x03, 0xFE, 0x7F, 0x03, 0x1F, 0x00, 0x00, 0x1F, 0xFE, 0x7F, 0x00,
+    0x07, 0xF2, 0x00, 0x00, 0x20, 0xFE, 0xE0, 0x00, 0x80, 0xFD, 0x00, 0x00, 0x80, 0xFE, 0xE0, 0x1C,
+    0x20, 0x00, 0x00, 0x01, 0x07, 0x9F, 0xFF, 0xFC, 0xFC, 0xFF, 0x9F, 0x07, 0x01, 0x00, 0x00, 0x40,
+    0x70, 0x78, 0x7E, 0x1F, 0x0F, 0x03, 0x03, 0x0F, 0x1F, 0x7E, 0x78, 0x70, 0x40, 0xF3, 0x00, 0x01,
+    0x00, 0x20, 0xFE, 0xE0, 0x00, 0x80, 0xFE, 0x00, 0x00, 0x80, 0xFE, 0xE0, 0x00, 0x20, 0xFE, 0x00,
+    0x08, 0x03, 0x1F, 0x7F, 0xFE, 0xF0, 0xFE, 0x7F, 0x1F, 0x03, 0xF9, 0x00, 0xFE, 0x7F, 0xEE, 0x00,
+    0x00, 0x00, 0xF5, 0xE0, 0xFC, 0x00, 0x10, 0x80, 0xE0, 0xF0, 0xFC, 0x7E, 0x1F, 0x0F, 0x03, 0x01,
+    0x00, 0x00, 0x78, 0x7C, 0x7F, 0x7F, 0x77, 0x73, 0xFB, 0x70, 0xF2, 0x00, 0xFC, 0x00, 0xFE, 0xE0,
+    0xFE, 0x60, 0xF9, 0x00, 0xFE, 0xFF, 0xF6, 0x00, 0xFE, 0xFF, 0xF6, 0x00, 0xFB, 0x03, 0xFE, 0x00,
+    0x04, 0x00, 0x20, 0xE0, 0xE0, 0x80, 0xF5, 0x00, 0x05, 0x03, 0x0F, 0x7E, 0xF8, 0xE0, 0x80, 0xF6,
+    0x00, 0x05, 0x01, 0x07, 0x1F, 0x7C, 0xF0, 0xC0, 0xF5, 0x00, 0xFE, 0x01, 0x00, 0x00, 0xFE, 0x00,
+    0xFE, 0x60, 0xFE, 0xE0, 0xF6, 0x00, 0xFE, 0xFF, 0xF6, 0x00, 0xFE, 0xFF, 0xF9, 0x00, 0xFB, 0x03,
+    0xFC, 0x00, 0xFD, 0x00, 0x01, 0x80, 0xC0, 0xFE, 0xE0, 0x01, 0xC0, 0x80, 0xFD, 0x00, 0x0C, 0x08,
+    0x0C, 0x0E, 0x07, 0x03, 0x01, 0x00, 0x01, 0x03, 0x07, 0x0E, 0x0C, 0x08, 0xE5, 0x00, 0xD7, 0x00,
+    0xF3, 0x18, 0xFE, 0x00, 0x05, 0x10, 0x30, 0x70, 0xE0, 0xC0, 0x80, 0xD2, 0x00, 0xF1, 0x00, 0x01,
+    0x38, 0xBC, 0xFC, 0x9C, 0x08, 0xBC, 0xF8, 0xF8, 0xE0, 0x00, 0x00, 0x1E, 0x3F, 0x7F, 0xFD, 0x73,
+    0x01, 0x33, 0x3B, 0xFE, 0x7F, 0xF2, 0x00, 0x00, 0x00, 0xFE, 0xE0, 0xF6, 0x00, 0xFE, 0xFF, 0x01,
+    0x30, 0x18, 0xFE, 0x1C, 0x05, 0x3C, 0xF8, 0xF0, 0xE0, 0x00, 0x00, 0xFE, 0x7F, 0x01, 0x18, 0x30,
+    0xFE, 0x70, 0x03, 0x78, 0x3F, 0x1F, 0x0F, 0xF2, 0x00, 0xF1, 0x00, 0x04, 0xC0, 0xF0, 0xF8, 0x78,
+    0x3C, 0xFC, 0x1C, 0x00, 0x38, 0xFE, 0x00, 0x04, 0x07, 0x1F, 0x3F, 0x38, 0x78, 0xFC, 0x70, 0x00,
+    0x38, 0xF2, 0x00, 0xF7, 0x00, 0xFE, 0xE0, 0xFF, 0x00, 0x03, 0xE0, 0xF0, 0xF8, 0x3C, 0xFE, 0x1C,
+    0x01, 0x18, 0x30, 0xFE, 0xFF, 0xFF, 0x00, 0x03, 0x0F, 0x1F, 0x3F, 0x78, 0xFE, 0x70, 0x01, 0x30,
+    0x18, 0xFE, 0x7F, 0xF2, 0x00, 0xF2, 0x00, 0x03, 0xC0, 0xF0, 0xF8, 0xBC, 0xFD, 0x9C, 0x09, 0xBC,
+    0xF8, 0xF0, 0xE0, 0x00, 0x00, 0x0F, 0x1F, 0x3F, 0x7B, 0xFB, 0x73, 0x01, 0x3B, 0x03, 0xF2, 0x00,
+    0xFC, 0x00, 0x00, 0xC0, 0xFB, 0xE0, 0xFD, 0x00, 0xFE, 0x1C, 0xFE, 0xFF, 0xFD, 0x1C, 0xFA, 0x00,
+    0xFE, 0x7F, 0xED, 0x00, 0xF2, 0x00, 0x03, 0xE0, 0xF0, 0xF8, 0x3C, 0xFE, 0x1C, 0x01, 0x18, 0x38,
+    0xFE, 0xFC, 0xFF, 0x00, 0x03, 0x0F, 0x1F, 0x3F, 0x78, 0xFD, 0x70, 0x00, 0x38, 0xFE, 0xFF, 0xFE,
+    0x00, 0x00, 0x07, 0xFB, 0x0E, 0x04, 0x0F, 0x07, 0x07, 0x01, 0x00, 0xFF, 0x00, 0xFE, 0xE0, 0xF6,
+    0x00, 0xFE, 0xFF, 0x07, 0x38, 0x18, 0x1C, 0x1C, 0x3C, 0xFC, 0xF8, 0xF0, 0xFE, 0x00, 0xFE, 0x7F,
+    0xFC, 0x00, 0xFE, 0x7F, 0xF2, 0x00, 0xFB, 0x00, 0xFE, 0x78, 0xF9, 0x00, 0xFE, 0x1C, 0xFE, 0xFC,
+    0xFA, 0x00, 0xFD, 0x70, 0xFE, 0x7F, 0xFD, 0x70, 0xF2, 0x00, 0xFA, 0x00, 0xFE, 0x78, 0xF9, 0x00,
+    0xFE, 0x1C, 0xFE, 0xFC, 0xF6, 0x00, 0xFE, 0xFF, 0xFB, 0x00, 0xFD, 0x0E, 0xFF, 0x0F, 0x01, 0x07,
+    0x03, 0xFD, 0x00, 0xFF, 0x00, 0xFE, 0xE0, 0xF6, 0x00, 0xFE, 0xFF, 0x07, 0xC0, 0xE0, 0xF0, 0xF8,
+    0x3C, 0x1C, 0x0C, 0x04, 0xFE, 0x00, 0xFE, 0x7F, 0x08, 0x03, 0x01, 0x07, 0x0F, 0x3F, 0x7C, 0x78,
+    0x60, 0x40, 0xF3, 0x00, 0xFF, 0x00, 0xFB, 0xE0, 0xF6, 0x00, 0xFE, 0xFF, 0xF6, 0x00, 0x03, 0x1F,
+    0x3F, 0x7F, 0x78, 0xFD, 0x70, 0xF2, 0x00, 0xF2, 0x00, 0xFE, 0xFC, 0x0A, 0x18, 0x1C, 0xFC, 0xFC,
+    0xF0, 0x1C, 0x1C, 0xFC, 0xFC, 0xF0, 0x00, 0xFE, 0x7F, 0xFF, 0x00, 0xFE, 0x7F, 0xFF, 0x00, 0xFE,
+    0x7F, 0xF3, 0x00, 0xF1, 0x00, 0xFE, 0xFC, 0x07, 0x38, 0x18, 0x1C, 0x1C, 0x3C, 0xFC, 0xF8, 0xF0,
+    0xFE, 0x00, 0xFE, 0x7F, 0xFC, 0x00, 0xFE, 0x7F, 0xF2, 0x00, 0xF2, 0x00, 0x03, 0xE0, 0xF0, 0xF8,
+    0x3C, 0xFD, 0x1C, 0x09, 0x3C, 0xF8, 0xF0, 0xC0, 0x00, 0x00, 0x07, 0x1F, 0x3F, 0x78, 0xFD, 0x70,
+    0x03, 0x78, 0x3F, 0x1F, 0x07, 0xF2, 0x00, 0xF2, 0x00, 0xFE, 0xFC, 0x01, 0x30, 0x18, 0xFE, 0x1C,
+    0x05, 0x3C, 0xF8, 0xF0, 0xE0, 0x00, 0x00, 0xFE, 0xFF, 0x01, 0x18, 0x30, 0xFE, 0x70, 0x05, 0x78,
+    0x3F, 0x1F, 0x0F, 0x00, 0x00, 0xFE, 0x0F, 0xF7, 0x00, 0xF2, 0x00, 0x03, 0xE0, 0xF0, 0xF8, 0x3C,
+    0xFE, 0x1C, 0x01, 0x18, 0x30, 0xFE, 0xFC, 0xFF, 0x00, 0x03, 0x0F, 0x1F, 0x3F, 0x78, 0xFE, 0x70,
+    0x01, 0x30, 0x18, 0xFE, 0xFF, 0xF6, 0x00, 0xFE, 0x0F, 0x00, 0x00, 0xF0, 0x00, 0xFE, 0xFC, 0x01,
+    0x70, 0x38, 0xFD, 0x1C, 0x00, 0x38, 0xFD, 0x00, 0xFE, 0x7F, 0xEB, 0x00, 0xF1, 0x00, 0x04, 0xF0,
+    0xF8, 0xFC, 0xDC, 0xDC, 0xFD, 0x9C, 0x00, 0x38, 0xFD, 0x00, 0x03, 0x38, 0x39, 0x71, 0x71, 0xFD,
+    0x73, 0x02, 0x7F, 0x3F, 0x1E, 0xF2, 0x00, 0xFC, 0x00, 0xFE, 0xC0, 0xF9, 0x00, 0xFE, 0x1C, 0xFE,
+    0xFF, 0xFD, 0x1C, 0xFA, 0x00, 0x02, 0x1F, 0x3F, 0x7F, 0xFD, 0x70, 0xF1, 0x00, 0xF1, 0x00, 0xFE,
+    0xFC, 0xFC, 0x00, 0xFE, 0xFC, 0xFE, 0x00, 0x07, 0x1F, 0x3F, 0x7F, 0x78, 0x70, 0x70, 0x30, 0x38,
+    0xFE, 0x7F, 0xF2, 0x00, 0xF2, 0x00, 0x0B, 0x0C, 0x7C, 0xFC, 0xFC, 0xC0, 0x00, 0x00, 0xC0, 0xFC,
+    0xFC, 0x7C, 0x0C, 0xFD, 0x00, 0x07, 0x03, 0x1F, 0x7F, 0x7C, 0x7C, 0x7F, 0x1F, 0x03, 0xF0, 0x00,
+    0xF3, 0x00, 0x1A, 0x1C, 0xFC, 0xFC, 0xC0, 0x00, 0xC0, 0xE0, 0xE0, 0xC0, 0x00, 0xC0, 0xFC, 0xFC,
+    0x1C, 0x00, 0x03, 0x7F, 0x7F, 0x78, 0x7F, 0x03, 0x03, 0x7F, 0x78, 0x7F, 0x7F, 0x03, 0xF2, 0x00,
+    0xF2, 0x00, 0x19, 0x04, 0x0C, 0x3C, 0x7C, 0xF8, 0xE0, 0xE0, 0xF8, 0x7C, 0x3C, 0x0C, 0x04, 0x00,
+    0x00, 0x40, 0x60, 0x78, 0x7E, 0x3F, 0x0F, 0x0F, 0x3F, 0x7E, 0x78, 0x60, 0x40, 0xF2, 0x00, 0xF2,
+    0x00, 0x0B, 0x04, 0x3C, 0xFC, 0xFC, 0xE0, 0x00, 0x00, 0xE0, 0xFC, 0xFC, 0x3C, 0x04, 0xFD, 0x00,
+    0x07, 0x01, 0x07, 0xFF, 0xFF, 0xFE, 0x7F, 0x0F, 0x01, 0xFC, 0x00, 0xFE, 0x0E, 0x02, 0x0F, 0x07,
+    0x03, 0xFB, 0x00, 0xF2, 0x00, 0xFD, 0x1C, 0x06, 0x9C, 0xDC, 0xFC, 0xFC, 0x7C, 0x3C, 0x1C, 0xFE,
+    0x00, 0x07, 0x70, 0x78, 0x7C, 0x7F, 0x7F, 0x77, 0x73, 0x71, 0xFE, 0x70, 0xF1, 0x00, 0xFB, 0x00,
+    0x02, 0xC0, 0xE0, 0xE0, 0xFE, 0x60, 0xFD, 0x00, 0xFE, 0x80, 0x03, 0xC0, 0xFF, 0xFF, 0x7F, 0xFA,
+    0x00, 0xFE, 0x01, 0x03, 0x03, 0xFF, 0xFF, 0xFE, 0xF6, 0x00, 0x02, 0x03, 0x07, 0x07, 0xFE, 0x06,
+    0xFF, 0x00, 0xFB, 0x00, 0xFE, 0xE0, 0xF6, 0x00, 0xFE, 0xFF, 0xF6, 0x00, 0xFE, 0xFF, 0xF6, 0x00,
+    0xFE, 0x1F, 0xFC, 0x00, 0xFE, 0x00, 0xFE, 0x60, 0xFF, 0xE0, 0x00, 0xC0, 0xF6, 0x00, 0x03, 0x7F,
+    0xFF, 0xFF, 0xC0, 0xFE, 0x80, 0xFA, 0x00, 0x03, 0xFE, 0xFF, 0xFF, 0x03, 0xFE, 0x01, 0xFD, 0x00,
+    0xFE, 0x06, 0xFF, 0x07, 0x00, 0x03, 0xFC, 0x00, 0xF2, 0x00, 0x00, 0xC0, 0xFC, 0xE0, 0xFC, 0xC0,
+    0x03, 0xE0, 0x00, 0x00, 0x01, 0xFC, 0x00, 0xFC, 0x01, 0xF1, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40,
+    0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF,
+    0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00,
+    0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07,
+    0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7,
+    0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01,
+    0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF,
+    0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01,
+    0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF,
+    0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7,
+    0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03,
+    0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0,
+    0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00,
+    0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF,
+    0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04,
+    0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03,
+    0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00,
+    0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00,
+    0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0,
+    0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00,
+    0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03,
+    0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00,
+    0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00,
+    0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7,
+    0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00,
+    0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07,
+    0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00,
+    0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00,
+    0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7,
+    0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40,
+    0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF,
+    0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00,
+    0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07,
+    0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7,
+    0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01,
+    0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF,
+    0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01,
+    0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF,
+    0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7,
+    0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03,
+    0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0,
+    0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00,
+    0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF,
+    0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04,
+    0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03,
+    0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00,
+    0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00,
+    0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0,
+    0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00,
+    0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03,
+    0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00,
+    0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00,
+    0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7,
+    0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00,
+    0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07,
+    0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00,
+    0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00,
+    0xC0, 0xF7, 0x40, 0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7,
+    0x00, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0x01, 0x00, 0xC0, 0xF7, 0x40,
+    0x03, 0xC0, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF, 0x00, 0x00, 0xFF, 0xF7, 0x00, 0x03, 0xFF,
+    0x00, 0x00, 0x07, 0xF7, 0x04, 0x01, 0x07, 0x00, 0xC9, 0x00, 0xED, 0x00, 0xFE, 0x9C, 0xF6, 0x00,
+    0xFE, 0xFF, 0xF6, 0x00, 0xFE, 0x0F, 0xFC, 0x00, 0xFB, 0x00, 0xFF, 0x80, 0xFA, 0x00, 0x09, 0xE0,
+    0xF0, 0xF8, 0x3C, 0x1C, 0xFF, 0xFF, 0x1C, 0x1C, 0x38, 0xFD, 0x00, 0x09, 0x0F, 0x1F, 0x3F, 0x78,
+    0x70, 0xFF, 0xFF, 0x70, 0x70, 0x38, 0xF8, 0x00, 0xFF, 0x03, 0xFB, 0x00, 0xFC, 0x00, 0x00, 0xC0,
+    0xFC, 0xE0, 0x00, 0xC0, 0xFD, 0x00, 0xFF, 0xE0, 0xFE, 0xFF, 0x00, 0xE1, 0xFE, 0xE0, 0x00, 0x01,
+    0xFE, 0x00, 0xFE, 0x70, 0xFE, 0x7F, 0xFB, 0x70, 0xF2, 0x00, 0xF0, 0x00, 0x09, 0x08, 0xFC, 0xF8,
+    0x38, 0x18, 0x18, 0x38, 0xF8, 0xFC, 0x08, 0xFD, 0x00, 0x09, 0x04, 0x0F, 0x07, 0x07, 0x06, 0x06,
+    0x07, 0x07, 0x0F, 0x04, 0xF2, 0x00, 0x01, 0x00, 0x20, 0xFE, 0xE0, 0x00, 0x80, 0xFE, 0x00, 0x00,
+    0x80, 0xFE, 0xE0, 0x0F, 0x20, 0x00, 0x30, 0x31, 0x37, 0x3F, 0x7F, 0xFC, 0xF0, 0xFC, 0x7F, 0x3F,
+    0x37, 0x31, 0x30, 0x00, 0xFC, 0x03, 0xFE, 0x7F, 0xFC, 0x03, 0xF3, 0x00, 0xFB, 0x00, 0xFE, 0xC0,
+    0xF6, 0x00, 0xFE, 0x7F, 0xF6, 0x00, 0xFE, 0xFC, 0xF6, 0x00, 0xFE, 0x07, 0xFC, 0x00, 0xFE, 0x00,
+    0x01, 0x80, 0xC0, 0xFD, 0xE0, 0x00, 0xC0, 0xFB, 0x00, 0x09, 0xE0, 0xF7, 0xFF, 0x1F, 0x1C, 0x38,
+    0x70, 0xF1, 0xE0, 0xC0, 0xFC, 0x00, 0x08, 0xE1, 0xC3, 0xC3, 0xC7, 0xCE, 0xFF, 0xFF, 0x7B, 0x01,
+    0xFB, 0x00, 0xFC, 0x01, 0xFC, 0x00, 0xFD, 0x00, 0xFE, 0x70, 0xFF, 0x00, 0xFE, 0x70, 0xD5, 0x00,
+    0xF3, 0x00, 0x05, 0xF0, 0xF8, 0x1C, 0x06, 0xE7, 0xF3, 0xFE, 0x13, 0x0A, 0x07, 0x06, 0x1C, 0xF8,
+    0xF0, 0x03, 0x07, 0x0E, 0x18, 0x39, 0x33, 0xFE, 0x32, 0x04, 0x38, 0x18, 0x0E, 0x07, 0x03, 0xF3,
+    0x00, 0xFD, 0x00, 0x00, 0xC0, 0xFD, 0x60, 0x01, 0xC0, 0x80, 0xFB, 0x00, 0x01, 0x3C, 0x7E, 0xFE,
+    0x66, 0x02, 0x36, 0x7F, 0x7F, 0xFA, 0x00, 0xFA, 0x03, 0xF0, 0x00, 0xF2, 0x00, 0xFF, 0x80, 0x17,
+    0xC0, 0xE0, 0x70, 0x38, 0x80, 0x80, 0xC0, 0xE0, 0x70, 0x38, 0x00, 0x00, 0x03, 0x03, 0x07, 0x0E,
+    0x1C, 0x38, 0x03, 0x03, 0x06, 0x0E, 0x1C, 0x38, 0xF2, 0x00, 0xF2, 0x00, 0xF8, 0x70, 0xFE, 0xF0,
+    0xF6, 0x00, 0xFE, 0x03, 0xF2, 0x00, 0xEF, 0x00, 0xFA, 0x80, 0xFA, 0x00, 0xFA, 0x03, 0xF0, 0x00,
+    0xF3, 0x00, 0x1B, 0xF0, 0xF8, 0x1C, 0x06, 0xF7, 0xF3, 0x53, 0xD3, 0xF3, 0x27, 0x06, 0x1C, 0xF8,
+    0xF0, 0x03, 0x07, 0x0E, 0x18, 0x3B, 0x33, 0x30, 0x30, 0x33, 0x3B, 0x1A, 0x0E, 0x07, 0x03, 0xF3,
+    0x00, 0xFD, 0x00, 0xFA, 0x60, 0xD4, 0x00, 0xFE, 0x00, 0x07, 0x80, 0xC0, 0xE0, 0x60, 0x60, 0xE0,
+    0xC0, 0x80, 0xFB, 0x00, 0x07, 0x07, 0x0F, 0x1C, 0x18, 0x18, 0x1C, 0x0F, 0x07, 0xE2, 0x00, 0xF2,
+    0x00, 0xFC, 0x70, 0xFE, 0xFF, 0xFC, 0x70, 0x00, 0x00, 0xFC, 0x70, 0xFE, 0x77, 0xFC, 0x70, 0xF3,
+    0x00, 0xFE, 0x00, 0x00, 0xC0, 0xFC, 0x60, 0xFF, 0xC0, 0xFB, 0x00, 0x07, 0x60, 0x70, 0x78, 0x68,
+    0x6C, 0x66, 0x63, 0x61, 0xE2, 0x00, 0xFE, 0x00, 0x00, 0xC0, 0xFC, 0x60, 0xFF, 0xC0, 0xFB, 0x00,
+    0x01, 0x30, 0x60, 0xFD, 0x66, 0x01, 0x3F, 0x39, 0xE2, 0x00, 0xFB, 0x00, 0x05, 0x80, 0xC0, 0xE0,
+    0x70, 0x30, 0x10, 0xD5, 0x00, 0xF1, 0x00, 0xFE, 0xFC, 0xFC, 0x00, 0xFE, 0xFC, 0xFE, 0x00, 0xFE,
+    0xFF, 0x00, 0x38, 0xFE, 0x70, 0x06, 0x38, 0x1F, 0x7F, 0x7F, 0x70, 0x00, 0x00, 0xFE, 0x0F, 0xF8,
+    0x00, 0xFF, 0x00, 0x01, 0x80, 0xC0, 0xFC, 0xE0, 0xFF, 0x60, 0xFF, 0xE0, 0xFF, 0x00, 0x02, 0x0F,
+    0x1F, 0x3F, 0xFE, 0x7F, 0xFF, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0xF9, 0x00, 0xFF, 0xFF, 0xFF, 0x00,
+    0xFF, 0xFF, 0xF9, 0x00, 0xFF, 0x01, 0xFF, 0x00, 0xFF, 0x01, 0x00, 0x00, 0xEE, 0x00, 0xFD, 0xE0,
+    0xF7, 0x00, 0xFD, 0x01, 0xEE, 0x00, 0xDE, 0x00, 0xFF, 0x80, 0xF7, 0x00, 0xFE, 0x0C, 0x01, 0x0F,
+    0x07, 0xFD, 0x00, 0xFE, 0x00, 0xFE, 0x60, 0xFF, 0xE0, 0xF8, 0x00, 0xFE, 0x60, 0xFF, 0x7F, 0xFE,
+    0x60, 0xE2, 0x00, 0xFE, 0x00, 0x02, 0x80, 0xC0, 0xE0, 0xFE, 0x60, 0x01, 0xE0, 0xC0, 0xFB, 0x00,
+    0x02, 0x1F, 0x3F, 0x70, 0xFE, 0x60, 0x02, 0x70, 0x3F, 0x1F, 0xFC, 0x00, 0xF8, 0x03, 0xF1, 0x00,
+    0xF1, 0x00, 0x19, 0x38, 0x70, 0xE0, 0xC0, 0x80, 0x80, 0x38, 0x70, 0xE0, 0xC0, 0x80, 0x80, 0x00,
+    0x00, 0x38, 0x1C, 0x0E, 0x06, 0x03, 0x03, 0x38, 0x1C, 0x0E, 0x07, 0x03, 0x03, 0xF3, 0x00, 0xFE,
+    0x18, 0xFF, 0xF8, 0xF8, 0x00, 0xFE, 0x18, 0xFF, 0x9F, 0xFF, 0x98, 0x00, 0xD8, 0xFE, 0x40, 0x03,
+    0x60, 0x20, 0x20, 0x00, 0xFE, 0x01, 0x07, 0xE0, 0xF0, 0xD8, 0xCE, 0xC3, 0xFF, 0xFF, 0xC0, 0xF6,
+    0x00, 0xFF, 0x03, 0xFE, 0x00, 0xFE, 0x18, 0xFF, 0xF8, 0xF8, 0x00, 0xFE, 0x18, 0xFF, 0x9F, 0xFF,
+    0x98, 0x00, 0xD8, 0xFE, 0x40, 0x03, 0x60, 0x20, 0x20, 0x00, 0xFE, 0x01, 0x08, 0x00, 0x06, 0x83,
+    0xC3, 0x43, 0x63, 0x33, 0x1E, 0x0E, 0xFB, 0x00, 0xF9, 0x03, 0x00, 0x00, 0x01, 0x30, 0x18, 0xFD,
+    0x98, 0x01, 0xF0, 0x70, 0xFB, 0x00, 0x02, 0x0C, 0x18, 0x19, 0xFE, 0x99, 0x01, 0x8F, 0xCE, 0xFE,
+    0x40, 0x03, 0x60, 0x20, 0x20, 0x00, 0xFE, 0x01, 0x07, 0xE0, 0xF0, 0xD8, 0xCE, 0xC3, 0xFF, 0xFF,
+    0xC0, 0xF6, 0x00, 0xFF, 0x03, 0xFE, 0x00, 0xED, 0x00, 0xFE, 0xDC, 0xFB, 0x00, 0x07, 0xC0, 0xE0,
+    0xF8, 0x38, 0x1C, 0x0F, 0x07, 0x03, 0xFB, 0x00, 0x02, 0x03, 0x07, 0x0F, 0xFB, 0x0E, 0x00, 0x07,
+    0xFE, 0x00, 0xFD, 0x00, 0x05, 0xC2, 0xE6, 0xEE, 0xEC, 0xE8, 0xC0, 0xFB, 0x00, 0x0F, 0xC0, 0xFC,
+    0xFF, 0x7F, 0x03, 0x03, 0x7F, 0xFF, 0xFC, 0xC0, 0x00, 0x00, 0x60, 0x7E, 0x7F, 0x7F, 0xFB, 0x07,
+    0xFF, 0x7F, 0x01, 0x7E, 0x60, 0xF3, 0x00, 0xFD, 0x00, 0x06, 0xC0, 0xE0, 0xE8, 0xEC, 0xEE, 0xC6,
+    0x02, 0xFC, 0x00, 0x0F, 0xC0, 0xFC, 0xFF, 0x7F, 0x03, 0x03, 0x7F, 0xFF, 0xFC, 0xC0, 0x00, 0x00,
+    0x60, 0x7E, 0x7F, 0x7F, 0xFB, 0x07, 0xFF, 0x7F, 0x01, 0x7E, 0x60, 0xF3, 0x00, 0xFE, 0x00, 0x01,
+    0x08, 0xCC, 0xFD, 0xE6, 0x01, 0xCC, 0x08, 0xFC, 0x00, 0x0F, 0xC0, 0xFC, 0xFF, 0x7F, 0x03, 0x03,
+    0x7F, 0xFF, 0xFC, 0xC0, 0x00, 0x00, 0x60, 0x7E, 0x7F, 0x7F, 0xFB, 0x07, 0xFF, 0x7F, 0x01, 0x7E,
+    0x60, 0xF3, 0x00, 0xFE, 0x00, 0x07, 0x0C, 0xCE, 0xE6, 0xE6, 0xEC, 0xEC, 0xCE, 0x06, 0xFC, 0x00,
+    0x0F, 0xC0, 0xFC, 0xFF, 0x7F, 0x03, 0x03, 0x7F, 0xFF, 0xFC, 0xC0, 0x00, 0x00, 0x60, 0x7E, 0x7F,
+    0x7F, 0xFB, 0x07, 0xFF, 0x7F, 0x01, 0x7E, 0x60, 0xF3, 0x00, 0xFE, 0x00, 0x07, 0x0E, 0xCE, 0xEE,
+    0xE0, 0xE0, 0xEE, 0xCE, 0x0E, 0xFC, 0x00, 0x0F, 0xC0, 0xFC, 0xFF, 0x7F, 0x03, 0x03, 0x7F, 0xFF,
+    0xFC, 0xC0, 0x00, 0x00, 0x60, 0x7E, 0x7F, 0x7F, 0xFB, 0x07, 0xFF, 0x7F, 0x01, 0x7E, 0x60, 0xF3,
+    0x00, 0xFC, 0x00, 0x05, 0x1C, 0xFE, 0xE6, 0xE6, 0xFE, 0x1C, 0xFB, 0x00, 0x0F, 0x80, 0xF8, 0xFF,
+    0x7F, 0x07, 0x07, 0x7F, 0xFF, 0xF8, 0x80, 0x00, 0x00, 0x60, 0x7C, 0x7F, 0x7F, 0xFB, 0x07, 0xFF,
+    0x7F, 0x00, 0x7C, 0xF3, 0x00, 0xFE, 0x00, 0x00, 0x80, 0xF7, 0xE0, 0xFF, 0x00, 0x04, 0xF0, 0xFF,
+    0xFF, 0x07, 0x00, 0xFE, 0xFF, 0xFE, 0x70, 0x04, 0x00, 0x60, 0x7F, 0x7F, 0x1F, 0xFE, 0x07, 0xFE,
+    0x7F, 0xFD, 0x70, 0xF3, 0x00, 0xFD, 0x00, 0x01, 0x80, 0xC0, 0xFB, 0xE0, 0x00, 0xC0, 0xFE, 0x00,
+    0x04, 0xFC, 0xFF, 0xFF, 0x07, 0x01, 0xFD, 0x00, 0x01, 0x01, 0x03, 0xFE, 0x00, 0x0A, 0x03, 0x0F,
+    0x1F, 0x3E, 0x78, 0x70, 0xF0, 0xF0, 0x70, 0x78, 0x3C, 0xFA, 0x00, 0xFE, 0x0C, 0x01, 0x0F, 0x07,
+    0xFE, 0x00, 0xFF, 0x00, 0xFF, 0xE0, 0x04, 0xE2, 0xE6, 0xEE, 0xEC, 0xE8, 0xFD, 0xE0, 0xFE, 0x00,
+    0xFE, 0xFF, 0xFA, 0x70, 0xFD, 0x00, 0xFE, 0x7F, 0xF9, 0x70, 0xF2, 0x00, 0xFF, 0x00, 0xFD, 0xE0,
+    0x06, 0xE8, 0xEC, 0xEE, 0xE6, 0xE2, 0xE0, 0xE0, 0xFE, 0x00, 0xFE, 0xFF, 0xFA, 0x70, 0xFD, 0x00,
+    0xFE, 0x7F, 0xF9, 0x70, 0xF2, 0x00, 0xFF, 0x00, 0x0A, 0xE0, 0xE8, 0xEC, 0xEE, 0xE6, 0xE2, 0xE6,
+    0xEE, 0xEC, 0xE8, 0xE0, 0xFE, 0x00, 0xFE, 0xFF, 0xFA, 0x70, 0xFD, 0x00, 0xFE, 0x7F, 0xF9, 0x70,
+    0xF2, 0x00, 0xFF, 0x00, 0xFF, 0xE0, 0xFE, 0xEE, 0xFF, 0xE0, 0xFE, 0xEE, 0x00, 0xE0, 0xFE, 0x00,
+    0xFE, 0xFF, 0xFA, 0x70, 0xFD, 0x00, 0xFE, 0x7F, 0xF9, 0x70, 0xF2, 0x00, 0xFE, 0x00, 0x05, 0xE0,
+    0xE2, 0xE6, 0xEE, 0xEC, 0xE8, 0xFE, 0xE0, 0xF9, 0x00, 0xFE, 0xFF, 0xF9, 0x00, 0xFE, 0x70, 0xFE,
+    0x7F, 0xFE, 0x70, 0xF1, 0x00, 0xFE, 0x00, 0xFE, 0xE0, 0x05, 0xE8, 0xEC, 0xEE, 0xE6, 0xE2, 0xE0,
+    0xF9, 0x00, 0xFE, 0xFF, 0xF9, 0x00, 0xFE, 0x70, 0xFE, 0x7F, 0xFE, 0x70, 0xF1, 0x00, 0xFE, 0x00,
+    0x08, 0xE8, 0xEC, 0xEE, 0xE6, 0xE2, 0xE6, 0xEE, 0xEC, 0xE8, 0xF9, 0x00, 0xFE, 0xFF, 0xF9, 0x00,
+    0xFE, 0x70, 0xFE, 0x7F, 0xFE, 0x70, 0xF1, 0x00, 0xFE, 0x00, 0x00, 0xE0, 0xFE, 0xEE, 0x00, 0xE0,
+    0xFE, 0xEE, 0x00, 0xE0, 0xF9, 0x00, 0xFE, 0xFF, 0xF9, 0x00, 0xFE, 0x70, 0xFE, 0x7F, 0xFE, 0x70,
+    0xF1, 0x00, 0xFF, 0x00, 0xFA, 0xE0, 0xFF, 0xC0, 0x04, 0x80, 0x00, 0x00, 0x70, 0x70, 0xFE, 0xFF,
+    0xFE, 0x70, 0x07, 0x00, 0x01, 0x07, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0xFE, 0x7F, 0xFD, 0x70, 0x04,
+    0x38, 0x3E, 0x1F, 0x0F, 0x03, 0xF3, 0x00, 0x0B, 0x00, 0xE0, 0xE0, 0xEC, 0xEE, 0x06, 0x0E, 0x0C,
+    0x0E, 0xE6, 0xE0, 0xE0, 0xFE, 0x00, 0xFE, 0xFF, 0x04, 0x07, 0x3F, 0xF8, 0xC0, 0x00, 0xFE, 0xFF,
+    0xFE, 0x00, 0xFE, 0x7F, 0xFF, 0x00, 0x02, 0x01, 0x0F, 0x7E, 0xFE, 0x7F, 0xF1, 0x00, 0xFF, 0x00,
+    0x09, 0x80, 0xC0, 0xC2, 0xE6, 0xEE, 0xEC, 0xE8, 0xC0, 0xC0, 0x80, 0xFE, 0x00, 0x03, 0xFC, 0xFF,
+    0xFF, 0x03, 0xFD, 0x00, 0x09, 0x03, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x03, 0x1F, 0x3F, 0x3C, 0xFD,
+    0x70, 0x03, 0x3C, 0x3F, 0x1F, 0x03, 0xF2, 0x00, 0xFF, 0x00, 0x09, 0x80, 0xC0, 0xC0, 0xE0, 0xE8,
+    0xEC, 0xEE, 0xC6, 0xC2, 0x80, 0xFE, 0x00, 0x03, 0xFC, 0xFF, 0xFF, 0x03, 0xFD, 0x00, 0x09, 0x03,
+    0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x03, 0x1F, 0x3F, 0x3C, 0xFD, 0x70, 0x03, 0x3C, 0x3F, 0x1F, 0x03,
+    0xF2, 0x00, 0xFF, 0x00, 0x02, 0x80, 0xC8, 0xCC, 0xFD, 0xE6, 0x02, 0xCC, 0xC8, 0x80, 0xFE, 0x00,
+    0x03, 0xFC, 0xFF, 0xFF, 0x03, 0xFD, 0x00, 0x09, 0x03, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x03, 0x1F,
+    0x3F, 0x3C, 0xFD, 0x70, 0x03, 0x3C, 0x3F, 0x1F, 0x03, 0xF2, 0x00, 0xFF, 0x00, 0x09, 0x80, 0xCC,
+    0xCE, 0xE6, 0xE6, 0xEC, 0xEC, 0xCE, 0xC6, 0x80, 0xFE, 0x00, 0x03, 0xFC, 0xFF, 0xFF, 0x03, 0xFD,
+    0x00, 0x09, 0x03, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x03, 0x1F, 0x3F, 0x3C, 0xFD, 0x70, 0x03, 0x3C,
+    0x3F, 0x1F, 0x03, 0xF2, 0x00, 0xFF, 0x00, 0x09, 0x80, 0xCE, 0xCE, 0xEE, 0xE0, 0xE0, 0xEE, 0xCE,
+    0xCE, 0x80, 0xFE, 0x00, 0x03, 0xFC, 0xFF, 0xFF, 0x03, 0xFD, 0x00, 0x09, 0x03, 0xFF, 0xFF, 0xFC,
+    0x00, 0x00, 0x03, 0x1F, 0x3F, 0x3C, 0xFD, 0x70, 0x03, 0x3C, 0x3F, 0x1F, 0x03, 0xF2, 0x00, 0xF2,
+    0x00, 0x19, 0x10, 0x38, 0x7C, 0xF8, 0xF0, 0xE0, 0xE0, 0xF0, 0xF8, 0x7C, 0x38, 0x10, 0x00, 0x00,
+    0x08, 0x1C, 0x3E, 0x1F, 0x0F, 0x07, 0x07, 0x0F, 0x1F, 0x3E, 0x1C, 0x08, 0xF2, 0x00, 0xFF, 0x00,
+    0x02, 0x80, 0xC0, 0xC0, 0xFC, 0xE0, 0xFF, 0xC0, 0x15, 0xE0, 0x40, 0x00, 0xFC, 0xFF, 0xFF, 0x83,
+    0xC0, 0xF0, 0x78, 0x3D, 0x1F, 0xFF, 0xFF, 0xFE, 0x00, 0x60, 0x77, 0x3F, 0x3F, 0x7F, 0x73, 0xFE,
+    0x70, 0x03, 0x3C, 0x3F, 0x1F, 0x03, 0xF2, 0x00, 0x00, 0x00, 0xFE, 0xE0, 0x04, 0x02, 0x06, 0x0E,
+    0x0C, 0x08, 0xFE, 0xE0, 0xFE, 0x00, 0xFE, 0xFF, 0xFC, 0x00, 0xFE, 0xFF, 0xFE, 0x00, 0x03, 0x0F,
+    0x3F, 0x3F, 0x78, 0xFE, 0x70, 0x03, 0x78, 0x3F, 0x3F, 0x0F, 0xF1, 0x00, 0x00, 0x00, 0xFE, 0xE0,
+    0xFF, 0x00, 0x05, 0x08, 0x0C, 0x0E, 0xE6, 0xE2, 0xE0, 0xFE, 0x00, 0xFE, 0xFF, 0xFC, 0x00, 0xFE,
+    0xFF, 0xFE, 0x00, 0x03, 0x0F, 0x3F, 0x3F, 0x78, 0xFE, 0x70, 0x03, 0x78, 0x3F, 0x3F, 0x0F, 0xF1,
+    0x00, 0x0B, 0x00, 0xE0, 0xE8, 0xEC, 0x0E, 0x06, 0x02, 0x06, 0x0E, 0xEC, 0xE8, 0xE0, 0xFE, 0x00,
+    0xFE, 0xFF, 0xFC, 0x00, 0xFE, 0xFF, 0xFE, 0x00, 0x03, 0x0F, 0x3F, 0x3F, 0x78, 0xFE, 0x70, 0x03,
+    0x78, 0x3F, 0x3F, 0x0F, 0xF1, 0x00, 0x04, 0x00, 0xE0, 0xEE, 0xEE, 0x0E, 0xFE, 0x00, 0x03, 0x0E,
+    0xEE, 0xEE, 0xE0, 0xFE, 0x00, 0xFE, 0xFF, 0xFC, 0x00, 0xFE, 0xFF, 0xFE, 0x00, 0x03, 0x0F, 0x3F,
+    0x3F, 0x78, 0xFE, 0x70, 0x03, 0x78, 0x3F, 0x3F, 0x0F, 0xF1, 0x00, 0x01, 0x00, 0x20, 0xFE, 0xE0,
+    0x08, 0x80, 0x08, 0x0C, 0x0E, 0x86, 0xE2, 0xE0, 0xE0, 0x20, 0xFE, 0x00, 0x08, 0x03, 0x1F, 0x7F,
+    0xFE, 0xF0, 0xFE, 0x7F, 0x1F, 0x03, 0xF9, 0x00, 0xFE, 0x7F, 0xEE, 0x00, 0xFF, 0x00, 0xFE, 0xE0,
+    0xF6, 0x00, 0xFE, 0xFF, 0xFD, 0x07, 0x03, 0x8F, 0xFE, 0xFE, 0xF8, 0xFE, 0x00, 0xFE, 0x7F, 0xFC,
+    0x07, 0xFF, 0x03, 0xF1, 0x00, 0x03, 0x00, 0x80, 0xC0, 0xC0, 0xFC, 0xE0, 0x00, 0xC0, 0xFC, 0x00,
+    0xFE, 0xFF, 0x06, 0x01, 0x78, 0xFC, 0xFD, 0xE7, 0xC7, 0x87, 0xFD, 0x00, 0xFE, 0x7F, 0x08, 0x00,
+    0x38, 0x70, 0x70, 0x71, 0x73, 0x7F, 0x3F, 0x1E, 0xF2, 0x00, 0xFE, 0x00, 0x05, 0x10, 0x30, 0x70,
+    0xE0, 0xC0, 0x80, 0xFA, 0x00, 0x01, 0x38, 0xBC, 0xFC, 0x9C, 0x08, 0xBC, 0xF8, 0xF8, 0xE0, 0x00,
+    0x00, 0x1E, 0x3F, 0x7F, 0xFD, 0x73, 0x01, 0x33, 0x3B, 0xFE, 0x7F, 0xF2, 0x00, 0xFB, 0x00, 0x05,
+    0x80, 0xC0, 0xE0, 0x70, 0x30, 0x10, 0xFD, 0x00, 0x01, 0x38, 0xBC, 0xFC, 0x9C, 0x08, 0xBC, 0xF8,
+    0xF8, 0xE0, 0x00, 0x00, 0x1E, 0x3F, 0x7F, 0xFD, 0x73, 0x01, 0x33, 0x3B, 0xFE, 0x7F, 0xF2, 0x00,
+    0xFE, 0x00, 0x08, 0x80, 0xC0, 0xE0, 0x70, 0x30, 0x70, 0xE0, 0xC0, 0x80, 0xFD, 0x00, 0x01, 0x38,
+    0xBC, 0xFC, 0x9C, 0x08, 0xBC, 0xF8, 0xF8, 0xE0, 0x00, 0x00, 0x1E, 0x3F, 0x7F, 0xFD, 0x73, 0x01,
+    0x33, 0x3B, 0xFE, 0x7F, 0xF2, 0x00, 0xFE, 0x00, 0x07, 0xE0, 0xF0, 0x30, 0x70, 0xE0, 0xC0, 0xF0,
+    0x70, 0xFC, 0x00, 0x01, 0x38, 0xBC, 0xFC, 0x9C, 0x08, 0xBC, 0xF8, 0xF8, 0xE0, 0x00, 0x00, 0x1E,
+    0x3F, 0x7F, 0xFD, 0x73, 0x01, 0x33, 0x3B, 0xFE, 0x7F, 0xF2, 0x00, 0xFD, 0x00, 0xFE, 0x70, 0xFF,
+    0x00, 0xFE, 0x70, 0xFD, 0x00, 0x01, 0x38, 0xBC, 0xFC, 0x9C, 0x08, 0xBC, 0xF8, 0xF8, 0xE0, 0x00,
+    0x00, 0x1E, 0x3F, 0x7F, 0xFD, 0x73, 0x01, 0x33, 0x3B, 0xFE, 0x7F, 0xF2, 0x00, 0xFD, 0x00, 0x01,
+    0x38, 0x7C, 0xFE, 0xC6, 0x01, 0x7C, 0x38, 0xFC, 0x00, 0x01, 0x38, 0xBC, 0xFC, 0x9C, 0x08, 0xBC,
+    0xF8, 0xF8, 0xE0, 0x00, 0x00, 0x1E, 0x3F, 0x7F, 0xFD, 0x73, 0x01, 0x33, 0x3B, 0xFE, 0x7F, 0xF2,
+    0x00, 0xF2, 0x00, 0x00, 0x38, 0xFD, 0x9C, 0x0A, 0xF8, 0xF0, 0xFC, 0x9C, 0x9C, 0xFC, 0xF8, 0xF0,
+    0x1E, 0x3F, 0x7F, 0xFE, 0x73, 0x03, 0x3F, 0x1F, 0x3F, 0x7B, 0xFE, 0x73, 0x00, 0x3B, 0xF3, 0x00,
+    0xF1, 0x00, 0x04, 0xC0, 0xF0, 0xF8, 0x78, 0x3C, 0xFC, 0x1C, 0x00, 0x38, 0xFE, 0x00, 0x0A, 0x07,
+    0x1F, 0x3F, 0x38, 0x78, 0x70, 0xF0, 0xF0, 0x70, 0x70, 0x38, 0xFA, 0x00, 0xFE, 0x0C, 0x01, 0x0F,
+    0x07, 0xFE, 0x00, 0xFE, 0x00, 0x05, 0x10, 0x30, 0x70, 0xE0, 0xC0, 0x80, 0xFB, 0x00, 0x03, 0xC0,
+    0xF0, 0xF8, 0xBC, 0xFD, 0x9C, 0x09, 0xBC, 0xF8, 0xF0, 0xE0, 0x00, 0x00, 0x0F, 0x1F, 0x3F, 0x7B,
+    0xFB, 0x73, 0x01, 0x3B, 0x03, 0xF2, 0x00, 0xFB, 0x00, 0x05, 0x80, 0xC0, 0xE0, 0x70, 0x30, 0x10,
+    0xFE, 0x00, 0x03, 0xC0, 0xF0, 0xF8, 0xBC, 0xFD, 0x9C, 0x09, 0xBC, 0xF8, 0xF0, 0xE0, 0x00, 0x00,
+    0x0F, 0x1F, 0x3F, 0x7B, 0xFB, 0x73, 0x01, 0x3B, 0x03, 0xF2, 0x00, 0xFE, 0x00, 0x08, 0x80, 0xC0,
+    0xE0, 0x70, 0x30, 0x70, 0xE0, 0xC0, 0x80, 0xFE, 0x00, 0x03, 0xC0, 0xF0, 0xF8, 0xBC, 0xFD, 0x9C,
+    0x09, 0xBC, 0xF8, 0xF0, 0xE0, 0x00, 0x00, 0x0F, 0x1F, 0x3F, 0x7B, 0xFB, 0x73, 0x01, 0x3B, 0x03,
+    0xF2, 0x00, 0xFD, 0x00, 0xFE, 0x70, 0xFF, 0x00, 0xFE, 0x70, 0xFE, 0x00, 0x03, 0xC0, 0xF0, 0xF8,
+    0xBC, 0xFD, 0x9C, 0x09, 0xBC, 0xF8, 0xF0, 0xE0, 0x00, 0x00, 0x0F, 0x1F, 0x3F, 0x7B, 0xFB, 0x73,
+    0x01, 0x3B, 0x03, 0xF2, 0x00, 0xFE, 0x00, 0x05, 0x10, 0x30, 0x70, 0xE0, 0xC0, 0x80, 0xF9, 0x00,
+    0xFE, 0x1C, 0xFE, 0xFC, 0xFA, 0x00, 0xFD, 0x70, 0xFE, 0x7F, 0xFD, 0x70, 0xF2, 0x00, 0xFB, 0x00,
+    0x05, 0x80, 0xC0, 0xE0, 0x70, 0x30, 0x10, 0xFC, 0x00, 0xFE, 0x1C, 0xFE, 0xFC, 0xFA, 0x00, 0xFD,
+    0x70, 0xFE, 0x7F, 0xFD, 0x70, 0xF2, 0x00, 0xFE, 0x00, 0x08, 0x80, 0xC0, 0xE0, 0x70, 0x30, 0x70,
+    0xE0, 0xC0, 0x80, 0xFC, 0x00, 0xFE, 0x1C, 0xFE, 0xFC, 0xFA, 0x00, 0xFD, 0x70, 0xFE, 0x7F, 0xFD,
+    0x70, 0xF2, 0x00, 0xFD, 0x00, 0xFE, 0x70, 0xFF, 0x00, 0xFE, 0x70, 0xFC, 0x00, 0xFE, 0x1C, 0xFE,
+    0xFC, 0xFA, 0x00, 0xFD, 0x70, 0xFE, 0x7F, 0xFD, 0x70, 0xF2, 0x00, 0xFD, 0x00, 0x02, 0x20, 0xE0,
+    0xE0, 0xFE, 0xC0, 0xFF, 0x60, 0xFE, 0x00, 0x11, 0xC0, 0xE3, 0xF3, 0x79, 0x39, 0x39, 0x3B, 0x3F,
+    0x3F, 0xFC, 0xF8, 0xE0, 0x00, 0x00, 0x0F, 0x1F, 0x3F, 0x78, 0xFD, 0x70, 0x03, 0x78, 0x3F, 0x1F,
+    0x07, 0xF2, 0x00, 0xFE, 0x00, 0x07, 0xE0, 0xF0, 0x30, 0x70, 0xE0, 0xC0, 0xF0, 0x70, 0xFC, 0x00,
+    0xFE, 0xFC, 0x07, 0x38, 0x18, 0x1C, 0x1C, 0x3C, 0xFC, 0xF8, 0xF0, 0xFE, 0x00, 0xFE, 0x7F, 0xFC,
+    0x00, 0xFE, 0x7F, 0xF2, 0x00, 0xFE, 0x00, 0x05, 0x10, 0x30, 0x70, 0xE0, 0xC0, 0x80, 0xFB, 0x00,
+    0x03, 0xE0, 0xF0, 0xF8, 0x3C, 0xFD, 0x1C, 0x09, 0x3C, 0xF8, 0xF0, 0xC0, 0x00, 0x00, 0x07, 0x1F,
+    0x3F, 0x78, 0xFD, 0x70, 0x03, 0x78, 0x3F, 0x1F, 0x07, 0xF2, 0x00, 0xFB, 0x00, 0x05, 0x80, 0xC0,
+    0xE0, 0x70, 0x30, 0x10, 0xFE, 0x00, 0x03, 0xE0, 0xF0, 0xF8, 0x3C, 0xFD, 0x1C, 0x09, 0x3C, 0xF8,
+    0xF0, 0xC0, 0x00, 0x00, 0x07, 0x1F, 0x3F, 0x78, 0xFD, 0x70, 0x03, 0x78, 0x3F, 0x1F, 0x07, 0xF2,
+    0x00, 0xFE, 0x00, 0x07, 0x80, 0xC0, 0x70, 0x30, 0x30, 0x70, 0xC0, 0x80, 0xFD, 0x00, 0x03, 0xE0,
+    0xF0, 0xF8, 0x3C, 0xFD, 0x1C, 0x09, 0x3C, 0xF8, 0xF0, 0xC0, 0x00, 0x00, 0x07, 0x1F, 0x3F, 0x78,
+    0xFD, 0x70, 0x03, 0x78, 0x3F, 0x1F, 0x07, 0xF2, 0x00, 0xFE, 0x00, 0x07, 0xE0, 0xF0, 0x30, 0x70,
+    0xE0, 0xC0, 0xF0, 0x70, 0xFD, 0x00, 0x03, 0xE0, 0xF0, 0xF8, 0x3C, 0xFD, 0x1C, 0x09, 0x3C, 0xF8,
+    0xF0, 0xC0, 0x00, 0x00, 0x07, 0x1F, 0x3F, 0x78, 0xFD, 0x70, 0x03, 0x78, 0x3F, 0x1F, 0x07, 0xF2,
+    0x00, 0xFE, 0x00, 0xFE, 0x70, 0xFF, 0x00, 0xFE, 0x70, 0xFD, 0x00, 0x03, 0xE0, 0xF0, 0xF8, 0x3C,
+    0xFD, 0x1C, 0x09, 0x3C, 0xF8, 0xF0, 0xC0, 0x00, 0x00, 0x07, 0x1F, 0x3F, 0x78, 0xFD, 0x70, 0x03,
+    0x78, 0x3F, 0x1F, 0x07, 0xF2, 0x00, 0xF3, 0x00, 0xFC, 0xC0, 0xFD, 0xDE, 0xFC, 0xC0, 0xFC, 0x01,
+    0xFD, 0x79, 0xFC, 0x01, 0xF3, 0x00, 0xF2, 0x00, 0x19, 0xE0, 0xF0, 0xF8, 0x3C, 0x1C, 0x9C, 0x9C,
+    0xDC, 0xFC, 0xF8, 0xFC, 0xCE, 0x04, 0x00, 0xE7, 0x7F, 0x3F, 0x7E, 0x77, 0x73, 0x71, 0x71, 0x78,
+    0x3F, 0x1F, 0x0F, 0xF2, 0x00, 0xFE, 0x00, 0x05, 0x10, 0x30, 0x70, 0xE0, 0xC0, 0x80, 0xFA, 0x00,
+    0xFE, 0xFC, 0xFC, 0x00, 0xFE, 0xFC, 0xFE, 0x00, 0x07, 0x1F, 0x3F, 0x7F, 0x78, 0x70, 0x70, 0x30,
+    0x38, 0xFE, 0x7F, 0xF2, 0x00, 0xFB, 0x00, 0x05, 0x80, 0xC0, 0xE0, 0x70, 0x30, 0x10, 0xFD, 0x00,
+    0xFE, 0xFC, 0xFC, 0x00, 0xFE, 0xFC, 0xFE, 0x00, 0x07, 0x1F, 0x3F, 0x7F, 0x78, 0x70, 0x70, 0x30,
+    0x38, 0xFE, 0x7F, 0xF2, 0x00, 0xFE, 0x00, 0x08, 0x80, 0xC0, 0xE0, 0x70, 0x30, 0x70, 0xE0, 0xC0,
+    0x80, 0xFD, 0x00, 0xFE, 0xFC, 0xFC, 0x00, 0xFE, 0xFC, 0xFE, 0x00, 0x07, 0x1F, 0x3F, 0x7F, 0x78,
+    0x70, 0x70, 0x30, 0x38, 0xFE, 0x7F, 0xF2, 0x00, 0xFE, 0x00, 0xFE, 0x70, 0xFE, 0x00, 0xFE, 0x70,
+    0xFD, 0x00, 0xFE, 0xFC, 0xFC, 0x00, 0xFE, 0xFC, 0xFE, 0x00, 0x07, 0x1F, 0x3F, 0x7F, 0x78, 0x70,
+    0x70, 0x30, 0x38, 0xFE, 0x7F, 0xF2, 0x00, 0xFB, 0x00, 0x05, 0x80, 0xC0, 0xE0, 0x70, 0x30, 0x10,
+    0xFE, 0x00, 0x0B, 0x04, 0x3C, 0xFC, 0xFC, 0xE0, 0x00, 0x00, 0xE0, 0xFC, 0xFC, 0x3C, 0x04, 0xFD,
+    0x00, 0x07, 0x01, 0x07, 0xFF, 0xFF, 0xFE, 0x7F, 0x0F, 0x01, 0xFC, 0x00, 0xFE, 0x0E, 0x02, 0x0F,
+    0x07, 0x03, 0xFB, 0x00, 0x00, 0x00, 0xFE, 0xE0, 0xF6, 0x00, 0xFE, 0xFF, 0x01, 0x30, 0x18, 0xFE,
+    0x1C, 0x05, 0x3C, 0xF8, 0xF0, 0xE0, 0x00, 0x00, 0xFE, 0xFF, 0x01, 0x18, 0x30, 0xFE, 0x70, 0x05,
+    0x78, 0x3F, 0x1F, 0x0F, 0x00, 0x00, 0xFE, 0x0F, 0xF7, 0x00, 0xFE, 0x00, 0xFE, 0x70, 0xFF, 0x00,
+    0xFE, 0x70, 0xFD, 0x00, 0x0B, 0x04, 0x3C, 0xFC, 0xFC, 0xE0, 0x00, 0x00, 0xE0, 0xFC, 0xFC, 0x3C,
+    0x04, 0xFD, 0x00, 0x07, 0x01, 0x07, 0xFF, 0xFF, 0xFE, 0x7F, 0x0F, 0x01, 0xFC, 0x00, 0xFE, 0x0E,
+    0x02, 0x0F, 0x07, 0x03, 0xFB, 0x00,
+};
+
+const font_native_t Monospaced_bold_24_native =
+{
+    .height = 29,
+    .pages = 4,
+    .first = 32,
+    .count = 224,
+    .packed = 1,
+    .glyphs = Monospaced_bold_24_glyphs,
+    .bitmap = Monospaced_bold_24_bitmap,
+};
+
+static const font_glyph_t Roboto_Mono_Medium_12_glyphs[224] =
+{
+    {    0,  7}, // 32
+    {   14,  7}, // 33
+    {   28,  7}, // 34
+    {   42,  7}, // 35
+    {   56,  7}, // 36
+    {   70,  7}, // 37
+    {   84,  7}, // 38
+    {   98,  7}, // 39
+    {  112,  7}, // 40
+    {  126,  7}, // 41
+    {  140,  7}, // 42
+    {  154,  7}, // 43
+    {  168,  7}, // 44
+    {  182,  7}, // 45
+    {  196,  7}, // 46
+    {  210,  7}, // 47
+    {  224,  7}, // 48
+    {  238,  7}, // 49
+    {  252,  7}, // 50
+    {  266,  7}, // 51
+    {  280,  7}, // 52
+    {  294,  7}, // 53
+    {  308,  7}, // 54
+    {  322,  7}, // 55
+    {  336,  7}, // 56
+    {  350,  7}, // 57
+    {  364,  7}, // 58
+    {  378,  7}, // 59
+    {  392,  7}, // 60
+    {  406,  7}, // 61
+    {  420,  7}, // 62
+    {  434,  7}, // 63
+    {  448,  7}, // 64
+    {  462,  7}, // 65
+    {  476,  7}, // 66
+    {  490,  7}, // 67
+    {  504,  7}, // 68
+    {  518,  7}, // 69
+    {  532,  7}, // 70
+    {  546,  7}, // 71
+    {  560,  7}, // 72
+    {  574,  7}, // 73
+    {  588,  7}, // 74
+    {  602,  7}, // 75
+    {  616,  7}, // 76
+    {  630,  7}, // 77
+    {  644,  7}, // 78
+    {  658,  7}, // 79
+    {  672,  7}, // 80
+    {  686,  7}, // 81
+    {  700,  7}, // 82
+    {  714,  7}, // 83
+    {  728,  7}, // 84
+    {  742,  7}, // 85
+    {  756,  7}, // 86
+    {  770,  7}, // 87
+    {  784,  7}, // 88
+    {  798,  7}, // 89
+    {  812,  7}, // 90
+    {  826,  7}, // 91
+    {  840,  7}, // 92
+    {  854,  7}, // 93
+    {  868,  7}, // 94
+    {  882,  7}, // 95
+    {  896,  7}, // 96
+    {  910,  7}, // 97
+    {  924,  7}, // 98
+    {  938,  7}, // 99
+    {  952,  7}, // 100
+    {  966,  7}, // 101
+    {  980,  7}, // 102
+    {  994,  7}, // 103
+    { 1008,  7}, // 104
+    { 1022,  7}, // 105
+    { 1036,  7}, // 106
+    { 1050,  7}, // 107
+    { 1064,  7}, // 108
+    { 1078,  7}, // 109
+    { 1092,  7}, // 110
+    { 1106,  7}, // 111
+    { 1120,  7}, // 112
+    { 1134,  7}, // 113
+    { 1148,  7}, // 114
+    { 1162,  7}, // 115
+    { 1176,  7}, // 116
+    { 1190,  7}, // 117
+    { 1204,  7}, // 118
+    { 1218,  7}, // 119
+    { 1232,  7}, // 120
+    { 1246,  7}, // 121
+    { 1260,  7}, // 122
+    { 1274,  7}, // 123
+    { 1288,  7}, // 124
+    { 1302,  7}, // 125
+    { 1316,  7}, // 126
+    { 1330,  7}, // 127
+    { 1344,  7}, // 128
+    { 1358,  7}, // 129
+    { 1372,  7}, // 130
+    { 1386,  7}, // 131
+    { 1400,  7}, // 132
+    { 1414,  7}, // 133
+    { 1428,  7}, // 134
+    { 1442,  7}, // 135
+    { 1456,  7}, // 136
+    { 1470,  7}, // 137
+    { 1484,  7}, // 138
+    { 1498,  7}, // 139
+    { 1512,  7}, // 140
+    { 1526,  7}, // 141
+    { 1540,  7}, // 142
+    { 1554,  7}, // 143
+    { 1568,  7}, // 144
+    { 1582,  7}, // 145
+    { 1596,  7}, // 146
+    { 1610,  7}, // 147
+    { 1624,  7}, // 148
+    { 1638,  7}, // 149
+    { 1652,  7}, // 150
+    { 1666,  7}, // 151
+    { 1680,  7}, // 152
+    { 1694,  7}, // 153
+    { 1708,  7}, // 154
+    { 1722,  7}, // 155
+    { 1736,  7}, // 156
+    { 1750,  7}, // 157
+    { 1764,  7}, // 158
+    { 1778,  7}, // 159
+    { 1792,  7}, // 160
+    { 1806,  7}, // 161
+    { 1820,  7}, // 162
+    { 1834,  7}, // 163
+    { 1848,  7}, // 164
+    { 1862,  7}, // 165
+    { 1876,  7}, // 166
+    { 1890,  7}, // 167
+    { 1904,  7}, // 168
+    { 1918,  7}, // 169
+    { 1932,  7}, // 170
+    { 1946,  7}, // 171
+    { 1960,  7}, // 172
+    { 1974,  7}, // 173
+    { 1988,  7}, // 174
+    { 2002,  7}, // 175
+    { 2016,  7}, // 176
+    { 2030,  7}, // 177
+    { 2044,  7}, // 178
+    { 2058,  7}, // 179
+    { 2072,  7}, // 180
+    { 2086,  7}, // 181
+    { 2100,  7}, // 182
+    { 2114,  7}, // 183
+    { 2128,  7}, // 184
+    { 2142,  7}, // 185
+    { 2156,  7}, // 186
+    { 2170,  7}, // 187
+    { 2184,  7}, // 188
+    { 2198,  7}, // 189
+    { 2212,  7}, // 190
+    { 2226,  7}, // 191
+    { 2240,  7}, // 192
+    { 2254,  7}, // 193
+    { 2268,  7}, // 194
+    { 2282,  7}, // 195
+    { 2296,  7}, // 196
+    { 2310,  7}, // 197
+    { 2324,  7}, // 198
+    { 2338,  7}, // 199
+    { 2352,  7}, // 200
+    { 2366,  7}, // 201
+    { 2380,  7}, // 202
+    { 2394,  7}, // 203
+    { 2408,  7}, // 204
+    { 2422,  7}, // 205
+    { 2436,  7}, // 206
+    { 2450,  7}, // 207
+    { 2464,  7}, // 208
+    { 2478,  7}, // 209
+    { 2492,  7}, // 210
+    { 2506,  7}, // 211
+    { 2520,  7}, // 212
+    { 2534,  7}, // 213
+    { 2548,  7}, // 214
+    { 2562,  7}, // 215
+    { 2576,  7}, // 216
+    { 2590,  7}, // 217
+    { 2604,  7}, // 218
+    { 2618,  7}, // 219
+    { 2632,  7}, // 220
+    { 2646,  7}, // 221
+    { 2660,  7}, // 222
+    { 2674,  7}, // 223
+    { 2688,  7}, // 224
+    { 2702,  7}, // 225
+    { 2716,  7}, // 226
+    { 2730,  7}, // 227
+    { 2744,  7}, // 228
+    { 2758,  7}, // 229
+    { 2772,  7}, // 230
+    { 2786,  7}, // 231
+    { 2800,  7}, // 232
+    { 2814,  7}, // 233
+    { 2828,  7}, // 234
+    { 2842,  7}, // 235
+    { 2856,  7}, // 236
+    { 2870,  7}, // 237
+    { 2884,  7}, // 238
+    { 2898,  7}, // 239
+    { 2912,  7}, // 240
+    { 2926,  7}, // 241
+    { 2940,  7}, // 242
+    { 2954,  7}, // 243
+    { 2968,  7}, // 244
+    { 2982,  7}, // 245
+    { 2996,  7}, // 246
+    { 3010,  7}, // 247
+    { 3024,  7}, // 248
+    { 3038,  7}, // 249
+    { 3052,  7}, // 250
+    { 3066,  7}, // 251
+    { 3080,  7}, // 252
+    { 3094,  7}, // 253
+    { 3108,  7}, // 254
+    { 3122,  7}, // 255
+};
+
+static const uint8_t Roboto_Mono_Medium_12_bitmap[3136] =
+{
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x00,
+    0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xF0, 0x28, 0xE0, 0x38,
+    0x20, 0x01, 0x0D, 0x03, 0x01, 0x0F, 0x01, 0x00, 0x00, 0x30, 0x78, 0xCE, 0x88, 0xB8, 0x20, 0x00,
+    0x06, 0x0C, 0x18, 0x08, 0x0F, 0x02, 0x30, 0x48, 0x78, 0x80, 0x70, 0x10, 0x00, 0x00, 0x00, 0x06,
+    0x01, 0x0F, 0x09, 0x0F, 0x00, 0x30, 0xF8, 0xC8, 0x78, 0x00, 0x00, 0x00, 0x0F, 0x09, 0x09, 0x0E,
+    0x0E, 0x0B, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xC0, 0x70, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x07, 0x18, 0x60, 0x00, 0x00, 0x00, 0x00,
+    0x0C, 0x30, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x60, 0x38, 0x0F, 0x00, 0x00, 0x00, 0x40, 0x40, 0xF0,
+    0x80, 0x40, 0x40, 0x00, 0x00, 0x03, 0x01, 0x01, 0x02, 0x00, 0x00, 0x80, 0x80, 0xF0, 0x80, 0x80,
+    0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x60, 0x38, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x70, 0x18, 0x00, 0x00, 0x10, 0x1C, 0x03, 0x00, 0x00, 0x00,
+    0x00, 0xF0, 0x18, 0x88, 0x58, 0xF0, 0x00, 0x00, 0x07, 0x0D, 0x08, 0x0C, 0x07, 0x00, 0x00, 0x30,
+    0x10, 0xF8, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F, 0x00, 0x00, 0x20, 0x30, 0x08, 0x08,
+    0xD8, 0x70, 0x00, 0x00, 0x0C, 0x0E, 0x0B, 0x08, 0x08, 0x00, 0x00, 0x10, 0x88, 0x88, 0xD8, 0x70,
+    0x00, 0x00, 0x04, 0x08, 0x08, 0x0D, 0x07, 0x00, 0x00, 0x80, 0xC0, 0x30, 0xF8, 0xF8, 0x00, 0x02,
+    0x03, 0x02, 0x02, 0x0F, 0x0F, 0x02, 0x00, 0xF0, 0xF8, 0x48, 0xC8, 0x88, 0x00, 0x00, 0x06, 0x0C,
+    0x08, 0x0C, 0x07, 0x00, 0x00, 0xE0, 0xF0, 0x58, 0xC8, 0x80, 0x00, 0x00, 0x07, 0x0C, 0x08, 0x0C,
+    0x07, 0x00, 0x00, 0x08, 0x08, 0x08, 0xE8, 0x38, 0x00, 0x00, 0x00, 0x0C, 0x07, 0x00, 0x00, 0x00,
+    0x00, 0x70, 0xD8, 0x88, 0x98, 0x70, 0x00, 0x00, 0x07, 0x0D, 0x08, 0x08, 0x07, 0x00, 0x00, 0xF0,
+    0x18, 0x08, 0x18, 0xF0, 0x00, 0x00, 0x01, 0x09, 0x09, 0x05, 0x03, 0x00, 0x00, 0x00, 0x00, 0x60,
+    0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x60, 0x38, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x40, 0x40, 0x00, 0x00,
+    0x01, 0x01, 0x02, 0x02, 0x06, 0x00, 0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00, 0x02, 0x02,
+    0x02, 0x02, 0x02, 0x00, 0x00, 0x40, 0x40, 0x80, 0x80, 0x80, 0x00, 0x00, 0x06, 0x02, 0x02, 0x03,
+    0x01, 0x00, 0x00, 0x10, 0x18, 0x08, 0x88, 0x70, 0x00, 0x00, 0x00, 0x00, 0x0B, 0x01, 0x00, 0x00,
+    0xC0, 0x30, 0xD8, 0x28, 0xE8, 0x10, 0xE0, 0x03, 0x04, 0x0B, 0x0A, 0x0B, 0x02, 0x01, 0x00, 0x00,
+    0xE0, 0x38, 0xF0, 0x80, 0x00, 0x08, 0x0F, 0x03, 0x02, 0x02, 0x0F, 0x0C, 0x00, 0xF8, 0x88, 0x88,
+    0x88, 0x78, 0x20, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x0F, 0x07, 0x00, 0xF0, 0x18, 0x08, 0x08, 0x30,
+    0x20, 0x00, 0x07, 0x0C, 0x08, 0x08, 0x06, 0x02, 0x00, 0xF8, 0x08, 0x08, 0x18, 0xF0, 0xC0, 0x00,
+    0x0F, 0x08, 0x08, 0x0C, 0x07, 0x01, 0x00, 0xF8, 0x88, 0x88, 0x88, 0x88, 0x00, 0x00, 0x0F, 0x08,
+    0x08, 0x08, 0x08, 0x00, 0x00, 0xF8, 0x88, 0x88, 0x88, 0x88, 0x08, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xF0, 0x18, 0x08, 0x88, 0xB0, 0xA0, 0x00, 0x07, 0x0C, 0x08, 0x08, 0x0F, 0x07,
+    0x00, 0xF8, 0x80, 0x80, 0x80, 0xF8, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x08,
+    0x08, 0xF8, 0x08, 0x08, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xF8, 0x00, 0x00, 0x06, 0x0C, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xF8, 0x80, 0xC0, 0x30, 0x18,
+    0x08, 0x00, 0x0F, 0x01, 0x01, 0x03, 0x0E, 0x08, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0F, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0xF8, 0x78, 0x80, 0xF0, 0xF8, 0xF8, 0x00, 0x0F, 0x00,
+    0x01, 0x00, 0x0F, 0x0F, 0x00, 0xF8, 0x70, 0xC0, 0x00, 0xF8, 0x00, 0x00, 0x0F, 0x00, 0x01, 0x07,
+    0x0F, 0x00, 0x00, 0xF0, 0x18, 0x08, 0x18, 0xF0, 0xC0, 0x00, 0x07, 0x0C, 0x08, 0x0C, 0x07, 0x01,
+    0x00, 0xF8, 0x88, 0x88, 0x88, 0xF8, 0x70, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0,
+    0x18, 0x08, 0x18, 0xF0, 0xE0, 0x00, 0x07, 0x0C, 0x08, 0x0C, 0x1F, 0x13, 0x00, 0xF8, 0x88, 0x88,
+    0x88, 0xF8, 0x20, 0x00, 0x0F, 0x00, 0x00, 0x03, 0x0E, 0x08, 0x00, 0x70, 0xD8, 0x88, 0x88, 0x38,
+    0x20, 0x00, 0x06, 0x0C, 0x08, 0x08, 0x0F, 0x06, 0x08, 0x08, 0x08, 0xF8, 0x08, 0x08, 0x08, 0x00,
+    0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x07, 0x0C,
+    0x08, 0x0C, 0x07, 0x00, 0x08, 0x78, 0xE0, 0x00, 0xC0, 0xF8, 0x08, 0x00, 0x00, 0x07, 0x0E, 0x07,
+    0x00, 0x00, 0x18, 0xF8, 0x80, 0x78, 0xE0, 0xE0, 0x78, 0x00, 0x0F, 0x0F, 0x00, 0x0F, 0x0F, 0x00,
+    0x08, 0x18, 0x70, 0xC0, 0xE0, 0x38, 0x08, 0x08, 0x0C, 0x07, 0x01, 0x03, 0x0E, 0x08, 0x08, 0x38,
+    0xE0, 0x80, 0xE0, 0x38, 0x08, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0xC8,
+    0x68, 0x18, 0x00, 0x00, 0x0C, 0x0B, 0x09, 0x08, 0x08, 0x08, 0x00, 0x00, 0xFC, 0xFC, 0x04, 0x00,
+    0x00, 0x00, 0x00, 0x3F, 0x3F, 0x20, 0x00, 0x00, 0x00, 0x08, 0x38, 0xE0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x01, 0x0F, 0x18, 0x00, 0x00, 0x00, 0x04, 0xFC, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x20,
+    0x3F, 0x3F, 0x00, 0x00, 0x00, 0x80, 0xE0, 0x18, 0x70, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10, 0x10, 0x00,
+    0x00, 0x00, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40,
+    0x60, 0x20, 0x60, 0xC0, 0x00, 0x00, 0x0E, 0x09, 0x09, 0x05, 0x0F, 0x00, 0x00, 0xFC, 0x40, 0x20,
+    0x60, 0xC0, 0x00, 0x00, 0x0F, 0x04, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xC0, 0x60, 0x20, 0x20, 0xC0,
+    0x00, 0x00, 0x07, 0x0C, 0x08, 0x08, 0x04, 0x00, 0x00, 0xC0, 0x60, 0x20, 0x60, 0xFC, 0x00, 0x00,
+    0x07, 0x0C, 0x08, 0x0C, 0x0F, 0x00, 0x00, 0xC0, 0x60, 0x20, 0x20, 0xC0, 0x00, 0x00, 0x07, 0x0D,
+    0x09, 0x09, 0x0D, 0x01, 0x00, 0x20, 0xE0, 0xFC, 0x24, 0x24, 0x04, 0x00, 0x00, 0x0F, 0x0F, 0x00,
+    0x00, 0x00, 0x00, 0xC0, 0x60, 0x20, 0x60, 0xE0, 0x00, 0x00, 0x27, 0x4C, 0x48, 0x68, 0x3F, 0x00,
+    0x00, 0xFC, 0x40, 0x20, 0x20, 0xE0, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x20,
+    0x20, 0xE8, 0xE8, 0x00, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x0F, 0x08, 0x00, 0x00, 0x00, 0x20, 0x28,
+    0xE8, 0x00, 0x00, 0x00, 0x40, 0x40, 0x60, 0x3F, 0x00, 0x00, 0x00, 0xFC, 0x00, 0xC0, 0x60, 0x20,
+    0x00, 0x00, 0x0F, 0x03, 0x03, 0x06, 0x0C, 0x08, 0x00, 0x04, 0x04, 0xFC, 0xFC, 0x00, 0x00, 0x00,
+    0x08, 0x08, 0x0F, 0x0F, 0x08, 0x08, 0x00, 0xE0, 0x20, 0xE0, 0x20, 0xE0, 0xC0, 0x00, 0x0F, 0x00,
+    0x0F, 0x00, 0x0F, 0x0F, 0x00, 0xE0, 0x40, 0x20, 0x20, 0xE0, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x0F, 0x00, 0x00, 0xC0, 0x60, 0x20, 0x60, 0xC0, 0x00, 0x00, 0x07, 0x0C, 0x08, 0x0C, 0x07, 0x01,
+    0x00, 0xE0, 0x40, 0x20, 0x60, 0xC0, 0x00, 0x00, 0x7F, 0x04, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xC0,
+    0x60, 0x20, 0x60, 0xE0, 0x00, 0x00, 0x07, 0x0C, 0x08, 0x0C, 0x7F, 0x00, 0x00, 0x00, 0xE0, 0x40,
+    0x20, 0x20, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xE0, 0x20, 0x20, 0x40,
+    0x00, 0x00, 0x04, 0x0D, 0x09, 0x09, 0x0E, 0x00, 0x00, 0x20, 0xF8, 0xF8, 0x20, 0x20, 0x00, 0x00,
+    0x00, 0x07, 0x0F, 0x08, 0x08, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x07, 0x0C,
+    0x08, 0x0C, 0x0F, 0x00, 0x00, 0xE0, 0x80, 0x00, 0x80, 0xE0, 0x20, 0x00, 0x00, 0x07, 0x0C, 0x07,
+    0x00, 0x00, 0x60, 0xE0, 0x00, 0xE0, 0x80, 0x80, 0xE0, 0x00, 0x0F, 0x0F, 0x00, 0x0F, 0x0F, 0x00,
+    0x00, 0x20, 0xE0, 0x80, 0xC0, 0x60, 0x20, 0x00, 0x08, 0x06, 0x03, 0x07, 0x0C, 0x08, 0x20, 0xE0,
+    0x80, 0x00, 0x00, 0xE0, 0x20, 0x00, 0x40, 0x63, 0x3C, 0x07, 0x01, 0x00, 0x00, 0x20, 0x20, 0xA0,
+    0xE0, 0x60, 0x00, 0x00, 0x0C, 0x0E, 0x0B, 0x08, 0x08, 0x08, 0x00, 0x00, 0x80, 0xF0, 0x7C, 0x04,
+    0x00, 0x00, 0x00, 0x00, 0x0F, 0x3E, 0x20, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x7C, 0xC0, 0x80, 0x00, 0x00, 0x00, 0x20,
+    0x3F, 0x01, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x80, 0xC0, 0x70,
+    0x40, 0xC0, 0x00, 0x00, 0x07, 0x0C, 0x38, 0x08, 0x0C, 0x00, 0x00, 0x80, 0xF8, 0x88, 0x88, 0x18,
+    0x10, 0x00, 0x0C, 0x0F, 0x08, 0x08, 0x08, 0x08, 0x00, 0xE0, 0x60, 0x20, 0x20, 0xE0, 0x20, 0x00,
+    0x0F, 0x0C, 0x08, 0x08, 0x0F, 0x09, 0x08, 0x98, 0xE0, 0x80, 0xE0, 0xB8, 0x08, 0x00, 0x02, 0x02,
+    0x0F, 0x02, 0x02, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 0x00,
+    0x00, 0x00, 0x00, 0xF0, 0xD8, 0x88, 0x88, 0xB8, 0x20, 0x00, 0x37, 0x44, 0x44, 0x4C, 0x7F, 0x13,
+    0x00, 0x00, 0x08, 0x00, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+    0xA0, 0x60, 0xE0, 0x40, 0x80, 0x00, 0x07, 0x0B, 0x0C, 0x0E, 0x04, 0x03, 0x00, 0x00, 0xF8, 0xA8,
+    0xF8, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x80, 0x40,
+    0x00, 0x00, 0x01, 0x03, 0x05, 0x03, 0x04, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xE0, 0x60, 0xE0, 0x40, 0x80, 0x00, 0x07, 0x0B, 0x09, 0x0B,
+    0x04, 0x03, 0x00, 0x00, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x30, 0x28, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40,
+    0x40, 0xF0, 0x40, 0x40, 0x00, 0x00, 0x08, 0x08, 0x0B, 0x08, 0x08, 0x00, 0x00, 0x00, 0x98, 0xC8,
+    0xB8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x98, 0xA8, 0xF8, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x7F, 0x0C,
+    0x08, 0x08, 0x0F, 0x00, 0x00, 0x60, 0xF8, 0xF8, 0xF8, 0xF8, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01,
+    0x0F, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x20, 0x00, 0x00, 0x00, 0x00,
+    0x10, 0xF8, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x88,
+    0xD8, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0xC0, 0x40, 0xC0, 0x00,
+    0x00, 0x00, 0x04, 0x06, 0x05, 0x06, 0x01, 0x00, 0x10, 0xF0, 0x00, 0x80, 0x60, 0x80, 0x00, 0x00,
+    0x00, 0x06, 0x01, 0x06, 0x0F, 0x04, 0x10, 0xF0, 0x00, 0x80, 0x60, 0x80, 0x00, 0x00, 0x00, 0x06,
+    0x01, 0x0D, 0x0D, 0x0B, 0x00, 0x90, 0xA8, 0xD0, 0x60, 0x80, 0x00, 0x00, 0x00, 0x06, 0x01, 0x06,
+    0x0F, 0x04, 0x00, 0x00, 0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x38, 0x7E, 0x43, 0x60, 0x30, 0x00,
+    0x00, 0x02, 0xE2, 0x3A, 0xF0, 0x80, 0x00, 0x08, 0x0F, 0x03, 0x02, 0x02, 0x0F, 0x0C, 0x00, 0x00,
+    0xE0, 0x3C, 0xF2, 0x82, 0x00, 0x08, 0x0F, 0x03, 0x02, 0x02, 0x0F, 0x0C, 0x00, 0x00, 0xE2, 0x39,
+    0xF1, 0x82, 0x00, 0x08, 0x0F, 0x03, 0x02, 0x02, 0x0F, 0x0C, 0x00, 0x00, 0xE3, 0x39, 0xF2, 0x83,
+    0x00, 0x08, 0x0F, 0x03, 0x02, 0x02, 0x0F, 0x0C, 0x00, 0x00, 0xE2, 0x38, 0xF2, 0x82, 0x00, 0x08,
+    0x0F, 0x03, 0x02, 0x02, 0x0F, 0x0C, 0x00, 0x00, 0xE2, 0x3D, 0xF7, 0x80, 0x00, 0x08, 0x0F, 0x03,
+    0x02, 0x02, 0x0F, 0x0C, 0x00, 0x00, 0xE0, 0x38, 0xF8, 0x88, 0x88, 0x08, 0x0F, 0x03, 0x02, 0x0F,
+    0x08, 0x08, 0x00, 0xF0, 0x18, 0x08, 0x08, 0x30, 0x20, 0x00, 0x07, 0x0C, 0x58, 0x28, 0x06, 0x02,
+    0x00, 0xFA, 0x8A, 0x8A, 0x88, 0x88, 0x00, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0xF8,
+    0x88, 0x8C, 0x8A, 0x8A, 0x00, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0xF8, 0x8A, 0x89,
+    0x89, 0x8A, 0x00, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0xF8, 0x8A, 0x88, 0x8A, 0x8A,
+    0x00, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x0A, 0x0A, 0xFA, 0x08, 0x08, 0x00, 0x00,
+    0x08, 0x08, 0x0F, 0x08, 0x08, 0x00, 0x00, 0x08, 0x08, 0xFC, 0x0A, 0x0A, 0x00, 0x00, 0x08, 0x08,
+    0x0F, 0x08, 0x08, 0x00, 0x00, 0x08, 0x0A, 0xF9, 0x09, 0x0A, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x08,
+    0x08, 0x00, 0x00, 0x08, 0x0A, 0xF8, 0x0A, 0x0A, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x08, 0x08, 0x00,
+    0x80, 0xF8, 0x88, 0x88, 0x18, 0xF0, 0xE0, 0x00, 0x0F, 0x08, 0x08, 0x0C, 0x07, 0x03, 0x00, 0xF8,
+    0x73, 0xC1, 0x02, 0xFB, 0x00, 0x00, 0x0F, 0x00, 0x01, 0x07, 0x0F, 0x00, 0x00, 0xF2, 0x1A, 0x0A,
+    0x18, 0xF0, 0xC0, 0x00, 0x07, 0x0C, 0x08, 0x0C, 0x07, 0x01, 0x00, 0xF0, 0x18, 0x0C, 0x1A, 0xF2,
+    0xC0, 0x00, 0x07, 0x0C, 0x08, 0x0C, 0x07, 0x01, 0x00, 0xF0, 0x1A, 0x09, 0x19, 0xF2, 0xC0, 0x00,
+    0x07, 0x0C, 0x08, 0x0C, 0x07, 0x01, 0x00, 0xF0, 0x1B, 0x09, 0x1A, 0xF3, 0xC0, 0x00, 0x07, 0x0C,
+    0x08, 0x0C, 0x07, 0x01, 0x00, 0xF0, 0x1A, 0x08, 0x1A, 0xF2, 0xC0, 0x00, 0x07, 0x0C, 0x08, 0x0C,
+    0x07, 0x01, 0x00, 0x60, 0xC0, 0x80, 0xC0, 0x60, 0x00, 0x00, 0x06, 0x03, 0x01, 0x03, 0x06, 0x00,
+    0x00, 0xF0, 0x18, 0x88, 0x78, 0xF8, 0xC4, 0x08, 0x0F, 0x0E, 0x09, 0x0C, 0x07, 0x01, 0x00, 0xFA,
+    0x02, 0x02, 0x00, 0xF8, 0x00, 0x00, 0x07, 0x0C, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xF8, 0x00, 0x04,
+    0x02, 0xFA, 0x00, 0x00, 0x07, 0x0C, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xF8, 0x02, 0x01, 0x01, 0xFA,
+    0x00, 0x00, 0x07, 0x0C, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xF8, 0x02, 0x00, 0x02, 0xFA, 0x00, 0x00,
+    0x07, 0x0C, 0x08, 0x0C, 0x07, 0x00, 0x08, 0x38, 0xE0, 0x84, 0xE2, 0x3A, 0x08, 0x00, 0x00, 0x00,
+    0x0F, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x20, 0x20, 0x20, 0xE0, 0xC0, 0x00, 0x0F, 0x02, 0x02, 0x02,
+    0x03, 0x01, 0x00, 0xF8, 0x0C, 0x04, 0xFC, 0x18, 0x00, 0x00, 0x0F, 0x00, 0x0C, 0x08, 0x0F, 0x06,
+    0x00, 0x48, 0x68, 0x28, 0x60, 0xC0, 0x00, 0x00, 0x0E, 0x09, 0x09, 0x05, 0x0F, 0x00, 0x00, 0x40,
+    0x60, 0x30, 0x68, 0xC8, 0x00, 0x00, 0x0E, 0x09, 0x09, 0x05, 0x0F, 0x00, 0x00, 0x40, 0x68, 0x24,
+    0x64, 0xC8, 0x00, 0x00, 0x0E, 0x09, 0x09, 0x05, 0x0F, 0x00, 0x00, 0x40, 0x6C, 0x24, 0x68, 0xCC,
+    0x00, 0x00, 0x0E, 0x09, 0x09, 0x05, 0x0F, 0x00, 0x00, 0x40, 0x68, 0x20, 0x68, 0xC8, 0x00, 0x00,
+    0x0E, 0x09, 0x09, 0x05, 0x0F, 0x00, 0x00, 0x40, 0x68, 0x34, 0x7C, 0xC0, 0x00, 0x00, 0x0E, 0x09,
+    0x09, 0x05, 0x0F, 0x00, 0x40, 0x60, 0x20, 0xE0, 0x20, 0x20, 0xC0, 0x06, 0x0F, 0x09, 0x07, 0x0D,
+    0x09, 0x0D, 0x00, 0xC0, 0x60, 0x20, 0x20, 0xC0, 0x00, 0x00, 0x07, 0x0C, 0x58, 0x28, 0x04, 0x00,
+    0x00, 0xC8, 0x68, 0x28, 0x20, 0xC0, 0x00, 0x00, 0x07, 0x0D, 0x09, 0x09, 0x0D, 0x01, 0x00, 0xC0,
+    0x60, 0x30, 0x28, 0xC8, 0x00, 0x00, 0x07, 0x0D, 0x09, 0x09, 0x0D, 0x01, 0x00, 0xC0, 0x68, 0x24,
+    0x24, 0xC8, 0x00, 0x00, 0x07, 0x0D, 0x09, 0x09, 0x0D, 0x01, 0x00, 0xC0, 0x68, 0x20, 0x28, 0xC8,
+    0x00, 0x00, 0x07, 0x0D, 0x09, 0x09, 0x0D, 0x01, 0x00, 0x28, 0x28, 0xE8, 0xE0, 0x00, 0x00, 0x00,
+    0x08, 0x08, 0x0F, 0x0F, 0x08, 0x08, 0x00, 0x20, 0x20, 0xF0, 0xE8, 0x08, 0x00, 0x00, 0x08, 0x08,
+    0x0F, 0x0F, 0x08, 0x08, 0x00, 0x20, 0x28, 0xE4, 0xE4, 0x08, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x0F,
+    0x08, 0x08, 0x00, 0x20, 0x28, 0xE0, 0xE8, 0x08, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x0F, 0x08, 0x08,
+    0x00, 0xC0, 0x68, 0x58, 0x78, 0xE8, 0x00, 0x03, 0x07, 0x08, 0x08, 0x0C, 0x07, 0x00, 0x00, 0xE0,
+    0x4C, 0x24, 0x28, 0xEC, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0xC8, 0x68, 0x28,
+    0x60, 0xC0, 0x00, 0x00, 0x07, 0x0C, 0x08, 0x0C, 0x07, 0x01, 0x00, 0xC0, 0x60, 0x30, 0x68, 0xC8,
+    0x00, 0x00, 0x07, 0x0C, 0x08, 0x0C, 0x07, 0x01, 0x00, 0xC0, 0x68, 0x24, 0x64, 0xC8, 0x00, 0x00,
+    0x07, 0x0C, 0x08, 0x0C, 0x07, 0x01, 0x00, 0xC0, 0x6C, 0x24, 0x68, 0xCC, 0x00, 0x00, 0x07, 0x0C,
+    0x08, 0x0C, 0x07, 0x01, 0x00, 0xC0, 0x68, 0x20, 0x68, 0xC8, 0x00, 0x00, 0x07, 0x0C, 0x08, 0x0C,
+    0x07, 0x01, 0x00, 0x80, 0x80, 0xA0, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x00, 0xC0, 0x60, 0x20, 0xE0, 0xD0, 0x00, 0x00, 0x0F, 0x0C, 0x0B, 0x0C, 0x07, 0x01, 0x00, 0xE8,
+    0x08, 0x08, 0x00, 0xE0, 0x00, 0x00, 0x07, 0x0C, 0x08, 0x0C, 0x0F, 0x00, 0x00, 0xE0, 0x00, 0x10,
+    0x08, 0xE8, 0x00, 0x00, 0x07, 0x0C, 0x08, 0x0C, 0x0F, 0x00, 0x00, 0xE0, 0x08, 0x04, 0x04, 0xE8,
+    0x00, 0x00, 0x07, 0x0C, 0x08, 0x0C, 0x0F, 0x00, 0x00, 0xE0, 0x08, 0x00, 0x08, 0xE8, 0x00, 0x00,
+    0x07, 0x0C, 0x08, 0x0C, 0x0F, 0x00, 0x20, 0xE0, 0x80, 0x10, 0x08, 0xE8, 0x20, 0x00, 0x40, 0x63,
+    0x3C, 0x07, 0x01, 0x00, 0x00, 0xFC, 0x40, 0x20, 0x60, 0xC0, 0x00, 0x00, 0x7F, 0x04, 0x08, 0x0C,
+    0x07, 0x00, 0x20, 0xE0, 0x88, 0x00, 0x08, 0xE8, 0x20, 0x00, 0x40, 0x63, 0x3C, 0x07, 0x01, 0x00,
+};
+
+const font_native_t Roboto_Mono_Medium_12_native =
+{
+    .height = 15,
+    .pages = 2,
+    .first = 32,
+    .count = 224,
+    .packed = 0,
+    .glyphs = Roboto_Mono_Medium_12_glyphs,
+    .bitmap = Roboto_Mono_Medium_12_bitmap,
+};
+
+static const font_glyph_t Monospaced_plain_12_glyphs[224] =
+{
+    {    0,  7}, // 32
+    {   14,  7}, // 33
+    {   28,  7}, // 34
+    {   42,  7}, // 35
+    {   56,  7}, // 36
+    {   70,  7}, // 37
+    {   84,  7}, // 38
+    {   98,  7}, // 39
+    {  112,  7}, // 40
+    {  126,  7}, // 41
+    {  140,  7}, // 42
+    {  154,  7}, // 43
+    {  168,  7}, // 44
+    {  182,  7}, // 45
+    {  196,  7}, // 46
+    {  210,  7}, // 47
+    {  224,  7}, // 48
+    {  238,  7}, // 49
+    {  252,  7}, // 50
+    {  266,  7}, // 51
+    {  280,  7}, // 52
+    {  294,  7}, // 53
+    {  308,  7}, // 54
+    {  322,  7}, // 55
+    {  336,  7}, // 56
+    {  350,  7}, // 57
+    {  364,  7}, // 58
+    {  378,  7}, // 59
+    {  392,  7}, // 60
+    {  406,  7}, // 61
+    {  420,  7}, // 62
+    {  434,  7}, // 63
+    {  448,  7}, // 64
+    {  462,  7}, // 65
+    {  476,  7}, // 66
+    {  490,  7}, // 67
+    {  504,  7}, // 68
+    {  518,  7}, // 69
+    {  532,  7}, // 70
+    {  546,  7}, // 71
+    {  560,  7}, // 72
+    {  574,  7}, // 73
+    {  588,  7}, // 74
+    {  602,  7}, // 75
+    {  616,  7}, // 76
+    {  630,  7}, // 77
+    {  644,  7}, // 78
+    {  658,  7}, // 79
+    {  672,  7}, // 80
+    {  686,  7}, // 81
+    {  700,  7}, // 82
+    {  714,  7}, // 83
+    {  728,  7}, // 84
+    {  742,  7}, // 85
+    {  756,  7}, // 86
+    {  770,  7}, // 87
+    {  784,  7}, // 88
+    {  798,  7}, // 89
+    {  812,  7}, // 90
+    {  826,  7}, // 91
+    {  840,  7}, // 92
+    {  854,  7}, // 93
+    {  868,  7}, // 94
+    {  882,  7}, // 95
+    {  896,  7}, // 96
+    {  910,  7}, // 97
+    {  924,  7}, // 98
+    {  938,  7}, // 99
+    {  952,  7}, // 100
+    {  966,  7}, // 101
+    {  980,  7}, // 102
+    {  994,  7}, // 103
+    { 1008,  7}, // 104
+    { 1022,  7}, // 105
+    { 1036,  7}, // 106
+    { 1050,  7}, // 107
+    { 1064,  7}, // 108
+    { 1078,  7}, // 109
+    { 1092,  7}, // 110
+    { 1106,  7}, // 111
+    { 1120,  7}, // 112
+    { 1134,  7}, // 113
+    { 1148,  7}, // 114
+    { 1162,  7}, // 115
+    { 1176,  7}, // 116
+    { 1190,  7}, // 117
+    { 1204,  7}, // 118
+    { 1218,  7}, // 119
+    { 1232,  7}, // 120
+    { 1246,  7}, // 121
+    { 1260,  7}, // 122
+    { 1274,  7}, // 123
+    { 1288,  7}, // 124
+    { 1302,  7}, // 125
+    { 1316,  7}, // 126
+    { 1330,  7}, // 127
+    { 1344,  7}, // 128
+    { 1358,  7}, // 129
+    { 1372,  7}, // 130
+    { 1386,  7}, // 131
+    { 1400,  7}, // 132
+    { 1414,  7}, // 133
+    { 1428,  7}, // 134
+    { 1442,  7}, // 135
+    { 1456,  7}, // 136
+    { 1470,  7}, // 137
+    { 1484,  7}, // 138
+    { 1498,  7}, // 139
+    { 1512,  7}, // 140
+    { 1526,  7}, // 141
+    { 1540,  7}, // 142
+    { 1554,  7}, // 143
+    { 1568,  7}, // 144
+    { 1582,  7}, // 145
+    { 1596,  7}, // 146
+    { 1610,  7}, // 147
+    { 1624,  7}, // 148
+    { 1638,  7}, // 149
+    { 1652,  7}, // 150
+    { 1666,  7}, // 151
+    { 1680,  7}, // 152
+    { 1694,  7}, // 153
+    { 1708,  7}, // 154
+    { 1722,  7}, // 155
+    { 1736,  7}, // 156
+    { 1750,  7}, // 157
+    { 1764,  7}, // 158
+    { 1778,  7}, // 159
+    { 1792,  7}, // 160
+    { 1806,  7}, // 161
+    { 1820,  7}, // 162
+    { 1834,  7}, // 163
+    { 1848,  7}, // 164
+    { 1862,  7}, // 165
+    { 1876,  7}, // 166
+    { 1890,  7}, // 167
+    { 1904,  7}, // 168
+    { 1918,  7}, // 169
+    { 1932,  7}, // 170
+    { 1946,  7}, // 171
+    { 1960,  7}, // 172
+    { 1974,  7}, // 173
+    { 1988,  7}, // 174
+    { 2002,  7}, // 175
+    { 2016,  7}, // 176
+    { 2030,  7}, // 177
+    { 2044,  7}, // 178
+    { 2058,  7}, // 179
+    { 2072,  7}, // 180
+    { 2086,  7}, // 181
+    { 2100,  7}, // 182
+    { 2114,  7}, // 183
+    { 2128,  7}, // 184
+    { 2142,  7}, // 185
+    { 2156,  7}, // 186
+    { 2170,  7}, // 187
+    { 2184,  7}, // 188
+    { 2198,  7}, // 189
+    { 2212,  7}, // 190
+    { 2226,  7}, // 191
+    { 2240,  7}, // 192
+    { 2254,  7}, // 193
+    { 2268,  7}, // 194
+    { 2282,  7}, // 195
+    { 2296,  7}, // 196
+    { 2310,  7}, // 197
+    { 2324,  7}, // 198
+    { 2338,  7}, // 199
+    { 2352,  7}, // 200
+    { 2366,  7}, // 201
+    { 2380,  7}, // 202
+    { 2394,  7}, // 203
+    { 2408,  7}, // 204
+    { 2422,  7}, // 205
+    { 2436,  7}, // 206
+    { 2450,  7}, // 207
+    { 2464,  7}, // 208
+    { 2478,  7}, // 209
+    { 2492,  7}, // 210
+    { 2506,  7}, // 211
+    { 2520,  7}, // 212
+    { 2534,  7}, // 213
+    { 2548,  7}, // 214
+    { 2562,  7}, // 215
+    { 2576,  7}, // 216
+    { 2590,  7}, // 217
+    { 2604,  7}, // 218
+    { 2618,  7}, // 219
+    { 2632,  7}, // 220
+    { 2646,  7}, // 221
+    { 2660,  7}, // 222
+    { 2674,  7}, // 223
+    { 2688,  7}, // 224
+    { 2702,  7}, // 225
+    { 2716,  7}, // 226
+    { 2730,  7}, // 227
+    { 2744,  7}, // 228
+    { 2758,  7}, // 229
+    { 2772,  7}, // 230
+    { 2786,  7}, // 231
+    { 2800,  7}, // 232
+    { 2814,  7}, // 233
+    { 2828,  7}, // 234
+    { 2842,  7}, // 235
+    { 2856,  7}, // 236
+    { 2870,  7}, // 237
+    { 2884,  7}, // 238
+    { 2898,  7}, // 239
+    { 2912,  7}, // 240
+    { 2926,  7}, // 241
+    { 2940,  7}, // 242
+    { 2954,  7}, // 243
+    { 2968,  7}, // 244
+    { 2982,  7}, // 245
+    { 2996,  7}, // 246
+    { 3010,  7}, // 247
+    { 3024,  7}, // 248
+    { 3038,  7}, // 249
+    { 3052,  7}, // 250
+    { 3066,  7}, // 251
+    { 3080,  7}, // 252
+    { 3094,  7}, // 253
+    { 3108,  7}, // 254
+    { 3122,  7}, // 255
+};
+
+static const uint8_t Monospaced_plain_12_bitmap[3136] =
+{
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00,
+    0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0xE0, 0x50, 0xC0, 0x70,
+    0x40, 0x02, 0x0E, 0x03, 0x0A, 0x07, 0x02, 0x00, 0x00, 0xE0, 0x90, 0xF8, 0x10, 0x20, 0x00, 0x00,
+    0x04, 0x08, 0x3F, 0x09, 0x07, 0x00, 0x30, 0x48, 0x48, 0xB0, 0x80, 0x40, 0x00, 0x00, 0x01, 0x01,
+    0x06, 0x09, 0x09, 0x06, 0x00, 0x00, 0xF0, 0xC8, 0x08, 0x08, 0x00, 0x00, 0x07, 0x0C, 0x08, 0x0B,
+    0x06, 0x0B, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xE0, 0x1C, 0x04, 0x00, 0x00, 0x00, 0x00, 0x03, 0x1C, 0x10, 0x00, 0x00, 0x00,
+    0x04, 0x1C, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x10, 0x1C, 0x03, 0x00, 0x00, 0x00, 0x90, 0x60, 0xF8,
+    0x60, 0x90, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00,
+    0x00, 0x01, 0x01, 0x01, 0x0F, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x10, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x30, 0x08, 0x00, 0x10, 0x0C, 0x03, 0x00, 0x00, 0x00,
+    0x00, 0xE0, 0x18, 0x08, 0x88, 0x18, 0xE0, 0x00, 0x03, 0x0C, 0x08, 0x08, 0x0C, 0x03, 0x00, 0x08,
+    0x08, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x08, 0x08, 0x00, 0x00, 0x10, 0x08, 0x08,
+    0x08, 0x88, 0x70, 0x00, 0x08, 0x0C, 0x0A, 0x09, 0x08, 0x08, 0x00, 0x10, 0x08, 0x88, 0x88, 0x88,
+    0x70, 0x00, 0x04, 0x08, 0x08, 0x08, 0x08, 0x07, 0x00, 0x00, 0xC0, 0x60, 0x18, 0xF8, 0x00, 0x00,
+    0x03, 0x02, 0x02, 0x02, 0x0F, 0x02, 0x00, 0x78, 0x48, 0x48, 0x48, 0xC8, 0x80, 0x00, 0x04, 0x08,
+    0x08, 0x08, 0x0C, 0x07, 0x00, 0xE0, 0x90, 0x48, 0x48, 0xC8, 0x90, 0x00, 0x03, 0x0C, 0x08, 0x08,
+    0x0C, 0x07, 0x00, 0x08, 0x08, 0x08, 0x88, 0x78, 0x18, 0x00, 0x00, 0x08, 0x06, 0x01, 0x00, 0x00,
+    0x00, 0x70, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00, 0x07, 0x08, 0x08, 0x08, 0x08, 0x07, 0x00, 0xF0,
+    0x18, 0x08, 0x08, 0x98, 0xE0, 0x00, 0x04, 0x09, 0x09, 0x09, 0x04, 0x03, 0x00, 0x00, 0x00, 0xC0,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x10, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x40, 0x40, 0x40, 0x20, 0x00,
+    0x01, 0x01, 0x02, 0x02, 0x02, 0x04, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x02, 0x02,
+    0x02, 0x02, 0x02, 0x02, 0x00, 0x20, 0x40, 0x40, 0x40, 0x80, 0x80, 0x00, 0x04, 0x02, 0x02, 0x02,
+    0x01, 0x01, 0x00, 0x00, 0x10, 0x88, 0xC8, 0x48, 0x30, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00,
+    0x00, 0xC0, 0x20, 0x10, 0x90, 0xB0, 0xE0, 0x00, 0x0F, 0x18, 0x23, 0x24, 0x24, 0x07, 0x00, 0x00,
+    0xC0, 0x38, 0x38, 0xC0, 0x00, 0x00, 0x0C, 0x03, 0x02, 0x02, 0x03, 0x0C, 0x00, 0xF8, 0x88, 0x88,
+    0x88, 0x88, 0x70, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x08, 0x07, 0x00, 0xE0, 0x10, 0x08, 0x08, 0x08,
+    0x10, 0x00, 0x03, 0x04, 0x08, 0x08, 0x08, 0x04, 0x00, 0xF8, 0x08, 0x08, 0x08, 0x10, 0xE0, 0x00,
+    0x0F, 0x08, 0x08, 0x08, 0x04, 0x03, 0x00, 0xF8, 0x88, 0x88, 0x88, 0x88, 0x88, 0x00, 0x0F, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x00, 0xF8, 0x88, 0x88, 0x88, 0x88, 0x88, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xE0, 0x10, 0x08, 0x08, 0x88, 0x90, 0x00, 0x03, 0x04, 0x08, 0x08, 0x08, 0x07,
+    0x00, 0xF8, 0x80, 0x80, 0x80, 0x80, 0xF8, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x08,
+    0x08, 0xF8, 0x08, 0x08, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x08,
+    0x08, 0xF8, 0x00, 0x00, 0x04, 0x08, 0x08, 0x08, 0x07, 0x00, 0x00, 0xF8, 0x80, 0xC0, 0x20, 0x10,
+    0x08, 0x00, 0x0F, 0x00, 0x00, 0x03, 0x06, 0x08, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0F, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0xF8, 0x30, 0xC0, 0xC0, 0x30, 0xF8, 0x00, 0x0F, 0x00,
+    0x01, 0x01, 0x00, 0x0F, 0x00, 0xF8, 0x18, 0xE0, 0x80, 0x00, 0xF8, 0x00, 0x0F, 0x00, 0x00, 0x03,
+    0x0C, 0x0F, 0x00, 0xE0, 0x18, 0x08, 0x08, 0x18, 0xE0, 0x00, 0x03, 0x0C, 0x08, 0x08, 0x0C, 0x03,
+    0x00, 0xF8, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0,
+    0x18, 0x08, 0x08, 0x18, 0xE0, 0x00, 0x03, 0x0C, 0x08, 0x08, 0x3C, 0x07, 0x00, 0xF8, 0x88, 0x88,
+    0x88, 0x88, 0x70, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x01, 0x06, 0x00, 0x70, 0xC8, 0x88, 0x88, 0x88,
+    0x10, 0x00, 0x04, 0x08, 0x08, 0x08, 0x08, 0x07, 0x08, 0x08, 0x08, 0xF8, 0x08, 0x08, 0x08, 0x00,
+    0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0x07, 0x08,
+    0x08, 0x08, 0x08, 0x07, 0x00, 0x18, 0xE0, 0x00, 0x00, 0xE0, 0x18, 0x00, 0x00, 0x01, 0x0E, 0x0E,
+    0x01, 0x00, 0xF8, 0x00, 0xC0, 0x30, 0xC0, 0x00, 0xF8, 0x01, 0x0E, 0x03, 0x00, 0x03, 0x0E, 0x01,
+    0x00, 0x08, 0x30, 0xC0, 0xC0, 0x30, 0x08, 0x00, 0x08, 0x06, 0x01, 0x01, 0x06, 0x08, 0x08, 0x10,
+    0x60, 0x80, 0x60, 0x10, 0x08, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x88,
+    0xC8, 0x38, 0x18, 0x00, 0x0C, 0x0E, 0x09, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0xFC, 0x04, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x1F, 0x10, 0x00, 0x00, 0x00, 0x08, 0x30, 0xC0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x03, 0x0C, 0x10, 0x00, 0x00, 0x04, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+    0x1F, 0x00, 0x00, 0x00, 0x20, 0x10, 0x08, 0x08, 0x10, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40,
+    0x00, 0x00, 0x00, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40,
+    0x20, 0x20, 0x20, 0xC0, 0x00, 0x00, 0x06, 0x09, 0x09, 0x09, 0x0F, 0x00, 0x00, 0xFC, 0x20, 0x20,
+    0x20, 0xC0, 0x00, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x07, 0x00, 0x00, 0xC0, 0x60, 0x20, 0x20, 0x40,
+    0x00, 0x00, 0x07, 0x0C, 0x08, 0x08, 0x08, 0x00, 0x00, 0xC0, 0x20, 0x20, 0x20, 0xFC, 0x00, 0x00,
+    0x07, 0x08, 0x08, 0x08, 0x0F, 0x00, 0x00, 0xC0, 0x60, 0x20, 0x20, 0xC0, 0x00, 0x00, 0x07, 0x09,
+    0x09, 0x09, 0x05, 0x00, 0x00, 0x20, 0x20, 0xF8, 0x24, 0x24, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x00,
+    0x00, 0x00, 0x00, 0xC0, 0x20, 0x20, 0x20, 0xE0, 0x00, 0x00, 0x07, 0x28, 0x48, 0x48, 0x3F, 0x00,
+    0x00, 0xFC, 0x40, 0x20, 0x20, 0xC0, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x20,
+    0x20, 0xE4, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x08, 0x08, 0x00, 0x00, 0x00, 0x20, 0x20,
+    0xE4, 0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0x3F, 0x00, 0x00, 0x00, 0xFC, 0x00, 0x80, 0x40, 0x20,
+    0x00, 0x00, 0x0F, 0x01, 0x02, 0x04, 0x08, 0x00, 0x00, 0x04, 0x04, 0xFC, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x07, 0x08, 0x08, 0x00, 0x00, 0xE0, 0x20, 0xE0, 0x20, 0xE0, 0x00, 0x00, 0x0F, 0x00,
+    0x0F, 0x00, 0x0F, 0x00, 0x00, 0xE0, 0x40, 0x20, 0x20, 0xC0, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00,
+    0x0F, 0x00, 0x00, 0xC0, 0x20, 0x20, 0x20, 0xC0, 0x00, 0x00, 0x07, 0x08, 0x08, 0x08, 0x07, 0x00,
+    0x00, 0xE0, 0x20, 0x20, 0x20, 0xC0, 0x00, 0x00, 0x7F, 0x08, 0x08, 0x08, 0x07, 0x00, 0x00, 0xC0,
+    0x20, 0x20, 0x20, 0xE0, 0x00, 0x00, 0x07, 0x08, 0x08, 0x08, 0x7F, 0x00, 0x00, 0x00, 0xE0, 0x60,
+    0x20, 0x20, 0x40, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x20, 0x20, 0x20, 0x40,
+    0x00, 0x00, 0x04, 0x09, 0x09, 0x09, 0x06, 0x00, 0x00, 0x20, 0x20, 0xF8, 0x20, 0x20, 0x00, 0x00,
+    0x00, 0x00, 0x0F, 0x08, 0x08, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x07, 0x08,
+    0x08, 0x08, 0x0F, 0x00, 0x00, 0x60, 0x80, 0x00, 0x80, 0x60, 0x00, 0x00, 0x00, 0x03, 0x0C, 0x03,
+    0x00, 0x00, 0x60, 0x80, 0x00, 0x80, 0x00, 0x80, 0x60, 0x00, 0x03, 0x0E, 0x01, 0x0E, 0x03, 0x00,
+    0x00, 0x20, 0xC0, 0x00, 0xC0, 0x20, 0x00, 0x00, 0x08, 0x06, 0x01, 0x06, 0x08, 0x00, 0x00, 0x60,
+    0x80, 0x00, 0x80, 0x60, 0x00, 0x00, 0x40, 0x67, 0x1C, 0x03, 0x00, 0x00, 0x00, 0x20, 0x20, 0x20,
+    0xA0, 0x60, 0x00, 0x00, 0x0C, 0x0A, 0x09, 0x08, 0x08, 0x00, 0x00, 0x80, 0x80, 0x7C, 0x04, 0x04,
+    0x00, 0x00, 0x00, 0x00, 0x1F, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x04, 0x04, 0x7C, 0x80, 0x80, 0x00, 0x00, 0x10, 0x10,
+    0x1F, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0x01, 0x01, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F,
+    0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0,
+    0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10,
+    0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10,
+    0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00,
+    0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40,
+    0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40,
+    0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F,
+    0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0,
+    0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10,
+    0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10,
+    0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00,
+    0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40,
+    0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40,
+    0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F,
+    0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0,
+    0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10,
+    0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10,
+    0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00,
+    0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40,
+    0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40,
+    0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F,
+    0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0,
+    0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10,
+    0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10,
+    0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00,
+    0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40,
+    0x40, 0x40, 0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40,
+    0x40, 0x7F, 0x00, 0xF0, 0x10, 0x10, 0x10, 0x10, 0xF0, 0x00, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x20, 0xF8,
+    0x20, 0x40, 0x00, 0x00, 0x07, 0x08, 0x3F, 0x08, 0x04, 0x00, 0x00, 0x80, 0xF0, 0x88, 0x88, 0x08,
+    0x00, 0x00, 0x08, 0x0F, 0x08, 0x08, 0x08, 0x00, 0x00, 0x20, 0xC0, 0x40, 0x40, 0xC0, 0x20, 0x00,
+    0x04, 0x03, 0x02, 0x02, 0x03, 0x04, 0x08, 0x50, 0x60, 0x80, 0x60, 0x50, 0x08, 0x00, 0x01, 0x01,
+    0x0F, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x00,
+    0x00, 0x00, 0x00, 0xF0, 0x28, 0x48, 0xC8, 0x88, 0x00, 0x00, 0x11, 0x13, 0x12, 0x14, 0x0F, 0x00,
+    0x00, 0x00, 0x08, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x20,
+    0xD0, 0x50, 0x50, 0x20, 0xC0, 0x01, 0x02, 0x05, 0x05, 0x05, 0x02, 0x01, 0x00, 0xE8, 0xA8, 0xA8,
+    0xF0, 0x00, 0x00, 0x00, 0x02, 0x02, 0x02, 0x02, 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x00, 0x80,
+    0x40, 0x00, 0x01, 0x02, 0x04, 0x01, 0x02, 0x04, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0x01, 0x01, 0x00, 0x00, 0xC0, 0x20, 0xD0, 0xD0, 0xD0, 0x20, 0xC0, 0x01, 0x02, 0x05, 0x05, 0x05,
+    0x02, 0x01, 0x00, 0x00, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x30, 0x48, 0x48, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80,
+    0x80, 0xE0, 0x80, 0x80, 0x80, 0x08, 0x08, 0x08, 0x0B, 0x08, 0x08, 0x08, 0x00, 0x00, 0x88, 0xE8,
+    0xB8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x88, 0xA8, 0xA8, 0xD8,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x04, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x7F, 0x08,
+    0x08, 0x08, 0x0F, 0x08, 0x00, 0x70, 0xF8, 0xF8, 0xF8, 0x08, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x1F,
+    0x00, 0x1F, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x20, 0x30, 0x00, 0x00, 0x00, 0x00,
+    0x88, 0xF8, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x88, 0x88,
+    0x70, 0x00, 0x00, 0x00, 0x02, 0x02, 0x02, 0x02, 0x00, 0x00, 0x00, 0x40, 0x80, 0x00, 0x40, 0x80,
+    0x00, 0x00, 0x04, 0x02, 0x01, 0x04, 0x02, 0x01, 0x44, 0x7C, 0x40, 0x00, 0x80, 0x80, 0x00, 0x02,
+    0x03, 0x01, 0x0D, 0x0B, 0x1F, 0x08, 0x44, 0x7C, 0x40, 0x00, 0x80, 0x80, 0x00, 0x02, 0x03, 0x01,
+    0x11, 0x1D, 0x17, 0x00, 0x00, 0x44, 0x54, 0x54, 0xEC, 0x80, 0x00, 0x02, 0x03, 0x01, 0x0D, 0x0B,
+    0x1F, 0x08, 0x00, 0x00, 0x00, 0x60, 0x00, 0x00, 0x00, 0x38, 0x4C, 0x44, 0x43, 0x20, 0x00, 0x00,
+    0x00, 0x00, 0xC1, 0x3A, 0x38, 0xC0, 0x00, 0x00, 0x0C, 0x03, 0x02, 0x02, 0x03, 0x0C, 0x00, 0x00,
+    0xC0, 0x3A, 0x39, 0xC0, 0x00, 0x00, 0x0C, 0x03, 0x02, 0x02, 0x03, 0x0C, 0x00, 0x00, 0xC2, 0x39,
+    0x39, 0xC2, 0x00, 0x00, 0x0C, 0x03, 0x02, 0x02, 0x03, 0x0C, 0x00, 0x00, 0xC3, 0x39, 0x3A, 0xC3,
+    0x00, 0x00, 0x0C, 0x03, 0x02, 0x02, 0x03, 0x0C, 0x00, 0x00, 0xC2, 0x38, 0x38, 0xC2, 0x00, 0x00,
+    0x0C, 0x03, 0x02, 0x02, 0x03, 0x0C, 0x00, 0x00, 0x00, 0xFE, 0xE6, 0x00, 0x00, 0x00, 0x08, 0x07,
+    0x02, 0x02, 0x07, 0x08, 0x00, 0x80, 0x78, 0x08, 0xF8, 0x88, 0x88, 0x0C, 0x03, 0x02, 0x02, 0x0F,
+    0x08, 0x08, 0x00, 0xE0, 0x10, 0x08, 0x08, 0x08, 0x10, 0x00, 0x03, 0x04, 0x28, 0x28, 0x38, 0x04,
+    0x00, 0xF8, 0x89, 0x8A, 0x88, 0x88, 0x88, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0xF8,
+    0x88, 0x8A, 0x89, 0x88, 0x88, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0xF8, 0x8A, 0x89,
+    0x89, 0x8A, 0x88, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0xF8, 0x8A, 0x88, 0x8A, 0x88,
+    0x88, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x08, 0x09, 0xFA, 0x08, 0x08, 0x00, 0x00,
+    0x08, 0x08, 0x0F, 0x08, 0x08, 0x00, 0x00, 0x08, 0x08, 0xFA, 0x09, 0x08, 0x00, 0x00, 0x08, 0x08,
+    0x0F, 0x08, 0x08, 0x00, 0x00, 0x08, 0x0A, 0xF9, 0x0A, 0x08, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x08,
+    0x08, 0x00, 0x00, 0x08, 0x0A, 0xF8, 0x0A, 0x08, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x08, 0x08, 0x00,
+    0x80, 0xF8, 0x88, 0x88, 0x08, 0x10, 0xE0, 0x00, 0x0F, 0x08, 0x08, 0x08, 0x04, 0x03, 0x00, 0xF8,
+    0x1B, 0xE1, 0x82, 0x03, 0xF8, 0x00, 0x0F, 0x00, 0x00, 0x03, 0x0C, 0x0F, 0x00, 0xE0, 0x19, 0x0A,
+    0x08, 0x18, 0xE0, 0x00, 0x03, 0x0C, 0x08, 0x08, 0x0C, 0x03, 0x00, 0xE0, 0x18, 0x0A, 0x09, 0x18,
+    0xE0, 0x00, 0x03, 0x0C, 0x08, 0x08, 0x0C, 0x03, 0x00, 0xE0, 0x1A, 0x09, 0x09, 0x1A, 0xE0, 0x00,
+    0x03, 0x0C, 0x08, 0x08, 0x0C, 0x03, 0x00, 0xE0, 0x1B, 0x09, 0x0A, 0x1B, 0xE0, 0x00, 0x03, 0x0C,
+    0x08, 0x08, 0x0C, 0x03, 0x00, 0xE0, 0x1A, 0x08, 0x08, 0x1A, 0xE0, 0x00, 0x03, 0x0C, 0x08, 0x08,
+    0x0C, 0x03, 0x00, 0x20, 0x40, 0x80, 0x40, 0x20, 0x00, 0x00, 0x02, 0x01, 0x00, 0x01, 0x02, 0x00,
+    0x00, 0xE0, 0x18, 0x88, 0x48, 0x38, 0xF8, 0x08, 0x07, 0x0E, 0x09, 0x08, 0x0C, 0x03, 0x00, 0xF8,
+    0x01, 0x02, 0x00, 0x00, 0xF8, 0x00, 0x07, 0x08, 0x08, 0x08, 0x08, 0x07, 0x00, 0xF8, 0x00, 0x02,
+    0x01, 0x00, 0xF8, 0x00, 0x07, 0x08, 0x08, 0x08, 0x08, 0x07, 0x00, 0xF8, 0x02, 0x01, 0x01, 0x02,
+    0xF8, 0x00, 0x07, 0x08, 0x08, 0x08, 0x08, 0x07, 0x00, 0xF8, 0x02, 0x00, 0x00, 0x02, 0xF8, 0x00,
+    0x07, 0x08, 0x08, 0x08, 0x08, 0x07, 0x08, 0x10, 0x60, 0x82, 0x61, 0x10, 0x08, 0x00, 0x00, 0x00,
+    0x0F, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x10, 0x10, 0x10, 0x10, 0xE0, 0x00, 0x0F, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0xF8, 0xE4, 0xA4, 0x18, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x09, 0x09, 0x06, 0x00,
+    0x00, 0x40, 0x20, 0x24, 0x28, 0xC0, 0x00, 0x00, 0x06, 0x09, 0x09, 0x09, 0x0F, 0x00, 0x00, 0x40,
+    0x20, 0x28, 0x24, 0xC0, 0x00, 0x00, 0x06, 0x09, 0x09, 0x09, 0x0F, 0x00, 0x00, 0x40, 0x28, 0x24,
+    0x24, 0xC8, 0x00, 0x00, 0x06, 0x09, 0x09, 0x09, 0x0F, 0x00, 0x00, 0x40, 0x2C, 0x24, 0x28, 0xCC,
+    0x00, 0x00, 0x06, 0x09, 0x09, 0x09, 0x0F, 0x00, 0x00, 0x40, 0x28, 0x20, 0x28, 0xC0, 0x00, 0x00,
+    0x06, 0x09, 0x09, 0x09, 0x0F, 0x00, 0x00, 0x40, 0x26, 0x29, 0x29, 0xC6, 0x00, 0x00, 0x06, 0x09,
+    0x09, 0x09, 0x0F, 0x00, 0x00, 0x40, 0x20, 0xC0, 0x20, 0xE0, 0x00, 0x00, 0x0F, 0x09, 0x07, 0x09,
+    0x09, 0x00, 0x00, 0xC0, 0x60, 0x20, 0x20, 0x40, 0x00, 0x00, 0x07, 0x0C, 0x28, 0x28, 0x38, 0x00,
+    0x00, 0xC0, 0x60, 0x24, 0x28, 0xC0, 0x00, 0x00, 0x07, 0x09, 0x09, 0x09, 0x05, 0x00, 0x00, 0xC0,
+    0x60, 0x28, 0x24, 0xC0, 0x00, 0x00, 0x07, 0x09, 0x09, 0x09, 0x05, 0x00, 0x00, 0xC0, 0x68, 0x24,
+    0x24, 0xC8, 0x00, 0x00, 0x07, 0x09, 0x09, 0x09, 0x05, 0x00, 0x00, 0xC0, 0x68, 0x20, 0x28, 0xC0,
+    0x00, 0x00, 0x07, 0x09, 0x09, 0x09, 0x05, 0x00, 0x00, 0x20, 0x20, 0xE4, 0x08, 0x00, 0x00, 0x00,
+    0x08, 0x08, 0x0F, 0x08, 0x08, 0x00, 0x00, 0x20, 0x20, 0xE8, 0x04, 0x00, 0x00, 0x00, 0x08, 0x08,
+    0x0F, 0x08, 0x08, 0x00, 0x00, 0x28, 0x24, 0xE4, 0x08, 0x00, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x08,
+    0x08, 0x00, 0x00, 0x20, 0x28, 0xE0, 0x08, 0x00, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x08, 0x08, 0x00,
+    0x00, 0x80, 0x54, 0x58, 0x68, 0xC0, 0x00, 0x00, 0x07, 0x08, 0x08, 0x08, 0x07, 0x00, 0x00, 0xE0,
+    0x4C, 0x24, 0x28, 0xCC, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0xC0, 0x20, 0x24,
+    0x28, 0xC0, 0x00, 0x00, 0x07, 0x08, 0x08, 0x08, 0x07, 0x00, 0x00, 0xC0, 0x20, 0x28, 0x24, 0xC0,
+    0x00, 0x00, 0x07, 0x08, 0x08, 0x08, 0x07, 0x00, 0x00, 0xC0, 0x28, 0x24, 0x28, 0xC0, 0x00, 0x00,
+    0x07, 0x08, 0x08, 0x08, 0x07, 0x00, 0x00, 0xCC, 0x24, 0x2C, 0x28, 0xCC, 0x00, 0x00, 0x07, 0x08,
+    0x08, 0x08, 0x07, 0x00, 0x00, 0xC0, 0x28, 0x20, 0x28, 0xC0, 0x00, 0x00, 0x07, 0x08, 0x08, 0x08,
+    0x07, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x05, 0x01, 0x01, 0x00,
+    0x00, 0xC0, 0x20, 0x20, 0xA0, 0xE0, 0x00, 0x00, 0x0F, 0x0A, 0x09, 0x08, 0x07, 0x00, 0x00, 0xE0,
+    0x00, 0x04, 0x08, 0xE0, 0x00, 0x00, 0x07, 0x08, 0x08, 0x08, 0x0F, 0x00, 0x00, 0xE0, 0x00, 0x08,
+    0x04, 0xE0, 0x00, 0x00, 0x07, 0x08, 0x08, 0x08, 0x0F, 0x00, 0x00, 0xE0, 0x08, 0x04, 0x08, 0xE0,
+    0x00, 0x00, 0x07, 0x08, 0x08, 0x08, 0x0F, 0x00, 0x00, 0xE0, 0x08, 0x00, 0x08, 0xE0, 0x00, 0x00,
+    0x07, 0x08, 0x08, 0x08, 0x0F, 0x00, 0x00, 0x60, 0x80, 0x08, 0x84, 0x60, 0x00, 0x00, 0x40, 0x67,
+    0x1C, 0x03, 0x00, 0x00, 0x00, 0xFC, 0x20, 0x20, 0x20, 0xC0, 0x00, 0x00, 0x7F, 0x08, 0x08, 0x08,
+    0x07, 0x00, 0x00, 0x60, 0x88, 0x00, 0x88, 0x60, 0x00, 0x00, 0x40, 0x67, 0x1C, 0x03, 0x00, 0x00,
+};
+
+const font_native_t Monospaced_plain_12_native =
+{
+    .height = 15,
+    .pages = 2,
+    .first = 32,
+    .count = 224,
+    .packed = 0,
+    .glyphs = Monospaced_plain_12_glyphs,
+    .bitmap = Monospaced_plain_12_bitmap,
+};
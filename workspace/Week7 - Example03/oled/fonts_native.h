@@ -0,0 +1,15 @@
+/* Generated by tools/font_convert.py, do not edit. */
+#ifndef FONTS_NATIVE_H_
+#define FONTS_NATIVE_H_
+
+#include "fonts.h"
+
+extern const font_native_t Monospaced_plain_10_native;
+extern const font_native_t Dialog_plain_12_native;
+extern const font_native_t Monospaced_bold_24_native; // packed, 6582 of 12544 bytes
+extern const font_native_t Roboto_Mono_Medium_12_native;
+extern const font_native_t Monospaced_plain_12_native;
+
+#define FONTS_NATIVE_PACKED_MAX (56)
+
+#endif // FONTS_NATIVE_H_
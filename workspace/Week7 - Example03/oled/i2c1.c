@@ -40,45 +40,43 @@
  *            OTHER DEALINGS IN THE SOFTWARE.
  *
  *****************************************************************************/
-#include <MKL25Z4.h>
 #include "i2c1.h"
+#include "ssd1306.h"
 
 /*!
  * \brief Initialises the I2C peripheral
  *
  * Initialises I2C1
- * The I2C baud rate is set to 375000 bps
+ * The I2C baud rate is set to I2C1_DEFAULT_BPS, or the bit rate selected by
+ * i2c1_set_speed()
  * The following I2C pins are configured:
  * - PTE0: SDA
  * - PTE1: SCL
  */
 void i2c1_init(void)
 {
-    // Clock i2c peripheral and port
-    SIM->SCGC4 |= SIM_SCGC4_I2C1_MASK;
-    SIM->SCGC5 |= SIM_SCGC5_PORTE_MASK;
-    
-    // Set pins to I2C function
-    PORTE->PCR[0] |= PORT_PCR_MUX(6);
-    PORTE->PCR[1] |= PORT_PCR_MUX(6);
-    
-    // Make sure i2c is disabled
-    I2C1->C1 &= ~(I2C_C1_IICEN_MASK);
-        
-    // MUL[1:0] : The MULT bits define the multiplier factor mul.
-    // ICR[5:0] : Prescales the bus clock for bit rate selection.
-    //
-    // I2C baud rate = bus speed (Hz)/(mul � SCL divider)
-    //        375000 =     24MHz     /( 1  *    64)
-    I2C1->F = (I2C_F_MULT(0) | I2C_F_ICR(0x12));   
-    
-    // Clear any flags
-    I2C1->S |= (I2C_S_ARBL_MASK | I2C_S_IICIF_MASK);
-    
-    // Enable i2c and set to master mode
-    I2C1->C1 |= (I2C_C1_IICEN_MASK);
+    i2c_init(&i2c_bus1);
 }
 
+/*!
+ * \brief Sets the I2C1 bit rate
+ *
+ * \see i2c_set_speed()
+ */
+uint32_t i2c1_set_speed(const uint32_t bps)
+{
+    return i2c_set_speed(&i2c_bus1, bps);
+}
+
+/*!
+ * \brief Returns the achieved I2C1 bit rate in bps
+ */
+uint32_t i2c1_get_speed(void)
+{
+    return i2c_get_speed(&i2c_bus1);
+}
+
+
 /*!
  * \brief Sends multiple commands to the Oled display
  *
@@ -93,29 +91,6 @@ void i2c1_init(void)
  */
 bool i2c1_write_cmd(const uint8_t address, const uint8_t cmd[], const uint32_t n)
 {
-    // Set to transmit mode
-    I2C1->C1 |= I2C_C1_TX_MASK;
-    
-    // Generate start condition
-    I2C1->C1 |= I2C_C1_MST_MASK;
-    
-    // Send the address
-    I2C1->D = address;
-    
-    // Wait for acknowledge
-    // If timeout occurs, try to reinitialise i2c and return from this function
-    uint32_t timeout = I2C_TIMEOUT;
-    while((I2C1->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }
-        
-    // Clear the flag
-    I2C1->S |= I2C_S_IICIF_MASK;
-                      
     // Datasheet 8.1.5.2: A control byte mainly consists of Co and D/C# bits 
     //                    following by six �0� �s
     // Bit 7 Co:   If the Co bit is set as logic �0�, the transmission of the 
@@ -126,50 +101,10 @@ bool i2c1_write_cmd(const uint8_t address, const uint8_t cmd[], const uint32_t n
     //             is set to logic �1�, it defines the following data byte as a 
     //             data which will be stored at the GDDRAM.
     //             The GDDRAM column address pointer will be increased by one 
-    //             automatically after each data write.    
-    
+    //             automatically after each data write.
+
     // Send control byte: next byte is acted as a command
-    I2C1->D = 0x00;
-        
-    // Wait for acknowledge
-    // If timeout occurs, try to reinitialise i2c and return from this function
-    timeout = I2C_TIMEOUT;
-    while((I2C1->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }        
-        
-    // Clear the flag
-    I2C1->S |= I2C_S_IICIF_MASK;             
-                           
-    for(uint32_t i=0; i<n; ++i)
-    {
-        // Send the byte
-        I2C1->D = cmd[i];
-        
-        // Wait for acknowledge
-        // If timeout occurs, try to reinitialise i2c and return from this
-        // function
-        timeout = I2C_TIMEOUT;
-        while((I2C1->S & I2C_S_IICIF_MASK)==0)
-        {
-            if(--timeout == 0)
-            {
-                return false;
-            }
-        }        
-            
-        // Clear the flag
-        I2C1->S |= I2C_S_IICIF_MASK;
-    }
-    
-    // Generate stop
-    I2C1->C1 &= ~I2C_C1_MST_MASK;
-    
-    return true;
+    return i2c_write(&i2c_bus1, address, 0x00, cmd, n);
 }
 
 /*!
@@ -186,81 +121,13 @@ bool i2c1_write_cmd(const uint8_t address, const uint8_t cmd[], const uint32_t n
  */
 bool i2c1_write_data(const uint8_t address, const uint8_t data[], const uint32_t n)
 {
-    // Set to transmit mode
-    I2C1->C1 |= I2C_C1_TX_MASK;
-    
-    // Generate start condition
-    I2C1->C1 |= I2C_C1_MST_MASK;
-    
-    // Send the address
-    I2C1->D = address;
-    
-    // Wait for acknowledge
-    // If timeout occurs, try to reinitialise i2c and return from this function
-    uint32_t timeout = I2C_TIMEOUT;
-    while((I2C1->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }
-        
-    // Clear the flag
-    I2C1->S |= I2C_S_IICIF_MASK;
-                      
-    // Datasheet 8.1.5.2: A control byte mainly consists of Co and D/C# bits 
-    //                    following by six �0� �s
-    // Bit 7 Co:   If the Co bit is set as logic �0�, the transmission of the 
-    //             following information will contain data bytes only.
-    // Bit 6 D/C#: The D/C# bit determines the next data byte is acted as a 
-    //             command or a data. If the D/C# bit is set to logic �0�, it 
-    //             defines the following data byte as a command. If the D/C# bit
-    //             is set to logic �1�, it defines the following data byte as a 
-    //             data which will be stored at the GDDRAM.
-    //             The GDDRAM column address pointer will be increased by one 
-    //             automatically after each data write.    
-
     // Send control byte: next byte is acted as a data
-    I2C1->D = 0x40;
-        
-    // Wait for acknowledge
-    // If timeout occurs, try to reinitialise i2c and return from this function
-    timeout = I2C_TIMEOUT;
-    while((I2C1->S & I2C_S_IICIF_MASK)==0)
-    {
-        if(--timeout == 0)
-        {
-            return false;
-        }
-    }
-        
-    // Clear the flag
-    I2C1->S |= I2C_S_IICIF_MASK;  
-    
-    for(uint32_t i=0; i<n; ++i)
-    {
-        // Send the byte
-        I2C1->D = data[i];
-
-        // Wait for acknowledge
-        // If timeout occurs, try to reinitialise i2c and return from this
-        // function
-        timeout = I2C_TIMEOUT;
-        while((I2C1->S & I2C_S_IICIF_MASK)==0)
-        {
-            if(--timeout == 0)
-            {
-                return false;
-            }
-        }
-            
-        // Clear the flag
-        I2C1->S |= I2C_S_IICIF_MASK;
-    }
-    
-    // Generate stop
-    I2C1->C1 &= ~I2C_C1_MST_MASK;
-    
-    return true;
+    return i2c_write(&i2c_bus1, address, 0x40, data, n);
 }
+
+const ssd1306_transport_t ssd1306_i2c1 =
+{
+    .init = i2c1_init,
+    .write_cmd = i2c1_write_cmd,
+    .write_data = i2c1_write_data,
+};
@@ -43,19 +43,12 @@
 #ifndef I2C1_H
 #define I2C1_H
 
-#include <stdint.h>
-#include <stdbool.h>
-
-/*!
- * \brief Definition for the I2C timeout
- *
- * This timeout value is used in loops to wait for a bit to set/reset. If the
- * bit doesn't get set, the function returns.
- */
-#define I2C_TIMEOUT (10000)
+#include "i2c.h"
 
 // Function prototypes
 void i2c1_init(void);
+uint32_t i2c1_set_speed(const uint32_t bps);
+uint32_t i2c1_get_speed(void);
 
 bool i2c1_write_cmd(const uint8_t address, const uint8_t cmd[], const uint32_t n);
 bool i2c1_write_data(const uint8_t address, const uint8_t data[], const uint32_t n);
@@ -0,0 +1,393 @@
+/*! ***************************************************************************
+ *
+ * \brief     SPI low level peripheral driver
+ * \file      spi1.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "spi1.h"
+#include "ssd1306_transport.h"
+#include "clock.h"
+#include "delay.h"
+#include "dma.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <MKL25Z4.h>
+#include "irq_prio.h"
+
+#if (SSD1306_SPI == 1)
+
+// Pins
+#define SPI1_SCK  (2) // PTE2, ALT2
+#define SPI1_MOSI (1) // PTE1, ALT2
+#define SPI1_RES  (3) // PTE3, GPIO
+#define SPI1_CS   (4) // PTE4, GPIO
+#define SPI1_DC   (5) // PTE5, GPIO
+
+#if (SPI1_DMA_CHANNEL < 0) || (SPI1_DMA_CHANNEL >= DMA_CHANNELS)
+#error "SPI1_DMA_CHANNEL must be 0, 1, 2 or 3"
+#endif
+
+// Set if the DMA channel was claimed, all writes are polled otherwise
+static bool spi1_dma = false;
+
+// Task waiting for the end of a DMA transfer
+static TaskHandle_t volatile spi1_task = NULL;
+
+// Status of the last DMA transfer, saved by the interrupt handler
+static volatile uint32_t spi1_dma_status = 0;
+
+// Achieved SPI clock in bps
+static uint32_t spi1_rate = 0;
+
+static clk_notifier_t spi1_clock_notifier;
+
+static void spi1_dma_isr(void *arg, const uint32_t status, BaseType_t *woken);
+
+/*!
+ * \brief Sets the fastest SPI clock that does not exceed SPI1_MAX_BPS
+ *
+ * The SPI clock is the bus clock / ((SPPR + 1) * 2^(SPR + 1)).
+ */
+static void spi1_set_speed(void)
+{
+    const uint32_t bus = clk_bus_hz();
+    uint32_t best_div = 0;
+    uint8_t best_br = 0;
+
+    for(uint32_t spr=0; spr<=8; ++spr)
+    {
+        for(uint32_t sppr=0; sppr<8; ++sppr)
+        {
+            const uint32_t div = (sppr + 1) << (spr + 1);
+
+            if((bus / div <= SPI1_MAX_BPS) && ((best_div == 0) || (div < best_div)))
+            {
+                best_div = div;
+                best_br = SPI_BR_SPPR(sppr) | SPI_BR_SPR(spr);
+            }
+        }
+    }
+
+    SPI1->BR = best_br;
+    spi1_rate = bus / best_div;
+}
+
+/*!
+ * \brief Waits for a DMA transfer before the clocks change and sets the SPI
+ *        clock for the new bus clock after
+ */
+static void spi1_clock(const clk_event_t event, void *arg)
+{
+    (void)arg;
+
+    if(event == CLK_PRE_CHANGE)
+    {
+        while(spi1_dma &&
+              (DMA0->DMA[SPI1_DMA_CHANNEL].DSR_BCR & DMA_DSR_BCR_BSY_MASK))
+        {}
+
+        return;
+    }
+
+    spi1_set_speed();
+}
+
+/*!
+ * \brief Initialises the SPI peripheral and resets the Oled display
+ *
+ * Initialises SPI1 as master in mode 0, MSB first, at the clock selected by
+ * SPI1_MAX_BPS. CS# and D/C# are GPIO pins, so the chip select stays low
+ * for a complete transfer and D/C# changes only between transfers. The
+ * display is reset with RES#, which the datasheet requires to be low for
+ * at least 3 us.
+ * The following pins are configured:
+ * - PTE2: SCK
+ * - PTE1: MOSI
+ * - PTE3: RES#
+ * - PTE4: CS#
+ * - PTE5: D/C#
+ */
+void spi1_init(void)
+{
+    static bool registered = false;
+
+    // Clock SPI and port
+    if(!registered)
+    {
+        clk_gate_acquire(CLK_GATE_SPI1);
+    }
+
+    SIM->SCGC5 |= SIM_SCGC5_PORTE_MASK;
+
+    PORTE->PCR[SPI1_SCK] = PORT_PCR_MUX(2);
+    PORTE->PCR[SPI1_MOSI] = PORT_PCR_MUX(2);
+    PORTE->PCR[SPI1_RES] = PORT_PCR_MUX(1);
+    PORTE->PCR[SPI1_CS] = PORT_PCR_MUX(1);
+    PORTE->PCR[SPI1_DC] = PORT_PCR_MUX(1);
+
+    PTE->PSOR = (1 << SPI1_CS) | (1 << SPI1_DC);
+    PTE->PCOR = (1 << SPI1_RES);
+    PTE->PDDR |= (1 << SPI1_RES) | (1 << SPI1_CS) | (1 << SPI1_DC);
+
+    // Master, mode 0, MSB first, no MODF on a GPIO chip select
+    SPI1->C1 = 0;
+    SPI1->C2 = 0;
+    spi1_set_speed();
+    SPI1->C1 = SPI_C1_MSTR_MASK | SPI_C1_SPE_MASK;
+
+    if(!registered)
+    {
+        clk_register(&spi1_clock_notifier, spi1_clock, NULL);
+        registered = true;
+    }
+
+    // Claim the DMA channel for good
+    if(!spi1_dma)
+    {
+        spi1_dma = dma_claim(SPI1_DMA_CHANNEL, spi1_dma_isr, NULL) >= 0;
+    }
+
+    if(spi1_dma)
+    {
+        // DMA channel: one byte per empty transmit buffer into the data
+        // register
+        DMA0->DMA[SPI1_DMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+        DMA0->DMA[SPI1_DMA_CHANNEL].DAR = (uint32_t)&SPI1->D;
+        dma_route(SPI1_DMA_CHANNEL, DMA_SOURCE_SPI1_TX, false);
+
+        dma_irq_enable(SPI1_DMA_CHANNEL, IRQ_PRIO(SPI1_DMA));
+    }
+
+    delay_us(10);
+    PTE->PSOR = (1 << SPI1_RES);
+    delay_us(10);
+}
+
+/*!
+ * \brief Returns the achieved SPI1 clock in bps
+ */
+uint32_t spi1_get_speed(void)
+{
+    return spi1_rate;
+}
+
+/*!
+ * \brief Sends n bytes by polling
+ *
+ * Waits for every received byte, so the last byte has been shifted out
+ * when the function returns.
+ */
+static void spi1_write_polled(const uint8_t buf[], const uint32_t n)
+{
+    // Clear a receive flag left by a previous transfer
+    (void)SPI1->S;
+    (void)SPI1->D;
+
+    for(uint32_t i=0; i<n; ++i)
+    {
+        while(!(SPI1->S & SPI_S_SPTEF_MASK))
+        {}
+
+        SPI1->D = buf[i];
+
+        while(!(SPI1->S & SPI_S_SPRF_MASK))
+        {}
+
+        (void)SPI1->D;
+    }
+}
+
+/*!
+ * \brief Sends n bytes by DMA, the calling task blocks until the end
+ *
+ * The received bytes are not read. The KL25Z SPI has no transfer complete
+ * flag, so after the DMA wrote the last byte into the empty transmit buffer
+ * the function waits one byte time for it to be shifted out.
+ *
+ * \return False on a DMA error or timeout
+ */
+static bool spi1_write_dma(const uint8_t buf[], const uint32_t n)
+{
+    DMA_Type *const dma = DMA0;
+    const uint32_t ch = SPI1_DMA_CHANNEL;
+    const TickType_t timeout = pdMS_TO_TICKS((n * 8 * 1000) / spi1_rate +
+        SPI1_TIMEOUT_MARGIN_MS);
+
+    spi1_dma_status = 0;
+    spi1_task = xTaskGetCurrentTaskHandle();
+    (void)ulTaskNotifyTakeIndexed(SPI1_NOTIFY_INDEX, pdTRUE, 0);
+
+    dma->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    dma->DMA[ch].SAR = (uint32_t)buf;
+    dma->DMA[ch].DSR_BCR = DMA_DSR_BCR_BCR(n);
+    dma->DMA[ch].DCR = DMA_DCR_EINT_MASK |
+                       DMA_DCR_ERQ_MASK |
+                       DMA_DCR_CS_MASK |
+                       DMA_DCR_SINC_MASK |
+                       DMA_DCR_SSIZE(1) |
+                       DMA_DCR_DSIZE(1) |
+                       DMA_DCR_D_REQ_MASK;
+
+    // The empty transmit buffer requests the first byte
+    SPI1->C2 |= SPI_C2_TXDMAE_MASK;
+
+    const bool done = ulTaskNotifyTakeIndexed(SPI1_NOTIFY_INDEX, pdTRUE, timeout) != 0;
+
+    SPI1->C2 &= ~SPI_C2_TXDMAE_MASK;
+    dma->DMA[ch].DCR &= ~DMA_DCR_ERQ_MASK;
+    spi1_task = NULL;
+
+    if(!done || (spi1_dma_status & (DMA_DSR_BCR_CE_MASK | DMA_DSR_BCR_BES_MASK |
+                                    DMA_DSR_BCR_BED_MASK)))
+    {
+        dma->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+        return false;
+    }
+
+    while(!(SPI1->S & SPI_S_SPTEF_MASK))
+    {}
+
+    delay_us((8000000UL + spi1_rate - 1) / spi1_rate);
+
+    return true;
+}
+
+/*!
+ * \brief Sends n bytes with D/C# at the given level and CS# low
+ */
+static bool spi1_write(const bool data, const uint8_t buf[], const uint32_t n)
+{
+    bool ok = true;
+
+    if(n == 0)
+    {
+        return true;
+    }
+
+    // Datasheet 8.1.3: D/C# is sampled with the last bit of every byte
+    if(data)
+    {
+        PTE->PSOR = (1 << SPI1_DC);
+    }
+    else
+    {
+        PTE->PCOR = (1 << SPI1_DC);
+    }
+
+    PTE->PCOR = (1 << SPI1_CS);
+
+    if(!spi1_dma || (n < SPI1_DMA_THRESHOLD) ||
+       (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING))
+    {
+        spi1_write_polled(buf, n);
+    }
+    else
+    {
+        ok = spi1_write_dma(buf, n);
+    }
+
+    PTE->PSOR = (1 << SPI1_CS);
+
+    return ok;
+}
+
+/*!
+ * \brief Sends multiple commands to the Oled display
+ *
+ * \param[in]  cmd  Pointer to the array of commands to be transmitted
+ * \param[in]  n    Number of commands
+ *
+ * \return True on successfull communication, false otherwise
+ */
+bool spi1_write_cmd(const uint8_t cmd[], const uint32_t n)
+{
+    return spi1_write(false, cmd, n);
+}
+
+/*!
+ * \brief Sends multiple data bytes to the Oled display
+ *
+ * \param[in]  data  Pointer to the array of data bytes to be transmitted
+ * \param[in]  n     Number of data bytes
+ *
+ * \return True on successfull communication, false otherwise
+ */
+bool spi1_write_data(const uint8_t data[], const uint32_t n)
+{
+    return spi1_write(true, data, n);
+}
+
+/*!
+ * \brief The transfer ended or failed, called by the interrupt handler of the
+ *        DMA channel
+ */
+static void spi1_dma_isr(void *arg, const uint32_t status, BaseType_t *woken)
+{
+    (void)arg;
+
+    spi1_dma_status = status;
+    DMA0->DMA[SPI1_DMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+
+    if(spi1_task != NULL)
+    {
+        vTaskNotifyGiveIndexedFromISR(spi1_task, SPI1_NOTIFY_INDEX, woken);
+    }
+}
+
+/*!
+ * \brief Sends commands to the Oled display, CS# selects the only display
+ */
+static bool spi1_transport_cmd(const uint8_t address, const uint8_t cmd[],
+    const uint32_t n)
+{
+    (void)address;
+
+    return spi1_write_cmd(cmd, n);
+}
+
+/*!
+ * \brief Sends display data to the Oled display, CS# selects the only
+ *        display
+ */
+static bool spi1_transport_data(const uint8_t address, const uint8_t data[],
+    const uint32_t n)
+{
+    (void)address;
+
+    return spi1_write_data(data, n);
+}
+
+const ssd1306_transport_t ssd1306_spi1 =
+{
+    .init = spi1_init,
+    .write_cmd = spi1_transport_cmd,
+    .write_data = spi1_transport_data,
+};
+
+#endif // SSD1306_SPI
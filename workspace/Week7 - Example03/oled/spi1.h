@@ -0,0 +1,104 @@
+/*! ***************************************************************************
+ *
+ * \brief     SPI low level peripheral driver
+ * \file      spi1.h
+ * \date      October 2026
+ *
+ * \remark    Hardware connection
+ * <pre>                                SSD1306 Oled display (SPI)       </pre>
+ * <pre>                           Vdd +-------------+                   </pre>
+ * <pre>      FRDM-KL25Z            |  |             |                   </pre>
+ * <pre>      -------------+        +--+Vcc          |                   </pre>
+ * <pre>                   |   GND|----+GND          |                   </pre>
+ * <pre>      SPI1_SCK/PTE2+-----------+D0 (SCLK)    |                   </pre>
+ * <pre>     SPI1_MOSI/PTE1+-----------+D1 (SDIN)    |                   </pre>
+ * <pre>               PTE3+-----------+RES#         |                   </pre>
+ * <pre>               PTE4+-----------+CS#          |                   </pre>
+ * <pre>               PTE5+-----------+D/C#         |                   </pre>
+ * <pre>      -------------+           +-------------+                   </pre>
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef SPI1_H
+#define SPI1_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// \name Definitions for SPI1
+/// \{
+
+/*!
+ * \brief Highest SPI clock, the SSD1306 has a minimum clock cycle time of
+ *        100 ns
+ *
+ * The SPI clock is the bus clock divided by 2 to 4096, so the clock is the
+ * fastest division of the bus clock that does not exceed this. At a bus
+ * clock of 24 MHz that is 6 MHz, for 1.4 ms per full framebuffer.
+ */
+#ifndef SPI1_MAX_BPS
+#define SPI1_MAX_BPS (10000000)
+#endif
+
+/*!
+ * \brief Minimum number of bytes written for a transfer to use DMA, shorter
+ *        transfers are polled in less time than a context switch
+ */
+#ifndef SPI1_DMA_THRESHOLD
+#define SPI1_DMA_THRESHOLD (16)
+#endif
+
+/*!
+ * \brief DMA channel used for SPI1 transfers, the channel of I2C1, which is
+ *        not used by the Oled display with the SPI transport
+ *
+ * Claimed from the DMA manager by spi1_init(), all writes are polled if
+ * another driver has it.
+ */
+#define SPI1_DMA_CHANNEL (2)
+
+/*!
+ * \brief Task notification index used to signal a completed transfer, the
+ *        index of I2C1
+ */
+#ifndef SPI1_NOTIFY_INDEX
+#define SPI1_NOTIFY_INDEX (3)
+#endif
+
+/*!
+ * \brief Time a transfer may take longer than its bits, in ms
+ */
+#define SPI1_TIMEOUT_MARGIN_MS (2)
+
+/// \}
+
+// Function prototypes
+void spi1_init(void);
+uint32_t spi1_get_speed(void);
+
+bool spi1_write_cmd(const uint8_t cmd[], const uint32_t n);
+bool spi1_write_data(const uint8_t data[], const uint32_t n);
+
+#endif // SPI1_H
@@ -0,0 +1,467 @@
+/*! ***************************************************************************
+ *
+ * \brief     Layered sprite compositor for the SSD1306 framebuffer
+ * \file      sprite.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "sprite.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*!
+ * \brief Returns the screen rectangle of a sprite, clipped to the screen
+ */
+static sprite_rect_t sprite_rect(const sprite_t *s)
+{
+    sprite_rect_t r =
+    {
+        (s->x < 0) ? 0 : s->x,
+        (s->y < 0) ? 0 : s->y,
+        s->x + s->w - 1,
+        s->y + s->h - 1,
+    };
+
+    if(r.x1 > (SSD1306_WIDTH - 1))
+    {
+        r.x1 = SSD1306_WIDTH - 1;
+    }
+
+    if(r.y1 > (SSD1306_HEIGHT - 1))
+    {
+        r.y1 = SSD1306_HEIGHT - 1;
+    }
+
+    if(!s->visible || (s->w == 0) || (s->h == 0) || (r.x0 > r.x1) ||
+       (r.y0 > r.y1))
+    {
+        r.x0 = 1;
+        r.x1 = 0;
+    }
+
+    return r;
+}
+
+/*!
+ * \brief Returns the rows 0 to h-1 of a sprite that fall in a page
+ *
+ * \param[in]  h    Height of the sprite
+ * \param[in]  row  Row of the sprite at the top of the page, -7 to h-1
+ *
+ * \return The rows in the bits of a framebuffer byte
+ */
+static uint8_t sprite_rows(const uint32_t h, const int32_t row)
+{
+    uint32_t rows = 0xFF;
+
+    if(row < 0)
+    {
+        rows <<= (uint32_t)(-row);
+    }
+
+    if(((int32_t)h - row) < 8)
+    {
+        rows &= (1UL << ((int32_t)h - row)) - 1;
+    }
+
+    return (uint8_t)rows;
+}
+
+/*!
+ * \brief Returns the eight rows of an image that fall in a page
+ *
+ * \param[in]  image  Image of w by h pixels
+ * \param[in]  w      Width of the image
+ * \param[in]  h      Height of the image
+ * \param[in]  col    Column in the image
+ * \param[in]  row    Row of the image at the top of the page, -7 to h-1
+ *
+ * \return The rows in the bits of a framebuffer byte, rows outside the image
+ *         are 0
+ */
+static uint8_t sprite_bits(const uint8_t *image, const uint32_t w,
+    const uint32_t h, const uint32_t col, const int32_t row)
+{
+    uint32_t bits;
+
+    if(row < 0)
+    {
+        bits = (uint32_t)image[col] << (uint32_t)(-row);
+    }
+    else
+    {
+        const uint32_t k = (uint32_t)row / 8;
+        const uint32_t shift = (uint32_t)row % 8;
+
+        bits = image[k * w + col] >> shift;
+
+        if((shift != 0) && ((k + 1) < ((h + 7) / 8)))
+        {
+            bits |= (uint32_t)image[(k + 1) * w + col] << (8 - shift);
+        }
+    }
+
+    return (uint8_t)bits & sprite_rows(h, row);
+}
+
+/*!
+ * \brief Blends the visible sprites into a column range of a page
+ *
+ * \param[in]      scene  Scene
+ * \param[in]      page   Page
+ * \param[in]      x0     First column
+ * \param[in]      x1     Last column
+ * \param[in,out]  buf    Background of the columns, then the result
+ */
+static void sprite_blend(const sprite_scene_t *scene, const uint32_t page,
+    const int32_t x0, const int32_t x1, uint8_t *buf)
+{
+    for(const sprite_t *s=scene->sprites; s!=NULL; s=s->next)
+    {
+        const int32_t row = (int32_t)(page * 8) - s->y;
+
+        if(!s->visible || (row <= -8) || (row >= s->h))
+        {
+            continue;
+        }
+
+        const int32_t c0 = (s->x > x0) ? s->x : x0;
+        const int32_t c1 = ((s->x + s->w - 1) < x1) ? (s->x + s->w - 1) : x1;
+
+        // Without a mask the sprite is opaque in its rectangle
+        const uint8_t opaque = sprite_rows(s->h, row);
+
+        for(int32_t c=c0; c<=c1; c++)
+        {
+            const uint32_t col = (uint32_t)(c - s->x);
+            const uint8_t bits = sprite_bits(s->image, s->w, s->h, col, row);
+            uint8_t *b = &buf[c - x0];
+
+            if(s->blend == SPRITE_OR)
+            {
+                *b |= bits;
+            }
+            else if(s->blend == SPRITE_XOR)
+            {
+                *b ^= bits;
+            }
+            else
+            {
+                const uint8_t m = (s->mask != NULL) ?
+                    sprite_bits(s->mask, s->w, s->h, col, row) : opaque;
+
+                *b = (*b & (uint8_t)~m) | (bits & m);
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Composes a rectangle of the framebuffer from the scene
+ *
+ * Works on whole pages, the rows of the pages the rectangle touches are
+ * composed as well.
+ *
+ * \return Number of bytes composed
+ */
+static uint32_t sprite_compose(ssd1306_t *oled, const sprite_scene_t *scene,
+    const sprite_rect_t *r)
+{
+    uint8_t buf[SSD1306_WIDTH];
+
+    if(r->x0 > r->x1)
+    {
+        return 0;
+    }
+
+    const uint32_t n = (uint32_t)(r->x1 - r->x0 + 1);
+
+    for(uint32_t page=(uint32_t)r->y0/8; page<=(uint32_t)r->y1/8; page++)
+    {
+        if(scene->rle != NULL)
+        {
+            ssd1306_rle_span(scene->rle, page, (uint32_t)r->x0, n, buf);
+        }
+        else if(scene->background != NULL)
+        {
+            (void)memcpy(buf, &scene->background[page * SSD1306_WIDTH + r->x0], n);
+        }
+        else
+        {
+            (void)memset(buf, 0, n);
+        }
+
+        sprite_blend(scene, page, r->x0, r->x1, buf);
+
+        for(uint32_t i=0; i<n; i++)
+        {
+            ssd1306_setbyte(oled, (uint8_t)(r->x0 + i), (uint8_t)page, buf[i]);
+        }
+    }
+
+    return n * ((uint32_t)r->y1/8 - (uint32_t)r->y0/8 + 1);
+}
+
+/*!
+ * \brief Sets up a scene without sprites
+ *
+ * The first sprite_render() composes the whole screen.
+ *
+ * \param[out] scene       Scene
+ * \param[in]  background  SSD1306_SIZE bytes in the format of
+ *                         ssd1306_drawbitmap(), NULL for a blank screen
+ */
+void sprite_scene_init(sprite_scene_t *scene, const uint8_t *background)
+{
+    scene->background = background;
+    scene->rle = NULL;
+    scene->sprites = NULL;
+    scene->full = true;
+}
+
+/*!
+ * \brief Replaces the background, the next render composes the whole screen
+ */
+void sprite_set_background(sprite_scene_t *scene, const uint8_t *background)
+{
+    scene->background = background;
+    scene->rle = NULL;
+    scene->full = true;
+}
+
+/*!
+ * \brief Replaces the background by a compressed bitmap, the next render
+ *        composes the whole screen
+ *
+ * Only the columns of every rectangle that is composed are decoded, so the
+ * background needs no copy in RAM.
+ */
+void sprite_set_background_rle(sprite_scene_t *scene, const ssd1306_rle_t *rle)
+{
+    scene->background = NULL;
+    scene->rle = rle;
+    scene->full = true;
+}
+
+/*!
+ * \brief Composes the whole screen on the next render
+ *
+ * Call after the framebuffer was drawn over by other code.
+ */
+void sprite_invalidate(sprite_scene_t *scene)
+{
+    scene->full = true;
+}
+
+/*!
+ * \brief Updates the framebuffer after the changes to the scene
+ *
+ * Call between display_lock() and display_unlock(). Only the rectangles of
+ * the sprites that changed are composed, where they were and where they
+ * are now.
+ *
+ * \param[in,out] scene  Scene
+ * \param[in,out] oled   Back buffer returned by display_lock()
+ *
+ * \return Number of framebuffer bytes composed
+ */
+uint32_t sprite_render(sprite_scene_t *scene, ssd1306_t *oled)
+{
+    static const sprite_rect_t screen =
+    {
+        0, 0, SSD1306_WIDTH - 1, SSD1306_HEIGHT - 1
+    };
+    uint32_t n = 0;
+
+    if(scene->full)
+    {
+        n = sprite_compose(oled, scene, &screen);
+        scene->full = false;
+    }
+
+    for(sprite_t *s=scene->sprites; s!=NULL; s=s->next)
+    {
+        if(!s->changed)
+        {
+            continue;
+        }
+
+        const sprite_rect_t now = sprite_rect(s);
+
+        // Nothing left to compose after the whole screen
+        if(n < SSD1306_SIZE)
+        {
+            n += sprite_compose(oled, scene, &s->drawn);
+            n += sprite_compose(oled, scene, &now);
+        }
+
+        s->drawn = now;
+        s->changed = false;
+    }
+
+    return n;
+}
+
+/*!
+ * \brief Sets up a hidden sprite at the top left corner
+ *
+ * \param[out] s      Sprite
+ * \param[in]  image  Image of w by h pixels, see sprite.h, kept by reference
+ * \param[in]  w      Width in pixels
+ * \param[in]  h      Height in pixels
+ * \param[in]  blend  Blend mode, a SPRITE_MASK sprite is opaque in its
+ *                    rectangle until a mask is set
+ */
+void sprite_init(sprite_t *s, const uint8_t *image, const uint8_t w,
+    const uint8_t h, const sprite_blend_t blend)
+{
+    s->image = image;
+    s->mask = NULL;
+    s->x = 0;
+    s->y = 0;
+    s->w = w;
+    s->h = h;
+    s->blend = blend;
+    s->visible = false;
+    s->changed = false;
+    s->drawn.x0 = 1;
+    s->drawn.x1 = 0;
+    s->next = NULL;
+}
+
+/*!
+ * \brief Adds a sprite on top of the sprites of a scene
+ */
+void sprite_add(sprite_scene_t *scene, sprite_t *s)
+{
+    sprite_t **p = &scene->sprites;
+
+    while(*p != NULL)
+    {
+        p = &(*p)->next;
+    }
+
+    s->next = NULL;
+    s->changed = true;
+    *p = s;
+}
+
+/*!
+ * \brief Moves a sprite
+ *
+ * \param[in,out] s  Sprite
+ * \param[in]     x  Column of the left edge
+ * \param[in]     y  Row of the top edge
+ */
+void sprite_move(sprite_t *s, const int16_t x, const int16_t y)
+{
+    if((x != s->x) || (y != s->y))
+    {
+        s->x = x;
+        s->y = y;
+        s->changed = true;
+    }
+}
+
+/*!
+ * \brief Replaces the image of a sprite, or marks a changed image
+ *
+ * Also call this after drawing into the current image.
+ *
+ * \param[in,out] s      Sprite
+ * \param[in]     image  Image of w by h pixels, kept by reference
+ * \param[in]     mask   SPRITE_MASK only: opaque pixels, NULL for all
+ * \param[in]     w      Width in pixels
+ * \param[in]     h      Height in pixels
+ */
+void sprite_set_image(sprite_t *s, const uint8_t *image, const uint8_t *mask,
+    const uint8_t w, const uint8_t h)
+{
+    s->image = image;
+    s->mask = mask;
+    s->w = w;
+    s->h = h;
+    s->changed = true;
+}
+
+/*!
+ * \brief Shows or hides a sprite
+ */
+void sprite_show(sprite_t *s, const bool visible)
+{
+    if(s->visible != visible)
+    {
+        s->visible = visible;
+        s->changed = true;
+    }
+}
+
+/*!
+ * \brief Draws a line into an image, with the algorithm of Bresenham
+ *
+ * \param[in,out] image   Image of w by h pixels
+ * \param[in]     w       Width of the image
+ * \param[in]     h       Height of the image
+ * \param[in]     x0, y0  Start point, pixels outside the image are skipped
+ * \param[in]     x1, y1  End point
+ */
+void sprite_image_line(uint8_t *image, const uint8_t w, const uint8_t h,
+    int32_t x0, int32_t y0, const int32_t x1, const int32_t y1)
+{
+    const int32_t dx = abs(x1 - x0);
+    const int32_t dy = -abs(y1 - y0);
+    const int32_t sx = (x0 < x1) ? 1 : -1;
+    const int32_t sy = (y0 < y1) ? 1 : -1;
+    int32_t err = dx + dy;
+
+    for( ;; )
+    {
+        if((x0 >= 0) && (x0 < w) && (y0 >= 0) && (y0 < h))
+        {
+            image[(y0 / 8) * w + x0] |= (uint8_t)(1U << (y0 % 8));
+        }
+
+        if((x0 == x1) && (y0 == y1))
+        {
+            break;
+        }
+
+        const int32_t e2 = 2 * err;
+
+        if(e2 >= dy)
+        {
+            err += dy;
+            x0 += sx;
+        }
+
+        if(e2 <= dx)
+        {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
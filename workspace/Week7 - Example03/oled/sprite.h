@@ -0,0 +1,121 @@
+/*! ***************************************************************************
+ *
+ * \brief     Layered sprite compositor for the SSD1306 framebuffer
+ * \file      sprite.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+/*
+ * A scene is a static background with sprites on top, in the order they
+ * were added. sprite_render() does not redraw the scene every frame. It
+ * only recomposes the rectangles where a sprite was and is now, for the
+ * sprites that moved, were shown or hidden or got a new image. Every byte
+ * of such a rectangle is composed from the background and all sprites that
+ * cover it, so overlapping sprites stay intact. The bytes go through
+ * ssd1306_setbyte(), so only the bytes that really changed are sent to the
+ * display.
+ *
+ * Images are in SSD1306 page order, like the bitmaps of
+ * ssd1306_drawbitmap(): (h + 7) / 8 pages of w bytes, bit 0 is the top row
+ * of a page.
+ *
+ * Render between display_lock() and display_unlock(). Invalidate the scene
+ * after the framebuffer was drawn over by other code.
+ */
+
+/// Bytes of an image of w by h pixels
+#define SPRITE_IMAGE_SIZE(w, h) ((w) * (((h) + 7) / 8))
+
+/// How a sprite is combined with the layers below it
+typedef enum
+{
+    SPRITE_OR,   ///< Pixels set in the image are turned on
+    SPRITE_XOR,  ///< Pixels set in the image invert the pixels below
+    SPRITE_MASK, ///< Pixels set in the mask are replaced by the image
+}
+sprite_blend_t;
+
+/// Screen rectangle, columns x0 to x1 and rows y0 to y1, empty if x0 > x1
+typedef struct
+{
+    int16_t x0, y0;
+    int16_t x1, y1;
+}
+sprite_rect_t;
+
+/// A sprite, change it with the functions below only
+typedef struct sprite
+{
+    const uint8_t *image;   ///< Image of w by h pixels
+    const uint8_t *mask;    ///< SPRITE_MASK only: opaque pixels, in the
+                            ///< format of the image, NULL for all
+    int16_t x, y;           ///< Top left corner, may be off the screen
+    uint8_t w, h;           ///< Size in pixels
+    sprite_blend_t blend;   ///< Blend mode
+    bool visible;           ///< Shown by sprite_render()
+    bool changed;           ///< Changed since the last sprite_render()
+    sprite_rect_t drawn;    ///< Rectangle at the last sprite_render()
+    struct sprite *next;    ///< Next sprite up
+}
+sprite_t;
+
+/// A background layer with sprites on top
+typedef struct
+{
+    const uint8_t *background; ///< SSD1306_SIZE bytes, NULL for blank
+    const ssd1306_rle_t *rle;  ///< Compressed background, used if not NULL
+    sprite_t *sprites;         ///< Lowest sprite first
+    bool full;                 ///< Recompose the whole screen
+}
+sprite_scene_t;
+
+// Function prototypes
+void sprite_scene_init(sprite_scene_t *scene, const uint8_t *background);
+void sprite_set_background(sprite_scene_t *scene, const uint8_t *background);
+void sprite_set_background_rle(sprite_scene_t *scene, const ssd1306_rle_t *rle);
+void sprite_invalidate(sprite_scene_t *scene);
+uint32_t sprite_render(sprite_scene_t *scene, ssd1306_t *oled);
+
+void sprite_init(sprite_t *s, const uint8_t *image, const uint8_t w,
+    const uint8_t h, const sprite_blend_t blend);
+void sprite_add(sprite_scene_t *scene, sprite_t *s);
+void sprite_move(sprite_t *s, const int16_t x, const int16_t y);
+void sprite_set_image(sprite_t *s, const uint8_t *image, const uint8_t *mask,
+    const uint8_t w, const uint8_t h);
+void sprite_show(sprite_t *s, const bool visible);
+
+void sprite_image_line(uint8_t *image, const uint8_t w, const uint8_t h,
+    int32_t x0, int32_t y0, const int32_t x1, const int32_t y1);
+
+#endif // SPRITE_H
@@ -30,52 +30,137 @@
  *
  *****************************************************************************/
 #include "ssd1306.h"
+#include "delay.h"
+#include "fonts_native.h"
+#include "mem.h"
+#include "sections.h"
 
 #include <string.h>
 
-static void delay_us(uint32_t d)
-{
+// Bytes of overhead to send a column range of a single page: address byte
+// + 6 command bytes, address byte + control byte
+#define SSD1306_WINDOW_COST (10)
 
-#if (CLOCK_SETUP != 1)
-#warning This delay function does not work as designed
+/*!
+ * \brief Transport of the commands and data, see ssd1306_transport.h
+ */
+#if (SSD1306_SPI == 1)
+static const ssd1306_transport_t *const transport = &ssd1306_spi1;
+#else
+static const ssd1306_transport_t *const transport = &ssd1306_i2c1;
 #endif
 
-    volatile uint32_t t;
+/*!
+ * \brief Number of times the Oled display was reinitialised after a transfer
+ *        failed, despite the retries and bus recovery of the I2C driver
+ */
+uint32_t ssd1306_reinits = 0;
+
+/*!
+ * \brief Marks a framebuffer byte as dirty
+ *
+ * \param[in]  d     Dirty ranges to update
+ * \param[in]  col   Column
+ * \param[in]  page  Page
+ */
+static inline void ssd1306_mark_dirty(ssd1306_dirty_t *d, const uint8_t col,
+    const uint8_t page)
+{
+    if(col < d->first[page])
+    {
+        d->first[page] = col;
+    }
 
-    for(t=4*d; t>0; t--)
+    if(col > d->last[page])
     {
-        __asm("nop");
-        __asm("nop");
+        d->last[page] = col;
     }
 }
 
 /*!
- * \brief Framebuffer
+ * \brief Marks a byte of the framebuffer as dirty
  *
- * The framebuffer holds all the data. The framebuffer is only written to the
- * Oled display when the function ssd1306_update() is called.
+ * \param[in]  oled  Display
  */
-uint8_t ssd1306_framebuffer[SSD1306_SIZE];
+static inline void ssd1306_mark(ssd1306_t *oled, const uint8_t col, const uint8_t page)
+{
+    ssd1306_mark_dirty(&oled->dirty, col, page);
+}
 
 /*!
- * \brief Pointer to the selected font
+ * \brief Stores a word of the framebuffer, marking the bytes that change
  *
- * The availble fonts are in fonts.h and fonts.c.
+ * The four bytes are in the same page. The dirty range of a page only grows,
+ * so marking the first and the last byte that changes is enough.
  *
- * Note that Monospaced_plain_10 is the default font and should not me removed
- * from fonts.c and/or fonts.h.
+ * \param[in]  oled   Display
+ * \param[in]  w      Index of the word
+ * \param[in]  value  New contents, byte 0 in the lowest bits
+ */
+static void ssd1306_store(ssd1306_t *oled, const uint32_t w, const uint32_t value)
+{
+    uint32_t *fb = (uint32_t *)(void *)oled->fb;
+    const uint32_t diff = fb[w] ^ value;
+
+    if(diff == 0)
+    {
+        return;
+    }
+
+    const uint8_t col = (w * 4) % SSD1306_WIDTH;
+    const uint8_t page = (w * 4) / SSD1306_WIDTH;
+    uint32_t lo = 0;
+    uint32_t hi = 3;
+
+    while((diff & (0xFFUL << (8 * lo))) == 0)
+    {
+        lo++;
+    }
+
+    while((diff & (0xFFUL << (8 * hi))) == 0)
+    {
+        hi--;
+    }
+
+    ssd1306_mark(oled, col + lo, page);
+    ssd1306_mark(oled, col + hi, page);
+
+    fb[w] = value;
+}
+
+/*!
+ * \brief Marks a page as clean
  */
-const char *font = Monospaced_plain_10;
+static void ssd1306_clean(ssd1306_dirty_t *d, const uint8_t page)
+{
+    d->first[page] = 0xFF;
+    d->last[page] = 0;
+}
 
 /*!
- * \brief Local x value
+ * \brief Marks all pages as completely dirty
  */
-uint8_t x = 0;
+static void ssd1306_invalidate_dirty(ssd1306_dirty_t *d)
+{
+    for(uint32_t p=0; p<SSD1306_PAGES; ++p)
+    {
+        d->first[p] = 0;
+        d->last[p] = SSD1306_WIDTH-1;
+    }
+}
 
 /*!
- * \brief Local y value
+ * \brief Marks the complete framebuffer as dirty
+ *
+ * Call this function after writing the framebuffer directly, so the next
+ * ssd1306_update() sends everything.
+ *
+ * \param[in]  oled  Display
  */
-uint8_t y = 0;
+void ssd1306_invalidate(ssd1306_t *oled)
+{
+    ssd1306_invalidate_dirty(&oled->dirty);
+}
 
 /*!
  * \brief List of commands that will be send to the Oled display upon
@@ -109,104 +194,503 @@ const uint8_t ssd1306_init_commands[] =
  * \brief Sends a sequence of initialisation commands to the Oled display
  *
  * Refer to the SSD1306 datasheet for a description of all possible commands
+ *
+ * \param[in]  oled  Display
  */
-void ssd1306_init(void)
+void ssd1306_init(ssd1306_t *oled)
 {
     // Clear the framebuffer
-    for(uint32_t i=0; i<SSD1306_SIZE; ++i)
+    mem_fill32((uint32_t *)(void *)oled->fb, 0, SSD1306_SIZE / 4);
+
+    // The display contents are unknown, so the next update sends everything
+    ssd1306_invalidate(oled);
+
+    // The initialisation commands set the display start line to 0 and the
+    // default orientation, inverse mode and contrast, and turn it on
+    oled->startline = 0;
+    oled->settings.remap = 0xA0;
+    oled->settings.scan = 0xC0;
+    oled->settings.inverse = 0xA6;
+    oled->settings.contrast = 0xFF;
+    oled->settings.power = 0xAF;
+
+    // Queued commands are superseded by the initialisation commands
+    oled->batch.n = 0;
+
+    // Initialize the KL25Z peripheral of the transport
+    transport->init();
+
+    // Initialize the SSD1306
+    transport->write_cmd(oled->address, ssd1306_init_commands,
+                         sizeof(ssd1306_init_commands));
+}
+
+/*!
+ * \brief Reinitialises the Oled display after a failed transfer
+ *
+ * The I2C driver already retried the transfer and recovered the bus, and an
+ * SPI transfer only fails on a DMA error, so the display itself is assumed
+ * to have lost its state. Unlike ssd1306_init() the
+ * framebuffer is kept and the orientation, inverse mode, contrast, start
+ * line and on or off state are restored. Everything is marked dirty, because the contents of the
+ * display are unknown.
+ *
+ * \param[in]   oled  Display
+ * \param[out]  d  Dirty ranges of the framebuffer that was being sent
+ */
+static void ssd1306_reset(ssd1306_t *oled, ssd1306_dirty_t *d)
+{
+    const uint8_t restore[] =
     {
-        ssd1306_framebuffer[i] = 0;
+        oled->settings.remap,
+        oled->settings.scan,
+        oled->settings.inverse,
+        0x81, oled->settings.contrast,
+        0x40 | oled->startline,
+        oled->settings.power,
+    };
+
+    ssd1306_reinits++;
+
+    // Queued commands are superseded by the initialisation commands
+    oled->batch.n = 0;
+
+    transport->init();
+
+    if(transport->write_cmd(oled->address, ssd1306_init_commands,
+                            sizeof(ssd1306_init_commands)))
+    {
+        transport->write_cmd(oled->address, restore, sizeof(restore));
     }
 
-    // Initialize the KL25Z I2C peripheral
-    i2c1_init();
+    ssd1306_invalidate_dirty(&oled->dirty);
+    ssd1306_invalidate_dirty(d);
+}
 
-    // Initialize the SSD1306
-    i2c1_write_cmd(SSD1306_SLAVE_ADDRESS,
-                  ssd1306_init_commands,
-                  sizeof(ssd1306_init_commands));
+/*!
+ * \brief Sends the queued commands to the Oled display
+ *
+ * All queued commands are transferred in a single I2C transfer.
+ *
+ * \param[in]  oled  Display
+ */
+static void ssd1306_batch_flush(ssd1306_t *oled)
+{
+    if(oled->batch.n == 0)
+    {
+        return;
+    }
+
+    const bool ok = transport->write_cmd(oled->address, oled->batch.cmd, oled->batch.n);
+
+    oled->batch.n = 0;
+
+    if(!ok)
+    {
+        // Try to reinitialise the display if writing the commands failed
+        ssd1306_reset(oled, &oled->dirty);
+    }
 }
 
 /*!
- * \brief Sends a command to the Oled display
+ * \brief Sends multiple commands to the Oled display
  *
- * Refer to the SSD1306 datasheet for a description of all possible commands
+ * Outside a batch the commands are sent in a single I2C transfer. Inside a
+ * batch they are queued, see ssd1306_batch_begin().
  *
- * \param[in]  cmd  Command
+ * \param[in]  oled  Display
+ * \param[in]  cmd  Pointer to the array of commands
+ * \param[in]  n    Number of commands, at most SSD1306_BATCH_SIZE
  */
-void ssd1306_command(const uint8_t cmd)
+static void ssd1306_commands(ssd1306_t *oled, const uint8_t cmd[], const uint32_t n)
 {
-    if(!i2c1_write_cmd(SSD1306_SLAVE_ADDRESS, &cmd, 1))
+    if(!oled->batch.active)
     {
-        // Try to reinitialise the display if writing the command failed
-        ssd1306_init();
+        if(!transport->write_cmd(oled->address, cmd, n))
+        {
+            // Try to reinitialise the display if writing the command failed
+            ssd1306_reset(oled, &oled->dirty);
+        }
+
         return;
     }
+
+    // Keep the bytes of a multi-byte command in a single transfer
+    if(oled->batch.n + n > SSD1306_BATCH_SIZE)
+    {
+        ssd1306_batch_flush(oled);
+    }
+
+    memcpy(&oled->batch.cmd[oled->batch.n], cmd, n);
+    oled->batch.n += n;
+}
+
+/*!
+ * \brief Sends a command to the Oled display
+ *
+ * Refer to the SSD1306 datasheet for a description of all possible commands
+ *
+ * Inside a batch the command is queued, see ssd1306_batch_begin().
+ *
+ * \param[in]  oled  Display
+ * \param[in]  cmd  Command
+ */
+void ssd1306_command(ssd1306_t *oled, const uint8_t cmd)
+{
+    ssd1306_commands(oled, &cmd, 1);
+}
+
+/*!
+ * \brief Starts queueing commands
+ *
+ * Until ssd1306_batch_end() or ssd1306_update() is called, ssd1306_command(),
+ * ssd1306_setorientation(), ssd1306_setinverse() and ssd1306_setcontrast()
+ * queue their commands instead of sending them. The queue is sent in a
+ * single I2C transfer, which saves the address byte, control byte and bus
+ * free time of every separate transfer. When the queue is full, it is sent
+ * and queueing continues.
+ *
+ * ssd1306_update() sends the queue in the same transfer as the address window
+ * of the first dirty page and ends the batch.
+ *
+ * Example:
+ * \code
+ * ssd1306_batch_begin(oled);
+ * ssd1306_setcontrast(oled, 0x80);
+ * ssd1306_setinverse(oled, 1);
+ * ssd1306_putstring(oled, 0, 0, "Hello");
+ * ssd1306_update(oled);
+ * \endcode
+ *
+ * \param[in]  oled  Display
+ */
+void ssd1306_batch_begin(ssd1306_t *oled)
+{
+    oled->batch.active = true;
+}
+
+/*!
+ * \brief Sends the queued commands and stops queueing
+ *
+ * \param[in]  oled  Display
+ */
+void ssd1306_batch_end(ssd1306_t *oled)
+{
+    oled->batch.active = false;
+
+    ssd1306_batch_flush(oled);
 }
 
 /*!
  * \brief Sends a data byte to the Oled display
  *
+ * \param[in]  oled  Display
  * \param[in]  data  Data
  */
-void ssd1306_data(const uint8_t data)
+void ssd1306_data(ssd1306_t *oled, const uint8_t data)
 {
-    if(!i2c1_write_data(SSD1306_SLAVE_ADDRESS, &data, 1))
+    if(!transport->write_data(oled->address, &data, 1))
     {
         // Try to reinitialise the display if writing the data failed
-        ssd1306_init();
+        ssd1306_reset(oled, &oled->dirty);
         return;
     }
 }
 
 /*!
- * \brief Sends the framebuffer to the Oled display
+ * \brief Sets the column and page address window of the Oled display
+ *
+ * If \p merge is true, the queued commands of a batch are sent in front of
+ * the window commands in the same transfer and the batch is ended.
+ *
+ * \param[in]  oled   Display
+ * \param[in]  c0     First column
+ * \param[in]  c1     Last column
+ * \param[in]  p0     First page
+ * \param[in]  p1     Last page
+ * \param[in]  merge  Send the queued commands as well
+ *
+ * \return True on successfull communication, false otherwise
+ */
+static bool ssd1306_window(ssd1306_t *oled, const uint8_t c0, const uint8_t c1,
+    const uint8_t p0, const uint8_t p1, const bool merge)
+{
+    const uint8_t data[] =
+    {
+        0x21, c0, c1, // Column Address start and end
+        0x22, p0, p1, // Page address start and end
+    };
+
+    if(!merge)
+    {
+        return transport->write_cmd(oled->address, data, sizeof(data));
+    }
+
+    oled->batch.active = false;
+
+    if(oled->batch.n + sizeof(data) > SSD1306_BATCH_SIZE)
+    {
+        ssd1306_batch_flush(oled);
+    }
+
+    memcpy(&oled->batch.cmd[oled->batch.n], data, sizeof(data));
+
+    const bool ok = transport->write_cmd(oled->address, oled->batch.cmd,
+        oled->batch.n + sizeof(data));
+
+    oled->batch.n = 0;
+
+    return ok;
+}
+
+/*!
+ * \brief Sends the dirty column range of a page of a framebuffer
+ *
+ * \param[in,out] oled   Display
+ * \param[in]     fb     Framebuffer of SSD1306_SIZE bytes
+ * \param[in,out] d      Dirty ranges of \p fb, the page is cleaned when sent
+ * \param[in]     p      Dirty page
+ * \param[in]     merge  Send the queued commands with the window
+ *
+ * \return False if the transfer failed and the display was reinitialised
+ */
+static bool ssd1306_send_page(ssd1306_t *oled, const uint8_t fb[],
+    ssd1306_dirty_t *d, const uint32_t p, const bool merge)
+{
+    if(!ssd1306_window(oled, d->first[p], d->last[p], p, p, merge))
+    {
+        // Try to reinitialise the display if writing the command failed
+        ssd1306_reset(oled, d);
+        return false;
+    }
+
+    delay_us(2);
+
+    if(!transport->write_data(oled->address,
+                              &fb[p * SSD1306_WIDTH + d->first[p]],
+                              d->last[p] - d->first[p] + 1))
+    {
+        // Try to reinitialise the display if writing the data failed
+        ssd1306_reset(oled, d);
+        return false;
+    }
+
+    delay_us(2);
+
+    ssd1306_clean(d, p);
+
+    return true;
+}
+
+/*!
+ * \brief Sends the dirty parts of a framebuffer to the Oled display
  *
- * The column and page addresses are set to the inital position.
- * Then the framebuffer is transferred.
+ * Only the column ranges that changed since the previous update are sent.
+ * For every dirty page the column and page addresses are set to the dirty
+ * range, followed by the data of that range. If that costs more than a full
+ * update, the complete framebuffer is sent instead.
  *
- * The total number of bytes to transfer is equal to:
+ * The total number of bytes to transfer for a full update is equal to:
  * - address byte + 6 command bytes
  * - address byte + (SSD1306_WIDTH * SSD1306_HEIGHT) / 8 data bytes
  *
- * The transmission of a single byte takes 1/375000 * 9 = 24 us
+ * A partial update costs SSD1306_WINDOW_COST bytes plus the number of dirty
+ * columns for every dirty page.
+ *
+ * The transmission of a single byte over I2C takes 1/375000 * 9 = 24 us
  *
  * Example for 128 x 64 display:
  * \n
  * 24 us * 1032 bytes = 24.768 ms is the total theoretical minimum time it takes
  * to send the framebuffer to the Oled display. Measurements show that it
- * actually takes approximately 28 ms.
+ * actually takes approximately 28 ms. Rewriting two digits of a clock touches
+ * a few pages of about 20 columns, which takes roughly 0.7 ms per page.
+ *
+ * While the scheduler is running the transfer is interrupt driven, so the
+ * calling task blocks and the CPU is free for other tasks during this time.
+ * With I2C1_USE_DMA the framebuffer itself is sent by DMA.
+ *
+ * With SSD1306_SPI a byte takes 8 / 6 MHz = 1.33 us at a bus clock of 24 MHz,
+ * there are no address or control bytes, so a full update takes about
+ * 1.4 ms and is sent by DMA as well.
+ *
+ * If the transfer fails, the Oled display is reinitialised and all of \p d is
+ * marked dirty, so the next update restores the complete screen.
  *
- * Notice that this is a non-blocking transfer.
+ * \param[in,out] oled   Display
+ * \param[in]     fb     Framebuffer of SSD1306_SIZE bytes
+ * \param[in,out] d      Dirty ranges of \p fb, cleaned when sent
+ * \param[in]     merge  Send the queued commands with the first window
  */
-void ssd1306_update(void)
+static void ssd1306_send(ssd1306_t *oled, const uint8_t fb[],
+    ssd1306_dirty_t *d, bool merge)
 {
-    uint8_t data[] =
+    uint32_t bytes = 0;
+
+    for(uint32_t p=0; p<SSD1306_PAGES; ++p)
     {
-        0x21, 0x00, 0x7F, // Column Address start and end (DEFAULT)
-        0x22, 0x00, 0x07, // Page address start and end (DEFAULT)
-    };
+        if(d->first[p] <= d->last[p])
+        {
+            bytes += d->last[p] - d->first[p] + 1 + SSD1306_WINDOW_COST;
+        }
+    }
+
+    // Nothing changed
+    if(bytes == 0)
+    {
+        if(merge)
+        {
+            ssd1306_batch_end(oled);
+        }
 
+        return;
+    }
 
-    if(!i2c1_write_cmd(SSD1306_SLAVE_ADDRESS, data, sizeof(data)))
+    if(bytes >= SSD1306_SIZE + SSD1306_WINDOW_COST)
     {
-        // Try to reinitialise the display if writing the command failed
-        ssd1306_init();
+        if(!ssd1306_window(oled, 0x00, SSD1306_WIDTH-1, 0x00, SSD1306_PAGES-1, merge))
+        {
+            // Try to reinitialise the display if writing the command failed
+            ssd1306_reset(oled, d);
+            return;
+        }
+
+        // The display requires an idle time of 1.3 us (see table 13-6 in the
+        // datasheet) between I2C transfers.
+        delay_us(2);
+
+        // Write the framebuffer to the device
+        if(!transport->write_data(oled->address, fb, SSD1306_SIZE))
+        {
+            // Try to reinitialise the display if writing the data failed
+            ssd1306_reset(oled, d);
+            return;
+        }
+
+        for(uint32_t p=0; p<SSD1306_PAGES; ++p)
+        {
+            ssd1306_clean(d, p);
+        }
+
         return;
     }
 
-    // The display requires an idle time of 1.3 us (see table 13-6 in the
-    // datasheet) between I2C transfers.
-    delay_us(2);
+    for(uint32_t p=0; p<SSD1306_PAGES; ++p)
+    {
+        if(d->first[p] > d->last[p])
+        {
+            continue;
+        }
+
+        if(!ssd1306_send_page(oled, fb, d, p, merge))
+        {
+            return;
+        }
+
+        // The queued commands went with the first window
+        merge = false;
+    }
+}
 
-    // Write the framebuffer to the device
-    if(!i2c1_write_data(SSD1306_SLAVE_ADDRESS,
-                   ssd1306_framebuffer,
-                   sizeof(ssd1306_framebuffer)))
+/*!
+ * \brief Sends the dirty parts of a framebuffer to the Oled display
+ *
+ * See ssd1306_send() for details. Queued commands are not sent.
+ *
+ * \param[in,out] oled  Display
+ * \param[in]     fb    Framebuffer of SSD1306_SIZE bytes
+ * \param[in,out] d     Dirty ranges of \p fb, cleaned when sent
+ */
+void ssd1306_update_buffer(ssd1306_t *oled, const uint8_t fb[],
+    ssd1306_dirty_t *d)
+{
+    ssd1306_send(oled, fb, d, false);
+}
+
+/*!
+ * \brief Sends the first dirty page of a framebuffer to the Oled display
+ *
+ * The dirty parts of two displays on one bus are sent a page of each in
+ * turn, so a full update of one display does not hold up a small change
+ * of the other for the 28 ms of a full frame. Costs SSD1306_WINDOW_COST
+ * bytes per page more than ssd1306_update_buffer() for a full update.
+ * Queued commands are not sent.
+ *
+ * \param[in,out] oled  Display
+ * \param[in]     fb    Framebuffer of SSD1306_SIZE bytes
+ * \param[in,out] d     Dirty ranges of \p fb, the page is cleaned when sent
+ *
+ * \return True if dirty pages are left, false when \p fb is sent or the
+ *         transfer failed and all of \p d was marked dirty
+ */
+bool ssd1306_update_page(ssd1306_t *oled, const uint8_t fb[],
+    ssd1306_dirty_t *d)
+{
+    uint32_t p = 0;
+
+    while((p < SSD1306_PAGES) && (d->first[p] > d->last[p]))
     {
-        // Try to reinitialise the display if writing the data failed
-        ssd1306_init();
-        return;
+        p++;
+    }
+
+    if((p == SSD1306_PAGES) || !ssd1306_send_page(oled, fb, d, p, false))
+    {
+        return false;
+    }
+
+    for(p=p+1; p<SSD1306_PAGES; ++p)
+    {
+        if(d->first[p] <= d->last[p])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*!
+ * \brief Sends the dirty parts of the framebuffer to the Oled display
+ *
+ * See ssd1306_send() for details. Commands queued since
+ * ssd1306_batch_begin() are sent in the same transfer as the first address
+ * window and the batch is ended.
+ *
+ * \param[in]  oled  Display
+ */
+void ssd1306_update(ssd1306_t *oled)
+{
+    ssd1306_send(oled, oled->fb, &oled->dirty, true);
+}
+
+/*!
+ * \brief Copies the dirty parts of the framebuffer to another buffer
+ *
+ * Used for double buffering. The dirty ranges of the framebuffer are
+ * merged into \p d and marked clean, so ranges that were not sent yet since
+ * the previous flip are kept. Send \p front with ssd1306_update_buffer().
+ *
+ * \param[in]     oled   Display
+ * \param[out]    front  Buffer of SSD1306_SIZE bytes, word aligned for a
+ *                       copy in words
+ * \param[in,out] d      Dirty ranges of \p front
+ */
+void ssd1306_flip(ssd1306_t *oled, uint8_t front[], ssd1306_dirty_t *d)
+{
+    for(uint32_t p=0; p<SSD1306_PAGES; ++p)
+    {
+        if(oled->dirty.first[p] > oled->dirty.last[p])
+        {
+            continue;
+        }
+
+        const uint32_t i = p * SSD1306_WIDTH + oled->dirty.first[p];
+
+        mem_copy(&front[i], &oled->fb[i], oled->dirty.last[p] - oled->dirty.first[p] + 1);
+
+        ssd1306_mark_dirty(d, oled->dirty.first[p], p);
+        ssd1306_mark_dirty(d, oled->dirty.last[p], p);
+        ssd1306_clean(&oled->dirty, p);
     }
 }
 
@@ -217,11 +701,12 @@ void ssd1306_update(void)
  * This font will be used for writing new characters.
  * Fonts should be located in the files fonts.c and fonts.h.
  *
+ * \param[in]  oled  Display
  * \param[in]  f  A pointer to a font
  */
-void ssd1306_setfont(const char *f)
+void ssd1306_setfont(ssd1306_t *oled, const char *f)
 {
-    font = f;
+    oled->font = f;
 }
 
 /*!
@@ -234,13 +719,11 @@ void ssd1306_setfont(const char *f)
  *
  * If \p orientation > 0: flipped both horizontally and vertically
  *
+ * \param[in]  oled         Display
  * \param[in]  orientation  Display orientation
  */
-void ssd1306_setorientation(const uint8_t orientation)
+void ssd1306_setorientation(ssd1306_t *oled, const uint8_t orientation)
 {
-    // The display requires an idle time before updating the orientiation
-    delay_us(2);
-
     uint8_t data[2];
 
     if(orientation)
@@ -254,12 +737,10 @@ void ssd1306_setorientation(const uint8_t orientation)
         data[1] = 0xC0;
     }
 
-    if(!i2c1_write_cmd(SSD1306_SLAVE_ADDRESS, data, sizeof(data)))
-    {
-        // Try to reinitialise the display if writing the command failed
-        ssd1306_init();
-        return;
-    }
+    oled->settings.remap = data[0];
+    oled->settings.scan = data[1];
+
+    ssd1306_commands(oled, data, sizeof(data));
 }
 
 /*!
@@ -271,13 +752,16 @@ void ssd1306_setorientation(const uint8_t orientation)
  *
  * If \p inv > 0: inverse mode enabled
  *
+ * \param[in]  oled  Display
  * \param[in]  inv  inverse mode
  */
-void ssd1306_setinverse(const uint8_t inv)
+void ssd1306_setinverse(ssd1306_t *oled, const uint8_t inv)
 {
     uint8_t data = (inv) ? 0xA7 : 0xA6;
 
-    ssd1306_command(data);
+    oled->settings.inverse = data;
+
+    ssd1306_command(oled, data);
 }
 
 /*!
@@ -285,10 +769,18 @@ void ssd1306_setinverse(const uint8_t inv)
  *
  * Clears all data in the framebuffer.
  * Call the function ssd1306_update() to actually show the result.
+ *
+ * All bytes that were lit become dirty. For a screen that is redrawn
+ * periodically, overwriting fixed width text is cheaper than clearing first.
+ *
+ * \param[in]  oled  Display
  */
-void ssd1306_clearscreen(void)
+void ssd1306_clearscreen(ssd1306_t *oled)
 {
-    memset(ssd1306_framebuffer, 0x00, sizeof(ssd1306_framebuffer));
+    for(uint32_t w=0; w<SSD1306_SIZE / 4; ++w)
+    {
+        ssd1306_store(oled, w, 0);
+    }
 }
 
 /*!
@@ -296,9 +788,10 @@ void ssd1306_clearscreen(void)
  *
  * This function sets the contrast between 0 and 255
  *
+ * \param[in]  oled      Display
  * \param[in]  contrast  Contrast value
  */
-void ssd1306_setcontrast(const uint8_t contrast)
+void ssd1306_setcontrast(ssd1306_t *oled, const uint8_t contrast)
 {
     uint8_t data[2] =
     {
@@ -307,31 +800,45 @@ void ssd1306_setcontrast(const uint8_t contrast)
 
     data[1] = contrast;
 
-    if(!i2c1_write_cmd(SSD1306_SLAVE_ADDRESS, data, sizeof(data)))
-    {
-        // Try to reinitialise the display if writing the command failed
-        i2c1_init();
-        return;
-    }
+    oled->settings.contrast = contrast;
+
+    ssd1306_commands(oled, data, sizeof(data));
 }
 
 /*!
- * \brief Sets x and y
+ * \brief Turns the display panel on or off
+ *
+ * While off, the panel draws almost no current and the display RAM keeps
+ * its contents, so turning it on shows the last data sent.
+ *
+ * \param[in]  oled  Display
+ * \param[in]  on  True to turn the panel on, false to turn it off
+ */
+void ssd1306_setpower(ssd1306_t *oled, const bool on)
+{
+    oled->settings.power = on ? 0xAF : 0xAE;
+
+    ssd1306_command(oled, oled->settings.power);
+}
+
+/*!
+ * \brief Sets x and y
  *
  * This function updates the current (x,y) value
  *
+ * \param[in]  oled   Display
  * \param[in]  new_x  New value for x
  * \param[in]  new_y  New value for y
  */
-void ssd1306_goto(const uint8_t new_x, const uint8_t new_y)
+void ssd1306_goto(ssd1306_t *oled, const uint8_t new_x, const uint8_t new_y)
 {
 	if((new_x >= SSD1306_WIDTH) || (new_y >= SSD1306_HEIGHT))
     {
 		return;
 	}
 
-    x = new_x;
-    y = new_y;
+    oled->x = new_x;
+    oled->y = new_y;
 }
 
 /*!
@@ -340,20 +847,239 @@ void ssd1306_goto(const uint8_t new_x, const uint8_t new_y)
  * This function sets the value of the pixel at location (x,y).
  * Call the function ssd1306_update() to actually show the result.
  *
+ * \param[in]  oled  Display
  * \param[in]  x    x-value
  * \param[in]  y    y-value
  * \param[in]  val  Pixel value
  */
-void ssd1306_setpixel(const uint8_t x, const uint8_t y, const pixel_value_t val)
+void ssd1306_setpixel(ssd1306_t *oled, const uint8_t x, const uint8_t y, const pixel_value_t val)
 {
+    uint8_t *p = &oled->fb[x + (y / 8) * SSD1306_WIDTH];
+    const uint8_t old = *p;
+
 	if(val == ON)
     {
-		ssd1306_framebuffer[x + (y / 8) * SSD1306_WIDTH] |= 1 << (y % 8);
+		*p |= 1 << (y % 8);
+	}
+    else if(val == INVERT)
+    {
+		*p ^= 1 << (y % 8);
 	}
     else
     {
-		ssd1306_framebuffer[x + (y / 8) * SSD1306_WIDTH] &= ~(1 << (y % 8));
+		*p &= ~(1 << (y % 8));
 	}
+
+    if(*p != old)
+    {
+        ssd1306_mark(oled, x, y / 8);
+    }
+}
+
+/*!
+ * \brief Writes a byte of the framebuffer
+ *
+ * Eight pixels above each other, for code that composes the framebuffer
+ * itself. The byte is only marked dirty if it changes.
+ *
+ * \param[in]  oled   Display
+ * \param[in]  col    Column, 0 to SSD1306_WIDTH-1
+ * \param[in]  page   Page, 0 to SSD1306_PAGES-1
+ * \param[in]  value  New contents, bit 0 is the top row of the page
+ */
+void ssd1306_setbyte(ssd1306_t *oled, const uint8_t col, const uint8_t page, const uint8_t value)
+{
+    uint8_t *p = &oled->fb[col + page * SSD1306_WIDTH];
+
+    if(*p != value)
+    {
+        *p = value;
+        ssd1306_mark(oled, col, page);
+    }
+}
+
+/*!
+ * \brief Saves the framebuffer under an overlay
+ *
+ * Copies the pages that \p box touches, from column \p box->x over
+ * \p box->w columns, into a block of \p pool. Draw the overlay over it next
+ * and put the contents back with ssd1306_restore_under(). Because the
+ * restore only marks the bytes that the overlay changed, showing and
+ * hiding an overlay costs the bus time of its own area, not an update of
+ * the screen underneath.
+ *
+ * The framebuffer must not be drawn under the overlay until it is restored,
+ * or that drawing is lost.
+ *
+ * \param[in]  oled  Display
+ * \param[in]  box   Rectangle of the overlay, clipped to the screen
+ * \param[in]  pool  Pool with blocks of at least w bytes per page
+ * \param[out] save  The saved contents
+ *
+ * \return false if the rectangle is empty, does not fit in a block or the pool
+ *         is empty, nothing is saved then
+ */
+bool ssd1306_save_under(ssd1306_t *oled, const ssd1306_box_t *box, pool_t *pool, ssd1306_save_t *save)
+{
+    save->pages = 0;
+    save->data = NULL;
+
+    if((box->w == 0) || (box->h == 0) || (box->x >= SSD1306_WIDTH) || (box->y >= SSD1306_HEIGHT))
+    {
+        return false;
+    }
+
+    const uint32_t x1 = ((box->x + box->w) > SSD1306_WIDTH) ? SSD1306_WIDTH : (box->x + box->w);
+    const uint32_t y1 = ((box->y + box->h) > SSD1306_HEIGHT) ? SSD1306_HEIGHT : (box->y + box->h);
+
+    save->x = box->x;
+    save->w = (uint8_t)(x1 - box->x);
+    save->page = box->y / 8;
+    save->pages = (uint8_t)(((y1 + 7) / 8) - save->page);
+    save->pool = pool;
+
+    if(((uint32_t)save->w * save->pages) > pool->block_size)
+    {
+        save->pages = 0;
+        return false;
+    }
+
+    save->data = pool_alloc(pool);
+
+    if(save->data == NULL)
+    {
+        save->pages = 0;
+        return false;
+    }
+
+    for(uint32_t p=0; p<save->pages; ++p)
+    {
+        (void)memcpy(&save->data[p * save->w],
+                     &oled->fb[save->x + ((save->page + p) * SSD1306_WIDTH)],
+                     save->w);
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Restores the framebuffer under an overlay and frees the block
+ *
+ * Only the bytes that differ from the saved contents are written and marked
+ * dirty, so the next update only sends the area the overlay changed.
+ *
+ * \param[in]  oled  Display
+ * \param[in]  save  Contents saved by ssd1306_save_under(), nothing is done
+ *                   if that failed
+ */
+void ssd1306_restore_under(ssd1306_t *oled, ssd1306_save_t *save)
+{
+    if((save->pages == 0) || (save->data == NULL))
+    {
+        return;
+    }
+
+    for(uint32_t p=0; p<save->pages; ++p)
+    {
+        for(uint32_t i=0; i<save->w; ++i)
+        {
+            ssd1306_setbyte(oled, save->x + i, save->page + p,
+                            save->data[(p * save->w) + i]);
+        }
+    }
+
+    pool_free(save->pool, save->data);
+
+    save->pages = 0;
+    save->data = NULL;
+}
+
+/*!
+ * \brief Sets, clears or inverts the masked bits of a framebuffer byte
+ *
+ * \param[in]  oled  Display
+ * \param[in]  col   Column
+ * \param[in]  page  Page
+ * \param[in]  mask  Bits to change, bit 0 is the top row of the page
+ * \param[in]  val   Pixel value
+ */
+static inline void ssd1306_apply(ssd1306_t *oled, const uint32_t col, const uint32_t page,
+    const uint8_t mask, const pixel_value_t val)
+{
+    uint8_t *p = &oled->fb[col + page * SSD1306_WIDTH];
+    const uint8_t old = *p;
+
+    if(val == ON)
+    {
+        *p |= mask;
+    }
+    else if(val == INVERT)
+    {
+        *p ^= mask;
+    }
+    else
+    {
+        *p &= ~mask;
+    }
+
+    if(*p != old)
+    {
+        ssd1306_mark(oled, col, page);
+    }
+}
+
+/*!
+ * \brief Writes the masked bits of a byte to a framebuffer byte
+ *
+ * \param[in]  oled  Display
+ * \param[in]  col   Column
+ * \param[in]  page  Page
+ * \param[in]  bits  Pixel values, bit 0 is the top row of the page
+ * \param[in]  mask  Bits to write
+ */
+static inline void ssd1306_write_masked(ssd1306_t *oled, const uint8_t col, const uint8_t page,
+    const uint8_t bits, const uint8_t mask)
+{
+    uint8_t *p = &oled->fb[col + page * SSD1306_WIDTH];
+    const uint8_t val = (*p & ~mask) | (bits & mask);
+
+    if(*p != val)
+    {
+        *p = val;
+        ssd1306_mark(oled, col, page);
+    }
+}
+
+/*!
+ * \brief Writes 8 vertical pixels of a column at once
+ *
+ * If \p row is not page aligned, the byte is split over two pages with two
+ * masked writes. Rows outside the screen are clipped.
+ *
+ * \param[in]  oled  Display
+ * \param[in]  col   Column
+ * \param[in]  row   Row of bit 0
+ * \param[in]  bits  Pixel values, bit 0 is the top row
+ * \param[in]  mask  Bits to write
+ */
+__RAMFUNC static void ssd1306_blit(ssd1306_t *oled, const uint8_t col, const uint32_t row,
+    const uint8_t bits, const uint8_t mask)
+{
+    const uint32_t page = row / 8;
+    const uint32_t shift = row % 8;
+
+    if(page >= SSD1306_PAGES)
+    {
+        return;
+    }
+
+    ssd1306_write_masked(oled, col, page, bits << shift, mask << shift);
+
+    if((shift != 0) && (page + 1 < SSD1306_PAGES))
+    {
+        ssd1306_write_masked(oled, col, page + 1, bits >> (8 - shift),
+            mask >> (8 - shift));
+    }
 }
 
 /*!
@@ -364,24 +1090,25 @@ void ssd1306_setpixel(const uint8_t x, const uint8_t y, const pixel_value_t val)
  * After writing a char to the framebuffer, y is not updated, only x.
  * Call the function ssd1306_update() to actually show the result.
  *
+ * \param[in]  oled  Display
  * \param[in]  c  Character to display
  */
-void ssd1306_putchar(const char c)
+__RAMFUNC void ssd1306_putchar(ssd1306_t *oled, const char c)
 {
     // Get the first four parameters from the font
   //uint8_t font_width = font[0];
-    uint8_t font_height = font[1];
-    uint8_t font_firstchar = font[2];
-    uint8_t font_numchars = font[3];
+    uint8_t font_height = oled->font[1];
+    uint8_t font_firstchar = oled->font[2];
+    uint8_t font_numchars = oled->font[3];
 
     // Calculate the index in the jump table
     uint32_t index = 4 + ((c - font_firstchar) * 4);
 
     // Read the data from the jump table
-    uint8_t offset1 = font[index];
-    uint8_t offset2 = font[index + 1];
-    uint8_t n_bytes = font[index + 2];
-    uint8_t char_width = font[index + 3];
+    uint8_t offset1 = oled->font[index];
+    uint8_t offset2 = oled->font[index + 1];
+    uint8_t n_bytes = oled->font[index + 2];
+    uint8_t char_width = oled->font[index + 3];
 
     // Calculate the index in the data table
     index = 4 + (font_numchars * 4) + (256UL * offset1) + offset2;
@@ -393,61 +1120,41 @@ void ssd1306_putchar(const char c)
         bytes_per_col++;
     }
 
-    // Calculate the total number of bytes for this character
-    uint8_t bytes_total = bytes_per_col * char_width;
-
-    // Temporary variable for y position
-    uint8_t y_tmp = y;
-
-    // Variable counting the character height in pixels
+    // Number of glyph rows that still have to be written in this column
     uint8_t height = 0;
 
-    // Loop all bytes inb a character
-    for(uint32_t n=0; n<bytes_total; n++)
+    // Loop all columns in a character
+    for(uint32_t col=0; col<char_width; col++)
     {
-        // Initially a byte is cleared
-        char data = 0;
+        oled->x++;
 
-        // Is there data available in the character table for this byte?
-        if(n < n_bytes)
+        // Stop if the x value is outside screen boundaries
+        if(oled->x >= SSD1306_WIDTH)
         {
-            data = font[index + n];
+            return;
         }
 
-        // Next column?
-        if((n % bytes_per_col) == 0)
-        {
-            y_tmp=y;
-            x++;
-
-            // Stop if the x value is outside screen boundaries
-            if(x >= SSD1306_WIDTH)
-            {
-                return;
-            }
-
-            height = 0;
-        }
+        height = font_height;
 
-        // Loop all bits in the byte and update the framebuffer
-        for(uint8_t mask = 1; mask != 0; mask <<= 1)
+        // Copy the column byte by byte, each byte holds 8 rows
+        for(uint32_t k=0; k<bytes_per_col; k++)
         {
-            pixel_value_t val = (data & mask) ? ON : OFF;
-            ssd1306_setpixel(x,y_tmp,val);
-            y_tmp++;
+            uint32_t n = col * bytes_per_col + k;
 
-            // Stop if the y value is outside screen boundaries
-            if(y_tmp >= SSD1306_HEIGHT)
-            {
-                break;
-            }
+            // Initially a byte is cleared
+            uint8_t data = 0;
 
-            // Stop if the font height has been reached
-            height++;
-            if(height >= font_height)
+            // Is there data available in the character table for this byte?
+            if(n < n_bytes)
             {
-                break;
+                data = oled->font[index + n];
             }
+
+            // Only the rows within the font height are written
+            uint8_t mask = (height >= 8) ? 0xFF : ((1 << height) - 1);
+            height -= (height >= 8) ? 8 : height;
+
+            ssd1306_blit(oled, oled->x, oled->y + 8 * k, data, mask);
         }
     }
 }
@@ -464,15 +1171,16 @@ void ssd1306_putchar(const char c)
  *
  * A '\r' character is ignored.
  *
+ * \param[in]  oled  Display
  * \param[in]  xs   x-value of the string
  * \param[in]  ys   y-value of the string
  * \param[in]  str  '\0' terminated string
  */
-void ssd1306_putstring(const uint8_t xs, const uint8_t ys, const char *str)
+void ssd1306_putstring(ssd1306_t *oled, const uint8_t xs, const uint8_t ys, const char *str)
 {
     uint8_t delta = 0;
 
-    ssd1306_goto(xs,ys);
+    ssd1306_goto(oled, xs,ys);
 
     uint32_t i=0;
     while(str[i] != '\0')
@@ -482,8 +1190,8 @@ void ssd1306_putstring(const uint8_t xs, const uint8_t ys, const char *str)
             // Go to a new line
             // Set the original x value and increment the y value by the font
             // height
-            delta += font[1];
-            ssd1306_goto(xs,ys+delta);
+            delta += oled->font[1];
+            ssd1306_goto(oled, xs,ys+delta);
         }
         else if(str[i] == '\r')
         {
@@ -491,166 +1199,1040 @@ void ssd1306_putstring(const uint8_t xs, const uint8_t ys, const char *str)
         }
         else
         {
-            ssd1306_putchar(str[i]);
+            ssd1306_putchar(oled, str[i]);
         }
 
         i++;
     }
 }
 
+/// Position in PackBits runs, of a compressed bitmap or a packed glyph
+typedef struct
+{
+    const uint8_t *p;   ///< Next byte of the runs
+    uint32_t left;      ///< Bytes left in the current run
+    bool repeat;        ///< The current run repeats value
+    uint8_t value;      ///< Byte of a repeat run
+}
+ssd1306_rle_reader_t;
+
 /*!
- * \brief Emulates a mini terminal
+ * \brief Returns the next byte of PackBits runs
+ */
+static inline uint8_t ssd1306_rle_next(ssd1306_rle_reader_t *r)
+{
+    if(r->left == 0)
+    {
+        const uint8_t n = *r->p++;
+
+        r->repeat = (n > 128);
+        r->left = r->repeat ? (257U - n) : (n + 1U);
+
+        if(r->repeat)
+        {
+            r->value = *r->p++;
+        }
+    }
+
+    r->left--;
+
+    return r->repeat ? r->value : *r->p++;
+}
+
+/*!
+ * \brief Returns the width of a character in a native font
  *
- * Writes a string of characters into the lowest line of the framebuffer, using
- * the selected font. The function updates the Oled display by calling the
- * function ssd1306_update().
+ * \param[in]  f  Native font
+ * \param[in]  c  Character
+ *
+ * \return Width in columns, 0 if the font doesn't hold the character
+ */
+uint8_t ssd1306_glyphwidth(const font_native_t *f, const char c)
+{
+    const uint8_t uc = (uint8_t)c;
+
+    if((uc < f->first) || ((uc - f->first) >= f->count))
+    {
+        return 0;
+    }
+
+    return f->glyphs[uc - f->first].width;
+}
+
+/*!
+ * \brief Returns the glyph data of a character in a native font
  *
- * A '\n' character scrolls all lines one line up, taking the current selected
- * font height into account and clears the bottom line.
+ * The glyph of a packed font is decoded into the glyph cache, if it is not
+ * in there yet. The data stays valid until FONT_CACHE_ENTRIES other glyphs
+ * of packed fonts were looked up.
  *
- * A '\r' character moves the x position to the beginning of the line. This
- * means that previous written characters will be overwritten.
+ * \param[in]  oled  Display
+ * \param[in]  f  Native font
+ * \param[in]  c  Character, with a width above 0
  *
- * \param[in]  str  '\0' terminated string
+ * \return Pointer to pages * width bytes in the layout of font_native_t
  */
-void ssd1306_terminal(const char *str)
+static const uint8_t *ssd1306_glyphdata(ssd1306_t *oled, const font_native_t *f, const uint8_t c)
 {
-    char offset = font[1];
+    const font_glyph_t *g = &f->glyphs[c - f->first];
 
-    y = SSD1306_HEIGHT-offset-1;
-
-    uint32_t i=0;
-    while(str[i] != '\0')
+#if (FONTS_NATIVE_PACKED_MAX > 0)
+    if(f->packed)
     {
-        if(str[i] == '\n')
+        uint32_t lru = 0;
+
+        oled->glyph_cache_time++;
+
+        for(uint32_t i=0; i<FONT_CACHE_ENTRIES; i++)
         {
-            // Move the previous characters up
-            for(uint32_t yn = offset; yn < SSD1306_HEIGHT; yn++)
+            if((oled->glyph_cache[i].font == f) && (oled->glyph_cache[i].c == c))
             {
-                for(uint32_t xn = 0; xn < SSD1306_WIDTH; xn++)
-                {
-                    pixel_value_t val = OFF;
-                    if(ssd1306_framebuffer[xn + (yn / 8) * SSD1306_WIDTH] & (1 << (yn % 8)))
-                    {
-                        val = ON;
-                    }
-
-                    ssd1306_setpixel(xn, yn-offset, val);
-                }
+                oled->glyph_cache[i].used = oled->glyph_cache_time;
+                return oled->glyph_cache[i].bitmap;
             }
 
-            // Clear bottom
-            for(uint32_t yn = SSD1306_HEIGHT-offset-1; yn < SSD1306_HEIGHT; yn++)
+            if((oled->glyph_cache_time - oled->glyph_cache[i].used) >
+               (oled->glyph_cache_time - oled->glyph_cache[lru].used))
             {
-                for(uint32_t xn = 0; xn < SSD1306_WIDTH; xn++)
-                {
-                    pixel_value_t val = OFF;
-                    ssd1306_setpixel(xn, yn, val);
-                }
+                lru = i;
             }
-
-            ssd1306_goto(0,SSD1306_HEIGHT-offset-1);
-        }
-        else if(str[i] == '\r')
-        {
-            ssd1306_goto(0,SSD1306_HEIGHT-offset-1);
         }
-        else
+
+        ssd1306_rle_reader_t r = {&f->bitmap[g->offset], 0, false, 0};
+        const uint32_t n = (uint32_t)f->pages * g->width;
+
+        for(uint32_t i=0; i<n; i++)
         {
-            ssd1306_putchar(str[i]);
+            oled->glyph_cache[lru].bitmap[i] = ssd1306_rle_next(&r);
         }
 
-        i++;
+        oled->glyph_cache[lru].font = f;
+        oled->glyph_cache[lru].c = c;
+        oled->glyph_cache[lru].used = oled->glyph_cache_time;
+
+        return oled->glyph_cache[lru].bitmap;
     }
+#endif
 
-    ssd1306_update();
+    return &f->bitmap[g->offset];
 }
 
 /*!
- * \brief Draws a line from (x0,y0) tot (x1,y1)
+ * \brief Returns the width of a string in a native font
  *
- * Draws a line in the framebuffer using Bresenham's line algorithm. The
- * implementation is based on the following information:
- * https://csustan.csustan.edu/~tom/Lecture-Notes/Graphics/Bresenham-Line/Bresenham-Line.pdf
+ * \param[in]  f    Native font
+ * \param[in]  str  '\0' terminated string
+ *
+ * \return Width in columns
+ */
+uint32_t ssd1306_stringwidth(const font_native_t *f, const char *str)
+{
+    uint32_t width = 0;
+
+    while(*str != '\0')
+    {
+        width += ssd1306_glyphwidth(f, *str++);
+    }
+
+    return width;
+}
+
+/*!
+ * \brief Displays a character of a native font at the current (x,y) position
  *
+ * Gives the same result as ssd1306_putchar() with the squix version of the
+ * font. If y is page aligned, every full page of the glyph is copied into
+ * the framebuffer at once. Otherwise the glyph bytes are written with
+ * masked writes.
  * Call the function ssd1306_update() to actually show the result.
  *
- * \param[in]  x0  x-value of the start point
- * \param[in]  y0  y-value of the start point
- * \param[in]  x1  x-value of the end point
- * \param[in]  y1  y-value of the end point
+ * \param[in]  oled  Display
+ * \param[in]  f  Native font, see fonts_native.h
+ * \param[in]  c  Character to display
  */
-void ssd1306_drawline(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+void ssd1306_putchar_native(ssd1306_t *oled, const font_native_t *f, const char c)
 {
-    int dx = x1 - x0;
-    int dy = y1 - y0;
+    const uint8_t width = ssd1306_glyphwidth(f, c);
 
-    int stepx, stepy;
+    if(width == 0)
+    {
+        return;
+    }
 
-    if (dy < 0) { dy = -dy; stepy = -1; } else { stepy = 1; }
-    if (dx < 0) { dx = -dx; stepx = -1; } else { stepx = 1; }
+    const uint8_t *glyph = ssd1306_glyphdata(oled, f, (uint8_t)c);
 
-    dy <<= 1;
-    dx <<= 1;
+    // Like ssd1306_putchar(), the first column is drawn at x+1
+    const uint32_t x0 = oled->x + 1;
 
-    if((x0 < SSD1306_WIDTH) && (y0 < SSD1306_HEIGHT))
+    if(x0 >= SSD1306_WIDTH)
     {
-        ssd1306_setpixel(x0, y0, ON);
+        oled->x = SSD1306_WIDTH;
+        return;
     }
 
-    if (dx > dy)
+    // Clip at the right side of the screen
+    const uint32_t cols = (x0 + width > SSD1306_WIDTH) ? (SSD1306_WIDTH - x0) : width;
+
+    uint8_t height = f->height;
+
+    for(uint32_t p=0; p<f->pages; p++)
     {
-        int fraction = dy - (dx >> 1);
+        const uint8_t *src = &glyph[p * width];
+        const uint32_t row = oled->y + 8 * p;
 
-        while (x0 != x1)
+        // Only the rows within the font height are written
+        const uint8_t mask = (height >= 8) ? 0xFF : ((1 << height) - 1);
+        height -= (height >= 8) ? 8 : height;
+
+        if(((row % 8) == 0) && (mask == 0xFF))
         {
-            x0 += stepx;
-            if (fraction >= 0)
-            {
-                y0 += stepy;
-                fraction -= dx;
-            }
+            const uint32_t page = row / 8;
 
-            fraction += dy;
-            if((x0 < SSD1306_WIDTH) && (y0 < SSD1306_HEIGHT))
+            if(page >= SSD1306_PAGES)
             {
-                ssd1306_setpixel(x0, y0, ON);
+                break;
             }
-        }
 
-    }
-    else
-    {
-        int fraction = dx - (dy >> 1);
+            uint8_t *dst = &oled->fb[page * SSD1306_WIDTH + x0];
 
-        while (y0 != y1)
-        {
-            if (fraction >= 0)
+            if(memcmp(dst, src, cols) != 0)
             {
-                x0 += stepx;
-                fraction -= dy;
+                memcpy(dst, src, cols);
+                ssd1306_mark(oled, x0, page);
+                ssd1306_mark(oled, x0 + cols - 1, page);
             }
-            y0 += stepy;
-
-            fraction += dx;
-            if((x0 < SSD1306_WIDTH) && (y0 < SSD1306_HEIGHT))
+        }
+        else
+        {
+            for(uint32_t col=0; col<cols; col++)
             {
-                ssd1306_setpixel(x0, y0, ON);
+                ssd1306_blit(oled, x0 + col, row, src[col], mask);
             }
         }
     }
+
+    oled->x = (oled->x + width >= SSD1306_WIDTH) ? SSD1306_WIDTH : oled->x + width;
 }
 
 /*!
- * \brief Draws a bitmap
+ * \brief Displays a string of characters of a native font starting at
+ *        position (xs,ys)
  *
- * Copies a bitmap to the framebuffer.
- * Call the function ssd1306_update() to actually show the result.
- * Bitmaps should be located in the files bitmaps.c and bitmaps.h.
+ * Behaves like ssd1306_putstring(), using the native font \p f instead of the
+ * selected font.
  *
- * \param[in]  bitmap  A pointer to a bitmap
+ * \param[in]  oled  Display
+ * \param[in]  f    Native font, see fonts_native.h
+ * \param[in]  xs   x-value of the string
+ * \param[in]  ys   y-value of the string
+ * \param[in]  str  '\0' terminated string
  */
-void ssd1306_drawbitmap(const unsigned char *bitmap)
+void ssd1306_putstring_native(ssd1306_t *oled, const font_native_t *f, const uint8_t xs,
+    const uint8_t ys, const char *str)
 {
-    memcpy(ssd1306_framebuffer, bitmap, sizeof(ssd1306_framebuffer));
+    uint8_t delta = 0;
+
+    ssd1306_goto(oled, xs,ys);
+
+    while(*str != '\0')
+    {
+        if(*str == '\n')
+        {
+            // Go to a new line
+            delta += f->height;
+            ssd1306_goto(oled, xs,ys+delta);
+        }
+        else if(*str != '\r')
+        {
+            ssd1306_putchar_native(oled, f, *str);
+        }
+
+        str++;
+    }
+}
+
+/*!
+ * \brief Returns the size of a string in a native font
+ *
+ * The width comes from the glyph width table, one lookup per character, no
+ * pixels are touched. A '\n' starts a new line.
+ *
+ * \param[in]   f       Native font
+ * \param[in]   str     '\0' terminated string
+ * \param[out]  height  Number of lines times the font height, may be NULL
+ *
+ * \return Width of the widest line in columns
+ */
+uint32_t ssd1306_measure(const font_native_t *f, const char *str,
+    uint32_t *height)
+{
+    uint32_t width = 0;
+    uint32_t line = 0;
+    uint32_t lines = 1;
+
+    for( ; *str != '\0'; str++)
+    {
+        if(*str == '\n')
+        {
+            line = 0;
+            lines++;
+        }
+        else
+        {
+            line += ssd1306_glyphwidth(f, *str);
+            width = (line > width) ? line : width;
+        }
+    }
+
+    if(height != NULL)
+    {
+        *height = lines * f->height;
+    }
+
+    return width;
+}
+
+/*!
+ * \brief Renders the rows top to bottom-1 of a line of text in the columns
+ *        x0 to x1-1
+ *
+ * Every pixel of the area is written, the pixels that are not part of a
+ * glyph are cleared. Glyphs left of x0 only cost a lookup of their width.
+ *
+ * \param[in]  oled    Display
+ * \param[in]  f       Native font
+ * \param[in]  str     First character of the line
+ * \param[in]  end     End of the line
+ * \param[in]  left    Column of the first glyph, may be left of x0
+ * \param[in]  x0, x1  Columns of the area
+ * \param[in]  top     Row of the top of the glyphs and the area
+ * \param[in]  bottom  Row below the area
+ */
+static void ssd1306_textline(ssd1306_t *oled, const font_native_t *f, const char *str,
+    const char *end, const int32_t left, const int32_t x0, const int32_t x1,
+    const int32_t top, const int32_t bottom)
+{
+    for(int32_t row=top; row<bottom; row+=8)
+    {
+        const uint32_t p = (uint32_t)(row - top) / 8;
+        const uint8_t mask = ((bottom - row) >= 8) ? 0xFF :
+            (uint8_t)((1U << (bottom - row)) - 1);
+        const char *s = str;
+        const char *looked_up = NULL;
+        const uint8_t *glyph = NULL;
+        int32_t cx = left;
+        int32_t w = (s < end) ? ssd1306_glyphwidth(f, *s) : 0;
+
+        for(int32_t col=x0; col<x1; col++)
+        {
+            uint8_t bits = 0;
+
+            // Skip to the glyph of the column
+            while((s < end) && ((cx + w) <= col))
+            {
+                cx += w;
+                s++;
+                w = (s < end) ? ssd1306_glyphwidth(f, *s) : 0;
+            }
+
+            if((s < end) && (col >= cx) && (p < f->pages))
+            {
+                // Once per glyph, a packed glyph is decoded at most once
+                if(looked_up != s)
+                {
+                    glyph = ssd1306_glyphdata(oled, f, (uint8_t)*s);
+                    looked_up = s;
+                }
+
+                bits = glyph[p * (uint32_t)w + (uint32_t)(col - cx)];
+            }
+
+            ssd1306_blit(oled, (uint8_t)col, (uint32_t)row, bits, mask);
+        }
+    }
+}
+
+/*!
+ * \brief Draws text in a native font aligned in a box
+ *
+ * Every line is aligned on its own, a '\n' starts a new line one font height
+ * lower. The text is clipped to the box and the rest of the box is cleared,
+ * so a shorter text leaves nothing of the previous one. The box is
+ * rendered in a single pass, pixels outside it are never written.
+ * Call the function ssd1306_update() to actually show the result.
+ *
+ * \param[in]  oled   Display
+ * \param[in]  f      Native font, see fonts_native.h
+ * \param[in]  box    Box, clipped to the screen
+ * \param[in]  align  Horizontal alignment of the lines in the box
+ * \param[in]  str    '\0' terminated string
+ */
+void ssd1306_drawtext(ssd1306_t *oled, const font_native_t *f, const ssd1306_box_t *box,
+    const ssd1306_align_t align, const char *str)
+{
+    const int32_t x0 = box->x;
+    const int32_t x1 = ((box->x + box->w) < SSD1306_WIDTH) ?
+        (box->x + box->w) : SSD1306_WIDTH;
+    const int32_t y1 = ((box->y + box->h) < SSD1306_HEIGHT) ?
+        (box->y + box->h) : SSD1306_HEIGHT;
+    int32_t top = box->y;
+
+    while(top < y1)
+    {
+        const char *end = str;
+        int32_t width = 0;
+
+        while((*end != '\0') && (*end != '\n'))
+        {
+            width += ssd1306_glyphwidth(f, *end++);
+        }
+
+        int32_t left = x0;
+
+        if(align == SSD1306_ALIGN_CENTER)
+        {
+            left += (box->w - width) / 2;
+        }
+        else if(align == SSD1306_ALIGN_RIGHT)
+        {
+            left += box->w - width;
+        }
+
+        // The last line also clears the rest of the box
+        int32_t bottom = top + f->height;
+
+        if((*end == '\0') || (bottom > y1))
+        {
+            bottom = y1;
+        }
+
+        ssd1306_textline(oled, f, str, end, left, x0, x1, top, bottom);
+
+        if(*end == '\0')
+        {
+            break;
+        }
+
+        str = end + 1;
+        top = bottom;
+    }
+}
+
+/*!
+ * \brief Returns the terminal line pitch for the selected font
+ *
+ * The smallest of 8, 16, 32 or 64 rows that holds the font height. As the
+ * pitch divides the display height, a terminal line never wraps around the
+ * end of the framebuffer.
+ *
+ * \param[in]  oled  Display
+ */
+static uint32_t ssd1306_terminal_pitch(ssd1306_t *oled)
+{
+    uint32_t pitch = 8;
+
+    while((pitch < (uint8_t)oled->font[1]) && (pitch < SSD1306_HEIGHT))
+    {
+        pitch <<= 1;
+    }
+
+    return pitch;
+}
+
+/*!
+ * \brief Emulates a mini terminal
+ *
+ * Writes a string of characters into the lowest line of the display, using
+ * the selected font. The function updates the Oled display by calling the
+ * function ssd1306_update().
+ *
+ * A '\n' character scrolls all lines one line up and clears the bottom line.
+ * Lines are ssd1306_terminal_pitch() rows apart. The framebuffer is used as a
+ * circular buffer: scrolling only moves the display start line (command
+ * 0x40-0x7F) and clears one line, so a newline costs rendering and sending
+ * one line instead of the complete framebuffer.
+ *
+ * A '\r' character moves the x position to the beginning of the line. This
+ * means that previous written characters will be overwritten.
+ *
+ * As the framebuffer rows are rotated in terminal mode, do not mix
+ * ssd1306_terminal() with other drawing functions. ssd1306_init() resets the
+ * start line.
+ *
+ * \param[in]  oled  Display
+ * \param[in]  str  '\0' terminated string
+ */
+void ssd1306_terminal(ssd1306_t *oled, const char *str)
+{
+    const uint32_t pitch = ssd1306_terminal_pitch(oled);
+
+    // Framebuffer row of the bottom line
+    uint32_t bottom = (SSD1306_HEIGHT - pitch + oled->startline) % SSD1306_HEIGHT;
+
+    oled->y = bottom;
+
+    uint32_t i=0;
+    while(str[i] != '\0')
+    {
+        if(str[i] == '\n')
+        {
+            // The top line becomes the new bottom line
+            oled->startline = (oled->startline + pitch) % SSD1306_HEIGHT;
+            bottom = (bottom + pitch) % SSD1306_HEIGHT;
+
+            ssd1306_fillrect(oled, 0, bottom, SSD1306_WIDTH, pitch, OFF);
+            ssd1306_command(oled, 0x40 | oled->startline);
+
+            ssd1306_goto(oled, 0,bottom);
+        }
+        else if(str[i] == '\r')
+        {
+            ssd1306_goto(oled, 0,bottom);
+        }
+        else
+        {
+            ssd1306_putchar(oled, str[i]);
+        }
+
+        i++;
+    }
+
+    ssd1306_update(oled);
+}
+
+/*!
+ * \brief Draws a line from (x0,y0) tot (x1,y1)
+ *
+ * Draws a line in the framebuffer using Bresenham's line algorithm. The
+ * implementation is based on the following information:
+ * https://csustan.csustan.edu/~tom/Lecture-Notes/Graphics/Bresenham-Line/Bresenham-Line.pdf
+ *
+ * Call the function ssd1306_update() to actually show the result.
+ *
+ * \param[in]  oled  Display
+ * \param[in]  x0  x-value of the start point
+ * \param[in]  y0  y-value of the start point
+ * \param[in]  x1  x-value of the end point
+ * \param[in]  y1  y-value of the end point
+ */
+void ssd1306_drawline(ssd1306_t *oled, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+{
+    // Horizontal and vertical lines write whole bytes
+    if(y0 == y1)
+    {
+        ssd1306_drawhline(oled, x0, x1, y0, ON);
+        return;
+    }
+
+    if(x0 == x1)
+    {
+        ssd1306_drawvline(oled, x0, y0, y1, ON);
+        return;
+    }
+
+    int dx = x1 - x0;
+    int dy = y1 - y0;
+
+    int stepx, stepy;
+
+    if (dy < 0) { dy = -dy; stepy = -1; } else { stepy = 1; }
+    if (dx < 0) { dx = -dx; stepx = -1; } else { stepx = 1; }
+
+    dy <<= 1;
+    dx <<= 1;
+
+    if((x0 < SSD1306_WIDTH) && (y0 < SSD1306_HEIGHT))
+    {
+        ssd1306_setpixel(oled, x0, y0, ON);
+    }
+
+    if (dx > dy)
+    {
+        int fraction = dy - (dx >> 1);
+
+        while (x0 != x1)
+        {
+            x0 += stepx;
+            if (fraction >= 0)
+            {
+                y0 += stepy;
+                fraction -= dx;
+            }
+
+            fraction += dy;
+            if((x0 < SSD1306_WIDTH) && (y0 < SSD1306_HEIGHT))
+            {
+                ssd1306_setpixel(oled, x0, y0, ON);
+            }
+        }
+
+    }
+    else
+    {
+        int fraction = dx - (dy >> 1);
+
+        while (y0 != y1)
+        {
+            if (fraction >= 0)
+            {
+                x0 += stepx;
+                fraction -= dy;
+            }
+            y0 += stepy;
+
+            fraction += dx;
+            if((x0 < SSD1306_WIDTH) && (y0 < SSD1306_HEIGHT))
+            {
+                ssd1306_setpixel(oled, x0, y0, ON);
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Draws a horizontal line from (x0,y) to (x1,y)
+ *
+ * Every column is a single masked byte write. Pixels outside the screen are
+ * clipped.
+ * Call the function ssd1306_update() to actually show the result.
+ *
+ * \param[in]  oled  Display
+ * \param[in]  x0   x-value of the start point
+ * \param[in]  x1   x-value of the end point
+ * \param[in]  y    y-value
+ * \param[in]  val  Pixel value
+ */
+void ssd1306_drawhline(ssd1306_t *oled, int32_t x0, int32_t x1, const int32_t y, const pixel_value_t val)
+{
+    if(x0 > x1)
+    {
+        int32_t t = x0; x0 = x1; x1 = t;
+    }
+
+    if((y < 0) || (y >= SSD1306_HEIGHT) || (x1 < 0) || (x0 >= SSD1306_WIDTH))
+    {
+        return;
+    }
+
+    if(x0 < 0)
+    {
+        x0 = 0;
+    }
+
+    if(x1 >= SSD1306_WIDTH)
+    {
+        x1 = SSD1306_WIDTH-1;
+    }
+
+    const uint8_t mask = 1 << (y % 8);
+
+    for(int32_t col=x0; col<=x1; col++)
+    {
+        ssd1306_apply(oled, col, y / 8, mask, val);
+    }
+}
+
+/*!
+ * \brief Draws a vertical line from (x,y0) to (x,y1)
+ *
+ * Every page the line crosses is a single masked byte write. Pixels outside
+ * the screen are clipped.
+ * Call the function ssd1306_update() to actually show the result.
+ *
+ * \param[in]  oled  Display
+ * \param[in]  x    x-value
+ * \param[in]  y0   y-value of the start point
+ * \param[in]  y1   y-value of the end point
+ * \param[in]  val  Pixel value
+ */
+void ssd1306_drawvline(ssd1306_t *oled, const int32_t x, int32_t y0, int32_t y1, const pixel_value_t val)
+{
+    if(y0 > y1)
+    {
+        int32_t t = y0; y0 = y1; y1 = t;
+    }
+
+    if((x < 0) || (x >= SSD1306_WIDTH) || (y1 < 0) || (y0 >= SSD1306_HEIGHT))
+    {
+        return;
+    }
+
+    if(y0 < 0)
+    {
+        y0 = 0;
+    }
+
+    if(y1 >= SSD1306_HEIGHT)
+    {
+        y1 = SSD1306_HEIGHT-1;
+    }
+
+    for(int32_t page=y0/8; page<=y1/8; page++)
+    {
+        uint8_t mask = 0xFF;
+
+        // Partial first and last page
+        if(page == y0/8)
+        {
+            mask &= 0xFF << (y0 % 8);
+        }
+
+        if(page == y1/8)
+        {
+            mask &= 0xFF >> (7 - (y1 % 8));
+        }
+
+        ssd1306_apply(oled, x, page, mask, val);
+    }
+}
+
+/*!
+ * \brief Draws the outline of a rectangle
+ *
+ * The top-left corner is (x,y). No pixel is written twice, so INVERT gives
+ * a closed outline.
+ * Call the function ssd1306_update() to actually show the result.
+ *
+ * \param[in]  oled  Display
+ * \param[in]  x    x-value of the top-left corner
+ * \param[in]  y    y-value of the top-left corner
+ * \param[in]  w    Width
+ * \param[in]  h    Height
+ * \param[in]  val  Pixel value
+ */
+void ssd1306_drawrect(ssd1306_t *oled, const int32_t x, const int32_t y, const int32_t w, const int32_t h, const pixel_value_t val)
+{
+    if((w <= 0) || (h <= 0))
+    {
+        return;
+    }
+
+    ssd1306_drawhline(oled, x, x+w-1, y, val);
+
+    if(h > 1)
+    {
+        ssd1306_drawhline(oled, x, x+w-1, y+h-1, val);
+    }
+
+    if(h > 2)
+    {
+        ssd1306_drawvline(oled, x, y+1, y+h-2, val);
+
+        if(w > 1)
+        {
+            ssd1306_drawvline(oled, x+w-1, y+1, y+h-2, val);
+        }
+    }
+}
+
+/*!
+ * \brief Fills a rectangle
+ *
+ * The top-left corner is (x,y). Each column of each page is a single masked
+ * byte write.
+ * Call the function ssd1306_update() to actually show the result.
+ *
+ * \param[in]  oled  Display
+ * \param[in]  x    x-value of the top-left corner
+ * \param[in]  y    y-value of the top-left corner
+ * \param[in]  w    Width
+ * \param[in]  h    Height
+ * \param[in]  val  Pixel value, INVERT inverts the area
+ */
+void ssd1306_fillrect(ssd1306_t *oled, const int32_t x, const int32_t y, const int32_t w, const int32_t h, const pixel_value_t val)
+{
+    for(int32_t col=x; col<x+w; col++)
+    {
+        ssd1306_drawvline(oled, col, y, y+h-1, val);
+    }
+}
+
+/*!
+ * \brief Writes the points of a circle that are symmetric to (x,y)
+ *
+ * Points that coincide are written once.
+ *
+ * \param[in]  oled  Display
+ */
+static void ssd1306_circlepoints(ssd1306_t *oled, const int32_t x0, const int32_t y0,
+    const int32_t x, const int32_t y, const pixel_value_t val)
+{
+    const int32_t px[8] = {x, -x, x, -x, y, -y, y, -y};
+    const int32_t py[8] = {y, y, -y, -y, x, x, -x, -x};
+
+    for(uint32_t i=0; i<8; i++)
+    {
+        // Skip mirrored points that fall on the axes or on the diagonal
+        if(((x == 0) && ((i == 1) || (i == 3) || (i == 6) || (i == 7))) ||
+           ((x == y) && (i >= 4)) || ((y == 0) && (i == 2)))
+        {
+            continue;
+        }
+
+        const int32_t cx = x0 + px[i];
+        const int32_t cy = y0 + py[i];
+
+        if((cx >= 0) && (cx < SSD1306_WIDTH) && (cy >= 0) && (cy < SSD1306_HEIGHT))
+        {
+            ssd1306_setpixel(oled, cx, cy, val);
+        }
+    }
+}
+
+/*!
+ * \brief Draws the outline of a circle
+ *
+ * Uses the midpoint circle algorithm, so only additions and shifts are
+ * needed. Pixels outside the screen are clipped.
+ * Call the function ssd1306_update() to actually show the result.
+ *
+ * \param[in]  oled  Display
+ * \param[in]  x0   x-value of the center
+ * \param[in]  y0   y-value of the center
+ * \param[in]  r    Radius
+ * \param[in]  val  Pixel value
+ */
+void ssd1306_drawcircle(ssd1306_t *oled, const int32_t x0, const int32_t y0, const int32_t r, const pixel_value_t val)
+{
+    int32_t x = 0;
+    int32_t y = r;
+    int32_t d = 1 - r;
+
+    if(r < 0)
+    {
+        return;
+    }
+
+    while(x <= y)
+    {
+        ssd1306_circlepoints(oled, x0, y0, x, y, val);
+
+        x++;
+
+        if(d < 0)
+        {
+            d += 2 * x + 1;
+        }
+        else
+        {
+            y--;
+            d += 2 * (x - y) + 1;
+        }
+    }
+}
+
+/*!
+ * \brief Fills a circle
+ *
+ * Every column of the circle is drawn once as a vertical line, so INVERT
+ * inverts the area.
+ * Call the function ssd1306_update() to actually show the result.
+ *
+ * \param[in]  oled  Display
+ * \param[in]  x0   x-value of the center
+ * \param[in]  y0   y-value of the center
+ * \param[in]  r    Radius
+ * \param[in]  val  Pixel value
+ */
+void ssd1306_fillcircle(ssd1306_t *oled, const int32_t x0, const int32_t y0, const int32_t r, const pixel_value_t val)
+{
+    int32_t h = r;
+
+    if(r < 0)
+    {
+        return;
+    }
+
+    ssd1306_drawvline(oled, x0, y0-r, y0+r, val);
+
+    for(int32_t dx=1; dx<=r; dx++)
+    {
+        // Largest h for which (dx,h) is inside the circle
+        while((h > 0) && ((dx * dx) + (h * h) > (r * r)))
+        {
+            h--;
+        }
+
+        ssd1306_drawvline(oled, x0+dx, y0-h, y0+h, val);
+        ssd1306_drawvline(oled, x0-dx, y0-h, y0+h, val);
+    }
+}
+
+/*!
+ * \brief Sine of the first quarter in steps of 6 degrees, Q15
+ *
+ * The other quarters follow from symmetry, so 16 entries cover all
+ * SSD1306_ANGLE_STEPS angles.
+ */
+static const uint16_t sin_quarter[(SSD1306_ANGLE_STEPS / 4) + 1] =
+{
+        0,  3425,  6813, 10126, 13328, 16383, 19260, 21925,
+    24351, 26509, 28377, 29934, 31163, 32051, 32587, 32767,
+};
+
+/*!
+ * \brief Returns the sine of an angle in steps of 6 degrees
+ *
+ * Reads the table instead of calling sinf(), which is done in software on
+ * the Cortex-M0+. A clock hand at \p step seconds or minutes then ends at
+ * x0 + ((len * ssd1306_sin(step)) >> 15), y0 - ((len * ssd1306_cos(step)) >> 15).
+ *
+ * \param[in]  step  Angle in steps of 360/SSD1306_ANGLE_STEPS degrees
+ *
+ * \return The sine in Q15, from -32767 to 32767
+ */
+int32_t ssd1306_sin(const uint32_t step)
+{
+    const uint32_t quarter = SSD1306_ANGLE_STEPS / 4;
+    const uint32_t s = step % SSD1306_ANGLE_STEPS;
+    const uint32_t i = s % quarter;
+
+    switch(s / quarter)
+    {
+    case 0:
+        return sin_quarter[i];
+    case 1:
+        return sin_quarter[quarter - i];
+    case 2:
+        return -(int32_t)sin_quarter[i];
+    default:
+        return -(int32_t)sin_quarter[quarter - i];
+    }
+}
+
+/*!
+ * \brief Returns the cosine of an angle in steps of 6 degrees
+ *
+ * \see ssd1306_sin()
+ *
+ * \param[in]  step  Angle in steps of 360/SSD1306_ANGLE_STEPS degrees
+ *
+ * \return The cosine in Q15, from -32767 to 32767
+ */
+int32_t ssd1306_cos(const uint32_t step)
+{
+    return ssd1306_sin((step % SSD1306_ANGLE_STEPS) + (SSD1306_ANGLE_STEPS / 4));
+}
+
+/*!
+ * \brief Draws a bitmap
+ *
+ * Copies a bitmap to the framebuffer.
+ * Call the function ssd1306_update() to actually show the result.
+ * Bitmaps should be located in the files bitmaps.c and bitmaps.h. A word
+ * aligned bitmap is compared and copied in words.
+ *
+ * \param[in]  oled    Display
+ * \param[in]  bitmap  A pointer to a bitmap
+ */
+void ssd1306_drawbitmap(ssd1306_t *oled, const unsigned char *bitmap)
+{
+    if(((uintptr_t)bitmap & 3) == 0)
+    {
+        const uint32_t *src = (const uint32_t *)(const void *)bitmap;
+
+        for(uint32_t w=0; w<SSD1306_SIZE / 4; ++w)
+        {
+            ssd1306_store(oled, w, src[w]);
+        }
+
+        return;
+    }
+
+    // Copy byte by byte, so only the bytes that change are marked dirty
+    for(uint32_t p=0; p<SSD1306_PAGES; ++p)
+    {
+        for(uint32_t c=0; c<SSD1306_WIDTH; ++c)
+        {
+            const uint32_t i = p * SSD1306_WIDTH + c;
+            if(oled->fb[i] != bitmap[i])
+            {
+                oled->fb[i] = bitmap[i];
+                ssd1306_mark(oled, c, p);
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Decodes a part of a page of a compressed bitmap
+ *
+ * Only the runs of the page are read, columns and pages outside the bitmap
+ * are off.
+ *
+ * \param[in]  rle   Compressed bitmap, see bitmaps.h
+ * \param[in]  page  Page of the bitmap
+ * \param[in]  x0    First column
+ * \param[in]  n     Number of columns
+ * \param[out] buf   n bytes in the format of the framebuffer
+ */
+void ssd1306_rle_span(const ssd1306_rle_t *rle, const uint32_t page,
+    const uint32_t x0, const uint32_t n, uint8_t *buf)
+{
+    uint32_t i = 0;
+
+    if(page < rle->pages)
+    {
+        ssd1306_rle_reader_t r = {&rle->data[rle->offset[page]], 0, false, 0};
+
+        for(uint32_t c=0; (c < rle->width) && (i < n); c++)
+        {
+            const uint8_t v = ssd1306_rle_next(&r);
+
+            if(c >= x0)
+            {
+                buf[i++] = v;
+            }
+        }
+    }
+
+    for(; i<n; i++)
+    {
+        buf[i] = 0;
+    }
+}
+
+/*!
+ * \brief Draws a compressed bitmap
+ *
+ * Decodes the bitmap straight into the framebuffer, at a page aligned
+ * position and clipped to the screen. Only the bytes that change are marked
+ * dirty, so a bitmap smaller than the screen only updates its own region.
+ * Call the function ssd1306_update() to actually show the result.
+ *
+ * \param[in]  oled  Display
+ * \param[in]  rle   Compressed bitmap, see bitmaps.h
+ * \param[in]  x     Column of the left of the bitmap, may be off screen
+ * \param[in]  page  Page of the top of the bitmap, may be off screen
+ */
+void ssd1306_drawrle(ssd1306_t *oled, const ssd1306_rle_t *rle, const int32_t x,
+    const int32_t page)
+{
+    for(uint32_t p=0; p<rle->pages; p++)
+    {
+        const int32_t dst = page + (int32_t)p;
+
+        if((dst < 0) || (dst >= SSD1306_PAGES))
+        {
+            continue;
+        }
+
+        ssd1306_rle_reader_t r = {&rle->data[rle->offset[p]], 0, false, 0};
+
+        for(uint32_t c=0; c<rle->width; c++)
+        {
+            const uint8_t v = ssd1306_rle_next(&r);
+            const int32_t col = x + (int32_t)c;
+
+            if(col >= SSD1306_WIDTH)
+            {
+                break;
+            }
+
+            if(col >= 0)
+            {
+                ssd1306_setbyte(oled, (uint8_t)col, (uint8_t)dst, v);
+            }
+        }
+    }
 }
@@ -32,9 +32,11 @@
 #ifndef SSD1306_H
 #define SSD1306_H
 
-#include "i2c1.h"
+#include "ssd1306_transport.h"
 #include "fonts.h"
+#include "fonts_native.h"
 #include "bitmaps.h"
+#include "pool.h"
 
 /// \name Definitions for SSD1306
 /// \{
@@ -44,51 +46,216 @@
  */
 #define SSD1306_SA0           (0)
 
+/*!
+ * \brief Definition for the slave address of a display with SA0 at \p sa0,
+ * 0x78 or 0x7A, so two displays can share I2C1
+ */
+#define SSD1306_ADDRESS(sa0)  (0x78 | ((sa0) << 1))
+
 /*!
  * \brief Definition for the display dimensions
  */
 #define SSD1306_WIDTH         (128)
 #define SSD1306_HEIGHT        (64)
 #define SSD1306_SIZE          (SSD1306_WIDTH * SSD1306_HEIGHT / 8)
+#define SSD1306_PAGES         (SSD1306_HEIGHT / 8)
 
 /*!
  * \brief Definition for the slave address
  */
-#define SSD1306_SLAVE_ADDRESS (0x78 | SSD1306_SA0)
+#define SSD1306_SLAVE_ADDRESS SSD1306_ADDRESS(SSD1306_SA0)
+
+/*!
+ * \brief Maximum number of queued commands between ssd1306_batch_begin() and
+ * ssd1306_batch_end()
+ */
+#define SSD1306_BATCH_SIZE    (32)
+
+/*!
+ * \brief Number of angles of ssd1306_sin() and ssd1306_cos() in a full turn,
+ * the seconds or minutes of a clock
+ */
+#define SSD1306_ANGLE_STEPS   (60)
 
 /// \}
 
 /// Value for a pixel
 typedef enum
 {
-    ON,  ///< Pixel is on
-    OFF, ///< Pixel is off
+    ON,     ///< Pixel is on
+    OFF,    ///< Pixel is off
+    INVERT, ///< Pixel is inverted
 }
 pixel_value_t;
 
-extern uint8_t ssd1306_framebuffer[SSD1306_SIZE];
+/// Horizontal alignment of text in a box, see ssd1306_drawtext()
+typedef enum
+{
+    SSD1306_ALIGN_LEFT,   ///< Left edge of the text at the left of the box
+    SSD1306_ALIGN_CENTER, ///< Text centred in the box
+    SSD1306_ALIGN_RIGHT,  ///< Right edge of the text at the right of the box
+}
+ssd1306_align_t;
+
+/// Rectangle of the screen, w columns from x and h rows from y
+typedef struct
+{
+    uint8_t x; ///< Left column
+    uint8_t y; ///< Top row
+    uint8_t w; ///< Width in columns
+    uint8_t h; ///< Height in rows
+}
+ssd1306_box_t;
+
+/// Dirty column range per page of a framebuffer
+///
+/// Columns first[p] up to and including last[p] of page p differ from what
+/// was last sent to the Oled display. A page is clean when first[p] > last[p].
+typedef struct
+{
+    uint8_t first[SSD1306_PAGES]; ///< First dirty column
+    uint8_t last[SSD1306_PAGES];  ///< Last dirty column
+}
+ssd1306_dirty_t;
+
+/// Framebuffer contents under an overlay, see ssd1306_save_under()
+///
+/// The saved rectangle spans whole pages, w bytes of each of the pages from
+/// page on, in a block of the pool.
+typedef struct
+{
+    uint8_t x;      ///< Left column
+    uint8_t page;   ///< Top page
+    uint8_t w;      ///< Width in columns
+    uint8_t pages;  ///< Height in pages, 0 if nothing is saved
+    pool_t *pool;   ///< Pool of the block
+    uint8_t *data;  ///< The saved bytes, page by page
+}
+ssd1306_save_t;
+
+/// A display and the framebuffer that is drawn into
+///
+/// Every display has its own framebuffer, dirty ranges, font, cursor and
+/// command queue, so the displays at 0x78 and 0x7A are drawn independently.
+/// Declare it with SSD1306_DISPLAY_INIT(). The members are private to the
+/// driver.
+typedef struct
+{
+    uint8_t *fb;            ///< Framebuffer of SSD1306_SIZE bytes, word aligned
+    ssd1306_dirty_t dirty;  ///< Dirty column ranges of fb
+    uint8_t address;        ///< I2C address, see SSD1306_ADDRESS()
+    const char *font;       ///< Font of ssd1306_putchar(), see fonts.h
+    uint8_t x;              ///< Cursor of ssd1306_putchar()
+    uint8_t y;
+    uint8_t startline;      ///< Row shown at the top in terminal mode
+
+    /// Display settings that differ from the initialisation commands,
+    /// restored after a failed transfer
+    struct
+    {
+        uint8_t remap;
+        uint8_t scan;
+        uint8_t inverse;
+        uint8_t contrast;
+        uint8_t power;
+    }settings;
+
+    /// Commands queued between ssd1306_batch_begin() and ssd1306_batch_end()
+    struct
+    {
+        bool active;
+        uint32_t n;
+        uint8_t cmd[SSD1306_BATCH_SIZE];
+    }batch;
+
+#if (FONTS_NATIVE_PACKED_MAX > 0)
+    /// Decoded glyphs of packed native fonts, the least recently used one
+    /// is replaced. Per display, so renderers of two displays do not evict
+    /// each other's glyphs.
+    struct
+    {
+        const font_native_t *font;
+        uint8_t c;
+        uint32_t used;
+        uint8_t bitmap[FONTS_NATIVE_PACKED_MAX];
+    }glyph_cache[FONT_CACHE_ENTRIES];
+
+    uint32_t glyph_cache_time;
+#endif
+}
+ssd1306_t;
+
+/*!
+ * \brief Initialiser of an ssd1306_t with its framebuffer and address
+ *
+ * Example:
+ * \code
+ * static __attribute__((aligned(4))) uint8_t fb[SSD1306_SIZE];
+ * static ssd1306_t oled = SSD1306_DISPLAY_INIT(fb, SSD1306_ADDRESS(1));
+ * \endcode
+ */
+#define SSD1306_DISPLAY_INIT(buffer, addr)                                  \
+{                                                                           \
+    .fb = (buffer),                                                         \
+    .address = (addr),                                                      \
+    .font = Monospaced_plain_10,                                            \
+    .settings = {.remap = 0xA0, .scan = 0xC0, .inverse = 0xA6,              \
+                 .contrast = 0xFF, .power = 0xAF},                          \
+}
+
+extern uint32_t ssd1306_reinits;
 
 // Funtion prototypes
-void ssd1306_init(void);
-void ssd1306_command(const uint8_t cmd);
-void ssd1306_data(const uint8_t data);
-void ssd1306_update(void);
+void ssd1306_init(ssd1306_t *oled);
+void ssd1306_command(ssd1306_t *oled, const uint8_t cmd);
+void ssd1306_batch_begin(ssd1306_t *oled);
+void ssd1306_batch_end(ssd1306_t *oled);
+void ssd1306_data(ssd1306_t *oled, const uint8_t data);
+void ssd1306_update(ssd1306_t *oled);
+void ssd1306_invalidate(ssd1306_t *oled);
+void ssd1306_update_buffer(ssd1306_t *oled, const uint8_t fb[], ssd1306_dirty_t *d);
+bool ssd1306_update_page(ssd1306_t *oled, const uint8_t fb[], ssd1306_dirty_t *d);
+void ssd1306_flip(ssd1306_t *oled, uint8_t front[], ssd1306_dirty_t *d);
+
+void ssd1306_setfont(ssd1306_t *oled, const char *f);
+void ssd1306_setorientation(ssd1306_t *oled, const uint8_t orientation);
+void ssd1306_setinverse(ssd1306_t *oled, const uint8_t inv);
 
-void ssd1306_setfont(const char *f);
-void ssd1306_setorientation(const uint8_t orientation);
-void ssd1306_setinverse(const uint8_t inv);
+void ssd1306_clearscreen(ssd1306_t *oled);
+void ssd1306_setcontrast(ssd1306_t *oled, const uint8_t contrast);
+void ssd1306_setpower(ssd1306_t *oled, const bool on);
+void ssd1306_goto(ssd1306_t *oled, const uint8_t new_x, const uint8_t new_y);
+void ssd1306_setpixel(ssd1306_t *oled, const uint8_t x, const uint8_t y, const pixel_value_t val);
+void ssd1306_setbyte(ssd1306_t *oled, const uint8_t col, const uint8_t page, const uint8_t value);
+bool ssd1306_save_under(ssd1306_t *oled, const ssd1306_box_t *box, pool_t *pool, ssd1306_save_t *save);
+void ssd1306_restore_under(ssd1306_t *oled, ssd1306_save_t *save);
 
-void ssd1306_clearscreen(void);
-void ssd1306_setcontrast(const uint8_t contrast);
-void ssd1306_goto(const uint8_t new_x, const uint8_t new_y);
-void ssd1306_setpixel(const uint8_t x, const uint8_t y, const pixel_value_t val);
+void ssd1306_putchar(ssd1306_t *oled, const char c);
+void ssd1306_putstring(ssd1306_t *oled, const uint8_t xs, const uint8_t ys, const char *str);
 
-void ssd1306_putchar(const char c);
-void ssd1306_putstring(const uint8_t xs, const uint8_t ys, const char *str);
+uint8_t ssd1306_glyphwidth(const font_native_t *f, const char c);
+uint32_t ssd1306_stringwidth(const font_native_t *f, const char *str);
+void ssd1306_putchar_native(ssd1306_t *oled, const font_native_t *f, const char c);
+void ssd1306_putstring_native(ssd1306_t *oled, const font_native_t *f,
+    const uint8_t xs, const uint8_t ys, const char *str);
+uint32_t ssd1306_measure(const font_native_t *f, const char *str,
+    uint32_t *height);
+void ssd1306_drawtext(ssd1306_t *oled, const font_native_t *f,
+    const ssd1306_box_t *box, const ssd1306_align_t align, const char *str);
 
-void ssd1306_drawline(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
-void ssd1306_drawbitmap(const unsigned char *bitmap);
+void ssd1306_drawline(ssd1306_t *oled, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+void ssd1306_drawhline(ssd1306_t *oled, int32_t x0, int32_t x1, const int32_t y, const pixel_value_t val);
+void ssd1306_drawvline(ssd1306_t *oled, const int32_t x, int32_t y0, int32_t y1, const pixel_value_t val);
+void ssd1306_drawrect(ssd1306_t *oled, const int32_t x, const int32_t y, const int32_t w, const int32_t h, const pixel_value_t val);
+void ssd1306_fillrect(ssd1306_t *oled, const int32_t x, const int32_t y, const int32_t w, const int32_t h, const pixel_value_t val);
+void ssd1306_drawcircle(ssd1306_t *oled, const int32_t x0, const int32_t y0, const int32_t r, const pixel_value_t val);
+void ssd1306_fillcircle(ssd1306_t *oled, const int32_t x0, const int32_t y0, const int32_t r, const pixel_value_t val);
+int32_t ssd1306_sin(const uint32_t step);
+int32_t ssd1306_cos(const uint32_t step);
+void ssd1306_drawbitmap(ssd1306_t *oled, const unsigned char *bitmap);
+void ssd1306_drawrle(ssd1306_t *oled, const ssd1306_rle_t *rle, const int32_t x, const int32_t page);
+void ssd1306_rle_span(const ssd1306_rle_t *rle, const uint32_t page, const uint32_t x0, const uint32_t n, uint8_t *buf);
 
-void ssd1306_terminal(const char *str);
+void ssd1306_terminal(ssd1306_t *oled, const char *str);
 
 #endif // SSD1306_H
@@ -0,0 +1,70 @@
+/*! ***************************************************************************
+ *
+ * \brief     Transport interface of the SSD1306 Oled display
+ * \file      ssd1306_transport.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef SSD1306_TRANSPORT_H
+#define SSD1306_TRANSPORT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// \name Definitions for the transport
+/// \{
+
+/*!
+ * \brief Set to 1 for an SSD1306 module with the 4-wire SPI interface on
+ *        SPI1, see spi1.h, instead of I2C1
+ */
+#ifndef SSD1306_SPI
+#define SSD1306_SPI (0)
+#endif
+
+/// \}
+
+/// Transport of the commands and the display data to the Oled display
+///
+/// The functions return after the bytes were sent, or failed to be sent.
+/// A failed transfer makes the SSD1306 driver reinitialise the display with
+/// init() and the initialisation commands. The address selects one of the
+/// displays on an I2C bus.
+typedef struct
+{
+    void (*init)(void); ///< Initialises the peripheral and the display interface
+    bool (*write_cmd)(const uint8_t address, const uint8_t cmd[], const uint32_t n);   ///< Sends commands
+    bool (*write_data)(const uint8_t address, const uint8_t data[], const uint32_t n); ///< Sends display data
+}
+ssd1306_transport_t;
+
+/// I2C1, a display at 0x78 and one at 0x7A, see i2c1.c
+extern const ssd1306_transport_t ssd1306_i2c1;
+
+/// SPI1 with D/C# and CS# on GPIO pins, a single display, see spi1.c
+extern const ssd1306_transport_t ssd1306_spi1;
+
+#endif // SSD1306_TRANSPORT_H
@@ -0,0 +1,415 @@
+/*! ***************************************************************************
+ *
+ * \brief     Overload protection with graceful degradation
+ * \file      overload.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#define LOG_MODULE  OVERLOAD
+#define LOG_TAG     "Overload: "
+
+#include "overload.h"
+#include "display.h"
+#include "loadmeter.h"
+#include "log.h"
+#include "mono.h"
+#include "periodic.h"
+#include "serial.h"
+#include "telemetry.h"
+#include "xprintf.h"
+
+#if (OVERLOAD_LOW_PERMILLE > OVERLOAD_HIGH_PERMILLE) || \
+    (OVERLOAD_HIGH_PERMILLE > OVERLOAD_SEVERE_PERMILLE)
+#error "OVERLOAD_LOW_PERMILLE to OVERLOAD_SEVERE_PERMILLE must not decrease"
+#endif
+
+// Stack size in words of the overload task
+#define OVERLOAD_STACK_DEPTH (configMINIMAL_STACK_SIZE + 32)
+
+// Time a line of the report may wait for room in the serial transmit buffer
+#define OVERLOAD_BLOCK_TIME  pdMS_TO_TICKS(100)
+
+// Longest line written to the serial port, including the terminator
+#define OVERLOAD_LINE_LEN    (64)
+
+// Degradation step of every criticality at every level
+static const uint8_t steps[OVERLOAD_LEVELS][OVERLOAD_CLASSES] =
+{
+    {0, 0, 0},
+    {0, 0, 1},
+    {0, 1, 2},
+};
+
+static const char *const level_names[OVERLOAD_LEVELS] = {"none", "high", "severe"};
+static const char *const class_names[OVERLOAD_CLASSES] =
+    {"critical", "important", "optional"};
+
+static const uint16_t display_ms[OVERLOAD_LEVELS] = OVERLOAD_DISPLAY_MS;
+static const uint8_t log_levels[OVERLOAD_LEVELS] = OVERLOAD_LOG_LEVELS;
+static const uint16_t tlm_decimation[OVERLOAD_LEVELS] = OVERLOAD_TLM_DECIMATION;
+
+// Registered clients, the newest first
+static overload_client_t *clients = NULL;
+
+// Written by the overload task, read with interrupts masked
+static overload_stats_t stats = {.level = OVERLOAD_NONE};
+static uint32_t level_start_ms = 0;
+
+static StaticTask_t overload_tcb;
+static StackType_t overload_stack[OVERLOAD_STACK_DEPTH];
+
+/*!
+ * \brief Returns the deadline misses of all periodic tasks together
+ */
+static uint32_t overload_misses(void)
+{
+    periodic_t p;
+    uint32_t i = 0;
+    uint32_t total = 0;
+
+    while(periodic_get(i++, &p))
+    {
+        total += p.overruns;
+    }
+
+    return total;
+}
+
+/*!
+ * \brief Gives every client the step of a level
+ */
+static void overload_apply(const overload_level_t level)
+{
+    for(overload_client_t *c = clients; c != NULL; c = c->next)
+    {
+        const uint8_t step = steps[level][c->criticality];
+
+        if((step != c->step) && (c->shed != NULL))
+        {
+            c->shed(c->arg, step);
+            c->step = step;
+            c->changes++;
+        }
+    }
+}
+
+/*!
+ * \brief Selects a level, the time at the previous level is counted
+ */
+static void overload_set(const overload_level_t level, const uint32_t now)
+{
+    taskENTER_CRITICAL();
+    {
+        stats.level_ms[stats.level] += now - level_start_ms;
+
+        if(level > stats.level)
+        {
+            stats.entered[level]++;
+        }
+
+        stats.level = level;
+    }
+    taskEXIT_CRITICAL();
+
+    level_start_ms = now;
+
+    LOG_INFO("level %s at %u per mille\r\n", level_names[level], stats.load);
+
+    overload_apply(level);
+}
+
+/*!
+ * \brief Overload task
+ *
+ * Runs at the priority of the load meter, so it keeps its period while the
+ * load it protects against starves the other tasks.
+ */
+static void vOverloadTask(void *pvParameters)
+{
+    static periodic_t xPeriodic;
+    uint32_t last_misses = overload_misses();
+    uint32_t calm_ms = mono_ms();
+
+    (void)pvParameters;
+
+    periodic_init(&xPeriodic, "Overload", pdMS_TO_TICKS(OVERLOAD_PERIOD_MS));
+
+    level_start_ms = calm_ms;
+
+    for( ;; )
+    {
+        (void)periodic_wait(&xPeriodic);
+
+        const uint32_t now = mono_ms();
+        const uint16_t load = loadmeter_total(0);
+        const uint32_t misses = overload_misses();
+
+        // periodic_reset() clears the counters
+        const uint32_t missed = (misses >= last_misses) ? (misses - last_misses) : misses;
+        last_misses = misses;
+
+        taskENTER_CRITICAL();
+        {
+            stats.load = load;
+            stats.misses += missed;
+        }
+        taskEXIT_CRITICAL();
+
+        overload_level_t target = OVERLOAD_NONE;
+
+        if((load >= OVERLOAD_SEVERE_PERMILLE) ||
+           ((missed > 0) && (load >= OVERLOAD_HIGH_PERMILLE)))
+        {
+            target = OVERLOAD_SEVERE;
+        }
+        else if((load >= OVERLOAD_HIGH_PERMILLE) || (missed > 0))
+        {
+            target = OVERLOAD_HIGH;
+        }
+
+        if(target > stats.level)
+        {
+            overload_set(target, now);
+            calm_ms = now;
+        }
+        else if((load >= OVERLOAD_LOW_PERMILLE) || (missed > 0))
+        {
+            // In the band of hysteresis
+            calm_ms = now;
+        }
+        else if((stats.level > OVERLOAD_NONE) &&
+                ((now - calm_ms) >= OVERLOAD_RECOVER_MS))
+        {
+            overload_set(stats.level - 1, now);
+            calm_ms = now;
+        }
+    }
+}
+
+/*!
+ * \brief Creates the overload task
+ *
+ * Call after loadmeter_init(), the task uses the shortest window of the
+ * load meter.
+ */
+void overload_init(UBaseType_t priority)
+{
+    (void)xTaskCreateStatic(vOverloadTask, "Overload", OVERLOAD_STACK_DEPTH,
+                            NULL, priority, overload_stack, &overload_tcb);
+}
+
+/*!
+ * \brief Adds a client
+ *
+ * A client added during an overload is degraded at once. Call from a task
+ * or before the scheduler is started, a client is added once.
+ *
+ * \param[in]  c  Client, a critical client may have no shed function
+ *
+ * \return false if the criticality is not valid or the client was added
+ *         already
+ */
+bool overload_register(overload_client_t *c)
+{
+    if((c->criticality >= OVERLOAD_CLASSES) ||
+       ((c->shed == NULL) && (c->criticality != OVERLOAD_CRITICAL)))
+    {
+        return false;
+    }
+
+    for(const overload_client_t *p = clients; p != NULL; p = p->next)
+    {
+        if(p == c)
+        {
+            return false;
+        }
+    }
+
+    c->step = 0;
+    c->changes = 0;
+
+    // The overload task walks the list without a lock, the client is
+    // complete before it is linked
+    taskENTER_CRITICAL();
+    {
+        c->next = clients;
+        clients = c;
+    }
+    taskEXIT_CRITICAL();
+
+    return true;
+}
+
+/*!
+ * \brief Returns the current overload level
+ */
+overload_level_t overload_level(void)
+{
+    return stats.level;
+}
+
+/*!
+ * \brief Returns the degradation step of a criticality at the current level
+ *
+ * \return 0 to 2, 0 is the normal operation
+ */
+uint32_t overload_step(const overload_class_t criticality)
+{
+    return (criticality < OVERLOAD_CLASSES) ? steps[stats.level][criticality] : 0;
+}
+
+/*!
+ * \brief Admission control of work that is started on request
+ *
+ * Work of a criticality that is degraded at the current level is refused,
+ * critical work is always admitted. Call from a task.
+ *
+ * \param[in]  criticality  Of the work
+ *
+ * \return false if the work should not be started now
+ */
+bool overload_admit(const overload_class_t criticality)
+{
+    if(overload_step(criticality) == 0)
+    {
+        return true;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        stats.refused[criticality]++;
+    }
+    taskEXIT_CRITICAL();
+
+    return false;
+}
+
+/*!
+ * \brief Iterates over the clients
+ *
+ * \param[in]  c  NULL for the first client, else the previous one
+ *
+ * \return The next client, NULL after the last
+ */
+const overload_client_t *overload_next(const overload_client_t *c)
+{
+    return (c == NULL) ? clients : c->next;
+}
+
+/*!
+ * \brief Copies the statistics, with the time at the current level so far
+ */
+void overload_get_stats(overload_stats_t *s)
+{
+    const uint32_t now = mono_ms();
+
+    taskENTER_CRITICAL();
+    {
+        *s = stats;
+        s->level_ms[s->level] += now - level_start_ms;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Writes the level, the statistics and the clients to the serial port
+ */
+void overload_report(void)
+{
+    char line[OVERLOAD_LINE_LEN];
+    overload_stats_t s;
+
+    overload_get_stats(&s);
+
+    xsnprintf(line, OVERLOAD_LINE_LEN, "\r\nOverload %s, load %u.%u %%\r\n",
+              level_names[s.level], s.load / 10U, s.load % 10U);
+    xSerialPutStringPolicy(line, eSerialBlock, OVERLOAD_BLOCK_TIME);
+
+    xSerialPutStringPolicy("Level    Entered       ms\r\n", eSerialBlock,
+                           OVERLOAD_BLOCK_TIME);
+
+    for(uint32_t i=0; i<OVERLOAD_LEVELS; ++i)
+    {
+        xsnprintf(line, OVERLOAD_LINE_LEN, "%-8s %7lu %8lu\r\n", level_names[i],
+                  (unsigned long)s.entered[i], (unsigned long)s.level_ms[i]);
+        xSerialPutStringPolicy(line, eSerialBlock, OVERLOAD_BLOCK_TIME);
+    }
+
+    xsnprintf(line, OVERLOAD_LINE_LEN, "Misses %lu, refused %lu important, %lu optional\r\n",
+              (unsigned long)s.misses, (unsigned long)s.refused[OVERLOAD_IMPORTANT],
+              (unsigned long)s.refused[OVERLOAD_OPTIONAL]);
+    xSerialPutStringPolicy(line, eSerialBlock, OVERLOAD_BLOCK_TIME);
+
+    for(const overload_client_t *c = overload_next(NULL); c != NULL; c = overload_next(c))
+    {
+        xsnprintf(line, OVERLOAD_LINE_LEN, "%-10s %-9s step %u, %lu changes\r\n",
+                  c->name, class_names[c->criticality], (unsigned int)c->step,
+                  (unsigned long)c->changes);
+        xSerialPutStringPolicy(line, eSerialBlock, OVERLOAD_BLOCK_TIME);
+    }
+}
+
+/*!
+ * \brief Shed function of the displays, limits the frame rate to
+ *        OVERLOAD_DISPLAY_MS
+ *
+ * \param[in]  arg   Not used
+ * \param[in]  step  Step
+ */
+void overload_display(void *arg, const uint32_t step)
+{
+    (void)arg;
+
+    display_set_interval(display_ms[step]);
+}
+
+/*!
+ * \brief Shed function of the logger, raises the threshold to
+ *        OVERLOAD_LOG_LEVELS
+ *
+ * \param[in]  arg   Not used
+ * \param[in]  step  Step
+ */
+void overload_log(void *arg, const uint32_t step)
+{
+    (void)arg;
+
+    log_set_threshold(log_levels[step]);
+}
+
+/*!
+ * \brief Shed function of the telemetry, sends one of
+ *        OVERLOAD_TLM_DECIMATION sensor samples
+ *
+ * \param[in]  arg   Not used
+ * \param[in]  step  Step
+ */
+void overload_telemetry(void *arg, const uint32_t step)
+{
+    (void)arg;
+
+    tlm_set_decimation(tlm_decimation[step]);
+}
@@ -0,0 +1,209 @@
+/*! ***************************************************************************
+ *
+ * \brief     Overload protection with graceful degradation
+ * \file      overload.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef OVERLOAD_H
+#define OVERLOAD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * The overload protection watches the CPU load of the load meter and the
+ * deadline misses of the periodic tasks, and keeps the critical work on
+ * time by degrading the work that is not. Every client declares its
+ * criticality and gets a shed function that is called with its degradation
+ * step when the overload level changes:
+ *
+ *   Level     Critical  Important  Optional
+ *   none          0         0          0
+ *   high          0         0          1
+ *   severe        0         1          2
+ *
+ * A load of OVERLOAD_HIGH_PERMILLE or a deadline miss in a period selects
+ * the high level at once, a load of OVERLOAD_SEVERE_PERMILLE or a miss at
+ * the high load the severe level. The level only steps down after
+ * OVERLOAD_RECOVER_MS below OVERLOAD_LOW_PERMILLE without misses, so the
+ * load the degradation saves does not switch it back and forth.
+ *
+ * Work that is started on request, such as a job or a report, asks
+ * overload_admit() with its criticality before it starts.
+ */
+
+/// \name Definitions for the overload protection
+/// \{
+
+/*!
+ * \brief Set to 1 to start the overload protection in main.c
+ */
+#ifndef OVERLOAD_ENABLED
+#define OVERLOAD_ENABLED          (0)
+#endif
+
+/*!
+ * \brief Interval in ms of the evaluation, the shortest window of the load
+ *        meter
+ */
+#ifndef OVERLOAD_PERIOD_MS
+#define OVERLOAD_PERIOD_MS        (100)
+#endif
+
+/*!
+ * \brief Load in per mille at or above which the high and the severe level
+ *        are selected
+ */
+#ifndef OVERLOAD_HIGH_PERMILLE
+#define OVERLOAD_HIGH_PERMILLE    (850)
+#endif
+
+#ifndef OVERLOAD_SEVERE_PERMILLE
+#define OVERLOAD_SEVERE_PERMILLE  (950)
+#endif
+
+/*!
+ * \brief Load in per mille below which the level steps down
+ */
+#ifndef OVERLOAD_LOW_PERMILLE
+#define OVERLOAD_LOW_PERMILLE     (700)
+#endif
+
+/*!
+ * \brief Time in ms below OVERLOAD_LOW_PERMILLE without misses per step down
+ */
+#ifndef OVERLOAD_RECOVER_MS
+#define OVERLOAD_RECOVER_MS       (2000)
+#endif
+
+/*!
+ * \brief Shortest time in ms between frames of the displays per step of
+ *        overload_display()
+ */
+#ifndef OVERLOAD_DISPLAY_MS
+#define OVERLOAD_DISPLAY_MS       {0, 100, 500}
+#endif
+
+/*!
+ * \brief Log threshold per step of overload_log()
+ */
+#ifndef OVERLOAD_LOG_LEVELS
+#define OVERLOAD_LOG_LEVELS       {LOG_LEVEL_DEBUG, LOG_LEVEL_INFO, LOG_LEVEL_WARN}
+#endif
+
+/*!
+ * \brief One of this many sensor samples is sent per step of
+ *        overload_telemetry()
+ */
+#ifndef OVERLOAD_TLM_DECIMATION
+#define OVERLOAD_TLM_DECIMATION   {1, 4, 16}
+#endif
+
+/// \}
+
+/// Overload level
+typedef enum
+{
+    OVERLOAD_NONE,
+    OVERLOAD_HIGH,
+    OVERLOAD_SEVERE,
+}overload_level_t;
+
+#define OVERLOAD_LEVELS  (3)
+
+/// Criticality of a client
+typedef enum
+{
+    OVERLOAD_CRITICAL,      ///< Never degraded
+    OVERLOAD_IMPORTANT,     ///< Degraded at the severe level only
+    OVERLOAD_OPTIONAL,      ///< Degraded at the high level, more when severe
+}overload_class_t;
+
+#define OVERLOAD_CLASSES (3)
+
+/*!
+ * \brief Degrades the work of a client
+ *
+ * Called from the overload task, it must not block. Step 0 restores the
+ * normal operation.
+ *
+ * \param[in]  arg   Argument of the client
+ * \param[in]  step  0 to 2
+ */
+typedef void (*overload_shed_t)(void *arg, const uint32_t step);
+
+/// A client of the overload protection
+///
+/// Initialise with OVERLOAD_CLIENT_INIT(), add with overload_register().
+/// The members after arg are managed by the overload protection.
+typedef struct overload_client
+{
+    const char *name;               ///< Name for the report
+    overload_class_t criticality;
+    overload_shed_t shed;           ///< NULL for a critical client
+    void *arg;                      ///< Argument of shed
+    uint8_t step;                   ///< Current degradation step
+    uint32_t changes;               ///< Calls of shed
+    struct overload_client *next;
+}
+overload_client_t;
+
+/*!
+ * \brief Initialiser of a client
+ */
+#define OVERLOAD_CLIENT_INIT(n, c, fn, a) \
+    {.name = (n), .criticality = (c), .shed = (fn), .arg = (a)}
+
+/// Statistics of the overload protection
+typedef struct
+{
+    overload_level_t level;
+    uint16_t load;                          ///< Last load in per mille
+    uint32_t misses;                        ///< Deadline misses seen
+    uint32_t entered[OVERLOAD_LEVELS];      ///< Steps up to a level
+    uint32_t level_ms[OVERLOAD_LEVELS];     ///< Time spent at a level
+    uint32_t refused[OVERLOAD_CLASSES];     ///< Refusals of overload_admit()
+}
+overload_stats_t;
+
+// Function prototypes
+void overload_init(UBaseType_t priority);
+bool overload_register(overload_client_t *c);
+overload_level_t overload_level(void);
+uint32_t overload_step(const overload_class_t criticality);
+bool overload_admit(const overload_class_t criticality);
+const overload_client_t *overload_next(const overload_client_t *c);
+void overload_get_stats(overload_stats_t *stats);
+void overload_report(void);
+
+void overload_display(void *arg, const uint32_t step);
+void overload_log(void *arg, const uint32_t step);
+void overload_telemetry(void *arg, const uint32_t step);
+
+#endif // OVERLOAD_H
@@ -0,0 +1,212 @@
+/*! ***************************************************************************
+ *
+ * \brief     Periodic tasks with deadline miss and release jitter statistics
+ * \file      periodic.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "periodic.h"
+#include "mono.h"
+#include "mtb.h"
+
+/*
+ * vTaskDelayUntil() catches up after a cycle that overran: the next cycle
+ * starts at once and nothing records that the deadline was missed.
+ * periodic_wait() wraps xTaskDelayUntil() and records every cycle of a
+ * registered task: the cycles that did not finish before the next release,
+ * the latest start after a release in ticks, and the release jitter, the
+ * deviation of the time between two starts from the period, measured with
+ * mono_us32().
+ */
+
+// Registered periodic tasks, newest first
+static periodic_t *periodics = NULL;
+
+/*!
+ * \brief Sets up and registers a periodic task, the first cycle is released
+ *        one period from now
+ *
+ * Called by the task itself, before its first periodic_wait().
+ *
+ * \param[out]  p       Periodic task, must stay valid
+ * \param[in]   name    Name for reports
+ * \param[in]   period  Period in ticks
+ */
+void periodic_init(periodic_t *p, const char *name, const TickType_t period)
+{
+    bool registered = false;
+
+    taskENTER_CRITICAL();
+    {
+        p->name = name;
+        p->period = period;
+        p->release = xTaskGetTickCount();
+        p->start_us = mono_us32();
+        p->cycles = 0;
+        p->overruns = 0;
+        p->max_late = 0;
+        p->max_jitter_us = 0;
+
+        for(uint32_t i=0; i<PERIODIC_BUCKETS; i++)
+        {
+            p->jitter[i] = 0;
+        }
+
+        for(const periodic_t *q=periodics; q!=NULL; q=q->next)
+        {
+            registered |= (q == p);
+        }
+
+        if(!registered)
+        {
+            p->next = periodics;
+            periodics = p;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Ends a cycle and waits for the release of the next one
+ *
+ * Like xTaskDelayUntil(), the releases stay at whole periods from the first
+ * one. A cycle that ran past the next release is counted as an overrun and
+ * the next cycle starts at once.
+ *
+ * \param[in,out]  p  Periodic task
+ *
+ * \return False if the cycle overran
+ */
+bool periodic_wait(periodic_t *p)
+{
+    const TickType_t release = p->release + p->period;
+
+#if (PERIODIC_STOP_MTB == 1)
+    // Stop before the kernel call, the trace then ends with the late cycle
+    if((xTaskGetTickCount() - p->release) >= p->period)
+    {
+        mtb_stop();
+    }
+#endif
+
+    const bool on_time = (xTaskDelayUntil(&p->release, p->period) != pdFALSE);
+    const TickType_t late = xTaskGetTickCount() - release;
+    const uint32_t now_us = mono_us32();
+    const uint32_t interval_us = now_us - p->start_us;
+    const uint32_t period_us = (uint32_t)p->period * (1000000UL / configTICK_RATE_HZ);
+    const uint32_t jitter_us = (interval_us > period_us) ?
+        (interval_us - period_us) : (period_us - interval_us);
+    uint32_t bucket = 0;
+
+    while((bucket < PERIODIC_BUCKETS - 1) &&
+          (jitter_us >= ((uint32_t)PERIODIC_JITTER_US << bucket)))
+    {
+        bucket++;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        p->cycles++;
+
+        if(!on_time)
+        {
+            p->overruns++;
+        }
+
+        if(late > p->max_late)
+        {
+            p->max_late = late;
+        }
+
+        if(jitter_us > p->max_jitter_us)
+        {
+            p->max_jitter_us = jitter_us;
+        }
+
+        if(p->jitter[bucket] < UINT16_MAX)
+        {
+            p->jitter[bucket]++;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    p->start_us = now_us;
+
+    return on_time;
+}
+
+/*!
+ * \brief Reads the statistics of a registered periodic task
+ *
+ * \param[in]   i      Index of the periodic task, from 0
+ * \param[out]  stats  Copy of the periodic task
+ *
+ * \return False if there are no more periodic tasks
+ */
+bool periodic_get(const uint32_t i, periodic_t *stats)
+{
+    const periodic_t *p;
+    uint32_t n = 0;
+
+    taskENTER_CRITICAL();
+    {
+        for(p=periodics; (p!=NULL) && (n<i); p=p->next)
+        {
+            n++;
+        }
+
+        if(p != NULL)
+        {
+            *stats = *p;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return p != NULL;
+}
+
+/*!
+ * \brief Clears the statistics of all periodic tasks
+ */
+void periodic_reset(void)
+{
+    taskENTER_CRITICAL();
+    {
+        for(periodic_t *p=periodics; p!=NULL; p=p->next)
+        {
+            p->cycles = 0;
+            p->overruns = 0;
+            p->max_late = 0;
+            p->max_jitter_us = 0;
+
+            for(uint32_t i=0; i<PERIODIC_BUCKETS; i++)
+            {
+                p->jitter[i] = 0;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+}
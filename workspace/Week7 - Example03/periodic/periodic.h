@@ -0,0 +1,93 @@
+/*! ***************************************************************************
+ *
+ * \brief     Periodic tasks with deadline miss and release jitter statistics
+ * \file      periodic.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// \name Definitions for the periodic tasks
+/// \{
+
+/*!
+ * \brief Number of buckets of the release jitter histogram
+ */
+#define PERIODIC_BUCKETS    (8)
+
+/*!
+ * \brief Bound of the first bucket in microseconds
+ *
+ * Bucket i counts the cycles with a jitter below PERIODIC_JITTER_US << i,
+ * the last bucket all others.
+ */
+#ifndef PERIODIC_JITTER_US
+#define PERIODIC_JITTER_US  (16)
+#endif
+
+/*!
+ * \brief Set to 1 to stop the MTB capture when a cycle overran, so the
+ *        branches of the late cycle are kept, see mtb/mtb.h
+ */
+#ifndef PERIODIC_STOP_MTB
+#define PERIODIC_STOP_MTB   (1)
+#endif
+
+/// \}
+
+/// A periodic task, set up with periodic_init()
+///
+/// The statistics are updated by periodic_wait() and read with
+/// periodic_get().
+typedef struct periodic
+{
+    const char *name;           ///< Name for reports
+    TickType_t period;          ///< Period in ticks
+    TickType_t release;         ///< Release of the current cycle in ticks
+    uint32_t start_us;          ///< Start of the current cycle in us
+    uint32_t cycles;            ///< Number of completed cycles
+    uint32_t overruns;          ///< Cycles that ran past the next release
+    TickType_t max_late;        ///< Longest start after a release in ticks
+    uint32_t max_jitter_us;     ///< Largest deviation from the period in us
+    uint16_t jitter[PERIODIC_BUCKETS]; ///< Saturates at 0xFFFF
+    struct periodic *next;      ///< Next registered periodic task
+}
+periodic_t;
+
+// Function prototypes
+void periodic_init(periodic_t *p, const char *name, const TickType_t period);
+bool periodic_wait(periodic_t *p);
+bool periodic_get(const uint32_t i, periodic_t *stats);
+void periodic_reset(void);
+
+#endif // PERIODIC_H
@@ -0,0 +1,241 @@
+/*! ***************************************************************************
+ *
+ * \brief     Fixed-size block pools
+ * \file      pool.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "pool.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Initialised pools, for the reports
+static pool_t *pools = NULL;
+
+/*!
+ * \brief Initialises a pool of count blocks in storage
+ *
+ * The storage is word aligned when it is defined with POOL_STORAGE() and
+ * must hold count blocks of POOL_BLOCK_SIZE(size) bytes. Call once per
+ * pool, before it is used by more than one task.
+ *
+ * \param[out]  pool     Pool
+ * \param[in]   name     Name for reports
+ * \param[in]   storage  Storage of the blocks
+ * \param[in]   size     Size of an object in bytes
+ * \param[in]   count    Number of blocks
+ */
+void pool_init(pool_t *pool, const char *name, void *storage,
+               const uint32_t size, const uint32_t count)
+{
+    const uint32_t block_size = POOL_BLOCK_SIZE(size);
+    uint8_t *block = (uint8_t *)storage;
+
+    configASSERT(((uintptr_t)storage & 3U) == 0);
+
+    pool->name = name;
+    pool->free = NULL;
+    pool->start = block;
+    pool->end = block + block_size * count;
+    pool->block_size = block_size;
+    pool->count = count;
+    pool->used = 0;
+    pool->peak = 0;
+    pool->failures = 0;
+
+    // Link the blocks back to front, so the first block is allocated first
+    for(uint32_t i=count; i>0; i--)
+    {
+        pool_block_t *b = (pool_block_t *)(block + block_size * (i - 1));
+
+        b->next = pool->free;
+        pool->free = b;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        pool->next = pools;
+        pools = pool;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Takes the first free block, called with interrupts masked
+ */
+static void *pool_take(pool_t *pool)
+{
+    pool_block_t *b = pool->free;
+
+    if(b == NULL)
+    {
+        pool->failures++;
+        return NULL;
+    }
+
+    pool->free = b->next;
+
+    if(++pool->used > pool->peak)
+    {
+        pool->peak = pool->used;
+    }
+
+    return b;
+}
+
+/*!
+ * \brief Returns a block to the free list, called with interrupts masked
+ */
+static void pool_give(pool_t *pool, void *block)
+{
+    pool_block_t *b = (pool_block_t *)block;
+
+    // Only blocks of this pool may be freed
+    configASSERT(((uint8_t *)block >= pool->start) &&
+                 ((uint8_t *)block < pool->end) &&
+                 ((((uint8_t *)block - pool->start) % pool->block_size) == 0));
+    configASSERT(pool->used > 0);
+
+    b->next = pool->free;
+    pool->free = b;
+    pool->used--;
+}
+
+/*!
+ * \brief Allocates a block
+ *
+ * Takes constant time and never blocks. Must be called from a task or
+ * before the scheduler is started.
+ *
+ * \param[in,out]  pool  Pool
+ *
+ * \return The block, or NULL if all blocks are allocated
+ */
+void *pool_alloc(pool_t *pool)
+{
+    void *block;
+
+    taskENTER_CRITICAL();
+    {
+        block = pool_take(pool);
+    }
+    taskEXIT_CRITICAL();
+
+    return block;
+}
+
+/*!
+ * \brief Frees a block allocated from the same pool
+ *
+ * Takes constant time. Must be called from a task.
+ *
+ * \param[in,out]  pool   Pool
+ * \param[in]      block  Block, NULL is ignored
+ */
+void pool_free(pool_t *pool, void *block)
+{
+    if(block == NULL)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        pool_give(pool, block);
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Allocates a block from an interrupt handler
+ *
+ * \param[in,out]  pool  Pool
+ *
+ * \return The block, or NULL if all blocks are allocated
+ */
+void *pool_alloc_from_isr(pool_t *pool)
+{
+    void *block;
+
+    const UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    {
+        block = pool_take(pool);
+    }
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+
+    return block;
+}
+
+/*!
+ * \brief Frees a block from an interrupt handler
+ *
+ * \param[in,out]  pool   Pool
+ * \param[in]      block  Block, NULL is ignored
+ */
+void pool_free_from_isr(pool_t *pool, void *block)
+{
+    if(block == NULL)
+    {
+        return;
+    }
+
+    const UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    {
+        pool_give(pool, block);
+    }
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/*!
+ * \brief Copies the statistics of a pool
+ *
+ * \param[in]   pool   Pool
+ * \param[out]  stats  Statistics
+ */
+void pool_stats(const pool_t *pool, pool_stats_t *stats)
+{
+    const UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    {
+        stats->block_size = pool->block_size;
+        stats->count = pool->count;
+        stats->used = pool->used;
+        stats->peak = pool->peak;
+        stats->failures = pool->failures;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/*!
+ * \brief Iterates over the initialised pools
+ *
+ * \param[in]  pool  Previous pool, or NULL for the first
+ *
+ * \return The next pool, or NULL after the last
+ */
+const pool_t *pool_next(const pool_t *pool)
+{
+    return (pool == NULL) ? pools : pool->next;
+}
@@ -0,0 +1,105 @@
+/*! ***************************************************************************
+ *
+ * \brief     Fixed-size block pools
+ * \file      pool.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// \name Definitions for the block pools
+/// \{
+
+/*!
+ * \brief Size of a block rounded up to a multiple of 4 bytes
+ *
+ * A free block holds the link to the next free block, so a block is at least
+ * the size of a pointer.
+ */
+#define POOL_BLOCK_SIZE(size) \
+    (((size) < sizeof(void *)) ? sizeof(void *) : (((size) + 3U) & ~3U))
+
+/*!
+ * \brief Defines the word aligned storage of a pool of count blocks
+ *
+ * Example: POOL_STORAGE(msg_storage, sizeof(msg_t), 8);
+ */
+#define POOL_STORAGE(name, size, count) \
+    uint32_t name[(POOL_BLOCK_SIZE(size) / 4U) * (count)]
+
+/// \}
+
+/// Free block, the link is stored in the block itself
+typedef struct pool_block
+{
+    struct pool_block *next;
+}
+pool_block_t;
+
+/// Block pool
+///
+/// Initialise with pool_init(), the fields are managed by the pool functions.
+typedef struct pool
+{
+    const char *name;       ///< Name for reports
+    pool_block_t *free;     ///< First free block
+    uint8_t *start;         ///< First byte of the storage
+    uint8_t *end;           ///< First byte after the storage
+    uint32_t block_size;    ///< Size of a block in bytes
+    uint32_t count;         ///< Number of blocks
+    uint32_t used;          ///< Number of allocated blocks
+    uint32_t peak;          ///< Largest number of allocated blocks
+    uint32_t failures;      ///< Allocations that found the pool empty
+    struct pool *next;      ///< Next initialised pool
+}
+pool_t;
+
+/// Pool statistics
+typedef struct
+{
+    uint32_t block_size;    ///< Size of a block in bytes
+    uint32_t count;         ///< Number of blocks
+    uint32_t used;          ///< Number of allocated blocks
+    uint32_t peak;          ///< Largest number of allocated blocks
+    uint32_t failures;      ///< Allocations that found the pool empty
+}
+pool_stats_t;
+
+// Function prototypes
+void pool_init(pool_t *pool, const char *name, void *storage,
+               const uint32_t size, const uint32_t count);
+void *pool_alloc(pool_t *pool);
+void pool_free(pool_t *pool, void *block);
+void *pool_alloc_from_isr(pool_t *pool);
+void pool_free_from_isr(pool_t *pool, void *block);
+void pool_stats(const pool_t *pool, pool_stats_t *stats);
+const pool_t *pool_next(const pool_t *pool);
+
+#endif // POOL_H
@@ -0,0 +1,317 @@
+/*! ***************************************************************************
+ *
+ * \brief     Residency of the power modes, sleep vetoes and wake-up sources
+ * \file      powerprof.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "powerprof.h"
+#include "clock.h"
+#include "task.h"
+#include "serial.h"
+#include "xprintf.h"
+
+/*
+ * The tickless idle reports every sleep with its mode, its length and the
+ * interrupt that ended it, and every sleep that could not be spent in a stop
+ * mode with the reason, see lowpower.c. The run-time counter stops in the
+ * stop modes, so the elapsed time is the run time plus the stop modes. The
+ * time in LP_RUN is what is left, including the busy idle loop of idle times
+ * too short for tickless idle.
+ */
+
+// Time a line may wait for room in the serial transmit buffer
+#define POWERPROF_BLOCK_TIME pdMS_TO_TICKS(100)
+
+// Longest line written to the serial port, including the terminator
+#define POWERPROF_LINE_LEN   (56)
+
+static const char * const mode_names[LP_MODES] =
+{
+    "Run", "Wait", "VLPS", "LLS"
+};
+
+static const uint32_t mode_ua[LP_MODES] =
+{
+    POWERPROF_RUN_UA, POWERPROF_WAIT_UA, POWERPROF_VLPS_UA, POWERPROF_LLS_UA
+};
+
+static const char * const veto_names[LP_VETOES] =
+{
+    "Short", "Blocked", "UART0", "DMA", "I2C", "ADC", "TPM", "PIT1", "USB"
+};
+
+static const char * const client_names[LP_CLIENTS] =
+{
+    "Serial", "App"
+};
+
+// Interrupts of the KL25, SysTick and none
+static const char * const wake_names[POWERPROF_WAKES] =
+{
+    "DMA0", "DMA1", "DMA2", "DMA3", "IRQ4", "FTFA", "LVD", "LLWU",
+    "I2C0", "I2C1", "SPI0", "SPI1", "UART0", "UART1", "UART2", "ADC0",
+    "CMP0", "TPM0", "TPM1", "TPM2", "RTC", "RTC_Sec", "PIT", "IRQ23",
+    "USB0", "DAC0", "TSI0", "MCG", "LPTMR0", "IRQ29", "PORTA", "PORTD",
+    "SysTick", "Other"
+};
+
+// Written by the idle task with interrupts masked
+static powerprof_t prof;
+static configRUN_TIME_COUNTER_TYPE origin = 0;
+static uint64_t stop_us = 0;
+
+// Copy for powerprof_report(), kept off the stack of the caller
+static powerprof_t snapshot;
+
+/*!
+ * \brief Counts a sleep, called with interrupts masked
+ *
+ * \param[in]  mode  LP_WAIT, LP_VLPS or LP_LLS
+ * \param[in]  us    Length of the sleep in microseconds
+ * \param[in]  wake  Source that ended it, from 0 to POWERPROF_WAKES - 1
+ */
+void powerprof_sleep(const uint32_t mode, const uint64_t us, const uint32_t wake)
+{
+    if((mode == LP_RUN) || (mode >= LP_MODES) || (wake >= POWERPROF_WAKES))
+    {
+        return;
+    }
+
+    prof.mode_us[mode] += us;
+    prof.sleeps[mode]++;
+    prof.wakes[wake]++;
+
+    // The run-time counter does not see the stop modes
+    if(mode != LP_WAIT)
+    {
+        stop_us += us;
+    }
+}
+
+/*!
+ * \brief Counts a sleep that was not spent in a stop mode
+ *
+ * \param[in]  veto     The reason
+ * \param[in]  clients  With LP_VETO_BLOCKED the bit mask of the clients that
+ *                      blocked it
+ */
+void powerprof_veto(const lp_veto_t veto, const uint32_t clients)
+{
+    if(veto >= LP_VETOES)
+    {
+        return;
+    }
+
+    const uint32_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        prof.vetoes[veto]++;
+
+        for(uint32_t i=0; i<LP_CLIENTS; i++)
+        {
+            if(clients & (1UL << i))
+            {
+                prof.blocked[i]++;
+            }
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+/*!
+ * \brief Reads the profile since the last reset
+ *
+ * \param[out]  p  Copy of the profile, with the elapsed time and the time
+ *                 in LP_RUN filled in
+ */
+void powerprof_get(powerprof_t *p)
+{
+    taskENTER_CRITICAL();
+    {
+        *p = prof;
+        p->total_us = powerprof_counts_to_us(portGET_RUN_TIME_COUNTER_VALUE() -
+                                             origin) + stop_us;
+    }
+    taskEXIT_CRITICAL();
+
+    uint64_t asleep = 0;
+
+    for(uint32_t m=LP_WAIT; m<LP_MODES; m++)
+    {
+        asleep += p->mode_us[m];
+    }
+
+    p->mode_us[LP_RUN] = (asleep < p->total_us) ? (p->total_us - asleep) : 0;
+}
+
+/*!
+ * \brief Estimates the mean supply current from the time in the modes
+ *
+ * \param[in]  p  Profile of powerprof_get()
+ *
+ * \return Mean current in uA, with the POWERPROF_*_UA currents of the modes
+ */
+uint32_t powerprof_mean_ua(const powerprof_t *p)
+{
+    uint64_t charge = 0;
+
+    if(p->total_us == 0)
+    {
+        return 0;
+    }
+
+    for(uint32_t m=0; m<LP_MODES; m++)
+    {
+        // In uA us, fits 64 bits for years at the run current
+        charge += p->mode_us[m] * mode_ua[m];
+    }
+
+    return (uint32_t)(charge / p->total_us);
+}
+
+/*!
+ * \brief Clears the profile and starts a new one
+ */
+void powerprof_reset(void)
+{
+    taskENTER_CRITICAL();
+    {
+        for(uint32_t m=0; m<LP_MODES; m++)
+        {
+            prof.mode_us[m] = 0;
+            prof.sleeps[m] = 0;
+        }
+
+        for(uint32_t i=0; i<LP_VETOES; i++)
+        {
+            prof.vetoes[i] = 0;
+        }
+
+        for(uint32_t i=0; i<LP_CLIENTS; i++)
+        {
+            prof.blocked[i] = 0;
+        }
+
+        for(uint32_t i=0; i<POWERPROF_WAKES; i++)
+        {
+            prof.wakes[i] = 0;
+        }
+
+        origin = portGET_RUN_TIME_COUNTER_VALUE();
+        stop_us = 0;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Writes a line to the serial port
+ */
+static void powerprof_puts(const char *line)
+{
+    xSerialPutStringPolicy(line, eSerialBlock, POWERPROF_BLOCK_TIME);
+}
+
+/*!
+ * \brief Writes the profile since the last report to the serial port and
+ *        clears it
+ *
+ * The residency of every mode in per mille with the number of sleeps, the
+ * estimated mean current, the reasons the stop modes were not entered and
+ * the wake-up sources. Modes, reasons and sources that did not occur are
+ * left out.
+ */
+void powerprof_report(void)
+{
+    char line[POWERPROF_LINE_LEN];
+    powerprof_t *p = &snapshot;
+
+    powerprof_get(p);
+    powerprof_reset();
+
+    xsnprintf(line, POWERPROF_LINE_LEN, "\r\nPower over %lu ms, mean %lu uA\r\n",
+        (unsigned long)(p->total_us / 1000), (unsigned long)powerprof_mean_ua(p));
+    powerprof_puts(line);
+
+    powerprof_puts("Mode         ms   pm  Sleeps\r\n");
+
+    for(uint32_t m=0; m<LP_MODES; m++)
+    {
+        if((p->mode_us[m] == 0) && (p->sleeps[m] == 0))
+        {
+            continue;
+        }
+
+        xsnprintf(line, POWERPROF_LINE_LEN, "%-8s %6lu %4lu %7lu\r\n",
+            mode_names[m], (unsigned long)(p->mode_us[m] / 1000),
+            (unsigned long)((p->total_us > 0) ?
+                            (p->mode_us[m] * 1000 / p->total_us) : 0),
+            (unsigned long)p->sleeps[m]);
+        powerprof_puts(line);
+    }
+
+    for(uint32_t i=0; i<LP_VETOES; i++)
+    {
+        if(p->vetoes[i] != 0)
+        {
+            xsnprintf(line, POWERPROF_LINE_LEN, "Veto %-8s %7lu\r\n",
+                veto_names[i], (unsigned long)p->vetoes[i]);
+            powerprof_puts(line);
+        }
+    }
+
+    for(uint32_t i=0; i<LP_CLIENTS; i++)
+    {
+        if(p->blocked[i] != 0)
+        {
+            xsnprintf(line, POWERPROF_LINE_LEN, "Block %-7s %7lu\r\n",
+                client_names[i], (unsigned long)p->blocked[i]);
+            powerprof_puts(line);
+        }
+    }
+
+    for(uint32_t i=0; i<POWERPROF_WAKES; i++)
+    {
+        if(p->wakes[i] != 0)
+        {
+            xsnprintf(line, POWERPROF_LINE_LEN, "Wake %-8s %7lu\r\n",
+                wake_names[i], (unsigned long)p->wakes[i]);
+            powerprof_puts(line);
+        }
+    }
+
+    // Peripheral clocks that are on now, these are not reset
+    for(uint32_t g=0; g<CLK_GATES; g++)
+    {
+        const uint32_t users = clk_gate_users((clk_gate_t)g);
+
+        if(users != 0)
+        {
+            xsnprintf(line, POWERPROF_LINE_LEN, "Gate %-8s %7lu\r\n",
+                clk_gate_name((clk_gate_t)g), (unsigned long)users);
+            powerprof_puts(line);
+        }
+    }
+}
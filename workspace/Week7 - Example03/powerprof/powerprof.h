@@ -0,0 +1,101 @@
+/*! ***************************************************************************
+ *
+ * \brief     Residency of the power modes, sleep vetoes and wake-up sources
+ * \file      powerprof.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef POWERPROF_H
+#define POWERPROF_H
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "lowpower.h"
+#include "runtime_stats.h"
+
+/// \name Definitions for the power profiler
+/// \{
+
+/*!
+ * \brief Typical supply currents in uA of the power modes, for the estimate
+ *        of the mean current
+ *
+ * Rough values for the KL25 at 3 V and 25 C with the 48 MHz core clock of
+ * CLK_RUN and most peripheral clocks gated. The board, the LEDs and the
+ * sensors are not included, measure and adjust them.
+ */
+#ifndef POWERPROF_RUN_UA
+#define POWERPROF_RUN_UA      (6000)
+#endif
+
+#ifndef POWERPROF_WAIT_UA
+#define POWERPROF_WAIT_UA     (3700)
+#endif
+
+#ifndef POWERPROF_VLPS_UA
+#define POWERPROF_VLPS_UA     (2)
+#endif
+
+#ifndef POWERPROF_LLS_UA
+#define POWERPROF_LLS_UA      (2)
+#endif
+
+/*!
+ * \brief Wake-up sources, 0 to 31 are the interrupts of the NVIC
+ */
+#define POWERPROF_WAKE_SYSTICK  (32)
+#define POWERPROF_WAKE_OTHER    (33)
+#define POWERPROF_WAKES         (34)
+
+/// \}
+
+/// Time in the power modes and the sleeps since the last reset
+typedef struct
+{
+    uint64_t total_us;                  ///< Time since the last reset
+    uint64_t mode_us[LP_MODES];         ///< Time in every mode
+    uint32_t sleeps[LP_MODES];          ///< Sleeps in every mode
+    uint32_t vetoes[LP_VETOES];         ///< Stop modes not entered
+    uint32_t blocked[LP_CLIENTS];       ///< LP_VETO_BLOCKED of every client
+    uint32_t wakes[POWERPROF_WAKES];    ///< Sleeps ended by every source
+}
+powerprof_t;
+
+/*!
+ * \brief Converts run-time counts to microseconds
+ */
+#define powerprof_counts_to_us(counts) \
+    ((uint64_t)(counts) * rtsTICK_US / rtsCOUNTS_PER_TICK)
+
+// Function prototypes
+void powerprof_sleep(const uint32_t mode, const uint64_t us, const uint32_t wake);
+void powerprof_veto(const lp_veto_t veto, const uint32_t clients);
+void powerprof_get(powerprof_t *prof);
+uint32_t powerprof_mean_ua(const powerprof_t *prof);
+void powerprof_reset(void);
+void powerprof_report(void);
+
+#endif // POWERPROF_H
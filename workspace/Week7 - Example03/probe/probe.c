@@ -0,0 +1,57 @@
+/*! ***************************************************************************
+ *
+ * \brief     GPIO timing probes
+ * \file      probe.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "probe.h"
+
+/*!
+ * \brief Configures the probe pins as low outputs
+ *
+ * Call before the scheduler is started. Does nothing when PROBE_ENABLED is 0.
+ */
+void probe_init(void)
+{
+#if (PROBE_ENABLED == 1)
+    const uint32_t mask = (1UL << PROBE_TASK) | (1UL << PROBE_ISR) |
+                          (1UL << PROBE_I2C) | (1UL << PROBE_SERIAL);
+
+    // Enable clock to PORTC
+    SIM->SCGC5 |= SIM_SCGC5_PORTC_MASK;
+
+    // Set the pins to the GPIO function
+    PORTC->PCR[PROBE_TASK] = PORT_PCR_MUX(1);
+    PORTC->PCR[PROBE_ISR] = PORT_PCR_MUX(1);
+    PORTC->PCR[PROBE_I2C] = PORT_PCR_MUX(1);
+    PORTC->PCR[PROBE_SERIAL] = PORT_PCR_MUX(1);
+
+    // Low outputs
+    FGPIOC->PCOR = mask;
+    FGPIOC->PDDR |= mask;
+#endif
+}
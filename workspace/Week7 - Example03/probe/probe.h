@@ -0,0 +1,100 @@
+/*! ***************************************************************************
+ *
+ * \brief     GPIO timing probes
+ * \file      probe.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef PROBE_H
+#define PROBE_H
+
+#include <MKL25Z4.h>
+
+/// \name Definitions for the timing probes
+/// \{
+
+/*!
+ * \brief Set to 1 to drive the probe pins
+ *
+ * With the default of 0 every probe macro expands to nothing and
+ * probe_init() leaves the pins alone, so the instrumented code is the same
+ * as without the probes.
+ */
+#ifndef PROBE_ENABLED
+#define PROBE_ENABLED (0)
+#endif
+
+/*!
+ * \brief Pin numbers on port C of the probe points
+ *
+ * PTC8 to PTC11 are on header J1 and not used by the other examples.
+ * - PROBE_TASK   : high while a task other than the idle task is running
+ * - PROBE_ISR    : high while an instrumented interrupt handler is running,
+ *                  a nested handler drives it low when it returns
+ * - PROBE_I2C    : high from start to stop of a transfer on either I2C bus
+ * - PROBE_SERIAL : high while a DMA transmission on UART0 is in progress
+ */
+#ifndef PROBE_TASK
+#define PROBE_TASK    (8)
+#endif
+#ifndef PROBE_ISR
+#define PROBE_ISR     (9)
+#endif
+#ifndef PROBE_I2C
+#define PROBE_I2C     (10)
+#endif
+#ifndef PROBE_SERIAL
+#define PROBE_SERIAL  (11)
+#endif
+
+/// \}
+
+#if (PROBE_ENABLED == 1)
+
+/*!
+ * \brief Drives a probe pin
+ *
+ * The pins are written through the FGPIO alias on the single-cycle IOPORT,
+ * so with a constant probe point every macro is a single store of a
+ * constant mask, also from an interrupt handler. The set, clear and toggle
+ * registers make the writes atomic.
+ */
+#define PROBE_HIGH(p)     (FGPIOC->PSOR = (1UL << (p)))
+#define PROBE_LOW(p)      (FGPIOC->PCOR = (1UL << (p)))
+#define PROBE_TOGGLE(p)   (FGPIOC->PTOR = (1UL << (p)))
+
+#else
+
+#define PROBE_HIGH(p)
+#define PROBE_LOW(p)
+#define PROBE_TOGGLE(p)
+
+#endif // PROBE_ENABLED
+
+// Function prototypes
+void probe_init(void);
+
+#endif // PROBE_H
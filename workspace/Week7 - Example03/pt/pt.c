@@ -0,0 +1,186 @@
+/*! ***************************************************************************
+ *
+ * \brief     Stackless protothread jobs sharing a single task
+ * \file      pt.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "pt.h"
+
+// Jobs in the order they were added
+static pt_job_t *jobs = NULL;
+static pt_job_t *jobs_tail = NULL;
+
+static TaskHandle_t pt_task = NULL;
+
+static StaticTask_t pt_tcb;
+__BSS_NOCLEAR static StackType_t pt_stack[PT_STACK_DEPTH];
+
+static void vPtTask(void *pvParameters);
+
+/*!
+ * \brief Creates the task that runs the protothread jobs
+ *
+ * \param[in]  priority  Priority of the jobs. They run cooperatively, a job
+ *                       delays all other jobs until it waits.
+ */
+void pt_init(UBaseType_t priority)
+{
+    pt_task = xTaskCreateStatic(vPtTask, "Jobs", PT_STACK_DEPTH, NULL,
+                                priority, pt_stack, &pt_tcb);
+}
+
+/*!
+ * \brief Adds a job, it runs in the next pass of the protothread task
+ *
+ * The job must remain valid while it runs. May be called before the
+ * scheduler is started and from a job.
+ *
+ * \param[in,out]  job  Job with fn and name set
+ */
+void pt_add(pt_job_t *job)
+{
+    job->pt.lc = 0;
+    job->pt.timed = false;
+    job->pt.wake = xTaskGetTickCount();
+    job->ended = false;
+    job->next = NULL;
+
+    taskENTER_CRITICAL();
+    {
+        if(jobs_tail == NULL)
+        {
+            jobs = job;
+        }
+        else
+        {
+            jobs_tail->next = job;
+        }
+
+        jobs_tail = job;
+    }
+    taskEXIT_CRITICAL();
+
+    pt_signal();
+}
+
+/*!
+ * \brief Runs all jobs in the next pass instead of at the next wake time
+ */
+void pt_signal(void)
+{
+    if(pt_task != NULL)
+    {
+        xTaskNotifyGive(pt_task);
+    }
+}
+
+/*!
+ * \brief Runs all jobs in the next pass, from an interrupt handler
+ *
+ * \param[in,out]  woken  Set to pdTRUE if the protothread task must be
+ *                        switched in
+ */
+void pt_signal_from_isr(BaseType_t *woken)
+{
+    if(pt_task != NULL)
+    {
+        vTaskNotifyGiveFromISR(pt_task, woken);
+    }
+}
+
+/*!
+ * \brief Runs every job once and returns the time until the next pass
+ */
+static TickType_t pt_pass(void)
+{
+    TickType_t next = portMAX_DELAY;
+
+    for(pt_job_t *job = jobs; job != NULL; job = job->next)
+    {
+        if(job->ended)
+        {
+            continue;
+        }
+
+        const pt_state_t state = job->fn(&job->pt);
+
+        if(state == PT_ENDED)
+        {
+            job->ended = true;
+        }
+        else if(state == PT_YIELDED)
+        {
+            next = 0;
+        }
+        else if(job->pt.timed)
+        {
+            // Only a delay, the job does not need to be polled before wake
+            const TickType_t left = job->pt.wake - xTaskGetTickCount();
+
+            if(pt_expired(&job->pt))
+            {
+                next = 0;
+            }
+            else if(left < next)
+            {
+                next = left;
+            }
+        }
+        else if(next > pdMS_TO_TICKS(PT_POLL_MS))
+        {
+            next = pdMS_TO_TICKS(PT_POLL_MS);
+        }
+    }
+
+    return next;
+}
+
+/*!
+ * \brief Runs the jobs
+ *
+ * Blocks until the earliest delay of a job expires or pt_signal() is
+ * called. Jobs waiting for a condition are polled every PT_POLL_MS, if
+ * there are none the task does not wake up for polling.
+ */
+static void vPtTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for( ;; )
+    {
+        const TickType_t next = pt_pass();
+
+        if(next > 0)
+        {
+            ulTaskNotifyTake(pdTRUE, next);
+        }
+        else
+        {
+            taskYIELD();
+        }
+    }
+}
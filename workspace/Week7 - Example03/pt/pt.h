@@ -0,0 +1,166 @@
+/*! ***************************************************************************
+ *
+ * \brief     Stackless protothread jobs sharing a single task
+ * \file      pt.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef PT_H
+#define PT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// \name Definitions for the protothread jobs
+/// \{
+
+/*!
+ * \brief Interval at which jobs waiting for a condition are polled
+ *
+ * A job waiting with PT_WAIT_UNTIL() is also run when pt_signal() is
+ * called, so a condition set by a task or interrupt handler is seen
+ * immediately if it signals.
+ */
+#ifndef PT_POLL_MS
+#define PT_POLL_MS      (10)
+#endif
+
+/*!
+ * \brief Stack size in words of the task that runs the jobs
+ */
+#ifndef PT_STACK_DEPTH
+#define PT_STACK_DEPTH  (configMINIMAL_STACK_SIZE)
+#endif
+
+/// \}
+
+/// Result of a pass through a job
+typedef enum
+{
+    PT_WAITING,     ///< Waiting for a condition or a delay
+    PT_YIELDED,     ///< Gave up the processor, run again in the next pass
+    PT_ENDED,       ///< Reached PT_END() or PT_EXIT(), not run again
+}
+pt_state_t;
+
+/// State of a protothread
+typedef struct
+{
+    uint16_t lc;        ///< Line to continue at
+    bool timed;         ///< Waiting for wake
+    TickType_t wake;    ///< Tick count at which a delay expires
+}
+pt_t;
+
+/// Job function, see PT_BEGIN()
+typedef pt_state_t (*pt_fn_t)(pt_t *pt);
+
+/// Job run by the protothread task
+typedef struct pt_job
+{
+    pt_fn_t fn;             ///< Job function
+    const char *name;       ///< Name for reports
+    pt_t pt;                ///< Managed by the scheduler
+    bool ended;             ///< Managed by the scheduler
+    struct pt_job *next;    ///< Managed by the scheduler
+}
+pt_job_t;
+
+/*!
+ * \brief Protothread control flow
+ *
+ * A job is a function that runs up to the next wait and returns. The next
+ * call continues after that wait, through a switch on the line number, so
+ * all jobs share the stack of the protothread task. Local variables do not
+ * keep their value across a wait, use static variables. A wait may not be
+ * placed inside a switch statement of the job.
+ *
+ * Example:
+ *
+ *     static pt_state_t job_blink(pt_t *pt)
+ *     {
+ *         PT_BEGIN(pt);
+ *
+ *         for( ;; )
+ *         {
+ *             led_on();
+ *             PT_DELAY(pt, pdMS_TO_TICKS(10));
+ *             led_off();
+ *             PT_DELAY(pt, pdMS_TO_TICKS(990));
+ *         }
+ *
+ *         PT_END(pt);
+ *     }
+ */
+#define PT_BEGIN(pt)            switch((pt)->lc) { case 0:
+
+#define PT_END(pt)              } (pt)->lc = 0; return PT_ENDED
+
+/// Returns until cond is true
+#define PT_WAIT_UNTIL(pt, cond) \
+    do { (pt)->lc = __LINE__; /* FALLTHROUGH */ case __LINE__: \
+        if(!(cond)) { return PT_WAITING; } } while(0)
+
+/// Returns once, continues in the next pass of the scheduler
+#define PT_YIELD(pt) \
+    do { (pt)->lc = __LINE__; return PT_YIELDED; \
+        /* FALLTHROUGH */ case __LINE__: ; } while(0)
+
+/// Ends the job
+#define PT_EXIT(pt)             do { (pt)->lc = 0; return PT_ENDED; } while(0)
+
+/// Waits until the tick count reaches (pt)->wake
+#define PT_WAIT_WAKE(pt) \
+    do { (pt)->timed = true; PT_WAIT_UNTIL(pt, pt_expired(pt)); \
+        (pt)->timed = false; } while(0)
+
+/// Waits ticks ticks from now, like vTaskDelay()
+#define PT_DELAY(pt, ticks) \
+    do { (pt)->wake = xTaskGetTickCount() + (ticks); PT_WAIT_WAKE(pt); } while(0)
+
+/// Waits until period ticks after the previous wake time, like
+/// vTaskDelayUntil(). The first period starts when the job is added.
+#define PT_DELAY_PERIODIC(pt, period) \
+    do { (pt)->wake += (period); PT_WAIT_WAKE(pt); } while(0)
+
+/*!
+ * \brief Checks if the delay of a protothread has expired
+ */
+static inline bool pt_expired(const pt_t *pt)
+{
+    return (TickType_t)(xTaskGetTickCount() - pt->wake) < (portMAX_DELAY / 2);
+}
+
+// Function prototypes
+void pt_init(UBaseType_t priority);
+void pt_add(pt_job_t *job);
+void pt_signal(void);
+void pt_signal_from_isr(BaseType_t *woken);
+
+#endif // PT_H
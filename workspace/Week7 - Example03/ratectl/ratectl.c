@@ -0,0 +1,318 @@
+/*! ***************************************************************************
+ *
+ * \brief     Activity-adaptive sample rates
+ * \file      ratectl.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdlib.h>
+
+#include "ratectl.h"
+#include "mma8451.h"
+#include "mono.h"
+#include "serial.h"
+#include "tcrt5000.h"
+#include "xprintf.h"
+
+// Time a line of the report may wait for room in the serial transmit buffer
+#define RATECTL_BLOCK_TIME   pdMS_TO_TICKS(100)
+
+// Longest line written to the serial port, including the terminator
+#define RATECTL_LINE_LEN     (64)
+
+// Weight of a new sample in the reference of a static signal, 1 / 2^n
+#define RATECTL_REF_SHIFT    (3)
+
+static const mma8451_odr_t mma8451_odrs[RATECTL_LEVELS] = RATECTL_MMA8451_ODRS;
+static const uint16_t tcrt5000_hz[RATECTL_LEVELS] = RATECTL_TCRT5000_HZ;
+
+// Started controllers, for the report
+static ratectl_t *controllers = NULL;
+
+/*!
+ * \brief Selects a level, the time at the previous level is counted
+ *
+ * \return false if the hardware did not take the level, it is kept then
+ */
+static bool ratectl_set(ratectl_t *c, const uint32_t level, const uint32_t now)
+{
+    if(!c->apply(c->arg, level))
+    {
+        c->failures++;
+        return false;
+    }
+
+    if(c->level < RATECTL_LEVELS)
+    {
+        c->level_ms[c->level] += now - c->level_start_ms;
+    }
+
+    c->level = (uint8_t)level;
+    c->level_start_ms = now;
+    c->since_ms = now;
+
+    return true;
+}
+
+/*!
+ * \brief Starts a controller at its highest level
+ *
+ * Call after the sensor is initialised, from the task that owns it.
+ *
+ * \param[in]  c  Controller, at most RATECTL_LEVELS levels
+ *
+ * \return false if the hardware did not take the level
+ */
+bool ratectl_start(ratectl_t *c)
+{
+    const uint32_t now = mono_ms();
+
+    if((c->levels == 0) || (c->levels > RATECTL_LEVELS))
+    {
+        return false;
+    }
+
+    c->ref_valid = false;
+    c->level = RATECTL_LEVELS;
+    c->level_start_ms = now;
+
+    // Started once, a restart of the sensor starts it again
+    ratectl_t *p = controllers;
+
+    while((p != NULL) && (p != c))
+    {
+        p = p->next;
+    }
+
+    if(p == NULL)
+    {
+        c->next = controllers;
+        controllers = c;
+    }
+
+    return ratectl_set(c, c->levels - 1U, now);
+}
+
+/*!
+ * \brief Feeds a sample to a controller
+ *
+ * \param[in]  c       Controller
+ * \param[in]  values  The channels of the sample
+ * \param[in]  n       Number of channels, at most RATECTL_CHANNELS
+ *
+ * \return true if the sample is activity
+ */
+bool ratectl_update(ratectl_t *c, const int32_t values[], const uint32_t n)
+{
+    bool active = false;
+
+    for(uint32_t i=0; (i<n) && (i<RATECTL_CHANNELS); ++i)
+    {
+        if(!c->ref_valid)
+        {
+            c->ref[i] = values[i];
+        }
+        else if((uint32_t)abs(values[i] - c->ref[i]) > c->threshold)
+        {
+            c->ref[i] = values[i];
+            active = true;
+        }
+        else
+        {
+            c->ref[i] += (values[i] - c->ref[i]) / (1 << RATECTL_REF_SHIFT);
+        }
+    }
+
+    c->ref_valid = true;
+
+    if(active)
+    {
+        ratectl_activity(c);
+    }
+    else
+    {
+        ratectl_tick(c);
+    }
+
+    return active;
+}
+
+/*!
+ * \brief Selects the highest level because of activity
+ *
+ * \param[in]  c  Controller
+ */
+void ratectl_activity(ratectl_t *c)
+{
+    const uint32_t now = mono_ms();
+
+    if(c->level == (c->levels - 1U))
+    {
+        c->since_ms = now;
+        return;
+    }
+
+    if(ratectl_set(c, c->levels - 1U, now))
+    {
+        c->ups++;
+    }
+}
+
+/*!
+ * \brief Steps down a level after hold_ms without activity
+ *
+ * Called by ratectl_update(). Call it periodically as well if the samples
+ * may stop, such as when the sensor only interrupts on an event.
+ *
+ * \param[in]  c  Controller
+ */
+void ratectl_tick(ratectl_t *c)
+{
+    const uint32_t now = mono_ms();
+
+    if((c->level == 0) || ((now - c->since_ms) < c->hold_ms))
+    {
+        return;
+    }
+
+    // The highest level if none was taken yet
+    const uint32_t level = (c->level >= c->levels) ? (c->levels - 1U) :
+                                                     (c->level - 1U);
+
+    if(ratectl_set(c, level, now))
+    {
+        c->downs++;
+    }
+    else
+    {
+        // Try again after the next hold time
+        c->since_ms = now;
+    }
+}
+
+/*!
+ * \brief Returns the current level of a controller, 0 is the lowest rate
+ */
+uint32_t ratectl_level(const ratectl_t *c)
+{
+    return c->level;
+}
+
+/*!
+ * \brief Iterates over the started controllers
+ *
+ * \param[in]  c  NULL for the first controller, else the previous one
+ *
+ * \return The next controller, NULL after the last
+ */
+const ratectl_t *ratectl_next(const ratectl_t *c)
+{
+    return (c == NULL) ? controllers : c->next;
+}
+
+/*!
+ * \brief Writes the levels and the time at every level to the serial port
+ */
+void ratectl_report(void)
+{
+    char line[RATECTL_LINE_LEN];
+    const uint32_t now = mono_ms();
+
+    xSerialPutStringPolicy("\r\nRate      Lvl    Up   Down Fail  Percent at 0..3\r\n",
+                           eSerialBlock, RATECTL_BLOCK_TIME);
+
+    for(const ratectl_t *c = ratectl_next(NULL); c != NULL; c = ratectl_next(c))
+    {
+        uint32_t ms[RATECTL_LEVELS];
+        uint32_t total = 0;
+
+        for(uint32_t i=0; i<RATECTL_LEVELS; ++i)
+        {
+            ms[i] = c->level_ms[i] + ((i == c->level) ? (now - c->level_start_ms) : 0);
+            total += ms[i];
+        }
+
+        xsnprintf(line, RATECTL_LINE_LEN, "%-8s %4u %5lu %6lu %4lu ", c->name,
+                  (unsigned int)c->level, (unsigned long)c->ups,
+                  (unsigned long)c->downs, (unsigned long)c->failures);
+        xSerialPutStringPolicy(line, eSerialBlock, RATECTL_BLOCK_TIME);
+
+        for(uint32_t i=0; i<c->levels; ++i)
+        {
+            xsnprintf(line, RATECTL_LINE_LEN, " %3lu",
+                      (unsigned long)((total >= 100) ? (ms[i] / (total / 100)) : 0));
+            xSerialPutStringPolicy(line, eSerialBlock, RATECTL_BLOCK_TIME);
+        }
+
+        xSerialPutStringPolicy("\r\n", eSerialBlock, RATECTL_BLOCK_TIME);
+    }
+}
+
+/*!
+ * \brief Apply function of the MMA8451, sets the ODR of RATECTL_MMA8451_ODRS
+ *
+ * The other settings and the data interrupt are kept. Call from the task
+ * that owns the MMA8451.
+ *
+ * \param[in]  arg    Not used
+ * \param[in]  level  Level
+ */
+bool ratectl_mma8451(void *arg, const uint32_t level)
+{
+    mma8451_config_t cfg;
+
+    (void)arg;
+
+    if(level >= RATECTL_LEVELS)
+    {
+        return false;
+    }
+
+    mma8451_get_config(&cfg);
+
+    if(cfg.odr == mma8451_odrs[level])
+    {
+        return true;
+    }
+
+    cfg.odr = mma8451_odrs[level];
+
+    return mma8451_configure(&cfg);
+}
+
+/*!
+ * \brief Apply function of the TCRT5000, sets the rate of
+ *        RATECTL_TCRT5000_HZ of the interrupt mode
+ *
+ * \param[in]  arg    Not used
+ * \param[in]  level  Level
+ */
+bool ratectl_tcrt5000(void *arg, const uint32_t level)
+{
+    (void)arg;
+
+    return (level < RATECTL_LEVELS) && tcrt5000_set_rate(tcrt5000_hz[level]);
+}
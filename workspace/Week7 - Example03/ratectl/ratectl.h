@@ -0,0 +1,138 @@
+/*! ***************************************************************************
+ *
+ * \brief     Activity-adaptive sample rates
+ * \file      ratectl.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef RATECTL_H
+#define RATECTL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * A rate controller runs a sensor at the highest of its rate levels while
+ * its signal changes and steps it down to the lowest level, the power
+ * floor, while it is static. The rate is changed at the hardware source of
+ * the samples through the apply function of the controller, the ODR of the
+ * MMA8451 or the TPM1 modulo of the TCRT5000, so fewer samples are taken,
+ * converted and handled, not just fewer of them read.
+ *
+ * The owner of the sensor feeds every sample to ratectl_update(). A change
+ * of any channel by more than the threshold from its reference is activity
+ * and selects the highest level at once, so the response to an event is a
+ * single sample at the low rate. The reference follows slow drift without
+ * counting it as activity. After hold_ms without activity the controller
+ * steps down one level, and again after every further hold_ms. Events of
+ * the hardware, such as a motion interrupt, are given to ratectl_activity().
+ */
+
+/// \name Definitions for the rate controllers
+/// \{
+
+/*!
+ * \brief Highest number of channels of a sample, the axes of the MMA8451
+ */
+#define RATECTL_CHANNELS  (3)
+
+/*!
+ * \brief Number of levels of the MMA8451 and TCRT5000 rate tables
+ */
+#define RATECTL_LEVELS    (4)
+
+/*!
+ * \brief ODR of every level of ratectl_mma8451(), lowest first
+ */
+#ifndef RATECTL_MMA8451_ODRS
+#define RATECTL_MMA8451_ODRS \
+    {MMA8451_ODR_6HZ25, MMA8451_ODR_12HZ5, MMA8451_ODR_50HZ, MMA8451_ODR_100HZ}
+#endif
+
+/*!
+ * \brief Rate in Hz of every level of ratectl_tcrt5000(), lowest first
+ */
+#ifndef RATECTL_TCRT5000_HZ
+#define RATECTL_TCRT5000_HZ {6, 10, 20, 50}
+#endif
+
+/// \}
+
+/*!
+ * \brief Sets the rate of a level at the hardware
+ *
+ * \param[in]  arg    Argument of the controller
+ * \param[in]  level  0 is the lowest rate
+ *
+ * \return false if the hardware was not changed
+ */
+typedef bool (*ratectl_apply_t)(void *arg, const uint32_t level);
+
+/// A rate controller
+///
+/// Initialise with RATECTL_INIT(), start with ratectl_start(). The members
+/// after hold_ms are managed by the controller.
+typedef struct ratectl
+{
+    const char *name;           ///< Name for the report
+    ratectl_apply_t apply;      ///< Sets the rate of a level
+    void *arg;                  ///< Argument of apply
+    uint8_t levels;             ///< Number of levels
+    uint32_t threshold;         ///< Change of a channel that is activity
+    uint32_t hold_ms;           ///< Time without activity per step down
+    int32_t ref[RATECTL_CHANNELS];
+    bool ref_valid;
+    uint8_t level;
+    uint32_t since_ms;          ///< Last activity or step down
+    uint32_t ups;               ///< Steps to the highest level
+    uint32_t downs;             ///< Steps down
+    uint32_t failures;          ///< Levels the hardware did not take
+    uint32_t level_ms[RATECTL_LEVELS]; ///< Time spent at the levels
+    uint32_t level_start_ms;
+    struct ratectl *next;
+}
+ratectl_t;
+
+/*!
+ * \brief Initialiser of a rate controller
+ */
+#define RATECTL_INIT(n, fn, a, lv, ths, hold) \
+    {.name = (n), .apply = (fn), .arg = (a), .levels = (lv), \
+     .threshold = (ths), .hold_ms = (hold)}
+
+// Function prototypes
+bool ratectl_start(ratectl_t *c);
+bool ratectl_update(ratectl_t *c, const int32_t values[], const uint32_t n);
+void ratectl_activity(ratectl_t *c);
+void ratectl_tick(ratectl_t *c);
+uint32_t ratectl_level(const ratectl_t *c);
+const ratectl_t *ratectl_next(const ratectl_t *c);
+void ratectl_report(void);
+
+bool ratectl_mma8451(void *arg, const uint32_t level);
+bool ratectl_tcrt5000(void *arg, const uint32_t level);
+
+#endif // RATECTL_H
@@ -0,0 +1,415 @@
+/*! ***************************************************************************
+ *
+ * \brief     Newlib standard I/O on the serial driver
+ * \file      retarget.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <errno.h>
+#include <reent.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <MKL25Z4.h>
+
+#include "retarget.h"
+#include "task.h"
+
+/*
+ * The system calls of newlib for printf(), puts(), scanf() and the like on
+ * stdin, stdout and stderr, on a port of the serial driver.
+ *
+ * newlib passes stdout to _write() in pieces, down to single characters,
+ * when the stream is unbuffered. Every task that writes gets one of the
+ * RETARGET_BUFFERS line buffers until its line is complete, so the driver
+ * takes whole lines in one xSerialPortWrite() and the lines of tasks do not
+ * mix. The buffer is free again at the end of the line. A task that finds
+ * no free buffer, stderr, writes before the scheduler runs and the flush of
+ * a full buffer write directly.
+ *
+ * retarget_init() makes stdout unbuffered, so newlib does not take a buffer
+ * of BUFSIZ bytes from the heap of _sbrk() for it. With
+ * configUSE_NEWLIB_REENTRANT every task has its own struct _reent. The
+ * functions here keep no state in it but errno, and malloc() is serialised
+ * with the scheduler suspended, see __malloc_lock(). A newlib without
+ * global stdio streams gives every task its own stdout, which then buffers
+ * in newlib until the _sbrk() heap is exhausted and is unbuffered after.
+ * Both work, the line buffers still pass whole lines to the driver.
+ *
+ * Writes in an interrupt are dropped, the driver blocks. xSerialPrintf()
+ * formats with xprintf on the stack and is cheaper than printf(), see the
+ * 'p' command of bench/serial_bench.c.
+ *
+ * A task that is deleted in the middle of a line keeps its buffer, call
+ * retarget_flush() before.
+ */
+
+/// A line buffer
+typedef struct
+{
+    TaskHandle_t owner;     ///< Task of the line, NULL if free
+    size_t len;             ///< Characters in buf
+    char buf[RETARGET_LINE_LEN];
+}
+retarget_line_t;
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+static xComPortHandle retarget_port;
+
+static retarget_line_t lines[RETARGET_BUFFERS];
+
+// Heap of malloc(), reserved by the linker script
+extern uint8_t _pvHeapStart[];
+extern uint8_t _pvHeapLimit[];
+
+static uint8_t *heap_end = _pvHeapStart;
+
+/*----------------------------------------------------------------------------*/
+// Local functions
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Returns the port, the default port before retarget_init()
+ */
+static xComPortHandle retarget_get_port(void)
+{
+    if(retarget_port == NULL)
+    {
+        retarget_port = xSerialGetDefaultPort();
+    }
+
+    return retarget_port;
+}
+
+/*!
+ * \brief Writes the line buffer to the driver and empties it
+ */
+static void retarget_write_line(retarget_line_t *l)
+{
+    if(l->len > 0)
+    {
+        (void)xSerialPortWrite(retarget_get_port(), l->buf, l->len);
+        l->len = 0;
+    }
+}
+
+/*!
+ * \brief Adds characters to a line buffer, writes it at every line end and
+ *        when it is full
+ *
+ * \return True if the buffer ends with a complete line
+ */
+static bool retarget_put(retarget_line_t *l, const char *buf, const size_t n)
+{
+    bool eol = false;
+
+    for(size_t i=0; i<n; i++)
+    {
+        const char c = buf[i];
+
+#if (RETARGET_CRLF == 1)
+        if((c == '\n') && ((l->len == 0) || (l->buf[l->len - 1] != '\r')))
+        {
+            if(l->len == RETARGET_LINE_LEN)
+            {
+                retarget_write_line(l);
+            }
+
+            l->buf[l->len++] = '\r';
+        }
+#endif
+
+        if(l->len == RETARGET_LINE_LEN)
+        {
+            retarget_write_line(l);
+        }
+
+        l->buf[l->len++] = c;
+        eol = (c == '\n');
+
+        if(eol)
+        {
+            retarget_write_line(l);
+        }
+    }
+
+    return eol;
+}
+
+/*!
+ * \brief Returns the line buffer of the calling task
+ *
+ * \param[in]  claim  Take a free buffer if the task has none
+ *
+ * \return The buffer, NULL if the task has none
+ */
+static retarget_line_t *retarget_line(const bool claim)
+{
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    retarget_line_t *found = NULL;
+    retarget_line_t *free_line = NULL;
+
+    taskENTER_CRITICAL();
+    {
+        for(uint32_t i=0; (i<RETARGET_BUFFERS) && (found == NULL); i++)
+        {
+            if(lines[i].owner == self)
+            {
+                found = &lines[i];
+            }
+            else if((lines[i].owner == NULL) && (free_line == NULL))
+            {
+                free_line = &lines[i];
+            }
+        }
+
+        if((found == NULL) && claim && (free_line != NULL))
+        {
+            free_line->owner = self;
+            found = free_line;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return found;
+}
+
+/*!
+ * \brief Writes characters without a line buffer of a task, formatted as
+ *        the line buffers do
+ */
+static void retarget_put_direct(const char *buf, const size_t n)
+{
+    retarget_line_t l = {.owner = NULL, .len = 0};
+
+    (void)retarget_put(&l, buf, n);
+    retarget_write_line(&l);
+}
+
+/*----------------------------------------------------------------------------*/
+// Public functions
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Sets the port of stdin, stdout and stderr and makes stdout
+ *        unbuffered in newlib, the line buffers here buffer it
+ *
+ * \param[in]  port  Opened serial port
+ */
+void retarget_init(xComPortHandle port)
+{
+    retarget_port = port;
+
+    (void)setvbuf(stdout, NULL, _IONBF, 0);
+}
+
+/*!
+ * \brief Writes the unfinished line of the calling task, before a prompt
+ *        is read or the task is deleted
+ */
+void retarget_flush(void)
+{
+    if(xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED)
+    {
+        return;
+    }
+
+    retarget_line_t *l = retarget_line(false);
+
+    if(l != NULL)
+    {
+        retarget_write_line(l);
+        l->owner = NULL;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+// System calls of newlib
+/*----------------------------------------------------------------------------*/
+
+int _write(int fd, const char *buf, int len)
+{
+    if((fd != STDOUT_FILENO) && (fd != STDERR_FILENO))
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    if((len <= 0) || (__get_IPSR() != 0))
+    {
+        return len;
+    }
+
+    if(xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED)
+    {
+        retarget_put_direct(buf, (size_t)len);
+        return len;
+    }
+
+    if(fd == STDERR_FILENO)
+    {
+        // Unbuffered, after what the task has written to stdout
+        retarget_flush();
+        retarget_put_direct(buf, (size_t)len);
+        return len;
+    }
+
+    retarget_line_t *l = retarget_line(true);
+
+    if(l == NULL)
+    {
+        retarget_put_direct(buf, (size_t)len);
+    }
+    else if(retarget_put(l, buf, (size_t)len))
+    {
+        // Only the owner writes its buffer, no lock is needed to free it
+        l->owner = NULL;
+    }
+
+    return len;
+}
+
+int _read(int fd, char *buf, int len)
+{
+    size_t n = 0;
+
+    if(fd != STDIN_FILENO)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    // The prompt of the task first
+    retarget_flush();
+
+    while((n == 0) && (len > 0))
+    {
+#if (serUSE_DMA_RX == 1)
+        n = xSerialGetFrame(buf, (size_t)len, portMAX_DELAY);
+#else
+        n = xSerialPortRead(retarget_get_port(), buf, (size_t)len, portMAX_DELAY);
+#endif
+    }
+
+    return (int)n;
+}
+
+int _close(int fd)
+{
+    (void)fd;
+
+    errno = EBADF;
+    return -1;
+}
+
+int _fstat(int fd, struct stat *st)
+{
+    (void)fd;
+
+    (void)memset(st, 0, sizeof(*st));
+    st->st_mode = S_IFCHR;
+
+    return 0;
+}
+
+int _isatty(int fd)
+{
+    return (fd >= STDIN_FILENO) && (fd <= STDERR_FILENO);
+}
+
+int _lseek(int fd, int offset, int whence)
+{
+    (void)fd;
+    (void)offset;
+    (void)whence;
+
+    errno = ESPIPE;
+    return -1;
+}
+
+int _getpid(void)
+{
+    return 1;
+}
+
+int _kill(int pid, int sig)
+{
+    (void)pid;
+    (void)sig;
+
+    errno = EINVAL;
+    return -1;
+}
+
+/*!
+ * \brief Grows the heap of malloc() in the .heap section of the linker
+ *        script, called with __malloc_lock() held
+ */
+void *_sbrk(ptrdiff_t incr)
+{
+    uint8_t *prev = heap_end;
+
+    if((incr > (_pvHeapLimit - heap_end)) || (incr < (_pvHeapStart - heap_end)))
+    {
+        errno = ENOMEM;
+        return (void *)-1;
+    }
+
+    heap_end += incr;
+
+    return prev;
+}
+
+/*!
+ * \brief Serialises malloc() and free() of the tasks, newlib nests the
+ *        calls
+ */
+void __malloc_lock(struct _reent *r)
+{
+    (void)r;
+
+    if(xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+    {
+        vTaskSuspendAll();
+    }
+}
+
+void __malloc_unlock(struct _reent *r)
+{
+    (void)r;
+
+    if(xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+    {
+        (void)xTaskResumeAll();
+    }
+}
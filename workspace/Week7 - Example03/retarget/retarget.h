@@ -0,0 +1,69 @@
+/*! ***************************************************************************
+ *
+ * \brief     Newlib standard I/O on the serial driver
+ * \file      retarget.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef RETARGET_H
+#define RETARGET_H
+
+#include "FreeRTOS.h"
+#include "serial.h"
+
+/// \name Definitions for the standard I/O retarget
+/// \{
+
+/*!
+ * \brief Characters of a line buffer, a longer line is written in parts
+ */
+#ifndef RETARGET_LINE_LEN
+#define RETARGET_LINE_LEN   (80)
+#endif
+
+/*!
+ * \brief Line buffers, one per task that has an unfinished line. A task
+ *        that finds none free writes directly to the driver.
+ */
+#ifndef RETARGET_BUFFERS
+#define RETARGET_BUFFERS    (4)
+#endif
+
+/*!
+ * \brief Set to 1 to write a '\n' as "\r\n", as the rest of the firmware
+ *        ends its lines
+ */
+#ifndef RETARGET_CRLF
+#define RETARGET_CRLF       (1)
+#endif
+
+/// \}
+
+// Function prototypes
+void retarget_init(xComPortHandle port);
+void retarget_flush(void);
+
+#endif // RETARGET_H
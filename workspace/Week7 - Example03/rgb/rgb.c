@@ -29,8 +29,49 @@
  *            OTHER DEALINGS IN THE SOFTWARE.
  *
  *****************************************************************************/
+#include <stddef.h>
+
 #include "rgb.h"
 
+#include "bme.h"
+#include "clock.h"
+#include "dma.h"
+#include "irq_prio.h"
+#include "sections.h"
+
+#if (RGB_DMA_CHANNEL < DMA_ANY) || (RGB_DMA_CHANNEL >= DMA_CHANNELS)
+#error "RGB_DMA_CHANNEL must be 0, 1, 2, 3 or DMA_ANY"
+#endif
+
+// One period of the playing effect, read by the DMA
+static __BSS_SRAM_U uint16_t fx_table[RGB_FX_MAX_STEPS];
+
+// State of the playing effect
+static uint32_t fx_steps = 0;
+static volatile uint32_t fx_remaining = 0;
+static volatile bool fx_forever = false;
+static TPM_Type *fx_tpm = NULL;
+static int32_t fx_ch = -1;
+
+// The playing effect, played again after a clock mode change
+static rgb_effect_t fx_effect;
+static uint32_t fx_period_ms;
+
+// Levels of the LEDs in 8.16 fixed point, the colour a fade starts from
+static uint32_t fd_level[3];
+
+// State of the fade
+static int32_t fd_step[3];
+static uint32_t fd_target[3];
+static volatile uint32_t fd_remaining = 0;
+
+// Registration for clock mode changes
+static clk_notifier_t clock;
+
+static void rgb_clock(const clk_event_t event, void *arg);
+static void rgb_fade_stop(void);
+static void rgb_dma_isr(void *arg, const uint32_t status, BaseType_t *woken);
+
 /*!
  * \brief Initialises the onboard RGB LED
  *
@@ -47,7 +88,8 @@ void rgb_init(void)
     SIM->SCGC5 |= SIM_SCGC5_PORTB(1) | SIM_SCGC5_PORTD(1);
 
     // Enable clock to TPMs
-    SIM->SCGC6 |= SIM_SCGC6_TPM0(1) | SIM_SCGC6_TPM2(1);
+    clk_gate_acquire(CLK_GATE_TPM0);
+    clk_gate_acquire(CLK_GATE_TPM2);
     
     // The actual TPM source clock frequency is determined by the setting 
     // in the file system_MKL25Z4.h. If CLOCK_SETUP == 1, which is the default 
@@ -58,6 +100,10 @@ void rgb_init(void)
     // This means that the MCGPLLCLK/2 option is selected. If CLOCK_SETUP == 1,
     // the MCGPLLCLK is equal to 96 MHz, so the TPM modules are clocked with a 
     // frequency of 96 MHz / 2 = 48 MHz.
+    //
+    // The clock manager changes the TPM clock with the clock mode, see
+    // clk_periph_hz(). The PWM then keeps its duty cycle.
+    clk_register(&clock, rgb_clock, NULL);
 
     // Select alternative functions on the pins connected to the RGB LEDs
     // PTB18 (red)  : TPM2_CH0
@@ -69,7 +115,8 @@ void rgb_init(void)
     PORTD->PCR[1]  = PORT_PCR_MUX(4);
     PORTD->PCR[2]  = PORT_PCR_MUX(4);
 
-    // Set initial values: all LEDs off
+    // Set initial values: all LEDs off. The counters are stopped, so the
+    // values are written immediately.
     rgb_pwmcontrol(0,0,0);
     
     // Set modulo value. We use the full 16-bit range, which allows us to 
@@ -91,10 +138,26 @@ void rgb_init(void)
     TPM0->CONTROLS[2].CnSC = TPM_CnSC_MSB(1) | TPM_CnSC_ELSB(1);
 
     // Start TPMs. Prescaler are kept at the default values: 1.
+    //
+    // From now on a write to CnV is buffered in edge-aligned PWM mode. The
+    // new value takes effect when the counter overflows from MOD to 0, so a
+    // write never cuts a period short or adds a pulse to it.
     TPM2->SC = TPM_SC_CMOD(1);
     TPM0->SC = TPM_SC_CMOD(1);
+
+    // The overflow interrupt of TPM2 steps a fade, it is enabled by
+    // rgb_fade() only
+    NVIC_SetPriority(TPM2_IRQn, IRQ_PRIO(RGB));
+    NVIC_ClearPendingIRQ(TPM2_IRQn);
+    NVIC_EnableIRQ(TPM2_IRQn);
 }
 
+/*!
+ * \brief Sets the compare values of the LEDs
+ *
+ * The values are raw duty cycles, without gamma correction and calibration.
+ * They take effect at the next overflow of the TPMs.
+ */
 inline void rgb_pwmcontrol(const uint16_t r, const uint16_t g, const uint16_t b)
 {
     // Set the channel compare values
@@ -103,39 +166,398 @@ inline void rgb_pwmcontrol(const uint16_t r, const uint16_t g, const uint16_t b)
     TPM0->CONTROLS[1].CnV = b;
 }
 
+/*!
+ * \brief Writes the levels of the LEDs to the CnV registers
+ */
+static void rgb_apply(void)
+{
+    rgb_pwmcontrol(rgb_compare(RGB_RED, (uint16_t)(fd_level[RGB_RED] >> 8)),
+                   rgb_compare(RGB_GREEN, (uint16_t)(fd_level[RGB_GREEN] >> 8)),
+                   rgb_compare(RGB_BLUE, (uint16_t)(fd_level[RGB_BLUE] >> 8)));
+}
+
+/*!
+ * \brief Switches the LEDs on at RGB_ON_LEVEL or off
+ *
+ * A fade is stopped first.
+ */
 inline void rgb_on(const bool r, const bool g, const bool b)
 {
-    // Set convenient on values for each color here
-    uint16_t red = 1000;
-    uint16_t green = 1000;
-    uint16_t blue = 3000;
+    rgb_fade_stop();
 
-    // Set the channel compare values
-    TPM2->CONTROLS[0].CnV = r ? red : 0;
-    TPM2->CONTROLS[1].CnV = g ? green : 0;
-    TPM0->CONTROLS[1].CnV = b ? blue : 0;
+    fd_level[RGB_RED] = r ? (RGB_ON_LEVEL << 16) : 0;
+    fd_level[RGB_GREEN] = g ? (RGB_ON_LEVEL << 16) : 0;
+    fd_level[RGB_BLUE] = b ? (RGB_ON_LEVEL << 16) : 0;
+
+    rgb_apply();
 }
 
 void rgb_red_on(const bool r)
 {
-    uint16_t red = 1000;
+    rgb_fade_stop();
+    fd_level[RGB_RED] = r ? (RGB_ON_LEVEL << 16) : 0;
 
     // Set the channel compare value
-    TPM2->CONTROLS[0].CnV = r ? red : 0;
+    TPM2->CONTROLS[0].CnV = rgb_compare(RGB_RED, (uint16_t)(fd_level[RGB_RED] >> 8));
 }
 
 void rgb_green_on(const bool g)
 {
-    uint16_t green = 1000;
+    rgb_fade_stop();
+    fd_level[RGB_GREEN] = g ? (RGB_ON_LEVEL << 16) : 0;
 
     // Set the channel compare value
-    TPM2->CONTROLS[1].CnV = g ? green : 0;
+    TPM2->CONTROLS[1].CnV = rgb_compare(RGB_GREEN, (uint16_t)(fd_level[RGB_GREEN] >> 8));
 }
 
 void rgb_blue_on(const bool b)
 {
-    uint16_t blue = 3000;
+    rgb_fade_stop();
+    fd_level[RGB_BLUE] = b ? (RGB_ON_LEVEL << 16) : 0;
 
     // Set the channel compare value
-    TPM0->CONTROLS[1].CnV = b ? blue : 0;
+    TPM0->CONTROLS[1].CnV = rgb_compare(RGB_BLUE, (uint16_t)(fd_level[RGB_BLUE] >> 8));
+}
+
+/*!
+ * \brief Sets a colour
+ *
+ * The levels are gamma corrected and calibrated, see rgb_compare(). The
+ * colour takes effect at the next overflow of the TPMs. A playing effect or
+ * fade is stopped first.
+ *
+ * \param[in]  color  The colour
+ */
+void rgb_set(const rgb_color_t *color)
+{
+    rgb_stop();
+    rgb_fade_stop();
+
+    fd_level[RGB_RED] = (uint32_t)color->r << 16;
+    fd_level[RGB_GREEN] = (uint32_t)color->g << 16;
+    fd_level[RGB_BLUE] = (uint32_t)color->b << 16;
+
+    rgb_apply();
+}
+
+/*!
+ * \brief Fades to a colour without CPU load from a task
+ *
+ * The fade starts from the colour of the last rgb_set(), rgb_fade() or
+ * rgb_on(). The overflow interrupt of TPM2 steps the levels once every PWM
+ * period and writes the CnV registers, which take effect at the next
+ * overflow. Every period so has one level and the levels are interpolated
+ * between the entries of the gamma table, there are no visible steps. The
+ * interrupt is disabled at the end of the fade. A playing effect or fade is
+ * stopped first. A clock mode change during a fade changes its duration.
+ *
+ * \param[in]  color  The colour at the end of the fade
+ * \param[in]  ms     Duration of the fade in ms, at most RGB_FADE_MAX_MS
+ *
+ * \return False if the duration is out of range
+ */
+bool rgb_fade(const rgb_color_t *color, const uint32_t ms)
+{
+    if(ms > RGB_FADE_MAX_MS)
+    {
+        return false;
+    }
+
+    const uint32_t periods = (ms * (clk_periph_hz() / 1000UL)) / 65536UL;
+
+    if(periods < 2)
+    {
+        rgb_set(color);
+        return true;
+    }
+
+    rgb_stop();
+    rgb_fade_stop();
+
+    fd_target[RGB_RED] = (uint32_t)color->r << 16;
+    fd_target[RGB_GREEN] = (uint32_t)color->g << 16;
+    fd_target[RGB_BLUE] = (uint32_t)color->b << 16;
+
+    for(uint32_t i=0; i<3; i++)
+    {
+        fd_step[i] = ((int32_t)fd_target[i] - (int32_t)fd_level[i]) /
+                     (int32_t)periods;
+    }
+
+    fd_remaining = periods;
+
+    // The first step is at the next overflow
+    TPM2->STATUS = TPM_STATUS_TOF(1);
+    BME_OR(TPM2->SC, TPM_SC_TOIE_MASK);
+
+    return true;
+}
+
+/*!
+ * \brief Returns true while a fade runs
+ */
+bool rgb_fading(void)
+{
+    return fd_remaining != 0;
+}
+
+/*!
+ * \brief Stops a fade, the LEDs keep the last level
+ */
+static void rgb_fade_stop(void)
+{
+    BME_CLR(TPM2->SC, TPM_SC_TOIE_MASK);
+    fd_remaining = 0;
+}
+
+/*!
+ * \brief Steps the fade at every overflow of TPM2
+ *
+ * The TPM0 counter is not in phase with TPM2, but both have the same
+ * period. The blue value takes effect at the next overflow of TPM0, so it
+ * also holds for one full period.
+ */
+void TPM2_IRQHandler(void)
+{
+    // Clear the flag
+    TPM2->STATUS = TPM_STATUS_TOF(1);
+
+    // The interrupt can be pending when a fade was stopped
+    if(fd_remaining == 0)
+    {
+        return;
+    }
+
+    if(--fd_remaining > 0)
+    {
+        for(uint32_t i=0; i<3; i++)
+        {
+            fd_level[i] += (uint32_t)fd_step[i];
+        }
+    }
+    else
+    {
+        // The last step ends at the colour without a rounding error
+        for(uint32_t i=0; i<3; i++)
+        {
+            fd_level[i] = fd_target[i];
+        }
+
+        BME_CLR(TPM2->SC, TPM_SC_TOIE_MASK);
+    }
+
+    rgb_apply();
+}
+
+/*!
+ * \brief Computes the compare value of an effect at a step
+ */
+static uint16_t rgb_fx_value(const rgb_effect_t *effect, const uint32_t step,
+    const uint32_t steps)
+{
+    // Position in the period, 0 to 65535
+    const uint32_t x = (step * 0x10000UL) / steps;
+
+    // Triangle, 0 at the start and end, 65535 halfway
+    const uint32_t tri = (x < 0x8000UL) ? (x * 2) : ((0xFFFFUL - x) * 2);
+
+    uint32_t level;
+
+    switch(effect->waveform)
+    {
+    case RGB_FX_BREATHE:
+        level = (tri * tri) >> 16;
+        break;
+    case RGB_FX_TRIANGLE:
+        level = tri;
+        break;
+    case RGB_FX_RAMP_UP:
+        level = x;
+        break;
+    case RGB_FX_RAMP_DOWN:
+        level = 0xFFFFUL - x;
+        break;
+    case RGB_FX_BLINK:
+    default:
+        level = (x < 0x8000UL) ? 0xFFFFUL : 0;
+        break;
+    }
+
+    return (uint16_t)((level * effect->peak) >> 16);
+}
+
+/*!
+ * \brief Starts a pass of the effect table
+ */
+static void rgb_fx_start_pass(void)
+{
+    DMA0->DMA[fx_ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    DMA0->DMA[fx_ch].SAR = (uint32_t)fx_table;
+    DMA0->DMA[fx_ch].DSR_BCR = DMA_DSR_BCR_BCR(fx_steps * sizeof(fx_table[0]));
+    DMA0->DMA[fx_ch].DCR |= DMA_DCR_ERQ_MASK;
+}
+
+/*!
+ * \brief Plays an effect on one LED without CPU load
+ *
+ * One period of the effect is computed into a table. On every overflow of
+ * the TPM of the LED, DMA channel RGB_DMA_CHANNEL writes the next value of
+ * the table to the CnV register of the LED, so the effect has a step of
+ * RGB_FX_STEP_US. The CPU only runs at the end of every period, to start the
+ * next one. A playing effect or fade is stopped first. rgb_pwmcontrol() and
+ * the other functions must not change the LED while the effect plays.
+ *
+ * \param[in]  effect     The effect
+ * \param[in]  period_ms  Period of the effect, at most RGB_FX_MAX_PERIOD_MS
+ * \param[in]  repeat     Number of periods, or RGB_FX_FOREVER
+ *
+ * \return False if the period is out of range or the DMA channel is used
+ *         by another driver
+ */
+bool rgb_play(const rgb_effect_t *effect, const uint32_t period_ms,
+    const uint32_t repeat)
+{
+    const uint32_t steps = (period_ms * (clk_periph_hz() / 1000UL)) / 65536UL;
+
+    rgb_stop();
+    rgb_fade_stop();
+
+    if((steps < 2) || (steps > RGB_FX_MAX_STEPS))
+    {
+        return false;
+    }
+
+    const int32_t ch = dma_claim(RGB_DMA_CHANNEL, rgb_dma_isr, NULL);
+
+    if(ch < 0)
+    {
+        return false;
+    }
+
+    for(uint32_t i=0; i<steps; i++)
+    {
+        fx_table[i] = rgb_fx_value(effect, i, steps);
+    }
+
+    fx_effect = *effect;
+    fx_period_ms = period_ms;
+    fx_steps = steps;
+    fx_remaining = repeat;
+    fx_forever = (repeat == RGB_FX_FOREVER);
+
+    // Destination and DMA request of the LED
+    dma_source_t source;
+    volatile uint32_t *cnv;
+
+    switch(effect->led)
+    {
+    case RGB_RED:
+        fx_tpm = TPM2;
+        cnv = &TPM2->CONTROLS[0].CnV;
+        source = DMA_SOURCE_TPM2_OVERFLOW;
+        break;
+    case RGB_GREEN:
+        fx_tpm = TPM2;
+        cnv = &TPM2->CONTROLS[1].CnV;
+        source = DMA_SOURCE_TPM2_OVERFLOW;
+        break;
+    case RGB_BLUE:
+    default:
+        fx_tpm = TPM0;
+        cnv = &TPM0->CONTROLS[1].CnV;
+        source = DMA_SOURCE_TPM0_OVERFLOW;
+        break;
+    }
+
+    fx_ch = ch;
+
+    // Cycle steal: one 16-bit transfer per overflow, from the next table
+    // entry to the fixed CnV register. ERQ is cleared at the end of a pass.
+    DMA0->DMA[ch].DAR = (uint32_t)cnv;
+    DMA0->DMA[ch].DCR = DMA_DCR_EINT_MASK |
+                        DMA_DCR_CS_MASK |
+                        DMA_DCR_SINC_MASK |
+                        DMA_DCR_SSIZE(2) |
+                        DMA_DCR_DSIZE(2) |
+                        DMA_DCR_D_REQ_MASK;
+
+    dma_route(ch, source, false);
+
+    // End of a pass interrupt
+    dma_irq_enable(ch, IRQ_PRIO(RGB_DMA));
+
+    rgb_fx_start_pass();
+
+    // The overflow flag requests the DMA instead of an interrupt
+    BME_OR(fx_tpm->SC, TPM_SC_DMA_MASK);
+
+    return true;
+}
+
+/*!
+ * \brief Plays the playing effect again after a clock mode change
+ *
+ * The table is computed for the step of the new TPM clock. An effect with a
+ * limited number of periods plays the periods that were left.
+ */
+static void rgb_clock(const clk_event_t event, void *arg)
+{
+    (void)arg;
+
+    if((event != CLK_POST_CHANGE) || (fx_tpm == NULL))
+    {
+        return;
+    }
+
+    const rgb_effect_t effect = fx_effect;
+    const uint32_t repeat = fx_forever ? RGB_FX_FOREVER : fx_remaining;
+
+    (void)rgb_play(&effect, fx_period_ms, repeat);
+}
+
+/*!
+ * \brief Stops the playing effect
+ *
+ * The LED keeps the last value that was written.
+ */
+void rgb_stop(void)
+{
+    if(fx_tpm == NULL)
+    {
+        return;
+    }
+
+    BME_CLR(fx_tpm->SC, TPM_SC_DMA_MASK);
+    fx_tpm = NULL;
+
+    dma_release(fx_ch);
+    fx_ch = -1;
+}
+
+/*!
+ * \brief Returns true while an effect plays
+ */
+bool rgb_playing(void)
+{
+    return fx_tpm != NULL;
+}
+
+/*!
+ * \brief End of a pass of the effect table, called by the interrupt handler
+ *        of the DMA channel
+ */
+static void rgb_dma_isr(void *arg, const uint32_t status, BaseType_t *woken)
+{
+    (void)arg;
+    (void)status;
+    (void)woken;
+
+    if(fx_forever || (--fx_remaining > 0))
+    {
+        rgb_fx_start_pass();
+    }
+    else
+    {
+        rgb_stop();
+    }
 }
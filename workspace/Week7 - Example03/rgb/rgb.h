@@ -35,7 +35,135 @@
 #include <MKL25Z4.h>
 #include <stdbool.h>
 
+/// \name Definitions for the effect engine
+/// \{
+
+/*!
+ * \brief DMA channel that writes the effect to the CnV register
+ *
+ * Claimed from the DMA manager while an effect plays, DMA_ANY for the
+ * highest free channel. Channel 3 is shared with TCRT5000_DMA_CHANNEL, which
+ * is not used together with the effects.
+ */
+#ifndef RGB_DMA_CHANNEL
+#define RGB_DMA_CHANNEL (3)
+#endif
+
+/*!
+ * \brief Maximum number of PWM periods in one period of an effect
+ */
+#ifndef RGB_FX_MAX_STEPS
+#define RGB_FX_MAX_STEPS (512)
+#endif
+
+/*!
+ * \brief Duration of one step of an effect in us
+ *
+ * A step is one PWM period, 65536 counts of the TPM clock. This is the step
+ * at the 48 MHz of CLK_RUN, the step is 3277 us in CLK_FLL and 8192 us in
+ * CLK_VLPR. A playing effect is recomputed after a clock mode change, so it
+ * keeps its period.
+ */
+#define RGB_FX_STEP_US (1365)
+
+/*!
+ * \brief Longest period of an effect in ms, in all clock modes
+ */
+#define RGB_FX_MAX_PERIOD_MS ((RGB_FX_MAX_STEPS * 65536UL) / 48000UL)
+
+/// Repeat count of rgb_play() that plays an effect until rgb_stop()
+#define RGB_FX_FOREVER (0)
+
+/// \}
+
+/// \name Definitions for the colour API
+/// \{
+
+/*!
+ * \brief Compare value of the red LED at full brightness
+ *
+ * The blue LED is the least efficient, red and green are scaled down to
+ * balance it. See rgb_calibrate().
+ */
+#ifndef RGB_CAL_RED
+#define RGB_CAL_RED (21845)
+#endif
+
+/*!
+ * \brief Compare value of the green LED at full brightness
+ */
+#ifndef RGB_CAL_GREEN
+#define RGB_CAL_GREEN (21845)
+#endif
+
+/*!
+ * \brief Compare value of the blue LED at full brightness
+ */
+#ifndef RGB_CAL_BLUE
+#define RGB_CAL_BLUE (65535)
+#endif
+
+/*!
+ * \brief Level of the LEDs that rgb_on() switches on, 0 to 255
+ *
+ * Level 64 gives the compare values 1043, 1043 and 3131 with the default
+ * calibration.
+ */
+#ifndef RGB_ON_LEVEL
+#define RGB_ON_LEVEL (64)
+#endif
+
+/*!
+ * \brief Longest fade of rgb_fade() in ms
+ */
+#define RGB_FADE_MAX_MS (60000)
+
+/// \}
+
+/// LED of the RGB LED
+typedef enum
+{
+    RGB_RED = 0,
+    RGB_GREEN,
+    RGB_BLUE,
+}rgb_led_t;
+
+/// Waveform of one period of an effect
+typedef enum
+{
+    RGB_FX_BREATHE,   ///< Quadratic fade in and out, looks linear to the eye
+    RGB_FX_TRIANGLE,  ///< Linear fade in and out
+    RGB_FX_RAMP_UP,   ///< Linear fade in, then off
+    RGB_FX_RAMP_DOWN, ///< On, then linear fade out
+    RGB_FX_BLINK,     ///< On for the first half, off for the second half
+}rgb_waveform_t;
+
+/// An effect of one LED
+typedef struct
+{
+    rgb_waveform_t waveform;
+    rgb_led_t led;
+    uint16_t peak;    ///< Compare value at the peak of the waveform
+}rgb_effect_t;
+
+/// A colour, every LED has a perceived brightness from 0 to 255
+typedef struct
+{
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+}rgb_color_t;
+
 void rgb_init(void);
+void rgb_set(const rgb_color_t *color);
+bool rgb_fade(const rgb_color_t *color, const uint32_t ms);
+bool rgb_fading(void);
+void rgb_calibrate(const uint16_t r, const uint16_t g, const uint16_t b);
+uint16_t rgb_compare(const rgb_led_t led, const uint16_t level);
+bool rgb_play(const rgb_effect_t *effect, const uint32_t period_ms,
+              const uint32_t repeat);
+void rgb_stop(void);
+bool rgb_playing(void);
 void rgb_on(const bool r, const bool g, const bool b);
 void rgb_pwmcontrol(const uint16_t r, const uint16_t g, const uint16_t b);
 
@@ -0,0 +1,120 @@
+/*! ***************************************************************************
+ *
+ * \brief     Gamma correction and calibration of the onboard RGB LED
+ * \file      rgb_color.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "rgb.h"
+
+// Perceived brightness to light output, round(65535 * (i / 255) ^ 2.2)
+static const uint16_t gamma_table[256] =
+{
+        0,     0,     2,     4,     7,    11,    17,    24,
+       32,    42,    53,    65,    79,    94,   111,   129,
+      148,   169,   192,   216,   242,   270,   299,   330,
+      362,   396,   432,   469,   508,   549,   591,   635,
+      681,   729,   779,   830,   883,   938,   995,  1053,
+     1113,  1175,  1239,  1305,  1373,  1443,  1514,  1587,
+     1663,  1740,  1819,  1900,  1983,  2068,  2155,  2243,
+     2334,  2427,  2521,  2618,  2717,  2817,  2920,  3024,
+     3131,  3240,  3350,  3463,  3578,  3694,  3813,  3934,
+     4057,  4182,  4309,  4438,  4570,  4703,  4838,  4976,
+     5115,  5257,  5401,  5547,  5695,  5845,  5998,  6152,
+     6309,  6468,  6629,  6792,  6957,  7124,  7294,  7466,
+     7640,  7816,  7994,  8175,  8358,  8543,  8730,  8919,
+     9111,  9305,  9501,  9699,  9900, 10102, 10307, 10515,
+    10724, 10936, 11150, 11366, 11585, 11806, 12029, 12254,
+    12482, 12712, 12944, 13179, 13416, 13655, 13896, 14140,
+    14386, 14635, 14885, 15138, 15394, 15652, 15912, 16174,
+    16439, 16706, 16975, 17247, 17521, 17798, 18077, 18358,
+    18642, 18928, 19216, 19507, 19800, 20095, 20393, 20694,
+    20996, 21301, 21609, 21919, 22231, 22546, 22863, 23182,
+    23504, 23829, 24156, 24485, 24817, 25151, 25487, 25826,
+    26168, 26512, 26858, 27207, 27558, 27912, 28268, 28627,
+    28988, 29351, 29717, 30086, 30457, 30830, 31206, 31585,
+    31966, 32349, 32735, 33124, 33514, 33908, 34304, 34702,
+    35103, 35507, 35913, 36321, 36732, 37146, 37562, 37981,
+    38402, 38825, 39252, 39680, 40112, 40546, 40982, 41421,
+    41862, 42306, 42753, 43202, 43654, 44108, 44565, 45025,
+    45487, 45951, 46418, 46888, 47360, 47835, 48313, 48793,
+    49275, 49761, 50249, 50739, 51232, 51728, 52226, 52727,
+    53230, 53736, 54245, 54756, 55270, 55787, 56306, 56828,
+    57352, 57879, 58409, 58941, 59476, 60014, 60554, 61097,
+    61642, 62190, 62741, 63295, 63851, 64410, 64971, 65535,
+};
+
+// Compare value of every LED at full brightness
+static uint16_t calibration[3] =
+{
+    [RGB_RED]   = RGB_CAL_RED,
+    [RGB_GREEN] = RGB_CAL_GREEN,
+    [RGB_BLUE]  = RGB_CAL_BLUE,
+};
+
+/*!
+ * \brief Sets the compare value of every LED at full brightness
+ *
+ * The LEDs differ in efficiency, the values balance them so that equal
+ * levels give white. The defaults are RGB_CAL_RED, RGB_CAL_GREEN and
+ * RGB_CAL_BLUE. A changed calibration is applied by the next rgb_set(),
+ * rgb_fade() or rgb_on().
+ *
+ * \param[in]  r  Compare value of the red LED at level 255
+ * \param[in]  g  Compare value of the green LED at level 255
+ * \param[in]  b  Compare value of the blue LED at level 255
+ */
+void rgb_calibrate(const uint16_t r, const uint16_t g, const uint16_t b)
+{
+    calibration[RGB_RED] = r;
+    calibration[RGB_GREEN] = g;
+    calibration[RGB_BLUE] = b;
+}
+
+/*!
+ * \brief Returns the compare value of an LED at a level
+ *
+ * The level is the perceived brightness in 8.8 fixed point, 0 is off and
+ * 0xFF00 is level 255. The fraction interpolates between the entries of the
+ * gamma table, so a slow fade has no visible steps at low levels.
+ *
+ * \param[in]  led    The LED
+ * \param[in]  level  Perceived brightness, 0 to 0xFF00
+ *
+ * \return The calibrated compare value
+ */
+uint16_t rgb_compare(const rgb_led_t led, const uint16_t level)
+{
+    const uint32_t i = level >> 8;
+    uint32_t light = gamma_table[i];
+
+    if(i < 255)
+    {
+        light += ((gamma_table[i + 1] - light) * (level & 0xFFU)) >> 8;
+    }
+
+    return (uint16_t)((light * (calibration[led] + 1UL)) >> 16);
+}
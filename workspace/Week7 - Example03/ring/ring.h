@@ -0,0 +1,328 @@
+/*! ***************************************************************************
+ *
+ * \brief     Lock-free single producer, single consumer ring buffers
+ * \file      ring.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef RING_H
+#define RING_H
+
+#include <MKL25Z4.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * A ring holds a power of two number of fixed size records, a byte ring has
+ * records of one byte. head is only written by the producer and tail only by
+ * the consumer. Both count freely, their difference is the fill, so a full
+ * ring uses all records. A single word store is atomic on the Cortex-M0+,
+ * so an index is published with one store behind a barrier and no
+ * interrupts are masked. Use one ring per direction, with exactly one
+ * producer, an interrupt handler or a task, and one consumer task.
+ *
+ * The consumer may wait with ring_wait() until the watermark is reached.
+ * The producer notifies it with ring_put() or ring_put_from_isr() on the
+ * task notification index given to ring_init(), which must not be used by
+ * the consumer task for anything else.
+ */
+
+/// A ring, set up with ring_init()
+typedef struct
+{
+    uint8_t *buf;               ///< (mask + 1) * size bytes
+    uint32_t mask;              ///< Number of records - 1
+    uint32_t size;              ///< Bytes per record
+    volatile uint32_t head;     ///< Records written, by the producer
+    volatile uint32_t tail;     ///< Records read, by the consumer
+    volatile uint32_t watermark;///< Fill that notifies the consumer
+    TaskHandle_t volatile task; ///< Consumer in ring_wait(), or NULL
+    UBaseType_t index;          ///< Task notification index
+    volatile uint32_t dropped;  ///< Records not written, the ring was full
+}
+ring_t;
+
+/*!
+ * \brief Sets up an empty ring
+ *
+ * \param[out] r      Ring
+ * \param[in]  buf    Storage of n * size bytes, kept by reference
+ * \param[in]  n      Number of records, a power of two
+ * \param[in]  size   Bytes per record, 1 for a byte ring
+ * \param[in]  index  Task notification index of the consumer
+ */
+static inline void ring_init(ring_t *r, void *buf, const uint32_t n,
+    const uint32_t size, const UBaseType_t index)
+{
+    configASSERT((n != 0) && ((n & (n - 1)) == 0));
+
+    r->buf = (uint8_t *)buf;
+    r->mask = n - 1;
+    r->size = size;
+    r->head = 0;
+    r->tail = 0;
+    r->watermark = 1;
+    r->task = NULL;
+    r->index = index;
+    r->dropped = 0;
+}
+
+/*!
+ * \brief Returns the number of records in the ring
+ */
+static inline uint32_t ring_count(const ring_t *r)
+{
+    return r->head - r->tail;
+}
+
+/*!
+ * \brief Returns the number of records that can be written
+ */
+static inline uint32_t ring_space(const ring_t *r)
+{
+    return (r->mask + 1) - (r->head - r->tail);
+}
+
+/*!
+ * \brief Sets the fill that notifies the consumer
+ *
+ * \param[in,out] r  Ring
+ * \param[in]     n  Watermark, 1 to the number of records
+ */
+static inline void ring_set_watermark(ring_t *r, const uint32_t n)
+{
+    if((n >= 1) && (n <= (r->mask + 1)))
+    {
+        r->watermark = n;
+    }
+}
+
+/*!
+ * \brief Writes a record, producer only
+ *
+ * Does not notify the consumer, see ring_put() and ring_put_from_isr().
+ *
+ * \param[in,out] r    Ring
+ * \param[in]     rec  Record of r->size bytes
+ *
+ * \return false if the ring is full, the record is dropped and counted
+ */
+static inline bool ring_write(ring_t *r, const void *rec)
+{
+    const uint32_t head = r->head;
+
+    if((head - r->tail) > r->mask)
+    {
+        r->dropped++;
+        return false;
+    }
+
+    if(r->size == 1)
+    {
+        r->buf[head & r->mask] = *(const uint8_t *)rec;
+    }
+    else
+    {
+        memcpy(&r->buf[(head & r->mask) * r->size], rec, r->size);
+    }
+
+    // The record must be stored before the consumer can see it
+    __DMB();
+    r->head = head + 1;
+
+    return true;
+}
+
+/*!
+ * \brief Returns true if a consumer is registered and the watermark is
+ *        reached
+ *
+ * \param[in]  r     Ring
+ * \param[out] task  Consumer to notify
+ */
+static inline bool ring_signal(const ring_t *r, TaskHandle_t *task)
+{
+    *task = r->task;
+
+    return (*task != NULL) && ((r->head - r->tail) >= r->watermark);
+}
+
+/*!
+ * \brief Writes a record from a task and notifies the consumer at the
+ *        watermark
+ *
+ * \param[in,out] r    Ring
+ * \param[in]     rec  Record of r->size bytes
+ *
+ * \return false if the ring is full, the record is dropped and counted
+ */
+static inline bool ring_put(ring_t *r, const void *rec)
+{
+    TaskHandle_t task;
+
+    if(!ring_write(r, rec))
+    {
+        return false;
+    }
+
+    if(ring_signal(r, &task))
+    {
+        (void)xTaskNotifyGiveIndexed(task, r->index);
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Writes a record from an interrupt handler and notifies the
+ *        consumer at the watermark
+ *
+ * \param[in,out] r      Ring
+ * \param[in]     rec    Record of r->size bytes
+ * \param[out]    woken  Set to pdTRUE if a context switch is needed
+ *
+ * \return false if the ring is full, the record is dropped and counted
+ */
+static inline bool ring_put_from_isr(ring_t *r, const void *rec,
+    BaseType_t *woken)
+{
+    TaskHandle_t task;
+
+    if(!ring_write(r, rec))
+    {
+        return false;
+    }
+
+    if(ring_signal(r, &task))
+    {
+        vTaskNotifyGiveIndexedFromISR(task, r->index, woken);
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Reads up to max records, oldest first, consumer only
+ *
+ * \param[in,out] r    Ring
+ * \param[out]    dst  Room for max records
+ * \param[in]     max  Most records to read
+ *
+ * \return Number of records read
+ */
+static inline uint32_t ring_read(ring_t *r, void *dst, const uint32_t max)
+{
+    const uint32_t head = r->head;
+    uint32_t tail = r->tail;
+    uint32_t n = head - tail;
+
+    n = (n > max) ? max : n;
+
+    // Read the records up to head after head itself
+    __DMB();
+
+    if(r->size == 1)
+    {
+        uint8_t *d = (uint8_t *)dst;
+
+        for(uint32_t i=0; i<n; ++i)
+        {
+            d[i] = r->buf[(tail + i) & r->mask];
+        }
+    }
+    else
+    {
+        // At most two copies, up to the end of the storage and from its start
+        const uint32_t first = (r->mask + 1) - (tail & r->mask);
+        const uint32_t a = (n < first) ? n : first;
+
+        memcpy(dst, &r->buf[(tail & r->mask) * r->size], a * r->size);
+        memcpy((uint8_t *)dst + (a * r->size), r->buf, (n - a) * r->size);
+    }
+
+    // The records must be read before the producer may overwrite them
+    __DMB();
+    r->tail = tail + n;
+
+    return n;
+}
+
+/*!
+ * \brief Reads one record, consumer only
+ *
+ * \param[in,out] r    Ring
+ * \param[out]    rec  Room for one record
+ *
+ * \return false if the ring is empty
+ */
+static inline bool ring_get(ring_t *r, void *rec)
+{
+    return ring_read(r, rec, 1) == 1;
+}
+
+/*!
+ * \brief Waits until the watermark is reached, consumer only
+ *
+ * Registers the calling task as the consumer. Returns at once if the
+ * watermark is already reached, a notification of records that are read now
+ * is discarded.
+ *
+ * \param[in,out] r        Ring
+ * \param[in]     timeout  Maximum time to wait in ticks
+ *
+ * \return Number of records in the ring, below the watermark on timeout
+ */
+static inline uint32_t ring_wait(ring_t *r, TickType_t timeout)
+{
+    TimeOut_t start;
+
+    r->task = xTaskGetCurrentTaskHandle();
+
+    if(ring_count(r) >= r->watermark)
+    {
+        (void)ulTaskNotifyTakeIndexed(r->index, pdTRUE, 0);
+
+        return ring_count(r);
+    }
+
+    vTaskSetTimeOutState(&start);
+
+    // A notification left by records that were read already wakes the task
+    // early, so wait again for the rest of the timeout
+    while((ring_count(r) < r->watermark) &&
+          (xTaskCheckForTimeOut(&start, &timeout) == pdFALSE))
+    {
+        (void)ulTaskNotifyTakeIndexed(r->index, pdTRUE, timeout);
+    }
+
+    return ring_count(r);
+}
+
+#endif // RING_H
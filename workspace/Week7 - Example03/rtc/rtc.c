@@ -2,10 +2,130 @@
 // Refer to https://community.nxp.com/docs/DOC-94734
 
 #include "rtc.h"
+#include "clock.h"
 #include "datetime.h"
+#include "irq_prio.h"
+#include "seqlock.h"
 
-SemaphoreHandle_t xRtcOneSecondSemaphore;
-SemaphoreHandle_t xRtcAlarmSemaphore;
+SemaphoreHandle_t xRtcOneSecondSemaphore = NULL;
+SemaphoreHandle_t xRtcAlarmSemaphore = NULL;
+
+// Task notified every second instead of giving xRtcOneSecondSemaphore
+static TaskHandle_t second_task = NULL;
+
+// Calendar of the RTC time, advanced by RTC_Seconds_IRQHandler(). Only
+// written by the interrupt handler, or by a task inside a critical section.
+static rtc_datetime_t calendar;
+
+// Value of RTC->TSR that calendar represents
+static uint32_t calendar_seconds;
+
+// The calendar and its seconds as published for rtc_get(), after every
+// change of the calendar
+typedef struct
+{
+    rtc_datetime_t datetime;
+    uint32_t seconds;
+}
+rtc_snapshot_t;
+
+static rtc_snapshot_t snapshot_copies[2];
+static seqlock_t snapshot_lock = SEQLOCK_INIT(snapshot_copies);
+
+// Armed alarms, sorted by expiry time. The first one is in the alarm
+// register. Changed by tasks inside a critical section and by
+// RTC_IRQHandler().
+static rtc_alarm_t *alarms = NULL;
+
+static void rtc_alarm_program(void);
+
+/*!
+ * \brief Number of days in the given month
+ */
+static uint16_t rtc_days_in_month(const uint16_t year, const uint16_t month)
+{
+    static const uint8_t days[] = {0U, 31U, 28U, 31U, 30U, 31U, 30U, 31U,
+        31U, 30U, 31U, 30U, 31U};
+
+    // Every fourth year is a leap year within 1970 - 2099
+    if((month == 2) && ((year & 3U) == 0))
+    {
+        return 29;
+    }
+
+    return days[month];
+}
+
+/*!
+ * \brief Publishes the calendar for rtc_get()
+ */
+static void rtc_calendar_publish(void)
+{
+    const rtc_snapshot_t snapshot = {calendar, calendar_seconds};
+
+    seqlock_write(&snapshot_lock, &snapshot);
+}
+
+/*!
+ * \brief Converts the seconds to the calendar from scratch
+ */
+static void rtc_calendar_sync(const uint32_t seconds)
+{
+    RTC_HAL_ConvertSecsToDatetime(&seconds, &calendar);
+
+    // 1970-01-01 was a Thursday, 0 is Sunday
+    calendar.weekday = ((seconds / 86400U) + 4U) % 7U;
+    calendar_seconds = seconds;
+
+    rtc_calendar_publish();
+}
+
+/*!
+ * \brief Advances the calendar by one second
+ *
+ * At most one field rolls over into the next per call, so this takes
+ * constant time and has no divisions.
+ */
+static void rtc_calendar_tick(void)
+{
+    calendar_seconds++;
+
+    if(++calendar.second < 60)
+    {
+        return;
+    }
+    calendar.second = 0;
+
+    if(++calendar.minute < 60)
+    {
+        return;
+    }
+    calendar.minute = 0;
+
+    if(++calendar.hour < 24)
+    {
+        return;
+    }
+    calendar.hour = 0;
+
+    if(++calendar.weekday >= 7)
+    {
+        calendar.weekday = 0;
+    }
+
+    if(++calendar.day <= rtc_days_in_month(calendar.year, calendar.month))
+    {
+        return;
+    }
+    calendar.day = 1;
+
+    if(++calendar.month <= 12)
+    {
+        return;
+    }
+    calendar.month = 1;
+    calendar.year++;
+}
 
 void rtc_init(void)
 {
@@ -31,7 +151,7 @@ void rtc_init(void)
 
 
     // Enable software access and interrupts to the RTC module.
-    SIM->SCGC6 |= SIM_SCGC6_RTC_MASK;
+    clk_gate_acquire(CLK_GATE_RTC);
 
     // Clear all RTC registers.
     RTC->CR = RTC_CR_SWR_MASK;
@@ -43,18 +163,18 @@ void rtc_init(void)
     }
 
     // Set time compensation parameters. (These parameters can be different for
-    // each application)
+    // each application) They are adjusted by rtc_sync().
     RTC->TCR = RTC_TCR_CIR(0) | RTC_TCR_TCR(0);
 
     // Enable time seconds interrupt for the module and enable its IRQ.
-    NVIC_SetPriority(RTC_Seconds_IRQn, 64);
+    NVIC_SetPriority(RTC_Seconds_IRQn, IRQ_PRIO(RTC_SECONDS));
     NVIC_ClearPendingIRQ(RTC_Seconds_IRQn);
     NVIC_EnableIRQ(RTC_Seconds_IRQn);
 
     RTC->IER |= RTC_IER_TSIE_MASK;
 
     // Enable alarm interrupt for the module and enable its IRQ.
-    NVIC_SetPriority(RTC_IRQn, 64);
+    NVIC_SetPriority(RTC_IRQn, IRQ_PRIO(RTC));
     NVIC_ClearPendingIRQ(RTC_IRQn);
     NVIC_EnableIRQ(RTC_IRQn);
 
@@ -65,68 +185,478 @@ void rtc_init(void)
 
     // Write to Time Seconds Register.
   //RTC_TSR = 0xFF;
+
+    // The software reset cleared the alarm register
+    taskENTER_CRITICAL();
+    {
+        rtc_calendar_sync(RTC->TSR);
+        rtc_alarm_program();
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Notifies a task every second instead of giving
+ *        xRtcOneSecondSemaphore
+ *
+ * The task waits with ulTaskNotifyTakeIndexed() on RTC_NOTIFY_INDEX. A direct
+ * notification needs no semaphore object and is cheaper to give and take.
+ *
+ * \param[in]  task  Task to notify, NULL gives the semaphore again
+ */
+void rtc_notify_seconds(TaskHandle_t task)
+{
+    second_task = task;
+}
+
+/*!
+ * \brief Inserts an alarm in the list, after alarms with the same time
+ */
+static void rtc_alarm_insert(rtc_alarm_t *alarm)
+{
+    rtc_alarm_t **p = &alarms;
+
+    while((*p != NULL) && ((*p)->time <= alarm->time))
+    {
+        p = &(*p)->next;
+    }
+
+    alarm->next = *p;
+    *p = alarm;
+}
+
+/*!
+ * \brief Removes an alarm from the list, if it is there
+ */
+static void rtc_alarm_remove(rtc_alarm_t *alarm)
+{
+    for(rtc_alarm_t **p = &alarms; *p != NULL; p = &(*p)->next)
+    {
+        if(*p == alarm)
+        {
+            *p = alarm->next;
+            break;
+        }
+    }
+
+    alarm->next = NULL;
 }
 
+/*!
+ * \brief Programs the alarm register for the first alarm
+ *
+ * The TAF flag is set when TSR increments from the value in TAR, so TAR is
+ * the second before the alarm. If the alarm became due while TAR was
+ * written, the interrupt is made pending in software.
+ */
+static void rtc_alarm_program(void)
+{
+    if(alarms == NULL)
+    {
+        // Clears the TAF flag, TSR will not be 0 again
+        RTC->TAR = 0;
+        return;
+    }
+
+    RTC->TAR = alarms->time - 1;
+
+    if(RTC->TSR >= alarms->time)
+    {
+        NVIC_SetPendingIRQ(RTC_IRQn);
+    }
+}
+
+/*!
+ * \brief Expires all alarms that are due, called by RTC_IRQHandler()
+ */
+static void rtc_alarm_expire(BaseType_t *woken)
+{
+    const uint32_t now = RTC->TSR;
+
+    while((alarms != NULL) && (alarms->time <= now))
+    {
+        rtc_alarm_t *alarm = alarms;
+        alarms = alarm->next;
+        alarm->next = NULL;
+
+        if(alarm->period != 0)
+        {
+            // Skip the periods that were missed, for example after the time
+            // was set forward
+            alarm->time += ((now - alarm->time) / alarm->period + 1) *
+                alarm->period;
+            rtc_alarm_insert(alarm);
+        }
+        else
+        {
+            alarm->armed = false;
+        }
+
+        if(alarm->callback != NULL)
+        {
+            alarm->callback(alarm, woken);
+        }
+        else if(alarm->task != NULL)
+        {
+            vTaskNotifyGiveIndexedFromISR(alarm->task, RTC_NOTIFY_INDEX, woken);
+        }
+        else if(xRtcAlarmSemaphore != NULL)
+        {
+            /* 'Give' the semaphore. This will unblock the deferred interrupt
+            handling task */
+            xSemaphoreGiveFromISR(xRtcAlarmSemaphore, woken);
+        }
+    }
+
+    rtc_alarm_program();
+}
+
+/*!
+ * \brief Arms an alarm
+ *
+ * Any number of alarms share the single alarm register of the RTC. Only the
+ * first alarm to expire is programmed, so there are no interrupts or task
+ * wake-ups until it is due. When it expires, \p alarm->callback is called
+ * from RTC_IRQHandler(). Without a callback \p alarm->task is notified, or
+ * xRtcAlarmSemaphore is given if there is no task either. The callback must
+ * not start or stop alarms.
+ *
+ * The alarm is armed again if it was already armed. A time in the past
+ * expires at the next second. The times are absolute, alarms must be
+ * started again after the time was set backwards.
+ *
+ * \param[in]  alarm   Alarm, which must stay valid while it is armed
+ * \param[in]  time    Expiry time in seconds since 1970-01-01, see
+ *                     rtc_get_seconds()
+ * \param[in]  period  Seconds between expiries, 0 for a single expiry
+ */
+void rtc_alarm_start(rtc_alarm_t *alarm, const uint32_t time,
+    const uint32_t period)
+{
+    taskENTER_CRITICAL();
+    {
+        if(alarm->armed)
+        {
+            rtc_alarm_remove(alarm);
+        }
+
+        alarm->time = time;
+        alarm->period = period;
+        alarm->armed = true;
+
+        rtc_alarm_insert(alarm);
+        rtc_alarm_program();
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Disarms an alarm
+ */
+void rtc_alarm_stop(rtc_alarm_t *alarm)
+{
+    taskENTER_CRITICAL();
+    {
+        if(alarm->armed)
+        {
+            rtc_alarm_remove(alarm);
+            alarm->armed = false;
+            rtc_alarm_program();
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Gets the current time in seconds since 1970-01-01
+ */
+uint32_t rtc_get_seconds(void)
+{
+    return RTC->TSR;
+}
+
+/*!
+ * \brief Converts a date and time to seconds since 1970-01-01
+ */
+uint32_t rtc_to_seconds(const rtc_datetime_t *datetime)
+{
+    uint32_t seconds;
+
+    RTC_HAL_ConvertDatetimeToSecs(datetime, &seconds);
+
+    return seconds;
+}
+
+/*!
+ * \brief Gets the current date and time, including the weekday
+ *
+ * Copies the calendar that is kept up to date by the seconds interrupt, so
+ * this takes constant time. The copy is consistent without masking the
+ * interrupt, so this can be called from an interrupt handler. The calendar
+ * is only converted from the seconds again if the RTC moved on before the
+ * interrupt was handled.
+ *
+ * \param[out]  datetime  Current date and time
+ */
 void rtc_get(rtc_datetime_t *datetime)
 {
+    rtc_snapshot_t snapshot;
+
+    (void)seqlock_read(&snapshot_lock, &snapshot);
+    *datetime = snapshot.datetime;
+
     // Read the number of seconds from the RTC Time Seconds Register
-    uint32_t seconds = RTC->TSR;
+    uint32_t now = RTC->TSR;
 
-    RTC_HAL_ConvertSecsToDatetime(&seconds, datetime);
+    if(now != snapshot.seconds)
+    {
+        RTC_HAL_ConvertSecsToDatetime(&now, datetime);
+        datetime->weekday = ((now / 86400U) + 4U) % 7U;
+    }
 }
 
+/*!
+ * \brief Gets the current time with sub-second resolution
+ *
+ * Combines the seconds counter with the 32.768 kHz prescaler, so the
+ * resolution is about 30 us without another timer. The seconds are read
+ * again if they incremented while the prescaler was read, so the two parts
+ * always belong together. Can be called from an interrupt handler.
+ *
+ * \return Time since 1970-01-01 in units of 1 / RTC_TIMESTAMP_HZ seconds
+ */
+uint64_t rtc_get_timestamp(void)
+{
+    uint32_t seconds;
+    uint32_t prescaler;
+
+    do
+    {
+        seconds = RTC->TSR;
+        prescaler = RTC->TPR;
+    }while(seconds != RTC->TSR);
+
+    // The seconds increment when bit 14 of the prescaler clears
+    return ((uint64_t)seconds << 15) | (prescaler & 0x7FFF);
+}
+
+/*!
+ * \brief Sets the RTC to a timestamp, see rtc_get_timestamp()
+ */
+static void rtc_write(const uint64_t timestamp)
+{
+    const uint32_t seconds = (uint32_t)(timestamp >> 15);
+
+    taskENTER_CRITICAL();
+    {
+        // Write the number of seconds to the RTC Time Seconds Register and
+        // the fraction of the second to the prescaler, which can only be
+        // written while the time counter is disabled
+        RTC->SR &= ~RTC_SR_TCE_MASK;
+        RTC->TPR = RTC_TPR_TPR(timestamp & 0x7FFF);
+        RTC->TSR = seconds;
+        RTC->SR |= RTC_SR_TCE_MASK;
+
+        rtc_calendar_sync(seconds);
+
+        // Alarms that are due now expire
+        rtc_alarm_program();
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Sets the date and time, at the start of the given second
+ */
 void rtc_set(rtc_datetime_t *datetime)
 {
     uint32_t seconds;
     RTC_HAL_ConvertDatetimeToSecs(datetime, &seconds);
 
-    // Write the number of seconds to the RTC Time Seconds Register
-    RTC->SR &= ~RTC_SR_TCE_MASK;
-    RTC->TSR = seconds;
-    RTC->SR |= RTC_SR_TCE_MASK;
+    rtc_write((uint64_t)seconds << 15);
+}
+
+/*!
+ * \brief Sets the time compensation to the average number of 32.768 kHz
+ *        cycles per second to drop, in 1/256 cycles
+ *
+ * The RTC drops TCR cycles once every CIR + 1 seconds. This picks the pair
+ * that comes closest to the average, the resolution is 1/256 cycle or
+ * 0.12 ppm.
+ */
+static void rtc_compensate(const int32_t cycles256)
+{
+    uint32_t best_tcr = 0;
+    uint32_t best_n = 1;
+    int32_t best_error = INT32_MAX;
+
+    for(int32_t n=1; n<=256; ++n)
+    {
+        // Rounded cycles to drop per interval of n seconds
+        int32_t tcr = (cycles256 * n + ((cycles256 >= 0) ? 128 : -128)) / 256;
+
+        if(tcr > 127)
+        {
+            tcr = 127;
+        }
+        else if(tcr < -128)
+        {
+            tcr = -128;
+        }
+
+        int32_t error = (tcr * 256 - cycles256 * n) / n;
+        error = (error < 0) ? -error : error;
+
+        if(error < best_error)
+        {
+            best_error = error;
+            best_tcr = (uint32_t)tcr & 0xFF;
+            best_n = n;
+        }
+    }
+
+    // Double buffered, takes effect at the end of the current interval
+    RTC->TCR = RTC_TCR_CIR(best_n - 1) | RTC_TCR_TCR(best_tcr);
 }
 
+/*!
+ * \brief Sets the time from a reference and compensates the drift
+ *
+ * Like rtc_set(), but the reference, for example a DCF77 minute mark, is
+ * also used to measure how fast the 32.768 kHz clock runs. When the
+ * previous reference is at least RTC_CAL_MIN_SECONDS ago, the time
+ * compensation register is adjusted so that the RTC follows the reference.
+ * The compensation applied during the measurement is taken into account, so
+ * every reference refines the previous correction. A measured drift beyond
+ * RTC_CAL_MAX_PPM is considered a bad reference and ignored.
+ *
+ * \param[in]  datetime  Reference date and time
+ * \param[in]  at        Value of rtc_get_timestamp() at the instant the
+ *                       reference second started
+ *
+ * \return True if the compensation was adjusted
+ */
+bool rtc_sync(const rtc_datetime_t *datetime, const uint64_t at)
+{
+    // Reference of the previous call, the RTC was set to it
+    static uint64_t previous = 0;
+
+    uint32_t seconds;
+    RTC_HAL_ConvertDatetimeToSecs(datetime, &seconds);
+
+    const uint64_t reference = (uint64_t)seconds << 15;
+    bool calibrated = false;
+
+    if((previous != 0) &&
+       (reference >= previous + ((uint64_t)RTC_CAL_MIN_SECONDS << 15)) &&
+       (at > previous))
+    {
+        const int64_t expected = (int64_t)(reference - previous);
+        const int64_t measured = (int64_t)(at - previous);
+
+        // Drift in parts per billion, positive if the RTC runs fast
+        const int64_t ppb = ((measured - expected) * 1000000000LL) / expected;
+
+        if((ppb <= (RTC_CAL_MAX_PPM * 1000LL)) &&
+           (ppb >= -(RTC_CAL_MAX_PPM * 1000LL)))
+        {
+            // Average cycles dropped per second during the measurement
+            const uint32_t tcr = RTC->TCR;
+            const int32_t n = (int32_t)((tcr & RTC_TCR_CIR_MASK) >>
+                RTC_TCR_CIR_SHIFT) + 1;
+            const int32_t old256 = ((int32_t)(int8_t)(tcr & RTC_TCR_TCR_MASK) *
+                256) / n;
+
+            // Cycles of the crystal per second of the reference
+            const int64_t cycles256 = ((32768LL * 256 - old256) * measured) /
+                expected;
+
+            rtc_compensate((int32_t)(32768LL * 256 - cycles256));
+            calibrated = true;
+        }
+    }
+
+    // Set the time, including the time since the reference second started
+    rtc_write(reference + (rtc_get_timestamp() - at));
+    previous = reference;
+
+    return calibrated;
+}
+
+/*!
+ * \brief RTC alarm interrupt handler
+ *
+ * Expires the alarms that are due and programs the alarm register for the
+ * next one.
+ */
 void RTC_IRQHandler(void)
 {
     // Clear pending interrupts
     NVIC_ClearPendingIRQ(RTC_IRQn);
 
-    if(RTC->SR & RTC_SR_TAF_MASK)
-    {
-        // Clear the TAF flag
-        RTC->TAR = 0;
+    /* The xHigherPriorityTaskWoken parameter must be initialized to pdFALSE as
+    it will get set to pdTRUE inside the interrupt safe API function if a
+    context switch is required. */
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-        /* The xHigherPriorityTaskWoken parameter must be initialized to pdFALSE as
-        it will get set to pdTRUE inside the interrupt safe API function if a
-        context switch is required. */
-        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    TRACE_ISR_ENTER();
 
-        /* 'Give' the semaphore. This will unblock the deferred interrupt handling
-        task */
-        xSemaphoreGiveFromISR( xRtcAlarmSemaphore, &xHigherPriorityTaskWoken );
+    // Writing the alarm register also clears the TAF flag
+    rtc_alarm_expire(&xHigherPriorityTaskWoken);
 
-        /* Pass the xHigherPriorityTaskWoken value into portYIELD_FROM_ISR(). If
-        xHigherPriorityTaskWoken was set to pdTRUE inside xSemaphoreGiveFromISR()
-        then calling portYIELD_FROM_ISR() will request a context switch. If
-        xHigherPriorityTaskWoken is still pdFALSE then calling
-        portYIELD_FROM_ISR() will have no effect. */
-        portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
-    }
+    TRACE_ISR_EXIT();
+
+    /* Pass the xHigherPriorityTaskWoken value into portYIELD_FROM_ISR(). If
+    xHigherPriorityTaskWoken was set to pdTRUE inside xSemaphoreGiveFromISR()
+    then calling portYIELD_FROM_ISR() will request a context switch. If
+    xHigherPriorityTaskWoken is still pdFALSE then calling
+    portYIELD_FROM_ISR() will have no effect. */
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
 }
 
 void RTC_Seconds_IRQHandler(void)
 {
+    TRACE_ISR_ENTER();
+
+    // The prescaler restarted at the second, it counts at 32.768 kHz which
+    // is 46875 / 64 bus clock cycles per count
+    TRACE_ISR_LATENCY(((RTC->TPR & 0x7FFF) * 46875UL) >> 6);
+
     // Clear pending interrupts
     NVIC_ClearPendingIRQ(RTC_Seconds_IRQn);
 
+    // Advance the calendar, or convert it again if seconds were missed or
+    // the time was set
+    const uint32_t seconds = RTC->TSR;
+
+    if(seconds == (calendar_seconds + 1))
+    {
+        rtc_calendar_tick();
+        rtc_calendar_publish();
+    }
+    else if(seconds != calendar_seconds)
+    {
+        rtc_calendar_sync(seconds);
+    }
+
     /* The xHigherPriorityTaskWoken parameter must be initialized to pdFALSE as
     it will get set to pdTRUE inside the interrupt safe API function if a
     context switch is required. */
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-    /* 'Give' the semaphore. This will unblock the deferred interrupt handling
-    task */
-    xSemaphoreGiveFromISR( xRtcOneSecondSemaphore, &xHigherPriorityTaskWoken );
+    /* Notify the task, or 'give' the semaphore. This will unblock the deferred
+    interrupt handling task */
+    if( second_task != NULL )
+    {
+        vTaskNotifyGiveIndexedFromISR( second_task, RTC_NOTIFY_INDEX,
+            &xHigherPriorityTaskWoken );
+    }
+    else if( xRtcOneSecondSemaphore != NULL )
+    {
+        xSemaphoreGiveFromISR( xRtcOneSecondSemaphore, &xHigherPriorityTaskWoken );
+    }
+
+    TRACE_ISR_EXIT();
 
     /* Pass the xHigherPriorityTaskWoken value into portYIELD_FROM_ISR(). If
     xHigherPriorityTaskWoken was set to pdTRUE inside xSemaphoreGiveFromISR()
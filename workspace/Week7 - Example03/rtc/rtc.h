@@ -7,6 +7,26 @@
 #include "MKL25Z4.h"
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "task.h"
+#include <stdbool.h>
+
+// Ticks per second of rtc_get_timestamp()
+#define RTC_TIMESTAMP_HZ (32768U)
+
+// Shortest time between two rtc_sync() references that is used to measure
+// the drift
+#ifndef RTC_CAL_MIN_SECONDS
+#define RTC_CAL_MIN_SECONDS (1800U)
+#endif
+
+// Largest drift in ppm of a plausible reference
+#define RTC_CAL_MAX_PPM (3000)
+
+// Task notification index used to signal a second or an alarm to a task, see
+// rtc_notify_seconds() and rtc_alarm_t
+#ifndef RTC_NOTIFY_INDEX
+#define RTC_NOTIFY_INDEX (6)
+#endif
 
 typedef struct
 {
@@ -20,11 +40,46 @@ typedef struct
 
 }rtc_datetime_t;
 
+struct rtc_alarm;
+
+/*!
+ * \brief Called from RTC_IRQHandler() when an alarm expires
+ */
+typedef void (*rtc_alarm_callback_t)(struct rtc_alarm *alarm,
+    BaseType_t *woken);
+
+/*!
+ * \brief Wall-clock alarm, see rtc_alarm_start()
+ *
+ * Only callback, task and arg are set by the caller, the other members
+ * belong to the driver. Without a callback, task is notified on
+ * RTC_NOTIFY_INDEX or, if task is NULL as well, xRtcAlarmSemaphore is given.
+ */
+typedef struct rtc_alarm
+{
+    rtc_alarm_callback_t callback; ///< Called from the ISR, or NULL
+    TaskHandle_t task;            ///< Notified if there is no callback
+    void *arg;                    ///< Free for the callback
+    uint32_t time;                ///< Next expiry in seconds since 1970
+    uint32_t period;              ///< Seconds between expiries, 0 for once
+    bool armed;
+    struct rtc_alarm *next;
+}rtc_alarm_t;
+
 extern SemaphoreHandle_t xRtcOneSecondSemaphore;
 extern SemaphoreHandle_t xRtcAlarmSemaphore;
 
 void rtc_init(void);
+void rtc_notify_seconds(TaskHandle_t task);
 void rtc_get(rtc_datetime_t *datetime);
+uint64_t rtc_get_timestamp(void);
+uint32_t rtc_get_seconds(void);
+uint32_t rtc_to_seconds(const rtc_datetime_t *datetime);
+
+void rtc_alarm_start(rtc_alarm_t *alarm, const uint32_t time,
+    const uint32_t period);
+void rtc_alarm_stop(rtc_alarm_t *alarm);
 void rtc_set(rtc_datetime_t *datetime);
+bool rtc_sync(const rtc_datetime_t *datetime, const uint64_t at);
 
 #endif
@@ -0,0 +1,185 @@
+/*! ***************************************************************************
+ *
+ * \brief     SEGGER RTT channels for logging and tracing over the debug probe
+ * \file      rtt.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <string.h>
+
+#include "rtt.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * Real-Time Transfer: the J-Link reads and writes ring buffers in RAM over
+ * SWD while the core runs. Writing to an up channel is a copy into its ring
+ * and an update of its write offset, without interrupts, pins or waiting
+ * for a peripheral. The probe polls the rings, Ozone shows RTT_TERMINAL in
+ * its Terminal window once the program runs, and
+ *
+ *   JLinkRTTLogger -Device MKL25Z128xxx4 -If SWD -Speed 4000 -RTTChannel 1 trace.bin
+ *
+ * captures RTT_TRACE for tools/trace_convert.py.
+ *
+ * This is a small implementation of the RTT protocol, not the SEGGER
+ * library. The probe finds the control block by the "SEGGER RTT" id in RAM
+ * or by the _SEGGER_RTT symbol of the elf. It is initialised with the
+ * .data section, so it is valid before main() and may be written from
+ * interrupt handlers during start-up.
+ *
+ * A write that does not fit is dropped as a whole and counted, so a record
+ * or frame is never split. Without a probe attached the rings fill up and
+ * every write is dropped.
+ */
+
+// Mode of a ring that is full: drop the write
+#define RTT_MODE_NO_BLOCK_SKIP (0)
+
+static char rtt_terminal_up[RTT_TERMINAL_SIZE];
+static char rtt_trace_up[RTT_TRACE_SIZE];
+static char rtt_terminal_down[RTT_DOWN_SIZE];
+
+static volatile uint32_t rtt_drops = 0;
+
+rtt_cb_t _SEGGER_RTT =
+{
+    .id = "SEGGER RTT",
+    .max_up = RTT_UP_CHANNELS,
+    .max_down = RTT_DOWN_CHANNELS,
+    .up =
+    {
+        {"Terminal", rtt_terminal_up, sizeof(rtt_terminal_up), 0, 0, RTT_MODE_NO_BLOCK_SKIP},
+        {"Trace", rtt_trace_up, sizeof(rtt_trace_up), 0, 0, RTT_MODE_NO_BLOCK_SKIP},
+    },
+    .down =
+    {
+        {"Terminal", rtt_terminal_down, sizeof(rtt_terminal_down), 0, 0, RTT_MODE_NO_BLOCK_SKIP},
+    },
+};
+
+/*!
+ * \brief Writes to an up channel
+ *
+ * Copies all bytes or none. Interrupts are masked while copying, so the
+ * function can be called from tasks and interrupt handlers.
+ *
+ * \param[in]  channel  Up channel, RTT_TERMINAL or RTT_TRACE
+ * \param[in]  data     Bytes to write
+ * \param[in]  len      Number of bytes
+ *
+ * \return Number of bytes written, len or 0 if they did not fit
+ */
+size_t rtt_write(const uint32_t channel, const void *data, const size_t len)
+{
+    rtt_buffer_t *ring = &_SEGGER_RTT.up[channel];
+    size_t ret = 0;
+    UBaseType_t mask;
+
+    configASSERT(channel < RTT_UP_CHANNELS);
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        const uint32_t rd = ring->rd_off;
+        uint32_t wr = ring->wr_off;
+        const uint32_t room = (rd > wr) ? (rd - wr - 1) : (ring->size - (wr - rd) - 1);
+
+        if(len <= room)
+        {
+            // Up to the end of the ring, then from its start
+            const size_t first = (len < (ring->size - wr)) ? len : (ring->size - wr);
+
+            memcpy(&ring->buffer[wr], data, first);
+            memcpy(ring->buffer, (const uint8_t *)data + first, len - first);
+
+            wr += len;
+
+            if(wr >= ring->size)
+            {
+                wr -= ring->size;
+            }
+
+            // The probe may read the bytes as soon as the offset moves
+            __DMB();
+            ring->wr_off = wr;
+
+            ret = len;
+        }
+        else
+        {
+            rtt_drops++;
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    return ret;
+}
+
+/*!
+ * \brief Reads from a down channel without waiting
+ *
+ * Must only be called by a single task.
+ *
+ * \param[in]   channel  Down channel, RTT_TERMINAL
+ * \param[out]  data     Received bytes
+ * \param[in]   len      Size of data
+ *
+ * \return Number of bytes read
+ */
+size_t rtt_read(const uint32_t channel, void *data, const size_t len)
+{
+    rtt_buffer_t *ring = &_SEGGER_RTT.down[channel];
+    uint8_t *dst = data;
+    uint32_t rd = ring->rd_off;
+    const uint32_t wr = ring->wr_off;
+    size_t n = 0;
+
+    configASSERT(channel < RTT_DOWN_CHANNELS);
+
+    while((rd != wr) && (n < len))
+    {
+        dst[n++] = (uint8_t)ring->buffer[rd++];
+
+        if(rd >= ring->size)
+        {
+            rd = 0;
+        }
+    }
+
+    // Release the bytes to the probe after they were copied
+    __DMB();
+    ring->rd_off = rd;
+
+    return n;
+}
+
+/*!
+ * \brief Returns the number of writes dropped because a ring was full
+ */
+uint32_t rtt_dropped(void)
+{
+    return rtt_drops;
+}
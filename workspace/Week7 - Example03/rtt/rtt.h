@@ -0,0 +1,109 @@
+/*! ***************************************************************************
+ *
+ * \brief     SEGGER RTT channels for logging and tracing over the debug probe
+ * \file      rtt.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef RTT_H
+#define RTT_H
+
+#include <MKL25Z4.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// \name Definitions for the RTT channels
+/// \{
+
+/*!
+ * \brief Up and down channel of the terminal, Ozone shows it in the Terminal
+ *        window
+ */
+#define RTT_TERMINAL        (0)
+
+/*!
+ * \brief Up channel of the telemetry frames of the trace recorder
+ */
+#define RTT_TRACE           (1)
+
+/*!
+ * \brief Number of up and down channels
+ */
+#define RTT_UP_CHANNELS     (2)
+#define RTT_DOWN_CHANNELS   (1)
+
+/*!
+ * \brief Sizes in bytes of the ring buffers. A ring holds one byte less.
+ */
+#ifndef RTT_TERMINAL_SIZE
+#define RTT_TERMINAL_SIZE   (512)
+#endif
+
+#ifndef RTT_TRACE_SIZE
+#define RTT_TRACE_SIZE      (512)
+#endif
+
+#ifndef RTT_DOWN_SIZE
+#define RTT_DOWN_SIZE       (16)
+#endif
+
+/// \}
+
+/// Ring buffer of a channel, the layout of SEGGER_RTT_BUFFER_UP and _DOWN
+///
+/// For an up channel the target writes wr_off and the probe rd_off, for a
+/// down channel the other way around.
+typedef struct
+{
+    const char *name;           ///< Name shown by the J-Link software
+    char *buffer;               ///< Ring buffer
+    uint32_t size;              ///< Size of the ring buffer in bytes
+    volatile uint32_t wr_off;   ///< Offset of the next byte to write
+    volatile uint32_t rd_off;   ///< Offset of the next byte to read
+    uint32_t flags;             ///< Mode when the ring is full
+}
+rtt_buffer_t;
+
+/// Control block, the layout of SEGGER_RTT_CB that the probe searches for
+typedef struct
+{
+    char id[16];                ///< "SEGGER RTT"
+    int32_t max_up;             ///< Number of up channels
+    int32_t max_down;           ///< Number of down channels
+    rtt_buffer_t up[RTT_UP_CHANNELS];
+    rtt_buffer_t down[RTT_DOWN_CHANNELS];
+}
+rtt_cb_t;
+
+// Control block, found by the probe
+extern rtt_cb_t _SEGGER_RTT;
+
+// Function prototypes
+size_t rtt_write(const uint32_t channel, const void *data, const size_t len);
+size_t rtt_read(const uint32_t channel, void *data, const size_t len);
+uint32_t rtt_dropped(void);
+
+#endif // RTT_H
@@ -30,20 +30,192 @@
  *
  *****************************************************************************/
 #include "runtime_stats.h"
+#include "clock.h"
+#include "irq_prio.h"
+
+/* Registration for clock mode changes. */
+static clk_notifier_t xRunTimeClock;
+
+static void prvRunTimeClock( const clk_event_t eEvent, void *pvArg );
+
+#if rtsFREE_RUNNING
+
+/* Number of times PIT0 counted down to zero, the upper half of the
+ * raw count. */
+static uint32_t ulWraps = 0;
+
+/* The run time and the raw count at the last clock mode change, and the
+ * 16.16 fixed point factor from bus clock cycles of the clock mode to
+ * rtsCLOCK_HZ cycles. */
+static uint64_t ullRunTimeBase = 0;
+static uint64_t ullRunTimeOrigin = 0;
+static uint32_t ulRunTimeScale = 0x10000UL;
+
+void vConfigureTimerForRunTimeStats( void )
+{
+	// Enable clock to PIT module
+	clk_gate_acquire(CLK_GATE_PIT);
+
+	// Enable module, freeze timers in debug mode
+	PIT->MCR &= ~PIT_MCR_MDIS_MASK;
+	PIT->MCR |= PIT_MCR_FRZ_MASK;
+
+	// Count down the full 32-bit range, about 179 s at 24 MHz. PIT0 is
+	// already running from ResetISR() for the boot time, see boot.h.
+	PIT->CHANNEL[0].LDVAL = PIT_LDVAL_TSV(0xFFFFFFFFUL);
+
+	// The scale of the current clock mode, and again after every change
+	prvRunTimeClock( CLK_POST_CHANGE, NULL );
+	clk_register( &xRunTimeClock, prvRunTimeClock, NULL );
+
+	// No chaining, PIT1 is the ADC trigger of the TCRT5000 driver
+	PIT->CHANNEL[0].TCTRL &= ~PIT_TCTRL_CHN_MASK;
+
+	// The wrap is normally counted by the next read of the counter. The
+	// interrupt only counts it if nothing reads the counter for a full
+	// period.
+	PIT->CHANNEL[0].TFLG = PIT_TFLG_TIF_MASK;
+	PIT->CHANNEL[0].TCTRL |= PIT_TCTRL_TIE_MASK;
+
+	/* Enable Interrupts */
+	NVIC_SetPriority(PIT_IRQn, IRQ_PRIO(RUNTIME));
+	NVIC_ClearPendingIRQ(PIT_IRQn);
+	NVIC_EnableIRQ(PIT_IRQn);
+
+	// Enable counter
+	PIT->CHANNEL[0].TCTRL |= PIT_TCTRL_TEN_MASK;
+}
+
+/* Returns the number of bus clock cycles since the timer was started. The
+ * wraps of PIT0 extend the count to 64 bits, so it does not overflow. Call
+ * with interrupts disabled. */
+static uint64_t prvRunTimeRaw( void )
+{
+uint32_t ulCount;
+
+	ulCount = PIT->CHANNEL[0].CVAL;
+
+	/* The counter reloaded since the last read. Count the wrap and read the
+	counter again, so it is known to be after the reload. */
+	if( PIT->CHANNEL[0].TFLG & PIT_TFLG_TIF_MASK )
+	{
+		PIT->CHANNEL[0].TFLG = PIT_TFLG_TIF_MASK;
+		ulWraps++;
+		ulCount = PIT->CHANNEL[0].CVAL;
+	}
+
+	return ( ( uint64_t ) ulWraps << 32 ) | ( 0xFFFFFFFFUL - ulCount );
+}
+
+/* Returns the run time of a raw count in rtsCLOCK_HZ cycles. Call with
+ * interrupts disabled. */
+static uint64_t prvRunTimeScaled( uint64_t ullRaw )
+{
+	ullRaw -= ullRunTimeOrigin;
+
+	if( ulRunTimeScale == 0x10000UL )
+	{
+		return ullRunTimeBase + ullRaw;
+	}
+
+	/* In two parts, so the product does not overflow. */
+	return ullRunTimeBase + ( ( ullRaw >> 16 ) * ulRunTimeScale ) +
+		( ( ( ullRaw & 0xFFFFUL ) * ulRunTimeScale ) >> 16 );
+}
+
+/* Returns the number of rtsCLOCK_HZ cycles since the timer was started.
+ * Called by the kernel on every context switch and can be called from any
+ * interrupt. */
+uint64_t ullRunTimeCounterValue( void )
+{
+uint32_t ulPrimask = __get_PRIMASK();
+uint64_t ullValue;
+
+	__disable_irq();
+
+	ullValue = prvRunTimeScaled( prvRunTimeRaw() );
+
+	__set_PRIMASK( ulPrimask );
+
+	return ullValue;
+}
+
+/* Starts a new scale at a clock mode change. The switch itself is counted at
+ * the old scale. */
+static void prvRunTimeClock( const clk_event_t eEvent, void *pvArg )
+{
+uint32_t ulPrimask = __get_PRIMASK();
+uint64_t ullRaw;
+
+	( void ) pvArg;
+
+	if( eEvent != CLK_POST_CHANGE )
+	{
+		return;
+	}
+
+	__disable_irq();
+
+	ullRaw = prvRunTimeRaw();
+	ullRunTimeBase = prvRunTimeScaled( ullRaw );
+	ullRunTimeOrigin = ullRaw;
+	ulRunTimeScale = ( uint32_t ) ( ( ( uint64_t ) rtsCLOCK_HZ << 16 ) / clk_bus_hz() );
+
+	__set_PRIMASK( ulPrimask );
+}
+
+/* Returns the run time in ticks of rtsTICK_US microseconds. */
+uint32_t ulRunTimeTicks( void )
+{
+	return ( uint32_t ) ( ullRunTimeCounterValue() / rtsTICK_CYCLES );
+}
+
+/* Returns the run time in microseconds. Can be called from any interrupt,
+ * also one with a higher priority than the PIT. Wraps around after about
+ * 71 minutes. */
+uint32_t ulRunTimeMicroseconds( void )
+{
+	return ( uint32_t ) ( ullRunTimeCounterValue() /
+		( rtsTICK_CYCLES / rtsTICK_US ) );
+}
+
+void PIT_IRQHandler()
+{
+	//clear pending IRQ
+	NVIC_ClearPendingIRQ(PIT_IRQn);
+
+	// Counts the wrap and clears the flag
+	( void ) ullRunTimeCounterValue();
+}
+
+#else
 
 volatile uint32_t ulHighFrequencyTicks = 0;
 
+/* Number of times ulHighFrequencyTicks wrapped around, the upper half of
+ * the 64-bit tick count. */
+static uint32_t ulTickWraps = 0;
+
+/* PIT0 cycles in a tick at the bus clock of the clock mode. */
+static uint32_t ulTickCycles = rtsTICK_CYCLES;
+
 void vConfigureTimerForRunTimeStats( void )
 {
 	// Enable clock to PIT module
-	SIM->SCGC6 |= SIM_SCGC6_PIT_MASK;
+	clk_gate_acquire(CLK_GATE_PIT);
 
 	// Enable module, freeze timers in debug mode
 	PIT->MCR &= ~PIT_MCR_MDIS_MASK;
 	PIT->MCR |= PIT_MCR_FRZ_MASK;
 
-	// Initialize PIT0 to count down from argument
-	PIT->CHANNEL[0].LDVAL = PIT_LDVAL_TSV(2400-1);
+	// Stop the boot time counter started by ResetISR(), so the new load
+	// value is used right away
+	PIT->CHANNEL[0].TCTRL = 0;
+
+	// Initialize PIT0 to count down a tick at the bus clock of the clock mode
+	ulTickCycles = clk_bus_hz() / ( 1000000UL / rtsTICK_US );
+	PIT->CHANNEL[0].LDVAL = PIT_LDVAL_TSV(ulTickCycles-1);
+	clk_register( &xRunTimeClock, prvRunTimeClock, NULL );
 
 	// No chaining
 	PIT->CHANNEL[0].TCTRL &= ~PIT_TCTRL_CHN_MASK;
@@ -52,7 +224,7 @@ void vConfigureTimerForRunTimeStats( void )
 	PIT->CHANNEL[0].TCTRL |= PIT_TCTRL_TIE_MASK;
 
 	/* Enable Interrupts */
-	NVIC_SetPriority(PIT_IRQn, 192); // 0, 64, 128 or 192
+	NVIC_SetPriority(PIT_IRQn, IRQ_PRIO(RUNTIME));
 	NVIC_ClearPendingIRQ(PIT_IRQn);
 	NVIC_EnableIRQ(PIT_IRQn);
 
@@ -60,6 +232,92 @@ void vConfigureTimerForRunTimeStats( void )
 	PIT->CHANNEL[0].TCTRL |= PIT_TCTRL_TEN_MASK;
 }
 
+/* Returns the run time in ticks of rtsTICK_US microseconds. */
+uint32_t ulRunTimeTicks( void )
+{
+	return ulHighFrequencyTicks;
+}
+
+/* Returns the run time in microseconds, with the resolution of the PIT0
+ * counter instead of that of ulHighFrequencyTicks. Can be called from any
+ * interrupt, also one with a higher priority than the PIT. Wraps around
+ * after about 71 minutes. */
+uint32_t ulRunTimeMicroseconds( void )
+{
+uint32_t ulPrimask = __get_PRIMASK();
+uint32_t ulTicks, ulCount;
+
+	__disable_irq();
+
+	ulTicks = ulHighFrequencyTicks;
+	ulCount = PIT->CHANNEL[0].CVAL;
+
+	/* The counter reloaded, but the interrupt did not run yet. Read the
+	counter again, so it is known to be after the reload. */
+	if( PIT->CHANNEL[0].TFLG & PIT_TFLG_TIF_MASK )
+	{
+		ulCount = PIT->CHANNEL[0].CVAL;
+		ulTicks++;
+	}
+
+	__set_PRIMASK( ulPrimask );
+
+	return ( ulTicks * rtsTICK_US ) +
+		( ( ( ulTickCycles - 1UL ) - ulCount ) * rtsTICK_US ) / ulTickCycles;
+}
+
+/* Returns the number of rtsCLOCK_HZ cycles since the timer was started,
+ * from the 64-bit tick count and the PIT0 counter within the tick. Can be
+ * called from any interrupt. */
+uint64_t ullRunTimeCounterValue( void )
+{
+uint32_t ulPrimask = __get_PRIMASK();
+uint32_t ulTicks, ulWraps, ulCount;
+
+	__disable_irq();
+
+	ulTicks = ulHighFrequencyTicks;
+	ulWraps = ulTickWraps;
+	ulCount = PIT->CHANNEL[0].CVAL;
+
+	/* The counter reloaded, but the interrupt did not run yet. */
+	if( PIT->CHANNEL[0].TFLG & PIT_TFLG_TIF_MASK )
+	{
+		ulCount = PIT->CHANNEL[0].CVAL;
+		ulTicks++;
+
+		if( ulTicks == 0UL )
+		{
+			ulWraps++;
+		}
+	}
+
+	__set_PRIMASK( ulPrimask );
+
+	/* Before vConfigureTimerForRunTimeStats() PIT0 is still free-running
+	from ResetISR(), the run time is 0 until then. */
+	if( ulCount >= ulTickCycles )
+	{
+		ulCount = ulTickCycles - 1UL;
+	}
+
+	return ( ( ( ( uint64_t ) ulWraps << 32 ) | ulTicks ) * rtsTICK_CYCLES ) +
+		( ( ( ulTickCycles - 1UL ) - ulCount ) * rtsTICK_CYCLES ) / ulTickCycles;
+}
+
+/* Sets the tick period for the new bus clock at a clock mode change, it is
+ * used from the next tick on. */
+static void prvRunTimeClock( const clk_event_t eEvent, void *pvArg )
+{
+	( void ) pvArg;
+
+	if( eEvent == CLK_POST_CHANGE )
+	{
+		ulTickCycles = clk_bus_hz() / ( 1000000UL / rtsTICK_US );
+		PIT->CHANNEL[0].LDVAL = PIT_LDVAL_TSV(ulTickCycles-1);
+	}
+}
+
 void PIT_IRQHandler()
 {
 	//clear pending IRQ
@@ -73,5 +331,12 @@ void PIT_IRQHandler()
 
 		// Do ISR work
 		ulHighFrequencyTicks++;
+
+		if( ulHighFrequencyTicks == 0UL )
+		{
+			ulTickWraps++;
+		}
 	}
 }
+
+#endif // rtsFREE_RUNNING
@@ -34,8 +34,42 @@
 
 #include <MKL25Z4.h>
 
+/* Set to 0 to count the run time with a 10 kHz PIT0 interrupt instead of
+ * reading a free-running PIT0. */
+#ifndef rtsFREE_RUNNING
+#define rtsFREE_RUNNING     ( 1 )
+#endif
+
+/* PIT0 counts bus clock cycles. A run-time stats tick is rtsTICK_CYCLES
+ * cycles of the 24 MHz bus clock of CLK_RUN, which is rtsTICK_US
+ * microseconds. The run time is kept in these units in the slower clock
+ * modes of the clock manager. */
+#define rtsTICK_CYCLES      ( 2400UL )
+#define rtsTICK_US          ( 100UL )
+#define rtsCLOCK_HZ         ( rtsTICK_CYCLES * ( 1000000UL / rtsTICK_US ) )
+
+#if rtsFREE_RUNNING
+
+/* The run-time counter is the 64-bit number of rtsCLOCK_HZ cycles, read
+ * from PIT0 without a periodic interrupt. */
+#define rtsCOUNTS_PER_TICK  ( rtsTICK_CYCLES )
+
+#else
+
+/* The run-time counter is ulHighFrequencyTicks, incremented by the PIT0
+ * interrupt every tick. */
+#define rtsCOUNTS_PER_TICK  ( 1UL )
+
 extern volatile uint32_t ulHighFrequencyTicks;
 
+#endif
+
+/* The 64-bit number of rtsCLOCK_HZ cycles since the timer was started, in
+ * both modes. */
+uint64_t ullRunTimeCounterValue( void );
+
 void vConfigureTimerForRunTimeStats( void );
+uint32_t ulRunTimeTicks( void );
+uint32_t ulRunTimeMicroseconds( void );
 
 #endif // RUNTIME_STATS_H
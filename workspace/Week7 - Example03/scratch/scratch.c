@@ -0,0 +1,204 @@
+/*! ***************************************************************************
+ *
+ * \brief     Scratch arena for transient buffers
+ * \file      scratch.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stddef.h>
+
+#include "scratch.h"
+
+#if ((SCRATCH_SIZE % SCRATCH_ALIGN) != 0)
+#error "SCRATCH_SIZE must be a multiple of SCRATCH_ALIGN"
+#endif
+
+#if (SCRATCH_SIZE > 0xFFFF)
+#error "SCRATCH_SIZE does not fit in the size of a block"
+#endif
+
+// Header in front of every block
+typedef struct
+{
+    TaskHandle_t owner;     // Task that allocated the block
+    uint32_t seq;           // Number of the allocation
+    uint16_t size;          // Bytes of the block, the header included
+    uint8_t freed;
+}
+scratch_block_t;
+
+#define SCRATCH_ROUND(n)  (((n) + (SCRATCH_ALIGN - 1U)) & ~(SCRATCH_ALIGN - 1U))
+#define SCRATCH_HEADER    SCRATCH_ROUND(sizeof(scratch_block_t))
+
+// The arena, top is the offset of the first free byte. Both are protected
+// by masking interrupts, the walks are over the few blocks in use.
+static uint64_t arena[SCRATCH_SIZE / sizeof(uint64_t)];
+static uint32_t top = 0;
+static uint32_t seq = 0;
+static uint32_t blocks = 0;
+static uint32_t peak = 0;
+static uint32_t failures = 0;
+
+#define SCRATCH_AT(offset) ((scratch_block_t *)((uint8_t *)arena + (offset)))
+
+/*!
+ * \brief Returns a mark of the allocations so far
+ *
+ * The allocations of the calling task after the mark are released together
+ * with scratch_release(). The mark is the number of the next allocation,
+ * not a position: the top may go down and up again before the task
+ * allocates. Call from a task.
+ */
+scratch_mark_t scratch_mark(void)
+{
+    return seq;
+}
+
+/*!
+ * \brief Allocates a block from the top of the arena
+ *
+ * While the arena is full, the allocation is tried again every tick until
+ * the timeout. Call from a task.
+ *
+ * \param[in]  size     Bytes
+ * \param[in]  timeout  Ticks to wait for room, 0 to not wait
+ *
+ * \return The block, aligned to SCRATCH_ALIGN, NULL if it did not fit in
+ *         time
+ */
+void *scratch_alloc(const uint32_t size, const TickType_t timeout)
+{
+    const uint32_t need = SCRATCH_HEADER + SCRATCH_ROUND(size);
+    const TickType_t start = xTaskGetTickCount();
+    scratch_block_t *b = NULL;
+
+    for( ;; )
+    {
+        taskENTER_CRITICAL();
+        {
+            if((size <= SCRATCH_SIZE) && (need <= (SCRATCH_SIZE - top)))
+            {
+                b = SCRATCH_AT(top);
+                b->owner = xTaskGetCurrentTaskHandle();
+                b->size = (uint16_t)need;
+                b->seq = seq++;
+                b->freed = 0;
+
+                top += need;
+                blocks++;
+
+                if(top > peak)
+                {
+                    peak = top;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if((b != NULL) || ((xTaskGetTickCount() - start) >= timeout))
+        {
+            break;
+        }
+
+        vTaskDelay(1);
+    }
+
+    if(b == NULL)
+    {
+        taskENTER_CRITICAL();
+        {
+            failures++;
+        }
+        taskEXIT_CRITICAL();
+
+        return NULL;
+    }
+
+    return (uint8_t *)b + SCRATCH_HEADER;
+}
+
+/*!
+ * \brief Frees the blocks the calling task allocated since a mark
+ *
+ * The top goes down to the end of the highest block still in use.
+ *
+ * \param[in]  mark  Of scratch_mark()
+ */
+void scratch_release(const scratch_mark_t mark)
+{
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+    taskENTER_CRITICAL();
+    {
+        uint32_t end = 0;
+        uint32_t n = 0;
+
+        for(uint32_t offset = 0; offset < top; )
+        {
+            scratch_block_t *b = SCRATCH_AT(offset);
+
+            // The numbers wrap around, newer ones are less than half
+            // the range ahead
+            if((b->owner == self) && ((int32_t)(b->seq - mark) >= 0))
+            {
+                b->freed = 1;
+            }
+
+            offset += b->size;
+
+            if(!b->freed)
+            {
+                end = offset;
+            }
+        }
+
+        // Count the blocks that stay below the new top
+        for(uint32_t offset = 0; offset < end; offset += SCRATCH_AT(offset)->size)
+        {
+            n++;
+        }
+
+        top = end;
+        blocks = n;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Copies the usage of the arena
+ */
+void scratch_get_stats(scratch_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    {
+        stats->size = SCRATCH_SIZE;
+        stats->blocks = blocks;
+        stats->used = top;
+        stats->peak = peak;
+        stats->failures = failures;
+    }
+    taskEXIT_CRITICAL();
+}
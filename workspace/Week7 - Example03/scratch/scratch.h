@@ -0,0 +1,100 @@
+/*! ***************************************************************************
+ *
+ * \brief     Scratch arena for transient buffers
+ * \file      scratch.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef SCRATCH_H
+#define SCRATCH_H
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * The scratch arena holds the buffers that a task only needs while it
+ * formats a line, renders a record or encodes a packet. Such a buffer on
+ * the stack is paid by every task that can get there, all the time. In the
+ * arena it is paid once, by the tasks that use it at the same moment.
+ *
+ * A task takes a mark, allocates from the top of the arena and releases
+ * everything it allocated since the mark:
+ *
+ *     const scratch_mark_t mark = scratch_mark();
+ *     char *line = scratch_alloc(64, 0);
+ *
+ *     if(line != NULL)
+ *     {
+ *         ...
+ *     }
+ *     scratch_release(mark);
+ *
+ * The tasks share the arena, so the blocks of different tasks interleave.
+ * A release only frees the blocks of the calling task, and the top goes
+ * down to the highest block still in use. A block that is freed below a
+ * block of another task is reused when that one is released too, so keep
+ * the time between mark and release short.
+ */
+
+/// \name Definitions for the scratch arena
+/// \{
+
+/*!
+ * \brief Size of the arena in bytes, a multiple of SCRATCH_ALIGN
+ */
+#ifndef SCRATCH_SIZE
+#define SCRATCH_SIZE    (256)
+#endif
+
+/*!
+ * \brief Alignment of the blocks in bytes
+ */
+#define SCRATCH_ALIGN   (8)
+
+/// \}
+
+/// Number of an allocation, see scratch_mark()
+typedef uint32_t scratch_mark_t;
+
+/// Usage of the arena
+typedef struct
+{
+    uint32_t size;          ///< Size of the arena in bytes
+    uint32_t blocks;        ///< Blocks in the arena, freed ones included
+    uint32_t used;          ///< Bytes from the start to the top
+    uint32_t peak;          ///< Highest top
+    uint32_t failures;      ///< Allocations that did not fit in time
+}
+scratch_stats_t;
+
+// Function prototypes
+scratch_mark_t scratch_mark(void);
+void *scratch_alloc(const uint32_t size, const TickType_t timeout);
+void scratch_release(const scratch_mark_t mark);
+void scratch_get_stats(scratch_stats_t *stats);
+
+#endif // SCRATCH_H
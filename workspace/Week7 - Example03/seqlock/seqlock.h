@@ -0,0 +1,151 @@
+/*! ***************************************************************************
+ *
+ * \brief     Lock-free latest value snapshots
+ * \file      seqlock.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <MKL25Z4.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * A seqlock holds the latest value of a variable that one writer, an
+ * interrupt handler or a task, updates and any number of tasks and
+ * interrupt handlers read. The value is kept twice. The writer fills the
+ * copy that readers do not use and then publishes it by incrementing the
+ * sequence number with a single store, so a reader that interrupts the
+ * writer reads the previous value in full. A reader that was interrupted
+ * by two writes while it copied sees the sequence number change and copies
+ * again. The writer never waits and no interrupts are masked.
+ *
+ * Writes to the same seqlock must not interrupt each other. Serialise them
+ * with a critical section if both a task and an interrupt handler write.
+ */
+
+/*!
+ * \brief Defines a seqlock with a zero value on an array of two copies
+ *
+ * Example:
+ *
+ *     static sample_t sample_copies[2];
+ *     static seqlock_t sample_lock = SEQLOCK_INIT(sample_copies);
+ */
+#define SEQLOCK_INIT(copies)    {(uint8_t *)(copies), sizeof((copies)[0]), 0}
+
+/// A seqlock, defined with SEQLOCK_INIT() or set up with seqlock_init()
+typedef struct
+{
+    uint8_t *buf;               ///< Two copies of size bytes
+    uint32_t size;              ///< Bytes of the value
+    volatile uint32_t seq;      ///< Number of writes, seq & 1 is the newest
+}
+seqlock_t;
+
+/*!
+ * \brief Sets up a seqlock
+ *
+ * \param[out] s      Seqlock
+ * \param[in]  buf    Storage of 2 * size bytes, kept by reference
+ * \param[in]  size   Bytes of the value
+ * \param[in]  value  Initial value of size bytes, NULL for all zero
+ */
+static inline void seqlock_init(seqlock_t *s, void *buf, const uint32_t size,
+    const void *value)
+{
+    s->buf = (uint8_t *)buf;
+    s->size = size;
+    s->seq = 0;
+
+    if(value != NULL)
+    {
+        memcpy(s->buf, value, size);
+    }
+    else
+    {
+        memset(s->buf, 0, size);
+    }
+}
+
+/*!
+ * \brief Publishes a new value, writer only
+ *
+ * \param[in,out] s      Seqlock
+ * \param[in]     value  Value of s->size bytes
+ */
+static inline void seqlock_write(seqlock_t *s, const void *value)
+{
+    const uint32_t seq = s->seq + 1;
+
+    memcpy(&s->buf[(seq & 1) * s->size], value, s->size);
+
+    // The copy must be complete before readers can select it
+    __DMB();
+    s->seq = seq;
+}
+
+/*!
+ * \brief Copies the latest value
+ *
+ * Never blocks the writer. Can be called from an interrupt handler.
+ *
+ * \param[in]  s      Seqlock
+ * \param[out] value  Value of s->size bytes
+ *
+ * \return Number of writes of the value, a reader compares it with the
+ *         previous result to find out if the value is new
+ */
+static inline uint32_t seqlock_read(const seqlock_t *s, void *value)
+{
+    uint32_t seq;
+
+    do
+    {
+        seq = s->seq;
+        __DMB();
+
+        memcpy(value, &s->buf[(seq & 1) * s->size], s->size);
+
+        // The copy must be complete before the sequence number is checked
+        __DMB();
+    }
+    while(seq != s->seq);
+
+    return seq;
+}
+
+/*!
+ * \brief Returns the number of writes of the value
+ */
+static inline uint32_t seqlock_seq(const seqlock_t *s)
+{
+    return s->seq;
+}
+
+#endif // SEQLOCK_H
@@ -29,192 +29,1515 @@
  */
 
 /*
-	BASIC INTERRUPT DRIVEN SERIAL PORT DRIVER FOR UART0.
+	BASIC INTERRUPT DRIVEN SERIAL PORT DRIVER FOR UART0, UART1 AND UART2.
+
+	Each port has its own transmit stream buffer, receive ring, mutex,
+	transmit policy and statistics. The transmit stream buffer has many
+	writers (all tasks that print), so writes are serialised with the port
+	mutex. The receive ring (ring/ring.h) has a single writer, the ISR, and
+	must have a single reader task, so a received byte costs no critical
+	section. Its size is uxQueueLength rounded down to a power of two.
+
+	The functions without a port handle operate on the port opened with
+	xSerialPortInit(), which is UART0 (serCOM1).
+
+	xSerialPortPrintf() formats with xformat() straight into the transmit
+	stream buffer, so no line buffer is needed on the stack of the caller.
+
+	UART0 only: buffers of at least serDMA_TX_THRESHOLD bytes are optionally
+	transmitted by DMA channel 0 (see serUSE_DMA_TX in serial.h). This costs
+	one interrupt per buffer instead of one interrupt per character. Both
+	DMA channels are claimed from the DMA manager (dma/dma.h) in
+	xSerialPortInitMinimal(), the port falls back to interrupts if another
+	driver has them.
+
+	UART0 only: with serUSE_DMA_RX set, DMA channel 1 receives into two
+	ping-pong frame buffers instead. The idle line interrupt ends a frame,
+	which is handed to the task blocked in xSerialGetFrame() with a single
+	notification.
+
+	UART0 only: with serLOW_POWER_RX set, the receiver runs from OSCERCLK
+	while the MCU is in VLPS and its active edge interrupt wakes the MCU,
+	see prvSerialStop().
 */
 
-/* Scheduler includes. */
-#include "FreeRTOS.h"
-#include "queue.h"
-#include "semphr.h"
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+
+#include <string.h>
+
+/* Library includes. */
+#include "xprintf.h"
+#include "MKL25Z4.h"
+
+/* Demo application includes. */
+#include "serial.h"
+#include "bme.h"
+#include "clock.h"
+#include "dma.h"
+#include "irq_prio.h"
+#include "ring.h"
+#include "sections.h"
+
+#if( serLOW_POWER_RX == 1 )
+#include "lowpower.h"
+
+#if( LP_STOP_MODE != LP_VLPS )
+#error "serLOW_POWER_RX requires LP_STOP_MODE LP_VLPS"
+#endif
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/* Misc defines. */
+#define serINVALID_BUFFER   ( ( StreamBufferHandle_t ) 0 )
+#define serNO_BLOCK		    ( ( TickType_t ) 0 )
+#define serTX_BLOCK_TIME    ( 40 / portTICK_PERIOD_MS )
+
+/* Baud rate generator defines. UART0 runs on the peripheral clock, UART1
+ * and UART2 on the bus clock of the clock manager. */
+#define serOSR_MIN          ( 4 )
+#define serOSR_MAX          ( 32 )
+#define serSBR_MAX          ( 0x1FFF )
+
+/* DMA defines. */
+#define serDMA_CHANNEL      ( 0 )
+#define serDMA_RX_CHANNEL   ( 1 )
+#define serDMA_TX_MARGIN    ( 2 / portTICK_PERIOD_MS + 1 )
+
+/* UART0 clock in the stop modes with serLOW_POWER_RX, OSCERCLK. */
+#define serSTOP_CLOCK_HZ    ( CPU_XTAL_CLK_HZ )
+
+/*---------------------------------------------------------------------------*/
+
+/* State of one serial port. UART0 is accessed through UART_Type, its first
+ * eight registers (BDH up to and including D) match those of UART1/UART2. */
+struct xCOM_PORT
+{
+    UART_Type * pxUart;
+    IRQn_Type xIrq;
+
+    /* The ring and the stream buffer used to hold characters. */
+    ring_t xRxedChars;
+    StreamBufferHandle_t xCharsForTx;
+    SemaphoreHandle_t xStringMutex;
+    StaticStreamBuffer_t xCharsForTxBuffer;
+    StaticSemaphore_t xStringMutexBuffer;
+    size_t xTxBufferSize;
+    unsigned long ulBaudRate;
+    unsigned long ulWantedBaud;
+
+    /* Clock mode changes, and the transmit requests held during one. */
+    clk_notifier_t xClock;
+    uint8_t ucHeldC2;
+    uint8_t ucHeldC5;
+
+    /* Port wide transmit policy, used by vSerialPortPutString() and
+     * xSerialPortWrite(). */
+    eSerialTxPolicy eTxPolicy;
+    TickType_t xTxPolicyBlockTime;
+
+    /* Drop counters and high-water marks. */
+    volatile SerialStats_t xStats;
+
+    /* Called for every received byte, NULL for none. */
+    SerialRxCallback_t pxRxCallback;
+    void * pvRxCallbackArg;
+};
+
+/* Pin configuration of each port. */
+typedef struct
+{
+    PORT_Type * pxPort;
+    uint32_t ulPortClockMask;
+    clk_gate_t eUartClockGate;
+    uint8_t ucTxPin;
+    uint8_t ucRxPin;
+    uint8_t ucMux;
+} xComPortPins;
+
+static const xComPortPins xPins[ serNUM_PORTS ] =
+{
+    { serCOM1_PORT, serCOM1_PORT_CLOCK, CLK_GATE_UART0, serCOM1_TX_PIN, serCOM1_RX_PIN, serCOM1_MUX },
+    { serCOM2_PORT, serCOM2_PORT_CLOCK, CLK_GATE_UART1, serCOM2_TX_PIN, serCOM2_RX_PIN, serCOM2_MUX },
+    { serCOM3_PORT, serCOM3_PORT_CLOCK, CLK_GATE_UART2, serCOM3_TX_PIN, serCOM3_RX_PIN, serCOM3_MUX },
+};
+
+static struct xCOM_PORT xPorts[ serNUM_PORTS ] =
+{
+    { ( UART_Type * )UART0, UART0_IRQn },
+    { UART1, UART1_IRQn },
+    { UART2, UART2_IRQn },
+};
+
+/* Storage of the rings and stream buffers, handed out by xSerialPortOpen(). Ports are
+ * never closed, so the storage is never returned. */
+static uint8_t ucBufferPool[ serBUFFER_POOL_SIZE ];
+static size_t xBufferPoolUsed = 0;
+
+/* The port used by the functions without a port handle. */
+static xComPortHandle xDefaultPort = NULL;
+
+/* UART0 */
+#define serUART0_PORT       ( &xPorts[ serCOM1 ] )
+
+#if( serLOW_POWER_RX == 1 )
+/* UART0 registers of a stop mode: C4, BDH, BDL and C5. The stop divisors
+ * are set with the baud rate, the run ones are saved for the wake-up. */
+typedef struct
+{
+    uint8_t ucC4;
+    uint8_t ucBdh;
+    uint8_t ucBdl;
+    uint8_t ucC5;
+} xUart0Divisors;
+
+static lp_notifier_t xLowPower;
+static xUart0Divisors xStopDivisors;
+static xUart0Divisors xRunDivisors;
+
+static void prvSerialStop( const lp_event_t eEvent, void *pvArg );
+#endif
+
+static uint32_t prvSerialFindBaudUart0( uint32_t ulClockHz, unsigned long ulWantedBaud,
+                                        uint32_t *pulOsr, uint32_t *pulSbr );
+static portBASE_TYPE prvSerialSetBaudUart0( xComPortHandle pxPort, unsigned long ulWantedBaud );
+static portBASE_TYPE prvSerialSetBaudUart( xComPortHandle pxPort, unsigned long ulWantedBaud );
+static void prvSerialClock( const clk_event_t eEvent, void *pvPort );
+
+static size_t prvSerialWrite( xComPortHandle pxPort, const char * pcBuffer, size_t xLength,
+                              eSerialTxPolicy ePolicy, TickType_t xBlockTime );
+static size_t prvSerialTransmit( xComPortHandle pxPort, const char * const pcBuffer, size_t xLength,
+                                 eSerialTxPolicy ePolicy, TickType_t xBlockTime );
+static void prvSerialIRQHandler( xComPortHandle pxPort, portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+#if( serUSE_DMA_TX == 1 )
+/* Set while DMA channel 0 owns the UART0 transmitter. */
+static volatile portBASE_TYPE xTxDmaBusy = pdFALSE;
+
+/* Set if DMA channel 0 was claimed. */
+static portBASE_TYPE xTxDmaClaimed = pdFALSE;
+
+/* The task waiting for the DMA transfer to complete. */
+static TaskHandle_t xTxDmaTask = NULL;
+
+static size_t prvSerialDmaWrite( const char * const pcBuffer, size_t xLength );
+static void prvSerialDmaTxIsr( void *pvArg, const uint32_t ulStatus, BaseType_t *pxHigherPriorityTaskWoken );
+#endif
+
+#if( serUSE_DMA_RX == 1 )
+/* Ping-pong frame buffers. DMA fills ucRxFrame[ucRxActive]. A completed
+ * frame is held in the other buffer until xSerialGetFrame() has copied it. */
+static __BSS_SRAM_U uint8_t ucRxFrame[ 2 ][ serRX_FRAME_SIZE ];
+static volatile size_t xRxFrameLength[ 2 ];
+static volatile uint8_t ucRxActive = 0;
+static volatile int8_t cRxReady = -1;
+
+/* The task waiting for a frame. */
+static TaskHandle_t xRxFrameTask = NULL;
+
+static void prvSerialRxArm( uint8_t ucBuffer );
+static void prvSerialRxFrameComplete( portBASE_TYPE *pxHigherPriorityTaskWoken );
+static void prvSerialDmaRxIsr( void *pvArg, const uint32_t ulStatus, BaseType_t *pxHigherPriorityTaskWoken );
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * See the serial.h header file.
+ */
+portBASE_TYPE xSerialPortInit( unsigned long ulWantedBaud,
+                               unsigned portBASE_TYPE uxQueueLength )
+{
+    portBASE_TYPE xReturn = pdFALSE;
+
+    xDefaultPort = xSerialPortOpen( serCOM1, ulWantedBaud, uxQueueLength );
+
+    if( xDefaultPort != NULL )
+    {
+        xReturn = pdTRUE;
+    }
+
+    return xReturn;
+}
+
+/*---------------------------------------------------------------------------*/
+
+xComPortHandle xSerialPortOpen( eCOMPort ePort, unsigned long ulWantedBaud,
+                                unsigned portBASE_TYPE uxQueueLength )
+{
+    xComPortHandle pxPort;
+    const xComPortPins *pxPins;
+    portBASE_TYPE xBaudOk;
+    uint8_t *pucStorage;
+    size_t xRxSize = 1;
+
+    while( ( xRxSize * 2 ) <= uxQueueLength )
+    {
+        xRxSize *= 2;
+    }
+
+    const size_t xStorageSize = xRxSize + ( uxQueueLength + 2 );
+
+    if( ( ePort >= serNUM_PORTS ) || ( ulWantedBaud == 0 ) ||
+        ( xStorageSize > serBUFFER_POOL_SIZE - xBufferPoolUsed ) )
+    {
+        return NULL;
+    }
+
+    pxPort = &xPorts[ ePort ];
+    pxPins = &xPins[ ePort ];
+
+    pucStorage = &ucBufferPool[ xBufferPoolUsed ];
+    xBufferPoolUsed += xStorageSize;
+
+    // Create the ring and the stream buffer used to hold Rx/Tx characters.
+	ring_init( &pxPort->xRxedChars, pucStorage, xRxSize, 1, serRX_NOTIFY_INDEX );
+	ring_set_watermark( &pxPort->xRxedChars, serRX_TRIGGER_LEVEL );
+	pxPort->xCharsForTx = xStreamBufferCreateStatic( uxQueueLength + 1, 1,
+	                                                 pucStorage + xRxSize,
+	                                                 &pxPort->xCharsForTxBuffer );
+	pxPort->xTxBufferSize = uxQueueLength + 1;
+	pxPort->eTxPolicy = serTX_DEFAULT_POLICY;
+	pxPort->xTxPolicyBlockTime = serTX_BLOCK_TIME;
+
+	// Create mutex
+	pxPort->xStringMutex = xSemaphoreCreateMutexStatic( &pxPort->xStringMutexBuffer );
+
+	// If the buffers were not created correctly the port cannot be used
+	if( ( pxPort->xCharsForTx == serINVALID_BUFFER ) ||
+	    ( pxPort->xStringMutex == NULL ) )
+	{
+		return NULL;
+	}
+
+    // enable clock to UART and port
+    clk_gate_acquire( pxPins->eUartClockGate );
+    SIM->SCGC5 |= pxPins->ulPortClockMask;
+
+    if( ePort == serCOM1 )
+    {
+        // Set UART clock to the peripheral clock, 48 MHz in CLK_RUN
+        clk_periph_select();
+    }
+
+    // select UART pins
+    pxPins->pxPort->PCR[ pxPins->ucTxPin ] = PORT_PCR_ISF_MASK | PORT_PCR_MUX( pxPins->ucMux );
+    pxPins->pxPort->PCR[ pxPins->ucRxPin ] = PORT_PCR_ISF_MASK | PORT_PCR_MUX( pxPins->ucMux );
+
+    pxPort->pxUart->C2 &= ~(UART_C2_TE_MASK | UART_C2_RE_MASK);
+
+    // No parity, 8 bits, one stop bit, other settings;
+    pxPort->pxUart->C1 = 0;
+    pxPort->pxUart->S2 = 0;
+    pxPort->pxUart->C3 = 0;
+
+    // Set baud rate to the closest achievable baud rate
+    if( ePort == serCOM1 )
+    {
+        UART0->C5 = 0;
+        xBaudOk = prvSerialSetBaudUart0( pxPort, ulWantedBaud );
+    }
+    else
+    {
+        pxPort->pxUart->C4 = 0;
+        xBaudOk = prvSerialSetBaudUart( pxPort, ulWantedBaud );
+    }
+
+    if( xBaudOk != pdTRUE )
+    {
+        return NULL;
+    }
+
+    // Set the baud rate again after every clock mode change
+    pxPort->ulWantedBaud = ulWantedBaud;
+    clk_register( &pxPort->xClock, prvSerialClock, pxPort );
+
+#if( serLOW_POWER_RX == 1 )
+    if( ePort == serCOM1 )
+    {
+        // Keep the crystal running in the stop modes, for OSCERCLK
+        OSC0->CR |= OSC_CR_EREFSTEN_MASK;
+        lp_register( &xLowPower, prvSerialStop, pxPort );
+    }
+#endif
+
+    // Enable transmitter and receiver but not interrupts
+    pxPort->pxUart->C2 = UART_C2_TE_MASK | UART_C2_RE_MASK;
+
+    // Interrupt on an overrun, noise and a framing error, so a lost byte is
+    // counted even when RDRF does not interrupt. There is no parity.
+    pxPort->pxUart->C3 = UART_C3_ORIE_MASK | UART_C3_NEIE_MASK | UART_C3_FEIE_MASK;
+
+    // Enable the interrupt in the NVIC
+    NVIC_SetPriority(pxPort->xIrq, IRQ_PRIO(SERIAL));
+    NVIC_ClearPendingIRQ(pxPort->xIrq);
+    NVIC_EnableIRQ(pxPort->xIrq);
+
+    if( ePort != serCOM1 )
+    {
+        // Enable receive interrupts
+        pxPort->pxUart->C2 |= UART_C2_RIE_MASK;
+
+        return pxPort;
+    }
+
+#if( serUSE_DMA_RX == 1 )
+    // Claim DMA channel 1 for good and route the UART0 receive request to it
+    if( dma_claim( serDMA_RX_CHANNEL, prvSerialDmaRxIsr, NULL ) == serDMA_RX_CHANNEL )
+    {
+        dma_route( serDMA_RX_CHANNEL, DMA_SOURCE_UART0_RX, false );
+
+        // Fixed source: the UART0 data register
+        DMA0->DMA[serDMA_RX_CHANNEL].SAR = (uint32_t)&UART0->D;
+        prvSerialRxArm(0);
+
+        dma_irq_enable( serDMA_RX_CHANNEL, IRQ_PRIO(SERIAL_DMA) );
+
+        // Idle line detection starts after the stop bit. RDRF generates DMA
+        // requests and the idle line interrupt ends a frame.
+        UART0->C1 |= UART0_C1_ILT_MASK;
+        UART0->C5 |= UART0_C5_RDMAE_MASK;
+        UART0->C2 |= UART_C2_ILIE_MASK;
+    }
+    else
+#endif
+    {
+        // Enable receive interrupts
+        UART0->C2 |= UART_C2_RIE_MASK;
+    }
+
+#if( serUSE_DMA_TX == 1 )
+    // Claim DMA channel 0 for good and route the UART0 transmit request to it
+    if( dma_claim( serDMA_CHANNEL, prvSerialDmaTxIsr, NULL ) == serDMA_CHANNEL )
+    {
+        dma_route( serDMA_CHANNEL, DMA_SOURCE_UART0_TX, false );
+
+        // Fixed destination: the UART0 data register
+        DMA0->DMA[serDMA_CHANNEL].DAR = (uint32_t)&UART0->D;
+
+        dma_irq_enable( serDMA_CHANNEL, IRQ_PRIO(SERIAL_DMA) );
+
+        xTxDmaClaimed = pdTRUE;
+    }
+#endif
+
+    return pxPort;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Returns pdTRUE if the baud rate error is within serMAX_BAUD_ERROR_PPT.
+ */
+static portBASE_TYPE prvSerialBaudErrorOk( unsigned long ulWantedBaud, uint32_t ulError )
+{
+    // Error in parts per thousand
+    if( ( ( uint64_t )ulError * 1000 ) > ( ( uint64_t )ulWantedBaud * serMAX_BAUD_ERROR_PPT ) )
+    {
+        return pdFALSE;
+    }
+
+    return pdTRUE;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * UART0: search the oversampling ratio (OSR) and the baud rate divisor (SBR)
+ * together for the lowest baud rate error: baud = clock / (OSR * SBR).
+ * On equal error the highest OSR is used, as it samples each bit more
+ * often. Returns the error in baud, UINT32_MAX with *pulSbr 0 if no divisor
+ * fits.
+ */
+static uint32_t prvSerialFindBaudUart0( uint32_t ulClockHz, unsigned long ulWantedBaud,
+                                        uint32_t *pulOsr, uint32_t *pulSbr )
+{
+    uint32_t ulOsr;
+    uint32_t ulSbr;
+    uint32_t ulError;
+    uint32_t ulBestError = UINT32_MAX;
+    uint32_t ulActual;
+
+    *pulOsr = 0;
+    *pulSbr = 0;
+
+    for( ulOsr = serOSR_MAX; ulOsr >= serOSR_MIN; ulOsr-- )
+    {
+        // Rounded divisor for this oversampling ratio
+        ulSbr = ( ulClockHz + ( ulWantedBaud * ulOsr ) / 2 ) /
+                ( ulWantedBaud * ulOsr );
+
+        if( ( ulSbr == 0 ) || ( ulSbr > serSBR_MAX ) )
+        {
+            continue;
+        }
+
+        ulActual = ulClockHz / ( ulOsr * ulSbr );
+        ulError = ( ulActual > ulWantedBaud ) ? ( ulActual - ulWantedBaud ) :
+                                                ( ulWantedBaud - ulActual );
+
+        if( ulError < ulBestError )
+        {
+            ulBestError = ulError;
+            *pulOsr = ulOsr;
+            *pulSbr = ulSbr;
+        }
+    }
+
+    return ulBestError;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * UART0: sets the divisors of prvSerialFindBaudUart0() for the peripheral
+ * clock. With serLOW_POWER_RX the divisors for OSCERCLK in the stop modes
+ * are found as well, their error is not checked. Returns pdFALSE if the
+ * error exceeds serMAX_BAUD_ERROR_PPT.
+ */
+static portBASE_TYPE prvSerialSetBaudUart0( xComPortHandle pxPort, unsigned long ulWantedBaud )
+{
+    uint32_t ulBestOsr;
+    uint32_t ulBestSbr;
+    const uint32_t ulBestError = prvSerialFindBaudUart0( clk_periph_hz(), ulWantedBaud,
+                                                         &ulBestOsr, &ulBestSbr );
+
+    if( ulBestSbr == 0 )
+    {
+        return pdFALSE;
+    }
+
+    UART0->C4 = UART0_C4_OSR( ulBestOsr - 1 );
+    UART0->BDH = UART0_BDH_SBR( ulBestSbr >> 8 );
+    UART0->BDL = UART0_BDL_SBR( ulBestSbr );
+
+    // Oversampling ratios from 4 to 7 require sampling on both edges
+    if( ulBestOsr < 8 )
+    {
+        UART0->C5 |= UART0_C5_BOTHEDGE_MASK;
+    }
+    else
+    {
+        UART0->C5 &= ~UART0_C5_BOTHEDGE_MASK;
+    }
+
+    pxPort->ulBaudRate = clk_periph_hz() / ( ulBestOsr * ulBestSbr );
+
+#if( serLOW_POWER_RX == 1 )
+    uint32_t ulStopOsr;
+    uint32_t ulStopSbr;
+
+    ( void ) prvSerialFindBaudUart0( serSTOP_CLOCK_HZ, ulWantedBaud, &ulStopOsr, &ulStopSbr );
+
+    if( ulStopSbr == 0 )
+    {
+        // Too fast for OSCERCLK, keep the divisors of the peripheral clock
+        ulStopOsr = ulBestOsr;
+        ulStopSbr = ulBestSbr;
+    }
+
+    // The RX active edge interrupt wakes the MCU
+    xStopDivisors.ucC4 = UART0_C4_OSR( ulStopOsr - 1 );
+    xStopDivisors.ucBdh = UART0_BDH_SBR( ulStopSbr >> 8 ) | UART0_BDH_RXEDGIE_MASK;
+    xStopDivisors.ucBdl = UART0_BDL_SBR( ulStopSbr );
+    xStopDivisors.ucC5 = ( ulStopOsr < 8 ) ? UART0_C5_BOTHEDGE_MASK : 0;
+#endif
+
+    return prvSerialBaudErrorOk( ulWantedBaud, ulBestError );
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * UART1 and UART2: fixed 16x oversampling from the 24 MHz bus clock.
+ * Returns pdFALSE if the error exceeds serMAX_BAUD_ERROR_PPT.
+ */
+static portBASE_TYPE prvSerialSetBaudUart( xComPortHandle pxPort, unsigned long ulWantedBaud )
+{
+    uint32_t ulSbr;
+    uint32_t ulActual;
+    uint32_t ulError;
+
+    // Rounded divisor
+    ulSbr = ( clk_bus_hz() + ( ulWantedBaud * 8 ) ) / ( ulWantedBaud * 16 );
+
+    if( ( ulSbr == 0 ) || ( ulSbr > serSBR_MAX ) )
+    {
+        return pdFALSE;
+    }
+
+    pxPort->pxUart->BDH = UART_BDH_SBR( ulSbr >> 8 );
+    pxPort->pxUart->BDL = UART_BDL_SBR( ulSbr );
+
+    ulActual = clk_bus_hz() / ( 16 * ulSbr );
+    ulError = ( ulActual > ulWantedBaud ) ? ( ulActual - ulWantedBaud ) :
+                                            ( ulWantedBaud - ulActual );
+
+    pxPort->ulBaudRate = ulActual;
+
+    return prvSerialBaudErrorOk( ulWantedBaud, ulError );
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Holds the transmitter during a clock mode change. Before the change the
+ * transmit interrupt and DMA requests are disabled and the last character is
+ * sent, after it the baud rate is set for the new clock with the transmitter
+ * and receiver disabled, as the reference manual requires, and the requests
+ * are enabled again. A character received during the change is lost. The
+ * baud rate error is not checked, ulSerialPortGetBaud() returns the new
+ * baud rate.
+ */
+static void prvSerialClock( const clk_event_t eEvent, void *pvPort )
+{
+    xComPortHandle pxPort = ( xComPortHandle ) pvPort;
+    const uint8_t ucEnable = UART_C2_TE_MASK | UART_C2_RE_MASK;
+
+    if( eEvent == CLK_PRE_CHANGE )
+    {
+        taskENTER_CRITICAL();
+        {
+            pxPort->ucHeldC2 = pxPort->pxUart->C2 & ( UART_C2_TIE_MASK | UART_C2_TCIE_MASK );
+            BME_CLR( pxPort->pxUart->C2, pxPort->ucHeldC2 );
+
+            if( pxPort == serUART0_PORT )
+            {
+                pxPort->ucHeldC5 = UART0->C5 & UART0_C5_TDMAE_MASK;
+                BME_CLR( UART0->C5, UART0_C5_TDMAE_MASK );
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( pxPort->pxUart->C2 & UART_C2_TE_MASK )
+        {
+            while( ( pxPort->pxUart->S1 & UART_S1_TC_MASK ) == 0 )
+            {}
+        }
+    }
+    else
+    {
+        const uint8_t ucC2 = pxPort->pxUart->C2;
+
+        pxPort->pxUart->C2 = ucC2 & ~ucEnable;
+
+        if( pxPort == serUART0_PORT )
+        {
+            ( void ) prvSerialSetBaudUart0( pxPort, pxPort->ulWantedBaud );
+        }
+        else
+        {
+            ( void ) prvSerialSetBaudUart( pxPort, pxPort->ulWantedBaud );
+        }
+
+        taskENTER_CRITICAL();
+        {
+            pxPort->pxUart->C2 = ucC2 | pxPort->ucHeldC2;
+
+            if( pxPort == serUART0_PORT )
+            {
+                UART0->C5 |= pxPort->ucHeldC5;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+#if( serLOW_POWER_RX == 1 )
+/*
+ * Moves UART0 to OSCERCLK for a stop mode and back, called by
+ * lp_suppress_ticks_and_sleep() with interrupts masked. A character that is
+ * being received is finished first, both clock switches are done with the
+ * transmitter and receiver disabled. The transmitter is idle, UART0 vetoes a
+ * stop mode while it transmits. A character received in the stop mode stays
+ * in the data register and is read by the receive interrupt once interrupts
+ * are enabled again.
+ */
+static void prvSerialStop( const lp_event_t eEvent, void *pvArg )
+{
+    const uint8_t ucC2 = UART0->C2;
+    const uint8_t ucEnable = UART_C2_TE_MASK | UART_C2_RE_MASK;
+    const xUart0Divisors *pxDivisors;
+
+    ( void ) pvArg;
+
+    while( UART0->S2 & UART0_S2_RAF_MASK )
+    {}
+
+    UART0->C2 = ucC2 & ~ucEnable;
+
+    if( eEvent == LP_PRE_STOP )
+    {
+        xRunDivisors.ucC4 = UART0->C4;
+        xRunDivisors.ucBdh = UART0->BDH;
+        xRunDivisors.ucBdl = UART0->BDL;
+        xRunDivisors.ucC5 = UART0->C5 & UART0_C5_BOTHEDGE_MASK;
+
+        SIM->SOPT2 = ( SIM->SOPT2 & ~SIM_SOPT2_UART0SRC_MASK ) | SIM_SOPT2_UART0SRC( 2 );
+        pxDivisors = &xStopDivisors;
+    }
+    else
+    {
+        // The edge that woke the MCU, write 1 clears the flag
+        UART0->S2 = ( UART0->S2 & ~UART0_S2_LBKDIF_MASK ) | UART0_S2_RXEDGIF_MASK;
+
+        clk_periph_select();
+        pxDivisors = &xRunDivisors;
+    }
+
+    UART0->C4 = pxDivisors->ucC4;
+    UART0->BDH = pxDivisors->ucBdh;
+    UART0->BDL = pxDivisors->ucBdl;
+    UART0->C5 = ( UART0->C5 & ~UART0_C5_BOTHEDGE_MASK ) | pxDivisors->ucC5;
+
+    UART0->C2 = ucC2;
+}
+
+/*---------------------------------------------------------------------------*/
+#endif
+
+unsigned long ulSerialPortGetBaud( xComPortHandle pxPort )
+{
+    return ( pxPort != NULL ) ? pxPort->ulBaudRate : 0;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Changes the baud rate of an open port, with the same hold of the
+ * transmitter as a clock mode change. Bytes still in the transmit buffer
+ * are sent at the new rate, so let the buffer drain first. Returns pdFALSE
+ * and keeps the old rate if the error exceeds serMAX_BAUD_ERROR_PPT. Do not
+ * call it during a clock mode change.
+ */
+portBASE_TYPE xSerialPortSetBaud( xComPortHandle pxPort, unsigned long ulWantedBaud )
+{
+    if( ( pxPort == NULL ) || ( ulWantedBaud == 0 ) )
+    {
+        return pdFALSE;
+    }
+
+    const unsigned long ulOldBaud = pxPort->ulWantedBaud;
+
+    prvSerialClock( CLK_PRE_CHANGE, pxPort );
+    pxPort->ulWantedBaud = ulWantedBaud;
+    prvSerialClock( CLK_POST_CHANGE, pxPort );
+
+    const uint32_t ulError = ( pxPort->ulBaudRate > ulWantedBaud ) ?
+                             ( pxPort->ulBaudRate - ulWantedBaud ) :
+                             ( ulWantedBaud - pxPort->ulBaudRate );
+
+    if( prvSerialBaudErrorOk( ulWantedBaud, ulError ) == pdFALSE )
+    {
+        prvSerialClock( CLK_PRE_CHANGE, pxPort );
+        pxPort->ulWantedBaud = ulOldBaud;
+        prvSerialClock( CLK_POST_CHANGE, pxPort );
+
+        return pdFALSE;
+    }
+
+    return pdTRUE;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Connects the transmitter output to the receiver input inside the UART
+ * (loop mode, C1 LOOPS with RSRC cleared). The RX pin is then not used, so
+ * a port can be tested without a cable. Like a baud rate change, the
+ * receiver and transmitter are disabled while the mode changes.
+ */
+void vSerialPortSetLoopback( xComPortHandle pxPort, portBASE_TYPE xEnable )
+{
+    if( pxPort == NULL )
+    {
+        return;
+    }
+
+    const uint8_t ucEnable = UART_C2_TE_MASK | UART_C2_RE_MASK;
+
+    if( pxPort->pxUart->C2 & UART_C2_TE_MASK )
+    {
+        while( ( pxPort->pxUart->S1 & UART_S1_TC_MASK ) == 0 )
+        {}
+    }
+
+    taskENTER_CRITICAL();
+    {
+        const uint8_t ucC2 = pxPort->pxUart->C2;
+
+        pxPort->pxUart->C2 = ucC2 & ~ucEnable;
+
+        if( xEnable != pdFALSE )
+        {
+            pxPort->pxUart->C1 = ( pxPort->pxUart->C1 & ~UART_C1_RSRC_MASK ) | UART_C1_LOOPS_MASK;
+        }
+        else
+        {
+            pxPort->pxUart->C1 &= ~UART_C1_LOOPS_MASK;
+        }
+
+        pxPort->pxUart->C2 = ucC2;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Sets the function called in the receive interrupt for every byte put in
+ * the receive ring. The receive ring keeps its single reader, the callback
+ * only tells it that there is something to read.
+ */
+void vSerialPortSetRxCallback( xComPortHandle pxPort, SerialRxCallback_t pxCallback, void * pvArg )
+{
+    if( pxPort == NULL )
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        pxPort->pxRxCallback = pxCallback;
+        pxPort->pvRxCallbackArg = pvArg;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Start transmit interrupts after characters have been written to the
+ * transmit stream buffer.
+ */
+static void prvSerialStartTx( xComPortHandle pxPort )
+{
+    size_t xUsed = xStreamBufferBytesAvailable( pxPort->xCharsForTx );
+
+    if( xUsed > pxPort->xStats.xTxHighWaterMark )
+    {
+        pxPort->xStats.xTxHighWaterMark = xUsed;
+    }
+
+#if( serUSE_DMA_TX == 1 )
+    // While DMA owns the UART0 transmitter, the DMA interrupt enables the
+    // transmit interrupt when the transfer is complete.
+    taskENTER_CRITICAL();
+    {
+        if( ( pxPort != serUART0_PORT ) || ( xTxDmaBusy == pdFALSE ) )
+        {
+            BME_OR(pxPort->pxUart->C2, UART_C2_TIE_MASK);
+        }
+    }
+    taskEXIT_CRITICAL();
+#else
+    BME_OR(pxPort->pxUart->C2, UART_C2_TIE_MASK);
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Discard the xCount oldest bytes from the transmit stream buffer. The
+ * transmit interrupt, the only other reader, is masked meanwhile.
+ */
+static void prvSerialDiscardOldest( xComPortHandle pxPort, size_t xCount )
+{
+#if( configUSE_STREAM_BUFFER_SPANS == 1 )
+    // Released in place, without copying them out first
+    taskENTER_CRITICAL();
+    {
+        pxPort->xStats.ulTxBytesDropped += xStreamBufferReceiveRelease( pxPort->xCharsForTx, xCount );
+    }
+    taskEXIT_CRITICAL();
+#else
+    char cScratch[ 16 ];
+    size_t xChunk;
+
+    taskENTER_CRITICAL();
+    {
+        while( xCount > 0 )
+        {
+            xChunk = ( xCount < sizeof( cScratch ) ) ? xCount : sizeof( cScratch );
+            xChunk = xStreamBufferReceive( pxPort->xCharsForTx, cScratch, xChunk, serNO_BLOCK );
+
+            if( xChunk == 0 )
+            {
+                break;
+            }
+
+            pxPort->xStats.ulTxBytesDropped += xChunk;
+            xCount -= xChunk;
+        }
+    }
+    taskEXIT_CRITICAL();
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Write xLength bytes into the transmit stream buffer according to ePolicy.
+ * The caller must hold the port mutex. Returns the number of bytes of
+ * pcBuffer written. Bytes that are not written, or that are discarded from
+ * the buffer to make room, are added to the drop counter.
+ */
+static size_t prvSerialWrite( xComPortHandle pxPort, const char * pcBuffer, size_t xLength,
+                              eSerialTxPolicy ePolicy, TickType_t xBlockTime )
+{
+    size_t xWritten = 0;
+    size_t xSent;
+    size_t xSpace;
+
+    switch( ePolicy )
+    {
+    case eSerialBlock:
+        // A single send never writes more than fits in the stream buffer, so
+        // keep going while the ISR makes room
+        while( xWritten < xLength )
+        {
+            xSent = xStreamBufferSend( pxPort->xCharsForTx, &pcBuffer[xWritten],
+                                       xLength - xWritten, xBlockTime );
+
+            if( xSent == 0 )
+            {
+                break;
+            }
+
+            xWritten += xSent;
+            prvSerialStartTx( pxPort );
+        }
+        break;
+
+    case eSerialDropOldest:
+        // Only the tail of a write larger than the buffer can be kept
+        if( xLength > pxPort->xTxBufferSize )
+        {
+            pxPort->xStats.ulTxBytesDropped += xLength - pxPort->xTxBufferSize;
+            pcBuffer += xLength - pxPort->xTxBufferSize;
+            xLength = pxPort->xTxBufferSize;
+        }
+
+        xSpace = xStreamBufferSpacesAvailable( pxPort->xCharsForTx );
+        if( xSpace < xLength )
+        {
+            prvSerialDiscardOldest( pxPort, xLength - xSpace );
+        }
+
+        xWritten = xStreamBufferSend( pxPort->xCharsForTx, pcBuffer, xLength, serNO_BLOCK );
+        prvSerialStartTx( pxPort );
+        break;
+
+    case eSerialDropNewest:
+    default:
+        xWritten = xStreamBufferSend( pxPort->xCharsForTx, pcBuffer, xLength, serNO_BLOCK );
+        prvSerialStartTx( pxPort );
+        break;
+    }
+
+    pxPort->xStats.ulTxBytesDropped += xLength - xWritten;
+
+    return xWritten;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Transmit xLength bytes by DMA if this is UART0 and the write is large
+ * enough, otherwise through the transmit stream buffer. The caller must hold
+ * the port mutex.
+ */
+static size_t prvSerialTransmit( xComPortHandle pxPort, const char * const pcBuffer, size_t xLength,
+                                 eSerialTxPolicy ePolicy, TickType_t xBlockTime )
+{
+#if( serUSE_DMA_TX == 1 )
+    size_t xSent = 0;
+
+    if( ( pxPort == serUART0_PORT ) && ( xLength >= serDMA_TX_THRESHOLD ) )
+    {
+        xSent = prvSerialDmaWrite( pcBuffer, xLength );
+    }
+
+    if( xSent > 0 )
+    {
+        pxPort->xStats.ulTxBytesDropped += xLength - xSent;
+        return xSent;
+    }
+#endif
+
+    return prvSerialWrite( pxPort, pcBuffer, xLength, ePolicy, xBlockTime );
+}
+
+/*---------------------------------------------------------------------------*/
+
+portBASE_TYPE xSerialPortPutChar( xComPortHandle pxPort, char cOutChar, TickType_t xBlockTime )
+{
+    portBASE_TYPE xReturn = pdFAIL;
+
+    // Send the character to the stream buffer. Return false if xBlockTime
+    // expires.
+    if( ( pxPort != NULL ) && ( xSemaphoreTake( pxPort->xStringMutex, xBlockTime ) == pdTRUE ) )
+    {
+        if( prvSerialWrite( pxPort, &cOutChar, 1, eSerialBlock, xBlockTime ) == 1 )
+        {
+            xReturn = pdPASS;
+        }
+
+        xSemaphoreGive( pxPort->xStringMutex );
+    }
+
+    return xReturn;
+}
+
+/*---------------------------------------------------------------------------*/
+
+portBASE_TYPE xSerialPortGetChar( xComPortHandle pxPort, char *pcRxedChar, TickType_t xBlockTime )
+{
+	// Get the next character from the ring.  Return false if no characters
+	// are available, or arrive before xBlockTime expires.
+	if( ( pxPort != NULL ) &&
+	    ( ring_wait( &pxPort->xRxedChars, xBlockTime ) > 0 ) &&
+	    ring_get( &pxPort->xRxedChars, pcRxedChar ) )
+	{
+		return pdTRUE;
+	}
+	else
+	{
+		return pdFALSE;
+	}
+}
+
+/*---------------------------------------------------------------------------*/
+
+size_t xSerialPortWrite( xComPortHandle pxPort, const void * pvBuffer, size_t xLength )
+{
+    size_t xWritten = 0;
+
+    if( ( pxPort != NULL ) && ( xSemaphoreTake( pxPort->xStringMutex, portMAX_DELAY ) == pdTRUE ) )
+    {
+        xWritten = prvSerialTransmit( pxPort, ( const char * )pvBuffer, xLength,
+                                      pxPort->eTxPolicy, pxPort->xTxPolicyBlockTime );
+
+        xSemaphoreGive( pxPort->xStringMutex );
+    }
+
+    return xWritten;
+}
+
+/*---------------------------------------------------------------------------*/
+
+size_t xSerialPortRead( xComPortHandle pxPort, void * pvBuffer, size_t xLength, TickType_t xBlockTime )
+{
+    if( pxPort == NULL )
+    {
+        return 0;
+    }
+
+    // Returns as soon as serRX_TRIGGER_LEVEL bytes are available, or with
+    // whatever arrived when xBlockTime expires.
+    ( void ) ring_wait( &pxPort->xRxedChars, xBlockTime );
+
+    return ring_read( &pxPort->xRxedChars, pvBuffer, xLength );
+}
+
+/*---------------------------------------------------------------------------*/
+
+void vSerialPortPutString( xComPortHandle pxPort, const char * const pcString )
+{
+    // What happens when the buffer is full is decided by the port wide
+    // policy, see vSerialPortSetTxPolicy().
+
+    if( pxPort == NULL )
+    {
+        return;
+    }
+
+    // Attempt to take the mutex, blocking indefinitely to wait for the mutex
+    // if it is not available straight away. The call to xSemaphoreTake() will
+    // only return when the mutex has been successfully obtained, so there is
+    // no need to check the function return value. If any other delay period
+    // was used then the code must check that xSemaphoreTake() returns pdTRUE
+    // before accessing the shared resource (which in this case is standard
+    // out). As noted earlier in this book, indefinite time outs are not
+    // recommended for production code.
+    xSemaphoreTake(pxPort->xStringMutex, portMAX_DELAY);
+    {
+        (void)prvSerialTransmit(pxPort, pcString, strlen(pcString),
+                                pxPort->eTxPolicy, pxPort->xTxPolicyBlockTime);
+    }
+    xSemaphoreGive(pxPort->xStringMutex);
+}
+
+/*---------------------------------------------------------------------------*/
+
+size_t xSerialPortPutStringPolicy( xComPortHandle pxPort, const char * const pcString,
+                                   eSerialTxPolicy ePolicy, TickType_t xBlockTime )
+{
+    size_t xWritten = 0;
+
+    if( ( pxPort != NULL ) && ( xSemaphoreTake(pxPort->xStringMutex, portMAX_DELAY) == pdTRUE ) )
+    {
+        xWritten = prvSerialTransmit(pxPort, pcString, strlen(pcString), ePolicy,
+                                     xBlockTime);
+
+        xSemaphoreGive(pxPort->xStringMutex);
+    }
+
+    return xWritten;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Passes a piece of xvformat() output to the port, which the caller holds.
+ */
+static void prvSerialFormatOut( void * pvArg, const char * pcString, size_t xLength )
+{
+    xComPortHandle pxPort = ( xComPortHandle )pvArg;
+
+    ( void )prvSerialTransmit( pxPort, pcString, xLength,
+                              pxPort->eTxPolicy, pxPort->xTxPolicyBlockTime );
+}
+
+size_t xSerialPortVPrintf( xComPortHandle pxPort, const char * pcFormat, va_list xArgs )
+{
+    size_t xLength = 0;
+
+    // The output is formatted straight into the transmit buffer. The port is
+    // held for the whole string, so it is not mixed with other output.
+    if( ( pxPort != NULL ) && ( xSemaphoreTake( pxPort->xStringMutex, portMAX_DELAY ) == pdTRUE ) )
+    {
+        xLength = xvformat( prvSerialFormatOut, pxPort, pcFormat, xArgs );
+
+        xSemaphoreGive( pxPort->xStringMutex );
+    }
+
+    return xLength;
+}
+
+size_t xSerialPortPrintf( xComPortHandle pxPort, const char * pcFormat, ... )
+{
+    va_list xArgs;
 
-/* Library includes. */
-#include "MKL25Z4.h"
+    va_start( xArgs, pcFormat );
+    const size_t xLength = xSerialPortVPrintf( pxPort, pcFormat, xArgs );
+    va_end( xArgs );
 
-/* Demo application includes. */
-#include "serial.h"
+    return xLength;
+}
 
 /*---------------------------------------------------------------------------*/
 
-/* Misc defines. */
-#define serINVALID_QUEUE    ( ( QueueHandle_t ) 0 )
-#define serNO_BLOCK		    ( ( TickType_t ) 0 )
-#define serTX_BLOCK_TIME    ( 40 / portTICK_PERIOD_MS )
+void vSerialPortSetTxPolicy( xComPortHandle pxPort, eSerialTxPolicy ePolicy, TickType_t xBlockTime )
+{
+    if( pxPort == NULL )
+    {
+        return;
+    }
+
+    xSemaphoreTake(pxPort->xStringMutex, portMAX_DELAY);
+    {
+        pxPort->eTxPolicy = ePolicy;
+        pxPort->xTxPolicyBlockTime = xBlockTime;
+    }
+    xSemaphoreGive(pxPort->xStringMutex);
+}
+
+/*---------------------------------------------------------------------------*/
+
+void vSerialPortGetStats( xComPortHandle pxPort, SerialStats_t * pxStats )
+{
+    if( pxPort == NULL )
+    {
+        memset( pxStats, 0, sizeof( *pxStats ) );
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        *pxStats = pxPort->xStats;
+    }
+    taskEXIT_CRITICAL();
+}
 
 /*---------------------------------------------------------------------------*/
 
-/* The queues used to hold characters. */
-static QueueHandle_t xRxedChars;
-static QueueHandle_t xCharsForTx;
-static SemaphoreHandle_t xStringMutex;
+void vSerialPortResetStats( xComPortHandle pxPort )
+{
+    if( pxPort == NULL )
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        pxPort->xStats.ulTxBytesDropped = 0;
+        pxPort->xStats.ulRxBytesDropped = 0;
+        pxPort->xStats.ulRxFramesDropped = 0;
+        pxPort->xStats.ulRxOverruns = 0;
+        pxPort->xStats.ulRxFramingErrors = 0;
+        pxPort->xStats.ulRxNoiseErrors = 0;
+        pxPort->xStats.ulRxParityErrors = 0;
+        pxPort->xStats.xTxHighWaterMark = xStreamBufferBytesAvailable( pxPort->xCharsForTx );
+        pxPort->xStats.xRxHighWaterMark = ring_count( &pxPort->xRxedChars );
+    }
+    taskEXIT_CRITICAL();
+}
 
 /*---------------------------------------------------------------------------*/
 
 /*
- * See the serial.h header file.
+ * Single port API, operating on the port opened by xSerialPortInit().
  */
-portBASE_TYPE xSerialPortInit( unsigned long ulWantedBaud,
-                               unsigned portBASE_TYPE uxQueueLength )
+portBASE_TYPE xSerialPutChar( char cOutChar, TickType_t xBlockTime )
 {
-    portBASE_TYPE xReturn = pdTRUE;
+    return xSerialPortPutChar( xDefaultPort, cOutChar, xBlockTime );
+}
 
-    // Create the queues used to hold Rx/Tx characters.
-	xRxedChars = xQueueCreate( uxQueueLength, sizeof(char) );
-	xCharsForTx = xQueueCreate( uxQueueLength + 1, sizeof(char) );
+portBASE_TYPE xSerialGetChar( char *pcRxedChar, TickType_t xBlockTime )
+{
+    return xSerialPortGetChar( xDefaultPort, pcRxedChar, xBlockTime );
+}
 
-	// Create mutex
-	xStringMutex = xSemaphoreCreateMutex();
+size_t xSerialWrite( const void * pvBuffer, size_t xLength )
+{
+    return xSerialPortWrite( xDefaultPort, pvBuffer, xLength );
+}
 
-	// If the queue was created correctly then setup the UART peripheral
-	if( ( xRxedChars != serINVALID_QUEUE ) && ( xCharsForTx != serINVALID_QUEUE ) )
-	{
-        // enable clock to UART and Port A
-        SIM->SCGC4 |= SIM_SCGC4_UART0_MASK;
-        SIM->SCGC5 |= SIM_SCGC5_PORTA_MASK;
+size_t xSerialRead( void * pvBuffer, size_t xLength, TickType_t xBlockTime )
+{
+    return xSerialPortRead( xDefaultPort, pvBuffer, xLength, xBlockTime );
+}
 
-        // Set UART clock to 48 MHz
-        SIM->SOPT2 |= SIM_SOPT2_UART0SRC(1);
-        SIM->SOPT2 |= SIM_SOPT2_PLLFLLSEL_MASK;
+void vSerialPutString( const char * const pcString )
+{
+    vSerialPortPutString( xDefaultPort, pcString );
+}
 
-        // select UART pins
-        PORTA->PCR[1] = PORT_PCR_ISF_MASK | PORT_PCR_MUX(2);
-        PORTA->PCR[2] = PORT_PCR_ISF_MASK | PORT_PCR_MUX(2);
+size_t xSerialPutStringPolicy( const char * const pcString,
+                               eSerialTxPolicy ePolicy, TickType_t xBlockTime )
+{
+    return xSerialPortPutStringPolicy( xDefaultPort, pcString, ePolicy, xBlockTime );
+}
 
-        UART0->C2 &=  ~(UARTLP_C2_TE_MASK | UARTLP_C2_RE_MASK);
+size_t xSerialPrintf( const char * pcFormat, ... )
+{
+    va_list xArgs;
 
-        // Set baud rate to baud rate
-        uint32_t divisor = 48000000UL/(ulWantedBaud*16);
-        UART0->BDH = UART_BDH_SBR(divisor>>8);
-        UART0->BDL = UART_BDL_SBR(divisor);
+    va_start( xArgs, pcFormat );
+    const size_t xLength = xSerialPortVPrintf( xDefaultPort, pcFormat, xArgs );
+    va_end( xArgs );
 
-        // No parity, 8 bits, one stop bit, other settings;
-        UART0->C1 = 0;
-        UART0->S2 = 0;
-        UART0->C3 = 0;
+    return xLength;
+}
 
-        // Enable transmitter and receiver but not interrupts
-        UART0->C2 = UART_C2_TE_MASK | UART_C2_RE_MASK;
+void vSerialSetTxPolicy( eSerialTxPolicy ePolicy, TickType_t xBlockTime )
+{
+    vSerialPortSetTxPolicy( xDefaultPort, ePolicy, xBlockTime );
+}
 
-        // Enable the interrupt in the NVIC
-        NVIC_SetPriority(UART0_IRQn, 128);
-        NVIC_ClearPendingIRQ(UART0_IRQn);
-        NVIC_EnableIRQ(UART0_IRQn);
+void vSerialGetStats( SerialStats_t * pxStats )
+{
+    vSerialPortGetStats( xDefaultPort, pxStats );
+}
 
-        // Enable receive interrupts
-        UART0->C2 |= UART_C2_RIE_MASK;
-	}
-	else
-	{
-		xReturn = pdFALSE;
-	}
+void vSerialResetStats( void )
+{
+    vSerialPortResetStats( xDefaultPort );
+}
 
-	return xReturn;
+unsigned long ulSerialGetBaud( void )
+{
+    return ulSerialPortGetBaud( xDefaultPort );
 }
 
 /*---------------------------------------------------------------------------*/
 
-portBASE_TYPE xSerialPutChar( char cOutChar, TickType_t xBlockTime )
+xComPortHandle xSerialGetDefaultPort( void )
 {
-    portBASE_TYPE xReturn;
+    return xDefaultPort;
+}
+
+/*---------------------------------------------------------------------------*/
+
+portBASE_TYPE xSerialPutBuffer( const char * const pcBuffer, size_t xLength,
+                                TickType_t xBlockTime )
+{
+    xComPortHandle pxPort = xDefaultPort;
+    portBASE_TYPE xReturn = pdFAIL;
 
-    // Send the character to the queue. Return false if xBlockTime expires.
-    if( xQueueSend( xCharsForTx, &cOutChar, xBlockTime ) == pdPASS )
+    if( ( pxPort == NULL ) || ( xSemaphoreTake(pxPort->xStringMutex, xBlockTime) != pdTRUE ) )
     {
-        xReturn = pdPASS;
-        UART0->C2 |= UART_C2_TIE_MASK;
+        return pdFAIL;
     }
-    else
+
+    if( prvSerialTransmit(pxPort, pcBuffer, xLength, eSerialBlock, xBlockTime) == xLength )
     {
-        xReturn = pdFAIL;
+        xReturn = pdPASS;
     }
 
+    xSemaphoreGive(pxPort->xStringMutex);
+
     return xReturn;
 }
 
 /*---------------------------------------------------------------------------*/
 
-portBASE_TYPE xSerialGetChar( char *pcRxedChar, TickType_t xBlockTime )
+#if( serUSE_DMA_TX == 1 )
+/*
+ * Transmit xLength bytes from pcBuffer by DMA on UART0. The caller must hold
+ * the UART0 port mutex. The calling task blocks until the transfer is
+ * complete, so pcBuffer may be located on the stack. Returns the number of
+ * bytes transmitted, which is 0 if the scheduler is not running and less than
+ * xLength if the transfer did not complete in time.
+ */
+static size_t prvSerialDmaWrite( const char * const pcBuffer, size_t xLength )
 {
-	// Get the next character from the buffer.  Return false if no characters
-	// are available, or arrive before xBlockTime expires.
-	if( xQueueReceive( xRxedChars, pcRxedChar, xBlockTime ) )
-	{
-		return pdTRUE;
-	}
-	else
-	{
-		return pdFALSE;
-	}
+    xComPortHandle pxPort = serUART0_PORT;
+    size_t xSent = xLength;
+
+    // 10 bits per character, plus a margin for the characters ahead of us
+    TickType_t xBlockTime = ( TickType_t )( ( xLength * 10000UL ) /
+        ( pxPort->ulBaudRate * portTICK_PERIOD_MS ) ) + serDMA_TX_MARGIN;
+
+    // Blocking on a notification requires a running scheduler
+    if( ( xTxDmaClaimed == pdFALSE ) ||
+        ( xTaskGetSchedulerState() != taskSCHEDULER_RUNNING ) )
+    {
+        return 0;
+    }
+
+    // Wait for characters that are still in the transmit stream buffer. The
+    // transmit interrupt is disabled by the ISR once the buffer is empty.
+    for( ;; )
+    {
+        taskENTER_CRITICAL();
+        if( ( UART0->C2 & UART_C2_TIE_MASK ) == 0 )
+        {
+            xTxDmaBusy = pdTRUE;
+            taskEXIT_CRITICAL();
+            break;
+        }
+        taskEXIT_CRITICAL();
+
+        vTaskDelay(1);
+    }
+
+    xTxDmaTask = xTaskGetCurrentTaskHandle();
+    ( void ) ulTaskNotifyTakeIndexed(serDMA_TX_NOTIFY_INDEX, pdTRUE, 0);
+
+    // Clear any previous status and program the transfer
+    DMA0->DMA[serDMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    DMA0->DMA[serDMA_CHANNEL].SAR = (uint32_t)pcBuffer;
+    DMA0->DMA[serDMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_BCR(xLength);
+
+    // Byte transfers, one per request, incrementing source, interrupt when
+    // complete. ERQ is cleared by hardware when BCR reaches zero (D_REQ).
+    DMA0->DMA[serDMA_CHANNEL].DCR = DMA_DCR_EINT_MASK |
+                                    DMA_DCR_ERQ_MASK |
+                                    DMA_DCR_CS_MASK |
+                                    DMA_DCR_SINC_MASK |
+                                    DMA_DCR_SSIZE(1) |
+                                    DMA_DCR_DSIZE(1) |
+                                    DMA_DCR_D_REQ_MASK;
+
+    // Let TDRE generate DMA requests
+    PROBE_HIGH(PROBE_SERIAL);
+    UART0->C5 |= UART0_C5_TDMAE_MASK;
+
+    if( ulTaskNotifyTakeIndexed(serDMA_TX_NOTIFY_INDEX, pdTRUE, xBlockTime) == 0 )
+    {
+        // Timeout, abort the transfer
+        taskENTER_CRITICAL();
+        {
+            BME_CLR(UART0->C5, UART0_C5_TDMAE_MASK);
+            PROBE_LOW(PROBE_SERIAL);
+            BME_CLR(DMA0->DMA[serDMA_CHANNEL].DCR, DMA_DCR_ERQ_MASK);
+            xSent -= DMA0->DMA[serDMA_CHANNEL].DSR_BCR & DMA_DSR_BCR_BCR_MASK;
+            DMA0->DMA[serDMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+
+            xTxDmaBusy = pdFALSE;
+            if( xStreamBufferIsEmpty(pxPort->xCharsForTx) == pdFALSE )
+            {
+                BME_OR(UART0->C2, UART_C2_TIE_MASK);
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    xTxDmaTask = NULL;
+
+    return xSent;
 }
 
 /*---------------------------------------------------------------------------*/
 
-void vSerialPutString( const char * const pcString )
+/*
+ * End of a DMA transmission, called by the interrupt handler of channel 0.
+ */
+static void prvSerialDmaTxIsr( void *pvArg, const uint32_t ulStatus, BaseType_t *pxHigherPriorityTaskWoken )
 {
-    // NOTE: This implementation does not handle the queue being full as no
-    // block time is used!
+    ( void ) pvArg;
+    ( void ) ulStatus;
 
-    char *pxNext = (char * const)pcString;
+    // Clear the DONE flag (and any error flags)
+    DMA0->DMA[serDMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
 
-    // Attempt to take the mutex, blocking indefinitely to wait for the mutex
-    // if it is not available straight away. The call to xSemaphoreTake() will
-    // only return when the mutex has been successfully obtained, so there is
-    // no need to check the function return value. If any other delay period
-    // was used then the code must check that xSemaphoreTake() returns pdTRUE
-    // before accessing the shared resource (which in this case is standard
-    // out). As noted earlier in this book, indefinite time outs are not
-    // recommended for production code.
-    xSemaphoreTake(xStringMutex, portMAX_DELAY);
+    // Stop DMA requests and hand the transmitter back to the stream buffer
+    BME_CLR(UART0->C5, UART0_C5_TDMAE_MASK);
+    PROBE_LOW(PROBE_SERIAL);
+    xTxDmaBusy = pdFALSE;
+
+    if( xStreamBufferIsEmpty(serUART0_PORT->xCharsForTx) == pdFALSE )
     {
-        while(*pxNext)
-        {
-            xSerialPutChar(*pxNext, serNO_BLOCK);
-            pxNext++;
-        }
+        BME_OR(UART0->C2, UART_C2_TIE_MASK);
+    }
+
+    if( xTxDmaTask != NULL )
+    {
+        vTaskNotifyGiveIndexedFromISR(xTxDmaTask, serDMA_TX_NOTIFY_INDEX,
+                                      pxHigherPriorityTaskWoken);
     }
-    xSemaphoreGive(xStringMutex);
 }
+#endif
 
 /*---------------------------------------------------------------------------*/
 
-void UART0_IRQHandler( void )
+/*
+ * Counts the receive errors in the status flags and clears them. The flags
+ * of UART0 are cleared by writing a 1, it stores no further bytes while OR
+ * is set. Those of UART1 and UART2 are cleared by the read of D that
+ * follows the read of S1. Returns pdTRUE if the byte in D is to be
+ * discarded.
+ */
+static portBASE_TYPE prvSerialRxErrors( xComPortHandle pxPort, const uint8_t ucStatus )
 {
-    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+    const uint8_t ucErrors = ucStatus & ( UART_S1_OR_MASK | UART_S1_NF_MASK |
+                                          UART_S1_FE_MASK | UART_S1_PF_MASK );
+
+    if( ucErrors == 0 )
+    {
+        return pdFALSE;
+    }
+
+    if( ucErrors & UART_S1_OR_MASK )
+    {
+        pxPort->xStats.ulRxOverruns++;
+    }
+
+    if( ucErrors & UART_S1_NF_MASK )
+    {
+        pxPort->xStats.ulRxNoiseErrors++;
+    }
+
+    if( ucErrors & UART_S1_FE_MASK )
+    {
+        pxPort->xStats.ulRxFramingErrors++;
+    }
+
+    if( ucErrors & UART_S1_PF_MASK )
+    {
+        pxPort->xStats.ulRxParityErrors++;
+    }
+
+    if( pxPort == serUART0_PORT )
+    {
+        UART0->S1 = ucErrors;
+    }
+
+    return ( ucErrors & ( UART_S1_FE_MASK | UART_S1_PF_MASK ) ) ? pdTRUE : pdFALSE;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Transmit and receive handling shared by all ports.
+ */
+static void prvSerialIRQHandler( xComPortHandle pxPort, portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+    UART_Type *pxUart = pxPort->pxUart;
+    size_t xRxUsed;
+    portBASE_TYPE xDiscard;
     char cChar;
 
-	if( UART0->S1 & UART_S1_TDRE_MASK )
+	if( ( pxUart->C2 & UART_C2_TIE_MASK ) && ( pxUart->S1 & UART_S1_TDRE_MASK ) )
 	{
 		// The interrupt was caused by the data register becoming empty.
 		// Are there any more characters to transmit?
-		if( xQueueReceiveFromISR( xCharsForTx, &cChar, &xHigherPriorityTaskWoken ) == pdTRUE )
+		if( xStreamBufferReceiveFromISR( pxPort->xCharsForTx, &cChar, 1, pxHigherPriorityTaskWoken ) == 1 )
 		{
-			// A character was retrieved from the transmit queue so send it.
-			UART0->D = cChar;
+			// A character was retrieved from the transmit buffer so send it.
+			pxUart->D = cChar;
 		}
 		else
 		{
-		    // No more characters in the transmit queue, disable transmit
+		    // No more characters in the transmit buffer, disable transmit
 		    // interrupt.
-			UART0->C2 &= ~UART_C2_TIE_MASK;
+			BME_CLR(pxUart->C2, UART_C2_TIE_MASK);
 		}
 	}
 
-	if( UART0->S1 & UART_S1_RDRF_MASK )
+	// The error flags belong to the byte in D, S1 is read before D. With
+	// the DMA receiver D is read by the DMA, the errors are counted here.
+	const uint8_t ucStatus = pxUart->S1;
+	xDiscard = prvSerialRxErrors( pxPort, ucStatus );
+
+	if( ( pxUart->C2 & UART_C2_RIE_MASK ) && ( ucStatus & UART_S1_RDRF_MASK ) )
 	{
         // The interrupt was caused by incoming data. Read the data and store
-	    // in the receive queue.
-		cChar = UART0->D;
-		xQueueSendFromISR( xRxedChars, &cChar, &xHigherPriorityTaskWoken );
+	    // in the receive buffer.
+		cChar = pxUart->D;
+		if( xDiscard != pdFALSE )
+		{
+			// Counted as a framing or parity error
+		}
+		else if( !ring_put_from_isr( &pxPort->xRxedChars, &cChar, pxHigherPriorityTaskWoken ) )
+		{
+			pxPort->xStats.ulRxBytesDropped++;
+		}
+		else
+		{
+			xRxUsed = ring_count( &pxPort->xRxedChars );
+			if( xRxUsed > pxPort->xStats.xRxHighWaterMark )
+			{
+				pxPort->xStats.xRxHighWaterMark = xRxUsed;
+			}
+
+			if( pxPort->pxRxCallback != NULL )
+			{
+				pxPort->pxRxCallback( pxPort->pvRxCallbackArg, pxHigherPriorityTaskWoken );
+			}
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------*/
+
+__RAMFUNC void UART0_IRQHandler( void )
+{
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+    TRACE_ISR_ENTER();
+
+#if( serUSE_DMA_RX == 1 )
+	if( ( UART0->C2 & UART_C2_ILIE_MASK ) && ( UART0->S1 & UART_S1_IDLE_MASK ) )
+	{
+		// The receive line went idle, the current frame is complete. The
+		// IDLE flag is cleared by writing a 1.
+		UART0->S1 = UART0_S1_IDLE_MASK;
+		prvSerialRxFrameComplete( &xHigherPriorityTaskWoken );
 	}
+#endif
+
+    prvSerialIRQHandler( &xPorts[ serCOM1 ], &xHigherPriorityTaskWoken );
+
+    TRACE_ISR_EXIT();
 
     // Pass the xHigherPriorityTaskWoken value into portEND_SWITCHING_ISR(). If
 	// xHigherPriorityTaskWoken was set to pdTRUE inside one of the ...FromISR()
@@ -223,3 +1546,149 @@ void UART0_IRQHandler( void )
 	// portEND_SWITCHING_ISR() will have no effect.
 	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
 }
+
+/*---------------------------------------------------------------------------*/
+
+void UART1_IRQHandler( void )
+{
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+    prvSerialIRQHandler( &xPorts[ serCOM2 ], &xHigherPriorityTaskWoken );
+
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+
+/*---------------------------------------------------------------------------*/
+
+void UART2_IRQHandler( void )
+{
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+    prvSerialIRQHandler( &xPorts[ serCOM3 ], &xHigherPriorityTaskWoken );
+
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+
+/*---------------------------------------------------------------------------*/
+
+#if( serUSE_DMA_RX == 1 )
+/*
+ * Start receiving a new frame into ucRxFrame[ucBuffer]. Also clears the DONE
+ * flag of the receive channel.
+ */
+static void prvSerialRxArm( uint8_t ucBuffer )
+{
+    DMA0->DMA[serDMA_RX_CHANNEL].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    DMA0->DMA[serDMA_RX_CHANNEL].DAR = (uint32_t)ucRxFrame[ucBuffer];
+    DMA0->DMA[serDMA_RX_CHANNEL].DSR_BCR = DMA_DSR_BCR_BCR(serRX_FRAME_SIZE);
+
+    // Byte transfers, one per request, incrementing destination, interrupt
+    // when the buffer is full. ERQ is cleared by hardware when BCR reaches
+    // zero (D_REQ).
+    DMA0->DMA[serDMA_RX_CHANNEL].DCR = DMA_DCR_EINT_MASK |
+                                       DMA_DCR_ERQ_MASK |
+                                       DMA_DCR_CS_MASK |
+                                       DMA_DCR_DINC_MASK |
+                                       DMA_DCR_SSIZE(1) |
+                                       DMA_DCR_DSIZE(1) |
+                                       DMA_DCR_D_REQ_MASK;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Called from the idle line interrupt and when the frame buffer is full.
+ * Hands the active buffer to the reader and switches DMA to the other one.
+ * If the reader still holds the other buffer, the new frame is dropped.
+ */
+static void prvSerialRxFrameComplete( portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+    uint8_t ucDone = ucRxActive;
+    size_t xLength;
+
+    BME_CLR(DMA0->DMA[serDMA_RX_CHANNEL].DCR, DMA_DCR_ERQ_MASK);
+    xLength = serRX_FRAME_SIZE -
+              ( DMA0->DMA[serDMA_RX_CHANNEL].DSR_BCR & DMA_DSR_BCR_BCR_MASK );
+
+    if( xLength == 0 )
+    {
+        // Nothing received since the last frame
+        prvSerialRxArm( ucDone );
+    }
+    else if( cRxReady >= 0 )
+    {
+        // The reader did not keep up, reuse the buffer
+        serUART0_PORT->xStats.ulRxFramesDropped++;
+        prvSerialRxArm( ucDone );
+    }
+    else
+    {
+        ucRxActive ^= 1;
+        prvSerialRxArm( ucRxActive );
+
+        xRxFrameLength[ ucDone ] = xLength;
+        cRxReady = ( int8_t )ucDone;
+
+        if( xRxFrameTask != NULL )
+        {
+            vTaskNotifyGiveIndexedFromISR( xRxFrameTask, serRX_FRAME_NOTIFY_INDEX,
+                                           pxHigherPriorityTaskWoken );
+        }
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+size_t xSerialGetFrame( void * pvBuffer, size_t xMaxLength, TickType_t xBlockTime )
+{
+    size_t xLength;
+    uint8_t ucBuffer;
+
+    xRxFrameTask = xTaskGetCurrentTaskHandle();
+
+    // Discard a notification for a frame that was already collected without
+    // blocking, then wait if no frame is ready.
+    ( void ) ulTaskNotifyTakeIndexed( serRX_FRAME_NOTIFY_INDEX, pdTRUE, 0 );
+
+    if( cRxReady < 0 )
+    {
+        ( void ) ulTaskNotifyTakeIndexed( serRX_FRAME_NOTIFY_INDEX, pdTRUE, xBlockTime );
+    }
+
+    if( cRxReady < 0 )
+    {
+        return 0;
+    }
+
+    // The ISR does not touch a ready buffer until it is released
+    ucBuffer = ( uint8_t )cRxReady;
+    xLength = xRxFrameLength[ ucBuffer ];
+
+    if( xLength > xMaxLength )
+    {
+        xLength = xMaxLength;
+    }
+
+    memcpy( pvBuffer, ucRxFrame[ ucBuffer ], xLength );
+
+    // Release the buffer
+    cRxReady = -1;
+
+    return xLength;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * The frame buffer is full, called by the interrupt handler of channel 1.
+ */
+static void prvSerialDmaRxIsr( void *pvArg, const uint32_t ulStatus, BaseType_t *pxHigherPriorityTaskWoken )
+{
+    ( void ) pvArg;
+    ( void ) ulStatus;
+
+    // Deliver it as a frame, the remainder of the burst follows in the next
+    // frame.
+    prvSerialRxFrameComplete( pxHigherPriorityTaskWoken );
+}
+#endif
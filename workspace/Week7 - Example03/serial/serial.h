@@ -31,9 +31,213 @@
 #ifndef SERIAL_COMMS_H
 #define SERIAL_COMMS_H
 
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* The serial ports. serCOM1 is UART0, which is connected to the OpenSDA
+ * virtual COM port. */
+typedef enum
+{
+    serCOM1 = 0,
+    serCOM2,
+    serCOM3,
+    serNUM_PORTS
+} eCOMPort;
+
+typedef struct xCOM_PORT * xComPortHandle;
+
+/* Pins of each port. The defaults are:
+ * serCOM1 : UART0 TX PTA2,  RX PTA1
+ * serCOM2 : UART1 TX PTE0,  RX PTE1  (shared with I2C1 of the OLED; PTC4 and
+ *                                     PTC3 with mux 3 are the alternative)
+ * serCOM3 : UART2 TX PTE22, RX PTE23
+ */
+#ifndef serCOM1_PORT
+#define serCOM1_PORT            PORTA
+#define serCOM1_PORT_CLOCK      SIM_SCGC5_PORTA_MASK
+#define serCOM1_TX_PIN          2
+#define serCOM1_RX_PIN          1
+#define serCOM1_MUX             2
+#endif
+
+#ifndef serCOM2_PORT
+#define serCOM2_PORT            PORTE
+#define serCOM2_PORT_CLOCK      SIM_SCGC5_PORTE_MASK
+#define serCOM2_TX_PIN          0
+#define serCOM2_RX_PIN          1
+#define serCOM2_MUX             3
+#endif
+
+#ifndef serCOM3_PORT
+#define serCOM3_PORT            PORTE
+#define serCOM3_PORT_CLOCK      SIM_SCGC5_PORTE_MASK
+#define serCOM3_TX_PIN          22
+#define serCOM3_RX_PIN          23
+#define serCOM3_MUX             4
+#endif
+
+/* Bytes of static storage for the buffers of all opened ports. A port opened
+ * with a queue length of n takes n rounded down to a power of two for the
+ * receive ring and n + 2 for the transmit stream buffer. The default fits
+ * one port with a queue length of 128. xSerialPortOpen() fails when the
+ * storage is used up.
+ */
+#ifndef serBUFFER_POOL_SIZE
+#define serBUFFER_POOL_SIZE     ( 2 * 128 + 3 )
+#endif
+
+/* Maximum accepted baud rate error in parts per thousand. A port is not
+ * opened if the closest achievable rate is further off. The rate that was
+ * achieved is returned by ulSerialPortGetBaud(). From the 48 MHz UART0
+ * clock, 921600 baud is off by 0.16% and 1, 1.5, 2 and 3 Mbaud are exact.
+ * UART1 and UART2 run from the 24 MHz bus clock with 16x oversampling, which
+ * limits them to 115200 baud (0.16%) for common rates. After a clock mode
+ * change the baud rate is set again without this check: from the 20 MHz
+ * clock of CLK_FLL 921600 baud is off by 1.4%, from the 8 MHz UART0 clock of
+ * CLK_VLPR by 3.5%, and UART1 and UART2 cannot reach 115200 baud from its
+ * 1 MHz bus clock.
+ */
+#ifndef serMAX_BAUD_ERROR_PPT
+#define serMAX_BAUD_ERROR_PPT   30
+#endif
+
+/* Set serUSE_DMA_TX to 1 to let UART0 writes of at least
+ * serDMA_TX_THRESHOLD bytes be handed to DMA channel 0. The calling task
+ * blocks on notification index serDMA_TX_NOTIFY_INDEX until the transfer
+ * completes, so configTASK_NOTIFICATION_ARRAY_ENTRIES must be larger than
+ * that index. Shorter writes use the interrupt driven stream buffer.
+ */
+#ifndef serUSE_DMA_TX
+#define serUSE_DMA_TX           1
+#endif
+
+#ifndef serDMA_TX_THRESHOLD
+#define serDMA_TX_THRESHOLD     8
+#endif
+
+#ifndef serDMA_TX_NOTIFY_INDEX
+#define serDMA_TX_NOTIFY_INDEX  1
+#endif
+
+/* Number of received bytes that must be available before a task blocked in
+ * xSerialRead() is unblocked. Larger values give fewer wakeups per byte.
+ */
+#ifndef serRX_TRIGGER_LEVEL
+#define serRX_TRIGGER_LEVEL     1
+#endif
+
+/* Task notification index on which the reader of xSerialGetChar() and
+ * xSerialRead() waits for received bytes. 0 is the index the receive stream
+ * buffer used before the receive ring.
+ */
+#ifndef serRX_NOTIFY_INDEX
+#define serRX_NOTIFY_INDEX      0
+#endif
+
+/* Set serUSE_DMA_RX to 1 to receive UART0 frames with DMA channel 1 and the
+ * idle line interrupt. Frames are read with xSerialGetFrame(); xSerialGetChar()
+ * and xSerialRead() then receive nothing. Frames longer than
+ * serRX_FRAME_SIZE are split. The reader blocks on notification index
+ * serRX_FRAME_NOTIFY_INDEX.
+ */
+#ifndef serUSE_DMA_RX
+#define serUSE_DMA_RX           0
+#endif
+
+#ifndef serRX_FRAME_SIZE
+#define serRX_FRAME_SIZE        64
+#endif
+
+#ifndef serRX_FRAME_NOTIFY_INDEX
+#define serRX_FRAME_NOTIFY_INDEX 2
+#endif
+
+/* Set serLOW_POWER_RX to 1 to keep the UART0 receiver listening in VLPS.
+ * Before every stop mode of lp_suppress_ticks_and_sleep() UART0 switches to
+ * OSCERCLK, the 8 MHz crystal that is kept running in stop, and the RX
+ * active edge interrupt is enabled to wake the MCU. After the wake-up the
+ * peripheral clock and its divisors are restored. The character that woke
+ * the MCU is received, characters that follow it while the PLL locks, about
+ * 1 ms, overrun the receiver. Requires LP_STOP_MODE LP_VLPS, UART0 stops in
+ * LLS.
+ */
+#ifndef serLOW_POWER_RX
+#define serLOW_POWER_RX         0
+#endif
+
+/* What to do when a write does not fit in the transmit buffer.
+ * eSerialBlock      : wait up to the block time for the ISR to make room.
+ * eSerialDropNewest : write what fits, drop the rest of the write.
+ * eSerialDropOldest : discard the oldest buffered bytes to make room.
+ */
+typedef enum
+{
+    eSerialBlock = 0,
+    eSerialDropNewest,
+    eSerialDropOldest
+} eSerialTxPolicy;
+
+#ifndef serTX_DEFAULT_POLICY
+#define serTX_DEFAULT_POLICY    eSerialDropNewest
+#endif
+
+/* Counters to size uxQueueLength from data. The receive errors are counted
+ * from the status flags of the UART: an overrun lost at least one byte
+ * before the receive interrupt ran, a byte with a framing or parity error
+ * is discarded, a byte with noise is kept. The frames of serUSE_DMA_RX keep
+ * every byte. A USB port has no line errors. */
+typedef struct
+{
+    uint32_t ulTxBytesDropped;
+    uint32_t ulRxBytesDropped;
+    size_t xTxHighWaterMark;
+    size_t xRxHighWaterMark;
+    uint32_t ulRxFramesDropped;
+    uint32_t ulRxOverruns;
+    uint32_t ulRxFramingErrors;
+    uint32_t ulRxNoiseErrors;
+    uint32_t ulRxParityErrors;
+} SerialStats_t;
+
+/* Called in the receive interrupt after a byte was put in the receive ring,
+ * for example to pend the processing of the bytes to the timer task. Not
+ * called for the frames of serUSE_DMA_RX. */
+typedef void ( *SerialRxCallback_t )( void * pvArg, portBASE_TYPE * pxHigherPriorityTaskWoken );
+
+/* Multi port API. */
+xComPortHandle xSerialPortOpen( eCOMPort ePort, unsigned long ulWantedBaud, unsigned portBASE_TYPE uxQueueLength );
+portBASE_TYPE xSerialPortGetChar( xComPortHandle pxPort, char * pcRxedChar, TickType_t xBlockTime );
+portBASE_TYPE xSerialPortPutChar( xComPortHandle pxPort, char cOutChar, TickType_t xBlockTime );
+void vSerialPortPutString( xComPortHandle pxPort, const char * const pcString );
+size_t xSerialPortWrite( xComPortHandle pxPort, const void * pvBuffer, size_t xLength );
+size_t xSerialPortRead( xComPortHandle pxPort, void * pvBuffer, size_t xLength, TickType_t xBlockTime );
+size_t xSerialPortPutStringPolicy( xComPortHandle pxPort, const char * const pcString, eSerialTxPolicy ePolicy, TickType_t xBlockTime );
+size_t xSerialPortPrintf( xComPortHandle pxPort, const char * pcFormat, ... ) __attribute__((format(printf, 2, 3)));
+size_t xSerialPortVPrintf( xComPortHandle pxPort, const char * pcFormat, va_list xArgs );
+void vSerialPortSetTxPolicy( xComPortHandle pxPort, eSerialTxPolicy ePolicy, TickType_t xBlockTime );
+void vSerialPortGetStats( xComPortHandle pxPort, SerialStats_t * pxStats );
+void vSerialPortResetStats( xComPortHandle pxPort );
+unsigned long ulSerialPortGetBaud( xComPortHandle pxPort );
+portBASE_TYPE xSerialPortSetBaud( xComPortHandle pxPort, unsigned long ulWantedBaud );
+void vSerialPortSetLoopback( xComPortHandle pxPort, portBASE_TYPE xEnable );
+void vSerialPortSetRxCallback( xComPortHandle pxPort, SerialRxCallback_t pxCallback, void * pvArg );
+
+/* Single port API, operating on UART0 as opened by xSerialPortInit(). */
 portBASE_TYPE xSerialPortInit( unsigned long ulWantedBaud, unsigned portBASE_TYPE uxQueueLength );
 portBASE_TYPE xSerialGetChar( char * pcRxedChar, TickType_t xBlockTime );
 portBASE_TYPE xSerialPutChar( char cOutChar, TickType_t xBlockTime );
 void vSerialPutString( const char * const pcString );
+portBASE_TYPE xSerialPutBuffer( const char * const pcBuffer, size_t xLength, TickType_t xBlockTime );
+size_t xSerialWrite( const void * pvBuffer, size_t xLength );
+size_t xSerialRead( void * pvBuffer, size_t xLength, TickType_t xBlockTime );
+size_t xSerialPutStringPolicy( const char * const pcString, eSerialTxPolicy ePolicy, TickType_t xBlockTime );
+size_t xSerialPrintf( const char * pcFormat, ... ) __attribute__((format(printf, 1, 2)));
+void vSerialSetTxPolicy( eSerialTxPolicy ePolicy, TickType_t xBlockTime );
+void vSerialGetStats( SerialStats_t * pxStats );
+void vSerialResetStats( void );
+size_t xSerialGetFrame( void * pvBuffer, size_t xMaxLength, TickType_t xBlockTime );
+unsigned long ulSerialGetBaud( void );
+xComPortHandle xSerialGetDefaultPort( void );
 
 #endif /* ifndef SERIAL_COMMS_H */
@@ -0,0 +1,92 @@
+/*! ***************************************************************************
+ *
+ * \brief     Task table of the application
+ * \file      app_tasks.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef APP_TASKS_H
+#define APP_TASKS_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "console.h"
+#include "sections.h"
+#include "sections.h"
+
+/// \name Stack sizes in words of the tasks of main.c
+/// \{
+#define SHOW_STACK_DEPTH    (configMINIMAL_STACK_SIZE + 64)
+#if (CONSOLE_ENABLED == 1)
+#define CMD_STACK_DEPTH     (configMINIMAL_STACK_SIZE + 96)
+#else
+#define CMD_STACK_DEPTH     (configMINIMAL_STACK_SIZE + 32)
+#endif
+#define SYNC_STACK_DEPTH    (configMINIMAL_STACK_SIZE)
+/// \}
+
+/*!
+ * \brief The tasks of main.c
+ *
+ * TASK(id, name, function, stack depth in words, priority). APP_TASK_STORAGE
+ * defines the TCB id_tcb and the stack id_stack of every task, so
+ * tools/task_budget.py finds them in the firmware, and APP_TASK_CREATE
+ * creates it with its name. The functions are declared before the table is
+ * expanded.
+ */
+#define APP_TASKS(TASK) \
+    TASK(show, "Show", vShowTask, SHOW_STACK_DEPTH, 3) \
+    TASK(cmd,  "Cmd",  vCmdTask,  CMD_STACK_DEPTH,  1) \
+    TASK(sync, "Sync", vSyncTask, SYNC_STACK_DEPTH, 1)
+
+/// \name Priorities of the tasks created by the libraries
+/// \{
+#define PRIO_WORK_HIGH      (3)  ///< Bottom halves of interrupt handlers
+#define PRIO_WORK_LOW       (1)  ///< Longer deferred work, at the shell
+#define PRIO_JOBS           (1)  ///< Protothread jobs
+#define PRIO_DISPLAY        (2)  ///< Display task, below the Show task
+#define PRIO_LOG            (tskIDLE_PRIORITY + 1)
+#define PRIO_FLOG           (tskIDLE_PRIORITY + 1)
+#define PRIO_VIB            (2)
+#define PRIO_ALOG           (2)
+#define PRIO_ACQ            (2)
+#define PRIO_LINK           (3)
+#define PRIO_LOAD           (configMAX_PRIORITIES - 1)
+#define PRIO_OVERLOAD       (configMAX_PRIORITIES - 1)  ///< With the load meter
+/// \}
+
+/// Defines the static memory of a task of APP_TASKS
+#define APP_TASK_STORAGE(id, name, function, depth, priority) \
+    static StaticTask_t id##_tcb; \
+    __BSS_NOCLEAR static StackType_t id##_stack[depth];
+
+/// Creates a task of APP_TASKS in its static memory
+#define APP_TASK_CREATE(id, name, function, depth, priority) \
+    (void)xTaskCreateStatic(function, name, depth, NULL, priority, \
+        id##_stack, &id##_tcb);
+
+#endif // APP_TASKS_H
@@ -29,10 +29,11 @@
  *            OTHER DEALINGS IN THE SOFTWARE.
  *
  *****************************************************************************/
+#define LOG_MODULE  MAIN
+
 #include <MKL25Z4.h>
-#include <math.h>
 #include <stdbool.h>
-#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "FreeRTOS.h"
@@ -41,59 +42,355 @@
 #include "task.h"
 #include "timers.h"
 
+#include "accellog.h"
+#include "acq.h"
+#include "app_tasks.h"
 #include "bitmaps.h"
+#include "bitmaps_rle.h"
+#include "boot.h"
+#include "bringup.h"
+#include "bus.h"
+#include "capture.h"
+#include "clock.h"
+#include "console.h"
+#include "crash.h"
+#include "dcf77.h"
+#include "display.h"
+#include "flashlog.h"
+#include "flow.h"
+#include "fonts_native.h"
+#include "freemaster.h"
+#include "idle.h"
 #include "leds.h"
+#include "link.h"
+#include "loadmeter.h"
+#include "log.h"
+#include "lowpower.h"
+#include "msg.h"
+#include "mono.h"
+#include "mtb.h"
+#include "mux.h"
+#include "overload.h"
+#include "pool.h"
+#include "powerprof.h"
+#include "probe.h"
+#include "pt.h"
 #include "rgb.h"
 #include "rtc.h"
 #include "serial.h"
+#include "sprite.h"
 #include "ssd1306.h"
 #include "switches.h"
+#include "taskstats.h"
+#include "telemetry.h"
+#include "timer.h"
+#include "usbcdc.h"
+#include "work.h"
+#include "vibration.h"
+#include "wcet.h"
+#include "widget.h"
+#include "xprintf.h"
 
 /*----------------------------------------------------------------------------*/
 // Local defines
 /*----------------------------------------------------------------------------*/
-#define M_PI (3.14159265f)
+#if (VIB_ENABLED == 1) && (ALOG_ENABLED == 1)
+#error "VIB_ENABLED and ALOG_ENABLED both use the MMA8451 FIFO"
+#endif
+
+#if (ACQ_ENABLED == 1) && ((VIB_ENABLED == 1) || (ALOG_ENABLED == 1))
+#error "ACQ_ENABLED takes the MMA8451 from VIB_ENABLED and ALOG_ENABLED"
+#endif
+
+// Vibration above this RMS counts as activity that keeps the display on,
+// about 50 mg
+#define WAKE_RMS    (COUNTS_PER_G / 20)
 
 typedef enum state
 {
     ANALOG,
     DIGITAL,
+    STATUS,
 }state_t;
 
 /*----------------------------------------------------------------------------*/
 // Local function prototypes
 /*----------------------------------------------------------------------------*/
-static void vBlinkTask(void *pvParameters);
+static pt_state_t job_swlog(pt_t *pt);
+static void swlog_notify(bus_sub_t *sub);
 static void vShowTask(void *pvParameters);
-static void vSwTask(void *parameters);
+static void show_second(void *item, void *arg);
+static void show_switch(void *item, void *arg);
+static void show_notify(bus_sub_t *sub);
+static void vCmdTask(void *pvParameters);
+static void next_clock_mode(void);
+#if (CONSOLE_ENABLED == 1)
+#if (ALOG_ENABLED == 1)
+static void cmd_accel(const uint32_t argc, char *argv[]);
+#endif
+#if (ACQ_ENABLED == 1)
+static void cmd_acq(const uint32_t argc, char *argv[]);
+#endif
+static void cmd_bringup(const uint32_t argc, char *argv[]);
+static void cmd_capture(const uint32_t argc, char *argv[]);
+static void cmd_clock(const uint32_t argc, char *argv[]);
+#if (FLOG_ENABLED == 1)
+static void cmd_flog(const uint32_t argc, char *argv[]);
+#endif
+#if (LINK_ENABLED == 1)
+static void cmd_link(const uint32_t argc, char *argv[]);
+#endif
+static void cmd_load(const uint32_t argc, char *argv[]);
+static void cmd_mtb(const uint32_t argc, char *argv[]);
+#if (OVERLOAD_ENABLED == 1)
+static void cmd_overload(const uint32_t argc, char *argv[]);
+#endif
+static void cmd_power(const uint32_t argc, char *argv[]);
+#if (VIB_ENABLED == 1)
+static void cmd_vib(const uint32_t argc, char *argv[]);
+#endif
+static void cmd_work(const uint32_t argc, char *argv[]);
+#endif
+static void vSyncTask(void *pvParameters);
 
 /*----------------------------------------------------------------------------*/
 // Local variables
 /*----------------------------------------------------------------------------*/
-QueueHandle_t xStateQueue;
+// The tiny periodic jobs share the stack of the protothread task
+static pt_job_t xSwLogJob = {.fn = job_swlog, .name = "SwLog"};
+
+// Every device is brought up by the task that owns it, the steps overlap
+static const bringup_step_t xSerialStep =
+    BRINGUP_STEP("Serial", BRINGUP_SERIAL, 0, 0);
+static const bringup_step_t xRtcStep =
+    BRINGUP_STEP("RTC", BRINGUP_RTC, 0, 0);
+static const bringup_step_t xDcf77Step =
+    BRINGUP_STEP("DCF77", BRINGUP_DCF77, BRINGUP_MASK(BRINGUP_RTC), 0);
+
+#if (OVERLOAD_ENABLED == 1)
+// The Show task keeps the clock on time, the display frames, the log and
+// the sensor telemetry give way under overload
+static overload_client_t xShowClient =
+    OVERLOAD_CLIENT_INIT("Show", OVERLOAD_CRITICAL, NULL, NULL);
+static overload_client_t xDisplayClient =
+    OVERLOAD_CLIENT_INIT("Display", OVERLOAD_OPTIONAL, overload_display, NULL);
+static overload_client_t xLogClient =
+    OVERLOAD_CLIENT_INIT("Log", OVERLOAD_OPTIONAL, overload_log, NULL);
+static overload_client_t xTlmClient =
+    OVERLOAD_CLIENT_INIT("Telemetry", OVERLOAD_OPTIONAL, overload_telemetry, NULL);
+#endif
+
+#if (CONSOLE_ENABLED == 1)
+// Commands of the console next to its built-in ones, sorted by name
+static const console_cmd_t xCommands[] =
+{
+#if (ALOG_ENABLED == 1)
+    {"accel",   cmd_accel,   "accelerometer burst to the flash log"},
+#endif
+#if (ACQ_ENABLED == 1)
+    {"acq",     cmd_acq,     "synchronised acquisition"},
+#endif
+    {"bringup", cmd_bringup, "device bring-up"},
+    {"capture", cmd_capture, "pulse measurement [rise|fall]"},
+    {"clock",   cmd_clock,   "next clock mode"},
+#if (FLOG_ENABLED == 1)
+    {"flog",    cmd_flog,    "flash log"},
+#endif
+#if (LINK_ENABLED == 1)
+    {"link",    cmd_link,    "board-to-board link"},
+#endif
+    {"load",    cmd_load,    "CPU load"},
+    {"mtb",     cmd_mtb,     "MTB branch trace"},
+#if (OVERLOAD_ENABLED == 1)
+    {"overload", cmd_overload, "overload level and degraded work"},
+#endif
+    {"power",   cmd_power,   "power mode residency"},
+#if (VIB_ENABLED == 1)
+    {"vib",     cmd_vib,     "vibration spectrum [cal]"},
+#endif
+    {"work",    cmd_work,    "deferred work"},
+};
+#endif
+
+// Every switch event is published once on xSwTopic, the Show task draws it
+// and the SwLog job logs it
+static bus_sub_t xShowSwSub = BUS_SUB("Show");
+static bus_sub_t xSwLogSub = BUS_SUB("SwLog");
+static BUS_TOPIC(xSwTopic, &xShowSwSub, &xSwLogSub);
+
+static pool_t xSwEventPool;
+__BSS_NOCLEAR static POOL_STORAGE(ulSwEventStorage,
+    MSG_BLOCK_SIZE(sizeof(sw_event_t)), 8);
+
+#if (ACQ_ENABLED == 1)
+// Converted at every master tick: the TCRT5000 and the temperature sensor
+static const uint8_t ucAcqChannels[] = {8, 26};
+#endif
+
+#if (VIB_ENABLED == 1)
+// The MMA8451 FIFO blocks of the vibration task are averaged to 25 Hz and
+// sent as TLM_MMA8451 records, declared from the sink to the source
+__BSS_NOCLEAR static FLOW_POOL_STORAGE(ulFlowStorage, 4);
+static const flow_tlm_t xAccelTlmType = {TLM_MMA8451};
+static flow_node_t xAccelTlm = FLOW_SINK(xAccelTlm, "AccelTlm", flow_tlm,
+                                         (void *)&xAccelTlmType, WORK_LOW);
+static flow_decimate_t xAccelDecimate = FLOW_DECIMATE(16);
+static flow_node_t xAccelDec = FLOW_STAGE(xAccelDec, "AccelDec", flow_decimate,
+                                          &xAccelDecimate, WORK_LOW, &xAccelTlm);
+static flow_node_t xAccelSrc = FLOW_SOURCE("Accel", &xAccelDec);
+#endif
+
+// The Show task blocks on the seconds semaphore and the switch events at once
+static mux_t xShowMux;
+static state_t xShowState = DIGITAL;
+
+// The analog clock: the dial is the compressed background, the second,
+// minute and hour hands are sprites that are only recomposed where they move
+#define HAND_SIZE   (28)
+
+static sprite_scene_t xClockScene;
+static sprite_t xHands[3];
+static uint8_t ucHandImages[3][SPRITE_IMAGE_SIZE(HAND_SIZE, HAND_SIZE)];
+static uint32_t ulHandSteps[3] = {UINT32_MAX, UINT32_MAX, UINT32_MAX};
+
+// The status dashboard: only the widgets whose value changed are redrawn
+// and sent every second
+static widget_screen_t xStatusScreen;
+static widget_t xStatusIcon;
+static widget_t xStatusTitle;
+static widget_t xStatusLoad;
+static widget_t xStatusBar;
+static widget_t xStatusUptime;
+
+// Execution times of the jobs of the Show task, one per mux handler
+static wcet_t xSecondWcet;
+static wcet_t xSwitchWcet;
+
+// Latency from a switch edge until its result was sent to the display
+static wcet_t xSwLatency[N_SWITCHES];
+
+// Memory of the kernel objects, all are created statically
+static StaticSemaphore_t xRtcOneSecondSemaphoreBuffer;
+
+// The tasks of the table in app_tasks.h
+APP_TASKS(APP_TASK_STORAGE)
 
 /*----------------------------------------------------------------------------*/
 // Main application
 /*----------------------------------------------------------------------------*/
 int main(void)
 {
+#if (CRASH_ENABLED == 1)
+    // Take the record of a crash of the previous run, before anything else
+    crash_init();
+#endif
+
+    // Branch trace from the start, stopped by a trigger, see mtb.h
+    mtb_init();
+    probe_init();
+    lp_init();
+    tim_init();
     rgb_init();
+    cap_init();
     led_init();
+
+    // The application is ready when these devices are
+    bringup_init(BRINGUP_MASK(BRINGUP_SERIAL) | BRINGUP_MASK(BRINGUP_RTC) |
+                 BRINGUP_MASK(BRINGUP_DCF77) | BRINGUP_MASK(BRINGUP_OLED)
+#if (VIB_ENABLED == 1)
+                 | BRINGUP_MASK(BRINGUP_MMA8451)
+#endif
+                 );
+
+    // Heartbeat on the green LED, written by DMA without CPU load
+    rgb_play(&(rgb_effect_t){RGB_FX_BREATHE, RGB_GREEN, 8000}, 600, RGB_FX_FOREVER);
+
+    // Without dependencies and settle time, this does not block
+    (void)bringup_begin(&xSerialStep, 0);
     xSerialPortInit(921600, 128);
+    bringup_done(&xSerialStep, true);
+#if (USBCDC_ENABLED == 1)
+    (void)xUsbCdcInit();
+#endif
+    tlm_init(xSerialGetDefaultPort());
+    fmstr_init(xSerialGetDefaultPort());
+    fmstr_rec_timer_start(FMSTR_REC_HZ);
 
     vSerialPutString("\r\nFRDM-KL25Z FreeRTOS demo Week 7 - Example 03\r\n");
     vSerialPutString("By Hugo Arends\r\n\r\n");
 
-    xRtcOneSecondSemaphore = xSemaphoreCreateBinary();
-    xRtcAlarmSemaphore = xSemaphoreCreateBinary();
+    pool_init(&xSwEventPool, "SwEvents", ulSwEventStorage,
+        MSG_BLOCK_SIZE(sizeof(sw_event_t)), 8);
+
+    // Create the tasks, the stacks and priorities are set in app_tasks.h
+    APP_TASKS(APP_TASK_CREATE)
+
+    // Bottom halves of interrupt handlers, above the display, and the
+    // longer deferred work at the level of the shell
+    work_init(PRIO_WORK_HIGH, PRIO_WORK_LOW);
+
+    // The stacks are sampled in the idle time, without a task of its own
+    taskstats_stack_monitor();
+
+    // The heartbeat runs on timer interrupts, stopped while the idle task
+    // does not run. SwLog runs as a protothread job.
+    led_heartbeat_start(led_heartbeat_default, LED_HEARTBEAT_DEFAULT_STEPS, true);
+    pt_init(PRIO_JOBS);
+    pt_add(&xSwLogJob);
 
-    xStateQueue = xQueueCreate(1, sizeof(state_t));
-    vQueueAddToRegistry(xStateQueue, "xStateQueue");
+    // The display task owns the oled display, the Show task draws
+    display_init(PRIO_DISPLAY, 1);
 
-    // Create the tasks
-    xTaskCreate(vBlinkTask, "Blink", configMINIMAL_STACK_SIZE, NULL, 1, NULL);
-    xTaskCreate(vShowTask,  "Show",  configMINIMAL_STACK_SIZE, NULL, 3, NULL);
-    xTaskCreate(vSwTask,    "Sw",    configMINIMAL_STACK_SIZE, NULL, 1, NULL);
+    // Render log records at the lowest application priority
+    log_init(PRIO_LOG);
+
+#if (FLOG_ENABLED == 1)
+    // Program the flash log at the same priority, every command masks
+    // interrupts
+    flog_init(PRIO_FLOG);
+#endif
+
+#if (VIB_ENABLED == 1)
+    // Analyse the MMA8451 FIFO blocks above the shell and the sync task, and
+    // pass them on to the dataflow graph
+    flow_init(ulFlowStorage, 4);
+    vib_init(PRIO_VIB, &xAccelSrc);
+#endif
+
+#if (ALOG_ENABLED == 1)
+    // Record MMA8451 bursts above the flash log task, which programs them
+    alog_init(PRIO_ALOG);
+#endif
+
+#if (ACQ_ENABLED == 1)
+    // Convert the ADC channels at a common tick and match the MMA8451
+    // samples to it
+    acq_init(PRIO_ACQ, ucAcqChannels, sizeof(ucAcqChannels));
+#endif
+
+#if (LINK_ENABLED == 1)
+    // Above the tasks that send telemetry, so the packets are stamped when
+    // they arrive
+    (void)link_init(PRIO_LINK);
+#endif
+
+    // Sample the CPU load at the highest priority, so the periods are regular
+    loadmeter_init(PRIO_LOAD);
+
+#if (OVERLOAD_ENABLED == 1)
+    // Degrade the optional work from the load of the load meter, at its
+    // priority
+    (void)overload_register(&xShowClient);
+    (void)overload_register(&xDisplayClient);
+    (void)overload_register(&xLogClient);
+    (void)overload_register(&xTlmClient);
+    overload_init(PRIO_OVERLOAD);
+#endif
+
+    // Boot time, from the end of SystemInit()
+    xSerialPrintf("Boot: %u us section init, %u us to scheduler\r\n",
+        (unsigned int)(boot_init_cycles / BOOT_CYCLES_PER_US),
+        (unsigned int)(boot_cycles() / BOOT_CYCLES_PER_US));
 
     /* Start the scheduler so the tasks start executing. */
     vTaskStartScheduler();
@@ -107,29 +404,111 @@ int main(void)
 
 /*----------------------------------------------------------------------------*/
 
-static void vBlinkTask(void *pvParameters)
+// Only used by the log statement of job_swlog()
+#if (LOG_MODULE_LEVEL >= LOG_LEVEL_INFO)
+static const char *const sw_event_names[] =
 {
-    led_init();
+    [SW_PRESS]   = "pressed",
+    [SW_RELEASE] = "released",
+    [SW_LONG]    = "held",
+    [SW_DOUBLE]  = "double clicked",
+    [SW_REPEAT]  = "repeated",
+};
+#endif
+
+static pt_state_t job_swlog(pt_t *pt)
+{
+    // Locals do not survive a wait
+    static sw_event_t *event;
 
-    char str[32];
-    sprintf(str, "[%*s] started\r\n", 12, __func__);
-    vSerialPutString(str);
+    PT_BEGIN(pt);
+
+    bus_attach_notify(&xSwLogSub, swlog_notify, NULL);
+
+    LOG_DEBUG("[%*s] started\r\n", 12, __func__);
 
-    /* As per most tasks, this task is implemented within an infinite loop. */
     for( ;; )
     {
-        led_on();
-        vTaskDelay(pdMS_TO_TICKS(10));
+        PT_WAIT_UNTIL(pt, (event = bus_receive(&xSwLogSub)) != NULL);
+
+        LOG_INFO("[%*s] SW%u %s\r\n", 12, __func__, event->sw + 1U,
+            sw_event_names[event->type]);
 
-        led_off();
-        vTaskDelay(pdMS_TO_TICKS(4990));
+        msg_release(event);
     }
+
+    PT_END(pt);
+}
+
+/*!
+ * \brief Runs the SwLog job at once when a switch event is published
+ */
+static void swlog_notify(bus_sub_t *sub)
+{
+    (void)sub;
+
+    pt_signal();
 }
 
 /*----------------------------------------------------------------------------*/
 
 static void vShowTask(void *pvParameters)
 {
+    // The RTC gives the semaphore every second, it is multiplexed with the
+    // signal of the switch events, so a button press is shown at once
+    xRtcOneSecondSemaphore = xSemaphoreCreateBinaryStatic(&xRtcOneSecondSemaphoreBuffer);
+    vQueueAddToRegistry(xRtcOneSecondSemaphore, "xRtcSecond");
+
+    wcet_init(&xSecondWcet, "Second");
+    wcet_init(&xSwitchWcet, "Switch");
+    wcet_init(&xSwLatency[SW1], "SW1>Oled");
+    wcet_init(&xSwLatency[SW2], "SW2>Oled");
+
+    sprite_scene_init(&xClockScene, NULL);
+    sprite_set_background_rle(&xClockScene, &clock_rle);
+
+    for(uint32_t i=0; i<3; i++)
+    {
+        sprite_init(&xHands[i], ucHandImages[i], 0, 0, SPRITE_OR);
+        sprite_show(&xHands[i], true);
+        sprite_add(&xClockScene, &xHands[i]);
+    }
+
+    static const ssd1306_box_t icon_box   = {0, 0, 8, 8};
+    static const ssd1306_box_t title_box  = {12, 0, SSD1306_WIDTH - 12, 13};
+    static const ssd1306_box_t load_box   = {0, 16, SSD1306_WIDTH, 13};
+    static const ssd1306_box_t bar_box    = {0, 32, SSD1306_WIDTH, 10};
+    static const ssd1306_box_t uptime_box = {0, 48, SSD1306_WIDTH, 13};
+
+    widget_screen_init(&xStatusScreen, 0);
+    widget_icon_init(&xStatusIcon, &icon_box, icon_cpu, 8, 8);
+    widget_label_init(&xStatusTitle, &title_box, &Monospaced_plain_10_native,
+        SSD1306_ALIGN_LEFT, "Status");
+    widget_value_init(&xStatusLoad, &load_box, &Monospaced_plain_10_native,
+        SSD1306_ALIGN_LEFT, "Load %ld%%");
+    widget_bar_init(&xStatusBar, &bar_box, 0, 1000);
+    widget_value_init(&xStatusUptime, &uptime_box, &Monospaced_plain_10_native,
+        SSD1306_ALIGN_LEFT, "Up %ld s");
+    widget_add(&xStatusScreen, &xStatusIcon);
+    widget_add(&xStatusScreen, &xStatusTitle);
+    widget_add(&xStatusScreen, &xStatusLoad);
+    widget_add(&xStatusScreen, &xStatusBar);
+    widget_add(&xStatusScreen, &xStatusUptime);
+
+    mux_init(&xShowMux);
+    bool added = mux_add_semaphore(&xShowMux, xRtcOneSecondSemaphore, show_second, NULL);
+    added &= mux_add_signal(&xShowMux, show_switch, NULL);
+    configASSERT(added);
+    (void)added;
+
+    bus_attach_notify(&xShowSwSub, show_notify, NULL);
+
+    // Debounced switch events from the pin interrupts, no polling
+    sw_init_bus(&xSwTopic, &xSwEventPool, SW_EVENT_MASK(SW_PRESS) |
+        SW_EVENT_MASK(SW_RELEASE) | SW_EVENT_MASK(SW_LONG));
+
+    (void)bringup_begin(&xRtcStep, portMAX_DELAY);
+
     rtc_init();
 
     rtc_datetime_t datetime;
@@ -141,141 +520,541 @@ static void vShowTask(void *pvParameters)
     datetime.second = 0;
     rtc_set(&datetime);
 
-    // Wait some time so the oled display is out of reset state
-    vTaskDelay(pdMS_TO_TICKS(200));
-
-    ssd1306_init();
-    ssd1306_setorientation(1);
-    ssd1306_clearscreen();
-    ssd1306_update();
+    bringup_done(&xRtcStep, true);
 
-    char str[128];
-    sprintf(str, "[%*s] started\r\n", 12, __func__);
-    vSerialPutString(str);
-
-    state_t state = DIGITAL;
+    LOG_DEBUG("[%*s] started\r\n", 12, __func__);
 
     /* As per most tasks, this task is implemented within an infinite loop. */
     for( ;; )
     {
-        /* Use the semaphore to wait for the event. The semaphore was created
-        before the scheduler was started, so before this task ran for the first
-        time. The task blocks indefinitely, meaning this function call will only
-        return once the semaphore has been successfully obtained - so there is
-        no need to check the value returned by xSemaphoreTake(). */
-        xSemaphoreTake(xRtcOneSecondSemaphore, portMAX_DELAY);
+        /* Wait for the seconds interrupt or a switch event and call its handler.
+        The task blocks indefinitely, so there is no need to check the value
+        returned by mux_wait(). */
+        mux_wait(&xShowMux, portMAX_DELAY);
+    }
+}
 
-        // State updated?
-        xQueueReceive(xStateQueue, &state, 0);
+/*!
+ * \brief Draws a hand of the analog clock from the center of the dial into
+ *        its sprite, if it moved
+ *
+ * The sprite is the bounding box of the hand.
+ *
+ * \param[in]  hand  Index of the hand in xHands
+ * \param[in]  len   Length in pixels, below HAND_SIZE
+ * \param[in]  step  Angle in steps of 6 degrees clockwise from 12 o'clock
+ */
+static void show_hand(const uint32_t hand, const int32_t len, const uint32_t step)
+{
+    if(ulHandSteps[hand] == step)
+    {
+        return;
+    }
 
-        // Get time from RTC
-        rtc_get(&datetime);
+    const int32_t x = 64 + ((len * ssd1306_sin(step) + 0x4000) >> 15);
+    const int32_t y = 31 - ((len * ssd1306_cos(step) + 0x4000) >> 15);
+    const int32_t x0 = (x < 64) ? x : 64;
+    const int32_t y0 = (y < 31) ? y : 31;
+    const uint8_t w = (uint8_t)(abs(x - 64) + 1);
+    const uint8_t h = (uint8_t)(abs(y - 31) + 1);
 
-        // Show the time on oled display
-        if(state == DIGITAL)
-        {
-            ssd1306_clearscreen();
+    (void)memset(ucHandImages[hand], 0, SPRITE_IMAGE_SIZE(w, h));
+    sprite_image_line(ucHandImages[hand], w, h, 64 - x0, 31 - y0, x - x0, y - y0);
 
-            sprintf(str, "%02hd:%02hd:%02hd", datetime.hour, datetime.minute, datetime.second);
-            ssd1306_setfont(Monospaced_bold_24);
-            ssd1306_putstring(64-(strlen(str)*Monospaced_bold_24[0]/2),4,str);
+    sprite_set_image(&xHands[hand], ucHandImages[hand], NULL, w, h);
+    sprite_move(&xHands[hand], (int16_t)x0, (int16_t)y0);
 
-            sprintf(str, "%02hd-%02hd-%04hd", datetime.day, datetime.month, datetime.year);
-            ssd1306_setfont(Monospaced_plain_10);
-            ssd1306_putstring(64-(strlen(str)*Monospaced_plain_10[0]/2),63-2*Monospaced_plain_10[1],str);
+    ulHandSteps[hand] = step;
+}
 
-            ssd1306_update();
+/*!
+ * \brief Draws the time or the status dashboard in the state in xShowState
+ *
+ * \param[in]  cause  Switch event that changed the state, its latency is
+ *                    traced to the display, or NULL
+ */
+static void show_draw(const sw_event_t *cause)
+{
+    static state_t shown = DIGITAL;
+
+    rtc_datetime_t datetime;
+    char str[16];
+
+    // Get time from RTC
+    rtc_get(&datetime);
+
+    // Show the time on oled display
+    ssd1306_t *oled = display_lock(0, portMAX_DELAY);
+
+    if(xShowState == DIGITAL)
+    {
+        // The time and date have a fixed width and overwrite the previous
+        // values, so only clear when switching from the analog clock.
+        // Unchanged digits then stay clean and are not sent.
+        if(shown != DIGITAL)
+        {
+            ssd1306_clearscreen(oled);
         }
-        else if(state == ANALOG)
+
+        const uint8_t date_height = Monospaced_plain_10_native.height;
+        const ssd1306_box_t time_box =
         {
-            ssd1306_drawbitmap(clock);
+            0, 4, SSD1306_WIDTH, Monospaced_bold_24_native.height
+        };
+        const ssd1306_box_t date_box =
+        {
+            0, 63 - 2 * date_height, SSD1306_WIDTH, date_height
+        };
 
-            // Calculate the positions of the hands
-            uint8_t x = 64 + 27.0f * cosf((datetime.second * (M_PI/30.0f)) - (M_PI/2.0f));
-            uint8_t y = 31 + 27.0f * sinf((datetime.second * (M_PI/30.0f)) - (M_PI/2.0f));
-            ssd1306_drawline(64, 31, x, y);
+        xsnprintf(str, sizeof(str), "%02hd:%02hd:%02hd", datetime.hour, datetime.minute, datetime.second);
+        ssd1306_drawtext(oled, &Monospaced_bold_24_native, &time_box,
+            SSD1306_ALIGN_CENTER, str);
 
-            x = 64 + 27.0f * cosf((datetime.minute * (M_PI/30.0f)) - (M_PI/2.0f));
-            y = 31 + 27.0f * sinf((datetime.minute * (M_PI/30.0f)) - (M_PI/2.0f));
-            ssd1306_drawline(64, 31, x, y);
+        xsnprintf(str, sizeof(str), "%02hd-%02hd-%04hd", datetime.day, datetime.month, datetime.year);
+        ssd1306_drawtext(oled, &Monospaced_plain_10_native, &date_box,
+            SSD1306_ALIGN_CENTER, str);
+    }
+    else if(xShowState == ANALOG)
+    {
+        // The digital clock drew over the dial
+        if(shown != ANALOG)
+        {
+            sprite_invalidate(&xClockScene);
+        }
 
-            x = 64 + 20.0f * cosf((datetime.hour * (M_PI/6.0f)) - (M_PI/2.0f));
-            y = 31 + 20.0f * sinf((datetime.hour * (M_PI/6.0f)) - (M_PI/2.0f));
-            ssd1306_drawline(64, 31, x, y);
+        // The hands point at one of the 60 angles of the sine table, an
+        // hour is 5 steps
+        show_hand(0, 27, datetime.second);
+        show_hand(1, 27, datetime.minute);
+        show_hand(2, 20, (datetime.hour % 12U) * 5U);
 
-            ssd1306_update();
+        (void)sprite_render(&xClockScene, oled);
+    }
+    else
+    {
+        // The clocks drew over the dashboard
+        if(shown != STATUS)
+        {
+            widget_screen_invalidate(&xStatusScreen);
         }
+
+        // The load of the last second in per mille
+        const uint16_t load = loadmeter_total(1);
+
+        widget_set_value(&xStatusLoad, load / 10);
+        widget_set_value(&xStatusBar, load);
+        widget_set_value(&xStatusUptime, (int32_t)(mono_ms() / 1000U));
+
+        (void)widget_render(&xStatusScreen, oled);
     }
-}
 
-/*----------------------------------------------------------------------------*/
+    if(cause != NULL)
+    {
+        (void)display_trace(0, &xSwLatency[cause->sw], cause->stamp);
+    }
 
-void vSwTask(void *pvParameters)
-{
-    sw_init();
+    display_unlock(0);
+    display_flip(0);
 
-    bool sw1_pressed = false;
-    bool sw2_pressed = false;
+    shown = xShowState;
+}
 
-    char str[32];
-    sprintf(str, "[%*s] started\r\n", 12, __func__);
-    vSerialPutString(str);
+/*!
+ * \brief Handles the seconds interrupt of the RTC
+ */
+static void show_second(void *item, void *arg)
+{
+    (void)item;
+    (void)arg;
 
-    TickType_t xLastWakeTime = xTaskGetTickCount();
+    wcet_start(&xSecondWcet);
 
-    for( ;; )
+    // Binary telemetry: RTC time and a run-time stats snapshot
+    tlm_rtc(RTC->TSR);
+    tlm_tasks();
+
+#if (VIB_ENABLED == 1)
+    // Moving the board wakes the display like a switch
+    for(uint32_t axis=0; axis<3; axis++)
     {
-        // Check SW1
-        if(!sw1_pressed && sw_pressed(SW1))
+        vib_features_t features;
+
+        if(vib_get(axis, &features) && (features.rms > WAKE_RMS))
         {
-            sw1_pressed = true;
-            xQueueSend(xStateQueue, &((state_t){DIGITAL}), pdMS_TO_TICKS(20));
+            display_activity();
         }
+    }
+#endif
+
+    show_draw(NULL);
+
+    (void)wcet_end(&xSecondWcet);
+}
+
+/*!
+ * \brief Handles the switch events pending for the Show task
+ *
+ * SW1 selects the digital clock, SW2 the analog clock, holding SW1 the
+ * status dashboard. The other event types are ignored.
+ */
+static void show_switch(void *item, void *arg)
+{
+    const state_t state = xShowState;
+    sw_event_t *event;
+    sw_event_t cause = {0};
+
+    (void)item;
+    (void)arg;
+
+    wcet_start(&xSwitchWcet);
+
+    // The signal bits are combined, so take all pending events
+    while((event = bus_receive(&xShowSwSub)) != NULL)
+    {
+        // Every switch event keeps the display on or wakes it
+        display_activity();
+
+        const state_t was = xShowState;
 
-        if(sw1_pressed && !sw_pressed(SW1))
+        if(event->type == SW_PRESS)
         {
-            sw1_pressed = false;
+            xShowState = (event->sw == SW1) ? DIGITAL : ANALOG;
         }
-
-        // Check SW2
-        if(!sw2_pressed && sw_pressed(SW2))
+        else if((event->type == SW_LONG) && (event->sw == SW1))
         {
-            sw2_pressed = true;
-            xQueueSend(xStateQueue, &((state_t){ANALOG}), pdMS_TO_TICKS(20));
+            xShowState = STATUS;
         }
 
-        if(sw2_pressed && !sw_pressed(SW2))
+        if(xShowState != was)
         {
-            sw2_pressed = false;
+            cause = *event;
         }
 
-        // Wait before sampling the next time
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(100));
+        msg_release(event);
+    }
+
+    if(xShowState != state)
+    {
+        show_draw(&cause);
     }
+
+    (void)wcet_end(&xSwitchWcet);
+}
+
+/*!
+ * \brief Signals the mux of the Show task when a switch event is published
+ */
+static void show_notify(bus_sub_t *sub)
+{
+    (void)sub;
+
+    mux_signal(&xShowMux, 1);
 }
 
 /*----------------------------------------------------------------------------*/
 
 static void vSyncTask(void *pvParameters)
 {
-    rtc_datetime_t datetime;
+    // Without a callback, the alarm notifies this task
+    static rtc_alarm_t sync_alarm = {.callback = NULL};
+
+    sync_alarm.task = xTaskGetCurrentTaskHandle();
+
+    // The alarm and the fixes need the RTC of the Show task
+    const bool rtc_ok = bringup_begin(&xDcf77Step, portMAX_DELAY);
+
+    dcf77_init();
+
+    bringup_done(&xDcf77Step, rtc_ok);
 
-    char str[32];
-    sprintf(str, "[%*s] started\r\n", 12, __func__);
-    vSerialPutString(str);
+    LOG_DEBUG("[%*s] started\r\n", 12, __func__);
 
-    TickType_t xLastWakeTime = xTaskGetTickCount();
+    // Start synchronization every hour at minute 58
+    const uint32_t now = rtc_get_seconds();
+    uint32_t first = now - (now % 3600) + (58 * 60);
+
+    if(first <= now)
+    {
+        first += 3600;
+    }
+
+    rtc_alarm_start(&sync_alarm, first, 3600);
 
     for( ;; )
     {
-        // Start synchronization every hour
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(60 * 1000));
+        // No wake-ups until the alarm expires
+        ulTaskNotifyTakeIndexed(RTC_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
 
-        rtc_get(&datetime);
+        // A fix takes one to two minutes with good reception
+        dcf77_fix_start();
 
-        if(datetime.minute >= 58)
+        if(dcf77_fix_wait(pdMS_TO_TICKS(4 * 60 * 1000)))
+        {
+            LOG_INFO("[%*s] time synchronised\r\n", 12, __func__);
+        }
+        else
         {
-            dcf77_fix_start();
+            LOG_WARN("[%*s] no DCF77 fix\r\n", 12, __func__);
         }
     }
 }
+
+/*----------------------------------------------------------------------------*/
+
+static void vCmdTask(void *pvParameters)
+{
+#if (CONSOLE_ENABLED != 1)
+    char c;
+#endif
+
+    LOG_DEBUG("[%*s] started\r\n", 12, __func__);
+
+#if (CRASH_ENABLED == 1)
+    // What ended the previous run, if it crashed
+    crash_report();
+#endif
+
+#if (CONSOLE_ENABLED == 1)
+    // Named commands on lines, the characters reach FreeMASTER first
+    console_init(xSerialGetDefaultPort(), xCommands,
+        sizeof(xCommands) / sizeof(xCommands[0]), fmstr_rx);
+    console_run();
+#else
+    for( ;; )
+    {
+        // Wait for a command character, 'l' task list, 'r' run-time stats,
+        // 'i' interrupt stats, 's' stack usage, 'h' heap stats, 't' trace dump,
+        // 'u' CPU load, 'q' queue contention, 'p' periodic task deadlines,
+        // 'w' job execution times, 'k' masked sections, 'm' MTB branch trace,
+        // 'e' power mode residency, 'c' next clock mode, 'f' flash log,
+        // 'v' vibration spectrum, 'b' device bring-up,
+        // 'a' accelerometer burst to the flash log, 'n' board-to-board link,
+        // 'o' deferred work, 'd' pulse measurement, 'x' I2C transfers,
+        // 'g' serial errors
+        if(xSerialGetChar(&c, portMAX_DELAY) == pdPASS)
+        {
+            // FreeMASTER frames start with '+' and are handled by the driver
+            if(fmstr_rx(c))
+            {
+                continue;
+            }
+
+            if(c == 't')
+            {
+                (void)tlm_trace();
+            }
+            else if(c == 'u')
+            {
+                loadmeter_report();
+            }
+            else if(c == 'm')
+            {
+                mtb_dump();
+            }
+            else if(c == 'e')
+            {
+                powerprof_report();
+            }
+            else if(c == 'b')
+            {
+                bringup_report();
+            }
+            else if(c == 'o')
+            {
+                work_report();
+                idle_report();
+#if (VIB_ENABLED == 1)
+                flow_report();
+#endif
+            }
+            else if(c == 'd')
+            {
+                cap_report(CAP_BOTH);
+            }
+#if (FLOG_ENABLED == 1)
+            else if(c == 'f')
+            {
+                flog_report();
+            }
+#endif
+#if (VIB_ENABLED == 1)
+            else if(c == 'v')
+            {
+                vib_report();
+            }
+#endif
+#if (ALOG_ENABLED == 1)
+            else if(c == 'a')
+            {
+                if(!alog_burst())
+                {
+                    LOG_WARN("accelerometer burst already running\r\n");
+                }
+            }
+#endif
+#if (LINK_ENABLED == 1)
+            else if(c == 'n')
+            {
+                link_report();
+            }
+#endif
+            else if(c == 'c')
+            {
+                next_clock_mode();
+            }
+            else
+            {
+                taskstats_command(c);
+            }
+        }
+    }
+#endif
+}
+
+/*!
+ * \brief Switches to the next clock mode
+ */
+static void next_clock_mode(void)
+{
+    clk_set_mode((clk_mode_t)((clk_get_mode() + 1) % CLK_N_MODES));
+
+    LOG_INFO("Clock: %s, core %lu Hz, bus %lu Hz\r\n",
+        clk_mode_name(clk_get_mode()),
+        (unsigned long)clk_core_hz(), (unsigned long)clk_bus_hz());
+}
+
+#if (CONSOLE_ENABLED == 1)
+#if (ALOG_ENABLED == 1)
+static void cmd_accel(const uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    if(!alog_burst())
+    {
+        LOG_WARN("accelerometer burst already running\r\n");
+    }
+}
+#endif
+
+#if (ACQ_ENABLED == 1)
+static void cmd_acq(const uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    acq_report();
+}
+#endif
+
+static void cmd_bringup(const uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    bringup_report();
+}
+
+static void cmd_capture(const uint32_t argc, char *argv[])
+{
+    cap_edge_t edge = CAP_BOTH;
+
+    if((argc > 1) && (strcmp(argv[1], "rise") == 0))
+    {
+        edge = CAP_RISING;
+    }
+    else if((argc > 1) && (strcmp(argv[1], "fall") == 0))
+    {
+        edge = CAP_FALLING;
+    }
+
+    cap_report(edge);
+}
+
+static void cmd_clock(const uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    next_clock_mode();
+}
+
+#if (FLOG_ENABLED == 1)
+static void cmd_flog(const uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    flog_report();
+}
+#endif
+
+#if (LINK_ENABLED == 1)
+static void cmd_link(const uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    link_report();
+}
+#endif
+
+static void cmd_load(const uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    loadmeter_report();
+}
+
+static void cmd_mtb(const uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    mtb_dump();
+}
+
+#if (OVERLOAD_ENABLED == 1)
+static void cmd_overload(const uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    overload_report();
+}
+#endif
+
+static void cmd_power(const uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    powerprof_report();
+}
+
+#if (VIB_ENABLED == 1)
+static void cmd_vib(const uint32_t argc, char *argv[])
+{
+    if((argc > 1) && (strcmp(argv[1], "cal") == 0))
+    {
+        vib_calibrate();
+        return;
+    }
+
+    vib_report();
+}
+#endif
+
+static void cmd_work(const uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    work_report();
+    idle_report();
+#if (VIB_ENABLED == 1)
+    flow_report();
+#endif
+}
+#endif
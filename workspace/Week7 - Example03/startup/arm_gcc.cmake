@@ -27,6 +27,7 @@ set(CMAKE_TRY_COMPILE_TARGET_TYPE "STATIC_LIBRARY")
 set(CMAKE_OBJCOPY arm-none-eabi-objcopy)
 set(CMAKE_OBJDUMP arm-none-eabi-objdump)
 set(SIZE arm-none-eabi-size)
+set(NM arm-none-eabi-nm)
 set(MCPU cortex-m0plus)
 set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
 
@@ -57,8 +58,17 @@ add_link_options(-mthumb
                 -specs=nano.specs 
                 -Wl,--gc-sections
                 -Wl,--print-memory-usage
-                -lm
-                -Wl,-Map=${PROJECT_BINARY_DIR}/${PROJECT_NAME}.map)
+                -lm)
+
+# Optimisation level of the build profiles. Debug builds unoptimised as
+# before, Release optimises for size with the speed critical libraries at -O2
+# (see SPEED_LIBRARIES in CMakeLists.txt), MinSizeRel optimises everything for
+# size. All profiles keep the -g3 debug information. Set as cache entries
+# before project(), the compiler defaults such as -O3 -DNDEBUG are not used.
+set(CMAKE_C_FLAGS_DEBUG "-O0" CACHE STRING "C flags of the Debug profile")
+set(CMAKE_C_FLAGS_RELEASE "-Os" CACHE STRING "C flags of the Release profile")
+set(CMAKE_C_FLAGS_MINSIZEREL "-Os" CACHE STRING "C flags of the MinSizeRel profile")
+set(CMAKE_C_FLAGS_RELWITHDEBINFO "-Og" CACHE STRING "C flags of the RelWithDebInfo profile")
 
 set(LINKER_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/linker_script.ld)
 add_link_options(-T ${LINKER_SCRIPT} -static)
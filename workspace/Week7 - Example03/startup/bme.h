@@ -0,0 +1,84 @@
+/*! ***************************************************************************
+ *
+ * \brief     Atomic peripheral register access with the Bit Manipulation Engine
+ * \file      bme.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef BME_H
+#define BME_H
+
+#include <stdint.h>
+
+/*!
+ * \brief Decorated store operations of the BME
+ *
+ * A store to a peripheral register address in 0x40000000 .. 0x4007FFFF
+ * with one of these operations in bits [28:26] is carried out by the BME in
+ * the peripheral bridge as a single read-modify-write that cannot be
+ * interrupted, in two bus cycles. This is all peripherals except GPIO and
+ * FGPIO, use PSOR, PCOR and PTOR for those.
+ *
+ * The register is still read and written as a whole, so write-1-to-clear
+ * flags that are set are cleared, the same as with a C read-modify-write.
+ */
+/// \{
+#define BME_OP_AND          (0x04000000UL)
+#define BME_OP_OR           (0x08000000UL)
+#define BME_OP_XOR          (0x0C000000UL)
+#define BME_OP_BFI(b, w)    (0x10000000UL | ((uint32_t)(b) << 23) | \
+                             ((uint32_t)((w) - 1) << 19))
+/// \}
+
+/*!
+ * \brief Decorated address of a register
+ */
+#define BME_ADDR(reg, op) \
+    ((volatile __typeof__(reg) *)((uintptr_t)&(reg) | (op)))
+
+/// reg &= mask, atomic
+#define BME_AND(reg, mask)  (*BME_ADDR(reg, BME_OP_AND) = (__typeof__(reg))(mask))
+
+/// reg |= mask, atomic
+#define BME_OR(reg, mask)   (*BME_ADDR(reg, BME_OP_OR) = (__typeof__(reg))(mask))
+
+/// reg ^= mask, atomic
+#define BME_XOR(reg, mask)  (*BME_ADDR(reg, BME_OP_XOR) = (__typeof__(reg))(mask))
+
+/// reg &= ~mask, atomic
+#define BME_CLR(reg, mask)  BME_AND(reg, ~(mask))
+
+/*!
+ * \brief Writes value into the w bits of reg starting at bit b, atomic
+ *
+ * value is not shifted, pass it as a field macro of the register
+ * definitions, for example BME_BFI(PORTD->PCR[3], PORT_PCR_IRQC_SHIFT,
+ * PORT_PCR_IRQC_WIDTH, PORT_PCR_IRQC(0b1011)).
+ */
+#define BME_BFI(reg, b, w, value) \
+    (*BME_ADDR(reg, BME_OP_BFI(b, w)) = (__typeof__(reg))(value))
+
+#endif // BME_H
@@ -0,0 +1,59 @@
+/*! ***************************************************************************
+ *
+ * \brief     Boot time measurement
+ * \file      boot.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef BOOT_H
+#define BOOT_H
+
+#include <MKL25Z4.h>
+
+/// PIT0 counts on the 24 MHz bus clock
+#define BOOT_CYCLES_PER_US  (24)
+
+/*!
+ * \brief Bus clock cycles spent by ResetISR() in the initialisation of the
+ *        data and bss sections
+ */
+extern unsigned int boot_init_cycles;
+
+/*!
+ * \brief Returns the bus clock cycles since the end of SystemInit()
+ *
+ * ResetISR() starts PIT0 free-running from 0xFFFFFFFF. The value is valid
+ * until vConfigureTimerForRunTimeStats() reloads PIT0 in the periodic
+ * run-time stats mode, or until PIT0 wraps after about 179 s.
+ *
+ * \return Bus clock cycles
+ */
+static inline uint32_t boot_cycles(void)
+{
+    return 0xFFFFFFFFUL - PIT->CHANNEL[0].CVAL;
+}
+
+#endif // BOOT_H
@@ -0,0 +1,103 @@
+/*! ***************************************************************************
+ *
+ * \brief     Inline GPIO accessors on the FGPIO or GPIO alias
+ * \file      gpio.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef GPIO_H
+#define GPIO_H
+
+#include <MKL25Z4.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*!
+ * \brief Set to 1 to access the ports through the FGPIO alias
+ *
+ * The FGPIO alias of the ports is on the single-cycle IOPORT of the core,
+ * a write or read takes one cycle. The GPIO alias is reached through the
+ * peripheral bridge at the bus clock and takes several cycles. The DMA
+ * controller can only reach the GPIO alias, so pins written by DMA must not
+ * use these accessors.
+ */
+#ifndef GPIO_USE_FGPIO
+#define GPIO_USE_FGPIO (1)
+#endif
+
+#if (GPIO_USE_FGPIO == 1)
+typedef FGPIO_Type gpio_t;
+#define GPIO_A  FGPIOA
+#define GPIO_B  FGPIOB
+#define GPIO_C  FGPIOC
+#define GPIO_D  FGPIOD
+#define GPIO_E  FGPIOE
+#else
+typedef GPIO_Type gpio_t;
+#define GPIO_A  GPIOA
+#define GPIO_B  GPIOB
+#define GPIO_C  GPIOC
+#define GPIO_D  GPIOD
+#define GPIO_E  GPIOE
+#endif
+
+/// Drives the pins in mask high
+static inline void gpio_set(gpio_t *port, const uint32_t mask)
+{
+    port->PSOR = mask;
+}
+
+/// Drives the pins in mask low
+static inline void gpio_clear(gpio_t *port, const uint32_t mask)
+{
+    port->PCOR = mask;
+}
+
+/// Inverts the pins in mask
+static inline void gpio_toggle(gpio_t *port, const uint32_t mask)
+{
+    port->PTOR = mask;
+}
+
+/// Returns true if any of the pins in mask reads high
+static inline bool gpio_read(gpio_t *port, const uint32_t mask)
+{
+    return (port->PDIR & mask) != 0;
+}
+
+/// Makes the pins in mask outputs
+static inline void gpio_output(gpio_t *port, const uint32_t mask)
+{
+    port->PDDR |= mask;
+}
+
+/// Makes the pins in mask inputs
+static inline void gpio_input(gpio_t *port, const uint32_t mask)
+{
+    port->PDDR &= ~mask;
+}
+
+#endif // GPIO_H
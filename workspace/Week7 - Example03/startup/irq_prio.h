@@ -0,0 +1,211 @@
+/*! ***************************************************************************
+ *
+ * \brief     Interrupt priorities and latency budgets of the board
+ * \file      irq_prio.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef IRQ_PRIO_H
+#define IRQ_PRIO_H
+
+#include <MKL25Z4.h>
+#include <stdint.h>
+
+/// \name Priority levels of the NVIC
+/// \{
+
+/*!
+ * \brief The four levels of the two priority bits of the Cortex-M0+
+ *
+ * A handler is only preempted by handlers of a lower level, handlers of the
+ * same level run one after the other. The ARM_CM0 port masks all interrupts
+ * in its critical sections, so every level may call the FromISR functions
+ * of the kernel and is delayed by the longest critical section.
+ *
+ *  Level  Priority  Used for
+ *  0      0         Sampling at fixed times: recorder, benchmark events
+ *  1      64        Events with a time stamp: accelerometer, RTC, timers
+ *  2      128       Data movers: UART, I2C, ADC, DMA, capture, USB
+ *  3      192       Background: run-time counter, switches, LEDs, wake-ups
+ */
+#define IRQ_LEVELS            (1 << __NVIC_PRIO_BITS)
+
+/// NVIC priority of a level
+#define IRQ_PRIO_LEVEL(level) ((uint32_t)(level) << (8 - __NVIC_PRIO_BITS))
+
+/// Level of an NVIC priority
+#define IRQ_LEVEL_OF(prio)    ((uint32_t)(prio) >> (8 - __NVIC_PRIO_BITS))
+
+/// \}
+
+/// \name Latency budgets in microseconds
+/// \{
+
+/*!
+ * \brief Longest time the interrupts are masked, by the kernel and by the
+ *        drivers, see critmon.h
+ */
+#ifndef IRQ_MASKED_US
+#define IRQ_MASKED_US         (20)
+#endif
+
+/*!
+ * \brief Worst-case entry latency that a handler of each level may see
+ *
+ * The worst case is IRQ_MASKED_US plus one run of every handler of the same
+ * and the lower levels, each within its run budget in IRQ_PRIO_TABLE. It is
+ * checked against the budget when compiling, so a new handler or a longer
+ * run budget that breaks a level does not build.
+ */
+#define IRQ_LATENCY_US_0      (50)
+#define IRQ_LATENCY_US_1      (100)
+#define IRQ_LATENCY_US_2      (250)
+#define IRQ_LATENCY_US_3      (1000)
+
+/// \}
+
+/*!
+ * \brief Interrupt sources of all drivers
+ *
+ * IRQ(name, first IRQ, last IRQ, level, run budget in us). A driver sets
+ * the priority of its interrupts with IRQ_PRIO(name), a second entry of the
+ * same name does not compile. An entry covers the IRQ numbers first to
+ * last, for example all DMA channels for a DMA client, whose channel is
+ * claimed at run-time. Sources that share an IRQ number are alternatives,
+ * LPTMR0 is the tickless idle or the FreeMASTER recorder and TPM1 the timer
+ * service or the TCRT5000 trigger.
+ *
+ * The run budget is the longest time a handler may take. taskstats_irq()
+ * compares it and the latency budget of the level with the times measured
+ * by TRACE_IRQ_STATS.
+ */
+#define IRQ_PRIO_TABLE(IRQ) \
+    IRQ(BENCH,       CMP0_IRQn,        CMP0_IRQn,        0,  2) \
+    IRQ(BENCH_EVENT, DAC0_IRQn,        DAC0_IRQn,        0,  2) \
+    IRQ(FMSTR_REC,   LPTMR0_IRQn,      LPTMR0_IRQn,      0, 10) \
+    IRQ(MMA8451,     PORTA_IRQn,       PORTA_IRQn,       1,  5) \
+    IRQ(RTC,         RTC_IRQn,         RTC_IRQn,         1,  5) \
+    IRQ(RTC_SECONDS, RTC_Seconds_IRQn, RTC_Seconds_IRQn, 1,  5) \
+    IRQ(TIMER,       TPM1_IRQn,        TPM1_IRQn,        1, 10) \
+    IRQ(SERIAL,      UART0_IRQn,       UART2_IRQn,       2,  5) \
+    IRQ(SERIAL_DMA,  DMA0_IRQn,        DMA3_IRQn,        2, 10) \
+    IRQ(I2C,         I2C0_IRQn,        I2C1_IRQn,        2, 10) \
+    IRQ(I2C_DMA,     DMA0_IRQn,        DMA3_IRQn,        2,  5) \
+    IRQ(SPI1_DMA,    DMA0_IRQn,        DMA3_IRQn,        2,  5) \
+    IRQ(ADC,         ADC0_IRQn,        ADC0_IRQn,        2,  5) \
+    IRQ(DAC_DMA,     DMA0_IRQn,        DMA3_IRQn,        2,  5) \
+    IRQ(DCF77,       TPM0_IRQn,        TPM0_IRQn,        2,  5) \
+    IRQ(CAPTURE_DMA, DMA0_IRQn,        DMA3_IRQn,        2, 10) \
+    IRQ(TCRT5000,    TPM1_IRQn,        TPM1_IRQn,        2,  5) \
+    IRQ(TCRT5000_DMA,DMA0_IRQn,        DMA3_IRQn,        2,  5) \
+    IRQ(USB,         USB0_IRQn,        USB0_IRQn,        2, 50) \
+    IRQ(RUNTIME,     PIT_IRQn,         PIT_IRQn,         3,  5) \
+    IRQ(SWITCHES,    PORTD_IRQn,       PORTD_IRQn,       3,  5) \
+    IRQ(RGB,         TPM2_IRQn,        TPM2_IRQn,        3,  5) \
+    IRQ(RGB_DMA,     DMA0_IRQn,        DMA3_IRQn,        3,  5) \
+    IRQ(LPTMR,       LPTMR0_IRQn,      LPTMR0_IRQn,      3,  5) \
+    IRQ(LLWU,        LLWU_IRQn,        LLWU_IRQn,        3,  5)
+
+/// NVIC priority of an interrupt source of IRQ_PRIO_TABLE
+#define IRQ_PRIO(name)        ((uint32_t)IRQ_PRIO_##name)
+
+#define IRQ_PRIO_ENUM(name, first, last, level, run_us) \
+    IRQ_PRIO_##name = IRQ_PRIO_LEVEL(level),
+
+/// NVIC priorities, a name that is used twice is a redeclaration
+enum
+{
+    IRQ_PRIO_TABLE(IRQ_PRIO_ENUM)
+};
+
+#define IRQ_PRIO_CHECK(name, first, last, level, run_us) \
+    _Static_assert(((level) >= 0) && ((level) < IRQ_LEVELS), \
+                   #name " has no priority level"); \
+    _Static_assert((first) <= (last), #name " has no IRQ numbers");
+
+IRQ_PRIO_TABLE(IRQ_PRIO_CHECK)
+
+/// \name Worst-case latency of every level, one run of all handlers at or
+///       below it
+/// \{
+#define IRQ_PRIO_RUN_0(name, first, last, level, run_us) + (((level) <= 0) ? (run_us) : 0)
+#define IRQ_PRIO_RUN_1(name, first, last, level, run_us) + (((level) <= 1) ? (run_us) : 0)
+#define IRQ_PRIO_RUN_2(name, first, last, level, run_us) + (((level) <= 2) ? (run_us) : 0)
+#define IRQ_PRIO_RUN_3(name, first, last, level, run_us) + (((level) <= 3) ? (run_us) : 0)
+
+#define IRQ_WORST_US(level) \
+    (IRQ_MASKED_US + (0 IRQ_PRIO_TABLE(IRQ_PRIO_RUN_##level)))
+/// \}
+
+_Static_assert(IRQ_WORST_US(0) <= IRQ_LATENCY_US_0, "level 0 exceeds its latency budget");
+_Static_assert(IRQ_WORST_US(1) <= IRQ_LATENCY_US_1, "level 1 exceeds its latency budget");
+_Static_assert(IRQ_WORST_US(2) <= IRQ_LATENCY_US_2, "level 2 exceeds its latency budget");
+_Static_assert(IRQ_WORST_US(3) <= IRQ_LATENCY_US_3, "level 3 exceeds its latency budget");
+
+/*!
+ * \brief Returns the latency budget of a level in microseconds
+ */
+static inline uint32_t irq_latency_budget_us(const uint32_t level)
+{
+    static const uint16_t budget[IRQ_LEVELS] =
+    {
+        IRQ_LATENCY_US_0, IRQ_LATENCY_US_1, IRQ_LATENCY_US_2, IRQ_LATENCY_US_3,
+    };
+
+    return (level < IRQ_LEVELS) ? budget[level] : 0;
+}
+
+/*!
+ * \brief Returns the run budget of an interrupt in microseconds
+ *
+ * The longest budget of the sources at the IRQ number with the given
+ * priority, so the budget of the source that set the priority.
+ *
+ * \param[in]  irq   IRQ number
+ * \param[in]  prio  NVIC priority of the IRQ
+ *
+ * \return The budget, 0 if no source in IRQ_PRIO_TABLE has this IRQ number
+ *         and priority
+ */
+static inline uint32_t irq_run_budget_us(const int32_t irq, const uint32_t prio)
+{
+#define IRQ_PRIO_BUDGET(name, first, last, level, run_us) \
+    if((irq >= (first)) && (irq <= (last)) && \
+       (IRQ_PRIO_LEVEL(level) == prio) && ((run_us) > budget)) \
+    { \
+        budget = (run_us); \
+    }
+
+    uint32_t budget = 0;
+
+    IRQ_PRIO_TABLE(IRQ_PRIO_BUDGET)
+
+#undef IRQ_PRIO_BUDGET
+
+    return budget;
+}
+
+#endif // IRQ_PRIO_H
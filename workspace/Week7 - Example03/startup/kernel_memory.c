@@ -0,0 +1,192 @@
+/*! ***************************************************************************
+ *
+ * \brief     Static memory of the kernel tasks and the memory of the heap
+ * \file      kernel_memory.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "kernel_memory.h"
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1) && (configHEAP_REGIONS == 1)
+/*!
+ * \brief Smallest spare RAM of a bank that is made a heap region
+ *
+ * A region holds the free block header and the end marker of heap_5.
+ */
+#define HEAP_REGION_MIN     (64)
+#endif
+
+/*!
+ * \brief Control blocks and stacks of the idle and timer service tasks
+ *
+ * With configSUPPORT_STATIC_ALLOCATION the kernel asks the application for
+ * the memory of the tasks it creates itself in vTaskStartScheduler(). The
+ * kernel fills the stacks when the tasks are created, so the startup code
+ * does not clear them.
+ */
+static StaticTask_t idle_tcb;
+__BSS_NOCLEAR static StackType_t idle_stack[configMINIMAL_STACK_SIZE];
+
+#if (configUSE_TIMERS == 1)
+static StaticTask_t timer_tcb;
+__BSS_NOCLEAR static StackType_t timer_stack[configTIMER_TASK_STACK_DEPTH];
+#endif
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1) && (configHEAP_REGIONS == 1)
+/*!
+ * \brief Spare RAM of both SRAM arrays, defined by the linker script
+ *
+ * SRAM_L is spare from the end of .bss, if .bss ends before SRAM_U. SRAM_U
+ * is spare from the end of the linker heap to the bottom of the main stack.
+ */
+extern uint8_t __start_heap_SRAM_L[];
+extern uint8_t __end_heap_SRAM_L[];
+extern uint8_t __start_heap_SRAM_U[];
+extern uint8_t __end_heap_SRAM_U[];
+
+/// Regions given to heap_5, in address order and terminated by a zero size
+static HeapRegion_t heap_regions[HEAP_BANKS + 1];
+
+#elif (configSUPPORT_DYNAMIC_ALLOCATION == 1) && (configAPPLICATION_ALLOCATED_HEAP == 1)
+/*!
+ * \brief Memory of the kernel heap
+ *
+ * heap_4 and heap_tlsf build their free lists in it before the first
+ * allocation, so the startup code does not clear it.
+ */
+__BSS_NOCLEAR uint8_t ucHeap[configTOTAL_HEAP_SIZE];
+#endif
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer,
+    StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize)
+{
+    *ppxIdleTaskTCBBuffer = &idle_tcb;
+    *ppxIdleTaskStackBuffer = idle_stack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+#if (configUSE_TIMERS == 1)
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
+    StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize)
+{
+    *ppxTimerTaskTCBBuffer = &timer_tcb;
+    *ppxTimerTaskStackBuffer = timer_stack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1) && (configHEAP_REGIONS == 1)
+/*!
+ * \brief Returns the spare RAM of a bank
+ */
+static HeapRegion_t heap_bank(const heap_bank_t bank)
+{
+    if(bank == HEAP_SRAM_L)
+    {
+        return (HeapRegion_t){__start_heap_SRAM_L,
+            (size_t)(__end_heap_SRAM_L - __start_heap_SRAM_L)};
+    }
+
+    return (HeapRegion_t){__start_heap_SRAM_U,
+        (size_t)(__end_heap_SRAM_U - __start_heap_SRAM_U)};
+}
+
+/*!
+ * \brief Returns the spare RAM of both banks as the regions of heap_5
+ *
+ * Called by heap_5 on the first allocation. A bank with less than
+ * HEAP_REGION_MIN bytes of spare RAM is left out.
+ */
+const HeapRegion_t *pxApplicationGetHeapRegions(void)
+{
+    uint32_t n = 0;
+
+    for(heap_bank_t bank=HEAP_SRAM_L; bank<HEAP_BANKS; bank++)
+    {
+        const HeapRegion_t region = heap_bank(bank);
+
+        if(region.xSizeInBytes >= HEAP_REGION_MIN)
+        {
+            heap_regions[n++] = region;
+        }
+    }
+
+    heap_regions[n] = (HeapRegion_t){NULL, 0};
+
+    return heap_regions;
+}
+
+/*!
+ * \brief Returns the bytes of the heap in a bank
+ *
+ * \param[in]  bank  The bank
+ *
+ * \return Size in bytes, 0 if the bank has no heap region
+ */
+size_t heap_bank_size(const heap_bank_t bank)
+{
+    const HeapRegion_t region = heap_bank(bank);
+
+    return (region.xSizeInBytes >= HEAP_REGION_MIN) ? region.xSizeInBytes : 0;
+}
+
+/*!
+ * \brief Allocates memory in a bank
+ *
+ * For a DMA buffer in SRAM_U, or data of the RAM functions in SRAM_L.
+ * Freed with vPortFree().
+ *
+ * \param[in]  bank  The bank
+ * \param[in]  size  Size in bytes
+ *
+ * \return The memory, NULL if no free block in the bank is large enough
+ */
+void *heap_malloc_bank(const heap_bank_t bank, const size_t size)
+{
+    const HeapRegion_t region = heap_bank(bank);
+
+    return pvPortMallocFromRegion(&region, size);
+}
+#endif
+
+/*!
+ * \brief Returns the size of the kernel heap in bytes
+ *
+ * configTOTAL_HEAP_SIZE, or with heap_5 the spare RAM of both banks.
+ */
+size_t heap_size(void)
+{
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1) && (configHEAP_REGIONS == 1)
+    return heap_bank_size(HEAP_SRAM_L) + heap_bank_size(HEAP_SRAM_U);
+#elif (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    return configTOTAL_HEAP_SIZE;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,54 @@
+/*! ***************************************************************************
+ *
+ * \brief     Kernel heap size and the heap_5 regions in both SRAM arrays
+ * \file      kernel_memory.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef KERNEL_MEMORY_H
+#define KERNEL_MEMORY_H
+
+#include <stddef.h>
+
+#include "FreeRTOS.h"
+
+/// SRAM array of a heap_5 region, see startup/sections.h
+typedef enum
+{
+    HEAP_SRAM_L,    ///< 0x1FFFF000 to 0x1FFFFFFF, next to the RAM functions
+    HEAP_SRAM_U,    ///< 0x20000000 to 0x20002FFF, for DMA buffers
+    HEAP_BANKS
+}
+heap_bank_t;
+
+size_t heap_size(void);
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1) && (configHEAP_REGIONS == 1)
+size_t heap_bank_size(const heap_bank_t bank);
+void *heap_malloc_bank(const heap_bank_t bank, const size_t size);
+#endif
+
+#endif // KERNEL_MEMORY_H
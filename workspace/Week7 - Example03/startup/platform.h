@@ -0,0 +1,85 @@
+/*! ***************************************************************************
+ *
+ * \brief     MCM platform control of the flash controller cache and speculation
+ * \file      platform.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#include <MKL25Z4.h>
+
+/// The flash controller bits of MCM_PLACR, the others are reserved
+#define PLATFORM_PLACR_MASK (MCM_PLACR_ARB_MASK | MCM_PLACR_CFCC_MASK | \
+                             MCM_PLACR_DFCDA_MASK | MCM_PLACR_DFCIC_MASK | \
+                             MCM_PLACR_DFCC_MASK | MCM_PLACR_EFDS_MASK | \
+                             MCM_PLACR_DFCS_MASK | MCM_PLACR_ESFC_MASK)
+
+/*!
+ * \brief MCM_PLACR flash controller settings written by ResetISR()
+ *
+ * All code and constant data run from flash. The flash controller has a
+ * small cache and can prefetch the next flash line while the current one is
+ * used (speculation). The reset default caches and speculates instruction
+ * fetches only, data reads are neither cached nor speculated.
+ *
+ * PLATFORM_TUNED, set by CMakeLists.txt in all profiles but Debug, also
+ * caches and speculates data reads. That speeds up the reads of constant
+ * tables such as the fonts and the copy of the data sections. Arbitration
+ * stays fixed, so the core has priority over DMA. Without PLATFORM_PLACR
+ * the reset default is kept, so a Debug image runs the way an unconfigured
+ * part does. kernel_bench.elf compares the settings.
+ */
+#if !defined(PLATFORM_PLACR) && defined(PLATFORM_TUNED)
+#define PLATFORM_PLACR      (MCM_PLACR_EFDS_MASK)
+#endif
+
+/*!
+ * \brief Changes the flash controller settings
+ *
+ * The cache is cleared, so no line cached under the old settings is used.
+ *
+ * \param[in]  placr  Flash controller bits of MCM_PLACR, without
+ *                    MCM_PLACR_CFCC_MASK
+ */
+static inline void platform_set_placr(const uint32_t placr)
+{
+    MCM->PLACR = (MCM->PLACR & ~PLATFORM_PLACR_MASK) |
+        (placr & PLATFORM_PLACR_MASK) | MCM_PLACR_CFCC_MASK;
+}
+
+/*!
+ * \brief Returns the flash controller settings
+ *
+ * \return Flash controller bits of MCM_PLACR
+ */
+static inline uint32_t platform_get_placr(void)
+{
+    return MCM->PLACR & (PLATFORM_PLACR_MASK & ~MCM_PLACR_CFCC_MASK);
+}
+
+#endif // PLATFORM_H
@@ -0,0 +1,101 @@
+/*! ***************************************************************************
+ *
+ * \brief     Placement of code and data in the SRAM banks
+ * \file      sections.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef SECTIONS_H
+#define SECTIONS_H
+
+/// \name Definitions for the SRAM placement
+/// \{
+
+/*!
+ * \brief Set to 1 to execute __RAMFUNC functions from SRAM_L
+ *
+ * Flash is read at the 24 MHz bus clock, so at 48 MHz the core waits on
+ * every flash fetch that misses the flash cache. SRAM is read without
+ * wait states. The startup code copies the .ramfunc section together with
+ * the initialised data. Calls between flash and SRAM are beyond the range
+ * of a BL instruction, the linker inserts a veneer for those calls.
+ */
+#ifndef RAMFUNC_ENABLED
+#define RAMFUNC_ENABLED         (1)
+#endif
+
+/*!
+ * \brief Set to 1 to place hot kernel data in SRAM_L and DMA buffers in
+ *        SRAM_U
+ *
+ * SRAM_L spans 0x1FFFF000 to 0x1FFFFFFF and SRAM_U spans 0x20000000 to
+ * 0x20002FFF. The linker script starts .data with the RAM functions and
+ * the .data.hot section at the bottom of SRAM_L and moves the .bss.$SRAM_U
+ * section above 0x20000000, so the CPU and the DMA controller work on
+ * different SRAM arrays.
+ */
+#ifndef SRAM_PLACEMENT_ENABLED
+#define SRAM_PLACEMENT_ENABLED  (1)
+#endif
+
+/// \}
+
+#if (RAMFUNC_ENABLED == 1)
+/// Function executed from SRAM_L
+#define __RAMFUNC     __attribute__((section(".ramfunc"), noinline))
+#else
+#define __RAMFUNC
+#endif
+
+#if (SRAM_PLACEMENT_ENABLED == 1)
+/// Variable in SRAM_L, next to the RAM functions
+#define __DATA_HOT    __attribute__((section(".data.hot")))
+
+/// Zero initialised variable in SRAM_U, for buffers accessed by DMA
+#define __BSS_SRAM_U  __attribute__((section(".bss.$SRAM_U")))
+#else
+#define __DATA_HOT
+#define __BSS_SRAM_U
+#endif
+
+#if (SRAM_PLACEMENT_ENABLED == 1)
+/// Zero initialised ring for circular DMA, aligned to its size in bytes, a
+/// power of two, as the SMOD and DMOD fields of DCR require. The rings are
+/// at the start of SRAM_U sorted by alignment, so they need no padding.
+#define __DMA_RING(size) \
+    __attribute__((section(".bss.$DMA_RING"), aligned(size)))
+#else
+#define __DMA_RING(size) __attribute__((aligned(size)))
+#endif
+
+/// Zero initialised variable that is not cleared by the startup code, for
+/// buffers that are written before they are read anyway
+#define __BSS_NOCLEAR __attribute__((section(".bss.noclear")))
+
+/// Variable that is not initialised and keeps its value over a warm reset
+#define __NOINIT      __attribute__((section(".noinit")))
+
+#endif // SECTIONS_H
@@ -53,6 +53,12 @@ extern "C" {
 #endif
 #endif
 
+// Flash controller cache and speculation settings of the build profile
+#include "platform.h"
+
+// Copy of the vector table in SRAM, IRQ_RAM_VECTORS
+#include "vectors.h"
+
 #define WEAK __attribute__ ((weak))
 #define WEAK_AV __attribute__ ((weak, section(".after_vectors")))
 #define ALIAS(f) __attribute__ ((weak, alias (#f)))
@@ -260,23 +266,70 @@ void (* const g_pfnVectors[])(void) = {
 // are written as separate functions rather than being inlined within the
 // ResetISR() function in order to cope with MCUs with multiple banks of
 // memory.
+// Both move four words per LDM/STM and finish with single words, the linker
+// script aligns the start and the length of every section to a word.
 //*****************************************************************************
 __attribute__ ((section(".after_vectors.init_data")))
 void data_init(unsigned int romstart, unsigned int start, unsigned int len) {
-	unsigned int *pulDest = (unsigned int*) start;
-	unsigned int *pulSrc = (unsigned int*) romstart;
-	unsigned int loop;
-	for (loop = 0; loop < len; loop = loop + 4)
-		*pulDest++ = *pulSrc++;
+	__asm volatile (
+		"	.syntax unified				\n"
+		"	b	2f				\n"
+		"1:	ldm	%[src]!, {r3, r4, r5, r6}	\n"
+		"	stm	%[dst]!, {r3, r4, r5, r6}	\n"
+		"2:	subs	%[len], #16			\n"
+		"	bhs	1b				\n"
+		"	adds	%[len], #16			\n"
+		"	beq	4f				\n"
+		"3:	ldm	%[src]!, {r3}			\n"
+		"	stm	%[dst]!, {r3}			\n"
+		"	subs	%[len], #4			\n"
+		"	bne	3b				\n"
+		"4:						\n"
+		: [dst] "+l" (start), [src] "+l" (romstart), [len] "+l" (len)
+		:
+		: "r3", "r4", "r5", "r6", "cc", "memory");
 }
 
 __attribute__ ((section(".after_vectors.init_bss")))
 void bss_init(unsigned int start, unsigned int len) {
-	unsigned int *pulDest = (unsigned int*) start;
-	unsigned int loop;
-	for (loop = 0; loop < len; loop = loop + 4)
-		*pulDest++ = 0;
-}
+	__asm volatile (
+		"	.syntax unified				\n"
+		"	movs	r3, #0				\n"
+		"	movs	r4, #0				\n"
+		"	movs	r5, #0				\n"
+		"	movs	r6, #0				\n"
+		"	b	2f				\n"
+		"1:	stm	%[dst]!, {r3, r4, r5, r6}	\n"
+		"2:	subs	%[len], #16			\n"
+		"	bhs	1b				\n"
+		"	adds	%[len], #16			\n"
+		"	beq	4f				\n"
+		"3:	stm	%[dst]!, {r3}			\n"
+		"	subs	%[len], #4			\n"
+		"	bne	3b				\n"
+		"4:						\n"
+		: [dst] "+l" (start), [len] "+l" (len)
+		:
+		: "r3", "r4", "r5", "r6", "cc", "memory");
+}
+
+//*****************************************************************************
+// Boot time measurement. PIT channel 0 is started free-running from
+// 0xFFFFFFFF right after SystemInit(), it runs on the bus clock and
+// vConfigureTimerForRunTimeStats() takes it over as the run-time counter.
+// boot_init_cycles holds the bus clock cycles spent in the data and bss
+// section initialisation, see boot.h.
+//*****************************************************************************
+#define BOOT_SIM_SCGC6      (*((volatile unsigned int *)0x4004803C))
+#define BOOT_SIM_SCGC6_PIT  (1u << 23)
+#define BOOT_PIT_MCR        (*((volatile unsigned int *)0x40037000))
+#define BOOT_PIT_MCR_FRZ    (1u << 0)
+#define BOOT_PIT_LDVAL0     (*((volatile unsigned int *)0x40037100))
+#define BOOT_PIT_CVAL0      (*((volatile unsigned int *)0x40037104))
+#define BOOT_PIT_TCTRL0     (*((volatile unsigned int *)0x40037108))
+#define BOOT_PIT_TCTRL_TEN  (1u << 0)
+
+unsigned int boot_init_cycles;
 
 //*****************************************************************************
 // The following symbols are constructs generated by the linker, indicating
@@ -310,6 +363,17 @@ void ResetISR(void) {
     *((volatile unsigned int *)0x40048100) = 0x00u;
 #endif // (__USE_CMSIS)
 
+#if defined (PLATFORM_PLACR)
+    // Before the data sections are copied from flash
+    platform_set_placr(PLATFORM_PLACR);
+#endif
+
+    // Start the boot time counter
+    BOOT_SIM_SCGC6 |= BOOT_SIM_SCGC6_PIT;
+    BOOT_PIT_MCR = BOOT_PIT_MCR_FRZ;
+    BOOT_PIT_LDVAL0 = 0xFFFFFFFFu;
+    BOOT_PIT_TCTRL0 = BOOT_PIT_TCTRL_TEN;
+
     //
     // Copy the data sections from flash to SRAM.
     //
@@ -335,6 +399,9 @@ void ResetISR(void) {
 		bss_init(ExeAddr, SectionLen);
 	}
 
+	// Written after the bss initialisation, it is in .bss itself
+	boot_init_cycles = 0xFFFFFFFFu - BOOT_PIT_CVAL0;
+
 #if !defined (__USE_CMSIS)
 // Assume that if __USE_CMSIS defined, then CMSIS SystemInit code
 // will setup the VTOR register
@@ -349,6 +416,11 @@ void ResetISR(void) {
     }
 #endif // (__USE_CMSIS)
 
+#if (IRQ_RAM_VECTORS == 1)
+    // Interrupts are still disabled, VTOR moves to the copy in SRAM
+    irq_vectors_init();
+#endif
+
 #if defined (__cplusplus)
     //
     // Call C++ library initialisation
@@ -0,0 +1,131 @@
+/*! ***************************************************************************
+ *
+ * \brief     Vector table in SRAM with handlers installed at run-time
+ * \file      vectors.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "vectors.h"
+#include "sections.h"
+
+// The flash table of startup_mkl25z4.c
+extern void (* const g_pfnVectors[])(void);
+
+#if (IRQ_RAM_VECTORS == 1)
+
+/*!
+ * \brief The copy in SRAM
+ *
+ * VTOR requires the table to be aligned to its size rounded up to a power
+ * of two. It is written by irq_vectors_init() before it is used, so the
+ * startup code does not clear it.
+ */
+__BSS_NOCLEAR __attribute__((aligned(256)))
+static volatile irq_handler_t ram_vectors[VECTORS_COUNT];
+
+#endif
+
+/*!
+ * \brief Copies the vector table to SRAM and moves VTOR to the copy
+ *
+ * Called by ResetISR() with interrupts masked, after the bss section is
+ * cleared. Does nothing when IRQ_RAM_VECTORS is 0.
+ */
+void irq_vectors_init(void)
+{
+#if (IRQ_RAM_VECTORS == 1)
+    for(uint32_t i=0; i<VECTORS_COUNT; i++)
+    {
+        ram_vectors[i] = g_pfnVectors[i];
+    }
+
+    __DSB();
+    SCB->VTOR = (uint32_t)ram_vectors;
+    __DSB();
+    __ISB();
+#endif
+}
+
+/*!
+ * \brief Installs the handler of an interrupt
+ *
+ * Takes effect at the next entry of the interrupt, a handler that runs
+ * finishes. May be called from a task or a handler. Without
+ * IRQ_RAM_VECTORS nothing is installed.
+ *
+ * \param[in]  irq      IRQ number, 0 to 31
+ * \param[in]  handler  New handler, NULL for the one of the flash table
+ *
+ * \return The previous handler, NULL if nothing was installed
+ */
+irq_handler_t irq_register(const IRQn_Type irq, const irq_handler_t handler)
+{
+#if (IRQ_RAM_VECTORS == 1)
+    if((irq < 0) || ((16 + irq) >= VECTORS_COUNT))
+    {
+        return NULL;
+    }
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    const irq_handler_t old = ram_vectors[16 + irq];
+    ram_vectors[16 + irq] = (handler != NULL) ? handler : g_pfnVectors[16 + irq];
+
+    // Written before the interrupt can be taken
+    __DSB();
+    __set_PRIMASK(primask);
+
+    return old;
+#else
+    (void)irq;
+    (void)handler;
+
+    return NULL;
+#endif
+}
+
+/*!
+ * \brief Returns the handler of an interrupt
+ *
+ * \param[in]  irq  IRQ number, 0 to 31
+ *
+ * \return The installed handler, the one of the flash table without
+ *         IRQ_RAM_VECTORS, NULL for an invalid IRQ number
+ */
+irq_handler_t irq_handler(const IRQn_Type irq)
+{
+    if((irq < 0) || ((16 + irq) >= VECTORS_COUNT))
+    {
+        return NULL;
+    }
+
+#if (IRQ_RAM_VECTORS == 1)
+    return ram_vectors[16 + irq];
+#else
+    return g_pfnVectors[16 + irq];
+#endif
+}
@@ -0,0 +1,81 @@
+/*! ***************************************************************************
+ *
+ * \brief     Vector table in SRAM with handlers installed at run-time
+ * \file      vectors.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef VECTORS_H
+#define VECTORS_H
+
+#include <MKL25Z4.h>
+#include <stddef.h>
+
+/*!
+ * \brief Set to 1 to run from a copy of the vector table in SRAM
+ *
+ * ResetISR() copies the flash table g_pfnVectors to SRAM and points VTOR to
+ * the copy, before any interrupt is enabled. A driver then installs its
+ * handler with irq_register() instead of defining the symbol of the vector,
+ * so several drivers can be linked that use the same IRQ in different
+ * modes, and a driver can swap in a handler for the mode it runs in. An
+ * exception entry fetches its vector from SRAM without flash wait states.
+ * The copy takes VECTORS_COUNT words of SRAM.
+ */
+#ifndef IRQ_RAM_VECTORS
+#define IRQ_RAM_VECTORS (0)
+#endif
+
+/// Exceptions of the Cortex-M0+ and the 32 interrupts of the KL25Z
+#define VECTORS_COUNT   (16 + 32)
+
+/// Handler of an exception or interrupt
+typedef void (*irq_handler_t)(void);
+
+/*!
+ * \brief Defines the interrupt handler of a driver
+ *
+ * With IRQ_RAM_VECTORS a function with the given name, which the driver
+ * installs with IRQ_INSTALL(). Without it the handler is the symbol of the
+ * vector in the flash table, and IRQ_INSTALL() does nothing.
+ *
+ * \param[in]  vector  Symbol of the vector, e.g. TPM1_IRQHandler
+ * \param[in]  name    Name of the handler in the driver
+ */
+#if (IRQ_RAM_VECTORS == 1)
+#define IRQ_HANDLER(vector, name)   static void name(void)
+#define IRQ_INSTALL(irq, name)      ((void)irq_register((irq), (name)))
+#else
+#define IRQ_HANDLER(vector, name)   void vector(void)
+#define IRQ_INSTALL(irq, name)      ((void)0)
+#endif
+
+// Function prototypes
+void irq_vectors_init(void);
+irq_handler_t irq_register(const IRQn_Type irq, const irq_handler_t handler);
+irq_handler_t irq_handler(const IRQn_Type irq);
+
+#endif // VECTORS_H
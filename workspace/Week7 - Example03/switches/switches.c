@@ -30,11 +30,47 @@
  *
  *****************************************************************************/
 #include "switches.h"
+#include "gpio.h"
+#include "irq_prio.h"
+#include "mono.h"
+
+#include "timers.h"
 
 static PORT_Type * port_mapping[N_SWITCHES] = {PORTD, PORTD};
-static GPIO_Type * gpio_mapping[N_SWITCHES] = {PTD,   PTD};
+static gpio_t *    gpio_mapping[N_SWITCHES] = {GPIO_D, GPIO_D};
 static uint8_t     pin_mapping[N_SWITCHES]  = {3,     5};
 
+// PORT_PCR_IRQC value for an interrupt on either edge
+#define SW_IRQC_EITHER_EDGE (0b1011)
+
+// Queue that receives sw_event_t, NULL if the interrupt mode is not used
+static QueueHandle_t sw_queue = NULL;
+
+// Topic and pool of the published events, NULL if the bus is not used
+static bus_topic_t *sw_topic = NULL;
+static pool_t *sw_pool = NULL;
+
+// Event types that are sent, see SW_EVENT_MASK()
+static uint32_t sw_events = 0;
+
+/// State machine of a switch in interrupt mode
+typedef struct
+{
+    TimerHandle_t timer;    ///< Debounce, long press and repeat timeouts
+    StaticTimer_t timer_buffer;
+    bool pressed;           ///< Debounced state
+    bool repeating;         ///< SW_LONG was sent for this press
+    bool click;             ///< Last release ended a short press
+    TickType_t released;    ///< Tick of the last release
+    TickType_t due;         ///< Tick of the next SW_LONG or SW_REPEAT
+    volatile uint32_t edge; ///< mono_us32() of the first edge of a change
+}sw_state_t;
+
+static sw_state_t sw_states[N_SWITCHES];
+
+static void sw_start_irq(const uint32_t events);
+static void sw_timeout(TimerHandle_t timer);
+
 /*!
  * \brief Initialises the switches on the shield
  *
@@ -60,7 +96,7 @@ void sw_init(void)
     // Set port pins to inputs
     for(int i=0; i<N_SWITCHES; i++)
     {
-        gpio_mapping[i]->PDDR &= ~(1<<pin_mapping[i]);
+        gpio_input(gpio_mapping[i], 1UL << pin_mapping[i]);
     }
 }
 
@@ -78,5 +114,225 @@ void sw_init(void)
 bool sw_pressed(const sw_t sw)
 {
     // If the key is pressed, the bit at that position will read logic 0
-    return ((gpio_mapping[sw]->PDIR & (1<<pin_mapping[sw])) == 0);
+    return !gpio_read(gpio_mapping[sw], 1UL << pin_mapping[sw]);
+}
+
+/*!
+ * \brief Initialises the switches in interrupt driven mode
+ *
+ * The passive input filter is enabled and every edge of a switch pin
+ * interrupts. The interrupt masks the pin while it bounces and (re)starts the
+ * one-shot timer of the switch with SW_DEBOUNCE_MS. When it expires, the
+ * timer task enables the pin interrupt again and runs the state machine of
+ * the switch, which sends ::sw_event_t events:
+ *
+ * - ::SW_PRESS and ::SW_RELEASE for every debounced change
+ * - ::SW_DOUBLE after ::SW_PRESS, if a short press was released less than
+ *   SW_DOUBLE_MS ago
+ * - ::SW_LONG once the switch is held for SW_LONG_MS, and then ::SW_REPEAT
+ *   every SW_REPEAT_MS until it is released
+ *
+ * While a switch is held, the same timer runs until the next long press or
+ * repeat event. Nothing is polled. Only the types in events are sent, so a
+ * task only wakes for the events it handles. Events are dropped if the queue
+ * is full.
+ *
+ * sw_pressed() can still be used in this mode.
+ *
+ * \param[in]  queue   Queue with items of ::sw_event_t
+ * \param[in]  events  Event types to send, SW_EVENT_MASK() of each type or
+ *                     SW_EVENTS_ALL
+ */
+void sw_init_irq(QueueHandle_t queue, const uint32_t events)
+{
+    sw_queue = queue;
+
+    sw_start_irq(events);
+}
+
+/*!
+ * \brief Initialises the switches in interrupt driven mode on the bus
+ *
+ * Like sw_init_irq(), but every event is allocated as a message from pool
+ * and published to all subscribers of topic with bus_publish(). Events are
+ * dropped if the pool is empty.
+ *
+ * \param[in]  topic   Topic for messages with a payload of ::sw_event_t
+ * \param[in]  pool    Pool with blocks of MSG_BLOCK_SIZE(sizeof(sw_event_t))
+ * \param[in]  events  Event types to publish, SW_EVENT_MASK() of each type or
+ *                     SW_EVENTS_ALL
+ */
+void sw_init_bus(bus_topic_t *topic, pool_t *pool, const uint32_t events)
+{
+    sw_topic = topic;
+    sw_pool = pool;
+
+    sw_start_irq(events);
+}
+
+/*!
+ * \brief Starts the interrupt driven mode, see sw_init_irq()
+ */
+static void sw_start_irq(const uint32_t events)
+{
+    sw_init();
+
+    sw_events = events;
+
+    for(int i=0; i<N_SWITCHES; i++)
+    {
+        sw_state_t *state = &sw_states[i];
+
+        state->timer = xTimerCreateStatic("Sw", pdMS_TO_TICKS(SW_DEBOUNCE_MS),
+            pdFALSE, (void *)(uintptr_t)i, sw_timeout, &state->timer_buffer);
+        state->pressed = sw_pressed((sw_t)i);
+        state->repeating = false;
+        state->click = false;
+
+        // - PFE = 1 : Passive input filter is enabled
+        // - IRQC[3:0] = 1011 : Interrupt on either edge
+        // - ISF = 1 : Clear the interrupt flag
+        port_mapping[i]->PCR[pin_mapping[i]] |= PORT_PCR_PFE(1) |
+            PORT_PCR_IRQC(SW_IRQC_EITHER_EDGE) | PORT_PCR_ISF(1);
+    }
+
+    // Enable Interrupts
+    NVIC_SetPriority(PORTD_IRQn, IRQ_PRIO(SWITCHES));
+    NVIC_ClearPendingIRQ(PORTD_IRQn);
+    NVIC_EnableIRQ(PORTD_IRQn);
+}
+
+/*!
+ * \brief Sends an event if its type is selected
+ */
+static void sw_send(const sw_t sw, const sw_event_type_t type,
+    const uint32_t stamp)
+{
+    if(sw_events & SW_EVENT_MASK(type))
+    {
+        const sw_event_t event = {sw, type, stamp};
+
+        // The timer task must not block
+        if(sw_queue != NULL)
+        {
+            (void)xQueueSend(sw_queue, &event, 0);
+        }
+
+        if(sw_topic != NULL)
+        {
+            sw_event_t *msg = msg_alloc(sw_pool);
+
+            if(msg != NULL)
+            {
+                *msg = event;
+                (void)bus_publish(sw_topic, msg);
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Runs the state machine of a switch after a timeout
+ *
+ * Runs in the timer task, after the debounce time or at the tick of the next
+ * long press or repeat event. The pin interrupt is enabled before the pin is
+ * sampled, so an edge after the sample starts the debounce timer again.
+ */
+static void sw_timeout(TimerHandle_t timer)
+{
+    const sw_t sw = (sw_t)(uintptr_t)pvTimerGetTimerID(timer);
+    sw_state_t *state = &sw_states[sw];
+    const TickType_t now = xTaskGetTickCount();
+
+    taskENTER_CRITICAL();
+    {
+        const uint32_t pcr = port_mapping[sw]->PCR[pin_mapping[sw]];
+        port_mapping[sw]->PCR[pin_mapping[sw]] = (pcr & ~PORT_PCR_IRQC_MASK) |
+            PORT_PCR_IRQC(SW_IRQC_EITHER_EDGE) | PORT_PCR_ISF(1);
+    }
+    taskEXIT_CRITICAL();
+
+    const bool pressed = sw_pressed(sw);
+
+    if(pressed && !state->pressed)
+    {
+        state->pressed = true;
+        state->repeating = false;
+        state->due = now + pdMS_TO_TICKS(SW_LONG_MS);
+
+        sw_send(sw, SW_PRESS, state->edge);
+
+        if(state->click && ((now - state->released) < pdMS_TO_TICKS(SW_DOUBLE_MS)))
+        {
+            sw_send(sw, SW_DOUBLE, state->edge);
+        }
+
+        // A third press is not a double click again
+        state->click = false;
+    }
+    else if(!pressed && state->pressed)
+    {
+        state->pressed = false;
+        state->click = !state->repeating;
+        state->released = now;
+
+        sw_send(sw, SW_RELEASE, state->edge);
+    }
+    else if(state->pressed && ((TickType_t)(now - state->due) < (portMAX_DELAY / 2)))
+    {
+        // Held until due, or a bounce restarted the timer and it is due
+        // already
+        sw_send(sw, state->repeating ? SW_REPEAT : SW_LONG, mono_us32());
+
+        state->repeating = true;
+        state->due = now + pdMS_TO_TICKS(SW_REPEAT_MS);
+    }
+
+    // Wake again at the next long press or repeat event
+    if(state->pressed)
+    {
+        const TickType_t left = state->due - now;
+
+        (void)xTimerChangePeriod(timer, (left > 0) ? left : 1, 0);
+    }
+}
+
+/*!
+ * \brief Pin interrupt of the switches
+ *
+ * Masks the pins that interrupted until sw_timeout() has run and restarts
+ * their debounce timers.
+ */
+void PORTD_IRQHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    TRACE_ISR_ENTER();
+
+    NVIC_ClearPendingIRQ(PORTD_IRQn);
+
+    for(int i=0; i<N_SWITCHES; i++)
+    {
+        const uint32_t pcr = port_mapping[i]->PCR[pin_mapping[i]];
+
+        if(pcr & PORT_PCR_ISF_MASK)
+        {
+            // Clear the interrupt and ignore the bounces
+            port_mapping[i]->PCR[pin_mapping[i]] =
+                (pcr & ~PORT_PCR_IRQC_MASK) | PORT_PCR_ISF(1);
+
+            // The start of the input latency of the event
+            sw_states[i].edge = mono_us32();
+
+            if(sw_states[i].timer != NULL)
+            {
+                // Changing the period also starts the timer
+                (void)xTimerChangePeriodFromISR(sw_states[i].timer,
+                    pdMS_TO_TICKS(SW_DEBOUNCE_MS), &xHigherPriorityTaskWoken);
+            }
+        }
+    }
+
+    TRACE_ISR_EXIT();
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
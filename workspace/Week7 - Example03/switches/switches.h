@@ -35,9 +35,39 @@
 #include <MKL25Z4.h>
 #include <stdbool.h>
 
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#include "bus.h"
+
 /// The number of keys available on the shield
 #define N_SWITCHES (2)
 
+/// \name Timing of the switch events in ms
+/// \{
+
+/// Time a switch must be stable after an edge before it is reported
+#ifndef SW_DEBOUNCE_MS
+#define SW_DEBOUNCE_MS (10)
+#endif
+
+/// Time a switch is held before ::SW_LONG is sent
+#ifndef SW_LONG_MS
+#define SW_LONG_MS (800)
+#endif
+
+/// Time between ::SW_REPEAT events while a switch is held after ::SW_LONG
+#ifndef SW_REPEAT_MS
+#define SW_REPEAT_MS (200)
+#endif
+
+/// Maximum time from the release of a click to the next press for ::SW_DOUBLE
+#ifndef SW_DOUBLE_MS
+#define SW_DOUBLE_MS (300)
+#endif
+
+/// \}
+
 /// Defines the type for the keys
 typedef enum
 {
@@ -45,8 +75,34 @@ typedef enum
     SW2,
 } sw_t;
 
+/// Type of a switch event
+typedef enum
+{
+    SW_PRESS = 0, ///< Debounced press
+    SW_RELEASE,   ///< Debounced release
+    SW_LONG,      ///< Held for SW_LONG_MS
+    SW_DOUBLE,    ///< Pressed within SW_DOUBLE_MS after a click, follows SW_PRESS
+    SW_REPEAT,    ///< Every SW_REPEAT_MS while held after SW_LONG
+} sw_event_type_t;
+
+/// Mask of an event type, for the events argument of sw_init_irq()
+#define SW_EVENT_MASK(type) (1UL << (type))
+
+/// All event types
+#define SW_EVENTS_ALL (0x1F)
+
+/// Event sent to the queue given to sw_init_irq() or published by sw_init_bus()
+typedef struct
+{
+    sw_t sw;
+    sw_event_type_t type;
+    uint32_t stamp; ///< mono_us32() of the edge, or the timeout of a held switch
+} sw_event_t;
+
 // Function prototypes
 void sw_init(void);
+void sw_init_irq(QueueHandle_t queue, const uint32_t events);
+void sw_init_bus(bus_topic_t *topic, pool_t *pool, const uint32_t events);
 bool sw_pressed(const sw_t sw); 
 
 #endif // SWITCHES_H
@@ -0,0 +1,1178 @@
+/*! ***************************************************************************
+ *
+ * \brief     Streaming task list, run-time, stack and heap statistics
+ * \file      taskstats.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#define LOG_MODULE  TASKSTATS
+#define LOG_TAG     "Stack low: "
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "taskstats.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "kernel_memory.h"
+#include "periodic.h"
+#include "pool.h"
+#include "scratch.h"
+#include "serial.h"
+#include "wcet.h"
+#include "critmon.h"
+#include "clock.h"
+#include "crash.h"
+#include "i2c.h"
+#include "idle.h"
+#include "irq_prio.h"
+#include "log.h"
+#include "xprintf.h"
+#include "trace.h"
+#include "tlm_pack.h"
+
+// Time a row may wait for room in the serial transmit buffer
+#define TASKSTATS_BLOCK_TIME pdMS_TO_TICKS(100)
+
+typedef void (*taskstats_row_t)(char *line, const TaskStatus_t *status,
+    const configRUN_TIME_COUNTER_TYPE total);
+
+/*!
+ * \brief Heap blocks allocated and freed, sizes include the block header
+ */
+typedef struct
+{
+    uint32_t allocs;
+    uint32_t alloc_bytes;
+    uint32_t frees;
+    uint32_t free_bytes;
+}taskstats_heap_use_t;
+
+/*!
+ * \brief Stack and heap usage of a task
+ *
+ * Kept after the task is deleted, then task is NULL.
+ */
+typedef struct
+{
+    void *task;
+    char name[configMAX_TASK_NAME_LEN];
+    uint32_t depth;    ///< Stack size in words
+    uint32_t min_free; ///< Smallest sampled high water mark in words
+    bool warned;
+    taskstats_heap_use_t heap;
+}taskstats_task_t;
+
+static taskstats_task_t tasks[TASKSTATS_STACK_SLOTS];
+static uint32_t tasks_used = 0;
+
+// Heap use before the scheduler was started and by untracked tasks
+static taskstats_heap_use_t heap_startup;
+static taskstats_heap_use_t heap_other;
+
+// Allocated block sizes, bucket i counts blocks up to 16 << i bytes and the
+// last one all larger blocks
+static uint32_t heap_sizes[TASKSTATS_HEAP_BUCKETS];
+static uint32_t heap_failed = 0;
+
+#if (TASKSTATS_HEAP_TRACE > 0)
+/*!
+ * \brief A recorded heap operation, the size of a free is 0
+ */
+typedef struct
+{
+    const void *address;
+    uint32_t size;
+}taskstats_heap_op_t;
+
+// Successful allocations and frees in order, and the operations that did not
+// fit. The recorded ones do not change, so the report reads them as is.
+static taskstats_heap_op_t heap_ops[TASKSTATS_HEAP_TRACE];
+static uint32_t heap_ops_used = 0;
+static uint32_t heap_ops_lost = 0;
+#endif
+
+// Snapshot of all tasks, taken without allocating. Owned by one report or
+// sample at a time, see taskstats_snapshot_take().
+static TaskStatus_t snapshot[TASKSTATS_STACK_SLOTS];
+static bool snapshot_busy = false;
+
+#if (configCHECK_FOR_STACK_OVERFLOW > 0)
+/*!
+ * \brief Name of the task that overflowed its stack, for the debugger
+ */
+const char * volatile taskstats_overflowed = NULL;
+#endif
+
+/*!
+ * \brief Writes a single line to the serial port
+ *
+ * Blocks until the line fits, so a long report is not silently truncated by
+ * the drop policy of the port.
+ */
+static void taskstats_puts(const char *line)
+{
+    xSerialPutStringPolicy(line, eSerialBlock, TASKSTATS_BLOCK_TIME);
+}
+
+/*!
+ * \brief Takes a snapshot of all tasks into the static snapshot buffer
+ *
+ * The buffer is held until taskstats_snapshot_give(), so a report from the
+ * commands and a sample of the stack monitor cannot overwrite each
+ * other.
+ *
+ * \param[out]  total  Total run time, may be NULL
+ *
+ * \return Number of tasks in the snapshot, 0 if the buffer is in use or
+ *         there are more than TASKSTATS_STACK_SLOTS tasks
+ */
+static UBaseType_t taskstats_snapshot_take(configRUN_TIME_COUNTER_TYPE *total)
+{
+    bool busy;
+
+    taskENTER_CRITICAL();
+    {
+        busy = snapshot_busy;
+        snapshot_busy = true;
+    }
+    taskEXIT_CRITICAL();
+
+    if(busy)
+    {
+        return 0;
+    }
+
+    const UBaseType_t n = uxTaskGetSystemState(snapshot, TASKSTATS_STACK_SLOTS,
+        total);
+
+    if(n == 0)
+    {
+        snapshot_busy = false;
+    }
+
+    return n;
+}
+
+/*!
+ * \brief Releases the snapshot buffer
+ */
+static void taskstats_snapshot_give(void)
+{
+    snapshot_busy = false;
+}
+
+/*!
+ * \brief Takes a snapshot of all tasks and writes one row per task
+ *
+ * Unlike vTaskList() and vTaskGetRunTimeStats() the report is never held in
+ * RAM as a whole. Each row of the static TaskStatus_t snapshot is formatted
+ * into a single line buffer on the stack and written to the serial port
+ * before the next one is formatted.
+ *
+ * \param[in]  header  Text written before the first row
+ * \param[in]  row     Formats a single row into a TASKSTATS_LINE_LEN buffer
+ */
+static void taskstats_walk(const char *header, taskstats_row_t row)
+{
+    char line[TASKSTATS_LINE_LEN];
+    configRUN_TIME_COUNTER_TYPE total;
+    const UBaseType_t n = taskstats_snapshot_take(&total);
+
+    if(n == 0)
+    {
+        taskstats_puts("No room for task snapshot\r\n");
+        return;
+    }
+
+    taskstats_puts(header);
+
+    for(UBaseType_t i=0; i<n; i++)
+    {
+        row(line, &snapshot[i], total);
+        taskstats_puts(line);
+    }
+
+    taskstats_snapshot_give();
+}
+
+/*!
+ * \brief Formats a row in the layout of vTaskList()
+ */
+static void taskstats_list_row(char *line, const TaskStatus_t *status,
+    const configRUN_TIME_COUNTER_TYPE total)
+{
+    static const char states[] = {'X', 'R', 'B', 'S', 'D', '?'};
+    eTaskState state = status->eCurrentState;
+
+    (void)total;
+
+    if(state > eInvalid)
+    {
+        state = eInvalid;
+    }
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "%-*s %c %2lu %5u %3lu\r\n",
+        configMAX_TASK_NAME_LEN, status->pcTaskName, states[state],
+        (unsigned long)status->uxCurrentPriority,
+        (unsigned int)status->usStackHighWaterMark,
+        (unsigned long)status->xTaskNumber);
+}
+
+/*!
+ * \brief Formats a row in the layout of vTaskGetRunTimeStats()
+ */
+static void taskstats_runtime_row(char *line, const TaskStatus_t *status,
+    const configRUN_TIME_COUNTER_TYPE total)
+{
+    uint32_t percent = (total / 100) ? (status->ulRunTimeCounter / (total / 100)) : 0;
+
+    // Run time in ticks of rtsTICK_US, whatever the counter counts
+    const unsigned long ticks = (unsigned long)(status->ulRunTimeCounter /
+        rtsCOUNTS_PER_TICK);
+
+    if(percent > 0)
+    {
+        xsnprintf(line, TASKSTATS_LINE_LEN, "%-*s %10lu %3lu%%\r\n",
+            configMAX_TASK_NAME_LEN, status->pcTaskName,
+            ticks, (unsigned long)percent);
+    }
+    else
+    {
+        xsnprintf(line, TASKSTATS_LINE_LEN, "%-*s %10lu  <1%%\r\n",
+            configMAX_TASK_NAME_LEN, status->pcTaskName,
+            ticks);
+    }
+}
+
+#if (TRACE_IRQ_STATS == 1)
+/*!
+ * \brief Writes the statistics of one series of interrupt times
+ *
+ * The row is marked "over" if the longest time exceeds the budget, a budget
+ * of 0 is not checked.
+ */
+static void taskstats_irq_row(const char *name, const trace_time_stats_t *t,
+    const uint32_t budget_us)
+{
+    char line[TASKSTATS_LINE_LEN];
+
+    if(t->count == 0)
+    {
+        return;
+    }
+
+    // Times in microseconds, at 24 bus clock cycles per microsecond
+    const uint32_t max_us = t->max / 24;
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "  %-3s %8lu %6lu %6lu %6lu%s\r\n", name,
+        (unsigned long)t->count, (unsigned long)(t->min / 24),
+        (unsigned long)((t->sum / t->count) / 24),
+        (unsigned long)max_us,
+        ((budget_us > 0) && (max_us > budget_us)) ? " over" : "");
+    taskstats_puts(line);
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "     %u %u %u %u %u %u %u %u\r\n",
+        t->histogram[0], t->histogram[1], t->histogram[2], t->histogram[3],
+        t->histogram[4], t->histogram[5], t->histogram[6], t->histogram[7]);
+    taskstats_puts(line);
+}
+#endif
+
+/*!
+ * \brief Writes the interrupt statistics to the serial port and clears them
+ *
+ * For every measured IRQ the handler duration (run) and, for timer
+ * interrupts, the entry latency (lat), each as count, min, avg and max in
+ * microseconds. The next line is the histogram of the times below 1, 2, 4
+ * ... 64 us and of the longer ones. Every IRQ is listed with its priority
+ * level and the budgets of irq_prio.h, the run budget of its source and the
+ * latency budget of the level, a row that exceeds its budget is marked.
+ * Requires TRACE_IRQ_STATS.
+ */
+void taskstats_irq(void)
+{
+#if (TRACE_IRQ_STATS == 0)
+    taskstats_puts("\r\nIRQ statistics disabled\r\n");
+#else
+    char line[TASKSTATS_LINE_LEN];
+    trace_irq_stats_t stats;
+    uint32_t i = 0;
+
+    taskstats_puts("\r\nIRQ    Count    Min    Avg    Max us\r\n");
+
+    while(trace_irq_get(i++, &stats))
+    {
+        const uint32_t prio = NVIC_GetPriority((IRQn_Type)stats.irq);
+        const uint32_t run_us = irq_run_budget_us(stats.irq, prio);
+        const uint32_t lat_us = irq_latency_budget_us(IRQ_LEVEL_OF(prio));
+
+        if(run_us > 0)
+        {
+            xsnprintf(line, TASKSTATS_LINE_LEN, "%d level %lu budget %lu %lu\r\n",
+                stats.irq, (unsigned long)IRQ_LEVEL_OF(prio),
+                (unsigned long)run_us, (unsigned long)lat_us);
+        }
+        else
+        {
+            // A priority that is not in IRQ_PRIO_TABLE
+            xsnprintf(line, TASKSTATS_LINE_LEN, "%d level %lu budget - %lu\r\n",
+                stats.irq, (unsigned long)IRQ_LEVEL_OF(prio),
+                (unsigned long)lat_us);
+        }
+        taskstats_puts(line);
+
+        taskstats_irq_row("run", &stats.duration, run_us);
+        taskstats_irq_row("lat", &stats.latency, lat_us);
+    }
+
+    trace_irq_reset();
+#endif
+}
+
+/*!
+ * \brief Writes the contention profile of the registered queues to the
+ *        serial port and clears it
+ *
+ * Columns are name, number of sends and receives that blocked, number of
+ * those that timed out, longest and average blocked time in microseconds
+ * and the peak fill level against the length. Requires TRACE_QUEUE_STATS.
+ */
+void taskstats_queues(void)
+{
+#if (TRACE_QUEUE_STATS == 0)
+    taskstats_puts("\r\nQueue statistics disabled\r\n");
+#else
+    char line[TASKSTATS_LINE_LEN];
+    trace_queue_stats_t q;
+    uint32_t i = 0;
+
+    taskstats_puts("\r\nName          Sends  Recvs  Tmo   Max us   Avg us Peak\r\n");
+
+    while(trace_queue_get(i++, &q))
+    {
+        const uint32_t blocks = q.blocked_sends + q.blocked_receives;
+        const uint64_t avg = (blocks > 0) ? (q.sum_blocked / blocks) : 0;
+
+        xsnprintf(line, TASKSTATS_LINE_LEN, "%-*s %6lu %6lu %4lu %8lu %8lu %2u/%u\r\n",
+            configMAX_TASK_NAME_LEN, q.name,
+            (unsigned long)q.blocked_sends, (unsigned long)q.blocked_receives,
+            (unsigned long)q.timeouts,
+            (unsigned long)(((uint64_t)q.max_blocked * 1000000) / TRACE_HZ),
+            (unsigned long)((avg * 1000000) / TRACE_HZ),
+            q.peak, q.length);
+        taskstats_puts(line);
+    }
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "Timer queue full %lu\r\n",
+        (unsigned long)uxTimerGetQueueFullCount());
+    taskstats_puts(line);
+
+    trace_queue_reset();
+#endif
+}
+
+/*!
+ * \brief Writes the deadline statistics of the periodic tasks to the serial
+ *        port and clears them
+ *
+ * Columns are name, period in ms, completed cycles, cycles that overran
+ * their deadline, the latest start after a release in ms and the largest
+ * release jitter in microseconds. The next line is the histogram of the
+ * jitter below PERIODIC_JITTER_US, twice that ... and of the larger ones.
+ */
+void taskstats_periodic(void)
+{
+    char line[TASKSTATS_LINE_LEN];
+    periodic_t p;
+    uint32_t i = 0;
+
+    taskstats_puts("\r\nName         Period  Cycles  Over Late ms Jit us\r\n");
+
+    while(periodic_get(i++, &p))
+    {
+        xsnprintf(line, TASKSTATS_LINE_LEN, "%-*s %6lu %7lu %5lu %7lu %6lu\r\n",
+            configMAX_TASK_NAME_LEN, p.name,
+            (unsigned long)(p.period * portTICK_PERIOD_MS),
+            (unsigned long)p.cycles, (unsigned long)p.overruns,
+            (unsigned long)(p.max_late * portTICK_PERIOD_MS),
+            (unsigned long)p.max_jitter_us);
+        taskstats_puts(line);
+
+        xsnprintf(line, TASKSTATS_LINE_LEN, "     %u %u %u %u %u %u %u %u\r\n",
+            p.jitter[0], p.jitter[1], p.jitter[2], p.jitter[3],
+            p.jitter[4], p.jitter[5], p.jitter[6], p.jitter[7]);
+        taskstats_puts(line);
+    }
+
+    periodic_reset();
+}
+
+/*!
+ * \brief Writes the execution times of the profiled jobs to the serial port
+ *        and clears them
+ *
+ * Columns are name, completed jobs and the minimum, mean, 99th percentile and
+ * maximum execution time in microseconds. The percentile is the estimate of
+ * wcet_percentile().
+ */
+void taskstats_wcet(void)
+{
+    char line[TASKSTATS_LINE_LEN];
+    wcet_t w;
+    uint32_t i = 0;
+
+    taskstats_puts("\r\nName           Jobs  Min us Mean us  P99 us  Max us\r\n");
+
+    while(wcet_get(i++, &w))
+    {
+        const uint32_t mean = (w.jobs > 0) ? (uint32_t)(w.total_us / w.jobs) : 0;
+
+        xsnprintf(line, TASKSTATS_LINE_LEN, "%-*s %6lu %7lu %7lu %7lu %7lu\r\n",
+            configMAX_TASK_NAME_LEN, w.name, (unsigned long)w.jobs,
+            (unsigned long)((w.jobs > 0) ? w.min_us : 0), (unsigned long)mean,
+            (unsigned long)wcet_percentile(&w, 99), (unsigned long)w.max_us);
+        taskstats_puts(line);
+    }
+
+    wcet_reset();
+}
+
+/*!
+ * \brief Writes the longest sections with interrupts masked to the serial
+ *        port and clears them
+ *
+ * Columns are the call site, the number of sections and the longest section
+ * in bus clock cycles and in microseconds at the current bus clock. The
+ * first line holds the totals of all sections. Empty without CRITMON_ENABLED.
+ */
+void taskstats_critical(void)
+{
+    char line[TASKSTATS_LINE_LEN];
+    const uint32_t mhz = clk_bus_hz() / 1000000UL;
+    critmon_total_t total;
+    critmon_site_t site;
+    uint32_t i = 0;
+
+    critmon_get_total(&total);
+
+    xsnprintf(line, TASKSTATS_LINE_LEN,
+        "\r\nMasked %lu, mean %lu cycles, max %lu cycles, evicted %lu\r\n",
+        (unsigned long)total.count,
+        (unsigned long)((total.count > 0) ? (total.total_cycles / total.count) : 0),
+        (unsigned long)total.max_cycles, (unsigned long)total.evicted);
+    taskstats_puts(line);
+
+    taskstats_puts("Caller        Count  Max cyc   Max us\r\n");
+
+    while(critmon_get(i++, &site))
+    {
+        if(site.caller == NULL)
+        {
+            continue;
+        }
+
+        xsnprintf(line, TASKSTATS_LINE_LEN, "0x%08lx %8lu %8lu %8lu\r\n",
+            (unsigned long)(uintptr_t)site.caller, (unsigned long)site.count,
+            (unsigned long)site.max_cycles,
+            (unsigned long)((mhz > 0) ? (site.max_cycles / mhz) : 0));
+        taskstats_puts(line);
+    }
+
+    critmon_reset();
+}
+
+/*!
+ * \brief Writes the drop and error counters of the default serial port and
+ *        clears them
+ *
+ * The first line holds the bytes dropped on a full transmit and receive
+ * buffer and the peak fill levels, the second the receive errors of the
+ * UART: overruns, framing, noise and parity errors, see SerialStats_t.
+ * With TLM_PACK the last line holds the packed telemetry samples, the
+ * bytes of their records against those of one record per sample and the
+ * compression ratio.
+ */
+void taskstats_serial(void)
+{
+    char line[TASKSTATS_LINE_LEN];
+    SerialStats_t stats;
+
+    vSerialGetStats(&stats);
+    vSerialResetStats();
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "\r\nSerial %lu baud, drop tx %lu rx %lu\r\n",
+        (unsigned long)ulSerialGetBaud(), (unsigned long)stats.ulTxBytesDropped,
+        (unsigned long)stats.ulRxBytesDropped);
+    taskstats_puts(line);
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "Peak tx %lu rx %lu, frames dropped %lu\r\n",
+        (unsigned long)stats.xTxHighWaterMark, (unsigned long)stats.xRxHighWaterMark,
+        (unsigned long)stats.ulRxFramesDropped);
+    taskstats_puts(line);
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "Overrun %lu framing %lu noise %lu parity %lu\r\n",
+        (unsigned long)stats.ulRxOverruns, (unsigned long)stats.ulRxFramingErrors,
+        (unsigned long)stats.ulRxNoiseErrors, (unsigned long)stats.ulRxParityErrors);
+    taskstats_puts(line);
+
+#if (TLM_PACK == 1)
+    tlm_pack_stats_t pack;
+
+    tlm_get_pack_stats(&pack);
+
+    const uint32_t ratio = (pack.packed_bytes > 0) ?
+        (uint32_t)(((uint64_t)pack.raw_bytes * 100) / pack.packed_bytes) : 0;
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "Packed %lu samples, %lu of %lu B, %lu.%02lux\r\n",
+        (unsigned long)pack.samples, (unsigned long)pack.packed_bytes,
+        (unsigned long)pack.raw_bytes, (unsigned long)(ratio / 100),
+        (unsigned long)(ratio % 100));
+    taskstats_puts(line);
+#endif
+}
+
+/*!
+ * \brief Writes the transfer metrics of one I2C bus and clears them
+ *
+ * The first line holds the achieved bit rate and the share of the time the
+ * bus was busy. For every slave address (write) the columns are transfers,
+ * bytes of the completed transfers, NACKs, lost arbitrations, timeouts and
+ * the mean and longest time on the bus in microseconds. The next line holds
+ * the mean and longest time in the queue, the line after it the histogram
+ * of the times on the bus below I2C_METRICS_BUCKET_US, twice that ... and of
+ * the longer ones.
+ */
+static void taskstats_i2c_bus(const char *name, i2c_bus_t *bus)
+{
+    char line[TASKSTATS_LINE_LEN];
+    i2c_device_stats_t d;
+    uint32_t i = 0;
+
+    const uint32_t busy = i2c_get_utilisation(bus);
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "\r\n%s %lu bps, busy %lu.%lu%%\r\n",
+        name, (unsigned long)i2c_get_speed(bus),
+        (unsigned long)(busy / 10), (unsigned long)(busy % 10));
+    taskstats_puts(line);
+
+    taskstats_puts("Addr  Xfers    Bytes Nack Arb  Tmo  Avg us  Max us\r\n");
+
+    while(i2c_get_device_stats(bus, i++, &d))
+    {
+        const uint64_t n = (d.transfers > 0) ? d.transfers : 1;
+
+        xsnprintf(line, TASKSTATS_LINE_LEN, "0x%02x %6lu %8lu %4lu %3lu %4lu %7lu %7lu\r\n",
+            d.address, (unsigned long)d.transfers, (unsigned long)d.bytes,
+            (unsigned long)d.nacks, (unsigned long)d.arbitration,
+            (unsigned long)d.timeouts,
+            (unsigned long)((d.busy / n) / I2C_METRICS_CYCLES_PER_US),
+            (unsigned long)(d.busy_max / I2C_METRICS_CYCLES_PER_US));
+        taskstats_puts(line);
+
+        xsnprintf(line, TASKSTATS_LINE_LEN, "  wait %7lu %7lu\r\n",
+            (unsigned long)((d.wait / n) / I2C_METRICS_CYCLES_PER_US),
+            (unsigned long)(d.wait_max / I2C_METRICS_CYCLES_PER_US));
+        taskstats_puts(line);
+
+        xsnprintf(line, TASKSTATS_LINE_LEN, "     %u %u %u %u %u %u %u %u\r\n",
+            d.histogram[0], d.histogram[1], d.histogram[2], d.histogram[3],
+            d.histogram[4], d.histogram[5], d.histogram[6], d.histogram[7]);
+        taskstats_puts(line);
+    }
+
+    i2c_reset_device_stats(bus);
+}
+
+/*!
+ * \brief Writes the transfer metrics of both I2C buses to the serial port
+ *        and clears them, see taskstats_i2c_bus(). Requires I2C_METRICS.
+ */
+void taskstats_i2c(void)
+{
+#if (I2C_METRICS == 0)
+    taskstats_puts("\r\nI2C metrics disabled\r\n");
+#else
+    taskstats_i2c_bus("I2C0", &i2c_bus0);
+    taskstats_i2c_bus("I2C1", &i2c_bus1);
+#endif
+}
+
+/*!
+ * \brief Records a created task, called by the traceTASK_CREATE() hook
+ *
+ * Called inside a critical section of the kernel, also before the scheduler
+ * is started. A task created at the address of a deleted one replaces its
+ * handle, so the deleted task keeps its entry.
+ *
+ * \param[in]  task   Handle of the task
+ * \param[in]  name   Name of the task
+ * \param[in]  depth  Stack size in words
+ */
+void taskstats_stack_created(void *task, const char *name, const uint32_t depth)
+{
+    for(uint32_t i=0; i<tasks_used; i++)
+    {
+        if(tasks[i].task == task)
+        {
+            tasks[i].task = NULL;
+        }
+    }
+
+    if(tasks_used >= TASKSTATS_STACK_SLOTS)
+    {
+        return;
+    }
+
+    taskstats_task_t *st = &tasks[tasks_used++];
+
+    st->task = task;
+    strncpy(st->name, name, configMAX_TASK_NAME_LEN - 1);
+    st->depth = depth;
+    st->min_free = depth;
+    st->warned = false;
+}
+
+/*!
+ * \brief Samples the stack high water mark of all tasks
+ *
+ * The high water mark is the least free stack since the task was created,
+ * sampling keeps it after the task is deleted.
+ *
+ * A task without any free stack has written its lowest word, the canary of
+ * configCHECK_FOR_STACK_OVERFLOW 3, and is reported as an overflow. The
+ * context switch would find it at the next switch as well, unless the
+ * task does not run again.
+ */
+void taskstats_stack_sample(void)
+{
+    const UBaseType_t n = taskstats_snapshot_take(NULL);
+    const TaskStatus_t *status = snapshot;
+    taskstats_task_t *overflowed = NULL;
+
+    if(n == 0)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        for(UBaseType_t i=0; i<n; i++)
+        {
+            for(uint32_t j=0; j<tasks_used; j++)
+            {
+                if(tasks[j].task != status[i].xHandle)
+                {
+                    continue;
+                }
+
+                if(status[i].usStackHighWaterMark < tasks[j].min_free)
+                {
+                    tasks[j].min_free = status[i].usStackHighWaterMark;
+                }
+
+                if(status[i].usStackHighWaterMark == 0)
+                {
+                    overflowed = &tasks[j];
+                }
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    taskstats_snapshot_give();
+
+#if (configCHECK_FOR_STACK_OVERFLOW > 0)
+    if(overflowed != NULL)
+    {
+        vApplicationStackOverflowHook((TaskHandle_t)overflowed->task,
+            overflowed->name);
+    }
+#else
+    (void)overflowed;
+#endif
+}
+
+/*!
+ * \brief Writes the stack usage of all tasks to the serial port
+ *
+ * Columns are name, stack size, least free stack and deepest use in words
+ * and the recommended size: the deepest use plus TASKSTATS_STACK_MARGIN
+ * percent, rounded up to 8 words. Deleted tasks are marked with a '*'. The
+ * report is as good as the coverage of the run, so exercise every code path
+ * before shrinking a stack.
+ */
+void taskstats_stack(void)
+{
+    char line[TASKSTATS_LINE_LEN];
+
+    taskstats_stack_sample();
+
+    taskstats_puts("\r\nName          Size Free Used  Rec\r\n");
+
+    for(uint32_t i=0; i<tasks_used; i++)
+    {
+        const taskstats_task_t *st = &tasks[i];
+        const uint32_t used = st->depth - st->min_free;
+        const uint32_t rec = ((used + (used * TASKSTATS_STACK_MARGIN) / 100) + 7) & ~7UL;
+
+        xsnprintf(line, TASKSTATS_LINE_LEN, "%-*s%c %4lu %4lu %4lu %4lu\r\n",
+            configMAX_TASK_NAME_LEN, st->name, (st->task == NULL) ? '*' : ' ',
+            (unsigned long)st->depth, (unsigned long)st->min_free,
+            (unsigned long)used, (unsigned long)rec);
+        taskstats_puts(line);
+    }
+}
+
+/*!
+ * \brief Step of the stack monitor, an idle job
+ *
+ * Samples the tasks and logs a warning once for every task with less than
+ * TASKSTATS_STACK_LOW words of free stack. The sample is a single step, it
+ * is skipped if a report holds the snapshot.
+ */
+static bool taskstats_stack_step(void *arg)
+{
+    (void)arg;
+
+    taskstats_stack_sample();
+
+    for(uint32_t i=0; i<tasks_used; i++)
+    {
+        taskstats_task_t *st = &tasks[i];
+
+        if(!st->warned && (st->min_free < TASKSTATS_STACK_LOW))
+        {
+            st->warned = true;
+
+            LOG_WARN("%s %u words\r\n", st->name, st->min_free);
+        }
+    }
+
+    return false;
+}
+
+static idle_job_t stack_job = IDLE_JOB(taskstats_stack_step, NULL, "Stacks");
+
+/*!
+ * \brief Submits the stack monitor, timer callback
+ */
+static void taskstats_stack_timer(TimerHandle_t timer)
+{
+    (void)timer;
+
+    (void)idle_submit(&stack_job);
+}
+
+/*!
+ * \brief Starts the stack monitor, which samples the tasks every
+ *        TASKSTATS_STACK_PERIOD_MS
+ *
+ * The sample is a job of the idle task, so the monitor takes no stack of
+ * its own and only runs when no task wants to. Without the monitor the
+ * tasks are sampled by the 's' command.
+ */
+void taskstats_stack_monitor(void)
+{
+    static StaticTimer_t timer_buffer;
+
+    TimerHandle_t timer = xTimerCreateStatic("Stacks",
+        pdMS_TO_TICKS(TASKSTATS_STACK_PERIOD_MS), pdTRUE, NULL,
+        taskstats_stack_timer, &timer_buffer);
+
+    configASSERT(timer != NULL);
+
+    (void)xTimerStart(timer, 0);
+}
+
+/*!
+ * \brief Finds the heap use record of the running task
+ */
+static taskstats_heap_use_t *taskstats_heap_use(void)
+{
+    if(xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED)
+    {
+        return &heap_startup;
+    }
+
+    void *task = xTaskGetCurrentTaskHandle();
+
+    for(uint32_t i=0; i<tasks_used; i++)
+    {
+        if(tasks[i].task == task)
+        {
+            return &tasks[i].heap;
+        }
+    }
+
+    return &heap_other;
+}
+
+/*!
+ * \brief Appends an operation to the heap trace, with the scheduler suspended
+ */
+static void taskstats_heap_record(const void *address, const uint32_t size)
+{
+#if (TASKSTATS_HEAP_TRACE > 0)
+    if(heap_ops_used < TASKSTATS_HEAP_TRACE)
+    {
+        heap_ops[heap_ops_used].address = address;
+        heap_ops[heap_ops_used].size = size;
+        heap_ops_used++;
+    }
+    else
+    {
+        heap_ops_lost++;
+    }
+#else
+    (void)address;
+    (void)size;
+#endif
+}
+
+/*!
+ * \brief Records an allocation, called by the traceMALLOC() hook
+ *
+ * Called by heap_4 with the scheduler suspended.
+ *
+ * \param[in]  address  Allocated memory, NULL if the allocation failed
+ * \param[in]  size     Block size in bytes, including the block header
+ */
+void taskstats_malloc(const void *address, const uint32_t size)
+{
+    uint32_t bucket = 0;
+
+    if(address == NULL)
+    {
+        heap_failed++;
+        return;
+    }
+
+    taskstats_heap_use_t *use = taskstats_heap_use();
+
+    use->allocs++;
+    use->alloc_bytes += size;
+
+    while((bucket < (TASKSTATS_HEAP_BUCKETS - 1)) && (size > (16UL << bucket)))
+    {
+        bucket++;
+    }
+
+    heap_sizes[bucket]++;
+
+    taskstats_heap_record(address, size);
+}
+
+/*!
+ * \brief Records a free, called by the traceFREE() hook
+ *
+ * A block is counted for the task that frees it, which is not necessarily
+ * the task that allocated it.
+ *
+ * \param[in]  address  Freed memory
+ * \param[in]  size     Block size in bytes, including the block header
+ */
+void taskstats_free(const void *address, const uint32_t size)
+{
+    taskstats_heap_use_t *use = taskstats_heap_use();
+
+    use->frees++;
+    use->free_bytes += size;
+
+    taskstats_heap_record(address, 0);
+}
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+/*!
+ * \brief Formats a row of heap use
+ */
+static void taskstats_heap_row(const char *name, const char mark,
+    const taskstats_heap_use_t *use)
+{
+    char line[TASKSTATS_LINE_LEN];
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "%-*s%c %5lu %6lu %5lu %6lu\r\n",
+        configMAX_TASK_NAME_LEN, name, mark,
+        (unsigned long)use->allocs, (unsigned long)use->alloc_bytes,
+        (unsigned long)use->frees, (unsigned long)use->free_bytes);
+    taskstats_puts(line);
+}
+
+#if (TASKSTATS_HEAP_TRACE > 0)
+/*!
+ * \brief Writes the recorded heap operations to the serial port
+ *
+ * Between "Heap trace <n> ops" and "end", an allocation as "a <address>
+ * <block size>" and a free as "f <address>". tools/heap_trace.py converts a
+ * capture for bench/heap_bench.c.
+ */
+static void taskstats_heap_trace(void)
+{
+    char line[TASKSTATS_LINE_LEN];
+    uint32_t used;
+    uint32_t lost;
+
+    vTaskSuspendAll();
+    {
+        used = heap_ops_used;
+        lost = heap_ops_lost;
+    }
+    (void)xTaskResumeAll();
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "Heap trace %lu ops, %lu lost\r\n",
+        (unsigned long)used, (unsigned long)lost);
+    taskstats_puts(line);
+
+    for(uint32_t i=0; i<used; i++)
+    {
+        if(heap_ops[i].size > 0)
+        {
+            xsnprintf(line, TASKSTATS_LINE_LEN, "a %08lX %lu\r\n",
+                (unsigned long)(uintptr_t)heap_ops[i].address,
+                (unsigned long)heap_ops[i].size);
+        }
+        else
+        {
+            xsnprintf(line, TASKSTATS_LINE_LEN, "f %08lX\r\n",
+                (unsigned long)(uintptr_t)heap_ops[i].address);
+        }
+        taskstats_puts(line);
+    }
+
+    taskstats_puts("end\r\n");
+}
+#endif
+#endif
+
+/*!
+ * \brief Writes the usage of the block pools and the scratch arena to the
+ *        serial port
+ */
+static void taskstats_pools(void)
+{
+    char line[TASKSTATS_LINE_LEN];
+    pool_stats_t stats;
+    scratch_stats_t scratch;
+
+    taskstats_puts("Pool         Size  Num Used Peak Fail\r\n");
+
+    for(const pool_t *pool = pool_next(NULL); pool != NULL;
+        pool = pool_next(pool))
+    {
+        pool_stats(pool, &stats);
+
+        xsnprintf(line, TASKSTATS_LINE_LEN, "%-*s %4lu %4lu %4lu %4lu %4lu\r\n",
+            configMAX_TASK_NAME_LEN, pool->name,
+            (unsigned long)stats.block_size, (unsigned long)stats.count,
+            (unsigned long)stats.used, (unsigned long)stats.peak,
+            (unsigned long)stats.failures);
+        taskstats_puts(line);
+    }
+
+    // The scratch arena in bytes, Num is the number of blocks in it
+    scratch_get_stats(&scratch);
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "%-*s %4lu %4lu %4lu %4lu %4lu\r\n",
+        configMAX_TASK_NAME_LEN, "Scratch",
+        (unsigned long)scratch.size, (unsigned long)scratch.blocks,
+        (unsigned long)scratch.used, (unsigned long)scratch.peak,
+        (unsigned long)scratch.failures);
+    taskstats_puts(line);
+}
+
+/*!
+ * \brief Writes the heap statistics to the serial port
+ *
+ * Free space, least free space ever, the largest free block and the
+ * fragmentation: the share of the free space that is not in the largest
+ * block. Then the histogram of allocated block sizes and the allocations
+ * and frees per task, and the heap trace with TASKSTATS_HEAP_TRACE. Last
+ * the usage of the block pools.
+ */
+void taskstats_heap(void)
+{
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    char line[TASKSTATS_LINE_LEN];
+    HeapStats_t stats;
+    uint32_t sizes[TASKSTATS_HEAP_BUCKETS];
+    uint32_t frag = 0;
+
+    vPortGetHeapStats(&stats);
+
+    vTaskSuspendAll();
+    {
+        memcpy(sizes, heap_sizes, sizeof(sizes));
+    }
+    (void)xTaskResumeAll();
+
+    if(stats.xAvailableHeapSpaceInBytes > 0)
+    {
+        frag = 100 - (stats.xSizeOfLargestFreeBlockInBytes * 100) /
+            stats.xAvailableHeapSpaceInBytes;
+    }
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "\r\nHeap %lu of %lu free, min %lu\r\n",
+        (unsigned long)stats.xAvailableHeapSpaceInBytes,
+        (unsigned long)heap_size(),
+        (unsigned long)stats.xMinimumEverFreeBytesRemaining);
+    taskstats_puts(line);
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "Largest %lu, %lu blocks, frag %lu%%\r\n",
+        (unsigned long)stats.xSizeOfLargestFreeBlockInBytes,
+        (unsigned long)stats.xNumberOfFreeBlocks, (unsigned long)frag);
+    taskstats_puts(line);
+
+    xsnprintf(line, TASKSTATS_LINE_LEN, "Allocs %lu, frees %lu, failed %lu\r\n",
+        (unsigned long)stats.xNumberOfSuccessfulAllocations,
+        (unsigned long)stats.xNumberOfSuccessfulFrees,
+        (unsigned long)heap_failed);
+    taskstats_puts(line);
+
+    taskstats_puts("  <=16   32   64  128  256  512 1024 more\r\n");
+    xsnprintf(line, TASKSTATS_LINE_LEN, "%6lu %4lu %4lu %4lu %4lu %4lu %4lu %4lu\r\n",
+        (unsigned long)sizes[0], (unsigned long)sizes[1],
+        (unsigned long)sizes[2], (unsigned long)sizes[3],
+        (unsigned long)sizes[4], (unsigned long)sizes[5],
+        (unsigned long)sizes[6], (unsigned long)sizes[7]);
+    taskstats_puts(line);
+
+    taskstats_puts("Name         Alloc  Bytes  Free  Bytes\r\n");
+
+    taskstats_heap_row("(startup)", ' ', &heap_startup);
+
+    for(uint32_t i=0; i<tasks_used; i++)
+    {
+        taskstats_heap_row(tasks[i].name, (tasks[i].task == NULL) ? '*' : ' ',
+            &tasks[i].heap);
+    }
+
+    taskstats_heap_row("(other)", ' ', &heap_other);
+
+#if (TASKSTATS_HEAP_TRACE > 0)
+    taskstats_heap_trace();
+#endif
+#else
+    taskstats_puts("\r\nNo heap, all kernel objects are static\r\n");
+#endif
+
+    taskstats_pools();
+}
+
+#if (configCHECK_FOR_STACK_OVERFLOW > 0)
+/*!
+ * \brief Called by the kernel or by taskstats_stack_sample() when a task
+ *        has overflowed its stack
+ *
+ * Memory next to the stack may already be corrupted, so nothing is written
+ * to the serial port. Halts with the name in taskstats_overflowed, or
+ * resets with the task and its registers in the crash record with
+ * CRASH_ENABLED.
+ */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+    taskDISABLE_INTERRUPTS();
+    taskstats_overflowed = pcTaskName;
+    crash_stack_overflow(pcTaskName, xTask);
+
+    for( ;; );
+}
+#endif
+
+/*!
+ * \brief Writes the task list to the serial port
+ *
+ * Columns are name, state (X running, R ready, B blocked, S suspended,
+ * D deleted), priority, stack high water mark in words and task number.
+ */
+void taskstats_list(void)
+{
+    taskstats_walk("\r\nName         S Pr Stack Num\r\n", taskstats_list_row);
+}
+
+/*!
+ * \brief Writes the run-time statistics to the serial port
+ *
+ * Columns are name, run time in ticks of rtsTICK_US microseconds and the share
+ * of the total run time.
+ */
+void taskstats_runtime(void)
+{
+    taskstats_walk("\r\nName               Ticks  CPU\r\n", taskstats_runtime_row);
+}
+
+/*!
+ * \brief Handles a single character serial command
+ *
+ * 'l' writes the task list, 'r' writes the run-time statistics, 'i' writes
+ * the interrupt statistics, 's' writes the stack usage, 'h' writes the heap
+ * statistics, 'q' writes the queue contention, 'p' writes the deadline
+ * statistics of the periodic tasks, 'w' writes the execution times of the
+ * profiled jobs, 'k' writes the longest sections with interrupts masked,
+ * 'x' writes the I2C transfer metrics, 'g' writes the serial port drops and
+ * receive errors. Other characters are ignored.
+ */
+void taskstats_command(const char c)
+{
+    switch(c)
+    {
+    case 'l':
+        taskstats_list();
+        break;
+    case 'r':
+        taskstats_runtime();
+        break;
+    case 'i':
+        taskstats_irq();
+        break;
+    case 's':
+        taskstats_stack();
+        break;
+    case 'h':
+        taskstats_heap();
+        break;
+    case 'q':
+        taskstats_queues();
+        break;
+    case 'p':
+        taskstats_periodic();
+        break;
+    case 'w':
+        taskstats_wcet();
+        break;
+    case 'k':
+        taskstats_critical();
+        break;
+    case 'x':
+        taskstats_i2c();
+        break;
+    case 'g':
+        taskstats_serial();
+        break;
+    default:
+        break;
+    }
+}
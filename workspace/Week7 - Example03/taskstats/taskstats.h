@@ -0,0 +1,93 @@
+/*! ***************************************************************************
+ *
+ * \brief     Streaming task list, run-time, stack and heap statistics
+ * \file      taskstats.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef TASKSTATS_H
+#define TASKSTATS_H
+
+#include <MKL25Z4.h>
+
+// Longest row written to the serial port, including the terminator
+#define TASKSTATS_LINE_LEN (96)
+
+// Number of tasks of which the stack and heap usage is tracked
+#ifndef TASKSTATS_STACK_SLOTS
+#define TASKSTATS_STACK_SLOTS (10)
+#endif
+
+// Recommended stack size is the deepest use plus this share of it, in %
+#define TASKSTATS_STACK_MARGIN (25)
+
+// Free stack in words below which the stack monitor logs a warning
+#define TASKSTATS_STACK_LOW (16)
+
+// Period in ms of the stack monitor, see taskstats_stack_monitor()
+#define TASKSTATS_STACK_PERIOD_MS (1000)
+
+// Number of buckets of the histogram of allocated block sizes
+#define TASKSTATS_HEAP_BUCKETS (8)
+
+// Heap operations recorded from the start for tools/heap_trace.py, written
+// at the end of the heap report. 0 records none, recording stops when full.
+#ifndef TASKSTATS_HEAP_TRACE
+#define TASKSTATS_HEAP_TRACE (0)
+#endif
+
+void taskstats_list(void);
+void taskstats_runtime(void);
+void taskstats_irq(void);
+void taskstats_queues(void);
+void taskstats_periodic(void);
+void taskstats_wcet(void);
+void taskstats_critical(void);
+void taskstats_i2c(void);
+void taskstats_serial(void);
+void taskstats_stack(void);
+void taskstats_stack_sample(void);
+void taskstats_stack_monitor(void);
+void taskstats_stack_created(void *task, const char *name, const uint32_t depth);
+void taskstats_heap(void);
+void taskstats_malloc(const void *address, const uint32_t size);
+void taskstats_free(const void *address, const uint32_t size);
+void taskstats_command(const char c);
+
+// FreeRTOS hook recording the stack depth of every created task, expanded in
+// the kernel sources where the TCB is known. The stack grows down, so the
+// highest valid address needs configRECORD_STACK_HIGH_ADDRESS.
+#define traceTASK_CREATE(pxNewTCB) \
+    taskstats_stack_created((pxNewTCB), (pxNewTCB)->pcTaskName, \
+        (uint32_t)((pxNewTCB)->pxEndOfStack - (pxNewTCB)->pxStack) + 1)
+
+// heap_4 hooks attributing allocations and frees to the running task
+#define traceMALLOC(pvAddress, uiSize) \
+    taskstats_malloc((pvAddress), (uiSize))
+#define traceFREE(pvAddress, uiSize) \
+    taskstats_free((pvAddress), (uiSize))
+
+#endif // TASKSTATS_H
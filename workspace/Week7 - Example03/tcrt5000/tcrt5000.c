@@ -30,20 +30,149 @@
  *
  *****************************************************************************/
 #include "tcrt5000.h"
+#include "bme.h"
+#include "clock.h"
+#include "dma.h"
+#include "ring.h"
+#include "seqlock.h"
+#include "timer.h"
+#include "irq_prio.h"
+#include "vectors.h"
 #include "stdbool.h"
+#include "sections.h"
 
 TaskHandle_t xADCTaskHandle;
 
+// Hardware averaging of the conversions
+static adc_avg_t avg = ADC_AVG_1;
+
+// Conversion request submitted by the TPM1 interrupt handler
+static void tcrt5000_adc_done(adc_request_t *r, BaseType_t *woken);
+static void tcrt5000_irq_handler(void);
+
+static adc_request_t request =
+{
+    .channel = 8,
+    .avg = ADC_AVG_1,
+    .callback = tcrt5000_adc_done,
+    .status = ADC_DONE,
+};
+
+#if (TCRT5000_RING_SIZE & (TCRT5000_RING_SIZE - 1)) != 0
+#error TCRT5000_RING_SIZE must be a power of two
+#endif
+
+// Ring of on/off differences, written by the ADC callback and read by
+// tcrt5000_read()
+static int32_t diff_storage[TCRT5000_RING_SIZE];
+static ring_t diffs;
+
+// Number of differences dropped because the ring was full
+uint32_t tcrt5000_ring_overruns = 0;
+
+// Latest sample pair in interrupt mode, written by the ADC callback and read
+// by tcrt5000_latest()
+static tcrt5000_reflect_t latest_copies[2];
+static seqlock_t latest = SEQLOCK_INIT(latest_copies);
+
+// Threshold mode: reflected brightness thresholds and current state
+static uint16_t watch_threshold;
+static uint16_t watch_hysteresis;
+static volatile bool watch_near = false;
+static TaskHandle_t watch_task = NULL;
+
+// Lock-in mode: on/off cycles per window, running sums and the result of the
+// last completed window
+static volatile uint32_t lockin_cycles = 16;
+static uint32_t lockin_n;
+static int32_t lockin_sum;
+static bool lockin_on;
+static volatile tcrt5000_lockin_t lockin_result;
+static volatile bool lockin_ready = false;
+static TaskHandle_t lockin_task = NULL;
+
+// Number of lock-in windows that were completed before the previous one was
+// taken by tcrt5000_lockin_wait()
+uint32_t tcrt5000_lockin_overruns = 0;
+
+// Synchronous mode: modulation frequency, 0 while stopped, settling time and
+// the DMA channel that switches the IR LED
+static uint32_t sync_hz = 0;
+static uint32_t sync_settle_us;
+static int32_t sync_ch = -1;
+
+// Written to PTOR by DMA at every compare match
+static const uint32_t sync_toggle = TCRT5000_IR_MASK;
+
+// Largest byte count of a DMA channel that is a multiple of the transfer
+#define SYNC_BCR (0x0FFFFCUL)
+
+static void tcrt5000_sync_dma_isr(void *arg, const uint32_t status,
+    BaseType_t *woken);
+
+// Ping-pong buffers, DMA fills one pair while the task processes the other
+static __BSS_SRAM_U tcrt5000_pair_t pairs[2];
+
+// Block that DMA is filling: bit 1 selects the pair, bit 0 the LED state
+static volatile uint32_t block = 0;
+
+// Completed pair that is not yet taken by tcrt5000_dma_wait()
+static const tcrt5000_pair_t * volatile ready = NULL;
+
+// Task notified by the DMA interrupt
+static TaskHandle_t dma_task = NULL;
+
+// Claimed DMA channel, -1 in interrupt mode
+static int32_t dma_ch = -1;
+
+static void tcrt5000_dma_isr(void *arg, const uint32_t status,
+    BaseType_t *woken);
+
+// Number of block pairs that were completed before the previous one was
+// taken by tcrt5000_dma_wait()
+uint32_t tcrt5000_dma_overruns = 0;
+
+// Rate of the conversion requests of the interrupt mode
+static volatile uint32_t rate_hz = TCRT5000_RATE_HZ;
+
+// Rate of the PIT1 trigger, 0 while it is stopped
+static uint32_t trigger_hz = 0;
+
+// Registration for clock mode changes
+static clk_notifier_t clock;
+
+static void tcrt5000_clock(const clk_event_t event, void *arg);
+static bool tcrt5000_sync_timing(void);
+
+/*!
+ * \brief TPM1 modulo for a conversion request at rate_hz
+ */
+static uint32_t tcrt5000_tpm_mod(void)
+{
+    // (48 MHz / 128 ) / 20 Hz = 18750 in CLK_RUN
+    const uint32_t mod = (clk_periph_hz() / 128 / rate_hz) - 1;
+
+    return (mod > 0xFFFF) ? 0xFFFF : mod;
+}
+
 /*!
  * \brief Initializes the TCRT5000 on the shield
  *
  * This functions initializes the TCRT5000 on the shield.
  * - PTA16 is configured as an output pin
  * - PTB0 is configured as an analog input (ADC channel 8)
- * - TPM1 is configured to trigger an ADC conversion every 50 ms
+ * - TPM1 is configured to request an ADC conversion at TCRT5000_RATE_HZ,
+ *   every 50 ms by default, see tcrt5000_set_rate()
+ *
+ * The conversions are requested from the ADC conversion service, so other
+ * clients can share ADC0. Call tcrt5000_dma_start() for higher sample rates.
+ * Hardware averaging is disabled, see tcrt5000_set_averaging().
  */
 void tcrt5000_init(void)
 {
+    ring_init(&diffs, diff_storage, TCRT5000_RING_SIZE, sizeof(int32_t),
+              TCRT5000_NOTIFY_INDEX);
+
     // ------------------------------------------------------------------------
 
     // Enable clock to PORTs
@@ -53,10 +182,10 @@ void tcrt5000_init(void)
     // pin.
     PORTA->PCR[16] &= ~0x7FF;
     PORTA->PCR[16] |= PORT_PCR_MUX(1) | PORT_PCR_PE(1);
-    PTA->PDDR |= (1<<16);
+    gpio_output(GPIO_A, TCRT5000_IR_MASK);
 
     // IR LED off
-    PTA->PSOR = (1<<16);
+    gpio_set(GPIO_A, TCRT5000_IR_MASK);
 
     // The output of the transistor is connected to PTB0. Configure the pin as
     // ADC input pin (channel 8).
@@ -64,106 +193,1172 @@ void tcrt5000_init(void)
 
     // ------------------------------------------------------------------------
 
-    // Enable clock to ADC0
-    SIM->SCGC6 |= SIM_SCGC6_ADC0(1);
-
-    // Configure ADC
-    // - ADLPC = 1        : Low-power configuration. The power is reduced at
-    //                      the expense of maximum clock speed.
-    // - ADIV[1:0] = 00   : The divide ratio is 1 and the clock rate is input
-    //                      clock.
-    // - ADLSMP = 1       : Long sample time.
-    // - MODE[1:0] = 11   : Single-ended 16-bit conversion
-    // - ADICLK[1:0] = 01 : (Bus clock)/2
-    ADC0->CFG1 = 0x9D;
-
-    // - ADTRG = 1   : Hardware trigger selected
-    // - ACFE  = 0   : Compare function disabled
-    // - DMAEN = 0   : DMA is disabled
-    // - REFSEL = 00 : Default voltage reference pin pair
-    ADC0->SC2 = ADC_SC2_ADTRG(1);
-
-    // - AIEN = 1     : Conversion complete interrupt is enabled
-    // - DIFF = 0     : Single-ended conversions and input channels are
-    //                  selected
-    // - ADCH = 01000 : Channel 8
-    ADC0->SC1[0] = ADC_SC1_AIEN(1) | ADC_SC1_ADCH(8);
+    // ADC0 is owned by the conversion service
+    adc_init();
 
     // ------------------------------------------------------------------------
 
     // Clock to TIM1 on
-    SIM->SCGC6 |= SIM_SCGC6_TPM1(1);
+    clk_gate_acquire(CLK_GATE_TPM1);
 
     // Divide by 128 Prescale Factor
     TPM1->SC |= TPM_SC_PS(0b111);
 
-    // (48 MHz / 128 ) / 20 Hz = 18750
-    TPM1->MOD = (18750-1);
+    // At rate_hz at the peripheral clock of the clock mode
+    TPM1->MOD = tcrt5000_tpm_mod();
+    clk_register(&clock, tcrt5000_clock, NULL);
+
+    // Overflow interrupt enabled, it submits a conversion request
+    BME_OR(TPM1->SC, TPM_SC_TOIE(1));
 
     // Counter increments on every LPTPM counter clock
     TPM1->SC |= TPM_SC_CMOD(1);
 
     // ------------------------------------------------------------------------
 
-    // ADC0 trigger source select
-    // - ADC0ALTTRGEN = 1  : Alternate trigger selected for ADC0
-    // - ADC0PRETRGSEL = 0 : Pre-trigger A
-    // - ADC0TRGSEL = 1001 : TPM1 overflow
-    SIM->SOPT7 |= SIM_SOPT7_ADC0ALTTRGEN(1) | SIM_SOPT7_ADC0TRGSEL(9);
+    // The timer service owns the TPM1 vector, it calls this handler from now
+    // on. Enable the interrupt in the NVIC.
+    tim_tpm1_handover(tcrt5000_irq_handler);
+    NVIC_SetPriority(TPM1_IRQn, IRQ_PRIO(TCRT5000));
+    NVIC_ClearPendingIRQ(TPM1_IRQn);
+    NVIC_EnableIRQ(TPM1_IRQn);
+}
 
-    // ------------------------------------------------------------------------
+/*!
+ * \brief Selects the hardware averaging of the conversions
+ *
+ * Every conversion is the average of \p avg conversions, in both the
+ * interrupt and the DMA acquisition mode. A conversion takes about
+ * ADC_CONVERSION_US, tcrt5000_dma_start() rejects sample rates that do not
+ * leave enough time for the averaged conversion.
+ *
+ * \param[in]  a  Number of conversions per result
+ */
+void tcrt5000_set_averaging(const adc_avg_t a)
+{
+    avg = a;
+}
+
+/*!
+ * \brief Changes the rate of the conversion requests of the interrupt mode
+ *
+ * The TPM1 modulo is changed, so the hardware requests the conversions at
+ * the new rate. It takes effect at the next overflow. In the synchronous
+ * mode TPM1 runs at the modulation, the rate is used when it stops.
+ *
+ * \param[in]  hz  TCRT5000_RATE_MIN_HZ to TCRT5000_RATE_MAX_HZ
+ *
+ * \return false if the rate is out of range
+ */
+bool tcrt5000_set_rate(const uint32_t hz)
+{
+    if((hz < TCRT5000_RATE_MIN_HZ) || (hz > TCRT5000_RATE_MAX_HZ))
+    {
+        return false;
+    }
 
-    // Enable the interrupt in the NVIC
-    NVIC_SetPriority(ADC0_IRQn, 128);
-    NVIC_ClearPendingIRQ(ADC0_IRQn);
-    NVIC_EnableIRQ(ADC0_IRQn);
+    rate_hz = hz;
+
+    if(sync_hz == 0)
+    {
+        TPM1->MOD = tcrt5000_tpm_mod();
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Returns the rate of the conversion requests of the interrupt mode
+ */
+uint32_t tcrt5000_get_rate(void)
+{
+    return rate_hz;
 }
 
-void ADC0_IRQHandler(void)
+/*!
+ * \brief TPM1 interrupt handler
+ *
+ * Submits a conversion at every overflow, every 50 ms by default. If the
+ * previous conversion is still queued behind conversions of other clients,
+ * this period is skipped.
+ */
+static void tcrt5000_irq_handler(void)
 {
-    // Clear pending interrupt
-    NVIC_ClearPendingIRQ(ADC0_IRQn);
+    TRACE_ISR_ENTER();
+
+    // The counter restarted at the overflow, it counts at 375 kHz which is
+    // 64 bus clock cycles per count
+    TRACE_ISR_LATENCY(TPM1->CNT * 64);
 
     // Clear the flag
     TPM1->STATUS = TPM_STATUS_TOF(1);
 
+    if((request.status == ADC_QUEUED) || (request.status == ADC_BUSY))
+    {
+        TRACE_ISR_EXIT();
+        return;
+    }
+
+    request.avg = avg;
+    adc_submit_from_isr(&request);
+
+    TRACE_ISR_EXIT();
+}
+
+/*!
+ * \brief Conversion complete callback, called by the ADC0 interrupt handler
+ *
+ * Alternates the IR LED. The difference of every on/off sample pair is
+ * stored in the ring, the task in tcrt5000_read() is notified when the
+ * watermark is reached. If the ring is full the difference is dropped and
+ * counted in tcrt5000_ring_overruns. The latest pair is published for
+ * tcrt5000_latest() either way.
+ */
+static void tcrt5000_adc_done(adc_request_t *r, BaseType_t *woken)
+{
     static volatile bool ir_led_is_on = false;
     static volatile uint32_t on_brightness;
     static volatile uint32_t off_brightness;
 
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    BaseType_t xResult;
-
     if(ir_led_is_on)
     {
         // Get conversion and complement the result
-        on_brightness = 0xFFFF - ADC0->R[0];
+        on_brightness = 0xFFFF - r->result;
 
         // IR LED off
-        PTA->PSOR = (1<<16);
+        gpio_set(GPIO_A, TCRT5000_IR_MASK);
         ir_led_is_on = false;
 
-        // Send a notification, and the ADC conversion result, directly to
-        // vADCTask()
-        xResult = xTaskNotifyFromISR(xADCTaskHandle,
-                                     on_brightness - off_brightness,
-                                     eSetValueWithoutOverwrite,
-                                     &xHigherPriorityTaskWoken );
+        const int32_t diff = (int32_t)on_brightness - (int32_t)off_brightness;
 
-        // If the call to xTaskNotifyFromISR() doesn't return pdPASS then the
-        // vADCTask is not keeping up with the rate at which ADC values are
-        // being generated
-        configASSERT(xResult == pdPASS);
+        const tcrt5000_reflect_t reflect =
+        {
+            (uint16_t)on_brightness, (uint16_t)off_brightness, diff
+        };
+        seqlock_write(&latest, &reflect);
 
-        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        // If the consumer is not keeping up, keep the oldest differences
+        if(!ring_put_from_isr(&diffs, &diff, woken))
+        {
+            tcrt5000_ring_overruns++;
+        }
     }
     else
     {
         // Get conversion and complement the result
-        off_brightness = 0xFFFF - ADC0->R[0];
+        off_brightness = 0xFFFF - r->result;
 
         // IR LED on
-        PTA->PCOR = (1<<16);
+        gpio_clear(GPIO_A, TCRT5000_IR_MASK);
         ir_led_is_on = true;
     }
 }
+
+/*!
+ * \brief Sets the number of buffered differences that notifies the consumer
+ *
+ * A consumer that needs every difference as soon as possible uses 1, the
+ * default. A larger value lets it process the differences in batches and
+ * wake up less often.
+ *
+ * \param[in]  n  Watermark, 1 to TCRT5000_RING_SIZE
+ */
+void tcrt5000_set_watermark(const uint32_t n)
+{
+    ring_set_watermark(&diffs, n);
+}
+
+/*!
+ * \brief Takes the buffered on/off differences in interrupt mode
+ *
+ * Must always be called by the same task. Blocks until the watermark is
+ * reached or \p timeout expires, then copies up to \p max differences,
+ * oldest first. A consumer that was delayed gets all differences buffered in
+ * the meantime.
+ *
+ * \param[out]  diff     Differences, on minus off brightness
+ * \param[in]   max      Size of \p diff
+ * \param[in]   timeout  Maximum time to wait in ticks
+ *
+ * \return Number of differences copied, 0 on timeout
+ */
+uint32_t tcrt5000_read(int32_t diff[], const uint32_t max,
+    const TickType_t timeout)
+{
+    (void)ring_wait(&diffs, timeout);
+
+    return ring_read(&diffs, diff, max);
+}
+
+/*!
+ * \brief Gets the latest sample pair in interrupt mode
+ *
+ * Does not block and does not take the differences from the ring, so any
+ * number of tasks or interrupt handlers can read it next to the consumer of
+ * tcrt5000_read(). The pair is consistent without masking the ADC
+ * interrupt.
+ *
+ * \param[out]  reflect  Latest brightnesses and their difference
+ *
+ * \return Number of sample pairs so far, 0 before the first
+ */
+uint32_t tcrt5000_latest(tcrt5000_reflect_t *reflect)
+{
+    return seqlock_read(&latest, reflect);
+}
+
+/*!
+ * \brief Triggers a conversion of ADC0 every 1 / rate_hz seconds by PIT1
+ */
+static void tcrt5000_trigger_start(const uint32_t rate_hz)
+{
+    // ADC0 trigger source select
+    // - ADC0ALTTRGEN = 1  : Alternate trigger selected for ADC0
+    // - ADC0PRETRGSEL = 0 : Pre-trigger A
+    // - ADC0TRGSEL = 0101 : PIT trigger 1
+    SIM->SOPT7 = (SIM->SOPT7 & ~SIM_SOPT7_ADC0TRGSEL_MASK) |
+        SIM_SOPT7_ADC0ALTTRGEN(1) | SIM_SOPT7_ADC0TRGSEL(5);
+
+    // PIT1 runs from the bus clock, 24 MHz in CLK_RUN, without interrupt
+    if(trigger_hz == 0)
+    {
+        clk_gate_acquire(CLK_GATE_PIT);
+    }
+
+    PIT->MCR &= ~PIT_MCR_MDIS_MASK;
+
+    trigger_hz = rate_hz;
+    clk_register(&clock, tcrt5000_clock, NULL);
+
+    PIT->CHANNEL[1].TCTRL = 0;
+    PIT->CHANNEL[1].LDVAL = PIT_LDVAL_TSV((clk_bus_hz() / rate_hz) - 1);
+    PIT->CHANNEL[1].TFLG = PIT_TFLG_TIF_MASK;
+    PIT->CHANNEL[1].TCTRL = PIT_TCTRL_TEN_MASK;
+}
+
+/*!
+ * \brief Recomputes the TPM1 modulo and the PIT1 trigger period after a
+ *        clock mode change
+ */
+static void tcrt5000_clock(const clk_event_t event, void *arg)
+{
+    (void)arg;
+
+    if(event != CLK_POST_CHANGE)
+    {
+        return;
+    }
+
+    if(sync_hz != 0)
+    {
+        (void)tcrt5000_sync_timing();
+    }
+    else
+    {
+        // Takes effect at the next overflow
+        TPM1->MOD = tcrt5000_tpm_mod();
+    }
+
+    if(trigger_hz != 0)
+    {
+        PIT->CHANNEL[1].TCTRL = 0;
+        PIT->CHANNEL[1].LDVAL = PIT_LDVAL_TSV((clk_bus_hz() / trigger_hz) - 1);
+        PIT->CHANNEL[1].TCTRL = PIT_TCTRL_TEN_MASK;
+    }
+}
+
+/*!
+ * \brief Stops the PIT1 trigger and selects the default trigger
+ */
+static void tcrt5000_trigger_stop(void)
+{
+    if(trigger_hz != 0)
+    {
+        PIT->CHANNEL[1].TCTRL = 0;
+        trigger_hz = 0;
+        clk_gate_release(CLK_GATE_PIT);
+    }
+
+    // Default trigger, the conversion service uses the software trigger
+    SIM->SOPT7 &= ~(SIM_SOPT7_ADC0ALTTRGEN_MASK | SIM_SOPT7_ADC0TRGSEL_MASK);
+}
+
+/*!
+ * \brief Starts the DMA acquisition mode
+ *
+ * Instead of an interrupt per conversion, DMA channel TCRT5000_DMA_CHANNEL
+ * stores the conversion results in a block of TCRT5000_BLOCK_SIZE samples
+ * with the IR LED on, followed by a block with the IR LED off. The IR LED is
+ * switched in the DMA interrupt at the end of every block, so there are two
+ * interrupts per block pair. When a pair is complete, \p task is notified on
+ * index TCRT5000_NOTIFY_INDEX while DMA fills the other pair.
+ *
+ * ADC0 is taken from the conversion service with adc_acquire(), so other
+ * clients wait until tcrt5000_dma_stop(). The conversions are triggered by
+ * PIT1 in hardware.
+ *
+ * \param[in]  rate_hz  Conversions per second, up to TCRT5000_DMA_MAX_HZ and
+ *                      limited by the hardware averaging
+ * \param[in]  task     Task that calls tcrt5000_dma_wait()
+ *
+ * \return False if \p rate_hz is out of range or the DMA channel is used by
+ *         another driver
+ */
+bool tcrt5000_dma_start(const uint32_t rate_hz, TaskHandle_t task)
+{
+    if((rate_hz == 0) || (rate_hz > TCRT5000_DMA_MAX_HZ))
+    {
+        return false;
+    }
+
+    // An averaged result must be completed before the next trigger, at
+    // about 4 us per conversion
+    if((rate_hz * adc_avg_samples(avg)) > (1000000 / ADC_CONVERSION_US))
+    {
+        return false;
+    }
+
+    if(dma_ch >= 0)
+    {
+        tcrt5000_dma_stop();
+    }
+
+    const int32_t ch = dma_claim(TCRT5000_DMA_CHANNEL, tcrt5000_dma_isr, NULL);
+
+    if(ch < 0)
+    {
+        return false;
+    }
+
+    dma_ch = ch;
+
+    // Stop conversions in interrupt mode and take ADC0 from the conversion
+    // service
+    BME_CLR(TPM1->SC, TPM_SC_TOIE_MASK);
+    adc_acquire(NULL);
+
+    dma_task = task;
+    block = 0;
+    ready = NULL;
+    tcrt5000_dma_overruns = 0;
+
+    // ------------------------------------------------------------------------
+
+    // Route the ADC0 request to the DMA channel
+    dma_route(ch, DMA_SOURCE_ADC0, false);
+
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    DMA0->DMA[ch].SAR = (uint32_t)&ADC0->R[0];
+    DMA0->DMA[ch].DAR = (uint32_t)pairs[0].on;
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_BCR(sizeof(pairs[0].on));
+
+    // 16-bit transfers, one per request, incrementing destination,
+    // interrupt when complete. ERQ is cleared by hardware when BCR reaches
+    // zero.
+    DMA0->DMA[ch].DCR = DMA_DCR_EINT_MASK |
+                        DMA_DCR_ERQ_MASK |
+                        DMA_DCR_CS_MASK |
+                        DMA_DCR_DINC_MASK |
+                        DMA_DCR_SSIZE(2) |
+                        DMA_DCR_DSIZE(2) |
+                        DMA_DCR_D_REQ_MASK;
+
+    dma_irq_enable(ch, IRQ_PRIO(TCRT5000_DMA));
+
+    // ------------------------------------------------------------------------
+
+    // The first block is sampled with the IR LED on
+    gpio_clear(GPIO_A, TCRT5000_IR_MASK);
+
+    ADC0->SC3 = adc_sc3_avg(avg);
+
+    // - ADTRG = 1   : Hardware trigger selected
+    // - DMAEN = 1   : DMA request on conversion complete
+    ADC0->SC2 = ADC_SC2_ADTRG(1) | ADC_SC2_DMAEN(1);
+
+    // - AIEN = 0     : Conversion complete interrupt is disabled
+    // - ADCH = 01000 : Channel 8
+    ADC0->SC1[0] = ADC_SC1_ADCH(8);
+
+    tcrt5000_trigger_start(rate_hz);
+
+    return true;
+}
+
+/*!
+ * \brief Stops the DMA acquisition mode and returns to interrupt mode
+ */
+void tcrt5000_dma_stop(void)
+{
+    if(dma_ch < 0)
+    {
+        return;
+    }
+
+    tcrt5000_trigger_stop();
+
+    dma_release(dma_ch);
+    dma_ch = -1;
+
+    dma_task = NULL;
+
+    // IR LED off
+    gpio_set(GPIO_A, TCRT5000_IR_MASK);
+
+    adc_release();
+
+    TPM1->STATUS = TPM_STATUS_TOF(1);
+    BME_OR(TPM1->SC, TPM_SC_TOIE(1));
+}
+
+/*!
+ * \brief Waits for the next block pair in DMA acquisition mode
+ *
+ * The returned pair is valid until DMA has filled the other pair, which
+ * takes 2 * TCRT5000_BLOCK_SIZE conversions. If the task falls behind, the
+ * newest pair is returned and tcrt5000_dma_overruns is incremented.
+ *
+ * \param[in]  timeout  Maximum time to wait in ticks
+ *
+ * \return The completed pair, or NULL on timeout
+ */
+const tcrt5000_pair_t *tcrt5000_dma_wait(const TickType_t timeout)
+{
+    const tcrt5000_pair_t *pair;
+
+    if(ulTaskNotifyTakeIndexed(TCRT5000_NOTIFY_INDEX, pdTRUE, timeout) == 0)
+    {
+        return NULL;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        pair = ready;
+        ready = NULL;
+    }
+    taskEXIT_CRITICAL();
+
+    return pair;
+}
+
+/*!
+ * \brief Calculates the reflected IR light of a block pair
+ *
+ * This is the mean brightness with the IR LED on minus the mean brightness
+ * with the IR LED off, the same difference the interrupt mode sends per
+ * sample pair, so ambient light is cancelled.
+ *
+ * \param[in]  pair  Block pair
+ *
+ * \return Difference in ADC counts
+ */
+int32_t tcrt5000_pair_diff(const tcrt5000_pair_t *pair)
+{
+    int32_t sum = 0;
+
+    for(uint32_t i=0; i<TCRT5000_BLOCK_SIZE; ++i)
+    {
+        // The brightness is the complement of the result
+        sum += (int32_t)pair->off[i] - (int32_t)pair->on[i];
+    }
+
+    return sum / TCRT5000_BLOCK_SIZE;
+}
+
+/*!
+ * \brief Filters the reflected IR light of a block pair
+ *
+ * The differences of the sample pairs are halved to fit Q15 and filtered
+ * as a block with dsp_biquad(), for example to suppress mains flicker that
+ * the on/off difference does not fully cancel. The filter state carries
+ * over between pairs, so the blocks form one continuous signal at the
+ * rate of tcrt5000_dma_start(), the fs of the filter design.
+ *
+ * \param[in]  pair  Block pair
+ * \param[in]  f     Filter, the state is updated
+ * \param[out] out   Filtered differences, in half ADC counts
+ *
+ * \return Mean of the filtered differences in ADC counts
+ */
+int32_t tcrt5000_pair_filter(const tcrt5000_pair_t *pair, const dsp_biquad_t *f,
+    int16_t out[TCRT5000_BLOCK_SIZE])
+{
+    for(uint32_t i=0; i<TCRT5000_BLOCK_SIZE; ++i)
+    {
+        // The brightness is the complement of the result
+        out[i] = (int16_t)(((int32_t)pair->off[i] - (int32_t)pair->on[i]) / 2);
+    }
+
+    dsp_biquad(f, out, out, TCRT5000_BLOCK_SIZE);
+
+    return (int32_t)dsp_mean(out, TCRT5000_BLOCK_SIZE) * 2;
+}
+
+/*!
+ * \brief DMA interrupt of the DMA acquisition mode
+ *
+ * Called by the interrupt handler of the channel at the end of every block. Switches the IR LED, points DMA to the
+ * next block and notifies the task when a pair is complete. The next
+ * conversion is started one sample period later, which is enough time for
+ * this handler and for the phototransistor to settle.
+ */
+static void tcrt5000_dma_isr(void *arg, const uint32_t status,
+    BaseType_t *woken)
+{
+    const int32_t ch = dma_ch;
+
+    (void)arg;
+    (void)status;
+
+    // Clear the done and error flags
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+
+    const uint32_t done = block;
+    const uint32_t next = (done + 1) & 0x03;
+
+    tcrt5000_pair_t *pair = &pairs[next >> 1];
+
+    // Pair blocks are on, off
+    if(next & 0x01)
+    {
+        gpio_set(GPIO_A, TCRT5000_IR_MASK);
+        DMA0->DMA[ch].DAR = (uint32_t)pair->off;
+    }
+    else
+    {
+        gpio_clear(GPIO_A, TCRT5000_IR_MASK);
+        DMA0->DMA[ch].DAR = (uint32_t)pair->on;
+    }
+
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_BCR(sizeof(pair->on));
+    DMA0->DMA[ch].DCR |= DMA_DCR_ERQ_MASK;
+
+    block = next;
+
+    if(done & 0x01)
+    {
+        if(ready != NULL)
+        {
+            tcrt5000_dma_overruns++;
+        }
+
+        ready = &pairs[done >> 1];
+
+        if(dma_task != NULL)
+        {
+            vTaskNotifyGiveIndexedFromISR(dma_task, TCRT5000_NOTIFY_INDEX,
+                woken);
+        }
+    }
+}
+
+/*!
+ * \brief Arms the compare function for the next threshold crossing
+ *
+ * The brightness is the complement of the result, so a brightness of at
+ * least threshold is a result below 0x10000 - threshold.
+ */
+static void tcrt5000_watch_compare(void)
+{
+    if(watch_near)
+    {
+        // Far again when brightness < threshold - hysteresis
+        adc_set_compare(ADC_COMPARE_GREATER_EQUAL,
+            0x10000UL - watch_threshold + watch_hysteresis, 0);
+    }
+    else
+    {
+        // Near when brightness >= threshold
+        adc_set_compare(ADC_COMPARE_LESS, 0x10000UL - watch_threshold, 0);
+    }
+}
+
+/*!
+ * \brief ADC0 interrupt handler in threshold mode
+ *
+ * Only called for a conversion that crossed the threshold.
+ */
+static void tcrt5000_watch_isr(BaseType_t *woken)
+{
+    // Reading the result clears COCO
+    (void)ADC0->R[0];
+
+    watch_near = !watch_near;
+    tcrt5000_watch_compare();
+
+    if(watch_task != NULL)
+    {
+        xTaskNotifyIndexedFromISR(watch_task, TCRT5000_NOTIFY_INDEX,
+            watch_near, eSetValueWithOverwrite, woken);
+    }
+}
+
+/*!
+ * \brief Starts the threshold mode
+ *
+ * The IR LED stays on and PIT1 triggers a conversion every 1 / rate_hz
+ * seconds. The compare function of ADC0 discards every result on the
+ * current side of the threshold, so there is no interrupt and no task
+ * wake-up while the reflection does not change. \p task is notified on index
+ * TCRT5000_NOTIFY_INDEX when the brightness crosses \p threshold upwards, or
+ * crosses \p threshold - \p hysteresis downwards.
+ *
+ * Unlike the other modes, the brightness is not corrected for ambient light,
+ * because the hardware compares single conversions. The mode starts in the
+ * far state, if the object is already near the first conversion notifies.
+ * ADC0 is taken from the conversion service until tcrt5000_watch_stop().
+ *
+ * \param[in]  rate_hz     Conversions per second, up to TCRT5000_DMA_MAX_HZ
+ * \param[in]  threshold   Brightness of a near object, at least 1
+ * \param[in]  hysteresis  Brightness drop before the object is far again,
+ *                         less than \p threshold
+ * \param[in]  task        Task that calls tcrt5000_watch_wait()
+ *
+ * \return False if a parameter is out of range
+ */
+bool tcrt5000_watch_start(const uint32_t rate_hz, const uint16_t threshold,
+    const uint16_t hysteresis, TaskHandle_t task)
+{
+    if((rate_hz == 0) || (rate_hz > TCRT5000_DMA_MAX_HZ) ||
+       (threshold == 0) || (hysteresis >= threshold))
+    {
+        return false;
+    }
+
+    if((rate_hz * adc_avg_samples(avg)) > (1000000 / ADC_CONVERSION_US))
+    {
+        return false;
+    }
+
+    // Stop conversions in interrupt mode and take ADC0 from the conversion
+    // service
+    BME_CLR(TPM1->SC, TPM_SC_TOIE_MASK);
+    adc_acquire(tcrt5000_watch_isr);
+
+    watch_threshold = threshold;
+    watch_hysteresis = hysteresis;
+    watch_near = false;
+    watch_task = task;
+
+    // IR LED on
+    gpio_clear(GPIO_A, TCRT5000_IR_MASK);
+
+    ADC0->SC3 = adc_sc3_avg(avg);
+
+    // - ADTRG = 1   : Hardware trigger selected
+    ADC0->SC2 = ADC_SC2_ADTRG(1);
+    tcrt5000_watch_compare();
+
+    // - AIEN = 1     : Conversion complete interrupt is enabled
+    // - ADCH = 01000 : Channel 8
+    ADC0->SC1[0] = ADC_SC1_AIEN(1) | ADC_SC1_ADCH(8);
+
+    tcrt5000_trigger_start(rate_hz);
+
+    return true;
+}
+
+/*!
+ * \brief Stops the threshold mode and returns to interrupt mode
+ */
+void tcrt5000_watch_stop(void)
+{
+    tcrt5000_trigger_stop();
+
+    watch_task = NULL;
+
+    // IR LED off
+    gpio_set(GPIO_A, TCRT5000_IR_MASK);
+
+    adc_release();
+
+    TPM1->STATUS = TPM_STATUS_TOF(1);
+    BME_OR(TPM1->SC, TPM_SC_TOIE(1));
+}
+
+/*!
+ * \brief Waits for a threshold crossing in threshold mode
+ *
+ * \param[out]  near     True if the object is near after the crossing
+ * \param[in]   timeout  Maximum time to wait in ticks
+ *
+ * \return False on timeout
+ */
+bool tcrt5000_watch_wait(bool *near, const TickType_t timeout)
+{
+    uint32_t value;
+
+    if(xTaskNotifyWaitIndexed(TCRT5000_NOTIFY_INDEX, 0, UINT32_MAX, &value,
+        timeout) != pdPASS)
+    {
+        return false;
+    }
+
+    *near = (value != 0);
+
+    return true;
+}
+
+/*!
+ * \brief Integrates a conversion of the lock-in and synchronous modes
+ *
+ * Adds the brightness with the IR LED on and subtracts the brightness with
+ * the IR LED off. After lockin_cycles on/off cycles the integrated result is
+ * published and the task is notified.
+ */
+static void tcrt5000_lockin_add(const int32_t result, const bool on,
+    BaseType_t *woken)
+{
+    // The brightness is the complement of the result, so on minus off
+    // brightness is off minus on result
+    if(!on)
+    {
+        lockin_sum += result;
+        return;
+    }
+
+    lockin_sum -= result;
+
+    if(++lockin_n < lockin_cycles)
+    {
+        return;
+    }
+
+    if(lockin_ready)
+    {
+        tcrt5000_lockin_overruns++;
+    }
+
+    lockin_result.sum = lockin_sum;
+    lockin_result.cycles = lockin_n;
+    lockin_ready = true;
+
+    lockin_sum = 0;
+    lockin_n = 0;
+
+    if(lockin_task != NULL)
+    {
+        vTaskNotifyGiveIndexedFromISR(lockin_task, TCRT5000_NOTIFY_INDEX,
+            woken);
+    }
+}
+
+/*!
+ * \brief ADC0 interrupt handler in lock-in mode
+ *
+ * Called for every conversion. Integrates the conversion, then switches the
+ * IR LED for the next conversion.
+ */
+static void tcrt5000_lockin_isr(BaseType_t *woken)
+{
+    const int32_t result = (int32_t)ADC0->R[0];
+    const bool on = lockin_on;
+
+    if(on)
+    {
+        // IR LED off
+        gpio_set(GPIO_A, TCRT5000_IR_MASK);
+    }
+    else
+    {
+        // IR LED on
+        gpio_clear(GPIO_A, TCRT5000_IR_MASK);
+    }
+
+    lockin_on = !on;
+
+    tcrt5000_lockin_add(result, on, woken);
+}
+
+/*!
+ * \brief Sets the number of on/off cycles integrated per lock-in window
+ *
+ * Can be changed while the lock-in mode is running and takes effect at the
+ * end of the current window. More cycles give a better signal to noise
+ * ratio at a lower result rate.
+ *
+ * \param[in]  n  Cycles per window, 1 to TCRT5000_LOCKIN_MAX_CYCLES
+ */
+void tcrt5000_lockin_set_cycles(const uint32_t n)
+{
+    if((n >= 1) && (n <= TCRT5000_LOCKIN_MAX_CYCLES))
+    {
+        lockin_cycles = n;
+    }
+}
+
+/*!
+ * \brief Starts the lock-in mode
+ *
+ * The IR LED is modulated with a square wave of \p mod_hz. PIT1 triggers one
+ * conversion in each half period, just before the IR LED is switched, so the
+ * phototransistor has almost half a period to settle. Ambient light that
+ * changes slowly compared to \p mod_hz is in both halves and cancels in the
+ * integrated result. The number of cycles per window is set with
+ * tcrt5000_lockin_set_cycles(), \p task is notified on index
+ * TCRT5000_NOTIFY_INDEX at the end of every window.
+ *
+ * ADC0 is taken from the conversion service until tcrt5000_lockin_stop().
+ *
+ * \param[in]  mod_hz  Modulation frequency, up to TCRT5000_DMA_MAX_HZ / 2
+ *                     and limited by the hardware averaging
+ * \param[in]  task    Task that calls tcrt5000_lockin_wait()
+ *
+ * \return False if \p mod_hz is out of range
+ */
+bool tcrt5000_lockin_start(const uint32_t mod_hz, TaskHandle_t task)
+{
+    const uint32_t rate_hz = 2 * mod_hz;
+
+    if((mod_hz == 0) || (rate_hz > TCRT5000_DMA_MAX_HZ))
+    {
+        return false;
+    }
+
+    if((rate_hz * adc_avg_samples(avg)) > (1000000 / ADC_CONVERSION_US))
+    {
+        return false;
+    }
+
+    // Stop conversions in interrupt mode and take ADC0 from the conversion
+    // service
+    BME_CLR(TPM1->SC, TPM_SC_TOIE_MASK);
+    adc_acquire(tcrt5000_lockin_isr);
+
+    lockin_n = 0;
+    lockin_sum = 0;
+    lockin_ready = false;
+    lockin_task = task;
+    tcrt5000_lockin_overruns = 0;
+
+    // The first half period is sampled with the IR LED off
+    gpio_set(GPIO_A, TCRT5000_IR_MASK);
+    lockin_on = false;
+
+    ADC0->SC3 = adc_sc3_avg(avg);
+
+    // - ADTRG = 1   : Hardware trigger selected
+    ADC0->SC2 = ADC_SC2_ADTRG(1);
+
+    // - AIEN = 1     : Conversion complete interrupt is enabled
+    // - ADCH = 01000 : Channel 8
+    ADC0->SC1[0] = ADC_SC1_AIEN(1) | ADC_SC1_ADCH(8);
+
+    tcrt5000_trigger_start(rate_hz);
+
+    return true;
+}
+
+/*!
+ * \brief Stops the lock-in mode and returns to interrupt mode
+ */
+void tcrt5000_lockin_stop(void)
+{
+    tcrt5000_trigger_stop();
+
+    lockin_task = NULL;
+
+    // IR LED off
+    gpio_set(GPIO_A, TCRT5000_IR_MASK);
+
+    adc_release();
+
+    TPM1->STATUS = TPM_STATUS_TOF(1);
+    BME_OR(TPM1->SC, TPM_SC_TOIE(1));
+}
+
+/*!
+ * \brief Waits for the next lock-in window
+ *
+ * If the task falls behind, the newest window is returned and
+ * tcrt5000_lockin_overruns is incremented.
+ *
+ * \param[out]  result   Integrated on minus off brightness and the number of
+ *                       cycles it was integrated over
+ * \param[in]   timeout  Maximum time to wait in ticks
+ *
+ * \return False on timeout
+ */
+bool tcrt5000_lockin_wait(tcrt5000_lockin_t *result, const TickType_t timeout)
+{
+    if(!lockin_ready)
+    {
+        (void)ulTaskNotifyTakeIndexed(TCRT5000_NOTIFY_INDEX, pdTRUE, timeout);
+    }
+
+    bool ok = false;
+
+    taskENTER_CRITICAL();
+    {
+        if(lockin_ready)
+        {
+            result->sum = lockin_result.sum;
+            result->cycles = lockin_result.cycles;
+            lockin_ready = false;
+            ok = true;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return ok;
+}
+
+/*!
+ * \brief Programs TPM1 for the synchronous mode at the current clock mode
+ *
+ * TPM1 overflows twice per modulation period and every overflow triggers a
+ * conversion. The compare match of channel TCRT5000_SYNC_CHANNEL switches
+ * the IR LED settle time before the overflow.
+ *
+ * \return False if the settling time and the conversion do not fit in half
+ *         a period, or a half period does not fit in the counter
+ */
+static bool tcrt5000_sync_timing(void)
+{
+    const uint32_t half_hz = 2 * sync_hz;
+    const uint32_t hz = clk_periph_hz();
+
+    // Smallest prescaler for the best resolution
+    uint32_t ps = 0;
+
+    while((ps < 7) && (((hz >> ps) / half_hz) > 0x10000))
+    {
+        ps++;
+    }
+
+    const uint32_t tpm_hz = hz >> ps;
+    const uint32_t period = tpm_hz / half_hz;
+    const uint32_t settle = (uint32_t)(((uint64_t)sync_settle_us * tpm_hz) /
+        1000000);
+    const uint32_t convert = (uint32_t)(((uint64_t)ADC_CONVERSION_US *
+        adc_avg_samples(avg) * tpm_hz) / 1000000);
+
+    // The IR LED must not be switched during a conversion
+    if((period > 0x10000) || (settle == 0) || ((settle + convert) >= period))
+    {
+        return false;
+    }
+
+    TPM1->SC = 0;
+    TPM1->CNT = 0;
+    TPM1->MOD = period - 1;
+    TPM1->CONTROLS[TCRT5000_SYNC_CHANNEL].CnV = period - settle;
+
+    // Counter increments on every LPTPM counter clock
+    TPM1->SC = TPM_SC_PS(ps) | TPM_SC_CMOD(1);
+
+    return true;
+}
+
+/*!
+ * \brief ADC0 interrupt handler in synchronous mode
+ *
+ * The IR LED is not switched here. The conversion started at the overflow,
+ * so if the counter is past the compare value the IR LED was switched since
+ * the conversion. Must run within half a modulation period.
+ */
+static void tcrt5000_sync_isr(BaseType_t *woken)
+{
+    const int32_t result = (int32_t)ADC0->R[0];
+
+    // The IR LED is on when the pin is low
+    bool on = !gpio_read(GPIO_A, TCRT5000_IR_MASK);
+
+    if(TPM1->CNT >= TPM1->CONTROLS[TCRT5000_SYNC_CHANNEL].CnV)
+    {
+        on = !on;
+    }
+
+    tcrt5000_lockin_add(result, on, woken);
+}
+
+/*!
+ * \brief Starts the synchronous mode
+ *
+ * Same as the lock-in mode, but the IR LED is switched by DMA instead of by
+ * the conversion interrupt. PTA16 has no TPM function, so the compare match
+ * of TPM1 channel TCRT5000_SYNC_CHANNEL requests DMA channel
+ * TCRT5000_DMA_CHANNEL, which writes the pin mask to PTOR. The conversions
+ * are triggered by the TPM1 overflow, so every conversion starts exactly
+ * \p settle_us after the IR LED was switched, independent of the interrupt
+ * latency. There is a DMA interrupt every 262143 edges only, to reload the
+ * byte count.
+ *
+ * The results are taken with tcrt5000_lockin_wait() and the window with
+ * tcrt5000_lockin_set_cycles(). TPM1 and ADC0 are taken until
+ * tcrt5000_sync_stop().
+ *
+ * \param[in]  mod_hz     Modulation frequency, up to TCRT5000_DMA_MAX_HZ / 2
+ *                        and limited by the hardware averaging
+ * \param[in]  settle_us  Time from switching the IR LED to the conversion,
+ *                        the conversion must end within the half period
+ * \param[in]  task       Task that calls tcrt5000_lockin_wait()
+ *
+ * \return False if a parameter is out of range or the DMA channel is used
+ *         by another driver
+ */
+bool tcrt5000_sync_start(const uint32_t mod_hz, const uint32_t settle_us,
+    TaskHandle_t task)
+{
+    const uint32_t rate_hz = 2 * mod_hz;
+
+    if((mod_hz == 0) || (rate_hz > TCRT5000_DMA_MAX_HZ))
+    {
+        return false;
+    }
+
+    if((rate_hz * adc_avg_samples(avg)) > (1000000 / ADC_CONVERSION_US))
+    {
+        return false;
+    }
+
+    if(sync_hz != 0)
+    {
+        tcrt5000_sync_stop();
+    }
+
+    const int32_t ch = dma_claim(TCRT5000_DMA_CHANNEL, tcrt5000_sync_dma_isr,
+        NULL);
+
+    if(ch < 0)
+    {
+        return false;
+    }
+
+    sync_hz = mod_hz;
+    sync_settle_us = settle_us;
+
+    // Stop conversions in interrupt mode, TPM1 is reprogrammed
+    BME_CLR(TPM1->SC, TPM_SC_TOIE_MASK);
+
+    if(!tcrt5000_sync_timing())
+    {
+        tcrt5000_sync_stop();
+        dma_release(ch);
+        return false;
+    }
+
+    sync_ch = ch;
+
+    // Take ADC0 from the conversion service
+    adc_acquire(tcrt5000_sync_isr);
+
+    lockin_n = 0;
+    lockin_sum = 0;
+    lockin_ready = false;
+    lockin_task = task;
+    tcrt5000_lockin_overruns = 0;
+
+    // The first match switches the IR LED off, so the first conversion is
+    // with the IR LED off
+    gpio_clear(GPIO_A, TCRT5000_IR_MASK);
+
+    // ------------------------------------------------------------------------
+
+    // Route the compare request to the DMA channel
+    dma_route(ch, DMA_SOURCE_TPM1_CH1, false);
+
+    // GPIOA, the DMA has no access to the FGPIO of the core
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    DMA0->DMA[ch].SAR = (uint32_t)&sync_toggle;
+    DMA0->DMA[ch].DAR = (uint32_t)&GPIOA->PTOR;
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_BCR(SYNC_BCR);
+
+    // 32-bit transfers, one per request, fixed addresses, interrupt when the
+    // count is used up. ERQ is cleared by hardware when BCR reaches zero.
+    DMA0->DMA[ch].DCR = DMA_DCR_EINT_MASK |
+                        DMA_DCR_ERQ_MASK |
+                        DMA_DCR_CS_MASK |
+                        DMA_DCR_SSIZE(0) |
+                        DMA_DCR_DSIZE(0) |
+                        DMA_DCR_D_REQ_MASK;
+
+    dma_irq_enable(ch, IRQ_PRIO(TCRT5000_DMA));
+
+    // - MSA = 1, ELSx = 0 : Software compare, the pin is not used
+    // - CHIE = 1, DMA = 1 : DMA request on a match, no interrupt
+    TPM1->CONTROLS[TCRT5000_SYNC_CHANNEL].CnSC = TPM_CnSC_CHF_MASK |
+                                                 TPM_CnSC_MSA_MASK |
+                                                 TPM_CnSC_CHIE_MASK |
+                                                 TPM_CnSC_DMA_MASK;
+
+    // ------------------------------------------------------------------------
+
+    ADC0->SC3 = adc_sc3_avg(avg);
+
+    // - ADTRG = 1   : Hardware trigger selected
+    ADC0->SC2 = ADC_SC2_ADTRG(1);
+
+    // - AIEN = 1     : Conversion complete interrupt is enabled
+    // - ADCH = 01000 : Channel 8
+    ADC0->SC1[0] = ADC_SC1_AIEN(1) | ADC_SC1_ADCH(8);
+
+    // ADC0 trigger source select
+    // - ADC0ALTTRGEN = 1  : Alternate trigger selected for ADC0
+    // - ADC0PRETRGSEL = 0 : Pre-trigger A
+    // - ADC0TRGSEL = 1001 : TPM1 overflow
+    SIM->SOPT7 = (SIM->SOPT7 & ~SIM_SOPT7_ADC0TRGSEL_MASK) |
+        SIM_SOPT7_ADC0ALTTRGEN(1) | SIM_SOPT7_ADC0TRGSEL(9);
+
+    return true;
+}
+
+/*!
+ * \brief Stops the synchronous mode and returns to interrupt mode
+ */
+void tcrt5000_sync_stop(void)
+{
+    if(sync_hz == 0)
+    {
+        return;
+    }
+
+    TPM1->CONTROLS[TCRT5000_SYNC_CHANNEL].CnSC = 0;
+
+    if(sync_ch >= 0)
+    {
+        tcrt5000_trigger_stop();
+
+        dma_release(sync_ch);
+        sync_ch = -1;
+
+        lockin_task = NULL;
+
+        adc_release();
+    }
+
+    sync_hz = 0;
+
+    // IR LED off
+    gpio_set(GPIO_A, TCRT5000_IR_MASK);
+
+    // At rate_hz again, see tcrt5000_init()
+    TPM1->SC = 0;
+    TPM1->CNT = 0;
+    TPM1->MOD = tcrt5000_tpm_mod();
+    TPM1->STATUS = TPM_STATUS_TOF(1);
+    TPM1->SC = TPM_SC_PS(0b111) | TPM_SC_TOIE(1) | TPM_SC_CMOD(1);
+}
+
+/*!
+ * \brief DMA interrupt of the synchronous mode, when the byte count is used
+ *        up
+ *
+ * A match during this handler is transferred when ERQ is set again, the
+ * channel flag stays set until then.
+ */
+static void tcrt5000_sync_dma_isr(void *arg, const uint32_t status,
+    BaseType_t *woken)
+{
+    const int32_t ch = sync_ch;
+
+    (void)arg;
+    (void)status;
+    (void)woken;
+
+    // Clear the done and error flags
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+
+    DMA0->DMA[ch].DSR_BCR = DMA_DSR_BCR_BCR(SYNC_BCR);
+    DMA0->DMA[ch].DCR |= DMA_DCR_ERQ_MASK;
+}
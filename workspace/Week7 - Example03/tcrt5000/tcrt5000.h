@@ -33,12 +33,156 @@
 #define TCRT5000_H
 
 #include <MKL25Z4.h>
+#include <stdbool.h>
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "task.h"
+
+#include "adc.h"
+#include "dsp.h"
+#include "gpio.h"
+
+/*!
+ * \brief Pin of the IR LED, PTA16, the LED is on when the pin is low
+ */
+#define TCRT5000_IR_MASK (1UL << 16)
+
+/*!
+ * \brief Number of samples per IR LED state in a DMA block pair
+ */
+#ifndef TCRT5000_BLOCK_SIZE
+#define TCRT5000_BLOCK_SIZE (16)
+#endif
+
+/*!
+ * \brief Rate of the conversion requests of the interrupt mode in Hz
+ */
+#ifndef TCRT5000_RATE_HZ
+#define TCRT5000_RATE_HZ (20)
+#endif
+
+/*!
+ * \brief Lowest and highest rate of tcrt5000_set_rate() in Hz
+ *
+ * The lowest rate keeps the TPM1 modulo within 16 bits at the 48 MHz
+ * peripheral clock of CLK_RUN.
+ */
+#define TCRT5000_RATE_MIN_HZ (6)
+#define TCRT5000_RATE_MAX_HZ (1000)
+
+/*!
+ * \brief Highest sample rate of the DMA acquisition mode in Hz
+ */
+#define TCRT5000_DMA_MAX_HZ (10000)
+
+/*!
+ * \brief DMA channel used by the DMA acquisition mode
+ *
+ * Claimed from the DMA manager by tcrt5000_dma_start(), DMA_ANY for the
+ * highest free channel. Channels 0 and 1 are used by the serial driver,
+ * channel 2 by I2C1.
+ */
+#ifndef TCRT5000_DMA_CHANNEL
+#define TCRT5000_DMA_CHANNEL (3)
+#endif
+
+/*!
+ * \brief TPM1 channel whose compare match switches the IR LED in the
+ *        synchronous mode
+ *
+ * Channel 0 is the compare channel of the timer service.
+ */
+#ifndef TCRT5000_SYNC_CHANNEL
+#define TCRT5000_SYNC_CHANNEL (1)
+#endif
+
+/*!
+ * \brief Number of on/off differences buffered in interrupt mode, a power of
+ *        two
+ */
+#ifndef TCRT5000_RING_SIZE
+#define TCRT5000_RING_SIZE (32)
+#endif
+
+/*!
+ * \brief Highest number of on/off cycles per lock-in window
+ *
+ * Keeps the integrated result within 32 bits.
+ */
+#define TCRT5000_LOCKIN_MAX_CYCLES (4096)
+
+/*!
+ * \brief Task notification index used to signal buffered differences or a
+ *        completed block pair
+ */
+#ifndef TCRT5000_NOTIFY_INDEX
+#define TCRT5000_NOTIFY_INDEX (0)
+#endif
+
+/*!
+ * \brief Raw conversion results of one block pair
+ *
+ * The ADC result decreases with the reflected light.
+ */
+typedef struct
+{
+    uint16_t on[TCRT5000_BLOCK_SIZE];  ///< Samples with the IR LED on
+    uint16_t off[TCRT5000_BLOCK_SIZE]; ///< Samples with the IR LED off
+}tcrt5000_pair_t;
+
+/*!
+ * \brief Integrated result of one lock-in window
+ */
+typedef struct
+{
+    int32_t sum;     ///< Sum of on minus off brightness over the window
+    uint32_t cycles; ///< Number of on/off cycles in the window
+}tcrt5000_lockin_t;
+
+/*!
+ * \brief One on/off sample pair in interrupt mode
+ */
+typedef struct
+{
+    uint16_t on;  ///< Brightness with the IR LED on
+    uint16_t off; ///< Brightness with the IR LED off
+    int32_t diff; ///< On minus off brightness
+}tcrt5000_reflect_t;
 
 extern TaskHandle_t xADCTaskHandle;
+extern uint32_t tcrt5000_dma_overruns;
+extern uint32_t tcrt5000_ring_overruns;
+extern uint32_t tcrt5000_lockin_overruns;
 
 // Function prototypes
 void tcrt5000_init(void);
+void tcrt5000_set_averaging(const adc_avg_t a);
+bool tcrt5000_set_rate(const uint32_t hz);
+uint32_t tcrt5000_get_rate(void);
+void tcrt5000_set_watermark(const uint32_t n);
+uint32_t tcrt5000_read(int32_t diff[], const uint32_t max,
+    const TickType_t timeout);
+uint32_t tcrt5000_latest(tcrt5000_reflect_t *reflect);
+
+bool tcrt5000_dma_start(const uint32_t rate_hz, TaskHandle_t task);
+void tcrt5000_dma_stop(void);
+const tcrt5000_pair_t *tcrt5000_dma_wait(const TickType_t timeout);
+int32_t tcrt5000_pair_diff(const tcrt5000_pair_t *pair);
+int32_t tcrt5000_pair_filter(const tcrt5000_pair_t *pair, const dsp_biquad_t *f,
+    int16_t out[TCRT5000_BLOCK_SIZE]);
+
+bool tcrt5000_watch_start(const uint32_t rate_hz, const uint16_t threshold,
+    const uint16_t hysteresis, TaskHandle_t task);
+void tcrt5000_watch_stop(void);
+bool tcrt5000_watch_wait(bool *near, const TickType_t timeout);
+
+void tcrt5000_lockin_set_cycles(const uint32_t n);
+bool tcrt5000_lockin_start(const uint32_t mod_hz, TaskHandle_t task);
+void tcrt5000_lockin_stop(void);
+bool tcrt5000_lockin_wait(tcrt5000_lockin_t *result, const TickType_t timeout);
+
+bool tcrt5000_sync_start(const uint32_t mod_hz, const uint32_t settle_us,
+    TaskHandle_t task);
+void tcrt5000_sync_stop(void);
 
 #endif // TCRT5000_H
@@ -0,0 +1,551 @@
+/*! ***************************************************************************
+ *
+ * \brief     COBS framed binary telemetry
+ * \file      telemetry.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <string.h>
+
+#include "telemetry.h"
+#include "tlm_pack.h"
+#include "task.h"
+#include "pool.h"
+#include "sections.h"
+#include "runtime_stats.h"
+#include "rtt.h"
+#include "trace.h"
+#include "usbcdc.h"
+
+// Header, payload and CRC
+#define TLM_RAW_MAX   (sizeof(tlm_header_t) + TLM_MAX_PAYLOAD + 2)
+
+// COBS adds at most one byte per 254 bytes, plus the delimiter
+#define TLM_FRAME_MAX (TLM_RAW_MAX + (TLM_RAW_MAX / 254) + 2)
+
+// Buffers for encoding a record, taken from a pool instead of the stack of
+// every task that sends records. The serial transmit DMA reads the frames,
+// so the pool is placed in SRAM_U.
+typedef struct
+{
+    uint8_t raw[TLM_RAW_MAX];
+    uint8_t frame[TLM_FRAME_MAX];
+}
+tlm_buffer_t;
+
+static __BSS_SRAM_U POOL_STORAGE(tlm_buffer_storage, sizeof(tlm_buffer_t), TLM_FRAME_BUFFERS);
+static pool_t tlm_buffers;
+
+static xComPortHandle tlm_port = NULL;
+static tlm_sink_t tlm_sink = NULL;
+static uint16_t tlm_seq = 0;
+
+// Task snapshot of tlm_tasks(), static so sending never allocates, and the
+// flag that it is in use by a task
+static TaskStatus_t tlm_snapshot[TLM_MAX_TASKS];
+static bool tlm_snapshot_busy = false;
+
+// One of every tlm_decimation sensor samples is sent, and the samples of
+// every stream since the last one that was sent
+static volatile uint32_t tlm_decimation = 1;
+static uint32_t tlm_mma8451_skip = 0;
+static uint32_t tlm_tcrt5000_skip = 0;
+
+#if (TLM_PACK == 1)
+// Streams of the sensor samples
+static tlm_pack_t tlm_mma8451_stream;
+static tlm_pack_t tlm_tcrt5000_stream;
+#endif
+
+/*!
+ * \brief Calculates the CRC-16/CCITT-FALSE of a buffer
+ *
+ * Polynomial 0x1021, initial value 0xFFFF, no reflection, no final XOR.
+ */
+uint16_t tlm_crc16(const uint8_t *data, uint32_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    while(len--)
+    {
+        crc ^= (uint16_t)(*data++) << 8;
+
+        for(uint32_t i=0; i<8; i++)
+        {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/*!
+ * \brief COBS encodes a buffer and appends the 0x00 delimiter
+ *
+ * \param[in]  src  Data to encode
+ * \param[in]  len  Number of bytes in src
+ * \param[out] dst  Encoded frame, at least len + len/254 + 2 bytes
+ *
+ * \return Number of bytes in dst
+ */
+uint32_t tlm_cobs_encode(const uint8_t *src, uint32_t len, uint8_t *dst)
+{
+    uint32_t code_idx = 0;
+    uint32_t out = 1;
+    uint8_t code = 1;
+
+    for(uint32_t i=0; i<len; i++)
+    {
+        if(src[i] == 0)
+        {
+            dst[code_idx] = code;
+            code_idx = out++;
+            code = 1;
+        }
+        else
+        {
+            dst[out++] = src[i];
+            code++;
+
+            if(code == 0xFF)
+            {
+                dst[code_idx] = code;
+                code_idx = out++;
+                code = 1;
+            }
+        }
+    }
+
+    dst[code_idx] = code;
+    dst[out++] = 0x00;
+
+    return out;
+}
+
+/*!
+ * \brief Decodes a COBS frame without its 0x00 delimiter
+ *
+ * \param[in]  src  Encoded frame
+ * \param[in]  len  Number of bytes in src
+ * \param[out] dst  Decoded data, at least len bytes
+ *
+ * \return Number of bytes in dst, 0 if the frame is not valid
+ */
+uint32_t tlm_cobs_decode(const uint8_t *src, uint32_t len, uint8_t *dst)
+{
+    uint32_t in = 0;
+    uint32_t out = 0;
+
+    while(in < len)
+    {
+        const uint8_t code = src[in++];
+
+        if((code == 0) || ((in + code - 1) > len))
+        {
+            return 0;
+        }
+
+        for(uint32_t i=1; i<code; i++)
+        {
+            dst[out++] = src[in++];
+        }
+
+        if((code < 0xFF) && (in < len))
+        {
+            dst[out++] = 0;
+        }
+    }
+
+    return out;
+}
+
+/*!
+ * \brief Initializes the telemetry stream
+ *
+ * \param[in]  port  Serial port the frames are written to. Use a port that
+ *                   carries no text, or let the host resynchronise on the
+ *                   0x00 delimiters and the CRC.
+ */
+void tlm_init(xComPortHandle port)
+{
+    pool_init(&tlm_buffers, "tlm_buffers", tlm_buffer_storage,
+        sizeof(tlm_buffer_t), TLM_FRAME_BUFFERS);
+
+    tlm_port = port;
+
+#if (TLM_PACK == 1)
+    tlm_pack_init(&tlm_mma8451_stream, TLM_MMA8451, 3, 3 * sizeof(int16_t));
+    tlm_pack_init(&tlm_tcrt5000_stream, TLM_TCRT5000, 1, sizeof(int32_t));
+#endif
+}
+
+/*!
+ * \brief Sends the records of tlm_send() to a sink instead of the serial
+ *        port
+ *
+ * Records of tlm_trace() on the RTT trace channel are not redirected.
+ *
+ * \param[in]  sink  Function that sends a record, NULL for the serial port
+ */
+void tlm_redirect(tlm_sink_t sink)
+{
+    tlm_sink = sink;
+}
+
+/*!
+ * \brief Writes a frame to the RTT trace channel
+ *
+ * Waits up to TLM_RTT_WAIT_MS for the probe to make room, the trace ring is
+ * sent in a burst that is larger than the RTT ring.
+ *
+ * \return false if the frame was not written
+ */
+static bool tlm_rtt_write(const uint8_t *frame, const uint32_t n)
+{
+    for(uint32_t ms=0; ms<TLM_RTT_WAIT_MS; ms++)
+    {
+        if(rtt_write(RTT_TRACE, frame, n) == n)
+        {
+            return true;
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+
+    return false;
+}
+
+/*!
+ * \brief Sends a single telemetry record to the serial port or to RTT
+ *
+ * \param[in]  type     Record type
+ * \param[in]  payload  Record payload
+ * \param[in]  len      Number of bytes in payload, at most TLM_MAX_PAYLOAD
+ * \param[in]  rtt      Send on the RTT trace channel
+ */
+static bool tlm_send_to(const tlm_type_t type, const void *payload,
+    const uint8_t len, const bool rtt)
+{
+    tlm_header_t header;
+    uint32_t n;
+    uint16_t crc;
+
+    if(len > TLM_MAX_PAYLOAD)
+    {
+        return false;
+    }
+
+    if(!rtt && (tlm_sink != NULL))
+    {
+        return tlm_sink(type, payload, len);
+    }
+
+    if((tlm_port == NULL) && !rtt && (TLM_USBCDC == 0))
+    {
+        return false;
+    }
+
+    tlm_buffer_t *buf = pool_alloc(&tlm_buffers);
+
+    if(buf == NULL)
+    {
+        return false;
+    }
+
+    uint8_t *raw = buf->raw;
+
+    header.version = TLM_VERSION;
+    header.type = (uint8_t)type;
+    header.timestamp = ulRunTimeTicks();
+
+    taskENTER_CRITICAL();
+    {
+        header.seq = tlm_seq++;
+    }
+    taskEXIT_CRITICAL();
+
+    memcpy(raw, &header, sizeof(header));
+    memcpy(&raw[sizeof(header)], payload, len);
+    n = sizeof(header) + len;
+
+    crc = tlm_crc16(raw, n);
+    raw[n++] = (uint8_t)(crc & 0xFF);
+    raw[n++] = (uint8_t)(crc >> 8);
+
+    n = tlm_cobs_encode(raw, n, buf->frame);
+
+#if (TLM_USBCDC == 1)
+    const bool ret = rtt ? tlm_rtt_write(buf->frame, n) :
+        (xUsbCdcWrite(buf->frame, n) == n);
+#else
+    const bool ret = rtt ? tlm_rtt_write(buf->frame, n) :
+        (xSerialPortWrite(tlm_port, buf->frame, n) == n);
+#endif
+
+    pool_free(&tlm_buffers, buf);
+
+    return ret;
+}
+
+/*!
+ * \brief Sends a single telemetry record
+ *
+ * Must be called from a task, as the serial port is protected by a mutex.
+ *
+ * \param[in]  type     Record type
+ * \param[in]  payload  Record payload
+ * \param[in]  len      Number of bytes in payload, at most TLM_MAX_PAYLOAD
+ *
+ * \return false if the record was too large, no frame buffer was free or
+ *         the record was not completely written
+ */
+bool tlm_send(const tlm_type_t type, const void *payload, const uint8_t len)
+{
+    return tlm_send_to(type, payload, len, false);
+}
+
+/*!
+ * \brief Sends one of every n sensor samples
+ *
+ * Lowers the rate of the TLM_MMA8451 and TLM_TCRT5000 streams without
+ * changing the sensors, the other records are not affected. The samples
+ * in between are left out, the first sample after them is sent.
+ *
+ * \param[in]  n  1 to send every sample
+ */
+void tlm_set_decimation(const uint32_t n)
+{
+    tlm_decimation = (n > 0) ? n : 1;
+}
+
+/*!
+ * \brief Returns true if a sample of a stream is left out
+ */
+static bool tlm_decimate(uint32_t *skip)
+{
+    if(++(*skip) < tlm_decimation)
+    {
+        return true;
+    }
+
+    *skip = 0;
+    return false;
+}
+
+/*!
+ * \brief Sends an MMA8451 sample
+ *
+ * With TLM_PACK the sample is added to a packed stream, which is sent when
+ * its record is full. A sample left out by tlm_set_decimation() counts as
+ * sent.
+ */
+bool tlm_mma8451(const int16_t x, const int16_t y, const int16_t z)
+{
+    if(tlm_decimate(&tlm_mma8451_skip))
+    {
+        return true;
+    }
+
+#if (TLM_PACK == 1)
+    const int32_t sample[3] = {x, y, z};
+
+    return tlm_pack_add(&tlm_mma8451_stream, sample);
+#else
+    int16_t payload[3] = {x, y, z};
+
+    return tlm_send(TLM_MMA8451, payload, sizeof(payload));
+#endif
+}
+
+/*!
+ * \brief Sends a TCRT5000 ADC difference
+ *
+ * With TLM_PACK the difference is added to a packed stream, which is sent
+ * when its record is full. A sample left out by tlm_set_decimation() counts
+ * as sent.
+ */
+bool tlm_tcrt5000(const int32_t diff)
+{
+    if(tlm_decimate(&tlm_tcrt5000_skip))
+    {
+        return true;
+    }
+
+#if (TLM_PACK == 1)
+    return tlm_pack_add(&tlm_tcrt5000_stream, &diff);
+#else
+    return tlm_send(TLM_TCRT5000, &diff, sizeof(diff));
+#endif
+}
+
+/*!
+ * \brief Returns the statistics of the packed sensor streams together
+ *
+ * All zero without TLM_PACK.
+ *
+ * \param[out]  stats  Sum of the statistics of all streams
+ */
+void tlm_get_pack_stats(tlm_pack_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+
+#if (TLM_PACK == 1)
+    const tlm_pack_t *streams[] = {&tlm_mma8451_stream, &tlm_tcrt5000_stream};
+
+    for(uint32_t i=0; i<(sizeof(streams) / sizeof(streams[0])); ++i)
+    {
+        tlm_pack_stats_t s;
+
+        tlm_pack_get_stats(streams[i], &s);
+
+        stats->samples += s.samples;
+        stats->raw_bytes += s.raw_bytes;
+        stats->packed_bytes += s.packed_bytes;
+        stats->records += s.records;
+        stats->keyframes += s.keyframes;
+        stats->failed += s.failed;
+    }
+#endif
+}
+
+/*!
+ * \brief Sends the RTC time in seconds
+ */
+bool tlm_rtc(const uint32_t seconds)
+{
+    return tlm_send(TLM_RTC, &seconds, sizeof(seconds));
+}
+
+/*!
+ * \brief Sends a snapshot of the run-time statistics to the serial port or to
+ *        RTT
+ *
+ * \param[in]  rtt  Send on the RTT trace channel
+ */
+static bool tlm_tasks_to(const bool rtt)
+{
+    const TaskStatus_t *status = tlm_snapshot;
+    tlm_task_t task;
+    bool ret = true;
+    bool busy;
+
+    taskENTER_CRITICAL();
+    {
+        busy = tlm_snapshot_busy;
+        tlm_snapshot_busy = true;
+    }
+    taskEXIT_CRITICAL();
+
+    if(busy)
+    {
+        return false;
+    }
+
+    const UBaseType_t n = uxTaskGetSystemState(tlm_snapshot, TLM_MAX_TASKS, NULL);
+
+    if(n == 0)
+    {
+        tlm_snapshot_busy = false;
+        return false;
+    }
+
+    for(UBaseType_t i=0; i<n; i++)
+    {
+        task.number = (uint8_t)status[i].xTaskNumber;
+        task.state = (uint8_t)status[i].eCurrentState;
+        task.priority = (uint8_t)status[i].uxCurrentPriority;
+        task.reserved = 0;
+        task.runtime = (uint32_t)(status[i].ulRunTimeCounter / rtsCOUNTS_PER_TICK);
+        task.stack_free = status[i].usStackHighWaterMark;
+        strncpy(task.name, status[i].pcTaskName, sizeof(task.name));
+
+        ret &= tlm_send_to(TLM_TASK, &task, sizeof(task), rtt);
+    }
+
+    tlm_snapshot_busy = false;
+
+    return ret;
+}
+
+/*!
+ * \brief Sends a snapshot of the run-time statistics, one record per task
+ *
+ * The snapshot buffer is static. Fails if another task is sending a
+ * snapshot or there are more than TLM_MAX_TASKS tasks.
+ */
+bool tlm_tasks(void)
+{
+    return tlm_tasks_to(false);
+}
+
+/*!
+ * \brief Sends the contents of the trace ring
+ *
+ * First the task records, which map task numbers to names, then a
+ * TRACE_INFO record followed by the events, oldest first. The recorder is
+ * suspended while the ring is sent. See tools/trace_convert.py for the
+ * host side. With TLM_TRACE_RTT the frames go to the RTT trace channel.
+ */
+bool tlm_trace(void)
+{
+#if (TRACE_ENABLED == 1)
+    trace_record_t records[TLM_MAX_PAYLOAD / sizeof(trace_record_t)];
+    const bool rtt = (TLM_TRACE_RTT == 1);
+    bool ret = tlm_tasks_to(rtt);
+
+    const bool was = trace_stop();
+
+    const uint32_t head = trace_ring.head;
+    const uint32_t lost = (head > TRACE_BUFFER_SIZE) ?
+        (head - TRACE_BUFFER_SIZE) : 0;
+
+    records[0].time = TRACE_HZ;
+    records[0].type = TRACE_INFO;
+    records[0].task = 0;
+    records[0].arg = (lost > 0xFFFF) ? 0xFFFF : (uint16_t)lost;
+
+    ret &= tlm_send_to(TLM_TRACE, records, sizeof(records[0]), rtt);
+
+    uint32_t first = 0;
+    uint32_t n;
+
+    while((n = trace_read(records, first,
+        sizeof(records) / sizeof(records[0]))) > 0)
+    {
+        ret &= tlm_send_to(TLM_TRACE, records, n * sizeof(records[0]), rtt);
+        first += n;
+    }
+
+    if(was)
+    {
+        (void)trace_start();
+    }
+
+    return ret;
+#else
+    return false;
+#endif
+}
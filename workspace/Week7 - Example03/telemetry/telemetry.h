@@ -0,0 +1,170 @@
+/*! ***************************************************************************
+ *
+ * \brief     COBS framed binary telemetry
+ * \file      telemetry.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <MKL25Z4.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "serial.h"
+
+/// \name Definitions for the telemetry stream
+/// \{
+
+/*!
+ * \brief Version of the record layout. Increment when a record changes.
+ */
+#define TLM_VERSION          (1)
+
+/*!
+ * \brief Maximum payload size of a record in bytes
+ */
+#define TLM_MAX_PAYLOAD      (32)
+
+/*!
+ * \brief Maximum number of tasks in a tlm_tasks() snapshot
+ */
+#ifndef TLM_MAX_TASKS
+#define TLM_MAX_TASKS        (10)
+#endif
+
+/*!
+ * \brief Number of frame buffers, the number of tasks that can send a
+ *        record at the same time
+ */
+#ifndef TLM_FRAME_BUFFERS
+#define TLM_FRAME_BUFFERS    (2)
+#endif
+
+/*!
+ * \brief Set to 1 to send the frames of tlm_trace() on the RTT trace channel
+ *        instead of the serial port
+ */
+#ifndef TLM_TRACE_RTT
+#define TLM_TRACE_RTT        (0)
+#endif
+
+/*!
+ * \brief Set to 1 to send the frames on the USB virtual COM port instead of
+ *        the serial port given to tlm_init(), needs USBCDC_ENABLED
+ */
+#ifndef TLM_USBCDC
+#define TLM_USBCDC           (0)
+#endif
+
+/*!
+ * \brief Time a frame of tlm_trace() waits for room in the RTT ring, in ms
+ */
+#define TLM_RTT_WAIT_MS      (10)
+
+/// \}
+
+/*!
+ * \brief Record types
+ *
+ * Every frame holds one record: an 8 byte header, the payload and a
+ * CRC-16/CCITT-FALSE over header and payload, all little endian. The frame
+ * is COBS encoded and terminated by a 0x00 byte. See
+ * tools/telemetry_decode.py for the host side.
+ */
+typedef enum
+{
+    TLM_MMA8451  = 1,   ///< int16_t x, y, z (raw 14-bit counts)
+    TLM_TCRT5000 = 2,   ///< int32_t ADC difference (IR on - IR off)
+    TLM_RTC      = 3,   ///< uint32_t seconds since 1970
+    TLM_TASK     = 4,   ///< One row of the run-time statistics
+    TLM_TRACE    = 5,   ///< Up to four trace_record_t, see tlm_trace()
+    TLM_VIBRATION = 6,  ///< vib_features_t of one axis, see vibration.h
+    TLM_NODE     = 7,   ///< tlm_node_t and the payload of a record of another
+                        ///< board, forwarded by the link, see link.h
+    TLM_PACKED   = 8,   ///< tlm_pack_header_t and delta coded samples of
+                        ///< another type, see tlm_pack.h
+}
+tlm_type_t;
+
+/// Record header
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;   ///< TLM_VERSION
+    uint8_t  type;      ///< tlm_type_t
+    uint16_t seq;       ///< Incremented for every record, detects lost frames
+    uint32_t timestamp; ///< ulRunTimeTicks() (100 us resolution)
+}
+tlm_header_t;
+
+/// Payload of TLM_TASK records
+typedef struct __attribute__((packed))
+{
+    uint8_t  number;        ///< Task number
+    uint8_t  state;         ///< eTaskState
+    uint8_t  priority;      ///< Current priority
+    uint8_t  reserved;
+    uint32_t runtime;       ///< Run time in ulRunTimeTicks() units
+    uint16_t stack_free;    ///< Stack high water mark in words
+    char     name[configMAX_TASK_NAME_LEN];
+}
+tlm_task_t;
+
+/// Payload of TLM_NODE records, followed by the payload of the record
+typedef struct __attribute__((packed))
+{
+    uint8_t  node;          ///< Board that sent the record, see LINK_NODE
+    uint8_t  type;          ///< tlm_type_t of the record
+    uint32_t time_us;       ///< mono_us() of this board when the record was
+                            ///< sent, lower 32 bits
+}
+tlm_node_t;
+
+/*!
+ * \brief Sends a record somewhere else than the serial port
+ *
+ * \return false if the record was not sent
+ */
+typedef bool (*tlm_sink_t)(const tlm_type_t type, const void *payload,
+                           const uint8_t len);
+
+// Function prototypes
+void tlm_init(xComPortHandle port);
+void tlm_redirect(tlm_sink_t sink);
+bool tlm_send(const tlm_type_t type, const void *payload, const uint8_t len);
+
+uint16_t tlm_crc16(const uint8_t *data, uint32_t len);
+uint32_t tlm_cobs_encode(const uint8_t *src, uint32_t len, uint8_t *dst);
+uint32_t tlm_cobs_decode(const uint8_t *src, uint32_t len, uint8_t *dst);
+
+bool tlm_mma8451(const int16_t x, const int16_t y, const int16_t z);
+bool tlm_tcrt5000(const int32_t diff);
+void tlm_set_decimation(const uint32_t n);
+bool tlm_rtc(const uint32_t seconds);
+bool tlm_tasks(void);
+bool tlm_trace(void);
+
+#endif // TELEMETRY_H
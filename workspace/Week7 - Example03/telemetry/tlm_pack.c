@@ -0,0 +1,213 @@
+/*! ***************************************************************************
+ *
+ * \brief     Delta and varint packing of telemetry sample streams
+ * \file      tlm_pack.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <string.h>
+
+#include "tlm_pack.h"
+#include "task.h"
+
+/*
+ * Consecutive samples of a sensor differ little, so every value is sent as
+ * the difference to the same channel of the previous sample, zig-zag
+ * mapped so small negative differences are small too, in a varint of 7
+ * bits per byte with the high bit set on all but the last byte. A
+ * difference below 64 takes one byte instead of the two or four of the
+ * value. The first sample of a keyframe is the difference to 0, the
+ * absolute value.
+ *
+ * Samples are gathered in a record until the next sample might not fit,
+ * so the header and CRC of a frame are shared by several samples. A value
+ * takes at most 5 bytes and a bounded loop of at most 5 steps, no
+ * division or table, in the order of 20 cycles per channel on the
+ * Cortex-M0+.
+ *
+ * The timestamp of a record is that of its last sample. See
+ * tools/telemetry_decode.py for the host side.
+ */
+
+// Longest varint of a 32-bit value
+#define TLM_PACK_VARINT_MAX  (5)
+
+/*!
+ * \brief Writes a value as a zig-zag varint
+ *
+ * \param[in]  value  Value to write
+ * \param[out] dst    At least 5 bytes
+ *
+ * \return Number of bytes written, 1 to 5
+ */
+uint32_t tlm_pack_varint(const int32_t value, uint8_t *dst)
+{
+    uint32_t u = ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+    uint32_t n = 0;
+
+    while(u >= 0x80)
+    {
+        dst[n++] = (uint8_t)(u | 0x80);
+        u >>= 7;
+    }
+
+    dst[n++] = (uint8_t)u;
+
+    return n;
+}
+
+/*!
+ * \brief Initialises a stream, its first record is a keyframe
+ *
+ * \param[out] p         Stream
+ * \param[in]  type      Record type of the unpacked samples
+ * \param[in]  channels  Values per sample, 1 to TLM_PACK_CHANNELS
+ * \param[in]  raw_size  Payload bytes of an unpacked sample, for the
+ *                       statistics
+ */
+void tlm_pack_init(tlm_pack_t *p, const tlm_type_t type,
+    const uint8_t channels, const uint8_t raw_size)
+{
+    memset(p, 0, sizeof(*p));
+
+    p->type = type;
+    p->channels = (channels > TLM_PACK_CHANNELS) ? TLM_PACK_CHANNELS : channels;
+    p->raw_size = raw_size;
+    p->len = TLM_PACK_HEADER;
+}
+
+/*!
+ * \brief Adds a sample to a stream
+ *
+ * The record is sent when the next sample might not fit in it.
+ *
+ * \param[in,out]  p       Stream
+ * \param[in]      sample  One value per channel
+ *
+ * \return false if a record was not sent
+ */
+bool tlm_pack_add(tlm_pack_t *p, const int32_t sample[])
+{
+    tlm_pack_header_t *header = (tlm_pack_header_t *)p->payload;
+
+    if(header->samples == 0)
+    {
+        // A new record, the first of a keyframe is sent absolute
+        header->type = (uint8_t)p->type;
+        header->channels = p->channels;
+        header->flags = (p->since_key == 0) ? TLM_PACK_KEY : 0;
+
+        if(header->flags & TLM_PACK_KEY)
+        {
+            memset(p->last, 0, sizeof(p->last));
+        }
+    }
+
+    for(uint32_t i=0; i<p->channels; ++i)
+    {
+        // Modulo 2^32, the host wraps the sum in the same way
+        const int32_t delta = (int32_t)((uint32_t)sample[i] - (uint32_t)p->last[i]);
+
+        p->len += tlm_pack_varint(delta, &p->payload[p->len]);
+        p->last[i] = sample[i];
+    }
+
+    header->samples++;
+
+    p->stats.samples++;
+    p->stats.raw_bytes += sizeof(tlm_header_t) + p->raw_size + 2;
+
+    if(((p->len + (p->channels * TLM_PACK_VARINT_MAX)) > TLM_MAX_PAYLOAD) ||
+       (header->samples == UINT8_MAX))
+    {
+        return tlm_pack_flush(p);
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Sends the samples gathered in a stream
+ *
+ * Call to bound the latency of a slow stream. A record that is not sent
+ * starts the next record with a keyframe, the host misses it.
+ *
+ * \param[in,out]  p  Stream
+ *
+ * \return false if the record was not sent, true if it was sent or empty
+ */
+bool tlm_pack_flush(tlm_pack_t *p)
+{
+    tlm_pack_header_t *header = (tlm_pack_header_t *)p->payload;
+
+    if(header->samples == 0)
+    {
+        return true;
+    }
+
+    const bool key = (header->flags & TLM_PACK_KEY) != 0;
+    const bool ret = tlm_send(TLM_PACKED, p->payload, p->len);
+
+    taskENTER_CRITICAL();
+    {
+        if(ret)
+        {
+            p->stats.records++;
+            p->stats.keyframes += key ? 1 : 0;
+            p->stats.packed_bytes += sizeof(tlm_header_t) + p->len + 2;
+        }
+        else
+        {
+            p->stats.failed++;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    p->since_key = (!ret || ((p->since_key + 1) >= TLM_PACK_KEYFRAME)) ? 0 :
+        (p->since_key + 1);
+
+    header->samples = 0;
+    p->len = TLM_PACK_HEADER;
+
+    return ret;
+}
+
+/*!
+ * \brief Copies the statistics of a stream
+ *
+ * The compression ratio is raw_bytes / packed_bytes.
+ *
+ * \param[in]   p      Stream
+ * \param[out]  stats  Statistics
+ */
+void tlm_pack_get_stats(const tlm_pack_t *p, tlm_pack_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    {
+        *stats = p->stats;
+    }
+    taskEXIT_CRITICAL();
+}
@@ -0,0 +1,125 @@
+/*! ***************************************************************************
+ *
+ * \brief     Delta and varint packing of telemetry sample streams
+ * \file      tlm_pack.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef TLM_PACK_H
+#define TLM_PACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "telemetry.h"
+
+/// \name Definitions for the packed sample streams
+/// \{
+
+/*!
+ * \brief Set to 1 to send the samples of tlm_mma8451() and tlm_tcrt5000()
+ *        in TLM_PACKED records instead of one record per sample
+ */
+#ifndef TLM_PACK
+#define TLM_PACK             (0)
+#endif
+
+/*!
+ * \brief Maximum number of channels of a stream
+ */
+#define TLM_PACK_CHANNELS    (4)
+
+/*!
+ * \brief Records between two keyframes of a stream
+ *
+ * A keyframe holds the absolute values of its first sample. After a lost
+ * frame the host decodes the stream again from the next keyframe, so the
+ * samples of up to this many records are lost with it.
+ */
+#ifndef TLM_PACK_KEYFRAME
+#define TLM_PACK_KEYFRAME    (8)
+#endif
+
+/// Bytes in front of the samples of a TLM_PACKED payload
+#define TLM_PACK_HEADER      (4)
+
+/// Flag of a keyframe in tlm_pack_header_t
+#define TLM_PACK_KEY         (0x01)
+
+/// \}
+
+/// Start of the payload of TLM_PACKED records, followed by the samples
+typedef struct __attribute__((packed))
+{
+    uint8_t type;           ///< tlm_type_t of the unpacked samples
+    uint8_t flags;          ///< TLM_PACK_KEY
+    uint8_t channels;       ///< Values per sample
+    uint8_t samples;        ///< Samples in the record
+}
+tlm_pack_header_t;
+
+/// Stream statistics, bytes are those of the records before COBS
+typedef struct
+{
+    uint32_t samples;       ///< Samples added
+    uint32_t raw_bytes;     ///< Bytes as one record per sample
+    uint32_t packed_bytes;  ///< Bytes of the sent TLM_PACKED records
+    uint32_t records;       ///< Sent records
+    uint32_t keyframes;     ///< Sent keyframes
+    uint32_t failed;        ///< Records that were not sent
+}
+tlm_pack_stats_t;
+
+/*!
+ * \brief A stream of samples of one record type
+ *
+ * Initialise with tlm_pack_init(). A stream is used by a single task.
+ */
+typedef struct
+{
+    tlm_type_t type;                  ///< Type of the unpacked samples
+    uint8_t channels;                 ///< Values per sample
+    uint8_t raw_size;                 ///< Payload bytes of an unpacked sample
+    uint8_t len;                      ///< Bytes in payload
+    uint8_t since_key;                ///< Records since the last keyframe
+    int32_t last[TLM_PACK_CHANNELS];  ///< Previous sample
+    uint8_t payload[TLM_MAX_PAYLOAD]; ///< The record being filled
+    tlm_pack_stats_t stats;
+}
+tlm_pack_t;
+
+// Function prototypes
+void tlm_pack_init(tlm_pack_t *p, const tlm_type_t type,
+    const uint8_t channels, const uint8_t raw_size);
+bool tlm_pack_add(tlm_pack_t *p, const int32_t sample[]);
+bool tlm_pack_flush(tlm_pack_t *p);
+void tlm_pack_get_stats(const tlm_pack_t *p, tlm_pack_stats_t *stats);
+
+uint32_t tlm_pack_varint(const int32_t value, uint8_t *dst);
+
+void tlm_get_pack_stats(tlm_pack_stats_t *stats);
+
+#endif // TLM_PACK_H
@@ -0,0 +1,479 @@
+/*! ***************************************************************************
+ *
+ * \brief     Hardware timer service with us resolution on TPM1
+ * \file      timer.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <MKL25Z4.h>
+#include <stddef.h>
+
+#include "timer.h"
+
+#include "bme.h"
+#include "clock.h"
+#include "irq_prio.h"
+#include "timers.h"
+#include "vectors.h"
+
+// A deadline this close is handled as expired, the compare value could be
+// passed before it is written
+#define TIM_MARGIN_TICKS (3 * ticks_per_us)
+
+#define TIM_US_TO_TICKS(us) ((us) * ticks_per_us)
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+
+// Active timers, sorted by deadline
+static tim_timer_t *volatile head = NULL;
+
+// Upper 16 bits of the 32-bit tick count
+static volatile uint32_t overflows = 0;
+
+// Counter ticks in a us at the current clock mode
+static uint32_t ticks_per_us = 3;
+
+// Registration for clock mode changes
+static clk_notifier_t clock;
+
+// Handler of the driver that took TPM1 with tim_tpm1_handover(), NULL while
+// TPM1 runs the timer service
+static volatile irq_handler_t tpm1_owner = NULL;
+
+static void tim_clock(const clk_event_t event, void *arg);
+static void tim_program(void);
+IRQ_HANDLER(TPM1_IRQHandler, tim_irq_handler);
+
+/*!
+ * \brief Returns the TPM1 prescaler for the current peripheral clock and
+ *        sets ticks_per_us
+ */
+static uint32_t tim_prescaler(void)
+{
+    const uint32_t hz = clk_periph_hz();
+
+    for(uint32_t ps=0; ps<8; ++ps)
+    {
+        if((((hz >> ps) % 1000000UL) == 0) &&
+           ((hz >> ps) <= TIM_MAX_TICKS_PER_US * 1000000UL))
+        {
+            ticks_per_us = (hz >> ps) / 1000000UL;
+            return ps;
+        }
+    }
+
+    // No whole number of ticks in a us
+    configASSERT(0);
+    return 0;
+}
+
+/*!
+ * \brief Initialises TPM1 for the timer service
+ *
+ * TPM1 only counts while a timer is active, so it does not keep the MCU out
+ * of the stop modes when there is nothing to time. Compare channel 0 is set
+ * to the earliest deadline in the next 16-bit counter period, the overflow
+ * interrupt extends the counter to 32 bits.
+ */
+void tim_init(void)
+{
+    // Clock to TPM1 on, counter stopped
+    clk_gate_acquire(CLK_GATE_TPM1);
+    TPM1->SC = 0;
+
+    // The TPM clock is the peripheral clock of the clock manager
+    TPM1->MOD = 0xFFFF;
+
+    // Channel 0 in software compare mode, the pin is not used
+    TPM1->CONTROLS[0].CnSC = TPM_CnSC_MSA(1);
+    TPM1->CONTROLS[0].CnV = 0;
+
+    // Prescale Factor of the clock mode, overflow interrupt
+    TPM1->STATUS = TPM_STATUS_TOF(1) | TPM_STATUS_CH0F(1);
+    TPM1->SC = TPM_SC_PS(tim_prescaler()) | TPM_SC_TOIE(1);
+
+    clk_register(&clock, tim_clock, NULL);
+
+    // Enable Interrupts
+    tpm1_owner = NULL;
+    IRQ_INSTALL(TPM1_IRQn, tim_irq_handler);
+    NVIC_SetPriority(TPM1_IRQn, IRQ_PRIO(TIMER));
+    NVIC_ClearPendingIRQ(TPM1_IRQn);
+    NVIC_EnableIRQ(TPM1_IRQn);
+}
+
+/*!
+ * \brief Returns the 32-bit tick count, call with interrupts masked
+ */
+static uint32_t tim_now(void)
+{
+    uint32_t high = overflows;
+    uint32_t cnt = TPM1->CNT;
+
+    // An overflow that is not handled yet
+    if(TPM1->STATUS & TPM_STATUS_TOF_MASK)
+    {
+        high++;
+        cnt = TPM1->CNT;
+    }
+
+    return (high << 16) | cnt;
+}
+
+/*!
+ * \brief Keeps the deadlines over a clock mode change
+ *
+ * Before the change the counter is stopped and the deadlines and periods
+ * are converted to us, after the change they are converted back to ticks of
+ * the new prescaler and the counter restarts from 0. The order of the list
+ * does not change.
+ */
+static void tim_clock(const clk_event_t event, void *arg)
+{
+    (void)arg;
+
+    const uint32_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        if(event == CLK_PRE_CHANGE)
+        {
+            const uint32_t now = tim_now();
+
+            BME_CLR(TPM1->SC, TPM_SC_CMOD_MASK);
+            BME_CLR(TPM1->CONTROLS[0].CnSC, TPM_CnSC_CHIE_MASK);
+
+            for(tim_timer_t *t = head; t != NULL; t = t->next)
+            {
+                const int32_t left = (int32_t)(t->deadline - now);
+
+                t->deadline = (left > 0) ? ((uint32_t)left / ticks_per_us) : 0;
+                t->period /= ticks_per_us;
+            }
+        }
+        else
+        {
+            TPM1->SC = TPM_SC_PS(tim_prescaler()) | TPM_SC_TOIE(1);
+            TPM1->CNT = 0;
+            TPM1->STATUS = TPM_STATUS_TOF(1) | TPM_STATUS_CH0F(1);
+            overflows = 0;
+
+            for(tim_timer_t *t = head; t != NULL; t = t->next)
+            {
+                t->deadline = TIM_US_TO_TICKS(t->deadline);
+                t->period = TIM_US_TO_TICKS(t->period);
+            }
+
+            if(head != NULL)
+            {
+                BME_OR(TPM1->SC, TPM_SC_CMOD(1));
+            }
+
+            tim_program();
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+/*!
+ * \brief Removes a timer from the list, call with interrupts masked
+ */
+static void tim_unlink(tim_timer_t *t)
+{
+    for(tim_timer_t *volatile *p = &head; *p != NULL; p = &(*p)->next)
+    {
+        if(*p == t)
+        {
+            *p = t->next;
+            t->next = NULL;
+            return;
+        }
+    }
+}
+
+/*!
+ * \brief Inserts a timer in the list by deadline, call with interrupts masked
+ *
+ * Timers with the same deadline expire in the order they were inserted.
+ */
+static void tim_insert(tim_timer_t *t)
+{
+    tim_timer_t *volatile *p = &head;
+
+    while((*p != NULL) && ((int32_t)(t->deadline - (*p)->deadline) >= 0))
+    {
+        p = &(*p)->next;
+    }
+
+    t->next = *p;
+    *p = t;
+}
+
+/*!
+ * \brief Sets compare channel 0 to the earliest deadline, call with
+ *        interrupts masked
+ *
+ * Stops the counter when there is no active timer. A deadline beyond the
+ * current 16-bit counter period is set by the overflow interrupt handler.
+ */
+static void tim_program(void)
+{
+    if(head == NULL)
+    {
+        BME_CLR(TPM1->SC, TPM_SC_CMOD_MASK);
+        BME_CLR(TPM1->CONTROLS[0].CnSC, TPM_CnSC_CHIE_MASK);
+        return;
+    }
+
+    const int32_t left = (int32_t)(head->deadline - tim_now());
+
+    if(left < 0x10000)
+    {
+        TPM1->CONTROLS[0].CnV = head->deadline & 0xFFFF;
+        TPM1->STATUS = TPM_STATUS_CH0F(1);
+        BME_OR(TPM1->CONTROLS[0].CnSC, TPM_CnSC_CHIE_MASK);
+
+        // The counter could have passed the compare value already
+        if((int32_t)(head->deadline - tim_now()) <= TIM_MARGIN_TICKS)
+        {
+            NVIC_SetPendingIRQ(TPM1_IRQn);
+        }
+    }
+    else
+    {
+        BME_CLR(TPM1->CONTROLS[0].CnSC, TPM_CnSC_CHIE_MASK);
+    }
+}
+
+/*!
+ * \brief Starts or restarts a timer
+ *
+ * May be called from a task, an interrupt handler or a timer callback.
+ *
+ * \param[in]  t          Timer
+ * \param[in]  delay_us   Time until the first expiry in us, 0 .. TIM_MAX_US
+ * \param[in]  period_us  Time between the following expiries in us, 0 for a
+ *                        one-shot timer or TIM_MIN_PERIOD_US .. TIM_MAX_US
+ */
+void tim_start(tim_timer_t *t, const uint32_t delay_us, const uint32_t period_us)
+{
+    configASSERT((t != NULL) && (t->callback != NULL));
+    configASSERT(delay_us <= TIM_MAX_US);
+    configASSERT((period_us == 0) ||
+        ((period_us >= TIM_MIN_PERIOD_US) && (period_us <= TIM_MAX_US)));
+
+    const uint32_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        tim_unlink(t);
+
+        if(head == NULL)
+        {
+            // Restart the counter, the tick count is only used for deadlines
+            BME_CLR(TPM1->SC, TPM_SC_CMOD_MASK);
+            TPM1->CNT = 0;
+            TPM1->STATUS = TPM_STATUS_TOF(1) | TPM_STATUS_CH0F(1);
+            overflows = 0;
+            BME_OR(TPM1->SC, TPM_SC_CMOD(1));
+        }
+
+        t->deadline = tim_now() + TIM_US_TO_TICKS(delay_us);
+        t->period = TIM_US_TO_TICKS(period_us);
+        t->active = true;
+
+        tim_insert(t);
+        tim_program();
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+/*!
+ * \brief Stops a timer
+ *
+ * A deferred callback that is already pending in the timer task is still
+ * called.
+ *
+ * \param[in]  t  Timer
+ */
+void tim_stop(tim_timer_t *t)
+{
+    const uint32_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        tim_unlink(t);
+        t->active = false;
+        tim_program();
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+/*!
+ * \brief Returns whether a timer is active
+ *
+ * \param[in]  t  Timer
+ *
+ * \return True if the timer will expire, false otherwise
+ */
+bool tim_active(const tim_timer_t *t)
+{
+    return t->active;
+}
+
+/*!
+ * \brief Calls the callback of a deferred timer in the timer task
+ */
+static void tim_deferred(void *p1, uint32_t p2)
+{
+    (void)p2;
+
+    tim_timer_t *t = p1;
+    t->callback(t->arg, NULL);
+}
+
+/*!
+ * \brief Callback of tim_delay_us(), wakes the waiting task
+ */
+static void tim_wake(void *arg, BaseType_t *woken)
+{
+    vTaskNotifyGiveIndexedFromISR((TaskHandle_t)arg, TIM_NOTIFY_INDEX, woken);
+}
+
+/*!
+ * \brief Blocks the calling task for a number of us
+ *
+ * The task is woken by the compare interrupt, so the delay is accurate to a
+ * few us plus the time of a context switch. Only call from a task while the
+ * scheduler is running, a higher priority task may delay the return further.
+ *
+ * \param[in]  us  Delay in us, 0 .. TIM_MAX_US
+ */
+void tim_delay_us(const uint32_t us)
+{
+    configASSERT(xTaskGetSchedulerState() == taskSCHEDULER_RUNNING);
+
+    tim_timer_t t = TIM_TIMER(tim_wake, xTaskGetCurrentTaskHandle());
+
+    ulTaskNotifyTakeIndexed(TIM_NOTIFY_INDEX, pdTRUE, 0);
+    tim_start(&t, us, 0);
+
+    // The notification is given by the last access to t in the handler
+    ulTaskNotifyTakeIndexed(TIM_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+}
+
+/*!
+ * \brief Hands TPM1 and its interrupt over to another driver
+ *
+ * The TCRT5000 driver runs TPM1 in a mode of its own. With IRQ_RAM_VECTORS
+ * \p handler is installed in the vector table. Without it only this driver
+ * defines TPM1_IRQHandler(), which then calls \p handler, so both drivers
+ * can be linked. The timer service must not be used until tim_init() takes
+ * TPM1 back.
+ *
+ * \param[in]  handler  TPM1 interrupt handler of the other driver
+ */
+void tim_tpm1_handover(const irq_handler_t handler)
+{
+#if (IRQ_RAM_VECTORS == 1)
+    (void)irq_register(TPM1_IRQn, handler);
+#else
+    tpm1_owner = handler;
+#endif
+}
+
+/*!
+ * \brief TPM1 interrupt handler
+ *
+ * Called on a compare match with the earliest deadline and on every counter
+ * overflow. Calls or defers the callbacks of all expired timers, periodic
+ * timers are reinserted with their next deadline.
+ */
+IRQ_HANDLER(TPM1_IRQHandler, tim_irq_handler)
+{
+#if (IRQ_RAM_VECTORS == 0)
+    // TPM1 was handed over to another driver
+    const irq_handler_t owner = tpm1_owner;
+    if(owner != NULL)
+    {
+        owner();
+        return;
+    }
+#endif
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    TRACE_ISR_ENTER();
+
+    uint32_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    const uint32_t status = TPM1->STATUS;
+    TPM1->STATUS = status & (TPM_STATUS_TOF_MASK | TPM_STATUS_CH0F_MASK);
+
+    if(status & TPM_STATUS_TOF_MASK)
+    {
+        overflows++;
+    }
+
+    tim_timer_t *t;
+
+    while(((t = head) != NULL) &&
+          ((int32_t)(t->deadline - tim_now()) <= TIM_MARGIN_TICKS))
+    {
+        head = t->next;
+        t->next = NULL;
+
+        if(t->period != 0)
+        {
+            t->deadline += t->period;
+            tim_insert(t);
+        }
+        else
+        {
+            t->active = false;
+        }
+
+        // The callback may start and stop timers, higher priority interrupt
+        // handlers are not delayed by it
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+        {
+            if(t->deferred)
+            {
+                xTimerPendFunctionCallFromISR(tim_deferred, t, 0,
+                    &xHigherPriorityTaskWoken);
+            }
+            else
+            {
+                t->callback(t->arg, &xHigherPriorityTaskWoken);
+            }
+        }
+        mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    }
+
+    tim_program();
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    TRACE_ISR_EXIT();
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
@@ -0,0 +1,132 @@
+/*! ***************************************************************************
+ *
+ * \brief     Hardware timer service with us resolution on TPM1
+ * \file      timer.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "vectors.h"
+
+#if (configUSE_TIMERS != 1)
+#error "Deferred callbacks run in the timer task, set configUSE_TIMERS to 1"
+#endif
+
+/// \name Definitions for the timer service
+/// \{
+
+/*!
+ * \brief Highest number of TPM1 counter ticks in a us
+ *
+ * The prescaler is set to the lowest division of the peripheral clock that
+ * gives a whole number of ticks in a us up to this number: 48 MHz / 16 in
+ * CLK_RUN, 20 MHz / 4 in CLK_FLL and 8 MHz / 2 in CLK_VLPR.
+ */
+#define TIM_MAX_TICKS_PER_US (5)
+
+/*!
+ * \brief Longest delay or period in us
+ *
+ * Deadlines are kept as 32-bit tick counts, compared with signed differences.
+ */
+#define TIM_MAX_US (0x7FFFFFFFUL / TIM_MAX_TICKS_PER_US)
+
+/*!
+ * \brief Shortest period in us of a periodic timer
+ *
+ * A shorter period would keep the CPU in the interrupt handler.
+ */
+#define TIM_MIN_PERIOD_US (20)
+
+/*!
+ * \brief Task notification index used by tim_delay_us()
+ */
+#ifndef TIM_NOTIFY_INDEX
+#define TIM_NOTIFY_INDEX (7)
+#endif
+
+/// \}
+
+/*!
+ * \brief Called when a timer expires
+ *
+ * Called from TPM1_IRQHandler(), or from the timer task for a deferred timer.
+ * The timer may be restarted or stopped from the callback.
+ *
+ * \param[in]  arg    Argument of the timer
+ * \param[out] woken  Set to pdTRUE if a higher priority task was woken, NULL
+ *                    for a deferred timer
+ */
+typedef void (*tim_callback_t)(void *arg, BaseType_t *woken);
+
+/*!
+ * \brief A one-shot or periodic timer
+ *
+ * Initialise with TIM_TIMER() or TIM_TIMER_DEFERRED(). The timer must remain
+ * valid while it is active.
+ */
+typedef struct tim_timer
+{
+    tim_callback_t callback;
+    void *arg;
+    bool deferred;            ///< Call from the timer task
+
+    // Managed by the service
+    uint32_t deadline;        ///< Counter ticks
+    uint32_t period;          ///< Counter ticks, 0 for a one-shot timer
+    volatile bool active;
+    struct tim_timer *next;
+}tim_timer_t;
+
+/*!
+ * \brief Initialiser of a timer with the callback in interrupt context
+ */
+#define TIM_TIMER(cb, a) {.callback = (cb), .arg = (a), .deferred = false}
+
+/*!
+ * \brief Initialiser of a timer with the callback in the timer task
+ */
+#define TIM_TIMER_DEFERRED(cb, a) {.callback = (cb), .arg = (a), .deferred = true}
+
+// Function prototypes
+void tim_init(void);
+
+void tim_start(tim_timer_t *t, const uint32_t delay_us, const uint32_t period_us);
+void tim_stop(tim_timer_t *t);
+bool tim_active(const tim_timer_t *t);
+
+void tim_delay_us(const uint32_t us);
+
+void tim_tpm1_handover(const irq_handler_t handler);
+
+#endif // TIMER_H
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""Decodes the accelerometer bursts (accellog/accellog.c) in a dump of the
+flash log region (flashlog/flashlog.c) to CSV.
+
+The dump is the FLASH_LOG region of the linker script taken over SWD, for
+example with
+    (gdb) dump binary memory flog.bin 0x1e000 0x1fc00
+
+Every sector starts with the magic 'FLOG' and a sequence number, followed by
+records of a header word (type, length, CRC-16/CCITT-FALSE) and the payload
+padded to whole words. The sectors are visited oldest first. Records of type
+ALOG_FLOG_TYPE hold
+
+    t_us:u32 seq:u16 format:u8 count:u8 samples[...]
+
+little-endian. Format 0 packs x, y and z as 14-bit fields, least significant
+bit first, format 1 holds the first sample as three i16 and the others as
+i8 differences.
+
+Every sample is printed as "burst,t_us,x,y,z" in 14-bit counts, the time
+since the burst started. A burst starts at a record with seq 0, a gap in seq
+is reported on stderr. The oldest burst may have lost its first records to
+the sector that is kept erased.
+
+Usage:
+    alog_decode.py <flog.bin> [sector size]
+"""
+
+import struct
+import sys
+
+FLOG_MAGIC = 0x474F4C46
+FLOG_FIRST = 8
+ALOG_FLOG_TYPE = 0xAC
+HEADER = struct.Struct("<IHBB")
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def records(data, sector_size):
+    sectors = []
+    for base in range(0, len(data) - sector_size + 1, sector_size):
+        magic, seq = struct.unpack_from("<II", data, base)
+        if magic == FLOG_MAGIC:
+            sectors.append((seq, base))
+
+    for _, base in sorted(sectors):
+        offset = FLOG_FIRST
+        while offset + 4 <= sector_size:
+            h, = struct.unpack_from("<I", data, base + offset)
+            length = (h >> 8) & 0xFF
+            size = 4 + ((length + 3) & ~3)
+            if h == 0xFFFFFFFF or offset + size > sector_size:
+                break
+            payload = data[base + offset + 4:base + offset + 4 + length]
+            if crc16(bytes([h & 0xFF, length]) + payload) == h >> 16:
+                yield h & 0xFF, payload
+            offset += size
+
+
+def s14(v):
+    return v - 0x4000 if v & 0x2000 else v
+
+
+def samples(payload):
+    t_us, seq, fmt, count = HEADER.unpack_from(payload)
+    data = payload[HEADER.size:]
+    out = []
+    if fmt == 1:
+        x, y, z = struct.unpack_from("<hhh", data)
+        out.append((x, y, z))
+        for i in range(1, count):
+            dx, dy, dz = struct.unpack_from("<bbb", data, 6 + 3 * (i - 1))
+            x, y, z = x + dx, y + dy, z + dz
+            out.append((x, y, z))
+    else:
+        bits = int.from_bytes(data, "little")
+        for i in range(count):
+            v = bits >> (42 * i)
+            out.append((s14(v & 0x3FFF), s14((v >> 14) & 0x3FFF),
+                        s14((v >> 28) & 0x3FFF)))
+    return t_us, seq, out
+
+
+def emit(burst, recs):
+    # The samples are evenly spaced at the data rate, see mma8451_fifo_read(),
+    # so the period follows from the times of consecutive records
+    period = 0.0
+    for i, (t_us, values) in enumerate(recs):
+        if i + 1 < len(recs):
+            period = (recs[i + 1][0] - t_us) / len(values)
+        for n, (x, y, z) in enumerate(values):
+            print("%d,%d,%d,%d,%d" % (burst, round(t_us + n * period), x, y, z))
+
+
+def main(argv):
+    if len(argv) < 2:
+        print(__doc__)
+        return 1
+
+    sector_size = int(argv[2], 0) if len(argv) > 2 else 1024
+    with open(argv[1], "rb") as f:
+        data = f.read()
+
+    burst = -1
+    expected = 0
+    recs = []
+    print("burst,t_us,x,y,z")
+    for rtype, payload in records(data, sector_size):
+        if rtype != ALOG_FLOG_TYPE or len(payload) < HEADER.size:
+            continue
+        t_us, seq, values = samples(payload)
+        if seq == 0 or burst < 0:
+            emit(burst, recs)
+            recs = []
+            burst += 1
+        elif seq != expected:
+            print("burst %d: records %d to %d dropped" % (burst, expected, seq - 1),
+                  file=sys.stderr)
+        expected = seq + 1
+        recs.append((t_us, values))
+
+    emit(burst, recs)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""Compares the results of the on-target benchmarks (bench/bench.c).
+
+The input is a capture of the serial port of a *_bench.elf. Every result of
+a benchmark is a JSON line, after the tables for people: a "meta" line that
+describes the build and the board, followed by "result" lines with the
+statistics of a measurement or a single value. Other lines are skipped, as
+are JSON lines that were cut on the board.
+
+With one capture the results are listed. With a second capture, the
+baseline, every result is listed with the change against the baseline in %,
+results that are missing in either capture are left out. The median is
+compared if both captures have it, otherwise the average or the value.
+
+A result that is in a capture more than once, such as after repeating a
+benchmark, is replaced by the last one.
+
+Usage:
+    bench_compare.py [--threshold=<percent>] <capture.txt> [<baseline.txt>]
+
+With --threshold only changes of more than that many % are listed, and the
+exit code is 1 if a result got worse by more than that. A worse result is a
+larger one, except for the rates of which the unit ends in "/s" or "Hz".
+"""
+
+import json
+import sys
+
+
+def read_capture(path):
+    metas = []
+    results = {}
+    with open(path, encoding="latin-1") as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith("{"):
+                continue
+            try:
+                record = json.loads(line)
+            except ValueError:
+                continue
+            if record.get("type") == "meta":
+                metas.append(record)
+            elif record.get("type") == "result":
+                key = (record.get("suite"), record.get("case"), record.get("metric", ""))
+                results[key] = record
+    return metas, results
+
+
+def figure(record, median):
+    if "value" in record:
+        return record["value"]
+    if median and "p50" in record:
+        return record["p50"]
+    return record.get("avg", 0)
+
+
+def higher_is_better(record):
+    unit = record.get("unit", "")
+    return unit.endswith("/s") or unit.endswith("Hz")
+
+
+def describe(metas, path):
+    if not metas:
+        return "%s: no description" % path
+    m = metas[-1]
+    text = "%s: %s, %s, %s, %s" % (path, m.get("board"), m.get("kernel"),
+                                   m.get("profile"), m.get("compiler"))
+    if "config" in m:
+        text += ", " + m["config"]
+    return text
+
+
+def name(key):
+    suite, case, metric = key
+    return "%s %s%s" % (suite, case, " " + metric if metric else "")
+
+
+def main(argv):
+    threshold = None
+    while len(argv) > 1 and argv[1].startswith("--"):
+        if argv[1].startswith("--threshold="):
+            threshold = float(argv[1][len("--threshold="):])
+        else:
+            print(__doc__)
+            return 1
+        del argv[1]
+
+    if len(argv) < 2:
+        print(__doc__)
+        return 1
+
+    metas, results = read_capture(argv[1])
+    if not results:
+        print("no benchmark results in %s" % argv[1], file=sys.stderr)
+        return 1
+
+    print(describe(metas, argv[1]))
+
+    if len(argv) < 3:
+        for key, r in results.items():
+            if "value" in r:
+                print("%-48s %10u %s" % (name(key), r["value"], r["unit"]))
+            else:
+                print("%-48s %10u %s, min %u max %u, %u samples" % (
+                    name(key), figure(r, True), r["unit"], r["min"], r["max"], r["n"]))
+        return 0
+
+    base_metas, base = read_capture(argv[2])
+    print(describe(base_metas, argv[2]))
+
+    worse = 0
+    for key, r in results.items():
+        if key not in base:
+            continue
+        b = base[key]
+        median = "p50" in r and "p50" in b
+        new = figure(r, median)
+        old = figure(b, median)
+        change = ((new - old) * 100.0 / old) if old else 0.0
+
+        if threshold is not None and abs(change) <= threshold:
+            continue
+
+        bad = (change < 0) if higher_is_better(r) else (change > 0)
+        if threshold is not None and bad:
+            worse += 1
+
+        print("%-48s %10u %10u %+7.1f%% %s" % (name(key), old, new, change,
+                                             r["unit"]))
+
+    return 1 if worse else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""Converts BMP images to bitmaps compressed per page for the SSD1306.
+
+A compressed bitmap (ssd1306_rle_t in oled/bitmaps.h) stores every page of
+8 rows as the bytes of ssd1306_framebuffer, column 0 first, packed with
+PackBits. A control byte n of 0 .. 127 is followed by n + 1 literal bytes,
+n of 129 .. 255 by a single byte that repeats 257 - n times, 128 is not used.
+The runs restart at every page and the offset of every page is stored, so a
+page or a part of it is decoded without the pages before it.
+
+A pixel is on if it is dark, with a luminance below half of the maximum,
+so an image drawn black on white is lit where it is black, as doc/clock.bmp
+is. The input is an uncompressed BMP with 1, 4, 8, 24 or 32 bits per pixel,
+at most 128 pixels wide. The height is rounded up to whole pages with rows
+that are off.
+
+Usage:
+    bmp_convert.py <output directory> <image.bmp> ...
+
+Writes bitmaps_rle.c and bitmaps_rle.h. Every image <name>.bmp becomes
+ssd1306_rle_t <name>_rle.
+"""
+
+import os
+import re
+import struct
+import sys
+
+MAX_WIDTH = 128
+
+
+def read_bmp(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if data[:2] != b"BM":
+        sys.exit("%s: not a BMP file" % path)
+
+    offset, = struct.unpack_from("<I", data, 10)
+    size, width, height, planes, bpp, compression = struct.unpack_from(
+        "<IiiHHI", data, 14)
+
+    if compression != 0 or bpp not in (1, 4, 8, 24, 32):
+        sys.exit("%s: only uncompressed 1, 4, 8, 24 and 32 bpp are supported" % path)
+    if not 0 < width <= MAX_WIDTH:
+        sys.exit("%s: width %d is not 1 to %d" % (path, width, MAX_WIDTH))
+
+    palette = []
+    if bpp <= 8:
+        colors, = struct.unpack_from("<I", data, 46)
+        colors = colors or (1 << bpp)
+        for i in range(colors):
+            b, g, r = data[14 + size + 4 * i:14 + size + 4 * i + 3]
+            palette.append((r, g, b))
+
+    # Rows are bottom-up unless the height is negative, padded to 4 bytes
+    stride = (width * bpp + 31) // 32 * 4
+    rows = []
+    for y in range(abs(height)):
+        line = y if height < 0 else abs(height) - 1 - y
+        row = data[offset + line * stride:offset + (line + 1) * stride]
+        pixels = []
+        for x in range(width):
+            if bpp >= 24:
+                b, g, r = row[x * bpp // 8:x * bpp // 8 + 3]
+            else:
+                bit = x * bpp
+                index = (row[bit // 8] >> (8 - bpp - bit % 8)) & ((1 << bpp) - 1)
+                r, g, b = palette[index]
+            pixels.append(r * 299 + g * 587 + b * 114 < 255 * 1000 // 2)
+        rows.append(pixels)
+
+    return width, rows
+
+
+def to_pages(width, rows):
+    pages = []
+    for p in range((len(rows) + 7) // 8):
+        page = []
+        for x in range(width):
+            value = 0
+            for bit in range(8):
+                y = p * 8 + bit
+                if y < len(rows) and rows[y][x]:
+                    value |= 1 << bit
+            page.append(value)
+        pages.append(page)
+    return pages
+
+
+def packbits(data):
+    out = []
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+
+        if run >= 2:
+            out += [257 - run, data[i]]
+            i += run
+            continue
+
+        # Literals until the next run of at least 3, a run of 2 inside
+        # literals costs the same as literals
+        start = i
+        while i < len(data) and i - start < 128:
+            if i + 2 < len(data) and data[i] == data[i + 1] == data[i + 2]:
+                break
+            i += 1
+        out += [i - start - 1] + data[start:i]
+    return out
+
+
+def emit(images, outdir):
+    header = ["/* Generated by tools/bmp_convert.py, do not edit. */",
+              "#ifndef BITMAPS_RLE_H_",
+              "#define BITMAPS_RLE_H_",
+              "",
+              "#include \"bitmaps.h\"",
+              ""]
+    source = ["/* Generated by tools/bmp_convert.py, do not edit. */",
+              "#include \"bitmaps_rle.h\"",
+              ""]
+
+    for name, width, pages in images:
+        offsets = []
+        data = []
+        for page in pages:
+            offsets.append(len(data))
+            data += packbits(page)
+
+        if len(data) > 0xFFFF:
+            sys.exit("%s: page offset does not fit in 16 bits" % name)
+
+        header.append("extern const ssd1306_rle_t %s_rle; // %d of %d bytes" % (
+            name, len(data) + 2 * len(pages), width * len(pages)))
+
+        source.append("static const uint16_t %s_offset[%d] =" % (name, len(pages)))
+        source.append("{")
+        source.append("    " + ", ".join("%d" % o for o in offsets) + ",")
+        source.append("};")
+        source.append("")
+
+        source.append("static const uint8_t %s_data[%d] =" % (name, len(data)))
+        source.append("{")
+        for i in range(0, len(data), 16):
+            source.append("    " + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+        source.append("};")
+        source.append("")
+
+        source.append("const ssd1306_rle_t %s_rle =" % name)
+        source.append("{")
+        source.append("    .width = %d," % width)
+        source.append("    .pages = %d," % len(pages))
+        source.append("    .offset = %s_offset," % name)
+        source.append("    .data = %s_data," % name)
+        source.append("};")
+        source.append("")
+
+    header += ["", "#endif // BITMAPS_RLE_H_", ""]
+
+    write_if_changed(os.path.join(outdir, "bitmaps_rle.h"), "\n".join(header))
+    write_if_changed(os.path.join(outdir, "bitmaps_rle.c"), "\n".join(source))
+
+
+def write_if_changed(path, text):
+    try:
+        with open(path) as f:
+            if f.read() == text:
+                return
+    except OSError:
+        pass
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def main(argv):
+    if len(argv) < 3:
+        print(__doc__)
+        return 1
+
+    images = []
+    for path in argv[2:]:
+        name = os.path.splitext(os.path.basename(path))[0]
+        if not re.match(r"^[A-Za-z_]\w*$", name):
+            sys.exit("%s: the name is not a C identifier" % path)
+        width, rows = read_bmp(path)
+        images.append((name, width, to_pages(width, rows)))
+
+    os.makedirs(argv[1], exist_ok=True)
+    emit(images, argv[1])
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,20 @@
+# Fails when a generated source committed to the tree differs from the fresh
+# output of its generator. The MCUXpresso project does not run the generators
+# and builds the committed copies, CMake checks that they are up to date.
+#
+# Usage:
+#   cmake -DGENERATED=<dir> -DCOMMITTED=<dir> -DFILES=<file>,<file>...
+#         -DREGENERATE=<command> -P check_generated.cmake
+
+string(REPLACE "," ";" FILES "${FILES}")
+
+foreach(FILE ${FILES})
+    execute_process(COMMAND "${CMAKE_COMMAND}" -E compare_files --ignore-eol
+                            "${GENERATED}/${FILE}" "${COMMITTED}/${FILE}"
+                    RESULT_VARIABLE DIFFERENT)
+
+    if(DIFFERENT)
+        message(FATAL_ERROR "${COMMITTED}/${FILE} is out of date, regenerate it "
+                            "from the project directory with:\n  ${REGENERATE}")
+    endif()
+endforeach()
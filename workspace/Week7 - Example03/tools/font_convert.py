@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""Converts the squix fonts in oled/fonts.c to the native font format.
+
+A native font (font_native_t in oled/fonts.h) stores every glyph in SSD1306
+page order: for page p of a glyph with width w, the bytes for columns
+0 .. w-1 are at bitmap[offset + p * w]. A page of a glyph drawn at a page
+aligned y position is then a single copy into ssd1306_framebuffer. Short
+glyphs are padded and rows below the font height are cleared at build time.
+
+The glyphs of a packed font are compressed one by one with the PackBits runs
+of tools/bmp_convert.py, the glyph offsets then index the runs. They are
+decoded on demand into a RAM cache when drawn. FONTS_NATIVE_PACKED_MAX in
+fonts_native.h is the size of the largest packed glyph, 0 without packed
+fonts, and sizes the entries of that cache.
+
+Usage:
+    font_convert.py [--pack=<Name>,...] <fonts.c> <output directory> [font name ...]
+
+Writes fonts_native.c and fonts_native.h. Without font names, all fonts in
+the input are converted. Every font <Name> becomes font_native_t <Name>_native.
+"""
+
+import os
+import re
+import sys
+
+from bmp_convert import packbits
+
+FONT_RE = re.compile(r"const\s+char\s+(\w+)\s*\[\s*\]\s*=\s*\{(.*?)\};", re.S)
+NUMBER_RE = re.compile(r"0[xX][0-9a-fA-F]+|\d+")
+
+
+def parse_fonts(text):
+    fonts = {}
+    for name, body in FONT_RE.findall(text):
+        body = re.sub(r"//[^\n]*", "", body)
+        fonts[name] = [int(n, 0) for n in NUMBER_RE.findall(body)]
+    return fonts
+
+
+def convert(name, data):
+    height, first, count = data[1], data[2], data[3]
+    pages = (height + 7) // 8
+    base = 4 + count * 4
+    last_mask = (1 << (height - 8 * (pages - 1))) - 1
+
+    glyphs = []
+    bitmap = []
+
+    for i in range(count):
+        offset1, offset2, n_bytes, width = data[4 + i * 4:8 + i * 4]
+        src = []
+        if n_bytes and not (offset1 == 0xFF and offset2 == 0xFF):
+            start = base + offset1 * 256 + offset2
+            src = data[start:start + n_bytes]
+
+        # squix glyphs are column-major, pages bytes per column
+        columns = [[0] * pages for _ in range(width)]
+        for n, value in enumerate(src):
+            if n // pages < width:
+                columns[n // pages][n % pages] = value
+
+        if len(bitmap) > 0xFFFF:
+            sys.exit("%s: glyph offset does not fit in 16 bits" % name)
+
+        glyphs.append((len(bitmap), width))
+        for p in range(pages):
+            mask = last_mask if p == pages - 1 else 0xFF
+            bitmap.extend(columns[c][p] & mask for c in range(width))
+
+    return height, pages, first, count, glyphs, bitmap
+
+
+def pack(pages, glyphs, bitmap):
+    packed_glyphs = []
+    packed = []
+    for offset, width in glyphs:
+        packed_glyphs.append((len(packed), width))
+        packed += packbits(bitmap[offset:offset + width * pages])
+    return packed_glyphs, packed
+
+
+def emit(fonts, names, packed_names, outdir):
+    header = ["/* Generated by tools/font_convert.py, do not edit. */",
+              "#ifndef FONTS_NATIVE_H_",
+              "#define FONTS_NATIVE_H_",
+              "",
+              "#include \"fonts.h\"",
+              ""]
+    source = ["/* Generated by tools/font_convert.py, do not edit. */",
+              "#include \"fonts_native.h\"",
+              ""]
+    packed_max = 0
+
+    for name in names:
+        height, pages, first, count, glyphs, bitmap = convert(name, fonts[name])
+        packed = name in packed_names
+
+        if packed:
+            size = len(bitmap)
+            packed_max = max([packed_max] + [w * pages for _, w in glyphs])
+            glyphs, bitmap = pack(pages, glyphs, bitmap)
+            if len(bitmap) > 0xFFFF:
+                sys.exit("%s: glyph offset does not fit in 16 bits" % name)
+            header.append("extern const font_native_t %s_native; // packed, %d of %d bytes" % (
+                name, len(bitmap), size))
+        else:
+            header.append("extern const font_native_t %s_native;" % name)
+
+        source.append("static const font_glyph_t %s_glyphs[%d] =" % (name, count))
+        source.append("{")
+        for i, (offset, width) in enumerate(glyphs):
+            source.append("    {%5d, %2d}, // %d" % (offset, width, first + i))
+        source.append("};")
+        source.append("")
+
+        source.append("static const uint8_t %s_bitmap[%d] =" % (name, max(len(bitmap), 1)))
+        source.append("{")
+        for i in range(0, len(bitmap), 16):
+            source.append("    " + ", ".join("0x%02X" % b for b in bitmap[i:i + 16]) + ",")
+        source.append("};")
+        source.append("")
+
+        source.append("const font_native_t %s_native =" % name)
+        source.append("{")
+        source.append("    .height = %d," % height)
+        source.append("    .pages = %d," % pages)
+        source.append("    .first = %d," % first)
+        source.append("    .count = %d," % count)
+        source.append("    .packed = %d," % (1 if packed else 0))
+        source.append("    .glyphs = %s_glyphs," % name)
+        source.append("    .bitmap = %s_bitmap," % name)
+        source.append("};")
+        source.append("")
+
+    header += ["",
+               "#define FONTS_NATIVE_PACKED_MAX (%d)" % packed_max,
+               "",
+               "#endif // FONTS_NATIVE_H_",
+               ""]
+
+    write_if_changed(os.path.join(outdir, "fonts_native.h"), "\n".join(header))
+    write_if_changed(os.path.join(outdir, "fonts_native.c"), "\n".join(source))
+
+
+def write_if_changed(path, text):
+    try:
+        with open(path) as f:
+            if f.read() == text:
+                return
+    except OSError:
+        pass
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def main(argv):
+    packed_names = []
+    while len(argv) > 1 and argv[1].startswith("--pack="):
+        packed_names += [n for n in argv[1][len("--pack="):].split(",") if n]
+        del argv[1]
+
+    if len(argv) < 3:
+        print(__doc__)
+        return 1
+
+    with open(argv[1], encoding="latin-1") as f:
+        fonts = parse_fonts(f.read())
+
+    names = argv[3:] or list(fonts)
+    for name in names + packed_names:
+        if name not in fonts:
+            sys.exit("font %s not found in %s" % (name, argv[1]))
+
+    os.makedirs(argv[2], exist_ok=True)
+    emit(fonts, names, packed_names, argv[2])
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
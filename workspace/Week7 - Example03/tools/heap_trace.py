@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+"""Converts a recorded heap trace to the replay table of bench/heap_bench.c.
+
+The input is a capture of the serial port after the 'h' command of a build
+with TASKSTATS_HEAP_TRACE, the lines between "Heap trace <n> ops" and "end":
+"a <address> <block size>" for an allocation and "f <address>" for a free.
+The block size includes the block header of the heap, which is subtracted
+again, so the replayed request gives the same block on heap_4.
+
+Without a capture a synthetic trace is generated: long-lived objects created
+at startup, short-lived messages of up to 128 bytes, buffers of up to 512
+bytes that live longer, and tasks that are created and deleted. It is the
+same for the same seed.
+
+Every block gets a slot, a free slot is reused by the next allocation, so
+the benchmark keeps the blocks in an array of HEAP_TRACE_SLOTS pointers. The
+peak number of blocks per size class of 16 to 1024 bytes sizes the block
+pools the heap is compared with.
+
+Usage:
+    heap_trace.py [--header=<bytes>] <output directory> <capture.txt>
+    heap_trace.py [--seed=<n>] <output directory>
+
+Writes heap_trace.c and heap_trace.h. The header is 8 bytes by default, the
+size of the block header of heap_4 on the Cortex-M0+.
+"""
+
+import heapq
+import os
+import random
+import re
+import sys
+
+CLASSES = [16 << i for i in range(7)]
+LINE_RE = re.compile(r"^([af]) ([0-9a-fA-F]{8})(?: (\d+))?\s*$")
+
+
+def read_capture(path, header):
+    ops = []
+    inside = False
+    with open(path, encoding="latin-1") as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith("Heap trace "):
+                # A later dump replaces an earlier one in the same capture
+                ops = []
+                inside = True
+            elif line == "end":
+                inside = False
+            elif inside:
+                m = LINE_RE.match(line)
+                if not m:
+                    continue
+                address = int(m.group(2), 16)
+                if m.group(1) == "a":
+                    ops.append((address, max(int(m.group(3)) - header, 1)))
+                else:
+                    ops.append((address, 0))
+    return ops
+
+
+def synthetic(seed):
+    rng = random.Random(seed)
+    ops = []
+    live = []
+    handle = 0
+
+    def alloc(size, lifetime):
+        nonlocal handle
+        handle += 1
+        ops.append((handle, size))
+        live.append([lifetime, handle])
+        return handle
+
+    # Kernel objects and buffers that are never freed
+    for size in (92, 256, 92, 192, 80, 160, 48, 128):
+        alloc(size, None)
+
+    # Queues, buffers and tasks of the steady state, one operation per step
+    for step in range(1200):
+        r = rng.random()
+        if r < 0.55:
+            alloc(rng.choice((12, 16, 24, 32, 48, 64, 96, 128)), rng.randint(1, 6))
+        elif r < 0.59:
+            alloc(rng.choice((128, 256, 384, 512)), rng.randint(10, 40))
+        elif r < 0.605:
+            # A task, its stack and its TCB are freed together
+            stack = rng.choice((256, 384))
+            lifetime = rng.randint(30, 120)
+            alloc(stack, lifetime)
+            alloc(92, lifetime)
+
+        for block in live:
+            if block[0] is not None:
+                block[0] -= 1
+        for block in [b for b in live if b[0] is not None and b[0] <= 0]:
+            ops.append((block[1], 0))
+            live.remove(block)
+
+    return ops
+
+
+def to_slots(ops):
+    slots = {}
+    free = []
+    count = 0
+    table = []
+    live = {}
+    peak = [0] * len(CLASSES)
+    used = [0] * len(CLASSES)
+
+    for address, size in ops:
+        if size > 0:
+            if address in slots:
+                sys.exit("block at %08x allocated twice" % address)
+            if free:
+                slot = heapq.heappop(free)
+            else:
+                slot = count
+                count += 1
+            if size > 0xFFFF:
+                sys.exit("allocation of %d bytes does not fit in 16 bits" % size)
+            slots[address] = slot
+            live[slot] = size
+            table.append((slot, size))
+
+            for i, c in enumerate(CLASSES):
+                if size <= c:
+                    used[i] += 1
+                    peak[i] = max(peak[i], used[i])
+                    break
+        elif address in slots:
+            # Frees of blocks allocated before the trace started are left out
+            slot = slots.pop(address)
+            size = live.pop(slot)
+            heapq.heappush(free, slot)
+            table.append((slot, 0))
+
+            for i, c in enumerate(CLASSES):
+                if size <= c:
+                    used[i] -= 1
+                    break
+
+    return table, count, peak
+
+
+def emit(table, count, peak, source_name, outdir):
+    pool_bytes = sum(c * max(p, 1) for c, p in zip(CLASSES, peak))
+
+    header = ["/* Generated by tools/heap_trace.py, do not edit. */",
+              "#ifndef HEAP_TRACE_H_",
+              "#define HEAP_TRACE_H_",
+              "",
+              "#include <stdint.h>",
+              "",
+              "#define HEAP_TRACE_OPS        (%d)" % len(table),
+              "#define HEAP_TRACE_SLOTS      (%d)" % max(count, 1),
+              "#define HEAP_TRACE_CLASSES    (%d)" % len(CLASSES),
+              "#define HEAP_TRACE_POOL_BYTES (%d)" % pool_bytes,
+              "",
+              "/// Allocation of size bytes into a slot, a free of the slot if the size is 0",
+              "typedef struct",
+              "{",
+              "    uint16_t slot;",
+              "    uint16_t size;",
+              "}heap_trace_op_t;",
+              "",
+              "extern const char heap_trace_source[];",
+              "extern const heap_trace_op_t heap_trace[HEAP_TRACE_OPS];",
+              "extern const uint16_t heap_trace_class_size[HEAP_TRACE_CLASSES];",
+              "extern const uint16_t heap_trace_class_peak[HEAP_TRACE_CLASSES];",
+              "",
+              "#endif // HEAP_TRACE_H_",
+              ""]
+
+    source = ["/* Generated by tools/heap_trace.py, do not edit. */",
+              "#include \"heap_trace.h\"",
+              "",
+              "const char heap_trace_source[] = \"%s\";" % source_name,
+              "",
+              "const heap_trace_op_t heap_trace[HEAP_TRACE_OPS] =",
+              "{"]
+    for i in range(0, len(table), 6):
+        source.append("    " + " ".join("{%d, %d}," % op for op in table[i:i + 6]))
+    source += ["};",
+               "",
+               "const uint16_t heap_trace_class_size[HEAP_TRACE_CLASSES] =",
+               "{",
+               "    " + ", ".join("%d" % c for c in CLASSES) + ",",
+               "};",
+               "",
+               "// Largest number of blocks of every class allocated at once, at least 1",
+               "const uint16_t heap_trace_class_peak[HEAP_TRACE_CLASSES] =",
+               "{",
+               "    " + ", ".join("%d" % max(p, 1) for p in peak) + ",",
+               "};",
+               ""]
+
+    write_if_changed(os.path.join(outdir, "heap_trace.h"), "\n".join(header))
+    write_if_changed(os.path.join(outdir, "heap_trace.c"), "\n".join(source))
+
+
+def write_if_changed(path, text):
+    try:
+        with open(path) as f:
+            if f.read() == text:
+                return
+    except OSError:
+        pass
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def main(argv):
+    header = 8
+    seed = 1
+    while len(argv) > 1 and argv[1].startswith("--"):
+        if argv[1].startswith("--header="):
+            header = int(argv[1][len("--header="):], 0)
+        elif argv[1].startswith("--seed="):
+            seed = int(argv[1][len("--seed="):], 0)
+        else:
+            print(__doc__)
+            return 1
+        del argv[1]
+
+    if len(argv) < 2:
+        print(__doc__)
+        return 1
+
+    if len(argv) > 2:
+        ops = read_capture(argv[2], header)
+        source_name = os.path.basename(argv[2])
+        if not ops:
+            print("no heap operations in %s" % argv[2], file=sys.stderr)
+            return 1
+    else:
+        ops = synthetic(seed)
+        source_name = "synthetic, seed %d" % seed
+
+    table, count, peak = to_slots(ops)
+
+    os.makedirs(argv[1], exist_ok=True)
+    emit(table, count, peak, source_name, argv[1])
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
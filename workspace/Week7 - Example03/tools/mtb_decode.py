@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""Decodes a branch trace of the Micro Trace Buffer (mtb/mtb.c) to functions
+and source lines.
+
+The input is either
+  - a capture of the serial port after the 'm' command, the lines between
+    "MTB <n> branches" and "end", or
+  - a raw memory dump of mtb_buffer taken over SWD, together with the value
+    of MTB->POSITION, for example with
+    (gdb) dump binary memory mtb.bin mtb_buffer (mtb_buffer + MTB_BUFFER_SIZE / 4)
+    (gdb) p/x ((MTB_Type *)0xF0000000)->POSITION
+    The position is the offset of the next packet from 0x1FFFF000 with the
+    wrap flag in bit 2.
+
+Every branch is printed oldest first as source -> destination, with the
+function and line of both addresses from arm-none-eabi-addr2line. A branch
+marked "exception" is an exception entry, its source is where the core was
+interrupted. A branch marked "start" is the first after the capture started.
+
+Usage:
+    mtb_decode.py <firmware.elf> <capture.txt>
+    mtb_decode.py <firmware.elf> <mtb.bin> <position>
+
+The addr2line tool can be set with the ADDR2LINE environment variable.
+"""
+
+import os
+import re
+import struct
+import subprocess
+import sys
+
+PACKET = struct.Struct("<II")
+LINE_RE = re.compile(r"^([0-9a-fA-F]{8}) ([0-9a-fA-F]{8})\s*$")
+
+
+def read_capture(path):
+    packets = []
+    inside = False
+    with open(path, encoding="latin-1") as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith("MTB "):
+                # A later dump replaces an earlier one in the same capture
+                packets = []
+                inside = True
+            elif line == "end":
+                inside = False
+            elif inside:
+                m = LINE_RE.match(line)
+                if m:
+                    packets.append((int(m.group(1), 16), int(m.group(2), 16)))
+    return packets
+
+
+def read_dump(path, position):
+    with open(path, "rb") as f:
+        data = f.read()
+    count = len(data) // PACKET.size
+    packets = [PACKET.unpack_from(data, i * PACKET.size) for i in range(count)]
+
+    # The pointer wraps at the buffer size, which the buffer is aligned to
+    nxt = ((position & ~7) % (count * PACKET.size)) // PACKET.size
+    if position & 4:
+        return packets[nxt:] + packets[:nxt]
+    return packets[:nxt]
+
+
+def lookup(elf, addresses):
+    tool = os.environ.get("ADDR2LINE", "arm-none-eabi-addr2line")
+    args = [tool, "-f", "-s", "-e", elf] + ["0x%08x" % a for a in addresses]
+    out = subprocess.run(args, capture_output=True, text=True, check=True).stdout
+    lines = out.splitlines()
+    return {a: "%s %s" % (lines[2 * i], lines[2 * i + 1])
+            for i, a in enumerate(addresses)}
+
+
+def main(argv):
+    if len(argv) < 3:
+        print(__doc__)
+        return 1
+
+    if len(argv) > 3:
+        packets = read_dump(argv[2], int(argv[3], 0))
+    else:
+        packets = read_capture(argv[2])
+
+    if not packets:
+        print("no branches in %s" % argv[2], file=sys.stderr)
+        return 1
+
+    # Bit 0 of the addresses holds the flags, instructions are halfword aligned
+    addresses = sorted({a & ~1 for p in packets for a in p})
+    names = lookup(argv[1], addresses)
+
+    for src, dst in packets:
+        flags = []
+        if src & 1:
+            flags.append("exception")
+        if dst & 1:
+            flags.append("start")
+        print("%08x %-40s -> %08x %s%s" % (
+            src & ~1, names[src & ~1], dst & ~1, names[dst & ~1],
+            "  [%s]" % ", ".join(flags) if flags else ""))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""Host side of the serial benchmark (bench/serial_bench.c).
+
+Runs the tests of a board with serial_bench.elf over its serial port, the
+OpenSDA virtual COM port of UART0:
+  - echo:     round trip latency of single bytes, and the throughput of a
+              burst that is echoed back
+  - transmit: throughput of the board to the host
+  - receive:  throughput of the host to the board
+  - loopback: the table of the test of UART0 in loop mode on the board
+  - stdio:    the CPU time per line of printf() through retarget/retarget.c
+              against xSerialPrintf() and a direct write, from the board
+
+The test pattern is byte i = i % 251, as on the board. The JSON lines of the
+board are left out, capture the port to compare them with bench_compare.py.
+The latency includes
+the USB latency of the virtual COM port, which is usually a millisecond or
+more, compare it with the loopback table of the board.
+
+Needs pyserial.
+
+Usage:
+    serial_bench.py <port> [baud] [bytes]
+
+The baud rate is 921600 and the burst 4096 bytes by default, the burst must
+not be larger than BENCH_BYTES of the board for the receive test.
+"""
+
+import statistics
+import sys
+import time
+
+PATTERN_MOD = 251
+SAMPLES = 200
+
+# Quiet time in seconds that ends the echo and receive tests of the board
+BENCH_QUIET = 1.0
+
+
+def pattern(n):
+    return bytes(i % PATTERN_MOD for i in range(n))
+
+
+def read_line(port, timeout=5.0):
+    """Returns the next line, without the line ending, or None."""
+    end = time.monotonic() + timeout
+    line = b""
+    while time.monotonic() < end:
+        c = port.read(1)
+        if not c:
+            continue
+        if c == b"\n":
+            return line.rstrip(b"\r").decode("latin-1")
+        line += c
+    return None
+
+
+def wait_for(port, prefix, timeout=5.0):
+    """Skips lines up to the first that starts with prefix and returns it."""
+    end = time.monotonic() + timeout
+    while time.monotonic() < end:
+        line = read_line(port, end - time.monotonic())
+        if line is None:
+            break
+        if line.startswith(prefix):
+            return line
+    raise RuntimeError("no '%s' from the board" % prefix)
+
+
+def read_exactly(port, n, timeout):
+    """Returns up to n bytes and the times of the first and last read."""
+    data = bytearray()
+    first = last = None
+    end = time.monotonic() + timeout
+    while len(data) < n and time.monotonic() < end:
+        chunk = port.read(n - len(data))
+        if chunk:
+            last = time.perf_counter()
+            if first is None:
+                first = last
+            data += chunk
+    return bytes(data), first, last
+
+
+def errors(data, offset=0):
+    return sum(1 for i, b in enumerate(data) if b != (offset + i) % PATTERN_MOD)
+
+
+def report(name, n, got, first, last, errs):
+    rate = got / (last - first) if got > 1 and last > first else 0
+    print("%-10s %6u of %6u bytes, %8.0f B/s, %u errors" % (name, got, n, rate, errs))
+
+
+def test_echo(port, n):
+    port.write(b"e")
+    wait_for(port, "echo")
+
+    rtt = []
+    for i in range(SAMPLES):
+        byte = bytes([i % PATTERN_MOD])
+        start = time.perf_counter()
+        port.write(byte)
+        c = port.read(1)
+        if c == byte:
+            rtt.append((time.perf_counter() - start) * 1e6)
+
+    if rtt:
+        rtt.sort()
+        print("echo       %u of %u round trips, us min %.0f med %.0f p99 %.0f max %.0f"
+              % (len(rtt), SAMPLES, rtt[0], statistics.median(rtt),
+                 rtt[(len(rtt) * 99) // 100], rtt[-1]))
+    else:
+        print("echo       no round trips")
+
+    start = time.perf_counter()
+    port.write(pattern(n))
+    data, _, last = read_exactly(port, n, 5.0)
+    report("echo", n, len(data), start, last or start, errors(data))
+
+    print(wait_for(port, "echo ", BENCH_QUIET + 5.0))
+
+
+def test_transmit(port):
+    port.write(b"t")
+    n = int(wait_for(port, "tx ").split()[1])
+    data, first, last = read_exactly(port, n, 10.0)
+    report("transmit", n, len(data), first or 0, last or 0, errors(data))
+    print(wait_for(port, "tx "))
+
+
+def test_receive(port, n):
+    port.write(b"r")
+    wait_for(port, "rx ")
+    port.write(pattern(n))
+    print(wait_for(port, "rx ", BENCH_QUIET + 10.0))
+    print(wait_for(port, "rx ", 2.0))
+
+
+def test_loopback(port):
+    port.write(b"l")
+    wait_for(port, "Loopback")
+    # The line carries the test bytes or nothing until the table
+    print("loopback on the board:")
+    print(wait_for(port, "   Baud", 30.0))
+    while True:
+        line = read_line(port)
+        if line is None or line == "end":
+            break
+        if not line.startswith("{"):
+            print(line)
+
+
+def test_stdio(port):
+    port.write(b"p")
+    wait_for(port, "stdio")
+    # The test lines of the methods come before the table
+    print("standard I/O on the board:")
+    print(wait_for(port, "Method", 10.0))
+    while True:
+        line = read_line(port)
+        if line is None or line == "end":
+            break
+        if not line.startswith("{"):
+            print(line)
+
+
+def main(argv):
+    if len(argv) < 2:
+        print(__doc__)
+        return 1
+
+    import serial
+
+    baud = int(argv[2]) if len(argv) > 2 else 921600
+    n = int(argv[3]) if len(argv) > 3 else 4096
+
+    with serial.Serial(argv[1], baud, timeout=0.1) as port:
+        port.reset_input_buffer()
+
+        test_echo(port, n)
+        test_transmit(port)
+        test_receive(port, n)
+        test_loopback(port)
+        test_stdio(port)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""Reports the static RAM of every task of a firmware, after the link.
+
+A task is found by its stack <id>_stack and its TCB <id>_tcb, the names
+that APP_TASK_STORAGE in src/app_tasks.h and the libraries use, read with
+arm-none-eabi-nm. A stack that is an array of several stacks, such as the
+one of the work queues, is a single row. The stack is shown in bytes and in
+words, the depth given to xTaskCreateStatic().
+
+With --budget the build fails when all tasks together take more than the
+given bytes of RAM, 0 is no limit.
+
+Usage:
+    task_budget.py [--budget=<bytes>] <firmware.elf>
+
+The nm tool can be set with the NM environment variable.
+"""
+
+import os
+import re
+import subprocess
+import sys
+
+# Static variables may get a suffix such as .lto_priv.0 or .0
+SYMBOL_RE = re.compile(r"^(\w+?)_(stack|tcb)(\.\S+)?$", re.IGNORECASE)
+
+
+def read_symbols(elf):
+    tool = os.environ.get("NM", "arm-none-eabi-nm")
+    args = [tool, "-S", "--defined-only", elf]
+    out = subprocess.run(args, capture_output=True, text=True, check=True).stdout
+
+    tasks = {}
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) != 4 or fields[2] not in "bBdD":
+            continue
+        m = SYMBOL_RE.match(fields[3])
+        if m:
+            task = tasks.setdefault(m.group(1), {"stack": 0, "tcb": 0})
+            task[m.group(2).lower()] += int(fields[1], 16)
+
+    # Both parts are needed, other arrays may end in _stack as well
+    return {name: t for name, t in tasks.items() if t["stack"] and t["tcb"]}
+
+
+def main(argv):
+    budget = 0
+    while len(argv) > 1 and argv[1].startswith("--"):
+        if argv[1].startswith("--budget="):
+            budget = int(argv[1][len("--budget="):], 0)
+        else:
+            print(__doc__)
+            return 1
+        del argv[1]
+
+    if len(argv) < 2:
+        print(__doc__)
+        return 1
+
+    tasks = read_symbols(argv[1])
+    if not tasks:
+        print("no task stacks in %s" % argv[1], file=sys.stderr)
+        return 1
+
+    print("%-12s %6s %6s %6s %6s" % ("Task", "Stack", "Words", "TCB", "Total"))
+    total = 0
+    for name, t in sorted(tasks.items(), key=lambda i: -(i[1]["stack"] + i[1]["tcb"])):
+        size = t["stack"] + t["tcb"]
+        total += size
+        print("%-12s %6d %6d %6d %6d" % (name, t["stack"], t["stack"] // 4, t["tcb"], size))
+    print("%-12s %6s %6s %6s %6d" % ("All", "", "", "", total))
+
+    if budget and total > budget:
+        print("tasks take %d B of RAM, over the budget of %d B" % (total, budget),
+              file=sys.stderr)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,223 @@
+#!/usr/bin/env python3
+"""Decoder for the COBS framed binary telemetry stream (telemetry/telemetry.c).
+
+Every frame is COBS encoded and terminated by 0x00. A decoded frame is
+
+    version:u8 type:u8 seq:u16 timestamp:u32 payload[...] crc:u16
+
+all little-endian. The CRC is CRC-16/CCITT-FALSE over header and payload.
+
+A record of type 7 is a record of another board, forwarded by the gateway of
+the board-to-board link (link/link.c). It is printed with the node and the
+time of the gateway in us, on the same time base as the gateway timestamps.
+
+A record of type 8 holds several samples of another type, delta coded in
+zig-zag varints (telemetry/tlm_pack.c). Every sample is printed as a record
+of its own type with the timestamp of the packed record. After a lost frame
+the samples are skipped until the next keyframe.
+
+Usage:
+    telemetry_decode.py /dev/ttyACM0 [baud]   read from a serial port (pyserial)
+    telemetry_decode.py capture.bin           read from a file
+    telemetry_decode.py -                     read from stdin
+"""
+
+import struct
+import sys
+
+TLM_VERSION = 1
+HEADER = struct.Struct("<BBHI")
+
+TASK_STATES = ["running", "ready", "blocked", "suspended", "deleted", "invalid"]
+
+# Layout of the unpacked samples of the record types that can be packed
+PACKED_LAYOUT = {1: "<hhh", 2: "<i"}
+PACK_KEY = 0x01
+
+
+def varint(data, i):
+    """Returns the zig-zag varint at data[i] and the index after it."""
+    u = 0
+    shift = 0
+    while True:
+        b = data[i]
+        i += 1
+        u |= (b & 0x7F) << shift
+        shift += 7
+        if not b & 0x80:
+            return (u >> 1) ^ -(u & 1), i
+
+
+def wrap32(v):
+    return ((v + 0x80000000) & 0xFFFFFFFF) - 0x80000000
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise ValueError("invalid COBS code")
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def parse_payload(rtype, payload):
+    if rtype == 1:
+        x, y, z = struct.unpack("<hhh", payload)
+        return "mma8451  x=%d y=%d z=%d" % (x, y, z)
+    if rtype == 2:
+        (diff,) = struct.unpack("<i", payload)
+        return "tcrt5000 diff=%d" % diff
+    if rtype == 3:
+        (secs,) = struct.unpack("<I", payload)
+        return "rtc      seconds=%u" % secs
+    if rtype == 4:
+        number, state, prio, _, runtime, stack = struct.unpack_from("<BBBBIH", payload)
+        name = payload[10:].split(b"\0", 1)[0].decode("ascii", "replace")
+        state = TASK_STATES[state] if state < len(TASK_STATES) else str(state)
+        return "task     #%u %-12s %-9s prio=%u runtime=%u stack_free=%u" % (
+            number, name, state, prio, runtime, stack)
+    if rtype == 6:
+        v = struct.unpack("<BBH3H3H4H", payload)
+        peaks = " ".join("%.1fHz:%u" % (f / 10.0, amp)
+                         for f, amp in zip(v[3:6], v[6:9]) if f)
+        axis = "xyz"[v[0]] if v[0] < 3 else str(v[0])
+        return "vibration %s rms=%u peaks=[%s] bands=%s" % (
+            axis, v[2], peaks, list(v[9:13]))
+    if rtype == 7:
+        node, inner, time_us = struct.unpack_from("<BBI", payload)
+        return "node %u %10u us  %s" % (node, time_us,
+                                        parse_payload(inner, payload[6:]))
+    return "type %u   %s" % (rtype, payload.hex())
+
+
+class Decoder:
+    def __init__(self):
+        self.buf = bytearray()
+        self.last_seq = None
+        self.frames = 0
+        self.lost = 0
+        self.errors = 0
+        # Previous sample of every packed type, None until a keyframe
+        self.packed = {}
+
+    def feed(self, data):
+        self.buf += data
+        while True:
+            end = self.buf.find(b"\0")
+            if end < 0:
+                return
+            frame = bytes(self.buf[:end])
+            del self.buf[:end + 1]
+            if frame:
+                self.frame(frame)
+
+    def frame(self, frame):
+        try:
+            raw = cobs_decode(frame)
+        except ValueError:
+            self.errors += 1
+            return
+        if len(raw) < HEADER.size + 2:
+            self.errors += 1
+            return
+        body, (crc,) = raw[:-2], struct.unpack("<H", raw[-2:])
+        if crc16(body) != crc:
+            self.errors += 1
+            return
+        version, rtype, seq, timestamp = HEADER.unpack_from(body)
+        if version != TLM_VERSION:
+            self.errors += 1
+            return
+        if self.last_seq is not None:
+            gap = (seq - self.last_seq - 1) & 0xFFFF
+            self.lost += gap
+            if gap:
+                # The delta chains continue in a lost frame
+                self.packed = {}
+        self.last_seq = seq
+        self.frames += 1
+        try:
+            if rtype == 8:
+                texts = self.unpack(body[HEADER.size:])
+            else:
+                texts = [parse_payload(rtype, body[HEADER.size:])]
+        except (struct.error, IndexError):
+            self.errors += 1
+            return
+        for text in texts:
+            print("%10u %5u  %s" % (timestamp, seq, text))
+
+    def unpack(self, payload):
+        inner, flags, channels, samples = struct.unpack_from("<BBBB", payload)
+        if flags & PACK_KEY:
+            last = [0] * channels
+        else:
+            last = self.packed.get(inner)
+            if last is None or len(last) != channels:
+                return []
+        texts = []
+        i = 4
+        for _ in range(samples):
+            for c in range(channels):
+                delta, i = varint(payload, i)
+                last[c] = wrap32(last[c] + delta)
+            layout = PACKED_LAYOUT.get(inner)
+            if layout:
+                texts.append(parse_payload(inner, struct.pack(layout, *last)))
+            else:
+                texts.append("type %u   %s" % (inner, last))
+        self.packed[inner] = list(last)
+        return texts
+
+
+def main(argv):
+    if len(argv) < 2:
+        print(__doc__)
+        return 1
+
+    dec = Decoder()
+    src = argv[1]
+
+    try:
+        if src == "-":
+            stream = sys.stdin.buffer
+        elif src.startswith("/dev/") or src.upper().startswith("COM"):
+            import serial
+            baud = int(argv[2]) if len(argv) > 2 else 921600
+            stream = serial.Serial(src, baud, timeout=0.1)
+        else:
+            stream = open(src, "rb")
+
+        while True:
+            data = stream.read(256)
+            if not data:
+                if src.startswith("/dev/") or src.upper().startswith("COM"):
+                    continue
+                break
+            dec.feed(data)
+    except KeyboardInterrupt:
+        pass
+
+    print("frames=%u lost=%u errors=%u" % (dec.frames, dec.lost, dec.errors),
+          file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
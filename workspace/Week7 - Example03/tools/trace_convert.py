@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""Converts a dump of the kernel trace recorder (trace/trace.c) to the Chrome
+trace event format, which is opened by Perfetto (ui.perfetto.dev) and
+chrome://tracing.
+
+The input is either
+  - a capture of the telemetry stream after the 't' command, which holds the
+    TLM_TASK records with the task names and the TLM_TRACE records, or
+  - a raw memory dump of trace_ring taken over SWD, for example with
+    (gdb) dump binary memory ring.bin &trace_ring (&trace_ring + 1)
+    Tasks are then named by number only.
+
+Usage:
+    trace_convert.py <capture.bin | ring.bin> <output.json>
+"""
+
+import json
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from telemetry_decode import HEADER, TLM_VERSION, cobs_decode, crc16  # noqa: E402
+
+TRACE_MAGIC = 0x45435254
+RECORD = struct.Struct("<IBBH")
+RING = struct.Struct("<IIII")
+
+TLM_TASK = 4
+TLM_TRACE = 5
+
+EVENTS = [
+    "info", "switched in", "queue send", "queue send failed", "queue receive",
+    "queue receive failed", "blocking on queue send",
+    "blocking on queue receive", "queue send from ISR",
+    "queue receive from ISR", "delay", "delay until", "notify",
+    "notify from ISR", "blocking on notify", "low power idle begin",
+    "low power idle end", "ISR enter", "ISR exit",
+]
+
+SWITCHED_IN = 1
+LOW_POWER_BEGIN = 15
+LOW_POWER_END = 16
+ISR_ENTER = 17
+ISR_EXIT = 18
+QUEUE_EVENTS = range(2, 10)
+
+ISR_TID = 1000
+
+
+def read_telemetry(data):
+    """Returns (hz, task names, records) of the last dump in a capture."""
+    names = {}
+    hz = None
+    records = []
+    for frame in data.split(b"\0"):
+        if not frame:
+            continue
+        try:
+            raw = cobs_decode(frame)
+        except ValueError:
+            continue
+        if len(raw) < HEADER.size + 2:
+            continue
+        body, (crc,) = raw[:-2], struct.unpack("<H", raw[-2:])
+        if crc16(body) != crc:
+            continue
+        version, rtype, _, _ = HEADER.unpack_from(body)
+        payload = body[HEADER.size:]
+        if version != TLM_VERSION:
+            continue
+        if rtype == TLM_TASK:
+            names[payload[0]] = payload[10:].split(b"\0", 1)[0].decode("ascii", "replace")
+        elif rtype == TLM_TRACE:
+            for i in range(0, len(payload) - RECORD.size + 1, RECORD.size):
+                rec = RECORD.unpack_from(payload, i)
+                if rec[1] == 0:
+                    # A new dump starts
+                    hz, records = rec[0], []
+                    if rec[3]:
+                        print("%u events were overwritten" % rec[3], file=sys.stderr)
+                else:
+                    records.append(rec)
+    if hz is None:
+        sys.exit("no trace dump found")
+    return hz, names, records
+
+
+def read_ring(data):
+    """Returns (hz, task names, records) of a raw trace_ring dump."""
+    _, size, hz, head = RING.unpack_from(data)
+    n = min(head, size)
+    records = []
+    for i in range(head - n, head):
+        records.append(RECORD.unpack_from(data, RING.size + (i % size) * RECORD.size))
+    return hz, {}, records
+
+
+def convert(hz, names, records):
+    events = []
+    tasks = set()
+    wraps = 0
+    previous = None
+    running = None
+    start = 0.0
+
+    def us(ticks):
+        return ticks * 1e6 / hz
+
+    for raw, etype, task, arg in records:
+        # The timestamps are 32 bits and wrap around
+        if previous is not None and raw < previous:
+            wraps += 1
+        previous = raw
+        ts = us((wraps << 32) + raw)
+        name = EVENTS[etype] if etype < len(EVENTS) else "event %u" % etype
+
+        if etype == SWITCHED_IN:
+            if running is not None:
+                events.append({"name": names.get(running, "task %u" % running),
+                               "ph": "X", "pid": 1, "tid": running,
+                               "ts": start, "dur": ts - start})
+            running, start = arg, ts
+            tasks.add(arg)
+        elif etype in (ISR_ENTER, ISR_EXIT):
+            events.append({"name": "IRQ %u" % arg, "pid": 1, "tid": ISR_TID,
+                           "ph": "B" if etype == ISR_ENTER else "E", "ts": ts})
+        elif etype in (LOW_POWER_BEGIN, LOW_POWER_END):
+            events.append({"name": "tickless idle", "pid": 1, "tid": task,
+                           "ph": "B" if etype == LOW_POWER_BEGIN else "E", "ts": ts})
+            tasks.add(task)
+        else:
+            args = {"queue": "0x%04x" % arg} if etype in QUEUE_EVENTS else {"index": arg}
+            events.append({"name": name, "ph": "i", "s": "t", "pid": 1,
+                           "tid": task, "ts": ts, "args": args})
+            tasks.add(task)
+
+    for task in sorted(tasks):
+        events.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": task,
+                       "args": {"name": names.get(task, "task %u" % task)}})
+    events.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": ISR_TID,
+                   "args": {"name": "interrupts"}})
+    events.append({"name": "process_name", "ph": "M", "pid": 1,
+                   "args": {"name": "FRDM-KL25Z"}})
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def main(argv):
+    if len(argv) < 3:
+        print(__doc__)
+        return 1
+
+    with open(argv[1], "rb") as f:
+        data = f.read()
+
+    if len(data) >= RING.size and RING.unpack_from(data)[0] == TRACE_MAGIC:
+        hz, names, records = read_ring(data)
+    else:
+        hz, names, records = read_telemetry(data)
+
+    with open(argv[2], "w") as f:
+        json.dump(convert(hz, names, records), f)
+
+    print("%u events" % len(records), file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
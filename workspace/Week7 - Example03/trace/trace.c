@@ -0,0 +1,639 @@
+/*! ***************************************************************************
+ *
+ * \brief     Kernel trace recorder
+ * \file      trace.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stddef.h>
+
+#include "trace.h"
+
+#if (TRACE_ENABLED == 1) || (TRACE_IRQ_STATS == 1)
+
+/*!
+ * \brief Timestamp of an event
+ *
+ * Reads the free-running PIT0 directly, without the 64-bit extension of
+ * the run-time counter. The host unwraps it.
+ */
+static inline uint32_t trace_time(void)
+{
+#if rtsFREE_RUNNING
+    return 0xFFFFFFFFUL - PIT->CHANNEL[0].CVAL;
+#else
+    return ulHighFrequencyTicks;
+#endif
+}
+
+#endif
+
+#if (TRACE_ENABLED == 1)
+
+trace_ring_t trace_ring =
+{
+    .magic = TRACE_MAGIC,
+    .size = TRACE_BUFFER_SIZE,
+    .hz = TRACE_HZ,
+    .head = 0,
+};
+
+// Cleared by trace_stop(), events are dropped while the ring is read
+static volatile bool recording = true;
+
+#endif // TRACE_ENABLED
+
+#if (TRACE_ENABLED == 1) || (TRACE_QUEUE_STATS == 1)
+
+// Number of the running task, stored in every event
+static volatile uint8_t current_task = 0;
+
+/*!
+ * \brief Records a context switch, called by the kernel
+ */
+void trace_task_switched_in(const uint32_t task)
+{
+    current_task = (uint8_t)task;
+
+#if (TRACE_ENABLED == 1)
+    trace_event(TRACE_TASK_SWITCHED_IN, task);
+#endif
+}
+
+#endif
+
+#if (TRACE_ENABLED == 1)
+
+/*!
+ * \brief Records an event
+ *
+ * Takes a few dozen cycles with interrupts disabled, so it can stay
+ * enabled in field builds. Can be called from tasks, from the kernel and
+ * from any interrupt handler.
+ *
+ * \param[in]  type  Event type
+ * \param[in]  arg   Argument, only the lower 16 bits are stored
+ */
+void trace_event(const trace_event_t type, const uint32_t arg)
+{
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    if(recording)
+    {
+        trace_record_t *r = &trace_ring.records[trace_ring.head &
+            (TRACE_BUFFER_SIZE - 1)];
+
+        r->time = trace_time();
+        r->type = (uint8_t)type;
+        r->task = current_task;
+        r->arg = (uint16_t)arg;
+
+        trace_ring.head++;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/*!
+ * \brief Resumes recording
+ *
+ * \return True if the recorder was already recording
+ */
+bool trace_start(void)
+{
+    const bool was = recording;
+
+    recording = true;
+
+    return was;
+}
+
+/*!
+ * \brief Suspends recording, so the ring can be read consistently
+ *
+ * \return True if the recorder was recording
+ */
+bool trace_stop(void)
+{
+    const bool was = recording;
+
+    recording = false;
+
+    return was;
+}
+
+/*!
+ * \brief Copies events from the ring, oldest first
+ *
+ * Stop the recorder first, otherwise events may be overwritten while they
+ * are copied. The first call should use \p first = 0, the next ones the
+ * sum of the previous return values.
+ *
+ * \param[out]  records  Copied events
+ * \param[in]   first    Number of events to skip, the oldest ones
+ * \param[in]   max      Size of \p records
+ *
+ * \return Number of events copied, 0 when all events are copied
+ */
+uint32_t trace_read(trace_record_t records[], const uint32_t first,
+    const uint32_t max)
+{
+    const uint32_t head = trace_ring.head;
+    const uint32_t n = (head < TRACE_BUFFER_SIZE) ? head : TRACE_BUFFER_SIZE;
+    uint32_t copied = 0;
+
+    for(uint32_t i=first; (i < n) && (copied < max); ++i)
+    {
+        records[copied++] = trace_ring.records[(head - n + i) &
+            (TRACE_BUFFER_SIZE - 1)];
+    }
+
+    return copied;
+}
+
+#endif // TRACE_ENABLED
+
+#if (TRACE_ENABLED == 1) || (TRACE_IRQ_STATS == 1)
+
+#if (TRACE_IRQ_STATS == 1)
+
+// Statistics of the measured interrupts, a slot is taken by the first entry
+// of an interrupt. slot_of[] maps an IRQ number to its slot + 1.
+static trace_irq_stats_t slots[TRACE_IRQ_SLOTS];
+static uint8_t slot_of[32];
+static uint32_t slots_used = 0;
+
+// Entry time of the handler that is running, per slot. An interrupt does not
+// preempt itself, so one per slot is enough.
+static uint32_t entered[TRACE_IRQ_SLOTS];
+
+/*!
+ * \brief Finds or takes the slot of the running interrupt, called with
+ *        interrupts disabled
+ */
+static trace_irq_stats_t *trace_irq_slot(const uint32_t irq, uint32_t *slot)
+{
+    if(irq >= 32)
+    {
+        return NULL;
+    }
+
+    if(slot_of[irq] == 0)
+    {
+        if(slots_used >= TRACE_IRQ_SLOTS)
+        {
+            return NULL;
+        }
+
+        slots[slots_used].irq = (int16_t)irq;
+        slots[slots_used].duration.min = UINT32_MAX;
+        slots[slots_used].latency.min = UINT32_MAX;
+        slot_of[irq] = (uint8_t)++slots_used;
+    }
+
+    *slot = slot_of[irq] - 1;
+
+    return &slots[*slot];
+}
+
+/*!
+ * \brief Adds a time in bus clock cycles to a series
+ */
+static void trace_time_add(trace_time_stats_t *t, const uint32_t cycles)
+{
+    // Bucket of the time in microseconds, at 24 cycles per microsecond
+    uint32_t us = cycles / 24;
+    uint32_t bucket = 0;
+
+    while((us > 0) && (bucket < (TRACE_IRQ_BUCKETS - 1)))
+    {
+        us >>= 1;
+        bucket++;
+    }
+
+    if(t->histogram[bucket] < 0xFFFF)
+    {
+        t->histogram[bucket]++;
+    }
+
+    t->count++;
+    t->sum += cycles;
+
+    if(cycles < t->min)
+    {
+        t->min = cycles;
+    }
+
+    if(cycles > t->max)
+    {
+        t->max = cycles;
+    }
+}
+
+#endif // TRACE_IRQ_STATS
+
+/*!
+ * \brief Called at the start of an interrupt handler by TRACE_ISR_ENTER()
+ */
+void trace_isr_enter(void)
+{
+    const uint32_t irq = __get_IPSR() - 16;
+
+#if (TRACE_ENABLED == 1)
+    trace_event(TRACE_ISR_ENTER, irq);
+#endif
+
+#if (TRACE_IRQ_STATS == 1)
+    const uint32_t primask = __get_PRIMASK();
+    uint32_t slot;
+
+    __disable_irq();
+
+    if(trace_irq_slot(irq, &slot) != NULL)
+    {
+        entered[slot] = trace_time();
+    }
+
+    __set_PRIMASK(primask);
+#endif
+}
+
+/*!
+ * \brief Called at every exit of an interrupt handler by TRACE_ISR_EXIT()
+ */
+void trace_isr_exit(void)
+{
+    const uint32_t irq = __get_IPSR() - 16;
+
+#if (TRACE_IRQ_STATS == 1)
+    const uint32_t primask = __get_PRIMASK();
+    uint32_t slot;
+
+    __disable_irq();
+
+    trace_irq_stats_t *stats = trace_irq_slot(irq, &slot);
+
+    if(stats != NULL)
+    {
+        trace_time_add(&stats->duration, trace_time() - entered[slot]);
+    }
+
+    __set_PRIMASK(primask);
+#endif
+
+#if (TRACE_ENABLED == 1)
+    trace_event(TRACE_ISR_EXIT, irq);
+#endif
+}
+
+/*!
+ * \brief Records the entry latency of a timer interrupt, called by
+ *        TRACE_ISR_LATENCY()
+ *
+ * \param[in]  cycles  Bus clock cycles from the interrupt request until the
+ *                     handler read the timer
+ */
+void trace_isr_latency(const uint32_t cycles)
+{
+#if (TRACE_IRQ_STATS == 1)
+    const uint32_t primask = __get_PRIMASK();
+    uint32_t slot;
+
+    __disable_irq();
+
+    trace_irq_stats_t *stats = trace_irq_slot(__get_IPSR() - 16, &slot);
+
+    if(stats != NULL)
+    {
+        trace_time_add(&stats->latency, cycles);
+    }
+
+    __set_PRIMASK(primask);
+#else
+    (void)cycles;
+#endif
+}
+
+/*!
+ * \brief Copies the statistics of a measured interrupt
+ *
+ * \param[in]   slot   Index, starting at 0
+ * \param[out]  stats  Statistics of the interrupt
+ *
+ * \return False if there is no interrupt in \p slot
+ */
+bool trace_irq_get(const uint32_t slot, trace_irq_stats_t *stats)
+{
+#if (TRACE_IRQ_STATS == 1)
+    bool ok = false;
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    if(slot < slots_used)
+    {
+        *stats = slots[slot];
+        ok = true;
+    }
+
+    __set_PRIMASK(primask);
+
+    return ok;
+#else
+    (void)slot;
+    (void)stats;
+
+    return false;
+#endif
+}
+
+/*!
+ * \brief Clears the statistics of all interrupts
+ */
+void trace_irq_reset(void)
+{
+#if (TRACE_IRQ_STATS == 1)
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    for(uint32_t i=0; i<slots_used; ++i)
+    {
+        const int16_t irq = slots[i].irq;
+
+        slots[i] = (trace_irq_stats_t){0};
+        slots[i].irq = irq;
+        slots[i].duration.min = UINT32_MAX;
+        slots[i].latency.min = UINT32_MAX;
+    }
+
+    __set_PRIMASK(primask);
+#endif
+}
+
+#endif
+
+#if (TRACE_QUEUE_STATS == 1)
+
+// Blocked times use the run-time counter, which does not wrap around in a
+// realistic blocked time
+#if rtsFREE_RUNNING
+typedef uint64_t trace_queue_time_t;
+#else
+typedef uint32_t trace_queue_time_t;
+#endif
+
+// Profiles of the registered queues
+static trace_queue_stats_t queues[TRACE_QUEUE_SLOTS];
+static uint32_t queues_used = 0;
+
+// Queue number a task is blocked on and since when, by task number. The
+// kernel may block a task again on the same queue before the operation
+// completes, that is a single block.
+static uint8_t blocked_on[TRACE_QUEUE_TASKS];
+static trace_queue_time_t blocked_since[TRACE_QUEUE_TASKS];
+
+/*!
+ * \brief Reads the run-time counter
+ */
+static inline trace_queue_time_t trace_queue_time(void)
+{
+#if rtsFREE_RUNNING
+    return ullRunTimeCounterValue();
+#else
+    return ulHighFrequencyTicks;
+#endif
+}
+
+/*!
+ * \brief Takes a profile for a queue added to the registry, called by the
+ *        traceQUEUE_REGISTRY_ADD() hook
+ *
+ * \param[in]  number  Queue number, the slot + 1 of a queue that is already
+ *                     profiled
+ * \param[in]  name    Name in the registry
+ * \param[in]  length  Number of items the queue can hold
+ *
+ * \return The new queue number, 0 if all slots are taken
+ */
+uint32_t trace_queue_register(const uint32_t number, const char *name,
+    const uint32_t length)
+{
+    const uint32_t primask = __get_PRIMASK();
+    uint32_t slot = number;
+
+    __disable_irq();
+
+    if((slot == 0) || (slot > queues_used))
+    {
+        slot = (queues_used < TRACE_QUEUE_SLOTS) ? ++queues_used : 0;
+    }
+
+    if(slot > 0)
+    {
+        queues[slot - 1].name = name;
+        queues[slot - 1].length = (uint16_t)length;
+    }
+
+    __set_PRIMASK(primask);
+
+    return slot;
+}
+
+/*!
+ * \brief Records that the running task blocks on a queue, called by the
+ *        traceBLOCKING_ON_QUEUE_SEND() and traceBLOCKING_ON_QUEUE_RECEIVE()
+ *        hooks
+ */
+void trace_queue_block(const uint32_t number, const bool receive)
+{
+    const uint32_t task = current_task;
+    const uint32_t primask = __get_PRIMASK();
+
+    if((number == 0) || (number > queues_used))
+    {
+        return;
+    }
+
+    __disable_irq();
+
+    if((task >= TRACE_QUEUE_TASKS) || (blocked_on[task] != number))
+    {
+        if(receive)
+        {
+            queues[number - 1].blocked_receives++;
+        }
+        else
+        {
+            queues[number - 1].blocked_sends++;
+        }
+
+        if(task < TRACE_QUEUE_TASKS)
+        {
+            blocked_on[task] = (uint8_t)number;
+            blocked_since[task] = trace_queue_time();
+        }
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/*!
+ * \brief Records a completed or failed queue operation of the running task,
+ *        called by the kernel hooks
+ *
+ * \param[in]  number  Queue number
+ * \param[in]  fill    Fill level after a send, 0 otherwise
+ * \param[in]  failed  True if the operation failed
+ */
+void trace_queue_done(const uint32_t number, const uint32_t fill,
+    const bool failed)
+{
+    const uint32_t task = current_task;
+    const uint32_t primask = __get_PRIMASK();
+
+    if((number == 0) || (number > queues_used))
+    {
+        return;
+    }
+
+    __disable_irq();
+
+    trace_queue_stats_t *q = &queues[number - 1];
+
+    if(fill > q->peak)
+    {
+        q->peak = (uint16_t)fill;
+    }
+
+    if((task < TRACE_QUEUE_TASKS) && (blocked_on[task] == number))
+    {
+        const trace_queue_time_t blocked = trace_queue_time() - blocked_since[task];
+
+        blocked_on[task] = 0;
+
+        q->sum_blocked += blocked;
+
+        if(blocked > q->max_blocked)
+        {
+            q->max_blocked = (blocked > UINT32_MAX) ? UINT32_MAX : (uint32_t)blocked;
+        }
+
+        if(failed)
+        {
+            q->timeouts++;
+        }
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/*!
+ * \brief Records the fill level after a send from an interrupt handler
+ */
+void trace_queue_fill(const uint32_t number, const uint32_t fill)
+{
+    const uint32_t primask = __get_PRIMASK();
+
+    if((number == 0) || (number > queues_used))
+    {
+        return;
+    }
+
+    __disable_irq();
+
+    if(fill > queues[number - 1].peak)
+    {
+        queues[number - 1].peak = (uint16_t)fill;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+#endif // TRACE_QUEUE_STATS
+
+#if (TRACE_ENABLED == 1) || (TRACE_QUEUE_STATS == 1)
+
+/*!
+ * \brief Copies the profile of a registered queue
+ *
+ * \param[in]   slot   Index, starting at 0
+ * \param[out]  stats  Profile of the queue
+ *
+ * \return False if there is no queue in \p slot
+ */
+bool trace_queue_get(const uint32_t slot, trace_queue_stats_t *stats)
+{
+#if (TRACE_QUEUE_STATS == 1)
+    bool ok = false;
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    if(slot < queues_used)
+    {
+        *stats = queues[slot];
+        ok = true;
+    }
+
+    __set_PRIMASK(primask);
+
+    return ok;
+#else
+    (void)slot;
+    (void)stats;
+
+    return false;
+#endif
+}
+
+/*!
+ * \brief Clears the profiles of all queues, blocks in progress are kept
+ */
+void trace_queue_reset(void)
+{
+#if (TRACE_QUEUE_STATS == 1)
+    const uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    for(uint32_t i=0; i<queues_used; ++i)
+    {
+        const char *name = queues[i].name;
+        const uint16_t length = queues[i].length;
+
+        queues[i] = (trace_queue_stats_t){0};
+        queues[i].name = name;
+        queues[i].length = length;
+    }
+
+    __set_PRIMASK(primask);
+#endif
+}
+
+#endif
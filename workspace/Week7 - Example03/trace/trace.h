@@ -0,0 +1,407 @@
+/*! ***************************************************************************
+ *
+ * \brief     Kernel trace recorder
+ * \file      trace.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <MKL25Z4.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "probe.h"
+#include "runtime_stats.h"
+
+/*!
+ * \brief Set to 0 to remove the recorder and all trace hooks from the build
+ */
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED (1)
+#endif
+
+/*!
+ * \brief Set to 1 to measure the duration and latency of the instrumented
+ *        interrupt handlers, see trace_irq_get()
+ *
+ * Requires the free-running PIT0 of the run-time stats.
+ */
+#ifndef TRACE_IRQ_STATS
+#define TRACE_IRQ_STATS (0)
+#endif
+
+#if (TRACE_IRQ_STATS == 1) && !rtsFREE_RUNNING
+#error "TRACE_IRQ_STATS requires rtsFREE_RUNNING"
+#endif
+
+/*!
+ * \brief Number of interrupts that can be measured at the same time
+ */
+#ifndef TRACE_IRQ_SLOTS
+#define TRACE_IRQ_SLOTS (8)
+#endif
+
+/*!
+ * \brief Number of histogram buckets, bucket i counts times below 2^i us
+ *        and the last one all longer times
+ */
+#define TRACE_IRQ_BUCKETS (8)
+
+/*!
+ * \brief Set to 0 to stop profiling the queues in the queue registry, see
+ *        trace_queue_get()
+ */
+#ifndef TRACE_QUEUE_STATS
+#define TRACE_QUEUE_STATS (1)
+#endif
+
+/*!
+ * \brief Number of registered queues that can be profiled
+ */
+#ifndef TRACE_QUEUE_SLOTS
+#define TRACE_QUEUE_SLOTS (8)
+#endif
+
+/*!
+ * \brief Number of tasks, by task number, of which the blocked time on a
+ *        queue is measured
+ */
+#ifndef TRACE_QUEUE_TASKS
+#define TRACE_QUEUE_TASKS (16)
+#endif
+
+/*!
+ * \brief Number of events in the ring, a power of two
+ *
+ * Every event takes 8 bytes. When the ring is full the oldest events are
+ * overwritten, so the ring always holds the most recent history.
+ */
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE (128)
+#endif
+
+/*!
+ * \brief Frequency of the event timestamps in Hz
+ */
+#if rtsFREE_RUNNING
+#define TRACE_HZ          (24000000UL)
+#else
+#define TRACE_HZ          (1000000UL / rtsTICK_US)
+#endif
+
+/*!
+ * \brief Marks a trace_ring_t in memory, for a dump over SWD
+ */
+#define TRACE_MAGIC       (0x45435254UL)
+
+/*!
+ * \brief Drives the PROBE_TASK pin on a task switch, expanded in tasks.c
+ *
+ * The pin is low while the idle task runs, so the duty cycle on a scope is
+ * the CPU load.
+ */
+#if (PROBE_ENABLED == 1)
+#define TRACE_PROBE_SWITCHED_IN() \
+    do { \
+        if(pxCurrentTCB != xIdleTaskHandle) \
+        { \
+            PROBE_HIGH(PROBE_TASK); \
+        } \
+    } while(0)
+#define traceTASK_SWITCHED_OUT() \
+    PROBE_LOW(PROBE_TASK)
+#else
+#define TRACE_PROBE_SWITCHED_IN()
+#endif
+
+/*!
+ * \brief Event types
+ *
+ * The argument of queue events is the lower half of the queue address, of
+ * notify events the notification index and of ISR events the IRQ number.
+ * Semaphores and mutexes are queues, so give and take are send and receive.
+ */
+typedef enum
+{
+    TRACE_INFO = 0,               ///< Synthetic, first record of a dump
+    TRACE_TASK_SWITCHED_IN,       ///< Task is the new running task
+    TRACE_QUEUE_SEND,
+    TRACE_QUEUE_SEND_FAILED,
+    TRACE_QUEUE_RECEIVE,
+    TRACE_QUEUE_RECEIVE_FAILED,
+    TRACE_BLOCKING_ON_QUEUE_SEND,
+    TRACE_BLOCKING_ON_QUEUE_RECEIVE,
+    TRACE_QUEUE_SEND_FROM_ISR,
+    TRACE_QUEUE_RECEIVE_FROM_ISR,
+    TRACE_TASK_DELAY,
+    TRACE_TASK_DELAY_UNTIL,
+    TRACE_TASK_NOTIFY,
+    TRACE_TASK_NOTIFY_FROM_ISR,
+    TRACE_BLOCKING_ON_NOTIFY,
+    TRACE_LOW_POWER_IDLE_BEGIN,
+    TRACE_LOW_POWER_IDLE_END,
+    TRACE_ISR_ENTER,
+    TRACE_ISR_EXIT,
+}trace_event_t;
+
+/*!
+ * \brief A single event
+ *
+ * For TRACE_INFO the time is TRACE_HZ and the argument the number of
+ * events that were overwritten, saturated at 0xFFFF.
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t time;    ///< Timestamp in ticks of TRACE_HZ, wraps around
+    uint8_t  type;    ///< trace_event_t
+    uint8_t  task;    ///< Number of the running task, see uxTaskGetTaskNumber()
+    uint16_t arg;     ///< Depends on the event type
+}trace_record_t;
+
+/*!
+ * \brief The ring, exported so a debugger can dump it as a single block
+ */
+typedef struct
+{
+    uint32_t magic;                            ///< TRACE_MAGIC
+    uint32_t size;                             ///< TRACE_BUFFER_SIZE
+    uint32_t hz;                               ///< TRACE_HZ
+    volatile uint32_t head;                    ///< Number of events written
+    trace_record_t records[TRACE_BUFFER_SIZE]; ///< Event head is at head % size
+}trace_ring_t;
+
+/*!
+ * \brief Statistics of a series of times in bus clock cycles
+ */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint16_t histogram[TRACE_IRQ_BUCKETS]; ///< Saturates at 0xFFFF
+}trace_time_stats_t;
+
+/*!
+ * \brief Measured handler duration and entry latency of an interrupt
+ *
+ * The duration includes the time the handler was preempted by interrupts
+ * with a higher priority. The latency is only measured by handlers of
+ * timer interrupts, which know when the interrupt was requested.
+ */
+typedef struct
+{
+    int16_t irq;                  ///< IRQ number
+    trace_time_stats_t duration;
+    trace_time_stats_t latency;
+}trace_irq_stats_t;
+
+/*!
+ * \brief Contention profile of a registered queue, semaphore or mutex
+ *
+ * Times are in ticks of TRACE_HZ. A semaphore is given by a send, so its
+ * fill level is the count. A mutex is full when it is free.
+ */
+typedef struct
+{
+    const char *name;           ///< Name in the queue registry
+    uint32_t blocked_sends;     ///< Sends and gives that had to block
+    uint32_t blocked_receives;  ///< Receives and takes that had to block
+    uint32_t timeouts;          ///< Blocked operations that failed
+    uint32_t max_blocked;       ///< Longest block, saturates
+    uint64_t sum_blocked;
+    uint16_t peak;              ///< Highest fill level
+    uint16_t length;
+}trace_queue_stats_t;
+
+#if (TRACE_ENABLED == 1)
+
+extern trace_ring_t trace_ring;
+
+// Function prototypes
+void trace_event(const trace_event_t type, const uint32_t arg);
+bool trace_start(void);
+bool trace_stop(void);
+uint32_t trace_read(trace_record_t records[], const uint32_t first,
+    const uint32_t max);
+
+#define TRACE_KERNEL_EVENT(type, pxQueue) \
+    trace_event((type), (uint32_t)(uintptr_t)(pxQueue))
+
+#else
+
+#define TRACE_KERNEL_EVENT(type, pxQueue)
+
+#endif // TRACE_ENABLED
+
+#if (TRACE_QUEUE_STATS == 1)
+
+uint32_t trace_queue_register(const uint32_t number, const char *name,
+    const uint32_t length);
+void trace_queue_block(const uint32_t number, const bool receive);
+void trace_queue_done(const uint32_t number, const uint32_t fill,
+    const bool failed);
+void trace_queue_fill(const uint32_t number, const uint32_t fill);
+
+// A send is traced before the item is copied, a semaphore that is
+// overwritten does not grow
+#define TRACE_QUEUE_FILL_AFTER_SEND(pxQueue) \
+    (((pxQueue)->uxMessagesWaiting < (pxQueue)->uxLength) ? \
+     ((pxQueue)->uxMessagesWaiting + 1) : (pxQueue)->uxLength)
+
+#define TRACE_QUEUE_BLOCK(pxQueue, receive) \
+    trace_queue_block((pxQueue)->uxQueueNumber, (receive))
+#define TRACE_QUEUE_DONE(pxQueue, fill, failed) \
+    trace_queue_done((pxQueue)->uxQueueNumber, (fill), (failed))
+#define TRACE_QUEUE_FILL(pxQueue) \
+    trace_queue_fill((pxQueue)->uxQueueNumber, TRACE_QUEUE_FILL_AFTER_SEND(pxQueue))
+
+// The profile slot + 1 is kept in the queue number of the queue
+#define traceQUEUE_REGISTRY_ADD(xQueue, pcQueueName) \
+    (xQueue)->uxQueueNumber = trace_queue_register((xQueue)->uxQueueNumber, \
+        (pcQueueName), (xQueue)->uxLength)
+
+#else
+
+#define TRACE_QUEUE_BLOCK(pxQueue, receive)
+#define TRACE_QUEUE_DONE(pxQueue, fill, failed)
+#define TRACE_QUEUE_FILL(pxQueue)
+
+#endif // TRACE_QUEUE_STATS
+
+#if (TRACE_ENABLED == 1) || (TRACE_QUEUE_STATS == 1)
+
+bool trace_queue_get(const uint32_t slot, trace_queue_stats_t *stats);
+void trace_queue_reset(void);
+void trace_task_switched_in(const uint32_t task);
+
+// FreeRTOS trace hooks, expanded in the kernel sources
+#define traceTASK_SWITCHED_IN() \
+    do { \
+        TRACE_PROBE_SWITCHED_IN(); \
+        trace_task_switched_in(pxCurrentTCB->uxTCBNumber); \
+    } while(0)
+#define traceQUEUE_SEND(pxQueue) \
+    do { \
+        TRACE_KERNEL_EVENT(TRACE_QUEUE_SEND, pxQueue); \
+        TRACE_QUEUE_DONE(pxQueue, TRACE_QUEUE_FILL_AFTER_SEND(pxQueue), false); \
+    } while(0)
+#define traceQUEUE_SEND_FAILED(pxQueue) \
+    do { \
+        TRACE_KERNEL_EVENT(TRACE_QUEUE_SEND_FAILED, pxQueue); \
+        TRACE_QUEUE_DONE(pxQueue, 0, true); \
+    } while(0)
+#define traceQUEUE_RECEIVE(pxQueue) \
+    do { \
+        TRACE_KERNEL_EVENT(TRACE_QUEUE_RECEIVE, pxQueue); \
+        TRACE_QUEUE_DONE(pxQueue, 0, false); \
+    } while(0)
+#define traceQUEUE_RECEIVE_FAILED(pxQueue) \
+    do { \
+        TRACE_KERNEL_EVENT(TRACE_QUEUE_RECEIVE_FAILED, pxQueue); \
+        TRACE_QUEUE_DONE(pxQueue, 0, true); \
+    } while(0)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) \
+    do { \
+        TRACE_KERNEL_EVENT(TRACE_BLOCKING_ON_QUEUE_SEND, pxQueue); \
+        TRACE_QUEUE_BLOCK(pxQueue, false); \
+    } while(0)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+    do { \
+        TRACE_KERNEL_EVENT(TRACE_BLOCKING_ON_QUEUE_RECEIVE, pxQueue); \
+        TRACE_QUEUE_BLOCK(pxQueue, true); \
+    } while(0)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) \
+    do { \
+        TRACE_KERNEL_EVENT(TRACE_QUEUE_SEND_FROM_ISR, pxQueue); \
+        TRACE_QUEUE_FILL(pxQueue); \
+    } while(0)
+
+#else
+
+#define traceTASK_SWITCHED_IN() \
+    TRACE_PROBE_SWITCHED_IN()
+
+#endif
+
+#if (TRACE_ENABLED == 1)
+
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) \
+    trace_event(TRACE_QUEUE_RECEIVE_FROM_ISR, (uint32_t)(uintptr_t)(pxQueue))
+#define traceTASK_DELAY() \
+    trace_event(TRACE_TASK_DELAY, 0)
+#define traceTASK_DELAY_UNTIL(x) \
+    trace_event(TRACE_TASK_DELAY_UNTIL, 0)
+#define traceTASK_NOTIFY(uxIndexToNotify) \
+    trace_event(TRACE_TASK_NOTIFY, (uxIndexToNotify))
+#define traceTASK_NOTIFY_FROM_ISR(uxIndexToNotify) \
+    trace_event(TRACE_TASK_NOTIFY_FROM_ISR, (uxIndexToNotify))
+#define traceTASK_NOTIFY_GIVE_FROM_ISR(uxIndexToNotify) \
+    trace_event(TRACE_TASK_NOTIFY_FROM_ISR, (uxIndexToNotify))
+#define traceTASK_NOTIFY_TAKE_BLOCK(uxIndexToWait) \
+    trace_event(TRACE_BLOCKING_ON_NOTIFY, (uxIndexToWait))
+#define traceTASK_NOTIFY_WAIT_BLOCK(uxIndexToWait) \
+    trace_event(TRACE_BLOCKING_ON_NOTIFY, (uxIndexToWait))
+#define traceLOW_POWER_IDLE_BEGIN() \
+    trace_event(TRACE_LOW_POWER_IDLE_BEGIN, 0)
+#define traceLOW_POWER_IDLE_END() \
+    trace_event(TRACE_LOW_POWER_IDLE_END, 0)
+
+#endif // TRACE_ENABLED
+
+#if (TRACE_ENABLED == 1) || (TRACE_IRQ_STATS == 1)
+
+void trace_isr_enter(void);
+void trace_isr_exit(void);
+void trace_isr_latency(const uint32_t cycles);
+bool trace_irq_get(const uint32_t slot, trace_irq_stats_t *stats);
+void trace_irq_reset(void);
+
+/*!
+ * \brief Records entry to and exit from an interrupt handler
+ *
+ * Place TRACE_ISR_ENTER() at the start of a handler and TRACE_ISR_EXIT() at
+ * every exit. The IRQ number is taken from IPSR. A handler of a timer
+ * interrupt also calls TRACE_ISR_LATENCY() with the number of bus clock
+ * cycles since the timer requested the interrupt.
+ */
+#define TRACE_ISR_ENTER() \
+    do { PROBE_HIGH(PROBE_ISR); trace_isr_enter(); } while(0)
+#define TRACE_ISR_EXIT() \
+    do { trace_isr_exit(); PROBE_LOW(PROBE_ISR); } while(0)
+#define TRACE_ISR_LATENCY(cycles)   trace_isr_latency(cycles)
+
+#else
+
+#define TRACE_ISR_ENTER()           PROBE_HIGH(PROBE_ISR)
+#define TRACE_ISR_EXIT()            PROBE_LOW(PROBE_ISR)
+#define TRACE_ISR_LATENCY(cycles)
+
+#endif
+
+#endif // TRACE_H
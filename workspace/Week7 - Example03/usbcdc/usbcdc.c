@@ -0,0 +1,1285 @@
+/*! ***************************************************************************
+ *
+ * \brief     USB CDC-ACM virtual COM port on USB0
+ * \file      usbcdc.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+/*
+	USB CDC-ACM DEVICE ON USB0.
+
+	A full speed device with one configuration: the communication interface
+	with an interrupt IN endpoint that is never used, and the data interface
+	with a bulk OUT and a bulk IN endpoint of 64 bytes. The control requests
+	of enumeration and the CDC line coding and control line state requests
+	are answered in the USB0 interrupt.
+
+	The USB controller moves packets by DMA from and to the buffers of the
+	buffer descriptor table (BDT). Both bulk endpoints are double buffered
+	with the even and odd descriptors, so the controller transfers one packet
+	while the interrupt handles the other.
+
+	Writers copy into the transmit stream buffer under the mutex, as in the
+	serial driver, the interrupt moves it into the free IN descriptors. A
+	transfer that ends on a full packet is ended with a zero length packet,
+	so the host returns the data to the reader. Received packets are copied
+	into the receive stream buffer. A packet that does not fit is held in its
+	descriptor, which is then not given back to the controller, so the host
+	is NAKed until the reader made room.
+
+	The interrupt and the tasks work on the descriptors of the bulk endpoints
+	with interrupts masked by taskENTER_CRITICAL().
+*/
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+/* Library includes. */
+#include "xprintf.h"
+#include "MKL25Z4.h"
+
+/* Demo application includes. */
+#include "usbcdc.h"
+#include "clock.h"
+#include "irq_prio.h"
+#include "sections.h"
+
+/*---------------------------------------------------------------------------*/
+
+/* Misc defines. */
+#define usbNO_BLOCK             ( ( TickType_t ) 0 )
+#define usbTX_BLOCK_TIME        ( 40 / portTICK_PERIOD_MS )
+
+/* Endpoints. */
+#define usbEP0_SIZE             ( 64 )
+#define usbBULK_SIZE            ( 64 )
+#define usbNOTIFY_SIZE          ( 16 )
+#define usbEP_NOTIFY            ( 1 )
+#define usbEP_OUT               ( 2 )
+#define usbEP_IN                ( 3 )
+#define usbN_ENDPOINTS          ( 4 )
+
+/* Buffer descriptor fields. Software writes OWN, DATA1, DTS, STALL and the
+ * byte count, the controller writes back the PID of the token. */
+#define usbBD_OWN               ( 1UL << 7 )
+#define usbBD_DATA1             ( 1UL << 6 )
+#define usbBD_DTS               ( 1UL << 3 )
+#define usbBD_BC( x )           ( ( uint32_t )( x ) << 16 )
+#define usbBD_GET_BC( x )       ( ( ( x ) >> 16 ) & 0x3FFUL )
+#define usbBD_GET_PID( x )      ( ( ( x ) >> 2 ) & 0xFUL )
+#define usbBD_DESC( n, data1 )  ( usbBD_OWN | usbBD_DTS | usbBD_BC( n ) | \
+                                  ( ( data1 ) ? usbBD_DATA1 : 0 ) )
+
+/* Index of a descriptor in the BDT, also STAT >> 2 of a completed token. */
+#define usbBD_INDEX( ep, tx, odd )  ( ( ( ep ) << 2 ) | ( ( tx ) << 1 ) | ( odd ) )
+#define usbRX                   ( 0 )
+#define usbTX                   ( 1 )
+
+/* Token PIDs. */
+#define usbPID_OUT              ( 0x1 )
+#define usbPID_IN               ( 0x9 )
+#define usbPID_SETUP            ( 0xD )
+
+/* Requests, bmRequestType in the low byte and bRequest in the high byte. */
+#define usbREQ_GET_STATUS_DEVICE        ( 0x0080 )
+#define usbREQ_GET_STATUS_INTERFACE     ( 0x0081 )
+#define usbREQ_GET_STATUS_ENDPOINT      ( 0x0082 )
+#define usbREQ_CLEAR_FEATURE_ENDPOINT   ( 0x0102 )
+#define usbREQ_SET_FEATURE_ENDPOINT     ( 0x0302 )
+#define usbREQ_SET_ADDRESS              ( 0x0500 )
+#define usbREQ_GET_DESCRIPTOR           ( 0x0680 )
+#define usbREQ_GET_CONFIGURATION        ( 0x0880 )
+#define usbREQ_SET_CONFIGURATION        ( 0x0900 )
+#define usbREQ_GET_INTERFACE            ( 0x0A81 )
+#define usbREQ_SET_INTERFACE            ( 0x0B01 )
+#define usbREQ_SET_LINE_CODING          ( 0x2021 )
+#define usbREQ_GET_LINE_CODING          ( 0x21A1 )
+#define usbREQ_SET_CONTROL_LINE_STATE   ( 0x2221 )
+#define usbREQ_SEND_BREAK               ( 0x2321 )
+
+/* Descriptor types. */
+#define usbDESC_DEVICE          ( 1 )
+#define usbDESC_CONFIGURATION   ( 2 )
+#define usbDESC_STRING          ( 3 )
+
+/* DTR of SET_CONTROL_LINE_STATE, set while a terminal has the port open. */
+#define usbLINE_DTR             ( 0x01 )
+
+/* Longest string descriptor, in characters. */
+#define usbSTRING_MAX           ( ( usbEP0_SIZE - 2 ) / 2 )
+
+/*---------------------------------------------------------------------------*/
+
+/* Buffer descriptor. */
+typedef struct
+{
+    volatile uint32_t ulDesc;
+    void * volatile pvAddr;
+} xUsbBd;
+
+/* SETUP packet. */
+typedef struct __attribute__((packed))
+{
+    uint8_t bmRequestType;
+    uint8_t bRequest;
+    uint16_t wValue;
+    uint16_t wIndex;
+    uint16_t wLength;
+} xUsbSetup;
+
+/* CDC line coding, as sent by the host. */
+typedef struct __attribute__((packed))
+{
+    uint32_t dwDTERate;
+    uint8_t bCharFormat;
+    uint8_t bParityType;
+    uint8_t bDataBits;
+} xUsbLineCoding;
+
+/*---------------------------------------------------------------------------*/
+
+static const uint8_t ucDeviceDescriptor[] =
+{
+    18,                                 /* bLength */
+    usbDESC_DEVICE,                     /* bDescriptorType */
+    0x00, 0x02,                         /* bcdUSB 2.00 */
+    0x02,                               /* bDeviceClass CDC */
+    0x00,                               /* bDeviceSubClass */
+    0x00,                               /* bDeviceProtocol */
+    usbEP0_SIZE,                        /* bMaxPacketSize0 */
+    usbcdcVENDOR_ID & 0xFF, usbcdcVENDOR_ID >> 8,
+    usbcdcPRODUCT_ID & 0xFF, usbcdcPRODUCT_ID >> 8,
+    0x00, 0x01,                         /* bcdDevice 1.00 */
+    1,                                  /* iManufacturer */
+    2,                                  /* iProduct */
+    3,                                  /* iSerialNumber */
+    1                                   /* bNumConfigurations */
+};
+
+static const uint8_t ucConfigDescriptor[] =
+{
+    /* Configuration */
+    9, usbDESC_CONFIGURATION,
+    67, 0,                              /* wTotalLength */
+    2,                                  /* bNumInterfaces */
+    1,                                  /* bConfigurationValue */
+    0,                                  /* iConfiguration */
+    0x80,                               /* bmAttributes, bus powered */
+    50,                                 /* bMaxPower, 100 mA */
+
+    /* Communication interface */
+    9, 4, 0, 0, 1, 0x02, 0x02, 0x01, 0, /* CDC, ACM, AT commands */
+    5, 0x24, 0x00, 0x10, 0x01,          /* Header, CDC 1.10 */
+    5, 0x24, 0x01, 0x00, 1,             /* Call management, data interface 1 */
+    4, 0x24, 0x02, 0x06,                /* ACM, line coding and break */
+    5, 0x24, 0x06, 0, 1,                /* Union, interface 0 and 1 */
+    7, 5, 0x80 | usbEP_NOTIFY, 0x03, usbNOTIFY_SIZE, 0, 64,
+
+    /* Data interface */
+    9, 4, 1, 0, 2, 0x0A, 0x00, 0x00, 0,
+    7, 5, usbEP_OUT, 0x02, usbBULK_SIZE, 0, 0,
+    7, 5, 0x80 | usbEP_IN, 0x02, usbBULK_SIZE, 0, 0
+};
+
+static const uint8_t ucLanguageDescriptor[] =
+{
+    4, usbDESC_STRING, 0x09, 0x04       /* English (United States) */
+};
+
+static const char * const pcStrings[] =
+{
+    "HAN University of Applied Sciences",
+    "FRDM-KL25Z MIC5 Week 7 Example 3",
+};
+
+/*---------------------------------------------------------------------------*/
+
+/* The BDT must be aligned to 512 bytes, only the descriptors of the
+ * endpoints in use are allocated. */
+static __BSS_SRAM_U xUsbBd xBdt[ usbN_ENDPOINTS * 4 ] __attribute__((aligned(512)));
+
+/* Packet buffers, read and written by the controller. */
+static __BSS_SRAM_U uint8_t ucEp0Rx[ 2 ][ usbEP0_SIZE ];
+static __BSS_SRAM_U uint8_t ucEp0Tx[ 2 ][ usbEP0_SIZE ];
+static __BSS_SRAM_U uint8_t ucBulkOut[ 2 ][ usbBULK_SIZE ];
+static __BSS_SRAM_U uint8_t ucBulkIn[ 2 ][ usbBULK_SIZE ];
+
+/* Control transfer in progress. */
+static xUsbSetup xSetup;
+static const uint8_t * pucEp0TxData = NULL;
+static uint16_t usEp0TxLeft = 0;
+static bool xEp0TxZlp = false;
+static uint8_t ucEp0TxOdd = 0;
+static uint8_t ucEp0TxData1 = 0;
+
+/* Device state. */
+static volatile uint8_t ucConfiguration = 0;
+static volatile uint8_t ucLineState = 0;
+static xUsbLineCoding xLineCoding = { 115200, 0, 0, 8 };
+static char cSerialNumber[ 21 ];
+
+/* Bulk IN: the next descriptor, its data toggle, the descriptors owned by
+ * the controller and whether the last packet was a full one. */
+static uint8_t ucInOdd = 0;
+static uint8_t ucInData1 = 0;
+static uint8_t ucInBusy = 0;
+static bool xInZlp = false;
+
+/* Bulk OUT: the next descriptor to complete, the data toggle of each
+ * descriptor and the completed descriptors that wait for room. */
+static uint8_t ucOutOdd = 0;
+static uint8_t ucOutData1[ 2 ] = { 0, 1 };
+static uint8_t ucOutHeld = 0;
+
+/* Stream buffers, mutex and transmit policy, as in the serial driver. */
+static StreamBufferHandle_t xRxedChars = NULL;
+static StreamBufferHandle_t xCharsForTx = NULL;
+static SemaphoreHandle_t xStringMutex = NULL;
+static StaticStreamBuffer_t xRxedCharsBuffer;
+static StaticStreamBuffer_t xCharsForTxBuffer;
+static StaticSemaphore_t xStringMutexBuffer;
+static uint8_t ucRxStorage[ usbcdcRX_BUFFER_SIZE + 1 ];
+static uint8_t ucTxStorage[ usbcdcTX_BUFFER_SIZE + 1 ];
+static eSerialTxPolicy eTxPolicy = serTX_DEFAULT_POLICY;
+static TickType_t xTxPolicyBlockTime = usbTX_BLOCK_TIME;
+static volatile SerialStats_t xStats;
+
+/* Clock mode changes. */
+static clk_notifier_t xClock;
+
+static void prvUsbReset( void );
+static void prvUsbAttach( void );
+static void prvUsbDetach( void );
+static void prvUsbClock( const clk_event_t eEvent, void *pvArg );
+static void prvUsbTxFill( portBASE_TYPE *pxHigherPriorityTaskWoken );
+static void prvUsbRxDrain( portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/*---------------------------------------------------------------------------*/
+
+portBASE_TYPE xUsbCdcInit( void )
+{
+    uintptr_t ulBdt = ( uintptr_t ) xBdt;
+
+    xRxedChars = xStreamBufferCreateStatic( usbcdcRX_BUFFER_SIZE, serRX_TRIGGER_LEVEL,
+                                            ucRxStorage, &xRxedCharsBuffer );
+    xCharsForTx = xStreamBufferCreateStatic( usbcdcTX_BUFFER_SIZE, 1,
+                                             ucTxStorage, &xCharsForTxBuffer );
+    xStringMutex = xSemaphoreCreateMutexStatic( &xStringMutexBuffer );
+
+    if( ( xRxedChars == NULL ) || ( xCharsForTx == NULL ) || ( xStringMutex == NULL ) )
+    {
+        return pdFALSE;
+    }
+
+    /* The serial number is the unique ID of the MCU, 80 bits in hex. */
+    ( void ) xsnprintf( cSerialNumber, sizeof( cSerialNumber ), "%04lX%08lX%08lX",
+                        ( unsigned long )( SIM->UIDMH & 0xFFFF ),
+                        ( unsigned long ) SIM->UIDML, ( unsigned long ) SIM->UIDL );
+
+    // The USB clock is MCGPLLCLK / 2, the PLL/FLL selection of CLK_RUN
+    SIM->SOPT2 |= SIM_SOPT2_USBSRC_MASK;
+    clk_gate_acquire( CLK_GATE_USBOTG );
+
+    // Reset the module
+    USB0->USBTRC0 |= USB_USBTRC0_USBRESET_MASK;
+    while( USB0->USBTRC0 & USB_USBTRC0_USBRESET_MASK )
+    {}
+
+    USB0->BDTPAGE1 = ( uint8_t )( ulBdt >> 8 ) & USB_BDTPAGE1_BDTBA_MASK;
+    USB0->BDTPAGE2 = ( uint8_t )( ulBdt >> 16 );
+    USB0->BDTPAGE3 = ( uint8_t )( ulBdt >> 24 );
+
+    USB0->ISTAT = 0xFF;
+    USB0->ERRSTAT = 0xFF;
+    USB0->OTGISTAT = 0xFF;
+
+    // Bit 6 of USBTRC0 must be set according to the reference manual
+    USB0->USBTRC0 |= 0x40;
+
+    USB0->CTL = USB_CTL_USBENSOFEN_MASK;
+    USB0->USBCTRL = 0;
+
+    NVIC_SetPriority( USB0_IRQn, IRQ_PRIO(USB) );
+    NVIC_ClearPendingIRQ( USB0_IRQn );
+    NVIC_EnableIRQ( USB0_IRQn );
+
+    // Detach in the clock modes without the PLL
+    clk_register( &xClock, prvUsbClock, NULL );
+
+    if( clk_get_mode() == CLK_RUN )
+    {
+        prvUsbAttach();
+    }
+
+    return pdTRUE;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Connects the D+ pull-up, the host then resets and enumerates the device.
+ */
+static void prvUsbAttach( void )
+{
+    USB0->INTEN = USB_INTEN_USBRSTEN_MASK;
+    USB0->CONTROL = USB_CONTROL_DPPULLUPNONOTG_MASK;
+}
+
+/*
+ * Disconnects from the bus. Data in the transmit stream buffer is kept.
+ */
+static void prvUsbDetach( void )
+{
+    taskENTER_CRITICAL();
+    {
+        USB0->CONTROL = 0;
+        USB0->INTEN = 0;
+        USB0->ISTAT = 0xFF;
+
+        for( uint32_t i = 0; i < usbN_ENDPOINTS; i++ )
+        {
+            USB0->ENDPOINT[ i ].ENDPT = 0;
+        }
+
+        ucConfiguration = 0;
+        ucLineState = 0;
+        ucInBusy = 0;
+        ucOutHeld = 0;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * The PLL stops in the other clock modes, so the device leaves the bus
+ * before a clock mode change and only returns in CLK_RUN.
+ */
+static void prvUsbClock( const clk_event_t eEvent, void *pvArg )
+{
+    ( void ) pvArg;
+
+    if( eEvent == CLK_PRE_CHANGE )
+    {
+        prvUsbDetach();
+    }
+    else if( clk_get_mode() == CLK_RUN )
+    {
+        prvUsbAttach();
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Bus reset: address 0, only endpoint 0 with both receive descriptors
+ * ready for a SETUP packet.
+ */
+static void prvUsbReset( void )
+{
+    USB0->CTL |= USB_CTL_ODDRST_MASK;
+
+    for( uint32_t i = 0; i < ( usbN_ENDPOINTS * 4 ); i++ )
+    {
+        xBdt[ i ].ulDesc = 0;
+    }
+
+    for( uint32_t i = 1; i < usbN_ENDPOINTS; i++ )
+    {
+        USB0->ENDPOINT[ i ].ENDPT = 0;
+    }
+
+    xBdt[ usbBD_INDEX( 0, usbRX, 0 ) ].pvAddr = ucEp0Rx[ 0 ];
+    xBdt[ usbBD_INDEX( 0, usbRX, 0 ) ].ulDesc = usbBD_DESC( usbEP0_SIZE, 0 );
+    xBdt[ usbBD_INDEX( 0, usbRX, 1 ) ].pvAddr = ucEp0Rx[ 1 ];
+    xBdt[ usbBD_INDEX( 0, usbRX, 1 ) ].ulDesc = usbBD_DESC( usbEP0_SIZE, 0 );
+    xBdt[ usbBD_INDEX( 0, usbTX, 0 ) ].pvAddr = ucEp0Tx[ 0 ];
+    xBdt[ usbBD_INDEX( 0, usbTX, 1 ) ].pvAddr = ucEp0Tx[ 1 ];
+
+    USB0->ENDPOINT[ 0 ].ENDPT = USB_ENDPT_EPHSHK_MASK | USB_ENDPT_EPTXEN_MASK |
+                                USB_ENDPT_EPRXEN_MASK;
+
+    ucEp0TxOdd = 0;
+    ucEp0TxData1 = 0;
+    usEp0TxLeft = 0;
+    xEp0TxZlp = false;
+    ucConfiguration = 0;
+    ucLineState = 0;
+    ucInBusy = 0;
+    ucOutHeld = 0;
+
+    USB0->ERRSTAT = 0xFF;
+    USB0->ISTAT = 0xFF;
+    USB0->ADDR = 0;
+    USB0->ERREN = 0xFF;
+    USB0->INTEN = USB_INTEN_USBRSTEN_MASK | USB_INTEN_TOKDNEEN_MASK |
+                  USB_INTEN_STALLEN_MASK | USB_INTEN_ERROREN_MASK;
+
+    USB0->CTL = USB_CTL_USBENSOFEN_MASK;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Queues the next packet of the control transfer on endpoint 0, or the zero
+ * length packet that ends it.
+ */
+static void prvUsbEp0Next( void )
+{
+    size_t xLength = ( usEp0TxLeft < usbEP0_SIZE ) ? usEp0TxLeft : usbEP0_SIZE;
+    xUsbBd *pxBd = &xBdt[ usbBD_INDEX( 0, usbTX, ucEp0TxOdd ) ];
+
+    if( xLength == 0 )
+    {
+        if( !xEp0TxZlp )
+        {
+            return;
+        }
+
+        xEp0TxZlp = false;
+    }
+
+    memcpy( pxBd->pvAddr, pucEp0TxData, xLength );
+    pucEp0TxData += xLength;
+    usEp0TxLeft -= xLength;
+
+    pxBd->ulDesc = usbBD_DESC( xLength, ucEp0TxData1 );
+    ucEp0TxData1 ^= 1;
+    ucEp0TxOdd ^= 1;
+}
+
+/*
+ * Starts the data stage of a control read. A reply shorter than wLength
+ * that ends on a full packet is ended with a zero length packet. The first
+ * two packets are queued in both transmit descriptors.
+ */
+static void prvUsbEp0Send( const void *pvData, size_t xLength )
+{
+    if( xLength > xSetup.wLength )
+    {
+        xLength = xSetup.wLength;
+    }
+
+    pucEp0TxData = ( const uint8_t * ) pvData;
+    usEp0TxLeft = ( uint16_t ) xLength;
+    xEp0TxZlp = ( xLength < xSetup.wLength ) && ( ( xLength % usbEP0_SIZE ) == 0 );
+
+    // A zero length reply is the status stage itself
+    if( xLength == 0 )
+    {
+        xEp0TxZlp = true;
+    }
+
+    prvUsbEp0Next();
+    prvUsbEp0Next();
+}
+
+/*
+ * Answers the status stage of a control write with a zero length packet.
+ */
+static void prvUsbEp0Ack( void )
+{
+    prvUsbEp0Send( NULL, 0 );
+}
+
+/*
+ * Refuses the request. The stall ends with the next SETUP packet.
+ */
+static void prvUsbEp0Stall( void )
+{
+    USB0->ENDPOINT[ 0 ].ENDPT = USB_ENDPT_EPSTALL_MASK | USB_ENDPT_EPHSHK_MASK |
+                                USB_ENDPT_EPTXEN_MASK | USB_ENDPT_EPRXEN_MASK;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Sends a string descriptor, converted from ASCII to UTF-16LE in the second
+ * transmit buffer of endpoint 0 and sent from there.
+ */
+static void prvUsbSendString( const char *pcString )
+{
+    static uint8_t ucString[ 2 + 2 * usbSTRING_MAX ];
+    size_t xLength = strlen( pcString );
+
+    if( xLength > usbSTRING_MAX )
+    {
+        xLength = usbSTRING_MAX;
+    }
+
+    ucString[ 0 ] = ( uint8_t )( 2 + 2 * xLength );
+    ucString[ 1 ] = usbDESC_STRING;
+
+    for( size_t i = 0; i < xLength; i++ )
+    {
+        ucString[ 2 + 2 * i ] = ( uint8_t ) pcString[ i ];
+        ucString[ 3 + 2 * i ] = 0;
+    }
+
+    prvUsbEp0Send( ucString, ucString[ 0 ] );
+}
+
+/*
+ * Selects configuration 1: enables the endpoints of the CDC interfaces and
+ * readies both OUT descriptors, or disables them for configuration 0.
+ */
+static void prvUsbConfigure( const uint8_t ucValue )
+{
+    const uint8_t ucBulk = USB_ENDPT_EPHSHK_MASK | USB_ENDPT_EPCTLDIS_MASK;
+
+    ucConfiguration = ucValue;
+    ucInBusy = 0;
+    ucInOdd = 0;
+    ucInData1 = 0;
+    xInZlp = false;
+    ucOutOdd = 0;
+    ucOutData1[ 0 ] = 0;
+    ucOutData1[ 1 ] = 1;
+    ucOutHeld = 0;
+
+    for( uint32_t i = 4; i < ( usbN_ENDPOINTS * 4 ); i++ )
+    {
+        xBdt[ i ].ulDesc = 0;
+    }
+
+    // All endpoints restart with their even descriptor
+    USB0->CTL |= USB_CTL_ODDRST_MASK;
+    USB0->CTL &= ~USB_CTL_ODDRST_MASK;
+    ucEp0TxOdd = 0;
+
+    if( ucValue == 0 )
+    {
+        for( uint32_t i = 1; i < usbN_ENDPOINTS; i++ )
+        {
+            USB0->ENDPOINT[ i ].ENDPT = 0;
+        }
+
+        return;
+    }
+
+    USB0->ENDPOINT[ usbEP_NOTIFY ].ENDPT = ucBulk | USB_ENDPT_EPTXEN_MASK;
+    USB0->ENDPOINT[ usbEP_OUT ].ENDPT = ucBulk | USB_ENDPT_EPRXEN_MASK;
+    USB0->ENDPOINT[ usbEP_IN ].ENDPT = ucBulk | USB_ENDPT_EPTXEN_MASK;
+
+    for( uint32_t i = 0; i < 2; i++ )
+    {
+        xBdt[ usbBD_INDEX( usbEP_OUT, usbRX, i ) ].pvAddr = ucBulkOut[ i ];
+        xBdt[ usbBD_INDEX( usbEP_OUT, usbRX, i ) ].ulDesc = usbBD_DESC( usbBULK_SIZE, ucOutData1[ i ] );
+        xBdt[ usbBD_INDEX( usbEP_IN, usbTX, i ) ].pvAddr = ucBulkIn[ i ];
+    }
+}
+
+/*
+ * Clears or sets the halt of a bulk endpoint. A cleared endpoint restarts
+ * with DATA0 on the descriptor it uses next.
+ */
+static portBASE_TYPE prvUsbHalt( const uint16_t usEndpoint, const bool xHalt )
+{
+    const uint32_t ulEp = usEndpoint & 0x0F;
+
+    if( ( ulEp == 0 ) || ( ulEp >= usbN_ENDPOINTS ) || ( ucConfiguration == 0 ) )
+    {
+        return pdFALSE;
+    }
+
+    if( xHalt )
+    {
+        USB0->ENDPOINT[ ulEp ].ENDPT |= USB_ENDPT_EPSTALL_MASK;
+        return pdTRUE;
+    }
+
+    if( ulEp == usbEP_IN )
+    {
+        ucInData1 = 0;
+    }
+    else if( ulEp == usbEP_OUT )
+    {
+        ucOutData1[ ucOutOdd ] = 0;
+        ucOutData1[ ucOutOdd ^ 1 ] = 1;
+
+        for( uint32_t i = 0; i < 2; i++ )
+        {
+            if( ( ucOutHeld & ( 1 << i ) ) == 0 )
+            {
+                xBdt[ usbBD_INDEX( usbEP_OUT, usbRX, i ) ].ulDesc = usbBD_DESC( usbBULK_SIZE, ucOutData1[ i ] );
+            }
+        }
+    }
+
+    USB0->ENDPOINT[ ulEp ].ENDPT &= ~USB_ENDPT_EPSTALL_MASK;
+
+    return pdTRUE;
+}
+
+/*
+ * Handles a SETUP packet on endpoint 0.
+ */
+static void prvUsbSetup( portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+    static uint8_t ucReply[ 2 ];
+    const uint16_t usRequest = ( uint16_t )( xSetup.bmRequestType | ( xSetup.bRequest << 8 ) );
+
+    switch( usRequest )
+    {
+    case usbREQ_GET_DESCRIPTOR:
+        switch( xSetup.wValue >> 8 )
+        {
+        case usbDESC_DEVICE:
+            prvUsbEp0Send( ucDeviceDescriptor, sizeof( ucDeviceDescriptor ) );
+            break;
+        case usbDESC_CONFIGURATION:
+            prvUsbEp0Send( ucConfigDescriptor, sizeof( ucConfigDescriptor ) );
+            break;
+        case usbDESC_STRING:
+            if( ( xSetup.wValue & 0xFF ) == 0 )
+            {
+                prvUsbEp0Send( ucLanguageDescriptor, sizeof( ucLanguageDescriptor ) );
+            }
+            else if( ( xSetup.wValue & 0xFF ) <= 2 )
+            {
+                prvUsbSendString( pcStrings[ ( xSetup.wValue & 0xFF ) - 1 ] );
+            }
+            else if( ( xSetup.wValue & 0xFF ) == 3 )
+            {
+                prvUsbSendString( cSerialNumber );
+            }
+            else
+            {
+                prvUsbEp0Stall();
+            }
+            break;
+        default:
+            // No device qualifier, the device is full speed only
+            prvUsbEp0Stall();
+            break;
+        }
+        break;
+
+    case usbREQ_SET_ADDRESS:
+        // The address is set after the status stage, see the IN token
+        prvUsbEp0Ack();
+        break;
+
+    case usbREQ_SET_CONFIGURATION:
+        if( xSetup.wValue <= 1 )
+        {
+            prvUsbConfigure( ( uint8_t ) xSetup.wValue );
+            prvUsbEp0Ack();
+        }
+        else
+        {
+            prvUsbEp0Stall();
+        }
+        break;
+
+    case usbREQ_GET_CONFIGURATION:
+        ucReply[ 0 ] = ucConfiguration;
+        prvUsbEp0Send( ucReply, 1 );
+        break;
+
+    case usbREQ_GET_STATUS_DEVICE:
+    case usbREQ_GET_STATUS_INTERFACE:
+        ucReply[ 0 ] = 0;
+        ucReply[ 1 ] = 0;
+        prvUsbEp0Send( ucReply, 2 );
+        break;
+
+    case usbREQ_GET_STATUS_ENDPOINT:
+        ucReply[ 0 ] = ( ( xSetup.wIndex & 0x0F ) < usbN_ENDPOINTS ) &&
+                       ( USB0->ENDPOINT[ xSetup.wIndex & 0x0F ].ENDPT & USB_ENDPT_EPSTALL_MASK ) ? 1 : 0;
+        ucReply[ 1 ] = 0;
+        prvUsbEp0Send( ucReply, 2 );
+        break;
+
+    case usbREQ_CLEAR_FEATURE_ENDPOINT:
+    case usbREQ_SET_FEATURE_ENDPOINT:
+        // ENDPOINT_HALT is the only endpoint feature
+        if( ( xSetup.wValue == 0 ) &&
+            ( prvUsbHalt( xSetup.wIndex, usRequest == usbREQ_SET_FEATURE_ENDPOINT ) == pdTRUE ) )
+        {
+            prvUsbEp0Ack();
+        }
+        else
+        {
+            prvUsbEp0Stall();
+        }
+        break;
+
+    case usbREQ_GET_INTERFACE:
+        ucReply[ 0 ] = 0;
+        prvUsbEp0Send( ucReply, 1 );
+        break;
+
+    case usbREQ_SET_INTERFACE:
+        // Both interfaces have alternate setting 0 only
+        if( xSetup.wValue == 0 )
+        {
+            prvUsbEp0Ack();
+        }
+        else
+        {
+            prvUsbEp0Stall();
+        }
+        break;
+
+    case usbREQ_SET_LINE_CODING:
+        // Answered when the data stage arrived, see the OUT token
+        break;
+
+    case usbREQ_GET_LINE_CODING:
+        prvUsbEp0Send( &xLineCoding, sizeof( xLineCoding ) );
+        break;
+
+    case usbREQ_SET_CONTROL_LINE_STATE:
+        ucLineState = ( uint8_t ) xSetup.wValue;
+        prvUsbEp0Ack();
+
+        // A terminal opened the port, send what was buffered
+        prvUsbTxFill( pxHigherPriorityTaskWoken );
+        break;
+
+    case usbREQ_SEND_BREAK:
+        prvUsbEp0Ack();
+        break;
+
+    default:
+        prvUsbEp0Stall();
+        break;
+    }
+}
+
+/*
+ * Handles a completed token on endpoint 0.
+ */
+static void prvUsbEp0Token( xUsbBd *pxBd, portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+    const uint32_t ulDesc = pxBd->ulDesc;
+
+    switch( usbBD_GET_PID( ulDesc ) )
+    {
+    case usbPID_SETUP:
+        memcpy( &xSetup, pxBd->pvAddr, sizeof( xSetup ) );
+        pxBd->ulDesc = usbBD_DESC( usbEP0_SIZE, 1 );
+
+        // A SETUP packet ends a control transfer that was still sending
+        xBdt[ usbBD_INDEX( 0, usbTX, 0 ) ].ulDesc = 0;
+        xBdt[ usbBD_INDEX( 0, usbTX, 1 ) ].ulDesc = 0;
+        usEp0TxLeft = 0;
+        xEp0TxZlp = false;
+        ucEp0TxData1 = 1;
+
+        prvUsbSetup( pxHigherPriorityTaskWoken );
+
+        // The controller holds token processing after a SETUP packet
+        USB0->CTL = USB_CTL_USBENSOFEN_MASK;
+        break;
+
+    case usbPID_OUT:
+        if( ( ( xSetup.bmRequestType | ( xSetup.bRequest << 8 ) ) == usbREQ_SET_LINE_CODING ) &&
+            ( usbBD_GET_BC( ulDesc ) >= sizeof( xLineCoding ) ) )
+        {
+            memcpy( &xLineCoding, pxBd->pvAddr, sizeof( xLineCoding ) );
+            xSetup.bRequest = 0;
+            prvUsbEp0Ack();
+        }
+
+        pxBd->ulDesc = usbBD_DESC( usbEP0_SIZE, 1 );
+        break;
+
+    case usbPID_IN:
+        prvUsbEp0Next();
+
+        if( ( xSetup.bmRequestType | ( xSetup.bRequest << 8 ) ) == usbREQ_SET_ADDRESS )
+        {
+            USB0->ADDR = ( uint8_t )( xSetup.wValue & USB_ADDR_ADDR_MASK );
+            xSetup.bRequest = 0;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Moves the transmit stream buffer into the free IN descriptors. Called by
+ * the interrupt and, with interrupts masked, by the writers.
+ */
+static void prvUsbTxFill( portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+    size_t xLength;
+
+    if( ucConfiguration == 0 )
+    {
+        return;
+    }
+
+    while( ucInBusy < 2 )
+    {
+        xUsbBd *pxBd = &xBdt[ usbBD_INDEX( usbEP_IN, usbTX, ucInOdd ) ];
+
+        xLength = xStreamBufferReceiveFromISR( xCharsForTx, pxBd->pvAddr, usbBULK_SIZE,
+                                               pxHigherPriorityTaskWoken );
+
+        if( ( xLength == 0 ) && !xInZlp )
+        {
+            break;
+        }
+
+        xInZlp = ( xLength == usbBULK_SIZE );
+
+        pxBd->ulDesc = usbBD_DESC( xLength, ucInData1 );
+        ucInData1 ^= 1;
+        ucInOdd ^= 1;
+        ucInBusy++;
+    }
+}
+
+/*
+ * Copies the received OUT packets into the receive stream buffer in the
+ * order they arrived, and gives their descriptors back to the controller.
+ * Stops at a packet that does not fit. Called by the interrupt and, with
+ * interrupts masked, by the reader.
+ */
+static void prvUsbRxDrain( portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+    while( ucOutHeld & ( 1 << ucOutOdd ) )
+    {
+        xUsbBd *pxBd = &xBdt[ usbBD_INDEX( usbEP_OUT, usbRX, ucOutOdd ) ];
+        const size_t xLength = usbBD_GET_BC( pxBd->ulDesc );
+
+        if( xStreamBufferSpacesAvailable( xRxedChars ) < xLength )
+        {
+            break;
+        }
+
+        ( void ) xStreamBufferSendFromISR( xRxedChars, pxBd->pvAddr, xLength,
+                                           pxHigherPriorityTaskWoken );
+
+        const size_t xUsed = xStreamBufferBytesAvailable( xRxedChars );
+
+        if( xUsed > xStats.xRxHighWaterMark )
+        {
+            xStats.xRxHighWaterMark = xUsed;
+        }
+
+        ucOutHeld &= ~( 1 << ucOutOdd );
+        pxBd->ulDesc = usbBD_DESC( usbBULK_SIZE, ucOutData1[ ucOutOdd ] );
+        ucOutOdd ^= 1;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+void USB0_IRQHandler( void )
+{
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+    const uint8_t ucStatus = USB0->ISTAT & USB0->INTEN;
+
+    if( ucStatus & USB_ISTAT_USBRST_MASK )
+    {
+        prvUsbReset();
+        return;
+    }
+
+    if( ucStatus & USB_ISTAT_ERROR_MASK )
+    {
+        USB0->ERRSTAT = 0xFF;
+        USB0->ISTAT = USB_ISTAT_ERROR_MASK;
+    }
+
+    if( ucStatus & USB_ISTAT_STALL_MASK )
+    {
+        // The stall of endpoint 0 was sent, the next SETUP is accepted again
+        USB0->ENDPOINT[ 0 ].ENDPT = USB_ENDPT_EPHSHK_MASK | USB_ENDPT_EPTXEN_MASK |
+                                    USB_ENDPT_EPRXEN_MASK;
+        USB0->ISTAT = USB_ISTAT_STALL_MASK;
+    }
+
+    if( ucStatus & USB_ISTAT_TOKDNE_MASK )
+    {
+        const uint8_t ucStat = USB0->STAT;
+        const uint32_t ulEp = ( ucStat & USB_STAT_ENDP_MASK ) >> USB_STAT_ENDP_SHIFT;
+        xUsbBd *pxBd = &xBdt[ ucStat >> 2 ];
+
+        if( ulEp == 0 )
+        {
+            prvUsbEp0Token( pxBd, &xHigherPriorityTaskWoken );
+        }
+        else if( ulEp == usbEP_OUT )
+        {
+            // Received in the descriptor the controller used, which is
+            // ucOutOdd unless a packet before it is still held
+            ucOutHeld |= 1 << ( ( ucStat & USB_STAT_ODD_MASK ) ? 1 : 0 );
+            prvUsbRxDrain( &xHigherPriorityTaskWoken );
+        }
+        else if( ulEp == usbEP_IN )
+        {
+            if( ucInBusy > 0 )
+            {
+                ucInBusy--;
+            }
+
+            prvUsbTxFill( &xHigherPriorityTaskWoken );
+        }
+
+        USB0->ISTAT = USB_ISTAT_TOKDNE_MASK;
+    }
+
+    portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Moves newly written data to the IN descriptors.
+ */
+static void prvUsbStartTx( void )
+{
+    const size_t xUsed = xStreamBufferBytesAvailable( xCharsForTx );
+
+    if( xUsed > xStats.xTxHighWaterMark )
+    {
+        xStats.xTxHighWaterMark = xUsed;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        prvUsbTxFill( NULL );
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Gives held OUT descriptors back after the reader made room.
+ */
+static void prvUsbStartRx( void )
+{
+    taskENTER_CRITICAL();
+    {
+        prvUsbRxDrain( NULL );
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Discards the xCount oldest bytes of the transmit stream buffer, with the
+ * interrupt, the other reader, masked.
+ */
+static void prvUsbDiscardOldest( size_t xCount )
+{
+    char cScratch[ 16 ];
+    size_t xChunk;
+
+    taskENTER_CRITICAL();
+    {
+        while( xCount > 0 )
+        {
+            xChunk = ( xCount < sizeof( cScratch ) ) ? xCount : sizeof( cScratch );
+            xChunk = xStreamBufferReceive( xCharsForTx, cScratch, xChunk, usbNO_BLOCK );
+
+            if( xChunk == 0 )
+            {
+                break;
+            }
+
+            xStats.ulTxBytesDropped += xChunk;
+            xCount -= xChunk;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Writes xLength bytes into the transmit stream buffer according to
+ * ePolicy, as prvSerialWrite() of the serial driver. The caller must hold
+ * the mutex.
+ */
+static size_t prvUsbWrite( const char * pcBuffer, size_t xLength,
+                           eSerialTxPolicy ePolicy, TickType_t xBlockTime )
+{
+    size_t xWritten = 0;
+    size_t xSent;
+    size_t xSpace;
+
+    switch( ePolicy )
+    {
+    case eSerialBlock:
+        while( xWritten < xLength )
+        {
+            xSent = xStreamBufferSend( xCharsForTx, &pcBuffer[ xWritten ],
+                                       xLength - xWritten, xBlockTime );
+
+            if( xSent == 0 )
+            {
+                break;
+            }
+
+            xWritten += xSent;
+            prvUsbStartTx();
+        }
+        break;
+
+    case eSerialDropOldest:
+        if( xLength > usbcdcTX_BUFFER_SIZE )
+        {
+            xStats.ulTxBytesDropped += xLength - usbcdcTX_BUFFER_SIZE;
+            pcBuffer += xLength - usbcdcTX_BUFFER_SIZE;
+            xLength = usbcdcTX_BUFFER_SIZE;
+        }
+
+        xSpace = xStreamBufferSpacesAvailable( xCharsForTx );
+        if( xSpace < xLength )
+        {
+            prvUsbDiscardOldest( xLength - xSpace );
+        }
+
+        xWritten = xStreamBufferSend( xCharsForTx, pcBuffer, xLength, usbNO_BLOCK );
+        prvUsbStartTx();
+        break;
+
+    case eSerialDropNewest:
+    default:
+        xWritten = xStreamBufferSend( xCharsForTx, pcBuffer, xLength, usbNO_BLOCK );
+        prvUsbStartTx();
+        break;
+    }
+
+    xStats.ulTxBytesDropped += xLength - xWritten;
+
+    return xWritten;
+}
+
+/*---------------------------------------------------------------------------*/
+
+portBASE_TYPE xUsbCdcConnected( void )
+{
+    return ( ( ucConfiguration != 0 ) && ( ucLineState & usbLINE_DTR ) ) ? pdTRUE : pdFALSE;
+}
+
+/*---------------------------------------------------------------------------*/
+
+portBASE_TYPE xUsbCdcPutChar( char cOutChar, TickType_t xBlockTime )
+{
+    portBASE_TYPE xReturn = pdFAIL;
+
+    if( ( xStringMutex != NULL ) && ( xSemaphoreTake( xStringMutex, xBlockTime ) == pdTRUE ) )
+    {
+        if( prvUsbWrite( &cOutChar, 1, eSerialBlock, xBlockTime ) == 1 )
+        {
+            xReturn = pdPASS;
+        }
+
+        xSemaphoreGive( xStringMutex );
+    }
+
+    return xReturn;
+}
+
+/*---------------------------------------------------------------------------*/
+
+portBASE_TYPE xUsbCdcGetChar( char * pcRxedChar, TickType_t xBlockTime )
+{
+    portBASE_TYPE xReturn = pdFALSE;
+
+    if( ( xRxedChars != NULL ) &&
+        ( xStreamBufferReceive( xRxedChars, pcRxedChar, 1, xBlockTime ) == 1 ) )
+    {
+        xReturn = pdTRUE;
+    }
+
+    if( xRxedChars != NULL )
+    {
+        prvUsbStartRx();
+    }
+
+    return xReturn;
+}
+
+/*---------------------------------------------------------------------------*/
+
+size_t xUsbCdcWrite( const void * pvBuffer, size_t xLength )
+{
+    size_t xWritten = 0;
+
+    if( ( xStringMutex != NULL ) && ( xSemaphoreTake( xStringMutex, portMAX_DELAY ) == pdTRUE ) )
+    {
+        xWritten = prvUsbWrite( ( const char * ) pvBuffer, xLength, eTxPolicy, xTxPolicyBlockTime );
+
+        xSemaphoreGive( xStringMutex );
+    }
+
+    return xWritten;
+}
+
+/*---------------------------------------------------------------------------*/
+
+size_t xUsbCdcRead( void * pvBuffer, size_t xLength, TickType_t xBlockTime )
+{
+    size_t xReceived;
+
+    if( xRxedChars == NULL )
+    {
+        return 0;
+    }
+
+    // Returns as soon as serRX_TRIGGER_LEVEL bytes are available, or with
+    // whatever arrived when xBlockTime expires.
+    xReceived = xStreamBufferReceive( xRxedChars, pvBuffer, xLength, xBlockTime );
+    prvUsbStartRx();
+
+    return xReceived;
+}
+
+/*---------------------------------------------------------------------------*/
+
+void vUsbCdcPutString( const char * const pcString )
+{
+    ( void ) xUsbCdcWrite( pcString, strlen( pcString ) );
+}
+
+/*---------------------------------------------------------------------------*/
+
+size_t xUsbCdcPutStringPolicy( const char * const pcString,
+                               eSerialTxPolicy ePolicy, TickType_t xBlockTime )
+{
+    size_t xWritten = 0;
+
+    if( ( xStringMutex != NULL ) && ( xSemaphoreTake( xStringMutex, portMAX_DELAY ) == pdTRUE ) )
+    {
+        xWritten = prvUsbWrite( pcString, strlen( pcString ), ePolicy, xBlockTime );
+
+        xSemaphoreGive( xStringMutex );
+    }
+
+    return xWritten;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Passes a piece of xvformat() output to the transmit stream buffer, the
+ * caller holds the mutex.
+ */
+static void prvUsbFormatOut( void * pvArg, const char * pcString, size_t xLength )
+{
+    ( void ) pvArg;
+
+    ( void ) prvUsbWrite( pcString, xLength, eTxPolicy, xTxPolicyBlockTime );
+}
+
+size_t xUsbCdcVPrintf( const char * pcFormat, va_list xArgs )
+{
+    size_t xLength = 0;
+
+    if( ( xStringMutex != NULL ) && ( xSemaphoreTake( xStringMutex, portMAX_DELAY ) == pdTRUE ) )
+    {
+        xLength = xvformat( prvUsbFormatOut, NULL, pcFormat, xArgs );
+
+        xSemaphoreGive( xStringMutex );
+    }
+
+    return xLength;
+}
+
+size_t xUsbCdcPrintf( const char * pcFormat, ... )
+{
+    va_list xArgs;
+
+    va_start( xArgs, pcFormat );
+    const size_t xLength = xUsbCdcVPrintf( pcFormat, xArgs );
+    va_end( xArgs );
+
+    return xLength;
+}
+
+/*---------------------------------------------------------------------------*/
+
+void vUsbCdcSetTxPolicy( eSerialTxPolicy ePolicy, TickType_t xBlockTime )
+{
+    if( xStringMutex == NULL )
+    {
+        return;
+    }
+
+    xSemaphoreTake( xStringMutex, portMAX_DELAY );
+    {
+        eTxPolicy = ePolicy;
+        xTxPolicyBlockTime = xBlockTime;
+    }
+    xSemaphoreGive( xStringMutex );
+}
+
+/*---------------------------------------------------------------------------*/
+
+void vUsbCdcGetStats( SerialStats_t * pxStats )
+{
+    taskENTER_CRITICAL();
+    {
+        *pxStats = xStats;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*---------------------------------------------------------------------------*/
+
+void vUsbCdcResetStats( void )
+{
+    if( xRxedChars == NULL )
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        xStats.ulTxBytesDropped = 0;
+        xStats.ulRxBytesDropped = 0;
+        xStats.ulRxFramesDropped = 0;
+        xStats.ulRxOverruns = 0;
+        xStats.ulRxFramingErrors = 0;
+        xStats.ulRxNoiseErrors = 0;
+        xStats.ulRxParityErrors = 0;
+        xStats.xTxHighWaterMark = xStreamBufferBytesAvailable( xCharsForTx );
+        xStats.xRxHighWaterMark = xStreamBufferBytesAvailable( xRxedChars );
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*---------------------------------------------------------------------------*/
+
+unsigned long ulUsbCdcGetBaud( void )
+{
+    return xLineCoding.dwDTERate;
+}
+
+/*---------------------------------------------------------------------------*/
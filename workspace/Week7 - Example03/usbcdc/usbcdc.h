@@ -0,0 +1,97 @@
+/*! ***************************************************************************
+ *
+ * \brief     USB CDC-ACM virtual COM port on USB0
+ * \file      usbcdc.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef USBCDC_H
+#define USBCDC_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "serial.h"
+
+/* Set to 1 to start the virtual COM port on the KL25Z USB connector, set by
+ * the USBCDC option of CMakeLists.txt. USB0 needs the 48 MHz PLL clock of
+ * CLK_RUN. In the other clock modes the device detaches from the bus and it
+ * attaches again when CLK_RUN returns.
+ */
+#ifndef USBCDC_ENABLED
+#define USBCDC_ENABLED              ( 0 )
+#endif
+
+/* Vendor and product ID. The default is the test PID of pid.codes, which is
+ * for development only and must not be used for devices that are handed
+ * out.
+ */
+#ifndef usbcdcVENDOR_ID
+#define usbcdcVENDOR_ID             ( 0x1209 )
+#endif
+
+#ifndef usbcdcPRODUCT_ID
+#define usbcdcPRODUCT_ID            ( 0x0001 )
+#endif
+
+/* Bytes of the transmit and receive stream buffers. Full speed bulk
+ * transfers move up to 19 packets of 64 bytes per 1 ms frame, the transmit
+ * buffer holds what is written while the host does not poll. The receive
+ * buffer is never overrun, the host is NAKed until there is room for a
+ * packet.
+ */
+#ifndef usbcdcTX_BUFFER_SIZE
+#define usbcdcTX_BUFFER_SIZE        ( 512 )
+#endif
+
+#ifndef usbcdcRX_BUFFER_SIZE
+#define usbcdcRX_BUFFER_SIZE        ( 128 )
+#endif
+
+/* Stream API of the virtual COM port, the same as the single port API of
+ * the serial driver. The transmit policies and the statistics are those of
+ * serial.h, ulRxBytesDropped and ulRxFramesDropped stay 0. The baud rate is
+ * the one set by the terminal on the host, it does not change the transfer
+ * rate.
+ */
+portBASE_TYPE xUsbCdcInit( void );
+portBASE_TYPE xUsbCdcConnected( void );
+portBASE_TYPE xUsbCdcGetChar( char * pcRxedChar, TickType_t xBlockTime );
+portBASE_TYPE xUsbCdcPutChar( char cOutChar, TickType_t xBlockTime );
+void vUsbCdcPutString( const char * const pcString );
+size_t xUsbCdcWrite( const void * pvBuffer, size_t xLength );
+size_t xUsbCdcRead( void * pvBuffer, size_t xLength, TickType_t xBlockTime );
+size_t xUsbCdcPutStringPolicy( const char * const pcString, eSerialTxPolicy ePolicy, TickType_t xBlockTime );
+size_t xUsbCdcPrintf( const char * pcFormat, ... ) __attribute__((format(printf, 1, 2)));
+size_t xUsbCdcVPrintf( const char * pcFormat, va_list xArgs );
+void vUsbCdcSetTxPolicy( eSerialTxPolicy ePolicy, TickType_t xBlockTime );
+void vUsbCdcGetStats( SerialStats_t * pxStats );
+void vUsbCdcResetStats( void );
+unsigned long ulUsbCdcGetBaud( void );
+
+#endif /* USBCDC_H */
@@ -0,0 +1,627 @@
+/*! ***************************************************************************
+ *
+ * \brief     Vibration spectrum of the MMA8451 FIFO blocks
+ * \file      vibration.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#define LOG_MODULE  VIB
+#define LOG_TAG     "Vib: "
+
+#include <math.h>
+#include <string.h>
+
+#include "vibration.h"
+#include "bringup.h"
+#include "dsp.h"
+#include "log.h"
+#include "serial.h"
+#include "telemetry.h"
+#include "wcet.h"
+#include "xprintf.h"
+
+/*
+ * The task collects frames of VIB_FFT_SIZE samples of all three axes from
+ * the FIFO blocks of the MMA8451. When a frame is full, the spectrum of one
+ * axis is calculated per block that follows, so the work of a block is at
+ * most one FFT, and the samples of those blocks are skipped. Of every axis
+ * the mean is removed, the frame is scaled up to near full scale, because
+ * the Q15 FFT halves its results in every stage, and a Hann window is
+ * applied. The features of the spectrum are sent as a TLM_VIBRATION record.
+ * Every FIFO block is also emitted to the dataflow graph given to
+ * vib_init(), see flow.h, for consumers of the samples themselves.
+ *
+ * A peak is a local maximum of the magnitudes, its frequency is refined by
+ * a parabola through the bin and its neighbours. Its amplitude is that of
+ * the bin, up to 1.4 dB low for a sine between two bins. The band RMS
+ * follows from the power of the bins, corrected for the Hann window.
+ *
+ * The means of a frame are the orientation of the board. When it lies flat
+ * and at rest for VIB_DRIFT_FRAMES frames in a row and the means are off
+ * by more than MMA8451_CAL_DRIFT_MG, or vib_calibrate() was called, the
+ * MMA8451 is calibrated again and the new offsets are stored.
+ */
+
+#if (VIB_FFT_SIZE > DSP_RFFT_MAX)
+#error "VIB_FFT_SIZE exceeds DSP_RFFT_MAX"
+#endif
+
+#if ((MMA8451_FIFO_SIZE * 3) > FLOW_BLOCK_VALUES)
+#error "A FIFO block does not fit in a flow block"
+#endif
+
+// Stack size in words of the vibration task
+#define VIB_STACK_DEPTH  (configMINIMAL_STACK_SIZE + 48)
+
+// Time without a FIFO block after which the MMA8451 is restarted
+#define VIB_TIMEOUT_MS   (1000)
+
+// Time a line of the report may wait for room in the serial transmit buffer
+#define VIB_BLOCK_TIME   pdMS_TO_TICKS(100)
+
+// Longest line written to the serial port, including the terminator
+#define VIB_LINE_LEN     (64)
+
+// Bins of a band
+#define VIB_BAND_BINS    (VIB_FFT_SIZE / (2 * VIB_BANDS))
+
+// RMS in counts of every axis of a frame below which the board is at rest
+#define VIB_REST_RMS     (40)
+
+// Frames in a row at rest with a drifted calibration before recalibrating
+#define VIB_DRIFT_FRAMES (8)
+
+// Data rate in 0.01 Hz for every ODR
+static const uint32_t odr_chz[] =
+{
+    80000, 40000, 20000, 10000, 5000, 1250, 625, 156,
+};
+
+// The frame of x, y and z, the spectrum of an axis is calculated in place
+static int16_t frame[3][VIB_FFT_SIZE];
+static uint32_t frame_len = 0;
+
+// Axes left to analyse of a full frame, 0 while the frame is collected
+static uint32_t pending = 0;
+
+// Means of the axes of the full frame, and the frames in a row that showed
+// a drifted calibration
+static int16_t means[3];
+static uint32_t drifted = 0;
+static volatile bool cal_requested = false;
+
+// Spectrum of one axis, see dsp_rfft(), next the magnitudes of the bins
+static int16_t spectrum[2 * VIB_FFT_SIZE];
+
+// Hann window, symmetric, so only the first half
+static int16_t window[(VIB_FFT_SIZE / 2) + 1];
+
+static mma8451_sample_t samples[MMA8451_FIFO_SIZE];
+
+// Source node the FIFO blocks are emitted to, NULL for none
+static flow_node_t *vib_out = NULL;
+
+// Latest features, written by the task with interrupts masked
+static vib_features_t latest[3];
+static bool valid = false;
+
+// Statistics
+static uint32_t frames = 0;
+static uint32_t skipped = 0;
+static uint32_t restarts = 0;
+static uint32_t calibrations = 0;
+static uint32_t max_us = 0;
+
+static wcet_t vib_wcet;
+static StaticTask_t vib_tcb;
+static StackType_t vib_stack[VIB_STACK_DEPTH];
+
+static void vVibTask(void *pvParameters);
+
+static const bringup_step_t vib_step =
+    BRINGUP_STEP("MMA8451", BRINGUP_MMA8451, 0, 0);
+
+/*!
+ * \brief Starts the MMA8451 in FIFO mode, waking the calling task
+ */
+static bool vib_start(void)
+{
+    frame_len = 0;
+    pending = 0;
+
+    return mma8451_init() &&
+           mma8451_fifo_start(VIB_ODR, VIB_WATERMARK,
+                              xTaskGetCurrentTaskHandle());
+}
+
+/*!
+ * \brief Calibrates the MMA8451 again and restarts the FIFO mode
+ */
+static void vib_recalibrate(void)
+{
+    cal_requested = false;
+    drifted = 0;
+    calibrations++;
+
+    if(mma8451_init() && mma8451_calibrate())
+    {
+        mma8451_cal_t cal;
+
+        (void)mma8451_get_cal(&cal);
+        LOG_INFO("calibrated, offsets %d %d %d\r\n", cal.x, cal.y, cal.z);
+    }
+    else
+    {
+        LOG_WARN("calibration failed, the board is not flat\r\n");
+    }
+
+    while(!vib_start())
+    {
+        vTaskDelay(pdMS_TO_TICKS(VIB_TIMEOUT_MS));
+    }
+}
+
+/*!
+ * \brief Checks the means of an analysed frame for a drifted calibration
+ *
+ * \return true if the board was flat and at rest with a drifted
+ *         calibration for VIB_DRIFT_FRAMES frames in a row
+ */
+static bool vib_drift_check(void)
+{
+    mma8451_config_t cfg;
+    int32_t mg[3];
+    bool rest = true;
+
+    mma8451_get_config(&cfg);
+
+    for(uint32_t a=0; a<3; ++a)
+    {
+        rest = rest && (latest[a].rms < VIB_REST_RMS);
+        mg[a] = (means[a] * 1000L) / (COUNTS_PER_G >> cfg.range);
+    }
+
+    if(rest && mma8451_cal_drifted(mg[0], mg[1], mg[2]))
+    {
+        drifted++;
+    }
+    else
+    {
+        drifted = 0;
+    }
+
+    return drifted >= VIB_DRIFT_FRAMES;
+}
+
+/*!
+ * \brief Removes the mean, scales up and windows the frame of an axis
+ *
+ * \param[in,out] x  VIB_FFT_SIZE samples
+ * \param[out]    f  Features, the RMS is set
+ *
+ * \return Number of bits the samples are scaled up by
+ */
+static uint32_t vib_prepare(int16_t x[], vib_features_t *f)
+{
+    const int16_t mean = dsp_mean(x, VIB_FFT_SIZE);
+    uint64_t sum = 0;
+    int32_t peak = 0;
+    uint32_t shift = 0;
+
+    for(uint32_t i=0; i<VIB_FFT_SIZE; ++i)
+    {
+        const int32_t v = x[i] - mean;
+
+        sum += (uint64_t)(v * v);
+        peak = (v > peak) ? v : (-v > peak) ? -v : peak;
+
+        // 14-bit samples, so this does not saturate
+        x[i] = (int16_t)v;
+    }
+
+    f->rms = dsp_isqrt((uint32_t)(sum / VIB_FFT_SIZE));
+
+    while((shift < 14) && ((peak << (shift + 1)) <= INT16_MAX))
+    {
+        shift++;
+    }
+
+    for(uint32_t i=0; i<VIB_FFT_SIZE; ++i)
+    {
+        const uint32_t w = (i <= (VIB_FFT_SIZE / 2)) ? i : (VIB_FFT_SIZE - i);
+
+        x[i] = (int16_t)((x[i] * (1L << shift) * window[w]) >> 15);
+    }
+
+    return shift;
+}
+
+/*!
+ * \brief Finds the peaks and the band RMS in the magnitudes of the bins
+ *
+ * \param[in]  mag    VIB_FFT_SIZE / 2 magnitudes
+ * \param[in]  shift  Bits the samples were scaled up by
+ * \param[out] f      Features
+ */
+static void vib_features(const uint16_t mag[], const uint32_t shift,
+    vib_features_t *f)
+{
+    uint64_t power[VIB_BANDS] = {0};
+    uint32_t peak_bin[VIB_PEAKS] = {0};
+
+    memset(f->peak_dhz, 0, sizeof(f->peak_dhz));
+    memset(f->peak_amp, 0, sizeof(f->peak_amp));
+
+    for(uint32_t k=1; k<(VIB_FFT_SIZE / 2); ++k)
+    {
+        power[k / VIB_BAND_BINS] += (uint32_t)mag[k] * mag[k];
+
+        // A local maximum, kept sorted by magnitude, largest first
+        if((mag[k] > mag[k - 1]) && (mag[k] >= mag[k + 1]))
+        {
+            for(uint32_t p=0; p<VIB_PEAKS; ++p)
+            {
+                if((peak_bin[p] == 0) || (mag[k] > mag[peak_bin[p]]))
+                {
+                    memmove(&peak_bin[p + 1], &peak_bin[p],
+                            (VIB_PEAKS - 1 - p) * sizeof(peak_bin[0]));
+                    peak_bin[p] = k;
+                    break;
+                }
+            }
+        }
+    }
+
+    for(uint32_t p=0; (p<VIB_PEAKS) && (peak_bin[p]!=0); ++p)
+    {
+        const uint32_t k = peak_bin[p];
+        const int32_t a = mag[k - 1];
+        const int32_t b = mag[k];
+        const int32_t c = mag[k + 1];
+
+        // Offset of the vertex of the parabola in 1/256 bin, -128 to 128
+        const int32_t offset = (128 * (a - c)) / (a - (2 * b) + c);
+
+        f->peak_dhz[p] = (uint16_t)((((k * 256) + offset) * odr_chz[VIB_ODR]) /
+                                    (VIB_FFT_SIZE * 256 * 10));
+
+        // The coherent gain of the Hann window is 0.5
+        f->peak_amp[p] = (uint16_t)((2 * (uint32_t)b) >> shift);
+    }
+
+    // The power of a sine in the bins of the Hann window is 3/4 of the
+    // power in a bin without window
+    for(uint32_t i=0; i<VIB_BANDS; ++i)
+    {
+        uint64_t ms = (power[i] * 4) / 3;
+
+        ms = (ms > UINT32_MAX) ? UINT32_MAX : ms;
+        f->band_rms[i] = (uint16_t)(dsp_isqrt((uint32_t)ms) >> shift);
+    }
+}
+
+/*!
+ * \brief Calculates the spectrum and the features of one axis of the frame
+ */
+static void vib_analyse(const uint32_t axis)
+{
+    vib_features_t f;
+    uint16_t *mag = (uint16_t *)spectrum;
+
+    f.axis = (uint8_t)axis;
+    f.reserved = 0;
+
+    const uint32_t shift = vib_prepare(frame[axis], &f);
+
+    (void)dsp_rfft(frame[axis], spectrum, VIB_FFT_SIZE);
+
+    // The magnitudes replace the bins, bin k is read before mag[k] is
+    // written
+    for(uint32_t k=0; k<=(VIB_FFT_SIZE / 2); ++k)
+    {
+        const int32_t re = spectrum[2 * k];
+        const int32_t im = spectrum[(2 * k) + 1];
+
+        mag[k] = dsp_isqrt((uint32_t)((re * re) + (im * im)));
+    }
+
+    vib_features(mag, shift, &f);
+
+    taskENTER_CRITICAL();
+    {
+        latest[axis] = f;
+        valid = true;
+    }
+    taskEXIT_CRITICAL();
+
+    (void)tlm_send(TLM_VIBRATION, &f, sizeof(f));
+}
+
+/*!
+ * \brief Emits a FIFO block to the dataflow graph
+ *
+ * A block of x, y and z frames at VIB_ODR, stamped with the FIFO time of
+ * the first sample. The block is lost if the pool is empty, which the pool
+ * counts.
+ */
+static void vib_emit(const uint32_t n)
+{
+    flow_block_t *b = flow_alloc();
+
+    if(b == NULL)
+    {
+        return;
+    }
+
+    b->channels = 3;
+    b->frames = (uint16_t)n;
+    b->stamp_us = samples[0].t_us;
+    b->period_us = 100000000UL / odr_chz[VIB_ODR];
+
+    for(uint32_t i=0; i<n; ++i)
+    {
+        b->data[(3 * i) + 0] = samples[i].x;
+        b->data[(3 * i) + 1] = samples[i].y;
+        b->data[(3 * i) + 2] = samples[i].z;
+    }
+
+    flow_emit(vib_out, b);
+}
+
+/*!
+ * \brief Initializes the vibration analysis
+ *
+ * Creates the task that reads the FIFO of the MMA8451 at VIB_ODR and
+ * analyses its samples. The task owns the MMA8451 and the FIFO interrupt.
+ *
+ * \param[in]  priority  Priority of the vibration task. The FIFO holds 32
+ *                       samples, so the task must read a block within
+ *                       (32 - VIB_WATERMARK) samples at VIB_ODR.
+ * \param[in]  out       Source node every FIFO block is emitted to as well,
+ *                       NULL for none
+ */
+void vib_init(UBaseType_t priority, flow_node_t *out)
+{
+    vib_out = out;
+
+    const uint32_t n = VIB_FFT_SIZE;
+
+    // Hann window in Q15, 0.5 - 0.5 cos(2 pi i / n)
+    for(uint32_t i=0; i<=(n / 2); ++i)
+    {
+        const float c = cosf(2.0f * 3.14159265f * (float)i / (float)n);
+
+        window[i] = (int16_t)lroundf(16383.5f * (1.0f - c));
+    }
+
+    wcet_init(&vib_wcet, "Vib");
+
+    (void)xTaskCreateStatic(vVibTask, "Vib", VIB_STACK_DEPTH, NULL, priority,
+                            vib_stack, &vib_tcb);
+}
+
+/*!
+ * \brief Returns the latest features of an axis
+ *
+ * \param[in]  axis      0 is x, 1 is y and 2 is z
+ * \param[out] features  Features
+ *
+ * \return false if no spectrum was calculated yet
+ */
+bool vib_get(const uint32_t axis, vib_features_t *features)
+{
+    bool ok;
+
+    if(axis > 2)
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        *features = latest[axis];
+        ok = valid;
+    }
+    taskEXIT_CRITICAL();
+
+    return ok;
+}
+
+/*!
+ * \brief Writes the latest features and the statistics to the serial port
+ *
+ * Per axis the RMS, the peaks as frequency and amplitude, and the band RMS.
+ * Next the number of frames, the samples skipped while the spectra were
+ * calculated, FIFO overflows, restarts of the MMA8451 after a failed read
+ * and the longest processing time of a block.
+ */
+void vib_report(void)
+{
+    static const char axes[] = "xyz";
+    char line[VIB_LINE_LEN];
+    vib_features_t f;
+
+    xSerialPutStringPolicy("\r\nVibration, amplitudes in counts\r\n",
+                           eSerialBlock, VIB_BLOCK_TIME);
+
+    for(uint32_t a=0; a<3; ++a)
+    {
+        if(!vib_get(a, &f))
+        {
+            xSerialPutStringPolicy("No spectrum yet\r\n", eSerialBlock,
+                                   VIB_BLOCK_TIME);
+            break;
+        }
+
+        xsnprintf(line, VIB_LINE_LEN, "%c rms %5u bands", axes[a],
+                  (unsigned int)f.rms);
+        xSerialPutStringPolicy(line, eSerialBlock, VIB_BLOCK_TIME);
+
+        for(uint32_t i=0; i<VIB_BANDS; ++i)
+        {
+            xsnprintf(line, VIB_LINE_LEN, " %5u", (unsigned int)f.band_rms[i]);
+            xSerialPutStringPolicy(line, eSerialBlock, VIB_BLOCK_TIME);
+        }
+
+        xSerialPutStringPolicy("\r\n  peaks", eSerialBlock, VIB_BLOCK_TIME);
+
+        for(uint32_t i=0; (i<VIB_PEAKS) && (f.peak_dhz[i]!=0); ++i)
+        {
+            xsnprintf(line, VIB_LINE_LEN, " %u.%u Hz %u",
+                      (unsigned int)(f.peak_dhz[i] / 10),
+                      (unsigned int)(f.peak_dhz[i] % 10),
+                      (unsigned int)f.peak_amp[i]);
+            xSerialPutStringPolicy(line, eSerialBlock, VIB_BLOCK_TIME);
+        }
+
+        xSerialPutStringPolicy("\r\n", eSerialBlock, VIB_BLOCK_TIME);
+    }
+
+    xsnprintf(line, VIB_LINE_LEN, "Frames %lu, skipped %lu, overflows %lu\r\n",
+              (unsigned long)frames, (unsigned long)skipped,
+              (unsigned long)mma8451_fifo_overflows);
+    xSerialPutStringPolicy(line, eSerialBlock, VIB_BLOCK_TIME);
+
+    xsnprintf(line, VIB_LINE_LEN, "Restarts %lu, longest block %lu us\r\n",
+              (unsigned long)restarts, (unsigned long)max_us);
+    xSerialPutStringPolicy(line, eSerialBlock, VIB_BLOCK_TIME);
+
+    xsnprintf(line, VIB_LINE_LEN, "Calibrations %lu, stored %lu\r\n",
+              (unsigned long)calibrations, (unsigned long)mma8451_cal_saves);
+    xSerialPutStringPolicy(line, eSerialBlock, VIB_BLOCK_TIME);
+}
+
+/*!
+ * \brief Requests a calibration of the MMA8451 after the current frame
+ *
+ * The board must lie flat and at rest, the offsets are stored in the flash
+ * log and applied at every boot.
+ */
+void vib_calibrate(void)
+{
+    cal_requested = true;
+}
+
+/*!
+ * \brief Vibration task
+ *
+ * Waits for a FIFO block, adds it to the frame or analyses one axis of a
+ * full frame. Restarts the MMA8451 when a read fails or no block arrives.
+ */
+static void vVibTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    // The first attempt ends the bring-up, the device is retried after it
+    (void)bringup_begin(&vib_step, portMAX_DELAY);
+
+    bool started = vib_start();
+
+    bringup_done(&vib_step, started);
+
+    while(!started)
+    {
+        vTaskDelay(pdMS_TO_TICKS(VIB_TIMEOUT_MS));
+        started = vib_start();
+    }
+
+    for( ;; )
+    {
+        bool recalibrate = false;
+        uint32_t n;
+
+        if((ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(VIB_TIMEOUT_MS)) == 0) ||
+           !mma8451_fifo_read(samples, MMA8451_FIFO_SIZE, &n))
+        {
+            LOG_WARN("no FIFO block, restarting the MMA8451\r\n");
+
+            restarts++;
+
+            while(!vib_start())
+            {
+                vTaskDelay(pdMS_TO_TICKS(VIB_TIMEOUT_MS));
+            }
+
+            continue;
+        }
+
+        if((vib_out != NULL) && (n > 0))
+        {
+            vib_emit(n);
+        }
+
+        wcet_start(&vib_wcet);
+
+        if(pending == 0)
+        {
+            uint32_t i;
+
+            for(i=0; (i<n) && (frame_len<VIB_FFT_SIZE); ++i)
+            {
+                frame[0][frame_len] = samples[i].x;
+                frame[1][frame_len] = samples[i].y;
+                frame[2][frame_len] = samples[i].z;
+                frame_len++;
+            }
+
+            skipped += n - i;
+
+            if(frame_len == VIB_FFT_SIZE)
+            {
+                for(uint32_t a=0; a<3; ++a)
+                {
+                    means[a] = dsp_mean(frame[a], VIB_FFT_SIZE);
+                }
+
+                pending = 3;
+            }
+        }
+        else
+        {
+            skipped += n;
+
+            vib_analyse(3 - pending);
+
+            if(--pending == 0)
+            {
+                frame_len = 0;
+                frames++;
+
+                recalibrate = vib_drift_check() || cal_requested;
+            }
+        }
+
+        const uint32_t us = wcet_end(&vib_wcet);
+
+        max_us = (us > max_us) ? us : max_us;
+
+        // Between frames, a calibration takes the MMA8451 out of FIFO mode
+        if(recalibrate)
+        {
+            vib_recalibrate();
+        }
+    }
+}
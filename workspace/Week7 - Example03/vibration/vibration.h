@@ -0,0 +1,116 @@
+/*! ***************************************************************************
+ *
+ * \brief     Vibration spectrum of the MMA8451 FIFO blocks
+ * \file      vibration.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef VIBRATION_H
+#define VIBRATION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "flow.h"
+#include "mma8451.h"
+
+/// \name Definitions for the vibration analysis
+/// \{
+
+/*!
+ * \brief Set to 1 to create the vibration analysis task in main()
+ */
+#ifndef VIB_ENABLED
+#define VIB_ENABLED       (0)
+#endif
+
+/*!
+ * \brief Number of samples per axis of a spectrum, 64, 128 or 256
+ *
+ * The frequency resolution is the data rate / VIB_FFT_SIZE. The buffers
+ * take 10 * VIB_FFT_SIZE bytes of RAM.
+ */
+#ifndef VIB_FFT_SIZE
+#define VIB_FFT_SIZE      (128)
+#endif
+
+/*!
+ * \brief Output data rate of the MMA8451 during the analysis
+ */
+#ifndef VIB_ODR
+#define VIB_ODR           (MMA8451_ODR_400HZ)
+#endif
+
+/*!
+ * \brief Number of samples of a FIFO block, the watermark
+ *
+ * At most one spectrum is calculated per block, which bounds the processing
+ * time of a block. The 3 spectra of a frame are calculated in the 3 blocks
+ * after it and the samples of those blocks are skipped.
+ */
+#ifndef VIB_WATERMARK
+#define VIB_WATERMARK     (16)
+#endif
+
+/*!
+ * \brief Number of peaks per axis, part of the TLM_VIBRATION record
+ */
+#define VIB_PEAKS         (3)
+
+/*!
+ * \brief Number of frequency bands per axis, part of the TLM_VIBRATION record
+ *
+ * The bands split 0 Hz to half the data rate in equal parts, the bin at
+ * 0 Hz is left out.
+ */
+#define VIB_BANDS         (4)
+
+/// \}
+
+/// Features of the spectrum of one axis, the payload of TLM_VIBRATION records
+///
+/// Amplitudes are in 14-bit counts, COUNTS_PER_G per g in the 2g range.
+typedef struct __attribute__((packed))
+{
+    uint8_t  axis;                  ///< 0 is x, 1 is y and 2 is z
+    uint8_t  reserved;
+    uint16_t rms;                   ///< RMS of the frame without its mean
+    uint16_t peak_dhz[VIB_PEAKS];   ///< Peak frequencies in 0.1 Hz, largest
+                                    ///< first, 0 if there are fewer peaks
+    uint16_t peak_amp[VIB_PEAKS];   ///< Amplitude of the sine of each peak
+    uint16_t band_rms[VIB_BANDS];   ///< RMS of the frequencies of each band
+}
+vib_features_t;
+
+// Function prototypes
+void vib_init(UBaseType_t priority, flow_node_t *out);
+bool vib_get(const uint32_t axis, vib_features_t *features);
+void vib_report(void);
+void vib_calibrate(void);
+
+#endif // VIBRATION_H
@@ -0,0 +1,295 @@
+/*! ***************************************************************************
+ *
+ * \brief     Execution time profiler of the jobs of tasks
+ * \file      wcet.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "wcet.h"
+#include "runtime_stats.h"
+
+#if WCET_BUCKET_US < 4
+#error "WCET_BUCKET_US must be at least 4"
+#endif
+
+/*
+ * The execution time of a job is the time its task was running between
+ * wcet_start() and wcet_end(), read from the run-time counter of the task
+ * with ulTaskGetCurrentRunTimeCounter(). The time the task was preempted or
+ * blocked is not counted, interrupts are counted in the task they
+ * interrupted. The resolution is that of the run-time counter: a cycle of
+ * the bus clock with rtsFREE_RUNNING, a tick of rtsTICK_US otherwise.
+ *
+ * Next to the minimum, mean and maximum, every job is counted in a
+ * histogram with four buckets per doubling of the execution time, from
+ * which wcet_percentile() estimates the percentiles within 25%.
+ */
+
+// Registered profiles, newest first
+static wcet_t *wcets = NULL;
+
+/*!
+ * \brief Clears the statistics of a profile
+ *
+ * \param[out]  w  Profile
+ */
+static void wcet_clear(wcet_t *w)
+{
+    w->jobs = 0;
+    w->min_us = UINT32_MAX;
+    w->max_us = 0;
+    w->total_us = 0;
+
+    for(uint32_t i=0; i<WCET_BUCKETS; i++)
+    {
+        w->hist[i] = 0;
+    }
+}
+
+/*!
+ * \brief Returns the histogram bucket of an execution time
+ *
+ * \param[in]  us  Execution time in microseconds
+ */
+static uint32_t wcet_bucket(const uint32_t us)
+{
+    uint32_t low = WCET_BUCKET_US;
+    uint32_t bucket = 1;
+
+    if(us < low)
+    {
+        return 0;
+    }
+
+    // Find the doubling, the last four buckets take all longer times
+    while(((us - low) >= low) && ((bucket + 4) < WCET_BUCKETS))
+    {
+        low <<= 1;
+        bucket += 4;
+    }
+
+    bucket += (us - low) / (low / 4);
+
+    return (bucket < WCET_BUCKETS) ? bucket : (WCET_BUCKETS - 1);
+}
+
+/*!
+ * \brief Returns the upper bound of a histogram bucket in microseconds
+ *
+ * \param[in]  bucket  Bucket, below WCET_BUCKETS - 1
+ */
+static uint32_t wcet_bound(const uint32_t bucket)
+{
+    uint32_t low;
+
+    if(bucket == 0)
+    {
+        return WCET_BUCKET_US;
+    }
+
+    low = (uint32_t)WCET_BUCKET_US << ((bucket - 1) / 4);
+
+    return low + (((bucket - 1) % 4) + 1) * (low / 4);
+}
+
+/*!
+ * \brief Sets up and registers a profile
+ *
+ * \param[out]  w     Profile, must stay valid
+ * \param[in]   name  Name for reports
+ */
+void wcet_init(wcet_t *w, const char *name)
+{
+    bool registered = false;
+
+    taskENTER_CRITICAL();
+    {
+        w->name = name;
+        w->start = 0;
+        wcet_clear(w);
+
+        for(const wcet_t *q=wcets; q!=NULL; q=q->next)
+        {
+            registered |= (q == w);
+        }
+
+        if(!registered)
+        {
+            w->next = wcets;
+            wcets = w;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Marks the start of a job
+ *
+ * The job ends with wcet_end(), called by the same task.
+ *
+ * \param[in,out]  w  Profile
+ */
+void wcet_start(wcet_t *w)
+{
+    w->start = ulTaskGetCurrentRunTimeCounter();
+}
+
+/*!
+ * \brief Marks the end of a job and records its execution time
+ *
+ * \param[in,out]  w  Profile
+ *
+ * \return Execution time of the job in microseconds
+ */
+uint32_t wcet_end(wcet_t *w)
+{
+    const configRUN_TIME_COUNTER_TYPE counts =
+        ulTaskGetCurrentRunTimeCounter() - w->start;
+    const uint32_t us = (uint32_t)(((uint64_t)counts * rtsTICK_US) /
+        rtsCOUNTS_PER_TICK);
+
+    wcet_record(w, us);
+
+    return us;
+}
+
+/*!
+ * \brief Records a time that was measured by the caller
+ *
+ * For times that are not the execution time of a task, such as the latency
+ * from an input to the display in display_trace(). Can be called by any
+ * task.
+ *
+ * \param[in,out]  w   Profile
+ * \param[in]      us  Time in microseconds
+ */
+void wcet_record(wcet_t *w, const uint32_t us)
+{
+    const uint32_t bucket = wcet_bucket(us);
+
+    taskENTER_CRITICAL();
+    {
+        w->jobs++;
+        w->total_us += us;
+
+        if(us < w->min_us)
+        {
+            w->min_us = us;
+        }
+
+        if(us > w->max_us)
+        {
+            w->max_us = us;
+        }
+
+        if(w->hist[bucket] < UINT16_MAX)
+        {
+            w->hist[bucket]++;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Estimates a percentile of the execution time from the histogram
+ *
+ * The estimate is the upper bound of the bucket the percentile falls in,
+ * at most the longest execution time.
+ *
+ * \param[in]  w        Profile, or a copy of it from wcet_get()
+ * \param[in]  percent  Percentile, 1 to 100
+ *
+ * \return Execution time in microseconds, 0 if there were no jobs
+ */
+uint32_t wcet_percentile(const wcet_t *w, const uint32_t percent)
+{
+    uint32_t total = 0;
+    uint32_t count = 0;
+
+    for(uint32_t i=0; i<WCET_BUCKETS; i++)
+    {
+        total += w->hist[i];
+    }
+
+    for(uint32_t i=0; i<(WCET_BUCKETS - 1); i++)
+    {
+        count += w->hist[i];
+
+        if((uint64_t)count * 100U >= (uint64_t)total * percent)
+        {
+            const uint32_t bound = wcet_bound(i);
+
+            return (bound < w->max_us) ? bound : w->max_us;
+        }
+    }
+
+    return w->max_us;
+}
+
+/*!
+ * \brief Reads the statistics of a registered profile
+ *
+ * \param[in]   i      Index of the profile, from 0
+ * \param[out]  stats  Copy of the profile
+ *
+ * \return False if there are no more profiles
+ */
+bool wcet_get(const uint32_t i, wcet_t *stats)
+{
+    const wcet_t *w;
+    uint32_t n = 0;
+
+    taskENTER_CRITICAL();
+    {
+        for(w=wcets; (w!=NULL) && (n<i); w=w->next)
+        {
+            n++;
+        }
+
+        if(w != NULL)
+        {
+            *stats = *w;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return w != NULL;
+}
+
+/*!
+ * \brief Clears the statistics of all profiles
+ */
+void wcet_reset(void)
+{
+    taskENTER_CRITICAL();
+    {
+        for(wcet_t *w=wcets; w!=NULL; w=w->next)
+        {
+            wcet_clear(w);
+        }
+    }
+    taskEXIT_CRITICAL();
+}
@@ -0,0 +1,88 @@
+/*! ***************************************************************************
+ *
+ * \brief     Execution time profiler of the jobs of tasks
+ * \file      wcet.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef WCET_H
+#define WCET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// \name Definitions for the execution time profiler
+/// \{
+
+/*!
+ * \brief Number of buckets of the execution time histogram
+ */
+#ifndef WCET_BUCKETS
+#define WCET_BUCKETS    (48)
+#endif
+
+/*!
+ * \brief Bound of the first bucket in microseconds, at least 4
+ *
+ * The first bucket counts the jobs that ran shorter than WCET_BUCKET_US.
+ * Every doubling of the execution time above it is split in four buckets,
+ * the last bucket counts all longer jobs.
+ */
+#ifndef WCET_BUCKET_US
+#define WCET_BUCKET_US  (4)
+#endif
+
+/// \}
+
+/// The jobs of a task, set up with wcet_init()
+///
+/// The statistics are updated by wcet_end() and read with wcet_get().
+typedef struct wcet
+{
+    const char *name;           ///< Name for reports
+    configRUN_TIME_COUNTER_TYPE start; ///< Run time of the task at wcet_start()
+    uint32_t jobs;              ///< Number of completed jobs
+    uint32_t min_us;            ///< Shortest execution time in us
+    uint32_t max_us;            ///< Longest execution time in us
+    uint64_t total_us;          ///< Sum of the execution times in us
+    uint16_t hist[WCET_BUCKETS]; ///< Saturates at 0xFFFF
+    struct wcet *next;          ///< Next registered profile
+}
+wcet_t;
+
+// Function prototypes
+void wcet_init(wcet_t *w, const char *name);
+void wcet_start(wcet_t *w);
+uint32_t wcet_end(wcet_t *w);
+void wcet_record(wcet_t *w, const uint32_t us);
+uint32_t wcet_percentile(const wcet_t *w, const uint32_t percent);
+bool wcet_get(const uint32_t i, wcet_t *stats);
+void wcet_reset(void);
+
+#endif // WCET_H
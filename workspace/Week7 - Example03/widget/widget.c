@@ -0,0 +1,440 @@
+/*! ***************************************************************************
+ *
+ * \brief     Retained-mode widgets for the Oled display
+ * \file      widget.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "widget.h"
+#include "display.h"
+#include "xprintf.h"
+
+/*!
+ * \brief Sets up the common part of a widget
+ */
+static void widget_setup(widget_t *w, const widget_type_t type,
+    const ssd1306_box_t *box, const font_native_t *font,
+    const ssd1306_align_t align)
+{
+    w->type = type;
+    w->box = *box;
+    w->font = font;
+    w->align = align;
+    w->dirty = true;
+    w->next = NULL;
+}
+
+/*!
+ * \brief Draws a bar gauge, a frame with the part up to the value filled
+ */
+static void widget_draw_bar(ssd1306_t *oled, const widget_t *w)
+{
+    const int32_t x = w->box.x;
+    const int32_t y = w->box.y;
+    const int32_t inner = w->box.w - 4;
+    const int32_t range = w->u.bar.max - w->u.bar.min;
+    int32_t fill = 0;
+
+    ssd1306_drawrect(oled, x, y, w->box.w, w->box.h, ON);
+    ssd1306_drawrect(oled, x + 1, y + 1, w->box.w - 2, w->box.h - 2, OFF);
+
+    if(range > 0)
+    {
+        const int32_t v = w->u.bar.value - w->u.bar.min;
+
+        fill = (v <= 0) ? 0 : (v >= range) ? inner :
+            (int32_t)(((int64_t)v * inner) / range);
+    }
+
+    ssd1306_fillrect(oled, x + 2, y + 2, fill, w->box.h - 4, ON);
+    ssd1306_fillrect(oled, x + 2 + fill, y + 2, inner - fill, w->box.h - 4, OFF);
+}
+
+/*!
+ * \brief Draws an icon at the top left of its box, the rest of the box is
+ *        cleared
+ */
+static void widget_draw_icon(ssd1306_t *oled, const widget_t *w)
+{
+    for(uint32_t row=0; row<w->box.h; row++)
+    {
+        for(uint32_t col=0; col<w->box.w; col++)
+        {
+            bool on = false;
+
+            if((w->u.icon.image != NULL) && (row < w->u.icon.h) &&
+               (col < w->u.icon.w))
+            {
+                on = (w->u.icon.image[(row / 8) * w->u.icon.w + col] &
+                    (1U << (row % 8))) != 0;
+            }
+
+            ssd1306_setpixel(oled, (uint8_t)(w->box.x + col), (uint8_t)(w->box.y + row),
+                on ? ON : OFF);
+        }
+    }
+}
+
+/*!
+ * \brief Draws the items of a list that fit in its box, one per font height
+ *        line, the selected item inverted
+ */
+static void widget_draw_list(ssd1306_t *oled, const widget_t *w)
+{
+    const uint8_t h = w->font->height;
+    ssd1306_box_t line = {w->box.x, w->box.y, w->box.w, h};
+
+    for(uint32_t i=w->u.list.top; (line.y + h) <= (w->box.y + w->box.h); i++)
+    {
+        const char *item = (i < w->u.list.count) ? w->u.list.items[i] : "";
+
+        ssd1306_drawtext(oled, w->font, &line, w->align, item);
+
+        if(i == w->u.list.selected)
+        {
+            ssd1306_fillrect(oled, line.x, line.y, line.w, line.h, INVERT);
+        }
+
+        line.y += h;
+    }
+
+    // Clear the rows below the last whole line
+    line.h = (uint8_t)(w->box.y + w->box.h - line.y);
+    ssd1306_fillrect(oled, line.x, line.y, line.w, line.h, OFF);
+}
+
+/*!
+ * \brief Draws a widget in its box
+ */
+static void widget_draw(ssd1306_t *oled, const widget_t *w)
+{
+    if(w->type == WIDGET_LABEL)
+    {
+        ssd1306_drawtext(oled, w->font, &w->box, w->align, w->u.text);
+    }
+    else if(w->type == WIDGET_VALUE)
+    {
+        char str[WIDGET_VALUE_SIZE];
+
+        xsnprintf(str, sizeof(str), w->u.value.fmt, (long)w->u.value.value);
+        ssd1306_drawtext(oled, w->font, &w->box, w->align, str);
+    }
+    else if(w->type == WIDGET_BAR)
+    {
+        widget_draw_bar(oled, w);
+    }
+    else if(w->type == WIDGET_ICON)
+    {
+        widget_draw_icon(oled, w);
+    }
+    else
+    {
+        widget_draw_list(oled, w);
+    }
+}
+
+/*!
+ * \brief Sets up an empty screen
+ *
+ * The first render clears the framebuffer and draws all widgets.
+ *
+ * \param[out] screen  Screen
+ * \param[in]  panel   Display of widget_update(), see display_lock()
+ */
+void widget_screen_init(widget_screen_t *screen, const uint8_t panel)
+{
+    screen->widgets = NULL;
+    screen->clear = true;
+    screen->panel = panel;
+}
+
+/*!
+ * \brief Adds a set up widget to a screen
+ */
+void widget_add(widget_screen_t *screen, widget_t *w)
+{
+    widget_t **p = &screen->widgets;
+
+    while(*p != NULL)
+    {
+        p = &(*p)->next;
+    }
+
+    w->next = NULL;
+    w->dirty = true;
+    *p = w;
+}
+
+/*!
+ * \brief Clears the framebuffer and redraws all widgets on the next render
+ *
+ * Call when the screen is shown again after other drawing.
+ */
+void widget_screen_invalidate(widget_screen_t *screen)
+{
+    screen->clear = true;
+}
+
+/*!
+ * \brief Redraws a widget on the next render, after the data it points to
+ *        changed
+ */
+void widget_invalidate(widget_t *w)
+{
+    w->dirty = true;
+}
+
+/*!
+ * \brief Redraws the dirty widgets of a screen into the framebuffer
+ *
+ * Call between display_lock() and display_unlock().
+ *
+ * \param[in,out] screen  Screen
+ * \param[in,out] oled    Back buffer returned by display_lock()
+ *
+ * \return Number of widgets redrawn
+ */
+uint32_t widget_render(widget_screen_t *screen, ssd1306_t *oled)
+{
+    uint32_t n = 0;
+
+    if(screen->clear)
+    {
+        ssd1306_clearscreen(oled);
+    }
+
+    for(widget_t *w=screen->widgets; w!=NULL; w=w->next)
+    {
+        if(w->dirty || screen->clear)
+        {
+            widget_draw(oled, w);
+            w->dirty = false;
+            n++;
+        }
+    }
+
+    screen->clear = false;
+
+    return n;
+}
+
+/*!
+ * \brief Redraws the dirty widgets of a screen and shows them
+ *
+ * Takes the back buffer of the display of the screen and requests a flip
+ * if a widget was redrawn.
+ *
+ * \param[in,out] screen  Screen
+ *
+ * \return Number of widgets redrawn
+ */
+uint32_t widget_update(widget_screen_t *screen)
+{
+    ssd1306_t *oled = display_lock(screen->panel, portMAX_DELAY);
+    const uint32_t n = widget_render(screen, oled);
+    display_unlock(screen->panel);
+
+    if(n > 0)
+    {
+        display_flip(screen->panel);
+    }
+
+    return n;
+}
+
+/*!
+ * \brief Sets up a label
+ *
+ * \param[out] w      Widget
+ * \param[in]  box    Box of the text
+ * \param[in]  font   Native font, see fonts_native.h
+ * \param[in]  align  Alignment in the box
+ * \param[in]  text   '\0' terminated text, kept by reference
+ */
+void widget_label_init(widget_t *w, const ssd1306_box_t *box,
+    const font_native_t *font, const ssd1306_align_t align, const char *text)
+{
+    widget_setup(w, WIDGET_LABEL, box, font, align);
+    w->u.text = text;
+}
+
+/*!
+ * \brief Sets up a value, a number shown with a format
+ *
+ * \param[out] w      Widget
+ * \param[in]  box    Box of the text
+ * \param[in]  font   Native font, see fonts_native.h
+ * \param[in]  align  Alignment in the box
+ * \param[in]  fmt    Format with a single long conversion, e.g. "%ld ms",
+ *                    the text must fit in WIDGET_VALUE_SIZE
+ */
+void widget_value_init(widget_t *w, const ssd1306_box_t *box,
+    const font_native_t *font, const ssd1306_align_t align, const char *fmt)
+{
+    widget_setup(w, WIDGET_VALUE, box, font, align);
+    w->u.value.fmt = fmt;
+    w->u.value.value = 0;
+}
+
+/*!
+ * \brief Sets up a bar gauge at the minimum
+ *
+ * \param[out] w    Widget
+ * \param[in]  box  Box of the frame, at least 5 by 5 pixels
+ * \param[in]  min  Value of an empty bar
+ * \param[in]  max  Value of a full bar
+ */
+void widget_bar_init(widget_t *w, const ssd1306_box_t *box, const int32_t min,
+    const int32_t max)
+{
+    widget_setup(w, WIDGET_BAR, box, NULL, SSD1306_ALIGN_LEFT);
+    w->u.bar.min = min;
+    w->u.bar.max = max;
+    w->u.bar.value = min;
+}
+
+/*!
+ * \brief Sets up an icon
+ *
+ * \param[out] w       Widget
+ * \param[in]  box     Box of the icon, the image is drawn at its top left
+ * \param[in]  image   Image in the page order of ssd1306_drawbitmap(), kept by
+ *                     reference, NULL for none
+ * \param[in]  width   Width of the image
+ * \param[in]  height  Height of the image
+ */
+void widget_icon_init(widget_t *w, const ssd1306_box_t *box,
+    const uint8_t *image, const uint8_t width, const uint8_t height)
+{
+    widget_setup(w, WIDGET_ICON, box, NULL, SSD1306_ALIGN_LEFT);
+    w->u.icon.image = image;
+    w->u.icon.w = width;
+    w->u.icon.h = height;
+}
+
+/*!
+ * \brief Sets up a list with the first item selected
+ *
+ * \param[out] w      Widget
+ * \param[in]  box    Box of the list, a line per font height
+ * \param[in]  font   Native font, see fonts_native.h
+ * \param[in]  items  Strings, kept by reference
+ * \param[in]  count  Number of items
+ */
+void widget_list_init(widget_t *w, const ssd1306_box_t *box,
+    const font_native_t *font, const char *const *items, const uint8_t count)
+{
+    widget_setup(w, WIDGET_LIST, box, font, SSD1306_ALIGN_LEFT);
+    w->u.list.items = items;
+    w->u.list.count = count;
+    w->u.list.selected = 0;
+    w->u.list.top = 0;
+}
+
+/*!
+ * \brief Sets the text of a label
+ *
+ * A label is only redrawn if the pointer changes. Call widget_invalidate()
+ * after changing the contents of the same string.
+ */
+void widget_set_text(widget_t *w, const char *text)
+{
+    if(w->u.text != text)
+    {
+        w->u.text = text;
+        w->dirty = true;
+    }
+}
+
+/*!
+ * \brief Sets the number of a value or a bar gauge, it is only redrawn if the
+ *        number changes
+ */
+void widget_set_value(widget_t *w, const int32_t value)
+{
+    int32_t *v = (w->type == WIDGET_BAR) ? &w->u.bar.value : &w->u.value.value;
+
+    if(*v != value)
+    {
+        *v = value;
+        w->dirty = true;
+    }
+}
+
+/*!
+ * \brief Sets the image of an icon, of the size given to widget_icon_init()
+ */
+void widget_set_icon(widget_t *w, const uint8_t *image)
+{
+    if(w->u.icon.image != image)
+    {
+        w->u.icon.image = image;
+        w->dirty = true;
+    }
+}
+
+/*!
+ * \brief Replaces the items of a list, always redraws it
+ */
+void widget_set_items(widget_t *w, const char *const *items, const uint8_t count)
+{
+    w->u.list.items = items;
+    w->u.list.count = count;
+
+    if(w->u.list.selected >= count)
+    {
+        w->u.list.selected = (count > 0) ? (count - 1) : 0;
+    }
+
+    w->dirty = true;
+}
+
+/*!
+ * \brief Selects an item of a list and scrolls it into view
+ */
+void widget_select(widget_t *w, const uint8_t index)
+{
+    const uint8_t lines = w->box.h / w->font->height;
+
+    if((index == w->u.list.selected) || (index >= w->u.list.count) ||
+       (lines == 0))
+    {
+        return;
+    }
+
+    w->u.list.selected = index;
+
+    if(index < w->u.list.top)
+    {
+        w->u.list.top = index;
+    }
+    else if(index >= (w->u.list.top + lines))
+    {
+        w->u.list.top = index - lines + 1;
+    }
+
+    w->dirty = true;
+}
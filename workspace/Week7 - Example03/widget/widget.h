@@ -0,0 +1,150 @@
+/*! ***************************************************************************
+ *
+ * \brief     Retained-mode widgets for the Oled display
+ * \file      widget.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef WIDGET_H
+#define WIDGET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+/*
+ * A screen is a list of widgets that keep their contents. Setting a
+ * property only marks that widget dirty if the property changes, and
+ * widget_render() only redraws the dirty widgets, each in its own box. The
+ * ssd1306 framebuffer tracks the bytes that change, so the display task
+ * only transfers the parts of the redrawn boxes that really differ.
+ *
+ * The boxes of the widgets on a screen must not overlap. A screen is used
+ * by a single task, that also calls widget_render() between display_lock()
+ * and display_unlock(), or widget_update().
+ */
+
+/// Maximum length of the text of a value widget
+#define WIDGET_VALUE_SIZE   (24)
+
+/// Kind of a widget
+typedef enum
+{
+    WIDGET_LABEL, ///< Fixed text
+    WIDGET_VALUE, ///< A number formatted with a printf style format
+    WIDGET_BAR,   ///< Horizontal bar gauge with a frame
+    WIDGET_ICON,  ///< Image in SSD1306 page order
+    WIDGET_LIST,  ///< Scrolling list of strings with a selected item
+}
+widget_type_t;
+
+/// A widget, change it with the functions below only
+typedef struct widget
+{
+    widget_type_t type;         ///< Kind
+    ssd1306_box_t box;          ///< Box the widget draws in
+    const font_native_t *font;  ///< Font of the text widgets
+    ssd1306_align_t align;      ///< Alignment of the text widgets
+    bool dirty;                 ///< Redrawn by the next widget_render()
+
+    union
+    {
+        const char *text;       ///< WIDGET_LABEL
+
+        struct
+        {
+            const char *fmt;    ///< Format with a single long argument
+            int32_t value;
+        }
+        value;                  ///< WIDGET_VALUE
+
+        struct
+        {
+            int32_t min;
+            int32_t max;
+            int32_t value;
+        }
+        bar;                    ///< WIDGET_BAR
+
+        struct
+        {
+            const uint8_t *image;
+            uint8_t w;
+            uint8_t h;
+        }
+        icon;                   ///< WIDGET_ICON
+
+        struct
+        {
+            const char *const *items;
+            uint8_t count;
+            uint8_t selected;   ///< Shown inverted
+            uint8_t top;        ///< First item shown
+        }
+        list;                   ///< WIDGET_LIST
+    }
+    u;
+
+    struct widget *next;        ///< Next widget of the screen
+}
+widget_t;
+
+/// A screen of widgets
+typedef struct
+{
+    widget_t *widgets;          ///< Widgets in the order they were added
+    bool clear;                 ///< Clear the framebuffer on the next render
+    uint8_t panel;              ///< Display of widget_update()
+}
+widget_screen_t;
+
+// Function prototypes
+void widget_screen_init(widget_screen_t *screen, const uint8_t panel);
+void widget_add(widget_screen_t *screen, widget_t *w);
+void widget_screen_invalidate(widget_screen_t *screen);
+void widget_invalidate(widget_t *w);
+uint32_t widget_render(widget_screen_t *screen, ssd1306_t *oled);
+uint32_t widget_update(widget_screen_t *screen);
+
+void widget_label_init(widget_t *w, const ssd1306_box_t *box,
+    const font_native_t *font, const ssd1306_align_t align, const char *text);
+void widget_value_init(widget_t *w, const ssd1306_box_t *box,
+    const font_native_t *font, const ssd1306_align_t align, const char *fmt);
+void widget_bar_init(widget_t *w, const ssd1306_box_t *box, const int32_t min,
+    const int32_t max);
+void widget_icon_init(widget_t *w, const ssd1306_box_t *box,
+    const uint8_t *image, const uint8_t width, const uint8_t height);
+void widget_list_init(widget_t *w, const ssd1306_box_t *box,
+    const font_native_t *font, const char *const *items, const uint8_t count);
+
+void widget_set_text(widget_t *w, const char *text);
+void widget_set_value(widget_t *w, const int32_t value);
+void widget_set_icon(widget_t *w, const uint8_t *image);
+void widget_set_items(widget_t *w, const char *const *items, const uint8_t count);
+void widget_select(widget_t *w, const uint8_t index);
+
+#endif // WIDGET_H
@@ -0,0 +1,303 @@
+/*! ***************************************************************************
+ *
+ * \brief     Prioritised deferred work for interrupt bottom halves
+ * \file      work.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include "work.h"
+
+#include "mono.h"
+#include "sections.h"
+#include "serial.h"
+#include "xprintf.h"
+
+/*
+ * Instead of a task per interrupt that waits for its semaphore or
+ * notification, interrupt handlers submit statically allocated work items
+ * to one of two worker tasks at fixed priorities, which run them in the
+ * order they were submitted. All items of a worker share its stack.
+ *
+ * An item that is submitted while it waits is not queued twice, the
+ * submission is coalesced and counted, so a burst of interrupts costs one
+ * run. The item must then handle all that happened since it was submitted,
+ * like a handler that reads a FIFO until it is empty.
+ *
+ * The latency of an item is bounded by the run times of the items queued
+ * before it on the same worker and by the tasks above the worker, the
+ * longest is kept in the statistics. Keep WORK_HIGH items short, an item
+ * that blocks delays all items after it.
+ */
+
+#define WORK_LINE_LEN       (64)
+
+#define WORK_BLOCK_TIME     pdMS_TO_TICKS(100)
+
+/// Queue and task of a worker
+typedef struct
+{
+    work_t *head;
+    work_t *tail;
+    TaskHandle_t task;
+    work_stats_t stats;
+}
+work_queue_t;
+
+/*----------------------------------------------------------------------------*/
+// Local variables
+/*----------------------------------------------------------------------------*/
+static work_queue_t queues[WORK_N_PRIOS];
+
+static const char *const work_names[WORK_N_PRIOS] = {"WorkHi", "WorkLo"};
+
+static StaticTask_t work_tcb[WORK_N_PRIOS];
+__BSS_NOCLEAR static StackType_t work_stack[WORK_N_PRIOS][WORK_STACK_DEPTH];
+
+/*----------------------------------------------------------------------------*/
+// Local function prototypes
+/*----------------------------------------------------------------------------*/
+static void vWorkTask(void *pvParameters);
+
+/*----------------------------------------------------------------------------*/
+// Local functions
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Queues an item, in a critical section
+ *
+ * \return False if the item was already queued
+ */
+static bool work_enqueue(work_queue_t *q, work_t *w)
+{
+    if(w->pending)
+    {
+        q->stats.coalesced++;
+        return false;
+    }
+
+    w->pending = true;
+    w->submitted = mono_us32();
+    w->next = NULL;
+
+    if(q->tail == NULL)
+    {
+        q->head = w;
+    }
+    else
+    {
+        q->tail->next = w;
+    }
+
+    q->tail = w;
+
+    return true;
+}
+
+/*!
+ * \brief Takes the oldest item off a queue
+ *
+ * \return The item, NULL if the queue is empty
+ */
+static work_t *work_dequeue(work_queue_t *q)
+{
+    work_t *w;
+
+    taskENTER_CRITICAL();
+    {
+        w = q->head;
+
+        if(w != NULL)
+        {
+            q->head = w->next;
+
+            if(q->head == NULL)
+            {
+                q->tail = NULL;
+            }
+
+            w->pending = false;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return w;
+}
+
+/*!
+ * \brief Runs the items of the queue given as parameter
+ */
+static void vWorkTask(void *pvParameters)
+{
+    work_queue_t *q = (work_queue_t *)pvParameters;
+
+    for( ;; )
+    {
+        (void)ulTaskNotifyTakeIndexed(WORK_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+
+        work_t *w;
+
+        while((w = work_dequeue(q)) != NULL)
+        {
+            const uint32_t start = mono_us32();
+            const uint32_t latency = start - w->submitted;
+
+            w->fn(w->arg);
+
+            const uint32_t run = mono_us32() - start;
+
+            q->stats.runs++;
+
+            if(latency > q->stats.max_latency_us)
+            {
+                q->stats.max_latency_us = latency;
+            }
+
+            if(run > q->stats.max_run_us)
+            {
+                q->stats.max_run_us = run;
+            }
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+// Public functions
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \brief Creates the worker tasks
+ *
+ * \param[in]  high  Priority of the WORK_HIGH worker
+ * \param[in]  low   Priority of the WORK_LOW worker
+ */
+void work_init(const UBaseType_t high, const UBaseType_t low)
+{
+    const UBaseType_t priority[WORK_N_PRIOS] = {high, low};
+
+    for(uint32_t i=0; i<WORK_N_PRIOS; i++)
+    {
+        queues[i].task = xTaskCreateStatic(vWorkTask, work_names[i],
+            WORK_STACK_DEPTH, &queues[i], priority[i], work_stack[i], &work_tcb[i]);
+    }
+}
+
+/*!
+ * \brief Queues an item to its worker
+ *
+ * May be called before the scheduler is started, the item runs when it
+ * has started.
+ *
+ * \param[in,out]  w  The item, which must remain valid until it ran
+ *
+ * \return False if the item was already queued, the submission is
+ *         coalesced with it
+ */
+bool work_submit(work_t *w)
+{
+    work_queue_t *q = &queues[w->prio];
+    bool queued;
+
+    configASSERT(q->task != NULL);
+
+    taskENTER_CRITICAL();
+    {
+        queued = work_enqueue(q, w);
+    }
+    taskEXIT_CRITICAL();
+
+    if(queued)
+    {
+        (void)xTaskNotifyGiveIndexed(q->task, WORK_NOTIFY_INDEX);
+    }
+
+    return queued;
+}
+
+/*!
+ * \brief Queues an item to its worker, from an interrupt handler
+ *
+ * \param[in,out]  w      The item, which must remain valid until it ran
+ * \param[in,out]  woken  Set to pdTRUE if the worker must be switched in
+ *
+ * \return False if the item was already queued, the submission is
+ *         coalesced with it
+ */
+bool work_submit_from_isr(work_t *w, BaseType_t *woken)
+{
+    work_queue_t *q = &queues[w->prio];
+    bool queued;
+
+    configASSERT(q->task != NULL);
+
+    const UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    {
+        queued = work_enqueue(q, w);
+    }
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+
+    if(queued)
+    {
+        vTaskNotifyGiveIndexedFromISR(q->task, WORK_NOTIFY_INDEX, woken);
+    }
+
+    return queued;
+}
+
+/*!
+ * \brief Copies the statistics of a worker
+ */
+void work_get_stats(const work_prio_t prio, work_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    {
+        *stats = queues[prio].stats;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*!
+ * \brief Writes the statistics of the workers
+ */
+void work_report(void)
+{
+    char line[WORK_LINE_LEN];
+    work_stats_t stats;
+
+    xsnprintf(line, WORK_LINE_LEN, "\r\n%-*s %8s %8s %8s %8s\r\n",
+        configMAX_TASK_NAME_LEN, "Worker", "Runs", "Merged", "Lat us", "Run us");
+    xSerialPutStringPolicy(line, eSerialBlock, WORK_BLOCK_TIME);
+
+    for(uint32_t i=0; i<WORK_N_PRIOS; i++)
+    {
+        work_get_stats((work_prio_t)i, &stats);
+
+        xsnprintf(line, WORK_LINE_LEN, "%-*s %8lu %8lu %8lu %8lu\r\n",
+            configMAX_TASK_NAME_LEN, work_names[i], (unsigned long)stats.runs,
+            (unsigned long)stats.coalesced, (unsigned long)stats.max_latency_us,
+            (unsigned long)stats.max_run_us);
+        xSerialPutStringPolicy(line, eSerialBlock, WORK_BLOCK_TIME);
+    }
+}
@@ -0,0 +1,118 @@
+/*! ***************************************************************************
+ *
+ * \brief     Prioritised deferred work for interrupt bottom halves
+ * \file      work.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef WORK_H
+#define WORK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// \name Definitions for the work queues
+/// \{
+
+/*!
+ * \brief Stack size in words of each worker task, the items of a worker
+ *        share it
+ */
+#ifndef WORK_STACK_DEPTH
+#define WORK_STACK_DEPTH    (configMINIMAL_STACK_SIZE)
+#endif
+
+/*!
+ * \brief Task notification index on which the workers wait for items. An
+ *        item must not wait on it.
+ */
+#ifndef WORK_NOTIFY_INDEX
+#define WORK_NOTIFY_INDEX   (0)
+#endif
+
+/// \}
+
+/// Worker of an item
+typedef enum
+{
+    WORK_HIGH,      ///< Short bottom halves of interrupts
+    WORK_LOW,       ///< Longer work that may block briefly
+    WORK_N_PRIOS,
+}
+work_prio_t;
+
+/// Function of a work item
+typedef void (*work_fn_t)(void *arg);
+
+/*!
+ * \brief A work item
+ *
+ * Statically allocated and initialised with WORK_ITEM(). An item is queued
+ * at most once, a submission while it waits is coalesced with it. The
+ * pending flag is cleared before the function runs, so a submission while
+ * it runs queues it again.
+ */
+typedef struct work
+{
+    work_fn_t fn;
+    void *arg;
+    work_prio_t prio;
+
+    // Managed by the service
+    volatile bool pending;
+    uint32_t submitted;         ///< mono_us32() of the submission
+    struct work *next;
+}
+work_t;
+
+/*!
+ * \brief Initialiser of a work item
+ */
+#define WORK_ITEM(f, a, p) {.fn = (f), .arg = (a), .prio = (p)}
+
+/// Statistics of a worker
+typedef struct
+{
+    uint32_t runs;              ///< Items run
+    uint32_t coalesced;         ///< Submissions of items already queued
+    uint32_t max_latency_us;    ///< Longest from submission to start
+    uint32_t max_run_us;        ///< Longest run of an item
+}
+work_stats_t;
+
+// Function prototypes
+void work_init(const UBaseType_t high, const UBaseType_t low);
+
+bool work_submit(work_t *w);
+bool work_submit_from_isr(work_t *w, BaseType_t *woken);
+
+void work_get_stats(const work_prio_t prio, work_stats_t *stats);
+void work_report(void);
+
+#endif // WORK_H
@@ -0,0 +1,456 @@
+/*! ***************************************************************************
+ *
+ * \brief     Integer only printf style formatter
+ * \file      xprintf.c
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#include <stdbool.h>
+
+#include "xprintf.h"
+
+/*
+ * A small replacement of the printf family of newlib-nano for the strings of
+ * the example. Only integers, characters and strings are formatted, so no
+ * floating point or 64 bit division is linked in. The output is passed to a
+ * callback in pieces: runs of the format string, converted numbers and the
+ * string arguments themselves, without copying them to a buffer first.
+ *
+ * Supported are the conversions d, i, u, x, X, c, s, p and %, the flags -, 0,
+ * + and space, a width and a precision, both also as *, and the length
+ * modifiers hh, h, l and z. A conversion that is not supported, such as a
+ * float or ll, is copied to the output together with the rest of the format
+ * string, because the size of its argument is unknown.
+ */
+
+/// \name Flags of a conversion
+/// \{
+#define XPRINTF_LEFT  (1U << 0) ///< '-', pad on the right
+#define XPRINTF_ZERO  (1U << 1) ///< '0', pad numbers with zeros
+#define XPRINTF_PLUS  (1U << 2) ///< '+', sign of positive numbers
+#define XPRINTF_SPACE (1U << 3) ///< ' ', space before positive numbers
+/// \}
+
+/// Output of a call and the number of characters passed to it
+typedef struct
+{
+    xprintf_out_t out;
+    void *arg;
+    size_t count;
+}xprintf_sink_t;
+
+/// Buffer of xsnprintf()
+typedef struct
+{
+    char *buf;
+    size_t size;
+    size_t pos;
+}xprintf_buf_t;
+
+static void xprintf_emit(xprintf_sink_t *sink, const char *s, const size_t n)
+{
+    if(n > 0)
+    {
+        sink->out(sink->arg, s, n);
+        sink->count += n;
+    }
+}
+
+/*!
+ * \brief Passes n copies of a padding character to the output
+ */
+static void xprintf_pad(xprintf_sink_t *sink, const char c, int32_t n)
+{
+    static const char spaces[8] = {' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '};
+    static const char zeros[8] = {'0', '0', '0', '0', '0', '0', '0', '0'};
+
+    while(n > 0)
+    {
+        const int32_t k = (n > 8) ? 8 : n;
+
+        xprintf_emit(sink, (c == '0') ? zeros : spaces, (size_t)k);
+        n -= k;
+    }
+}
+
+/*!
+ * \brief Passes a string in a field of the given width to the output
+ */
+static void xprintf_field(xprintf_sink_t *sink, const char *s, const size_t n,
+    const uint32_t flags, const int32_t width)
+{
+    const int32_t pad = width - (int32_t)n;
+
+    if(!(flags & XPRINTF_LEFT))
+    {
+        xprintf_pad(sink, ' ', pad);
+    }
+
+    xprintf_emit(sink, s, n);
+
+    if(flags & XPRINTF_LEFT)
+    {
+        xprintf_pad(sink, ' ', pad);
+    }
+}
+
+/*!
+ * \brief Converts a number and passes it in its field to the output
+ *
+ * \param[in]  v       Magnitude of the number
+ * \param[in]  base    10 or 16
+ * \param[in]  upper   Upper case hexadecimal digits
+ * \param[in]  prefix  Sign or "0x", may be empty
+ */
+static void xprintf_number(xprintf_sink_t *sink, unsigned long v,
+    const unsigned long base, const bool upper, const char *prefix,
+    const uint32_t flags, const int32_t width, const int32_t precision)
+{
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char buf[3 * sizeof(unsigned long)];
+    size_t n = 0;
+
+    // The digits from the least significant one, nothing for 0 with
+    // precision 0
+    while((v > 0) || ((n == 0) && (precision != 0)))
+    {
+        buf[sizeof(buf) - 1 - n++] = digits[v % base];
+        v /= base;
+    }
+
+    size_t np = 0;
+    while(prefix[np] != '\0')
+    {
+        np++;
+    }
+
+    int32_t zeros = (precision > (int32_t)n) ? (precision - (int32_t)n) : 0;
+    int32_t pad = width - (int32_t)(np + n) - zeros;
+
+    // The 0 flag is ignored with a precision, like printf() does
+    if((flags & XPRINTF_ZERO) && !(flags & XPRINTF_LEFT) && (precision < 0))
+    {
+        zeros += (pad > 0) ? pad : 0;
+        pad = 0;
+    }
+
+    if(!(flags & XPRINTF_LEFT))
+    {
+        xprintf_pad(sink, ' ', pad);
+    }
+
+    xprintf_emit(sink, prefix, np);
+    xprintf_pad(sink, '0', zeros);
+    xprintf_emit(sink, &buf[sizeof(buf) - n], n);
+
+    if(flags & XPRINTF_LEFT)
+    {
+        xprintf_pad(sink, ' ', pad);
+    }
+}
+
+/*!
+ * \brief Reads a width or precision from the format string or, for '*',
+ *        from the arguments
+ */
+static int32_t xprintf_value(const char **p, va_list *ap)
+{
+    int32_t v = 0;
+
+    if(**p == '*')
+    {
+        (*p)++;
+        return (int32_t)va_arg(*ap, int);
+    }
+
+    while((**p >= '0') && (**p <= '9'))
+    {
+        v = (v * 10) + (*(*p)++ - '0');
+    }
+
+    return v;
+}
+
+/*!
+ * \brief Formats the arguments and passes the result to a callback
+ *
+ * \param[in]  out  Callback that receives the output in pieces
+ * \param[in]  arg  Passed to \p out
+ * \param[in]  fmt  printf style format string, see the top of this file for
+ *                  the supported conversions
+ * \param[in]  ap   Arguments
+ *
+ * \return The number of characters passed to \p out
+ */
+size_t xvformat(xprintf_out_t out, void *arg, const char *fmt, va_list ap)
+{
+    xprintf_sink_t sink = {.out = out, .arg = arg, .count = 0};
+    va_list args;
+
+    // Copied, so the helpers can take the list by reference on every target
+    va_copy(args, ap);
+
+    while(*fmt != '\0')
+    {
+        // A run of characters up to the next conversion
+        const char *p = fmt;
+        while((*p != '\0') && (*p != '%'))
+        {
+            p++;
+        }
+
+        xprintf_emit(&sink, fmt, (size_t)(p - fmt));
+
+        if(*p == '\0')
+        {
+            break;
+        }
+
+        const char *spec = p++;
+        uint32_t flags = 0;
+
+        for(;; p++)
+        {
+            if(*p == '-')      { flags |= XPRINTF_LEFT; }
+            else if(*p == '0') { flags |= XPRINTF_ZERO; }
+            else if(*p == '+') { flags |= XPRINTF_PLUS; }
+            else if(*p == ' ') { flags |= XPRINTF_SPACE; }
+            else               { break; }
+        }
+
+        int32_t width = xprintf_value(&p, &args);
+        if(width < 0)
+        {
+            flags |= XPRINTF_LEFT;
+            width = -width;
+        }
+
+        int32_t precision = -1;
+        if(*p == '.')
+        {
+            p++;
+            precision = xprintf_value(&p, &args);
+        }
+
+        // Length modifier: 1 for h, 2 for hh, -1 for l and z
+        int32_t length = 0;
+        if(*p == 'h')
+        {
+            length = (p[1] == 'h') ? 2 : 1;
+            p += length;
+        }
+        else if(((*p == 'l') && (p[1] != 'l')) || (*p == 'z'))
+        {
+            length = -1;
+            p++;
+        }
+
+        const char c = *p++;
+
+        switch(c)
+        {
+        case '%':
+            xprintf_emit(&sink, "%", 1);
+            break;
+
+        case 'c':
+        {
+            const char ch = (char)va_arg(args, int);
+            xprintf_field(&sink, &ch, 1, flags, width);
+            break;
+        }
+
+        case 's':
+        {
+            const char *s = va_arg(args, const char *);
+            size_t n = 0;
+
+            if(s == NULL)
+            {
+                s = "(null)";
+            }
+
+            while((s[n] != '\0') && ((precision < 0) || (n < (size_t)precision)))
+            {
+                n++;
+            }
+
+            xprintf_field(&sink, s, n, flags, width);
+            break;
+        }
+
+        case 'd':
+        case 'i':
+        {
+            long v;
+
+            if(length < 0)
+            {
+                v = va_arg(args, long);
+            }
+            else
+            {
+                v = va_arg(args, int);
+                v = (length == 1) ? (short)v : (length == 2) ? (signed char)v : v;
+            }
+
+            const char *sign = (v < 0) ? "-" : (flags & XPRINTF_PLUS) ? "+" :
+                               (flags & XPRINTF_SPACE) ? " " : "";
+            const unsigned long m = (v < 0) ? (0UL - (unsigned long)v) :
+                                              (unsigned long)v;
+
+            xprintf_number(&sink, m, 10, false, sign, flags, width, precision);
+            break;
+        }
+
+        case 'u':
+        case 'x':
+        case 'X':
+        {
+            unsigned long v;
+
+            if(length < 0)
+            {
+                v = va_arg(args, unsigned long);
+            }
+            else
+            {
+                v = va_arg(args, unsigned int);
+                v = (length == 1) ? (unsigned short)v :
+                    (length == 2) ? (unsigned char)v : v;
+            }
+
+            xprintf_number(&sink, v, (c == 'u') ? 10 : 16, (c == 'X'), "",
+                flags, width, precision);
+            break;
+        }
+
+        case 'p':
+            xprintf_number(&sink, (unsigned long)(uintptr_t)va_arg(args, void *),
+                16, false, "0x", flags, width, precision);
+            break;
+
+        default:
+            // The size of the argument is unknown, so the remaining
+            // arguments cannot be read
+            p = spec;
+            while(*p != '\0')
+            {
+                p++;
+            }
+            xprintf_emit(&sink, spec, (size_t)(p - spec));
+            break;
+        }
+
+        fmt = p;
+    }
+
+    va_end(args);
+
+    return sink.count;
+}
+
+/*!
+ * \brief Formats the arguments and passes the result to a callback
+ *
+ * \see xvformat()
+ */
+size_t xformat(xprintf_out_t out, void *arg, const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    const size_t n = xvformat(out, arg, fmt, ap);
+    va_end(ap);
+
+    return n;
+}
+
+/*!
+ * \brief Copies output to the buffer of xvsnprintf() while there is room
+ */
+static void xprintf_buf_out(void *arg, const char *s, size_t n)
+{
+    xprintf_buf_t *b = (xprintf_buf_t *)arg;
+
+    if(b->pos + 1 >= b->size)
+    {
+        return;
+    }
+
+    if(n > (b->size - 1 - b->pos))
+    {
+        n = b->size - 1 - b->pos;
+    }
+
+    for(size_t i=0; i<n; ++i)
+    {
+        b->buf[b->pos++] = s[i];
+    }
+}
+
+/*!
+ * \brief Formats the arguments into a buffer, like vsnprintf()
+ *
+ * The result is always terminated if \p size is larger than 0.
+ *
+ * \param[out]  buf   Buffer
+ * \param[in]   size  Size of the buffer
+ * \param[in]   fmt   Format string, see xvformat()
+ * \param[in]   ap    Arguments
+ *
+ * \return The length of the complete result, which was truncated if it is
+ *         not less than \p size
+ */
+int xvsnprintf(char *buf, size_t size, const char *fmt, va_list ap)
+{
+    xprintf_buf_t b = {.buf = buf, .size = size, .pos = 0};
+
+    const size_t n = xvformat(xprintf_buf_out, &b, fmt, ap);
+
+    if(size > 0)
+    {
+        buf[b.pos] = '\0';
+    }
+
+    return (int)n;
+}
+
+/*!
+ * \brief Formats the arguments into a buffer, like snprintf()
+ *
+ * \see xvsnprintf()
+ */
+int xsnprintf(char *buf, size_t size, const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    const int n = xvsnprintf(buf, size, fmt, ap);
+    va_end(ap);
+
+    return n;
+}
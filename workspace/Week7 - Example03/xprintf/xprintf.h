@@ -0,0 +1,56 @@
+/*! ***************************************************************************
+ *
+ * \brief     Integer only printf style formatter
+ * \file      xprintf.h
+ * \date      October 2026
+ *
+ * \copyright 2026 HAN University of Applied Sciences. All Rights Reserved.
+ *            \n\n
+ *            Permission is hereby granted, free of charge, to any person
+ *            obtaining a copy of this software and associated documentation
+ *            files (the "Software"), to deal in the Software without
+ *            restriction, including without limitation the rights to use,
+ *            copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *            copies of the Software, and to permit persons to whom the
+ *            Software is furnished to do so, subject to the following
+ *            conditions:
+ *            \n\n
+ *            The above copyright notice and this permission notice shall be
+ *            included in all copies or substantial portions of the Software.
+ *            \n\n
+ *            THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *            EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *            OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *            NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *            HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *            WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *            FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *            OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+#ifndef XPRINTF_H
+#define XPRINTF_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \brief Receives the formatted output in pieces
+ *
+ * \param[in]  arg  Argument given to xformat()
+ * \param[in]  s    Characters, not terminated
+ * \param[in]  n    Number of characters
+ */
+typedef void (*xprintf_out_t)(void *arg, const char *s, size_t n);
+
+// Function prototypes
+size_t xvformat(xprintf_out_t out, void *arg, const char *fmt, va_list ap);
+size_t xformat(xprintf_out_t out, void *arg, const char *fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+
+int xvsnprintf(char *buf, size_t size, const char *fmt, va_list ap);
+int xsnprintf(char *buf, size_t size, const char *fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+
+#endif // XPRINTF_H